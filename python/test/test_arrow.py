@@ -17,7 +17,8 @@
 import unittest
 import pyarrow
 
-from pyvelox.arrow import to_velox, to_arrow
+from pyvelox.arrow import to_velox, to_arrow, to_arrow_reader
+from pyvelox.type import BIGINT, ROW
 from pyvelox.vector import Vector
 
 
@@ -48,3 +49,28 @@ class TestPyVeloxArrow(unittest.TestCase):
         # vector = to_velox(pyarrow.array([]))
         # self.assertEqual(vector.size(), 0)
         pass
+
+    def test_reader(self):
+        batches = [
+            pyarrow.record_batch(
+                [pyarrow.array(list(range(i * 10, (i + 1) * 10)))], names=["c0"]
+            )
+            for i in range(5)
+        ]
+        reader = to_arrow_reader(to_velox(batch) for batch in batches)
+
+        self.assertTrue(isinstance(reader, pyarrow.RecordBatchReader))
+        self.assertEqual(reader.schema, batches[0].schema)
+        self.assertEqual(reader.read_all(), pyarrow.Table.from_batches(batches))
+
+    def test_reader_empty(self):
+        self.assertRaises(RuntimeError, to_arrow_reader, [])
+
+        reader = to_arrow_reader([], ROW(["c0"], [BIGINT()]))
+        schema = pyarrow.schema([("c0", pyarrow.int64())])
+        self.assertEqual(reader.schema, schema)
+        self.assertEqual(reader.read_all().num_rows, 0)
+
+    def test_reader_not_row(self):
+        vector = to_velox(pyarrow.array([1, 2, 3]))
+        self.assertRaises(RuntimeError, to_arrow_reader, [vector])
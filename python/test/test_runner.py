@@ -17,9 +17,10 @@ import os
 import random
 import tempfile
 import unittest
+from concurrent.futures import ThreadPoolExecutor
 
 import pyarrow
-from pyvelox.arrow import to_velox
+from pyvelox.arrow import to_arrow_reader, to_velox
 from pyvelox.file import DWRF
 from pyvelox.plan_builder import PlanBuilder
 from pyvelox.runner import (
@@ -186,6 +187,27 @@ class TestPyVeloxRunner(unittest.TestCase):
         )
         self.assertEqual(output, expected)
 
+    def test_runner_threads(self):
+        # Execution releases the GIL, so runners can be driven from multiple
+        # Python threads concurrently.
+        batch_size = 100
+        vectors = []
+        for i in range(10):
+            array = pyarrow.array(list(range(i * batch_size, (i + 1) * batch_size)))
+            vectors.append(to_velox(pyarrow.record_batch([array], names=["c0"])))
+
+        def run(i):
+            plan_builder = PlanBuilder().values(vectors).order_by(["c0"])
+            runner = LocalRunner(plan_builder.get_plan_node())
+            return to_arrow_reader(runner.execute()).read_all()
+
+        with ThreadPoolExecutor(max_workers=4) as pool:
+            tables = list(pool.map(run, range(8)))
+
+        expected = list(range(10 * batch_size))
+        for table in tables:
+            self.assertEqual(table.column("c0").to_pylist(), expected)
+
     def test_register_connectors(self):
         register_hive("conn1")
         self.assertRaises(RuntimeError, register_hive, "conn1")
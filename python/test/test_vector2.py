@@ -103,3 +103,26 @@ class TestPyVeloxVector(unittest.TestCase):
         data = [1.9, 2.45]
         vector = to_velox(pyarrow.array(data))
         self.assertEqual(vector.type(), DOUBLE())
+
+    def test_vector_values(self):
+        data = [1, 2, 3, 4, 5]
+        view = memoryview(to_velox(pyarrow.array(data)).values())
+        self.assertTrue(view.readonly)
+        self.assertEqual(view.format, "q")
+        self.assertEqual(view.tolist(), data)
+
+        # The buffer keeps the vector alive after it goes out of scope.
+        view = memoryview(to_velox(pyarrow.array([1.5, 2.5])).values())
+        self.assertEqual(view.format, "d")
+        self.assertEqual(view.tolist(), [1.5, 2.5])
+
+        view = memoryview(
+            to_velox(pyarrow.array([7, 8], type=pyarrow.int16())).values()
+        )
+        self.assertEqual(view.tolist(), [7, 8])
+
+        # Only flat numeric vectors without nulls.
+        vector = to_velox(pyarrow.array([1, None, 3]))
+        self.assertRaises(RuntimeError, vector.values)
+        vector = to_velox(pyarrow.array(["a", "b"]))
+        self.assertRaises(RuntimeError, vector.values)
@@ -137,6 +137,30 @@ void QueryBenchmarkBase::printResults(
   }
 }
 
+// static
+void QueryBenchmarkBase::printOperatorStats(
+    const exec::TaskStats& stats,
+    std::ostream& out) {
+  out << "Operator stats:" << std::endl;
+  out << "pipeline\toperator\tplanNodeId\tcpuNanos\twallNanos"
+      << "\tpeakMemoryBytes\toutputRows\tspilledBytes" << std::endl;
+  for (const auto& pipeline : stats.pipelineStats) {
+    for (const auto& op : pipeline.operatorStats) {
+      CpuWallTiming timing;
+      timing.add(op.addInputTiming);
+      timing.add(op.getOutputTiming);
+      timing.add(op.finishTiming);
+      timing.add(op.isBlockedTiming);
+      timing.add(op.backgroundTiming);
+      out << op.pipelineId << "\t" << op.operatorType << "\t"
+          << op.planNodeId << "\t" << timing.cpuNanos << "\t"
+          << timing.wallNanos << "\t"
+          << op.memoryStats.peakTotalMemoryReservation << "\t"
+          << op.outputPositions << "\t" << op.spilledBytes << std::endl;
+    }
+  }
+}
+
 void QueryBenchmarkBase::initialize() {
   if (FLAGS_cache_gb) {
     memory::MemoryManager::Options options;
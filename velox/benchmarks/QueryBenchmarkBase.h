@@ -104,6 +104,13 @@ class QueryBenchmarkBase {
       const std::vector<RowVectorPtr>& results,
       std::ostream& out);
 
+  /// Prints one tab separated line per operator of 'stats' with its CPU and
+  /// wall time and its peak memory, for tracking regressions of individual
+  /// operators across runs.
+  static void printOperatorStats(
+      const exec::TaskStats& stats,
+      std::ostream& out);
+
   void readCombinations();
 
   /// Entry point invoked with different settings to run the benchmark.
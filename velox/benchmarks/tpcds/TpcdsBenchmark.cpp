@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/benchmarks/tpcds/TpcdsBenchmark.h"
+
+#include "velox/benchmarks/QueryBenchmarkBase.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::dwio::common;
+
+DEFINE_string(
+    data_path,
+    "",
+    "Root path of TPC-DS data. Data layout must follow Hive-style "
+    "partitioning. Example layout for '-data_path=/data/tpcds10'\n"
+    "       /data/tpcds10/customer_demographics\n"
+    "       /data/tpcds10/date_dim\n"
+    "       /data/tpcds10/household_demographics\n"
+    "       /data/tpcds10/item\n"
+    "       /data/tpcds10/promotion\n"
+    "       /data/tpcds10/store\n"
+    "       /data/tpcds10/store_sales\n"
+    "       /data/tpcds10/time_dim\n"
+    "If the above are directories, they contain the data files for "
+    "each table. If they are files, they contain a file system path for each "
+    "data file, one per line. The columns must have the standard TPC-DS "
+    "names.");
+namespace {
+static bool notEmpty(const char* /*flagName*/, const std::string& value) {
+  return !value.empty();
+}
+} // namespace
+
+DEFINE_validator(data_path, &notEmpty);
+
+DEFINE_int32(
+    run_query_verbose,
+    -1,
+    "Run a given query and print execution statistics");
+DEFINE_bool(
+    run_scan_verbose,
+    false,
+    "Run the scan of all the store_sales columns and print execution "
+    "statistics");
+DEFINE_bool(
+    print_operator_stats,
+    false,
+    "Print the CPU time and peak memory of each operator after each "
+    "benchmarked query");
+
+std::shared_ptr<TpcdsQueryBuilder> queryBuilder;
+
+class TpcdsBenchmark : public QueryBenchmarkBase {
+ public:
+  void runMain(std::ostream& out, RunStats& runStats) override {
+    if (FLAGS_run_query_verbose == -1 && !FLAGS_run_scan_verbose) {
+      folly::runBenchmarks();
+      return;
+    }
+    const auto queryPlan = FLAGS_run_scan_verbose
+        ? queryBuilder->getScanPlan()
+        : queryBuilder->getQueryPlan(FLAGS_run_query_verbose);
+    auto [cursor, actualResults] = run(queryPlan);
+    if (!cursor) {
+      LOG(ERROR) << "Query terminated with error. Exiting";
+      exit(1);
+    }
+    auto task = cursor->task();
+    ensureTaskCompletion(task.get());
+    if (FLAGS_include_results) {
+      printResults(actualResults, out);
+      out << std::endl;
+    }
+    const auto stats = task->taskStats();
+    int64_t rawInputBytes = 0;
+    for (auto& pipeline : stats.pipelineStats) {
+      auto& first = pipeline.operatorStats[0];
+      if (first.operatorType == "TableScan") {
+        rawInputBytes += first.rawInputBytes;
+      }
+    }
+    runStats.rawInputBytes = rawInputBytes;
+    out << fmt::format(
+               "Execution time: {}",
+               succinctMillis(
+                   stats.executionEndTimeMs - stats.executionStartTimeMs))
+        << std::endl;
+    out << fmt::format(
+               "Splits total: {}, finished: {}",
+               stats.numTotalSplits,
+               stats.numFinishedSplits)
+        << std::endl;
+    out << printPlanWithStats(
+               *queryPlan.plan, stats, FLAGS_include_custom_stats)
+        << std::endl;
+    printOperatorStats(stats, out);
+  }
+
+  // Runs 'plan' and prints the stats of its operators if
+  // --print_operator_stats is set.
+  void runBenchmark(const TpchPlan& plan) {
+    auto [cursor, results] = run(plan);
+    if (FLAGS_print_operator_stats && cursor) {
+      folly::BenchmarkSuspender suspender;
+      printOperatorStats(cursor->task()->taskStats(), std::cout);
+    }
+  }
+};
+
+TpcdsBenchmark benchmark;
+
+BENCHMARK(q3) {
+  benchmark.runBenchmark(queryBuilder->getQueryPlan(3));
+}
+
+BENCHMARK(q7) {
+  benchmark.runBenchmark(queryBuilder->getQueryPlan(7));
+}
+
+BENCHMARK(q27) {
+  benchmark.runBenchmark(queryBuilder->getQueryPlan(27));
+}
+
+BENCHMARK(q96) {
+  benchmark.runBenchmark(queryBuilder->getQueryPlan(96));
+}
+
+BENCHMARK(q98) {
+  benchmark.runBenchmark(queryBuilder->getQueryPlan(98));
+}
+
+BENCHMARK(scan) {
+  benchmark.runBenchmark(queryBuilder->getScanPlan());
+}
+
+void tpcdsBenchmarkMain() {
+  benchmark.initialize();
+  queryBuilder =
+      std::make_shared<TpcdsQueryBuilder>(toFileFormat(FLAGS_data_format));
+  queryBuilder->initialize(FLAGS_data_path);
+  if (FLAGS_test_flags_file.empty()) {
+    RunStats ignore;
+    benchmark.runMain(std::cout, ignore);
+  } else {
+    benchmark.runAllCombinations();
+  }
+  benchmark.shutdown();
+  queryBuilder.reset();
+}
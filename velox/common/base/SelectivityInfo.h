@@ -39,6 +39,14 @@ class SelectivityInfo {
     return timeToDropValue() < right.timeToDropValue();
   }
 
+  /// Halves the counts and the time, so that the values added after weigh
+  /// more than the values added before.
+  void decay() {
+    numIn_ /= 2;
+    numOut_ /= 2;
+    timeClocks_ /= 2;
+  }
+
   uint64_t numIn() const {
     return numIn_;
   }
@@ -61,6 +61,31 @@ SpillConfig::SpillConfig(
       "Spillable memory reservation growth pct should not be lower than minimum available pct");
 }
 
+int32_t SpillConfig::maxMergeFiles() const {
+  if (mergeReadBufferBudget == 0) {
+    return 0;
+  }
+  // At least two files are merged at a time to make progress.
+  return std::max<uint64_t>(
+      2,
+      std::min<uint64_t>(
+          std::numeric_limits<int32_t>::max(),
+          mergeReadBufferBudget / std::max<uint64_t>(readBufferSize, 1)));
+}
+
+int32_t SpillConfig::reservationGrowthPct(uint32_t numGrowths) const {
+  if (maxSpillableReservationGrowthPct <= spillableReservationGrowthPct) {
+    return spillableReservationGrowthPct;
+  }
+  // Stops doubling before the percentage can overflow.
+  int64_t pct = spillableReservationGrowthPct;
+  for (uint32_t i = 0; i < numGrowths && pct < maxSpillableReservationGrowthPct;
+       ++i) {
+    pct *= 2;
+  }
+  return std::min<int64_t>(pct, maxSpillableReservationGrowthPct);
+}
+
 int32_t SpillConfig::spillLevel(uint8_t startBitOffset) const {
   VELOX_CHECK_LE(
       startBitOffset + numPartitionBits,
@@ -52,6 +52,18 @@ using GetSpillDirectoryPathCB = std::function<std::string_view()>;
 /// bytes exceed the set limit.
 using UpdateAndCheckSpillLimitCB = std::function<void(uint64_t)>;
 
+/// Places spill files on an overflow spill tier, e.g. a remote object store,
+/// once the local spill tier reaches its quota.
+struct SpillOverflowConfig {
+  /// Returns the spill directory path on the overflow tier.
+  GetSpillDirectoryPathCB getSpillDirPathCb;
+
+  /// Invoked with the bytes written to the spill files on the local tier.
+  /// Returns false once the local tier has reached its quota. Invoked with zero
+  /// bytes to check the quota before creating a spill file.
+  std::function<bool(uint64_t)> updateLocalSpillBytesCb;
+};
+
 /// Specifies the config for spilling.
 struct SpillConfig {
   SpillConfig() = default;
@@ -84,6 +96,18 @@ struct SpillConfig {
   /// Checks if the given 'startBitOffset' has exceeded the max spill limit.
   bool exceedSpillLevelLimit(uint8_t startBitOffset) const;
 
+  /// Returns the maximum number of sorted spill files merged at a time so that
+  /// their read buffers fit in 'mergeReadBufferBudget', or 0 if unbounded.
+  int32_t maxMergeFiles() const;
+
+  /// Returns the memory reservation growth in percentage of the current memory
+  /// usage for a spillable operator that has successfully grown its
+  /// reservation 'numGrowths' times in a row. The operators count the
+  /// successful reservations of their ensureInputFits() and reset the count
+  /// when a reservation fails, so that a growing operator reaches its peak
+  /// memory in a logarithmic number of larger reservations.
+  int32_t reservationGrowthPct(uint32_t numGrowths) const;
+
   /// Returns true if prefix sort is enabled.
   bool prefixSortEnabled() const {
     return prefixSortConfig.has_value();
@@ -117,6 +141,25 @@ struct SpillConfig {
   /// Executor for spilling. If nullptr spilling writes on the Driver's thread.
   folly::Executor* executor; // Not owned.
 
+  /// Executor for writing the buffered spill data in the background while the
+  /// spill writer serializes the next buffer. If nullptr the spill writer
+  /// writes synchronously.
+  folly::Executor* asyncWriteExecutor{nullptr}; // Not owned.
+
+  /// Executor for prefetching the spill files merged by an ordered spill
+  /// reader. If nullptr or 'mergeReadAheadBudget' is 0, the files are read on
+  /// demand.
+  folly::Executor* readAheadExecutor{nullptr}; // Not owned.
+
+  /// The maximum memory in bytes of the buffers prefetched by an ordered spill
+  /// reader.
+  uint64_t mergeReadAheadBudget{0};
+
+  /// The maximum memory in bytes of the read buffers of the sorted spill files
+  /// merged at a time. If the files of a sorted spill need more, they are
+  /// merged in multiple passes. 0 means no limit.
+  uint64_t mergeReadBufferBudget{0};
+
   /// The minimal spillable memory reservation in percentage of the current
   /// memory usage.
   int32_t minSpillableReservationPct;
@@ -125,6 +168,11 @@ struct SpillConfig {
   /// memory usage.
   int32_t spillableReservationGrowthPct;
 
+  /// If larger than 'spillableReservationGrowthPct', the growth percentage
+  /// doubles with each successful reservation up to this value, see
+  /// reservationGrowthPct().
+  int32_t maxSpillableReservationGrowthPct{0};
+
   /// The start partition bit offset of the top (the first level) partitions.
   uint8_t startPartitionBit;
 
@@ -151,11 +199,24 @@ struct SpillConfig {
   /// CompressionKind when spilling, CompressionKind_NONE means no compression.
   common::CompressionKind compressionKind;
 
+  /// If larger than 0 and 'compressionKind' is ZSTD, the Presto serde trains
+  /// a ZSTD dictionary on the first this many pages of a spill partition and
+  /// compresses the following pages with it. 0 disables the dictionary.
+  int32_t compressionDictionaryPages{0};
+
   /// Prefix sort config when spilling, enable prefix sort when this config is
   /// set, otherwise, fallback to timsort.
   std::optional<PrefixSortConfig> prefixSortConfig;
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// The name of the vector serde kind used to spill the rows of a row
+  /// container, "Presto" or "CompactRow".
+  std::string rowContainerSerdeKind{"Presto"};
+
+  /// If set, the spill files go to the overflow tier once the local tier at
+  /// 'getSpillDirPathCb' reaches its quota.
+  std::optional<SpillOverflowConfig> overflowConfig;
 };
 } // namespace facebook::velox::common
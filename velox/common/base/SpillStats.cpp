@@ -87,6 +87,7 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillWrites += other.spillWrites;
   spillFlushTimeNanos += other.spillFlushTimeNanos;
   spillWriteTimeNanos += other.spillWriteTimeNanos;
+  spillWriteWaitTimeNanos += other.spillWriteWaitTimeNanos;
   spillMaxLevelExceededCount += other.spillMaxLevelExceededCount;
   spillReadBytes += other.spillReadBytes;
   spillReads += other.spillReads;
@@ -114,6 +115,8 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillWrites = spillWrites - other.spillWrites;
   result.spillFlushTimeNanos = spillFlushTimeNanos - other.spillFlushTimeNanos;
   result.spillWriteTimeNanos = spillWriteTimeNanos - other.spillWriteTimeNanos;
+  result.spillWriteWaitTimeNanos =
+      spillWriteWaitTimeNanos - other.spillWriteWaitTimeNanos;
   result.spillMaxLevelExceededCount =
       spillMaxLevelExceededCount - other.spillMaxLevelExceededCount;
   result.spillReadBytes = spillReadBytes - other.spillReadBytes;
@@ -149,6 +152,7 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillWrites);
   UPDATE_COUNTER(spillFlushTimeNanos);
   UPDATE_COUNTER(spillWriteTimeNanos);
+  UPDATE_COUNTER(spillWriteWaitTimeNanos);
   UPDATE_COUNTER(spillMaxLevelExceededCount);
   UPDATE_COUNTER(spillReadBytes);
   UPDATE_COUNTER(spillReads);
@@ -190,6 +194,7 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillWrites,
              spillFlushTimeNanos,
              spillWriteTimeNanos,
+             spillWriteWaitTimeNanos,
              spillMaxLevelExceededCount,
              spillReadBytes,
              spillReads,
@@ -209,6 +214,7 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spillWrites,
              other.spillFlushTimeNanos,
              other.spillWriteTimeNanos,
+             other.spillWriteWaitTimeNanos,
              spillMaxLevelExceededCount,
              spillReadBytes,
              spillReads,
@@ -216,6 +222,24 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillDeserializationTimeNanos);
 }
 
+uint64_t SpillStats::estimateSpillCostNs(uint64_t bytes) const {
+  if (spilledInputBytes == 0) {
+    return bytes * kDefaultSpillNanosPerByte;
+  }
+  const double writeNanosPerByte =
+      static_cast<double>(
+          spillFillTimeNanos + spillSortTimeNanos +
+          spillExtractVectorTimeNanos + spillSerializationTimeNanos +
+          spillFlushTimeNanos + spillWriteTimeNanos) /
+      spilledInputBytes;
+  // The read bytes are the bytes on disk which might be compressed.
+  const double readNanosPerByte = spillReadBytes == 0
+      ? writeNanosPerByte
+      : static_cast<double>(spillReadTimeNanos + spillDeserializationTimeNanos) /
+          spillReadBytes * spilledBytes / spilledInputBytes;
+  return bytes * (writeNanosPerByte + readNanosPerByte);
+}
+
 void SpillStats::reset() {
   spillRuns = 0;
   spilledInputBytes = 0;
@@ -230,6 +254,7 @@ void SpillStats::reset() {
   spillWrites = 0;
   spillFlushTimeNanos = 0;
   spillWriteTimeNanos = 0;
+  spillWriteWaitTimeNanos = 0;
   spillMaxLevelExceededCount = 0;
   spillReadBytes = 0;
   spillReads = 0;
@@ -242,7 +267,8 @@ std::string SpillStats::toString() const {
       "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] "
       "spilledPartitions[{}] spilledFiles[{}] spillFillTimeNanos[{}] "
       "spillSortTimeNanos[{}] spillExtractVectorTime[{}] spillSerializationTimeNanos[{}] spillWrites[{}] "
-      "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] maxSpillExceededLimitCount[{}] "
+      "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] spillWriteWaitTimeNanos[{}] "
+      "maxSpillExceededLimitCount[{}] "
       "spillReadBytes[{}] spillReads[{}] spillReadTimeNanos[{}] "
       "spillReadDeserializationTimeNanos[{}]",
       spillRuns,
@@ -258,6 +284,7 @@ std::string SpillStats::toString() const {
       spillWrites,
       succinctNanos(spillFlushTimeNanos),
       succinctNanos(spillWriteTimeNanos),
+      succinctNanos(spillWriteWaitTimeNanos),
       spillMaxLevelExceededCount,
       succinctBytes(spillReadBytes),
       spillReads,
@@ -356,4 +383,11 @@ SpillStats globalSpillStats() {
   }
   return gSpillStats;
 }
+
+uint64_t updateGlobalLocalSpillTierBytes(int64_t delta) {
+  static std::atomic<int64_t> localSpillTierBytes{0};
+  const auto bytes = localSpillTierBytes.fetch_add(delta) + delta;
+  VELOX_CHECK_GE(bytes, 0);
+  return bytes;
+}
 } // namespace facebook::velox::common
@@ -56,6 +56,11 @@ struct SpillStats {
   uint64_t spillFlushTimeNanos{0};
   /// The time spent on writing spilled rows to disk.
   uint64_t spillWriteTimeNanos{0};
+  /// The time the spilling thread waited for the asynchronous writes to
+  /// finish, including the writes it ran itself as the executor had not
+  /// started them. The writes overlap with the spill serialization by the
+  /// fraction of 'spillWriteTimeNanos' not spent waiting.
+  uint64_t spillWriteWaitTimeNanos{0};
   /// The number of times that an hash build operator exceeds the max spill
   /// limit.
   uint64_t spillMaxLevelExceededCount{0};
@@ -95,6 +100,15 @@ struct SpillStats {
     return spilledBytes == 0;
   }
 
+  /// The spill cost per byte of memory assumed by estimateSpillCostNs() if
+  /// nothing has been spilled, i.e. writing and reading back at about 250MB/s.
+  static constexpr uint64_t kDefaultSpillNanosPerByte{4};
+
+  /// Returns the estimated time in nanoseconds to spill 'bytes' of memory and
+  /// read them back at the throughput observed by these stats. Reading back is
+  /// assumed to be as fast as spilling if nothing has been read yet.
+  uint64_t estimateSpillCostNs(uint64_t bytes) const;
+
   SpillStats& operator+=(const SpillStats& other);
   SpillStats operator-(const SpillStats& other) const;
   bool operator==(const SpillStats& other) const;
@@ -169,6 +183,11 @@ void updateGlobalSpillDeserializationTimeNs(uint64_t timeNs);
 
 /// Gets the cumulative global spill stats.
 SpillStats globalSpillStats();
+
+/// Updates the bytes of the spill files on the local spill tier of this node by
+/// 'delta' and returns the new total. The bytes are added as the spill files
+/// are written and removed when their spill directory is removed.
+uint64_t updateGlobalLocalSpillTierBytes(int64_t delta);
 } // namespace facebook::velox::common
 
 template <>
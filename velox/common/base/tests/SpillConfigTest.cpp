@@ -194,6 +194,36 @@ TEST_P(SpillConfigTest, spillableReservationPercentages) {
   }
 }
 
+TEST_P(SpillConfigTest, reservationGrowthPct) {
+  SpillConfig config(
+      [&]() -> std::string_view { return ""; },
+      [&](uint64_t) {},
+      "reservationGrowthPct",
+      0,
+      0,
+      0,
+      nullptr,
+      5,
+      10,
+      0,
+      0,
+      0,
+      1'000'000,
+      0,
+      "none",
+      prefixSortConfig_);
+  // The growth is constant by default.
+  ASSERT_EQ(config.reservationGrowthPct(0), 10);
+  ASSERT_EQ(config.reservationGrowthPct(10), 10);
+
+  config.maxSpillableReservationGrowthPct = 100;
+  ASSERT_EQ(config.reservationGrowthPct(0), 10);
+  ASSERT_EQ(config.reservationGrowthPct(1), 20);
+  ASSERT_EQ(config.reservationGrowthPct(3), 80);
+  ASSERT_EQ(config.reservationGrowthPct(4), 100);
+  ASSERT_EQ(config.reservationGrowthPct(1'000), 100);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     SpillConfigTest,
     SpillConfigTest,
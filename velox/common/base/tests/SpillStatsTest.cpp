@@ -129,7 +129,8 @@ TEST(SpillStatsTest, spillStats) {
       "spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] "
       "spillFillTimeNanos[1.03us] spillSortTimeNanos[1.03us] spillExtractVectorTime[1.03us] "
       "spillSerializationTimeNanos[1.03us] spillWrites[1028] spillFlushTimeNanos[1.03us] "
-      "spillWriteTimeNanos[1.03us] maxSpillExceededLimitCount[4] "
+      "spillWriteTimeNanos[1.03us] spillWriteWaitTimeNanos[0ns] "
+      "maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTimeNanos[100ns] "
       "spillReadDeserializationTimeNanos[100ns]");
   ASSERT_EQ(
@@ -139,7 +140,32 @@ TEST(SpillStatsTest, spillStats) {
       "spillFillTimeNanos[1.03us] spillSortTimeNanos[1.03us] spillExtractVectorTime[1.03us] "
       "spillSerializationTimeNanos[1.03us] spillWrites[1028] "
       "spillFlushTimeNanos[1.03us] spillWriteTimeNanos[1.03us] "
-      "maxSpillExceededLimitCount[4] "
+      "spillWriteWaitTimeNanos[0ns] maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTimeNanos[100ns] "
       "spillReadDeserializationTimeNanos[100ns]");
 }
+
+TEST(SpillStatsTest, estimateSpillCostNs) {
+  SpillStats stats;
+  ASSERT_EQ(
+      stats.estimateSpillCostNs(1'000),
+      1'000 * SpillStats::kDefaultSpillNanosPerByte);
+
+  // 6'000ns to spill 1'000 bytes and nothing read back yet.
+  stats.spilledInputBytes = 1'000;
+  stats.spilledBytes = 500;
+  stats.spillFillTimeNanos = 1'000;
+  stats.spillSortTimeNanos = 1'000;
+  stats.spillExtractVectorTimeNanos = 1'000;
+  stats.spillSerializationTimeNanos = 1'000;
+  stats.spillFlushTimeNanos = 1'000;
+  stats.spillWriteTimeNanos = 1'000;
+  ASSERT_EQ(stats.estimateSpillCostNs(2'000), 2 * (6 + 6) * 1'000);
+
+  // 2'000ns to read back 250 of the 500 compressed bytes, i.e. 4ns per byte of
+  // memory.
+  stats.spillReadBytes = 250;
+  stats.spillReadTimeNanos = 1'000;
+  stats.spillDeserializationTimeNanos = 1'000;
+  ASSERT_EQ(stats.estimateSpillCostNs(2'000), 2 * (6 + 4) * 1'000);
+}
@@ -52,7 +52,7 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
   numPins_ = 1;
   std::unique_ptr<folly::SharedPromise<bool>> promise;
   {
-    std::lock_guard<std::mutex> l(shard_->mutex());
+    std::lock_guard<std::shared_mutex> l(shard_->mutex());
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
@@ -70,6 +70,12 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
     hook(*this);
   }
 
+  // A new entry stays in the cache under memory pressure only if it is hit
+  // again. A prefetched entry is kept for its first use.
+  if (!isPrefetch() && shard_->cache()->underMemoryPressure()) {
+    makeEvictable();
+  }
+
   if (!ssdSavable) {
     return;
   }
@@ -166,9 +172,12 @@ CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
+  if (auto pin = findShared(key, size); !pin.empty()) {
+    return pin;
+  }
   AsyncDataCacheEntry* entryToInit = nullptr;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<std::shared_mutex> l(mutex_);
     ++eventCounter_;
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
@@ -234,8 +243,34 @@ CachePin CacheShard::findOrCreate(
   return initEntry(key, entryToInit);
 }
 
+CachePin CacheShard::findShared(RawFileCacheKey key, uint64_t size) {
+  // Eviction, removal and the creation of entries hold 'mutex_' exclusively,
+  // so a found entry that is not exclusive cannot go away or become exclusive
+  // before it is pinned.
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  auto it = entryMap_.find(key);
+  if (it == entryMap_.end()) {
+    return CachePin();
+  }
+  auto* foundEntry = it->second;
+  // The first hit on a prefetched entry changes its flags and a stale entry
+  // is replaced. These are left to findOrCreate() under the exclusive lock.
+  if (foundEntry->isExclusive() || foundEntry->isPrefetch() ||
+      foundEntry->size() < size) {
+    return CachePin();
+  }
+  ++eventCounter_;
+  foundEntry->touch();
+  ++numHit_;
+  hitBytes_ += foundEntry->size();
+  ++foundEntry->numPins_;
+  CachePin pin;
+  pin.setEntry(foundEntry);
+  return pin;
+}
+
 void CacheShard::makeEvictable(RawFileCacheKey key) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<std::shared_mutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it == entryMap_.end()) {
     return;
@@ -244,7 +279,7 @@ void CacheShard::makeEvictable(RawFileCacheKey key) {
 }
 
 bool CacheShard::exists(RawFileCacheKey key) const {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<std::shared_mutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it != entryMap_.end()) {
     it->second->touch();
@@ -253,6 +288,18 @@ bool CacheShard::exists(RawFileCacheKey key) const {
   return false;
 }
 
+void CacheShard::appendRanges(CachedRanges& ranges) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& entry : entries_) {
+    if (entry == nullptr || !entry->key_.fileNum.hasValue() ||
+        entry->isExclusive()) {
+      continue;
+    }
+    ranges[entry->key_.fileNum.id()].emplace_back(
+        entry->key_.offset, entry->size_);
+  }
+}
+
 CachePin CacheShard::initEntry(
     RawFileCacheKey key,
     AsyncDataCacheEntry* entry) {
@@ -278,7 +325,7 @@ bool CoalescedLoad::loadOrFuture(
     folly::SemiFuture<bool>* wait,
     bool ssdSavable) {
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<std::shared_mutex> l(mutex_);
     if (state_ == State::kCancelled || state_ == State::kLoaded) {
       return true;
     }
@@ -321,7 +368,7 @@ bool CoalescedLoad::loadOrFuture(
 void CoalescedLoad::setEndState(State endState) {
   std::unique_ptr<folly::SharedPromise<bool>> promise;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<std::shared_mutex> l(mutex_);
     state_ = endState;
     promise.swap(promise_);
   }
@@ -332,7 +379,7 @@ void CoalescedLoad::setEndState(State endState) {
 
 std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
     AsyncDataCacheEntry* entry) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<std::shared_mutex> l(mutex_);
   removeEntryLocked(entry);
   // After the entry is removed from the hash table, a promise can no longer
   // be made. It is safe to move the promise and realize it.
@@ -370,7 +417,8 @@ uint64_t CacheShard::evict(
     uint64_t bytesToFree,
     bool evictAllUnpinned,
     MachinePageCount pagesToAcquire,
-    memory::Allocation& acquired) {
+    memory::Allocation& acquired,
+    bool evictableOnly) {
   auto* ssdCache = cache_->ssdCache();
   const bool skipSsdSaveable =
       (ssdCache != nullptr) && ssdCache->writeInProgress();
@@ -380,7 +428,7 @@ uint64_t CacheShard::evict(
   int64_t largeEvicted = 0;
   int32_t evictSaveableSkipped = 0;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<std::shared_mutex> l(mutex_);
     const size_t size = entries_.size();
     if (size == 0) {
       return 0;
@@ -414,11 +462,18 @@ uint64_t CacheShard::evict(
         eventCounter_ = 0;
       }
 
+      // An explicitly evictable entry has the maximum score.
+      if (evictableOnly && candidate->key_.fileNum.hasValue() &&
+          candidate->score(now) != std::numeric_limits<int32_t>::max()) {
+        continue;
+      }
+
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
            (score = candidate->score(now)) >= evictionThreshold_)) {
-        if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
+        if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned &&
+            !evictableOnly) {
           ++evictSaveableSkipped;
           continue;
         }
@@ -514,7 +569,7 @@ void CacheShard::calibrateThreshold() {
 }
 
 void CacheShard::updateStats(CacheStats& stats) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<std::shared_mutex> l(mutex_);
   for (auto& entry : entries_) {
     if (!entry || !entry->key_.fileNum.hasValue()) {
       ++stats.numEmptyEntries;
@@ -558,7 +613,7 @@ void CacheShard::updateStats(CacheStats& stats) {
 }
 
 void CacheShard::appendSsdSaveable(bool saveAll, std::vector<CachePin>& pins) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<std::shared_mutex> l(mutex_);
   // Do not add entries to a write batch more than maxWriteRatio_. If SSD save
   // is slower than storage read, we must not have a situation where SSD save
   // pins everything and stops reading.
@@ -594,7 +649,7 @@ bool CacheShard::removeFileEntries(
   int64_t pagesRemoved = 0;
   std::vector<memory::Allocation> toFree;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<std::shared_mutex> l(mutex_);
 
     auto entryIndex = -1;
     for (auto& cacheEntry : entries_) {
@@ -734,6 +789,12 @@ bool AsyncDataCache::exists(RawFileCacheKey key) const {
   return shards_[shard]->exists(key);
 }
 
+void AsyncDataCache::appendRanges(CachedRanges& ranges) const {
+  for (const auto& shard : shards_) {
+    shard->appendRanges(ranges);
+  }
+}
+
 bool AsyncDataCache::makeSpace(
     MachinePageCount numPages,
     std::function<bool(memory::Allocation& allocation)> allocate) {
@@ -840,17 +901,27 @@ uint64_t AsyncDataCache::shrink(uint64_t targetBytes) {
   uint64_t shrinkTimeUs{0};
   {
     MicrosecondTimer timer(&shrinkTimeUs);
-    for (int shard = 0; shard < shards_.size(); ++shard) {
-      memory::Allocation unused;
-      evictedBytes += shards_[shardCounter_++ & (kShardMask)]->evict(
-          std::max<uint64_t>(minBytesToEvict, targetBytes - evictedBytes),
-          // Cache shrink is triggered when server is under low memory pressure
-          // so need to free up memory as soon as possible. So we always avoid
-          // triggering ssd save to accelerate the cache evictions.
-          true,
-          0,
-          unused);
-      VELOX_CHECK(unused.empty());
+    // The first round evicts only the explicitly evictable entries, which are
+    // the least worth retaining. The second round evicts all the unpinned
+    // entries.
+    for (const bool evictableOnly : {true, false}) {
+      for (int shard = 0; shard < shards_.size(); ++shard) {
+        memory::Allocation unused;
+        evictedBytes += shards_[shardCounter_++ & (kShardMask)]->evict(
+            std::max<uint64_t>(minBytesToEvict, targetBytes - evictedBytes),
+            // Cache shrink is triggered when server is under low memory
+            // pressure so need to free up memory as soon as possible. So we
+            // always avoid triggering ssd save to accelerate the cache
+            // evictions.
+            true,
+            0,
+            unused,
+            evictableOnly);
+        VELOX_CHECK(unused.empty());
+        if (evictedBytes >= targetBytes) {
+          break;
+        }
+      }
       if (evictedBytes >= targetBytes) {
         break;
       }
@@ -868,6 +939,19 @@ uint64_t AsyncDataCache::shrink(uint64_t targetBytes) {
   return evictedBytes;
 }
 
+bool AsyncDataCache::underMemoryPressure() const {
+  if (opts_.noRetentionMemoryRatio >= 1) {
+    return false;
+  }
+  const auto allocatedPages = allocator_->numAllocated();
+  const auto cachedPages = cachedPages_.load(std::memory_order_relaxed);
+  const auto nonCachePages =
+      allocatedPages > cachedPages ? allocatedPages - cachedPages : 0;
+  return nonCachePages >=
+      memory::AllocationTraits::numPages(allocator_->capacity()) *
+      opts_.noRetentionMemoryRatio;
+}
+
 bool AsyncDataCache::canTryAllocate(
     MachinePageCount numPages,
     const memory::Allocation& acquired) const {
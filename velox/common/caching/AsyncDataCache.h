@@ -17,10 +17,12 @@
 #pragma once
 
 #include <deque>
+#include <shared_mutex>
 
 #include <fmt/format.h>
 #include <folly/GLog.h>
 #include <folly/chrono/Hardware.h>
+#include <folly/container/F14Map.h>
 #include <folly/container/F14Set.h>
 #include <folly/futures/SharedPromise.h>
 
@@ -29,6 +31,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/PeerCache.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
@@ -119,6 +122,10 @@ struct RawFileCacheKey {
     return offset == other.offset && fileNum == other.fileNum;
   }
 };
+
+/// The cached {offset, size} ranges of files keyed on the file number.
+using CachedRanges =
+    folly::F14FastMap<uint64_t, std::vector<std::pair<uint64_t, uint64_t>>>;
 } // namespace facebook::velox::cache
 
 namespace std {
@@ -256,10 +263,18 @@ class AsyncDataCacheEntry {
     trackingId_ = id;
   }
 
+  TrackingId trackingId() const {
+    return trackingId_;
+  }
+
   void setGroupId(uint64_t groupId) {
     groupId_ = groupId;
   }
 
+  uint64_t groupId() const {
+    return groupId_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -300,7 +315,8 @@ class AsyncDataCacheEntry {
   std::unique_ptr<folly::SharedPromise<bool>> promise_;
   int32_t size_{0};
 
-  // Setting this from 0 to 1 or to kExclusive requires owning shard_->mutex_.
+  // Setting this from 0 to 1 or to kExclusive requires owning shard_->mutex_,
+  // in at least shared mode for 0 to 1.
   std::atomic<int32_t> numPins_{0};
 
   AccessStats accessStats_;
@@ -571,11 +587,14 @@ class CacheShard {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// Adds the ranges of the loaded entries to 'ranges'.
+  void appendRanges(CachedRanges& ranges) const;
+
   AsyncDataCache* cache() const {
     return cache_;
   }
 
-  std::mutex& mutex() {
+  std::shared_mutex& mutex() {
     return mutex_;
   }
 
@@ -588,13 +607,16 @@ class CacheShard {
   /// If 'evictAllUnpinned' is true, anything that is not pinned is evicted at
   /// first sight. This is for out of memory emergencies. If 'pagesToAcquire' is
   /// set, up to this amount is added to 'allocation'. A smaller amount can be
-  /// added if not enough evictable data is found. The function returns the
-  /// total evicted bytes.
+  /// added if not enough evictable data is found. If 'evictableOnly' is true,
+  /// only the unpinned entries that are explicitly evictable, see
+  /// AsyncDataCacheEntry::makeEvictable(), are evicted. The function returns
+  /// the total evicted bytes.
   uint64_t evict(
       uint64_t bytesToFree,
       bool evictAllUnpinned,
       memory::MachinePageCount pagesToAcquire,
-      memory::Allocation& acquiredAllocation);
+      memory::Allocation& acquiredAllocation,
+      bool evictableOnly = false);
 
   /// Removes 'entry' from 'this'. Removes a possible promise from the entry
   /// inside the shard mutex and returns it so that it can be realized outside
@@ -642,6 +664,12 @@ class CacheShard {
 
   CachePin initEntry(RawFileCacheKey key, AsyncDataCacheEntry* entry);
 
+  // Returns a pin on the readable entry of 'key' of at least 'size' bytes,
+  // holding 'mutex_' only in shared mode, so that concurrent hits do not
+  // serialize. Returns an empty pin for all the other cases, which
+  // findOrCreate() handles under the exclusive lock.
+  CachePin findShared(RawFileCacheKey key, uint64_t size);
+
   void freeAllocations(std::vector<memory::Allocation>& allocations);
 
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
@@ -649,7 +677,9 @@ class CacheShard {
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
 
-  mutable std::mutex mutex_;
+  // Held in shared mode by the lookups that pin a readable entry and in
+  // exclusive mode by everything else.
+  mutable std::shared_mutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
   // Entries associated to a key.
   std::deque<std::unique_ptr<AsyncDataCacheEntry>> entries_;
@@ -661,14 +691,15 @@ class CacheShard {
 
   // Index in 'entries_' for the next eviction candidate.
   uint32_t clockHand_{0};
-  // Number of gets since last stats sampling.
-  uint32_t eventCounter_{0};
+  // Number of gets since last stats sampling. The counters below that are
+  // atomic are also updated by findShared().
+  std::atomic<uint32_t> eventCounter_{0};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
   // Cumulative count of cache hits.
-  uint64_t numHit_{0};
+  std::atomic<uint64_t> numHit_{0};
   // Cumulative Sum of bytes in cache hits.
-  uint64_t hitBytes_{0};
+  std::atomic<uint64_t> hitBytes_{0};
   // Cumulative count of hits on entries held in exclusive mode.
   uint64_t numWaitExclusive_{0};
   // Cumulative count of new entry creation.
@@ -700,10 +731,12 @@ class AsyncDataCache : public memory::Cache {
     Options(
         double _maxWriteRatio = 0.7,
         double _ssdSavableRatio = 0.125,
-        int32_t _minSsdSavableBytes = 1 << 24)
+        int32_t _minSsdSavableBytes = 1 << 24,
+        double _noRetentionMemoryRatio = 1.0)
         : maxWriteRatio(_maxWriteRatio),
           ssdSavableRatio(_ssdSavableRatio),
-          minSsdSavableBytes(_minSsdSavableBytes){};
+          minSsdSavableBytes(_minSsdSavableBytes),
+          noRetentionMemoryRatio(_noRetentionMemoryRatio){};
 
     /// The max ratio of the number of in-memory cache entries being written to
     /// SSD cache over the total number of cache entries. This is to control SSD
@@ -722,6 +755,14 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// The ratio of the allocator capacity that the memory allocated outside
+    /// of the cache, e.g. by queries, must reach for the cache to be under
+    /// memory pressure. Under memory pressure, a newly loaded entry is
+    /// immediately evictable until it is hit again, so that the data a scan
+    /// reads only once does not displace the cached data that is reused. 1
+    /// disables this.
+    double noRetentionMemoryRatio;
   };
 
   AsyncDataCache(
@@ -759,6 +800,10 @@ class AsyncDataCache : public memory::Cache {
       memory::MachinePageCount numPages,
       std::function<bool(memory::Allocation& allocation)> allocate) override;
 
+  /// Evicts the unpinned entries that are explicitly evictable first, e.g.
+  /// the ones loaded under memory pressure and not hit again, see
+  /// 'Options::noRetentionMemoryRatio'. Evicts the other unpinned entries
+  /// only if these do not add up to 'targetBytes'.
   uint64_t shrink(uint64_t targetBytes) override;
 
   memory::MemoryAllocator* allocator() const override {
@@ -787,6 +832,10 @@ class AsyncDataCache : public memory::Cache {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// Adds the ranges of the loaded entries to 'ranges'. Does not include the
+  /// SSD cache, see SsdCache::appendRanges().
+  void appendRanges(CachedRanges& ranges) const;
+
 #if defined(__has_feature)
 #if __has_feature(thread_sanitizer)
   __attribute__((__no_sanitize__("thread")))
@@ -815,6 +864,21 @@ class AsyncDataCache : public memory::Cache {
     return ssdCache_.get();
   }
 
+  /// Sets the tier consulted on a miss in 'this' and 'ssdCache_' before
+  /// reading the storage. To be called before the cache is used.
+  void setPeerCache(std::shared_ptr<PeerCache> peerCache) {
+    peerCache_ = std::move(peerCache);
+  }
+
+  /// Returns the peer cache or nullptr if not set.
+  PeerCache* peerCache() const {
+    return peerCache_.get();
+  }
+
+  /// Returns true if the memory allocated outside of the cache is at least
+  /// 'Options::noRetentionMemoryRatio' of the allocator capacity.
+  bool underMemoryPressure() const;
+
   /// Updates stats for creation of a new cache entry of 'size' bytes,
   /// i.e. a cache miss. Periodically updates SSD admission criteria,
   /// i.e. reconsider criteria every half cache capacity worth of misses.
@@ -893,6 +957,7 @@ class AsyncDataCache : public memory::Cache {
   const Options opts_;
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  std::shared_ptr<PeerCache> peerCache_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
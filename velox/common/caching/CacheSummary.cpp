@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheSummary.h"
+
+#include <algorithm>
+
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::cache {
+
+CacheSummary::CacheSummary(const AsyncDataCache& cache)
+    : createTimeMs_(getCurrentTimeMs()) {
+  cache.appendRanges(ranges_);
+  if (cache.ssdCache() != nullptr) {
+    cache.ssdCache()->appendRanges(ranges_);
+  }
+  fileFilter_.reset(ranges_.size());
+  for (auto& [fileNum, ranges] : ranges_) {
+    fileFilter_.insert(fileNameHash(fileIds().string(fileNum)));
+    // Turns the {offset, size} ranges into disjoint {begin, end} ones. An
+    // entry may be both in memory and on SSD.
+    for (auto& range : ranges) {
+      range.second += range.first;
+    }
+    std::sort(ranges.begin(), ranges.end());
+    int32_t numMerged = 0;
+    for (const auto& range : ranges) {
+      if (numMerged > 0 && range.first <= ranges[numMerged - 1].second) {
+        ranges[numMerged - 1].second =
+            std::max(ranges[numMerged - 1].second, range.second);
+      } else {
+        ranges[numMerged++] = range;
+      }
+    }
+    ranges.resize(numMerged);
+  }
+}
+
+uint64_t CacheSummary::cachedBytes(
+    uint64_t fileNum,
+    uint64_t offset,
+    uint64_t size) const {
+  auto it = ranges_.find(fileNum);
+  if (it == ranges_.end()) {
+    return 0;
+  }
+  const auto& ranges = it->second;
+  const auto end = offset + size;
+  // The first range that ends after 'offset'.
+  auto rangeIt = std::upper_bound(
+      ranges.begin(),
+      ranges.end(),
+      offset,
+      [](uint64_t value, const auto& range) { return value < range.second; });
+  uint64_t bytes = 0;
+  for (; rangeIt != ranges.end() && rangeIt->first < end; ++rangeIt) {
+    bytes += std::min(end, rangeIt->second) - std::max(offset, rangeIt->first);
+  }
+  return bytes;
+}
+
+std::string CacheSummary::serializedFileFilter() const {
+  std::string serialized;
+  serialized.resize(fileFilter_.serializedSize());
+  fileFilter_.serialize(serialized.data());
+  return serialized;
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/common/caching/AsyncDataCache.h"
+
+namespace facebook::velox::cache {
+
+/// A snapshot of the file ranges held in an AsyncDataCache and its SsdCache,
+/// for telling how much of a split a worker has cached without looking up
+/// the cache entries one by one. Making the snapshot visits all the entries,
+/// so it is made periodically and queried many times. The snapshot also has
+/// a Bloom filter of the names of the cached files for a scheduler to route
+/// the splits to the workers that have their data.
+class CacheSummary {
+ public:
+  /// Makes a snapshot of the loaded entries of 'cache' and of the entries of
+  /// its SsdCache if any.
+  explicit CacheSummary(const AsyncDataCache& cache);
+
+  /// Returns the hash of 'fileName' in the Bloom filter of
+  /// serializedFileFilter().
+  static uint64_t fileNameHash(std::string_view fileName) {
+    return folly::hasher<std::string_view>()(fileName);
+  }
+
+  /// Returns the number of bytes of [offset, offset + size) of the file
+  /// 'fileNum' of FileIds that are cached in memory or on SSD.
+  uint64_t cachedBytes(uint64_t fileNum, uint64_t offset, uint64_t size)
+      const;
+
+  /// Returns true if the file named 'fileName' may have cached data.
+  bool mayContainFile(std::string_view fileName) const {
+    return fileFilter_.mayContain(fileNameHash(fileName));
+  }
+
+  /// Returns the number of files with cached data.
+  int32_t numFiles() const {
+    return ranges_.size();
+  }
+
+  /// Returns the Bloom filter of the fileNameHash() of the cached files,
+  /// serialized by BloomFilter::serialize().
+  std::string serializedFileFilter() const;
+
+  /// Returns the time in ms since the epoch when 'this' was made.
+  uint64_t createTimeMs() const {
+    return createTimeMs_;
+  }
+
+ private:
+  const uint64_t createTimeMs_;
+
+  // The disjoint cached ranges of each file as {begin, end}, sorted on
+  // 'begin'.
+  CachedRanges ranges_;
+
+  BloomFilter<> fileFilter_;
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::cache {
+
+void FileGroupStats::recordReference(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* group = groupLocked(groupId);
+  if (group == nullptr) {
+    return;
+  }
+  auto& stream = group->streams[trackingId];
+  stream.referencedBytes += bytes;
+  ++stream.numReferences;
+}
+
+void FileGroupStats::recordRead(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* group = groupLocked(groupId);
+  if (group == nullptr) {
+    return;
+  }
+  group->streams[trackingId].readBytes += bytes;
+}
+
+void FileGroupStats::recordFile(
+    uint64_t fileId,
+    uint64_t groupId,
+    int32_t numStripes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numFiles_ >= kMaxFiles) {
+    return;
+  }
+  auto* group = groupLocked(groupId);
+  if (group == nullptr) {
+    return;
+  }
+  if (group->files.emplace(fileId, numStripes).second) {
+    group->numStripes += numStripes;
+    ++numFiles_;
+  }
+}
+
+FileGroupStats::GroupStats* FileGroupStats::groupLocked(uint64_t groupId) {
+  auto it = groups_.find(groupId);
+  if (it != groups_.end()) {
+    return &it->second;
+  }
+  if (groups_.size() >= maxGroups_) {
+    return nullptr;
+  }
+  return &groups_[groupId];
+}
+
+const FileGroupStats::StreamStats* FileGroupStats::findLocked(
+    uint64_t groupId,
+    TrackingId trackingId,
+    const GroupStats*& group) const {
+  group = nullptr;
+  auto it = groups_.find(groupId);
+  if (it == groups_.end()) {
+    return nullptr;
+  }
+  group = &it->second;
+  auto streamIt = group->streams.find(trackingId);
+  return streamIt == group->streams.end() ? nullptr : &streamIt->second;
+}
+
+// static
+double FileGroupStats::size(
+    const GroupStats& group,
+    const StreamStats& stream) {
+  if (group.numStripes == 0 || stream.numReferences == 0) {
+    return 0;
+  }
+  return stream.referencedBytes / stream.numReferences * group.numStripes;
+}
+
+// static
+double FileGroupStats::score(
+    const GroupStats& group,
+    const StreamStats& stream) {
+  const auto streamSize = size(group, stream);
+  return streamSize == 0 ? 0 : stream.readBytes / streamSize;
+}
+
+bool FileGroupStats::shouldSaveToSsd(uint64_t groupId, TrackingId trackingId)
+    const {
+  if (trackingId.empty()) {
+    // Metadata like footers is not tracked by stream.
+    return true;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!filterActive_) {
+    return true;
+  }
+  const GroupStats* group;
+  const auto* stream = findLocked(groupId, trackingId, group);
+  if (group == nullptr || group->numStripes == 0) {
+    return true;
+  }
+  return stream != nullptr && score(*group, *stream) > minSsdScore_;
+}
+
+double FileGroupStats::reuseProbability(
+    uint64_t groupId,
+    TrackingId trackingId) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const GroupStats* group;
+  const auto* stream = findLocked(groupId, trackingId, group);
+  if (stream == nullptr || group->numStripes == 0) {
+    return 1;
+  }
+  const auto streamScore = score(*group, *stream);
+  return streamScore <= 1 ? 0 : 1 - 1 / streamScore;
+}
+
+void FileGroupStats::updateSsdFilter(uint64_t ssdSize, int32_t decayPct) {
+  VELOX_CHECK_GE(decayPct, 0);
+  VELOX_CHECK_LE(decayPct, 100);
+  std::lock_guard<std::mutex> l(mutex_);
+  if (decayPct > 0) {
+    const double factor = (100 - decayPct) / 100.0;
+    for (auto& groupIt : groups_) {
+      for (auto& streamIt : groupIt.second.streams) {
+        auto& stream = streamIt.second;
+        stream.referencedBytes *= factor;
+        stream.numReferences *= factor;
+        stream.readBytes *= factor;
+      }
+    }
+  }
+  pruneLocked();
+  double totalSize;
+  const auto minScore = minScoreLocked(ssdSize, totalSize);
+  filterActive_ = minScore.has_value();
+  minSsdScore_ = minScore.value_or(0);
+}
+
+void FileGroupStats::pruneLocked() {
+  for (auto it = groups_.begin(); it != groups_.end();) {
+    auto& streams = it->second.streams;
+    for (auto streamIt = streams.begin(); streamIt != streams.end();) {
+      if (streamIt->second.referencedBytes < kMinBytes &&
+          streamIt->second.readBytes < kMinBytes) {
+        streamIt = streams.erase(streamIt);
+      } else {
+        ++streamIt;
+      }
+    }
+    if (streams.empty()) {
+      numFiles_ -= it->second.files.size();
+      it = groups_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  const size_t maxRetained = maxGroups_ * 3 / 4;
+  if (groups_.size() <= maxRetained) {
+    return;
+  }
+  // Drops the groups with the lowest best stream score.
+  std::vector<std::pair<double, uint64_t>> groupScores;
+  groupScores.reserve(groups_.size());
+  for (const auto& [groupId, group] : groups_) {
+    double bestScore = 0;
+    for (const auto& streamIt : group.streams) {
+      const auto& stream = streamIt.second;
+      bestScore = std::max(bestScore, score(group, stream));
+    }
+    groupScores.emplace_back(bestScore, groupId);
+  }
+  const auto numDropped = groups_.size() - maxRetained;
+  std::nth_element(
+      groupScores.begin(),
+      groupScores.begin() + numDropped,
+      groupScores.end());
+  for (auto i = 0; i < numDropped; ++i) {
+    auto it = groups_.find(groupScores[i].second);
+    numFiles_ -= it->second.files.size();
+    groups_.erase(it);
+  }
+}
+
+std::optional<double> FileGroupStats::minScoreLocked(
+    uint64_t ssdSize,
+    double& totalSize) const {
+  std::vector<std::pair<double, double>> scoreAndSizes;
+  totalSize = 0;
+  for (const auto& groupIt : groups_) {
+    const auto& group = groupIt.second;
+    for (const auto& streamIt : group.streams) {
+      const auto& stream = streamIt.second;
+      const auto streamSize = size(group, stream);
+      if (streamSize > 0) {
+        scoreAndSizes.emplace_back(score(group, stream), streamSize);
+        totalSize += streamSize;
+      }
+    }
+  }
+  if (totalSize <= ssdSize) {
+    return std::nullopt;
+  }
+  // The best scoring streams are saved until the SSD is full.
+  std::sort(
+      scoreAndSizes.begin(),
+      scoreAndSizes.end(),
+      [](const auto& left, const auto& right) {
+        return left.first > right.first;
+      });
+  double cumulativeSize = 0;
+  for (const auto& [streamScore, streamSize] : scoreAndSizes) {
+    cumulativeSize += streamSize;
+    if (cumulativeSize > ssdSize) {
+      return streamScore;
+    }
+  }
+  // The sum may differ from 'totalSize' by the rounding.
+  return scoreAndSizes.back().first;
+}
+
+std::string FileGroupStats::toString(uint64_t cacheBytes) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  double totalSize;
+  const auto minScore = minScoreLocked(cacheBytes, totalSize);
+  std::stringstream out;
+  out << groups_.size() << " groups " << numFiles_ << " files tracked "
+      << succinctBytes(static_cast<uint64_t>(totalSize)) << ", "
+      << (minScore.has_value() ? 100.0 * cacheBytes / totalSize : 100.0)
+      << "% cacheable";
+  if (filterActive_) {
+    out << ", saving scores over " << minSsdScore_;
+  }
+
+  std::vector<std::pair<double, uint64_t>> groupReads;
+  for (const auto& [groupId, group] : groups_) {
+    double readBytes = 0;
+    double groupSize = 0;
+    for (const auto& streamIt : group.streams) {
+      const auto& stream = streamIt.second;
+      readBytes += stream.readBytes;
+      groupSize += size(group, stream);
+    }
+    if (groupSize > 0) {
+      groupReads.emplace_back(readBytes / groupSize, groupId);
+    }
+  }
+  const auto numListed =
+      std::min<size_t>(groupReads.size(), kNumListedGroups);
+  std::partial_sort(
+      groupReads.begin(),
+      groupReads.begin() + numListed,
+      groupReads.end(),
+      std::greater<>());
+  for (auto i = 0; i < numListed; ++i) {
+    out << "\n group " << groupReads[i].second << ": read "
+        << groupReads[i].first << " times";
+  }
+  return out.str();
+}
+
+} // namespace facebook::velox::cache
@@ -16,48 +16,140 @@
 
 #pragma once
 
+#include <optional>
+
+#include <folly/container/F14Map.h>
+
 #include "velox/common/caching/ScanTracker.h"
 
 namespace facebook::velox::cache {
 
-// Dummy implementation of SsdCache admission stats.
+/// Tracks the references and reads of the streams of file groups, e.g. the
+/// partitions of a table, to decide what is worth saving to SSD. The size of
+/// a stream in a group is estimated from the bytes per reference and the
+/// number of stripes of the distinct files of the group. The score of a
+/// stream is its read bytes over its size, i.e. the number of times it was
+/// read, decayed over time. When the tracked data does not fit in the SSD,
+/// only the streams with the best scores that fit are saved, so that a one
+/// time scan of a large table does not replace the data that is read over and
+/// over. The streams of the groups with no known files are always saved.
+/// Thread safe.
 class FileGroupStats {
  public:
-  // Records ScanTracker::recordReference at group level
+  /// The default percentage by which the scores decay at each
+  /// updateSsdFilter().
+  static constexpr int32_t kDefaultDecayPct = 10;
+
+  /// The default maximum number of tracked groups.
+  static constexpr int32_t kDefaultMaxGroups = 50'000;
+
+  /// The maximum number of tracked files in all groups together.
+  static constexpr int32_t kMaxFiles = 1'000'000;
+
+  explicit FileGroupStats(int32_t maxGroups = kDefaultMaxGroups)
+      : maxGroups_(maxGroups) {}
+
+  /// Records ScanTracker::recordReference at group level.
   void recordReference(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
 
-  // Records ScanTracker::recordRead at group level
+  /// Records ScanTracker::recordRead at group level.
   void recordRead(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
-
-  // Records the existence of a distinct file inside 'groupId'
-  void recordFile(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      int32_t /*numStripes*/) {}
-
-  // Returns true if groupId, trackingId qualify the data to be cached to SSD.
-  bool shouldSaveToSsd(uint64_t /*groupId*/, TrackingId /*trackingId*/) const {
-    return true;
-  }
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
+
+  /// Records the existence of a distinct file inside 'groupId'.
+  void recordFile(uint64_t fileId, uint64_t groupId, int32_t numStripes);
+
+  /// Returns true if groupId, trackingId qualify the data to be cached to SSD.
+  bool shouldSaveToSsd(uint64_t groupId, TrackingId trackingId) const;
 
-  // Updates the SSD selection criteria. 'ssdsize' is the capacity,
-  // 'decayPct' gives by how much old accesses are discounted.
-  void updateSsdFilter(uint64_t /*ssdSize*/, int32_t /*decayPct*/ = 0) {}
+  /// Returns the estimated probability in [0, 1] that the data of 'groupId',
+  /// 'trackingId' is read again, 1 if not known. This is 1 - 1 / score, so
+  /// that the data read once has no reuse.
+  double reuseProbability(uint64_t groupId, TrackingId trackingId) const;
 
-  // Recalculates the best groups and makes a human readable
-  // summary. 'cacheBytes' is used to compute what fraction of the tracked
-  // working set can be cached in 'cacheBytes'.
-  std::string toString(uint64_t /*cacheBytes*/) {
-    return "<dummy FileGroupStats>";
+  /// Updates the SSD selection criteria. 'ssdSize' is the capacity,
+  /// 'decayPct' gives by how much old accesses are discounted. Drops the
+  /// groups that are no longer read and the ones with the lowest scores over
+  /// 'maxGroups_'.
+  void updateSsdFilter(uint64_t ssdSize, int32_t decayPct = kDefaultDecayPct);
+
+  /// Returns the number of tracked groups.
+  int32_t numGroups() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return groups_.size();
   }
+
+  /// Makes a human readable summary with the best groups. 'cacheBytes' is
+  /// used to compute what fraction of the tracked working set can be cached
+  /// in 'cacheBytes'.
+  std::string toString(uint64_t cacheBytes) const;
+
+ private:
+  // The bytes below which a decayed stream is dropped.
+  static constexpr double kMinBytes = 1;
+
+  // The number of best groups listed by toString().
+  static constexpr int32_t kNumListedGroups = 10;
+
+  struct StreamStats {
+    double referencedBytes{0};
+    double numReferences{0};
+    double readBytes{0};
+  };
+
+  struct GroupStats {
+    // The number of stripes of each distinct file.
+    folly::F14FastMap<uint64_t, int32_t> files;
+    int64_t numStripes{0};
+    folly::F14FastMap<TrackingId, StreamStats> streams;
+  };
+
+  // Returns the estimated size in bytes of 'stream' in 'group', 0 if the
+  // group has no known files.
+  static double size(const GroupStats& group, const StreamStats& stream);
+
+  // Returns the score of 'stream' in 'group'.
+  static double score(const GroupStats& group, const StreamStats& stream);
+
+  // Returns the stats of 'groupId', creating them if there is room. Returns
+  // nullptr if there are 'maxGroups_' groups already.
+  GroupStats* groupLocked(uint64_t groupId);
+
+  // Returns the stats of 'groupId', 'trackingId' or nullptr if not tracked.
+  // Sets 'group' to the stats of 'groupId' or nullptr.
+  const StreamStats* findLocked(
+      uint64_t groupId,
+      TrackingId trackingId,
+      const GroupStats*& group) const;
+
+  // Drops the streams and groups that decayed to nothing and the groups with
+  // the lowest scores if there are more than 'maxGroups_' * 3 / 4, so that
+  // there is room for new groups.
+  void pruneLocked();
+
+  // Returns the score over which the tracked data fits in 'ssdSize', or
+  // std::nullopt if all of it fits. Sets 'totalSize' to the size of the
+  // tracked data.
+  std::optional<double> minScoreLocked(uint64_t ssdSize, double& totalSize)
+      const;
+
+  const int32_t maxGroups_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<uint64_t, GroupStats> groups_;
+  int64_t numFiles_{0};
+
+  // True if the tracked data does not fit in the SSD. Only the data with a
+  // score over 'minSsdScore_' is saved then.
+  bool filterActive_{false};
+  double minSsdScore_{0};
 };
 
 } // namespace facebook::velox::cache
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+
+namespace facebook::velox::cache {
+
+class AsyncDataCacheEntry;
+
+/// Tier between the local caches and the storage that reads the data from the
+/// cache of another worker of the cluster, e.g. the worker that owns the
+/// file range by consistent hashing. Velox has no RPC of its own, so the
+/// embedding engine implements this and sets it with
+/// AsyncDataCache::setPeerCache(). The readers consult this on a miss in both
+/// AsyncDataCache and SsdCache before reading the storage. Must be thread
+/// safe.
+class PeerCache {
+ public:
+  virtual ~PeerCache() = default;
+
+  /// Fills the memory of the exclusively held 'entry' with the 'entry.size()'
+  /// bytes at 'entry.offset()' of 'fileName' if a peer has them cached.
+  /// Returns false on a miss, a timeout or an error, in which case the data
+  /// is read from storage. The implementation is expected to bound its
+  /// latency with a short timeout since the caller waits for it.
+  virtual bool read(std::string_view fileName, AsyncDataCacheEntry& entry) = 0;
+};
+
+} // namespace facebook::velox::cache
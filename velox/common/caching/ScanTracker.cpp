@@ -17,10 +17,71 @@
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/FileGroupStats.h"
 
+#include <folly/Synchronized.h>
+
 #include <sstream>
 
 namespace facebook::velox::cache {
 
+namespace {
+folly::Synchronized<
+    folly::F14FastMap<std::string, std::shared_ptr<ScanHistory>>>&
+tableHistories() {
+  static folly::Synchronized<
+      folly::F14FastMap<std::string, std::shared_ptr<ScanHistory>>>
+      histories;
+  return histories;
+}
+} // namespace
+
+// static
+std::shared_ptr<ScanHistory> ScanHistory::forTable(const std::string& table) {
+  return tableHistories().withWLock(
+      [&](auto& histories) -> std::shared_ptr<ScanHistory> {
+        auto it = histories.find(table);
+        if (it != histories.end()) {
+          return it->second;
+        }
+        if (histories.size() >= kMaxTables) {
+          return nullptr;
+        }
+        auto history = std::make_shared<ScanHistory>();
+        histories.emplace(table, history);
+        return history;
+      });
+}
+
+// static
+void ScanHistory::testingClear() {
+  tableHistories().wlock()->clear();
+}
+
+std::optional<TrackingData> ScanHistory::trackingData(TrackingId id) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = data_.find(id);
+  if (it == data_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void ScanHistory::merge(
+    const folly::F14FastMap<TrackingId, TrackingData>& data) {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& [id, history] : data_) {
+    history.referencedBytes *= kDecay;
+    history.readBytes *= kDecay;
+  }
+  for (const auto& [id, scanData] : data) {
+    if (scanData.referencedBytes == 0) {
+      continue;
+    }
+    auto& history = data_[id];
+    history.referencedBytes += scanData.referencedBytes;
+    history.readBytes += scanData.readBytes;
+  }
+}
+
 // Marks that 'bytes' worth of data may be accessed in the future. See
 // TrackingData for meaning of quantum.
 void ScanTracker::recordReference(
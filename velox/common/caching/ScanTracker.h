@@ -18,7 +18,9 @@
 
 #include <folly/container/F14Map.h>
 #include <cstdint>
+#include <memory>
 #include <mutex>
+#include <optional>
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
@@ -78,6 +80,38 @@ struct TrackingData {
   double readBytes{};
 };
 
+/// Access history of the streams of a table over the scans that have
+/// finished, so that a new scan of the table prefetches the columns the past
+/// scans read as soon as it starts, and not the ones that are always filtered
+/// out. The history of each scan is added with the older history decayed, so
+/// that the history follows changes in the workload. Thread safe.
+class ScanHistory {
+ public:
+  /// The maximum number of tables that have a history.
+  static constexpr int32_t kMaxTables = 10'000;
+
+  /// Returns the process-wide history of 'table', creating it if needed.
+  /// Returns nullptr if there are 'kMaxTables' histories already.
+  static std::shared_ptr<ScanHistory> forTable(const std::string& table);
+
+  /// Drops the histories of all tables.
+  static void testingClear();
+
+  /// Returns the decayed references and reads of 'id' over the past scans or
+  /// std::nullopt if 'id' has no history.
+  std::optional<TrackingData> trackingData(TrackingId id) const;
+
+  /// Adds the accesses of a finished scan.
+  void merge(const folly::F14FastMap<TrackingId, TrackingData>& data);
+
+ private:
+  // The weight of the earlier history when adding the accesses of a scan.
+  static constexpr double kDecay = 0.5;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<TrackingId, TrackingData> data_;
+};
+
 /// Tracks column access frequency during execution of a query. A ScanTracker is
 /// created at the level of a Task/TableScan, so that all threads of a scan
 /// report in the same tracker. The same ScanTracker tracks all reads of all
@@ -92,20 +126,27 @@ class ScanTracker {
   /// and will be referenced from a map from id to weak_ptr to 'this'.
   /// 'unregisterer' is supplied so that the destructor can remove the weak_ptr
   /// from the map of pending trackers. 'loadQuantum' is the largest single IO
-  /// size for read.
+  /// size for read. 'history' is the access history of the scanned table, if
+  /// any, that is used for the streams this has no history of yet and that
+  /// gets the accesses of this at destruction.
   ScanTracker(
       std::string_view id,
       std::function<void(ScanTracker*)> unregisterer,
       int32_t loadQuantum,
-      FileGroupStats* fileGroupStats = nullptr)
+      FileGroupStats* fileGroupStats = nullptr,
+      std::shared_ptr<ScanHistory> history = nullptr)
       : id_(id),
         unregisterer_(std::move(unregisterer)),
-        fileGroupStats_(fileGroupStats) {}
+        fileGroupStats_(fileGroupStats),
+        history_(std::move(history)) {}
 
   ~ScanTracker() {
     if (unregisterer_) {
       unregisterer_(this);
     }
+    if (history_ != nullptr) {
+      history_->merge(data_);
+    }
   }
 
   /// Records that a scan references 'bytes' bytes of the stream given by 'id'.
@@ -140,9 +181,24 @@ class ScanTracker {
     return data.readBytes / data.referencedBytes * 100;
   }
 
+  /// Returns the references and reads of 'id'. Until 'id' is referenced
+  /// more than once, the reads of the past scans of the table are returned
+  /// as if they were the earlier reads of this scan.
   TrackingData trackingData(TrackingId id) {
     std::lock_guard<std::mutex> l(mutex_);
-    return data_[id];
+    const auto& data = data_[id];
+    if (history_ == nullptr ||
+        data.referencedBytes > data.lastReferencedBytes) {
+      return data;
+    }
+    const auto history = history_->trackingData(id);
+    if (!history.has_value()) {
+      return data;
+    }
+    return TrackingData{
+        history->referencedBytes + data.referencedBytes,
+        data.lastReferencedBytes,
+        history->readBytes + data.readBytes};
   }
 
   std::string_view id() const {
@@ -160,6 +216,7 @@ class ScanTracker {
   const std::string id_;
   const std::function<void(ScanTracker*)> unregisterer_{nullptr};
   FileGroupStats* const fileGroupStats_;
+  const std::shared_ptr<ScanHistory> history_;
 
   std::mutex mutex_;
   folly::F14FastMap<TrackingId, TrackingData> data_;
@@ -67,7 +67,9 @@ SsdCache::SsdCache(const Config& config)
         config.disableFileCow,
         config.checksumEnabled,
         checksumReadVerificationEnabled,
-        executor_);
+        executor_,
+        groupStats_.get(),
+        config.compressionKind);
     files_.push_back(std::make_unique<SsdFile>(fileConfig));
   }
 }
@@ -184,6 +186,12 @@ SsdCacheStats SsdCache::stats() const {
   return stats;
 }
 
+void SsdCache::appendRanges(CachedRanges& ranges) const {
+  for (const auto& file : files_) {
+    file->appendRanges(ranges);
+  }
+}
+
 std::string SsdCache::toString() const {
   const auto data = stats();
   const uint64_t capacity = maxBytes();
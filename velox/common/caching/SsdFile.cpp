@@ -36,6 +36,7 @@
 
 DECLARE_bool(velox_ssd_odirect);
 DECLARE_bool(velox_ssd_verify_write);
+DECLARE_int32(velox_ssd_max_parallel_reads);
 
 namespace facebook::velox::cache {
 
@@ -67,6 +68,43 @@ uint32_t numIoVectorsFromEntry(AsyncDataCacheEntry& entry) {
   }
   return entry.data().numRuns();
 }
+
+// Returns the ranges of the memory of 'entry'.
+std::vector<folly::Range<char*>> entryRanges(AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    return {folly::Range<char*>(entry.tinyData(), entry.size())};
+  }
+  std::vector<folly::Range<char*>> ranges;
+  const auto& allocation = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < allocation.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = allocation.runAt(i);
+    const auto rangeSize = std::min<int64_t>(bytesLeft, run.numBytes());
+    ranges.emplace_back(run.data<char>(), rangeSize);
+    bytesLeft -= rangeSize;
+  }
+  return ranges;
+}
+
+// Copies the first 'entry.size()' bytes of 'data' into 'entry'.
+void copyToEntry(const char* data, AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    ::memcpy(entry.tinyData(), data, entry.size());
+    return;
+  }
+  const auto& allocation = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < allocation.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = allocation.runAt(i);
+    const auto copySize = std::min<int64_t>(bytesLeft, run.numBytes());
+    ::memcpy(run.data<char>(), data, copySize);
+    data += copySize;
+    bytesLeft -= copySize;
+  }
+}
+
+// The size of the uncompressed size prefix of a compressed entry.
+constexpr int32_t kCompressedHeaderSize = sizeof(uint32_t);
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -114,8 +152,17 @@ SsdFile::SsdFile(const Config& config)
       shardId_(config.shardId),
       fs_(filesystems::getFileSystem(fileName_, nullptr)),
       checkpointIntervalBytes_(config.checkpointIntervalBytes),
-      executor_(config.executor) {
+      executor_(config.executor),
+      groupStats_(config.groupStats) {
   process::TraceContext trace("SsdFile::SsdFile");
+  if (config.compressionKind != common::CompressionKind_NONE) {
+    auto codec = common::Codec::create(config.compressionKind);
+    VELOX_CHECK(
+        codec.hasValue(),
+        "Cannot compress SSD cache entries: {}",
+        codec.error().message());
+    codec_ = std::move(codec.value());
+  }
   filesystems::FileOptions fileOptions;
   fileOptions.shouldThrowOnFileAlreadyExists = false;
   fileOptions.bufferIo = !FLAGS_velox_ssd_odirect;
@@ -196,9 +243,18 @@ CoalesceIoStats SsdFile::load(
     return CoalesceIoStats();
   }
   size_t totalPayloadBytes = 0;
+  // The pins of the compressed runs are read one by one after the others.
+  std::vector<int32_t> compressedIndices;
   for (auto i = 0; i < pins.size(); ++i) {
     const auto runSize = ssdPins[i].run().size();
     auto* entry = pins[i].checkedEntry();
+    if (ssdPins[i].run().compressed()) {
+      compressedIndices.push_back(i);
+      regionRead(regionIndex(ssdPins[i].run().offset()), runSize);
+      ++stats_.entriesRead;
+      stats_.bytesRead += entry->size();
+      continue;
+    }
     if (FOLLY_UNLIKELY(runSize < entry->size())) {
       ++stats_.readSsdErrors;
       VELOX_FAIL(
@@ -212,34 +268,126 @@ CoalesceIoStats SsdFile::load(
     stats_.bytesRead += entry->size();
   }
 
-  // Do coalesced IO for the pins. For short payloads, the break-even between
-  // discrete pread calls and a single preadv that discards gaps is ~25K per
-  // gap. For longer payloads this is ~50-100K.
-  const auto stats = readPins(
-      pins,
-      totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
-      // Max ranges in one preadv call. Longest gap + longest cache entry are
-      // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
-      // of 1000 is safe.
-      900,
-      [&](int32_t index) { return ssdPins[index].run().offset(); },
-      [&](const std::vector<CachePin>& /*pins*/,
-          int32_t /*begin*/,
-          int32_t /*end*/,
-          uint64_t offset,
-          const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
-      });
+  CoalesceIoStats stats;
+  std::vector<uint32_t> dataSizes(pins.size());
+  if (compressedIndices.empty()) {
+    std::vector<std::pair<uint64_t, std::vector<folly::Range<char*>>>>
+        batches;
+    // Do coalesced IO for the pins. For short payloads, the break-even
+    // between discrete pread calls and a single preadv that discards gaps is
+    // ~25K per gap. For longer payloads this is ~50-100K.
+    stats = readPins(
+        pins,
+        totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
+        // Max ranges in one preadv call. Longest gap + longest cache entry
+        // are under 12 ranges. If a system has a limit of 1K ranges, coalesce
+        // limit of 1000 is safe.
+        900,
+        [&](int32_t index) { return ssdPins[index].run().offset(); },
+        [&](const std::vector<CachePin>& /*pins*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t offset,
+            const std::vector<folly::Range<char*>>& buffers) {
+          batches.emplace_back(offset, buffers);
+        });
+    readBatches(batches);
+  } else {
+    // The compressed runs are decompressed into the entries, so the pins are
+    // read one by one.
+    for (auto i = 0; i < pins.size(); ++i) {
+      const auto run = ssdPins[i].run();
+      auto* entry = pins[i].checkedEntry();
+      if (run.compressed()) {
+        dataSizes[i] = readCompressed(run, *entry);
+        stats.payloadBytes += run.size();
+      } else {
+        read(run.offset(), entryRanges(*entry));
+        stats.payloadBytes += entry->size();
+      }
+      ++stats.numIos;
+    }
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
     auto* entry = pins[i].checkedEntry();
     auto ssdRun = ssdPins[i].run();
-    maybeVerifyChecksum(*entry, ssdRun);
+    maybeVerifyChecksum(
+        *entry, ssdRun, ssdRun.compressed() ? dataSizes[i] : ssdRun.size());
   }
   return stats;
 }
 
+std::string SsdFile::compressEntry(const AsyncDataCacheEntry& entry) const {
+  const auto size = entry.size();
+  std::string data;
+  const char* input = entry.tinyData();
+  if (input == nullptr) {
+    data.resize(size);
+    int64_t offset = 0;
+    const auto& allocation = entry.data();
+    for (auto i = 0; i < allocation.numRuns() && offset < size; ++i) {
+      const auto run = allocation.runAt(i);
+      const auto copySize = std::min<int64_t>(size - offset, run.numBytes());
+      ::memcpy(data.data() + offset, run.data<char>(), copySize);
+      offset += copySize;
+    }
+    input = data.data();
+  }
+  std::string compressed(
+      kCompressedHeaderSize + codec_->maxCompressedLength(size), 0);
+  const uint32_t header = size;
+  ::memcpy(compressed.data(), &header, kCompressedHeaderSize);
+  const auto compressedSize = codec_->compress(
+      reinterpret_cast<const uint8_t*>(input),
+      size,
+      reinterpret_cast<uint8_t*>(compressed.data() + kCompressedHeaderSize),
+      compressed.size() - kCompressedHeaderSize);
+  if (compressedSize.hasError() ||
+      kCompressedHeaderSize + compressedSize.value() >= size) {
+    return "";
+  }
+  compressed.resize(kCompressedHeaderSize + compressedSize.value());
+  return compressed;
+}
+
+uint32_t SsdFile::readCompressed(
+    const SsdRun& run,
+    AsyncDataCacheEntry& entry) {
+  process::TraceContext trace("SsdFile::readCompressed");
+  VELOX_CHECK_NOT_NULL(codec_);
+  std::string compressed(run.size(), 0);
+  readFile_->pread(run.offset(), run.size(), compressed.data());
+  uint32_t dataSize;
+  ::memcpy(&dataSize, compressed.data(), kCompressedHeaderSize);
+  if (FOLLY_UNLIKELY(dataSize < entry.size())) {
+    ++stats_.readSsdErrors;
+    VELOX_FAIL(
+        "IOERR: SSD cache cache entry {} short than requested range {}",
+        succinctBytes(dataSize),
+        succinctBytes(entry.size()));
+  }
+  std::string data(dataSize, 0);
+  const auto result = codec_->decompress(
+      reinterpret_cast<const uint8_t*>(
+          compressed.data() + kCompressedHeaderSize),
+      run.size() - kCompressedHeaderSize,
+      reinterpret_cast<uint8_t*>(data.data()),
+      dataSize);
+  if (FOLLY_UNLIKELY(result.hasError() || result.value() != dataSize)) {
+    ++stats_.readSsdCorruptions;
+    VELOX_FAIL(
+        "IOERR: Corrupt compressed SSD cache entry - File: {}, Offset: {}, "
+        "Size: {}",
+        fileName_,
+        run.offset(),
+        run.size());
+  }
+  copyToEntry(data.data(), entry);
+  return dataSize;
+}
+
 void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
@@ -247,8 +395,48 @@ void SsdFile::read(
   readFile_->preadv(offset, buffers);
 }
 
+void SsdFile::readBatches(
+    const std::vector<std::pair<uint64_t, std::vector<folly::Range<char*>>>>&
+        batches) {
+  const auto numParallel = std::min<int32_t>(
+      batches.size(), std::max(1, FLAGS_velox_ssd_max_parallel_reads));
+  if (numParallel <= 1 || executor_ == nullptr) {
+    for (const auto& [offset, buffers] : batches) {
+      read(offset, buffers);
+    }
+    return;
+  }
+
+  // The batches after the first are scheduled on 'executor_' and the ones no
+  // executor thread has started by the time they are needed are read on this
+  // thread. The batches past 'numParallel' are read on this thread after the
+  // first.
+  std::vector<std::shared_ptr<AsyncSource<bool>>> reads;
+  reads.reserve(numParallel - 1);
+  SCOPE_EXIT {
+    // Waits for the scheduled reads since they fill the entries of the caller.
+    for (auto& source : reads) {
+      source->close();
+    }
+  };
+  for (auto i = 1; i < numParallel; ++i) {
+    reads.push_back(std::make_shared<AsyncSource<bool>>([this, &batches, i]() {
+      read(batches[i].first, batches[i].second);
+      return std::make_unique<bool>(true);
+    }));
+    executor_->add([source = reads.back()]() { source->prepare(); });
+  }
+  read(batches[0].first, batches[0].second);
+  for (auto i = numParallel; i < batches.size(); ++i) {
+    read(batches[i].first, batches[i].second);
+  }
+  for (auto& source : reads) {
+    source->move();
+  }
+}
+
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<int32_t>& sizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -263,13 +451,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const auto offset = regionSizes_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+    for (; next < sizes.size(); ++next) {
+      if (sizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= sizes[next];
+      toWrite += sizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -353,9 +540,23 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
   }
 
+  // The compressed data of the entries, empty for the ones stored as is, and
+  // the sizes the entries take on SSD.
+  std::vector<std::string> compressed(codec_ != nullptr ? pins.size() : 0);
+  std::vector<int32_t> sizes(pins.size());
+  for (auto i = 0; i < pins.size(); ++i) {
+    auto* entry = pins[i].checkedEntry();
+    if (codec_ != nullptr) {
+      compressed[i] = compressEntry(*entry);
+    }
+    sizes[i] = compressed.empty() || compressed[i].empty()
+        ? entry->size()
+        : compressed[i].size();
+  }
+
   int32_t writeIndex = 0;
   while (writeIndex < pins.size()) {
-    auto space = getSpace(pins, writeIndex);
+    auto space = getSpace(sizes, writeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       ++stats_.writeSsdDropped;
@@ -369,8 +570,10 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     std::vector<iovec> writeIovecs;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      const auto numIovecs = numIoVectorsFromEntry(*entry);
+      const bool isCompressed = !compressed.empty() && !compressed[i].empty();
+      const auto entrySize = sizes[i];
+      const auto numIovecs =
+          isCompressed ? 1 : numIoVectorsFromEntry(*entry);
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
       if (writeIovecs.size() + numIovecs > IOV_MAX) {
         // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
@@ -387,7 +590,12 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       if (writeLength + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, writeIovecs);
+      if (isCompressed) {
+        writeIovecs.push_back(
+            {compressed[i].data(), static_cast<size_t>(entrySize)});
+      } else {
+        addEntryToIovecs(*entry, writeIovecs);
+      }
       writeLength += entrySize;
       ++numWrittenEntries;
     }
@@ -409,15 +617,27 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         auto* entry = pins[i].checkedEntry();
         VELOX_CHECK_NULL(entry->ssdFile());
         entry->setSsdFile(this, offset);
-        const auto size = entry->size();
+        const auto size = sizes[i];
+        const bool isCompressed = size < entry->size();
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
         uint32_t checksum = 0;
         if (checksumEnabled_) {
           checksum = checksumEntry(*entry);
         }
-        entries_[std::move(key)] = SsdRun(offset, size, checksum);
-        if (FLAGS_velox_ssd_verify_write) {
+        entries_[std::move(key)] =
+            SsdRun(offset, size, checksum, isCompressed);
+        if (isCompressed) {
+          stats_.bytesSavedByCompression += entry->size() - size;
+        }
+        if (groupStats_ != nullptr) {
+          tracker_.regionWritten(
+              regionIndex(offset),
+              size,
+              groupStats_->reuseProbability(
+                  entry->groupId(), entry->trackingId()));
+        }
+        if (FLAGS_velox_ssd_verify_write && !isCompressed) {
           verifyWrite(*entry, SsdRun(offset, size, checksum));
         }
         offset += size;
@@ -492,6 +712,13 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   }
 }
 
+void SsdFile::appendRanges(CachedRanges& ranges) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& [key, run] : entries_) {
+    ranges[key.fileNum.id()].emplace_back(key.offset, run.size());
+  }
+}
+
 void SsdFile::updateStats(SsdCacheStats& stats) const {
   // Lock only in tsan build. Incrementing the counters has no synchronized
   // semantics.
@@ -525,6 +752,7 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
   stats.readSsdCorruptions += stats_.readSsdCorruptions;
   stats.readWithoutChecksumChecks += stats_.readWithoutChecksumChecks;
+  stats.bytesSavedByCompression += stats_.bytesSavedByCompression;
 }
 
 void SsdFile::clear() {
@@ -893,16 +1121,17 @@ uint32_t SsdFile::checksumEntry(const AsyncDataCacheEntry& entry) const {
 
 void SsdFile::maybeVerifyChecksum(
     const AsyncDataCacheEntry& entry,
-    const SsdRun& ssdRun) {
+    const SsdRun& ssdRun,
+    uint32_t dataSize) {
   if (!checksumReadVerificationEnabled_) {
     return;
   }
-  VELOX_DCHECK_EQ(ssdRun.size(), entry.size());
-  if (ssdRun.size() != entry.size()) {
+  VELOX_DCHECK_EQ(dataSize, entry.size());
+  if (dataSize != entry.size()) {
     ++stats_.readWithoutChecksumChecks;
     VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
         << "SSD read without checksum due to cache request size mismatch, SSD cache size "
-        << ssdRun.size() << " request size " << entry.size()
+        << dataSize << " request size " << entry.size()
         << ", cache request: " << entry.toString();
     return;
   }
@@ -1040,6 +1269,10 @@ void SsdFile::readCheckpoint() {
     if (evictedMap.find(region) != evictedMap.end()) {
       continue;
     }
+    if (run.compressed() && codec_ == nullptr) {
+      // The entry was written with compression, which is off now.
+      continue;
+    }
     // The file may have a different id on restore.
     const auto it = idMap.find(fileNum);
     VELOX_CHECK(it != idMap.end());
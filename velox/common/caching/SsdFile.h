@@ -21,6 +21,7 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileInputStream.h"
 #include "velox/common/file/FileSystems.h"
@@ -33,16 +34,27 @@ class SsdCacheTestHelper;
 } // namespace test
 
 /// A 64 bit word describing a SSD cache entry in an SsdFile. The low 23 bits
-/// are the size, for a maximum entry size of 8MB. The high bits are the offset.
+/// are the size, for a maximum entry size of 8MB. The next 40 bits are the
+/// offset. The highest bit is set if the entry is stored compressed, see
+/// SsdFile::Config::compressionKind. The size is the stored size then.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
+  static constexpr int32_t kOffsetBits = 40;
+  static constexpr uint64_t kCompressedBit = 1ULL << 63;
 
   SsdRun() : fileBits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum)
-      : fileBits_((offset << kSizeBits) | ((size - 1))), checksum_(checksum) {
-    VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
+  SsdRun(
+      uint64_t offset,
+      uint32_t size,
+      uint32_t checksum,
+      bool compressed = false)
+      : fileBits_(
+            (offset << kSizeBits) | ((size - 1)) |
+            (compressed ? kCompressedBit : 0)),
+        checksum_(checksum) {
+    VELOX_CHECK_LT(offset, 1L << kOffsetBits);
     VELOX_CHECK_NE(size, 0);
     VELOX_CHECK_LE(size, 1 << kSizeBits);
   }
@@ -64,13 +76,18 @@ class SsdRun {
   }
 
   uint64_t offset() const {
-    return (fileBits_ >> kSizeBits);
+    return (fileBits_ & ~kCompressedBit) >> kSizeBits;
   }
 
   uint32_t size() const {
     return (fileBits_ & ((1 << kSizeBits) - 1)) + 1;
   }
 
+  /// Returns true if the entry is stored compressed.
+  bool compressed() const {
+    return (fileBits_ & kCompressedBit) != 0;
+  }
+
   /// Returns the checksum computed with crc32.
   uint32_t checksum() const {
     return checksum_;
@@ -171,6 +188,7 @@ struct SsdCacheStats {
     readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
     readWithoutChecksumChecks =
         tsanAtomicValue(other.readWithoutChecksumChecks);
+    bytesSavedByCompression = tsanAtomicValue(other.bytesSavedByCompression);
   }
 
   SsdCacheStats operator-(const SsdCacheStats& other) const {
@@ -202,6 +220,8 @@ struct SsdCacheStats {
         readCheckpointErrors - other.readCheckpointErrors;
     result.readWithoutChecksumChecks =
         readWithoutChecksumChecks - other.readWithoutChecksumChecks;
+    result.bytesSavedByCompression =
+        bytesSavedByCompression - other.bytesSavedByCompression;
     return result;
   }
 
@@ -238,6 +258,8 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> readCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdCorruptions{0};
   tsan_atomic<uint32_t> readWithoutChecksumChecks{0};
+  /// The bytes the compressed entries take less than uncompressed.
+  tsan_atomic<uint64_t> bytesSavedByCompression{0};
 };
 
 /// A shard of SsdCache. Corresponds to one file on SSD. The data backed by each
@@ -257,7 +279,10 @@ class SsdFile {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        FileGroupStats* _groupStats = nullptr,
+        common::CompressionKind _compressionKind =
+            common::CompressionKind_NONE)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -266,7 +291,9 @@ class SsdFile {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          groupStats(_groupStats),
+          compressionKind(_compressionKind){};
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -292,6 +319,16 @@ class SsdFile {
 
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
+
+    /// If set, gives the reuse probability of the written entries, which
+    /// orders the regions for eviction, see SsdFileTracker::regionWritten().
+    FileGroupStats* groupStats;
+
+    /// If not NONE, the entries are compressed with this codec and stored
+    /// compressed if this makes them smaller. The checksum is of the
+    /// uncompressed data and is verified after decompression. The entries of
+    /// a checkpoint made with compression are dropped on recovery without.
+    common::CompressionKind compressionKind;
   };
 
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
@@ -341,6 +378,10 @@ class SsdFile {
   /// Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
+  /// Adds the ranges of the cached entries to 'ranges'. The size of a
+  /// compressed entry is its stored size, which undercounts its range.
+  void appendRanges(CachedRanges& ranges) const;
+
   /// Remove cached entries of files in the fileNum set 'filesToRemove'. If
   /// successful, return true, and 'filesRetained' contains entries that should
   /// not be removed, ex., from pinned regions. Otherwise, return false and
@@ -419,10 +460,20 @@ class SsdFile {
   // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
   // if there is no space. The space does not necessarily cover all the pins, so
   // multiple calls starting at the first unwritten pin may be needed.
+  // 'sizes' are the sizes the pins take on SSD.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<int32_t>& sizes,
       int32_t begin);
 
+  // Returns the data of 'entry' compressed with 'codec_', prefixed with its
+  // uncompressed size, or an empty string if compression does not make it
+  // smaller.
+  std::string compressEntry(const AsyncDataCacheEntry& entry) const;
+
+  // Reads the compressed 'run' into 'entry' and returns the uncompressed size
+  // of 'run'.
+  uint32_t readCompressed(const SsdRun& run, AsyncDataCacheEntry& entry);
+
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regions);
@@ -434,6 +485,13 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // Reads the coalesced 'batches' of {offset, buffers}. Up to
+  // FLAGS_velox_ssd_max_parallel_reads of these are in flight at a time on
+  // 'executor_' so that the device gets more than one IO at a time.
+  void readBatches(
+      const std::vector<
+          std::pair<uint64_t, std::vector<folly::Range<char*>>>>& batches);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
@@ -476,9 +534,12 @@ class SsdFile {
     return force || (bytesAfterCheckpoint_ >= checkpointIntervalBytes_);
   }
 
+  // Verifies the checksum of 'entry' read from 'ssdRun'. 'dataSize' is the
+  // uncompressed size of 'ssdRun'.
   void maybeVerifyChecksum(
       const AsyncDataCacheEntry& entry,
-      const SsdRun& ssdRun);
+      const SsdRun& ssdRun,
+      uint32_t dataSize);
 
   // Disable 'copy on write'. Will throw if failed for any reason, including
   // file system not supporting cow feature.
@@ -603,9 +664,14 @@ class SsdFile {
   // means no checkpointing. This is set to 0 if checkpointing fails.
   int64_t checkpointIntervalBytes_{0};
 
-  // Executor for async fsync in checkpoint.
+  // Executor for async fsync in checkpoint and the parallel reads of a load.
   folly::Executor* executor_;
 
+  FileGroupStats* const groupStats_;
+
+  // Codec for the compressed entries, nullptr if not compressing.
+  std::unique_ptr<common::Codec> codec_;
+
   // Count of bytes written after last checkpoint.
   std::atomic<uint64_t> bytesAfterCheckpoint_{0};
 
@@ -32,7 +32,13 @@ void SsdFileTracker::fileTouched(int32_t totalEntries) {
 void SsdFileTracker::regionFilled(int32_t region) {
   const double best =
       *std::max_element(regionScores_.begin(), regionScores_.end());
-  regionScores_[region] = std::max<double>(regionScores_[region], best * 1.1);
+  const double reuse = regionWrittenBytes_[region] > 0
+      ? regionReuseBytes_[region] / regionWrittenBytes_[region]
+      : 1;
+  const double scorePct = kMinFilledScorePct +
+      (kMaxFilledScorePct - kMinFilledScorePct) * reuse;
+  regionScores_[region] =
+      std::max<double>(regionScores_[region], best * scorePct / 100);
 }
 
 std::vector<int32_t> SsdFileTracker::findEvictionCandidates(
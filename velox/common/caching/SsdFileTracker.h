@@ -31,6 +31,8 @@ class SsdFileTracker {
  public:
   void resize(int32_t numRegions) {
     resizeTsanAtomic(regionScores_, numRegions);
+    regionWrittenBytes_.resize(numRegions);
+    regionReuseBytes_.resize(numRegions);
   }
 
   void regionRead(int32_t region, int32_t bytes) {
@@ -39,12 +41,25 @@ class SsdFileTracker {
 
   void regionCleared(int32_t region) {
     regionScores_[region] = 0;
+    regionWrittenBytes_[region] = 0;
+    regionReuseBytes_[region] = 0;
+  }
+
+  /// Records that 'bytes' of data with an estimated probability of 'reuse' to
+  /// be read again, see FileGroupStats::reuseProbability(), were written to
+  /// 'region'.
+  void regionWritten(int32_t region, int32_t bytes, double reuse) {
+    regionWrittenBytes_[region] += bytes;
+    regionReuseBytes_[region] += bytes * reuse;
   }
 
   // Marks that a region has been filled and transits from writable to
   // evictable. Set its score to be at least the best score + a small margin so
   // that it gets time to live. Otherwise, it has had the least time to get hits
-  // and would be the first evicted.
+  // and would be the first evicted. The margin shrinks down to
+  // 'kMinFilledScorePct' of the best score for the regions written with the
+  // data that is not expected to be read again, so that these are evicted
+  // before the ones with the data that is read over and over.
   void regionFilled(int32_t region);
 
   // Increments event count and periodically decays
@@ -89,13 +104,24 @@ class SsdFileTracker {
   /// NOTE: this is only used by test and Prestissimo worker operation.
   void clear() {
     std::fill(regionScores_.begin(), regionScores_.end(), 0);
+    std::fill(regionWrittenBytes_.begin(), regionWrittenBytes_.end(), 0);
+    std::fill(regionReuseBytes_.begin(), regionReuseBytes_.end(), 0);
   }
 
  private:
   static constexpr int32_t kDecayInterval = 1000;
 
+  static constexpr int32_t kMinFilledScorePct = 50;
+  static constexpr int32_t kMaxFilledScorePct = 110;
+
   std::vector<tsan_atomic<double>> regionScores_;
 
+  // The bytes written to each region since it was cleared, and the same
+  // weighted by their reuse probability. 0 if not recorded, which counts as
+  // full reuse.
+  std::vector<double> regionWrittenBytes_;
+  std::vector<double> regionReuseBytes_;
+
   // Count of lookups. The scores are decayed every time the count goes
   // over kDecayInterval or half count of cache entries, whichever comes first.
   uint64_t numTouches_{0};
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MallocAllocator.h"
+
+DEFINE_int32(num_entries, 10'000, "The number of cached entries");
+DEFINE_int32(entry_size, 4096, "The size in bytes of a cached entry");
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+std::shared_ptr<memory::MemoryAllocator> allocator;
+std::shared_ptr<AsyncDataCache> cache;
+std::unique_ptr<StringIdLease> file;
+
+RawFileCacheKey key(int32_t index) {
+  return {file->id(), static_cast<uint64_t>(index) * FLAGS_entry_size};
+}
+
+void populate() {
+  allocator = std::make_shared<memory::MallocAllocator>(
+      2L * FLAGS_num_entries * FLAGS_entry_size + (64L << 20), 0);
+  cache = AsyncDataCache::create(allocator.get());
+  file = std::make_unique<StringIdLease>(
+      fileIds(), std::string_view("AsyncDataCacheBenchmark"));
+  for (auto i = 0; i < FLAGS_num_entries; ++i) {
+    auto pin = cache->findOrCreate(key(i), FLAGS_entry_size);
+    pin.checkedEntry()->setExclusiveToShared();
+  }
+}
+
+// Makes 'numLookups' hits on each of 'numThreads' threads. The threads
+// start at different entries and hit all the shards.
+void hits(uint32_t numLookups, int32_t numThreads) {
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    threads.emplace_back([i, numLookups]() {
+      int32_t index = i * FLAGS_num_entries / 64;
+      for (auto lookup = 0; lookup < numLookups; ++lookup) {
+        auto pin = cache->findOrCreate(
+            key(index++ % FLAGS_num_entries), FLAGS_entry_size);
+        folly::doNotOptimizeAway(pin.checkedEntry());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+} // namespace
+
+BENCHMARK_PARAM(hits, 1);
+BENCHMARK_RELATIVE_PARAM(hits, 2);
+BENCHMARK_RELATIVE_PARAM(hits, 4);
+BENCHMARK_RELATIVE_PARAM(hits, 8);
+BENCHMARK_RELATIVE_PARAM(hits, 16);
+BENCHMARK_RELATIVE_PARAM(hits, 32);
+
+int main(int argc, char** argv) {
+  folly::Init follyInit(&argc, &argv);
+  populate();
+  folly::runBenchmarks();
+  file.reset();
+  cache->shutdown();
+  cache.reset();
+  allocator.reset();
+  return 0;
+}
@@ -18,6 +18,7 @@
 #include "velox/common/base/Semaphore.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/CacheTTLController.h"
+#include "velox/common/caching/CacheSummary.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/caching/tests/CacheTestUtil.h"
@@ -1000,7 +1001,7 @@ TEST_P(AsyncDataCacheTest, cacheStats) {
       "[size 256: 0(0MB) allocated 0 mapped]\n"
       "]\n"
       "SSD: Ssd cache IO: Write 0B read 0B Size 512.00MB Occupied 0B 0K entries.\n"
-      "GroupStats: <dummy FileGroupStats>";
+      "GroupStats: 0 groups 0 files tracked 0B, 100% cacheable";
   ASSERT_EQ(cache_->toString(), expectedDetailedCacheOutput);
   ASSERT_EQ(cache_->toString(true), expectedDetailedCacheOutput);
   const std::string expectedShortCacheOutput =
@@ -1076,6 +1077,66 @@ TEST_P(AsyncDataCacheTest, staleEntry) {
   ASSERT_EQ(stats.numHit, 1);
 }
 
+TEST_P(AsyncDataCacheTest, concurrentHits) {
+  constexpr uint64_t kRamBytes = 64UL << 20;
+  constexpr int32_t kNumEntries = 16;
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumLookups = 10'000;
+  constexpr uint64_t kSize = 1000;
+  initializeCache(kRamBytes, 0, 0);
+  StringIdLease file(fileIds(), std::string_view("concurrentHits"));
+  for (auto i = 0; i < kNumEntries; ++i) {
+    auto pin = cache_->findOrCreate({file.id(), i * kSize}, kSize);
+    ASSERT_TRUE(pin.entry()->isExclusive());
+    pin.entry()->setExclusiveToShared();
+  }
+  const auto numHits = cache_->refreshStats().numHit;
+
+  runThreads(kNumThreads, [&](int32_t threadIndex) {
+    for (auto i = 0; i < kNumLookups; ++i) {
+      const uint64_t offset = ((threadIndex + i) % kNumEntries) * kSize;
+      auto pin = cache_->findOrCreate({file.id(), offset}, kSize);
+      ASSERT_TRUE(pin.checkedEntry()->isShared());
+      ASSERT_EQ(pin.checkedEntry()->offset(), static_cast<int64_t>(offset));
+    }
+  });
+  const auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numHit - numHits, kNumThreads * kNumLookups);
+  ASSERT_EQ(stats.numEntries, kNumEntries);
+  ASSERT_EQ(stats.numShared, 0);
+}
+
+TEST_P(AsyncDataCacheTest, cacheSummary) {
+  constexpr uint64_t kRamBytes = 64UL << 20;
+  initializeCache(kRamBytes, 0, 0);
+  StringIdLease file(fileIds(), std::string_view("cacheSummaryFile"));
+  StringIdLease otherFile(fileIds(), std::string_view("cacheSummaryOther"));
+  // Ranges [0, 1000), [1000, 1500) and [4000, 5000) of 'file' are loaded.
+  for (auto [offset, size] : std::vector<std::pair<uint64_t, uint64_t>>{
+           {0, 1000}, {1000, 500}, {4000, 1000}}) {
+    auto pin = cache_->findOrCreate({file.id(), offset}, size);
+    pin.checkedEntry()->setExclusiveToShared();
+  }
+  // An entry being loaded is not counted.
+  auto exclusivePin = cache_->findOrCreate({otherFile.id(), 0}, 1000);
+  ASSERT_TRUE(exclusivePin.checkedEntry()->isExclusive());
+
+  CacheSummary summary(*cache_);
+  ASSERT_EQ(summary.numFiles(), 1);
+  ASSERT_EQ(summary.cachedBytes(file.id(), 0, 10'000), 2'500);
+  ASSERT_EQ(summary.cachedBytes(file.id(), 500, 4'000), 1'000 + 500);
+  ASSERT_EQ(summary.cachedBytes(file.id(), 1'500, 2'500), 0);
+  ASSERT_EQ(summary.cachedBytes(file.id(), 4'500, 100), 100);
+  ASSERT_EQ(summary.cachedBytes(otherFile.id(), 0, 1'000), 0);
+  ASSERT_TRUE(summary.mayContainFile("cacheSummaryFile"));
+
+  BloomFilter<> filter;
+  const auto serialized = summary.serializedFileFilter();
+  filter.merge(serialized.data());
+  ASSERT_TRUE(
+      filter.mayContain(CacheSummary::fileNameHash("cacheSummaryFile")));
+}
+
 TEST_P(AsyncDataCacheTest, shrinkCache) {
   constexpr uint64_t kRamBytes = 128UL << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
@@ -1442,6 +1503,68 @@ TEST_P(AsyncDataCacheTest, makeEvictable) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, noRetentionUnderMemoryPressure) {
+  constexpr uint64_t kRamBytes = 128UL << 20;
+  constexpr int kDataSize = 4096;
+  for (const bool underPressure : {false, true}) {
+    SCOPED_TRACE(fmt::format("underPressure: {}", underPressure));
+    AsyncDataCache::Options cacheOptions;
+    // Half of the capacity is allocated outside of the cache below.
+    cacheOptions.noRetentionMemoryRatio = underPressure ? 0.25 : 0.75;
+    initializeCache(kRamBytes, 0, 0, false, cacheOptions);
+    memory::Allocation allocation;
+    ASSERT_TRUE(allocator_->allocateNonContiguous(
+        memory::AllocationTraits::numPages(kRamBytes / 2), allocation));
+    ASSERT_EQ(cache_->underMemoryPressure(), underPressure);
+
+    const RawFileCacheKey key{filenames_[0].id(), 0};
+    auto pin = cache_->findOrCreate(key, kDataSize);
+    ASSERT_TRUE(pin.entry()->isExclusive());
+    pin.entry()->setExclusiveToShared(false);
+    const auto entryHelper = test::AsyncDataCacheEntryTestHelper(pin.entry());
+    ASSERT_EQ(entryHelper.accessStats().lastUse == 0, underPressure);
+    pin.clear();
+
+    // A hit makes the entry retainable again.
+    pin = cache_->findOrCreate(key, kDataSize);
+    ASSERT_FALSE(pin.entry()->isExclusive());
+    ASSERT_NE(
+        test::AsyncDataCacheEntryTestHelper(pin.entry()).accessStats().lastUse,
+        0);
+    pin.clear();
+    allocator_->freeNonContiguous(allocation);
+  }
+}
+
+TEST_P(AsyncDataCacheTest, shrinkEvictableFirst) {
+  constexpr uint64_t kRamBytes = 128UL << 20;
+  constexpr int kDataSize = 64 << 10;
+  constexpr int kNumEntries = 20;
+  initializeCache(kRamBytes);
+  std::vector<RawFileCacheKey> keys;
+  for (int i = 0; i < kNumEntries; ++i) {
+    keys.push_back(RawFileCacheKey{
+        filenames_[0].id(), static_cast<uint64_t>(i) * kDataSize});
+    auto pin = cache_->findOrCreate(keys.back(), kDataSize);
+    pin.entry()->setExclusiveToShared(false);
+  }
+  // The even entries are evictable.
+  for (int i = 0; i < kNumEntries; i += 2) {
+    cache_->makeEvictable(keys[i]);
+  }
+
+  ASSERT_GE(
+      cache_->shrink(kDataSize * kNumEntries / 2),
+      kDataSize * kNumEntries / 2);
+  for (int i = 0; i < kNumEntries; ++i) {
+    ASSERT_EQ(cache_->exists(keys[i]), i % 2 == 1) << i;
+  }
+
+  // The other entries are evicted if there are not enough evictable ones.
+  ASSERT_GE(cache_->shrink(kDataSize), kDataSize);
+  ASSERT_LT(cache_->refreshStats().numEntries, kNumEntries / 2);
+}
+
 TEST_P(AsyncDataCacheTest, ssdWriteOptions) {
   constexpr uint64_t kRamBytes = 16UL << 20; // 16 MB
   constexpr uint64_t kSsdBytes = 64UL << 20; // 64 MB
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/base/tests/GTestUtils.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+namespace {
+constexpr int32_t kStripeBytes = 1 << 20;
+
+// Simulates 'numScans' full scans of 'numFiles' files of 'numStripes' stripes
+// of 'groupId' that read the two streams of one column.
+void scan(
+    FileGroupStats& stats,
+    uint64_t groupId,
+    int32_t numFiles,
+    int32_t numStripes,
+    int32_t numScans) {
+  for (auto scan = 0; scan < numScans; ++scan) {
+    for (auto file = 0; file < numFiles; ++file) {
+      const uint64_t fileId = groupId * 1'000 + file;
+      stats.recordFile(fileId, groupId, numStripes);
+      for (auto stripe = 0; stripe < numStripes; ++stripe) {
+        for (auto id : {TrackingId(1), TrackingId(2)}) {
+          stats.recordReference(fileId, groupId, id, kStripeBytes);
+          stats.recordRead(fileId, groupId, id, kStripeBytes);
+        }
+      }
+    }
+  }
+}
+} // namespace
+
+TEST(FileGroupStatsTest, admission) {
+  FileGroupStats stats;
+  // A group of 10MB per stream read 10 times and a group of 100MB per stream
+  // read once.
+  scan(stats, 1, 2, 5, 10);
+  scan(stats, 2, 20, 5, 1);
+  stats.updateSsdFilter(1UL << 30, 0);
+  // Everything fits.
+  EXPECT_TRUE(stats.shouldSaveToSsd(1, TrackingId(1)));
+  EXPECT_TRUE(stats.shouldSaveToSsd(2, TrackingId(1)));
+  // Unknown groups and untracked streams are saved.
+  EXPECT_TRUE(stats.shouldSaveToSsd(3, TrackingId(1)));
+  EXPECT_TRUE(stats.shouldSaveToSsd(2, TrackingId()));
+
+  EXPECT_DOUBLE_EQ(stats.reuseProbability(1, TrackingId(1)), 0.9);
+  EXPECT_DOUBLE_EQ(stats.reuseProbability(2, TrackingId(2)), 0);
+  EXPECT_DOUBLE_EQ(stats.reuseProbability(3, TrackingId(1)), 1);
+
+  // Only the group that is read over and over fits.
+  stats.updateSsdFilter(100 << 20, 0);
+  EXPECT_TRUE(stats.shouldSaveToSsd(1, TrackingId(1)));
+  EXPECT_TRUE(stats.shouldSaveToSsd(1, TrackingId(2)));
+  EXPECT_FALSE(stats.shouldSaveToSsd(2, TrackingId(1)));
+  EXPECT_FALSE(stats.shouldSaveToSsd(2, TrackingId(2)));
+  EXPECT_TRUE(stats.shouldSaveToSsd(3, TrackingId(1)));
+  EXPECT_EQ(
+      stats.toString(100 << 20),
+      "2 groups 22 files tracked 220.00MB, 45.4545% cacheable, saving scores "
+      "over 1\n group 1: read 10 times\n group 2: read 1 times");
+
+  // A group of no known files is always saved.
+  stats.recordReference(10, 4, TrackingId(1), kStripeBytes);
+  EXPECT_TRUE(stats.shouldSaveToSsd(4, TrackingId(1)));
+}
+
+TEST(FileGroupStatsTest, decay) {
+  FileGroupStats stats;
+  scan(stats, 1, 1, 1, 4);
+  stats.updateSsdFilter(1UL << 30, 50);
+  EXPECT_DOUBLE_EQ(stats.reuseProbability(1, TrackingId(1)), 0.5);
+  // The streams that are no longer read decay to nothing and are dropped
+  // with their group.
+  for (auto i = 0; i < 30; ++i) {
+    stats.updateSsdFilter(1UL << 30, 50);
+  }
+  EXPECT_EQ(stats.numGroups(), 0);
+  EXPECT_DOUBLE_EQ(stats.reuseProbability(1, TrackingId(1)), 1);
+  VELOX_ASSERT_THROW(stats.updateSsdFilter(1UL << 30, 101), "(101 vs. 100)");
+}
+
+TEST(FileGroupStatsTest, maxGroups) {
+  constexpr int32_t kMaxGroups = 8;
+  FileGroupStats stats(kMaxGroups);
+  for (auto group = 0; group < 2 * kMaxGroups; ++group) {
+    // The higher groups are read more times.
+    scan(stats, group, 1, 1, 1 + group);
+  }
+  EXPECT_EQ(stats.numGroups(), kMaxGroups);
+  // Makes room for new groups by dropping the ones with the lowest scores.
+  stats.updateSsdFilter(1UL << 30, 0);
+  EXPECT_EQ(stats.numGroups(), kMaxGroups * 3 / 4);
+  EXPECT_EQ(stats.reuseProbability(0, TrackingId(1)), 1);
+  EXPECT_EQ(stats.reuseProbability(1, TrackingId(1)), 1);
+  EXPECT_DOUBLE_EQ(stats.reuseProbability(2, TrackingId(1)), 2.0 / 3);
+  scan(stats, 100, 1, 1, 1);
+  EXPECT_EQ(stats.numGroups(), kMaxGroups * 3 / 4 + 1);
+}
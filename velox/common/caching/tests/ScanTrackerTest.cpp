@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/ScanTracker.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+class ScanTrackerTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    ScanHistory::testingClear();
+  }
+
+  // Runs a scan of 'table' that references streams 1 and 2 'numStripes' times
+  // and reads only stream 1.
+  static void scan(const std::string& table, int32_t numStripes) {
+    ScanTracker tracker("scan", nullptr, 1 << 20, nullptr, history(table));
+    for (auto i = 0; i < numStripes; ++i) {
+      tracker.recordReference(TrackingId(1), 1000, 0, 0);
+      tracker.recordReference(TrackingId(2), 1000, 0, 0);
+      tracker.recordRead(TrackingId(1), 1000, 0, 0);
+    }
+  }
+
+  static std::shared_ptr<ScanHistory> history(const std::string& table) {
+    return ScanHistory::forTable(table);
+  }
+};
+
+TEST_F(ScanTrackerTest, history) {
+  scan("t", 10);
+  EXPECT_EQ(history("t"), history("t"));
+  EXPECT_NE(history("t"), history("u"));
+
+  ScanTracker tracker("scan", nullptr, 1 << 20, nullptr, history("t"));
+  // A new scan of a table starts with the history of the table.
+  tracker.recordReference(TrackingId(1), 1000, 0, 0);
+  tracker.recordReference(TrackingId(2), 1000, 0, 0);
+  auto data = tracker.trackingData(TrackingId(1));
+  EXPECT_EQ(data.referencedBytes, 11'000);
+  EXPECT_EQ(data.lastReferencedBytes, 1000);
+  EXPECT_EQ(data.readBytes, 10'000);
+  data = tracker.trackingData(TrackingId(2));
+  EXPECT_EQ(data.referencedBytes, 11'000);
+  EXPECT_EQ(data.readBytes, 0);
+  // The streams with no history and the other tables start from nothing.
+  EXPECT_EQ(tracker.trackingData(TrackingId(3)).referencedBytes, 0);
+  ScanTracker other("other", nullptr, 1 << 20, nullptr, history("u"));
+  EXPECT_EQ(other.trackingData(TrackingId(1)).referencedBytes, 0);
+
+  // The scan uses its own accesses once it has any.
+  tracker.recordRead(TrackingId(2), 1000, 0, 0);
+  tracker.recordReference(TrackingId(2), 1000, 0, 0);
+  data = tracker.trackingData(TrackingId(2));
+  EXPECT_EQ(data.referencedBytes, 2000);
+  EXPECT_EQ(data.readBytes, 1000);
+}
+
+TEST_F(ScanTrackerTest, decay) {
+  scan("t", 10);
+  scan("t", 2);
+  // The older scan counts for half.
+  const auto data = history("t")->trackingData(TrackingId(1));
+  ASSERT_TRUE(data.has_value());
+  EXPECT_EQ(data->referencedBytes, 7000);
+  EXPECT_EQ(data->readBytes, 7000);
+  EXPECT_FALSE(history("t")->trackingData(TrackingId(3)).has_value());
+}
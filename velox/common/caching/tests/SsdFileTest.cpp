@@ -37,6 +37,7 @@ using facebook::velox::memory::MemoryAllocator;
 
 DECLARE_bool(velox_ssd_odirect);
 DECLARE_bool(velox_ssd_verify_write);
+DECLARE_int32(velox_ssd_max_parallel_reads);
 
 // Represents an entry written to SSD.
 struct TestEntry {
@@ -74,7 +75,8 @@ class SsdFileTest : public testing::Test {
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
       bool disableFileCow = false,
-      bool enableFaultInjection = false) {
+      bool enableFaultInjection = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_velox_ssd_odirect = false;
     cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
@@ -88,7 +90,8 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        disableFileCow);
+        disableFileCow,
+        compressionKind);
   }
 
   void initializeSsdFile(
@@ -96,7 +99,8 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -105,7 +109,9 @@ class SsdFileTest : public testing::Test {
         disableFileCow,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        ssdExecutor());
+        ssdExecutor(),
+        nullptr,
+        compressionKind);
     ssdFile_ = std::make_unique<SsdFile>(config);
     if (ssdFile_ != nullptr) {
       ssdFileHelper_ =
@@ -401,6 +407,99 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, parallelReads) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(kSsdSize);
+  auto pins = makePins(fileName_.id(), 0, 128 << 10, 2048 * 1025, 32 * kMB);
+  ssdFile_->write(pins);
+  // Every other entry is loaded so that the gaps between the loaded entries
+  // are too large to coalesce.
+  std::vector<CachePin> loadPins;
+  for (auto i = 0; i < pins.size(); i += 2) {
+    loadPins.push_back(std::move(pins[i]));
+  }
+  for (auto maxParallelReads : {1, 3, 100}) {
+    SCOPED_TRACE(fmt::format("maxParallelReads {}", maxParallelReads));
+    FLAGS_velox_ssd_max_parallel_reads = maxParallelReads;
+    std::vector<SsdPin> ssdPins;
+    for (auto& pin : loadPins) {
+      const auto& data = pin.entry()->data();
+      for (auto i = 0; i < data.numRuns(); ++i) {
+        ::memset(data.runAt(i).data(), 0, data.runAt(i).numBytes());
+      }
+      ssdPins.push_back(ssdFile_->find(RawFileCacheKey{
+          pin.entry()->key().fileNum.id(), pin.entry()->key().offset}));
+    }
+    const auto stats = ssdFile_->load(ssdPins, loadPins);
+    EXPECT_EQ(stats.numIos, loadPins.size());
+    for (auto& pin : loadPins) {
+      checkContents(pin.entry()->data(), pin.entry()->size());
+    }
+  }
+  FLAGS_velox_ssd_max_parallel_reads = 8;
+}
+
+TEST_F(SsdFileTest, compression) {
+  if (!common::Codec::isAvailable(common::CompressionKind_LZ4)) {
+    GTEST_SKIP() << "LZ4 is not available";
+  }
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = SsdFile::kRegionSize;
+  initializeCache(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      false,
+      common::CompressionKind_LZ4);
+
+  std::vector<TestEntry> entries;
+  {
+    auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 32 * kMB);
+    ssdFile_->write(pins);
+    int64_t totalSize = 0;
+    for (auto& pin : pins) {
+      EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+      entries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+      totalSize += pin.entry()->size();
+      // Clears the contents so that they come from SSD.
+      const auto& data = pin.entry()->data();
+      for (auto i = 0; i < data.numRuns(); ++i) {
+        ::memset(data.runAt(i).data(), 0, data.runAt(i).numBytes());
+      }
+    }
+    SsdCacheStats stats;
+    ssdFile_->updateStats(stats);
+    EXPECT_GT(stats.bytesSavedByCompression, 0);
+    EXPECT_EQ(stats.bytesCached + stats.bytesSavedByCompression, totalSize);
+
+    // The compressed entries are decompressed and their checksums verified.
+    readAndCheckPins(pins);
+    stats.clear();
+    ssdFile_->updateStats(stats);
+    EXPECT_EQ(stats.readSsdCorruptions, 0);
+    EXPECT_EQ(stats.readWithoutChecksumChecks, 0);
+  }
+
+  // The compressed entries are recovered from the checkpoint with compression
+  // and dropped without.
+  cache_->clear();
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      common::CompressionKind_LZ4);
+  EXPECT_EQ(checkEntries(entries), entries.size());
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes, true, true);
+  EXPECT_EQ(checkEntries(entries), 0);
+}
+
 TEST_F(SsdFileTest, checkpoint) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
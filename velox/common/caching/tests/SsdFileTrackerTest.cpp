@@ -68,3 +68,31 @@ TEST(SsdFileTrackerTest, tracker) {
   candidates = tracker.findEvictionCandidates(3, kNumRegions, pins);
   EXPECT_EQ(candidates.size(), 3);
 }
+
+TEST(SsdFileTrackerTest, reuse) {
+  constexpr int32_t kNumRegions = 4;
+  SsdFileTracker tracker;
+  tracker.resize(kNumRegions);
+  tracker.regionRead(0, 1000);
+  // Region 1 has no recorded reuse, region 2 holds data that is read again
+  // and region 3 data that is read once.
+  tracker.regionFilled(1);
+  tracker.regionWritten(2, 100, 1);
+  tracker.regionFilled(2);
+  tracker.regionWritten(3, 100, 0);
+  tracker.regionFilled(3);
+  const auto scores = tracker.copyScores();
+  EXPECT_DOUBLE_EQ(scores[1], 1100);
+  EXPECT_DOUBLE_EQ(scores[2], 1210);
+  EXPECT_DOUBLE_EQ(scores[3], 605);
+
+  std::vector<int32_t> pins(kNumRegions);
+  EXPECT_EQ(
+      tracker.findEvictionCandidates(1, kNumRegions, pins),
+      std::vector<int32_t>{3});
+
+  // Clearing a region resets its written bytes.
+  tracker.regionCleared(3);
+  tracker.regionFilled(3);
+  EXPECT_DOUBLE_EQ(tracker.copyScores()[3], 1331);
+}
@@ -21,9 +21,36 @@
 #endif
 
 #include <folly/Conv.h>
+#include <folly/Synchronized.h>
 
 namespace facebook::velox::common {
 
+namespace {
+folly::Synchronized<std::unordered_map<CompressionKind, CodecFactory>>&
+codecFactories() {
+  static folly::Synchronized<std::unordered_map<CompressionKind, CodecFactory>>
+      factories;
+  return factories;
+}
+
+CodecFactory findCodecFactory(CompressionKind kind) {
+  return codecFactories().withRLock(
+      [&](const auto& factories) -> CodecFactory {
+        auto it = factories.find(kind);
+        return it == factories.end() ? nullptr : it->second;
+      });
+}
+} // namespace
+
+void registerCodecFactory(CompressionKind kind, CodecFactory factory) {
+  VELOX_CHECK_NOT_NULL(factory);
+  codecFactories().wlock()->insert_or_assign(kind, std::move(factory));
+}
+
+void unregisterCodecFactory(CompressionKind kind) {
+  codecFactories().wlock()->erase(kind);
+}
+
 std::unique_ptr<folly::compression::Codec> compressionKindToCodec(
     CompressionKind kind) {
   switch (static_cast<int32_t>(kind)) {
@@ -129,29 +156,34 @@ Expected<std::unique_ptr<Codec>> Codec::create(
 
   auto compressionLevel = codecOptions.compressionLevel;
   std::unique_ptr<Codec> codec;
-  switch (kind) {
+  if (auto factory = findCodecFactory(kind)) {
+    codec = factory(codecOptions);
+  } else {
+    switch (kind) {
 #ifdef VELOX_ENABLE_COMPRESSION_LZ4
-    case CompressionKind_LZ4: {
-      if (auto options = dynamic_cast<const Lz4CodecOptions*>(&codecOptions)) {
-        switch (options->lz4Type) {
-          case Lz4CodecOptions::kLz4Frame:
-            codec = makeLz4FrameCodec(compressionLevel);
-            break;
-          case Lz4CodecOptions::kLz4Raw:
-            codec = makeLz4RawCodec(compressionLevel);
-            break;
-          case Lz4CodecOptions::kLz4Hadoop:
-            codec = makeLz4HadoopCodec();
-            break;
+      case CompressionKind_LZ4: {
+        if (auto options =
+                dynamic_cast<const Lz4CodecOptions*>(&codecOptions)) {
+          switch (options->lz4Type) {
+            case Lz4CodecOptions::kLz4Frame:
+              codec = makeLz4FrameCodec(compressionLevel);
+              break;
+            case Lz4CodecOptions::kLz4Raw:
+              codec = makeLz4RawCodec(compressionLevel);
+              break;
+            case Lz4CodecOptions::kLz4Hadoop:
+              codec = makeLz4HadoopCodec();
+              break;
+          }
+        } else {
+          // By default, create LZ4 Frame codec.
+          codec = makeLz4FrameCodec(compressionLevel);
         }
-      } else {
-        // By default, create LZ4 Frame codec.
-        codec = makeLz4FrameCodec(compressionLevel);
-      }
-    } break;
+      } break;
 #endif
-    default:
-      break;
+      default:
+        break;
+    }
   }
   VELOX_RETURN_UNEXPECTED_IF(
       codec == nullptr,
@@ -171,6 +203,9 @@ Expected<std::unique_ptr<Codec>> Codec::create(
 }
 
 bool Codec::isAvailable(CompressionKind kind) {
+  if (findCodecFactory(kind) != nullptr) {
+    return true;
+  }
   switch (kind) {
 #ifdef VELOX_ENABLE_COMPRESSION_LZ4
     case CompressionKind_LZ4:
@@ -188,6 +223,17 @@ Expected<uint64_t> Codec::getUncompressedLength(
       "getUncompressedLength is unsupported with {} format.", name()));
 }
 
+std::vector<Expected<uint64_t>> Codec::decompressBatch(
+    folly::Range<const DecompressionJob*> jobs) {
+  std::vector<Expected<uint64_t>> results;
+  results.reserve(jobs.size());
+  for (const auto& job : jobs) {
+    results.push_back(decompress(
+        job.input, job.inputLength, job.output, job.outputLength));
+  }
+  return results;
+}
+
 Expected<uint64_t> Codec::compressFixedLength(
     const uint8_t* input,
     uint64_t inputLength,
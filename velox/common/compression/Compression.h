@@ -18,8 +18,11 @@
 
 #include <fmt/format.h>
 #include <folly/Expected.h>
+#include <folly/Range.h>
 #include <folly/compression/Compression.h>
+#include <functional>
 #include <string>
+#include <vector>
 
 #include "velox/common/base/Status.h"
 
@@ -63,6 +66,15 @@ struct CodecOptions {
   virtual ~CodecOptions() = default;
 };
 
+/// A block to decompress from 'input' into 'output'. 'outputLength' is the
+/// capacity of 'output' and must fit the decompressed block.
+struct DecompressionJob {
+  const uint8_t* input;
+  uint64_t inputLength;
+  uint8_t* output;
+  uint64_t outputLength;
+};
+
 /// Codec interface for compression and decompression.
 /// The Codec class provides a common interface for various compression
 /// algorithms to support one-shot compression and decompression.
@@ -137,6 +149,12 @@ class Codec {
       uint8_t* output,
       uint64_t outputLength) = 0;
 
+  /// Decompresses a batch of blocks with one-shot decompression and returns
+  /// the decompressed length of each. The default decompresses the blocks one
+  /// at a time. Codecs that offload to a device submit them together.
+  virtual std::vector<Expected<uint64_t>> decompressBatch(
+      folly::Range<const DecompressionJob*> jobs);
+
   /// Performs one-shot compression.
   /// This function compresses data and writes the output up to the specified
   /// outputLength. If outputLength is too small to hold all the compressed
@@ -193,6 +211,18 @@ class Codec {
   virtual Status init();
 };
 
+using CodecFactory =
+    std::function<std::unique_ptr<Codec>(const CodecOptions& codecOptions)>;
+
+/// Registers 'factory' to create the codecs of 'kind' in Codec::create(). Takes
+/// precedence over the built-in codec of 'kind' and replaces the factory
+/// registered before, e.g. to plug in a codec that is not built in or one that
+/// offloads to an accelerator.
+void registerCodecFactory(CompressionKind kind, CodecFactory factory);
+
+/// Removes the factory registered for 'kind'. No-op if there is none.
+void unregisterCodecFactory(CompressionKind kind);
+
 /// Base class for streaming compressors. Unlike one-shot compression, streaming
 /// compression can compress data with arbitrary length and write the compressed
 /// data through multiple calls to compress().
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/CompressionAccelerator.h"
+#include "velox/common/base/Exceptions.h"
+
+#include <folly/Synchronized.h>
+
+namespace facebook::velox::common {
+
+namespace {
+
+folly::Synchronized<std::shared_ptr<CompressionAccelerator>>&
+registeredAccelerator() {
+  static folly::Synchronized<std::shared_ptr<CompressionAccelerator>>
+      accelerator;
+  return accelerator;
+}
+
+// Decompresses on the accelerator and does everything else with the wrapped
+// software codec.
+class AcceleratedCodec : public Codec {
+ public:
+  AcceleratedCodec(
+      std::unique_ptr<Codec> codec,
+      std::shared_ptr<CompressionAccelerator> accelerator)
+      : codec_(std::move(codec)), accelerator_(std::move(accelerator)) {
+    VELOX_CHECK_NOT_NULL(codec_);
+    VELOX_CHECK_NOT_NULL(accelerator_);
+  }
+
+  int32_t minCompressionLevel() const override {
+    return codec_->minCompressionLevel();
+  }
+
+  int32_t maxCompressionLevel() const override {
+    return codec_->maxCompressionLevel();
+  }
+
+  int32_t defaultCompressionLevel() const override {
+    return codec_->defaultCompressionLevel();
+  }
+
+  Expected<uint64_t> compress(
+      const uint8_t* input,
+      uint64_t inputLength,
+      uint8_t* output,
+      uint64_t outputLength) override {
+    return codec_->compress(input, inputLength, output, outputLength);
+  }
+
+  Expected<uint64_t> decompress(
+      const uint8_t* input,
+      uint64_t inputLength,
+      uint8_t* output,
+      uint64_t outputLength) override {
+    const DecompressionJob job{input, inputLength, output, outputLength};
+    return std::move(decompressBatch(folly::Range(&job, 1))[0]);
+  }
+
+  std::vector<Expected<uint64_t>> decompressBatch(
+      folly::Range<const DecompressionJob*> jobs) override {
+    return accelerator_->decompress(
+        codec_->compressionKind(), jobs, [&](const DecompressionJob& job) {
+          return codec_->decompress(
+              job.input, job.inputLength, job.output, job.outputLength);
+        });
+  }
+
+  Expected<uint64_t> compressFixedLength(
+      const uint8_t* input,
+      uint64_t inputLength,
+      uint8_t* output,
+      uint64_t outputLength) override {
+    return codec_->compressFixedLength(
+        input, inputLength, output, outputLength);
+  }
+
+  uint64_t maxCompressedLength(uint64_t inputLength) override {
+    return codec_->maxCompressedLength(inputLength);
+  }
+
+  Expected<uint64_t> getUncompressedLength(
+      const uint8_t* input,
+      uint64_t inputLength) const override {
+    return codec_->getUncompressedLength(input, inputLength);
+  }
+
+  bool supportsStreamingCompression() const override {
+    return codec_->supportsStreamingCompression();
+  }
+
+  Expected<std::shared_ptr<StreamingCompressor>> makeStreamingCompressor()
+      override {
+    return codec_->makeStreamingCompressor();
+  }
+
+  Expected<std::shared_ptr<StreamingDecompressor>> makeStreamingDecompressor()
+      override {
+    return codec_->makeStreamingDecompressor();
+  }
+
+  CompressionKind compressionKind() const override {
+    return codec_->compressionKind();
+  }
+
+  int32_t compressionLevel() const override {
+    return codec_->compressionLevel();
+  }
+
+  std::string_view name() const override {
+    return codec_->name();
+  }
+
+ private:
+  const std::unique_ptr<Codec> codec_;
+  const std::shared_ptr<CompressionAccelerator> accelerator_;
+};
+
+} // namespace
+
+std::vector<Expected<uint64_t>> CompressionAccelerator::decompress(
+    CompressionKind kind,
+    folly::Range<const DecompressionJob*> jobs,
+    const std::function<Expected<uint64_t>(const DecompressionJob&)>&
+        fallback) {
+  std::vector<Expected<uint64_t>> results(jobs.size());
+  auto futures = submitDecompression(kind, jobs);
+  const auto numAccepted = futures.size();
+  VELOX_CHECK_LE(numAccepted, jobs.size());
+  numRejected_ += jobs.size() - numAccepted;
+
+  // The device writes to the buffers of the accepted jobs until their futures
+  // complete, so an error of the fallback is rethrown after waiting for them.
+  std::exception_ptr fallbackError;
+  try {
+    for (auto i = numAccepted; i < jobs.size(); ++i) {
+      results[i] = fallback(jobs[i]);
+    }
+  } catch (...) {
+    fallbackError = std::current_exception();
+  }
+
+  std::vector<size_t> failedJobs;
+  for (size_t i = 0; i < numAccepted; ++i) {
+    auto result = std::move(futures[i]).getTry();
+    if (result.hasValue() && result->hasValue()) {
+      results[i] = std::move(result.value());
+    } else {
+      failedJobs.push_back(i);
+    }
+  }
+  numAccelerated_ += numAccepted - failedJobs.size();
+  numFailed_ += failedJobs.size();
+  if (fallbackError) {
+    std::rethrow_exception(fallbackError);
+  }
+  for (auto i : failedJobs) {
+    results[i] = fallback(jobs[i]);
+  }
+  return results;
+}
+
+CompressionAccelerator::Stats CompressionAccelerator::stats() const {
+  return Stats{
+      .numAccelerated = numAccelerated_,
+      .numRejected = numRejected_,
+      .numFailed = numFailed_};
+}
+
+void registerCompressionAccelerator(
+    std::shared_ptr<CompressionAccelerator> accelerator) {
+  *registeredAccelerator().wlock() = std::move(accelerator);
+}
+
+std::shared_ptr<CompressionAccelerator> compressionAccelerator(
+    CompressionKind kind) {
+  auto accelerator = registeredAccelerator().copy();
+  if (accelerator == nullptr || !accelerator->supportsDecompression(kind)) {
+    return nullptr;
+  }
+  return accelerator;
+}
+
+std::unique_ptr<Codec> makeAcceleratedCodec(
+    std::unique_ptr<Codec> codec,
+    std::shared_ptr<CompressionAccelerator> accelerator) {
+  return std::make_unique<AcceleratedCodec>(
+      std::move(codec), std::move(accelerator));
+}
+
+} // namespace facebook::velox::common
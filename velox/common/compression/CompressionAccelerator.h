@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/futures/Future.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "velox/common/compression/Compression.h"
+
+namespace facebook::velox::common {
+
+/// Interface of a device that offloads decompression, e.g. Intel QAT or IAA.
+/// A backend implements submitDecompression() over the submission queue of
+/// its device and registers itself with registerCompressionAccelerator().
+/// decompress() adds batching and the software fallback on top.
+///
+/// The formats of the kinds are those of the file readers: ZLIB is raw
+/// deflate as in DWRF and ORC, GZIP is the gzip format, ZSTD and SNAPPY are
+/// single frames and LZ4 is a raw LZ4 block.
+class CompressionAccelerator {
+ public:
+  struct Stats {
+    /// Number of jobs decompressed on the device.
+    uint64_t numAccelerated{0};
+    /// Number of jobs decompressed in software because the submission queue
+    /// of the device was full.
+    uint64_t numRejected{0};
+    /// Number of jobs decompressed in software after the device failed them.
+    uint64_t numFailed{0};
+  };
+
+  virtual ~CompressionAccelerator() = default;
+
+  virtual std::string_view name() const = 0;
+
+  /// Returns true if the device decompresses 'kind'.
+  virtual bool supportsDecompression(CompressionKind kind) const = 0;
+
+  /// Submits 'jobs' to the device as one batch without waiting for them.
+  /// Returns a future for each of the leading jobs that the device accepted,
+  /// which are fewer than 'jobs' if the submission queue of the device is
+  /// full. A future holds the decompressed length of its job or the error of
+  /// the device. The buffers of the accepted jobs must stay valid until their
+  /// futures complete.
+  virtual std::vector<folly::SemiFuture<Expected<uint64_t>>>
+  submitDecompression(
+      CompressionKind kind,
+      folly::Range<const DecompressionJob*> jobs) = 0;
+
+  /// Decompresses 'jobs' on the device as one batch and returns the
+  /// decompressed length of each. Runs the jobs that the device does not
+  /// accept or fails with 'fallback' on the calling thread. The rejected jobs
+  /// run while the accepted ones are in flight. Waits for all accepted jobs
+  /// before returning or throwing.
+  std::vector<Expected<uint64_t>> decompress(
+      CompressionKind kind,
+      folly::Range<const DecompressionJob*> jobs,
+      const std::function<Expected<uint64_t>(const DecompressionJob&)>&
+          fallback);
+
+  Stats stats() const;
+
+ private:
+  std::atomic_uint64_t numAccelerated_{0};
+  std::atomic_uint64_t numRejected_{0};
+  std::atomic_uint64_t numFailed_{0};
+};
+
+/// Sets the accelerator that the file readers offload decompression to and
+/// replaces the one set before. nullptr removes it.
+void registerCompressionAccelerator(
+    std::shared_ptr<CompressionAccelerator> accelerator);
+
+/// Returns the registered accelerator if it decompresses 'kind', otherwise
+/// nullptr.
+std::shared_ptr<CompressionAccelerator> compressionAccelerator(
+    CompressionKind kind);
+
+/// Returns a codec that decompresses on 'accelerator' and falls back to
+/// 'codec' for the blocks that 'accelerator' rejects or fails. Compresses with
+/// 'codec'. 'codec' must produce the format of its kind that 'accelerator'
+/// expects. A backend can register this with registerCodecFactory() to make
+/// Codec::create() offload its kinds.
+std::unique_ptr<Codec> makeAcceleratedCodec(
+    std::unique_ptr<Codec> codec,
+    std::shared_ptr<CompressionAccelerator> accelerator);
+
+} // namespace facebook::velox::common
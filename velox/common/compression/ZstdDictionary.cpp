@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/ZstdDictionary.h"
+#include "velox/common/base/Exceptions.h"
+
+#include <glog/logging.h>
+#include <zdict.h>
+#include <zstd.h>
+
+namespace facebook::velox::common {
+
+namespace {
+// ZSTD trains better on many small samples than on a few large ones, so the
+// samples are cut into pieces of at most this size.
+constexpr size_t kMaxSamplePieceSize = 8 << 10;
+
+// Returns the contiguous bytes of 'input', coalescing a chain into 'buffer'.
+folly::ByteRange contiguousBytes(
+    const folly::IOBuf& input,
+    std::string& buffer) {
+  if (!input.isChained()) {
+    return {input.data(), input.length()};
+  }
+  buffer.reserve(input.computeChainDataLength());
+  for (const auto range : input) {
+    buffer.append(reinterpret_cast<const char*>(range.data()), range.size());
+  }
+  return {reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size()};
+}
+} // namespace
+
+// static
+std::shared_ptr<ZstdDictionary> ZstdDictionary::train(
+    const std::vector<std::string>& samples,
+    size_t maxSize,
+    int32_t compressionLevel) {
+  std::string sampleBuffer;
+  std::vector<size_t> sampleSizes;
+  for (const auto& sample : samples) {
+    sampleBuffer.append(sample);
+    for (size_t offset = 0; offset < sample.size();
+         offset += kMaxSamplePieceSize) {
+      sampleSizes.push_back(
+          std::min(kMaxSamplePieceSize, sample.size() - offset));
+    }
+  }
+  std::string content(maxSize, '\0');
+  const auto size = ZDICT_trainFromBuffer(
+      content.data(),
+      content.size(),
+      sampleBuffer.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  if (ZDICT_isError(size)) {
+    VLOG(1) << "Failed to train ZSTD dictionary on " << sampleSizes.size()
+            << " samples of " << sampleBuffer.size()
+            << " bytes: " << ZDICT_getErrorName(size);
+    return nullptr;
+  }
+  content.resize(size);
+  return std::make_shared<ZstdDictionary>(std::move(content), compressionLevel);
+}
+
+ZstdDictionary::ZstdDictionary(std::string content, int32_t compressionLevel)
+    : content_(std::move(content)),
+      id_(ZDICT_getDictID(content_.data(), content_.size())),
+      compressionDictionary_(ZSTD_createCDict(
+          content_.data(),
+          content_.size(),
+          compressionLevel)),
+      decompressionDictionary_(
+          ZSTD_createDDict(content_.data(), content_.size())) {
+  VELOX_CHECK_NE(id_, 0, "Not a trained ZSTD dictionary");
+  VELOX_CHECK_NOT_NULL(compressionDictionary_);
+  VELOX_CHECK_NOT_NULL(decompressionDictionary_);
+}
+
+ZstdDictionary::~ZstdDictionary() {
+  ZSTD_freeCDict(compressionDictionary_);
+  ZSTD_freeDDict(decompressionDictionary_);
+}
+
+std::unique_ptr<folly::IOBuf> ZstdDictionary::compress(
+    const folly::IOBuf& input) const {
+  std::string buffer;
+  const auto bytes = contiguousBytes(input, buffer);
+  auto output = folly::IOBuf::create(ZSTD_compressBound(bytes.size()));
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(
+      ZSTD_createCCtx(), ZSTD_freeCCtx);
+  VELOX_CHECK_NOT_NULL(context);
+  const auto size = ZSTD_compress_usingCDict(
+      context.get(),
+      output->writableData(),
+      output->capacity(),
+      bytes.data(),
+      bytes.size(),
+      compressionDictionary_);
+  VELOX_CHECK(
+      !ZSTD_isError(size),
+      "ZSTD dictionary compression failed: {}",
+      ZSTD_getErrorName(size));
+  output->append(size);
+  return output;
+}
+
+std::unique_ptr<folly::IOBuf> ZstdDictionary::decompress(
+    const folly::IOBuf& input,
+    uint64_t uncompressedSize) const {
+  std::string buffer;
+  const auto bytes = contiguousBytes(input, buffer);
+  const auto frameId = ZSTD_getDictID_fromFrame(bytes.data(), bytes.size());
+  VELOX_CHECK_EQ(
+      frameId, id_, "ZSTD frame is compressed with another dictionary");
+  auto output = folly::IOBuf::create(uncompressedSize);
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(
+      ZSTD_createDCtx(), ZSTD_freeDCtx);
+  VELOX_CHECK_NOT_NULL(context);
+  const auto size = ZSTD_decompress_usingDDict(
+      context.get(),
+      output->writableData(),
+      uncompressedSize,
+      bytes.data(),
+      bytes.size(),
+      decompressionDictionary_);
+  VELOX_CHECK(
+      !ZSTD_isError(size),
+      "ZSTD dictionary decompression failed: {}",
+      ZSTD_getErrorName(size));
+  VELOX_CHECK_EQ(size, uncompressedSize);
+  output->append(size);
+  return output;
+}
+
+} // namespace facebook::velox::common
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/io/IOBuf.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace facebook::velox::common {
+
+/// A trained ZSTD dictionary, digested for compression and decompression.
+/// Small inputs with shared content, e.g. the pages of one stream, compress
+/// poorly on their own because each starts without history. With a dictionary
+/// trained on samples of them they compress as if they were one input.
+class ZstdDictionary {
+ public:
+  static constexpr int32_t kDefaultCompressionLevel = 3;
+
+  /// Trains a dictionary of at most 'maxSize' bytes on 'samples'. Returns
+  /// nullptr if ZSTD can not train one, e.g. because the samples are too few
+  /// or too small.
+  static std::shared_ptr<ZstdDictionary> train(
+      const std::vector<std::string>& samples,
+      size_t maxSize,
+      int32_t compressionLevel = kDefaultCompressionLevel);
+
+  /// Makes a dictionary from the content of a trained one, e.g. as shipped
+  /// by the writer of a stream.
+  explicit ZstdDictionary(
+      std::string content,
+      int32_t compressionLevel = kDefaultCompressionLevel);
+
+  ~ZstdDictionary();
+
+  /// The id of the dictionary. The frames compressed with the dictionary
+  /// refer to it by id.
+  uint32_t id() const {
+    return id_;
+  }
+
+  const std::string& content() const {
+    return content_;
+  }
+
+  /// Compresses 'input' into one frame.
+  std::unique_ptr<folly::IOBuf> compress(const folly::IOBuf& input) const;
+
+  /// Decompresses a frame compressed with 'this' into 'uncompressedSize'
+  /// bytes. Throws if the frame is corrupt or refers to another dictionary.
+  std::unique_ptr<folly::IOBuf> decompress(
+      const folly::IOBuf& input,
+      uint64_t uncompressedSize) const;
+
+ private:
+  const std::string content_;
+  const uint32_t id_;
+  ZSTD_CDict_s* const compressionDictionary_;
+  ZSTD_DDict_s* const decompressionDictionary_;
+};
+
+} // namespace facebook::velox::common
@@ -26,6 +26,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/CompressionAccelerator.h"
 #include "velox/common/compression/Lz4Compression.h"
 
 namespace facebook::velox::common {
@@ -330,6 +331,46 @@ void checkStreamingRoundtrip(Codec* codec, const std::vector<uint8_t>& data) {
   checkStreamingRoundtrip(
       makeStreamingCompressor(codec), makeStreamingDecompressor(codec), data);
 }
+
+// Decompresses LZ4 raw blocks in software. Accepts up to 'queueDepth' jobs
+// per batch and fails all of them if 'fail' is true.
+class TestAccelerator : public CompressionAccelerator {
+ public:
+  TestAccelerator(size_t queueDepth, bool fail)
+      : queueDepth_(queueDepth), fail_(fail), codec_(makeLz4RawCodec()) {}
+
+  std::string_view name() const override {
+    return "test";
+  }
+
+  bool supportsDecompression(CompressionKind kind) const override {
+    return kind == CompressionKind_LZ4;
+  }
+
+  std::vector<folly::SemiFuture<Expected<uint64_t>>> submitDecompression(
+      CompressionKind /*kind*/,
+      folly::Range<const DecompressionJob*> jobs) override {
+    std::vector<folly::SemiFuture<Expected<uint64_t>>> futures;
+    for (const auto& job : jobs) {
+      if (futures.size() == queueDepth_) {
+        break;
+      }
+      if (fail_) {
+        futures.push_back(folly::makeSemiFuture(Expected<uint64_t>(
+            folly::makeUnexpected(Status::IOError("Device error")))));
+        continue;
+      }
+      futures.push_back(folly::makeSemiFuture(codec_->decompress(
+          job.input, job.inputLength, job.output, job.outputLength)));
+    }
+    return futures;
+  }
+
+ private:
+  const size_t queueDepth_;
+  const bool fail_;
+  const std::unique_ptr<Codec> codec_;
+};
 } // namespace
 
 class CompressionTest : public testing::Test {};
@@ -534,4 +575,94 @@ TEST(CodecTestInvalid, invalidKind) {
           "Support for codec '{}' is either not built or not implemented.",
           compressionKindToString(kind)));
 }
+
+TEST(CodecFactoryTest, registerCodecFactory) {
+  ASSERT_FALSE(Codec::isAvailable(CompressionKind_ZSTD));
+  registerCodecFactory(CompressionKind_ZSTD, [](const CodecOptions& options) {
+    return makeLz4RawCodec(options.compressionLevel);
+  });
+  ASSERT_TRUE(Codec::isAvailable(CompressionKind_ZSTD));
+  auto codec = Codec::create(CompressionKind_ZSTD)
+                   .thenOrThrow(folly::identity, throwsNotOk);
+  checkCodecRoundtrip(codec, makeCompressibleData(10000));
+
+  unregisterCodecFactory(CompressionKind_ZSTD);
+  ASSERT_FALSE(Codec::isAvailable(CompressionKind_ZSTD));
+  ASSERT_TRUE(Codec::create(CompressionKind_ZSTD).hasError());
+}
+
+TEST(CompressionAcceleratorTest, decompressBatch) {
+  constexpr size_t kNumBlocks = 5;
+  auto software = makeLz4RawCodec();
+  std::vector<std::vector<uint8_t>> blocks;
+  std::vector<std::vector<uint8_t>> compressedBlocks;
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    blocks.push_back(makeCompressibleData(1000 * (i + 1)));
+    std::vector<uint8_t> compressed(
+        software->maxCompressedLength(blocks.back().size()));
+    const auto length = software
+                            ->compress(
+                                blocks.back().data(),
+                                blocks.back().size(),
+                                compressed.data(),
+                                compressed.size())
+                            .thenOrThrow(folly::identity, throwsNotOk);
+    compressed.resize(length);
+    compressedBlocks.push_back(std::move(compressed));
+  }
+
+  struct {
+    size_t queueDepth;
+    bool fail;
+    CompressionAccelerator::Stats expectedStats;
+  } testSettings[] = {
+      {kNumBlocks, false, {kNumBlocks, 0, 0}},
+      {2, false, {2, kNumBlocks - 2, 0}},
+      {0, false, {0, kNumBlocks, 0}},
+      {2, true, {0, kNumBlocks - 2, 2}}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(
+        fmt::format(
+            "queueDepth {} fail {}", testData.queueDepth, testData.fail));
+    auto accelerator =
+        std::make_shared<TestAccelerator>(testData.queueDepth, testData.fail);
+    auto codec = makeAcceleratedCodec(makeLz4RawCodec(), accelerator);
+    ASSERT_EQ(codec->compressionKind(), CompressionKind_LZ4);
+
+    std::vector<std::vector<uint8_t>> outputs;
+    std::vector<DecompressionJob> jobs;
+    for (size_t i = 0; i < kNumBlocks; ++i) {
+      outputs.emplace_back(blocks[i].size());
+      jobs.push_back(
+          {compressedBlocks[i].data(),
+           compressedBlocks[i].size(),
+           outputs.back().data(),
+           outputs.back().size()});
+    }
+    const auto results = codec->decompressBatch(folly::range(jobs));
+    ASSERT_EQ(results.size(), kNumBlocks);
+    for (size_t i = 0; i < kNumBlocks; ++i) {
+      ASSERT_TRUE(results[i].hasValue());
+      ASSERT_EQ(results[i].value(), blocks[i].size());
+      ASSERT_EQ(outputs[i], blocks[i]);
+    }
+    const auto stats = accelerator->stats();
+    ASSERT_EQ(stats.numAccelerated, testData.expectedStats.numAccelerated);
+    ASSERT_EQ(stats.numRejected, testData.expectedStats.numRejected);
+    ASSERT_EQ(stats.numFailed, testData.expectedStats.numFailed);
+
+    // Single blocks take the same path.
+    checkCodecRoundtrip(software, codec, blocks[0]);
+  }
+}
+
+TEST(CompressionAcceleratorTest, register) {
+  ASSERT_EQ(compressionAccelerator(CompressionKind_LZ4), nullptr);
+  auto accelerator = std::make_shared<TestAccelerator>(1, false);
+  registerCompressionAccelerator(accelerator);
+  ASSERT_EQ(compressionAccelerator(CompressionKind_LZ4), accelerator);
+  ASSERT_EQ(compressionAccelerator(CompressionKind_ZSTD), nullptr);
+  registerCompressionAccelerator(nullptr);
+  ASSERT_EQ(compressionAccelerator(CompressionKind_LZ4), nullptr);
+}
 } // namespace facebook::velox::common
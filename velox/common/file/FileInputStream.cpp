@@ -38,6 +38,14 @@ FileInputStream::FileInputStream(
 }
 
 FileInputStream::~FileInputStream() {
+  if (prefetch_ != nullptr) {
+    try {
+      prefetch_->close();
+    } catch (const std::exception& ex) {
+      LOG(WARNING) << "FileInputStream prefetch failed on destruction "
+                   << ex.what();
+    }
+  }
   if (!readAheadWait_.valid()) {
     return;
   }
@@ -67,6 +75,15 @@ void FileInputStream::readNextRange() {
       VELOX_CHECK_LT(
           0, readBytes, "Read past end of FileInputStream {}", fileSize_);
       advanceBuffer();
+    } else if (prefetch_ != nullptr) {
+      auto prefetch = std::move(prefetch_);
+      auto result = prefetch->move();
+      VELOX_CHECK_NOT_NULL(result);
+      readBytes = *result;
+      VELOX_CHECK_LT(
+          0, readBytes, "Read past end of FileInputStream {}", fileSize_);
+      // Frees the consumed buffer.
+      buffers_[bufferIndex()] = std::move(prefetchBuffer_);
     } else {
       readBytes = readSize();
       VELOX_CHECK_LT(
@@ -205,6 +222,29 @@ uint64_t FileInputStream::readSize() const {
   return std::min(fileSize_ - fileOffset_, bufferSize_);
 }
 
+uint64_t FileInputStream::prefetchSize() const {
+  if (readAheadEnabled_ || prefetch_ != nullptr) {
+    return 0;
+  }
+  return readSize();
+}
+
+void FileInputStream::prefetch(folly::Executor* executor) {
+  VELOX_CHECK_NOT_NULL(executor);
+  const auto size = prefetchSize();
+  VELOX_CHECK_GT(size, 0);
+  prefetchBuffer_ = AlignedBuffer::allocate<char>(size, pool_);
+  prefetch_ = std::make_shared<AsyncSource<uint64_t>>(
+      [file = file_.get(),
+       offset = fileOffset_,
+       size,
+       data = prefetchBuffer_->asMutable<char>()]() {
+        file->pread(offset, size, data);
+        return std::make_unique<uint64_t>(size);
+      });
+  executor->add([prefetch = prefetch_]() { prefetch->prepare(); });
+}
+
 void FileInputStream::maybeIssueReadahead() {
   VELOX_CHECK(!readAheadWait_.valid());
   if (!readAheadEnabled_) {
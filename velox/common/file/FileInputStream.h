@@ -19,6 +19,7 @@
 #include <cstdint>
 
 #include "velox/buffer/Buffer.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/ByteStream.h"
 
@@ -59,6 +60,28 @@ class FileInputStream : public ByteInputStream {
 
   std::string toString() const override;
 
+  /// Returns the bytes left to read in the current buffer.
+  uint64_t bufferedBytes() const {
+    return current_ == nullptr ? 0 : current_->availableBytes();
+  }
+
+  /// Returns the bytes prefetch() would read, or 0 if it would not read any
+  /// because the file system read-ahead is used, a prefetch is outstanding or
+  /// the whole file has been read.
+  uint64_t prefetchSize() const;
+
+  /// Returns the size of the buffer allocated by an outstanding prefetch, or 0
+  /// if there is none.
+  uint64_t prefetchedBytes() const {
+    return prefetch_ == nullptr ? 0 : prefetchBuffer_->capacity();
+  }
+
+  /// Reads the next buffer from the file on 'executor' for files which do not
+  /// support async read. The buffer is allocated from the stream's pool and
+  /// freed once the stream moves past it. Must only be called if
+  /// prefetchSize() is not 0.
+  void prefetch(folly::Executor* executor);
+
   /// Records the file read stats.
   struct Stats {
     uint32_t numReads{0};
@@ -123,6 +146,11 @@ class FileInputStream : public ByteInputStream {
   folly::SemiFuture<uint64_t> readAheadWait_{
       folly::SemiFuture<uint64_t>::makeEmpty()};
 
+  // The read of the next range into 'prefetchBuffer_' issued by prefetch().
+  // Produces the number of bytes read.
+  std::shared_ptr<AsyncSource<uint64_t>> prefetch_;
+  BufferPtr prefetchBuffer_;
+
   ByteRange range_;
 
   Stats stats_;
@@ -143,6 +143,27 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(const uint64_t* hashes, int32_t numHashes) {
+  constexpr int32_t kBatchSize = 64;
+  uint32_t indices[kBatchSize];
+  int8_t values[kBatchSize];
+  for (auto begin = 0; begin < numHashes; begin += kBatchSize) {
+    const auto size = std::min(kBatchSize, numHashes - begin);
+    // Independent per hash, so that the loop vectorizes.
+    for (auto i = 0; i < size; ++i) {
+      const auto hash = hashes[begin + i];
+      indices[i] = computeIndex(hash, indexBitLength_);
+      values[i] = numberOfLeadingZeros(hash, indexBitLength_) + 1;
+    }
+    for (auto i = 0; i < size; ++i) {
+      // 'baseline_' changes in insert().
+      if (values[i] - baseline_ > getDelta(indices[i])) {
+        insert(indices[i], values[i]);
+      }
+    }
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
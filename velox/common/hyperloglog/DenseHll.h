@@ -48,6 +48,12 @@ class DenseHll {
 
   void insertHash(uint64_t hash);
 
+  /// Same as calling insertHash() for each of 'hashes'. Computes the buckets
+  /// and values of a batch of hashes at a time, then rejects the values that
+  /// do not exceed the 4 bit delta of their bucket, which are nearly all once
+  /// the buckets fill up, without going through insert().
+  void insertHashes(const uint64_t* hashes, int32_t numHashes);
+
   /// Inserts pre-computed {bucket, value} pair. These value must be compatible
   /// with computeIndex and computeValue methods called with the indexBitLength
   /// value of this HLL. Used by SparseHll.toDense().
@@ -225,6 +225,24 @@ TEST_P(DenseHllTest, mergeWith) {
   testMergeWith(indexBitLength, sequence(0, 2'000'000), sequence(0, 2'000'000));
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  for (auto numHashes : {10, 1'000, 100'000}) {
+    std::vector<uint64_t> hashes;
+    for (auto i = 0; i < numHashes; ++i) {
+      hashes.push_back(hashOne(i));
+    }
+    DenseHll expected{indexBitLength, &allocator_};
+    for (auto hash : hashes) {
+      expected.insertHash(hash);
+    }
+    DenseHll hll{indexBitLength, &allocator_};
+    hll.insertHashes(hashes.data(), hashes.size());
+    ASSERT_EQ(serialize(hll), serialize(expected));
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     DenseHllTest,
     DenseHllTest,
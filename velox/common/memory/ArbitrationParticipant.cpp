@@ -176,6 +176,23 @@ uint64_t ArbitrationParticipant::reclaimableUsedCapacity() const {
   return std::min<int64_t>(maxReclaimableBytes, reclaimableBytes.value_or(0));
 }
 
+std::optional<uint64_t> ArbitrationParticipant::reclaimUsedCapacityCostNs()
+    const {
+  const auto* reclaimer = pool_->reclaimer();
+  uint64_t reclaimCostNs{0};
+  if (reclaimer == nullptr || !reclaimer->reclaimCost(*pool_, reclaimCostNs)) {
+    return std::nullopt;
+  }
+  // The cost is for all the reclaimable bytes which might be more than the
+  // reclaimable used capacity.
+  const auto reclaimableBytes = pool_->reclaimableBytes().value_or(0);
+  if (reclaimableBytes == 0) {
+    return 0;
+  }
+  const auto usedCapacity = reclaimableUsedCapacity();
+  return reclaimCostNs * (static_cast<double>(usedCapacity) / reclaimableBytes);
+}
+
 uint64_t ArbitrationParticipant::maxShrinkCapacity() const {
   const uint64_t capacity = pool_->capacity();
   const uint64_t freeBytes = pool_->freeBytes();
@@ -221,6 +221,11 @@ class ArbitrationParticipant
   /// memory pool through disk spilling.
   uint64_t reclaimableUsedCapacity() const;
 
+  /// Returns the estimated time in nanoseconds to reclaim the used memory
+  /// capacity returned by reclaimableUsedCapacity(), or std::nullopt if the
+  /// memory reclaimers of the query memory pool don't know the cost.
+  std::optional<uint64_t> reclaimUsedCapacityCostNs() const;
+
   /// Checks if the query memory pool can grow 'requestBytes' from its current
   /// capacity under the max capacity limit.
   bool checkCapacityGrowth(uint64_t requestBytes) const;
@@ -414,6 +419,10 @@ struct ArbitrationCandidate {
   int64_t currentCapacity{0};
   int64_t reclaimableUsedCapacity{0};
   int64_t reclaimableFreeCapacity{0};
+  /// The estimated time in nanoseconds to reclaim 'reclaimableUsedCapacity',
+  /// or std::nullopt if unknown. Only set by the global arbitration which
+  /// prefers cheap reclaims.
+  std::optional<uint64_t> reclaimCostNs;
 
   /// If 'freeCapacityOnly' is true, the candidate is only used to reclaim free
   /// capacity so only collects the free capacity stats.
@@ -88,6 +88,14 @@ HashStringAllocator::~HashStringAllocator() {
 void HashStringAllocator::clear() {
   state_.numFree() = 0;
   state_.freeBytes() = 0;
+  // The blocks in the small free lists are not marked free.
+  state_.currentBytes() += state_.smallFreeBytes();
+  std::fill(
+      std::begin(state_.smallFreeLists()),
+      std::end(state_.smallFreeLists()),
+      nullptr);
+  state_.numSmallFree() = 0;
+  state_.smallFreeBytes() = 0;
   std::fill(
       std::begin(state_.freeNonEmpty()), std::end(state_.freeNonEmpty()), 0);
   for (auto& pair : state_.allocationsFromPool()) {
@@ -279,7 +287,7 @@ void HashStringAllocator::newSlab() {
 
   // Add the new memory to the free list: Placement construct a header that
   // covers the space from start to the end marker and add this to free list.
-  free(new (run) Header(available - kHeaderSize));
+  freeToFreeList(new (run) Header(available - kHeaderSize));
 }
 
 void HashStringAllocator::newRange(
@@ -353,7 +361,7 @@ void HashStringAllocator::freeRestOfBlock(Header* header, int32_t keepBytes) {
 
   header->setSize(keepBytes);
   auto* newHeader = new (header->end()) Header(freeSize);
-  free(newHeader);
+  freeToFreeList(newHeader);
 }
 
 int32_t HashStringAllocator::freeListIndex(int size) {
@@ -370,6 +378,45 @@ void HashStringAllocator::removeFromFreeList(Header* header) {
   }
 }
 
+void HashStringAllocator::addToSmallFreeList(Header* header) {
+  VELOX_CHECK(!header->isFree());
+  VELOX_DCHECK_GE(header->size(), kMinAlloc);
+  auto& list = state_.smallFreeLists()[header->size() - kMinAlloc];
+  *reinterpret_cast<Header**>(header->begin()) = list;
+  list = header;
+  ++state_.numSmallFree();
+  state_.smallFreeBytes() += blockBytes(header);
+  state_.currentBytes() -= blockBytes(header);
+}
+
+HashStringAllocator::Header* HashStringAllocator::allocateFromSmallFreeList(
+    int32_t size) {
+  auto& list = state_.smallFreeLists()[std::max(size, kMinAlloc) - kMinAlloc];
+  auto* header = list;
+  if (header == nullptr) {
+    return nullptr;
+  }
+  list = *reinterpret_cast<Header**>(header->begin());
+  --state_.numSmallFree();
+  state_.smallFreeBytes() -= blockBytes(header);
+  state_.currentBytes() += blockBytes(header);
+  return header;
+}
+
+void HashStringAllocator::flushSmallFreeLists() {
+  for (auto& list : state_.smallFreeLists()) {
+    while (list != nullptr) {
+      auto* header = list;
+      list = *reinterpret_cast<Header**>(header->begin());
+      // freeToFreeList() counts the block as freed from 'currentBytes_'.
+      state_.currentBytes() += blockBytes(header);
+      freeToFreeList(header);
+    }
+  }
+  state_.numSmallFree() = 0;
+  state_.smallFreeBytes() = 0;
+}
+
 HashStringAllocator::Header* HashStringAllocator::allocate(
     int64_t size,
     bool exactSize) {
@@ -380,7 +427,17 @@ HashStringAllocator::Header* HashStringAllocator::allocate(
     return header;
   }
 
+  if (exactSize && size <= kMaxSmallFreeSize) {
+    if (auto* header = allocateFromSmallFreeList(size)) {
+      return header;
+    }
+  }
   auto* header = allocateFromFreeLists(size, exactSize, exactSize);
+  if (header == nullptr && state_.numSmallFree() > 0) {
+    // The small free blocks may coalesce into a large enough block.
+    flushSmallFreeLists();
+    header = allocateFromFreeLists(size, exactSize, exactSize);
+  }
   if (header == nullptr) {
     newSlab();
     header = allocateFromFreeLists(size, exactSize, exactSize);
@@ -452,41 +509,51 @@ void HashStringAllocator::free(Header* header) {
         state_.allocationsFromPool().find(headerToFree) !=
             state_.allocationsFromPool().end()) {
       freeToPool(headerToFree, headerToFree->size() + kHeaderSize);
+    } else if (
+        headerToFree->size() <= kMaxSmallFreeSize &&
+        state_.smallFreeBytes() + blockBytes(headerToFree) <=
+            kMaxSmallFreeBytes) {
+      addToSmallFreeList(headerToFree);
     } else {
-      VELOX_CHECK(!headerToFree->isFree());
-      state_.freeBytes() += blockBytes(headerToFree);
-      state_.currentBytes() -= blockBytes(headerToFree);
-      Header* next = headerToFree->next();
-      if (next != nullptr) {
-        VELOX_CHECK(!next->isPreviousFree());
-        if (next->isFree()) {
-          --state_.numFree();
-          removeFromFreeList(next);
-          headerToFree->setSize(
-              headerToFree->size() + next->size() + kHeaderSize);
-          next = castToHeader(headerToFree->end());
-          VELOX_CHECK(next->isArenaEnd() || !next->isFree());
-        }
-      }
-      if (headerToFree->isPreviousFree()) {
-        auto* previousFree = getPreviousFree(headerToFree);
-        removeFromFreeList(previousFree);
-        previousFree->setSize(
-            previousFree->size() + headerToFree->size() + kHeaderSize);
-
-        headerToFree = previousFree;
-      } else {
-        ++state_.numFree();
-      }
-      const auto freedSize = headerToFree->size();
-      const auto freeIndex = freeListIndex(freedSize);
-      bits::setBit(state_.freeNonEmpty(), freeIndex);
-      state_.freeLists()[freeIndex].insert(
-          reinterpret_cast<CompactDoubleList*>(headerToFree->begin()));
-      markAsFree(headerToFree);
+      freeToFreeList(headerToFree);
     }
     headerToFree = continued;
   } while (headerToFree != nullptr);
+  if (state_.currentBytes() == 0 && state_.numSmallFree() > 0) {
+    flushSmallFreeLists();
+  }
+}
+
+void HashStringAllocator::freeToFreeList(Header* header) {
+  VELOX_CHECK(!header->isFree());
+  state_.freeBytes() += blockBytes(header);
+  state_.currentBytes() -= blockBytes(header);
+  Header* next = header->next();
+  if (next != nullptr) {
+    VELOX_CHECK(!next->isPreviousFree());
+    if (next->isFree()) {
+      --state_.numFree();
+      removeFromFreeList(next);
+      header->setSize(header->size() + next->size() + kHeaderSize);
+      next = castToHeader(header->end());
+      VELOX_CHECK(next->isArenaEnd() || !next->isFree());
+    }
+  }
+  if (header->isPreviousFree()) {
+    auto* previousFree = getPreviousFree(header);
+    removeFromFreeList(previousFree);
+    previousFree->setSize(previousFree->size() + header->size() + kHeaderSize);
+
+    header = previousFree;
+  } else {
+    ++state_.numFree();
+  }
+  const auto freedSize = header->size();
+  const auto freeIndex = freeListIndex(freedSize);
+  bits::setBit(state_.freeNonEmpty(), freeIndex);
+  state_.freeLists()[freeIndex].insert(
+      reinterpret_cast<CompactDoubleList*>(header->begin()));
+  markAsFree(header);
 }
 
 // static
@@ -762,7 +829,23 @@ int64_t HashStringAllocator::checkConsistency() const {
 
   VELOX_CHECK_EQ(numInFreeList, state_.numFree());
   VELOX_CHECK_EQ(bytesInFreeList, state_.freeBytes());
-  return allocatedBytes;
+
+  // The blocks in the small free lists are counted as allocated above.
+  uint64_t numInSmallFreeList = 0;
+  uint64_t bytesInSmallFreeList = 0;
+  for (auto i = 0; i < kNumSmallFreeLists; ++i) {
+    for (auto* header = state_.smallFreeLists()[i]; header != nullptr;
+         header = *reinterpret_cast<Header**>(header->begin())) {
+      VELOX_CHECK(!header->isFree());
+      VELOX_CHECK(!header->isContinued());
+      VELOX_CHECK_EQ(header->size() - kMinAlloc, i);
+      ++numInSmallFreeList;
+      bytesInSmallFreeList += blockBytes(header);
+    }
+  }
+  VELOX_CHECK_EQ(numInSmallFreeList, state_.numSmallFree());
+  VELOX_CHECK_EQ(bytesInSmallFreeList, state_.smallFreeBytes());
+  return allocatedBytes - bytesInSmallFreeList;
 }
 
 bool HashStringAllocator::isEmpty() const {
@@ -296,7 +296,11 @@ class HashStringAllocator : public StreamArena {
   }
 
   /// Adds the allocation of 'header' and any extensions (if header has
-  /// kContinued set) to the free list.
+  /// kContinued set) to the free list. Blocks of up to 'kMaxSmallFreeSize'
+  /// bytes go to a list of free blocks of their size first, so that an
+  /// allocation of the same size takes them back without splitting and
+  /// coalescing. These are coalesced with their neighbors when the free list
+  /// has no block for an allocation or when 'this' becomes empty.
   void free(Header* header);
 
   /// Returns a lower bound on bytes available without growing 'this'. This is
@@ -304,8 +308,9 @@ class HashStringAllocator : public StreamArena {
   /// the pointer because in the worst case we would have one allocation that
   /// chains many small free blocks together via kContinued.
   uint64_t freeSpace() const {
-    const int64_t minFree = state_.freeBytes() -
-        state_.numFree() * (kHeaderSize + Header::kContinuedPtrSize);
+    const int64_t minFree = state_.freeBytes() + state_.smallFreeBytes() -
+        (state_.numFree() + state_.numSmallFree()) *
+            (kHeaderSize + Header::kContinuedPtrSize);
     VELOX_CHECK_GE(minFree, 0, "Guaranteed free space cannot be negative");
     return minFree;
   }
@@ -352,6 +357,14 @@ class HashStringAllocator : public StreamArena {
   static constexpr int32_t kNumFreeLists = kMaxAlloc - kMinAlloc + 2;
   static constexpr uint32_t kHeaderSize = sizeof(Header);
 
+  // The largest block size that is kept in the small free lists.
+  static constexpr int32_t kMaxSmallFreeSize = 256;
+  static constexpr int32_t kNumSmallFreeLists =
+      kMaxSmallFreeSize - kMinAlloc + 1;
+  // The maximum bytes in the small free lists. The blocks past this go to the
+  // free list right away.
+  static constexpr uint64_t kMaxSmallFreeBytes = kUnitSize;
+
   void newRange(
       int64_t bytes,
       ByteRange* lastRange,
@@ -365,6 +378,22 @@ class HashStringAllocator : public StreamArena {
 
   void removeFromFreeList(Header* header);
 
+  // Adds 'header', a block of up to 'kMaxSmallFreeSize' bytes, to the small
+  // free list of its size.
+  void addToSmallFreeList(Header* header);
+
+  // Returns a block of 'size' bytes from the small free lists or nullptr if
+  // there is none.
+  Header* allocateFromSmallFreeList(int32_t size);
+
+  // Moves the blocks in the small free lists to the free list, coalescing them
+  // with their free neighbors.
+  void flushSmallFreeLists();
+
+  // Adds 'header', a block in the arena, to the free list, coalescing it with
+  // its free neighbors.
+  void freeToFreeList(Header* header);
+
   // Allocates a block of specified size. If exactSize is false, the block may
   // be smaller or larger. Checks free list before allocating new memory.
   Header* allocate(int64_t size, bool exactSize);
@@ -469,6 +498,19 @@ class HashStringAllocator : public StreamArena {
     // Sum of the size of blocks in 'free_', excluding headers.
     DECLARE_FIELD_WITH_INIT_VALUE(uint64_t, freeBytes, 0);
 
+    typedef Header* SmallFreeLists[kNumSmallFreeLists];
+
+    // Singly linked lists of the free blocks of each size up to
+    // 'kMaxSmallFreeSize'. These are not marked free and the first word of a
+    // block points to the next block in its list. Not included in 'free_'.
+    DECLARE_FIELD_WITH_INIT_VALUE(SmallFreeLists, smallFreeLists, {});
+
+    // Count of blocks in 'smallFreeLists_'.
+    DECLARE_FIELD_WITH_INIT_VALUE(uint64_t, numSmallFree, 0);
+
+    // Sum of the size of blocks in 'smallFreeLists_', including headers.
+    DECLARE_FIELD_WITH_INIT_VALUE(uint64_t, smallFreeBytes, 0);
+
     // Counter of allocated bytes. The difference of two point in time values
     // tells how much memory has been consumed by activity between these points
     // in time. Incremented by allocation and decremented by free. Used for
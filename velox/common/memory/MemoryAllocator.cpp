@@ -432,6 +432,12 @@ void MemoryAllocator::useHugePages(
   if (rc != 0) {
     VELOX_MEM_LOG(WARNING) << "madvise hugepage errno="
                            << folly ::errnoStr(errno);
+    return;
+  }
+  if (enable) {
+    numHugePageBytes_ += maybeRange.value().size();
+  } else {
+    numHugePageBytes_ -= maybeRange.value().size();
   }
 #endif
 }
@@ -341,6 +341,12 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
 
   virtual MachinePageCount numMapped() const = 0;
 
+  /// Returns the bytes of the contiguous allocations that are advised to be
+  /// backed by huge pages.
+  uint64_t numHugePageBytes() const {
+    return numHugePageBytes_;
+  }
+
   virtual Stats stats() const {
     return stats_;
   }
@@ -502,6 +508,9 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   // system by 'this' (via madvise calls).
   std::atomic<MachinePageCount> numMapped_{0};
 
+  // Tracks the bytes advised to be backed by huge pages in useHugePages().
+  std::atomic<uint64_t> numHugePageBytes_{0};
+
   // Indicates if the failure injection is persistent or transient.
   //
   // NOTE: this is only used for testing purpose.
@@ -226,6 +226,38 @@ bool MemoryReclaimer::reclaimableBytes(
   return reclaimable;
 }
 
+bool MemoryReclaimer::reclaimCost(
+    const MemoryPool& pool,
+    uint64_t& reclaimCostNs) const {
+  reclaimCostNs = 0;
+  if (pool.kind() == MemoryPool::Kind::kLeaf) {
+    return false;
+  }
+  bool known{false};
+  bool unknown{false};
+  pool.visitChildren([&](MemoryPool* child) {
+    const auto* reclaimer = child->reclaimer();
+    uint64_t childCostNs{0};
+    if (reclaimer != nullptr && reclaimer->reclaimCost(*child, childCostNs)) {
+      known = true;
+      reclaimCostNs += childCostNs;
+      return true;
+    }
+    // A child with reclaimable memory of unknown cost makes the cost of
+    // 'pool' unknown rather than cheaper than it is.
+    if (child->reclaimableBytes().value_or(0) != 0) {
+      unknown = true;
+      return false;
+    }
+    return true;
+  });
+  if (unknown) {
+    reclaimCostNs = 0;
+    return false;
+  }
+  return known;
+}
+
 uint64_t MemoryReclaimer::reclaim(
     MemoryPool* pool,
     uint64_t targetBytes,
@@ -378,6 +378,15 @@ class MemoryReclaimer {
       const MemoryPool& pool,
       uint64_t& reclaimableBytes) const;
 
+  /// Invoked by the memory arbitrator to get the estimated time in nanoseconds
+  /// to reclaim all the reclaimable memory from 'pool', e.g. to spill it to
+  /// disk and read it back later. The function returns true if the cost of
+  /// 'pool' is known and returns it in 'reclaimCostNs'. The default
+  /// implementation sums up the costs of the child pools. The cost is unknown
+  /// if that of a child pool with reclaimable memory is unknown.
+  virtual bool reclaimCost(const MemoryPool& pool, uint64_t& reclaimCostNs)
+      const;
+
   /// Invoked by the memory arbitrator to reclaim from memory 'pool' with
   /// specified 'targetBytes'. It is expected to reclaim at least that amount of
   /// memory bytes but there is no guarantees. If 'targetBytes' is zero, then it
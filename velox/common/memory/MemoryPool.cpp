@@ -32,6 +32,13 @@ DEFINE_bool(
     false,
     "Whether allow to memory capacity transfer between memory pools from different tasks, which might happen in use case like Spark-Gluten");
 
+DEFINE_int32(
+    velox_memory_pool_reservation_slack_mb,
+    0,
+    "The unused reservation in MB a leaf memory pool keeps when memory is "
+    "freed, so that allocations and frees around a reservation quantum do not "
+    "update the memory pool tree every time. MemoryPool::release() returns it");
+
 DECLARE_bool(velox_suppress_memory_capacity_exceeding_error_message);
 
 using facebook::velox::common::testutil::TestValue;
@@ -951,7 +958,10 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      // Without a reservation slack, there is nothing to release unless
+      // reserve() was called.
+      if (minReservationBytes_ == 0 &&
+          FLAGS_velox_memory_pool_reservation_slack_mb == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
@@ -960,7 +970,7 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = reservationAfterFreeLocked(newCap);
     }
     freeable = reservationBytes_ - newQuantized;
     if (freeable > 0) {
@@ -1283,6 +1293,36 @@ void MemoryPoolImpl::recordGrowDbg(const void* addr, uint64_t newSize) {
   allocResult->second.size = newSize;
 }
 
+std::vector<MemoryPoolImpl::AllocationCallSite>
+MemoryPoolImpl::debugAllocationCallSites() {
+  std::unordered_map<std::string, AllocationCallSite> callSites;
+  {
+    std::lock_guard<std::mutex> l(debugAllocMutex_);
+    for (const auto& itr : debugAllocRecords_) {
+      const auto& allocationRecord = itr.second;
+      auto stackStr = allocationRecord.callStack.toString();
+      auto& callSite = callSites[stackStr];
+      if (callSite.callStack.empty()) {
+        callSite.callStack = std::move(stackStr);
+      }
+      callSite.bytes += allocationRecord.size;
+      ++callSite.numAllocations;
+    }
+  }
+  std::vector<AllocationCallSite> sortedCallSites;
+  sortedCallSites.reserve(callSites.size());
+  for (auto& [_, callSite] : callSites) {
+    sortedCallSites.push_back(std::move(callSite));
+  }
+  std::sort(
+      sortedCallSites.begin(),
+      sortedCallSites.end(),
+      [](const AllocationCallSite& a, const AllocationCallSite& b) {
+        return a.bytes > b.bytes;
+      });
+  return sortedCallSites;
+}
+
 void MemoryPoolImpl::leakCheckDbg() {
   VELOX_CHECK(debugEnabled());
   if (debugAllocRecords_.empty()) {
@@ -1292,34 +1332,11 @@ void MemoryPoolImpl::leakCheckDbg() {
   std::ostream oss(&buf);
   oss << "[MemoryPool] : " << name_ << " - Detected total of "
       << debugAllocRecords_.size() << " leaked allocations:\n";
-  struct AllocationStats {
-    uint64_t size{0};
-    uint64_t numAllocations{0};
-  };
-  std::unordered_map<std::string, AllocationStats> sizeAggregatedRecords;
-  for (const auto& itr : debugAllocRecords_) {
-    const auto& allocationRecord = itr.second;
-    const auto stackStr = allocationRecord.callStack.toString();
-    if (sizeAggregatedRecords.count(stackStr) == 0) {
-      sizeAggregatedRecords[stackStr] = AllocationStats();
-    }
-    sizeAggregatedRecords[stackStr].size += allocationRecord.size;
-    ++sizeAggregatedRecords[stackStr].numAllocations;
-  }
-  std::vector<std::pair<std::string, AllocationStats>> sortedRecords(
-      sizeAggregatedRecords.begin(), sizeAggregatedRecords.end());
-  std::sort(
-      sortedRecords.begin(),
-      sortedRecords.end(),
-      [](const std::pair<std::string, AllocationStats>& a,
-         std::pair<std::string, AllocationStats>& b) {
-        return a.second.size > b.second.size;
-      });
-  for (const auto& pair : sortedRecords) {
-    oss << "======== Leaked memory from " << pair.second.numAllocations
-        << " total allocations of " << succinctBytes(pair.second.size)
+  for (const auto& callSite : debugAllocationCallSites()) {
+    oss << "======== Leaked memory from " << callSite.numAllocations
+        << " total allocations of " << succinctBytes(callSite.bytes)
         << " total size ========\n"
-        << pair.first << "\n";
+        << callSite.callStack << "\n";
   }
   VELOX_FAIL(buf.str());
 }
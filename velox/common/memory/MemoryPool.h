@@ -31,6 +31,7 @@
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
 DECLARE_bool(velox_memory_pool_capacity_transfer_across_tasks);
+DECLARE_int32(velox_memory_pool_reservation_slack_mb);
 
 namespace facebook::velox::exec {
 class ParallelMemoryReclaimer;
@@ -736,6 +737,18 @@ class MemoryPoolImpl : public MemoryPool {
     return debugAllocRecords_;
   }
 
+  /// The outstanding allocations of a call stack recorded in debug mode.
+  struct AllocationCallSite {
+    std::string callStack;
+    uint64_t bytes{0};
+    uint64_t numAllocations{0};
+  };
+
+  /// Returns the outstanding allocations recorded in debug mode grouped by
+  /// call stack, the largest first. Empty if the debug mode does not record
+  /// the allocations of this pool.
+  std::vector<AllocationCallSite> debugAllocationCallSites();
+
  private:
   void enterArbitration() override;
 
@@ -884,7 +897,10 @@ class MemoryPoolImpl : public MemoryPool {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      // Without a reservation slack, there is nothing to release unless
+      // reserve() was called.
+      if (minReservationBytes_ == 0 &&
+          FLAGS_velox_memory_pool_reservation_slack_mb == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
@@ -893,7 +909,7 @@ class MemoryPoolImpl : public MemoryPool {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = reservationAfterFreeLocked(newCap);
     }
 
     const int64_t freeable = reservationBytes_ - newQuantized;
@@ -904,6 +920,20 @@ class MemoryPoolImpl : public MemoryPool {
     }
   }
 
+  // Returns the reservation to keep after a free that leaves 'size' bytes
+  // reserved. Keeps up to 'velox_memory_pool_reservation_slack_mb' of the
+  // current reservation unused while there is memory in use, so that the next
+  // allocations are served without updating the parents.
+  FOLLY_ALWAYS_INLINE int64_t reservationAfterFreeLocked(int64_t size) const {
+    const int64_t slackBytes =
+        int64_t(FLAGS_velox_memory_pool_reservation_slack_mb) * kMB;
+    if (FOLLY_LIKELY(slackBytes == 0) || size == 0) {
+      return quantizedSize(size);
+    }
+    return std::min<int64_t>(
+        reservationBytes_, quantizedSize(size + slackBytes));
+  }
+
   // Decrements the reservation in 'this' and parents.
   void decrementReservation(uint64_t size) noexcept;
 
@@ -330,13 +330,7 @@ bool MmapAllocator::allocateContiguousImpl(
       std::lock_guard<std::mutex> l(arenaMutex_);
       data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
     } else {
-      data = ::mmap(
-          nullptr,
-          AllocationTraits::pageBytes(maxPages),
-          PROT_READ | PROT_WRITE,
-          MAP_PRIVATE | MAP_ANONYMOUS,
-          -1,
-          0);
+      data = mmapHugePageAligned(AllocationTraits::pageBytes(maxPages));
     }
   }
   if (data == nullptr || data == MAP_FAILED) {
@@ -523,13 +517,8 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
       0,
       "Sizeclass {} must have a multiple of 64 capacity",
       unitSize_);
-  void* ptr = mmap(
-      nullptr,
-      AllocationTraits::pageBytes(capacity_ * unitSize_),
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
+  void* ptr = mmapHugePageAligned(
+      AllocationTraits::pageBytes(capacity_ * unitSize_));
   if (ptr == MAP_FAILED || ptr == nullptr) {
     VELOX_FAIL(
         "Could not allocate working memory "
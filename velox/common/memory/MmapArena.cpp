@@ -21,6 +21,35 @@
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::memory {
+void* mmapHugePageAligned(uint64_t bytes) {
+  constexpr auto kHugePageSize = AllocationTraits::kHugePageSize;
+  const uint64_t mapBytes =
+      bytes < kHugePageSize ? bytes : bytes + kHugePageSize;
+  void* ptr = ::mmap(
+      nullptr,
+      mapBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (ptr == MAP_FAILED || mapBytes == bytes) {
+    return ptr;
+  }
+  // Unmaps the unaligned head and the tail past 'bytes'.
+  const auto begin = reinterpret_cast<uintptr_t>(ptr);
+  const auto alignedBegin = bits::roundUp(begin, kHugePageSize);
+  if (alignedBegin > begin) {
+    ::munmap(ptr, alignedBegin - begin);
+  }
+  const auto end = begin + mapBytes;
+  if (end > alignedBegin + bytes) {
+    ::munmap(
+        reinterpret_cast<void*>(alignedBegin + bytes),
+        end - alignedBegin - bytes);
+  }
+  return reinterpret_cast<void*>(alignedBegin);
+}
+
 uint64_t MmapArena::roundBytes(uint64_t bytes) {
   return bits::nextPowerOfTwo(bytes);
 }
@@ -31,13 +60,7 @@ MmapArena::MmapArena(size_t capacityBytes) : byteSize_(capacityBytes) {
       0,
       "Arena must have a multiple of {} bytes capacity.",
       kMinGrainSizeBytes);
-  void* ptr = mmap(
-      nullptr,
-      capacityBytes,
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
+  void* ptr = mmapHugePageAligned(capacityBytes);
   if (ptr == MAP_FAILED || ptr == nullptr) {
     VELOX_FAIL(
         "Could not allocate working memory"
@@ -26,6 +26,12 @@
 
 namespace facebook::velox::memory {
 
+/// Maps 'bytes' of anonymous memory like mmap(). A mapping of at least a huge
+/// page starts at a huge page boundary, so that all of it can be backed by
+/// transparent huge pages. The result is unmapped with munmap() of 'bytes'.
+/// Returns MAP_FAILED on failure.
+void* mmapHugePageAligned(uint64_t bytes);
+
 class MmapArena {
  public:
   /// Single MmapArena capacity is determined by mmap_arena_capacity_ratio ratio
@@ -228,6 +228,14 @@ bool SharedArbitrator::ExtraConfig::globalArbitrationWithoutSpill(
       kDefaultGlobalArbitrationWithoutSpill);
 }
 
+bool SharedArbitrator::ExtraConfig::globalArbitrationReclaimCostAware(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return getConfig<bool>(
+      configs,
+      kGlobalArbitrationReclaimCostAware,
+      kDefaultGlobalArbitrationReclaimCostAware);
+}
+
 double SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(
     const std::unordered_map<std::string, std::string>& configs) {
   return getConfig<double>(
@@ -265,6 +273,8 @@ SharedArbitrator::SharedArbitrator(const Config& config)
           ExtraConfig::globalArbitrationAbortTimeRatio(config.extraConfigs)),
       globalArbitrationWithoutSpill_(
           ExtraConfig::globalArbitrationWithoutSpill(config.extraConfigs)),
+      globalArbitrationReclaimCostAware_(
+          ExtraConfig::globalArbitrationReclaimCostAware(config.extraConfigs)),
       freeReservedCapacity_(reservedCapacity_),
       freeNonReservedCapacity_(capacity_ - freeReservedCapacity_) {
   VELOX_CHECK_EQ(kind_, config.kind);
@@ -305,7 +315,9 @@ SharedArbitrator::SharedArbitrator(const Config& config)
                         << ", global arbitration abort time ratio "
                         << globalArbitrationAbortTimeRatio_
                         << ", global arbitration skip spill "
-                        << globalArbitrationWithoutSpill_;
+                        << globalArbitrationWithoutSpill_
+                        << ", global arbitration reclaim cost aware "
+                        << globalArbitrationReclaimCostAware_;
   }
   VELOX_MEM_LOG(INFO) << "Memory pool participant config: "
                       << participantConfig_.toString();
@@ -546,6 +558,35 @@ void SharedArbitrator::sortCandidatesByReclaimableUsedCapacity(
       &candidates);
 }
 
+void SharedArbitrator::sortCandidatesByReclaimCost(
+    std::vector<ArbitrationCandidate>& candidates) {
+  // A candidate with an unknown cost is considered the most expensive.
+  const auto costPerByte = [](const ArbitrationCandidate& candidate) {
+    if (!candidate.reclaimCostNs.has_value()) {
+      return std::numeric_limits<double>::infinity();
+    }
+    return candidate.reclaimableUsedCapacity == 0
+        ? 0.0
+        : static_cast<double>(candidate.reclaimCostNs.value()) /
+            candidate.reclaimableUsedCapacity;
+  };
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [&](const ArbitrationCandidate& lhs, const ArbitrationCandidate& rhs) {
+        const auto lhsCost = costPerByte(lhs);
+        const auto rhsCost = costPerByte(rhs);
+        if (lhsCost != rhsCost) {
+          return lhsCost < rhsCost;
+        }
+        return lhs.reclaimableUsedCapacity > rhs.reclaimableUsedCapacity;
+      });
+
+  TestValue::adjust(
+      "facebook::velox::memory::SharedArbitrator::sortCandidatesByReclaimCost",
+      &candidates);
+}
+
 std::optional<ArbitrationCandidate> SharedArbitrator::findAbortCandidate(
     bool force) {
   auto candidates = getCandidates();
@@ -1120,7 +1161,15 @@ uint64_t SharedArbitrator::reclaimUsedMemoryBySpill(
   allParticipantsReclaimed = true;
   const uint64_t prevReclaimedBytes = reclaimedUsedBytes_;
   auto candidates = getCandidates();
-  sortCandidatesByReclaimableUsedCapacity(candidates);
+  if (globalArbitrationReclaimCostAware_) {
+    for (auto& candidate : candidates) {
+      candidate.reclaimCostNs =
+          candidate.participant->reclaimUsedCapacityCostNs();
+    }
+    sortCandidatesByReclaimCost(candidates);
+  } else {
+    sortCandidatesByReclaimableUsedCapacity(candidates);
+  }
 
   std::vector<ArbitrationCandidate> victims;
   victims.reserve(candidates.size());
@@ -1128,6 +1177,11 @@ uint64_t SharedArbitrator::reclaimUsedMemoryBySpill(
   for (auto& candidate : candidates) {
     if (candidate.reclaimableUsedCapacity <
         participantConfig_.minReclaimBytes) {
+      // The candidates sorted by reclaim cost are not sorted by reclaimable
+      // used capacity.
+      if (globalArbitrationReclaimCostAware_) {
+        continue;
+      }
       break;
     }
     if (failedParticipants.count(candidate.participant->id()) != 0) {
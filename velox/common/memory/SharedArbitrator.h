@@ -226,6 +226,16 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     static bool globalArbitrationWithoutSpill(
         const std::unordered_map<std::string, std::string>& configs);
 
+    /// If true, global arbitration reclaims used memory by spilling from the
+    /// participants with the cheapest reclaim first, i.e. the least estimated
+    /// reclaim time per reclaimable byte reported by their memory reclaimers,
+    /// instead of from the ones with the most reclaimable used capacity first.
+    static constexpr std::string_view kGlobalArbitrationReclaimCostAware{
+        "global-arbitration-reclaim-cost-aware"};
+    static constexpr bool kDefaultGlobalArbitrationReclaimCostAware{false};
+    static bool globalArbitrationReclaimCostAware(
+        const std::unordered_map<std::string, std::string>& configs);
+
     /// If true, do sanity check on the arbitrator state on destruction.
     ///
     /// TODO: deprecate this flag after all the existing memory leak use cases
@@ -459,7 +469,8 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   //
   // NOTE: the function sorts participants based on their reclaimable used
   // memory capacity, and reclaims from participants with larger reclaimable
-  // used memory first.
+  // used memory first. If 'globalArbitrationReclaimCostAware_' is set, it
+  // reclaims from the participants with the cheapest reclaim first instead.
   uint64_t reclaimUsedMemoryBySpill(
       uint64_t targetBytes,
       std::unordered_set<uint64_t>& reclaimedParticipants,
@@ -472,6 +483,13 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   static void sortCandidatesByReclaimableUsedCapacity(
       std::vector<ArbitrationCandidate>& candidates);
 
+  // Sorts 'candidates' based on the estimated reclaim cost per reclaimable
+  // used byte in ascending order. The candidates with an unknown cost go last.
+  // The candidates with the same or an unknown cost are sorted based on
+  // reclaimable used capacity in descending order.
+  static void sortCandidatesByReclaimCost(
+      std::vector<ArbitrationCandidate>& candidates);
+
   // Invoked to reclaim the used memory capacity to abort the participant with
   // the largest capacity to free up memory. The function returns the actually
   // reclaimed capacity in bytes.
@@ -610,6 +628,7 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   const uint32_t globalArbitrationMemoryReclaimPct_;
   const double globalArbitrationAbortTimeRatio_;
   const bool globalArbitrationWithoutSpill_;
+  const bool globalArbitrationReclaimCostAware_;
 
   // The executor used to reclaim memory from multiple participants in parallel
   // at the background for global arbitration or external memory reclamation.
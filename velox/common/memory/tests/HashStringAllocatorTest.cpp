@@ -202,6 +202,30 @@ TEST_F(HashStringAllocatorTest, allocate) {
   EXPECT_LE(allocator_->retainedSize() - allocator_->freeSpace(), 250);
 }
 
+TEST_F(HashStringAllocatorTest, smallFreeLists) {
+  std::vector<HSA::Header*> headers;
+  for (auto i = 0; i < 100; ++i) {
+    headers.push_back(allocate(100));
+  }
+  auto* first = headers[0];
+  allocator_->free(first);
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+  // A block of another size does not reuse the freed block but one of the
+  // same size does.
+  auto* other = allocate(50);
+  ASSERT_NE(other, first);
+  headers.push_back(other);
+  ASSERT_EQ(allocate(100), first);
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+
+  // The freed small blocks are coalesced once all is freed.
+  for (auto* header : headers) {
+    allocator_->free(header);
+  }
+  ASSERT_TRUE(allocator_->isEmpty());
+  ASSERT_LE(allocator_->retainedSize() - allocator_->freeSpace(), 100);
+}
+
 TEST_F(HashStringAllocatorTest, allocateLarge) {
   // Verify that allocate() can handle sizes larger than the largest class size
   // supported by memory allocators, that is, 256 pages.
@@ -1011,6 +1011,30 @@ TEST_P(MemoryAllocatorTest, allocContiguous) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, allocContiguousHugePages) {
+  constexpr MachinePageCount kNumPages =
+      4 * AllocationTraits::numPagesInHugePage();
+  ContiguousAllocation allocation;
+  instance_->allocateContiguous(kNumPages, nullptr, allocation);
+  if (useMmap_) {
+    // The mmapped allocation starts at a huge page boundary.
+    ASSERT_EQ(
+        reinterpret_cast<uintptr_t>(allocation.data()) %
+            AllocationTraits::kHugePageSize,
+        0);
+    ASSERT_EQ(
+        allocation.hugePageRange().value().size(),
+        AllocationTraits::pageBytes(kNumPages));
+  }
+  // The huge page advice may be unsupported by the kernel.
+  const auto numHugePageBytes = instance_->numHugePageBytes();
+  ASSERT_TRUE(
+      numHugePageBytes == 0 ||
+      numHugePageBytes == allocation.hugePageRange().value().size());
+  instance_->freeContiguous(allocation);
+  ASSERT_EQ(instance_->numHugePageBytes(), 0);
+}
+
 TEST_P(MemoryAllocatorTest, allocContiguousFail) {
   struct {
     MachinePageCount nonContiguousPages;
@@ -538,6 +538,19 @@ class MockLeafMemoryReclaimer : public MemoryReclaimer {
     return true;
   }
 
+  bool reclaimCost(const MemoryPool& pool, uint64_t& reclaimCostNs)
+      const override {
+    uint64_t bytes{0};
+    if (!reclaimableBytes(pool, bytes)) {
+      reclaimCostNs = 0;
+      return false;
+    }
+    reclaimCostNs = bytes * kReclaimNanosPerByte;
+    return true;
+  }
+
+  static constexpr uint64_t kReclaimNanosPerByte{2};
+
   uint64_t reclaim(
       MemoryPool* /*unused*/,
       uint64_t targetBytes,
@@ -671,6 +684,56 @@ TEST_F(MemoryReclaimerTest, mockReclaim) {
   ASSERT_EQ(stats_, MemoryReclaimer::Stats{});
 }
 
+TEST_F(MemoryReclaimerTest, reclaimCost) {
+  const int numChildren = 4;
+  const int allocBytes = 64;
+  std::atomic<uint64_t> totalUsedBytes{0};
+  auto root = memory::memoryManager()->addRootPool(
+      "reclaimCost", kMaxMemory, MemoryReclaimer::create());
+  uint64_t reclaimCostNs{0};
+  ASSERT_FALSE(root->reclaimer()->reclaimCost(*root, reclaimCostNs));
+  ASSERT_EQ(reclaimCostNs, 0);
+
+  std::vector<std::shared_ptr<MemoryPool>> childPools;
+  for (int i = 0; i < numChildren; ++i) {
+    auto childPool =
+        root->addAggregateChild(std::to_string(i), MemoryReclaimer::create());
+    childPools.push_back(childPool);
+    // The second leaf of each child is not reclaimable and has no cost.
+    for (int j = 0; j < 2; ++j) {
+      auto leafPool = childPool->addLeafChild(
+          std::to_string(j),
+          true,
+          std::make_unique<MockLeafMemoryReclaimer>(totalUsedBytes, j == 0));
+      childPools.push_back(leafPool);
+      auto* reclaimer =
+          static_cast<MockLeafMemoryReclaimer*>(leafPool->reclaimer());
+      reclaimer->setPool(leafPool.get());
+      void* buffer = leafPool->allocate(allocBytes * (i + 1));
+      reclaimer->addAllocation(buffer, allocBytes * (i + 1));
+    }
+    // A leaf with the default reclaimer has no cost either.
+    childPools.push_back(childPool->addLeafChild(
+        "default", true, MemoryReclaimer::create()));
+  }
+
+  ASSERT_TRUE(root->reclaimer()->reclaimCost(*root, reclaimCostNs));
+  ASSERT_EQ(
+      reclaimCostNs,
+      MockLeafMemoryReclaimer::kReclaimNanosPerByte * allocBytes *
+          (1 + 2 + 3 + 4));
+  ASSERT_TRUE(
+      childPools[0]->reclaimer()->reclaimCost(*childPools[0], reclaimCostNs));
+  ASSERT_EQ(
+      reclaimCostNs, MockLeafMemoryReclaimer::kReclaimNanosPerByte * allocBytes);
+
+  for (auto& pool : childPools) {
+    if (pool->kind() == MemoryPool::Kind::kLeaf && pool->name() != "default") {
+      static_cast<MockLeafMemoryReclaimer*>(pool->reclaimer())->freeAll();
+    }
+  }
+}
+
 TEST_F(MemoryReclaimerTest, mockReclaimMoreThanAvailable) {
   const int numChildren = 10;
   const int numAllocationsPerLeaf = 10;
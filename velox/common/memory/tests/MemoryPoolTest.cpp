@@ -3557,6 +3557,44 @@ TEST_P(MemoryPoolTest, maybeReserve) {
   ASSERT_EQ(child->stats().numShrinks, 0);
 }
 
+TEST_P(MemoryPoolTest, reservationSlack) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_memory_pool_reservation_slack_mb = 4;
+  constexpr int64_t kMaxSize = 1 << 30; // 1GB
+  MemoryManager::Options options;
+  options.allocatorCapacity = kMaxSize;
+  options.arbitratorCapacity = kMaxSize;
+  options.extraArbitratorConfigs = {
+      {std::string(SharedArbitrator::ExtraConfig::kReservedCapacity),
+       folly::to<std::string>(kMaxSize / 8) + "B"}};
+  setupMemory(options);
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool("reservationSlack", kMaxSize);
+  auto child = root->addLeafChild("reservationSlack", isLeafThreadSafe_);
+
+  void* first = child->allocate(4 * MB);
+  void* second = child->allocate(4 * MB);
+  ASSERT_EQ(child->reservedBytes(), 8 * MB);
+  // The freed reservation stays in the leaf pool.
+  child->free(second, 4 * MB);
+  ASSERT_EQ(child->usedBytes(), 4 * MB);
+  ASSERT_EQ(child->reservedBytes(), 8 * MB);
+  ASSERT_EQ(root->reservedBytes(), 8 * MB);
+  second = child->allocate(2 * MB);
+  ASSERT_EQ(child->reservedBytes(), 8 * MB);
+
+  // release() returns the unused reservation.
+  child->release();
+  ASSERT_EQ(child->reservedBytes(), 6 * MB);
+  ASSERT_EQ(root->reservedBytes(), 6 * MB);
+
+  // The whole reservation is returned once no memory is used.
+  child->free(first, 4 * MB);
+  child->free(second, 2 * MB);
+  ASSERT_EQ(child->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
 TEST_P(MemoryPoolTest, maybeReserveFailWithAbort) {
   constexpr int64_t kMaxSize = 1 * GB; // 1GB
   MemoryManager::Options options;
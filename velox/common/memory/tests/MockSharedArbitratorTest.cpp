@@ -672,6 +672,10 @@ TEST_F(MockSharedArbitrationTest, extraConfigs) {
       SharedArbitrator::ExtraConfig::globalArbitrationWithoutSpill(
           emptyConfigs),
       SharedArbitrator::ExtraConfig::kDefaultGlobalArbitrationWithoutSpill);
+  ASSERT_EQ(
+      SharedArbitrator::ExtraConfig::globalArbitrationReclaimCostAware(
+          emptyConfigs),
+      SharedArbitrator::ExtraConfig::kDefaultGlobalArbitrationReclaimCostAware);
   ASSERT_EQ(
       SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(
           emptyConfigs),
@@ -705,6 +709,9 @@ TEST_F(MockSharedArbitrationTest, extraConfigs) {
       "1.0";
   configs[std::string(
       SharedArbitrator::ExtraConfig::kGlobalArbitrationWithoutSpill)] = "true";
+  configs[std::string(
+      SharedArbitrator::ExtraConfig::kGlobalArbitrationReclaimCostAware)] =
+      "true";
   configs[std::string(
       SharedArbitrator::ExtraConfig::kGlobalArbitrationAbortTimeRatio)] = "0.8";
 
@@ -736,6 +743,8 @@ TEST_F(MockSharedArbitrationTest, extraConfigs) {
   ASSERT_EQ(
       SharedArbitrator::ExtraConfig::globalArbitrationWithoutSpill(configs),
       true);
+  ASSERT_TRUE(
+      SharedArbitrator::ExtraConfig::globalArbitrationReclaimCostAware(configs));
   ASSERT_EQ(
       SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(configs),
       0.8);
@@ -3968,6 +3977,50 @@ DEBUG_ONLY_TEST_F(MockSharedArbitrationTest, orderedArbitration) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, sortCandidatesByReclaimCost) {
+  struct {
+    uint64_t usedBytes;
+    std::optional<uint64_t> reclaimNanosPerByte;
+  } candidateSettings[] = {
+      {8 * MB, 4},
+      {16 * MB, std::nullopt},
+      {32 * MB, 1},
+      {64 * MB, std::nullopt},
+      // A reclaim that costs nothing, e.g. dropping a table.
+      {4 * MB, 0}};
+
+  std::vector<MockMemoryOperator*> memOps;
+  for (const auto& settings : candidateSettings) {
+    memOps.push_back(addMemoryOp());
+    memOps.back()->allocate(settings.usedBytes);
+  }
+  test::SharedArbitratorTestHelper arbitratorHelper(arbitrator_);
+  std::vector<ArbitrationCandidate> candidates;
+  for (auto i = 0; i < memOps.size(); ++i) {
+    candidates.emplace_back(
+        arbitratorHelper.getParticipant(tasks()[i]->pool()->name()),
+        /*freeCapacityOnly=*/false);
+    ASSERT_EQ(
+        candidates.back().reclaimableUsedCapacity,
+        candidateSettings[i].usedBytes);
+    if (candidateSettings[i].reclaimNanosPerByte.has_value()) {
+      candidates.back().reclaimCostNs = candidateSettings[i].usedBytes *
+          candidateSettings[i].reclaimNanosPerByte.value();
+    }
+  }
+
+  // The candidates with an unknown cost go after the ones with a known cost,
+  // the larger first.
+  test::SharedArbitratorTestHelper::sortCandidatesByReclaimCost(candidates);
+  const std::vector<int> expectedOrder{4, 2, 0, 3, 1};
+  ASSERT_EQ(candidates.size(), expectedOrder.size());
+  for (auto i = 0; i < expectedOrder.size(); ++i) {
+    ASSERT_EQ(
+        candidates[i].participant->name(),
+        tasks()[expectedOrder[i]]->pool()->name());
+  }
+}
+
 TEST_F(MockSharedArbitrationTest, enterArbitrationException) {
   const uint64_t memCapacity = 128 * MB;
   const uint64_t initPoolCapacity = memCapacity;
@@ -75,6 +75,11 @@ class SharedArbitratorTestHelper {
     return arbitrator_->hasShutdownLocked();
   }
 
+  static void sortCandidatesByReclaimCost(
+      std::vector<ArbitrationCandidate>& candidates) {
+    SharedArbitrator::sortCandidatesByReclaimCost(candidates);
+  }
+
  private:
   SharedArbitrator* const arbitrator_;
 };
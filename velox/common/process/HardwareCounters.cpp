@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/HardwareCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace facebook::velox::process {
+
+#ifdef __linux__
+namespace {
+
+int openCounter(uint32_t type, uint64_t config, int groupFd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = groupFd < 0 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  // Counts the calling thread on any CPU.
+  return syscall(
+      __NR_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, groupFd, 0);
+}
+
+} // namespace
+
+HardwareCounters::HardwareCounters() {
+  const uint64_t configs[kNumCounters] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES,
+      PERF_COUNT_HW_BRANCH_MISSES};
+  for (auto i = 0; i < kNumCounters; ++i) {
+    fds_[i] = openCounter(PERF_TYPE_HARDWARE, configs[i], groupFd_);
+    if (fds_[i] < 0) {
+      // All or nothing, so that the values of one read are consistent.
+      for (auto j = 0; j < i; ++j) {
+        close(fds_[j]);
+        fds_[j] = -1;
+      }
+      groupFd_ = -1;
+      return;
+    }
+    if (i == 0) {
+      groupFd_ = fds_[0];
+    }
+  }
+  ioctl(groupFd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(groupFd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+HardwareCounters::~HardwareCounters() {
+  for (auto fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+}
+
+bool HardwareCounters::read(HardwareCounterValues& values) const {
+  if (groupFd_ < 0) {
+    return false;
+  }
+  // PERF_FORMAT_GROUP reads the number of counters followed by their values.
+  uint64_t buffer[1 + kNumCounters];
+  if (::read(groupFd_, buffer, sizeof(buffer)) != sizeof(buffer) ||
+      buffer[0] != kNumCounters) {
+    return false;
+  }
+  values.cycles = buffer[1];
+  values.instructions = buffer[2];
+  values.llcMisses = buffer[3];
+  values.branchMisses = buffer[4];
+  return true;
+}
+#else
+HardwareCounters::HardwareCounters() = default;
+
+HardwareCounters::~HardwareCounters() = default;
+
+bool HardwareCounters::read(HardwareCounterValues& /*values*/) const {
+  return false;
+}
+#endif
+
+// static
+HardwareCounters& HardwareCounters::forThread() {
+  thread_local HardwareCounters counters;
+  return counters;
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace facebook::velox::process {
+
+/// Values of the hardware counters of the calling thread.
+struct HardwareCounterValues {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  uint64_t llcMisses{0};
+  uint64_t branchMisses{0};
+
+  HardwareCounterValues operator-(const HardwareCounterValues& other) const {
+    return {
+        cycles - other.cycles,
+        instructions - other.instructions,
+        llcMisses - other.llcMisses,
+        branchMisses - other.branchMisses};
+  }
+};
+
+/// A group of perf_event_open() counters of CPU cycles, instructions,
+/// last-level cache misses and branch mispredictions that count for the
+/// calling thread. The counters are opened on first use on each thread and
+/// stay open for the life of the thread. Reading them is one read() of the
+/// group. The counters are not available outside of Linux or when the process
+/// may not open them, e.g. with a high kernel.perf_event_paranoid or inside
+/// some containers, in which case read() returns false.
+class HardwareCounters {
+ public:
+  /// Returns the counters of the calling thread.
+  static HardwareCounters& forThread();
+
+  ~HardwareCounters();
+
+  bool available() const {
+    return groupFd_ >= 0;
+  }
+
+  /// Sets 'values' to the counts of the calling thread since the counters
+  /// were opened. Returns false with 'values' unchanged if the counters are
+  /// not available. Must be called on the thread that created 'this'.
+  bool read(HardwareCounterValues& values) const;
+
+ private:
+  HardwareCounters();
+
+  static constexpr int kNumCounters = 4;
+
+  // The file descriptor of the group leader, the cycles counter, or -1.
+  int groupFd_{-1};
+  int fds_[kNumCounters] = {-1, -1, -1, -1};
+};
+
+} // namespace facebook::velox::process
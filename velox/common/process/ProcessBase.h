@@ -50,4 +50,10 @@ bool hasAvx2();
 /// by flag.
 bool hasBmi2();
 
+/// True if the machine has Intel AVX-512 F and BW instructions and these are
+/// not disabled by flag. Unlike hasAvx2(), this does not depend on the build
+/// target. The code using these must be compiled for them with a target
+/// attribute.
+bool hasAvx512();
+
 } // namespace facebook::velox::process
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/TimelineTrace.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace facebook::velox::process {
+
+namespace {
+thread_local const TimelineTrack* currentTrack{nullptr};
+} // namespace
+
+TimelineTrace::TimelineTrace(uint32_t capacity)
+    : capacity_(std::max<uint32_t>(capacity, 1)),
+      slots_(std::make_unique<Slot[]>(capacity_)) {}
+
+// static
+uint64_t TimelineTrace::nowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void TimelineTrace::record(const TimelineEvent& event) {
+  const auto index = next_.fetch_add(1, std::memory_order_relaxed);
+  auto& slot = slots_[index % capacity_];
+  slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.event = event;
+  slot.sequence.store(2 * (index + 1), std::memory_order_release);
+}
+
+std::vector<TimelineEvent> TimelineTrace::events() const {
+  std::vector<std::pair<uint64_t, TimelineEvent>> indexedEvents;
+  indexedEvents.reserve(std::min<uint64_t>(numRecorded(), capacity_));
+  for (uint32_t i = 0; i < capacity_; ++i) {
+    const auto& slot = slots_[i];
+    const auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == 0 || sequence % 2 == 1) {
+      continue;
+    }
+    const auto event = slot.event;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+    indexedEvents.emplace_back(sequence / 2 - 1, event);
+  }
+  std::sort(
+      indexedEvents.begin(),
+      indexedEvents.end(),
+      [](const auto& left, const auto& right) {
+        return left.first < right.first;
+      });
+  std::vector<TimelineEvent> result;
+  result.reserve(indexedEvents.size());
+  for (const auto& [_, event] : indexedEvents) {
+    result.push_back(event);
+  }
+  return result;
+}
+
+// static
+const TimelineTrack* TimelineTrack::current() {
+  return currentTrack;
+}
+
+// static
+void TimelineTrack::recordOnThread(
+    const char* name,
+    const char* category,
+    uint64_t startUs,
+    const char* valueName,
+    int64_t value) {
+  const auto* track = currentTrack;
+  if (track == nullptr) {
+    return;
+  }
+  const auto nowUs = TimelineTrace::nowUs();
+  TimelineEvent event;
+  event.name = name;
+  event.category = category;
+  event.pid = track->pid;
+  event.tid = track->tid;
+  event.startUs = startUs;
+  event.durationUs = nowUs > startUs ? nowUs - startUs : 0;
+  event.valueName = valueName;
+  event.value = value;
+  track->trace->record(event);
+}
+
+ScopedTimelineTrack::ScopedTimelineTrack(const TimelineTrack* track)
+    : track_(track), prevTrack_(currentTrack) {
+  if (track_ != nullptr) {
+    currentTrack = track_;
+  }
+}
+
+ScopedTimelineTrack::~ScopedTimelineTrack() {
+  if (track_ != nullptr) {
+    currentTrack = prevTrack_;
+  }
+}
+
+} // namespace facebook::velox::process
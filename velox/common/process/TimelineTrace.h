@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// An interval or an instant on a track of a TimelineTrace. 'name' and
+/// 'category' must outlive the trace, e.g. be string literals.
+struct TimelineEvent {
+  /// The category of the I/O events. These overlap with the other events of
+  /// their track, so the trace shows them on a track of their own.
+  static constexpr const char* kIoCategory = "io";
+
+  const char* name{nullptr};
+  const char* category{nullptr};
+  /// The track of the event, e.g. the pipeline and the driver.
+  int32_t pid{0};
+  int32_t tid{0};
+  /// The start in TimelineTrace::nowUs() time.
+  uint64_t startUs{0};
+  uint64_t durationUs{0};
+  /// True for an event without duration, e.g. the arrival of a split.
+  bool instant{false};
+  /// An optional value shown with the event, e.g. bytes, if 'valueName' is
+  /// set.
+  const char* valueName{nullptr};
+  int64_t value{0};
+};
+
+/// A fixed size ring buffer of TimelineEvents that multiple threads record
+/// into without locking. Keeps the last 'capacity' events.
+class TimelineTrace {
+ public:
+  explicit TimelineTrace(uint32_t capacity);
+
+  /// Returns the monotonic time of TimelineEvent::startUs.
+  static uint64_t nowUs();
+
+  void record(const TimelineEvent& event);
+
+  /// Returns the events in the buffer in the order of record() calls. Skips
+  /// the events that are being recorded concurrently.
+  std::vector<TimelineEvent> events() const;
+
+  /// Returns the number of events recorded, including the overwritten ones.
+  uint64_t numRecorded() const {
+    return next_.load(std::memory_order_relaxed);
+  }
+
+  uint32_t capacity() const {
+    return capacity_;
+  }
+
+ private:
+  struct Slot {
+    // 0 if never written, odd while being written, 2 * (index + 1) after
+    // writing the event of the index-th record() call.
+    std::atomic_uint64_t sequence{0};
+    TimelineEvent event;
+  };
+
+  const uint32_t capacity_;
+  const std::unique_ptr<Slot[]> slots_;
+  std::atomic_uint64_t next_{0};
+};
+
+/// The TimelineTrace and the track that the calling thread records into,
+/// e.g. the events of a driver.
+struct TimelineTrack {
+  std::shared_ptr<TimelineTrace> trace;
+  int32_t pid{0};
+  int32_t tid{0};
+
+  /// Returns the track set by ScopedTimelineTrack on the calling thread or
+  /// nullptr.
+  static const TimelineTrack* current();
+
+  /// Records an interval on the current track of the thread that starts at
+  /// 'startUs' and ends now. No-op if the thread has no track.
+  static void recordOnThread(
+      const char* name,
+      const char* category,
+      uint64_t startUs,
+      const char* valueName = nullptr,
+      int64_t value = 0);
+};
+
+/// Sets the current track of the calling thread for the life of 'this'. No-op
+/// if 'track' is nullptr.
+class ScopedTimelineTrack {
+ public:
+  explicit ScopedTimelineTrack(const TimelineTrack* track);
+
+  ~ScopedTimelineTrack();
+
+ private:
+  const TimelineTrack* const track_;
+  const TimelineTrack* const prevTrack_;
+};
+
+} // namespace facebook::velox::process
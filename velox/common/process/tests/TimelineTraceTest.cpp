@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/TimelineTrace.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+TimelineEvent makeEvent(int32_t tid, int64_t value) {
+  TimelineEvent event;
+  event.name = "test";
+  event.category = "test";
+  event.tid = tid;
+  event.startUs = TimelineTrace::nowUs();
+  event.valueName = "value";
+  event.value = value;
+  return event;
+}
+
+TEST(TimelineTraceTest, keepsLastEvents) {
+  TimelineTrace trace(8);
+  ASSERT_TRUE(trace.events().empty());
+  for (auto i = 0; i < 5; ++i) {
+    trace.record(makeEvent(0, i));
+  }
+  auto events = trace.events();
+  ASSERT_EQ(events.size(), 5);
+  for (auto i = 0; i < 5; ++i) {
+    ASSERT_EQ(events[i].value, i);
+  }
+
+  for (auto i = 5; i < 20; ++i) {
+    trace.record(makeEvent(0, i));
+  }
+  ASSERT_EQ(trace.numRecorded(), 20);
+  events = trace.events();
+  ASSERT_EQ(events.size(), 8);
+  for (auto i = 0; i < 8; ++i) {
+    ASSERT_EQ(events[i].value, 12 + i);
+  }
+}
+
+TEST(TimelineTraceTest, multiThread) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumEvents = 1'000;
+  TimelineTrace trace(kNumThreads * kNumEvents);
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i] {
+      for (auto j = 0; j < kNumEvents; ++j) {
+        trace.record(makeEvent(i, j));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto events = trace.events();
+  ASSERT_EQ(events.size(), kNumThreads * kNumEvents);
+  // The events of each thread are in the order of recording.
+  std::vector<int64_t> nextValues(kNumThreads, 0);
+  for (const auto& event : events) {
+    ASSERT_EQ(event.value, nextValues[event.tid]++);
+  }
+}
+
+TEST(TimelineTraceTest, scopedTrack) {
+  const auto startUs = TimelineTrace::nowUs();
+  TimelineTrack::recordOnThread("noTrack", "test", startUs);
+  ASSERT_EQ(TimelineTrack::current(), nullptr);
+
+  TimelineTrack track{std::make_shared<TimelineTrace>(16), 1, 2};
+  {
+    ScopedTimelineTrack scopedTrack(&track);
+    ASSERT_EQ(TimelineTrack::current(), &track);
+    {
+      ScopedTimelineTrack noTrack(nullptr);
+      ASSERT_EQ(TimelineTrack::current(), &track);
+    }
+    TimelineTrack::recordOnThread("spill", "test", startUs, "rows", 10);
+  }
+  ASSERT_EQ(TimelineTrack::current(), nullptr);
+
+  const auto events = track.trace->events();
+  ASSERT_EQ(events.size(), 1);
+  ASSERT_STREQ(events[0].name, "spill");
+  ASSERT_EQ(events[0].pid, 1);
+  ASSERT_EQ(events[0].tid, 2);
+  ASSERT_EQ(events[0].startUs, startUs);
+  ASSERT_FALSE(events[0].instant);
+  ASSERT_STREQ(events[0].valueName, "rows");
+  ASSERT_EQ(events[0].value, 10);
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -631,10 +631,15 @@ class Connector {
   /// Returns a ScanTracker for 'id'. 'id' uniquely identifies the
   /// tracker and different threads will share the same
   /// instance. 'loadQuantum' is the largest single IO for the query
-  /// being tracked.
+  /// being tracked. 'fileGroupStats' is the SSD admission stats of the
+  /// cache the scan reads through, if any, which the tracker reports the
+  /// accesses to. 'history' is the access history of the scanned table, if
+  /// any, that a new tracker starts from.
   static std::shared_ptr<cache::ScanTracker> getTracker(
       const std::string& scanId,
-      int32_t loadQuantum);
+      int32_t loadQuantum,
+      cache::FileGroupStats* fileGroupStats = nullptr,
+      std::shared_ptr<cache::ScanHistory> history = nullptr);
 
   virtual folly::Executor* executor() const {
     return nullptr;
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/DecodedColumnCache.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <folly/hash/Hash.h>
+
+namespace facebook::velox::connector::hive {
+
+namespace {
+DecodedColumnCache** instancePtr() {
+  static DecodedColumnCache* instance{nullptr};
+  return &instance;
+}
+} // namespace
+
+size_t DecodedColumnCache::KeyHasher::operator()(const Key& key) const {
+  return folly::hash::hash_combine(
+      key.fileName,
+      key.fileSize,
+      key.modificationTime,
+      key.start,
+      key.length,
+      key.column,
+      key.type->hashKind(),
+      key.fingerprint);
+}
+
+// static
+DecodedColumnCache* DecodedColumnCache::getInstance() {
+  return *instancePtr();
+}
+
+// static
+void DecodedColumnCache::setInstance(DecodedColumnCache* cache) {
+  *instancePtr() = cache;
+}
+
+VectorPtr DecodedColumnCache::get(const Key& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* column = cache_.get(key);
+  if (column == nullptr) {
+    return nullptr;
+  }
+  auto result = *column;
+  cache_.release(key);
+  return result;
+}
+
+void DecodedColumnCache::put(const Key& key, VectorPtr column) {
+  VELOX_CHECK_EQ(column->pool(), pool_.get());
+  const auto bytes = column->retainedSize();
+  auto value = std::make_unique<VectorPtr>(std::move(column));
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, value.get(), bytes)) {
+    // The cache owns the value now.
+    value.release();
+  }
+}
+
+// static
+std::string DecodedColumnCache::splitKey(const Key& key) {
+  return fmt::format(
+      "{}:{}:{}:{}:{}:{}",
+      key.fileName,
+      key.fileSize,
+      key.modificationTime,
+      key.start,
+      key.length,
+      key.fingerprint);
+}
+
+bool DecodedColumnCache::startDecode(
+    const std::vector<Key>& keys,
+    ContinueFuture& future) {
+  VELOX_CHECK(!keys.empty());
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = decodes_.find(splitKey(keys[0]));
+  if (it == decodes_.end()) {
+    decodes_.emplace(splitKey(keys[0]), Decode{keys, {}});
+    return true;
+  }
+  auto& decode = it->second;
+  for (const auto& key : keys) {
+    if (std::find(decode.keys.begin(), decode.keys.end(), key) ==
+        decode.keys.end()) {
+      return true;
+    }
+  }
+  auto [promise, waitFuture] =
+      makeVeloxContinuePromiseContract("DecodedColumnCache::startDecode");
+  decode.promises.push_back(std::move(promise));
+  future = std::move(waitFuture);
+  ++numDecodeWaits_;
+  return false;
+}
+
+void DecodedColumnCache::finishDecode(const std::vector<Key>& keys) {
+  VELOX_CHECK(!keys.empty());
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = decodes_.find(splitKey(keys[0]));
+    // A reader that was not registered by startDecode() decodes other
+    // columns than the registered one.
+    if (it == decodes_.end() || it->second.keys != keys) {
+      return;
+    }
+    promises = std::move(it->second.promises);
+    decodes_.erase(it);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+DecodedColumnCache::Stats DecodedColumnCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto cacheStats = cache_.stats();
+  return Stats{
+      cacheStats.numLookups,
+      cacheStats.numHits,
+      cacheStats.numElements,
+      cacheStats.curSize,
+      numDecodeWaits_};
+}
+
+void DecodedColumnCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.free(cache_.maxSize());
+}
+
+} // namespace facebook::velox::connector::hive
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/common/future/VeloxPromise.h"
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Process-wide cache of the fully decoded columns of splits of small, hot
+/// tables, e.g. the dimension tables that are joined in most queries. A
+/// HiveDataSource that reads all the rows of a split, i.e. without filters,
+/// serves the split from here instead of decompressing and decoding the same
+/// bytes again. The cached vectors are copies in the memory pool of the
+/// cache, which allocates from the same MemoryAllocator as the
+/// AsyncDataCache, so that the AsyncDataCache evicts raw data to make room
+/// for them. The entries are keyed by the file name, size and modification
+/// time, so that a rewritten file does not get the columns of its previous
+/// version. The cached vectors are shared by the readers and must not be
+/// modified. If the fragment result cache is enabled, the cache also holds
+/// the columns of splits read with filters after the filters are applied.
+/// Their keys have the fingerprint of the filters and the partition values,
+/// so that only a scan with the same filters gets them. Concurrent scans of a
+/// split that is not cached yet decode it once: the first reader decodes the
+/// split while the readers that need no other columns wait for it and then
+/// read the cached columns. Thread safe.
+class DecodedColumnCache {
+ public:
+  struct Key {
+    std::string fileName;
+    int64_t fileSize;
+    int64_t modificationTime;
+    uint64_t start;
+    uint64_t length;
+    std::string column;
+    TypePtr type;
+    // The filters and partition values the column is read with, empty if
+    // the column has all the rows of the split.
+    std::string fingerprint;
+
+    bool operator==(const Key& other) const {
+      return fileSize == other.fileSize &&
+          modificationTime == other.modificationTime &&
+          start == other.start && length == other.length &&
+          fileName == other.fileName && column == other.column &&
+          *type == *other.type && fingerprint == other.fingerprint;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Stats {
+    uint64_t numLookups{0};
+    uint64_t numHits{0};
+    uint64_t numEntries{0};
+    uint64_t bytes{0};
+    // Number of times a reader waited for another reader to decode a split.
+    uint64_t numDecodeWaits{0};
+  };
+
+  /// 'maxBytes' is the capacity in retained bytes of the cached vectors, which
+  /// are allocated from 'pool'.
+  DecodedColumnCache(
+      uint64_t maxBytes,
+      std::shared_ptr<memory::MemoryPool> pool)
+      : pool_(std::move(pool)), cache_(maxBytes) {}
+
+  /// Returns the process-wide instance or nullptr if decoded columns are not
+  /// cached.
+  static DecodedColumnCache* getInstance();
+
+  /// Sets the process-wide instance. The caller owns 'cache' which must
+  /// outlive its use by the data sources.
+  static void setInstance(DecodedColumnCache* cache);
+
+  /// Returns the memory pool in which the cached vectors are allocated.
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  /// Returns the column of 'key' or nullptr if not cached.
+  VectorPtr get(const Key& key);
+
+  /// Adds 'column', a vector allocated from pool() with all the rows of the
+  /// column of 'key'. Evicts the least recently used entries to make room.
+  /// Does nothing if the column is cached already or larger than the
+  /// capacity.
+  void put(const Key& key, VectorPtr column);
+
+  /// Registers the caller as the reader that decodes the columns of 'keys',
+  /// which are columns of the same split, and returns true. If another reader
+  /// is decoding all these columns, returns false and sets 'future' to be
+  /// fulfilled when that reader has added its columns or stopped decoding.
+  /// The caller then looks up the columns again. If another reader decodes
+  /// only some of the columns, returns true without registering the caller.
+  bool startDecode(const std::vector<Key>& keys, ContinueFuture& future);
+
+  /// Called after a startDecode() that returned true, after the caller has
+  /// added its columns or stopped decoding them. Wakes up the waiting readers.
+  void finishDecode(const std::vector<Key>& keys);
+
+  Stats stats() const;
+
+  void clear();
+
+ private:
+  // A split being decoded by one reader for the readers waiting on it.
+  struct Decode {
+    // The columns the reader decodes.
+    std::vector<Key> keys;
+    std::vector<ContinuePromise> promises;
+  };
+
+  // Returns the key of the split of the column of 'key' in 'decodes_'.
+  static std::string splitKey(const Key& key);
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<Key, VectorPtr, std::equal_to<Key>, KeyHasher> cache_;
+  std::unordered_map<std::string, Decode> decodes_;
+  uint64_t numDecodeWaits_{0};
+};
+
+} // namespace facebook::velox::connector::hive
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/HiveCacheWarmer.h"
+
+#include <filesystem>
+
+#include "velox/dwio/common/Throttler.h"
+
+namespace facebook::velox::connector::hive {
+
+HiveCacheWarmer::HiveCacheWarmer(
+    HiveConnector* connector,
+    const std::shared_ptr<HiveTableHandle>& tableHandle,
+    const RowTypePtr& columns,
+    ConnectorQueryCtx* connectorQueryCtx,
+    Options options)
+    : options_(options), connectorQueryCtx_(connectorQueryCtx) {
+  VELOX_CHECK_NOT_NULL(connector);
+  VELOX_CHECK_NOT_NULL(connectorQueryCtx_);
+  VELOX_CHECK_NOT_NULL(
+      connectorQueryCtx_->cache(), "Warming up needs an AsyncDataCache");
+  VELOX_CHECK_GT(options_.batchRows, 0);
+  std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+      columnHandles;
+  for (auto i = 0; i < columns->size(); ++i) {
+    const auto& name = columns->nameOf(i);
+    columnHandles[name] = std::make_shared<HiveColumnHandle>(
+        name,
+        HiveColumnHandle::ColumnType::kRegular,
+        columns->childAt(i),
+        columns->childAt(i));
+  }
+  dataSource_ = connector->createDataSource(
+      columns, tableHandle, columnHandles, connectorQueryCtx_);
+}
+
+HiveCacheWarmer::Stats HiveCacheWarmer::warm(
+    const std::vector<std::shared_ptr<HiveConnectorSplit>>& splits) {
+  Stats stats;
+  for (const auto& split : splits) {
+    if (connectorQueryCtx_->cancellationToken().isCancellationRequested()) {
+      stats.cancelled = true;
+      break;
+    }
+    if (!split->cacheable) {
+      ++stats.numSkippedSplits;
+      continue;
+    }
+    stats.backoffMs += throttle(*split);
+    stats.numRows += readSplit(split);
+    ++stats.numSplits;
+  }
+  return stats;
+}
+
+int64_t HiveCacheWarmer::readSplit(
+    const std::shared_ptr<HiveConnectorSplit>& split) {
+  dataSource_->addSplit(split);
+  int64_t numRows = 0;
+  for (;;) {
+    ContinueFuture future = ContinueFuture::makeEmpty();
+    auto result = dataSource_->next(options_.batchRows, future);
+    if (!result.has_value()) {
+      future.wait();
+      continue;
+    }
+    if (result.value() == nullptr) {
+      return numRows;
+    }
+    numRows += result.value()->size();
+  }
+}
+
+uint64_t HiveCacheWarmer::throttle(const HiveConnectorSplit& split) const {
+  if (!options_.throttle) {
+    return 0;
+  }
+  auto* throttler = dwio::common::Throttler::instance();
+  if (throttler == nullptr) {
+    return 0;
+  }
+  return throttler->throttleBackoff(
+      dwio::common::Throttler::SignalType::kLocal,
+      split.connectorId,
+      std::filesystem::path(split.filePath).parent_path().string());
+}
+
+} // namespace facebook::velox::connector::hive
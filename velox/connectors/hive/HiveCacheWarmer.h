@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/TableHandle.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Preloads the streams of selected columns of Hive splits into the
+/// AsyncDataCache of a ConnectorQueryCtx and, through the write behind of the
+/// cache, into its SsdCache. This lets a node that starts cold, e.g. after a
+/// restart or when added by autoscaling, reach its steady state hit rate
+/// before it serves the queries that need the data. The splits are read with
+/// a HiveDataSource and the rows are discarded.
+class HiveCacheWarmer {
+ public:
+  struct Options {
+    /// The number of rows read per batch.
+    uint64_t batchRows{10'000};
+
+    /// If true and dwio::common::Throttler is initialized, each split is
+    /// reported to the throttler as a local signal on its directory, so that
+    /// the warm up of many files of a directory backs off exponentially and
+    /// leaves the storage to the queries.
+    bool throttle{true};
+  };
+
+  struct Stats {
+    int64_t numSplits{0};
+    /// The splits that are not cacheable and are not read.
+    int64_t numSkippedSplits{0};
+    int64_t numRows{0};
+    uint64_t backoffMs{0};
+    /// True if warm() stopped at a cancellation.
+    bool cancelled{false};
+  };
+
+  /// Reads the regular columns 'columns' of the table of 'tableHandle'.
+  /// 'connectorQueryCtx' gives the cache, the memory pools and the
+  /// cancellation token that stops warm(). It must outlive 'this'.
+  HiveCacheWarmer(
+      HiveConnector* connector,
+      const std::shared_ptr<HiveTableHandle>& tableHandle,
+      const RowTypePtr& columns,
+      ConnectorQueryCtx* connectorQueryCtx,
+      Options options);
+
+  /// Reads 'splits' one after the other on the calling thread, which should
+  /// be a low priority one. Returns after the split being read when the
+  /// cancellation of the token of 'connectorQueryCtx' is requested.
+  Stats warm(const std::vector<std::shared_ptr<HiveConnectorSplit>>& splits);
+
+ private:
+  // Reads 'split' to the end and returns the number of rows.
+  int64_t readSplit(const std::shared_ptr<HiveConnectorSplit>& split);
+
+  // Returns the backoff in ms imposed by the throttler before reading 'split'.
+  uint64_t throttle(const HiveConnectorSplit& split) const;
+
+  const Options options_;
+  ConnectorQueryCtx* const connectorQueryCtx_;
+  std::unique_ptr<DataSource> dataSource_;
+};
+
+} // namespace facebook::velox::connector::hive
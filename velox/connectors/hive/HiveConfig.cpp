@@ -67,6 +67,20 @@ uint32_t HiveConfig::maxPartitionsPerWriters(
       config_->get<uint32_t>(kMaxPartitionsPerWriters, 128));
 }
 
+uint32_t HiveConfig::maxOpenWriters(const config::ConfigBase* session) const {
+  return session->get<uint32_t>(
+      kMaxOpenWritersSession, config_->get<uint32_t>(kMaxOpenWriters, 0));
+}
+
+uint64_t HiveConfig::maxPartitionBufferBytes(
+    const config::ConfigBase* session) const {
+  return config::toCapacity(
+      session->get<std::string>(
+          kMaxPartitionBufferBytesSession,
+          config_->get<std::string>(kMaxPartitionBufferBytes, "64MB")),
+      config::CapacityUnit::BYTE);
+}
+
 bool HiveConfig::immutablePartitions() const {
   return config_->get<bool>(kImmutablePartitions, false);
 }
@@ -201,6 +215,38 @@ uint64_t HiveConfig::filePreloadThreshold() const {
   return config_->get<uint64_t>(kFilePreloadThreshold, 8UL << 20);
 }
 
+uint64_t HiveConfig::decodedColumnCacheMaxFileSize(
+    const config::ConfigBase* session) const {
+  return config::toCapacity(
+      session->get<std::string>(
+          kDecodedColumnCacheMaxFileSizeSession,
+          config_->get<std::string>(kDecodedColumnCacheMaxFileSize, "0B")),
+      config::CapacityUnit::BYTE);
+}
+
+bool HiveConfig::fragmentResultCacheEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kFragmentResultCacheEnabledSession,
+      config_->get<bool>(kFragmentResultCacheEnabled, false));
+}
+
+uint64_t HiveConfig::cacheSummaryRefreshMs() const {
+  return config_->get<uint64_t>(kCacheSummaryRefreshMs, 10'000);
+}
+
+uint32_t HiveConfig::decodingParallelism(
+    const config::ConfigBase* session) const {
+  return session->get<uint32_t>(
+      kDecodingParallelismSession,
+      config_->get<uint32_t>(kDecodingParallelism, 0));
+}
+
+uint32_t HiveConfig::numPrefetchUnits(const config::ConfigBase* session) const {
+  return session->get<uint32_t>(
+      kNumPrefetchUnitsSession, config_->get<uint32_t>(kNumPrefetchUnits, 0));
+}
+
 uint8_t HiveConfig::readTimestampUnit(const config::ConfigBase* session) const {
   const auto unit = session->get<uint8_t>(
       kReadTimestampUnitSession,
@@ -225,6 +271,13 @@ bool HiveConfig::readStatsBasedFilterReorderDisabled(
       config_->get<bool>(kReadStatsBasedFilterReorderDisabled, false));
 }
 
+bool HiveConfig::expressionFilterPushdownEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kExpressionFilterPushdownEnabledSession,
+      config_->get<bool>(kExpressionFilterPushdownEnabled, false));
+}
+
 std::string HiveConfig::hiveLocalDataPath() const {
   return config_->get<std::string>(kLocalDataPath, "");
 }
@@ -49,6 +49,21 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWritersSession =
       "max_partitions_per_writers";
 
+  /// Maximum number of files a partitioned table writer instance keeps open
+  /// at a time, 0 for no limit. When the limit is reached, the rows of the
+  /// partitions without an open file are buffered and the least recently
+  /// used file is closed to make room for the partition with the most
+  /// buffered data. Not supported for bucketed tables.
+  static constexpr const char* kMaxOpenWriters = "max-open-writers";
+  static constexpr const char* kMaxOpenWritersSession = "max_open_writers";
+
+  /// Maximum size of the rows buffered for the partitions without an open
+  /// file when 'max-open-writers' is set.
+  static constexpr const char* kMaxPartitionBufferBytes =
+      "max-partition-buffer-bytes";
+  static constexpr const char* kMaxPartitionBufferBytesSession =
+      "max_partition_buffer_bytes";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -139,6 +154,39 @@ class HiveConfig {
   /// meta data together. Optimization to decrease the small IO requests
   static constexpr const char* kFilePreloadThreshold = "file-preload-threshold";
 
+  /// The maximum size in bytes of a file whose splits are served from the
+  /// DecodedColumnCache when read without filters. 0 disables the cache.
+  static constexpr const char* kDecodedColumnCacheMaxFileSize =
+      "decoded-column-cache-max-file-size";
+  static constexpr const char* kDecodedColumnCacheMaxFileSizeSession =
+      "decoded_column_cache_max_file_size";
+
+  /// Whether the DecodedColumnCache also caches the results of splits read
+  /// with filters, keyed by the filters, e.g. for the repeated scans of
+  /// dashboards over immutable partitions.
+  static constexpr const char* kFragmentResultCacheEnabled =
+      "fragment-result-cache-enabled";
+  static constexpr const char* kFragmentResultCacheEnabledSession =
+      "fragment_result_cache_enabled";
+
+  /// The age in ms after which HiveConnector::cacheSummary() makes a new
+  /// summary of the AsyncDataCache.
+  static constexpr const char* kCacheSummaryRefreshMs =
+      "cache-summary-refresh-ms";
+
+  /// The number of threads of the connector executor that decode the
+  /// non-filter columns of a wide batch in parallel. 0 or 1 decodes them on
+  /// the driver thread.
+  static constexpr const char* kDecodingParallelism = "decoding-parallelism";
+  static constexpr const char* kDecodingParallelismSession =
+      "decoding_parallelism";
+
+  /// The number of stripes or row groups after the current one that DWRF and
+  /// Parquet readers load on the connector executor while the current one is
+  /// read. 0 loads each stripe when the reader gets to it.
+  static constexpr const char* kNumPrefetchUnits = "num-prefetch-units";
+  static constexpr const char* kNumPrefetchUnitsSession = "num_prefetch_units";
+
   /// Config used to create write files. This config is provided to underlying
   /// file system through hive connector and data sink. The config is free form.
   /// The form should be defined by the underlying file system.
@@ -180,6 +228,15 @@ class HiveConfig {
   static constexpr const char* kReadStatsBasedFilterReorderDisabledSession =
       "stats_based_filter_reorder_disabled";
 
+  /// If true, the conjuncts of the remaining filter that only read a single
+  /// VARCHAR or VARBINARY column are also evaluated by the readers while
+  /// decoding the column, once per dictionary value for dictionary encoded
+  /// columns.
+  static constexpr const char* kExpressionFilterPushdownEnabled =
+      "expression-filter-pushdown-enabled";
+  static constexpr const char* kExpressionFilterPushdownEnabledSession =
+      "expression_filter_pushdown_enabled";
+
   static constexpr const char* kLocalDataPath = "hive_local_data_path";
   static constexpr const char* kLocalFileFormat = "hive_local_file_format";
 
@@ -188,6 +245,10 @@ class HiveConfig {
 
   uint32_t maxPartitionsPerWriters(const config::ConfigBase* session) const;
 
+  uint32_t maxOpenWriters(const config::ConfigBase* session) const;
+
+  uint64_t maxPartitionBufferBytes(const config::ConfigBase* session) const;
+
   bool immutablePartitions() const;
 
   std::string gcsEndpoint() const;
@@ -240,6 +301,17 @@ class HiveConfig {
 
   uint64_t filePreloadThreshold() const;
 
+  uint64_t decodedColumnCacheMaxFileSize(
+      const config::ConfigBase* session) const;
+
+  bool fragmentResultCacheEnabled(const config::ConfigBase* session) const;
+
+  uint64_t cacheSummaryRefreshMs() const;
+
+  uint32_t decodingParallelism(const config::ConfigBase* session) const;
+
+  uint32_t numPrefetchUnits(const config::ConfigBase* session) const;
+
   // Returns the timestamp unit used when reading timestamps from files.
   uint8_t readTimestampUnit(const config::ConfigBase* session) const;
 
@@ -252,6 +324,11 @@ class HiveConfig {
   bool readStatsBasedFilterReorderDisabled(
       const config::ConfigBase* session) const;
 
+  /// Returns true if single column conjuncts of the remaining filter are
+  /// pushed down into the readers. See exec::ExpressionFilter.
+  bool expressionFilterPushdownEnabled(
+      const config::ConfigBase* session) const;
+
   /// Returns the file system path containing local data. If non-empty,
   /// initializes LocalHiveConnectorMetadata to provide metadata for the tables
   /// in the directory.
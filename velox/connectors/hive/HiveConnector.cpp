@@ -17,9 +17,14 @@
 #include "velox/connectors/hive/HiveConnector.h"
 
 #include "velox/common/base/Fs.h"
+#include "velox/common/caching/CacheSummary.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/HiveDataSink.h"
 #include "velox/connectors/hive/HiveDataSource.h"
+#include "velox/connectors/hive/HiveIndexSource.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/expression/FieldReference.h"
@@ -70,6 +75,47 @@ HiveConnector::HiveConnector(
   }
 }
 
+std::shared_ptr<const cache::CacheSummary> HiveConnector::cacheSummary() {
+  auto* cache = cache::AsyncDataCache::getInstance();
+  if (cache == nullptr) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> l(cacheSummaryMutex_);
+  if (cacheSummary_ == nullptr ||
+      getCurrentTimeMs() - cacheSummary_->createTimeMs() >=
+          hiveConfig_->cacheSummaryRefreshMs()) {
+    cacheSummary_ = std::make_shared<const cache::CacheSummary>(*cache);
+  }
+  return cacheSummary_;
+}
+
+double HiveConnector::cachedFraction(const HiveConnectorSplit& split) {
+  uint64_t size = split.length;
+  if (split.properties.has_value() &&
+      split.properties->fileSize.has_value()) {
+    const uint64_t fileSize = split.properties->fileSize.value();
+    size = split.start >= fileSize
+        ? 0
+        : std::min<uint64_t>(size, fileSize - split.start);
+  } else if (size == std::numeric_limits<uint64_t>::max()) {
+    return 0;
+  }
+  if (size == 0) {
+    return 0;
+  }
+  const auto fileNum = fileIds().id(split.filePath);
+  if (fileNum == StringIdMap::kNoId) {
+    return 0;
+  }
+  auto summary = cacheSummary();
+  if (summary == nullptr) {
+    return 0;
+  }
+  return static_cast<double>(
+             summary->cachedBytes(fileNum, split.start, size)) /
+      size;
+}
+
 std::unique_ptr<DataSource> HiveConnector::createDataSource(
     const RowTypePtr& outputType,
     const std::shared_ptr<ConnectorTableHandle>& tableHandle,
@@ -87,6 +133,29 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       hiveConfig_);
 }
 
+std::shared_ptr<IndexSource> HiveConnector::createIndexSource(
+    const RowTypePtr& inputType,
+    size_t numJoinKeys,
+    const std::vector<core::IndexLookupConditionPtr>& joinConditions,
+    const RowTypePtr& outputType,
+    const std::shared_ptr<ConnectorTableHandle>& tableHandle,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+    ConnectorQueryCtx* connectorQueryCtx) {
+  return std::make_shared<HiveIndexSource>(
+      inputType,
+      numJoinKeys,
+      joinConditions,
+      outputType,
+      tableHandle,
+      columnHandles,
+      connectorQueryCtx,
+      &fileHandleFactory_,
+      executor_,
+      hiveConfig_);
+}
+
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
     RowTypePtr inputType,
     std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
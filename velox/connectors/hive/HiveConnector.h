@@ -15,11 +15,17 @@
  */
 #pragma once
 
+#include <mutex>
+
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/core/PlanNode.h"
 
+namespace facebook::velox::cache {
+class CacheSummary;
+} // namespace facebook::velox::cache
+
 namespace facebook::velox::dwio::common {
 class DataSink;
 class DataSource;
@@ -27,6 +33,8 @@ class DataSource;
 
 namespace facebook::velox::connector::hive {
 
+struct HiveConnectorSplit;
+
 class HiveConnector : public Connector {
  public:
   HiveConnector(
@@ -60,6 +68,22 @@ class HiveConnector : public Connector {
     return true;
   }
 
+  bool supportsIndexLookup() const override {
+    return true;
+  }
+
+  /// Creates a HiveIndexSource. 'tableHandle' must be a HiveIndexTableHandle.
+  std::shared_ptr<IndexSource> createIndexSource(
+      const RowTypePtr& inputType,
+      size_t numJoinKeys,
+      const std::vector<core::IndexLookupConditionPtr>& joinConditions,
+      const RowTypePtr& outputType,
+      const std::shared_ptr<ConnectorTableHandle>& tableHandle,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      ConnectorQueryCtx* connectorQueryCtx) override;
+
   std::unique_ptr<DataSink> createDataSink(
       RowTypePtr inputType,
       std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
@@ -80,11 +104,25 @@ class HiveConnector : public Connector {
     return fileHandleFactory_.clearCache();
   }
 
+  /// Returns a summary of the file ranges in the process-wide AsyncDataCache
+  /// and its SsdCache for a scheduler to place the splits on the workers that
+  /// have their data. The summary is made again when older than
+  /// HiveConfig::kCacheSummaryRefreshMs. Returns nullptr if there is no cache.
+  std::shared_ptr<const cache::CacheSummary> cacheSummary();
+
+  /// Returns the fraction in [0, 1] of the byte range of 'split' that is in
+  /// cacheSummary(). Returns 0 if there is no cache or the size of the range
+  /// is unknown, i.e. the split goes to the end of a file of unknown size.
+  double cachedFraction(const HiveConnectorSplit& split);
+
  protected:
   const std::shared_ptr<HiveConfig> hiveConfig_;
   FileHandleFactory fileHandleFactory_;
   folly::Executor* executor_;
   std::shared_ptr<ConnectorMetadata> metadata_;
+
+  std::mutex cacheSummaryMutex_;
+  std::shared_ptr<const cache::CacheSummary> cacheSummary_;
 };
 
 class HiveConnectorFactory : public ConnectorFactory {
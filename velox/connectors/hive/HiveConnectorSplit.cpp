@@ -19,15 +19,18 @@
 namespace facebook::velox::connector::hive {
 
 std::string HiveConnectorSplit::toString() const {
-  if (tableBucketNumber.has_value()) {
-    return fmt::format(
-        "Hive: {} {} - {} {}",
-        filePath,
-        start,
-        length,
-        tableBucketNumber.value());
-  }
-  return fmt::format("Hive: {} {} - {}", filePath, start, length);
+  auto result = tableBucketNumber.has_value()
+      ? fmt::format(
+            "Hive: {} {} - {} {}",
+            filePath,
+            start,
+            length,
+            tableBucketNumber.value())
+      : fmt::format("Hive: {} {} - {}", filePath, start, length);
+  if (!coalescedFiles.empty()) {
+    result += fmt::format(" + {} coalesced files", coalescedFiles.size());
+  }
+  return result;
 }
 
 std::string HiveConnectorSplit::getFileName() const {
@@ -118,6 +121,14 @@ folly::dynamic HiveConnectorSplit::serialize() const {
     obj["rowIdProperties"] = rowIdObj;
   }
 
+  if (!coalescedFiles.empty()) {
+    folly::dynamic coalescedFilesArray = folly::dynamic::array;
+    for (const auto& file : coalescedFiles) {
+      coalescedFilesArray.push_back(file->serialize());
+    }
+    obj["coalescedFiles"] = coalescedFilesArray;
+  }
+
   return obj;
 }
 
@@ -204,7 +215,7 @@ std::shared_ptr<HiveConnectorSplit> HiveConnectorSplit::create(
         .tableGuid = rowIdObj["tableGuid"].asString()};
   }
 
-  return std::make_shared<HiveConnectorSplit>(
+  auto split = std::make_shared<HiveConnectorSplit>(
       connectorId,
       filePath,
       fileFormat,
@@ -222,6 +233,14 @@ std::shared_ptr<HiveConnectorSplit> HiveConnectorSplit::create(
       properties,
       rowIdProperties,
       bucketConversion);
+
+  const auto& coalescedFilesObj = obj.getDefault("coalescedFiles", nullptr);
+  if (coalescedFilesObj != nullptr) {
+    for (const auto& fileObj : coalescedFilesObj) {
+      split->coalescedFiles.push_back(create(fileObj));
+    }
+  }
+  return split;
 }
 
 // static
@@ -74,6 +74,13 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
 
   std::optional<HiveBucketConversion> bucketConversion;
 
+  /// Files read after 'filePath' as part of this split. Coalescing many
+  /// small files into one split shares the data source, its scan spec and
+  /// the split handling of the task between the files, and lets the files
+  /// after the current one be opened in the background. The coalesced files
+  /// must have the format of this split and no coalesced files of their own.
+  std::vector<std::shared_ptr<HiveConnectorSplit>> coalescedFiles;
+
   HiveConnectorSplit(
       const std::string& connectorId,
       const std::string& _filePath,
@@ -220,8 +227,16 @@ class HiveConnectorSplitBuilder {
     return *this;
   }
 
+  /// Adds a file read after the file of this split. See
+  /// HiveConnectorSplit::coalescedFiles.
+  HiveConnectorSplitBuilder& coalescedFile(
+      std::shared_ptr<HiveConnectorSplit> file) {
+    coalescedFiles_.push_back(std::move(file));
+    return *this;
+  }
+
   std::shared_ptr<connector::hive::HiveConnectorSplit> build() const {
-    return std::make_shared<connector::hive::HiveConnectorSplit>(
+    auto split = std::make_shared<connector::hive::HiveConnectorSplit>(
         connectorId_,
         filePath_,
         fileFormat_,
@@ -239,6 +254,8 @@ class HiveConnectorSplitBuilder {
         fileProperties_,
         rowIdProperties_,
         bucketConversion_);
+    split->coalescedFiles = coalescedFiles_;
+    return split;
   }
 
  private:
@@ -259,6 +276,7 @@ class HiveConnectorSplitBuilder {
   bool cacheable_{true};
   std::optional<FileProperties> fileProperties_;
   std::optional<RowIdProperties> rowIdProperties_ = std::nullopt;
+  std::vector<std::shared_ptr<HiveConnectorSplit>> coalescedFiles_;
 };
 
 } // namespace facebook::velox::connector::hive
@@ -747,21 +747,74 @@ bool testFilters(
   return true;
 }
 
+bool testPartitionFilters(
+    const common::ScanSpec* scanSpec,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle,
+    bool asLocalTime) {
+  for (const auto& child : scanSpec->children()) {
+    if (!child->filter()) {
+      continue;
+    }
+    const auto& name = child->fieldName();
+    const auto iter = partitionKeys.find(name);
+    if (iter == partitionKeys.end()) {
+      continue;
+    }
+    if (iter->second.has_value()) {
+      const auto handlesIter = partitionKeysHandle.find(name);
+      if (handlesIter == partitionKeysHandle.end()) {
+        // Not a partition key of the scan. testFilters() handles it.
+        continue;
+      }
+      if (!applyPartitionFilter(
+              handlesIter->second->dataType(),
+              iter->second.value(),
+              handlesIter->second->isPartitionDateValueDaysSinceEpoch(),
+              child->filter(),
+              asLocalTime)) {
+        VLOG(1) << "Skipping " << filePath
+                << " based on the value of partition key " << name;
+        return false;
+      }
+    } else if (
+        child->filter()->isDeterministic() && !child->filter()->testNull()) {
+      VLOG(1) << "Skipping " << filePath
+              << " because the filter testNull() failed for partition key "
+              << name;
+      return false;
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
     const ConnectorQueryCtx* connectorQueryCtx,
     std::shared_ptr<io::IoStatistics> ioStats,
     std::shared_ptr<filesystems::File::IoStats> fsStats,
-    folly::Executor* executor) {
-  if (connectorQueryCtx->cache()) {
+    folly::Executor* executor,
+    const std::string& tableName) {
+  // The prefetch of a new scan of a table starts from the columns the past
+  // scans of the table read.
+  auto history =
+      tableName.empty() ? nullptr : cache::ScanHistory::forTable(tableName);
+  if (auto* cache = connectorQueryCtx->cache()) {
+    auto* ssdCache = cache->ssdCache();
     return std::make_unique<dwio::common::CachedBufferedInput>(
         fileHandle.file,
         dwio::common::MetricsLog::voidLog(),
         fileHandle.uuid.id(),
-        connectorQueryCtx->cache(),
+        cache,
         Connector::getTracker(
-            connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+            connectorQueryCtx->scanId(),
+            readerOpts.loadQuantum(),
+            ssdCache != nullptr ? &ssdCache->groupStats() : nullptr,
+            std::move(history)),
         fileHandle.groupId.id(),
         ioStats,
         std::move(fsStats),
@@ -773,7 +826,10 @@ std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
       dwio::common::MetricsLog::voidLog(),
       fileHandle.uuid.id(),
       Connector::getTracker(
-          connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+          connectorQueryCtx->scanId(),
+          readerOpts.loadQuantum(),
+          nullptr,
+          std::move(history)),
       fileHandle.groupId.id(),
       std::move(ioStats),
       std::move(fsStats),
@@ -910,4 +966,32 @@ core::TypedExprPtr extractFiltersFromRemainingFilter(
   }
   return expr;
 }
+
+void extractExpressionFilters(
+    const core::TypedExprPtr& remainingFilter,
+    core::ExpressionEvaluator* evaluator,
+    common::SubfieldFilters& filters) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(remainingFilter.get());
+  if (call != nullptr && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      extractExpressionFilters(input, evaluator, filters);
+    }
+    return;
+  }
+  try {
+    common::Subfield subfield;
+    std::unique_ptr<common::Filter> filter =
+        exec::ExpressionFilter::create(remainingFilter, evaluator, subfield);
+    if (filter == nullptr) {
+      return;
+    }
+    if (auto it = filters.find(subfield); it != filters.end()) {
+      filter = filter->mergeWith(it->second.get());
+    }
+    filters.insert_or_assign(std::move(subfield), std::move(filter));
+  } catch (const VeloxException&) {
+    LOG(WARNING) << "Unexpected failure when extracting expression filter for: "
+                 << remainingFilter->toString();
+  }
+}
 } // namespace facebook::velox::connector::hive
@@ -95,13 +95,26 @@ bool testFilters(
         partitionKeysHandle,
     bool asLocalTime);
 
+/// Returns false if the partition values of a split fail the filters of
+/// 'scanSpec' on the partition keys. Unlike testFilters(), this needs no
+/// reader, so a split can be pruned before its file is opened.
+bool testPartitionFilters(
+    const common::ScanSpec* scanSpec,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle,
+    bool asLocalTime);
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
     const ConnectorQueryCtx* connectorQueryCtx,
     std::shared_ptr<io::IoStatistics> ioStats,
     std::shared_ptr<filesystems::File::IoStats> fsStats,
-    folly::Executor* executor);
+    folly::Executor* executor,
+    const std::string& tableName = "");
 
 core::TypedExprPtr extractFiltersFromRemainingFilter(
     const core::TypedExprPtr& expr,
@@ -110,4 +123,13 @@ core::TypedExprPtr extractFiltersFromRemainingFilter(
     common::SubfieldFilters& filters,
     double& sampleRate);
 
+/// Adds an exec::ExpressionFilter to 'filters' for each conjunct of
+/// 'remainingFilter' that is a deterministic predicate over a single top level
+/// VARCHAR or VARBINARY column, e.g. lower(c) = 'us'. The conjuncts must stay
+/// in the remaining filter. 'evaluator' must outlive 'filters'.
+void extractExpressionFilters(
+    const core::TypedExprPtr& remainingFilter,
+    core::ExpressionEvaluator* evaluator,
+    common::SubfieldFilters& filters);
+
 } // namespace facebook::velox::connector::hive
@@ -29,6 +29,7 @@
 #include "velox/dwio/common/SortingWriter.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/SortBuffer.h"
+#include "velox/vector/DecodedVector.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -59,6 +60,99 @@ RowTypePtr getNonPartitionTypes(
   return ROW(std::move(childNames), std::move(childTypes));
 }
 
+// Name of the Z-order key column sorted on by a clustered write.
+constexpr const char* kClusteringKeyColumn = "$clustering_key";
+
+constexpr uint64_t kSignBit = 1ULL << 63;
+
+bool isClusteringType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+uint64_t signedPrefix(int64_t value) {
+  return static_cast<uint64_t>(value) ^ kSignBit;
+}
+
+uint64_t doublePrefix(double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & kSignBit) ? ~bits : bits | kSignBit;
+}
+
+// Returns a 64 bit prefix of the value at 'row' whose unsigned order is the
+// order of the values. Nulls sort first.
+uint64_t orderPreservingPrefix(
+    const DecodedVector& decoded,
+    vector_size_t row,
+    TypeKind kind) {
+  if (decoded.isNullAt(row)) {
+    return 0;
+  }
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+      return decoded.valueAt<bool>(row) ? kSignBit : 1;
+    case TypeKind::TINYINT:
+      return signedPrefix(decoded.valueAt<int8_t>(row));
+    case TypeKind::SMALLINT:
+      return signedPrefix(decoded.valueAt<int16_t>(row));
+    case TypeKind::INTEGER:
+      return signedPrefix(decoded.valueAt<int32_t>(row));
+    case TypeKind::BIGINT:
+      return signedPrefix(decoded.valueAt<int64_t>(row));
+    case TypeKind::HUGEINT:
+      return signedPrefix(
+          static_cast<int64_t>(decoded.valueAt<int128_t>(row) >> 64));
+    case TypeKind::REAL:
+      return doublePrefix(decoded.valueAt<float>(row));
+    case TypeKind::DOUBLE:
+      return doublePrefix(decoded.valueAt<double>(row));
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      const auto value = decoded.valueAt<StringView>(row);
+      uint64_t prefix = 0;
+      for (auto i = 0; i < std::min<int32_t>(8, value.size()); ++i) {
+        prefix |= static_cast<uint64_t>(static_cast<uint8_t>(value.data()[i]))
+            << (56 - 8 * i);
+      }
+      return prefix;
+    }
+    case TypeKind::TIMESTAMP:
+      return signedPrefix(decoded.valueAt<Timestamp>(row).getSeconds());
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Interleaves the high bits of the 'numColumns' 'prefixes' so that the order of
+// the result is the Z-order of the prefixes.
+uint64_t zOrder(const uint64_t* prefixes, int32_t numColumns) {
+  const int32_t bitsPerColumn = 64 / numColumns;
+  uint64_t result = 0;
+  int32_t resultBit = 63;
+  for (int32_t bit = 63; bit > 63 - bitsPerColumn; --bit) {
+    for (auto i = 0; i < numColumns; ++i) {
+      result |= ((prefixes[i] >> bit) & 1) << resultBit;
+      --resultBit;
+    }
+  }
+  return result;
+}
+
 // Filters out partition columns if there is any.
 RowVectorPtr makeDataInput(
     const std::vector<column_index_t>& dataCols,
@@ -400,6 +494,10 @@ HiveDataSink::HiveDataSink(
       updateMode_(getUpdateMode()),
       maxOpenWriters_(hiveConfig_->maxPartitionsPerWriters(
           connectorQueryCtx->sessionProperties())),
+      openWriterLimit_(
+          hiveConfig_->maxOpenWriters(connectorQueryCtx->sessionProperties())),
+      maxPartitionBufferBytes_(hiveConfig_->maxPartitionBufferBytes(
+          connectorQueryCtx->sessionProperties())),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty()
@@ -425,6 +523,11 @@ HiveDataSink::HiveDataSink(
   if (isBucketed()) {
     VELOX_USER_CHECK_LT(
         bucketCount_, maxBucketCount(), "bucketCount exceeds the limit");
+    VELOX_USER_CHECK_EQ(
+        openWriterLimit_,
+        0,
+        "{} is not supported for bucketed tables",
+        HiveConfig::kMaxOpenWritersSession);
   }
   VELOX_USER_CHECK(
       (commitStrategy_ == CommitStrategy::kNoCommit) ||
@@ -432,6 +535,12 @@ HiveDataSink::HiveDataSink(
       "Unsupported commit strategy: {}",
       commitStrategyToString(commitStrategy_));
 
+  if (!insertTableHandle_->clusteredBy().empty() &&
+      (!isBucketed() ||
+       insertTableHandle_->bucketProperty()->sortedBy().empty())) {
+    setupClusteredWrite();
+  }
+
   if (insertTableHandle_->ensureFiles()) {
     VELOX_CHECK(
         !isPartitioned() && !isBucketed(),
@@ -462,6 +571,66 @@ HiveDataSink::HiveDataSink(
   }
 }
 
+void HiveDataSink::setupClusteredWrite() {
+  const auto& clusteredBy = insertTableHandle_->clusteredBy();
+  VELOX_USER_CHECK_LE(clusteredBy.size(), 64, "Too many clustering columns");
+  const auto dataType = getNonPartitionTypes(dataChannels_, inputType_);
+  for (const auto& name : clusteredBy) {
+    const auto channel = dataType->getChildIdxIfExists(name);
+    VELOX_USER_CHECK(
+        channel.has_value(),
+        "Clustering column must be a non-partition column: {}",
+        name);
+    VELOX_USER_CHECK(
+        isClusteringType(dataType->childAt(channel.value())),
+        "Unsupported clustering column type: {} {}",
+        name,
+        dataType->childAt(channel.value())->toString());
+    clusteringChannels_.push_back(channel.value());
+  }
+
+  auto names = dataType->names();
+  auto types = dataType->children();
+  sortColumnIndices_.push_back(names.size());
+  sortCompareFlags_.push_back(
+      {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue});
+  names.push_back(kClusteringKeyColumn);
+  types.push_back(BIGINT());
+  clusteringInputType_ = ROW(std::move(names), std::move(types));
+}
+
+RowVectorPtr HiveDataSink::appendClusteringKey(
+    const RowVectorPtr& dataInput) const {
+  const auto numRows = dataInput->size();
+  const auto numColumns = clusteringChannels_.size();
+  std::vector<uint64_t> prefixes(numRows * numColumns);
+  DecodedVector decoded;
+  for (auto i = 0; i < numColumns; ++i) {
+    const auto& column = dataInput->childAt(clusteringChannels_[i]);
+    decoded.decode(*column);
+    for (auto row = 0; row < numRows; ++row) {
+      prefixes[row * numColumns + i] =
+          orderPreservingPrefix(decoded, row, column->typeKind());
+    }
+  }
+
+  auto key = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), numRows, dataInput->pool());
+  auto* rawKey = key->mutableRawValues();
+  for (auto row = 0; row < numRows; ++row) {
+    rawKey[row] = static_cast<int64_t>(
+        zOrder(&prefixes[row * numColumns], numColumns) ^ kSignBit);
+  }
+  auto children = dataInput->children();
+  children.push_back(std::move(key));
+  return std::make_shared<RowVector>(
+      dataInput->pool(),
+      clusteringInputType_,
+      dataInput->nulls(),
+      numRows,
+      std::move(children));
+}
+
 bool HiveDataSink::canReclaim() const {
   // Currently, we only support memory reclaim on dwrf file writer.
   return (spillConfig_ != nullptr) &&
@@ -486,6 +655,11 @@ void HiveDataSink::appendData(RowVectorPtr input) {
     input->childAt(i)->loadedVector();
   }
 
+  if (openWriterLimit_ > 0) {
+    appendWithOpenWriterLimit(input);
+    return;
+  }
+
   // All inputs belong to a single non-bucketed partition. The partition id
   // must be zero.
   if (!isBucketed() && partitionIdGenerator_->numPartitions() == 1) {
@@ -509,11 +683,132 @@ void HiveDataSink::appendData(RowVectorPtr input) {
   }
 }
 
+void HiveDataSink::appendWithOpenWriterLimit(const RowVectorPtr& input) {
+  VELOX_CHECK(isPartitioned() && !isBucketed());
+  auto* pool = connectorQueryCtx_->memoryPool();
+  const auto numPartitions = partitionIdGenerator_->numPartitions();
+  if (partitionBuffers_.size() < numPartitions) {
+    partitionBuffers_.resize(numPartitions);
+    partitionBufferBytes_.resize(numPartitions, 0);
+  }
+
+  // Groups the rows by partition with a counting sort.
+  const vector_size_t numRows = partitionIds_.size();
+  std::vector<vector_size_t> offsets(numPartitions + 1, 0);
+  for (auto row = 0; row < numRows; ++row) {
+    ++offsets[partitionIds_[row] + 1];
+  }
+  for (auto i = 0; i < numPartitions; ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+  auto indices = allocateIndices(numRows, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  auto next = offsets;
+  for (auto row = 0; row < numRows; ++row) {
+    rawIndices[next[partitionIds_[row]]++] = row;
+  }
+
+  for (uint32_t partition = 0; partition < numPartitions; ++partition) {
+    const auto numPartitionRows = offsets[partition + 1] - offsets[partition];
+    if (numPartitionRows == 0) {
+      continue;
+    }
+    auto rows = numPartitionRows == numRows
+        ? input
+        : exec::wrap(
+              numPartitionRows,
+              Buffer::slice<vector_size_t>(
+                  indices, offsets[partition], numPartitionRows, pool),
+              input);
+    const HiveWriterId id{partition};
+    auto it = writerIndexMap_.find(id);
+    if (it != writerIndexMap_.end()) {
+      write(it->second, rows);
+    } else if (writerIndexMap_.size() < openWriterLimit_) {
+      flushPartitionBuffer(partition);
+      write(writerIndexMap_.at(id), rows);
+    } else {
+      bufferPartitionRows(partition, rows);
+    }
+  }
+
+  while (totalPartitionBufferBytes_ > maxPartitionBufferBytes_) {
+    const auto largest = std::max_element(
+        partitionBufferBytes_.begin(), partitionBufferBytes_.end());
+    flushPartitionBuffer(largest - partitionBufferBytes_.begin());
+  }
+}
+
+void HiveDataSink::bufferPartitionRows(
+    uint32_t partitionId,
+    const RowVectorPtr& rows) {
+  auto& buffer = partitionBuffers_[partitionId];
+  if (buffer == nullptr) {
+    buffer = BaseVector::create<RowVector>(
+        inputType_, 0, connectorQueryCtx_->memoryPool());
+  }
+  const auto offset = buffer->size();
+  buffer->resize(offset + rows->size());
+  buffer->copy(rows.get(), offset, 0, rows->size());
+  const auto bytes = rows->estimateFlatSize();
+  partitionBufferBytes_[partitionId] += bytes;
+  totalPartitionBufferBytes_ += bytes;
+}
+
+void HiveDataSink::flushPartitionBuffer(uint32_t partitionId) {
+  const HiveWriterId id{partitionId};
+  auto it = writerIndexMap_.find(id);
+  const auto index =
+      it != writerIndexMap_.end() ? it->second : openWriter(id);
+  if (partitionId >= partitionBuffers_.size() ||
+      partitionBuffers_[partitionId] == nullptr) {
+    return;
+  }
+  auto buffer = std::move(partitionBuffers_[partitionId]);
+  totalPartitionBufferBytes_ -= partitionBufferBytes_[partitionId];
+  partitionBufferBytes_[partitionId] = 0;
+  write(index, buffer);
+}
+
+void HiveDataSink::flushPartitionBuffers() {
+  for (uint32_t partition = 0; partition < partitionBuffers_.size();
+       ++partition) {
+    if (partitionBuffers_[partition] != nullptr) {
+      flushPartitionBuffer(partition);
+    }
+  }
+  VELOX_CHECK_EQ(totalPartitionBufferBytes_, 0);
+}
+
+uint32_t HiveDataSink::openWriter(const HiveWriterId& id) {
+  if (writerIndexMap_.size() >= openWriterLimit_) {
+    auto leastRecentlyUsed = writerIndexMap_.begin();
+    for (auto it = writerIndexMap_.begin(); it != writerIndexMap_.end();
+         ++it) {
+      if (writerLastUse_[it->second] <
+          writerLastUse_[leastRecentlyUsed->second]) {
+        leastRecentlyUsed = it;
+      }
+    }
+    const auto index = leastRecentlyUsed->second;
+    {
+      WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+      writers_[index]->close();
+      writers_[index].reset();
+    }
+    writerIndexMap_.erase(leastRecentlyUsed);
+    addThreadLocalRuntimeStat(kClosedIdleWriters, RuntimeCounter(1));
+  }
+  return appendWriter(id);
+}
+
 void HiveDataSink::write(size_t index, RowVectorPtr input) {
   WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   auto dataInput = makeDataInput(dataChannels_, input);
 
-  writers_[index]->write(dataInput);
+  writers_[index]->write(
+      clusteredWrite() ? appendClusteringKey(dataInput) : dataInput);
+  writerLastUse_[index] = ++writeSequence_;
   writerInfo_[index]->inputSizeInBytes += dataInput->estimateFlatSize();
   writerInfo_[index]->numWrittenRows += dataInput->size();
 }
@@ -593,6 +888,15 @@ DataSink::Stats HiveDataSink::stats() const {
 std::shared_ptr<memory::MemoryPool> HiveDataSink::createWriterPool(
     const HiveWriterId& writerId) {
   auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
+  if (openWriterLimit_ > 0) {
+    // A partition can have several writers over time, told apart by their
+    // index.
+    return connectorPool->addAggregateChild(fmt::format(
+        "{}.{}.{}",
+        connectorPool->name(),
+        writerId.toString(),
+        writers_.size()));
+  }
   return connectorPool->addAggregateChild(
       fmt::format("{}.{}", connectorPool->name(), writerId.toString()));
 }
@@ -644,6 +948,10 @@ bool HiveDataSink::finish() {
   // Flush is reentry state.
   setState(State::kFinishing);
 
+  if (openWriterLimit_ > 0) {
+    flushPartitionBuffers();
+  }
+
   // As for now, only sorted writer needs flush buffered data. For non-sorted
   // writer, data is directly written to the underlying file writer.
   if (!sortWrite()) {
@@ -711,11 +1019,17 @@ void HiveDataSink::closeInternal() {
 
   if (state_ == State::kClosed) {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->close();
     }
   } else {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->abort();
     }
@@ -733,9 +1047,9 @@ uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
 uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   // Check max open writers.
   VELOX_USER_CHECK_LE(
-      writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+      writerIndexMap_.size(), maxOpenWriters_, "Exceeded open writer limit");
   VELOX_CHECK_EQ(writers_.size(), writerInfo_.size());
-  VELOX_CHECK_EQ(writerIndexMap_.size(), writerInfo_.size());
+  VELOX_CHECK_LE(writerIndexMap_.size(), writerInfo_.size());
 
   std::optional<std::string> partitionName;
   if (isPartitioned()) {
@@ -828,6 +1142,7 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       options);
   writer = maybeCreateBucketSortWriter(std::move(writer));
   writers_.emplace_back(std::move(writer));
+  writerLastUse_.emplace_back(++writeSequence_);
   // Extends the buffer used for partition rows calculations.
   partitionSizes_.emplace_back(0);
   partitionRows_.emplace_back(nullptr);
@@ -845,8 +1160,9 @@ HiveDataSink::maybeCreateBucketSortWriter(
   }
   auto* sortPool = writerInfo_.back()->sortPool.get();
   VELOX_CHECK_NOT_NULL(sortPool);
+  auto dataType = getNonPartitionTypes(dataChannels_, inputType_);
   auto sortBuffer = std::make_unique<exec::SortBuffer>(
-      getNonPartitionTypes(dataChannels_, inputType_),
+      clusteredWrite() ? clusteringInputType_ : dataType,
       sortColumnIndices_,
       sortCompareFlags_,
       sortPool,
@@ -861,7 +1177,8 @@ HiveDataSink::maybeCreateBucketSortWriter(
           connectorQueryCtx_->sessionProperties()),
       hiveConfig_->sortWriterMaxOutputBytes(
           connectorQueryCtx_->sessionProperties()),
-      sortWriterFinishTimeSliceLimitMs_);
+      sortWriterFinishTimeSliceLimitMs_,
+      clusteredWrite() ? std::move(dataType) : nullptr);
 }
 
 HiveWriterId HiveDataSink::getWriterId(size_t row) const {
@@ -1071,6 +1388,13 @@ folly::dynamic HiveInsertTableHandle::serialize() const {
   obj["serdeParameters"] = params;
   obj["ensureFiles"] = ensureFiles_;
   obj["fileNameGenerator"] = fileNameGenerator_->serialize();
+  if (!clusteredBy_.empty()) {
+    folly::dynamic clusteredBy = folly::dynamic::array;
+    for (const auto& column : clusteredBy_) {
+      clusteredBy.push_back(column);
+    }
+    obj["clusteredBy"] = clusteredBy;
+  }
   return obj;
 }
 
@@ -1104,6 +1428,13 @@ HiveInsertTableHandlePtr HiveInsertTableHandle::create(
 
   auto fileNameGenerator =
       ISerializable::deserialize<FileNameGenerator>(obj["fileNameGenerator"]);
+
+  std::vector<std::string> clusteredBy;
+  if (obj.count("clusteredBy") > 0) {
+    for (const auto& column : obj["clusteredBy"]) {
+      clusteredBy.push_back(column.asString());
+    }
+  }
   return std::make_shared<HiveInsertTableHandle>(
       inputColumns,
       locationHandle,
@@ -1113,7 +1444,8 @@ HiveInsertTableHandlePtr HiveInsertTableHandle::create(
       serdeParameters,
       nullptr, // writerOptions is not serializable
       ensureFiles,
-      fileNameGenerator);
+      fileNameGenerator,
+      std::move(clusteredBy));
 }
 
 void HiveInsertTableHandle::registerSerDe() {
@@ -1147,6 +1479,13 @@ std::string HiveInsertTableHandle::toString() const {
     }
   }
   out << ", fileNameGenerator: " << fileNameGenerator_->toString();
+  if (!clusteredBy_.empty()) {
+    out << ", clusteredBy: [";
+    for (const auto& column : clusteredBy_) {
+      out << " " << column;
+    }
+    out << " ]";
+  }
   out << "]";
   return out.str();
 }
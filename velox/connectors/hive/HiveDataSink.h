@@ -245,7 +245,12 @@ class HiveInsertTableHandle : public ConnectorInsertTableHandle {
       // engine handles ensuring a 1 to 1 mapping from task to bucket.
       const bool ensureFiles = false,
       std::shared_ptr<const FileNameGenerator> fileNameGenerator =
-          std::make_shared<const HiveInsertFileNameGenerator>())
+          std::make_shared<const HiveInsertFileNameGenerator>(),
+      // Columns to cluster the rows of each written file on when the table
+      // has no sort order. The rows are sorted on the Z-order value of these
+      // columns so that the min/max statistics of stripes and row groups are
+      // selective for filters on any of them.
+      std::vector<std::string> clusteredBy = {})
       : inputColumns_(std::move(inputColumns)),
         locationHandle_(std::move(locationHandle)),
         storageFormat_(storageFormat),
@@ -254,7 +259,8 @@ class HiveInsertTableHandle : public ConnectorInsertTableHandle {
         serdeParameters_(serdeParameters),
         writerOptions_(writerOptions),
         ensureFiles_(ensureFiles),
-        fileNameGenerator_(std::move(fileNameGenerator)) {
+        fileNameGenerator_(std::move(fileNameGenerator)),
+        clusteredBy_(std::move(clusteredBy)) {
     if (compressionKind.has_value()) {
       VELOX_CHECK(
           compressionKind.value() != common::CompressionKind_MAX,
@@ -312,6 +318,10 @@ class HiveInsertTableHandle : public ConnectorInsertTableHandle {
     return fileNameGenerator_;
   }
 
+  const std::vector<std::string>& clusteredBy() const {
+    return clusteredBy_;
+  }
+
   bool supportsMultiThreading() const override {
     return true;
   }
@@ -342,6 +352,7 @@ class HiveInsertTableHandle : public ConnectorInsertTableHandle {
   const std::shared_ptr<dwio::common::WriterOptions> writerOptions_;
   const bool ensureFiles_;
   const std::shared_ptr<const FileNameGenerator> fileNameGenerator_;
+  const std::vector<std::string> clusteredBy_;
 };
 
 /// Parameters for Hive writers.
@@ -494,6 +505,7 @@ class HiveDataSink : public DataSink {
  public:
   /// The list of runtime stats reported by hive data sink
   static constexpr const char* kEarlyFlushedRawBytes = "earlyFlushedRawBytes";
+  static constexpr const char* kClosedIdleWriters = "closedIdleWriters";
 
   /// Defines the execution states of a hive data sink running internally.
   enum class State {
@@ -587,6 +599,19 @@ class HiveDataSink : public DataSink {
     return !sortColumnIndices_.empty();
   }
 
+  // Returns true if the rows of each file are sorted on the Z-order value of
+  // the clustering columns of the insert table handle.
+  FOLLY_ALWAYS_INLINE bool clusteredWrite() const {
+    return !clusteringChannels_.empty();
+  }
+
+  // Sets up sorting each file on the Z-order value of the clustering columns.
+  void setupClusteredWrite();
+
+  // Returns 'dataInput' with the Z-order value of the clustering columns
+  // appended as a BIGINT column.
+  RowVectorPtr appendClusteringKey(const RowVectorPtr& dataInput) const;
+
   // Returns true if the table is partitioned.
   FOLLY_ALWAYS_INLINE bool isPartitioned() const {
     return partitionIdGenerator_ != nullptr;
@@ -629,6 +654,27 @@ class HiveDataSink : public DataSink {
   // the newly created writer in 'writers_'.
   uint32_t appendWriter(const HiveWriterId& id);
 
+  // Writes 'input' when the number of open writers is limited by
+  // 'openWriterLimit_'. The rows of a partition are written to its open
+  // writer if there is one or to a new writer if the limit is not reached,
+  // and buffered otherwise. The largest buffers are then written until the
+  // buffered size is within 'maxPartitionBufferBytes_'.
+  void appendWithOpenWriterLimit(const RowVectorPtr& input);
+
+  // Buffers 'rows' of partition 'partitionId' with no open writer.
+  void bufferPartitionRows(uint32_t partitionId, const RowVectorPtr& rows);
+
+  // Writes the buffered rows of 'partitionId', opening a writer for the
+  // partition if needed.
+  void flushPartitionBuffer(uint32_t partitionId);
+
+  // Writes the rows of all the partition buffers.
+  void flushPartitionBuffers();
+
+  // Opens a writer for 'id', first closing the least recently used writer if
+  // 'openWriterLimit_' writers are open. Returns the index of the writer.
+  uint32_t openWriter(const HiveWriterId& id);
+
   std::unique_ptr<facebook::velox::dwio::common::Writer>
   maybeCreateBucketSortWriter(
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
@@ -665,6 +711,11 @@ class HiveDataSink : public DataSink {
   const std::shared_ptr<const HiveConfig> hiveConfig_;
   const HiveWriterParameters::UpdateMode updateMode_;
   const uint32_t maxOpenWriters_;
+  // The maximum number of writers open at a time for a partitioned write, 0
+  // for no limit. The files of closed writers stay in 'writers_' as nullptr
+  // and a partition whose writer is closed gets a new file for its next rows.
+  const uint32_t openWriterLimit_;
+  const uint64_t maxPartitionBufferBytes_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   // Indices of dataChannel are stored in ascending order
@@ -678,6 +729,11 @@ class HiveDataSink : public DataSink {
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
 
+  // Channels of the clustering columns in the data columns and the type of the
+  // data columns followed by the Z-order key, which the sort buffer sorts on.
+  std::vector<column_index_t> clusteringChannels_;
+  RowTypePtr clusteringInputType_;
+
   State state_{State::kRunning};
 
   tsan_atomic<bool> nonReclaimableSection_{false};
@@ -692,6 +748,16 @@ class HiveDataSink : public DataSink {
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
+  // The value of 'writeSequence_' at the last write to each writer, for
+  // closing the least recently used writer.
+  std::vector<uint64_t> writerLastUse_;
+  uint64_t writeSequence_{0};
+
+  // The rows of the partitions without an open writer, indexed by partition
+  // id, and their estimated size, used with 'openWriterLimit_'.
+  std::vector<RowVectorPtr> partitionBuffers_;
+  std::vector<uint64_t> partitionBufferBytes_;
+  uint64_t totalPartitionBufferBytes_{0};
 
   // Below are structures updated when processing current input. partitionIds_
   // are indexed by the row of input_. partitionRows_, rawPartitionRows_ and
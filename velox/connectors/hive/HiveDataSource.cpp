@@ -17,10 +17,13 @@
 #include "velox/connectors/hive/HiveDataSource.h"
 
 #include <fmt/ranges.h>
+#include <folly/json.h>
+#include <map>
 #include <string>
 #include <unordered_map>
 
 #include "velox/common/testutil/TestValue.h"
+#include "velox/connectors/hive/DecodedColumnCache.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/expression/FieldReference.h"
@@ -54,6 +57,82 @@ bool shouldEagerlyMaterialize(
   return false;
 }
 
+// Returns true if the dynamic filters on a column of type 'type' can be
+// evaluated on the vectors of the DecodedColumnCache by testFilter().
+bool isDecodedColumnCacheable(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns true if the value at 'row' of 'decoded' passes 'filter'.
+bool testFilter(
+    const common::Filter& filter,
+    const DecodedVector& decoded,
+    vector_size_t row) {
+  if (decoded.isNullAt(row)) {
+    return filter.testNull();
+  }
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::BOOLEAN:
+      return filter.testBool(decoded.valueAt<bool>(row));
+    case TypeKind::TINYINT:
+      return filter.testInt64(decoded.valueAt<int8_t>(row));
+    case TypeKind::SMALLINT:
+      return filter.testInt64(decoded.valueAt<int16_t>(row));
+    case TypeKind::INTEGER:
+      return filter.testInt64(decoded.valueAt<int32_t>(row));
+    case TypeKind::BIGINT:
+      return filter.testInt64(decoded.valueAt<int64_t>(row));
+    case TypeKind::HUGEINT:
+      return filter.testInt128(decoded.valueAt<int128_t>(row));
+    case TypeKind::REAL:
+      return filter.testFloat(decoded.valueAt<float>(row));
+    case TypeKind::DOUBLE:
+      return filter.testDouble(decoded.valueAt<double>(row));
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      const auto value = decoded.valueAt<StringView>(row);
+      return filter.testBytes(value.data(), value.size());
+    }
+    case TypeKind::TIMESTAMP:
+      return filter.testTimestamp(decoded.valueAt<Timestamp>(row));
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Returns a string that is the same for two scans if they read the same rows
+// of a split, i.e. have the same subfield filters and remaining filter.
+std::string filterFingerprint(
+    const common::SubfieldFilters& filters,
+    const core::TypedExprPtr& remainingFilter) {
+  std::vector<std::string> parts;
+  parts.reserve(filters.size() + 1);
+  for (const auto& [subfield, filter] : filters) {
+    parts.push_back(fmt::format(
+        "{}:{}", subfield.toString(), folly::toJson(filter->serialize())));
+  }
+  std::sort(parts.begin(), parts.end());
+  if (remainingFilter) {
+    parts.push_back(remainingFilter->toString());
+  }
+  return fmt::format("{}", fmt::join(parts, ";"));
+}
+
 } // namespace
 
 HiveDataSource::HiveDataSource(
@@ -142,6 +221,12 @@ HiveDataSource::HiveDataSource(
     randomSkip_ = std::make_shared<random::RandomSkipTracker>(sampleRate);
   }
 
+  if (remainingFilter &&
+      hiveConfig_->expressionFilterPushdownEnabled(
+          connectorQueryCtx_->sessionProperties())) {
+    extractExpressionFilters(remainingFilter, expressionEvaluator_, filters_);
+  }
+
   if (remainingFilter) {
     remainingFilterExprSet_ = expressionEvaluator_->compile(remainingFilter);
     auto& remainingFilterExpr = remainingFilterExprSet_->expr(0);
@@ -201,6 +286,24 @@ HiveDataSource::HiveDataSource(
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
         *scanSpec_, *remainingFilter, expressionEvaluator_);
   }
+  const bool fragmentResultCacheEnabled =
+      hiveConfig_->fragmentResultCacheEnabled(
+          connectorQueryCtx_->sessionProperties());
+  decodedColumnCacheEligible_ =
+      (fragmentResultCacheEnabled ||
+       (filters_.empty() && !remainingFilter && partitionKeys_.empty())) &&
+      !randomSkip_ && infoColumns_.empty() &&
+      !specialColumns_.rowIndex.has_value() &&
+      !specialColumns_.rowId.has_value() && subfields_.empty() &&
+      outputType_->size() > 0 &&
+      std::all_of(
+          outputType_->children().begin(),
+          outputType_->children().end(),
+          [](const TypePtr& type) { return isDecodedColumnCacheable(*type); });
+  if (decodedColumnCacheEligible_ &&
+      (!filters_.empty() || remainingFilter || !partitionKeys_.empty())) {
+    filterFingerprint_ = filterFingerprint(filters_, remainingFilter);
+  }
 
   ioStats_ = std::make_shared<io::IoStatistics>();
   fsStats_ = std::make_shared<filesystems::File::IoStats>();
@@ -297,6 +400,10 @@ void HiveDataSource::setupRowIdColumn() {
           connectorQueryCtx_->memoryPool());
 }
 
+HiveDataSource::~HiveDataSource() {
+  finishSharedDecode();
+}
+
 void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   VELOX_CHECK_NULL(
       split_,
@@ -306,6 +413,23 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
 
   VLOG(1) << "Adding split " << split_->toString();
 
+  if (!split_->coalescedFiles.empty()) {
+    VELOX_CHECK(
+        coalescedFiles_.empty(),
+        "Coalesced files of the previous split have not been processed yet");
+    for (const auto& file : split_->coalescedFiles) {
+      VELOX_CHECK_EQ(
+          file->fileFormat,
+          split_->fileFormat,
+          "Coalesced files must have the format of their split");
+      VELOX_CHECK(
+          file->coalescedFiles.empty(),
+          "Coalesced files cannot have coalesced files");
+      coalescedFiles_.push_back(file);
+    }
+    openCoalescedFiles();
+  }
+
   if (splitReader_) {
     splitReader_.reset();
   }
@@ -319,12 +443,34 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     setupRowIdColumn();
   }
 
+  if (lookupDecodedColumns()) {
+    return;
+  }
+  if (!decodedColumns_.empty()) {
+    // The split reader is created by the first next() unless a concurrent
+    // reader of the split decodes it. The decision is deferred since the split
+    // may be preloaded long before it is read.
+    return;
+  }
+  openSplitReader();
+}
+
+void HiveDataSource::openSplitReader() {
   splitReader_ = createSplitReader();
   // Split reader subclasses may need to use the reader options in prepareSplit
   // so we initialize it beforehand.
   splitReader_->configureReaderOptions(randomSkip_);
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_);
   readerOutputType_ = splitReader_->readerOutputType();
+
+  if (outputType_->size() == 0 && readerOutputType_->size() == 0 &&
+      !remainingFilterExprSet_ && !partitionFunction_ &&
+      !splitReader_->emptySplit()) {
+    metadataRowsRemaining_ = splitReader_->rowCountFromMetadata();
+    if (metadataRowsRemaining_.has_value()) {
+      ++numMetadataCountedSplits_;
+    }
+  }
 }
 
 vector_size_t HiveDataSource::applyBucketConversion(
@@ -366,10 +512,64 @@ vector_size_t HiveDataSource::applyBucketConversion(
   return size;
 }
 
+void HiveDataSource::openCoalescedFiles() {
+  if (executor_ == nullptr || !hiveConfig_->isFileHandleCacheEnabled()) {
+    return;
+  }
+  // The background opens keep a reference to the connector, which owns
+  // 'fileHandleFactory_'.
+  auto connector = getConnector(split_->connectorId);
+  for (const auto& file : coalescedFiles_) {
+    executor_->add([connector, factory = fileHandleFactory_, file]() {
+      try {
+        factory->generate(
+            file->filePath,
+            file->properties.has_value() ? &*file->properties : nullptr,
+            nullptr);
+      } catch (const std::exception&) {
+        // The error is raised when the file is read.
+      }
+    });
+  }
+}
+
 std::optional<RowVectorPtr> HiveDataSource::next(
     uint64_t size,
-    velox::ContinueFuture& /*future*/) {
+    velox::ContinueFuture& future) {
+  auto output = nextFromFile(size, future);
+  if (output.has_value() && output.value() == nullptr &&
+      !coalescedFiles_.empty()) {
+    // The file is done. Continue with the next coalesced file in the same
+    // scan spec and return an empty batch to let the driver check for
+    // yield or cancellation between files.
+    auto file = std::move(coalescedFiles_.front());
+    coalescedFiles_.pop_front();
+    addSplit(std::move(file));
+    return getEmptyOutput();
+  }
+  return output;
+}
+
+std::optional<RowVectorPtr> HiveDataSource::nextFromFile(
+    uint64_t size,
+    velox::ContinueFuture& future) {
   VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
+  if (cachedColumns_.empty() && splitReader_ == nullptr) {
+    if (waitingForDecode_) {
+      waitingForDecode_ = false;
+      if (!lookupDecodedColumns()) {
+        // The other reader stopped before the end of the split.
+        openSplitReader();
+      }
+    } else if (decodedColumns_.empty() || startSharedDecode(future)) {
+      openSplitReader();
+    } else {
+      return std::nullopt;
+    }
+  }
+  if (!cachedColumns_.empty()) {
+    return nextFromDecodedColumns(size);
+  }
   VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
 
   TestValue::adjust(
@@ -379,6 +579,9 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     resetSplit();
     return nullptr;
   }
+  if (metadataRowsRemaining_.has_value()) {
+    return nextFromMetadata(size);
+  }
 
   // Bucket conversion or delta update could add extra column to reader output.
   auto needsExtraColumn = [&] {
@@ -393,6 +596,7 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   completedRows_ += rowsScanned;
   if (rowsScanned == 0) {
     splitReader_->updateRuntimeStats(runtimeStats_);
+    saveDecodedColumns();
     resetSplit();
     return nullptr;
   }
@@ -456,6 +660,12 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     outputColumns.emplace_back(
         exec::wrapChild(rowsRemaining, remainingIndices, child));
   }
+  if (!decodedColumns_.empty()) {
+    for (auto i = 0; i < decodedColumns_.size(); ++i) {
+      decodedColumns_[i]->append(
+          BaseVector::loadedVectorShared(outputColumns[i]).get());
+    }
+  }
 
   return std::make_shared<RowVector>(
       pool_, outputType_, BufferPtr(nullptr), rowsRemaining, outputColumns);
@@ -466,6 +676,12 @@ void HiveDataSource::addDynamicFilter(
     const std::shared_ptr<common::Filter>& filter) {
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
   fieldSpec.addFilter(*filter);
+  // The columns read from now on are filtered and are not saved to the
+  // DecodedColumnCache. The cached ones are filtered by
+  // nextFromDecodedColumns().
+  decodedColumns_.clear();
+  finishSharedDecode();
+  dynamicFilters_.emplace_back(outputChannel, filter);
   scanSpec_->resetCachedValues(true);
   if (splitReader_) {
     splitReader_->resetFilterCaches();
@@ -510,6 +726,13 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
          RuntimeCounter(
              ioStats_->ssdRead().sum(), RuntimeCounter::Unit::kBytes)});
   }
+  if (ioStats_->peerRead().count() > 0) {
+    res.insert({"numPeerRead", RuntimeCounter(ioStats_->peerRead().count())});
+    res.insert(
+        {"peerReadBytes",
+         RuntimeCounter(
+             ioStats_->peerRead().sum(), RuntimeCounter::Unit::kBytes)});
+  }
   if (ioStats_->ramHit().count() > 0) {
     res.insert({"numRamRead", RuntimeCounter(ioStats_->ramHit().count())});
     res.insert(
@@ -520,6 +743,20 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
   if (numBucketConversion_ > 0) {
     res.insert({"numBucketConversion", RuntimeCounter(numBucketConversion_)});
   }
+  if (numDecodedColumnCacheSplits_ > 0) {
+    res.insert(
+        {"numDecodedColumnCacheSplits",
+         RuntimeCounter(numDecodedColumnCacheSplits_)});
+  }
+  if (numSharedDecodeWaits_ > 0) {
+    res.insert(
+        {"numSharedDecodeWaits", RuntimeCounter(numSharedDecodeWaits_)});
+  }
+  if (numMetadataCountedSplits_ > 0) {
+    res.insert(
+        {"numMetadataCountedSplits",
+         RuntimeCounter(numMetadataCountedSplits_)});
+  }
 
   const auto fsStats = fsStats_->stats();
   for (const auto& storageStats : fsStats) {
@@ -536,6 +773,7 @@ void HiveDataSource::setFromDataSource(
   VELOX_CHECK_NOT_NULL(source, "Bad DataSource type");
 
   split_ = std::move(source->split_);
+  coalescedFiles_ = std::move(source->coalescedFiles_);
   runtimeStats_.skippedSplits += source->runtimeStats_.skippedSplits;
   runtimeStats_.processedSplits += source->runtimeStats_.processedSplits;
   runtimeStats_.skippedSplitBytes += source->runtimeStats_.skippedSplitBytes;
@@ -543,7 +781,17 @@ void HiveDataSource::setFromDataSource(
   source->scanSpec_->moveAdaptationFrom(*scanSpec_);
   scanSpec_ = std::move(source->scanSpec_);
   splitReader_ = std::move(source->splitReader_);
-  splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  if (splitReader_) {
+    splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  }
+  decodedColumnKeys_ = std::move(source->decodedColumnKeys_);
+  decodedColumns_ = std::move(source->decodedColumns_);
+  cachedColumns_ = std::move(source->cachedColumns_);
+  cachedOffset_ = source->cachedOffset_;
+  numDecodedColumnCacheSplits_ += source->numDecodedColumnCacheSplits_;
+  numSharedDecodeWaits_ += source->numSharedDecodeWaits_;
+  metadataRowsRemaining_ = source->metadataRowsRemaining_;
+  numMetadataCountedSplits_ += source->numMetadataCountedSplits_;
   // New io will be accounted on the stats of 'source'. Add the existing
   // balance to that.
   source->ioStats_->merge(*ioStats_);
@@ -553,6 +801,11 @@ void HiveDataSource::setFromDataSource(
 
   numBucketConversion_ += source->numBucketConversion_;
   partitionFunction_ = std::move(source->partitionFunction_);
+
+  // The scan spec now has the filters added while the split was preloaded.
+  if (splitReader_ != nullptr && split_ != nullptr) {
+    splitReader_->pruneOnPartitionValues(runtimeStats_);
+  }
 }
 
 int64_t HiveDataSource::estimatedRowSize() {
@@ -584,12 +837,183 @@ vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
   return rowsRemaining;
 }
 
+void HiveDataSource::cancel() {
+  // Destroying the reader cancels the loads it has scheduled ahead of the
+  // reads, e.g. when a downstream Limit finishes before the end of the split.
+  resetSplit();
+  splitReader_.reset();
+}
+
 void HiveDataSource::resetSplit() {
+  finishSharedDecode();
+  waitingForDecode_ = false;
   split_.reset();
-  splitReader_->resetSplit();
+  decodedColumnKeys_.clear();
+  decodedColumns_.clear();
+  cachedColumns_.clear();
+  metadataRowsRemaining_.reset();
+  if (splitReader_) {
+    splitReader_->resetSplit();
+  }
   // Keep readers around to hold adaptation.
 }
 
+bool HiveDataSource::lookupDecodedColumns() {
+  decodedColumnKeys_.clear();
+  decodedColumns_.clear();
+  cachedColumns_.clear();
+  auto* cache = DecodedColumnCache::getInstance();
+  if (!decodedColumnCacheEligible_ || cache == nullptr || !split_->cacheable ||
+      split_->bucketConversion.has_value() ||
+      typeid(*split_) != typeid(HiveConnectorSplit) ||
+      !split_->properties.has_value() ||
+      !split_->properties->fileSize.has_value() ||
+      !split_->properties->modificationTime.has_value()) {
+    return false;
+  }
+  const auto maxFileSize = hiveConfig_->decodedColumnCacheMaxFileSize(
+      connectorQueryCtx_->sessionProperties());
+  if (*split_->properties->fileSize > maxFileSize) {
+    return false;
+  }
+  std::string fingerprint;
+  if (!filterFingerprint_.empty()) {
+    // The partition values are constant columns and may have filters.
+    std::map<std::string, std::optional<std::string>> partitionValues(
+        split_->partitionKeys.begin(), split_->partitionKeys.end());
+    fingerprint = filterFingerprint_;
+    for (const auto& [name, value] : partitionValues) {
+      fingerprint += fmt::format(";{}={}", name, value.value_or("<null>"));
+    }
+  }
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    decodedColumnKeys_.push_back(
+        {split_->filePath,
+         *split_->properties->fileSize,
+         *split_->properties->modificationTime,
+         split_->start,
+         split_->length,
+         readerOutputType_->nameOf(i),
+         outputType_->childAt(i),
+         fingerprint});
+  }
+  for (const auto& key : decodedColumnKeys_) {
+    auto column = cache->get(key);
+    if (column == nullptr) {
+      cachedColumns_.clear();
+      break;
+    }
+    cachedColumns_.push_back(std::move(column));
+  }
+  if (!cachedColumns_.empty()) {
+    cachedOffset_ = 0;
+    ++numDecodedColumnCacheSplits_;
+    return true;
+  }
+  if (dynamicFilters_.empty()) {
+    for (const auto& key : decodedColumnKeys_) {
+      decodedColumns_.push_back(BaseVector::create(key.type, 0, cache->pool()));
+    }
+  }
+  return false;
+}
+
+void HiveDataSource::saveDecodedColumns() {
+  if (decodedColumns_.empty()) {
+    return;
+  }
+  auto* cache = DecodedColumnCache::getInstance();
+  VELOX_CHECK_NOT_NULL(cache);
+  for (auto i = 0; i < decodedColumns_.size(); ++i) {
+    cache->put(decodedColumnKeys_[i], std::move(decodedColumns_[i]));
+  }
+  decodedColumns_.clear();
+  finishSharedDecode();
+}
+
+bool HiveDataSource::startSharedDecode(ContinueFuture& future) {
+  auto* cache = DecodedColumnCache::getInstance();
+  VELOX_CHECK_NOT_NULL(cache);
+  if (cache->startDecode(decodedColumnKeys_, future)) {
+    sharedDecode_ = true;
+    return true;
+  }
+  waitingForDecode_ = true;
+  ++numSharedDecodeWaits_;
+  return false;
+}
+
+void HiveDataSource::finishSharedDecode() {
+  if (!sharedDecode_) {
+    return;
+  }
+  sharedDecode_ = false;
+  if (auto* cache = DecodedColumnCache::getInstance()) {
+    cache->finishDecode(decodedColumnKeys_);
+  }
+}
+
+RowVectorPtr HiveDataSource::nextFromMetadata(uint64_t size) {
+  auto& numRows = metadataRowsRemaining_.value();
+  if (numRows == 0) {
+    splitReader_->updateRuntimeStats(runtimeStats_);
+    resetSplit();
+    return nullptr;
+  }
+  const auto batchSize = std::min(size, numRows);
+  numRows -= batchSize;
+  completedRows_ += batchSize;
+  return std::make_shared<RowVector>(
+      pool_, outputType_, nullptr, batchSize, std::vector<VectorPtr>{});
+}
+
+RowVectorPtr HiveDataSource::nextFromDecodedColumns(uint64_t size) {
+  const auto numRows = cachedColumns_[0]->size();
+  if (cachedOffset_ >= numRows) {
+    resetSplit();
+    return nullptr;
+  }
+  const vector_size_t batchSize =
+      std::min<uint64_t>(size, numRows - cachedOffset_);
+  std::vector<VectorPtr> columns;
+  columns.reserve(cachedColumns_.size());
+  for (const auto& column : cachedColumns_) {
+    columns.push_back(column->slice(cachedOffset_, batchSize));
+  }
+  cachedOffset_ += batchSize;
+  completedRows_ += batchSize;
+
+  vector_size_t rowsRemaining = batchSize;
+  BufferPtr remainingIndices;
+  if (!dynamicFilters_.empty()) {
+    SelectivityVector rows(batchSize);
+    for (const auto& [channel, filter] : dynamicFilters_) {
+      DecodedVector decoded(*columns[channel], rows);
+      for (auto row = 0; row < batchSize; ++row) {
+        if (rows.isValid(row) && !testFilter(*filter, decoded, row)) {
+          rows.setValid(row, false);
+        }
+      }
+      rows.updateBounds();
+    }
+    rowsRemaining = rows.countSelected();
+    if (rowsRemaining == 0) {
+      return getEmptyOutput();
+    }
+    if (rowsRemaining < batchSize) {
+      remainingIndices = allocateIndices(rowsRemaining, pool_);
+      auto* rawIndices = remainingIndices->asMutable<vector_size_t>();
+      vector_size_t numIndices = 0;
+      rows.applyToSelected([&](auto row) { rawIndices[numIndices++] = row; });
+    }
+  }
+  for (auto& column : columns) {
+    column = exec::wrapChild(rowsRemaining, remainingIndices, column);
+  }
+  return std::make_shared<RowVector>(
+      pool_, outputType_, BufferPtr(nullptr), rowsRemaining, columns);
+}
+
 HiveDataSource::WaveDelegateHookFunction HiveDataSource::waveDelegateHook_;
 
 std::shared_ptr<wave::WaveDataSource> HiveDataSource::toWaveDataSource() {
@@ -15,10 +15,13 @@
  */
 #pragma once
 
+#include <deque>
+
 #include "velox/common/base/RandomUtil.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/DecodedColumnCache.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/HiveConnectorUtil.h"
@@ -46,6 +49,8 @@ class HiveDataSource : public DataSource {
       const ConnectorQueryCtx* connectorQueryCtx,
       const std::shared_ptr<HiveConfig>& hiveConfig);
 
+  ~HiveDataSource() override;
+
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
   std::optional<RowVectorPtr> next(uint64_t size, velox::ContinueFuture& future)
@@ -73,6 +78,8 @@ class HiveDataSource : public DataSource {
 
   int64_t estimatedRowSize() override;
 
+  void cancel() override;
+
   std::shared_ptr<wave::WaveDataSource> toWaveDataSource() override;
 
   using WaveDelegateHookFunction =
@@ -144,6 +151,45 @@ class HiveDataSource : public DataSource {
   // hold adaptation.
   void resetSplit();
 
+  // Looks up the columns of 'split_' in the DecodedColumnCache. Returns true
+  // and sets 'cachedColumns_' if all are cached. Otherwise prepares
+  // 'decodedColumns_' to collect the columns if the split can be cached and
+  // returns false.
+  bool lookupDecodedColumns();
+
+  // Adds the columns collected in 'decodedColumns_' to the
+  // DecodedColumnCache at the end of the split.
+  void saveDecodedColumns();
+
+  // Registers 'this' as the reader that decodes the columns of 'split_' for
+  // the concurrent readers of the same split. Returns false and sets 'future'
+  // if another reader is decoding them.
+  bool startSharedDecode(ContinueFuture& future);
+
+  // Wakes up the readers waiting for 'this' to decode the split.
+  void finishSharedDecode();
+
+  // Creates the split reader for 'split_'.
+  void openSplitReader();
+
+  // Returns the next up to 'size' rows of 'cachedColumns_' with the dynamic
+  // filters applied, nullptr at the end of the split.
+  RowVectorPtr nextFromDecodedColumns(uint64_t size);
+
+  // Returns the next up to 'size' rows of 'metadataRowsRemaining_', nullptr
+  // at the end of the split.
+  RowVectorPtr nextFromMetadata(uint64_t size);
+
+  // Returns the next rows of the file of 'split_', nullptr at the end of the
+  // file.
+  std::optional<RowVectorPtr> nextFromFile(
+      uint64_t size,
+      velox::ContinueFuture& future);
+
+  // Opens the files of 'coalescedFiles_' in the background so that their
+  // handles are in the file handle cache by the time they are read.
+  void openCoalescedFiles();
+
   const RowVectorPtr& getEmptyOutput() {
     if (!emptyOutput_) {
       emptyOutput_ = RowVector::createEmpty(outputType_, pool_);
@@ -176,6 +222,9 @@ class HiveDataSource : public DataSource {
 
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 
+  // The coalesced files of the split that are still to be read, in order.
+  std::deque<std::shared_ptr<HiveConnectorSplit>> coalescedFiles_;
+
   int64_t numBucketConversion_ = 0;
   std::unique_ptr<HivePartitionFunction> partitionFunction_;
   std::vector<uint32_t> partitions_;
@@ -190,5 +239,35 @@ class HiveDataSource : public DataSource {
   // Remembers the WaveDataSource. Successive calls to toWaveDataSource() will
   // return the same.
   std::shared_ptr<wave::WaveDataSource> waveDataSource_;
+
+  // True if the splits may be served from the DecodedColumnCache, i.e. all
+  // the rows of the regular columns are read or the fragment result cache is
+  // enabled.
+  bool decodedColumnCacheEligible_{false};
+  // The fingerprint of the filters if the filtered columns are cached.
+  std::string filterFingerprint_;
+  // The dynamic filters, which are applied to the cached columns.
+  std::vector<std::pair<column_index_t, std::shared_ptr<common::Filter>>>
+      dynamicFilters_;
+  // The keys of the columns of the current split in the DecodedColumnCache,
+  // empty if the split is not cacheable.
+  std::vector<DecodedColumnCache::Key> decodedColumnKeys_;
+  // The columns of the current split collected while reading it, to be added
+  // to the DecodedColumnCache at its end.
+  std::vector<VectorPtr> decodedColumns_;
+  // The cached columns of the current split and the next row to return.
+  std::vector<VectorPtr> cachedColumns_;
+  vector_size_t cachedOffset_{0};
+  int64_t numDecodedColumnCacheSplits_{0};
+  // True if 'this' waits for another reader to decode the current split.
+  bool waitingForDecode_{false};
+  // True if the readers of the current split wait for 'this' to decode it.
+  bool sharedDecode_{false};
+  int64_t numSharedDecodeWaits_{0};
+
+  // The rows left in the current split if it is counted from the file
+  // metadata, i.e. the scan has no columns and no filters, e.g. count(*).
+  std::optional<uint64_t> metadataRowsRemaining_;
+  int64_t numMetadataCountedSplits_{0};
 };
 } // namespace facebook::velox::connector::hive
@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/HiveIndexSource.h"
+
+#include <folly/container/F14Map.h>
+
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive {
+
+namespace {
+
+constexpr uint64_t kReadBatchSize = 10'000;
+
+template <typename T>
+void appendIntegerKeys(
+    const DecodedVector& decoded,
+    vector_size_t size,
+    std::vector<int64_t>& values) {
+  for (auto row = 0; row < size; ++row) {
+    if (!decoded.isNullAt(row)) {
+      values.push_back(decoded.valueAt<T>(row));
+    }
+  }
+}
+
+template <typename T>
+void sortAndDedup(std::vector<T>& values) {
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+} // namespace
+
+HiveIndexTableHandle::HiveIndexTableHandle(
+    std::string connectorId,
+    const std::string& tableName,
+    common::SubfieldFilters subfieldFilters,
+    const RowTypePtr& dataColumns,
+    std::vector<std::shared_ptr<const HiveConnectorSplit>> files,
+    const std::unordered_map<std::string, std::string>& tableParameters)
+    : HiveTableHandle(
+          std::move(connectorId),
+          tableName,
+          true,
+          std::move(subfieldFilters),
+          nullptr,
+          dataColumns,
+          tableParameters),
+      files_(std::move(files)) {
+  VELOX_USER_CHECK_NOT_NULL(
+      dataColumns, "Hive index table {} requires its data columns", tableName);
+}
+
+std::string HiveIndexTableHandle::toString() const {
+  return fmt::format(
+      "{}, index files: {}", HiveTableHandle::toString(), files_.size());
+}
+
+folly::dynamic HiveIndexTableHandle::serialize() const {
+  auto obj = HiveTableHandle::serialize();
+  obj["name"] = "HiveIndexTableHandle";
+  folly::dynamic files = folly::dynamic::array;
+  for (const auto& file : files_) {
+    files.push_back(file->serialize());
+  }
+  obj["files"] = files;
+  return obj;
+}
+
+ConnectorTableHandlePtr HiveIndexTableHandle::create(
+    const folly::dynamic& obj,
+    void* context) {
+  auto base = std::static_pointer_cast<const HiveTableHandle>(
+      HiveTableHandle::create(obj, context));
+  common::SubfieldFilters subfieldFilters;
+  for (const auto& [subfield, filter] : base->subfieldFilters()) {
+    subfieldFilters.emplace(subfield.clone(), filter->clone());
+  }
+  std::vector<std::shared_ptr<const HiveConnectorSplit>> files;
+  for (const auto& file : obj["files"]) {
+    files.push_back(HiveConnectorSplit::create(file));
+  }
+  return std::make_shared<const HiveIndexTableHandle>(
+      base->connectorId(),
+      base->tableName(),
+      std::move(subfieldFilters),
+      base->dataColumns(),
+      std::move(files),
+      base->tableParameters());
+}
+
+void HiveIndexTableHandle::registerSerDe() {
+  auto& registry = DeserializationWithContextRegistryForSharedPtr();
+  registry.Register("HiveIndexTableHandle", create);
+}
+
+class HiveIndexSource::ResultIterator : public LookupResultIterator {
+ public:
+  ResultIterator(
+      std::shared_ptr<HiveIndexSource> source,
+      RowVectorPtr matches,
+      std::vector<vector_size_t> inputHits,
+      std::vector<vector_size_t> matchRows)
+      : source_(std::move(source)),
+        matches_(std::move(matches)),
+        inputHits_(std::move(inputHits)),
+        matchRows_(std::move(matchRows)) {}
+
+  std::optional<std::unique_ptr<LookupResult>> next(
+      vector_size_t size,
+      velox::ContinueFuture& /*future*/) override {
+    if (offset_ >= inputHits_.size()) {
+      return nullptr;
+    }
+    const vector_size_t numRows =
+        std::min<size_t>(size, inputHits_.size() - offset_);
+    auto* pool = source_->pool_;
+    auto hits = allocateIndices(numRows, pool);
+    std::copy_n(
+        inputHits_.data() + offset_,
+        numRows,
+        hits->asMutable<vector_size_t>());
+    auto indices = allocateIndices(numRows, pool);
+    std::copy_n(
+        matchRows_.data() + offset_,
+        numRows,
+        indices->asMutable<vector_size_t>());
+    offset_ += numRows;
+
+    std::vector<VectorPtr> columns;
+    columns.reserve(source_->outputChannels_.size());
+    for (auto channel : source_->outputChannels_) {
+      columns.push_back(BaseVector::wrapInDictionary(
+          nullptr, indices, numRows, matches_->childAt(channel)));
+    }
+    return std::make_unique<LookupResult>(
+        std::move(hits),
+        std::make_shared<RowVector>(
+            pool, source_->outputType_, nullptr, numRows, std::move(columns)));
+  }
+
+ private:
+  const std::shared_ptr<HiveIndexSource> source_;
+  const RowVectorPtr matches_;
+  const std::vector<vector_size_t> inputHits_;
+  const std::vector<vector_size_t> matchRows_;
+  // The first of 'inputHits_' not returned yet.
+  size_t offset_{0};
+};
+
+HiveIndexSource::HiveIndexSource(
+    const RowTypePtr& inputType,
+    size_t numJoinKeys,
+    const std::vector<core::IndexLookupConditionPtr>& joinConditions,
+    const RowTypePtr& outputType,
+    const std::shared_ptr<ConnectorTableHandle>& tableHandle,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+    ConnectorQueryCtx* connectorQueryCtx,
+    FileHandleFactory* fileHandleFactory,
+    folly::Executor* executor,
+    const std::shared_ptr<HiveConfig>& hiveConfig)
+    : tableHandle_(
+          std::dynamic_pointer_cast<HiveIndexTableHandle>(tableHandle)),
+      numJoinKeys_(numJoinKeys),
+      connectorQueryCtx_(connectorQueryCtx),
+      fileHandleFactory_(fileHandleFactory),
+      executor_(executor),
+      hiveConfig_(hiveConfig),
+      pool_(connectorQueryCtx->memoryPool()),
+      ioStats_(std::make_shared<io::IoStatistics>()),
+      fsStats_(std::make_shared<filesystems::File::IoStats>()),
+      outputType_(outputType) {
+  VELOX_CHECK_NOT_NULL(
+      tableHandle_,
+      "TableHandle must be an instance of HiveIndexTableHandle");
+  VELOX_USER_CHECK(
+      joinConditions.empty(),
+      "Hive index lookup supports only equi-join keys");
+  VELOX_USER_CHECK_GT(numJoinKeys_, 0);
+  VELOX_CHECK_EQ(inputType->size(), numJoinKeys_);
+
+  auto columnName = [&](const std::string& alias) -> const std::string& {
+    auto it = columnHandles.find(alias);
+    VELOX_CHECK(
+        it != columnHandles.end(),
+        "ColumnHandle is missing for column: {}",
+        alias);
+    auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
+    VELOX_USER_CHECK(
+        handle->columnType() == HiveColumnHandle::ColumnType::kRegular,
+        "Hive index lookup supports only regular columns: {}",
+        alias);
+    return handle->name();
+  };
+  const auto& dataColumns = tableHandle_->dataColumns();
+  std::vector<std::string> readNames;
+  std::vector<TypePtr> readTypes;
+  auto addReadColumn = [&](const std::string& name) -> column_index_t {
+    auto it = std::find(readNames.begin(), readNames.end(), name);
+    if (it != readNames.end()) {
+      return it - readNames.begin();
+    }
+    readNames.push_back(name);
+    readTypes.push_back(dataColumns->findChild(name));
+    return readNames.size() - 1;
+  };
+  // The keys are distinct and take the first channels.
+  for (auto i = 0; i < numJoinKeys_; ++i) {
+    addReadColumn(columnName(inputType->nameOf(i)));
+  }
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    outputChannels_.push_back(
+        addReadColumn(columnName(outputType_->nameOf(i))));
+  }
+  readType_ = ROW(std::move(readNames), std::move(readTypes));
+}
+
+std::shared_ptr<IndexSource::LookupResultIterator> HiveIndexSource::lookup(
+    const LookupRequest& request) {
+  addRuntimeStat(kNumLookups, 1);
+  auto matches = readMatches(*request.input);
+  std::vector<vector_size_t> inputHits;
+  std::vector<vector_size_t> rows;
+  matchRows(*request.input, *matches, inputHits, rows);
+  return std::make_shared<ResultIterator>(
+      shared_from_this(),
+      std::move(matches),
+      std::move(inputHits),
+      std::move(rows));
+}
+
+std::unique_ptr<common::Filter> HiveIndexSource::makeKeyFilter(
+    const RowVector& input) {
+  const auto& keys = input.childAt(0);
+  DecodedVector decoded(*keys);
+  std::vector<int64_t> integerKeys;
+  switch (keys->typeKind()) {
+    case TypeKind::TINYINT:
+      appendIntegerKeys<int8_t>(decoded, input.size(), integerKeys);
+      break;
+    case TypeKind::SMALLINT:
+      appendIntegerKeys<int16_t>(decoded, input.size(), integerKeys);
+      break;
+    case TypeKind::INTEGER:
+      appendIntegerKeys<int32_t>(decoded, input.size(), integerKeys);
+      break;
+    case TypeKind::BIGINT:
+      appendIntegerKeys<int64_t>(decoded, input.size(), integerKeys);
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      std::vector<std::string> values;
+      for (auto row = 0; row < input.size(); ++row) {
+        if (!decoded.isNullAt(row)) {
+          values.push_back(std::string(decoded.valueAt<StringView>(row)));
+        }
+      }
+      if (values.empty()) {
+        return std::make_unique<common::AlwaysFalse>();
+      }
+      sortAndDedup(values);
+      return std::make_unique<common::BytesValues>(values, false);
+    }
+    default:
+      return nullptr;
+  }
+  sortAndDedup(integerKeys);
+  return common::createBigintValues(integerKeys, false);
+}
+
+RowVectorPtr HiveIndexSource::readMatches(const RowVector& input) {
+  common::SubfieldFilters filters;
+  for (const auto& [subfield, filter] : tableHandle_->subfieldFilters()) {
+    filters.emplace(subfield.clone(), filter->clone());
+  }
+  if (auto keyFilter = makeKeyFilter(input)) {
+    common::Subfield keySubfield(readType_->nameOf(0));
+    auto it = filters.find(keySubfield);
+    if (it == filters.end()) {
+      filters.emplace(std::move(keySubfield), std::move(keyFilter));
+    } else {
+      it->second = it->second->mergeWith(keyFilter.get());
+    }
+  }
+  auto scanSpec = makeScanSpec(
+      readType_,
+      {},
+      filters,
+      tableHandle_->dataColumns(),
+      {},
+      {},
+      {},
+      false,
+      pool_);
+
+  auto matches = BaseVector::create<RowVector>(readType_, 0, pool_);
+  const auto asLocalTime = hiveConfig_->readTimestampPartitionValueAsLocalTime(
+      connectorQueryCtx_->sessionProperties());
+  for (const auto& file : tableHandle_->files()) {
+    auto& fileReader = reader(file);
+    // Skips the files whose stats do not have any of the keys.
+    if (!testFilters(
+            scanSpec.get(),
+            &fileReader,
+            file->filePath,
+            file->partitionKeys,
+            {},
+            asLocalTime)) {
+      addRuntimeStat(kSkippedIndexFiles, 1);
+      continue;
+    }
+    dwio::common::RowReaderOptions rowReaderOptions;
+    configureRowReaderOptions(
+        tableHandle_->tableParameters(),
+        scanSpec,
+        nullptr,
+        readType_,
+        file,
+        hiveConfig_,
+        connectorQueryCtx_->sessionProperties(),
+        rowReaderOptions);
+    auto rowReader = fileReader.createRowReader(rowReaderOptions);
+    VectorPtr batch = BaseVector::create(readType_, 0, pool_);
+    while (rowReader->next(kReadBatchSize, batch) > 0) {
+      if (batch->size() > 0) {
+        batch->loadedVector();
+        matches->append(batch.get());
+      }
+    }
+  }
+  addRuntimeStat(kIndexRowsRead, matches->size());
+  return matches;
+}
+
+dwio::common::Reader& HiveIndexSource::reader(
+    const std::shared_ptr<const HiveConnectorSplit>& file) {
+  auto it = readers_.find(file->filePath);
+  if (it != readers_.end()) {
+    return *it->second;
+  }
+  dwio::common::ReaderOptions readerOptions(pool_);
+  configureReaderOptions(
+      hiveConfig_, connectorQueryCtx_, tableHandle_, file, readerOptions);
+  auto fileHandle = fileHandleFactory_->generate(
+      file->filePath,
+      file->properties.has_value() ? &*file->properties : nullptr,
+      fsStats_.get());
+  auto input = createBufferedInput(
+      *fileHandle,
+      readerOptions,
+      connectorQueryCtx_,
+      ioStats_,
+      fsStats_,
+      executor_,
+      tableHandle_->tableName());
+  auto fileReader =
+      dwio::common::getReaderFactory(readerOptions.fileFormat())
+          ->createReader(std::move(input), readerOptions);
+  return *readers_.emplace(file->filePath, std::move(fileReader))
+              .first->second;
+}
+
+void HiveIndexSource::matchRows(
+    const RowVector& input,
+    const RowVector& matches,
+    std::vector<vector_size_t>& inputHits,
+    std::vector<vector_size_t>& matchRows) const {
+  auto keyHash = [&](const RowVector& rows, vector_size_t row) {
+    uint64_t hash = 0;
+    for (auto i = 0; i < numJoinKeys_; ++i) {
+      hash = bits::hashMix(hash, rows.childAt(i)->hashValueAt(row));
+    }
+    return hash;
+  };
+  folly::F14FastMap<uint64_t, std::vector<vector_size_t>> rowsByHash;
+  for (auto row = 0; row < matches.size(); ++row) {
+    rowsByHash[keyHash(matches, row)].push_back(row);
+  }
+  for (auto row = 0; row < input.size(); ++row) {
+    bool hasNullKey = false;
+    for (auto i = 0; i < numJoinKeys_; ++i) {
+      hasNullKey |= input.childAt(i)->isNullAt(row);
+    }
+    if (hasNullKey) {
+      continue;
+    }
+    auto it = rowsByHash.find(keyHash(input, row));
+    if (it == rowsByHash.end()) {
+      continue;
+    }
+    for (auto matchRow : it->second) {
+      bool equal = true;
+      for (auto i = 0; i < numJoinKeys_ && equal; ++i) {
+        equal = matches.childAt(i)->equalValueAt(
+            input.childAt(i).get(), matchRow, row);
+      }
+      if (equal) {
+        inputHits.push_back(row);
+        matchRows.push_back(matchRow);
+      }
+    }
+  }
+}
+
+void HiveIndexSource::addRuntimeStat(const std::string& name, int64_t value) {
+  std::lock_guard<std::mutex> l(mutex_);
+  runtimeStats_[name].addValue(value);
+}
+
+std::unordered_map<std::string, RuntimeMetric> HiveIndexSource::runtimeStats() {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = runtimeStats_;
+  if (ioStats_->read().count() > 0) {
+    stats.emplace(
+        "storageReadBytes",
+        RuntimeMetric(ioStats_->read().sum(), RuntimeCounter::Unit::kBytes));
+  }
+  if (ioStats_->ramHit().count() > 0) {
+    stats.emplace(
+        "ramReadBytes",
+        RuntimeMetric(ioStats_->ramHit().sum(), RuntimeCounter::Unit::kBytes));
+  }
+  return stats;
+}
+
+} // namespace facebook::velox::connector::hive
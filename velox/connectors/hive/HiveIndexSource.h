@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/io/IoStatistics.h"
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/dwio/common/Reader.h"
+
+namespace facebook::velox::connector::hive {
+
+class HiveConfig;
+
+/// A Hive table that is bucketed and sorted on its lookup keys, so that the
+/// index lookup join can read the rows of a batch of keys from the few
+/// stripes or row groups whose min/max stats cover the keys instead of
+/// scanning the table. 'files' are the files of the table, e.g. the files of
+/// the buckets of the probe side.
+class HiveIndexTableHandle : public HiveTableHandle {
+ public:
+  HiveIndexTableHandle(
+      std::string connectorId,
+      const std::string& tableName,
+      common::SubfieldFilters subfieldFilters,
+      const RowTypePtr& dataColumns,
+      std::vector<std::shared_ptr<const HiveConnectorSplit>> files,
+      const std::unordered_map<std::string, std::string>& tableParameters =
+          {});
+
+  const std::vector<std::shared_ptr<const HiveConnectorSplit>>& files()
+      const {
+    return files_;
+  }
+
+  bool supportsIndexLookup() const override {
+    return true;
+  }
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static ConnectorTableHandlePtr create(
+      const folly::dynamic& obj,
+      void* context);
+
+  static void registerSerDe();
+
+ private:
+  const std::vector<std::shared_ptr<const HiveConnectorSplit>> files_;
+};
+
+/// Looks up the rows of a HiveIndexTableHandle that match the equi-join keys
+/// of the lookup requests. Each request reads the files with an IN filter on
+/// the first key, so that the readers skip the files, stripes and row groups
+/// whose stats do not have any of the keys, and matches the rows read on all
+/// the keys. The readers of the files are kept across requests so that their
+/// footers are read once, and the data read goes through the AsyncDataCache
+/// if there is one. Join conditions besides the equi-join keys are not
+/// supported.
+class HiveIndexSource : public IndexSource,
+                        public std::enable_shared_from_this<HiveIndexSource> {
+ public:
+  /// The number of rows read from the index files by the lookups.
+  static constexpr const char* kIndexRowsRead = "indexRowsRead";
+  /// The number of files skipped by the lookups based on the file stats.
+  static constexpr const char* kSkippedIndexFiles = "skippedIndexFiles";
+  static constexpr const char* kNumLookups = "numLookups";
+
+  HiveIndexSource(
+      const RowTypePtr& inputType,
+      size_t numJoinKeys,
+      const std::vector<core::IndexLookupConditionPtr>& joinConditions,
+      const RowTypePtr& outputType,
+      const std::shared_ptr<ConnectorTableHandle>& tableHandle,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      ConnectorQueryCtx* connectorQueryCtx,
+      FileHandleFactory* fileHandleFactory,
+      folly::Executor* executor,
+      const std::shared_ptr<HiveConfig>& hiveConfig);
+
+  std::shared_ptr<LookupResultIterator> lookup(
+      const LookupRequest& request) override;
+
+  std::unordered_map<std::string, RuntimeMetric> runtimeStats() override;
+
+ private:
+  class ResultIterator;
+
+  // Returns the rows of the index files whose first key is one of the first
+  // keys of 'input'.
+  RowVectorPtr readMatches(const RowVector& input);
+
+  // Returns the IN filter on the first key of 'input', or nullptr if the type
+  // of the key has no IN filter and the files are read without one.
+  std::unique_ptr<common::Filter> makeKeyFilter(const RowVector& input);
+
+  // Returns the reader of 'file', creating it on first use.
+  dwio::common::Reader& reader(
+      const std::shared_ptr<const HiveConnectorSplit>& file);
+
+  // Returns the matching rows of 'matches' for each row of 'input' in the
+  // order of 'input', as the input rows in 'inputHits' and the rows of
+  // 'matches' in 'matchRows'.
+  void matchRows(
+      const RowVector& input,
+      const RowVector& matches,
+      std::vector<vector_size_t>& inputHits,
+      std::vector<vector_size_t>& matchRows) const;
+
+  void addRuntimeStat(const std::string& name, int64_t value);
+
+  const std::shared_ptr<HiveIndexTableHandle> tableHandle_;
+  const size_t numJoinKeys_;
+  ConnectorQueryCtx* const connectorQueryCtx_;
+  FileHandleFactory* const fileHandleFactory_;
+  folly::Executor* const executor_;
+  const std::shared_ptr<const HiveConfig> hiveConfig_;
+  memory::MemoryPool* const pool_;
+  const std::shared_ptr<io::IoStatistics> ioStats_;
+  const std::shared_ptr<filesystems::File::IoStats> fsStats_;
+
+  // The type of the output of the lookups.
+  RowTypePtr outputType_;
+  // The columns read from the files, the keys first, in the file names.
+  RowTypePtr readType_;
+  // The channel in 'readType_' of each column of 'outputType_'.
+  std::vector<column_index_t> outputChannels_;
+
+  // The readers of the files by file path.
+  std::unordered_map<std::string, std::unique_ptr<dwio::common::Reader>>
+      readers_;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, RuntimeMetric> runtimeStats_;
+};
+
+} // namespace facebook::velox::connector::hive
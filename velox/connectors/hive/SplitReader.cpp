@@ -23,6 +23,8 @@
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/MetricsLog.h"
+#include "velox/dwio/common/PrefetchUnitLoader.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/type/TimestampConversion.h"
 
@@ -158,11 +160,18 @@ void SplitReader::configureReaderOptions(
   baseReaderOpts_.setRandomSkip(std::move(randomSkip));
   baseReaderOpts_.setScanSpec(scanSpec_);
   baseReaderOpts_.setFileFormat(hiveSplit_->fileFormat);
+  if (hiveSplit_->properties.has_value()) {
+    baseReaderOpts_.setFileModificationTime(
+        hiveSplit_->properties->modificationTime);
+  }
 }
 
 void SplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats) {
+  if (pruneOnPartitionValues(runtimeStats)) {
+    return;
+  }
   createReader();
   if (emptySplit_) {
     return;
@@ -186,6 +195,14 @@ uint64_t SplitReader::next(uint64_t size, VectorPtr& output) {
   return baseRowReader_->next(size, output, &mutation);
 }
 
+std::optional<uint64_t> SplitReader::rowCountFromMetadata() const {
+  if (!baseRowReader_ || scanSpec_->hasFilter() ||
+      baseReaderOpts_.randomSkip() || baseRowReaderOpts_.skipRows() > 0) {
+    return std::nullopt;
+  }
+  return baseRowReader_->rowCountFromMetadata();
+}
+
 void SplitReader::resetFilterCaches() {
   if (baseRowReader_) {
     baseRowReader_->resetFilterCaches();
@@ -196,6 +213,28 @@ bool SplitReader::emptySplit() const {
   return emptySplit_;
 }
 
+bool SplitReader::pruneOnPartitionValues(
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  if (emptySplit_ ||
+      testPartitionFilters(
+          scanSpec_.get(),
+          hiveSplit_->filePath,
+          hiveSplit_->partitionKeys,
+          *partitionKeys_,
+          hiveConfig_->readTimestampPartitionValueAsLocalTime(
+              connectorQueryCtx_->sessionProperties()))) {
+    return emptySplit_;
+  }
+  if (baseRowReader_ != nullptr) {
+    // The split was counted as processed when it was prepared.
+    --runtimeStats.processedSplits;
+  }
+  ++runtimeStats.skippedSplits;
+  runtimeStats.skippedSplitBytes += hiveSplit_->length;
+  emptySplit_ = true;
+  return true;
+}
+
 void SplitReader::resetSplit() {
   hiveSplit_.reset();
 }
@@ -217,7 +256,9 @@ void SplitReader::updateRuntimeStats(
 }
 
 bool SplitReader::allPrefetchIssued() const {
-  return baseRowReader_ && baseRowReader_->allPrefetchIssued();
+  // An empty split has no IO to issue, so the next splits can be preloaded.
+  return emptySplit_ ||
+      (baseRowReader_ && baseRowReader_->allPrefetchIssued());
 }
 
 void SplitReader::setConnectorQueryCtx(
@@ -275,7 +316,8 @@ void SplitReader::createReader() {
       connectorQueryCtx_,
       ioStats_,
       fsStats_,
-      executor_);
+      executor_,
+      hiveTableHandle_->tableName());
 
   baseReader_ = dwio::common::getReaderFactory(baseReaderOpts_.fileFormat())
                     ->createReader(std::move(baseFileInput), baseReaderOpts_);
@@ -336,6 +378,26 @@ void SplitReader::createRowReader(
       hiveConfig_,
       connectorQueryCtx_->sessionProperties(),
       baseRowReaderOpts_);
+  const auto decodingParallelism =
+      hiveConfig_->decodingParallelism(connectorQueryCtx_->sessionProperties());
+  if (decodingParallelism > 1 && executor_ != nullptr) {
+    // The executor outlives the connector and so the readers.
+    baseRowReaderOpts_.setDecodingExecutor(
+        std::shared_ptr<folly::Executor>(executor_, [](folly::Executor*) {}));
+    baseRowReaderOpts_.setDecodingParallelismFactor(decodingParallelism);
+  }
+  const auto numPrefetchUnits =
+      hiveConfig_->numPrefetchUnits(connectorQueryCtx_->sessionProperties());
+  if (numPrefetchUnits > 0 && executor_ != nullptr) {
+    baseRowReaderOpts_.setUnitLoaderFactory(
+        std::make_shared<dwio::common::PrefetchUnitLoaderFactory>(
+            executor_,
+            dwio::common::PrefetchUnitLoaderFactory::Options{
+                .numPrefetchUnits = numPrefetchUnits},
+            baseRowReaderOpts_.blockedOnIoCallback(),
+            dwio::common::getMetricsLogFactory().create(
+                hiveSplit_->filePath, /*ioLogging=*/false)));
+  }
   baseRowReader_ = baseReader_->createRowReader(baseRowReaderOpts_);
 }
 
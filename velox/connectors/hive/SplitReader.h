@@ -83,10 +83,22 @@ class SplitReader {
 
   virtual uint64_t next(uint64_t size, VectorPtr& output);
 
+  /// Returns the number of rows of the split from the file metadata if these
+  /// can be produced without reading the data, i.e. there are no filters,
+  /// deleted, sampled or skipped rows. Returns std::nullopt otherwise.
+  virtual std::optional<uint64_t> rowCountFromMetadata() const;
+
   void resetFilterCaches();
 
   bool emptySplit() const;
 
+  /// Marks the split empty if its partition values fail the filters of the
+  /// scan spec. This is done before the file is opened and again when the
+  /// scan spec gets filters after the split was prepared, e.g. the dynamic
+  /// filters that arrive while the split is preloaded. Returns true if the
+  /// split is empty.
+  bool pruneOnPartitionValues(dwio::common::RuntimeStatistics& runtimeStats);
+
   void resetSplit();
 
   int64_t estimatedRowSize() const;
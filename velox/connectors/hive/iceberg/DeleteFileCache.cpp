@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/DeleteFileCache.h"
+
+#include <gflags/gflags.h>
+
+#include "velox/connectors/hive/iceberg/DeletionVector.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
+
+DECLARE_int64(velox_iceberg_delete_cache_bytes);
+
+namespace facebook::velox::connector::hive::iceberg {
+
+// static
+template <typename T>
+DeleteFileCache<T>& DeleteFileCache<T>::instance() {
+  static DeleteFileCache<T> cache(FLAGS_velox_iceberg_delete_cache_bytes);
+  return cache;
+}
+
+template class DeleteFileCache<DeletionVector>;
+template class DeleteFileCache<EqualityDeleteSet>;
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// A process wide cache of the deletes read from Iceberg delete files, e.g.
+/// DeletionVectors or EqualityDeleteSets. The files of a table are
+/// immutable, so the deletes read from a delete file do not change and are
+/// reused across splits and queries. 'T' must have memoryBytes(). The size
+/// of each cache is set by the 'velox_iceberg_delete_cache_bytes' flag.
+/// Thread safe.
+template <typename T>
+class DeleteFileCache {
+ public:
+  explicit DeleteFileCache(uint64_t maxBytes) : cache_(maxBytes) {}
+
+  /// Returns the process wide cache of 'T'.
+  static DeleteFileCache& instance();
+
+  /// Returns the deletes for 'key' or nullptr if not cached.
+  std::shared_ptr<const T> find(const std::string& key) {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* entry = cache_.get(key);
+    if (entry == nullptr) {
+      return nullptr;
+    }
+    auto deletes = *entry;
+    cache_.release(key);
+    return deletes;
+  }
+
+  /// Caches 'deletes' for 'key' if there is room.
+  void insert(const std::string& key, std::shared_ptr<const T> deletes) {
+    const auto size = deletes->memoryBytes() + key.size();
+    auto entry = std::make_unique<Entry>(std::move(deletes));
+    std::lock_guard<std::mutex> l(mutex_);
+    if (cache_.add(key, entry.get(), size)) {
+      entry.release();
+    }
+  }
+
+  SimpleLRUCacheStats stats() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return cache_.stats();
+  }
+
+ private:
+  using Entry = std::shared_ptr<const T>;
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, Entry> cache_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
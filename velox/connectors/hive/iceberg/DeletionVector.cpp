@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/DeletionVector.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <folly/hash/Checksum.h>
+#include <folly/lang/Bits.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+
+// The cookies of the portable roaring bitmaps with and without run
+// containers.
+constexpr uint32_t kSerialCookie = 12347;
+constexpr uint32_t kSerialCookieNoRuns = 12346;
+// The number of containers from which a bitmap with run containers has the
+// container offsets.
+constexpr int32_t kNoOffsetThreshold = 4;
+// The magic of an Iceberg deletion vector blob.
+constexpr uint8_t kDeletionVectorMagic[] = {0xD1, 0xD3, 0x39, 0x64};
+
+// Reads the fields of a serialized deletion vector with bounds checks.
+class BlobReader {
+ public:
+  explicit BlobReader(std::string_view data) : data_(data) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    std::memcpy(&value, skip(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  const char* skip(size_t numBytes) {
+    VELOX_CHECK_LE(
+        offset_ + numBytes, data_.size(), "Truncated deletion vector");
+    const auto* bytes = data_.data() + offset_;
+    offset_ += numBytes;
+    return bytes;
+  }
+
+  size_t offset() const {
+    return offset_;
+  }
+
+ private:
+  const std::string_view data_;
+  size_t offset_{0};
+};
+
+// ORs the bits in [begin, end) of 'source' into 'target' from bit
+// 'targetOffset' on, 64 bits at a time. Returns true if any bit is set.
+bool orBits(
+    const uint64_t* source,
+    uint32_t begin,
+    uint32_t end,
+    uint64_t* target,
+    uint64_t targetOffset) {
+  uint64_t anySet = 0;
+  for (auto bit = begin; bit < end; bit += 64) {
+    const auto numBits = std::min<uint32_t>(64, end - bit);
+    const auto sourceShift = bit % 64;
+    uint64_t word = source[bit / 64] >> sourceShift;
+    if (sourceShift != 0 && numBits > 64 - sourceShift) {
+      word |= source[bit / 64 + 1] << (64 - sourceShift);
+    }
+    if (numBits < 64) {
+      word &= bits::lowMask(numBits);
+    }
+    anySet |= word;
+    const auto targetBit = targetOffset + bit - begin;
+    const auto targetShift = targetBit % 64;
+    target[targetBit / 64] |= word << targetShift;
+    if (targetShift != 0 && numBits > 64 - targetShift) {
+      target[targetBit / 64 + 1] |= word >> (64 - targetShift);
+    }
+  }
+  return anySet != 0;
+}
+
+} // namespace
+
+void DeletionVector::add(const int64_t* positions, int32_t numPositions) {
+  for (auto i = 0; i < numPositions; ++i) {
+    VELOX_CHECK_GE(positions[i], 0, "Negative deleted position");
+    auto& container = containerFor(positions[i] >> kContainerBits);
+    addToContainer(container, positions[i] & bits::lowMask(kContainerBits));
+  }
+}
+
+DeletionVector::Container& DeletionVector::containerFor(uint64_t key) {
+  if (lastContainer_ < containers_.size() &&
+      containers_[lastContainer_].key == key) {
+    return containers_[lastContainer_];
+  }
+  if (containers_.empty() || containers_.back().key < key) {
+    return appendContainer(key);
+  }
+  auto it = std::lower_bound(
+      containers_.begin(),
+      containers_.end(),
+      key,
+      [](const Container& container, uint64_t key) {
+        return container.key < key;
+      });
+  if (it->key != key) {
+    Container container;
+    container.key = key;
+    it = containers_.insert(it, std::move(container));
+  }
+  lastContainer_ = it - containers_.begin();
+  return *it;
+}
+
+DeletionVector::Container& DeletionVector::appendContainer(uint64_t key) {
+  VELOX_CHECK(
+      containers_.empty() || containers_.back().key < key,
+      "Deletion vector containers out of order");
+  auto& container = containers_.emplace_back();
+  container.key = key;
+  lastContainer_ = containers_.size() - 1;
+  return container;
+}
+
+// static
+void DeletionVector::addToContainer(Container& container, uint16_t value) {
+  if (!container.bits.empty()) {
+    if (!bits::isBitSet(container.bits.data(), value)) {
+      bits::setBit(container.bits.data(), value);
+      ++container.cardinality;
+    }
+    return;
+  }
+  auto& values = container.values;
+  if (values.empty() || values.back() < value) {
+    values.push_back(value);
+  } else {
+    auto it = std::lower_bound(values.begin(), values.end(), value);
+    if (*it == value) {
+      return;
+    }
+    values.insert(it, value);
+  }
+  if (++container.cardinality > kMaxArraySize) {
+    makeBitmap(container);
+  }
+}
+
+// static
+void DeletionVector::makeBitmap(Container& container) {
+  container.bits.resize(kContainerWords, 0);
+  for (auto value : container.values) {
+    bits::setBit(container.bits.data(), value);
+  }
+  container.values.clear();
+  container.values.shrink_to_fit();
+}
+
+bool DeletionVector::contains(uint64_t position) const {
+  const uint64_t key = position >> kContainerBits;
+  auto it = std::lower_bound(
+      containers_.begin(),
+      containers_.end(),
+      key,
+      [](const Container& container, uint64_t key) {
+        return container.key < key;
+      });
+  if (it == containers_.end() || it->key != key) {
+    return false;
+  }
+  const uint16_t value = position & bits::lowMask(kContainerBits);
+  if (!it->bits.empty()) {
+    return bits::isBitSet(it->bits.data(), value);
+  }
+  return std::binary_search(it->values.begin(), it->values.end(), value);
+}
+
+uint64_t DeletionVector::cardinality() const {
+  uint64_t count = 0;
+  for (const auto& container : containers_) {
+    count += container.cardinality;
+  }
+  return count;
+}
+
+uint64_t DeletionVector::memoryBytes() const {
+  uint64_t bytes = sizeof(*this) + containers_.capacity() * sizeof(Container);
+  for (const auto& container : containers_) {
+    bytes += container.values.capacity() * sizeof(uint16_t) +
+        container.bits.capacity() * sizeof(uint64_t);
+  }
+  return bytes;
+}
+
+bool DeletionVector::setDeletedRows(
+    uint64_t firstRow,
+    uint64_t numRows,
+    uint64_t* bitmap) const {
+  const uint64_t endRow = firstRow + numRows;
+  auto it = std::lower_bound(
+      containers_.begin(),
+      containers_.end(),
+      firstRow >> kContainerBits,
+      [](const Container& container, uint64_t key) {
+        return container.key < key;
+      });
+  bool anySet = false;
+  for (; it != containers_.end() && (it->key << kContainerBits) < endRow;
+       ++it) {
+    const uint64_t base = it->key << kContainerBits;
+    const uint32_t begin = std::max(firstRow, base) - base;
+    const uint32_t end =
+        std::min<uint64_t>(endRow, base + (1UL << kContainerBits)) - base;
+    if (!it->bits.empty()) {
+      anySet |=
+          orBits(it->bits.data(), begin, end, bitmap, base + begin - firstRow);
+      continue;
+    }
+    const auto& values = it->values;
+    for (auto value = std::lower_bound(values.begin(), values.end(), begin);
+         value != values.end() && *value < end;
+         ++value) {
+      bits::setBit(bitmap, base + *value - firstRow);
+      anySet = true;
+    }
+  }
+  return anySet;
+}
+
+size_t DeletionVector::addPortableBitmap(
+    uint32_t high,
+    std::string_view data) {
+  BlobReader reader(data);
+  const auto cookie = reader.read<uint32_t>();
+  uint32_t numContainers;
+  const uint8_t* runFlags = nullptr;
+  if ((cookie & 0xFFFF) == kSerialCookie) {
+    numContainers = (cookie >> 16) + 1;
+    runFlags = reinterpret_cast<const uint8_t*>(
+        reader.skip(bits::nbytes(numContainers)));
+  } else {
+    VELOX_CHECK_EQ(
+        cookie, kSerialCookieNoRuns, "Bad roaring bitmap in deletion vector");
+    numContainers = reader.read<uint32_t>();
+  }
+  std::vector<std::pair<uint16_t, int32_t>> keyAndCardinalities;
+  keyAndCardinalities.reserve(numContainers);
+  for (auto i = 0; i < numContainers; ++i) {
+    const auto key = reader.read<uint16_t>();
+    keyAndCardinalities.emplace_back(key, reader.read<uint16_t>() + 1);
+  }
+  if (runFlags == nullptr || numContainers >= kNoOffsetThreshold) {
+    // Skips the offsets of the containers, which follow each other.
+    reader.skip(numContainers * sizeof(uint32_t));
+  }
+
+  for (auto i = 0; i < numContainers; ++i) {
+    const auto [key, cardinality] = keyAndCardinalities[i];
+    auto& container =
+        appendContainer((static_cast<uint64_t>(high) << kContainerBits) | key);
+    if (runFlags != nullptr && bits::isBitSet(runFlags, i)) {
+      // The runs are pairs of start and length - 1.
+      if (cardinality > kMaxArraySize) {
+        container.bits.resize(kContainerWords, 0);
+      }
+      const auto numRuns = reader.read<uint16_t>();
+      for (auto run = 0; run < numRuns; ++run) {
+        const uint32_t start = reader.read<uint16_t>();
+        const uint32_t end = start + reader.read<uint16_t>() + 1;
+        VELOX_CHECK_LE(end, 1 << kContainerBits, "Bad deletion vector run");
+        if (!container.bits.empty()) {
+          bits::fillBits(container.bits.data(), start, end, true);
+        } else {
+          for (auto value = start; value < end; ++value) {
+            container.values.push_back(value);
+          }
+        }
+      }
+      VELOX_CHECK(
+          !container.bits.empty() || container.values.size() == cardinality,
+          "Bad deletion vector run container cardinality");
+    } else if (cardinality <= kMaxArraySize) {
+      container.values.resize(cardinality);
+      const auto numBytes = cardinality * sizeof(uint16_t);
+      std::memcpy(container.values.data(), reader.skip(numBytes), numBytes);
+    } else {
+      container.bits.resize(kContainerWords);
+      const auto numBytes = kContainerWords * sizeof(uint64_t);
+      std::memcpy(container.bits.data(), reader.skip(numBytes), numBytes);
+    }
+    container.cardinality = cardinality;
+  }
+  return reader.offset();
+}
+
+// static
+std::shared_ptr<DeletionVector> DeletionVector::fromIcebergBlob(
+    std::string_view blob) {
+  BlobReader reader(blob);
+  const auto length = folly::Endian::big(reader.read<uint32_t>());
+  VELOX_CHECK_EQ(
+      length + 2 * sizeof(uint32_t),
+      blob.size(),
+      "Deletion vector length does not match its blob");
+  const auto* magic = reader.skip(sizeof(kDeletionVectorMagic));
+  VELOX_CHECK_EQ(
+      std::memcmp(magic, kDeletionVectorMagic, sizeof(kDeletionVectorMagic)),
+      0,
+      "Bad deletion vector magic");
+  const auto checksum = folly::crc32_type(
+      reinterpret_cast<const uint8_t*>(magic), length);
+  reader.skip(length - sizeof(kDeletionVectorMagic));
+  VELOX_CHECK_EQ(
+      folly::Endian::big(reader.read<uint32_t>()),
+      checksum,
+      "Deletion vector checksum mismatch");
+
+  // A portable 64 bit roaring bitmap is the number of 32 bit bitmaps followed
+  // by each bitmap prefixed with the high 32 bits of its positions.
+  auto deletionVector = std::make_shared<DeletionVector>();
+  auto bitmap = blob.substr(
+      sizeof(uint32_t) + sizeof(kDeletionVectorMagic),
+      length - sizeof(kDeletionVectorMagic));
+  BlobReader bitmapReader(bitmap);
+  const auto numBitmaps = bitmapReader.read<uint64_t>();
+  size_t offset = bitmapReader.offset();
+  for (auto i = 0; i < numBitmaps; ++i) {
+    BlobReader highReader(bitmap.substr(offset));
+    const auto high = highReader.read<uint32_t>();
+    offset += sizeof(uint32_t);
+    offset += deletionVector->addPortableBitmap(high, bitmap.substr(offset));
+  }
+  VELOX_CHECK_EQ(offset, bitmap.size(), "Extra bytes after deletion vector");
+  return deletionVector;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
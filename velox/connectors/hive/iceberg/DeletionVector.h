@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// The deleted row positions of a data file, stored like a 64 bit roaring
+/// bitmap. The positions are grouped by their high 48 bits into containers
+/// of 64K positions. A container holds the sorted low 16 bits of its
+/// positions when sparse and a bitmap of 64K bits when dense. A deletion
+/// vector is built once per data file and shared by all the splits and
+/// queries that read the file.
+class DeletionVector {
+ public:
+  /// Adds 'numPositions' positions. The positions are usually ascending,
+  /// which makes adding them append only.
+  void add(const int64_t* positions, int32_t numPositions);
+
+  bool contains(uint64_t position) const;
+
+  bool empty() const {
+    return containers_.empty();
+  }
+
+  /// Returns the number of deleted positions.
+  uint64_t cardinality() const;
+
+  /// Returns the retained memory in bytes.
+  uint64_t memoryBytes() const;
+
+  /// Sets the bits of the deleted positions in [firstRow, firstRow +
+  /// numRows) in 'bitmap', where bit 0 is 'firstRow'. The bits of the dense
+  /// containers are ORed a word at a time. Returns true if any bit is set.
+  bool setDeletedRows(uint64_t firstRow, uint64_t numRows, uint64_t* bitmap)
+      const;
+
+  /// Parses the Iceberg v3 serialized deletion vector in 'blob', i.e. the
+  /// content of a 'deletion-vector-v1' blob of a Puffin file: the big endian
+  /// length, the magic, a portable 64 bit roaring bitmap and the big endian
+  /// CRC-32 of the magic and the bitmap.
+  static std::shared_ptr<DeletionVector> fromIcebergBlob(
+      std::string_view blob);
+
+ private:
+  // The number of low bits of the positions in a container.
+  static constexpr int32_t kContainerBits = 16;
+  static constexpr int32_t kContainerWords = (1 << kContainerBits) / 64;
+  // The cardinality over which a container is a bitmap.
+  static constexpr int32_t kMaxArraySize = 4096;
+
+  struct Container {
+    // The high bits of the positions.
+    uint64_t key;
+    // The sorted low bits of the positions if 'bits' is empty.
+    std::vector<uint16_t> values;
+    // 'kContainerWords' words of bits if the container is dense.
+    std::vector<uint64_t> bits;
+    int32_t cardinality{0};
+  };
+
+  // Returns the container for 'key', adding it if needed.
+  Container& containerFor(uint64_t key);
+
+  // Adds a container for 'key', which must be over the keys of the existing
+  // containers.
+  Container& appendContainer(uint64_t key);
+
+  static void addToContainer(Container& container, uint16_t value);
+
+  static void makeBitmap(Container& container);
+
+  // Parses a portable 32 bit roaring bitmap at 'data' and adds its positions
+  // with 'high' as the high 32 bits. Returns the number of bytes parsed.
+  size_t addPortableBitmap(uint32_t high, std::string_view data);
+
+  std::vector<Container> containers_;
+  // The index in 'containers_' of the container added to last.
+  size_t lastContainer_{0};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
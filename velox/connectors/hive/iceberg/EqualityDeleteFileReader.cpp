@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::shared_ptr<filesystems::File::IoStats>& fsStats,
+    const std::string& connectorId)
+    : pool_(connectorQueryCtx->memoryPool()) {
+  VELOX_CHECK(deleteFile.content == FileContent::kEqualityDeletes);
+
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile.filePath,
+      deleteFile.fileFormat,
+      0,
+      deleteFile.fileSizeInBytes);
+
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      hiveConfig,
+      connectorQueryCtx,
+      /*fileSchema=*/nullptr,
+      deleteSplit,
+      /*tableParameters=*/{},
+      deleteReaderOpts);
+
+  auto deleteFileHandleCachePtr =
+      fileHandleFactory->generate(deleteFile.filePath);
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandleCachePtr,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStats,
+      fsStats,
+      executor);
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  // The schema of the reader has no field ids, so the equality columns can
+  // only be told apart from the other columns if there are no others.
+  deleteFileSchema_ = deleteReader->rowType();
+  VELOX_CHECK(
+      deleteFile.equalityFieldIds.empty() ||
+          deleteFile.equalityFieldIds.size() == deleteFileSchema_->size(),
+      "Equality delete file {} has columns other than its equality columns",
+      deleteFile.filePath);
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (auto i = 0; i < deleteFileSchema_->size(); ++i) {
+    scanSpec->addField(deleteFileSchema_->nameOf(i), i);
+  }
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      {},
+      scanSpec,
+      nullptr,
+      deleteFileSchema_,
+      deleteSplit,
+      nullptr,
+      nullptr,
+      deleteRowReaderOpts);
+  deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
+}
+
+std::shared_ptr<EqualityDeleteSet> EqualityDeleteFileReader::readDeletes() {
+  auto deleteSet = std::make_shared<EqualityDeleteSet>(deleteFileSchema_);
+  VectorPtr deleteRows = BaseVector::create(deleteFileSchema_, 0, pool_);
+  while (deleteRowReader_->next(kReadBatchSize, deleteRows) > 0) {
+    if (deleteRows->size() > 0) {
+      deleteSet->add(*deleteRows->loadedVector()->as<RowVector>());
+    }
+  }
+  deleteRowReader_.reset();
+  return deleteSet;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
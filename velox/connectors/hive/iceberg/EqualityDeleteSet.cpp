@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/vector/SelectivityVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+
+template <TypeKind Kind>
+void appendValue(
+    const DecodedVector& decoded,
+    vector_size_t row,
+    std::string& key) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto value = decoded.valueAt<T>(row);
+  if constexpr (std::is_same_v<T, StringView>) {
+    const uint32_t size = value.size();
+    key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    key.append(value.data(), size);
+  } else {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+} // namespace
+
+EqualityDeleteSet::EqualityDeleteSet(RowTypePtr keyType)
+    : keyType_(std::move(keyType)) {
+  VELOX_CHECK_GT(keyType_->size(), 0, "Equality deletes without columns");
+  for (const auto& type : keyType_->children()) {
+    VELOX_CHECK(
+        type->isPrimitiveType(),
+        "Equality deletes on {} columns are not supported",
+        type->toString());
+  }
+}
+
+std::vector<DecodedVector> EqualityDeleteSet::decode(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t numRows) const {
+  VELOX_CHECK_EQ(keys.size(), keyType_->size());
+  SelectivityVector rows(numRows);
+  std::vector<DecodedVector> decoded(keys.size());
+  for (auto i = 0; i < keys.size(); ++i) {
+    VELOX_CHECK(
+        keys[i]->type()->equivalent(*keyType_->childAt(i)),
+        "Equality delete column {} is {} in the data and {} in the deletes",
+        keyType_->nameOf(i),
+        keys[i]->type()->toString(),
+        keyType_->childAt(i)->toString());
+    decoded[i].decode(*keys[i], rows);
+  }
+  return decoded;
+}
+
+void EqualityDeleteSet::makeKey(
+    const std::vector<DecodedVector>& decoded,
+    vector_size_t row,
+    std::string& key) const {
+  key.clear();
+  for (auto i = 0; i < decoded.size(); ++i) {
+    if (decoded[i].isNullAt(row)) {
+      key.push_back(0);
+      continue;
+    }
+    key.push_back(1);
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        appendValue, keyType_->childAt(i)->kind(), decoded[i], row, key);
+  }
+}
+
+void EqualityDeleteSet::add(const RowVector& keys) {
+  const auto decoded = decode(keys.children(), keys.size());
+  std::string key;
+  for (vector_size_t row = 0; row < keys.size(); ++row) {
+    makeKey(decoded, row, key);
+    if (keys_.insert(key).second) {
+      keyBytes_ += key.size();
+    }
+  }
+}
+
+bool EqualityDeleteSet::setDeletedRows(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t numRows,
+    uint64_t* deletedRows) const {
+  if (keys_.empty()) {
+    return false;
+  }
+  const auto decoded = decode(keys, numRows);
+  bool anyDeleted = false;
+  std::string key;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    makeKey(decoded, row, key);
+    if (keys_.count(key) != 0) {
+      bits::setBit(deletedRows, row);
+      anyDeleted = true;
+    }
+  }
+  return anyDeleted;
+}
+
+uint64_t EqualityDeleteSet::memoryBytes() const {
+  // The keys over the small string size have their own allocation.
+  return sizeof(*this) + keys_.getAllocatedMemorySize() + keyBytes_;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Set.h>
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// The rows of an Iceberg equality delete file as a hash set of normalized
+/// keys. A normalized key is the values of the equality columns of a row
+/// packed in a string, each value preceded by a null flag, so that the set
+/// does not reference vectors or memory pools and can be shared across the
+/// splits and queries that apply the delete file. A data row is deleted if
+/// its values of the equality columns equal the values of any delete row,
+/// nulls being equal to nulls.
+class EqualityDeleteSet {
+ public:
+  /// 'keyType' gives the names and the scalar types of the equality columns.
+  explicit EqualityDeleteSet(RowTypePtr keyType);
+
+  /// Returns the names and types of the equality columns.
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  /// Adds the rows of 'keys', which has the columns of keyType().
+  void add(const RowVector& keys);
+
+  /// Sets the bits in 'deletedRows' of the rows of 'keys' that are in the
+  /// set. 'keys' has one column for each column of keyType(). Returns true
+  /// if any bit is set.
+  bool setDeletedRows(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t numRows,
+      uint64_t* deletedRows) const;
+
+  bool empty() const {
+    return keys_.empty();
+  }
+
+  size_t size() const {
+    return keys_.size();
+  }
+
+  /// Returns the retained memory in bytes.
+  uint64_t memoryBytes() const;
+
+ private:
+  // Decodes 'keys', one vector for each column of 'keyType_'.
+  std::vector<DecodedVector> decode(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t numRows) const;
+
+  // Sets 'key' to the normalized key of 'row' of 'decoded'.
+  void makeKey(
+      const std::vector<DecodedVector>& decoded,
+      vector_size_t row,
+      std::string& key) const;
+
+  const RowTypePtr keyType_;
+
+  folly::F14FastSet<std::string> keys_;
+  // The sum of the sizes of 'keys_'.
+  uint64_t keyBytes_{0};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
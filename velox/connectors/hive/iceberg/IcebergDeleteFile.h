@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -46,6 +47,10 @@ struct IcebergDeleteFile {
   // by each column's field id. E.g. The deleted rows for a column with field id
   // 1 is in range [10, 50], then upperBounds will contain entry <1, "50">
   std::unordered_map<int32_t, std::string> upperBounds;
+  // The offset and size of the blob of a deletion vector, set if the
+  // positional deletes are an Iceberg v3 deletion vector in a Puffin file.
+  std::optional<uint64_t> contentOffset;
+  std::optional<uint64_t> contentSizeInBytes;
 
   IcebergDeleteFile(
       FileContent _content,
@@ -55,7 +60,9 @@ struct IcebergDeleteFile {
       uint64_t _fileSizeInBytes,
       std::vector<int32_t> _equalityFieldIds = {},
       std::unordered_map<int32_t, std::string> _lowerBounds = {},
-      std::unordered_map<int32_t, std::string> _upperBounds = {})
+      std::unordered_map<int32_t, std::string> _upperBounds = {},
+      std::optional<uint64_t> _contentOffset = std::nullopt,
+      std::optional<uint64_t> _contentSizeInBytes = std::nullopt)
       : content(_content),
         filePath(_filePath),
         fileFormat(_fileFormat),
@@ -63,7 +70,13 @@ struct IcebergDeleteFile {
         fileSizeInBytes(_fileSizeInBytes),
         equalityFieldIds(_equalityFieldIds),
         lowerBounds(_lowerBounds),
-        upperBounds(_upperBounds) {}
+        upperBounds(_upperBounds),
+        contentOffset(_contentOffset),
+        contentSizeInBytes(_contentSizeInBytes) {}
+
+  bool isDeletionVector() const {
+    return contentOffset.has_value();
+  }
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
@@ -16,8 +16,12 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/DeleteFileCache.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 #include "velox/dwio/common/BufferUtil.h"
 
 using namespace facebook::velox::dwio::common;
@@ -56,6 +60,9 @@ IcebergSplitReader::IcebergSplitReader(
 void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats) {
+  if (pruneOnPartitionValues(runtimeStats)) {
+    return;
+  }
   createReader();
   if (emptySplit_) {
     return;
@@ -73,30 +80,189 @@ void IcebergSplitReader::prepareSplit(
       std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
-  positionalDeleteFileReaders_.clear();
+  deletionVectors_.clear();
+  equalityDeletes_.clear();
+  equalityKeyReader_.reset();
 
   const auto& deleteFiles = icebergSplit->deleteFiles;
   for (const auto& deleteFile : deleteFiles) {
     if (deleteFile.content == FileContent::kPositionalDeletes) {
       if (deleteFile.recordCount > 0) {
-        positionalDeleteFileReaders_.push_back(
-            std::make_unique<PositionalDeleteFileReader>(
-                deleteFile,
-                hiveSplit_->filePath,
-                fileHandleFactory_,
-                connectorQueryCtx_,
-                executor_,
-                hiveConfig_,
-                ioStats_,
-                fsStats_,
-                runtimeStats,
-                splitOffset_,
-                hiveSplit_->connectorId));
+        auto deletionVector = loadDeletionVector(deleteFile, runtimeStats);
+        if (!deletionVector->empty()) {
+          deletionVectors_.push_back(std::move(deletionVector));
+        }
+      }
+    } else if (deleteFile.content == FileContent::kEqualityDeletes) {
+      if (deleteFile.recordCount > 0) {
+        auto deleteSet = loadEqualityDeletes(deleteFile);
+        if (!deleteSet->empty()) {
+          equalityDeletes_.push_back(std::move(deleteSet));
+        }
       }
     } else {
       VELOX_NYI();
     }
   }
+  if (!equalityDeletes_.empty()) {
+    createEqualityKeyReader();
+  }
+}
+
+std::shared_ptr<const DeletionVector> IcebergSplitReader::loadDeletionVector(
+    const IcebergDeleteFile& deleteFile,
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  // The files of a table are immutable, so the path, size and offset of the
+  // deletes identify them.
+  const auto key = fmt::format(
+      "{}\n{}\n{}\n{}",
+      deleteFile.filePath,
+      deleteFile.fileSizeInBytes,
+      deleteFile.contentOffset.value_or(0),
+      hiveSplit_->filePath);
+  auto& cache = DeleteFileCache<DeletionVector>::instance();
+  if (auto deletionVector = cache.find(key)) {
+    return deletionVector;
+  }
+
+  std::shared_ptr<DeletionVector> deletionVector;
+  if (deleteFile.isDeletionVector()) {
+    VELOX_CHECK(
+        deleteFile.contentSizeInBytes.has_value(),
+        "Deletion vector without size: {}",
+        deleteFile.filePath);
+    auto fileHandle = fileHandleFactory_->generate(
+        deleteFile.filePath, nullptr, fsStats_ ? fsStats_.get() : nullptr);
+    const auto blob = fileHandle->file->pread(
+        deleteFile.contentOffset.value(),
+        deleteFile.contentSizeInBytes.value());
+    ioStats_->incRawBytesRead(blob.size());
+    deletionVector = DeletionVector::fromIcebergBlob(blob);
+  } else {
+    deletionVector = std::make_shared<DeletionVector>();
+    PositionalDeleteFileReader(
+        deleteFile,
+        hiveSplit_->filePath,
+        fileHandleFactory_,
+        connectorQueryCtx_,
+        executor_,
+        hiveConfig_,
+        ioStats_,
+        fsStats_,
+        runtimeStats,
+        hiveSplit_->connectorId)
+        .readDeletePositions(*deletionVector);
+  }
+  cache.insert(key, deletionVector);
+  return deletionVector;
+}
+
+std::shared_ptr<const EqualityDeleteSet>
+IcebergSplitReader::loadEqualityDeletes(const IcebergDeleteFile& deleteFile) {
+  // The rows of an equality delete file apply to all the data files of the
+  // split group, so the key does not include the base data file.
+  const auto key =
+      fmt::format("{}\n{}", deleteFile.filePath, deleteFile.fileSizeInBytes);
+  auto& cache = DeleteFileCache<EqualityDeleteSet>::instance();
+  if (auto deleteSet = cache.find(key)) {
+    return deleteSet;
+  }
+  std::shared_ptr<const EqualityDeleteSet> deleteSet =
+      EqualityDeleteFileReader(
+          deleteFile,
+          fileHandleFactory_,
+          connectorQueryCtx_,
+          executor_,
+          hiveConfig_,
+          ioStats_,
+          fsStats_,
+          hiveSplit_->connectorId)
+          .readDeletes();
+  cache.insert(key, deleteSet);
+  return deleteSet;
+}
+
+void IcebergSplitReader::createEqualityKeyReader() {
+  const auto& fileType = baseReader_->rowType();
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  auto keySpec = std::make_shared<common::ScanSpec>("<root>");
+  equalityKeyChannels_.clear();
+  for (const auto& deleteSet : equalityDeletes_) {
+    auto& channels = equalityKeyChannels_.emplace_back();
+    for (const auto& name : deleteSet->keyType()->names()) {
+      const auto channel =
+          std::find(names.begin(), names.end(), name) - names.begin();
+      if (channel == names.size()) {
+        VELOX_CHECK(
+            fileType->containsChild(name),
+            "Equality delete column {} is not in {}",
+            name,
+            hiveSplit_->filePath);
+        keySpec->addField(name, channel);
+        names.push_back(name);
+        types.push_back(fileType->findChild(name));
+      }
+      channels.push_back(channel);
+    }
+  }
+
+  dwio::common::RowReaderOptions keyReaderOpts;
+  configureRowReaderOptions(
+      hiveTableHandle_->tableParameters(),
+      keySpec,
+      nullptr,
+      fileType,
+      hiveSplit_,
+      hiveConfig_,
+      connectorQueryCtx_->sessionProperties(),
+      keyReaderOpts);
+  equalityKeyReader_ = baseReader_->createRowReader(keyReaderOpts);
+  equalityKeys_ = BaseVector::create(
+      ROW(std::move(names), std::move(types)),
+      0,
+      connectorQueryCtx_->memoryPool());
+}
+
+bool IcebergSplitReader::setEqualityDeletedRows(
+    uint64_t numRows,
+    uint64_t* deletedRows) {
+  // Skips the rows that the base reader skipped, e.g. the stripes that its
+  // filters exclude.
+  const auto rowNumber = baseRowReader_->nextRowNumber();
+  for (;;) {
+    const auto keyRowNumber = equalityKeyReader_->nextRowNumber();
+    VELOX_CHECK_NE(keyRowNumber, dwio::common::RowReader::kAtEnd);
+    if (keyRowNumber >= rowNumber) {
+      VELOX_CHECK_EQ(keyRowNumber, rowNumber);
+      break;
+    }
+    equalityKeyReader_->next(rowNumber - keyRowNumber, equalityKeys_);
+  }
+  const auto numKeys = equalityKeyReader_->next(numRows, equalityKeys_);
+  VELOX_CHECK_EQ(numKeys, numRows);
+  VELOX_CHECK_EQ(equalityKeys_->size(), numRows);
+
+  auto* keys = equalityKeys_->asUnchecked<RowVector>();
+  bool anyDeleted = false;
+  std::vector<VectorPtr> deleteSetKeys;
+  for (auto i = 0; i < equalityDeletes_.size(); ++i) {
+    deleteSetKeys.clear();
+    for (auto channel : equalityKeyChannels_[i]) {
+      deleteSetKeys.push_back(
+          BaseVector::loadedVectorShared(keys->childAt(channel)));
+    }
+    anyDeleted |= equalityDeletes_[i]->setDeletedRows(
+        deleteSetKeys, numRows, deletedRows);
+  }
+  return anyDeleted;
+}
+
+std::optional<uint64_t> IcebergSplitReader::rowCountFromMetadata() const {
+  if (!deletionVectors_.empty() || !equalityDeletes_.empty()) {
+    return std::nullopt;
+  }
+  return SplitReader::rowCountFromMetadata();
 }
 
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
@@ -104,38 +270,35 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
   mutation.deletedRows = nullptr;
 
-  if (deleteBitmap_) {
-    std::memset(
-        (void*)(deleteBitmap_->asMutable<int8_t>()), 0L, deleteBitmap_->size());
-  }
-
   const auto actualSize = baseRowReader_->nextReadSize(size);
 
   if (actualSize == dwio::common::RowReader::kAtEnd) {
     return 0;
   }
 
-  if (!positionalDeleteFileReaders_.empty()) {
-    auto numBytes = bits::nbytes(actualSize);
-    dwio::common::ensureCapacity<int8_t>(
-        deleteBitmap_, numBytes, connectorQueryCtx_->memoryPool(), false, true);
-
-    for (auto iter = positionalDeleteFileReaders_.begin();
-         iter != positionalDeleteFileReaders_.end();) {
-      (*iter)->readDeletePositions(baseReadOffset_, actualSize, deleteBitmap_);
+  if (!deletionVectors_.empty() || equalityKeyReader_) {
+    const auto numWords = bits::nwords(actualSize);
+    dwio::common::ensureCapacity<uint64_t>(
+        deleteBitmap_, numWords, connectorQueryCtx_->memoryPool());
+    auto* deleteBitmap = deleteBitmap_->asMutable<uint64_t>();
+    std::memset(deleteBitmap, 0, numWords * sizeof(uint64_t));
 
-      if ((*iter)->noMoreData()) {
-        iter = positionalDeleteFileReaders_.erase(iter);
-      } else {
-        ++iter;
-      }
+    // The positions in the deletion vectors are relative to the start of the
+    // base data file.
+    const auto firstRow = splitOffset_ + baseReadOffset_;
+    bool anyDeleted = false;
+    for (const auto& deletionVector : deletionVectors_) {
+      anyDeleted |=
+          deletionVector->setDeletedRows(firstRow, actualSize, deleteBitmap);
+    }
+    if (equalityKeyReader_) {
+      anyDeleted |= setEqualityDeletedRows(actualSize, deleteBitmap);
+    }
+    if (anyDeleted) {
+      mutation.deletedRows = deleteBitmap;
     }
   }
 
-  mutation.deletedRows = deleteBitmap_ && deleteBitmap_->size() > 0
-      ? deleteBitmap_->as<uint64_t>()
-      : nullptr;
-
   auto rowsScanned = baseRowReader_->next(actualSize, output, &mutation);
   baseReadOffset_ += rowsScanned;
 
@@ -18,7 +18,8 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
-#include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
+#include "velox/connectors/hive/iceberg/DeletionVector.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
 
 namespace facebook::velox::connector::hive::iceberg {
 
@@ -48,14 +49,46 @@ class IcebergSplitReader : public SplitReader {
 
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
+  std::optional<uint64_t> rowCountFromMetadata() const override;
+
  private:
+  // Returns the deletion vector of the base data file from 'deleteFile', from
+  // the DeleteFileCache if there.
+  std::shared_ptr<const DeletionVector> loadDeletionVector(
+      const IcebergDeleteFile& deleteFile,
+      dwio::common::RuntimeStatistics& runtimeStats);
+
+  // Returns the rows of the equality delete file 'deleteFile', from the
+  // DeleteFileCache if there.
+  std::shared_ptr<const EqualityDeleteSet> loadEqualityDeletes(
+      const IcebergDeleteFile& deleteFile);
+
+  // Creates 'equalityKeyReader_' to read the columns of the equality deletes.
+  void createEqualityKeyReader();
+
+  // Sets the bits in 'deletedRows' of the next 'numRows' rows of the base
+  // data file that are deleted by 'equalityDeletes_'. Returns true if any bit
+  // is set.
+  bool setEqualityDeletedRows(uint64_t numRows, uint64_t* deletedRows);
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
   // The file position for the first row in the split
   uint64_t splitOffset_;
-  std::list<std::unique_ptr<PositionalDeleteFileReader>>
-      positionalDeleteFileReaders_;
+  // The deleted positions of the base data file from each delete file.
+  std::vector<std::shared_ptr<const DeletionVector>> deletionVectors_;
+  // The rows deleted by each equality delete file.
+  std::vector<std::shared_ptr<const EqualityDeleteSet>> equalityDeletes_;
+  // The channels in 'equalityKeys_' of the columns of each of
+  // 'equalityDeletes_'.
+  std::vector<std::vector<column_index_t>> equalityKeyChannels_;
+  // Reads the columns of the equality deletes for all the rows of the split
+  // without filters, one batch ahead of each batch of 'baseRowReader_'. This
+  // turns the equality deletes into deleted rows of the batch like the
+  // positional deletes, so that the deleted rows never reach the filters.
+  std::unique_ptr<dwio::common::RowReader> equalityKeyReader_;
+  VectorPtr equalityKeys_;
   BufferPtr deleteBitmap_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
@@ -34,7 +34,6 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
     const std::shared_ptr<io::IoStatistics>& ioStats,
     const std::shared_ptr<filesystems::File::IoStats>& fsStats,
     dwio::common::RuntimeStatistics& runtimeStats,
-    uint64_t splitOffset,
     const std::string& connectorId)
     : deleteFile_(deleteFile),
       baseFilePath_(baseFilePath),
@@ -47,12 +46,8 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       pool_(connectorQueryCtx->memoryPool()),
       filePathColumn_(IcebergMetadataColumn::icebergDeleteFilePathColumn()),
       posColumn_(IcebergMetadataColumn::icebergDeletePosColumn()),
-      splitOffset_(splitOffset),
       deleteSplit_(nullptr),
-      deleteRowReader_(nullptr),
-      deletePositionsOutput_(nullptr),
-      deletePositionsOffset_(0),
-      totalNumRowsScanned_(0) {
+      deleteRowReader_(nullptr) {
   VELOX_CHECK(deleteFile_.content == FileContent::kPositionalDeletes);
   VELOX_CHECK(deleteFile_.recordCount);
 
@@ -142,144 +137,30 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
 }
 
 void PositionalDeleteFileReader::readDeletePositions(
-    uint64_t baseReadOffset,
-    uint64_t size,
-    BufferPtr deleteBitmapBuffer) {
-  // We are going to read to the row number up to the end of the batch. For the
-  // same base file, the deleted rows are in ascending order in the same delete
-  // file. rowNumberUpperBound is the upperbound for the row number in this
-  // batch, excluding boundaries
-  int64_t rowNumberUpperBound = splitOffset_ + baseReadOffset + size;
-
-  // Finish unused delete positions from last batch.
-  if (deletePositionsOutput_ &&
-      deletePositionsOffset_ < deletePositionsOutput_->size()) {
-    updateDeleteBitmap(
-        std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-            ->childAt(0),
-        baseReadOffset,
-        rowNumberUpperBound,
-        deleteBitmapBuffer);
-
-    if (readFinishedForBatch(rowNumberUpperBound)) {
-      return;
-    }
-  }
-
+    DeletionVector& deletionVector) {
   if (!deleteRowReader_ || !deleteSplit_) {
     return;
   }
 
-  // Read the new delete positions for this batch into deletePositionsOutput_
-  // and update the delete bitmap
-  auto outputType = posColumn_->type;
   RowTypePtr outputRowType = ROW({posColumn_->name}, {posColumn_->type});
-  if (!deletePositionsOutput_) {
-    deletePositionsOutput_ = BaseVector::create(outputRowType, 0, pool_);
-  }
-
-  do {
-    auto rowsScanned = deleteRowReader_->next(size, deletePositionsOutput_);
-    totalNumRowsScanned_ += rowsScanned;
-
-    if (rowsScanned > 0) {
-      VELOX_CHECK(
-          !deletePositionsOutput_->mayHaveNulls(),
-          "Iceberg delete file pos column cannot have nulls");
-
-      auto numDeletedRows = deletePositionsOutput_->size();
-      if (numDeletedRows > 0) {
-        deletePositionsOutput_->loadedVector();
-        deletePositionsOffset_ = 0;
-
-        // Convert the row numbers to set bits, up to rowNumberUpperBound.
-        // Beyond that the buffer of deleteBitMap is not available.
-        updateDeleteBitmap(
-            std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-                ->childAt(0),
-            baseReadOffset,
-            rowNumberUpperBound,
-            deleteBitmapBuffer);
-      }
-    } else {
-      // Reaching the end of the file
-      deleteSplit_.reset();
-      break;
+  VectorPtr deletePositionsOutput =
+      BaseVector::create(outputRowType, 0, pool_);
+  while (deleteRowReader_->next(kReadBatchSize, deletePositionsOutput) > 0) {
+    if (deletePositionsOutput->size() == 0) {
+      continue;
     }
-  } while (!readFinishedForBatch(rowNumberUpperBound));
-}
-
-bool PositionalDeleteFileReader::noMoreData() {
-  return totalNumRowsScanned_ >= deleteFile_.recordCount &&
-      deletePositionsOutput_ &&
-      deletePositionsOffset_ >= deletePositionsOutput_->size();
-}
-
-void PositionalDeleteFileReader::updateDeleteBitmap(
-    VectorPtr deletePositionsVector,
-    uint64_t baseReadOffset,
-    int64_t rowNumberUpperBound,
-    BufferPtr deleteBitmapBuffer) {
-  auto deleteBitmap = deleteBitmapBuffer->asMutable<uint8_t>();
-
-  // Convert the positions in file into positions relative to the start of the
-  // split.
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-  int64_t rowNumberLowerBound = baseReadOffset + splitOffset_;
-
-  // If the rowNumberLowerBound is greater than the last position in this delete
-  // rows batch, nothing to delete.
-  if (rowNumberLowerBound >
-      deletePositions[deletePositionsVector->size() - 1]) {
-    return;
+    VELOX_CHECK(
+        !deletePositionsOutput->mayHaveNulls(),
+        "Iceberg delete file pos column cannot have nulls");
+    deletePositionsOutput->loadedVector();
+    const auto* deletePositions =
+        std::dynamic_pointer_cast<RowVector>(deletePositionsOutput)
+            ->childAt(0)
+            ->as<FlatVector<int64_t>>();
+    deletionVector.add(deletePositions->rawValues(), deletePositions->size());
   }
-
-  // Skip the delete positions in deletePositionsVector until they are in the
-  // [rowNumberLowerBound, rowNumberUpperBound) range.
-  while (deletePositionsOffset_ < deletePositionsVector->size() &&
-         deletePositions[deletePositionsOffset_] < rowNumberLowerBound) {
-    deletePositionsOffset_++;
-  }
-  while (deletePositionsOffset_ < deletePositionsVector->size() &&
-         deletePositions[deletePositionsOffset_] < rowNumberUpperBound) {
-    bits::setBit(
-        deleteBitmap,
-        deletePositions[deletePositionsOffset_] - rowNumberLowerBound);
-    deletePositionsOffset_++;
-  }
-
-  deleteBitmapBuffer->setSize(std::max(
-      static_cast<uint64_t>(deleteBitmapBuffer->size()),
-      deletePositionsOffset_ == 0 ||
-              (deletePositionsOffset_ < deletePositionsVector->size() &&
-               deletePositions[deletePositionsOffset_] >= rowNumberUpperBound)
-          ? 0
-          : bits::nbytes(
-                deletePositions[deletePositionsOffset_ - 1] + 1 -
-                rowNumberLowerBound)));
-}
-
-bool PositionalDeleteFileReader::readFinishedForBatch(
-    int64_t rowNumberUpperBound) {
-  VELOX_CHECK_NOT_NULL(deletePositionsOutput_);
-
-  auto deletePositionsVector =
-      std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)->childAt(0);
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-
-  // We've read enough of the delete positions from this delete file when 1) it
-  // reaches the end of the file, or 2) the last read delete position is greater
-  // than the largest base file row number that is going to be read in this
-  // batch
-  if (totalNumRowsScanned_ >= deleteFile_.recordCount ||
-      (deletePositionsVector->size() != 0 &&
-       (deletePositionsOffset_ < deletePositionsVector->size() &&
-        deletePositions[deletePositionsOffset_] >= rowNumberUpperBound))) {
-    return true;
-  }
-  return false;
+  deleteRowReader_.reset();
+  deleteSplit_.reset();
 }
 
 } // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/DeletionVector.h"
+
+#include <map>
+#include <set>
+
+#include <folly/Random.h>
+#include <folly/hash/Checksum.h>
+#include <folly/lang/Bits.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/hive/iceberg/DeleteFileCache.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+
+template <typename T>
+void append(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Serializes 'positions' as an Iceberg deletion vector blob. The containers
+// are run containers if 'withRuns' and array or bitmap containers otherwise.
+std::string serialize(const std::set<uint64_t>& positions, bool withRuns) {
+  std::map<uint32_t, std::map<uint16_t, std::vector<uint16_t>>> bitmaps;
+  for (auto position : positions) {
+    bitmaps[position >> 32][(position >> 16) & 0xFFFF].push_back(
+        position & 0xFFFF);
+  }
+  std::string bitmap;
+  append<uint64_t>(bitmap, bitmaps.size());
+  for (const auto& [high, containers] : bitmaps) {
+    append<uint32_t>(bitmap, high);
+    const uint32_t numContainers = containers.size();
+    if (withRuns) {
+      append<uint32_t>(bitmap, 12347 | ((numContainers - 1) << 16));
+      bitmap.append(bits::nbytes(numContainers), '\xFF');
+    } else {
+      append<uint32_t>(bitmap, 12346);
+      append<uint32_t>(bitmap, numContainers);
+    }
+    for (const auto& [key, values] : containers) {
+      append<uint16_t>(bitmap, key);
+      append<uint16_t>(bitmap, values.size() - 1);
+    }
+    if (!withRuns || numContainers >= 4) {
+      // The offsets are not used by the reader.
+      bitmap.append(numContainers * sizeof(uint32_t), '\0');
+    }
+    for (const auto& [key, values] : containers) {
+      if (withRuns) {
+        std::vector<std::pair<uint16_t, uint16_t>> runs;
+        for (auto value : values) {
+          if (!runs.empty() && runs.back().first + runs.back().second + 1 ==
+                  value) {
+            ++runs.back().second;
+          } else {
+            runs.emplace_back(value, 0);
+          }
+        }
+        append<uint16_t>(bitmap, runs.size());
+        for (auto [start, length] : runs) {
+          append<uint16_t>(bitmap, start);
+          append<uint16_t>(bitmap, length);
+        }
+      } else if (values.size() <= 4096) {
+        for (auto value : values) {
+          append<uint16_t>(bitmap, value);
+        }
+      } else {
+        std::vector<uint64_t> words(1024);
+        for (auto value : values) {
+          bits::setBit(words.data(), value);
+        }
+        bitmap.append(
+            reinterpret_cast<const char*>(words.data()),
+            words.size() * sizeof(uint64_t));
+      }
+    }
+  }
+
+  std::string content("\xD1\xD3\x39\x64");
+  content += bitmap;
+  std::string blob;
+  append<uint32_t>(blob, folly::Endian::big<uint32_t>(content.size()));
+  blob += content;
+  append<uint32_t>(
+      blob,
+      folly::Endian::big(folly::crc32_type(
+          reinterpret_cast<const uint8_t*>(content.data()), content.size())));
+  return blob;
+}
+
+// Returns a set of positions with sparse and dense containers in different
+// high 32 bit ranges.
+std::set<uint64_t> makePositions() {
+  folly::Random::DefaultGenerator rng(1);
+  std::set<uint64_t> positions;
+  for (auto i = 0; i < 1'000; ++i) {
+    positions.insert(folly::Random::rand32(200'000, rng));
+  }
+  for (uint64_t i = 300'000; i < 310'000; ++i) {
+    positions.insert(i);
+  }
+  for (auto i = 0; i < 100; ++i) {
+    positions.insert((5UL << 32) + folly::Random::rand32(1 << 20, rng));
+  }
+  return positions;
+}
+
+void expectSameRows(
+    const DeletionVector& deletionVector,
+    const std::set<uint64_t>& positions) {
+  EXPECT_EQ(deletionVector.cardinality(), positions.size());
+  for (auto position : positions) {
+    ASSERT_TRUE(deletionVector.contains(position)) << position;
+  }
+  EXPECT_FALSE(deletionVector.contains(*positions.rbegin() + 1));
+
+  for (auto [firstRow, numRows] : std::vector<std::pair<uint64_t, uint64_t>>{
+           {0, 1'000},
+           {65'000, 1'000},
+           {299'990, 10'021},
+           {1, 400'000},
+           {(5UL << 32) + 1, 1 << 20},
+           {1'000'000, 1'000}}) {
+    std::vector<uint64_t> bitmap(bits::nwords(numRows));
+    const bool anySet =
+        deletionVector.setDeletedRows(firstRow, numRows, bitmap.data());
+    bool expectAnySet = false;
+    for (auto row = 0; row < numRows; ++row) {
+      const bool deleted = positions.count(firstRow + row) > 0;
+      expectAnySet |= deleted;
+      ASSERT_EQ(bits::isBitSet(bitmap.data(), row), deleted)
+          << firstRow << " + " << row;
+    }
+    EXPECT_EQ(anySet, expectAnySet);
+  }
+}
+
+TEST(DeletionVectorTest, add) {
+  const auto positions = makePositions();
+  DeletionVector deletionVector;
+  EXPECT_TRUE(deletionVector.empty());
+  std::vector<int64_t> ascending(positions.begin(), positions.end());
+  deletionVector.add(ascending.data(), ascending.size());
+  expectSameRows(deletionVector, positions);
+
+  // Positions out of order and duplicates.
+  DeletionVector shuffled;
+  std::vector<int64_t> positionsVec = ascending;
+  std::shuffle(
+      positionsVec.begin(),
+      positionsVec.end(),
+      folly::Random::DefaultGenerator(2));
+  positionsVec.insert(
+      positionsVec.end(), ascending.begin(), ascending.begin() + 100);
+  shuffled.add(positionsVec.data(), positionsVec.size());
+  expectSameRows(shuffled, positions);
+  EXPECT_LT(shuffled.memoryBytes(), positions.size() * sizeof(uint64_t));
+
+  const int64_t negative = -1;
+  VELOX_ASSERT_THROW(
+      deletionVector.add(&negative, 1), "Negative deleted position");
+}
+
+TEST(DeletionVectorTest, icebergBlob) {
+  const auto positions = makePositions();
+  for (auto withRuns : {false, true}) {
+    SCOPED_TRACE(fmt::format("withRuns {}", withRuns));
+    auto deletionVector =
+        DeletionVector::fromIcebergBlob(serialize(positions, withRuns));
+    expectSameRows(*deletionVector, positions);
+  }
+
+  auto blob = serialize(positions, false);
+  auto badMagic = blob;
+  badMagic[4] = 0;
+  VELOX_ASSERT_THROW(
+      DeletionVector::fromIcebergBlob(badMagic), "Bad deletion vector magic");
+  auto badChecksum = blob;
+  ++badChecksum[20];
+  VELOX_ASSERT_THROW(
+      DeletionVector::fromIcebergBlob(badChecksum),
+      "Deletion vector checksum mismatch");
+  VELOX_ASSERT_THROW(
+      DeletionVector::fromIcebergBlob(blob.substr(0, blob.size() - 1)),
+      "Deletion vector length does not match its blob");
+}
+
+TEST(DeletionVectorTest, cache) {
+  DeleteFileCache<DeletionVector> cache(1 << 20);
+  EXPECT_EQ(cache.find("file"), nullptr);
+  auto deletionVector = std::make_shared<DeletionVector>();
+  const int64_t position = 10;
+  deletionVector->add(&position, 1);
+  cache.insert("file", deletionVector);
+  EXPECT_EQ(cache.find("file"), deletionVector);
+  // A second insert of the same key keeps the first.
+  cache.insert("file", std::make_shared<DeletionVector>());
+  EXPECT_EQ(cache.find("file"), deletionVector);
+  EXPECT_EQ(cache.stats().numElements, 1);
+}
+
+} // namespace
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include "gtest/gtest.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+class EqualityDeleteSetTest : public ::testing::Test,
+                              public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  // Returns the rows of 'keys' that 'deleteSet' deletes.
+  std::vector<vector_size_t> deletedRows(
+      const EqualityDeleteSet& deleteSet,
+      const std::vector<VectorPtr>& keys) {
+    const auto numRows = keys[0]->size();
+    std::vector<uint64_t> bits(bits::nwords(numRows));
+    const bool anyDeleted =
+        deleteSet.setDeletedRows(keys, numRows, bits.data());
+    std::vector<vector_size_t> rows;
+    bits::forEachSetBit(
+        bits.data(), 0, numRows, [&](auto row) { rows.push_back(row); });
+    EXPECT_EQ(anyDeleted, !rows.empty());
+    return rows;
+  }
+};
+
+TEST_F(EqualityDeleteSetTest, multipleColumns) {
+  EqualityDeleteSet deleteSet(ROW({"id", "name"}, {BIGINT(), VARCHAR()}));
+  EXPECT_TRUE(deleteSet.empty());
+  deleteSet.add(*makeRowVector(
+      {"id", "name"},
+      {makeNullableFlatVector<int64_t>({1, 2, std::nullopt, 1}),
+       makeNullableFlatVector<std::string>(
+           {"a", std::nullopt, "c", "a long string over the inline size"})}));
+  EXPECT_EQ(deleteSet.size(), 4);
+
+  // The nulls are equal to nulls. The keys may have any encoding.
+  auto ids = makeNullableFlatVector<int64_t>({1, 1, 2, 2, std::nullopt, 3});
+  auto names = makeNullableFlatVector<std::string>(
+      {"a", "b", std::nullopt, "a", "c", "a"});
+  EXPECT_EQ(
+      deletedRows(deleteSet, {ids, names}),
+      std::vector<vector_size_t>({0, 2, 4}));
+  EXPECT_EQ(
+      deletedRows(
+          deleteSet,
+          {makeConstant<int64_t>(1, 2),
+           makeFlatVector<std::string>(
+               {"a long string over the inline size", "a"})}),
+      std::vector<vector_size_t>({0, 1}));
+  EXPECT_EQ(
+      deletedRows(
+          deleteSet,
+          {wrapInDictionary(makeIndices({5, 0}), ids),
+           wrapInDictionary(makeIndices({5, 0}), names)}),
+      std::vector<vector_size_t>({1}));
+
+  VELOX_ASSERT_THROW(
+      deletedRows(deleteSet, {makeFlatVector<int32_t>({1}), names}),
+      "Equality delete column id is INTEGER in the data and BIGINT in the "
+      "deletes");
+  VELOX_ASSERT_THROW(
+      EqualityDeleteSet(ROW({"a"}, {ARRAY(BIGINT())})),
+      "Equality deletes on ARRAY<BIGINT> columns are not supported");
+}
+
+TEST_F(EqualityDeleteSetTest, duplicates) {
+  EqualityDeleteSet deleteSet(ROW({"c0"}, {INTEGER()}));
+  auto deletes = makeRowVector({makeFlatVector<int32_t>({1, 2, 1, 2})});
+  deleteSet.add(*deletes);
+  const auto memoryBytes = deleteSet.memoryBytes();
+  deleteSet.add(*deletes);
+  EXPECT_EQ(deleteSet.size(), 2);
+  EXPECT_EQ(deleteSet.memoryBytes(), memoryBytes);
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
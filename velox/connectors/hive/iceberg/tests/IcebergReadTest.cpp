@@ -775,4 +775,54 @@ TEST_F(HiveIcebergTest, testPartitionedRead) {
 
   HiveConnectorTestBase::assertQuery(plan, splits, "SELECT 0, '2018-04-06'");
 }
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  std::vector<RowVectorPtr> dataVectors;
+  for (auto i = 0; i < 2; ++i) {
+    dataVectors.push_back(makeRowVector(
+        {"c0"},
+        {makeFlatVector<int64_t>(
+            rowCount / 2, [&](auto row) { return i * rowCount / 2 + row; })}));
+  }
+  auto dataFilePath = TempFilePath::create();
+  writeToFile(
+      dataFilePath->getPath(), dataVectors, config_, flushPolicyFactory_);
+  createDuckDbTable(dataVectors);
+
+  // The deletes match the first and last rows of the row groups and a key
+  // that is not in the data.
+  auto deleteFilePath = TempFilePath::create();
+  writeToFile(
+      deleteFilePath->getPath(),
+      {makeRowVector(
+          {"c0"},
+          {makeFlatVector<int64_t>({0, 9999, 10000, 12345, 19999, 30000})})},
+      config_,
+      flushPolicyFactory_);
+  IcebergDeleteFile deleteFile(
+      FileContent::kEqualityDeletes,
+      deleteFilePath->getPath(),
+      FileFormat::DWRF,
+      6,
+      testing::internal::GetFileSize(
+          std::fopen(deleteFilePath->getPath().c_str(), "r")),
+      {1});
+
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  for (auto splitCount : {1, 2}) {
+    SCOPED_TRACE(fmt::format("splitCount {}", splitCount));
+    auto splits = makeIcebergSplits(
+        dataFilePath->getPath(), {deleteFile}, {}, splitCount);
+    HiveConnectorTestBase::assertQuery(
+        PlanBuilder(pool_.get()).tableScan(rowType).planNode(),
+        splits,
+        "SELECT * FROM tmp WHERE c0 NOT IN (0, 9999, 10000, 12345, 19999)");
+
+    // The deleted rows are removed before the filters.
+    HiveConnectorTestBase::assertQuery(
+        PlanBuilder(pool_.get()).tableScan(rowType, {"c0 > 15000"}).planNode(),
+        splits,
+        "SELECT * FROM tmp WHERE c0 > 15000 AND c0 <> 19999");
+  }
+}
 } // namespace facebook::velox::connector::hive::iceberg
@@ -26,7 +26,6 @@ std::string_view HdfsFileSystem::kViewfsScheme("viewfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(
       const config::ConfigBase* config,
       const HdfsServiceEndpoint& endpoint) {
@@ -47,6 +46,14 @@ class HdfsFileSystem::Impl {
       driver_->BuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
     }
     driver_->BuilderSetForceNewInstance(builder);
+    // The builder keeps pointers to the keys and values until it connects.
+    const auto clientConf = HdfsFileSystem::clientConfig(config);
+    for (const auto& [key, value] : clientConf) {
+      driver_->BuilderConfSetStr(builder, key.c_str(), value.c_str());
+      if (key == "dfs.client.hedged.read.threadpool.size") {
+        hedgedReadCounters_ = std::make_shared<HdfsHedgedReadCounters>();
+      }
+    }
     hdfsClient_ = driver_->BuilderConnect(builder);
     VELOX_CHECK_NOT_NULL(
         hdfsClient_,
@@ -72,9 +79,15 @@ class HdfsFileSystem::Impl {
     return driver_;
   }
 
+  const std::shared_ptr<HdfsHedgedReadCounters>& hedgedReadCounters() const {
+    return hedgedReadCounters_;
+  }
+
  private:
   hdfsFS hdfsClient_;
   filesystems::arrow::io::internal::LibHdfsShim* driver_;
+  // Set if the client has hedged reads enabled.
+  std::shared_ptr<HdfsHedgedReadCounters> hedgedReadCounters_;
 };
 
 HdfsFileSystem::HdfsFileSystem(
@@ -88,6 +101,40 @@ std::string HdfsFileSystem::name() const {
   return "HDFS";
 }
 
+std::vector<std::pair<std::string, std::string>> HdfsFileSystem::clientConfig(
+    const config::ConfigBase* config) {
+  std::vector<std::pair<std::string, std::string>> clientConf;
+  if (config == nullptr) {
+    return clientConf;
+  }
+  if (config->get<bool>(kShortCircuitRead, false)) {
+    const auto socketPath = config->get<std::string>(kDomainSocketPath);
+    VELOX_USER_CHECK(
+        socketPath.hasValue() && !socketPath->empty(),
+        "{} is required when {} is enabled",
+        kDomainSocketPath,
+        kShortCircuitRead);
+    clientConf.emplace_back("dfs.client.read.shortcircuit", "true");
+    clientConf.emplace_back("dfs.domain.socket.path", *socketPath);
+  }
+  const auto hedgedReadThreads =
+      config->get<int32_t>(kHedgedReadThreadPoolSize, 0);
+  VELOX_USER_CHECK_GE(
+      hedgedReadThreads,
+      0,
+      "{} must not be negative",
+      kHedgedReadThreadPoolSize);
+  if (hedgedReadThreads > 0) {
+    clientConf.emplace_back(
+        "dfs.client.hedged.read.threadpool.size",
+        std::to_string(hedgedReadThreads));
+    clientConf.emplace_back(
+        "dfs.client.hedged.read.threshold.millis",
+        std::to_string(config->get<int32_t>(kHedgedReadThresholdMs, 500)));
+  }
+  return clientConf;
+}
+
 std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& /*unused*/) {
@@ -99,7 +146,10 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     }
   }
   return std::make_unique<HdfsReadFile>(
-      impl_->hdfsShim(), impl_->hdfsClient(), path);
+      impl_->hdfsShim(),
+      impl_->hdfsClient(),
+      path,
+      impl_->hedgedReadCounters());
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
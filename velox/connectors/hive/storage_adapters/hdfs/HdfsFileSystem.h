@@ -96,6 +96,27 @@ class HdfsFileSystem : public FileSystem {
       const std::string_view filePath,
       const config::ConfigBase* config);
 
+  /// Returns the Hadoop client settings for the short-circuit and hedged read
+  /// settings in 'config'. Empty if 'config' is null or enables neither.
+  static std::vector<std::pair<std::string, std::string>> clientConfig(
+      const config::ConfigBase* config);
+
+  /// Reads the blocks on the local data node through a domain socket
+  /// instead of the data node process.
+  static constexpr const char* kShortCircuitRead =
+      "hive.hdfs.short-circuit-read.enabled";
+  /// The domain socket shared with the local data node. Required for
+  /// short-circuit reads.
+  static constexpr const char* kDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+  /// The number of threads that issue hedged reads. 0 disables hedged reads.
+  static constexpr const char* kHedgedReadThreadPoolSize =
+      "hive.hdfs.hedged-read.thread-pool-size";
+  /// The time a read waits for a data node before a hedged read is sent to
+  /// another data node holding a replica of the block.
+  static constexpr const char* kHedgedReadThresholdMs =
+      "hive.hdfs.hedged-read.threshold-ms";
+
   static std::string_view kScheme;
 
   static std::string_view kViewfsScheme;
@@ -15,6 +15,10 @@
  */
 
 #include "HdfsReadFile.h"
+
+#include <limits>
+#include <optional>
+
 #include "velox/external/hdfs/ArrowHdfsInternal.h"
 
 namespace facebook::velox {
@@ -58,15 +62,70 @@ struct HdfsFile {
     VELOX_CHECK(bytesRead >= 0, "Read failure in HDFSReadFile::preadInternal.");
     return bytesRead;
   }
+
+  int32_t pread(uint64_t offset, char* pos, uint64_t length) const {
+    auto bytesRead = driver_->Pread(
+        client_,
+        handle_,
+        offset,
+        pos,
+        std::min<uint64_t>(length, std::numeric_limits<tSize>::max()));
+    VELOX_CHECK(
+        bytesRead > 0,
+        "Read failure in HDFSReadFile::preadInternal: {}",
+        driver_->GetLastExceptionRootCause());
+    return bytesRead;
+  }
+
+  std::optional<hdfsReadStatistics> readStatistics() const {
+    hdfsReadStatistics* stats = nullptr;
+    if (driver_->FileGetReadStatistics(handle_, &stats) != 0) {
+      return std::nullopt;
+    }
+    const auto result = *stats;
+    driver_->FileFreeReadStatistics(stats);
+    return result;
+  }
 };
 
+namespace {
+
+// Moves 'reported' up to 'value' and returns the increase, 0 if 'value' was
+// already reported.
+uint64_t takeIncrease(std::atomic<uint64_t>& reported, uint64_t value) {
+  auto previous = reported.load();
+  while (value > previous) {
+    if (reported.compare_exchange_weak(previous, value)) {
+      return value - previous;
+    }
+  }
+  return 0;
+}
+
+void addBytesCounter(
+    filesystems::File::IoStats* stats,
+    const char* name,
+    uint64_t bytes) {
+  if (bytes > 0) {
+    stats->addCounter(
+        name, RuntimeCounter(bytes, RuntimeCounter::Unit::kBytes));
+  }
+}
+
+} // namespace
+
 class HdfsReadFile::Impl {
  public:
   Impl(
       filesystems::arrow::io::internal::LibHdfsShim* driver,
       hdfsFS hdfs,
-      const std::string_view path)
-      : driver_(driver), hdfsClient_(hdfs), filePath_(path) {
+      const std::string_view path,
+      std::shared_ptr<HdfsHedgedReadCounters> hedgedReadCounters)
+      : driver_(driver),
+        hdfsClient_(hdfs),
+        filePath_(path),
+        hedgedReadCounters_(std::move(hedgedReadCounters)),
+        hasPread_(driver_->HasPread()) {
     fileInfo_ = driver_->GetPathInfo(hdfsClient_, filePath_.data());
     if (fileInfo_ == nullptr) {
       auto error = fmt::format(
@@ -89,32 +148,97 @@ class HdfsReadFile::Impl {
     }
   }
 
-  void preadInternal(uint64_t offset, uint64_t length, char* pos) const {
+  void preadInternal(
+      uint64_t offset,
+      uint64_t length,
+      char* pos,
+      filesystems::File::IoStats* stats) const {
     checkFileReadParameters(offset, length);
     if (!file_->handle_) {
       file_->open(driver_, hdfsClient_, filePath_);
     }
-    file_->seek(offset);
+    const auto statsBefore =
+        stats != nullptr ? file_->readStatistics() : std::nullopt;
     uint64_t totalBytesRead = 0;
-    while (totalBytesRead < length) {
-      auto bytesRead = file_->read(pos, length - totalBytesRead);
-      totalBytesRead += bytesRead;
-      pos += bytesRead;
+    if (hasPread_) {
+      // The client hedges positional reads but not seek and read.
+      while (totalBytesRead < length) {
+        auto bytesRead = file_->pread(
+            offset + totalBytesRead, pos, length - totalBytesRead);
+        totalBytesRead += bytesRead;
+        pos += bytesRead;
+      }
+    } else {
+      file_->seek(offset);
+      while (totalBytesRead < length) {
+        auto bytesRead = file_->read(pos, length - totalBytesRead);
+        totalBytesRead += bytesRead;
+        pos += bytesRead;
+      }
+    }
+    if (stats != nullptr) {
+      addReadCounters(statsBefore, stats);
     }
   }
 
-  std::string_view pread(uint64_t offset, uint64_t length, void* buf) const {
-    preadInternal(offset, length, static_cast<char*>(buf));
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      filesystems::File::IoStats* stats) const {
+    preadInternal(offset, length, static_cast<char*>(buf), stats);
     return {static_cast<char*>(buf), length};
   }
 
-  std::string pread(uint64_t offset, uint64_t length) const {
+  std::string pread(
+      uint64_t offset,
+      uint64_t length,
+      filesystems::File::IoStats* stats) const {
     std::string result(length, 0);
     char* pos = result.data();
-    preadInternal(offset, length, pos);
+    preadInternal(offset, length, pos, stats);
     return result;
   }
 
+  // Adds the short-circuit and local bytes of the last read and the hedged
+  // reads of the client not yet reported to 'stats'.
+  void addReadCounters(
+      const std::optional<hdfsReadStatistics>& statsBefore,
+      filesystems::File::IoStats* stats) const {
+    const auto statsAfter = file_->readStatistics();
+    if (statsBefore.has_value() && statsAfter.has_value()) {
+      addBytesCounter(
+          stats,
+          HdfsReadFile::kShortCircuitBytesRead,
+          statsAfter->totalShortCircuitBytesRead -
+              statsBefore->totalShortCircuitBytesRead);
+      addBytesCounter(
+          stats,
+          HdfsReadFile::kLocalBytesRead,
+          statsAfter->totalLocalBytesRead - statsBefore->totalLocalBytesRead);
+    }
+    if (hedgedReadCounters_ == nullptr) {
+      return;
+    }
+    hdfsHedgedReadMetrics* metrics = nullptr;
+    if (driver_->GetHedgedReadMetrics(hdfsClient_, &metrics) != 0) {
+      return;
+    }
+    const auto hedgedReads =
+        takeIncrease(hedgedReadCounters_->hedgedReads, metrics->hedgedReadOps);
+    const auto hedgedReadWins = takeIncrease(
+        hedgedReadCounters_->hedgedReadWins, metrics->hedgedReadOpsWin);
+    driver_->FreeHedgedReadMetrics(metrics);
+    if (hedgedReads > 0) {
+      stats->addCounter(
+          HdfsReadFile::kHedgedReads, RuntimeCounter(hedgedReads));
+    }
+    if (hedgedReadWins > 0) {
+      stats->addCounter(
+          HdfsReadFile::kHedgedReadWins, RuntimeCounter(hedgedReadWins));
+    }
+  }
+
   uint64_t size() const {
     return fileInfo_->mSize;
   }
@@ -148,14 +272,21 @@ class HdfsReadFile::Impl {
   hdfsFS hdfsClient_;
   std::string filePath_;
   hdfsFileInfo* fileInfo_;
+  const std::shared_ptr<HdfsHedgedReadCounters> hedgedReadCounters_;
+  const bool hasPread_;
   folly::ThreadLocal<HdfsFile> file_;
 };
 
 HdfsReadFile::HdfsReadFile(
     filesystems::arrow::io::internal::LibHdfsShim* driver,
     hdfsFS hdfs,
-    const std::string_view path)
-    : pImpl(std::make_unique<Impl>(driver, hdfs, path)) {}
+    const std::string_view path,
+    std::shared_ptr<HdfsHedgedReadCounters> hedgedReadCounters)
+    : pImpl(std::make_unique<Impl>(
+          driver,
+          hdfs,
+          path,
+          std::move(hedgedReadCounters))) {}
 
 HdfsReadFile::~HdfsReadFile() = default;
 
@@ -164,14 +295,14 @@ std::string_view HdfsReadFile::pread(
     uint64_t length,
     void* buf,
     filesystems::File::IoStats* stats) const {
-  return pImpl->pread(offset, length, buf);
+  return pImpl->pread(offset, length, buf, stats);
 }
 
 std::string HdfsReadFile::pread(
     uint64_t offset,
     uint64_t length,
     filesystems::File::IoStats* stats) const {
-  return pImpl->pread(offset, length);
+  return pImpl->pread(offset, length, stats);
 }
 
 uint64_t HdfsReadFile::size() const {
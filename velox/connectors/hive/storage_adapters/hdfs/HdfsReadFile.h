@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <atomic>
+
 #include "velox/common/file/File.h"
 #include "velox/external/hdfs/hdfs.h"
 
@@ -23,15 +25,33 @@ namespace filesystems::arrow::io::internal {
 class LibHdfsShim;
 }
 
+/// The hedged read metrics of an HDFS client that have been reported to the
+/// IoStats of the reads. The client keeps cumulative metrics for all its
+/// files, and each increment is reported once by the read that sees it.
+struct HdfsHedgedReadCounters {
+  std::atomic<uint64_t> hedgedReads{0};
+  std::atomic<uint64_t> hedgedReadWins{0};
+};
+
 /**
  * Implementation of hdfs read file.
  */
 class HdfsReadFile final : public ReadFile {
  public:
+  /// The counters added to the IoStats of the reads.
+  static constexpr const char* kShortCircuitBytesRead =
+      "hdfsShortCircuitBytesRead";
+  static constexpr const char* kLocalBytesRead = "hdfsLocalBytesRead";
+  static constexpr const char* kHedgedReads = "hdfsHedgedReads";
+  static constexpr const char* kHedgedReadWins = "hdfsHedgedReadWins";
+
+  /// 'hedgedReadCounters' is set if the client of 'hdfs' has hedged reads
+  /// enabled.
   explicit HdfsReadFile(
       filesystems::arrow::io::internal::LibHdfsShim* driver,
       hdfsFS hdfs,
-      std::string_view path);
+      std::string_view path,
+      std::shared_ptr<HdfsHedgedReadCounters> hedgedReadCounters = nullptr);
   ~HdfsReadFile() override;
 
   std::string_view pread(
@@ -293,6 +293,88 @@ TEST_F(HdfsFileSystemTest, missingPort) {
       "hdfsPort is empty, configuration missing for hdfs port");
 }
 
+TEST_F(HdfsFileSystemTest, clientConfig) {
+  using ClientConfig = std::vector<std::pair<std::string, std::string>>;
+  using filesystems::HdfsFileSystem;
+
+  // No config and the defaults leave both features off.
+  ASSERT_TRUE(HdfsFileSystem::clientConfig(nullptr).empty());
+  const config::ConfigBase emptyConfig(
+      std::unordered_map<std::string, std::string>{});
+  ASSERT_TRUE(HdfsFileSystem::clientConfig(&emptyConfig).empty());
+
+  const config::ConfigBase disabledConfig(
+      std::unordered_map<std::string, std::string>{
+          {HdfsFileSystem::kShortCircuitRead, "false"},
+          {HdfsFileSystem::kDomainSocketPath, "/var/run/hdfs/dn_socket"},
+          {HdfsFileSystem::kHedgedReadThreadPoolSize, "0"},
+          {HdfsFileSystem::kHedgedReadThresholdMs, "100"}});
+  ASSERT_TRUE(HdfsFileSystem::clientConfig(&disabledConfig).empty());
+
+  const config::ConfigBase shortCircuitConfig(
+      std::unordered_map<std::string, std::string>{
+          {HdfsFileSystem::kShortCircuitRead, "true"},
+          {HdfsFileSystem::kDomainSocketPath, "/var/run/hdfs/dn_socket"}});
+  ASSERT_EQ(
+      HdfsFileSystem::clientConfig(&shortCircuitConfig),
+      (ClientConfig{
+          {"dfs.client.read.shortcircuit", "true"},
+          {"dfs.domain.socket.path", "/var/run/hdfs/dn_socket"}}));
+
+  // The threshold defaults to 500ms.
+  const config::ConfigBase hedgedReadConfig(
+      std::unordered_map<std::string, std::string>{
+          {HdfsFileSystem::kHedgedReadThreadPoolSize, "8"}});
+  ASSERT_EQ(
+      HdfsFileSystem::clientConfig(&hedgedReadConfig),
+      (ClientConfig{
+          {"dfs.client.hedged.read.threadpool.size", "8"},
+          {"dfs.client.hedged.read.threshold.millis", "500"}}));
+
+  const config::ConfigBase allConfig(
+      std::unordered_map<std::string, std::string>{
+          {HdfsFileSystem::kShortCircuitRead, "true"},
+          {HdfsFileSystem::kDomainSocketPath, "/tmp/dn_socket"},
+          {HdfsFileSystem::kHedgedReadThreadPoolSize, "4"},
+          {HdfsFileSystem::kHedgedReadThresholdMs, "20"}});
+  ASSERT_EQ(
+      HdfsFileSystem::clientConfig(&allConfig),
+      (ClientConfig{
+          {"dfs.client.read.shortcircuit", "true"},
+          {"dfs.domain.socket.path", "/tmp/dn_socket"},
+          {"dfs.client.hedged.read.threadpool.size", "4"},
+          {"dfs.client.hedged.read.threshold.millis", "20"}}));
+
+  const config::ConfigBase missingSocketConfig(
+      std::unordered_map<std::string, std::string>{
+          {HdfsFileSystem::kShortCircuitRead, "true"}});
+  VELOX_ASSERT_USER_THROW(
+      HdfsFileSystem::clientConfig(&missingSocketConfig),
+      "hive.hdfs.domain-socket-path is required when "
+      "hive.hdfs.short-circuit-read.enabled is enabled");
+
+  const config::ConfigBase negativeThreadsConfig(
+      std::unordered_map<std::string, std::string>{
+          {HdfsFileSystem::kHedgedReadThreadPoolSize, "-1"}});
+  VELOX_ASSERT_USER_THROW(
+      HdfsFileSystem::clientConfig(&negativeThreadsConfig),
+      "hive.hdfs.hedged-read.thread-pool-size must not be negative");
+}
+
+TEST_F(HdfsFileSystemTest, hedgedReadViaFileSystem) {
+  auto values = configurationValues;
+  values[filesystems::HdfsFileSystem::kHedgedReadThreadPoolSize] = "2";
+  values[filesystems::HdfsFileSystem::kHedgedReadThresholdMs] = "10";
+  const auto config = std::make_shared<const config::ConfigBase>(
+      std::move(values));
+  filesystems::HdfsFileSystem hdfsFileSystem(
+      config,
+      filesystems::HdfsFileSystem::getServiceEndpoint(
+          fullDestinationPath_, config.get()));
+  auto readFile = hdfsFileSystem.openFileForRead(fullDestinationPath_);
+  readData(readFile.get());
+}
+
 TEST_F(HdfsFileSystemTest, missingFileViaReadFile) {
   filesystems::arrow::io::internal::LibHdfsShim* driver;
   auto hdfs = connectHdfsDriver(
@@ -148,6 +148,10 @@ void registerS3Metrics() {
   DEFINE_METRIC(kMetricS3GetMetadataErrors, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3GetObjectRetries, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3GetMetadataRetries, velox::StatType::COUNT);
+  // Tracks getObject latency in range of [0, 10s] with 500 buckets and
+  // reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricS3GetObjectLatencyMs, 20, 0, 10'000, 50, 90, 99, 100);
 #endif
 }
 
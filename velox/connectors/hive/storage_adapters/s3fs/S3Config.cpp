@@ -87,4 +87,12 @@ std::optional<std::string> S3Config::endpointRegion() const {
   return region;
 }
 
+uint64_t S3Config::readPartSize() const {
+  const auto size = config::toCapacity(
+      config_.find(Keys::kReadPartSize)->second.value(),
+      config::CapacityUnit::BYTE);
+  VELOX_USER_CHECK_GT(size, 0, "S3 read part size must be positive");
+  return size;
+}
+
 } // namespace facebook::velox::filesystems
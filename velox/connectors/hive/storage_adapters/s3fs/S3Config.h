@@ -76,6 +76,9 @@ class S3Config {
     kRetryMode,
     kUseProxyFromEnv,
     kCredentialsProvider,
+    kReadParallelism,
+    kReadPartSize,
+    kUploadParallelism,
     kEnd
   };
 
@@ -114,6 +117,11 @@ class S3Config {
              std::make_pair("use-proxy-from-env", "false")},
             {Keys::kCredentialsProvider,
              std::make_pair("aws-credentials-provider", std::nullopt)},
+            {Keys::kReadParallelism,
+             std::make_pair("read-parallelism", "1")},
+            {Keys::kReadPartSize, std::make_pair("read-part-size", "8MB")},
+            {Keys::kUploadParallelism,
+             std::make_pair("upload-parallelism", "1")},
         };
     return config;
   }
@@ -243,6 +251,25 @@ class S3Config {
     return config_.find(Keys::kCredentialsProvider)->second;
   }
 
+  /// Maximum number of GetObject requests in flight for the reads of all the
+  /// files of a file system. Reads over 'readPartSize' bytes are split into
+  /// parts read in parallel if this is over 1.
+  uint32_t readParallelism() const {
+    auto value = config_.find(Keys::kReadParallelism)->second.value();
+    return folly::to<uint32_t>(value);
+  }
+
+  /// Size in bytes of the parts of a read split into parallel requests.
+  uint64_t readPartSize() const;
+
+  /// Maximum number of parts uploading in the background for the writes of
+  /// all the files of a file system, and for each file. The parts are
+  /// uploaded synchronously by append and close if this is 1.
+  int32_t uploadParallelism() const {
+    auto value = config_.find(Keys::kUploadParallelism)->second.value();
+    return folly::to<int32_t>(value);
+  }
+
  private:
   std::unordered_map<Keys, std::optional<std::string>> config_;
   std::string payloadSigningPolicy_;
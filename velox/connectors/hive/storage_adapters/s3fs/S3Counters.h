@@ -53,4 +53,8 @@ constexpr std::string_view kMetricS3GetObjectErrors{
 constexpr std::string_view kMetricS3GetObjectRetries{
     "velox.s3_get_object_retries"};
 
+// The latency distribution of S3 getObject calls.
+constexpr std::string_view kMetricS3GetObjectLatencyMs{
+    "velox.s3_get_object_latency_ms"};
+
 } // namespace facebook::velox::filesystems
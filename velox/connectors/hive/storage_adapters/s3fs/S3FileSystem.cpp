@@ -15,9 +15,11 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/config/Config.h"
 #include "velox/common/file/File.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Config.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Counters.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
@@ -25,7 +27,11 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 
@@ -98,8 +104,18 @@ std::shared_ptr<Aws::Auth::AWSCredentialsProvider> getCredentialsProviderByName(
 
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(std::string_view path, Aws::S3::S3Client* client)
-      : client_(client) {
+  // Reads over 'readPartSize' bytes are split into parts read in parallel on
+  // 'readExecutor' if it is set. preadvAsync() then also reads on
+  // 'readExecutor'.
+  S3ReadFile(
+      std::string_view path,
+      Aws::S3::S3Client* client,
+      folly::Executor* readExecutor = nullptr,
+      uint64_t readPartSize = 0)
+      : client_(client),
+        readExecutor_(readExecutor),
+        readPartSize_(readPartSize) {
+    VELOX_CHECK(!readExecutor_ || readPartSize_ > 0);
     getBucketAndKeyFromPath(path, bucket_, key_);
   }
 
@@ -160,23 +176,51 @@ class S3ReadFile final : public ReadFile {
     // multi-range. AWS S3 also charges by number of read requests and not size.
     // The idea here is to use a single read spanning all the ranges and then
     // populate individual ranges. We pre-allocate a buffer to support this.
-    size_t length = 0;
-    for (const auto range : buffers) {
-      length += range.size();
+    const auto length = totalLength(buffers);
+    if (isSingleRange(buffers)) {
+      preadInternal(offset, length, buffers[0].data());
+      return length;
     }
     // TODO: allocate from a memory pool
     std::string result(length, 0);
     preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
-    }
+    copyToRanges(result.data(), buffers);
     return length;
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      File::IoStats* stats) const override {
+    if (!readExecutor_) {
+      return ReadFile::preadvAsync(offset, buffers, stats);
+    }
+    const auto length = totalLength(buffers);
+    std::shared_ptr<std::string> result;
+    char* position;
+    if (isSingleRange(buffers)) {
+      position = buffers[0].data();
+    } else {
+      result = std::make_shared<std::string>(length, 0);
+      position = result->data();
+    }
+    return folly::collectAll(readParts(offset, length, position))
+        .deferValue([result, buffers, length](
+                        std::vector<folly::Try<folly::Unit>>&& parts) {
+          for (auto& part : parts) {
+            part.throwUnlessValue();
+          }
+          if (result) {
+            copyToRanges(result->data(), buffers);
+          }
+          return length;
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return readExecutor_ != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -200,9 +244,73 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
+  static uint64_t totalLength(const std::vector<folly::Range<char*>>& buffers) {
+    uint64_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
+    }
+    return length;
+  }
+
+  // Returns true if 'buffers' is a single range without gaps, which is then
+  // read into directly.
+  static bool isSingleRange(const std::vector<folly::Range<char*>>& buffers) {
+    return buffers.size() == 1 && buffers[0].data() != nullptr;
+  }
+
+  // Copies the bytes of the ranges of 'buffers' from 'data', which has the
+  // bytes of the ranges and the gaps between them.
+  static void copyToRanges(
+      const char* data,
+      const std::vector<folly::Range<char*>>& buffers) {
+    size_t offset = 0;
+    for (auto range : buffers) {
+      if (range.data()) {
+        memcpy(range.data(), data + offset, range.size());
+      }
+      offset += range.size();
+    }
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    if (!readExecutor_ || length <= readPartSize_) {
+      getObject(offset, length, position);
+      return;
+    }
+    auto parts = folly::collectAll(readParts(offset, length, position)).get();
+    for (auto& part : parts) {
+      part.throwUnlessValue();
+    }
+  }
+
+  // Starts the reads of 'length' bytes at 'offset' on 'readExecutor_'. The
+  // range is split into parts of at most 'readPartSize_' bytes of about the
+  // same size.
+  std::vector<folly::SemiFuture<folly::Unit>>
+  readParts(uint64_t offset, uint64_t length, char* position) const {
+    const auto numParts = std::max<uint64_t>(
+        1, bits::divRoundUp(length, readPartSize_));
+    const auto partSize = bits::divRoundUp(length, numParts);
+    std::vector<folly::SemiFuture<folly::Unit>> parts;
+    parts.reserve(numParts);
+    for (uint64_t partOffset = 0; partOffset < length;
+         partOffset += partSize) {
+      const auto partLength = std::min(partSize, length - partOffset);
+      auto read = [this,
+                   partStart = offset + partOffset,
+                   partLength,
+                   partPosition = position + partOffset]() {
+        getObject(partStart, partLength, partPosition);
+      };
+      parts.push_back(folly::via(readExecutor_, std::move(read)).semi());
+    }
+    return parts;
+  }
+
+  // Reads 'length' bytes at 'offset' into 'position' with one GetObject.
+  void getObject(uint64_t offset, uint64_t length, char* position) const {
     // Read the desired range of bytes.
     Aws::S3::Model::GetObjectRequest request;
     Aws::S3::Model::GetObjectResult result;
@@ -216,7 +324,13 @@ class S3ReadFile final : public ReadFile {
         AwsWriteableStreamFactory(position, length));
     RECORD_METRIC_VALUE(kMetricS3ActiveConnections);
     RECORD_METRIC_VALUE(kMetricS3GetObjectCalls);
-    auto outcome = client_->GetObject(request);
+    uint64_t latencyUs{0};
+    auto outcome = [&]() {
+      MicrosecondTimer timer(&latencyUs);
+      return client_->GetObject(request);
+    }();
+    RECORD_HISTOGRAM_METRIC_VALUE(
+        kMetricS3GetObjectLatencyMs, latencyUs / 1'000);
     if (!outcome.IsSuccess()) {
       RECORD_METRIC_VALUE(kMetricS3GetObjectErrors);
     }
@@ -226,6 +340,8 @@ class S3ReadFile final : public ReadFile {
   }
 
   Aws::S3::S3Client* client_;
+  folly::Executor* const readExecutor_;
+  const uint64_t readPartSize_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -274,16 +390,21 @@ Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy inferPayloadSign(
 
 class S3WriteFile::Impl {
  public:
-  explicit Impl(
+  Impl(
       std::string_view path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool)
-      : client_(client), pool_(pool) {
+      memory::MemoryPool* pool,
+      folly::Executor* uploadExecutor,
+      int32_t maxUploadsInFlight)
+      : client_(client),
+        pool_(pool),
+        uploadExecutor_(uploadExecutor),
+        maxUploadsInFlight_(maxUploadsInFlight) {
     VELOX_CHECK_NOT_NULL(client);
     VELOX_CHECK_NOT_NULL(pool);
+    VELOX_CHECK(!uploadExecutor_ || maxUploadsInFlight_ > 0);
     getBucketAndKeyFromPath(path, bucket_, key_);
-    currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
-    currentPart_->reserve(kPartUploadSize);
+    currentPart_ = newPart();
     // Check that the object doesn't exist, if it does throw an error.
     {
       Aws::S3::Model::HeadObjectRequest request;
@@ -338,10 +459,19 @@ class S3WriteFile::Impl {
     fileSize_ = 0;
   }
 
+  ~Impl() {
+    // The uploads in flight reference 'this' and their parts.
+    for (auto& upload : uploadsInFlight_) {
+      std::move(upload.result).getTry();
+    }
+  }
+
   // Appends data to the end of the file.
   void append(std::string_view data) {
     VELOX_CHECK(!closed(), "File is closed");
-    if (data.size() + currentPart_->size() >= kPartUploadSize) {
+    if (uploadExecutor_) {
+      appendAsync(data);
+    } else if (data.size() + currentPart_->size() >= kPartUploadSize) {
       upload(data);
     } else {
       // Append to current part.
@@ -364,7 +494,13 @@ class S3WriteFile::Impl {
       return;
     }
     RECORD_METRIC_VALUE(kMetricS3StartedUploads);
-    uploadPart({currentPart_->data(), currentPart_->size()}, true);
+    if (uploadExecutor_) {
+      startPartUpload();
+      waitForUploads(0);
+      freeParts_.clear();
+    } else {
+      uploadPart({currentPart_->data(), currentPart_->size()}, true);
+    }
     VELOX_CHECK_EQ(uploadState_.partNumber, uploadState_.completedParts.size());
     // Complete the multipart upload.
     {
@@ -414,6 +550,63 @@ class S3WriteFile::Impl {
   };
   UploadState uploadState_;
 
+  // A part uploading on 'uploadExecutor_'.
+  struct UploadInFlight {
+    std::unique_ptr<dwio::common::DataBuffer<char>> part;
+    folly::SemiFuture<Aws::S3::Model::CompletedPart> result;
+  };
+
+  std::unique_ptr<dwio::common::DataBuffer<char>> newPart() {
+    if (!freeParts_.empty()) {
+      auto part = std::move(freeParts_.back());
+      freeParts_.pop_back();
+      part->resize(0);
+      return part;
+    }
+    auto part = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
+    part->reserve(kPartUploadSize);
+    return part;
+  }
+
+  // Copies 'data' to 'currentPart_' and starts the upload of each part that
+  // gets full.
+  void appendAsync(std::string_view data) {
+    while (!data.empty()) {
+      const auto size = std::min<uint64_t>(
+          data.size(), kPartUploadSize - currentPart_->size());
+      currentPart_->unsafeAppend(data.data(), size);
+      data.remove_prefix(size);
+      if (currentPart_->size() == kPartUploadSize) {
+        startPartUpload();
+      }
+    }
+  }
+
+  // Starts the upload of 'currentPart_' on 'uploadExecutor_' after waiting
+  // for an upload to finish if 'maxUploadsInFlight_' are in flight.
+  void startPartUpload() {
+    waitForUploads(maxUploadsInFlight_ - 1);
+    const auto partNumber = ++uploadState_.partNumber;
+    auto part = std::move(currentPart_);
+    auto send = [this, partNumber, data = part.get()]() {
+      return sendPart(partNumber, {data->data(), data->size()});
+    };
+    uploadsInFlight_.push_back(
+        {std::move(part), folly::via(uploadExecutor_, std::move(send)).semi()});
+    currentPart_ = newPart();
+  }
+
+  // Waits for the oldest uploads until at most 'maxUploads' are in flight.
+  // Throws the error of a failed upload.
+  void waitForUploads(size_t maxUploads) {
+    while (uploadsInFlight_.size() > maxUploads) {
+      auto upload = std::move(uploadsInFlight_.front());
+      uploadsInFlight_.pop_front();
+      uploadState_.completedParts.push_back(std::move(upload.result).get());
+      freeParts_.push_back(std::move(upload.part));
+    }
+  }
+
   // Data can be smaller or larger than the kPartUploadSize.
   // Complete the currentPart_ and upload kPartUploadSize chunks of data.
   // Save the remaining into currentPart_.
@@ -438,41 +631,53 @@ class S3WriteFile::Impl {
   void uploadPart(const std::string_view part, bool isLast = false) {
     // Only the last part can be less than kPartUploadSize.
     VELOX_CHECK(isLast || (!isLast && (part.size() == kPartUploadSize)));
-    // Upload the part.
-    {
-      Aws::S3::Model::UploadPartRequest request;
-      request.SetBucket(bucket_);
-      request.SetKey(key_);
-      request.SetUploadId(uploadState_.id);
-      request.SetPartNumber(++uploadState_.partNumber);
-      request.SetContentLength(part.size());
-      request.SetBody(
-          std::make_shared<StringViewStream>(part.data(), part.size()));
-      // The default algorithm used is MD5. However, MD5 is not supported with
-      // fips and can cause a SIGSEGV. Set CRC32 instead which is a standard for
-      // checksum computation and is not restricted by fips.
-      request.SetChecksumAlgorithm(Aws::S3::Model::ChecksumAlgorithm::CRC32);
-      auto outcome = client_->UploadPart(request);
-      VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
-      // Append ETag and part number for this uploaded part.
-      // This will be needed for upload completion in Close().
-      auto result = outcome.GetResult();
-      Aws::S3::Model::CompletedPart part;
-
-      part.SetPartNumber(uploadState_.partNumber);
-      part.SetETag(result.GetETag());
-      // Don't add the checksum to the part if the checksum is empty.
-      // Some filesystems such as IBM COS require this to be not set.
-      if (!result.GetChecksumCRC32().empty()) {
-        part.SetChecksumCRC32(result.GetChecksumCRC32());
-      }
-      uploadState_.completedParts.push_back(std::move(part));
+    uploadState_.completedParts.push_back(
+        sendPart(++uploadState_.partNumber, part));
+  }
+
+  // Uploads 'part' as the part 'partNumber' and returns its completion. Runs
+  // on 'uploadExecutor_' for the asynchronous uploads.
+  Aws::S3::Model::CompletedPart sendPart(
+      int64_t partNumber,
+      const std::string_view part) const {
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(bucket_);
+    request.SetKey(key_);
+    request.SetUploadId(uploadState_.id);
+    request.SetPartNumber(partNumber);
+    request.SetContentLength(part.size());
+    request.SetBody(
+        std::make_shared<StringViewStream>(part.data(), part.size()));
+    // The default algorithm used is MD5. However, MD5 is not supported with
+    // fips and can cause a SIGSEGV. Set CRC32 instead which is a standard for
+    // checksum computation and is not restricted by fips.
+    request.SetChecksumAlgorithm(Aws::S3::Model::ChecksumAlgorithm::CRC32);
+    auto outcome = client_->UploadPart(request);
+    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
+    // Return ETag and part number for this uploaded part.
+    // This will be needed for upload completion in Close().
+    auto result = outcome.GetResult();
+    Aws::S3::Model::CompletedPart completedPart;
+
+    completedPart.SetPartNumber(partNumber);
+    completedPart.SetETag(result.GetETag());
+    // Don't add the checksum to the part if the checksum is empty.
+    // Some filesystems such as IBM COS require this to be not set.
+    if (!result.GetChecksumCRC32().empty()) {
+      completedPart.SetChecksumCRC32(result.GetChecksumCRC32());
     }
+    return completedPart;
   }
 
   Aws::S3::S3Client* client_;
   memory::MemoryPool* pool_;
+  folly::Executor* const uploadExecutor_;
+  const int32_t maxUploadsInFlight_;
   std::unique_ptr<dwio::common::DataBuffer<char>> currentPart_;
+  // The parts uploading on 'uploadExecutor_' in the order of their numbers.
+  std::deque<UploadInFlight> uploadsInFlight_;
+  // Parts whose upload finished, reused for the next parts.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>> freeParts_;
   std::string bucket_;
   std::string key_;
   size_t fileSize_ = -1;
@@ -481,8 +686,11 @@ class S3WriteFile::Impl {
 S3WriteFile::S3WriteFile(
     std::string_view path,
     Aws::S3::S3Client* client,
-    memory::MemoryPool* pool) {
-  impl_ = std::make_shared<Impl>(path, client, pool);
+    memory::MemoryPool* pool,
+    folly::Executor* uploadExecutor,
+    int32_t maxUploadsInFlight) {
+  impl_ = std::make_shared<Impl>(
+      path, client, pool, uploadExecutor, maxUploadsInFlight);
 }
 
 void S3WriteFile::append(std::string_view data) {
@@ -692,10 +900,28 @@ class S3FileSystem::Impl {
 
     client_ = std::make_shared<Aws::S3::S3Client>(
         credentialsProvider, nullptr /* endpointProvider */, clientConfig);
+
+    // The threads of the executor bound the number of GetObject requests in
+    // flight for the file system.
+    if (s3Config.readParallelism() > 1) {
+      readPartSize_ = s3Config.readPartSize();
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          s3Config.readParallelism(),
+          std::make_shared<folly::NamedThreadFactory>("S3Read"));
+    }
+    if (s3Config.uploadParallelism() > 1) {
+      uploadParallelism_ = s3Config.uploadParallelism();
+      uploadExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          uploadParallelism_,
+          std::make_shared<folly::NamedThreadFactory>("S3Upload"));
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    // Finishes the reads and uploads in flight before the client goes away.
+    readExecutor_.reset();
+    uploadExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -829,6 +1055,22 @@ class S3FileSystem::Impl {
     return client_.get();
   }
 
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
+  uint64_t readPartSize() const {
+    return readPartSize_;
+  }
+
+  folly::Executor* uploadExecutor() const {
+    return uploadExecutor_.get();
+  }
+
+  int32_t uploadParallelism() const {
+    return uploadParallelism_;
+  }
+
   std::string getLogLevelName() const {
     return getAwsInstance()->getLogLevelName();
   }
@@ -839,6 +1081,14 @@ class S3FileSystem::Impl {
 
  private:
   std::shared_ptr<Aws::S3::S3Client> client_;
+  // Runs the parts of the reads split into parallel GetObject requests. Not
+  // set if 'hive.s3.read-parallelism' is 1.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
+  uint64_t readPartSize_{0};
+  // Uploads the parts of the write files in the background. Not set if
+  // 'hive.s3.upload-parallelism' is 1.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> uploadExecutor_;
+  int32_t uploadParallelism_{0};
 };
 
 S3FileSystem::S3FileSystem(
@@ -861,7 +1111,8 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view s3Path,
     const FileOptions& options) {
   const auto path = getPath(s3Path);
-  auto s3file = std::make_unique<S3ReadFile>(path, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      path, impl_->s3Client(), impl_->readExecutor(), impl_->readPartSize());
   s3file->initialize(options);
   return s3file;
 }
@@ -870,8 +1121,12 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view s3Path,
     const FileOptions& options) {
   const auto path = getPath(s3Path);
-  auto s3file =
-      std::make_unique<S3WriteFile>(path, impl_->s3Client(), options.pool);
+  auto s3file = std::make_unique<S3WriteFile>(
+      path,
+      impl_->s3Client(),
+      options.pool,
+      impl_->uploadExecutor(),
+      impl_->uploadParallelism());
   return s3file;
 }
 
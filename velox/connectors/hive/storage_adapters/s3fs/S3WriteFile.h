@@ -23,6 +23,10 @@ namespace Aws::S3 {
 class S3Client;
 }
 
+namespace folly {
+class Executor;
+}
+
 namespace facebook::velox::filesystems {
 
 /// S3WriteFile uses the Apache Arrow implementation as a reference.
@@ -42,15 +46,20 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
+/// UploadPart is synchronous during append and flush unless an upload
+/// executor is given. The full parts are then uploaded on the executor while
+/// the writer goes on appending, with at most 'maxUploadsInFlight' parts
+/// uploading at a time. The parts in flight are allocated from 'pool'. An
+/// error of an upload is thrown by the next append or close.
 /// TODO: Implement retry on failure.
 class S3WriteFile : public WriteFile {
  public:
   S3WriteFile(
       std::string_view path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* uploadExecutor = nullptr,
+      int32_t maxUploadsInFlight = 0);
 
   /// Appends data to the end of the file.
   /// Uploads a part on reaching part size limit.
@@ -59,7 +68,8 @@ class S3WriteFile : public WriteFile {
   /// No-op. Append handles the flush.
   void flush() override;
 
-  /// Close the file. Any cleanup (disk flush, etc.) will be done here.
+  /// Close the file. Any cleanup (disk flush, etc.) will be done here. Waits
+  /// for the parts uploading in the background.
   void close() override;
 
   /// Current file size, i.e. the sum of all previous Appends.
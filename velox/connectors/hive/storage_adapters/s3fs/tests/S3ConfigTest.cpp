@@ -37,6 +37,8 @@ TEST(S3ConfigTest, defaultConfig) {
   ASSERT_EQ(s3Config.payloadSigningPolicy(), "Never");
   ASSERT_EQ(s3Config.cacheKey("foo", config), "foo");
   ASSERT_EQ(s3Config.bucket(), "");
+  ASSERT_EQ(s3Config.readParallelism(), 1);
+  ASSERT_EQ(s3Config.readPartSize(), 8 << 20);
 }
 
 TEST(S3ConfigTest, overrideConfig) {
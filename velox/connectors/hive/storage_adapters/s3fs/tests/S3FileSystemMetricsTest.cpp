@@ -166,6 +166,13 @@ TEST_F(S3FileSystemMetricsTest, metrics) {
   EXPECT_EQ(2, s3Reporter->counterMap[std::string{kMetricS3MetadataCalls}]);
   readFile->pread(0, kDataContent.length());
   EXPECT_EQ(1, s3Reporter->counterMap[std::string{kMetricS3GetObjectCalls}]);
+  EXPECT_EQ(
+      1,
+      s3Reporter->histogramPercentilesMap.count(
+          std::string{kMetricS3GetObjectLatencyMs}));
+  EXPECT_EQ(
+      1,
+      s3Reporter->counterMap.count(std::string{kMetricS3GetObjectLatencyMs}));
 }
 
 } // namespace facebook::velox::filesystems
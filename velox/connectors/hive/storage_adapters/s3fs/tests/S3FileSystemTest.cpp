@@ -76,6 +76,40 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, parallelRead) {
+  const char* bucketName = "parallel";
+  const char* file = "test.txt";
+  const auto filename = localPath(bucketName) + "/" + file;
+  const auto s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-parallelism", "4"}, {"hive.s3.read-part-size", "64kB"}});
+  filesystems::S3FileSystem s3fs(bucketName, hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  readData(readFile.get());
+
+  char head[12];
+  char tail[7];
+  const uint64_t gap = kOneMB + 15 - sizeof(head) - sizeof(tail);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)gap),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(readFile->preadvAsync(0, buffers).get(), 15 + kOneMB);
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+
+  std::string data(kOneMB, 0);
+  buffers = {folly::Range<char*>(data.data(), data.size())};
+  ASSERT_EQ(readFile->preadvAsync(10, buffers).get(), kOneMB);
+  ASSERT_EQ(data, std::string(kOneMB, 'c'));
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     std::unordered_map<std::string, std::string> config(
@@ -292,6 +326,44 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
 
+TEST_F(S3FileSystemTest, writeFileWithAsyncUploads) {
+  const auto bucketName = "asyncupload";
+  const auto file = "test.txt";
+  const auto s3File = s3URI(bucketName, file);
+
+  auto hiveConfig =
+      minioServer_->hiveConfig({{"hive.s3.upload-parallelism", "3"}});
+  filesystems::S3FileSystem s3fs(bucketName, hiveConfig);
+  auto pool = memory::memoryManager()->addLeafPool("S3FileSystemTest");
+  auto writeFile =
+      s3fs.openFileForWrite(s3File, {{}, pool.get(), std::nullopt});
+  auto s3WriteFile = dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+
+  // Appends 41 MiB of numbered 1 KiB blocks in appends of different sizes,
+  // i.e. 4 full parts of 10 MiB and a last part.
+  constexpr int32_t kBlockSize = 1 << 10;
+  constexpr int32_t kNumBlocks = 41 << 10;
+  std::string data(kNumBlocks * kBlockSize, 0);
+  for (int32_t i = 0; i < kNumBlocks; ++i) {
+    memcpy(data.data() + i * kBlockSize, &i, sizeof(i));
+  }
+  std::string_view remaining = data;
+  for (auto appendSize = 1; !remaining.empty(); appendSize *= 3) {
+    const auto size = std::min<size_t>(appendSize, remaining.size());
+    writeFile->append(remaining.substr(0, size));
+    remaining.remove_prefix(size);
+  }
+  EXPECT_EQ(writeFile->size(), data.size());
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 4);
+  // The parts being uploaded are allocated from the pool.
+  EXPECT_GE(pool->usedBytes(), 10 << 20);
+  writeFile->close();
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 5);
+
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_EQ(readFile->pread(0, data.size()), data);
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
@@ -17,7 +17,10 @@
 #include <gtest/gtest.h>
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
+#include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/CacheSummary.h"
+#include "velox/connectors/hive/HiveCacheWarmer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/HiveDataSource.h"
@@ -656,5 +659,76 @@ TEST_F(HiveConnectorTest, prestoTableSampling) {
   ASSERT_TRUE(filters.empty());
 }
 
+TEST_F(HiveConnectorTest, cacheWarmer) {
+  const auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  const auto vectors = makeVectors(rowType, 4, 1'000);
+  const auto filePaths = makeFilePaths(3);
+  std::vector<std::shared_ptr<HiveConnectorSplit>> splits;
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors);
+    // The last split is not cacheable.
+    splits.push_back(makeHiveConnectorSplit(
+        filePaths[i]->getPath(),
+        0,
+        std::numeric_limits<uint64_t>::max(),
+        0,
+        i < filePaths.size() - 1));
+  }
+  asyncDataCache_->clear();
+
+  config::ConfigBase sessionProperties({});
+  folly::CancellationSource cancellationSource;
+  ConnectorQueryCtx connectorQueryCtx(
+      pool_.get(),
+      pool_.get(),
+      &sessionProperties,
+      nullptr,
+      common::PrefixSortConfig(),
+      nullptr,
+      asyncDataCache_.get(),
+      "query.cacheWarmer",
+      "task.cacheWarmer",
+      "planNodeId.cacheWarmer",
+      0,
+      "",
+      false,
+      cancellationSource.getToken());
+  auto hiveConnector = std::dynamic_pointer_cast<HiveConnector>(
+      connector::getConnector(kHiveConnectorId));
+  HiveCacheWarmer warmer(
+      hiveConnector.get(),
+      makeTableHandle(),
+      ROW({"c0"}, {BIGINT()}),
+      &connectorQueryCtx,
+      {});
+  auto stats = warmer.warm(splits);
+  ASSERT_EQ(stats.numSplits, 2);
+  ASSERT_EQ(stats.numSkippedSplits, 1);
+  ASSERT_EQ(stats.numRows, 8'000);
+  ASSERT_FALSE(stats.cancelled);
+  ASSERT_GT(asyncDataCache_->refreshStats().numEntries, 0);
+
+  // The warmed files are partly cached, only 'c0' is read. The split that goes
+  // to the end of a file of unknown size has no known byte range.
+  const auto fileSize = fs::file_size(filePaths[0]->getPath());
+  const auto fraction = hiveConnector->cachedFraction(
+      *makeHiveConnectorSplit(filePaths[0]->getPath(), 0, fileSize));
+  ASSERT_GT(fraction, 0);
+  ASSERT_LT(fraction, 1);
+  ASSERT_EQ(hiveConnector->cachedFraction(*splits[0]), 0);
+  ASSERT_EQ(
+      hiveConnector->cachedFraction(
+          *makeHiveConnectorSplit(filePaths[2]->getPath(), 0, fileSize)),
+      0);
+  auto summary = hiveConnector->cacheSummary();
+  ASSERT_TRUE(summary->mayContainFile(filePaths[0]->getPath()));
+  ASSERT_EQ(summary, hiveConnector->cacheSummary());
+
+  cancellationSource.requestCancellation();
+  stats = warmer.warm(splits);
+  ASSERT_EQ(stats.numSplits, 0);
+  ASSERT_TRUE(stats.cancelled);
+}
+
 } // namespace
 } // namespace facebook::velox::connector::hive
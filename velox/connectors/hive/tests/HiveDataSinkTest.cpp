@@ -35,6 +35,7 @@
 #include "velox/dwio/parquet/writer/Writer.h"
 #endif
 
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
@@ -520,7 +521,8 @@ TEST_F(HiveDataSinkTest, basic) {
       "spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] "
       "spillFillTimeNanos[0ns] spillSortTimeNanos[0ns] spillExtractVectorTime[0ns] spillSerializationTimeNanos[0ns] "
       "spillWrites[0] spillFlushTimeNanos[0ns] spillWriteTimeNanos[0ns] "
-      "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
+      "spillWriteWaitTimeNanos[0ns] maxSpillExceededLimitCount[0] "
+      "spillReadBytes[0B] spillReads[0] "
       "spillReadTimeNanos[0ns] spillReadDeserializationTimeNanos[0ns]");
 
   const int numBatches = 10;
@@ -571,7 +573,8 @@ TEST_F(HiveDataSinkTest, basicBucket) {
       "spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] "
       "spillFillTimeNanos[0ns] spillSortTimeNanos[0ns] spillExtractVectorTime[0ns] spillSerializationTimeNanos[0ns] "
       "spillWrites[0] spillFlushTimeNanos[0ns] spillWriteTimeNanos[0ns] "
-      "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
+      "spillWriteWaitTimeNanos[0ns] maxSpillExceededLimitCount[0] "
+      "spillReadBytes[0B] spillReads[0] "
       "spillReadTimeNanos[0ns] spillReadDeserializationTimeNanos[0ns]");
 
   const int numBatches = 10;
@@ -1272,6 +1275,133 @@ TEST_F(HiveDataSinkTest, ensureFilesWithData) {
   verifyWrittenData(outputDirectory->getPath());
 }
 
+TEST_F(HiveDataSinkTest, clusteredWrite) {
+  const auto vectors = createVectors(500, 4);
+  createDuckDbTable(vectors);
+
+  auto makeDataSink = [&](const std::string& outputDirectoryPath,
+                          const std::vector<std::string>& clusteredBy) {
+    auto handle = createHiveInsertTableHandle(rowType_, outputDirectoryPath);
+    return std::make_shared<HiveDataSink>(
+        rowType_,
+        std::make_shared<HiveInsertTableHandle>(
+            handle->inputColumns(),
+            handle->locationHandle(),
+            handle->storageFormat(),
+            nullptr,
+            handle->compressionKind(),
+            handle->serdeParameters(),
+            nullptr,
+            false,
+            handle->fileNameGenerator(),
+            clusteredBy),
+        connectorQueryCtx_.get(),
+        CommitStrategy::kNoCommit,
+        connectorConfig_);
+  };
+
+  // With one clustering column, the Z-order is the order of the column.
+  auto outputDirectory = TempDirectoryPath::create();
+  auto dataSink = makeDataSink(outputDirectory->getPath(), {"c0"});
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  ASSERT_TRUE(dataSink->finish());
+  dataSink->close();
+  verifyWrittenData(outputDirectory->getPath());
+
+  const auto filePaths = listFiles(outputDirectory->getPath());
+  auto result = AssertQueryBuilder(PlanBuilder().tableScan(rowType_).planNode())
+                    .split(makeHiveConnectorSplit(filePaths[0]))
+                    .copyResults(pool());
+  auto* c0 = result->childAt(0)->asFlatVector<int64_t>();
+  std::optional<int64_t> previous;
+  for (auto i = 0; i < result->size(); ++i) {
+    if (c0->isNullAt(i)) {
+      continue;
+    }
+    if (previous.has_value()) {
+      ASSERT_LE(previous.value(), c0->valueAt(i));
+    }
+    previous = c0->valueAt(i);
+  }
+
+  outputDirectory = TempDirectoryPath::create();
+  dataSink = makeDataSink(outputDirectory->getPath(), {"c0", "c4", "c5"});
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  ASSERT_TRUE(dataSink->finish());
+  dataSink->close();
+  verifyWrittenData(outputDirectory->getPath());
+
+  VELOX_ASSERT_USER_THROW(
+      makeDataSink(outputDirectory->getPath(), {"c7"}),
+      "Clustering column must be a non-partition column: c7");
+}
+
+TEST_F(HiveDataSinkTest, openWriterLimit) {
+  connectorSessionProperties_->set(HiveConfig::kMaxOpenWritersSession, "4");
+  connectorSessionProperties_->set(
+      HiveConfig::kMaxPartitionBufferBytesSession, "16KB");
+  const auto outputDirectory = TempDirectoryPath::create();
+  const auto rowType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  const int numPartitions = 20;
+  const int batchSize = 500;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<int64_t>(
+             batchSize, [](auto row) { return row % numPartitions; }),
+         makeFlatVector<int64_t>(
+             batchSize, [i](auto row) { return i * batchSize + row; })}));
+  }
+  auto dataSink = createDataSink(
+      rowType,
+      outputDirectory->getPath(),
+      dwio::common::FileFormat::DWRF,
+      {"c0"});
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  ASSERT_TRUE(dataSink->finish());
+  const auto partitionUpdates = dataSink->close();
+
+  // The writers closed to stay within the limit leave more than one file
+  // for some partitions, each with its own partition update.
+  const auto filePaths = listFiles(outputDirectory->getPath());
+  ASSERT_GT(filePaths.size(), numPartitions);
+  ASSERT_EQ(partitionUpdates.size(), filePaths.size());
+  ASSERT_EQ(dataSink->stats().numWrittenFiles, filePaths.size());
+
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (const auto& filePath : filePaths) {
+    splits.push_back(makeHiveConnectorSplit(filePath));
+  }
+  createDuckDbTable(vectors);
+  HiveConnectorTestBase::assertQuery(
+      PlanBuilder().tableScan(ROW({"c1"}, {BIGINT()})).planNode(),
+      splits,
+      "SELECT c1 FROM tmp");
+
+  // Bucketed tables are not supported.
+  auto bucketProperty = std::make_shared<HiveBucketProperty>(
+      HiveBucketProperty::Kind::kHiveCompatible,
+      4,
+      std::vector<std::string>{"c1"},
+      std::vector<TypePtr>{BIGINT()},
+      std::vector<std::shared_ptr<const HiveSortingColumn>>{});
+  VELOX_ASSERT_THROW(
+      createDataSink(
+          rowType,
+          outputDirectory->getPath(),
+          dwio::common::FileFormat::DWRF,
+          {"c0"},
+          bucketProperty),
+      "max_open_writers is not supported for bucketed tables");
+}
+
 TEST_F(HiveDataSinkTest, ensureFilesUnsupported) {
   VELOX_ASSERT_THROW(
       makeHiveInsertTableHandle(
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/HiveIndexSource.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+
+namespace facebook::velox::connector::hive {
+namespace {
+
+using namespace facebook::velox::exec::test;
+
+class HiveIndexSourceTest : public HiveConnectorTestBase {
+ protected:
+  void SetUp() override {
+    HiveConnectorTestBase::SetUp();
+    Type::registerSerDe();
+    HiveConnectorSplit::registerSerDe();
+    HiveIndexTableHandle::registerSerDe();
+  }
+
+  // Writes the index table as 'numFiles' files sorted on 'k', with 'k' from
+  // 0 to 'numFiles' * 'rowsPerFile' - 1 in steps of 2.
+  void writeIndexTable(int32_t numFiles, int32_t rowsPerFile) {
+    for (auto i = 0; i < numFiles; ++i) {
+      auto data = makeRowVector(
+          {"k", "v", "w"},
+          {makeFlatVector<int64_t>(
+               rowsPerFile,
+               [&](auto row) { return 2 * (i * rowsPerFile + row); }),
+           makeFlatVector<std::string>(
+               rowsPerFile,
+               [&](auto row) {
+                 return fmt::format("v{}", i * rowsPerFile + row);
+               }),
+           makeFlatVector<int64_t>(
+               rowsPerFile, [&](auto row) { return i * rowsPerFile + row; })});
+      files_.push_back(TempFilePath::create());
+      writeToFile(files_.back()->getPath(), data);
+      splits_.push_back(makeHiveConnectorSplit(files_.back()->getPath()));
+      indexData_.push_back(data);
+    }
+    createDuckDbTable("u", indexData_);
+  }
+
+  std::shared_ptr<HiveIndexTableHandle> makeTableHandle() const {
+    std::vector<std::shared_ptr<const HiveConnectorSplit>> files(
+        splits_.begin(), splits_.end());
+    return std::make_shared<HiveIndexTableHandle>(
+        kHiveConnectorId,
+        "index_table",
+        common::SubfieldFilters{},
+        indexType_,
+        std::move(files));
+  }
+
+  core::PlanNodePtr makeLookupPlan(
+      const RowVectorPtr& probe,
+      core::JoinType joinType,
+      core::PlanNodeId& joinNodeId) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto indexPlanBuilder = PlanBuilder(planNodeIdGenerator, pool());
+    auto indexScan = std::dynamic_pointer_cast<const core::TableScanNode>(
+        PlanBuilder::TableScanBuilder(indexPlanBuilder)
+            .tableHandle(makeTableHandle())
+            .outputType(indexType_)
+            .assignments(allRegularColumns(indexType_))
+            .endTableScan()
+            .planNode());
+    return PlanBuilder(planNodeIdGenerator, pool())
+        .values({probe})
+        .indexLookupJoin(
+            {"p"}, {"k"}, indexScan, {}, {"p", "v", "w"}, joinType)
+        .capturePlanNodeId(joinNodeId)
+        .planNode();
+  }
+
+  const RowTypePtr indexType_{
+      ROW({"k", "v", "w"}, {BIGINT(), VARCHAR(), BIGINT()})};
+  std::vector<std::shared_ptr<TempFilePath>> files_;
+  std::vector<std::shared_ptr<HiveConnectorSplit>> splits_;
+  std::vector<RowVectorPtr> indexData_;
+};
+
+TEST_F(HiveIndexSourceTest, lookup) {
+  writeIndexTable(3, 1'000);
+  // Keys that match once, twice, not at all and null, all in the key range
+  // of the first file.
+  auto probe = makeRowVector(
+      {"p", "q"},
+      {makeNullableFlatVector<int64_t>(
+           {10, 11, 10, std::nullopt, 1'998, 0, 7, 500}),
+       makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6, 7, 8})});
+  createDuckDbTable("t", {probe});
+
+  core::PlanNodeId joinNodeId;
+  for (auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    const auto sql = joinType == core::JoinType::kInner
+        ? "SELECT p, v, w FROM t, u WHERE t.p = u.k"
+        : "SELECT p, v, w FROM t LEFT JOIN u ON t.p = u.k";
+    auto task = AssertQueryBuilder(
+                    makeLookupPlan(probe, joinType, joinNodeId),
+                    duckDbQueryRunner_)
+                    .assertResults(sql);
+    auto stats = exec::toPlanStats(task->taskStats()).at(joinNodeId);
+    // The files after the first have no keys in their stats.
+    ASSERT_EQ(
+        stats.customStats.at(HiveIndexSource::kSkippedIndexFiles).sum, 2);
+    ASSERT_LT(stats.customStats.at(HiveIndexSource::kIndexRowsRead).sum, 10);
+  }
+}
+
+TEST_F(HiveIndexSourceTest, tableHandleSerde) {
+  writeIndexTable(2, 10);
+  auto handle = makeTableHandle();
+  auto copy = ISerializable::deserialize<HiveIndexTableHandle>(
+      handle->serialize(), pool());
+  ASSERT_EQ(copy->toString(), handle->toString());
+  ASSERT_EQ(copy->files().size(), 2);
+  ASSERT_EQ(copy->files()[1]->filePath, splits_[1]->filePath);
+  ASSERT_TRUE(copy->supportsIndexLookup());
+}
+
+} // namespace
+} // namespace facebook::velox::connector::hive
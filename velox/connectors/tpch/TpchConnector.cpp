@@ -21,37 +21,6 @@ namespace facebook::velox::connector::tpch {
 
 using facebook::velox::tpch::Table;
 
-namespace {
-
-RowVectorPtr getTpchData(
-    Table table,
-    size_t maxRows,
-    size_t offset,
-    double scaleFactor,
-    memory::MemoryPool* pool) {
-  switch (table) {
-    case Table::TBL_PART:
-      return velox::tpch::genTpchPart(pool, maxRows, offset, scaleFactor);
-    case Table::TBL_SUPPLIER:
-      return velox::tpch::genTpchSupplier(pool, maxRows, offset, scaleFactor);
-    case Table::TBL_PARTSUPP:
-      return velox::tpch::genTpchPartSupp(pool, maxRows, offset, scaleFactor);
-    case Table::TBL_CUSTOMER:
-      return velox::tpch::genTpchCustomer(pool, maxRows, offset, scaleFactor);
-    case Table::TBL_ORDERS:
-      return velox::tpch::genTpchOrders(pool, maxRows, offset, scaleFactor);
-    case Table::TBL_LINEITEM:
-      return velox::tpch::genTpchLineItem(pool, maxRows, offset, scaleFactor);
-    case Table::TBL_NATION:
-      return velox::tpch::genTpchNation(pool, maxRows, offset, scaleFactor);
-    case Table::TBL_REGION:
-      return velox::tpch::genTpchRegion(pool, maxRows, offset, scaleFactor);
-  }
-  return nullptr;
-}
-
-} // namespace
-
 std::string TpchTableHandle::toString() const {
   return fmt::format(
       "table: {}, scale factor: {}", toTableName(table_), scaleFactor_);
@@ -63,8 +32,12 @@ TpchDataSource::TpchDataSource(
     const std::unordered_map<
         std::string,
         std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-    velox::memory::MemoryPool* pool)
-    : pool_(pool) {
+    velox::memory::MemoryPool* pool,
+    folly::Executor* executor,
+    size_t generationParallelism)
+    : executor_(executor),
+      generationParallelism_(generationParallelism),
+      pool_(pool) {
   auto tpchTableHandle =
       std::dynamic_pointer_cast<TpchTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
@@ -159,8 +132,14 @@ std::optional<RowVectorPtr> TpchDataSource::next(
   }
 
   size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
-  auto outputVector =
-      getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  auto outputVector = velox::tpch::genTpchData(
+      tpchTable_,
+      pool_,
+      maxRows,
+      splitOffset_,
+      scaleFactor_,
+      executor_,
+      generationParallelism_);
 
   // If the split is exhausted.
   if (!outputVector || outputVector->size() == 0) {
@@ -76,7 +76,9 @@ class TpchDataSource : public DataSource {
       const std::unordered_map<
           std::string,
           std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-      velox::memory::MemoryPool* pool);
+      velox::memory::MemoryPool* pool,
+      folly::Executor* executor = nullptr,
+      size_t generationParallelism = 1);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -126,16 +128,40 @@ class TpchDataSource : public DataSource {
   size_t completedRows_{0};
   size_t completedBytes_{0};
 
+  // Generates each batch in up to 'generationParallelism_' ranges in parallel
+  // if set.
+  folly::Executor* const executor_;
+  const size_t generationParallelism_;
+
   memory::MemoryPool* pool_;
 };
 
 class TpchConnector final : public Connector {
  public:
+  /// The number of ranges each batch of a split is generated in, in parallel
+  /// on the executor of the connector. 1 generates the batches on the driver
+  /// thread.
+  static constexpr const char* kGenerationParallelism =
+      "tpch.generation-parallelism";
+
   TpchConnector(
       const std::string& id,
       std::shared_ptr<const config::ConfigBase> config,
-      folly::Executor* /*executor*/)
-      : Connector(id) {}
+      folly::Executor* executor)
+      : Connector(id),
+        executor_(executor),
+        generationParallelism_(
+            config->get<int32_t>(kGenerationParallelism, 1)) {
+    VELOX_USER_CHECK_GE(
+        generationParallelism_,
+        1,
+        "{} must be positive",
+        kGenerationParallelism);
+  }
+
+  folly::Executor* executor() const override {
+    return executor_;
+  }
 
   std::unique_ptr<DataSource> createDataSource(
       const std::shared_ptr<const RowType>& outputType,
@@ -148,7 +174,9 @@ class TpchConnector final : public Connector {
         outputType,
         tableHandle,
         columnHandles,
-        connectorQueryCtx->memoryPool());
+        connectorQueryCtx->memoryPool(),
+        executor_,
+        generationParallelism_);
   }
 
   std::unique_ptr<DataSink> createDataSink(
@@ -159,6 +187,10 @@ class TpchConnector final : public Connector {
       CommitStrategy /*commitStrategy*/) override final {
     VELOX_NYI("TpchConnector does not support data sink.");
   }
+
+ private:
+  folly::Executor* const executor_;
+  const int32_t generationParallelism_;
 };
 
 class TpchConnectorFactory : public ConnectorFactory {
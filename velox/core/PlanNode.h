@@ -2188,11 +2188,17 @@ class LocalMergeNode : public PlanNode {
 /// Calculates partition number for each row of the specified vector.
 class PartitionFunction {
  public:
+  /// Partition number of a row which goes to all the partitions. Only used by
+  /// partition functions that replicate rows for a remote exchange, see
+  /// PartitionedOutput.
+  static constexpr uint32_t kAllPartitions =
+      std::numeric_limits<uint32_t>::max();
+
   virtual ~PartitionFunction() = default;
 
   /// @param input RowVector to split into partitions.
   /// @param [out] partitions Computed partition numbers for each row in
-  /// 'input'.
+  /// 'input'. A partition number may be kAllPartitions.
   /// @return Returns partition number in case all rows of 'input' are
   /// assigned to the same partition. In this case 'partitions' vector is left
   /// unchanged. Used to optimize round-robin partitioning in local exchange.
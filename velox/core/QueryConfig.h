@@ -64,11 +64,53 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// If true, trees of plus, minus and multiply of DOUBLE or REAL over columns
+  /// and constants are evaluated as one expression in a single pass over the
+  /// rows, without a vector for the result of each call. False by default.
+  static constexpr const char* kExprFusedArithmeticEnabled =
+      "expression.fused_arithmetic_enabled";
+
+  /// If greater than 0, a branch of a SWITCH, IF or COALESCE that selects at
+  /// most this fraction of the rows of the batch is evaluated over a dense
+  /// copy of its inputs, and the result is scattered back to the selected
+  /// rows. 0 by default, i.e. the branches are evaluated on the selected rows
+  /// of the batch.
+  static constexpr const char* kExprSparseBranchMaxDensity =
+      "expression.sparse_branch_max_density";
+
+  /// If true, each node of an expression tree records the time spent in its
+  /// evaluation, the bytes it allocates, its input and non-null output rows,
+  /// see ExprSet::profile(). FilterProject reports these as runtime stats of
+  /// its plan node. False by default.
+  static constexpr const char* kExprProfileEnabled =
+      "expression.profile_enabled";
+
+  /// If true, the json_extract_scalar calls with constant paths on the same
+  /// JSON in a set of expressions are evaluated as one call that parses each
+  /// document once and extracts all the paths. False by default.
+  static constexpr const char* kExprJsonMultiPathExtractionEnabled =
+      "expression.json_multi_path_extraction_enabled";
+
+  /// If true, the results of json_extract_scalar calls with constant paths
+  /// over a batch are kept in the AsyncDataCache of the process, so that
+  /// extracting the same paths from the same batch again does not parse the
+  /// documents. False by default.
+  static constexpr const char* kExprJsonExtractCacheEnabled =
+      "expression.json_extract_cache_enabled";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// If N > 0, one in N calls of Operator::addInput() and getOutput() counts
+  /// the CPU cycles, instructions, last-level cache misses and branch
+  /// mispredictions of the call with the hardware counters of the thread and
+  /// adds them to the runtime stats of the operator. 0 by default, which
+  /// disables the counters. The counters are not available on all systems.
+  static constexpr const char* kOperatorHardwareCounterSampleRate =
+      "operator_hardware_counter_sample_rate";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -93,6 +135,14 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// A local exchange copies the strings of a string column into a tight
+  /// buffer before queuing it if the strings of the batch take less than this
+  /// fraction of the string buffers the column references. The buffers of a
+  /// large decompressed page would otherwise be kept alive by a few rows
+  /// while the batch waits in the queue. 0 disables the compaction.
+  static constexpr const char* kLocalExchangeStringCompactionRatio =
+      "local_exchange_string_compaction_ratio";
+
   /// Limits the number of partitions created by a local exchange.
   /// Partitioning data too granularly can lead to poor performance.
   /// This setting allows increasing the task concurrency for all
@@ -144,6 +194,13 @@ class QueryConfig {
   static constexpr const char* kMaxExchangeBufferSize =
       "exchange.max_buffer_size";
 
+  /// If true, the exchange client sizes the bytes it keeps queued and in
+  /// flight to the rate at which the consumers drain the exchange queue times
+  /// the round trip time of the data requests, capped by
+  /// 'exchange.max_buffer_size'.
+  static constexpr const char* kExchangeAdaptiveFlowControl =
+      "exchange.adaptive_flow_control";
+
   /// Maximum size in bytes to accumulate among all sources of the merge
   /// exchange. Enforced approximately, not strictly.
   static constexpr const char* kMaxMergeExchangeBufferSize =
@@ -170,6 +227,104 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Percentage of the groups that a partial aggregation evicts at a time once
+  /// it reaches 'max_partial_aggregation_memory'. Groups that were not updated
+  /// since the previous eviction sweep are evicted first, so that frequent
+  /// keys stay in the table. 0 flushes all groups instead.
+  static constexpr const char* kPartialAggregationEvictionPct =
+      "partial_aggregation_eviction_pct";
+
+  /// If true, a partial aggregation checks whether its input is sorted on the
+  /// grouping keys. While it is, the aggregation outputs the groups of each
+  /// batch as soon as the keys change, as if the keys were pre-grouped, so
+  /// that the hash table holds only the groups of one batch. The first batch
+  /// that is not sorted, or that is not greater than the previous batch, turns
+  /// the check off for the rest of the input.
+  static constexpr const char* kPartialAggregationSortedInputDetectionEnabled =
+      "partial_aggregation_sorted_input_detection_enabled";
+
+  /// Maximum number of groups for which a group by on keys that fit an array
+  /// (kArray hash mode) keeps the accumulators of aggregates that support it,
+  /// e.g. sum and count, in flat arrays indexed by the group's array position
+  /// instead of in the group rows. 0 disables the dense accumulators.
+  static constexpr const char* kAggregationDenseAccumulatorsMaxGroups =
+      "aggregation_dense_accumulators_max_groups";
+
+  /// If true, the drivers of a final or single hash aggregation insert their
+  /// input into one grouping table shared by all the drivers of the task, so
+  /// that the plan does not need a local exchange that partitions the input by
+  /// the grouping keys. Applies only to integer or boolean grouping keys and
+  /// count, sum, min and max of fixed width numeric types without masks, and
+  /// only if spilling is disabled.
+  static constexpr const char* kConcurrentHashAggregationEnabled =
+      "concurrent_hash_aggregation_enabled";
+
+  /// If true, a final or single hash aggregation with two or more distinct
+  /// aggregates over single columns, e.g. count(distinct a), count(distinct
+  /// b), keeps the distinct values of all of them in one hash table on
+  /// (group, aggregate, value) instead of in one set per group and aggregate.
+  static constexpr const char* kAggregationSharedDistinctTableEnabled =
+      "aggregation_shared_distinct_table_enabled";
+
+  /// If true, a single aggregation over a GroupId, e.g. for ROLLUP or CUBE,
+  /// aggregates each input row once on all the grouping keys and derives the
+  /// grouping sets from the intermediate results of these groups, instead of
+  /// aggregating a copy of the input per grouping set. Applies only if the
+  /// aggregates have no masks, distinct or sorted inputs and spilling is
+  /// disabled.
+  static constexpr const char* kAggregationGroupingSetsRollupEnabled =
+      "aggregation_grouping_sets_rollup_enabled";
+
+  /// If true, the drivers of an OrderBy sort their input in parallel and then
+  /// range-partition the sorted runs by splitters sampled from all the runs,
+  /// so that each driver merges one key range of all the runs and the drivers
+  /// return disjoint, consecutive key ranges. The final merge of the outputs
+  /// of the drivers, e.g. by a LocalMerge, then takes all the rows of one
+  /// driver before the rows of the next. Applies only if spilling is disabled.
+  static constexpr const char* kOrderByParallelSortEnabled =
+      "order_by_parallel_sort_enabled";
+
+  /// If true, the drivers of a Window without partition keys evaluate the
+  /// window functions of the single partition in parallel: the drivers sort
+  /// their input and split it into consecutive key ranges as for
+  /// 'kOrderByParallelSortEnabled', each driver evaluates the functions over
+  /// one range, and the results are fixed up with the results over the ranges
+  /// before it. Applies only to row_number, rank, dense_rank and to sum and
+  /// count of numeric types and min and max of integer types with the default
+  /// frame, and only if spilling is disabled.
+  static constexpr const char* kWindowParallelEvaluationEnabled =
+      "window_parallel_evaluation_enabled";
+
+  /// If true, a nested loop join whose condition compares a build column with
+  /// expressions over probe columns, e.g. 'u0 BETWEEN t0 - 10 AND t0 + 10' or
+  /// 't0 >= u0', sorts the build side on that column and evaluates the
+  /// condition only on the build rows in the range found by binary search for
+  /// each probe row. The order of the build rows matching a probe row in the
+  /// output then follows the sort order.
+  static constexpr const char* kNestedLoopJoinSortedBuildEnabled =
+      "nested_loop_join_sorted_build_enabled";
+
+  /// If true, a nested loop join whose condition tests that the envelope of a
+  /// build row, given by DOUBLE build columns, overlaps a point or envelope
+  /// over probe columns in two dimensions, e.g. 'x BETWEEN xmin AND xmax AND y
+  /// BETWEEN ymin AND ymax', packs the build side into an R-tree on the
+  /// envelopes. The condition is then evaluated only on the build rows whose
+  /// envelopes overlap the one of the probe row. Takes precedence over
+  /// kNestedLoopJoinSortedBuildEnabled. The order of the build rows matching a
+  /// probe row in the output then follows the packing order.
+  static constexpr const char* kNestedLoopJoinSpatialIndexEnabled =
+      "nested_loop_join_spatial_index_enabled";
+
+  /// Maximum number of input batches that a TopN keeps to take the non-key
+  /// columns of the top rows from at the end. The rows in the heap then hold
+  /// only the sort keys and a reference to their input row, so that the
+  /// non-key columns of the rows that are later pushed out of the heap are not
+  /// copied. Once more batches are referenced, the non-key columns of the rows
+  /// in the heap are copied into one batch. 0 copies the non-key columns of
+  /// each row into the heap.
+  static constexpr const char* kTopNLateMaterializationMaxBatches =
+      "topn_late_materialization_max_batches";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -214,6 +369,21 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If true, the Driver sets the output batch size of each operator from the
+  /// measured CPU time per row of the operator that consumes its output and
+  /// from the size of its output rows. Cheap consumers get larger batches up
+  /// to kMaxOutputBatchRows and expensive ones get smaller batches, down to
+  /// kAdaptiveOutputBatchMinRows, that keep their working set in cache. The
+  /// sizes take effect the next time an operator computes its batch size,
+  /// e.g. for each split in TableScan.
+  static constexpr const char* kAdaptiveOutputBatchRowsEnabled =
+      "adaptive_output_batch_rows_enabled";
+
+  /// Min number of rows in the output batches sized by
+  /// kAdaptiveOutputBatchRowsEnabled.
+  static constexpr const char* kAdaptiveOutputBatchMinRows =
+      "adaptive_output_batch_min_rows";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
@@ -237,9 +407,31 @@ class QueryConfig {
   static constexpr const char* kAggregationSpillEnabled =
       "aggregation_spill_enabled";
 
+  /// Percentage of the row bytes of a final or single aggregation that a
+  /// memory reclaim spills when releasing the unused memory reservation of the
+  /// operator satisfies the reclaim. The largest hash partitions are spilled
+  /// and the others keep aggregating in memory. 0 spills all the rows.
+  static constexpr const char* kAggregationSpillPartialPct =
+      "aggregation_spill_partial_pct";
+
   /// Join spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kJoinSpillEnabled = "join_spill_enabled";
 
+  /// If true, the SMALLINT, INTEGER and BIGINT dependent columns of the hash
+  /// join tables built from spilled input are stored as the offset from the
+  /// minimum build side value in the fewest bytes that fit the range of the
+  /// build side values. TIMESTAMP dependent columns whose build side values are
+  /// all whole microseconds are stored as int64 microseconds in 8 instead of
+  /// 16 bytes.
+  static constexpr const char* kJoinSpillCompactColumnsEnabled =
+      "join_spill_compact_columns_enabled";
+
+  /// If true, an inner hash join without a filter joins a restored spill
+  /// partition which exceeds the max spill level by sorting both sides and
+  /// merging them instead of building a hash table of it.
+  static constexpr const char* kHashJoinSortMergeFallbackEnabled =
+      "hash_join_sort_merge_fallback_enabled";
+
   /// Config to enable hash join spill for mixed grouped execution mode.
   static constexpr const char* kMixedGroupedModeHashJoinSpillEnabled =
       "mixed_grouped_mode_hash_join_spill_enabled";
@@ -263,6 +455,14 @@ class QueryConfig {
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
 
+  /// Partitioned output buffer spilling flag, only applies if "spill_enabled"
+  /// flag is set. If true, the task's partitioned output buffer spills the
+  /// pages of its destinations to disk when its buffered size reaches
+  /// kMaxOutputBufferSize instead of blocking the producers, and reads them
+  /// back when fetched.
+  static constexpr const char* kOutputBufferSpillEnabled =
+      "output_buffer_spill_enabled";
+
   /// The max row numbers to fill and spill for each spill run. This is used to
   /// cap the memory used for spilling. If it is zero, then there is no limit
   /// and spilling might run out of memory.
@@ -291,6 +491,19 @@ class QueryConfig {
   static constexpr const char* kSpillCompressionKind =
       "spill_compression_codec";
 
+  /// If larger than 0 and the spill compression codec is zstd, the Presto
+  /// serde compresses the pages of a spill partition with a ZSTD dictionary
+  /// trained on its first this many pages. 0 disables the dictionary.
+  static constexpr const char* kSpillCompressionDictionaryPages =
+      "spill_compression_dictionary_pages";
+
+  /// The serde used to spill the rows of a row container, e.g. by aggregation,
+  /// order by and hash build: 'Presto' for the columnar Presto page format,
+  /// 'CompactRow' for the row wise compact row format or 'ArrowIpc' for Arrow
+  /// IPC record batch messages.
+  static constexpr const char* kSpillRowContainerSerdeKind =
+      "spill_row_container_serde_kind";
+
   /// Enable the prefix sort or fallback to timsort in spill. The prefix sort is
   /// faster than std::sort but requires the memory to build normalized prefix
   /// keys, which might have potential risk of running out of server memory.
@@ -304,11 +517,37 @@ class QueryConfig {
   static constexpr const char* kSpillWriteBufferSize =
       "spill_write_buffer_size";
 
+  /// If true, a spill writer serializes the next buffer of spilled data while
+  /// the previous one is written to disk on the spill executor.
+  static constexpr const char* kSpillAsyncWriteEnabled =
+      "spill_async_write_enabled";
+
   /// Specifies the buffer size in bytes to read from one spilled file. If the
   /// underlying filesystem supports async read, we do read-ahead with double
   /// buffering, which doubles the buffer used to read from each spill file.
   static constexpr const char* kSpillReadBufferSize = "spill_read_buffer_size";
 
+  /// The maximum memory in bytes used to prefetch the next buffers of the
+  /// spill files merged by an ordered spill reader on the spill executor. Used
+  /// if the underlying filesystem does not support async read. 0 disables the
+  /// prefetch.
+  static constexpr const char* kSpillMergeReadAheadBudget =
+      "spill_merge_read_ahead_budget";
+
+  /// The maximum memory in bytes of the read buffers of the sorted spill files
+  /// merged at a time by an order by, 'kSpillReadBufferSize' per file. If a
+  /// sort has spilled more files, the smallest files are merged into larger
+  /// sorted files first, in as many passes as needed. 0 means no limit.
+  static constexpr const char* kSpillMergeReadBufferBudget =
+      "spill_merge_read_buffer_budget";
+
+  /// The quota in bytes of the spill files on the local spill tier of a node.
+  /// Once the spill files of all the tasks on the local tier reach the quota,
+  /// new spill files go to the overflow spill directory of the task, e.g. on a
+  /// remote object store. 0 disables the overflow tier.
+  static constexpr const char* kSpillLocalTierMaxBytes =
+      "spill_local_tier_max_bytes";
+
   /// Config used to create spill files. This config is provided to underlying
   /// file system and the config is free form. The form should be defined by the
   /// underlying file system.
@@ -347,6 +586,15 @@ class QueryConfig {
   static constexpr const char* kSpillableReservationGrowthPct =
       "spillable_reservation_growth_pct";
 
+  /// If larger than 'kSpillableReservationGrowthPct', the growth percentage
+  /// doubles with each successful memory reservation of a spillable operator
+  /// up to this value, and goes back to 'kSpillableReservationGrowthPct' when
+  /// a reservation fails. This reaches the peak memory of a large operator in
+  /// fewer and larger reservations, each of which may need a memory
+  /// arbitration. 0 keeps the growth percentage constant.
+  static constexpr const char* kMaxSpillableReservationGrowthPct =
+      "max_spillable_reservation_growth_pct";
+
   /// Minimum memory footprint size required to reclaim memory from a file
   /// writer by flushing its buffered data to disk.
   static constexpr const char* kWriterFlushThresholdBytes =
@@ -400,6 +648,43 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The target size in bytes of a cache-resident partition of a hash join
+  /// table. If non-zero and the table is larger than this, the build side rows
+  /// are inserted and the probe side rows are looked up one table partition at
+  /// a time to reduce cache and TLB misses. 0 disables radix partitioning.
+  static constexpr const char* kHashJoinRadixPartitionBytes =
+      "hash_join_radix_partition_bytes";
+
+  /// The max size in bytes of a Bloom filter made from the integer join keys of
+  /// a hash join build side and pushed down into the probe side table scan as
+  /// a dynamic filter. Bloom filters are made for the keys that have too many
+  /// distinct values for an exact IN-list dynamic filter. 0 disables Bloom
+  /// filter pushdown.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
+  /// If true, the hash probe returns the build side columns as lazy vectors
+  /// that are copied from the hash table only for the rows and the columns
+  /// accessed downstream. Applies to hash joins that cannot spill.
+  static constexpr const char* kHashProbeLazyBuildColumnsEnabled =
+      "hash_probe_lazy_build_columns_enabled";
+
+  /// Comma-separated list of the ids of the hash join plan nodes whose build
+  /// sides are broadcast, i.e. identical in all the tasks of a stage. The tasks
+  /// of the same query running on a node share one build table for these
+  /// joins: the first task to finish its build publishes its table and the
+  /// other tasks probe it instead of building their own. Right, full and right
+  /// semi joins are never shared as they set probed flags on the table.
+  static constexpr const char* kSharedHashJoinNodeIds =
+      "shared_hash_join_node_ids";
+
+  /// The max size in bytes of a build table shared by the joins in
+  /// 'kSharedHashJoinNodeIds' if spilling is enabled for them. A shared table
+  /// can't be spilled, so larger tables are built per task. 0 disables sharing
+  /// for the joins which can spill.
+  static constexpr const char* kSharedHashJoinMaxTableBytes =
+      "shared_hash_join_max_table_bytes";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -423,6 +708,19 @@ class QueryConfig {
   static constexpr const char* kMaxSharedSubexprResultsCached =
       "max_shared_subexpr_results_cached";
 
+  /// The maximum retained size in bytes of the results an expression memoizes
+  /// for the base of a dictionary input shared by consecutive batches. The
+  /// results are dropped and not memoized for the rest of the batches with
+  /// the same base once they are larger. 0 means no limit.
+  static constexpr const char* kMaxDictionaryMemoBytes =
+      "max_dictionary_memo_bytes";
+
+  /// If true, a project that directly follows a project or a filter and a
+  /// project in a pipeline reads the subexpressions these compute from an
+  /// additional column of the first project instead of computing them again.
+  static constexpr const char* kPipelineSubExpressionForwardingEnabled =
+      "pipeline_sub_expression_forwarding_enabled";
+
   /// Maximum number of splits to preload. Set to 0 to disable preloading.
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
@@ -433,6 +731,21 @@ class QueryConfig {
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// The weight of the query in sharing the threads of a WorkStealingExecutor
+  /// with the other queries. The executor runs first the drivers of the
+  /// queries with the least cpu time divided by weight, so that a query with
+  /// twice the weight gets twice the cpu time of a competing query. Used with
+  /// 'kDriverCpuTimeSliceLimitMs' so that the drivers yield to the drivers of
+  /// the other queries. A weight of 0 is taken as 1.
+  static constexpr const char* kQueryCpuShareWeight = "query_cpu_share_weight";
+
+  /// If not zero, the time in microseconds a driver blocked on a connector or
+  /// an index lookup waits for it on the driver thread before going off
+  /// thread. A short read or lookup then continues on the same thread instead
+  /// of being enqueued on the executor again.
+  static constexpr const char* kDriverIoWaitOnThreadUs =
+      "driver_io_wait_on_thread_us";
+
   /// Maximum number of bytes to use for the normalized key in prefix-sort. Use
   /// 0 to disable prefix-sort.
   static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
@@ -465,6 +778,24 @@ class QueryConfig {
   static constexpr const char* kQueryTraceTaskRegExp =
       "query_trace_task_reg_exp";
 
+  /// If non-zero, the interval at which a task samples the memory
+  /// reservations of its memory pools into the task memory trace file in its
+  /// directory under 'kQueryTraceDir'. Only the tasks whose id matches
+  /// 'kQueryTraceTaskRegExp' are sampled if it is set. Independent of
+  /// 'kQueryTraceEnabled'.
+  static constexpr const char* kQueryTraceMemorySampleIntervalMs =
+      "query_trace_memory_sample_interval_ms";
+
+  /// If non-zero, the number of the latest timeline events of a task to keep
+  /// and write to the task timeline trace file in its directory under
+  /// 'kQueryTraceDir'. The events are the driver quanta, the blocking
+  /// intervals with their reasons, split arrivals, spill runs and cache loads
+  /// in Chrome trace format. Only the tasks whose id matches
+  /// 'kQueryTraceTaskRegExp' are traced if it is set. Independent of
+  /// 'kQueryTraceEnabled'.
+  static constexpr const char* kQueryTraceTimelineMaxEvents =
+      "query_trace_timeline_max_events";
+
   /// Config used to create operator trace directory. This config is provided to
   /// underlying file system and the config is free form. The form should be
   /// defined by the underlying file system.
@@ -545,6 +876,14 @@ class QueryConfig {
   static constexpr const char* kScaleWriterMinProcessedBytesRebalanceThreshold =
       "scaled_writer_min_processed_bytes_rebalance_threshold";
 
+  /// The max ratio of the time the table writers spend in sink write I/O to
+  /// the time they spend appending data to their sinks, above which the scale
+  /// writer exchange stops scaling writer processing. More writers do not help
+  /// when the storage is the bottleneck and only produce smaller files. The
+  /// value is in the range of [0, 1], and 1 disables the check.
+  static constexpr const char* kScaleWriterMaxSinkIoTimeRatio =
+      "scaled_writer_max_sink_io_time_ratio";
+
   /// If true, enables the scaled table scan processing. For each table scan
   /// plan node, a scan controller is used to control the number of running scan
   /// threads based on the query memory usage. It keeps increasing the number of
@@ -568,6 +907,49 @@ class QueryConfig {
   static constexpr const char* kShuffleCompressionKind =
       "shuffle_compression_codec";
 
+  /// If true and 'shuffle_compression_codec' is not none, PartitionedOutput
+  /// with the Presto serde compresses each column of a page on its own
+  /// instead of the whole page and writes the columns which do not compress
+  /// uncompressed. The pages can only be read by Velox.
+  static constexpr const char* kShuffleColumnCompression =
+      "shuffle_column_compression";
+
+  /// The compression kind for the variable width and complex type columns if
+  /// 'shuffle_column_compression' is true. Defaults to
+  /// 'shuffle_compression_codec'.
+  static constexpr const char* kShuffleStringCompressionKind =
+      "shuffle_string_compression_codec";
+
+  /// If true, PartitionedOutput with the Presto serde sends the rows of each
+  /// destination from an input vector as a page of its own which keeps the
+  /// dictionary and constant encodings of the input, and Exchange
+  /// deserializes each page into a vector of its own to keep the encodings on
+  /// the consumer. The pages are smaller than when accumulating rows over
+  /// input vectors, so this is best for large input vectors or few
+  /// destinations.
+  static constexpr const char* kShufflePreserveEncodings =
+      "shuffle_preserve_encodings";
+
+  /// If not zero, PartitionedOutput with at least this many destinations
+  /// groups the rows of each input vector by partition before serializing:
+  /// it counts the rows of each partition, computes the first row of each
+  /// partition and copies each column once into the partition order. Each
+  /// destination then serializes a contiguous range of rows instead of rows
+  /// scattered over the input, which keeps the serialization cache friendly
+  /// with many destinations at the cost of the copy.
+  static constexpr const char* kShuffleColumnarPartitionMinDestinations =
+      "shuffle_columnar_partition_min_destinations";
+
+  /// If true, PartitionedOutput over a partial aggregation merges the
+  /// intermediate results of the input rows with the same grouping keys in a
+  /// hash table of up to 'kMaxPartialAggregationMemory' bytes before
+  /// serializing them. This cuts the shuffled rows when the partial
+  /// aggregation flushes or abandons often, e.g. for skewed keys. The merging
+  /// is abandoned like a partial aggregation, see
+  /// 'kAbandonPartialAggregationMinPct'.
+  static constexpr const char* kShuffleCombinePartialAggregates =
+      "shuffle_combine_partial_aggregates";
+
   /// If a key is found in multiple given maps, by default that key's value in
   /// the resulting map comes from the last one of those maps. When true, throw
   /// exception on duplicate map key.
@@ -655,6 +1037,50 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t partialAggregationEvictionPct() const {
+    return get<int32_t>(kPartialAggregationEvictionPct, 0);
+  }
+
+  bool partialAggregationSortedInputDetectionEnabled() const {
+    return get<bool>(kPartialAggregationSortedInputDetectionEnabled, false);
+  }
+
+  uint32_t aggregationDenseAccumulatorsMaxGroups() const {
+    return get<uint32_t>(kAggregationDenseAccumulatorsMaxGroups, 0);
+  }
+
+  bool concurrentHashAggregationEnabled() const {
+    return get<bool>(kConcurrentHashAggregationEnabled, false);
+  }
+
+  bool aggregationSharedDistinctTableEnabled() const {
+    return get<bool>(kAggregationSharedDistinctTableEnabled, false);
+  }
+
+  bool aggregationGroupingSetsRollupEnabled() const {
+    return get<bool>(kAggregationGroupingSetsRollupEnabled, false);
+  }
+
+  bool orderByParallelSortEnabled() const {
+    return get<bool>(kOrderByParallelSortEnabled, false);
+  }
+
+  bool windowParallelEvaluationEnabled() const {
+    return get<bool>(kWindowParallelEvaluationEnabled, false);
+  }
+
+  bool nestedLoopJoinSortedBuildEnabled() const {
+    return get<bool>(kNestedLoopJoinSortedBuildEnabled, false);
+  }
+
+  bool nestedLoopJoinSpatialIndexEnabled() const {
+    return get<bool>(kNestedLoopJoinSpatialIndexEnabled, false);
+  }
+
+  int32_t topNLateMaterializationMaxBatches() const {
+    return get<int32_t>(kTopNLateMaterializationMaxBatches, 0);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -692,6 +1118,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  double localExchangeStringCompactionRatio() const {
+    return get<double>(kLocalExchangeStringCompactionRatio, 0.1);
+  }
+
   uint32_t maxLocalExchangePartitionCount() const {
     // defaults to unlimited
     static constexpr uint32_t kDefault = std::numeric_limits<uint32_t>::max();
@@ -724,6 +1154,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
   }
 
+  bool exchangeAdaptiveFlowControl() const {
+    return get<bool>(kExchangeAdaptiveFlowControl, false);
+  }
+
   uint64_t maxMergeExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 128UL << 20;
     return get<uint64_t>(kMaxMergeExchangeBufferSize, kDefault);
@@ -752,6 +1186,18 @@ class QueryConfig {
     return maxBatchRows;
   }
 
+  bool adaptiveOutputBatchRowsEnabled() const {
+    return get<bool>(kAdaptiveOutputBatchRowsEnabled, false);
+  }
+
+  vector_size_t adaptiveOutputBatchMinRows() const {
+    const uint32_t minBatchRows =
+        get<uint32_t>(kAdaptiveOutputBatchMinRows, 256);
+    VELOX_USER_CHECK_LE(
+        minBatchRows, std::numeric_limits<vector_size_t>::max());
+    return minBatchRows;
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
@@ -810,10 +1256,22 @@ class QueryConfig {
     return get<bool>(kAggregationSpillEnabled, true);
   }
 
+  int32_t aggregationSpillPartialPct() const {
+    return get<int32_t>(kAggregationSpillPartialPct, 0);
+  }
+
   bool joinSpillEnabled() const {
     return get<bool>(kJoinSpillEnabled, true);
   }
 
+  bool joinSpillCompactColumnsEnabled() const {
+    return get<bool>(kJoinSpillCompactColumnsEnabled, false);
+  }
+
+  bool hashJoinSortMergeFallbackEnabled() const {
+    return get<bool>(kHashJoinSortMergeFallbackEnabled, false);
+  }
+
   bool mixedGroupedModeHashJoinSpillEnabled() const {
     return get<bool>(kMixedGroupedModeHashJoinSpillEnabled, false);
   }
@@ -838,6 +1296,10 @@ class QueryConfig {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
 
+  bool outputBufferSpillEnabled() const {
+    return get<bool>(kOutputBufferSpillEnabled, false);
+  }
+
   int32_t maxSpillLevel() const {
     return get<int32_t>(kMaxSpillLevel, 1);
   }
@@ -867,6 +1329,14 @@ class QueryConfig {
     return get<std::string>(kSpillCompressionKind, "none");
   }
 
+  int32_t spillCompressionDictionaryPages() const {
+    return get<int32_t>(kSpillCompressionDictionaryPages, 0);
+  }
+
+  std::string spillRowContainerSerdeKind() const {
+    return get<std::string>(kSpillRowContainerSerdeKind, "Presto");
+  }
+
   bool spillPrefixSortEnabled() const {
     return get<bool>(kSpillPrefixSortEnabled, false);
   }
@@ -876,11 +1346,27 @@ class QueryConfig {
     return get<uint64_t>(kSpillWriteBufferSize, 1L << 20);
   }
 
+  bool spillAsyncWriteEnabled() const {
+    return get<bool>(kSpillAsyncWriteEnabled, false);
+  }
+
   uint64_t spillReadBufferSize() const {
     // The default read buffer size set to 1MB.
     return get<uint64_t>(kSpillReadBufferSize, 1L << 20);
   }
 
+  uint64_t spillMergeReadAheadBudget() const {
+    return get<uint64_t>(kSpillMergeReadAheadBudget, 0);
+  }
+
+  uint64_t spillMergeReadBufferBudget() const {
+    return get<uint64_t>(kSpillMergeReadBufferBudget, 0);
+  }
+
+  uint64_t spillLocalTierMaxBytes() const {
+    return get<uint64_t>(kSpillLocalTierMaxBytes, 0);
+  }
+
   std::string spillFileCreateConfig() const {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
@@ -895,6 +1381,10 @@ class QueryConfig {
     return get<int32_t>(kSpillableReservationGrowthPct, kDefaultPct);
   }
 
+  int32_t maxSpillableReservationGrowthPct() const {
+    return get<int32_t>(kMaxSpillableReservationGrowthPct, 0);
+  }
+
   bool queryTraceEnabled() const {
     return get<bool>(kQueryTraceEnabled, false);
   }
@@ -918,6 +1408,14 @@ class QueryConfig {
     return get<std::string>(kQueryTraceTaskRegExp, "");
   }
 
+  uint64_t queryTraceMemorySampleIntervalMs() const {
+    return get<uint64_t>(kQueryTraceMemorySampleIntervalMs, 0);
+  }
+
+  uint32_t queryTraceTimelineMaxEvents() const {
+    return get<uint32_t>(kQueryTraceTimelineMaxEvents, 0);
+  }
+
   std::string opTraceDirectoryCreateConfig() const {
     return get<std::string>(kOpTraceDirectoryCreateConfig, "");
   }
@@ -969,10 +1467,34 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprFusedArithmeticEnabled() const {
+    return get<bool>(kExprFusedArithmeticEnabled, false);
+  }
+
+  bool exprProfileEnabled() const {
+    return get<bool>(kExprProfileEnabled, false);
+  }
+
+  double exprSparseBranchMaxDensity() const {
+    return get<double>(kExprSparseBranchMaxDensity, 0);
+  }
+
+  bool exprJsonMultiPathExtractionEnabled() const {
+    return get<bool>(kExprJsonMultiPathExtractionEnabled, false);
+  }
+
+  bool exprJsonExtractCacheEnabled() const {
+    return get<bool>(kExprJsonExtractCacheEnabled, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  uint32_t operatorHardwareCounterSampleRate() const {
+    return get<uint32_t>(kOperatorHardwareCounterSampleRate, 0);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -990,6 +1512,26 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint64_t hashJoinRadixPartitionBytes() const {
+    return get<uint64_t>(kHashJoinRadixPartitionBytes, 0);
+  }
+
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
+  bool hashProbeLazyBuildColumnsEnabled() const {
+    return get<bool>(kHashProbeLazyBuildColumnsEnabled, false);
+  }
+
+  std::string sharedHashJoinNodeIds() const {
+    return get<std::string>(kSharedHashJoinNodeIds, "");
+  }
+
+  uint64_t sharedHashJoinMaxTableBytes() const {
+    return get<uint64_t>(kSharedHashJoinMaxTableBytes, 0);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -1014,6 +1556,14 @@ class QueryConfig {
     return get<uint32_t>(kMaxSharedSubexprResultsCached, 10);
   }
 
+  uint64_t maxDictionaryMemoBytes() const {
+    return get<uint64_t>(kMaxDictionaryMemoBytes, 0);
+  }
+
+  bool pipelineSubExpressionForwardingEnabled() const {
+    return get<bool>(kPipelineSubExpressionForwardingEnabled, false);
+  }
+
   int32_t maxSplitPreloadPerDriver() const {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
@@ -1022,6 +1572,14 @@ class QueryConfig {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  uint64_t driverIoWaitOnThreadUs() const {
+    return get<uint64_t>(kDriverIoWaitOnThreadUs, 0);
+  }
+
+  uint32_t queryCpuShareWeight() const {
+    return std::max<uint32_t>(1, get<uint32_t>(kQueryCpuShareWeight, 1));
+  }
+
   uint32_t prefixSortNormalizedKeyMaxBytes() const {
     return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
   }
@@ -1052,6 +1610,10 @@ class QueryConfig {
         kScaleWriterMinProcessedBytesRebalanceThreshold, 256 << 20);
   }
 
+  double scaleWriterMaxSinkIoTimeRatio() const {
+    return get<double>(kScaleWriterMaxSinkIoTimeRatio, 1.0);
+  }
+
   bool tableScanScaledProcessingEnabled() const {
     return get<bool>(kTableScanScaledProcessingEnabled, false);
   }
@@ -1064,10 +1626,31 @@ class QueryConfig {
     return get<uint32_t>(kIndexLookupJoinMaxPrefetchBatches, 0);
   }
 
+  uint32_t shuffleColumnarPartitionMinDestinations() const {
+    return get<uint32_t>(kShuffleColumnarPartitionMinDestinations, 0);
+  }
+
+  bool shuffleCombinePartialAggregates() const {
+    return get<bool>(kShuffleCombinePartialAggregates, false);
+  }
+
+  bool shufflePreserveEncodings() const {
+    return get<bool>(kShufflePreserveEncodings, false);
+  }
+
   std::string shuffleCompressionKind() const {
     return get<std::string>(kShuffleCompressionKind, "none");
   }
 
+  bool shuffleColumnCompression() const {
+    return get<bool>(kShuffleColumnCompression, false);
+  }
+
+  std::string shuffleStringCompressionKind() const {
+    return get<std::string>(
+        kShuffleStringCompressionKind, shuffleCompressionKind());
+  }
+
   int32_t requestDataSizesMaxWaitSec() const {
     return get<int32_t>(kRequestDataSizesMaxWaitSec, 10);
   }
@@ -20,6 +20,7 @@
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/memory/Scratch.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorPool.h"
@@ -126,6 +127,23 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   /// the max query trace bytes limit.
   void updateTracedBytesAndCheckLimit(uint64_t bytes);
 
+  /// Adds to the cpu time of the drivers of this query.
+  void addCpuTimeNanos(uint64_t nanos) {
+    cpuTimeNanos_ += nanos;
+  }
+
+  /// Returns the cpu time of the drivers of this query.
+  uint64_t cpuTimeNanos() const {
+    return cpuTimeNanos_;
+  }
+
+  /// Returns the cpu time of the drivers of this query divided by its
+  /// 'QueryConfig::kQueryCpuShareWeight'. The drivers of the queries with the
+  /// least weighted cpu time run first on a WorkStealingExecutor.
+  uint64_t weightedCpuTimeNanos() const {
+    return cpuTimeNanos_ / queryConfig_.queryCpuShareWeight();
+  }
+
   void testingOverrideMemoryPool(std::shared_ptr<memory::MemoryPool> pool) {
     pool_ = std::move(pool);
   }
@@ -222,6 +240,7 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   QueryConfig queryConfig_;
   std::atomic<uint64_t> numSpilledBytes_{0};
   std::atomic<uint64_t> numTracedBytes_{0};
+  std::atomic<uint64_t> cpuTimeNanos_{0};
 
   mutable std::mutex mutex_;
   // Indicates if this query is under memory arbitration or not.
@@ -259,6 +278,8 @@ class ExecCtx {
           !queryConfig.debugDisableExpressionsWithLazyInputs();
       maxSharedSubexprResultsCached =
           queryConfig.maxSharedSubexprResultsCached();
+      maxDictionaryMemoBytes = queryConfig.maxDictionaryMemoBytes();
+      exprProfileEnabled = queryConfig.exprProfileEnabled();
     }
 
     /// True if caches in expression evaluation used for performance are
@@ -281,6 +302,12 @@ class ExecCtx {
     /// The maximum number of distinct inputs to cache results in a
     /// given shared subexpression during experssion evaluation.
     uint32_t maxSharedSubexprResultsCached;
+    /// The maximum retained size of the results memoized for the base of a
+    /// dictionary input. 0 means no limit.
+    uint64_t maxDictionaryMemoBytes;
+    /// True if the time, allocations and rows of each expression are recorded
+    /// in its ExprStats.
+    bool exprProfileEnabled;
   };
 
   velox::memory::MemoryPool* pool() const {
@@ -390,6 +417,14 @@ class ExecCtx {
     return optimizationParams_;
   }
 
+  /// Returns the reusable scratch areas for the temporaries that do not
+  /// outlive the call that makes them, e.g. the intermediate results of an
+  /// expression, see ScratchPtr. The areas are kept for the next batch
+  /// instead of being allocated for each.
+  Scratch& scratch() {
+    return scratch_;
+  }
+
  private:
   // Pool for all Buffers for this thread.
   memory::MemoryPool* const pool_;
@@ -403,6 +438,7 @@ class ExecCtx {
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
   std::unique_ptr<VectorPool> vectorPool_;
+  Scratch scratch_;
 };
 
 } // namespace facebook::velox::core
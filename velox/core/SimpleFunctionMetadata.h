@@ -694,6 +694,7 @@ class UDFHolder {
   DECLARE_METHOD_RESOLVER(callNullable_method_resolver, callNullable);
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
 
   // Check which flavor of the call()/callNullable()/callNullFree() method is
@@ -713,6 +714,7 @@ class UDFHolder {
   // Optionally, UDFs can also provide the following methods:
   //
   // - bool|void callAscii(...)
+  // - void callBatch(out*, const in*..., size)
   // - void initialize(...)
 
   // call():
@@ -829,6 +831,17 @@ class UDFHolder {
         (udf_has_callAscii_return_void && udf_has_call_return_bool)),
       "The return type for callAscii() must match the return type for call().");
 
+  // callBatch(): computes call() for 'size' consecutive rows of inputs
+  // without nulls. Only used for fixed width primitive types and for functions
+  // that always return a value.
+  static constexpr bool udf_has_callBatch = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      void,
+      exec_return_type*,
+      const exec_arg_type<TArgs>*...,
+      vector_size_t>::value;
+
   // initialize():
   static constexpr bool udf_has_initialize = util::has_method<
       Fun,
@@ -883,6 +896,11 @@ class UDFHolder {
   static constexpr bool is_default_contains_nulls_behavior =
       !udf_has_call && !udf_has_callNullable;
   static constexpr bool has_ascii = udf_has_callAscii;
+
+  static_assert(
+      !udf_has_callBatch ||
+          (udf_has_call_return_void && !can_produce_null_output),
+      "callBatch() requires a call() method that returns void.");
   static constexpr bool is_default_ascii_behavior =
       udf_is_default_ascii_behavior<Fun>();
 
@@ -978,6 +996,18 @@ class UDFHolder {
     }
   }
 
+  FOLLY_ALWAYS_INLINE void callBatch(
+      exec_return_type* out,
+      const exec_arg_type<TArgs>*... args,
+      vector_size_t size) {
+    if constexpr (udf_has_callBatch) {
+      instance_.callBatch(out, args..., size);
+    } else {
+      VELOX_UNREACHABLE(
+          "callBatch should never be called if the UDF does not implement callBatch.");
+    }
+  }
+
   FOLLY_ALWAYS_INLINE Status callNullFree(
       exec_return_type& out,
       bool& notNull,
@@ -16,10 +16,199 @@
 
 #include "velox/dwio/common/BitPackDecoder.h"
 
+#include <array>
+#include <utility>
+
+#include "velox/common/process/ProcessBase.h"
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
 namespace facebook::velox::dwio::common {
 
 using int128_t = __int128_t;
 
+#ifdef __x86_64__
+
+// The AVX-512 kernels are compiled for AVX-512 regardless of the build target
+// and are only called if process::hasAvx512().
+#define VELOX_AVX512_TARGET __attribute__((target("avx512f,avx512bw")))
+
+namespace {
+
+template <typename T>
+struct Avx512Ops;
+
+template <>
+struct Avx512Ops<uint16_t> {
+  VELOX_AVX512_TARGET static __m512i permute(__m512i index, __m512i x) {
+    return _mm512_permutexvar_epi16(index, x);
+  }
+  VELOX_AVX512_TARGET static __m512i shiftRight(__m512i x, __m512i shift) {
+    return _mm512_srlv_epi16(x, shift);
+  }
+  VELOX_AVX512_TARGET static __m512i shiftLeft(__m512i x, __m512i shift) {
+    return _mm512_sllv_epi16(x, shift);
+  }
+};
+
+template <>
+struct Avx512Ops<uint32_t> {
+  VELOX_AVX512_TARGET static __m512i permute(__m512i index, __m512i x) {
+    return _mm512_permutexvar_epi32(index, x);
+  }
+  VELOX_AVX512_TARGET static __m512i shiftRight(__m512i x, __m512i shift) {
+    return _mm512_srlv_epi32(x, shift);
+  }
+  VELOX_AVX512_TARGET static __m512i shiftLeft(__m512i x, __m512i shift) {
+    return _mm512_sllv_epi32(x, shift);
+  }
+};
+
+template <>
+struct Avx512Ops<uint64_t> {
+  VELOX_AVX512_TARGET static __m512i permute(__m512i index, __m512i x) {
+    return _mm512_permutexvar_epi64(index, x);
+  }
+  VELOX_AVX512_TARGET static __m512i shiftRight(__m512i x, __m512i shift) {
+    return _mm512_srlv_epi64(x, shift);
+  }
+  VELOX_AVX512_TARGET static __m512i shiftLeft(__m512i x, __m512i shift) {
+    return _mm512_sllv_epi64(x, shift);
+  }
+};
+
+// The lanes and shifts that extract the 64 / sizeof(T) fields of kWidth bits
+// packed in a 64 byte register. Field i starts in lane 'low[i]' at bit
+// 'right[i]' and continues in lane 'high[i]', which is shifted left by
+// 'left[i]'. The variable shifts by the lane width or more give 0.
+template <typename T, uint8_t kWidth>
+struct UnpackPlan {
+  static constexpr int32_t kLanes = 64 / sizeof(T);
+  static constexpr int32_t kLaneBits = 8 * sizeof(T);
+
+  constexpr UnpackPlan() {
+    for (int32_t i = 0; i < kLanes; ++i) {
+      const int32_t bit = i * kWidth;
+      low[i] = bit / kLaneBits;
+      // The index past the last lane wraps to lane 0, whose bits land over
+      // the field width and are masked off.
+      high[i] = (bit / kLaneBits + 1) % kLanes;
+      right[i] = bit % kLaneBits;
+      left[i] = kLaneBits - bit % kLaneBits;
+      mask[i] = static_cast<T>(
+          static_cast<T>(~T(0)) >> (kLaneBits - kWidth));
+    }
+  }
+
+  T low[kLanes]{};
+  T high[kLanes]{};
+  T right[kLanes]{};
+  T left[kLanes]{};
+  T mask[kLanes]{};
+};
+
+// Unpacks the whole batches of 64 / sizeof(T) values in 'numValues', i.e.
+// kWidth times 4, 2 or 1 bytes per batch. The loads are masked to the bytes
+// of the batch so that nothing past the packed data is read. Returns the
+// number of unpacked values.
+template <typename T, uint8_t kWidth>
+VELOX_AVX512_TARGET uint64_t
+unpackAvx512Width(const uint8_t*& inputBits, uint64_t numValues, T*& result) {
+  using Ops = Avx512Ops<T>;
+  using Plan = UnpackPlan<T, kWidth>;
+  static constexpr Plan kPlan;
+  constexpr int32_t kBytes = Plan::kLanes * kWidth / 8;
+  constexpr __mmask64 kLoadMask = kBytes == 64 ? ~0ULL : (1ULL << kBytes) - 1;
+
+  const auto low = _mm512_loadu_si512(kPlan.low);
+  const auto high = _mm512_loadu_si512(kPlan.high);
+  const auto right = _mm512_loadu_si512(kPlan.right);
+  const auto left = _mm512_loadu_si512(kPlan.left);
+  const auto mask = _mm512_loadu_si512(kPlan.mask);
+  const uint64_t numBatches = numValues / Plan::kLanes;
+  for (uint64_t i = 0; i < numBatches; ++i) {
+    const auto packed = _mm512_maskz_loadu_epi8(kLoadMask, inputBits);
+    const auto lowBits = Ops::shiftRight(Ops::permute(low, packed), right);
+    const auto highBits = Ops::shiftLeft(Ops::permute(high, packed), left);
+    _mm512_storeu_si512(
+        result, _mm512_and_si512(_mm512_or_si512(lowBits, highBits), mask));
+    inputBits += kBytes;
+    result += Plan::kLanes;
+  }
+  return numBatches * Plan::kLanes;
+}
+
+#undef VELOX_AVX512_TARGET
+
+template <typename T>
+using UnpackKernel = uint64_t (*)(const uint8_t*&, uint64_t, T*&);
+
+template <typename T, size_t... kWidths>
+constexpr std::array<UnpackKernel<T>, sizeof...(kWidths)> makeKernels(
+    std::index_sequence<kWidths...>) {
+  return {&unpackAvx512Width<T, kWidths + 1>...};
+}
+
+template <typename T>
+uint64_t unpackAvx512Impl(
+    const uint8_t*& inputBits,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    T*& result) {
+  static constexpr auto kKernels =
+      makeKernels<T>(std::make_index_sequence<8 * sizeof(T)>());
+  VELOX_DCHECK(bitWidth >= 1 && bitWidth <= 8 * sizeof(T));
+  if (!process::hasAvx512()) {
+    return 0;
+  }
+  return kKernels[bitWidth - 1](inputBits, numValues, result);
+}
+
+} // namespace
+
+#else
+
+namespace {
+
+template <typename T>
+uint64_t unpackAvx512Impl(const uint8_t*&, uint64_t, uint8_t, T*&) {
+  return 0;
+}
+
+} // namespace
+
+#endif
+
+namespace detail {
+
+uint64_t unpackAvx512(
+    const uint8_t*& inputBits,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint16_t*& result) {
+  return unpackAvx512Impl(inputBits, numValues, bitWidth, result);
+}
+
+uint64_t unpackAvx512(
+    const uint8_t*& inputBits,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint32_t*& result) {
+  return unpackAvx512Impl(inputBits, numValues, bitWidth, result);
+}
+
+uint64_t unpackAvx512(
+    const uint8_t*& inputBits,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint64_t*& result) {
+  return unpackAvx512Impl(inputBits, numValues, bitWidth, result);
+}
+
+} // namespace detail
+
 #if XSIMD_WITH_AVX2
 
 typedef int32_t __m256si __attribute__((__vector_size__(32), __may_alias__));
@@ -150,6 +150,38 @@ inline void unpack<uint32_t>(
     uint8_t bitWidth,
     uint32_t* FOLLY_NONNULL& result);
 
+template <>
+inline void unpack<uint64_t>(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint64_t* FOLLY_NONNULL& result);
+
+namespace detail {
+/// Unpacks the leading values of 'numValues' values of 'bitWidth' bits with
+/// AVX-512 if the CPU has it. Unpacks whole batches of 64 bytes of results and
+/// advances 'inputBits' and 'result' past them. Returns the number of unpacked
+/// values, 0 if AVX-512 is not available.
+uint64_t unpackAvx512(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint16_t* FOLLY_NONNULL& result);
+
+uint64_t unpackAvx512(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint32_t* FOLLY_NONNULL& result);
+
+uint64_t unpackAvx512(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint64_t* FOLLY_NONNULL& result);
+} // namespace detail
+
 // The function definitions are put here to make sure they are inlined. Moving
 // them to the .cpp file may result in 10x regression.
 
@@ -163,7 +195,7 @@ static inline uint32_t unpackNaive(
   VELOX_CHECK(bitWidth >= 1 && bitWidth <= sizeof(T) * 8);
   VELOX_CHECK(inputBufferLen * 8 >= bitWidth * numValues);
 
-  auto mask = BITPACK_MASKS[bitWidth];
+  const T mask = ~0ULL >> (64 - bitWidth);
 
   uint64_t bitPosition = 0;
   for (uint32_t i = 0; i < numValues; i++) {
@@ -171,7 +203,8 @@ static inline uint32_t unpackNaive(
     bitPosition += bitWidth;
     while (bitPosition > 8) {
       inputBits++;
-      val |= (*inputBits << (8 - (bitPosition - bitWidth))) & mask;
+      val |= (static_cast<T>(*inputBits) << (8 - (bitPosition - bitWidth))) &
+          mask;
       bitPosition -= 8;
     }
     result[i] = val;
@@ -680,6 +713,10 @@ inline void unpack<uint16_t>(
   VELOX_CHECK(bitWidth >= 1 && bitWidth <= 16);
   VELOX_CHECK(inputBufferLen * 8 >= bitWidth * numValues);
 
+  if (bitWidth < 16) {
+    numValues -= detail::unpackAvx512(inputBits, numValues, bitWidth, result);
+  }
+
 #if XSIMD_WITH_AVX2
 
   switch (bitWidth) {
@@ -729,6 +766,10 @@ inline void unpack<uint32_t>(
   VELOX_CHECK(bitWidth >= 1 && bitWidth <= 32);
   VELOX_CHECK(inputBufferLen * 8 >= bitWidth * numValues);
 
+  if (bitWidth < 32) {
+    numValues -= detail::unpackAvx512(inputBits, numValues, bitWidth, result);
+  }
+
 #if XSIMD_WITH_AVX2
 
   switch (bitWidth) {
@@ -789,6 +830,23 @@ inline void unpack<uint32_t>(
 #endif
 }
 
+template <>
+inline void unpack<uint64_t>(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint64_t* FOLLY_NONNULL& result) {
+  VELOX_CHECK(bitWidth >= 1 && bitWidth <= 64);
+  VELOX_CHECK(inputBufferLen * 8 >= bitWidth * numValues);
+
+  const auto numUnpacked =
+      detail::unpackAvx512(inputBits, numValues, bitWidth, result);
+  numValues -= numUnpacked;
+  inputBufferLen -= numUnpacked * bitWidth / 8;
+  unpackNaive<uint64_t>(inputBits, inputBufferLen, numValues, bitWidth, result);
+}
+
 // Loads a bit field from 'ptr' + bitOffset for up to 'bitWidth' bits. makes
 // sure not to access bytes past lastSafeWord + 7. The definition is put here
 // because it's inlined.
@@ -22,6 +22,7 @@
 #include "velox/dwio/common/BufferedInput.h"
 
 DEFINE_bool(wsVRLoad, false, "Use WS VRead API to load");
+DECLARE_bool(velox_adaptive_io_coalesce);
 
 using ::facebook::velox::common::Region;
 
@@ -87,6 +88,8 @@ void BufferedInput::readToBuffer(
     MicrosecondTimer timer(&usec);
     input_->read(allocated.data(), allocated.size(), offset, logType);
   }
+  StorageReadModel::forPath(input_->getName())
+      .recordRead(allocated.size(), usec);
   if (auto* stats = input_->getStats()) {
     stats->read().increment(allocated.size());
     stats->queryThreadIoLatency().increment(usec);
@@ -174,11 +177,12 @@ void BufferedInput::mergeRegions() {
   std::vector<size_t> te(e.size());
   te[e[0]] = 0;
 
+  const auto maxMergeDistance = mergeDistance();
   size_t ia = 0;
   VELOX_CHECK_GT(r[ia].length, 0, "invalid region");
   for (size_t ib = 1; ib < r.size(); ++ib) {
     VELOX_CHECK_GT(r[ib].length, 0, "invalid region");
-    if (!tryMerge(r[ia], r[ib])) {
+    if (!tryMerge(r[ia], r[ib], maxMergeDistance)) {
       r[++ia] = r[ib];
     }
     te[e[ib]] = ia;
@@ -188,7 +192,19 @@ void BufferedInput::mergeRegions() {
   std::swap(e, te);
 }
 
-bool BufferedInput::tryMerge(Region& first, const Region& second) {
+uint64_t BufferedInput::mergeDistance() const {
+  if (!FLAGS_velox_adaptive_io_coalesce) {
+    return maxMergeDistance_;
+  }
+  return StorageReadModel::forPath(input_->getName())
+      .coalesceDistance()
+      .value_or(maxMergeDistance_);
+}
+
+bool BufferedInput::tryMerge(
+    Region& first,
+    const Region& second,
+    uint64_t maxMergeDistance) {
   VELOX_CHECK_GE(second.offset, first.offset, "regions should be sorted.");
   const int64_t gap = second.offset - first.offset - first.length;
 
@@ -200,7 +216,7 @@ bool BufferedInput::tryMerge(Region& first, const Region& second) {
   }
 
   // compare with 0 since it's comparison in different types
-  if (gap < 0 || gap <= maxMergeDistance_) {
+  if (gap < 0 || gap <= maxMergeDistance) {
     // the second region is inside first one if extension is negative
     if (extension > 0) {
       first.length += extension;
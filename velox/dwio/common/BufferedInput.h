@@ -19,6 +19,7 @@
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/memory/AllocationPool.h"
 #include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/common/StorageReadModel.h"
 #include "velox/dwio/common/StreamIdentifier.h"
 
 // Use WS VRead API to load
@@ -250,10 +251,15 @@ class BufferedInput {
   void sortRegions();
   void mergeRegions();
 
+  // Returns the distance under which regions are merged: 'maxMergeDistance_'
+  // or the one measured for the file system of 'input_'.
+  uint64_t mergeDistance() const;
+
   // tries and merges WS read regions into one
   bool tryMerge(
       velox::common::Region& first,
-      const velox::common::Region& second);
+      const velox::common::Region& second,
+      uint64_t maxMergeDistance);
 
   uint64_t maxMergeDistance_;
   std::optional<bool> wsVRLoad_;
@@ -245,6 +245,9 @@ void CacheInputStream::loadSync(const Region& region) {
     if (loadFromSsd(region, *entry)) {
       return;
     }
+    if (loadFromPeer(region, *entry)) {
+      return;
+    }
     const auto ranges = makeRanges(entry, region.length);
     uint64_t storageReadUs{0};
     {
@@ -324,6 +327,28 @@ bool CacheInputStream::loadFromSsd(
   return true;
 }
 
+bool CacheInputStream::loadFromPeer(
+    const Region& region,
+    cache::AsyncDataCacheEntry& entry) {
+  auto* peerCache = cache_->peerCache();
+  if (peerCache == nullptr) {
+    return false;
+  }
+  uint64_t peerReadUs{0};
+  bool found;
+  {
+    MicrosecondTimer timer(&peerReadUs);
+    found = peerCache->read(fileIds().string(fileNum_), entry);
+  }
+  ioStats_->queryThreadIoLatency().increment(peerReadUs);
+  if (!found) {
+    return false;
+  }
+  ioStats_->peerRead().increment(region.length);
+  entry.setExclusiveToShared(!noCacheRetention_);
+  return true;
+}
+
 std::string CacheInputStream::ssdFileName() const {
   auto ssdCache = cache_->ssdCache();
   if (!ssdCache) {
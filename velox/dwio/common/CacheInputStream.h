@@ -119,6 +119,11 @@ class CacheInputStream : public SeekableInputStream {
       const velox::common::Region& region,
       cache::AsyncDataCacheEntry& entry);
 
+  // Returns true if there is a peer cache and it filled 'entry'.
+  bool loadFromPeer(
+      const velox::common::Region& region,
+      cache::AsyncDataCacheEntry& entry);
+
   // Invoked to clear the cache pin of the accessed cache entry and mark it as
   // immediate evictable if 'noCacheRetention_' flag is set.
   void clearCachePin();
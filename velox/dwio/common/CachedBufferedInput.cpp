@@ -15,7 +15,9 @@
  */
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/common/caching/FileIds.h"
 #include "velox/common/memory/Allocation.h"
+#include "velox/common/process/TimelineTrace.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
@@ -292,6 +294,29 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
       size_ += request->size;
       requests_.push_back(std::move(*request));
     }
+    // The load may run on another thread, e.g. a prefetch on the executor.
+    if (const auto* track = process::TimelineTrack::current()) {
+      timelineTrack_ = *track;
+    }
+  }
+
+  std::vector<CachePin> loadData(bool prefetch) override {
+    if (!timelineTrack_.has_value()) {
+      return loadPins(prefetch);
+    }
+    const auto startUs = process::TimelineTrace::nowUs();
+    auto pins = loadPins(prefetch);
+    process::TimelineEvent event;
+    event.name = prefetch ? "prefetch" : "load";
+    event.category = process::TimelineEvent::kIoCategory;
+    event.pid = timelineTrack_->pid;
+    event.tid = timelineTrack_->tid;
+    event.startUs = startUs;
+    event.durationUs = process::TimelineTrace::nowUs() - startUs;
+    event.valueName = "bytes";
+    event.value = size_;
+    timelineTrack_->trace->record(event);
+    return pins;
   }
 
   const std::vector<CacheRequest>& requests() {
@@ -319,6 +344,9 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
   }
 
  protected:
+  // Loads the entries of 'requests_' and returns their pins.
+  virtual std::vector<CachePin> loadPins(bool prefetch) = 0;
+
   void updateStats(const CoalesceIoStats& stats, bool prefetch, bool ssd) {
     if (ioStats_ == nullptr) {
       return;
@@ -359,6 +387,8 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
   std::shared_ptr<filesystems::File::IoStats> fsStats_;
   const uint64_t groupId_;
   int64_t size_{0};
+  // The timeline track of the driver that planned the load if it has one.
+  std::optional<process::TimelineTrack> timelineTrack_;
 };
 
 // Represents a CoalescedLoad from ReadFile, e.g. disagg disk.
@@ -381,7 +411,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
         input_(std::move(input)),
         maxCoalesceDistance_(maxCoalesceDistance) {}
 
-  std::vector<CachePin> loadData(bool prefetch) override {
+  std::vector<CachePin> loadPins(bool prefetch) override {
     std::vector<CachePin> pins;
     pins.reserve(keys_.size());
     cache_.makePins(
@@ -396,6 +426,28 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     if (pins.empty()) {
       return pins;
     }
+    std::vector<CachePin> peerPins;
+    if (auto* peerCache = cache_.peerCache()) {
+      // The entries a peer has are not read from storage.
+      const auto fileName = fileIds().string(keys_[0].fileNum);
+      std::vector<CachePin> misses;
+      int64_t peerBytes = 0;
+      for (auto& pin : pins) {
+        if (peerCache->read(fileName, *pin.checkedEntry())) {
+          peerBytes += pin.entry()->size();
+          peerPins.push_back(std::move(pin));
+        } else {
+          misses.push_back(std::move(pin));
+        }
+      }
+      pins = std::move(misses);
+      if (ioStats_ != nullptr && !peerPins.empty()) {
+        ioStats_->peerRead().increment(peerBytes);
+      }
+      if (pins.empty()) {
+        return peerPins;
+      }
+    }
     auto stats = cache::readPins(
         pins,
         maxCoalesceDistance_,
@@ -409,6 +461,9 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
           input_->read(buffers, offset, LogType::FILE);
         });
     updateStats(stats, prefetch, false);
+    for (auto& pin : peerPins) {
+      pins.push_back(std::move(pin));
+    }
     return pins;
   }
 
@@ -432,7 +487,7 @@ class SsdLoad : public DwioCoalescedLoadBase {
             groupId,
             std::move(requests)) {}
 
-  std::vector<CachePin> loadData(bool prefetch) override {
+  std::vector<CachePin> loadPins(bool prefetch) override {
     std::vector<SsdPin> ssdPins;
     std::vector<CachePin> pins;
     cache_.makePins(
@@ -556,6 +556,37 @@ ColumnVisitor<T, TFilter, ExtractValues, isDense, hasBulkPath>::addOutputRow(
 
 enum FilterResult { kUnknown = 0x40, kSuccess = 0x80, kFailure = 0 };
 
+// Sets 'filterCache' to the result of 'filter' on each of the 'numValues'
+// 'values'. The fixed width values of the types that have a SIMD filter are
+// tested a vector at a time.
+template <typename T, typename TFilter>
+void filterDictionaryValues(
+    TFilter& filter,
+    const T* values,
+    int32_t numValues,
+    uint8_t* filterCache) {
+  int32_t i = 0;
+  if constexpr (
+      std::is_same_v<T, int16_t> || std::is_same_v<T, int32_t> ||
+      std::is_same_v<T, int64_t> || std::is_same_v<T, float> ||
+      std::is_same_v<T, double>) {
+    constexpr int32_t kWidth = xsimd::batch<T>::size;
+    for (; i + kWidth <= numValues; i += kWidth) {
+      const auto passed = simd::toBitMask(
+          filter.testValues(xsimd::load_unaligned(values + i)));
+      for (auto lane = 0; lane < kWidth; ++lane) {
+        filterCache[i + lane] = (passed >> lane) & 1 ? FilterResult::kSuccess
+                                                     : FilterResult::kFailure;
+      }
+    }
+  }
+  for (; i < numValues; ++i) {
+    filterCache[i] = velox::common::applyFilter(filter, values[i])
+        ? FilterResult::kSuccess
+        : FilterResult::kFailure;
+  }
+}
+
 namespace detail {
 
 template <typename T, typename A>
@@ -756,6 +787,24 @@ class DictionaryColumnVisitor
                                                                          : 2),
         state_(reader->scanState().rawState) {}
 
+  // Evaluates the filter on the whole dictionary if it is small next to
+  // the rows to visit, so that the rows only gather the cached results by
+  // index instead of testing the values not seen before one by one.
+  void filterDictionary() {
+    if constexpr (hasFilter() && TFilter::deterministic) {
+      auto& scanState = super::reader().scanState();
+      if (scanState.filterCacheComplete ||
+          static_cast<int64_t>(dictionarySize()) *
+                  DictionaryValues::kMinRowsPerValueToFilter >
+              super::numRows_) {
+        return;
+      }
+      filterDictionaryValues(
+          super::filter_, dict(), dictionarySize(), filterCache());
+      scanState.filterCacheComplete = true;
+    }
+  }
+
   FOLLY_ALWAYS_INLINE bool isInDict() {
     if (inDict()) {
       return bits::isBitSet(inDict(), super::currentRow());
@@ -1160,6 +1209,7 @@ ColumnVisitor<T, TFilter, ExtractValues, isDense, hasBulkPath>::
   auto result = DictionaryColumnVisitor<T, TFilter, ExtractValues, isDense>(
       filter_, reader_, RowSet(rows_ + rowIndex_, numRows_), values_);
   result.numValuesBias_ = numValuesBias_;
+  result.filterDictionary();
   return result;
 }
 
@@ -1180,6 +1230,7 @@ ColumnVisitor<T, TFilter, ExtractValues, isDense, hasBulkPath>::
   auto result = StringDictionaryColumnVisitor<TFilter, ExtractValues, isDense>(
       filter_, reader_, RowSet(rows_ + rowIndex_, numRows_), values_);
   result.setNumValuesBias(numValuesBias_);
+  result.filterDictionary();
   return result;
 }
 
@@ -1202,6 +1253,32 @@ class StringDictionaryColumnVisitor
             rows,
             values) {}
 
+  // Like DictionaryColumnVisitor::filterDictionary() over the stripe and
+  // stride dictionaries. Tests only the values with no cached result, e.g.
+  // the values of a new stride dictionary.
+  void filterDictionary() {
+    if constexpr (DictSuper::hasFilter() && TFilter::deterministic) {
+      auto& scanState = super::reader().scanState();
+      const int64_t numValues = DictSuper::dictionarySize() +
+          DictSuper::state_.dictionary2.numValues;
+      if (scanState.filterCacheComplete ||
+          numValues * DictionaryValues::kMinRowsPerValueToFilter >
+              super::numRows_) {
+        return;
+      }
+      auto* filterCache = DictSuper::filterCache();
+      for (auto i = 0; i < numValues; ++i) {
+        if (filterCache[i] == FilterResult::kUnknown) {
+          filterCache[i] =
+              velox::common::applyFilter(super::filter_, valueInDictionary(i))
+              ? FilterResult::kSuccess
+              : FilterResult::kFailure;
+        }
+      }
+      scanState.filterCacheComplete = true;
+    }
+  }
+
   FOLLY_ALWAYS_INLINE vector_size_t process(int32_t value, bool& atEnd) {
     bool inStrideDict = !DictSuper::isInDict();
     auto index = value;
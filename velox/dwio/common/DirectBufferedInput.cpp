@@ -19,8 +19,10 @@
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/DirectInputStream.h"
+#include "velox/dwio/common/StorageReadModel.h"
 
 DECLARE_int32(cache_prefetch_min_pct);
+DECLARE_bool(velox_adaptive_io_coalesce);
 
 using ::facebook::velox::common::Region;
 using facebook::velox::common::testutil::TestValue;
@@ -131,13 +133,20 @@ std::vector<int32_t> DirectBufferedInput::groupRequests(
     // eligible to prefetch. This will be loaded by itself on first use.
     return {};
   }
-  const int32_t maxDistance = options_.maxCoalesceDistance();
+  int32_t maxDistance = options_.maxCoalesceDistance();
   const auto loadQuantum = options_.loadQuantum();
   // If reading densely accessed, coalesce into large for best throughput, if
   // for sparse, coalesce to quantum to reduce overread. Not all sparse access
   // is correlated.
-  const auto maxCoalesceBytes =
-      prefetch ? options_.maxCoalesceBytes() : loadQuantum;
+  auto maxCoalesceBytes = prefetch ? options_.maxCoalesceBytes() : loadQuantum;
+  if (FLAGS_velox_adaptive_io_coalesce) {
+    // Reads the gaps that cost less than a separate read on this file system
+    // and splits the coalesced reads that are long enough to be bound by
+    // throughput, so that the pieces load in parallel.
+    const auto& model = StorageReadModel::forPath(input_->getName());
+    maxDistance = model.coalesceDistance(maxDistance);
+    maxCoalesceBytes = model.maxCoalesceBytes(loadQuantum, maxCoalesceBytes);
+  }
 
   // Combine adjacent short reads.
   int64_t coalescedBytes = 0;
@@ -321,6 +330,8 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
     input_->read(buffers, requests_[0].region.offset, LogType::FILE);
   }
 
+  StorageReadModel::forPath(input_->getName())
+      .recordRead(size + overread, usecs);
   ioStats_->read().increment(size + overread);
   ioStats_->incRawBytesRead(size);
   ioStats_->incTotalScanTime(usecs * 1'000);
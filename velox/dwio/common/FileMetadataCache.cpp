@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <folly/hash/Hash.h>
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+FileMetadataCache** instancePtr() {
+  static FileMetadataCache* instance{nullptr};
+  return &instance;
+}
+} // namespace
+
+size_t FileMetadataCache::KeyHasher::operator()(const Key& key) const {
+  return folly::hash::hash_combine(
+      static_cast<int32_t>(key.format),
+      key.fileName,
+      key.fileSize,
+      key.modificationTime);
+}
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return *instancePtr();
+}
+
+// static
+void FileMetadataCache::setInstance(FileMetadataCache* cache) {
+  *instancePtr() = cache;
+}
+
+std::shared_ptr<void> FileMetadataCache::getInternal(const Key& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* metadata = cache_.get(key);
+  if (metadata == nullptr) {
+    return nullptr;
+  }
+  auto result = *metadata;
+  cache_.release(key);
+  return result;
+}
+
+void FileMetadataCache::put(
+    const Key& key,
+    std::shared_ptr<void> metadata,
+    uint64_t bytes) {
+  auto value = std::make_unique<std::shared_ptr<void>>(std::move(metadata));
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, value.get(), bytes)) {
+    // The cache owns the value now.
+    value.release();
+  }
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto cacheStats = cache_.stats();
+  return Stats{
+      cacheStats.numLookups,
+      cacheStats.numHits,
+      cacheStats.numElements,
+      cacheStats.curSize};
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.free(cache_.maxSize());
+}
+
+} // namespace facebook::velox::dwio::common
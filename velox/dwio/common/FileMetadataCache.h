@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/dwio/common/Options.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Process-wide cache of the decoded footers of files, so that the readers of
+/// a file that was read before do not read and parse its metadata again. The
+/// entries are keyed by the file name, size and modification time, so that a
+/// rewritten file does not get the metadata of its previous version. The
+/// cached metadata is shared by the readers and must not be modified. Thread
+/// safe.
+class FileMetadataCache {
+ public:
+  struct Key {
+    FileFormat format;
+    std::string fileName;
+    uint64_t fileSize;
+    int64_t modificationTime;
+
+    bool operator==(const Key& other) const {
+      return format == other.format && fileSize == other.fileSize &&
+          modificationTime == other.modificationTime &&
+          fileName == other.fileName;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Stats {
+    uint64_t numLookups{0};
+    uint64_t numHits{0};
+    uint64_t numEntries{0};
+    uint64_t bytes{0};
+  };
+
+  /// 'maxBytes' is the capacity in estimated bytes of decoded metadata.
+  explicit FileMetadataCache(uint64_t maxBytes) : cache_(maxBytes) {}
+
+  /// Returns the process-wide instance or nullptr if metadata is not cached.
+  static FileMetadataCache* getInstance();
+
+  /// Sets the process-wide instance. The caller owns 'cache' which must
+  /// outlive its use by the readers.
+  static void setInstance(FileMetadataCache* cache);
+
+  /// Returns the metadata of the file of 'key' or nullptr if not cached.
+  template <typename T>
+  std::shared_ptr<T> get(const Key& key) {
+    return std::static_pointer_cast<T>(getInternal(key));
+  }
+
+  /// Adds the decoded 'metadata' of the file of 'key' that takes about
+  /// 'bytes' of memory. Evicts the least recently used entries to make room.
+  /// Does nothing if the file is cached already.
+  void put(const Key& key, std::shared_ptr<void> metadata, uint64_t bytes);
+
+  Stats stats() const;
+
+  void clear();
+
+ private:
+  std::shared_ptr<void> getInternal(const Key& key);
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<Key, std::shared_ptr<void>, std::equal_to<Key>, KeyHasher>
+      cache_;
+};
+
+} // namespace facebook::velox::dwio::common
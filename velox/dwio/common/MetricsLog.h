@@ -127,6 +127,20 @@ class MetricsLog {
 
   virtual void logFileClose(const FileCloseMetrics& /* metrics */) const {}
 
+  struct UnitLoadMetrics {
+    uint32_t numUnits;
+    // The units queued to load ahead of their use.
+    uint32_t numPrefetchedUnits;
+    // The prefetched units that were loaded by the time they were used.
+    uint32_t numPrefetchHits;
+    // The prefetched units dropped unused, e.g. because of a seek.
+    uint32_t numCancelledPrefetches;
+    // The time the reader waited for units to load.
+    uint64_t stallTimeUs;
+  };
+
+  virtual void logUnitLoad(const UnitLoadMetrics& /* metrics */) const {}
+
   static std::shared_ptr<const MetricsLog> voidLog() {
     static std::shared_ptr<const MetricsLog> log{new MetricsLog("")};
     return log;
@@ -126,6 +126,10 @@ class FormatSpecificOptions {
 /// Options for creating a RowReader.
 class RowReaderOptions {
  public:
+  /// The default for setParallelDecodeMinCells(), e.g. 100 columns of a 10K
+  /// row batch.
+  static constexpr uint64_t kDefaultParallelDecodeMinCells = 1'000'000;
+
   RowReaderOptions() noexcept
       : dataStart_(0),
         dataLength_(std::numeric_limits<uint64_t>::max()),
@@ -287,6 +291,13 @@ class RowReaderOptions {
     decodingParallelismFactor_ = factor;
   }
 
+  /// Sets the minimum number of values, i.e. rows times columns, of a batch
+  /// for the selective readers to decode the non-filter columns in parallel
+  /// on the decoding executor.
+  void setParallelDecodeMinCells(uint64_t cells) {
+    parallelDecodeMinCells_ = cells;
+  }
+
   void setRowNumberColumnInfo(
       std::optional<RowNumberColumnInfo> rowNumberColumnInfo) {
     rowNumberColumnInfo_ = std::move(rowNumberColumnInfo);
@@ -365,6 +376,10 @@ class RowReaderOptions {
     return decodingParallelismFactor_;
   }
 
+  uint64_t parallelDecodeMinCells() const {
+    return parallelDecodeMinCells_;
+  }
+
   TimestampPrecision timestampPrecision() const {
     return timestampPrecision_;
   }
@@ -411,6 +426,7 @@ class RowReaderOptions {
   // operations.
   std::shared_ptr<folly::Executor> decodingExecutor_;
   size_t decodingParallelismFactor_{0};
+  uint64_t parallelDecodeMinCells_{kDefaultParallelDecodeMinCells};
   std::optional<RowNumberColumnInfo> rowNumberColumnInfo_{std::nullopt};
   // Parameters that are provided as the physical storage properties.
   std::unordered_map<std::string, std::string> storageParameters_ = {};
@@ -499,6 +515,15 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the modification time of the file. The decoded metadata of the
+  /// files with a known modification time is kept in the FileMetadataCache if
+  /// there is one.
+  ReaderOptions& setFileModificationTime(
+      std::optional<int64_t> modificationTime) {
+    fileModificationTime_ = modificationTime;
+    return *this;
+  }
+
   ReaderOptions& setFileColumnNamesReadAsLowerCase(bool flag) {
     fileColumnNamesReadAsLowerCase_ = flag;
     return *this;
@@ -559,6 +584,10 @@ class ReaderOptions : public io::ReaderOptions {
     return filePreloadThreshold_;
   }
 
+  const std::optional<int64_t>& fileModificationTime() const {
+    return fileModificationTime_;
+  }
+
   const std::shared_ptr<folly::Executor>& ioExecutor() const {
     return ioExecutor_;
   }
@@ -627,6 +656,7 @@ class ReaderOptions : public io::ReaderOptions {
   std::shared_ptr<encryption::DecrypterFactory> decrypterFactory_;
   uint64_t footerEstimatedSize_{kDefaultFooterEstimatedSize};
   uint64_t filePreloadThreshold_{kDefaultFilePreloadThreshold};
+  std::optional<int64_t> fileModificationTime_;
   bool fileColumnNamesReadAsLowerCase_{false};
   bool useColumnNamesForColumnMapping_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/PrefetchUnitLoader.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <optional>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/MeasureTime.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+enum class UnitState { kUnloaded, kQueued, kLoading, kLoaded };
+
+// The state shared with the loads on the executor. A queued load may run
+// after the loader is gone and then finds its unit no longer queued.
+struct SharedState {
+  std::mutex mutex;
+  std::condition_variable loadDone;
+  std::vector<std::unique_ptr<LoadUnit>> units;
+  std::vector<UnitState> states;
+  // The error of the load of each kLoaded unit, if any.
+  std::vector<std::exception_ptr> errors;
+  // True for the units dropped while loading. These are unloaded when the
+  // load finishes.
+  std::vector<bool> dropped;
+};
+
+void finishLoadLocked(
+    SharedState& state,
+    uint32_t unit,
+    std::exception_ptr error) {
+  if (state.dropped[unit]) {
+    state.dropped[unit] = false;
+    if (error == nullptr) {
+      state.units[unit]->unload();
+    }
+    state.states[unit] = UnitState::kUnloaded;
+  } else {
+    state.errors[unit] = std::move(error);
+    state.states[unit] = UnitState::kLoaded;
+  }
+  state.loadDone.notify_all();
+}
+
+// Loads 'unit' of 'state' unless it was dropped or taken over by the reader
+// since it was queued.
+void runLoad(SharedState& state, uint32_t unit) {
+  std::unique_lock<std::mutex> l(state.mutex);
+  if (state.states[unit] != UnitState::kQueued) {
+    return;
+  }
+  state.states[unit] = UnitState::kLoading;
+  l.unlock();
+  std::exception_ptr error;
+  try {
+    state.units[unit]->load();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  l.lock();
+  finishLoadLocked(state, unit, std::move(error));
+}
+
+class PrefetchUnitLoader : public UnitLoader {
+ public:
+  PrefetchUnitLoader(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      folly::Executor* executor,
+      const PrefetchUnitLoaderFactory::Options& options,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback,
+      MetricsLogPtr metricsLog)
+      : executor_{executor},
+        options_{options},
+        metricsLog_{std::move(metricsLog)},
+        state_{std::make_shared<SharedState>()},
+        numUnits_(loadUnits.size()),
+        prefetched_(numUnits_, false),
+        prefetchBytes_(numUnits_, 0),
+        stallCallback_{[this, callback = std::move(blockedOnIoCallback)](
+                           std::chrono::high_resolution_clock::duration
+                               duration) {
+          metrics_.stallTimeUs +=
+              std::chrono::duration_cast<std::chrono::microseconds>(duration)
+                  .count();
+          if (callback) {
+            callback(duration);
+          }
+        }} {
+    state_->units = std::move(loadUnits);
+    state_->states.resize(numUnits_, UnitState::kUnloaded);
+    state_->errors.resize(numUnits_);
+    state_->dropped.resize(numUnits_, false);
+    metrics_.numUnits = numUnits_;
+  }
+
+  ~PrefetchUnitLoader() override {
+    std::vector<std::unique_ptr<LoadUnit>> units;
+    {
+      std::unique_lock<std::mutex> l(state_->mutex);
+      for (auto& state : state_->states) {
+        if (state == UnitState::kQueued) {
+          state = UnitState::kUnloaded;
+        }
+      }
+      state_->loadDone.wait(l, [&]() {
+        return std::none_of(
+            state_->states.begin(), state_->states.end(), [](auto state) {
+              return state == UnitState::kLoading;
+            });
+      });
+      // The units may reference the reader, which goes away with 'this'.
+      units = std::move(state_->units);
+    }
+    metricsLog_->logUnitLoad(metrics_);
+  }
+
+  LoadUnit& getLoadedUnit(uint32_t unit) override {
+    VELOX_CHECK_LT(unit, numUnits_, "Unit out of range");
+    std::unique_lock<std::mutex> l(state_->mutex);
+    for (uint32_t i = 0; i < numUnits_; ++i) {
+      if (i != unit && !isAhead(unit, i)) {
+        dropLocked(i);
+      }
+    }
+
+    auto& unitState = state_->states[unit];
+    if (unitState == UnitState::kLoaded && prefetched_[unit]) {
+      ++metrics_.numPrefetchHits;
+    }
+    prefetched_[unit] = false;
+    if (unitState != UnitState::kLoaded) {
+      MeasureTime measure(stallCallback_);
+      // Keeps a load that a seek dropped.
+      state_->dropped[unit] = false;
+      if (unitState == UnitState::kLoading) {
+        state_->loadDone.wait(
+            l, [&]() { return unitState != UnitState::kLoading; });
+      } else {
+        // Loads the units that are not queued or whose load has not started
+        // on the calling thread.
+        unitState = UnitState::kLoading;
+        l.unlock();
+        std::exception_ptr error;
+        try {
+          state_->units[unit]->load();
+        } catch (...) {
+          error = std::current_exception();
+        }
+        l.lock();
+        finishLoadLocked(*state_, unit, std::move(error));
+      }
+    }
+    VELOX_CHECK(unitState == UnitState::kLoaded);
+    if (auto error = std::move(state_->errors[unit])) {
+      unitState = UnitState::kUnloaded;
+      std::rethrow_exception(error);
+    }
+    l.unlock();
+
+    if (options_.prefetchRowFraction == 0) {
+      prefetch(unit);
+    }
+    return *state_->units[unit];
+  }
+
+  void onRead(uint32_t unit, uint64_t rowOffsetInUnit, uint64_t rowCount)
+      override {
+    VELOX_CHECK_LT(unit, numUnits_, "Unit out of range");
+    const auto numRows = state_->units[unit]->getNumRows();
+    VELOX_CHECK_LT(rowOffsetInUnit, numRows, "Row out of range");
+    if (rowOffsetInUnit + rowCount >= options_.prefetchRowFraction * numRows) {
+      prefetch(unit);
+    }
+  }
+
+  void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) override {
+    VELOX_CHECK_LT(unit, numUnits_, "Unit out of range");
+    VELOX_CHECK_LE(
+        rowOffsetInUnit,
+        state_->units[unit]->getNumRows(),
+        "Row out of range");
+    prefetchedFor_.reset();
+    std::lock_guard<std::mutex> l(state_->mutex);
+    for (uint32_t i = 0; i < numUnits_; ++i) {
+      if (prefetched_[i] && i != unit && !isAhead(unit, i)) {
+        dropLocked(i);
+      }
+    }
+  }
+
+ private:
+  // Returns true if 'unit' is one of the units loaded ahead of 'current'.
+  bool isAhead(uint32_t current, uint32_t unit) const {
+    return unit > current && unit - current <= options_.numPrefetchUnits;
+  }
+
+  // Unloads 'unit' or makes sure it gets unloaded if it is loading.
+  void dropLocked(uint32_t unit) {
+    if (prefetched_[unit]) {
+      prefetched_[unit] = false;
+      ++metrics_.numCancelledPrefetches;
+    }
+    auto& unitState = state_->states[unit];
+    switch (unitState) {
+      case UnitState::kUnloaded:
+        break;
+      case UnitState::kQueued:
+        unitState = UnitState::kUnloaded;
+        break;
+      case UnitState::kLoading:
+        state_->dropped[unit] = true;
+        break;
+      case UnitState::kLoaded:
+        if (state_->errors[unit] == nullptr) {
+          state_->units[unit]->unload();
+        }
+        state_->errors[unit] = nullptr;
+        unitState = UnitState::kUnloaded;
+        break;
+    }
+  }
+
+  // Queues the loads of the units after 'unit' that fit in
+  // 'maxPrefetchBytes'.
+  void prefetch(uint32_t unit) {
+    if (prefetchedFor_ == unit) {
+      return;
+    }
+    prefetchedFor_ = unit;
+    uint64_t bytes = 0;
+    for (auto next = unit + 1; next < numUnits_ && isAhead(unit, next);
+         ++next) {
+      {
+        std::lock_guard<std::mutex> l(state_->mutex);
+        if (state_->states[next] != UnitState::kUnloaded) {
+          bytes += prefetchBytes_[next];
+          continue;
+        }
+      }
+      // No load of 'next' is running, so its size can be read without the
+      // lock.
+      const auto ioSize = state_->units[next]->getIoSize();
+      if (bytes + ioSize > options_.maxPrefetchBytes) {
+        break;
+      }
+      bytes += ioSize;
+      {
+        std::lock_guard<std::mutex> l(state_->mutex);
+        state_->states[next] = UnitState::kQueued;
+        prefetched_[next] = true;
+        prefetchBytes_[next] = ioSize;
+        ++metrics_.numPrefetchedUnits;
+      }
+      executor_->add([state = state_, next]() { runLoad(*state, next); });
+    }
+  }
+
+  folly::Executor* const executor_;
+  const PrefetchUnitLoaderFactory::Options options_;
+  const MetricsLogPtr metricsLog_;
+  const std::shared_ptr<SharedState> state_;
+  const uint32_t numUnits_;
+
+  // True for the units queued by prefetch() that have not been used yet.
+  std::vector<bool> prefetched_;
+  // The IO size of each unit when queued by prefetch().
+  std::vector<uint64_t> prefetchBytes_;
+  // The unit for which prefetch() last ran, reset on seek.
+  std::optional<uint32_t> prefetchedFor_;
+
+  MetricsLog::UnitLoadMetrics metrics_{};
+  const std::function<void(std::chrono::high_resolution_clock::duration)>
+      stallCallback_;
+};
+
+} // namespace
+
+PrefetchUnitLoaderFactory::PrefetchUnitLoaderFactory(
+    folly::Executor* executor,
+    Options options,
+    std::function<void(std::chrono::high_resolution_clock::duration)>
+        blockedOnIoCallback,
+    MetricsLogPtr metricsLog)
+    : executor_{executor},
+      options_{options},
+      blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+      metricsLog_{std::move(metricsLog)} {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GE(options_.prefetchRowFraction, 0);
+  VELOX_CHECK_LE(options_.prefetchRowFraction, 1);
+}
+
+std::unique_ptr<UnitLoader> PrefetchUnitLoaderFactory::create(
+    std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+    uint64_t rowsToSkip) {
+  const auto totalRows = std::accumulate(
+      loadUnits.cbegin(), loadUnits.cend(), 0UL, [](uint64_t sum, auto& unit) {
+        return sum + unit->getNumRows();
+      });
+  VELOX_CHECK_LE(
+      rowsToSkip,
+      totalRows,
+      "Can only skip up to the past-the-end row of the file.");
+  return std::make_unique<PrefetchUnitLoader>(
+      std::move(loadUnits),
+      executor_,
+      options_,
+      blockedOnIoCallback_,
+      metricsLog_);
+}
+
+} // namespace facebook::velox::dwio::common
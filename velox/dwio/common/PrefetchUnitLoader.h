@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include <folly/Executor.h>
+
+#include "velox/dwio/common/MetricsLog.h"
+#include "velox/dwio/common/UnitLoader.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Makes UnitLoaders that load the next units on an executor while the
+/// current unit is read, so that the reader does not stall on IO at each
+/// unit boundary. The loads of the next units start when the reads of the
+/// current unit pass a fraction of its rows. The units loaded ahead are
+/// bounded in number and in IO size and are dropped on seeks. LoadUnit::load()
+/// of a unit must be safe to run while the previous unit is read.
+class PrefetchUnitLoaderFactory : public UnitLoaderFactory {
+ public:
+  struct Options {
+    /// The number of units after the current one that are loaded ahead.
+    uint32_t numPrefetchUnits{1};
+
+    /// The fraction of the rows of the current unit after which the next
+    /// units are loaded. 0 loads them as soon as the current unit is loaded.
+    double prefetchRowFraction{0.5};
+
+    /// The maximum IO size of the units loaded ahead of the current one.
+    uint64_t maxPrefetchBytes{256UL << 20};
+  };
+
+  PrefetchUnitLoaderFactory(
+      folly::Executor* executor,
+      Options options,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback,
+      MetricsLogPtr metricsLog = MetricsLog::voidLog());
+
+  ~PrefetchUnitLoaderFactory() override = default;
+
+  std::unique_ptr<UnitLoader> create(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      uint64_t rowsToSkip) override;
+
+ private:
+  folly::Executor* const executor_;
+  const Options options_;
+  const std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  const MetricsLogPtr metricsLog_;
+};
+
+} // namespace facebook::velox::dwio::common
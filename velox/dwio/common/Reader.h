@@ -100,6 +100,14 @@ class RowReader {
    */
   virtual std::optional<size_t> estimatedRowSize() const = 0;
 
+  /// Returns the number of rows in the range of the reader according to the
+  /// file metadata, or std::nullopt if not known. With no filters, next()
+  /// returns this many rows in total, so that a scan without columns can
+  /// produce its rows without reading the data.
+  virtual std::optional<uint64_t> rowCountFromMetadata() const {
+    return std::nullopt;
+  }
+
   // Returns true if the expected IO for 'this' is scheduled. If this
   // is true it makes sense to prefetch the next split.
   virtual bool allPrefetchIssued() const {
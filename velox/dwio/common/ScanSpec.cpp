@@ -191,12 +191,13 @@ void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
       continue;
     }
     auto* otherChild = it->second;
+    // The filter of 'other' includes the filters added after 'this' was
+    // made, e.g. dynamic filters, also on the columns that are constant in
+    // either, e.g. partition keys.
+    child->filter_ = std::move(otherChild->filter_);
     if (!child->isConstant() && !otherChild->isConstant()) {
-      // If other child is constant, a possible filter on a
-      // constant will have been evaluated at split start time. If
-      // 'child' is constant there is no adaptation that can be
-      // received.
-      child->filter_ = std::move(otherChild->filter_);
+      // A filter on a constant is evaluated at split start time and has no
+      // selectivity to adapt from.
       child->selectivity_ = otherChild->selectivity_;
     }
   }
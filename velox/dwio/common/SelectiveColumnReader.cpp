@@ -195,6 +195,58 @@ void SelectiveColumnReader::setComplexNulls(
   }
 }
 
+namespace {
+// Sets the min and max of 'result' to the bounds of 'filter' if this is a
+// range that all the non-null values of 'result' passed. Operators downstream
+// of the scan use these to decide their filters for the whole batch.
+template <typename T>
+void setFilterBounds(const velox::common::Filter* filter, BaseVector& result) {
+  if (filter == nullptr ||
+      filter->kind() != velox::common::FilterKind::kBigintRange) {
+    return;
+  }
+  auto* flat = result.asFlatVector<T>();
+  if (flat == nullptr) {
+    return;
+  }
+  const auto* range = static_cast<const velox::common::BigintRange*>(filter);
+  const auto lower = std::max<int64_t>(
+      range->lower(), std::numeric_limits<T>::min());
+  const auto upper = std::min<int64_t>(
+      range->upper(), std::numeric_limits<T>::max());
+  if (lower > upper) {
+    return;
+  }
+  flat->setStats(SimpleVectorStats<T>{
+      static_cast<T>(lower), static_cast<T>(upper)});
+}
+} // namespace
+
+void SelectiveColumnReader::setIntFilterBounds(
+    const TypePtr& requestedType,
+    VectorPtr& result) const {
+  if (isFlatMapValue_ || result == nullptr) {
+    return;
+  }
+  const auto* filter = scanSpec_->filter();
+  switch (requestedType->kind()) {
+    case TypeKind::TINYINT:
+      setFilterBounds<int8_t>(filter, *result);
+      break;
+    case TypeKind::SMALLINT:
+      setFilterBounds<int16_t>(filter, *result);
+      break;
+    case TypeKind::INTEGER:
+      setFilterBounds<int32_t>(filter, *result);
+      break;
+    case TypeKind::BIGINT:
+      setFilterBounds<int64_t>(filter, *result);
+      break;
+    default:
+      break;
+  }
+}
+
 void SelectiveColumnReader::getIntValues(
     const RowSet& rows,
     const TypePtr& requestedType,
@@ -264,6 +316,7 @@ void SelectiveColumnReader::getIntValues(
       VELOX_FAIL(
           "Not a valid type for integer reader: {}", requestedType->toString());
   }
+  setIntFilterBounds(requestedType, *result);
 }
 
 void SelectiveColumnReader::getUnsignedIntValues(
@@ -459,6 +512,7 @@ void SelectiveColumnReader::resetFilterCaches() {
         FilterResult::kUnknown,
         scanState_.filterCache.size());
   }
+  scanState_.filterCacheComplete = false;
 }
 
 void SelectiveColumnReader::addParentNulls(
@@ -43,13 +43,24 @@ struct DictionaryValues {
   /// True if values are in ascending order.
   bool sorted{false};
 
+  /// True if all the string values are ASCII. The readers set this when
+  /// loading a string dictionary, so that the vectors over the dictionary
+  /// carry the ASCII flag and the string functions need not scan the values.
+  bool isAscii{false};
+
   void clear() {
     values = nullptr;
     strings = nullptr;
     numValues = 0;
     sorted = false;
+    isAscii = false;
   }
 
+  /// The filter is evaluated on all the dictionary values before the rows
+  /// when there are at least this many rows to visit per dictionary value.
+  /// The rows then only look up the results by index.
+  static constexpr int32_t kMinRowsPerValueToFilter = 4;
+
   /// Whether the dictionary values have filter on it.
   static bool hasFilter(const velox::common::Filter* filter) {
     // Dictionary values cannot be null.  It's by design not possible in ORC and
@@ -124,6 +135,10 @@ struct ScanState {
   // in mid scan.
   raw_vector<uint8_t> filterCache;
 
+  // True if 'filterCache' has the result of every dictionary value. Must be
+  // reset together with 'filterCache'.
+  bool filterCacheComplete{false};
+
   // The above as raw pointers.
   RawScanState rawState;
 };
@@ -544,6 +559,11 @@ class SelectiveColumnReader {
       const TypePtr& requestedType,
       VectorPtr* result);
 
+  /// Sets the min and max of the integer values in 'result' to the range of
+  /// the filter of the column, which all the non-null values passed.
+  void setIntFilterBounds(const TypePtr& requestedType, VectorPtr& result)
+      const;
+
   /// Returns integer values for 'rows' cast to the width of 'requestedType' in
   /// '*result', the related fileDataType is unsigned int type.
   void getUnsignedIntValues(
@@ -18,6 +18,7 @@
 
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/ColumnLoader.h"
+#include "velox/dwio/common/ParallelFor.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -323,6 +324,8 @@ void SelectiveStructColumnReaderBase::read(
     const RowSet& rows,
     const uint64_t* incomingNulls) {
   numReads_ = scanSpec_->newRead();
+  parallelChildren_.clear();
+  parallelDecoded_ = false;
   prepareRead<char>(offset, rows, incomingNulls);
   RowSet activeRows = rows;
   if (hasDeletion_) {
@@ -386,7 +389,10 @@ void SelectiveStructColumnReaderBase::read(
     auto* reader = children_.at(fieldIndex);
     if (reader->isTopLevel() && childSpec->projectOut() &&
         !childSpec->hasFilter()) {
-      // Will make a LazyVector.
+      if (decodingExecutor_ != nullptr) {
+        parallelChildren_.push_back(reader);
+      }
+      // Will make a LazyVector unless decoded in parallel below.
       continue;
     }
 
@@ -412,6 +418,22 @@ void SelectiveStructColumnReaderBase::read(
     }
   }
 
+  // The children are independent once the filters have run, so each is
+  // decoded whole by one thread.
+  if (!activeRows.empty() && parallelChildren_.size() > 1 &&
+      parallelChildren_.size() * activeRows.size() >=
+          parallelDecodeMinCells_) {
+    for (auto* reader : parallelChildren_) {
+      advanceFieldReader(reader, offset);
+    }
+    ParallelFor(
+        decodingExecutor_, 0, parallelChildren_.size(), decodingParallelism_)
+        .execute([&](size_t i) {
+          parallelChildren_[i]->read(offset, activeRows, structNulls);
+        });
+    parallelDecoded_ = true;
+  }
+
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
   recordParentNullsInChildren(offset, rows);
@@ -543,7 +565,8 @@ void SelectiveStructColumnReaderBase::getValues(
       continue;
     }
 
-    if (childSpec->hasFilter() || !children_[index]->isTopLevel()) {
+    if (childSpec->hasFilter() || !children_[index]->isTopLevel() ||
+        parallelDecoded_) {
       children_[index]->getValues(rows, &childResult);
       continue;
     }
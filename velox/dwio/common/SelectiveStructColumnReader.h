@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 
 namespace facebook::velox::dwio::common {
@@ -102,6 +104,21 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     currentRowNumber_ = value;
   }
 
+  /// Decodes the top level non-filter children with up to 'parallelism'
+  /// threads of 'executor' once the filter children have produced the rows
+  /// of a batch, instead of loading them as LazyVectors. This is only done
+  /// when the batch decodes at least 'minCells' values, i.e. rows times
+  /// children, so that narrow scans do not pay for the hand-off. A null
+  /// 'executor' or 'parallelism' under 2 disables this.
+  void setParallelDecoding(
+      folly::Executor* executor,
+      size_t parallelism,
+      uint64_t minCells) {
+    decodingExecutor_ = parallelism > 1 ? executor : nullptr;
+    decodingParallelism_ = parallelism;
+    parallelDecodeMinCells_ = minCells;
+  }
+
  protected:
   template <typename T, typename KeyNode, typename FormatData>
   friend class SelectiveFlatMapColumnReaderHelper;
@@ -180,6 +197,19 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // After read() call mutation_ could go out of scope.  Need to keep this
   // around for lazy columns.
   bool hasDeletion_ = false;
+
+  // See setParallelDecoding().
+  folly::Executor* decodingExecutor_{nullptr};
+  size_t decodingParallelism_{0};
+  uint64_t parallelDecodeMinCells_{0};
+
+  // The top level non-filter children of the last read() that may be decoded
+  // in parallel.
+  std::vector<SelectiveColumnReader*> parallelChildren_;
+
+  // True if the last read() decoded 'parallelChildren_', so that getValues()
+  // returns their values instead of LazyVectors.
+  bool parallelDecoded_{false};
 };
 
 class SelectiveStructColumnReader : public SelectiveStructColumnReaderBase {
@@ -225,6 +255,11 @@ class SelectiveFlatMapColumnReaderHelper {
     if (auto type = reader_.requestedType_->childAt(1); type->isRow()) {
       childValues_ = BaseVector::create(type, 0, reader_.memoryPool_);
     }
+    if (auto* valuesSpec = reader_.scanSpec_->childByName(
+            velox::common::ScanSpec::kMapValuesFieldName);
+        valuesSpec && valuesSpec->isConstant()) {
+      constantValues_ = valuesSpec->constantValue();
+    }
   }
 
   void read(int64_t offset, RowSet rows, const uint64_t* incomingNulls);
@@ -263,6 +298,10 @@ class SelectiveFlatMapColumnReaderHelper {
       const uint64_t* columnBits,
       vector_size_t size);
 
+  // Returns the key of each of 'keyNodes_'. Copies the string keys that are
+  // not inline into a buffer of 'flatKeys'.
+  std::vector<T> makeKeys(FlatVector<T>* flatKeys);
+
   template <TypeKind kKind>
   void copyValues(
       RowSet rows,
@@ -270,6 +309,10 @@ class SelectiveFlatMapColumnReaderHelper {
       vector_size_t* rawOffsets,
       BaseVector& values);
 
+  // Sets the keys of the map entries when the values are constant.
+  void
+  copyKeys(RowSet rows, FlatVector<T>* flatKeys, vector_size_t* rawOffsets);
+
   SelectiveStructColumnReaderBase& reader_;
   std::vector<KeyNode> keyNodes_;
   VectorPtr childValues_;
@@ -277,6 +320,9 @@ class SelectiveFlatMapColumnReaderHelper {
   std::vector<uint64_t> columnRowBits_;
   int columnBitsWords_;
   std::vector<BaseVector::CopyRange> copyRanges_;
+  // The value of all map entries if the values are not read, e.g. when only
+  // the keys or the sizes of the maps are used.
+  VectorPtr constantValues_;
 };
 
 template <typename T, typename KeyNode, typename FormatData>
@@ -415,6 +461,54 @@ SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::calculateOffsets(
   return numNestedRows;
 }
 
+template <typename T, typename KeyNode, typename FormatData>
+std::vector<T>
+SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::makeKeys(
+    FlatVector<T>* flatKeys) {
+  std::vector<T> keys;
+  keys.reserve(keyNodes_.size());
+  for (auto& keyNode : keyNodes_) {
+    keys.push_back(keyNode.key.get());
+  }
+  if constexpr (std::is_same_v<T, StringView>) {
+    size_t bufferSize = 0;
+    for (auto& key : keys) {
+      if (!key.isInline()) {
+        bufferSize += key.size();
+      }
+    }
+    if (bufferSize > 0) {
+      auto buffer =
+          AlignedBuffer::allocate<char>(bufferSize, reader_.memoryPool_);
+      auto* rawBuffer = buffer->template asMutable<char>();
+      flatKeys->addStringBuffer(buffer);
+      for (auto& key : keys) {
+        if (!key.isInline()) {
+          memcpy(rawBuffer, key.data(), key.size());
+          key = StringView(rawBuffer, key.size());
+          rawBuffer += key.size();
+        }
+      }
+    }
+  }
+  return keys;
+}
+
+template <typename T, typename KeyNode, typename FormatData>
+void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::copyKeys(
+    RowSet rows,
+    FlatVector<T>* flatKeys,
+    vector_size_t* rawOffsets) {
+  T* rawKeys = flatKeys->mutableRawValues();
+  const auto keys = makeKeys(flatKeys);
+  for (int k = 0; k < reader_.children_.size(); ++k) {
+    auto* columnBits = columnRowBits_.data() + k * columnBitsWords_;
+    bits::forEachSetBit(columnBits, 0, rows.size(), [&](vector_size_t i) {
+      rawKeys[rawOffsets[i]++] = keys[k];
+    });
+  }
+}
+
 // When `kDirectCopy' is true, copy the values directly into the target vector.
 // Otherwise store the copy ranges and they will be copied after calling this
 // function.
@@ -466,30 +560,7 @@ void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::copyValues(
       TypeKind::TINYINT <= kKind && kKind <= TypeKind::DOUBLE;
   using ValueType = typename TypeTraits<kKind>::NativeType;
   T* rawKeys = flatKeys->mutableRawValues();
-  [[maybe_unused]] size_t strKeySize;
-  [[maybe_unused]] char* rawStrKeyBuffer;
-  if constexpr (std::is_same_v<T, StringView>) {
-    strKeySize = 0;
-    for (int k = 0; k < reader_.children_.size(); ++k) {
-      if (!keyNodes_[k].key.get().isInline()) {
-        strKeySize += keyNodes_[k].key.get().size();
-      }
-    }
-    if (strKeySize > 0) {
-      auto buf = AlignedBuffer::allocate<char>(strKeySize, reader_.memoryPool_);
-      rawStrKeyBuffer = buf->template asMutable<char>();
-      flatKeys->addStringBuffer(buf);
-      strKeySize = 0;
-      for (int k = 0; k < reader_.children_.size(); ++k) {
-        auto& s = keyNodes_[k].key.get();
-        if (!s.isInline()) {
-          memcpy(&rawStrKeyBuffer[strKeySize], s.data(), s.size());
-          strKeySize += s.size();
-        }
-      }
-      strKeySize = 0;
-    }
-  }
+  const auto keys = makeKeys(flatKeys);
   detail::FlatMapDirectCopyHelper<ValueType> directCopy;
   if constexpr (kDirectCopy) {
     VELOX_CHECK(values.isFlatEncoding());
@@ -499,16 +570,7 @@ void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::copyValues(
     bits::fillBits(directCopy.targetNulls, 0, flat->size(), bits::kNotNull);
   }
   for (int k = 0; k < reader_.children_.size(); ++k) {
-    T key;
-    if constexpr (std::is_same_v<T, StringView>) {
-      key = keyNodes_[k].key.get();
-      if (!key.isInline()) {
-        key = {&rawStrKeyBuffer[strKeySize], static_cast<int32_t>(key.size())};
-        strKeySize += key.size();
-      }
-    } else {
-      key = keyNodes_[k].key.get();
-    }
+    const T key = keys[k];
     reader_.children_[k]->getValues(rows, &childValues_);
     if constexpr (kDirectCopy) {
       decodedChildValues_.decode(*childValues_);
@@ -553,10 +615,15 @@ void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::getValues(
   auto& keys = mapResult.mapKeys();
   auto& values = mapResult.mapValues();
   BaseVector::prepareForReuse(keys, numNestedRows);
-  BaseVector::prepareForReuse(values, numNestedRows);
   auto* flatKeys = keys->template asFlatVector<T>();
-  VELOX_DYNAMIC_TYPE_DISPATCH(
-      copyValues, values->typeKind(), rows, flatKeys, rawOffsets, *values);
+  if (constantValues_) {
+    copyKeys(rows, flatKeys, rawOffsets);
+    values = BaseVector::wrapInConstant(numNestedRows, 0, constantValues_);
+  } else {
+    BaseVector::prepareForReuse(values, numNestedRows);
+    VELOX_DYNAMIC_TYPE_DISPATCH(
+        copyValues, values->typeKind(), rows, flatKeys, rawOffsets, *values);
+  }
   VELOX_CHECK_EQ(rawOffsets[rows.size() - 1], numNestedRows);
   std::copy_backward(
       rawOffsets, rawOffsets + rows.size() - 1, rawOffsets + rows.size());
@@ -22,8 +22,10 @@ SortingWriter::SortingWriter(
     std::unique_ptr<exec::SortBuffer> sortBuffer,
     vector_size_t maxOutputRowsConfig,
     uint64_t maxOutputBytesConfig,
-    uint64_t outputTimeSliceLimitMs)
+    uint64_t outputTimeSliceLimitMs,
+    RowTypePtr outputType)
     : outputWriter_(std::move(writer)),
+      outputType_(std::move(outputType)),
       maxOutputRowsConfig_(maxOutputRowsConfig),
       maxOutputBytesConfig_(maxOutputBytesConfig),
       finishTimeSliceLimitMs_(outputTimeSliceLimitMs),
@@ -77,7 +79,7 @@ bool SortingWriter::finish() {
     }
     output = sortBuffer_->getOutput(maxOutputBatchRows);
     if (output != nullptr) {
-      outputWriter_->write(output);
+      outputWriter_->write(dropSortKeys(output));
     }
   } while (output != nullptr);
 
@@ -101,6 +103,21 @@ void SortingWriter::abort() {
   outputWriter_->abort();
 }
 
+RowVectorPtr SortingWriter::dropSortKeys(const RowVectorPtr& output) const {
+  if (outputType_ == nullptr) {
+    return output;
+  }
+  std::vector<VectorPtr> children(
+      output->children().begin(),
+      output->children().begin() + outputType_->size());
+  return std::make_shared<RowVector>(
+      output->pool(),
+      outputType_,
+      output->nulls(),
+      output->size(),
+      std::move(children));
+}
+
 bool SortingWriter::canReclaim() const {
   return canReclaim_;
 }
@@ -25,12 +25,15 @@ namespace facebook::velox::dwio::common {
 /// Sorting Writer object is used to write sorted data into a single file.
 class SortingWriter : public Writer {
  public:
+  /// If 'outputType' is set, the data has sort key columns added by the caller
+  /// after the columns of 'outputType'. These are dropped after sorting.
   SortingWriter(
       std::unique_ptr<Writer> writer,
       std::unique_ptr<exec::SortBuffer> sortBuffer,
       vector_size_t maxOutputRowsConfig,
       uint64_t maxOutputBytesConfig,
-      uint64_t outputTimeSliceLimitMs);
+      uint64_t outputTimeSliceLimitMs,
+      RowTypePtr outputType = nullptr);
 
   ~SortingWriter() override;
 
@@ -78,7 +81,11 @@ class SortingWriter : public Writer {
 
   vector_size_t outputBatchRows();
 
+  // Drops the sort key columns added by the caller from sorted 'output'.
+  RowVectorPtr dropSortKeys(const RowVectorPtr& output) const;
+
   const std::unique_ptr<Writer> outputWriter_;
+  const RowTypePtr outputType_;
   const vector_size_t maxOutputRowsConfig_;
   const uint64_t maxOutputBytesConfig_;
   const uint64_t finishTimeSliceLimitMs_;
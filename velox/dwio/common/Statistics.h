@@ -536,6 +536,10 @@ struct ColumnReaderStatistics {
   // Number of rows returned by string dictionary reader that is flattened
   // instead of keeping dictionary encoding.
   int64_t flattenStringDictionaryValues{0};
+
+  // Number of dictionary pages that had the same bytes as the previous
+  // dictionary page of their column and reused its decoded values.
+  int64_t reusedDictionaryPages{0};
 };
 
 struct RuntimeStatistics {
@@ -554,6 +558,10 @@ struct RuntimeStatistics {
   // Number of strides (row groups) processed based on statistics.
   int64_t processedStrides{0};
 
+  // Number of rows skipped within strides (row groups) based on the
+  // statistics of their pages.
+  int64_t skippedPageRows{0};
+
   int64_t footerBufferOverread{0};
 
   int64_t numStripes{0};
@@ -579,6 +587,9 @@ struct RuntimeStatistics {
     if (processedStrides > 0) {
       result.emplace("processedStrides", RuntimeCounter(processedStrides));
     }
+    if (skippedPageRows > 0) {
+      result.emplace("skippedPageRows", RuntimeCounter(skippedPageRows));
+    }
     if (footerBufferOverread > 0) {
       result.emplace(
           "footerBufferOverread",
@@ -592,6 +603,11 @@ struct RuntimeStatistics {
           "flattenStringDictionaryValues",
           RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues));
     }
+    if (columnReaderStatistics.reusedDictionaryPages > 0) {
+      result.emplace(
+          "reusedDictionaryPages",
+          RuntimeCounter(columnReaderStatistics.reusedDictionaryPages));
+    }
     return result;
   }
 };
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/StorageReadModel.h"
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+namespace facebook::velox::dwio::common {
+
+void StorageReadModel::recordRead(uint64_t bytes, uint64_t micros) {
+  const double x = bytes;
+  const double y = micros;
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numReads_;
+  sumWeights_ = sumWeights_ * kDecay + 1;
+  sumBytes_ = sumBytes_ * kDecay + x;
+  sumMicros_ = sumMicros_ * kDecay + y;
+  sumBytesSquared_ = sumBytesSquared_ * kDecay + x * x;
+  sumBytesMicros_ = sumBytesMicros_ * kDecay + x * y;
+}
+
+std::optional<std::pair<double, double>> StorageReadModel::estimate() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numReads_ < kMinReads) {
+    return std::nullopt;
+  }
+  const double meanBytes = sumBytes_ / sumWeights_;
+  const double meanMicros = sumMicros_ / sumWeights_;
+  const double varianceBytes =
+      sumBytesSquared_ / sumWeights_ - meanBytes * meanBytes;
+  // Reads of about the same size do not separate the latency from the
+  // transfer time.
+  if (varianceBytes <= 1e-3 * meanBytes * meanBytes) {
+    return std::nullopt;
+  }
+  const double microsPerByte =
+      (sumBytesMicros_ / sumWeights_ - meanBytes * meanMicros) / varianceBytes;
+  const double latency = meanMicros - microsPerByte * meanBytes;
+  if (microsPerByte <= 0 || latency <= 0) {
+    return std::nullopt;
+  }
+  return std::make_pair(latency, 1 / microsPerByte);
+}
+
+std::optional<int32_t> StorageReadModel::coalesceDistance() const {
+  const auto latencyAndThroughput = estimate();
+  if (!latencyAndThroughput.has_value()) {
+    return std::nullopt;
+  }
+  const auto [latency, throughput] = latencyAndThroughput.value();
+  return std::clamp<double>(
+      latency * throughput, kMinCoalesceDistance, kMaxCoalesceDistance);
+}
+
+int64_t StorageReadModel::maxCoalesceBytes(int64_t minBytes, int64_t maxBytes)
+    const {
+  const auto distance = coalesceDistance();
+  if (!distance.has_value() || minBytes >= maxBytes) {
+    return maxBytes;
+  }
+  return std::clamp<int64_t>(
+      static_cast<int64_t>(distance.value()) * kParallelReadFactor,
+      minBytes,
+      maxBytes);
+}
+
+// static
+std::string StorageReadModel::fileSystemKey(std::string_view path) {
+  const auto pos = path.find("://");
+  if (pos == std::string_view::npos) {
+    return "file";
+  }
+  return std::string(path.substr(0, pos));
+}
+
+// static
+StorageReadModel& StorageReadModel::forPath(std::string_view path) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::unique_ptr<StorageReadModel>>
+      models;
+  auto key = fileSystemKey(path);
+  std::lock_guard<std::mutex> l(mutex);
+  auto& model = models[key];
+  if (model == nullptr) {
+    model = std::make_unique<StorageReadModel>();
+  }
+  return *model;
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace facebook::velox::dwio::common {
+
+/// Estimates the per read latency and the throughput of a kind of storage
+/// from the reads done on it so far. The time of a read is modeled as
+/// latency + bytes / throughput, fitted by least squares over the recent
+/// reads. Reading a gap between two ranges costs less than a separate read
+/// when the gap is under latency * throughput bytes, which is large on
+/// object stores and small on local disks. There is one model per file
+/// system, shared by all the readers of the process.
+class StorageReadModel {
+ public:
+  /// The bounds of the coalesce distance chosen from the measurements.
+  static constexpr int32_t kMinCoalesceDistance = 4 << 10;
+  static constexpr int32_t kMaxCoalesceDistance = 16 << 20;
+
+  /// Coalesced reads of more than this many times the coalesce distance
+  /// spend almost all their time transferring data and are better issued
+  /// as separate loads that run in parallel.
+  static constexpr int32_t kParallelReadFactor = 16;
+
+  /// The number of reads after which the model gives estimates.
+  static constexpr int32_t kMinReads = 16;
+
+  /// Records a read of 'bytes' that took 'micros'.
+  void recordRead(uint64_t bytes, uint64_t micros);
+
+  /// Returns the gap in bytes under which two ranges are better read
+  /// together, or std::nullopt if the reads so far do not give an estimate.
+  std::optional<int32_t> coalesceDistance() const;
+
+  /// Returns 'defaultDistance' until the model has an estimate and the
+  /// estimate afterwards.
+  int32_t coalesceDistance(int32_t defaultDistance) const {
+    return coalesceDistance().value_or(defaultDistance);
+  }
+
+  /// Returns the size over which a coalesced read is better split into
+  /// parallel reads, clamped to ['minBytes', 'maxBytes'], or 'maxBytes' if
+  /// there is no estimate.
+  int64_t maxCoalesceBytes(int64_t minBytes, int64_t maxBytes) const;
+
+  /// Returns the latency per read in microseconds and the throughput in
+  /// bytes per microsecond, or std::nullopt if there is no estimate.
+  std::optional<std::pair<double, double>> estimate() const;
+
+  /// Returns the model of the file system of 'path', keyed by the scheme of
+  /// 'path', e.g. "s3" or "hdfs". Paths without a scheme are local.
+  static StorageReadModel& forPath(std::string_view path);
+
+  /// Returns the key of the model of 'path'.
+  static std::string fileSystemKey(std::string_view path);
+
+ private:
+  // The weight of the previous reads is multiplied by this at each read so
+  // that the model follows changes in the storage.
+  static constexpr double kDecay = 0.99;
+
+  mutable std::mutex mutex_;
+  uint64_t numReads_{0};
+  // Decayed sums of the weights, the sizes, the times, the squared sizes
+  // and the products of size and time for the least squares fit.
+  double sumWeights_{0};
+  double sumBytes_{0};
+  double sumMicros_{0};
+  double sumBytesSquared_{0};
+  double sumBytesMicros_{0};
+};
+
+} // namespace facebook::velox::dwio::common
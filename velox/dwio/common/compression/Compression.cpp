@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/common/compression/CompressionAccelerator.h"
 #include "velox/common/compression/LzoDecompressor.h"
 #include "velox/dwio/common/IntCodecCommon.h"
 #include "velox/dwio/common/compression/PagedInputStream.h"
@@ -30,6 +31,7 @@ namespace facebook::velox::dwio::common::compression {
 
 using dwio::common::encryption::Decrypter;
 using dwio::common::encryption::Encrypter;
+using facebook::velox::common::CompressionAccelerator;
 using facebook::velox::common::CompressionKind;
 using memory::MemoryPool;
 
@@ -610,6 +612,87 @@ bool ZlibDecompressionStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+// Offloads the blocks to 'accelerator_' and decompresses the ones that it
+// rejects or fails with the software 'decompressor_'.
+class AcceleratedDecompressor : public Decompressor {
+ public:
+  AcceleratedDecompressor(
+      std::unique_ptr<Decompressor> decompressor,
+      std::shared_ptr<CompressionAccelerator> accelerator,
+      CompressionKind kind,
+      uint64_t blockSize,
+      const std::string& streamDebugInfo)
+      : Decompressor{blockSize, streamDebugInfo},
+        decompressor_{std::move(decompressor)},
+        accelerator_{std::move(accelerator)},
+        kind_{kind} {}
+
+  std::pair<int64_t, bool> getDecompressedLength(
+      const char* src,
+      uint64_t srcLength) const override {
+    return decompressor_->getDecompressedLength(src, srcLength);
+  }
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override;
+
+ private:
+  const std::unique_ptr<Decompressor> decompressor_;
+  const std::shared_ptr<CompressionAccelerator> accelerator_;
+  const CompressionKind kind_;
+};
+
+uint64_t AcceleratedDecompressor::decompress(
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength) {
+  const velox::common::DecompressionJob job{
+      reinterpret_cast<const uint8_t*>(src),
+      srcLength,
+      reinterpret_cast<uint8_t*>(dest),
+      destLength};
+  auto results = accelerator_->decompress(
+      kind_,
+      folly::Range(&job, 1),
+      [&](const velox::common::DecompressionJob& /*job*/)
+          -> Expected<uint64_t> {
+        return decompressor_->decompress(src, srcLength, dest, destLength);
+      });
+  DWIO_ENSURE(
+      results[0].hasValue(),
+      "Accelerated decompression failed: ",
+      results[0].error().message(),
+      " Info: ",
+      streamDebugInfo_);
+  return results[0].value();
+}
+
+// Returns the registered accelerator if it decompresses the blocks of 'kind'
+// with 'options'. LZ4 and LZO in Hadoop frames and zlib blocks with a header
+// stay in software.
+std::shared_ptr<CompressionAccelerator> decompressionAccelerator(
+    CompressionKind kind,
+    const CompressionOptions& options) {
+  switch (kind) {
+    case CompressionKind::CompressionKind_ZLIB:
+      if (options.format.zlib.windowBits >= 0) {
+        return nullptr;
+      }
+      break;
+    case CompressionKind::CompressionKind_GZIP:
+    case CompressionKind::CompressionKind_SNAPPY:
+    case CompressionKind::CompressionKind_ZSTD:
+      break;
+    default:
+      return nullptr;
+  }
+  return velox::common::compressionAccelerator(kind);
+}
+
 } // namespace
 
 std::unique_ptr<Compressor> createCompressor(
@@ -652,6 +735,7 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     const Decrypter* decrypter,
     bool useRawDecompression,
     size_t compressedLength) {
+  auto accelerator = decompressionAccelerator(kind, options);
   std::unique_ptr<Decompressor> decompressor;
   switch (static_cast<int64_t>(kind)) {
     case CompressionKind::CompressionKind_NONE:
@@ -661,7 +745,7 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
       // decompressor remain as nullptr
       break;
     case CompressionKind::CompressionKind_ZLIB:
-      if (!decrypter) {
+      if (!decrypter && !accelerator) {
         // When file is not encrypted, we can use zlib streaming codec to avoid
         // copying data
         return std::make_unique<ZlibDecompressionStream>(
@@ -678,7 +762,7 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
           blockSize, options.format.zlib.windowBits, streamDebugInfo, false);
       break;
     case CompressionKind::CompressionKind_GZIP:
-      if (!decrypter) {
+      if (!decrypter && !accelerator) {
         // When file is not encrypted, we can use zlib streaming codec to avoid
         // copying data
         return std::make_unique<ZlibDecompressionStream>(
@@ -717,6 +801,14 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     default:
       DWIO_RAISE("Unknown compression codec ", kind);
   }
+  if (accelerator) {
+    decompressor = std::make_unique<AcceleratedDecompressor>(
+        std::move(decompressor),
+        std::move(accelerator),
+        kind,
+        blockSize,
+        streamDebugInfo);
+  }
   return std::make_unique<PagedInputStream>(
       std::move(input),
       pool,
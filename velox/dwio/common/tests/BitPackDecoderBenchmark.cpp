@@ -227,6 +227,7 @@ std::vector<std::vector<uint64_t>> bitPackedData;
 std::vector<uint8_t> result8;
 std::vector<uint16_t> result16;
 std::vector<uint32_t> result32;
+std::vector<uint64_t> result64;
 
 std::vector<int32_t> allRowNumbers;
 std::vector<int32_t> oddRowNumbers;
@@ -389,6 +390,18 @@ void duckdbBitUnpack(uint8_t bitWidth, T* result) {
   }                                                               \
   BENCHMARK_DRAW_LINE();
 
+#define BENCHMARK_UNPACK_FULLROWS_CASE_64(width)            \
+  BENCHMARK(velox_unpack_fullrows_##width##_64) {           \
+    veloxBitUnpack<uint64_t>(width, result64.data());       \
+  }                                                         \
+  BENCHMARK_RELATIVE(arrow_unpack_fullrows_##width##_64) {  \
+    arrowBitUnpack<uint64_t>(width, result64.data());       \
+  }                                                         \
+  BENCHMARK_RELATIVE(duckdb_unpack_fullrows_##width##_64) { \
+    duckdbBitUnpack<uint64_t>(width, result64.data());      \
+  }                                                         \
+  BENCHMARK_DRAW_LINE();
+
 #define BENCHMARK_UNPACK_ODDROWS_CASE_8(width)                  \
   BENCHMARK_RELATIVE(legacy_unpack_naive_oddrows_##width##_8) { \
     legacyUnpackNaive<uint8_t>(oddRows, width, result8.data()); \
@@ -469,6 +482,16 @@ BENCHMARK_UNPACK_FULLROWS_CASE_32(32)
 
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_UNPACK_FULLROWS_CASE_64(1)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(4)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(7)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(13)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(17)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(24)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(31)
+
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK_UNPACK_ODDROWS_CASE_8(1)
 BENCHMARK_UNPACK_ODDROWS_CASE_8(2)
 BENCHMARK_UNPACK_ODDROWS_CASE_8(4)
@@ -605,6 +628,7 @@ int32_t main(int32_t argc, char* argv[]) {
   result8.resize(randomInts_u32.size());
   result16.resize(randomInts_u32.size());
   result32.resize(randomInts_u32.size());
+  result64.resize(randomInts_u32.size());
 
   randomInts_u64_result.resize(randomInts_u64.size());
 
@@ -16,6 +16,7 @@
 
 #include "velox/dwio/common/DecoderUtil.h"
 #include <folly/Random.h>
+#include "velox/dwio/common/ColumnVisitors.h"
 #include "velox/common/base/Nulls.h"
 #include "velox/type/Filter.h"
 
@@ -233,3 +234,40 @@ TEST_F(DecoderUtilTest, processFixedWithRun) {
     }
   }
 }
+
+TEST_F(DecoderUtilTest, filterDictionaryValues) {
+  // An odd size so that the values after the last full vector are tested one
+  // by one.
+  constexpr int32_t kSize = 101;
+  raw_vector<int64_t> bigints(kSize);
+  raw_vector<int16_t> smallints(kSize);
+  raw_vector<double> doubles(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    bigints[i] = i * 3;
+    smallints[i] = i * 3;
+    doubles[i] = i * 3;
+  }
+  std::vector<uint8_t> cache(kSize, FilterResult::kUnknown);
+  common::BigintRange range(30, 150, false);
+  auto expectCache = [&](auto passes) {
+    for (auto i = 0; i < kSize; ++i) {
+      EXPECT_EQ(
+          cache[i], passes(i) ? FilterResult::kSuccess : FilterResult::kFailure)
+          << i;
+    }
+  };
+  filterDictionaryValues(range, bigints.data(), kSize, cache.data());
+  expectCache([](auto i) { return i * 3 >= 30 && i * 3 <= 150; });
+
+  std::fill(cache.begin(), cache.end(), FilterResult::kUnknown);
+  filterDictionaryValues(range, smallints.data(), kSize, cache.data());
+  expectCache([](auto i) { return i * 3 >= 30 && i * 3 <= 150; });
+
+  auto in = common::createBigintValues({0, 9, 300, 301}, false);
+  filterDictionaryValues(*in, bigints.data(), kSize, cache.data());
+  expectCache([](auto i) { return i == 0 || i == 3 || i == 100; });
+
+  common::DoubleRange doubleRange(10, false, false, 20, false, true, false);
+  filterDictionaryValues(doubleRange, doubles.data(), kSize, cache.data());
+  expectCache([](auto i) { return i * 3 >= 10 && i * 3 < 20; });
+}
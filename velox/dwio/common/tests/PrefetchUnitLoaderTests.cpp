@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/executors/ManualExecutor.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/PrefetchUnitLoader.h"
+#include "velox/dwio/common/tests/utils/UnitLoaderTestTools.h"
+
+using facebook::velox::dwio::common::MetricsLog;
+using facebook::velox::dwio::common::PrefetchUnitLoaderFactory;
+using facebook::velox::dwio::common::test::ReaderMock;
+
+namespace {
+class TestMetricsLog : public MetricsLog {
+ public:
+  explicit TestMetricsLog(UnitLoadMetrics& metrics)
+      : MetricsLog(""), metrics_{metrics} {}
+
+  void logUnitLoad(const UnitLoadMetrics& metrics) const override {
+    metrics_ = metrics;
+  }
+
+ private:
+  UnitLoadMetrics& metrics_;
+};
+} // namespace
+
+TEST(PrefetchUnitLoaderTests, prefetchesNextUnit) {
+  folly::ManualExecutor executor;
+  size_t blockedOnIoCount = 0;
+  MetricsLog::UnitLoadMetrics metrics{};
+  PrefetchUnitLoaderFactory factory(
+      &executor,
+      {.numPrefetchUnits = 1, .prefetchRowFraction = 0.5},
+      [&](auto) { ++blockedOnIoCount; },
+      std::make_shared<TestMetricsLog>(metrics));
+  {
+    ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 0};
+    EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 0-2, load(0)
+    EXPECT_EQ(blockedOnIoCount, 1);
+    EXPECT_EQ(executor.drain(), 0);
+
+    EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 3-5, queues load(1)
+    EXPECT_EQ(
+        readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+    EXPECT_EQ(executor.drain(), 1);
+    EXPECT_EQ(
+        readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+    EXPECT_TRUE(readerMock.read(4)); // Unit: 0, rows: 6-9
+    // Unit: 1, rows: 0-13, unload(0), queues load(2)
+    EXPECT_TRUE(readerMock.read(14));
+    EXPECT_EQ(
+        readerMock.unitsLoaded(), std::vector<bool>({false, true, false}));
+    EXPECT_EQ(blockedOnIoCount, 1);
+
+    // The load of unit 2 has not started and is done by the reader.
+    EXPECT_TRUE(readerMock.read(10)); // Unit: 1, rows: 14-19
+    EXPECT_TRUE(readerMock.read(30)); // Unit: 2, rows: 0-29, unload(1)
+    EXPECT_EQ(
+        readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+    EXPECT_EQ(blockedOnIoCount, 2);
+    EXPECT_FALSE(readerMock.read(30));
+  }
+  EXPECT_EQ(executor.drain(), 1);
+  EXPECT_EQ(metrics.numUnits, 3);
+  EXPECT_EQ(metrics.numPrefetchedUnits, 2);
+  EXPECT_EQ(metrics.numPrefetchHits, 1);
+  EXPECT_EQ(metrics.numCancelledPrefetches, 0);
+}
+
+TEST(PrefetchUnitLoaderTests, maxPrefetchBytes) {
+  folly::ManualExecutor executor;
+  PrefetchUnitLoaderFactory factory(
+      &executor,
+      {.numPrefetchUnits = 2,
+       .prefetchRowFraction = 0,
+       .maxPrefetchBytes = 25},
+      nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {10, 20, 30}, factory, 0};
+  EXPECT_TRUE(readerMock.read(1)); // Unit: 0, rows: 0, queues load(1)
+  EXPECT_EQ(executor.drain(), 1);
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+}
+
+TEST(PrefetchUnitLoaderTests, seekCancelsPrefetch) {
+  folly::ManualExecutor executor;
+  MetricsLog::UnitLoadMetrics metrics{};
+  PrefetchUnitLoaderFactory factory(
+      &executor,
+      {.numPrefetchUnits = 1, .prefetchRowFraction = 0},
+      nullptr,
+      std::make_shared<TestMetricsLog>(metrics));
+  {
+    ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 0};
+    EXPECT_TRUE(readerMock.read(1)); // Unit: 0, rows: 0, queues load(1)
+    readerMock.seek(30);
+    EXPECT_EQ(executor.drain(), 1);
+    EXPECT_EQ(
+        readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+    EXPECT_TRUE(readerMock.read(3)); // Unit: 2, rows: 0-2, unload(0)
+    EXPECT_EQ(
+        readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+  }
+  EXPECT_EQ(metrics.numPrefetchedUnits, 1);
+  EXPECT_EQ(metrics.numCancelledPrefetches, 1);
+}
+
+TEST(PrefetchUnitLoaderTests, invalidOptions) {
+  folly::ManualExecutor executor;
+  VELOX_ASSERT_THROW(
+      PrefetchUnitLoaderFactory(
+          &executor, {.prefetchRowFraction = 2}, nullptr),
+      "(2 vs. 1)");
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/StorageReadModel.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+// Records reads of sizes from 64KB to 8MB on a storage with 'latencyUs'
+// microseconds per read and 'bytesPerUs' throughput.
+void recordReads(StorageReadModel& model, double latencyUs, double bytesPerUs) {
+  for (auto i = 0; i < 100; ++i) {
+    const uint64_t bytes = (64 << 10) << (i % 8);
+    model.recordRead(bytes, latencyUs + bytes / bytesPerUs);
+  }
+}
+
+TEST(StorageReadModelTest, noEstimate) {
+  StorageReadModel model;
+  EXPECT_FALSE(model.coalesceDistance().has_value());
+  EXPECT_EQ(model.coalesceDistance(1000), 1000);
+  EXPECT_EQ(model.maxCoalesceBytes(1 << 20, 128 << 20), 128 << 20);
+
+  // Reads of one size do not give an estimate.
+  for (auto i = 0; i < 100; ++i) {
+    model.recordRead(1 << 20, 1000);
+  }
+  EXPECT_FALSE(model.estimate().has_value());
+}
+
+TEST(StorageReadModelTest, estimate) {
+  // An object store with 20ms per request and 100MB/s.
+  StorageReadModel objectStore;
+  recordReads(objectStore, 20'000, 100);
+  auto estimate = objectStore.estimate();
+  ASSERT_TRUE(estimate.has_value());
+  EXPECT_NEAR(estimate->first, 20'000, 1);
+  EXPECT_NEAR(estimate->second, 100, 0.01);
+  EXPECT_NEAR(objectStore.coalesceDistance().value(), 2'000'000, 1'000);
+  EXPECT_NEAR(
+      objectStore.maxCoalesceBytes(8 << 20, 128 << 20),
+      2'000'000 * StorageReadModel::kParallelReadFactor,
+      16'000);
+
+  // A local disk with 10us per read and 200MB/s gets the minimum distance.
+  StorageReadModel localDisk;
+  recordReads(localDisk, 10, 200);
+  EXPECT_EQ(
+      localDisk.coalesceDistance(), StorageReadModel::kMinCoalesceDistance);
+  EXPECT_EQ(localDisk.maxCoalesceBytes(8 << 20, 128 << 20), 8 << 20);
+
+  // The model follows a change in the storage.
+  recordReads(localDisk, 100'000, 1'000);
+  recordReads(localDisk, 100'000, 1'000);
+  EXPECT_EQ(
+      localDisk.coalesceDistance(), StorageReadModel::kMaxCoalesceDistance);
+}
+
+TEST(StorageReadModelTest, forPath) {
+  EXPECT_EQ(StorageReadModel::fileSystemKey("/tmp/file"), "file");
+  EXPECT_EQ(StorageReadModel::fileSystemKey("s3://bucket/file"), "s3");
+  EXPECT_EQ(StorageReadModel::fileSystemKey("hdfs://host/file"), "hdfs");
+  EXPECT_EQ(
+      &StorageReadModel::forPath("s3://bucket/a"),
+      &StorageReadModel::forPath("s3://other/b"));
+  EXPECT_NE(
+      &StorageReadModel::forPath("s3://bucket/a"),
+      &StorageReadModel::forPath("/tmp/a"));
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::dwrf {
+
+namespace {
+
+// The seed of the Murmur3 hash of the ORC bloom filters.
+constexpr uint64_t kMurmurSeed = 104729;
+constexpr uint64_t kMurmurC1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t kMurmurC2 = 0x4cf5ad432745937fULL;
+
+inline uint64_t rotateLeft(uint64_t value, int32_t shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t mixKey(uint64_t key) {
+  key *= kMurmurC1;
+  key = rotateLeft(key, 31);
+  return key * kMurmurC2;
+}
+
+inline uint64_t finalizeHash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Shifts right with sign extension like the Java '>>'.
+inline uint64_t shiftRight(uint64_t value, int32_t shift) {
+  return static_cast<uint64_t>(static_cast<int64_t>(value) >> shift);
+}
+
+// Returns the bit of 'hash' for the 'i'th hash function in a filter of
+// 'numBits' bits. Matches the 32 bit signed arithmetic of the ORC writers.
+inline uint32_t bitPosition(uint64_t hash, int32_t i, uint64_t numBits) {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  auto combined = static_cast<int32_t>(hash1 + i * hash2);
+  if (combined < 0) {
+    combined = ~combined;
+  }
+  return combined % numBits;
+}
+
+} // namespace
+
+BloomFilter::BloomFilter(uint64_t expectedEntries, double fpp) {
+  VELOX_CHECK_GT(expectedEntries, 0);
+  VELOX_CHECK(fpp > 0 && fpp < 1, "Bloom filter fpp must be in (0, 1)");
+  const auto ln2 = std::log(2.0);
+  const auto optimalBits = static_cast<uint64_t>(
+      -static_cast<double>(expectedEntries) * std::log(fpp) / (ln2 * ln2));
+  // Like the ORC writers, rounds up to whole words, adding a word when
+  // already rounded.
+  const auto numBits = optimalBits + 64 - optimalBits % 64;
+  bits_.resize(numBits / 64);
+  numHashFunctions_ = std::max<int32_t>(
+      1,
+      static_cast<int32_t>(std::round(
+          static_cast<double>(numBits) / expectedEntries * ln2)));
+}
+
+BloomFilter::BloomFilter(std::vector<uint64_t> bits, int32_t numHashFunctions)
+    : bits_(std::move(bits)), numHashFunctions_(numHashFunctions) {}
+
+std::unique_ptr<BloomFilter> BloomFilter::fromProto(
+    const proto::BloomFilter& proto) {
+  std::vector<uint64_t> bits;
+  if (proto.bitset_size() > 0) {
+    bits.assign(proto.bitset().begin(), proto.bitset().end());
+  } else {
+    const auto& bytes = proto.utf8bitset();
+    VELOX_CHECK_EQ(
+        bytes.size() % sizeof(uint64_t),
+        0,
+        "Bloom filter bitset is not whole words");
+    bits.resize(bytes.size() / sizeof(uint64_t));
+    ::memcpy(bits.data(), bytes.data(), bytes.size());
+  }
+  VELOX_CHECK(!bits.empty(), "Bloom filter has no bits");
+  VELOX_CHECK_GT(proto.numhashfunctions(), 0);
+  return std::unique_ptr<BloomFilter>(
+      new BloomFilter(std::move(bits), proto.numhashfunctions()));
+}
+
+uint64_t BloomFilter::hashLong(int64_t value) {
+  auto key = static_cast<uint64_t>(value);
+  key = ~key + (key << 21);
+  key ^= shiftRight(key, 24);
+  key = key + (key << 3) + (key << 8);
+  key ^= shiftRight(key, 14);
+  key = key + (key << 2) + (key << 4);
+  key ^= shiftRight(key, 28);
+  return key + (key << 31);
+}
+
+uint64_t BloomFilter::hashBytes(std::string_view value) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  const auto size = value.size();
+  uint64_t hash = kMurmurSeed;
+  const auto numBlocks = size / 8;
+  for (size_t i = 0; i < numBlocks; ++i) {
+    uint64_t block;
+    ::memcpy(&block, data + i * 8, sizeof(block));
+    hash ^= mixKey(block);
+    hash = rotateLeft(hash, 27) * 5 + 0x52dce729;
+  }
+  const auto* tail = data + numBlocks * 8;
+  uint64_t key = 0;
+  for (auto i = static_cast<int32_t>(size % 8) - 1; i >= 0; --i) {
+    key ^= static_cast<uint64_t>(tail[i]) << (i * 8);
+  }
+  if (size % 8 != 0) {
+    hash ^= mixKey(key);
+  }
+  hash ^= size;
+  return finalizeHash(hash);
+}
+
+void BloomFilter::addHash(uint64_t hash) {
+  const auto bits = numBits();
+  for (int32_t i = 1; i <= numHashFunctions_; ++i) {
+    bits::setBit(bits_.data(), bitPosition(hash, i, bits));
+  }
+}
+
+bool BloomFilter::testHash(uint64_t hash) const {
+  const auto bits = numBits();
+  for (int32_t i = 1; i <= numHashFunctions_; ++i) {
+    if (!bits::isBitSet(bits_.data(), bitPosition(hash, i, bits))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BloomFilter::reset() {
+  std::fill(bits_.begin(), bits_.end(), 0);
+}
+
+void BloomFilter::toProto(proto::BloomFilter& proto) const {
+  proto.set_numhashfunctions(numHashFunctions_);
+  proto.mutable_bitset()->Assign(bits_.begin(), bits_.end());
+}
+
+} // namespace facebook::velox::dwrf
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+
+namespace facebook::velox::dwrf {
+
+/// A bloom filter that reads and writes the BloomFilter of ORC and DWRF
+/// files like the ORC writers do. Strings are hashed with the 64 bit
+/// Murmur3 hash and integers with Thomas Wang's 64 bit integer hash. The
+/// halves of the hash set 'numHashFunctions' bits by double hashing.
+class BloomFilter {
+ public:
+  /// Makes a filter for 'expectedEntries' distinct values with a false
+  /// positive probability of 'fpp'.
+  BloomFilter(uint64_t expectedEntries, double fpp);
+
+  /// Reads a filter from 'proto'. The bits are in 'bitset' or, as the ORC
+  /// Java writer stores them, little endian in 'utf8bitset'.
+  static std::unique_ptr<BloomFilter> fromProto(
+      const proto::BloomFilter& proto);
+
+  static uint64_t hashLong(int64_t value);
+
+  static uint64_t hashBytes(std::string_view value);
+
+  void addLong(int64_t value) {
+    addHash(hashLong(value));
+  }
+
+  void addBytes(std::string_view value) {
+    addHash(hashBytes(value));
+  }
+
+  /// Returns false if no value with 'hash' was added.
+  bool testHash(uint64_t hash) const;
+
+  bool testLong(int64_t value) const {
+    return testHash(hashLong(value));
+  }
+
+  bool testBytes(std::string_view value) const {
+    return testHash(hashBytes(value));
+  }
+
+  /// Clears all bits.
+  void reset();
+
+  void toProto(proto::BloomFilter& proto) const;
+
+  uint64_t numBits() const {
+    return bits_.size() * 64;
+  }
+
+  int32_t numHashFunctions() const {
+    return numHashFunctions_;
+  }
+
+ private:
+  BloomFilter(std::vector<uint64_t> bits, int32_t numHashFunctions);
+
+  void addHash(uint64_t hash);
+
+  std::vector<uint64_t> bits_;
+  int32_t numHashFunctions_;
+};
+
+} // namespace facebook::velox::dwrf
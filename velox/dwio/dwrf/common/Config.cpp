@@ -21,6 +21,31 @@
 
 namespace facebook::velox::dwrf {
 
+namespace {
+
+std::string columnsToString(const std::vector<uint32_t>& val) {
+  return folly::join(",", val);
+}
+
+std::vector<uint32_t> columnsFromString(
+    const std::string& /* key */,
+    const std::string& val) {
+  std::vector<uint32_t> result;
+  if (!val.empty()) {
+    std::vector<folly::StringPiece> pieces;
+    folly::split(',', val, pieces, true);
+    for (const auto& p : pieces) {
+      const auto& trimmedCol = folly::trimWhitespace(p);
+      if (!trimmedCol.empty()) {
+        result.push_back(folly::to<uint32_t>(trimmedCol));
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace
+
 Config::Entry<WriterVersion> Config::WRITER_VERSION(
     "orc.writer.version",
     WriterVersion_CURRENT);
@@ -89,6 +114,18 @@ Config::Entry<bool> Config::DICTIONARY_SORT_KEYS{
     "hive.exec.orc.dictionary.key.sorted",
     false};
 
+Config::Entry<bool> Config::DICTIONARY_EARLY_CHECK{
+    "orc.dictionary.early.check",
+    false};
+
+Config::Entry<const std::vector<uint32_t>> Config::BLOOM_FILTER_COLUMNS(
+    "orc.bloom.filter.columns",
+    {},
+    columnsToString,
+    columnsFromString);
+
+Config::Entry<float> Config::BLOOM_FILTER_FPP{"orc.bloom.filter.fpp", 0.05f};
+
 Config::Entry<float> Config::ENTROPY_KEY_STRING_SIZE_THRESHOLD{
     "hive.exec.orc.entropy.key.string.size.threshold",
     0.9f};
@@ -126,21 +163,8 @@ Config::Entry<bool> Config::MAP_FLAT_DICT_SHARE(
 Config::Entry<const std::vector<uint32_t>> Config::MAP_FLAT_COLS(
     "orc.map.flat.cols",
     {},
-    [](const std::vector<uint32_t>& val) { return folly::join(",", val); },
-    [](const std::string& /* key */, const std::string& val) {
-      std::vector<uint32_t> result;
-      if (!val.empty()) {
-        std::vector<folly::StringPiece> pieces;
-        folly::split(',', val, pieces, true);
-        for (const auto& p : pieces) {
-          const auto& trimmedCol = folly::trimWhitespace(p);
-          if (!trimmedCol.empty()) {
-            result.push_back(folly::to<uint32_t>(trimmedCol));
-          }
-        }
-      }
-      return result;
-    });
+    columnsToString,
+    columnsFromString);
 
 Config::Entry<const std::vector<std::vector<std::string>>>
     Config::MAP_FLAT_COLS_STRUCT_KEYS(
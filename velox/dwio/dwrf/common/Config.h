@@ -47,6 +47,16 @@ class Config : public config::ConfigBase {
   static Entry<float> DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD;
   static Entry<float> DICTIONARY_STRING_KEY_SIZE_THRESHOLD;
   static Entry<bool> DICTIONARY_SORT_KEYS;
+  /// Decides between the dictionary and the direct encodings of the columns
+  /// after the first row index stride of the file instead of when the first
+  /// stripe is flushed, so that the columns that go direct do not build a
+  /// stripe sized dictionary first.
+  static Entry<bool> DICTIONARY_EARLY_CHECK;
+  /// The top level columns, by index, that get a bloom filter per row index
+  /// stride. Only the integer and string columns get bloom filters.
+  static Entry<const std::vector<uint32_t>> BLOOM_FILTER_COLUMNS;
+  /// The false positive probability of the bloom filters.
+  static Entry<float> BLOOM_FILTER_FPP;
   static Entry<float> ENTROPY_KEY_STRING_SIZE_THRESHOLD;
   static Entry<uint32_t> ENTROPY_STRING_MIN_SAMPLES;
   static Entry<float> ENTROPY_STRING_DICT_SAMPLE_FRACTION;
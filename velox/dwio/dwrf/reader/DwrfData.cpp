@@ -16,15 +16,99 @@
 
 #include "velox/dwio/dwrf/reader/DwrfData.h"
 
+#include <algorithm>
+
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 
 namespace facebook::velox::dwrf {
 
+namespace {
+
+// The most values of a filter that are tested against the bloom filters.
+constexpr size_t kMaxBloomFilterValues = 1'000;
+
+// Returns the bloom filter hashes of the values that pass 'filter' on a
+// column of 'type'. Returns an empty vector if 'filter' passes nulls, a
+// range or too many values, in which case the bloom filters do not help.
+std::vector<uint64_t> bloomFilterHashes(
+    const common::Filter* filter,
+    const Type& type) {
+  std::vector<uint64_t> hashes;
+  if (filter == nullptr || filter->testNull()) {
+    return hashes;
+  }
+  const auto addLongs = [&](const std::vector<int64_t>& values) {
+    for (auto value : values) {
+      hashes.push_back(BloomFilter::hashLong(value));
+    }
+  };
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      if (type.isDecimal()) {
+        break;
+      }
+      switch (filter->kind()) {
+        case common::FilterKind::kBigintRange: {
+          const auto* range = static_cast<const common::BigintRange*>(filter);
+          if (range->isSingleValue()) {
+            hashes.push_back(BloomFilter::hashLong(range->lower()));
+          }
+          break;
+        }
+        case common::FilterKind::kBigintValuesUsingHashTable:
+          addLongs(
+              static_cast<const common::BigintValuesUsingHashTable*>(filter)
+                  ->values());
+          break;
+        case common::FilterKind::kBigintValuesUsingBitmask:
+          addLongs(static_cast<const common::BigintValuesUsingBitmask*>(filter)
+                       ->values());
+          break;
+        default:
+          break;
+      }
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      switch (filter->kind()) {
+        case common::FilterKind::kBytesRange: {
+          const auto* range = static_cast<const common::BytesRange*>(filter);
+          if (range->isSingleValue()) {
+            hashes.push_back(BloomFilter::hashBytes(range->lower()));
+          }
+          break;
+        }
+        case common::FilterKind::kBytesValues:
+          for (const auto& value :
+               static_cast<const common::BytesValues*>(filter)->values()) {
+            hashes.push_back(BloomFilter::hashBytes(value));
+          }
+          break;
+        default:
+          break;
+      }
+      break;
+    default:
+      break;
+  }
+  if (hashes.size() > kMaxBloomFilterValues) {
+    hashes.clear();
+  }
+  return hashes;
+}
+
+} // namespace
+
 DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> fileType,
     StripeStreams& stripe,
     const StreamLabels& streamLabels,
-    FlatMapContext flatMapContext)
+    FlatMapContext flatMapContext,
+    const common::ScanSpec* scanSpec)
     : memoryPool_(stripe.getMemoryPool()),
       fileType_(std::move(fileType)),
       flatMapContext_(std::move(flatMapContext)),
@@ -55,6 +139,20 @@ DwrfData::DwrfData(
           proto::orc::Stream_Kind_ROW_INDEX),
       streamLabels.label(),
       false);
+
+  // The bloom filters are only loaded for the filters known at construct
+  // time, since they are large compared to the row index.
+  if (scanSpec &&
+      !bloomFilterHashes(scanSpec->filter(), *fileType_->type()).empty()) {
+    bloomFilterStream_ = stripe.getStream(
+        StripeStreamsUtil::getStreamForKind(
+            stripe,
+            encodingKey,
+            proto::Stream_Kind_BLOOM_FILTER_UTF8,
+            proto::orc::Stream_Kind_BLOOM_FILTER_UTF8),
+        streamLabels.label(),
+        false);
+  }
 }
 
 uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
@@ -99,6 +197,23 @@ void DwrfData::ensureRowGroupIndex() {
   }
 }
 
+bool DwrfData::testBloomFilter(
+    int32_t index,
+    const std::vector<uint64_t>& hashes) {
+  if (bloomFilterStream_) {
+    bloomFilterIndex_ = ProtoUtils::readProto<proto::BloomFilterIndex>(
+        std::move(bloomFilterStream_));
+  }
+  if (!bloomFilterIndex_ || index >= bloomFilterIndex_->bloomfilter_size()) {
+    return true;
+  }
+  const auto bloomFilter =
+      BloomFilter::fromProto(bloomFilterIndex_->bloomfilter(index));
+  return std::any_of(hashes.begin(), hashes.end(), [&](auto hash) {
+    return bloomFilter->testHash(hash);
+  });
+}
+
 dwio::common::PositionProvider DwrfData::seekToRowGroup(int64_t index) {
   ensureRowGroupIndex();
 
@@ -173,6 +288,11 @@ void DwrfData::filterRowGroups(
         scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
   }
 
+  std::vector<uint64_t> hashes;
+  if (bloomFilterStream_ || bloomFilterIndex_) {
+    hashes = bloomFilterHashes(filter, *fileType_->type());
+  }
+
   for (auto i = 0; i < index_->entry_size(); ++i) {
     const auto& entry = index_->entry(i);
     const auto columnStats = buildColumnStatisticsFromProto(
@@ -184,6 +304,12 @@ void DwrfData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (!hashes.empty() && !testBloomFilter(i, hashes)) {
+      VLOG(1) << "Drop stride " << i << " by bloom filter on "
+              << scanSpec.toString();
+      bits::setBit(result.filterResult.data(), i);
+      continue;
+    }
 
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
@@ -36,7 +36,8 @@ class DwrfData : public dwio::common::FormatData {
       std::shared_ptr<const dwio::common::TypeWithId> fileType,
       StripeStreams& stripe,
       const StreamLabels& streamLabels,
-      FlatMapContext flatMapContext);
+      FlatMapContext flatMapContext,
+      const common::ScanSpec* scanSpec = nullptr);
 
   void readNulls(
       vector_size_t numValues,
@@ -99,12 +100,21 @@ class DwrfData : public dwio::common::FormatData {
         entry.positions().begin(), entry.positions().end());
   }
 
+  // Returns false if the bloom filter of row group 'index' shows that no
+  // value in 'hashes' is in the row group.
+  bool testBloomFilter(int32_t index, const std::vector<uint64_t>& hashes);
+
   memory::MemoryPool& memoryPool_;
   const std::shared_ptr<const dwio::common::TypeWithId> fileType_;
   FlatMapContext flatMapContext_;
   std::unique_ptr<BooleanRleDecoder> notNullDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> indexStream_;
   std::unique_ptr<proto::RowIndex> index_;
+  // The bloom filters of the row groups. The stream is only opened when the
+  // filter of the column passes a few values, for which the bloom filters
+  // may drop row groups the statistics cannot.
+  std::unique_ptr<dwio::common::SeekableInputStream> bloomFilterStream_;
+  std::unique_ptr<proto::BloomFilterIndex> bloomFilterIndex_;
   int64_t stripeRows_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
@@ -132,9 +142,9 @@ class DwrfParams : public dwio::common::FormatParams {
 
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
-      const common::ScanSpec& /*scanSpec*/) override {
+      const common::ScanSpec& scanSpec) override {
     return std::make_unique<DwrfData>(
-        type, stripeStreams_, streamLabels_, flatMapContext_);
+        type, stripeStreams_, streamLabels_, flatMapContext_, &scanSpec);
   }
 
   StripeStreams& stripeStreams() {
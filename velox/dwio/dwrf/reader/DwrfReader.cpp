@@ -19,6 +19,7 @@
 #include <chrono>
 
 #include "velox/dwio/common/OnDemandUnitLoader.h"
+#include "velox/dwio/common/SelectiveStructColumnReader.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
@@ -169,6 +170,14 @@ void DwrfUnit::ensureDecoders() {
         flatMapContext,
         /*isRoot=*/true);
     selectiveColumnReader_->setIsTopLevel();
+    if (auto* structReader =
+            dynamic_cast<dwio::common::SelectiveStructColumnReaderBase*>(
+                selectiveColumnReader_.get())) {
+      structReader->setParallelDecoding(
+          options_.decodingExecutor().get(),
+          options_.decodingParallelismFactor(),
+          options_.parallelDecodeMinCells());
+    }
   } else {
     auto requestedType = columnSelector_->getSchemaWithId();
     auto factory = &ColumnReaderFactory::defaultFactory();
@@ -788,6 +797,15 @@ std::optional<size_t> DwrfRowReader::estimatedRowSize() const {
   return std::nullopt;
 }
 
+std::optional<uint64_t> DwrfRowReader::rowCountFromMetadata() const {
+  if (emptyFile()) {
+    return 0;
+  }
+  return firstRowOfStripe_[stripeCeiling_ - 1] +
+      getReader().footer().stripes(stripeCeiling_ - 1).numberOfRows() -
+      firstRowOfStripe_[firstStripe_];
+}
+
 DwrfReader::DwrfReader(
     const ReaderOptions& options,
     std::unique_ptr<dwio::common::BufferedInput> input)
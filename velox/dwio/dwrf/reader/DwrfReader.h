@@ -99,6 +99,9 @@ class DwrfRowReader : public StrideIndexProvider,
   /// Estimates the row size for projected columns
   std::optional<size_t> estimatedRowSize() const override;
 
+  /// Returns the number of rows of the stripes in range.
+  std::optional<uint64_t> rowCountFromMetadata() const override;
+
   /// Returns number of rows read. Guaranteed to be less then or equal to size.
   uint64_t next(
       uint64_t size,
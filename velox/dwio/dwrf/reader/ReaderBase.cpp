@@ -268,6 +268,7 @@ void ReaderBase::loadCache() {
       input_->load(LogType::FOOTER);
     }
   }
+  input_->setNumStripes(footer().stripesSize());
   // Release the memory as we no longer need it.
   stripeMetadataCacheBuffer_.reset();
 }
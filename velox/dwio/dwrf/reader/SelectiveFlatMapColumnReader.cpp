@@ -65,6 +65,44 @@ struct KeyNode {
         inMap(std::move(inMap)) {}
 };
 
+// Reads only the in-map stream of a flat map value and not the values, for
+// maps whose values spec is constant, e.g. when only the keys or the sizes of
+// the maps are used. The value streams of the keys are not loaded.
+class SelectiveFlatMapInMapReader : public dwio::common::SelectiveColumnReader {
+ public:
+  SelectiveFlatMapInMapReader(
+      const TypePtr& requestedType,
+      const std::shared_ptr<const dwio::common::TypeWithId>& fileType,
+      DwrfParams& params,
+      common::ScanSpec& scanSpec)
+      : SelectiveColumnReader(requestedType, fileType, params, scanSpec) {}
+
+  void seekToRowGroup(int64_t index) override {
+    SelectiveColumnReader::seekToRowGroup(index);
+    formatData_->as<DwrfData>().seekToRowGroup(index);
+  }
+
+  uint64_t skip(uint64_t numValues) override {
+    return formatData_->skipNulls(numValues, true);
+  }
+
+  void read(int64_t offset, const RowSet& rows, const uint64_t* incomingNulls)
+      override {
+    readNulls(offset, rows.back() + 1, incomingNulls);
+    inputRows_ = rows;
+    readOffset_ = offset + rows.back() + 1;
+  }
+
+  void getValues(const RowSet& /*rows*/, VectorPtr* /*result*/) override {
+    VELOX_UNREACHABLE("The values of the keys are constant");
+  }
+
+ protected:
+  bool readsNullsOnly() const override {
+    return true;
+  }
+};
+
 template <typename T>
 std::vector<KeyNode<T>> getKeyNodes(
     const TypePtr& requestedType,
@@ -144,8 +182,14 @@ std::vector<KeyNode<T>> getKeyNodes(
                 .sequence = sequence,
                 .inMapDecoder = inMapDecoder.get(),
                 .keySelectionCallback = nullptr});
-        auto reader = SelectiveDwrfReader::build(
-            requestedValueType, dataValueType, childParams, *childSpec);
+        std::unique_ptr<dwio::common::SelectiveColumnReader> reader;
+        if (!asStruct && valuesSpec->isConstant()) {
+          reader = std::make_unique<SelectiveFlatMapInMapReader>(
+              requestedValueType, dataValueType, childParams, *childSpec);
+        } else {
+          reader = SelectiveDwrfReader::build(
+              requestedValueType, dataValueType, childParams, *childSpec);
+        }
         keyNodes.emplace_back(
             key, sequence, std::move(reader), std::move(inMapDecoder));
       });
@@ -129,6 +129,7 @@ void SelectiveIntegerDictionaryColumnReader::ensureInitialized() {
         scanState_.filterCache.data(),
         FilterResult::kUnknown,
         scanState_.filterCache.size());
+    scanState_.filterCacheComplete = false;
   }
   scanState_.updateRawState();
   initialized_ = true;
@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/reader/SelectiveStringDictionaryColumnReader.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::dwrf {
 
@@ -129,6 +130,8 @@ void SelectiveStringDictionaryColumnReader::loadDictionary(
   // read bytes from underlying string
   values.strings = AlignedBuffer::allocate<char>(stringsBytes, memoryPool_);
   data.readFully(values.strings->asMutable<char>(), stringsBytes);
+  values.isAscii = functions::stringCore::isAscii(
+      values.strings->as<char>(), stringsBytes);
   // fill the values with StringViews over the strings. 'strings' will
   // exist even if 'stringsBytes' is 0, which can happen if the only
   // content of the dictionary is the empty string.
@@ -174,6 +177,7 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
         scanState_.filterCache.data() + scanState_.dictionary.numValues,
         FilterResult::kUnknown,
         scanState_.dictionary2.numValues);
+    scanState_.filterCacheComplete = false;
   }
   scanState_.updateRawState();
 }
@@ -211,6 +215,9 @@ void SelectiveStringDictionaryColumnReader::makeDictionaryBaseVector() {
         scanState_.dictionary.values,
         std::vector<BufferPtr>{scanState_.dictionary.strings});
   }
+  if (dictionaryIsAscii()) {
+    dictionaryValues_->setAllIsAscii(true);
+  }
 }
 
 void SelectiveStringDictionaryColumnReader::read(
@@ -284,6 +291,9 @@ void SelectiveStringDictionaryColumnReader::makeFlat(VectorPtr* result) {
       numValues_,
       std::move(values),
       std::move(stringBuffers));
+  if (dictionaryIsAscii()) {
+    (*result)->asUnchecked<FlatVector<StringView>>()->setAllIsAscii(true);
+  }
   statistics_.flattenStringDictionaryValues += numValues_;
 }
 
@@ -326,6 +336,7 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
         scanState_.filterCache.data(),
         FilterResult::kUnknown,
         scanState_.dictionary.numValues);
+    scanState_.filterCacheComplete = false;
   }
 
   // handle in dictionary stream
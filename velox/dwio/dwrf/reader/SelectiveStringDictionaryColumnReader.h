@@ -82,6 +82,14 @@ class SelectiveStringDictionaryColumnReader
 
   void makeFlat(VectorPtr* result);
 
+  // True if the values of the stripe and the stride dictionaries are all
+  // ASCII.
+  bool dictionaryIsAscii() const {
+    return scanState_.dictionary.isAscii &&
+        (scanState_.dictionary2.numValues == 0 ||
+         scanState_.dictionary2.isAscii);
+  }
+
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ false>> dictIndex_;
   std::unique_ptr<ByteRleDecoder> inDictionaryReader_;
   std::unique_ptr<dwio::common::SeekableInputStream> strideDictStream_;
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace facebook::velox::dwrf;
+
+TEST(BloomFilterTest, size) {
+  // The sizes of the ORC writers for the same parameters.
+  BloomFilter filter(10'000, 0.05);
+  EXPECT_EQ(filter.numBits(), 62'400);
+  EXPECT_EQ(filter.numHashFunctions(), 4);
+
+  BloomFilter small(1, 0.5);
+  EXPECT_EQ(small.numBits(), 64);
+  EXPECT_EQ(small.numHashFunctions(), 44);
+
+  VELOX_ASSERT_THROW(BloomFilter(0, 0.05), "");
+  VELOX_ASSERT_THROW(BloomFilter(100, 1), "Bloom filter fpp must be in (0, 1)");
+}
+
+TEST(BloomFilterTest, addAndTest) {
+  constexpr int64_t kNumValues = 10'000;
+  BloomFilter filter(2 * kNumValues, 0.05);
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    filter.addLong(i * 3);
+    filter.addBytes(fmt::format("value {}", i * 3));
+  }
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    ASSERT_TRUE(filter.testLong(i * 3)) << i;
+    ASSERT_TRUE(filter.testBytes(fmt::format("value {}", i * 3))) << i;
+  }
+
+  // The false positive rate is about the fpp of the filter.
+  int32_t numLongPositives = 0;
+  int32_t numBytesPositives = 0;
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    numLongPositives += filter.testLong(i * 3 + 1);
+    numBytesPositives += filter.testBytes(fmt::format("value {}", i * 3 + 1));
+  }
+  EXPECT_LT(numLongPositives, kNumValues / 10);
+  EXPECT_LT(numBytesPositives, kNumValues / 10);
+
+  filter.reset();
+  EXPECT_FALSE(filter.testLong(0));
+  EXPECT_FALSE(filter.testBytes("value 0"));
+}
+
+TEST(BloomFilterTest, proto) {
+  BloomFilter filter(1'000, 0.01);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    filter.addLong(i);
+  }
+  filter.addBytes("");
+  filter.addBytes("a string longer than eight bytes");
+
+  proto::BloomFilter bitset;
+  filter.toProto(bitset);
+  EXPECT_EQ(bitset.numhashfunctions(), filter.numHashFunctions());
+  EXPECT_EQ(bitset.bitset_size() * 64, filter.numBits());
+
+  // The ORC Java writer stores the words little endian in 'utf8bitset'.
+  proto::BloomFilter utf8Bitset;
+  utf8Bitset.set_numhashfunctions(bitset.numhashfunctions());
+  std::string bytes;
+  for (auto word : bitset.bitset()) {
+    bytes.append(reinterpret_cast<const char*>(&word), sizeof(word));
+  }
+  utf8Bitset.set_utf8bitset(bytes);
+
+  for (const auto* proto : {&bitset, &utf8Bitset}) {
+    auto read = BloomFilter::fromProto(*proto);
+    EXPECT_EQ(read->numBits(), filter.numBits());
+    EXPECT_EQ(read->numHashFunctions(), filter.numHashFunctions());
+    for (int64_t i = 0; i < 1'000; ++i) {
+      ASSERT_TRUE(read->testLong(i)) << i;
+    }
+    EXPECT_TRUE(read->testBytes(""));
+    EXPECT_TRUE(read->testBytes("a string longer than eight bytes"));
+  }
+
+  utf8Bitset.set_utf8bitset(bytes.substr(1));
+  VELOX_ASSERT_THROW(
+      BloomFilter::fromProto(utf8Bitset),
+      "Bloom filter bitset is not whole words");
+}
@@ -42,6 +42,40 @@ using memory::MemoryAllocator;
 using IoStatisticsPtr = std::shared_ptr<IoStatistics>;
 DECLARE_bool(velox_ssd_odirect);
 
+namespace {
+// Serves the test data of every other entry as if another worker had it
+// cached.
+class TestPeerCache : public PeerCache {
+ public:
+  bool read(std::string_view /*fileName*/, AsyncDataCacheEntry& entry)
+      override {
+    if (++numReads_ % 2 == 0) {
+      return false;
+    }
+    uint8_t data = entry.key().fileNum.id() + entry.offset();
+    if (entry.tinyData() != nullptr) {
+      for (auto i = 0; i < entry.size(); ++i) {
+        entry.tinyData()[i] = data++;
+      }
+      return true;
+    }
+    int64_t bytesLeft = entry.size();
+    for (auto i = 0; i < entry.data().numRuns() && bytesLeft > 0; ++i) {
+      auto run = entry.data().runAt(i);
+      const auto size = std::min<int64_t>(run.numBytes(), bytesLeft);
+      for (auto j = 0; j < size; ++j) {
+        run.data<uint8_t>()[j] = data++;
+      }
+      bytesLeft -= size;
+    }
+    return true;
+  }
+
+ private:
+  std::atomic<int64_t> numReads_{0};
+};
+} // namespace
+
 class CacheTest : public ::testing::Test {
  protected:
   static constexpr int32_t kMaxStreams = 50;
@@ -560,6 +594,24 @@ TEST_F(CacheTest, bufferedInput) {
       fsStats_);
 }
 
+TEST_F(CacheTest, peerCache) {
+  initializeCache(160 << 20);
+  cache_->setPeerCache(std::make_shared<TestPeerCache>());
+  readLoop(
+      "testfile",
+      30,
+      70,
+      10,
+      20,
+      4,
+      /*noCacheRetention=*/false,
+      ioStats_,
+      fsStats_);
+  // The entries the peer does not have are read from storage.
+  EXPECT_GT(ioStats_->peerRead().sum(), 0);
+  EXPECT_GT(ioStats_->read().sum(), 0);
+}
+
 // Calibrates the data read for a densely and sparsely read stripe of test data.
 // Fills the SSD cache with test data. Reads 2x cache size worth of data and
 // checks that the cache population settles to a stable state.  Shifts the
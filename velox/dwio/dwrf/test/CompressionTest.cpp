@@ -22,8 +22,12 @@
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <folly/Random.h>
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
+#include <zlib.h>
+#include <zstd.h>
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/CompressionAccelerator.h"
 
 #include <algorithm>
 
@@ -35,6 +39,8 @@ using namespace facebook::velox::dwio::common::encryption;
 using namespace facebook::velox::dwio::common::encryption::test;
 using namespace facebook::velox::dwrf;
 using namespace facebook::velox::memory;
+using facebook::velox::Expected;
+using facebook::velox::Status;
 using facebook::velox::VeloxException;
 
 const int32_t DEFAULT_MEM_STREAM_SIZE = 1024 * 1024 * 2; // 2M
@@ -285,6 +291,93 @@ TEST_P(CompressionTest, compressProtoBuf) {
   verifyProto(memSink, kind_, block, *pool_, ps, decrypter_);
 }
 
+// Decompresses ZLIB and ZSTD blocks in software. Rejects every other job as
+// if the submission queue of the device were full.
+class TestAccelerator : public CompressionAccelerator {
+ public:
+  std::string_view name() const override {
+    return "test";
+  }
+
+  bool supportsDecompression(CompressionKind kind) const override {
+    return kind == CompressionKind_ZLIB || kind == CompressionKind_ZSTD;
+  }
+
+  std::vector<folly::SemiFuture<Expected<uint64_t>>> submitDecompression(
+      CompressionKind kind,
+      folly::Range<const DecompressionJob*> jobs) override {
+    std::vector<folly::SemiFuture<Expected<uint64_t>>> futures;
+    for (const auto& job : jobs) {
+      if (numJobs_++ % 2 == 1) {
+        break;
+      }
+      futures.push_back(folly::makeSemiFuture(decompressBlock(kind, job)));
+    }
+    return futures;
+  }
+
+ private:
+  static Expected<uint64_t> decompressBlock(
+      CompressionKind kind,
+      const DecompressionJob& job) {
+    if (kind == CompressionKind_ZSTD) {
+      const auto length = ZSTD_decompress(
+          job.output, job.outputLength, job.input, job.inputLength);
+      if (ZSTD_isError(length)) {
+        return folly::makeUnexpected(
+            Status::IOError(ZSTD_getErrorName(length)));
+      }
+      return length;
+    }
+    z_stream stream{};
+    if (inflateInit2(&stream, Compressor::DWRF_ORC_ZLIB_WINDOW_BITS) !=
+        Z_OK) {
+      return folly::makeUnexpected(Status::IOError("inflateInit2 failed"));
+    }
+    stream.next_in = const_cast<Bytef*>(job.input);
+    stream.avail_in = job.inputLength;
+    stream.next_out = job.output;
+    stream.avail_out = job.outputLength;
+    const auto result = inflate(&stream, Z_FINISH);
+    const auto length = stream.total_out;
+    inflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+      return folly::makeUnexpected(Status::IOError("inflate failed"));
+    }
+    return length;
+  }
+
+  uint64_t numJobs_{0};
+};
+
+TEST_P(CompressionTest, accelerator) {
+  if (kind_ == CompressionKind_NONE) {
+    return;
+  }
+  auto accelerator = std::make_shared<TestAccelerator>();
+  registerCompressionAccelerator(accelerator);
+  SCOPE_EXIT {
+    registerCompressionAccelerator(nullptr);
+  };
+
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool_.get()});
+  uint64_t block = 1024;
+  constexpr size_t dataSize = 64 * 1024;
+  char testData[dataSize];
+  generateRandomData(testData, dataSize, true);
+  compressAndVerify(
+      kind_, memSink, block, *pool_, testData, dataSize, encrypter_);
+  decompressAndVerify(
+      memSink, kind_, block, testData, dataSize, *pool_, decrypter_);
+
+  // Every other block is decompressed in software.
+  const auto stats = accelerator->stats();
+  ASSERT_GT(stats.numRejected, 0);
+  ASSERT_GE(stats.numAccelerated, stats.numRejected);
+  ASSERT_LE(stats.numAccelerated, stats.numRejected + 1);
+  ASSERT_EQ(stats.numFailed, 0);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     TestCompression,
     CompressionTest,
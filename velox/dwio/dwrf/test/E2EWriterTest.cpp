@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -946,6 +947,116 @@ TEST_F(E2EWriterTest, PartialStride) {
   ASSERT_EQ(true, reader->columnStatistics(1)->hasNull().value());
 }
 
+TEST_F(E2EWriterTest, parallelFlush) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<a:bigint,b:string,c:double,d:array<int>,e:map<int,string>,"
+      "f:struct<g:string,h:boolean>,i:string>");
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 4; ++i) {
+    batches.push_back(BatchMaker::createBatch(
+        type, 1'000, *leafPool_, nullptr, /*seed=*/i));
+  }
+
+  // Writes the batches in a stripe each and returns the file.
+  auto writeFile = [&](std::shared_ptr<folly::Executor> executor) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::COMPRESSION, common::CompressionKind_ZSTD);
+    auto sink = std::make_unique<MemorySink>(
+        16 * kSizeMB, FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = std::move(executor);
+    options.encodingParallelismFactor = 4;
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+      writer.flush();
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto serial = writeFile(nullptr);
+  const auto parallel =
+      writeFile(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  // The file does not depend on how the columns are scheduled.
+  ASSERT_EQ(parallel, serial);
+
+  auto reader = std::make_unique<dwrf::DwrfReader>(
+      dwio::common::ReaderOptions{leafPool_.get()},
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(std::string_view(parallel)),
+          *leafPool_));
+  ASSERT_EQ(reader->getNumberOfStripes(), batches.size());
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  VectorPtr result;
+  for (const auto& batch : batches) {
+    ASSERT_TRUE(rowReader->next(batch->size(), result));
+    ASSERT_EQ(result->size(), batch->size());
+    for (auto row = 0; row < batch->size(); ++row) {
+      ASSERT_TRUE(result->equalValueAt(batch.get(), row, row)) << row;
+    }
+  }
+  ASSERT_FALSE(rowReader->next(1, result));
+}
+
+TEST_F(E2EWriterTest, earlyDictionaryCheck) {
+  auto type = ROW({"unique", "repeated"}, {VARCHAR(), VARCHAR()});
+  VectorMaker maker(leafPool_.get());
+  auto makeBatch = [&](vector_size_t first, vector_size_t size) {
+    return maker.rowVector(
+        {maker.flatVector<std::string>(
+             size,
+             [&](auto row) { return fmt::format("unique {}", first + row); }),
+         maker.flatVector<std::string>(size, [](auto row) {
+           return fmt::format("repeated {}", row % 10);
+         })});
+  };
+
+  int64_t dictionaryBytes[2];
+  std::string files[2];
+  for (auto earlyCheck : {false, true}) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1000));
+    config->set(dwrf::Config::DICTIONARY_EARLY_CHECK, earlyCheck);
+    auto sink = std::make_unique<MemorySink>(
+        16 * kSizeMB, FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    dwrf::Writer writer{std::move(sink), options};
+    writer.write(makeBatch(0, 1'000));
+    writer.write(makeBatch(1'000, 10'000));
+    dictionaryBytes[earlyCheck] = writer.getContext().getMemoryUsage(
+        dwrf::MemoryUsageCategory::DICTIONARY);
+    writer.close();
+    files[earlyCheck] = std::string(sinkPtr->data(), sinkPtr->size());
+  }
+  // The unique column goes direct after the first stride instead of building
+  // a dictionary until the flush.
+  EXPECT_LT(dictionaryBytes[true], dictionaryBytes[false]);
+
+  auto reader = std::make_unique<dwrf::DwrfReader>(
+      dwio::common::ReaderOptions{leafPool_.get()},
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(std::string_view(files[true])),
+          *leafPool_));
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  auto expected = makeBatch(0, 11'000);
+  VectorPtr result;
+  ASSERT_TRUE(rowReader->next(expected->size(), result));
+  ASSERT_EQ(result->size(), expected->size());
+  for (auto row = 0; row < result->size(); ++row) {
+    ASSERT_TRUE(result->equalValueAt(expected.get(), row, row)) << row;
+  }
+}
+
 TEST_F(E2EWriterTest, OversizeRows) {
   auto pool = facebook::velox::memory::memoryManager()->addLeafPool();
 
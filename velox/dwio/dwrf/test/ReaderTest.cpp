@@ -2266,6 +2266,53 @@ TEST_F(TestReader, failToReuseReaderNulls) {
   }
 }
 
+TEST_F(TestReader, parallelDecoding) {
+  constexpr int32_t kNumColumns = 8;
+  constexpr int32_t kSize = 1'000;
+  std::vector<VectorPtr> columns;
+  for (auto i = 0; i < kNumColumns; ++i) {
+    if (i % 2 == 0) {
+      columns.push_back(makeFlatVector<int64_t>(
+          kSize, [i](auto row) { return row * i; }, nullEvery(7 + i)));
+    } else {
+      columns.push_back(makeFlatVector<std::string>(
+          kSize, [i](auto row) { return fmt::format("{}-{}", i, row); }));
+    }
+  }
+  auto data = makeRowVector(columns);
+  auto schema = asRowType(data->type());
+  auto [writer, reader] = createWriterReader({data}, pool());
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*schema);
+  // Keeps the rows under 500.
+  spec->childByName("c1")->setFilter(std::make_unique<common::BytesRange>(
+      "1-0", false, false, "1-5", false, true, false));
+
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  rowReaderOpts.setDecodingExecutor(executor);
+  rowReaderOpts.setDecodingParallelismFactor(4);
+  for (const auto minCells :
+       {uint64_t{0}, std::numeric_limits<uint64_t>::max()}) {
+    SCOPED_TRACE(fmt::format("minCells {}", minCells));
+    rowReaderOpts.setParallelDecodeMinCells(minCells);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(schema, 0, pool());
+    ASSERT_EQ(rowReader->next(kSize, result), kSize);
+    auto* rowVector = result->asUnchecked<RowVector>();
+    // The children are decoded by the reader instead of loaded lazily when
+    // the batch is large enough.
+    ASSERT_EQ(rowVector->childAt(0)->isLazy(), minCells > 0);
+    ASSERT_EQ(result->size(), 500);
+    result = BaseVector::loadedVectorShared(result);
+    for (auto i = 0; i < result->size(); ++i) {
+      ASSERT_TRUE(result->equalValueAt(data.get(), i, i))
+          << result->toString(i);
+    }
+  }
+}
+
 TEST_F(TestReader, readFlatMapsSomeEmpty) {
   // Test reading a flat map where the key filter means that some maps are
   // empty.
@@ -2345,6 +2392,79 @@ TEST_F(TestReader, readFlatMapsSomeEmpty) {
   validate(3, 2, {1, 2}, {12, 13});
 }
 
+TEST_F(TestReader, readFlatMapKeysOnly) {
+  // Row i is null if i % 7 == 3 and otherwise has the keys k of [0, 10) with
+  // (i + k) % 3 != 0.
+  constexpr int32_t kSize = 1'000;
+  auto keyName = [](int32_t k) {
+    return fmt::format("a feature key longer than inline {}", k);
+  };
+  std::vector<vector_size_t> offsets;
+  std::vector<std::string> keyStrings;
+  std::vector<vector_size_t> nullRows;
+  for (auto i = 0; i < kSize; ++i) {
+    offsets.push_back(keyStrings.size());
+    if (i % 7 == 3) {
+      nullRows.push_back(i);
+      continue;
+    }
+    for (auto k = 0; k < 10; ++k) {
+      if ((i + k) % 3 != 0) {
+        keyStrings.push_back(keyName(k));
+      }
+    }
+  }
+  offsets.push_back(keyStrings.size());
+  auto maps = makeMapVector(
+      offsets,
+      makeFlatVector(keyStrings),
+      makeFlatVector<int64_t>(keyStrings.size(), folly::identity),
+      nullRows);
+  auto row = makeRowVector({"a"}, {maps});
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set(dwrf::Config::MAP_FLAT_COLS, {0});
+  auto [writer, reader] = createWriterReader({row}, pool(), config);
+
+  auto schema = asRowType(row->type());
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*schema);
+  // Only the keys are needed, so the values are a null constant.
+  spec->childByName("a")
+      ->childByName(common::ScanSpec::kMapValuesFieldName)
+      ->setConstantValue(BaseVector::createNullConstant(BIGINT(), 1, pool()));
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  VectorPtr batch = BaseVector::create(schema, 0, pool());
+  vector_size_t firstRow = 0;
+  while (rowReader->next(64, batch)) {
+    auto* resultMaps =
+        batch->as<RowVector>()->childAt(0)->loadedVector()->as<MapVector>();
+    ASSERT_TRUE(resultMaps->mapValues()->isConstantEncoding());
+    auto* resultKeys = resultMaps->mapKeys()->asFlatVector<StringView>();
+    for (auto i = 0; i < resultMaps->size(); ++i) {
+      const auto expectedRow = firstRow + i;
+      ASSERT_EQ(resultMaps->isNullAt(i), maps->isNullAt(expectedRow)) << i;
+      if (maps->isNullAt(expectedRow)) {
+        continue;
+      }
+      ASSERT_EQ(resultMaps->sizeAt(i), maps->sizeAt(expectedRow));
+      std::unordered_set<std::string> keySet;
+      for (auto j = 0; j < resultMaps->sizeAt(i); ++j) {
+        keySet.insert(resultKeys->valueAt(resultMaps->offsetAt(i) + j).str());
+        ASSERT_TRUE(resultMaps->mapValues()->isNullAt(
+            resultMaps->offsetAt(i) + j));
+      }
+      for (auto k = 0; k < 10; ++k) {
+        ASSERT_EQ(keySet.count(keyName(k)), (expectedRow + k) % 3 != 0);
+      }
+    }
+    firstRow += resultMaps->size();
+  }
+  ASSERT_EQ(firstRow, kSize);
+}
+
 TEST_F(TestReader, readFlatMapsWithNullMaps) {
   // Test reading a flat map where the key filter means that some maps are
   // empty.
@@ -2474,6 +2594,75 @@ TEST_F(TestReader, readStructWithWholeBatchFiltered) {
   }
 }
 
+TEST_F(TestReader, bloomFilter) {
+  constexpr int32_t kSize = 10'000;
+  // Every stride has values over the whole range, so that the statistics of
+  // the strides do not drop any.
+  auto valueAt = [](auto row) { return (row * 7'919) % kSize; };
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(kSize, valueAt),
+      makeFlatVector<std::string>(
+          kSize, [&](auto row) { return fmt::format("key {}", valueAt(row)); }),
+  });
+  for (auto withBloomFilter : {false, true}) {
+    SCOPED_TRACE(fmt::format("withBloomFilter {}", withBloomFilter));
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1'000));
+    if (withBloomFilter) {
+      config->set(Config::BLOOM_FILTER_COLUMNS, {0, 1});
+    }
+    auto [writer, reader] = createWriterReader({batch}, pool(), config);
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*reader->rowType());
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+
+    auto readMatches = [&](int64_t& skippedStrides) {
+      spec->resetCachedValues(true);
+      auto rowReader = reader->createRowReader(rowReaderOpts);
+      auto result = BaseVector::create(reader->rowType(), 0, pool());
+      int64_t numMatches = 0;
+      while (rowReader->next(kSize, result)) {
+        numMatches += result->size();
+      }
+      dwio::common::RuntimeStatistics stats;
+      rowReader->updateRuntimeStats(stats);
+      skippedStrides = stats.skippedStrides;
+      return numMatches;
+    };
+
+    int64_t skippedStrides;
+    spec->childByName("c0")->setFilter(
+        common::createBigintValues({1'234, 5'678}, false));
+    ASSERT_EQ(readMatches(skippedStrides), 2);
+    // The bloom filters drop the strides without either value, leaving at
+    // most a false positive or two.
+    if (withBloomFilter) {
+      ASSERT_GE(skippedStrides, 6);
+    } else {
+      ASSERT_EQ(skippedStrides, 0);
+    }
+
+    spec->childByName("c0")->setFilter(nullptr);
+    spec->childByName("c1")->setFilter(std::make_unique<common::BytesValues>(
+        std::vector<std::string>{"key 4321"}, false));
+    ASSERT_EQ(readMatches(skippedStrides), 1);
+    if (withBloomFilter) {
+      ASSERT_GE(skippedStrides, 7);
+    } else {
+      ASSERT_EQ(skippedStrides, 0);
+    }
+
+    // A range filter does not use the bloom filters.
+    spec->childByName("c1")->setFilter(nullptr);
+    spec->childByName("c0")->setFilter(
+        std::make_unique<common::BigintRange>(1'000, 1'099, false));
+    ASSERT_EQ(readMatches(skippedStrides), 100);
+    ASSERT_EQ(skippedStrides, 0);
+    spec->childByName("c0")->setFilter(nullptr);
+  }
+}
+
 TEST_F(TestReader, readStringDictionaryAsFlat) {
   std::vector<std::string> dictionary;
   for (int i = 0; i < 26; ++i) {
@@ -2508,6 +2697,11 @@ TEST_F(TestReader, readStringDictionaryAsFlat) {
   ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
   ASSERT_TRUE(c0->valueVector()->isFlatEncoding());
   ASSERT_EQ(c0->valueVector()->size(), dictionary.size());
+  // The dictionary is all ASCII, which the values carry.
+  ASSERT_EQ(
+      c0->valueVector()->asUnchecked<SimpleVector<StringView>>()->isAscii(
+          SelectivityVector(dictionary.size())),
+      true);
   dwio::common::RuntimeStatistics stats;
   rowReader->updateRuntimeStats(stats);
   ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 0);
@@ -2518,6 +2712,12 @@ TEST_F(TestReader, readStringDictionaryAsFlat) {
   ASSERT_EQ(rowReader->next(20, actual), 20);
   ASSERT_EQ(actual->size(), 1);
   ASSERT_TRUE(actual->as<RowVector>()->childAt(0)->isFlatEncoding());
+  ASSERT_EQ(
+      actual->as<RowVector>()
+          ->childAt(0)
+          ->asUnchecked<SimpleVector<StringView>>()
+          ->isAscii(SelectivityVector(1)),
+      true);
   stats = {};
   rowReader->updateRuntimeStats(stats);
   ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 1);
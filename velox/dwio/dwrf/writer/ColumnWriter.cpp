@@ -15,8 +15,12 @@
  */
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
+
+#include <deque>
+
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -32,6 +36,29 @@ using namespace facebook::velox::memory;
 
 namespace facebook::velox::dwrf {
 
+bool BaseColumnWriter::hasBloomFilter() const {
+  if (!isIndexEnabled() || sequence_ != 0 || type_.parent() == nullptr ||
+      type_.parent()->id() != 0) {
+    return false;
+  }
+  switch (type_.type()->kind()) {
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      if (type_.type()->isDecimal()) {
+        return false;
+      }
+      break;
+    case TypeKind::VARCHAR:
+      break;
+    default:
+      return false;
+  }
+  const auto& columns = getConfig(Config::BLOOM_FILTER_COLUMNS);
+  return std::find(columns.begin(), columns.end(), type_.column()) !=
+      columns.end();
+}
+
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
@@ -484,9 +511,15 @@ uint64_t IntegerColumnWriter<T>::write(
     // Decode and then write
     auto localDecoded = decode(slice, ranges);
     auto& decodedVector = localDecoded.get();
+    addToBloomFilter<T>(decodedVector, ranges);
     return writeDict(decodedVector, ranges);
   }
 
+  if (bloomFilter_) {
+    auto localDecoded = decode(slice, ranges);
+    addToBloomFilter<T>(localDecoded.get(), ranges);
+  }
+
   // If the input is not a flat vector we make a complete copy and convert
   // it to flat vector
   if (slice->encoding() != VectorEncoding::Simple::FLAT) {
@@ -1211,6 +1244,7 @@ uint64_t StringColumnWriter::write(
     const common::Ranges& ranges) {
   auto localDecoded = decode(slice, ranges);
   auto& decodedVector = localDecoded.get();
+  addToBloomFilter<StringView>(decodedVector, ranges);
 
   if (useDictionaryEncoding_) {
     return writeDict(decodedVector, ranges);
@@ -1729,18 +1763,62 @@ class StructColumnWriter : public BaseColumnWriter {
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
       std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
     BaseColumnWriter::flush(encodingFactory, encodingOverride);
+    if (flushInParallel()) {
+      flushChildrenInParallel(encodingFactory);
+      return;
+    }
     for (auto& c : children_) {
       c->flush(encodingFactory);
     }
   }
 
  private:
+  // True if the columns of the root are encoded and compressed in parallel
+  // on the encoding executor. A flush under memory arbitration stays on the
+  // arbitrating thread.
+  bool flushInParallel() const {
+    return isRoot() && children_.size() > 1 &&
+        context_.encodingExecutor() != nullptr &&
+        context_.encodingParallelismFactor() > 1 &&
+        !underMemoryArbitration();
+  }
+
+  // Flushes the children in parallel. The encodings of each child are
+  // collected apart and added in the order of the children, so that the
+  // footer does not depend on the scheduling.
+  void flushChildrenInParallel(
+      const std::function<proto::ColumnEncoding&(uint32_t)>& encodingFactory);
+
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
 };
 
+void StructColumnWriter::flushChildrenInParallel(
+    const std::function<proto::ColumnEncoding&(uint32_t)>& encodingFactory) {
+  // A deque keeps the references to the encodings valid as it grows.
+  std::vector<std::deque<std::pair<uint32_t, proto::ColumnEncoding>>>
+      childEncodings(children_.size());
+  ParallelFor(
+      context_.encodingExecutor(),
+      0,
+      children_.size(),
+      context_.encodingParallelismFactor())
+      .execute([&](size_t i) {
+        auto& encodings = childEncodings[i];
+        children_[i]->flush([&](uint32_t nodeId) -> proto::ColumnEncoding& {
+          return encodings.emplace_back(nodeId, proto::ColumnEncoding{})
+              .second;
+        });
+      });
+  for (auto& encodings : childEncodings) {
+    for (auto& [nodeId, encoding] : encodings) {
+      encodingFactory(nodeId).Swap(&encoding);
+    }
+  }
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
@@ -18,6 +18,7 @@
 
 #include "velox/common/base/GTestMacros.h"
 #include "velox/dwio/common/OutputStream.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 #include "velox/dwio/dwrf/common/ByteRLE.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/common/IntEncoder.h"
@@ -84,6 +85,10 @@ class BaseColumnWriter : public ColumnWriter {
     fileStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    if (bloomFilter_) {
+      bloomFilter_->toProto(*bloomFilterIndex_.add_bloomfilter());
+      bloomFilter_->reset();
+    }
     recordPosition();
     for (auto& child : children_) {
       child->createIndexEntry();
@@ -117,6 +122,11 @@ class BaseColumnWriter : public ColumnWriter {
     setEncoding(encoding);
     encodingOverride(encoding);
     indexBuilder_->flush();
+    if (bloomFilter_) {
+      bloomFilterIndex_.SerializeToZeroCopyStream(bloomFilterStream_.get());
+      bloomFilterStream_->flush();
+      bloomFilterIndex_.Clear();
+    }
   }
 
   uint64_t writeFileStats(std::function<proto::ColumnStatistics&(uint32_t)>
@@ -173,6 +183,33 @@ class BaseColumnWriter : public ColumnWriter {
         StatisticsBuilderOptions::fromConfig(context.getConfigs());
     indexStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
     fileStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
+    if (hasBloomFilter()) {
+      bloomFilter_ = std::make_unique<BloomFilter>(
+          context.indexStride(), getConfig(Config::BLOOM_FILTER_FPP));
+      bloomFilterStream_ = newStream(StreamKind::StreamKind_BLOOM_FILTER_UTF8);
+    }
+  }
+
+  // Adds the non-null values of 'decoded' in 'ranges' to the bloom filter of
+  // the current stride if the column has bloom filters.
+  template <typename T>
+  void addToBloomFilter(
+      const DecodedVector& decoded,
+      const common::Ranges& ranges) {
+    if (!bloomFilter_) {
+      return;
+    }
+    for (auto& pos : ranges) {
+      if (decoded.isNullAt(pos)) {
+        continue;
+      }
+      if constexpr (std::is_same_v<T, StringView>) {
+        const auto value = decoded.valueAt<StringView>(pos);
+        bloomFilter_->addBytes(std::string_view(value.data(), value.size()));
+      } else {
+        bloomFilter_->addLong(decoded.valueAt<T>(pos));
+      }
+    }
   }
 
   uint64_t writeNulls(const VectorPtr& slice, const common::Ranges& ranges) {
@@ -248,6 +285,10 @@ class BaseColumnWriter : public ColumnWriter {
     return context_.indexEnabled();
   }
 
+  // Returns true if the column is a top level integer or string column in
+  // Config::BLOOM_FILTER_COLUMNS.
+  bool hasBloomFilter() const;
+
   virtual bool useDictionaryEncoding() const {
     return (sequence_ == 0 ||
             !context_.getConfig(Config::MAP_FLAT_DISABLE_DICT_ENCODING)) &&
@@ -264,6 +305,11 @@ class BaseColumnWriter : public ColumnWriter {
   std::unique_ptr<StatisticsBuilder> indexStatsBuilder_;
   std::unique_ptr<StatisticsBuilder> fileStatsBuilder_;
   std::unique_ptr<ByteRleEncoder> present_;
+  // The bloom filter of the current stride and the bloom filters of the
+  // finished strides of the stripe, if the column has bloom filters.
+  std::unique_ptr<BloomFilter> bloomFilter_;
+  proto::BloomFilterIndex bloomFilterIndex_;
+  std::unique_ptr<BufferedOutputStream> bloomFilterStream_;
   bool hasNull_ = false;
   // callback used to inject the logic that captures positions for flat map
   // in_map stream
@@ -181,6 +181,9 @@ Writer::Writer(
       context.getTotalMemoryUsage(),
       0,
       "Unexpected memory usage on dwrf writer construction");
+  context.setEncodingExecutor(
+      options.encodingExecutor, options.encodingParallelismFactor);
+  earlyDictionaryCheck_ = context.getConfig(Config::DICTIONARY_EARLY_CHECK);
   setMemoryReclaimers(pool);
   writerBase_->initBuffers();
 
@@ -309,6 +312,12 @@ void Writer::write(const VectorPtr& input) {
         context.indexRowCount() >= context.indexStride()) {
       createRowIndexEntry();
     }
+
+    if (earlyDictionaryCheck_ &&
+        context.stripeRowCount() >= context.indexStride()) {
+      earlyDictionaryCheck_ = false;
+      writer_->tryAbandonDictionaries(/*force=*/false);
+    }
   }
 }
 
@@ -45,6 +45,11 @@ struct WriterOptions : public dwio::common::WriterOptions {
   const tz::TimeZone* sessionTimezone{nullptr};
   bool adjustTimestampToTimezone{false};
   DwrfFormat format{DwrfFormat::kDwrf};
+  /// Optional executor on which the columns of each stripe are encoded and
+  /// compressed in parallel at flush, using up to
+  /// 'encodingParallelismFactor' threads including the writing one.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
 
   void processConfigs(
       const config::ConfigBase& connectorConfig,
@@ -218,6 +223,9 @@ class Writer : public dwio::common::Writer {
   std::unique_ptr<DWRFFlushPolicy> flushPolicy_;
   std::unique_ptr<LayoutPlanner> layoutPlanner_;
   std::unique_ptr<ColumnWriter> writer_;
+  // True until the encodings are checked after the first stride of the first
+  // stripe if Config::DICTIONARY_EARLY_CHECK is set.
+  bool earlyDictionaryCheck_{false};
 };
 
 class DwrfWriterFactory : public dwio::common::WriterFactory {
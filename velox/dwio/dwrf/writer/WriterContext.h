@@ -17,6 +17,10 @@
 #pragma once
 
 #include <limits>
+#include <mutex>
+
+#include <folly/Executor.h>
+
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -50,10 +54,12 @@ class WriterContext : public CompressionBufferPool {
   ~WriterContext() override;
 
   bool hasStream(const DwrfStreamIdentifier& stream) const {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     return streams_.find(stream) != streams_.end();
   }
 
   const DataBufferHolder& getStream(const DwrfStreamIdentifier& stream) const {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     return streams_.at(stream);
   }
 
@@ -71,25 +77,29 @@ class WriterContext : public CompressionBufferPool {
   // so accounting for the memory usage can be inflated even aside from the
   // capacity vs actual usage problem. However, this is ok as an upperbound for
   // flush policy evaluation and would be more accurate after flush.
+  //
+  // The streams may be added by the column writers flushed in parallel.
   std::unique_ptr<BufferedOutputStream> newStream(
       const DwrfStreamIdentifier& stream) {
-    VELOX_CHECK(
-        !hasStream(stream), "Stream already exists: {}", stream.toString());
-
-    streams_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(stream),
-        std::forward_as_tuple(
-            getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
-            compressionBlockSize(),
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
-    auto& holder = streams_.at(stream);
+    DataBufferHolder* holder;
+    {
+      std::lock_guard<std::mutex> l(streamsMutex_);
+      auto [it, inserted] = streams_.emplace(
+          std::piecewise_construct,
+          std::forward_as_tuple(stream),
+          std::forward_as_tuple(
+              getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
+              compressionBlockSize(),
+              getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
+              getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
+      VELOX_CHECK(inserted, "Stream already exists: {}", stream.toString());
+      holder = &it->second;
+    }
     auto encrypter = handler_->isEncrypted(stream.encodingKey().node())
         ? std::addressof(
               handler_->getEncryptionProvider(stream.encodingKey().node()))
         : nullptr;
-    return newStream(compression_, holder, encrypter);
+    return newStream(compression_, *holder, encrypter);
   }
 
   std::unique_ptr<DataBufferHolder> newDataBufferHolder(
@@ -145,9 +155,10 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
-    VELOX_CHECK(hasStream(stream));
-    auto& collector = streams_.at(stream);
-    collector.suppress();
+    std::lock_guard<std::mutex> l(streamsMutex_);
+    auto it = streams_.find(stream);
+    VELOX_CHECK(it != streams_.end());
+    it->second.suppress();
   }
 
   bool isStreamPaged(uint32_t nodeId) const {
@@ -217,6 +228,25 @@ class WriterContext : public CompressionBufferPool {
     return *config_;
   }
 
+  /// Sets the executor on which the columns of a stripe are encoded and
+  /// compressed in parallel at flush, using up to 'parallelismFactor'
+  /// threads. The columns are flushed on the calling thread if 'executor' is
+  /// null or 'parallelismFactor' is at most 1.
+  void setEncodingExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelismFactor) {
+    encodingExecutor_ = std::move(executor);
+    encodingParallelismFactor_ = parallelismFactor;
+  }
+
+  const std::shared_ptr<folly::Executor>& encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
+  size_t encodingParallelismFactor() const {
+    return encodingParallelismFactor_;
+  }
+
   void iterateUnSuppressedStreams(
       std::function<void(
           std::pair<const DwrfStreamIdentifier, DataBufferHolder>&)> callback) {
@@ -256,19 +286,14 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  /// Returns the compression buffer. The streams compressed in parallel by
+  /// the column writers flushed on the encoding executor get extra buffers
+  /// from the general pool, which are kept for reuse.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
-      uint64_t size) override {
-    VELOX_CHECK_NOT_NULL(compressionBuffer_);
-    VELOX_CHECK_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
-  }
+      uint64_t size) override;
 
   void returnBuffer(
-      std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
-    VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
-  }
+      std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override;
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
     nodeSize_[node] += size;
@@ -648,6 +673,9 @@ class WriterContext : public CompressionBufferPool {
       DataBufferHolder,
       dwio::common::StreamIdentifierHash>
       streams_;
+  // Guards the additions to 'streams_', which may come from the column
+  // writers flushed in parallel.
+  mutable std::mutex streamsMutex_;
   folly::F14NodeMap<uint32_t, std::unique_ptr<PhysicalSizeAggregator>>
       physicalSizeAggregators_;
   folly::F14FastMap<
@@ -659,6 +687,13 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // The compression buffers allocated for the parallel flushes, guarded by
+  // 'compressionBufferMutex_' together with 'compressionBuffer_'.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      extraCompressionBuffers_;
+  std::mutex compressionBufferMutex_;
+  std::shared_ptr<folly::Executor> encodingExecutor_;
+  size_t encodingParallelismFactor_{0};
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <string>
 
 namespace facebook::velox::parquet {
 
@@ -159,6 +160,49 @@ BlockSplitBloomFilter BlockSplitBloomFilter::deserialize(
   return bloomFilter;
 }
 
+BlockSplitBloomFilter BlockSplitBloomFilter::read(
+    dwio::common::BufferedInput& input,
+    uint64_t offset,
+    memory::MemoryPool& pool) {
+  const uint64_t fileSize = input.getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileSize, "Bloom filter offset out of range");
+  const auto headerLength =
+      std::min<uint64_t>(kHeaderSizeGuess, fileSize - offset);
+  std::string headerBytes(headerLength, '\0');
+  input.read(offset, headerLength, dwio::common::LogType::STRIPE_INDEX)
+      ->readFully(headerBytes.data(), headerLength);
+
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      headerBytes.data(), headerLength);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  const uint32_t headerSize = header.read(&protocol);
+  validateBloomFilterHeader(header);
+
+  const uint32_t bloomFilterSize = header.numBytes;
+  BlockSplitBloomFilter bloomFilter(&pool);
+  if (headerSize + bloomFilterSize <= headerLength) {
+    bloomFilter.init(
+        reinterpret_cast<const uint8_t*>(headerBytes.data()) + headerSize,
+        bloomFilterSize);
+    return bloomFilter;
+  }
+  VELOX_CHECK_LE(
+      offset + headerSize + bloomFilterSize,
+      fileSize,
+      "Bloom filter extends past the end of the file");
+  auto buffer = AlignedBuffer::allocate<char>(bloomFilterSize, &pool);
+  input
+      .read(
+          offset + headerSize,
+          bloomFilterSize,
+          dwio::common::LogType::STRIPE_INDEX)
+      ->readFully(buffer->asMutable<char>(), bloomFilterSize);
+  bloomFilter.init(buffer->as<uint8_t>(), bloomFilterSize);
+  return bloomFilter;
+}
+
 void BlockSplitBloomFilter::writeTo(
     velox::dwio::common::AppendOnlyBufferedStream* sink) const {
   VELOX_CHECK(sink != nullptr);
@@ -308,9 +308,22 @@ class BlockSplitBloomFilter : public BloomFilter {
       dwio::common::SeekableInputStream* input_stream,
       memory::MemoryPool& pool);
 
+  /// Reads the Bloom filter at 'offset' of the file of 'input'. The header
+  /// is read first and the bitset then, so that no more than the Bloom
+  /// filter is read. The reads go through 'input', which keeps them in the
+  /// data cache if 'input' is cached.
+  static BlockSplitBloomFilter read(
+      dwio::common::BufferedInput& input,
+      uint64_t offset,
+      memory::MemoryPool& pool);
+
  private:
   inline void insertHashImpl(uint64_t hash);
 
+  // The number of bytes read for the header of a Bloom filter, which is
+  // usually much smaller.
+  static constexpr uint32_t kHeaderSizeGuess = 256;
+
   // Bytes in a tiny Bloom filter block.
   static constexpr int kBytesPerFilterBlock = 32;
 
@@ -30,7 +30,16 @@
 namespace facebook::velox::parquet {
 namespace {
 
-template <typename OffsetType>
+// Converts the levels of lists or of structs over lists to validity bits and
+// offsets or lengths. The levels are processed in batches of 64: the levels
+// that start a list, continue a list or are skipped are turned into bitmaps
+// with vectorized comparisons. The validity bits of the lists are the
+// extracted bits of the starts. The item counts are popcounts of the
+// continuations between consecutive starts, so that the work is per list
+// and not per level. If 'kLengths', 'offsets' gets the number of items of
+// each list and the items of a list started before 'defLevels' are not
+// counted. Otherwise 'offsets' gets cumulative offsets from offsets[0].
+template <typename OffsetType, bool kLengths = false>
 void DefRepLevelsToListInfo(
     const int16_t* defLevels,
     const int16_t* repLevels,
@@ -38,7 +47,6 @@ void DefRepLevelsToListInfo(
     LevelInfo levelInfo,
     ValidityBitmapInputOutput* output,
     OffsetType* offsets) {
-  OffsetType* origPos = offsets;
   std::optional<::arrow::internal::FirstTimeBitmapWriter> validBitsWriter;
   if (output->validBits) {
     validBitsWriter.emplace(
@@ -46,73 +54,106 @@ void DefRepLevelsToListInfo(
         output->validBitsOffset,
         output->valuesReadUpperBound);
   }
-  for (int x = 0; x < numDefLevels; x++) {
-    // Skip items that belong to empty or null ancestor lists and further nested
-    // lists.
-    if (defLevels[x] < levelInfo.repeatedAncestorDefLevel ||
-        repLevels[x] > levelInfo.repLevel) {
-      continue;
+  int64_t numLists = 0;
+  // The offset of the end of the current list, i.e. offsets[numLists].
+  int64_t offset = (offsets != nullptr && !kLengths) ? offsets[0] : 0;
+  // Adds 'numItems' items to the current list.
+  auto addItems = [&](int64_t numItems) {
+    if (FOLLY_UNLIKELY(
+            offset > std::numeric_limits<OffsetType>::max() - numItems)) {
+      VELOX_FAIL("List index overflow.");
     }
-
-    if (repLevels[x] == levelInfo.repLevel) {
-      // A continuation of an existing list.
-      // offsets can be null for structs with repeated children (we don't need
-      // to know offsets until we get to the children).
-      if (offsets != nullptr) {
-        if (FOLLY_UNLIKELY(
-                *offsets == std::numeric_limits<OffsetType>::max())) {
-          VELOX_FAIL("List index overflow.");
-        }
-        *offsets += 1;
+    offset += numItems;
+    if constexpr (kLengths) {
+      if (numLists > 0) {
+        offsets[numLists - 1] += numItems;
       }
+    } else {
+      offsets[numLists] = offset;
+    }
+  };
+  // Starts a list with 1 item if 'present' and no items otherwise.
+  auto startList = [&](bool present) {
+    ++numLists;
+    if constexpr (kLengths) {
+      offset = present;
+      offsets[numLists - 1] = present;
     } else {
       if (FOLLY_UNLIKELY(
-              (validBitsWriter.has_value() &&
-               validBitsWriter->position() >= output->valuesReadUpperBound) ||
-              (offsets - origPos) >= output->valuesReadUpperBound)) {
-        VELOX_FAIL(
-            "Definition levels exceeded upper bound: {}",
-            output->valuesReadUpperBound);
+              present && offset == std::numeric_limits<OffsetType>::max())) {
+        VELOX_FAIL("List index overflow.");
       }
+      offset += present;
+      offsets[numLists] = offset;
+    }
+  };
+
+  for (int64_t begin = 0; begin < numDefLevels; begin += kExtractBitsSize) {
+    const int64_t batchSize =
+        std::min<int64_t>(kExtractBitsSize, numDefLevels - begin);
+    const int16_t* defs = defLevels + begin;
+    const int16_t* reps = repLevels + begin;
+    const uint64_t batchMask = batchSize == kExtractBitsSize
+        ? ~uint64_t{0}
+        : (uint64_t{1} << batchSize) - 1;
+    // Items of empty or null ancestor lists and of further nested lists.
+    const uint64_t skipped =
+        (~GreaterThanBitmap(
+             defs, batchSize, levelInfo.repeatedAncestorDefLevel - 1) |
+         GreaterThanBitmap(reps, batchSize, levelInfo.repLevel)) &
+        batchMask;
+    // A repetition level equal to the level of the list continues it. A
+    // lower one starts a list.
+    const uint64_t atListLevel =
+        GreaterThanBitmap(reps, batchSize, levelInfo.repLevel - 1);
+    const uint64_t continued = atListLevel & ~skipped;
+    const uint64_t starts = ~atListLevel & ~skipped & batchMask;
+    const int64_t numStarts = ::arrow::bit_util::PopCount(starts);
+    if (FOLLY_UNLIKELY(numLists + numStarts > output->valuesReadUpperBound)) {
+      VELOX_FAIL(
+          "Definition levels exceeded upper bound: {}",
+          output->valuesReadUpperBound);
+    }
 
-      // current_rep < list repLevel i.e. start of a list (ancestor empty lists
-      // are filtered out above). offsets can be null for structs with repeated
-      // children (we don't need to know offsets until we get to the children).
-      if (offsets != nullptr) {
-        ++offsets;
-        // Use cumulative offsets because variable size lists are more common
-        // than fixed size lists so it should be cheaper to make these
-        // cumulative and subtract when validating fixed size lists.
-        *offsets = *(offsets - 1);
-        if (defLevels[x] >= levelInfo.defLevel) {
-          if (FOLLY_UNLIKELY(
-                  *offsets == std::numeric_limits<OffsetType>::max())) {
-            VELOX_FAIL("List index overflow.");
-          }
-          *offsets += 1;
-        }
-      }
+    if (validBitsWriter.has_value()) {
+      // The levelInfo def level for lists reflects element present level.
+      // The prior level distinguishes between empty lists.
+      const uint64_t valid = ExtractBits(
+          GreaterThanBitmap(defs, batchSize, levelInfo.defLevel - 2), starts);
+      validBitsWriter->AppendWord(valid, numStarts);
+      output->nullCount += numStarts - ::arrow::bit_util::PopCount(valid);
+    }
 
-      if (validBitsWriter.has_value()) {
-        // the levelInfo def level for lists reflects element present level.
-        // the prior level distinguishes between empty lists.
-        if (defLevels[x] >= levelInfo.defLevel - 1) {
-          validBitsWriter->Set();
-        } else {
-          output->nullCount++;
-          validBitsWriter->Clear();
-        }
-        validBitsWriter->Next();
+    if (offsets == nullptr) {
+      // Offsets can be null for structs with repeated children (we don't
+      // need to know offsets until we get to the children).
+      numLists += numStarts;
+      continue;
+    }
+    const uint64_t present =
+        GreaterThanBitmap(defs, batchSize, levelInfo.defLevel - 1);
+    uint64_t pendingStarts = starts;
+    uint64_t pendingItems = continued;
+    while (pendingStarts != 0) {
+      const uint64_t start = pendingStarts & (~pendingStarts + 1);
+      const uint64_t items = pendingItems & (start - 1);
+      if (items != 0) {
+        addItems(::arrow::bit_util::PopCount(items));
+        pendingItems &= ~items;
       }
+      startList((present & start) != 0);
+      pendingStarts &= pendingStarts - 1;
+    }
+    if (pendingItems != 0) {
+      addItems(::arrow::bit_util::PopCount(pendingItems));
     }
   }
+
   if (validBitsWriter.has_value()) {
     validBitsWriter->Finish();
   }
-  if (offsets != nullptr) {
-    output->valuesRead = offsets - origPos;
-  } else if (validBitsWriter.has_value()) {
-    output->valuesRead = validBitsWriter->position();
+  if (offsets != nullptr || validBitsWriter.has_value()) {
+    output->valuesRead = numLists;
   }
   if (output->nullCount > 0 && levelInfo.nullSlotUsage > 1) {
     VELOX_FAIL(
@@ -165,6 +206,17 @@ void DefRepLevelsToList(
       defLevels, repLevels, numDefLevels, levelInfo, output, offsets);
 }
 
+void DefRepLevelsToLengths(
+    const int16_t* defLevels,
+    const int16_t* repLevels,
+    int64_t numDefLevels,
+    LevelInfo levelInfo,
+    ValidityBitmapInputOutput* output,
+    int32_t* lengths) {
+  DefRepLevelsToListInfo<int32_t, /*kLengths=*/true>(
+      defLevels, repLevels, numDefLevels, levelInfo, output, lengths);
+}
+
 void DefRepLevelsToBitmap(
     const int16_t* defLevels,
     const int16_t* repLevels,
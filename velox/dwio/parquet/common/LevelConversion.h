@@ -173,6 +173,18 @@ void DefRepLevelsToList(
     ValidityBitmapInputOutput* output,
     int64_t* offsets);
 
+// Same as DefRepLevelsToList but writes the number of items of each list to
+// 'lengths' instead of offsets. The items of a list started before
+// 'defLevels' are not counted. Lengths must be sized to
+// valuesReadUpperBound.
+void DefRepLevelsToLengths(
+    const int16_t* defLevels,
+    const int16_t* repLevels,
+    int64_t numDefLevels,
+    LevelInfo levelInfo,
+    ValidityBitmapInputOutput* output,
+    int32_t* lengths);
+
 // Reconstructs a validity bitmap for a struct every member is a list or has
 // a list descendant.  See documentation on DefLevelsToBitmap for when more
 // details on this method compared to the other ones defined above.
@@ -25,6 +25,7 @@
 #include "arrow/util/bit_util.h"
 #include "arrow/util/bitmap_writer.h"
 
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/dwio/parquet/common/LevelComparison.h"
 
@@ -257,7 +258,11 @@ using extractBitmapT = uint64_t;
 inline extractBitmapT ExtractBits(
     extractBitmapT bitmap,
     extractBitmapT selectBitmap) {
+#ifdef __BMI2__
+  return bits::extractBits<uint64_t>(bitmap, selectBitmap);
+#else
   return ExtractBitsSoftware(bitmap, selectBitmap);
+#endif
 }
 
 static constexpr int64_t kExtractBitsSize = 8 * sizeof(extractBitmapT);
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilterPruning.h"
+
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+using common::FilterKind;
+
+template <typename T>
+const T& as(const common::Filter& filter) {
+  return static_cast<const T&>(filter);
+}
+
+// Returns the number of values passing 'filter' if it is an equality or an
+// IN list on integers or strings, 0 otherwise.
+size_t numFilterValues(const common::Filter& filter) {
+  switch (filter.kind()) {
+    case FilterKind::kBigintRange:
+      return as<common::BigintRange>(filter).isSingleValue() ? 1 : 0;
+    case FilterKind::kBigintValuesUsingHashTable:
+      return as<common::BigintValuesUsingHashTable>(filter).values().size();
+    case FilterKind::kBigintValuesUsingBitmask:
+      return as<common::BigintValuesUsingBitmask>(filter).values().size();
+    case FilterKind::kBytesRange:
+      return as<common::BytesRange>(filter).isSingleValue() ? 1 : 0;
+    case FilterKind::kBytesValues:
+      return as<common::BytesValues>(filter).values().size();
+    default:
+      return 0;
+  }
+}
+
+bool isIntegerFilter(const common::Filter& filter) {
+  return filter.kind() == FilterKind::kBigintRange ||
+      filter.kind() == FilterKind::kBigintValuesUsingHashTable ||
+      filter.kind() == FilterKind::kBigintValuesUsingBitmask;
+}
+
+std::vector<int64_t> integerFilterValues(const common::Filter& filter) {
+  switch (filter.kind()) {
+    case FilterKind::kBigintRange:
+      return {as<common::BigintRange>(filter).lower()};
+    case FilterKind::kBigintValuesUsingHashTable:
+      return as<common::BigintValuesUsingHashTable>(filter).values();
+    case FilterKind::kBigintValuesUsingBitmask:
+      return as<common::BigintValuesUsingBitmask>(filter).values();
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+bool containsString(const BloomFilter& bloomFilter, std::string_view value) {
+  const ByteArray byteArray(value);
+  return bloomFilter.findHash(bloomFilter.hash(&byteArray));
+}
+
+} // namespace
+
+bool canTestBloomFilter(const common::Filter& filter, thrift::Type::type type) {
+  if (filter.testNull()) {
+    return false;
+  }
+  const auto numValues = numFilterValues(filter);
+  if (numValues == 0 || numValues > kMaxBloomFilterLookups) {
+    return false;
+  }
+  switch (type) {
+    case thrift::Type::INT32:
+    case thrift::Type::INT64:
+      return isIntegerFilter(filter);
+    case thrift::Type::BYTE_ARRAY:
+      return !isIntegerFilter(filter);
+    default:
+      return false;
+  }
+}
+
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type type) {
+  if (type == thrift::Type::BYTE_ARRAY) {
+    if (filter.kind() == FilterKind::kBytesRange) {
+      return containsString(
+          bloomFilter, as<common::BytesRange>(filter).lower());
+    }
+    for (const auto& value : as<common::BytesValues>(filter).values()) {
+      if (containsString(bloomFilter, value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  for (auto value : integerFilterValues(filter)) {
+    if (type == thrift::Type::INT32) {
+      // The values outside of the range of the column are not in it.
+      if (value < std::numeric_limits<int32_t>::min() ||
+          value > std::numeric_limits<int32_t>::max()) {
+        continue;
+      }
+      if (bloomFilter.findHash(
+              bloomFilter.hash(static_cast<int32_t>(value)))) {
+        return true;
+      }
+    } else if (bloomFilter.findHash(bloomFilter.hash(value))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/common/BloomFilter.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// The maximum number of values of an IN filter looked up in a Bloom filter.
+/// Larger lists are unlikely to miss all the values of a row group and take
+/// more time to look up than they save.
+constexpr int32_t kMaxBloomFilterLookups = 1'024;
+
+/// Returns true if the values passing 'filter' are a short list of non-null
+/// values that can be looked up in the Bloom filter of a column of physical
+/// type 'type', i.e. the filter is an equality or an IN list and does not
+/// pass nulls. Nulls are not in Bloom filters.
+bool canTestBloomFilter(const common::Filter& filter, thrift::Type::type type);
+
+/// Returns false if none of the values passing 'filter' is in 'bloomFilter'
+/// of a column of physical type 'type'. 'filter' must be one for which
+/// canTestBloomFilter() is true.
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type type);
+
+} // namespace facebook::velox::parquet
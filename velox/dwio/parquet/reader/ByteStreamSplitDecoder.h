@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <xsimd/xsimd.hpp>
+
+#include <cstdint>
+
+namespace facebook::velox::parquet {
+
+namespace detail {
+
+// Transposes 'numValues' values of 'kWidth' bytes from 'kWidth' streams of
+// 'numValues' bytes at 'data' to consecutive values at 'out'. A batch of
+// bytes of each stream is interleaved with log2(kWidth) rounds of byte
+// zips, which is the transpose of a 'kWidth' x batch size byte matrix.
+template <int32_t kWidth>
+void byteStreamSplitTranspose(
+    const uint8_t* data,
+    int64_t numValues,
+    uint8_t* out) {
+  static_assert((kWidth & (kWidth - 1)) == 0);
+  using Batch = xsimd::batch<uint8_t>;
+  constexpr int32_t kBatchSize = Batch::size;
+  int64_t i = 0;
+  for (; i + kBatchSize <= numValues; i += kBatchSize) {
+    Batch streams[kWidth];
+    for (int32_t k = 0; k < kWidth; ++k) {
+      streams[k] = Batch::load_unaligned(data + k * numValues + i);
+    }
+    for (int32_t round = 1; round < kWidth; round *= 2) {
+      Batch zipped[kWidth];
+      for (int32_t k = 0; k < kWidth / 2; ++k) {
+        zipped[2 * k] = xsimd::zip_lo(streams[k], streams[k + kWidth / 2]);
+        zipped[2 * k + 1] =
+            xsimd::zip_hi(streams[k], streams[k + kWidth / 2]);
+      }
+      for (int32_t k = 0; k < kWidth; ++k) {
+        streams[k] = zipped[k];
+      }
+    }
+    for (int32_t k = 0; k < kWidth; ++k) {
+      streams[k].store_unaligned(out + i * kWidth + k * kBatchSize);
+    }
+  }
+  for (; i < numValues; ++i) {
+    for (int32_t k = 0; k < kWidth; ++k) {
+      out[i * kWidth + k] = data[k * numValues + i];
+    }
+  }
+}
+
+} // namespace detail
+
+/// Decodes a BYTE_STREAM_SPLIT encoded page of 'numValues' values of 'width'
+/// bytes at 'data' into the PLAIN layout at 'out'. The encoding stores byte
+/// k of each value in stream k, so that the similar high bytes of floating
+/// point values compress well. The page is decoded in one pass so that the
+/// values can then be read and filtered like PLAIN values.
+inline void byteStreamSplitToPlain(
+    const char* data,
+    int64_t numValues,
+    int32_t width,
+    char* out) {
+  const auto* input = reinterpret_cast<const uint8_t*>(data);
+  auto* output = reinterpret_cast<uint8_t*>(out);
+  switch (width) {
+    case 2:
+      detail::byteStreamSplitTranspose<2>(input, numValues, output);
+      break;
+    case 4:
+      detail::byteStreamSplitTranspose<4>(input, numValues, output);
+      break;
+    case 8:
+      detail::byteStreamSplitTranspose<8>(input, numValues, output);
+      break;
+    case 16:
+      detail::byteStreamSplitTranspose<16>(input, numValues, output);
+      break;
+    default:
+      for (int64_t i = 0; i < numValues; ++i) {
+        for (int32_t k = 0; k < width; ++k) {
+          output[i * width + k] = input[k * numValues + i];
+        }
+      }
+  }
+}
+
+} // namespace facebook::velox::parquet
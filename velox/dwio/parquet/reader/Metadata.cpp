@@ -243,6 +243,21 @@ int64_t ColumnChunkMetaDataPtr::dictionaryPageOffset() const {
   return thriftColumnChunkPtr(ptr_)->meta_data.dictionary_page_offset;
 }
 
+bool ColumnChunkMetaDataPtr::hasOffsetIndex() const {
+  return thriftColumnChunkPtr(ptr_)->__isset.offset_index_offset &&
+      thriftColumnChunkPtr(ptr_)->__isset.offset_index_length;
+}
+
+int64_t ColumnChunkMetaDataPtr::offsetIndexOffset() const {
+  VELOX_CHECK(hasOffsetIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::offsetIndexLength() const {
+  VELOX_CHECK(hasOffsetIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_length;
+}
+
 common::CompressionKind ColumnChunkMetaDataPtr::compression() const {
   return thriftCodecToCompressionKind(
       thriftColumnChunkPtr(ptr_)->meta_data.codec);
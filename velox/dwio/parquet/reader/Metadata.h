@@ -21,6 +21,17 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+} // namespace thrift
+
+/// Returns the ColumnStatistics of 'type' for the min, max and null count in
+/// 'columnChunkStats', which cover 'numRowsInRowGroup' rows.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& columnChunkStats,
+    const velox::Type& type,
+    uint64_t numRowsInRowGroup);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -61,6 +72,14 @@ class ColumnChunkMetaDataPtr {
   /// Must check for its presence using hasDictionaryPageOffset().
   int64_t dictionaryPageOffset() const;
 
+  /// Check the presence of the OffsetIndex of the column chunk.
+  bool hasOffsetIndex() const;
+
+  /// The file offset and the length of the OffsetIndex. Must check for its
+  /// presence using hasOffsetIndex().
+  int64_t offsetIndexOffset() const;
+  int32_t offsetIndexLength() const;
+
   /// The compression.
   common::CompressionKind compression() const;
 
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+template <typename T>
+T readPageIndex(dwio::common::SeekableInputStream& stream, int32_t length) {
+  std::vector<char> copy(length);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, &stream, copy.data(), bufferStart, bufferEnd);
+  auto transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(copy.data(), length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T index;
+  index.read(&protocol);
+  return index;
+}
+
+template <typename T>
+T readPageIndex(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    int32_t length) {
+  auto stream =
+      input.read(offset, length, dwio::common::LogType::STRIPE_INDEX);
+  return readPageIndex<T>(*stream, length);
+}
+
+template thrift::ColumnIndex readPageIndex<thrift::ColumnIndex>(
+    dwio::common::SeekableInputStream&,
+    int32_t);
+template thrift::OffsetIndex readPageIndex<thrift::OffsetIndex>(
+    dwio::common::SeekableInputStream&,
+    int32_t);
+template thrift::ColumnIndex readPageIndex<thrift::ColumnIndex>(
+    dwio::common::BufferedInput&,
+    int64_t,
+    int32_t);
+template thrift::OffsetIndex readPageIndex<thrift::OffsetIndex>(
+    dwio::common::BufferedInput&,
+    int64_t,
+    int32_t);
+
+std::vector<RowRange> pageRowRanges(
+    const thrift::ColumnIndex& columnIndex,
+    const thrift::OffsetIndex& offsetIndex,
+    int64_t numRows,
+    common::Filter* filter,
+    const TypePtr& type) {
+  const auto& locations = offsetIndex.page_locations;
+  const auto numPages = locations.size();
+  if (numPages == 0 || columnIndex.null_pages.size() != numPages ||
+      columnIndex.min_values.size() != numPages ||
+      columnIndex.max_values.size() != numPages) {
+    // A malformed index does not exclude any rows.
+    return {{0, numRows}};
+  }
+  const bool hasNullCounts = columnIndex.__isset.null_counts &&
+      columnIndex.null_counts.size() == numPages;
+  std::vector<RowRange> ranges;
+  for (auto i = 0; i < numPages; ++i) {
+    const int64_t begin = locations[i].first_row_index;
+    const int64_t end =
+        i + 1 < numPages ? locations[i + 1].first_row_index : numRows;
+    thrift::Statistics pageStats;
+    if (columnIndex.null_pages[i]) {
+      pageStats.__set_null_count(end - begin);
+    } else {
+      pageStats.__set_min_value(columnIndex.min_values[i]);
+      pageStats.__set_max_value(columnIndex.max_values[i]);
+      if (hasNullCounts) {
+        pageStats.__set_null_count(columnIndex.null_counts[i]);
+      }
+    }
+    auto stats = buildColumnStatisticsFromThrift(pageStats, *type, end - begin);
+    if (!testFilter(filter, stats.get(), end - begin, type)) {
+      continue;
+    }
+    if (!ranges.empty() && ranges.back().end == begin) {
+      ranges.back().end = end;
+    } else {
+      ranges.push_back({begin, end});
+    }
+  }
+  return ranges;
+}
+
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right) {
+  std::vector<RowRange> result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < left.size() && j < right.size()) {
+    const auto begin = std::max(left[i].begin, right[j].begin);
+    const auto end = std::min(left[i].end, right[j].end);
+    if (begin < end) {
+      result.push_back({begin, end});
+    }
+    if (left[i].end < right[j].end) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return result;
+}
+
+} // namespace facebook::velox::parquet
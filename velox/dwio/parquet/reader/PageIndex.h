@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// A range of rows [begin, end) of a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+/// Reads the thrift encoded 'T' of 'length' bytes at 'offset' of 'input'.
+/// This is used for the ColumnIndex and the OffsetIndex of column chunks,
+/// which are written after the row groups and are not covered by the loads
+/// of the row groups.
+template <typename T>
+T readPageIndex(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    int32_t length);
+
+/// Reads the thrift encoded 'T' of 'length' bytes from 'stream'.
+template <typename T>
+T readPageIndex(dwio::common::SeekableInputStream& stream, int32_t length);
+
+/// Returns the sorted ranges of rows of a row group of 'numRows' rows in the
+/// pages of a column whose min, max and null counts in 'columnIndex' do not
+/// exclude values passing 'filter'. The first rows of the pages are in
+/// 'offsetIndex'. 'type' is the type of the column in the file.
+std::vector<RowRange> pageRowRanges(
+    const thrift::ColumnIndex& columnIndex,
+    const thrift::OffsetIndex& offsetIndex,
+    int64_t numRows,
+    common::Filter* filter,
+    const TypePtr& type);
+
+/// Returns the rows in both 'left' and 'right', which are sorted and
+/// disjoint.
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right);
+
+} // namespace facebook::velox::parquet
@@ -21,6 +21,7 @@
 #include "velox/dwio/common/ColumnVisitors.h"
 #include "velox/dwio/parquet/common/LevelConversion.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 #include "velox/vector/FlatVector.h"
 
@@ -44,6 +45,9 @@ void PageReader::seekToPage(int64_t row) {
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
   for (;;) {
+    if (row != kRepDefOnly) {
+      skipToPageOfRow(row);
+    }
     if (chunkSize_ <= pageStart_) {
       // This may happen if seeking to exactly end of row group.
       numRepDefsInPage_ = 0;
@@ -81,6 +85,45 @@ void PageReader::seekToPage(int64_t row) {
   }
 }
 
+void PageReader::setPageLocations(
+    std::vector<thrift::PageLocation> locations,
+    int64_t chunkOffset) {
+  VELOX_CHECK_EQ(maxRepeat_, 0, "Page locations need top level rows");
+  for (auto& location : locations) {
+    location.offset -= chunkOffset;
+  }
+  pageLocations_ = std::move(locations);
+}
+
+void PageReader::skipToPageOfRow(int64_t row) {
+  // The dictionary page precedes the first data page and must be read
+  // before skipping data pages.
+  const int64_t position = pageStart_;
+  if (pageLocations_.empty() || position < pageLocations_[0].offset) {
+    return;
+  }
+  auto it = std::upper_bound(
+      pageLocations_.begin(),
+      pageLocations_.end(),
+      row,
+      [](int64_t row, const auto& location) {
+        return row < location.first_row_index;
+      });
+  VELOX_DCHECK(it != pageLocations_.begin());
+  const auto& location = *(it - 1);
+  if (location.offset <= position) {
+    return;
+  }
+  dwio::common::skipBytes(
+      location.offset - position,
+      inputStream_.get(),
+      bufferStart_,
+      bufferEnd_);
+  pageStart_ = location.offset;
+  rowOfPage_ = location.first_row_index;
+  numRowsInPage_ = 0;
+}
+
 PageHeader PageReader::readPageHeader() {
   TestValue::adjust(
       "facebook::velox::parquet::PageReader::readPageHeader", this);
@@ -133,6 +176,12 @@ const char* PageReader::decompressData(
     const char* pageData,
     uint32_t compressedSize,
     uint32_t uncompressedSize) {
+  if (codec_ == common::CompressionKind::CompressionKind_NONE) {
+    // The page is read as is. Copying it to 'decompressedData_' would only
+    // add a pass over the page.
+    VELOX_CHECK_EQ(compressedSize, uncompressedSize);
+    return pageData;
+  }
   std::unique_ptr<dwio::common::SeekableInputStream> inputStream =
       std::make_unique<dwio::common::SeekableArrayInputStream>(
           pageData, compressedSize, 0);
@@ -295,6 +344,12 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   }
   auto levelsSize = repeatLength + defineLength;
   pageData_ += levelsSize;
+  if (row == kRepDefOnly) {
+    // The levels of V2 pages are not compressed, so the values do not need
+    // to be decompressed for reading the levels only.
+    skipBytes(bytes, inputStream_.get(), bufferStart_, bufferEnd_);
+    return;
+  }
   if (pageHeader.data_page_header_v2.__isset.is_compressed &&
       pageHeader.data_page_header_v2.is_compressed &&
       (pageHeader.compressed_page_size - levelsSize > 0)) {
@@ -303,10 +358,6 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
         pageHeader.compressed_page_size - levelsSize,
         pageHeader.uncompressed_page_size - levelsSize);
   }
-  if (row == kRepDefOnly) {
-    skipBytes(bytes, inputStream_.get(), bufferStart_, bufferEnd_);
-    return;
-  }
 
   encodedDataSize_ = pageHeader.uncompressed_page_size - levelsSize;
   encoding_ = pageHeader.data_page_header_v2.encoding;
@@ -323,17 +374,21 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
   dictionaryEncoding_ = pageHeader.dictionary_page_header.encoding;
   dictionary_.sorted = pageHeader.dictionary_page_header.__isset.is_sorted &&
       pageHeader.dictionary_page_header.is_sorted;
+  dictionary_.isAscii = false;
   VELOX_CHECK(
       dictionaryEncoding_ == Encoding::PLAIN_DICTIONARY ||
       dictionaryEncoding_ == Encoding::PLAIN);
 
+  pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
   if (codec_ != common::CompressionKind::CompressionKind_NONE) {
-    pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
     pageData_ = decompressData(
         pageData_,
         pageHeader.compressed_page_size,
         pageHeader.uncompressed_page_size);
   }
+  if (reuseCachedDictionary(pageHeader)) {
+    return;
+  }
 
   auto parquetType = type_->parquetType_.value();
   switch (parquetType) {
@@ -359,16 +414,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       } else {
         dictionary_.values = AlignedBuffer::allocate<char>(numBytes, &pool_);
       }
-      if (pageData_) {
-        memcpy(dictionary_.values->asMutable<char>(), pageData_, numBytes);
-      } else {
-        dwio::common::readBytes(
-            numBytes,
-            inputStream_.get(),
-            dictionary_.values->asMutable<char>(),
-            bufferStart_,
-            bufferEnd_);
-      }
+      memcpy(dictionary_.values->asMutable<char>(), pageData_, numBytes);
       if (type_->type()->isShortDecimal() &&
           parquetType == thrift::Type::INT32) {
         auto values = dictionary_.values->asMutable<int64_t>();
@@ -394,16 +440,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       auto numVeloxBytes = dictionary_.numValues * sizeof(int128_t);
       dictionary_.values = AlignedBuffer::allocate<char>(numVeloxBytes, &pool_);
       auto numBytes = dictionary_.numValues * sizeof(Int96Timestamp);
-      if (pageData_) {
-        memcpy(dictionary_.values->asMutable<char>(), pageData_, numBytes);
-      } else {
-        dwio::common::readBytes(
-            numBytes,
-            inputStream_.get(),
-            dictionary_.values->asMutable<char>(),
-            bufferStart_,
-            bufferEnd_);
-      }
+      memcpy(dictionary_.values->asMutable<char>(), pageData_, numBytes);
       // Expand the Parquet type length values to Velox type length.
       // We start from the end to allow in-place expansion.
       auto values = dictionary_.values->asMutable<int128_t>();
@@ -426,16 +463,14 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       auto values = dictionary_.values->asMutable<StringView>();
       dictionary_.strings = AlignedBuffer::allocate<char>(numBytes, &pool_);
       auto strings = dictionary_.strings->asMutable<char>();
-      if (pageData_) {
-        memcpy(strings, pageData_, numBytes);
-      } else {
-        dwio::common::readBytes(
-            numBytes, inputStream_.get(), strings, bufferStart_, bufferEnd_);
-      }
+      memcpy(strings, pageData_, numBytes);
       auto header = strings;
+      dictionary_.isAscii = true;
       for (auto i = 0; i < dictionary_.numValues; ++i) {
         auto length = *reinterpret_cast<const int32_t*>(header);
         values[i] = StringView(header + sizeof(int32_t), length);
+        dictionary_.isAscii &= functions::stringCore::isAscii(
+            header + sizeof(int32_t), length);
         header += length + sizeof(int32_t);
       }
       VELOX_CHECK_EQ(header, strings + numBytes);
@@ -449,16 +484,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       dictionary_.values = AlignedBuffer::allocate<char>(numVeloxBytes, &pool_);
       auto data = dictionary_.values->asMutable<char>();
       // Read the data bytes.
-      if (pageData_) {
-        memcpy(data, pageData_, numParquetBytes);
-      } else {
-        dwio::common::readBytes(
-            numParquetBytes,
-            inputStream_.get(),
-            data,
-            bufferStart_,
-            bufferEnd_);
-      }
+      memcpy(data, pageData_, numParquetBytes);
       if (type_->type()->isShortDecimal()) {
         // Parquet decimal values have a fixed typeLength_ and are in big-endian
         // layout.
@@ -513,6 +539,47 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       VELOX_UNSUPPORTED(
           "Parquet type {} not supported for dictionary", parquetType);
   }
+  cacheDictionary(pageHeader);
+}
+
+bool PageReader::reuseCachedDictionary(const PageHeader& pageHeader) {
+  if (!dictionaryCache_ || !dictionaryCache_->pageBytes) {
+    return false;
+  }
+  const auto& cache = *dictionaryCache_;
+  const uint64_t numBytes = pageHeader.uncompressed_page_size;
+  if (cache.encoding != dictionaryEncoding_ ||
+      cache.dictionary.numValues != dictionary_.numValues ||
+      cache.dictionary.sorted != dictionary_.sorted ||
+      cache.pageBytes->size() != numBytes ||
+      memcmp(cache.pageBytes->as<char>(), pageData_, numBytes) != 0) {
+    return false;
+  }
+  dictionary_ = cache.dictionary;
+  dictionaryValues_ = cache.dictionaryValues;
+  if (stats_) {
+    ++stats_->reusedDictionaryPages;
+  }
+  return true;
+}
+
+void PageReader::cacheDictionary(const PageHeader& pageHeader) {
+  if (!dictionaryCache_) {
+    return;
+  }
+  auto& cache = *dictionaryCache_;
+  const auto numBytes = pageHeader.uncompressed_page_size;
+  if (type_->parquetType_.value() == thrift::Type::BYTE_ARRAY) {
+    // The strings of the dictionary are a copy of the page.
+    cache.pageBytes = dictionary_.strings;
+  } else {
+    cache.pageBytes = AlignedBuffer::allocate<char>(numBytes, &pool_);
+    memcpy(cache.pageBytes->asMutable<char>(), pageData_, numBytes);
+  }
+  cache.encoding = dictionaryEncoding_;
+  cache.dictionary = dictionary_;
+  cache.dictionaryValues = nullptr;
+  cache.hasFilterCache = false;
 }
 
 void PageReader::makeFilterCache(dwio::common::ScanState& state) {
@@ -523,6 +590,7 @@ void PageReader::makeFilterCache(dwio::common::ScanState& state) {
       state.filterCache.data(),
       dwio::common::FilterResult::kUnknown,
       state.filterCache.size());
+  state.filterCacheComplete = false;
   state.rawState.filterCache = state.filterCache.data();
 }
 
@@ -628,17 +696,13 @@ int32_t PageReader::getLengthsAndNulls(
           definitionLevels_.data() + begin, end - begin, info, &bits);
       break;
     case LevelMode::kList: {
-      DefRepLevelsToList(
+      DefRepLevelsToLengths(
           definitionLevels_.data() + begin,
           repetitionLevels_.data() + begin,
           end - begin,
           info,
           &bits,
           lengths);
-      // Convert offsets to lengths.
-      for (auto i = 0; i < bits.valuesRead; ++i) {
-        lengths[i] = lengths[i + 1] - lengths[i];
-      }
       break;
     }
     case LevelMode::kStructOverLists: {
@@ -746,11 +810,58 @@ void PageReader::makeDecoder() {
         break;
       }
       FMT_FALLTHROUGH;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      if (encoding_ == Encoding::DELTA_LENGTH_BYTE_ARRAY &&
+          parquetType == thrift::Type::BYTE_ARRAY) {
+        deltaLengthByteArrDecoder_ =
+            std::make_unique<DeltaLengthByteArrayDecoder>(pageData_);
+        break;
+      }
+      FMT_FALLTHROUGH;
+    case Encoding::BYTE_STREAM_SPLIT:
+      if (encoding_ == Encoding::BYTE_STREAM_SPLIT &&
+          parquetType != thrift::Type::BOOLEAN &&
+          parquetType != thrift::Type::BYTE_ARRAY &&
+          parquetType != thrift::Type::INT96) {
+        makeByteStreamSplitDecoder();
+        break;
+      }
+      FMT_FALLTHROUGH;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
 }
 
+void PageReader::makeByteStreamSplitDecoder() {
+  const auto parquetType = type_->parquetType_.value();
+  const bool isFixedLength = parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY;
+  VELOX_CHECK(
+      !isFixedLength ||
+          !(type_->type()->isVarbinary() || type_->type()->isVarchar()),
+      "BYTE_STREAM_SPLIT is not supported for strings");
+  const int32_t width =
+      isFixedLength ? type_->typeLength_ : parquetTypeBytes(parquetType);
+  VELOX_CHECK_GT(width, 0);
+  VELOX_CHECK_EQ(
+      encodedDataSize_ % width,
+      0,
+      "BYTE_STREAM_SPLIT page size is not a multiple of the value size");
+  const int64_t numValues = encodedDataSize_ / width;
+  if (!byteStreamSplitValues_ ||
+      byteStreamSplitValues_->capacity() < encodedDataSize_) {
+    byteStreamSplitValues_ =
+        AlignedBuffer::allocate<char>(encodedDataSize_, &pool_);
+  }
+  auto* values = byteStreamSplitValues_->asMutable<char>();
+  byteStreamSplitToPlain(pageData_, numValues, width, values);
+  directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          values, encodedDataSize_),
+      false,
+      width,
+      isFixedLength);
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
@@ -778,6 +889,8 @@ void PageReader::skip(int64_t numRows) {
   // Skip the decoder
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    deltaLengthByteArrDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
@@ -912,7 +1025,15 @@ bool PageReader::rowsForPage(
     if (scanState.dictionary.values != dictionary_.values) {
       scanState.dictionary = dictionary_;
       if (hasFilter) {
-        makeFilterCache(scanState);
+        // The filter results on a dictionary reused from a previous row
+        // group are still valid.
+        if (!isCachedDictionary() || !dictionaryCache_->hasFilterCache ||
+            scanState.filterCache.size() != dictionary_.numValues) {
+          makeFilterCache(scanState);
+        }
+        if (dictionaryCache_) {
+          dictionaryCache_->hasFilterCache = isCachedDictionary();
+        }
       }
       scanState.updateRawState();
     }
@@ -997,6 +1118,13 @@ const VectorPtr& PageReader::dictionaryValues(const TypePtr& type) {
         dictionary_.numValues,
         dictionary_.values,
         std::vector<BufferPtr>{dictionary_.strings});
+    if (dictionary_.isAscii) {
+      dictionaryValues_->asUnchecked<FlatVector<StringView>>()->setAllIsAscii(
+          true);
+    }
+    if (isCachedDictionary()) {
+      dictionaryCache_->dictionaryValues = dictionaryValues_;
+    }
   }
   return dictionaryValues_;
 }
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/common/RleEncodingInternal.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
@@ -31,6 +32,25 @@
 
 namespace facebook::velox::parquet {
 
+/// The last dictionary decoded for a column, kept across the column chunks
+/// of the row groups of a split. Writers often produce the same dictionary
+/// page in every row group, e.g. for low cardinality columns. A dictionary
+/// page with the same bytes as the cached one then reuses its decoded values
+/// and the results of the column's filter on them.
+struct DictionaryPageCache {
+  /// The uncompressed bytes of the dictionary page.
+  BufferPtr pageBytes;
+  thrift::Encoding::type encoding;
+  dwio::common::DictionaryValues dictionary;
+
+  /// The string dictionary as a vector if made by dictionaryValues().
+  VectorPtr dictionaryValues;
+
+  /// True if the filter cache in the scan state of the column was made for
+  /// 'dictionary'.
+  bool hasFilterCache{false};
+};
+
 /// Manages access to pages inside a ColumnChunk. Interprets page headers and
 /// encodings and presents the combination of pages and encoded values as a
 /// continuous stream accessible via readWithVisitor().
@@ -42,7 +62,9 @@ class PageReader {
       ParquetTypeWithIdPtr fileType,
       common::CompressionKind codec,
       int64_t chunkSize,
-      const tz::TimeZone* sessionTimezone)
+      const tz::TimeZone* sessionTimezone,
+      DictionaryPageCache* dictionaryCache = nullptr,
+      dwio::common::ColumnReaderStatistics* stats = nullptr)
       : pool_(pool),
         inputStream_(std::move(stream)),
         type_(std::move(fileType)),
@@ -52,7 +74,9 @@ class PageReader {
         codec_(codec),
         chunkSize_(chunkSize),
         nullConcatenation_(pool_),
-        sessionTimezone_(sessionTimezone) {
+        sessionTimezone_(sessionTimezone),
+        dictionaryCache_(dictionaryCache),
+        stats_(stats) {
     type_->makeLevelInfo(leafInfo_);
   }
 
@@ -149,6 +173,14 @@ class PageReader {
     return sessionTimezone_;
   }
 
+  /// Sets the locations of the data pages from the OffsetIndex of the column
+  /// chunk. 'chunkOffset' is the file offset of the start of the column
+  /// chunk. Seeks past the next page then go directly to the page of the
+  /// target row instead of reading the headers of the pages in between.
+  void setPageLocations(
+      std::vector<thrift::PageLocation> locations,
+      int64_t chunkOffset);
+
  private:
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
@@ -170,6 +202,21 @@ class PageReader {
   // Initializes a filter result cache for the dictionary in 'state'.
   void makeFilterCache(dwio::common::ScanState& state);
 
+  // Sets 'dictionary_' from 'dictionaryCache_' if the uncompressed dictionary
+  // page at 'pageData_' has the same bytes as the cached one. Returns true if
+  // the cached dictionary is used.
+  bool reuseCachedDictionary(const thrift::PageHeader& pageHeader);
+
+  // Puts 'dictionary_', decoded from the page at 'pageData_', in
+  // 'dictionaryCache_'.
+  void cacheDictionary(const thrift::PageHeader& pageHeader);
+
+  // Returns true if 'dictionary_' is the dictionary in 'dictionaryCache_'.
+  bool isCachedDictionary() const {
+    return dictionaryCache_ &&
+        dictionaryCache_->dictionary.values == dictionary_.values;
+  }
+
   // Makes a decoder based on 'encoding_' for bytes from ''pageData_' to
   // 'pageData_' + 'encodedDataSize_'.
   void makedecoder();
@@ -200,11 +247,19 @@ class PageReader {
   // next page.
   void updateRowInfoAfterPageSkipped();
 
+  // Skips to the header of the last data page starting at or before 'row'
+  // if 'pageLocations_' has one after the current position.
+  void skipToPageOfRow(int64_t row);
+
   void prepareDataPageV1(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDataPageV2(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDictionary(const thrift::PageHeader& pageHeader);
   void makeDecoder();
 
+  // Decodes the BYTE_STREAM_SPLIT values of the page into
+  // 'byteStreamSplitValues_' and makes 'directDecoder_' read them.
+  void makeByteStreamSplitDecoder();
+
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
   // 'numRowsInPage_' accordingly. This is used for non-top level leaves when
   // 'hasChunkRepDefs_' is false.
@@ -312,6 +367,9 @@ class PageReader {
       } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
         nullsFromFastPath = false;
         deltaByteArrDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaLengthByteArrDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -322,6 +380,8 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
         deltaByteArrDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -454,6 +514,10 @@ class PageReader {
   // Offset of current page's header from start of ColumnChunk.
   uint64_t pageStart_{0};
 
+  // The data pages of the ColumnChunk from the OffsetIndex, with offsets
+  // from the start of the ColumnChunk. Empty if there is no OffsetIndex.
+  std::vector<thrift::PageLocation> pageLocations_;
+
   // Offset of first byte after current page' header.
   uint64_t pageDataStart_{0};
 
@@ -504,6 +568,11 @@ class PageReader {
 
   const tz::TimeZone* sessionTimezone_{nullptr};
 
+  // The dictionary of the previous column chunk of the column. Not owned.
+  DictionaryPageCache* const dictionaryCache_{nullptr};
+
+  dwio::common::ColumnReaderStatistics* const stats_{nullptr};
+
   // Decoders. Only one will be set at a time.
   std::unique_ptr<dwio::common::DirectDecoder<true>> directDecoder_;
   std::unique_ptr<RleBpDataDecoder> dictionaryIdDecoder_;
@@ -511,8 +580,13 @@ class PageReader {
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
   std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrDecoder_;
   std::unique_ptr<RleBpDataDecoder> rleBooleanDecoder_;
   // Add decoders for other encodings here.
+
+  // The values of a BYTE_STREAM_SPLIT page in the PLAIN layout, read by
+  // 'directDecoder_'. Reused across pages.
+  BufferPtr byteStreamSplitValues_;
 };
 
 FOLLY_ALWAYS_INLINE dwio::common::compression::CompressionOptions
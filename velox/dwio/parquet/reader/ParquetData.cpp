@@ -16,16 +16,139 @@
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
+#include <algorithm>
+
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetStatsContext.h"
 
 namespace facebook::velox::parquet {
 
+namespace {
+
+// A range of offsets [begin, end) in a column chunk.
+struct ChunkRegion {
+  uint64_t begin;
+  uint64_t end;
+};
+
+// Reads a column chunk of which only the bytes in 'regions' are loaded.
+// Each region has its own stream in 'streams'. The bytes between the regions
+// are skipped without IO. The PageReader seeks over the pages that are not
+// loaded with the page locations of the OffsetIndex.
+class ChunkRegionsInputStream : public dwio::common::SeekableInputStream {
+ public:
+  ChunkRegionsInputStream(
+      std::vector<ChunkRegion> regions,
+      std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams,
+      uint64_t chunkSize,
+      uint32_t column)
+      : regions_(std::move(regions)),
+        streams_(std::move(streams)),
+        chunkSize_(chunkSize),
+        column_(column) {
+    VELOX_CHECK_EQ(regions_.size(), streams_.size());
+  }
+
+  bool Next(const void** data, int32_t* size) override {
+    if (position_ >= chunkSize_) {
+      return false;
+    }
+    if (!inCurrentRegion()) {
+      auto it = std::upper_bound(
+          regions_.begin(),
+          regions_.end(),
+          position_,
+          [](uint64_t position, const ChunkRegion& region) {
+            return position < region.begin;
+          });
+      VELOX_CHECK(
+          it != regions_.begin() && position_ < (it - 1)->end,
+          "Read of an unloaded page of column {} at offset {}",
+          column_,
+          position_);
+      current_ = it - regions_.begin() - 1;
+      streamPosition_ = kNoPosition;
+    }
+    auto& stream = *streams_[current_];
+    if (streamPosition_ != position_) {
+      std::vector<uint64_t> offset = {position_ - regions_[current_].begin};
+      dwio::common::PositionProvider positionProvider(offset);
+      stream.seekToPosition(positionProvider);
+    }
+    if (!stream.Next(data, size)) {
+      return false;
+    }
+    position_ += *size;
+    streamPosition_ = position_;
+    return true;
+  }
+
+  void BackUp(int32_t count) override {
+    VELOX_CHECK_EQ(streamPosition_, position_);
+    streams_[current_]->BackUp(count);
+    position_ -= count;
+    streamPosition_ = position_;
+  }
+
+  bool SkipInt64(int64_t count) override {
+    position_ += count;
+    return position_ <= chunkSize_;
+  }
+
+  google::protobuf::int64 ByteCount() const override {
+    return position_;
+  }
+
+  void seekToPosition(dwio::common::PositionProvider& position) override {
+    position_ = position.next();
+  }
+
+  std::string getName() const override {
+    return fmt::format(
+        "ChunkRegionsInputStream for column {}, {} regions",
+        column_,
+        regions_.size());
+  }
+
+  size_t positionSize() const override {
+    return 1;
+  }
+
+ private:
+  static constexpr uint64_t kNoPosition = ~0UL;
+
+  bool inCurrentRegion() const {
+    return current_ < regions_.size() &&
+        position_ >= regions_[current_].begin &&
+        position_ < regions_[current_].end;
+  }
+
+  const std::vector<ChunkRegion> regions_;
+  const std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      streams_;
+  const uint64_t chunkSize_;
+  const uint32_t column_;
+  // The offset in the chunk of the next byte to return.
+  uint64_t position_{0};
+  // The region of the last Next().
+  size_t current_{~0UL};
+  // The offset in the chunk of the next byte of the stream of 'current_'.
+  uint64_t streamPosition_{kNoPosition};
+};
+
+} // namespace
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
   return std::make_unique<ParquetData>(
-      type, metaData_, pool(), sessionTimezone_);
+      type,
+      metaData_,
+      pool(),
+      runtimeStatistics(),
+      sessionTimezone_,
+      readOffsetIndex_);
 }
 
 void ParquetData::filterRowGroups(
@@ -91,28 +214,118 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
 
 void ParquetData::enqueueRowGroup(
     uint32_t index,
-    dwio::common::BufferedInput& input) {
+    dwio::common::BufferedInput& input,
+    const std::vector<RowRange>* rowRanges) {
   auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
-  streams_.resize(fileMetaDataPtr_.numRowGroups());
   VELOX_CHECK(
       chunk.hasMetadata(),
       "ColumnMetaData does not exist for schema Id ",
       type_->column());
   ;
 
-  uint64_t chunkReadOffset = chunk.dataPageOffset();
-  if (chunk.hasDictionaryPageOffset() && chunk.dictionaryPageOffset() >= 4) {
-    // this assumes the data pages follow the dict pages directly.
-    chunkReadOffset = chunk.dictionaryPageOffset();
+  // The page locations are used for seeking only if the rows of the column
+  // are top level rows.
+  const bool hasPageLocations =
+      readOffsetIndex_ && maxRepeat_ == 0 && chunk.hasOffsetIndex();
+  if (hasPageLocations && rowRanges) {
+    streams_[index] = enqueuePages(index, chunk, *rowRanges, input);
+    if (streams_[index]) {
+      return;
+    }
   }
 
+  const uint64_t readOffset = chunkReadOffset(chunk);
   uint64_t readSize =
       (chunk.compression() == common::CompressionKind::CompressionKind_NONE)
       ? chunk.totalUncompressedSize()
       : chunk.totalCompressedSize();
 
   auto id = dwio::common::StreamIdentifier(type_->column());
-  streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  streams_[index] = input.enqueue({readOffset, readSize}, &id);
+  if (hasPageLocations) {
+    if (!pageLocations_[index].empty()) {
+      // The OffsetIndex was read by enqueuePages().
+      return;
+    }
+    offsetIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.offsetIndexOffset()),
+         static_cast<uint64_t>(chunk.offsetIndexLength())},
+        &id);
+  }
+}
+
+std::unique_ptr<dwio::common::SeekableInputStream> ParquetData::enqueuePages(
+    uint32_t index,
+    const ColumnChunkMetaDataPtr& chunk,
+    const std::vector<RowRange>& rowRanges,
+    dwio::common::BufferedInput& input) {
+  // The OffsetIndex is needed before the pages can be enqueued, so it is
+  // read here and not with the pages.
+  auto offsetIndex = readPageIndex<thrift::OffsetIndex>(
+      input, chunk.offsetIndexOffset(), chunk.offsetIndexLength());
+  if (offsetIndex.page_locations.empty()) {
+    return nullptr;
+  }
+  pageLocations_[index] = std::move(offsetIndex.page_locations);
+  const auto& locations = pageLocations_[index];
+  const uint64_t readOffset = chunkReadOffset(chunk);
+  const uint64_t chunkSize = chunk.totalCompressedSize();
+  const int64_t numRows = fileMetaDataPtr_.rowGroup(index).numRows();
+
+  std::vector<ChunkRegion> regions;
+  uint64_t regionBytes = 0;
+  auto addRegion = [&](uint64_t begin, uint64_t end) {
+    regionBytes += end - begin;
+    if (!regions.empty() && regions.back().end == begin) {
+      regions.back().end = end;
+    } else {
+      regions.push_back({begin, end});
+    }
+  };
+  // The dictionary page is before the first data page.
+  if (locations[0].offset > readOffset) {
+    addRegion(0, locations[0].offset - readOffset);
+  }
+  size_t range = 0;
+  for (size_t i = 0; i < locations.size(); ++i) {
+    const int64_t firstRow = locations[i].first_row_index;
+    const int64_t endRow = i + 1 < locations.size()
+        ? locations[i + 1].first_row_index
+        : numRows;
+    while (range < rowRanges.size() && rowRanges[range].end <= firstRow) {
+      ++range;
+    }
+    if (range == rowRanges.size()) {
+      break;
+    }
+    if (rowRanges[range].begin < endRow) {
+      const uint64_t begin = locations[i].offset - readOffset;
+      VELOX_CHECK_LE(begin + locations[i].compressed_page_size, chunkSize);
+      addRegion(begin, begin + locations[i].compressed_page_size);
+    }
+  }
+  if (regionBytes >= chunkSize) {
+    return nullptr;
+  }
+
+  auto id = dwio::common::StreamIdentifier(type_->column());
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams;
+  streams.reserve(regions.size());
+  for (const auto& region : regions) {
+    streams.push_back(input.enqueue(
+        {readOffset + region.begin, region.end - region.begin}, &id));
+  }
+  return std::make_unique<ChunkRegionsInputStream>(
+      std::move(regions), std::move(streams), chunkSize, type_->column());
+}
+
+// static
+uint64_t ParquetData::chunkReadOffset(const ColumnChunkMetaDataPtr& chunk) {
+  if (chunk.hasDictionaryPageOffset() && chunk.dictionaryPageOffset() >= 4) {
+    // this assumes the data pages follow the dict pages directly.
+    return chunk.dictionaryPageOffset();
+  }
+  return chunk.dataPageOffset();
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
@@ -126,7 +339,20 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
       type_,
       metadata.compression(),
       metadata.totalCompressedSize(),
-      sessionTimezone_);
+      sessionTimezone_,
+      &dictionaryCache_,
+      &stats_);
+  if (!pageLocations_[index].empty()) {
+    reader_->setPageLocations(
+        std::move(pageLocations_[index]), chunkReadOffset(metadata));
+    pageLocations_[index].clear();
+  } else if (offsetIndexStreams_[index]) {
+    auto offsetIndex = readPageIndex<thrift::OffsetIndex>(
+        *offsetIndexStreams_[index], metadata.offsetIndexLength());
+    offsetIndexStreams_[index].reset();
+    reader_->setPageLocations(
+        std::move(offsetIndex.page_locations), chunkReadOffset(metadata));
+  }
   return dwio::common::PositionProvider(empty);
 }
 
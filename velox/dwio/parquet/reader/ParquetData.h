@@ -30,6 +30,8 @@ class BufferedInput;
 
 namespace facebook::velox::parquet {
 
+struct RowRange;
+
 class ParquetParams : public dwio::common::FormatParams {
  public:
   ParquetParams(
@@ -37,11 +39,13 @@ class ParquetParams : public dwio::common::FormatParams {
       dwio::common::ColumnReaderStatistics& stats,
       const FileMetaDataPtr metaData,
       const tz::TimeZone* sessionTimezone,
-      TimestampPrecision timestampPrecision)
+      TimestampPrecision timestampPrecision,
+      bool readOffsetIndex = false)
       : FormatParams(pool, stats),
         metaData_(metaData),
         sessionTimezone_(sessionTimezone),
-        timestampPrecision_(timestampPrecision) {}
+        timestampPrecision_(timestampPrecision),
+        readOffsetIndex_(readOffsetIndex) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
@@ -54,6 +58,7 @@ class ParquetParams : public dwio::common::FormatParams {
   const FileMetaDataPtr metaData_;
   const tz::TimeZone* sessionTimezone_;
   const TimestampPrecision timestampPrecision_;
+  const bool readOffsetIndex_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -63,17 +68,34 @@ class ParquetData : public dwio::common::FormatData {
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
       memory::MemoryPool& pool,
-      const tz::TimeZone* sessionTimezone)
+      dwio::common::ColumnReaderStatistics& stats,
+      const tz::TimeZone* sessionTimezone,
+      bool readOffsetIndex = false)
       : pool_(pool),
+        stats_(stats),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1),
-        sessionTimezone_(sessionTimezone) {}
+        sessionTimezone_(sessionTimezone),
+        readOffsetIndex_(readOffsetIndex) {
+    // The streams are sized here because the row groups may be enqueued on
+    // an executor while the current one is read.
+    streams_.resize(fileMetaDataPtr_.numRowGroups());
+    offsetIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
+    pageLocations_.resize(fileMetaDataPtr_.numRowGroups());
+  }
 
-  /// Prepares to read data for 'index'th row group.
-  void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
+  /// Prepares to read data for 'index'th row group. Also reads the
+  /// OffsetIndex of the column chunk if 'readOffsetIndex' was given, so that
+  /// skips over many rows go directly to the page of the target row. If
+  /// 'rowRanges' is given, only the rows in it are read and only the pages
+  /// covering them are enqueued when the column has an OffsetIndex.
+  void enqueueRowGroup(
+      uint32_t index,
+      dwio::common::BufferedInput& input,
+      const std::vector<RowRange>* rowRanges = nullptr);
 
   /// Positions 'this' at 'index'th row group. loadRowGroup must be called
   /// first. The returned PositionProvider is empty and should not be used.
@@ -208,19 +230,44 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  // Returns the file offset of the first page of 'chunk'.
+  static uint64_t chunkReadOffset(const ColumnChunkMetaDataPtr& chunk);
+
+  // Enqueues the dictionary page and the data pages of 'chunk' of row group
+  // 'index' that have rows in 'rowRanges'. Returns a stream over the chunk
+  // that reads the enqueued pages and skips the others without IO, or
+  // nullptr if all the pages are needed.
+  std::unique_ptr<dwio::common::SeekableInputStream> enqueuePages(
+      uint32_t index,
+      const ColumnChunkMetaDataPtr& chunk,
+      const std::vector<RowRange>& rowRanges,
+      dwio::common::BufferedInput& input);
+
  protected:
   memory::MemoryPool& pool_;
+  dwio::common::ColumnReaderStatistics& stats_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const FileMetaDataPtr fileMetaDataPtr_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
+  // Streams for the OffsetIndex of this column in each of 'rowGroups_', if
+  // 'readOffsetIndex_'.
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      offsetIndexStreams_;
+  // The page locations of this column in each of 'rowGroups_' if the
+  // OffsetIndex was read when enqueueing the pages of the row group.
+  std::vector<std::vector<thrift::PageLocation>> pageLocations_;
 
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
   const tz::TimeZone* sessionTimezone_;
+  const bool readOffsetIndex_;
   std::unique_ptr<PageReader> reader_;
+  // The last dictionary read by a 'reader_', reused by the next row group if
+  // its dictionary page is the same.
+  DictionaryPageCache dictionaryCache_;
 
   // Nulls derived from leaf repdefs for non-leaf readers.
   BufferPtr presetNulls_;
@@ -17,7 +17,11 @@
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 
 #include <thrift/protocol/TCompactProtocol.h> //@manual
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/common/UnitLoader.h"
 
+#include "velox/dwio/parquet/reader/BloomFilterPruning.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -36,6 +40,18 @@ bool isParquetReservedKeyword(
       ? true
       : false;
 }
+
+bool hasRepeatedValues(const ParquetTypeWithId& type) {
+  if (type.maxRepeat_ > 0) {
+    return true;
+  }
+  for (const auto& child : type.getChildren()) {
+    if (hasRepeatedValues(static_cast<const ParquetTypeWithId&>(*child))) {
+      return true;
+    }
+  }
+  return false;
+}
 } // namespace
 
 /// Metadata and options for reading Parquet.
@@ -67,6 +83,12 @@ class ReaderBase {
     return FileMetaDataPtr(reinterpret_cast<const void*>(fileMetaData_.get()));
   }
 
+  /// Returns true if the file metadata is in the FileMetadataCache and thus
+  /// shared with the other readers of the file.
+  bool isFileMetaDataShared() const {
+    return fileMetaDataShared_;
+  }
+
   const std::shared_ptr<const RowType>& schema() const {
     return schema_;
   }
@@ -89,10 +111,14 @@ class ReaderBase {
 
   /// Ensures that streams are enqueued and loading for the row group at
   /// 'currentGroup'. May start loading one or more subsequent groups.
+  /// Loads the row group at 'currentGroup' of 'groups' and the ones after it
+  /// to prefetch. 'rowRanges' has the rows to read of each of 'groups', if
+  /// known from the page index.
   void scheduleRowGroups(
       const std::vector<uint32_t>& groups,
       int32_t currentGroup,
-      StructColumnReader& reader);
+      StructColumnReader& reader,
+      const std::vector<std::optional<std::vector<RowRange>>>& rowRanges);
 
   /// Returns the uncompressed size for columns in 'type' and its children in
   /// row group.
@@ -105,7 +131,11 @@ class ReaderBase {
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
  private:
-  // Reads and parses file footer.
+  // The estimated ratio of the memory of the decoded file metadata to the
+  // size of its thrift encoding.
+  static constexpr int32_t kDecodedFooterSizeRatio = 3;
+
+  // Reads and parses file footer, unless it is in the FileMetadataCache.
   void loadFileMetaData();
 
   void initializeSchema();
@@ -139,7 +169,8 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  std::shared_ptr<thrift::FileMetaData> fileMetaData_;
+  bool fileMetaDataShared_{false};
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -168,6 +199,23 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  std::optional<dwio::common::FileMetadataCache::Key> cacheKey;
+  if (metadataCache != nullptr &&
+      options_.fileModificationTime().has_value()) {
+    cacheKey = dwio::common::FileMetadataCache::Key{
+        dwio::common::FileFormat::PARQUET,
+        input_->getReadFile()->getName(),
+        fileLength_,
+        options_.fileModificationTime().value()};
+    fileMetaData_ = metadataCache->get<thrift::FileMetaData>(*cacheKey);
+    if (fileMetaData_ != nullptr) {
+      fileMetaDataShared_ = true;
+      input_->setNumStripes(fileMetaData_->row_groups.size());
+      return;
+    }
+  }
+
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
@@ -214,8 +262,16 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
+  fileMetaData_ = std::make_shared<thrift::FileMetaData>();
   fileMetaData_->read(thriftProtocol.get());
+  input_->setNumStripes(fileMetaData_->row_groups.size());
+  if (cacheKey.has_value()) {
+    metadataCache->put(
+        *cacheKey,
+        fileMetaData_,
+        static_cast<uint64_t>(footerLength) * kDecodedFooterSizeRatio);
+    fileMetaDataShared_ = true;
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -985,14 +1041,17 @@ std::shared_ptr<const RowType> ReaderBase::createRowType(
 void ReaderBase::scheduleRowGroups(
     const std::vector<uint32_t>& rowGroupIds,
     int32_t currentGroup,
-    StructColumnReader& reader) {
+    StructColumnReader& reader,
+    const std::vector<std::optional<std::vector<RowRange>>>& rowRanges) {
   auto numRowGroupsToLoad = std::min(
       options_.prefetchRowGroups() + 1,
       static_cast<int64_t>(rowGroupIds.size() - currentGroup));
   for (auto i = 0; i < numRowGroupsToLoad; i++) {
     auto thisGroup = rowGroupIds[currentGroup + i];
     if (!inputs_[thisGroup]) {
-      inputs_[thisGroup] = reader.loadRowGroup(thisGroup, input_);
+      const auto& ranges = rowRanges[currentGroup + i];
+      inputs_[thisGroup] = reader.loadRowGroup(
+          thisGroup, input_, ranges.has_value() ? &ranges.value() : nullptr);
     }
   }
 
@@ -1023,6 +1082,78 @@ bool ReaderBase::isRowGroupBuffered(int32_t rowGroupIndex) const {
   return inputs_.count(rowGroupIndex) != 0;
 }
 
+namespace {
+
+// A row group loaded by a UnitLoader. The column chunks are loaded into a
+// BufferedInput of the unit, so that the load can run on an executor while
+// the previous row group is read.
+class RowGroupLoadUnit : public dwio::common::LoadUnit {
+ public:
+  RowGroupLoadUnit(
+      StructColumnReader& reader,
+      const dwio::common::BufferedInput& baseInput,
+      uint32_t rowGroup,
+      const std::vector<RowRange>* rowRanges,
+      uint64_t numRows,
+      uint64_t ioSize)
+      : reader_(reader),
+        baseInput_(baseInput),
+        rowGroup_(rowGroup),
+        rowRanges_(rowRanges),
+        numRows_(numRows),
+        ioSize_(ioSize) {}
+
+  void load() override {
+    input_ = reader_.loadRowGroup(
+        rowGroup_,
+        std::shared_ptr<dwio::common::BufferedInput>(baseInput_.clone()),
+        rowRanges_);
+  }
+
+  void unload() override {
+    input_.reset();
+  }
+
+  uint64_t getNumRows() override {
+    return numRows_;
+  }
+
+  uint64_t getIoSize() override {
+    return ioSize_;
+  }
+
+ private:
+  StructColumnReader& reader_;
+  const dwio::common::BufferedInput& baseInput_;
+  const uint32_t rowGroup_;
+  const std::vector<RowRange>* const rowRanges_;
+  const uint64_t numRows_;
+  const uint64_t ioSize_;
+  std::shared_ptr<dwio::common::BufferedInput> input_;
+};
+
+// Returns the compressed size of the column chunks of row group 'rowGroup'
+// read by 'reader' and its children.
+uint64_t compressedSize(
+    const dwio::common::SelectiveColumnReader& reader,
+    const thrift::RowGroup& rowGroup) {
+  if (reader.children().empty()) {
+    const auto column = reader.fileType().column();
+    if (column == ParquetTypeWithId::kNonLeaf ||
+        column >= rowGroup.columns.size()) {
+      return 0;
+    }
+    return rowGroup.columns[column].meta_data.total_compressed_size;
+  }
+  uint64_t size = 0;
+  for (const auto* child : reader.children()) {
+    size += compressedSize(*child, rowGroup);
+  }
+  return size;
+}
+
+} // namespace
+
 class ParquetRowReader::Impl {
  public:
   Impl(
@@ -1053,12 +1184,14 @@ class ParquetRowReader::Impl {
       return; // TODO
     }
     parquetStatsContext_ = ParquetStatsContext(readerBase_->version());
+    usePageIndex_ = shouldUsePageIndex();
     ParquetParams params(
         pool_,
         columnReaderStats_,
         readerBase_->fileMetaData(),
         readerBase->sessionTimezone(),
-        options_.timestampPrecision());
+        options_.timestampPrecision(),
+        usePageIndex_);
     requestedType_ = options_.requestedType() ? options_.requestedType()
                                               : readerBase_->schema();
     columnReader_ = ParquetColumnReader::build(
@@ -1067,9 +1200,20 @@ class ParquetRowReader::Impl {
         params,
         *options_.scanSpec());
     columnReader_->setIsTopLevel();
+    if (auto* structReader =
+            dynamic_cast<dwio::common::SelectiveStructColumnReaderBase*>(
+                columnReader_.get())) {
+      structReader->setParallelDecoding(
+          options_.decodingExecutor().get(),
+          options_.decodingParallelismFactor(),
+          options_.parallelDecodeMinCells());
+    }
 
     filterRowGroups();
     if (!rowGroupIds_.empty()) {
+      if (options_.unitLoaderFactory()) {
+        unitLoader_ = createUnitLoader();
+      }
       // schedule prefetch of first row group right after reading the metadata.
       // This is usually on a split preload thread before the split goes to
       // table scan.
@@ -1080,6 +1224,7 @@ class ParquetRowReader::Impl {
   void filterRowGroups() {
     rowGroupIds_.reserve(rowGroups_.size());
     firstRowOfRowGroup_.reserve(rowGroups_.size());
+    rowRangesOfRowGroup_.reserve(rowGroups_.size());
 
     ParquetData::FilterRowGroupsResult res;
     columnReader_->filterRowGroups(0, parquetStatsContext_, res);
@@ -1102,17 +1247,27 @@ class ParquetRowReader::Impl {
       auto isExcluded =
           (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i));
       auto isEmpty = rowGroups_[i].num_rows == 0;
+      if (rowGroupInRange && !isExcluded && !isEmpty) {
+        isExcluded = !bloomFiltersMatch(i);
+      }
+      std::optional<std::vector<RowRange>> rowRanges;
+      if (usePageIndex_ && rowGroupInRange && !isExcluded && !isEmpty) {
+        rowRanges = filterPages(i);
+        isExcluded = rowRanges.has_value() && rowRanges->empty();
+      }
 
       // Add a row group to read if it is within range and not empty and not in
       // the excluded list.
       if (rowGroupInRange && !isExcluded && !isEmpty) {
         rowGroupIds_.push_back(i);
         firstRowOfRowGroup_.push_back(rowNumber);
+        rowRangesOfRowGroup_.push_back(std::move(rowRanges));
       } else {
-        if (i != 0) {
+        if (i != 0 && !readerBase_->isFileMetaDataShared()) {
           // Clear the metadata of row groups that are not read. This helps
           // reduce the memory consumption. ColumnChunks consume the most
           // memory. Skip the 0th RowGroup as it is used by estimatedRowSize().
+          // The shared metadata is kept for the other readers of the file.
           rowGroups_[i].columns.clear();
         }
         if (rowGroupInRange) {
@@ -1125,11 +1280,16 @@ class ParquetRowReader::Impl {
   }
 
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
+    for (;;) {
+      if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+          !advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
+      if (skipToRowRange()) {
+        return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] +
+            currentRowInGroup_;
+      }
     }
-    return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
 
   int64_t nextReadSize(uint64_t size) {
@@ -1137,7 +1297,10 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    const uint64_t end = currentRowRanges_
+        ? (*currentRowRanges_)[nextRowRange_].end
+        : rowsInCurrentRowGroup_;
+    return std::min(size, end - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -1149,6 +1312,10 @@ class ParquetRowReader::Impl {
       return 0;
     }
     VELOX_DCHECK_GT(rowsToRead, 0);
+    if (unitLoader_) {
+      unitLoader_->onRead(
+          nextRowGroupIdsIdx_ - 1, currentRowInGroup_, rowsToRead);
+    }
     columnReader_->setCurrentRowNumber(nextRowNumber());
     if (!options_.rowNumberColumnInfo().has_value()) {
       columnReader_->next(rowsToRead, result, mutation);
@@ -1174,9 +1341,20 @@ class ParquetRowReader::Impl {
         rowGroups_[index].num_rows;
   }
 
+  uint64_t rowCountFromMetadata() const {
+    uint64_t numRows = 0;
+    for (auto id : rowGroupIds_) {
+      numRows += rowGroups_[id].num_rows;
+    }
+    return numRows;
+  }
+
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += skippedStrides_;
     stats.processedStrides += rowGroupIds_.size();
+    stats.skippedPageRows += skippedPageRows_;
+    stats.columnReaderStatistics.reusedDictionaryPages +=
+        columnReaderStats_.reusedDictionaryPages;
   }
 
   void resetFilterCaches() {
@@ -1188,19 +1366,171 @@ class ParquetRowReader::Impl {
   }
 
  private:
+  // Returns true if the page indexes can be used to skip rows: some top level
+  // column read from the file has a filter and no column read from the file
+  // has repeated values, whose rows are not top level rows.
+  bool shouldUsePageIndex() const {
+    const auto& fileType = *readerBase_->schemaWithId();
+    const auto& fileRowType = fileType.type()->asRow();
+    bool hasFilter = false;
+    for (const auto* childSpec : options_.scanSpec()->stableChildren()) {
+      if (childSpec->isConstant() || !childSpec->readFromFile() ||
+          !fileRowType.containsChild(childSpec->fieldName())) {
+        continue;
+      }
+      const auto& childType = static_cast<const ParquetTypeWithId&>(
+          *fileType.childByName(childSpec->fieldName()));
+      if (hasRepeatedValues(childType)) {
+        return false;
+      }
+      hasFilter |= childSpec->filter() && childType.getChildren().empty();
+    }
+    return hasFilter;
+  }
+
+  // Returns false if the Bloom filter of a top level column of row group
+  // 'index' has none of the values of the equality or IN filter on the
+  // column. This runs after the row group statistics did not exclude the row
+  // group, so the Bloom filters are only read for the row groups that the
+  // min and max values cannot prune.
+  bool bloomFiltersMatch(uint32_t index) {
+    const auto& rowGroup = rowGroups_[index];
+    for (auto* child : columnReader_->children()) {
+      auto* filter = child->scanSpec()->filter();
+      if (!filter || !child->children().empty()) {
+        continue;
+      }
+      const auto& fileType =
+          static_cast<const ParquetTypeWithId&>(child->fileType());
+      if (!fileType.parquetType_.has_value() ||
+          !canTestBloomFilter(*filter, fileType.parquetType_.value())) {
+        continue;
+      }
+      const auto& metadata = rowGroup.columns[fileType.column()].meta_data;
+      if (!metadata.__isset.bloom_filter_offset) {
+        continue;
+      }
+      const auto bloomFilter = BlockSplitBloomFilter::read(
+          readerBase_->bufferedInput(), metadata.bloom_filter_offset, pool_);
+      if (!testBloomFilter(
+              *filter, bloomFilter, fileType.parquetType_.value())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns the rows of row group 'index' that may pass the filters on the
+  // top level columns according to the ColumnIndex of their pages, or
+  // std::nullopt if the page indexes exclude no rows.
+  std::optional<std::vector<RowRange>> filterPages(uint32_t index) {
+    const auto& rowGroup = rowGroups_[index];
+    auto& input = readerBase_->bufferedInput();
+    std::optional<std::vector<RowRange>> ranges;
+    for (auto* child : columnReader_->children()) {
+      auto* filter = child->scanSpec()->filter();
+      if (!filter || !child->children().empty()) {
+        continue;
+      }
+      const auto& fileType =
+          static_cast<const ParquetTypeWithId&>(child->fileType());
+      if (fileType.parquetType_.has_value() &&
+          parquetStatsContext_.shouldIgnoreStatistics(
+              fileType.parquetType_.value())) {
+        continue;
+      }
+      const auto& chunk = rowGroup.columns[fileType.column()];
+      if (!chunk.__isset.column_index_offset ||
+          !chunk.__isset.column_index_length ||
+          !chunk.__isset.offset_index_offset ||
+          !chunk.__isset.offset_index_length) {
+        continue;
+      }
+      const auto columnIndex = readPageIndex<thrift::ColumnIndex>(
+          input, chunk.column_index_offset, chunk.column_index_length);
+      const auto offsetIndex = readPageIndex<thrift::OffsetIndex>(
+          input, chunk.offset_index_offset, chunk.offset_index_length);
+      auto columnRanges = pageRowRanges(
+          columnIndex, offsetIndex, rowGroup.num_rows, filter, fileType.type());
+      ranges = ranges.has_value()
+          ? intersectRowRanges(ranges.value(), columnRanges)
+          : std::move(columnRanges);
+    }
+    if (ranges.has_value() && ranges->size() == 1 &&
+        ranges->front() == RowRange{0, rowGroup.num_rows}) {
+      return std::nullopt;
+    }
+    return ranges;
+  }
+
+  // Skips the rows of the current row group that are before the next range
+  // of 'currentRowRanges_'. Returns false if no rows are left to read in the
+  // row group.
+  bool skipToRowRange() {
+    if (!currentRowRanges_) {
+      return true;
+    }
+    const auto& ranges = *currentRowRanges_;
+    while (nextRowRange_ < ranges.size() &&
+           ranges[nextRowRange_].end <= currentRowInGroup_) {
+      ++nextRowRange_;
+    }
+    const uint64_t target = nextRowRange_ < ranges.size()
+        ? std::max<uint64_t>(ranges[nextRowRange_].begin, currentRowInGroup_)
+        : rowsInCurrentRowGroup_;
+    if (target > currentRowInGroup_) {
+      skippedPageRows_ += target - currentRowInGroup_;
+      currentRowInGroup_ = target;
+      // The column readers seek to the new offset on their next read.
+      columnReader_->setReadOffset(target);
+    }
+    return currentRowInGroup_ < rowsInCurrentRowGroup_;
+  }
+
+  // Returns a UnitLoader from the factory in 'options_' with a unit for each
+  // of 'rowGroupIds_'. The factory decides how many row groups are loaded
+  // ahead and within what memory.
+  std::unique_ptr<dwio::common::UnitLoader> createUnitLoader() {
+    auto& reader = static_cast<StructColumnReader&>(*columnReader_);
+    std::vector<std::unique_ptr<dwio::common::LoadUnit>> units;
+    units.reserve(rowGroupIds_.size());
+    for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+      const auto& rowGroup = rowGroups_[rowGroupIds_[i]];
+      const auto& rowRanges = rowRangesOfRowGroup_[i];
+      units.push_back(std::make_unique<RowGroupLoadUnit>(
+          reader,
+          readerBase_->bufferedInput(),
+          rowGroupIds_[i],
+          rowRanges.has_value() ? &rowRanges.value() : nullptr,
+          rowGroup.num_rows,
+          compressedSize(*columnReader_, rowGroup)));
+    }
+    return options_.unitLoaderFactory()->create(std::move(units), 0);
+  }
+
   bool advanceToNextRowGroup() {
     if (nextRowGroupIdsIdx_ == rowGroupIds_.size()) {
       return false;
     }
 
     auto nextRowGroupIndex = rowGroupIds_[nextRowGroupIdsIdx_];
-    readerBase_->scheduleRowGroups(
-        rowGroupIds_,
-        nextRowGroupIdsIdx_,
-        static_cast<StructColumnReader&>(*columnReader_));
+    if (unitLoader_) {
+      // Unloads the previous row group and starts the prefetch of the next
+      // ones if the reads of this one do not.
+      unitLoader_->getLoadedUnit(nextRowGroupIdsIdx_);
+    } else {
+      readerBase_->scheduleRowGroups(
+          rowGroupIds_,
+          nextRowGroupIdsIdx_,
+          static_cast<StructColumnReader&>(*columnReader_),
+          rowRangesOfRowGroup_);
+    }
     currentRowGroupPtr_ = &rowGroups_[rowGroupIds_[nextRowGroupIdsIdx_]];
     rowsInCurrentRowGroup_ = currentRowGroupPtr_->num_rows;
     currentRowInGroup_ = 0;
+    auto& rowRanges = rowRangesOfRowGroup_[nextRowGroupIdsIdx_];
+    currentRowRanges_ = rowRanges.has_value() ? &rowRanges.value() : nullptr;
+    nextRowRange_ = 0;
     nextRowGroupIdsIdx_++;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
     return true;
@@ -1221,7 +1551,22 @@ class ParquetRowReader::Impl {
   uint64_t currentRowInGroup_;
   uint32_t skippedStrides_{0};
 
+  // True if the ColumnIndex and OffsetIndex of the columns are used to skip
+  // the rows of the pages that cannot pass the filters.
+  bool usePageIndex_{false};
+  // The rows that may pass the filters of each of 'rowGroupIds_' according to
+  // the page indexes. std::nullopt if all rows may pass.
+  std::vector<std::optional<std::vector<RowRange>>> rowRangesOfRowGroup_;
+  // The ranges of the current row group, nullptr if all rows may pass.
+  const std::vector<RowRange>* currentRowRanges_{nullptr};
+  // Index in 'currentRowRanges_' of the range of the next row to read.
+  size_t nextRowRange_{0};
+  uint64_t skippedPageRows_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
+  // Loads the row groups if 'options_' has a UnitLoaderFactory. Declared
+  // after 'columnReader_', which the loads in progress use.
+  std::unique_ptr<dwio::common::UnitLoader> unitLoader_;
 
   TypePtr requestedType_;
   ParquetStatsContext parquetStatsContext_;
@@ -1271,6 +1616,10 @@ std::optional<size_t> ParquetRowReader::estimatedRowSize() const {
   return impl_->estimatedRowSize();
 }
 
+std::optional<uint64_t> ParquetRowReader::rowCountFromMetadata() const {
+  return impl_->rowCountFromMetadata();
+}
+
 ParquetReader::ParquetReader(
     std::unique_ptr<dwio::common::BufferedInput> input,
     const dwio::common::ReaderOptions& options)
@@ -110,13 +110,14 @@ void StructColumnReader::read(
 
 std::shared_ptr<dwio::common::BufferedInput> StructColumnReader::loadRowGroup(
     uint32_t index,
-    const std::shared_ptr<dwio::common::BufferedInput>& input) {
+    const std::shared_ptr<dwio::common::BufferedInput>& input,
+    const std::vector<RowRange>* rowRanges) {
   if (isRowGroupBuffered(index, *input)) {
-    enqueueRowGroup(index, *input);
+    enqueueRowGroup(index, *input, rowRanges);
     return input;
   }
   auto newInput = input->clone();
-  enqueueRowGroup(index, *newInput);
+  enqueueRowGroup(index, *newInput, rowRanges);
   newInput->load(dwio::common::LogType::STRIPE);
   return newInput;
 }
@@ -131,16 +132,18 @@ bool StructColumnReader::isRowGroupBuffered(
 
 void StructColumnReader::enqueueRowGroup(
     uint32_t index,
-    dwio::common::BufferedInput& input) {
+    dwio::common::BufferedInput& input,
+    const std::vector<RowRange>* rowRanges) {
   for (auto& child : children_) {
     if (auto structChild = dynamic_cast<StructColumnReader*>(child)) {
-      structChild->enqueueRowGroup(index, input);
+      structChild->enqueueRowGroup(index, input, rowRanges);
     } else if (auto listChild = dynamic_cast<ListColumnReader*>(child)) {
       listChild->enqueueRowGroup(index, input);
     } else if (auto mapChild = dynamic_cast<MapColumnReader*>(child)) {
       mapChild->enqueueRowGroup(index, input);
     } else {
-      child->formatData().as<ParquetData>().enqueueRowGroup(index, input);
+      child->formatData().as<ParquetData>().enqueueRowGroup(
+          index, input, rowRanges);
     }
   }
 }
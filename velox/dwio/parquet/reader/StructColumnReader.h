@@ -28,6 +28,7 @@ namespace facebook::velox::parquet {
 enum class LevelMode;
 class PageReader;
 class ParquetParams;
+struct RowRange;
 
 class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
  public:
@@ -44,10 +45,12 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   /// Creates the streams for 'rowGroup'. Checks whether row 'rowGroup'
   /// has been buffered in 'input'. If true, return the input. Or else creates
-  /// the streams in a new input and loads.
+  /// the streams in a new input and loads. If 'rowRanges' is given, the
+  /// columns that have an OffsetIndex load only the pages with rows in it.
   std::shared_ptr<dwio::common::BufferedInput> loadRowGroup(
       uint32_t index,
-      const std::shared_ptr<dwio::common::BufferedInput>& input);
+      const std::shared_ptr<dwio::common::BufferedInput>& input,
+      const std::vector<RowRange>* rowRanges = nullptr);
 
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
@@ -78,7 +81,10 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
  private:
   dwio::common::SelectiveColumnReader* findBestLeaf();
 
-  void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
+  void enqueueRowGroup(
+      uint32_t index,
+      dwio::common::BufferedInput& input,
+      const std::vector<RowRange>* rowRanges);
 
   bool isRowGroupBuffered(uint32_t index, dwio::common::BufferedInput& input);
 
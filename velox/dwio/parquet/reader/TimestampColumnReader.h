@@ -43,7 +43,41 @@ Timestamp toInt96Timestamp(const int128_t& value) {
   return Timestamp::fromDaysAndNanos(days, nanos);
 }
 
-// Range filter for Parquet Timestamp.
+// Returns the number of units of 'precision' in a second.
+int64_t unitsPerSecond(TimestampPrecision precision) {
+  switch (precision) {
+    case TimestampPrecision::kMilliseconds:
+      return 1'000;
+    case TimestampPrecision::kMicroseconds:
+      return 1'000'000;
+    case TimestampPrecision::kNanoseconds:
+      return 1'000'000'000;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Returns the Int96 encoding of 'ts' as int128_t, i.e. the Julian day in the
+// high 64 bits and the nanos of the day in the low 64 bits. The result is
+// out of the range of the encoded values if the day does not fit in them.
+int128_t toInt96Encoded(const Timestamp& ts) {
+  int64_t days = ts.getSeconds() / Timestamp::kSecondsInDay;
+  int64_t seconds = ts.getSeconds() % Timestamp::kSecondsInDay;
+  if (seconds < 0) {
+    seconds += Timestamp::kSecondsInDay;
+    --days;
+  }
+  const int128_t nanos = static_cast<int128_t>(seconds) *
+          Timestamp::kNanosInSecond +
+      ts.getNanos();
+  return static_cast<int128_t>(days + Timestamp::kJulianToUnixEpochDays) *
+      (static_cast<int128_t>(1) << 64) +
+      nanos;
+}
+
+// Range filter for Parquet Timestamp. The bounds are converted once to the
+// encoding of the file, so that the values are compared as encoded and only
+// the values that pass are converted to Timestamp.
 template <typename T>
 class ParquetTimestampRange final : public common::TimestampRange {
  public:
@@ -60,21 +94,46 @@ class ParquetTimestampRange final : public common::TimestampRange {
       bool nullAllowed,
       TimestampPrecision filePrecision)
       : TimestampRange(lower, upper, nullAllowed),
-        filePrecision_(filePrecision) {}
+        filePrecision_(filePrecision) {
+    if constexpr (std::is_same_v<T, int64_t>) {
+      // The smallest and the largest encoded values in the range. These are
+      // int128_t so that bounds beyond the int64_t range do not overflow.
+      const int64_t units = unitsPerSecond(filePrecision_);
+      const int64_t nanosPerUnit = Timestamp::kNanosInSecond / units;
+      lowerEncoded_ = static_cast<int128_t>(lower.getSeconds()) * units +
+          (lower.getNanos() + nanosPerUnit - 1) / nanosPerUnit;
+      upperEncoded_ = static_cast<int128_t>(upper.getSeconds()) * units +
+          upper.getNanos() / nanosPerUnit;
+    } else {
+      lowerEncoded_ = toInt96Encoded(lower);
+      upperEncoded_ = toInt96Encoded(upper);
+    }
+  }
 
   bool testInt128(const int128_t& value) const final {
-    Timestamp ts;
     if constexpr (std::is_same_v<T, int64_t>) {
-      ts = toInt64Timestamp(value, filePrecision_);
-    } else if constexpr (std::is_same_v<T, int128_t>) {
-      ts = toInt96Timestamp(value);
+      return value >= lowerEncoded_ && value <= upperEncoded_;
+    } else {
+      // The encoded values order like the timestamps if the nanos are within
+      // the day and the day is not negative.
+      constexpr uint64_t kNanosInDay =
+          Timestamp::kSecondsInDay * Timestamp::kNanosInSecond;
+      if (FOLLY_LIKELY(
+              static_cast<uint64_t>(value) < kNanosInDay &&
+              static_cast<uint64_t>(value >> 64) <=
+                  std::numeric_limits<int32_t>::max())) {
+        return value >= lowerEncoded_ && value <= upperEncoded_;
+      }
+      const auto ts = toInt96Timestamp(value);
+      return ts >= this->lower() && ts <= this->upper();
     }
-    return ts >= this->lower() && ts <= this->upper();
   }
 
  private:
   // Only used when T is int64_t.
   const TimestampPrecision filePrecision_;
+  int128_t lowerEncoded_;
+  int128_t upperEncoded_;
 };
 
 } // namespace
@@ -135,10 +194,26 @@ class TimestampColumnReader : public IntegerColumnReader {
       return;
     }
 
-    // Adjust timestamp nanos to the requested precision.
+    // Adjust timestamp nanos to the requested precision. The values are the
+    // ones that passed the filter.
     VectorPtr resultVector = *result;
     auto rawValues =
         resultVector->asUnchecked<FlatVector<Timestamp>>()->mutableRawValues();
+    if constexpr (std::is_same_v<T, int64_t>) {
+      if (!resultVector->mayHaveNulls()) {
+        switch (filePrecision_) {
+          case TimestampPrecision::kMilliseconds:
+            convertInt64<TimestampPrecision::kMilliseconds>(rawValues);
+            return;
+          case TimestampPrecision::kMicroseconds:
+            convertInt64<TimestampPrecision::kMicroseconds>(rawValues);
+            return;
+          case TimestampPrecision::kNanoseconds:
+            convertInt64<TimestampPrecision::kNanoseconds>(rawValues);
+            return;
+        }
+      }
+    }
     for (auto i = 0; i < numValues_; ++i) {
       if (resultVector->isNullAt(i)) {
         continue;
@@ -199,6 +274,34 @@ class TimestampColumnReader : public IntegerColumnReader {
   }
 
  private:
+  // Converts the 'numValues_' Int64 timestamps of 'kPrecision' in 'values'
+  // to Timestamp without branches, so that the loop can be vectorized.
+  template <TimestampPrecision kPrecision>
+  void convertInt64(Timestamp* values) {
+    constexpr int64_t kUnits = kPrecision == TimestampPrecision::kMilliseconds
+        ? 1'000
+        : kPrecision == TimestampPrecision::kMicroseconds ? 1'000'000
+                                                          : 1'000'000'000;
+    constexpr int64_t kNanosPerUnit = Timestamp::kNanosInSecond / kUnits;
+    // Nanos of the requested precision, 1 if it is not coarser than the unit.
+    const int64_t truncateNanos =
+        needsConversion_ && requestedPrecision_ < kPrecision
+        ? Timestamp::kNanosInSecond / unitsPerSecond(requestedPrecision_)
+        : 1;
+    auto* encoded = reinterpret_cast<int128_t*>(values);
+    for (auto i = 0; i < numValues_; ++i) {
+      const int64_t value = static_cast<int64_t>(encoded[i]);
+      // Floor division so that the nanos are positive for negative values.
+      int64_t seconds = value / kUnits;
+      int64_t remainder = value - seconds * kUnits;
+      seconds -= remainder < 0;
+      remainder += remainder < 0 ? kUnits : 0;
+      int64_t nanos = remainder * kNanosPerUnit;
+      nanos -= nanos % truncateNanos;
+      values[i] = Timestamp(seconds, nanos);
+    }
+  }
+
   // The requested precision can be specified from HiveConfig to read timestamp
   // from Parquet.
   const TimestampPrecision requestedPrecision_;
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/common/LevelConversion.h"
+
+#include <random>
+#include <vector>
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/base/BitUtil.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+constexpr int32_t kNumRows = 100'000;
+
+// The levels of a column of 'depth' nested nullable lists of nullable
+// values. The list at depth l is null at definition level 2 * (l - 1), empty
+// at 2 * l - 1 and has items from 2 * l on.
+struct NestedLevels {
+  explicit NestedLevels(int16_t depth) : depth(depth) {
+    std::mt19937 rng(1);
+    for (auto row = 0; row < kNumRows; ++row) {
+      addList(1, 0, rng);
+    }
+    lengths.resize(defLevels.size());
+    nulls.resize(bits::nbytes(defLevels.size()));
+  }
+
+  void addList(int16_t level, int16_t repLevel, std::mt19937& rng) {
+    const auto kind = rng() % 10;
+    if (kind == 0) {
+      add(2 * (level - 1), repLevel);
+      return;
+    }
+    if (kind == 1) {
+      add(2 * level - 1, repLevel);
+      return;
+    }
+    const auto numItems = 1 + rng() % 5;
+    for (auto i = 0; i < numItems; ++i) {
+      const int16_t itemRepLevel = i == 0 ? repLevel : level;
+      if (level < depth) {
+        addList(level + 1, itemRepLevel, rng);
+      } else {
+        // A null or a non-null value.
+        add(rng() % 8 == 0 ? 2 * level : 2 * level + 1, itemRepLevel);
+      }
+    }
+  }
+
+  void add(int16_t defLevel, int16_t repLevel) {
+    defLevels.push_back(defLevel);
+    repLevels.push_back(repLevel);
+  }
+
+  // Converts the levels of all the list levels, as the reader does for each
+  // of the nested readers. Returns the number of lists.
+  int64_t convert() {
+    int64_t numLists = 0;
+    for (int16_t level = 1; level <= depth; ++level) {
+      ValidityBitmapInputOutput io;
+      io.valuesReadUpperBound = defLevels.size();
+      io.validBits = nulls.data();
+      DefRepLevelsToLengths(
+          defLevels.data(),
+          repLevels.data(),
+          defLevels.size(),
+          LevelInfo(1, 2 * level, level, 2 * (level - 1)),
+          &io,
+          lengths.data());
+      numLists += io.valuesRead;
+    }
+    return numLists;
+  }
+
+  const int16_t depth;
+  std::vector<int16_t> defLevels;
+  std::vector<int16_t> repLevels;
+  std::vector<int32_t> lengths;
+  std::vector<uint8_t> nulls;
+};
+
+void run(uint32_t iterations, int16_t depth) {
+  folly::BenchmarkSuspender suspender;
+  NestedLevels levels(depth);
+  suspender.dismiss();
+  int64_t numLists = 0;
+  for (auto i = 0; i < iterations; ++i) {
+    numLists += levels.convert();
+  }
+  folly::doNotOptimizeAway(numLists);
+}
+
+BENCHMARK_NAMED_PARAM(run, depth1, 1);
+BENCHMARK_NAMED_PARAM(run, depth2, 2);
+BENCHMARK_NAMED_PARAM(run, depth3, 3);
+BENCHMARK_NAMED_PARAM(run, depth4, 4);
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
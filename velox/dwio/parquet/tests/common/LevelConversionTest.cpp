@@ -18,12 +18,14 @@
 
 #include "velox/dwio/parquet/common/LevelConversion.h"
 
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/dwio/parquet/common/LevelComparison.h"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <random>
 #include <string>
 #include <vector>
 
@@ -394,6 +396,88 @@ TYPED_TEST(NestedListTest, TestOverflow) {
   this->Run(testData, levelInfo);
 }
 
+// Converts the levels of a list one level at a time, as an independent
+// check of the batched conversion.
+void referenceListInfo(
+    const std::vector<int16_t>& defLevels,
+    const std::vector<int16_t>& repLevels,
+    const LevelInfo& levelInfo,
+    std::vector<int32_t>& offsets,
+    std::vector<bool>& valid) {
+  offsets = {0};
+  valid.clear();
+  for (auto i = 0; i < defLevels.size(); ++i) {
+    if (defLevels[i] < levelInfo.repeatedAncestorDefLevel ||
+        repLevels[i] > levelInfo.repLevel) {
+      continue;
+    }
+    if (repLevels[i] == levelInfo.repLevel) {
+      ++offsets.back();
+    } else {
+      offsets.push_back(
+          offsets.back() + (defLevels[i] >= levelInfo.defLevel ? 1 : 0));
+      valid.push_back(defLevels[i] >= levelInfo.defLevel - 1);
+    }
+  }
+}
+
+TEST(DefRepLevelsToLengths, randomLevels) {
+  std::mt19937 rng(1);
+  for (auto numLevels : {1, 63, 64, 65, 1'000}) {
+    for (int16_t repLevel = 1; repLevel <= 4; ++repLevel) {
+      SCOPED_TRACE(fmt::format("{} levels, repLevel {}", numLevels, repLevel));
+      std::vector<int16_t> defLevels(numLevels);
+      std::vector<int16_t> repLevels(numLevels);
+      for (auto i = 0; i < numLevels; ++i) {
+        defLevels[i] = rng() % (2 * repLevel + 2);
+        repLevels[i] = rng() % (repLevel + 2);
+      }
+      LevelInfo levelInfo(1, 2 * repLevel, repLevel, 2 * repLevel - 2);
+      std::vector<int32_t> expectedOffsets;
+      std::vector<bool> expectedValid;
+      referenceListInfo(
+          defLevels, repLevels, levelInfo, expectedOffsets, expectedValid);
+
+      std::vector<int32_t> offsets(numLevels + 1);
+      std::vector<int32_t> lengths(numLevels);
+      std::vector<uint8_t> validBits(bits::nbytes(numLevels));
+      ValidityBitmapInputOutput io;
+      io.valuesReadUpperBound = numLevels;
+      io.validBits = validBits.data();
+      DefRepLevelsToList(
+          defLevels.data(),
+          repLevels.data(),
+          numLevels,
+          levelInfo,
+          &io,
+          offsets.data());
+      ASSERT_EQ(io.valuesRead, expectedValid.size());
+      offsets.resize(io.valuesRead + 1);
+      EXPECT_EQ(offsets, expectedOffsets);
+      int64_t numNulls = 0;
+      for (auto i = 0; i < expectedValid.size(); ++i) {
+        ASSERT_EQ(bits::isBitSet(validBits.data(), i), expectedValid[i]) << i;
+        numNulls += !expectedValid[i];
+      }
+      EXPECT_EQ(io.nullCount, numNulls);
+
+      ValidityBitmapInputOutput lengthsIo;
+      lengthsIo.valuesReadUpperBound = numLevels;
+      DefRepLevelsToLengths(
+          defLevels.data(),
+          repLevels.data(),
+          numLevels,
+          levelInfo,
+          &lengthsIo,
+          lengths.data());
+      ASSERT_EQ(lengthsIo.valuesRead, expectedValid.size());
+      for (auto i = 0; i < lengthsIo.valuesRead; ++i) {
+        ASSERT_EQ(lengths[i], expectedOffsets[i + 1] - expectedOffsets[i]);
+      }
+    }
+  }
+}
+
 TEST(TestOnlyExtractBitsSoftware, BasicTest) {
   auto check =
       [](uint64_t bitmap, uint64_t selection, uint64_t expected) -> void {
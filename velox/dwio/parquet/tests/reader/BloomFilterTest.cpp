@@ -27,7 +27,9 @@
 
 #include "velox/dwio/common/OutputStream.h"
 #include "velox/dwio/parquet/common/BloomFilter.h"
+#include "velox/common/file/File.h"
 #include "velox/dwio/parquet/common/XxHasher.h"
+#include "velox/dwio/parquet/reader/BloomFilterPruning.h"
 #include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
@@ -395,3 +397,85 @@ TEST_F(BloomFilterTest, TestBloomFilterHashes) {
         << "Hash with seed 0 Error: " << i;
   }
 }
+
+TEST_F(BloomFilterTest, filterPruning) {
+  BlockSplitBloomFilter bloomFilter(leafPool_.get());
+  bloomFilter.init(1024);
+  for (int64_t i = 0; i < 100; i += 2) {
+    bloomFilter.insertHash(bloomFilter.hash(i));
+    bloomFilter.insertHash(bloomFilter.hash(static_cast<int32_t>(i)));
+  }
+  const std::string present = "present";
+  const ByteArray presentBytes(present);
+  bloomFilter.insertHash(bloomFilter.hash(&presentBytes));
+
+  const common::BigintRange equal(10, 10, false);
+  const common::BigintRange range(10, 20, false);
+  const common::BigintRange equalOrNull(11, 11, true);
+  ASSERT_TRUE(canTestBloomFilter(equal, thrift::Type::INT64));
+  ASSERT_TRUE(canTestBloomFilter(equal, thrift::Type::INT32));
+  EXPECT_FALSE(canTestBloomFilter(equal, thrift::Type::BYTE_ARRAY));
+  EXPECT_FALSE(canTestBloomFilter(equal, thrift::Type::DOUBLE));
+  EXPECT_FALSE(canTestBloomFilter(range, thrift::Type::INT64));
+  EXPECT_FALSE(canTestBloomFilter(equalOrNull, thrift::Type::INT64));
+  EXPECT_TRUE(testBloomFilter(equal, bloomFilter, thrift::Type::INT64));
+  EXPECT_TRUE(testBloomFilter(equal, bloomFilter, thrift::Type::INT32));
+  const common::BigintRange absent(11, 11, false);
+  EXPECT_FALSE(testBloomFilter(absent, bloomFilter, thrift::Type::INT64));
+  // Values out of the range of INT32 are never in an INT32 column.
+  const common::BigintRange tooLarge(1L << 40, 1L << 40, false);
+  EXPECT_FALSE(testBloomFilter(tooLarge, bloomFilter, thrift::Type::INT32));
+
+  const auto inList = common::createBigintValues({1, 3, 5, 8}, false);
+  ASSERT_TRUE(canTestBloomFilter(*inList, thrift::Type::INT64));
+  EXPECT_TRUE(testBloomFilter(*inList, bloomFilter, thrift::Type::INT64));
+  const auto absentList = common::createBigintValues({1, 3, 1'001}, false);
+  EXPECT_FALSE(
+      testBloomFilter(*absentList, bloomFilter, thrift::Type::INT64));
+
+  const common::BytesRange equalString(
+      present, false, false, present, false, false, false);
+  ASSERT_TRUE(canTestBloomFilter(equalString, thrift::Type::BYTE_ARRAY));
+  EXPECT_FALSE(canTestBloomFilter(equalString, thrift::Type::INT64));
+  EXPECT_TRUE(
+      testBloomFilter(equalString, bloomFilter, thrift::Type::BYTE_ARRAY));
+  const common::BytesValues strings({"absent", "missing"}, false);
+  ASSERT_TRUE(canTestBloomFilter(strings, thrift::Type::BYTE_ARRAY));
+  EXPECT_FALSE(
+      testBloomFilter(strings, bloomFilter, thrift::Type::BYTE_ARRAY));
+  const common::BytesValues withPresent({"absent", present}, false);
+  EXPECT_TRUE(
+      testBloomFilter(withPresent, bloomFilter, thrift::Type::BYTE_ARRAY));
+}
+
+TEST_F(BloomFilterTest, readFromInput) {
+  // A small filter that fits in the first read of the header and a large
+  // one that takes a second read.
+  for (const uint32_t numBytes : {32, 64 << 10}) {
+    SCOPED_TRACE(fmt::format("numBytes {}", numBytes));
+    BlockSplitBloomFilter bloomFilter(leafPool_.get());
+    bloomFilter.init(numBytes);
+    for (int64_t i = 0; i < 10; ++i) {
+      bloomFilter.insertHash(bloomFilter.hash(i * 7));
+    }
+    dwio::common::DataBufferHolder bufferHolder{*leafPool_, 1024};
+    dwio::common::AppendOnlyBufferedStream sink(
+        std::make_unique<dwio::common::BufferedOutputStream>(bufferHolder));
+    bloomFilter.writeTo(&sink);
+    sink.flush();
+    // The Bloom filter starts at offset 100 and is followed by 10 bytes.
+    std::string file(100, 'x');
+    for (auto& buffer : bufferHolder.getBuffers()) {
+      file.append(buffer.data(), buffer.size());
+    }
+    file.append(10, 'y');
+
+    dwio::common::BufferedInput input(
+        std::make_shared<InMemoryReadFile>(file), *leafPool_);
+    const auto read = BlockSplitBloomFilter::read(input, 100, *leafPool_);
+    EXPECT_EQ(read.getBitsetSize(), numBytes);
+    for (int64_t i = 0; i < 10; ++i) {
+      EXPECT_TRUE(read.findHash(read.hash(i * 7)));
+    }
+  }
+}
@@ -133,6 +133,28 @@ TEST_F(E2EFilterTest, integerDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, pageIndex) {
+  options_.enablePageIndex = true;
+  options_.dataPageSize = 4 * 1024;
+
+  for (auto enableDictionary : {false, true}) {
+    SCOPED_TRACE(fmt::format("enableDictionary {}", enableDictionary));
+    options_.enableDictionary = enableDictionary;
+    testWithTypes(
+        "int_val:int,"
+        "long_val:bigint,"
+        "string_val:string,"
+        "long_null:bigint",
+        [&]() {
+          makeAllNulls("long_null");
+          makeStringDistribution("string_val", 100, true, false);
+        },
+        true,
+        {"int_val", "long_val", "string_val", "long_null"},
+        20);
+  }
+}
+
 TEST_F(E2EFilterTest, integerDeltaBinaryPack) {
   options_.enableDictionary = false;
   options_.encoding =
@@ -331,6 +353,28 @@ TEST_F(E2EFilterTest, floatAndDoubleDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, floatAndDoubleByteStreamSplit) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::BYTE_STREAM_SPLIT;
+
+  testWithTypes(
+      "float_val:float,"
+      "double_val:double,"
+      "float_val2:float,"
+      "double_val2:double,"
+      "float_null:float",
+      [&]() {
+        makeAllNulls("float_null");
+        makeQuantizedFloat<float>("float_val2", 200, true);
+        makeQuantizedFloat<double>("double_val2", 522, true);
+      },
+      false,
+      {"float_val", "double_val", "float_val2", "double_val2", "float_null"},
+      20);
+}
+
 TEST_F(E2EFilterTest, floatAndDouble) {
   // float_val and double_val may be direct since the
   // values are random.float_val2 and double_val2 are expected to be
@@ -539,6 +583,24 @@ TEST_F(E2EFilterTest, stringDeltaByteArray) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDeltaLengthByteArray) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_LENGTH_BYTE_ARRAY;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringDistribution("string_val", 100, true, false);
+        makeStringUnique("string_val_2");
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
 TEST_F(E2EFilterTest, dedictionarize) {
   rowsInRowGroup_ = 10'000;
   options_.dictionaryPageSizeLimit = 20'000;
@@ -707,6 +769,54 @@ TEST_F(E2EFilterTest, combineRowGroup) {
   EXPECT_EQ(parquetReader.numberOfRows(), 5);
 }
 
+TEST_F(E2EFilterTest, reuseDictionaryAcrossRowGroups) {
+  // Row groups with the same values in the same order have the same
+  // dictionary pages.
+  flushEveryNBatches_ = 1;
+  auto batch = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; }),
+       makeFlatVector<std::string>(
+           1'000, [](auto row) { return fmt::format("value {}", row % 7); })});
+  writeToMemory(batch->type(), std::vector<RowVectorPtr>(5, batch), false);
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<InMemoryReadFile>(sinkData_), readerOpts.memoryPool());
+  auto reader = makeReader(readerOpts, std::move(input));
+  ASSERT_EQ(
+      dynamic_cast<ParquetReader&>(*reader).fileMetaData().numRowGroups(), 5);
+
+  auto scanSpec = std::make_shared<ScanSpec>("<root>");
+  scanSpec->addAllChildFields(*batch->type());
+  scanSpec->childByName("c1")->setFilter(std::make_unique<BytesValues>(
+      std::vector<std::string>{"value 3"}, false));
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  VectorPtr result = BaseVector::create(batch->type(), 0, pool());
+  int64_t numRows = 0;
+  while (rowReader->next(300, result) > 0) {
+    auto* rowVector = result->asUnchecked<RowVector>();
+    auto* c0 = rowVector->childAt(0)->loadedVector()->asFlatVector<int64_t>();
+    auto* c1 =
+        rowVector->childAt(1)->loadedVector()->as<SimpleVector<StringView>>();
+    for (auto i = 0; i < rowVector->size(); ++i) {
+      ASSERT_EQ(c1->valueAt(i).str(), "value 3");
+      // Rows 3, 10, 17... of each row group pass.
+      const auto row = (numRows + i) % 143 * 7 + 3;
+      ASSERT_EQ(c0->valueAt(i), row % 10);
+    }
+    numRows += rowVector->size();
+  }
+  EXPECT_EQ(numRows, 5 * 143);
+
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  // Each column reuses the dictionary of the first row group in the other
+  // four.
+  EXPECT_EQ(stats.columnReaderStatistics.reusedDictionaryPages, 8);
+}
+
 TEST_F(E2EFilterTest, writeDecimalAsInteger) {
   auto rowVector = makeRowVector(
       {makeFlatVector<int64_t>({1, 2}, DECIMAL(8, 2)),
@@ -14,7 +14,13 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/common/PrefetchUnitLoader.h"
+#include "velox/dwio/parquet/reader/TimestampColumnReader.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
@@ -98,6 +104,43 @@ TEST_F(ParquetReaderTest, parseSample) {
       sampleSchema(), *rowReader, expected, *leafPool_);
 }
 
+TEST_F(ParquetReaderTest, fileMetadataCache) {
+  FileMetadataCache metadataCache(1 << 20);
+  FileMetadataCache::setInstance(&metadataCache);
+  SCOPE_EXIT {
+    FileMetadataCache::setInstance(nullptr);
+  };
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+      makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+  });
+  const auto read = [&](std::optional<int64_t> modificationTime) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setFileModificationTime(modificationTime);
+    auto reader = createReader(sample, readerOptions);
+    auto rowReaderOpts = getReaderOpts(sampleSchema());
+    rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(
+        sampleSchema(), *rowReader, expected, *leafPool_);
+  };
+
+  // The files with no known modification time are not cached.
+  read(std::nullopt);
+  EXPECT_EQ(metadataCache.stats().numEntries, 0);
+  read(1);
+  EXPECT_EQ(metadataCache.stats().numEntries, 1);
+  EXPECT_EQ(metadataCache.stats().numHits, 0);
+  read(1);
+  EXPECT_EQ(metadataCache.stats().numHits, 1);
+  // A newer version of the file does not get the old metadata.
+  read(2);
+  EXPECT_EQ(metadataCache.stats().numHits, 1);
+  EXPECT_EQ(metadataCache.stats().numEntries, 2);
+  EXPECT_GT(metadataCache.stats().bytes, 0);
+}
+
 TEST_F(ParquetReaderTest, parseEmptyNestedList) {
   // parse_empty_nested_list.parquet holds 1,000 rows of the following data:
   //
@@ -1266,6 +1309,45 @@ TEST_F(ParquetReaderTest, prefetchRowGroups) {
   }
 }
 
+TEST_F(ParquetReaderTest, prefetchRowGroupsWithUnitLoader) {
+  auto rowType = ROW({"id"}, {BIGINT()});
+  const std::string sample(getExampleFilePath("multiple_row_groups.parquet"));
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  readerOptions.setFilePreloadThreshold(0);
+  auto reader = createReader(sample, readerOptions);
+
+  auto readAll = [&](std::shared_ptr<UnitLoaderFactory> factory) {
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+    rowReaderOpts.setUnitLoaderFactory(std::move(factory));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    std::vector<VectorPtr> batches;
+    for (;;) {
+      VectorPtr result = BaseVector::create(rowType, 0, pool_.get());
+      if (rowReader->next(100, result) == 0) {
+        return batches;
+      }
+      batches.push_back(std::move(result));
+    }
+  };
+
+  const auto expected = readAll(nullptr);
+  ASSERT_FALSE(expected.empty());
+  folly::CPUThreadPoolExecutor executor(2);
+  for (auto numPrefetchUnits : {1, 3}) {
+    SCOPED_TRACE(fmt::format("numPrefetchUnits {}", numPrefetchUnits));
+    const auto actual = readAll(std::make_shared<PrefetchUnitLoaderFactory>(
+        &executor,
+        PrefetchUnitLoaderFactory::Options{
+            .numPrefetchUnits = static_cast<uint32_t>(numPrefetchUnits)},
+        nullptr));
+    ASSERT_EQ(actual.size(), expected.size());
+    for (auto i = 0; i < expected.size(); ++i) {
+      assertEqualVectors(expected[i], actual[i]);
+    }
+  }
+}
+
 TEST_F(ParquetReaderTest, testEmptyRowGroups) {
   // empty_row_groups.parquet contains empty row groups
   const std::string sample(getExampleFilePath("empty_row_groups.parquet"));
@@ -1733,3 +1815,245 @@ TEST_F(ParquetReaderTest, fileColumnVarcharToMetadataColumnMismatchTest) {
     runVarcharColTest(type);
   }
 }
+
+TEST_F(ParquetReaderTest, pageIndexSparseRowRanges) {
+  // 'c0' is sorted, so the page index narrows the filter on it to sparse row
+  // ranges. With 1KB pages, a page holds about 128 values, so both ranges
+  // span several pages and start and end in the middle of a page.
+  constexpr int64_t kNumRows = 100'000;
+  const auto data = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(kNumRows, [](auto row) { return row * 3; })});
+  const auto rowType = asRowType(data->type());
+  std::vector<int64_t> expectedRows;
+  for (auto row = 1'000; row <= 1'100; ++row) {
+    expectedRows.push_back(row);
+  }
+  for (auto row = 5'050; row <= 5'300; ++row) {
+    expectedRows.push_back(row);
+  }
+  const auto expected = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(expectedRows),
+       makeFlatVector<int64_t>(
+           expectedRows.size(),
+           [&](auto row) { return expectedRows[row] * 3; })});
+
+  // Returns the bytes read by the filtered scan after opening the file, and
+  // the total bytes of the column chunks.
+  const auto read = [&](bool enablePageIndex) {
+    const auto filePath = fmt::format(
+        "{}/pageIndex{}.parquet", tempPath_->getPath(), enablePageIndex);
+    facebook::velox::parquet::WriterOptions options;
+    options.memoryPool = rootPool_.get();
+    options.enableDictionary = false;
+    options.dataPageSize = 1'024;
+    options.enablePageIndex = enablePageIndex;
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        createSink(filePath), options, rowType);
+    writer->write(data);
+    writer->close();
+
+    // The page loads are not coalesced, so that only the loaded pages are
+    // read.
+    auto file = std::make_shared<LocalReadFile>(filePath);
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setFilePreloadThreshold(0);
+    readerOptions.setFooterEstimatedSize(64 << 10);
+    auto input = std::make_unique<BufferedInput>(
+        file, *leafPool_, MetricsLog::voidLog(), nullptr, nullptr, 0);
+    auto reader =
+        std::make_unique<ParquetReader>(std::move(input), readerOptions);
+    const auto rowGroup = reader->fileMetaData().rowGroup(0);
+    EXPECT_EQ(reader->fileMetaData().numRowGroups(), 1);
+    EXPECT_EQ(rowGroup.columnChunk(0).hasOffsetIndex(), enablePageIndex);
+    const uint64_t chunkBytes = rowGroup.columnChunk(0).totalCompressedSize() +
+        rowGroup.columnChunk(1).totalCompressedSize();
+
+    file->resetBytesRead();
+    std::vector<std::unique_ptr<BigintRange>> ranges;
+    ranges.push_back(std::make_unique<BigintRange>(1'000, 1'100, false));
+    ranges.push_back(std::make_unique<BigintRange>(5'050, 5'300, false));
+    FilterMap filters;
+    filters.insert(
+        {"c0", std::make_unique<BigintMultiRange>(std::move(ranges), false)});
+    assertReadWithReaderAndFilters(
+        std::move(reader), "", rowType, std::move(filters), expected);
+    return std::make_pair(file->bytesRead(), chunkBytes);
+  };
+
+  // Without a page index, the column chunks are read whole.
+  const auto [fullBytesRead, fullChunkBytes] = read(false);
+  EXPECT_GE(fullBytesRead, fullChunkBytes);
+
+  // With a page index, only the pages with rows in the ranges are read, along
+  // with the page index itself.
+  const auto [bytesRead, chunkBytes] = read(true);
+  EXPECT_GT(bytesRead, 0);
+  EXPECT_LT(bytesRead, chunkBytes / 10);
+}
+
+TEST_F(ParquetReaderTest, timestampRangeOnEncodedValues) {
+  // Compares the filter on the encoded values with the filter on the
+  // timestamps, for the encoded values around the bounds.
+  const auto testInt64 = [](const Timestamp& lower,
+                            const Timestamp& upper,
+                            TimestampPrecision unit) {
+    ParquetTimestampRange<int64_t> filter(lower, upper, false, unit);
+    const int64_t units = unit == TimestampPrecision::kMilliseconds
+        ? 1'000
+        : 1'000'000;
+    for (const auto& bound : {lower, upper}) {
+      const int64_t encoded = bound.getSeconds() * units +
+          bound.getNanos() / (Timestamp::kNanosInSecond / units);
+      for (auto value = encoded - 2; value <= encoded + 2; ++value) {
+        const auto ts = unit == TimestampPrecision::kMilliseconds
+            ? Timestamp::fromMillis(value)
+            : Timestamp::fromMicros(value);
+        EXPECT_EQ(filter.testInt128(value), ts >= lower && ts <= upper)
+            << ts.toString();
+      }
+    }
+  };
+  // Bounds that are not aligned to the unit.
+  testInt64(
+      Timestamp(10, 500'001),
+      Timestamp(20, 999'999'999),
+      TimestampPrecision::kMilliseconds);
+  testInt64(
+      Timestamp(10, 500'001),
+      Timestamp(20, 999'999'999),
+      TimestampPrecision::kMicroseconds);
+  // Bounds before 1970, aligned and not aligned to the unit.
+  testInt64(
+      Timestamp(-20, 0),
+      Timestamp(-10, 999'500'000),
+      TimestampPrecision::kMilliseconds);
+  testInt64(
+      Timestamp(-20, 1),
+      Timestamp(-1, 999'999'999),
+      TimestampPrecision::kMicroseconds);
+  {
+    // [-0.5ms, 0.5ms] holds only 0 in millis.
+    ParquetTimestampRange<int64_t> filter(
+        Timestamp(-1, 999'500'000),
+        Timestamp(0, 500'000),
+        false,
+        TimestampPrecision::kMilliseconds);
+    EXPECT_FALSE(filter.testInt128(-1));
+    EXPECT_TRUE(filter.testInt128(0));
+    EXPECT_FALSE(filter.testInt128(1));
+  }
+
+  // Int96 values are the Julian day in the high 64 bits and the nanos of the
+  // day in the low 64 bits.
+  constexpr int64_t kNanosInDay =
+      Timestamp::kSecondsInDay * Timestamp::kNanosInSecond;
+  const auto int96 = [](int64_t days, uint64_t nanos) {
+    return static_cast<int128_t>(days + Timestamp::kJulianToUnixEpochDays)
+        << 64 |
+        nanos;
+  };
+  const auto testInt96 = [&](const Timestamp& lower,
+                             const Timestamp& upper,
+                             int128_t value) {
+    ParquetTimestampRange<int128_t> filter(
+        lower, upper, false, TimestampPrecision::kNanoseconds);
+    const auto ts = Timestamp::fromDaysAndNanos(
+        static_cast<int32_t>(value >> 64), static_cast<uint64_t>(value));
+    const bool passed = filter.testInt128(value);
+    EXPECT_EQ(passed, ts >= lower && ts <= upper) << ts.toString();
+    return passed;
+  };
+  // Before 1970.
+  const Timestamp lower(-1, 999'999'999);
+  const Timestamp upper(0, 10);
+  EXPECT_FALSE(testInt96(lower, upper, int96(-1, kNanosInDay - 2)));
+  EXPECT_TRUE(testInt96(lower, upper, int96(-1, kNanosInDay - 1)));
+  EXPECT_TRUE(testInt96(lower, upper, int96(0, 10)));
+  EXPECT_FALSE(testInt96(lower, upper, int96(0, 11)));
+  EXPECT_FALSE(testInt96(
+      Timestamp(-2 * Timestamp::kSecondsInDay, 0),
+      Timestamp(-1, 0),
+      int96(-1, kNanosInDay - 1)));
+  // The nanos are outside of the day, so the encoded values do not order
+  // like the timestamps.
+  EXPECT_TRUE(testInt96(lower, upper, int96(-1, kNanosInDay + 5)));
+  EXPECT_FALSE(testInt96(lower, upper, int96(-1, kNanosInDay + 11)));
+  EXPECT_TRUE(testInt96(
+      Timestamp(2 * Timestamp::kSecondsInDay, 0),
+      Timestamp(3 * Timestamp::kSecondsInDay, 0),
+      int96(0, 2 * kNanosInDay)));
+  EXPECT_FALSE(testInt96(
+      Timestamp(0, 0), Timestamp(1, 0), int96(0, 2 * kNanosInDay)));
+}
+
+TEST_F(ParquetReaderTest, timestampInt64FilterWithoutNulls) {
+  // 'c0' has no nulls and is converted in the fast path. 'c1' has the same
+  // values with some nulls and is converted one value at a time.
+  constexpr int32_t kSize = 1'000;
+  for (const auto unit :
+       {TimestampPrecision::kMilliseconds,
+        TimestampPrecision::kMicroseconds}) {
+    SCOPED_TRACE(fmt::format("unit {}", static_cast<int>(unit)));
+    // Values before and after 1970 that are not aligned to a second.
+    const auto valueAt = [&](auto row) {
+      const int64_t value = (row - kSize / 2) * 1'234'567LL + 7;
+      return unit == TimestampPrecision::kMilliseconds
+          ? Timestamp::fromMillis(value)
+          : Timestamp::fromMicros(value);
+    };
+    const auto isNullAt = [](auto row) { return row % 5 == 0; };
+    const auto data = makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<Timestamp>(kSize, valueAt),
+         makeFlatVector<Timestamp>(kSize, valueAt, isNullAt)});
+    const auto rowType = asRowType(data->type());
+
+    const auto filePath = fmt::format(
+        "{}/timestamp{}.parquet",
+        tempPath_->getPath(),
+        static_cast<int>(unit));
+    facebook::velox::parquet::WriterOptions options;
+    options.memoryPool = rootPool_.get();
+    options.enableDictionary = false;
+    options.parquetWriteTimestampUnit = unit;
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        createSink(filePath), options, rowType);
+    writer->write(data);
+    writer->close();
+
+    // The bounds are 1ns after the values of rows 200 and 700, so the rows in
+    // (200, 700] pass. The values are read in milliseconds.
+    constexpr int32_t kFirst = 201;
+    constexpr int32_t kLast = 700;
+    const auto afterValueAt = [&](auto row) {
+      const auto ts = valueAt(row);
+      return Timestamp(ts.getSeconds(), ts.getNanos() + 1);
+    };
+    const auto expectedAt = [&](auto row) {
+      return valueAt(row + kFirst).toPrecision(
+          TimestampPrecision::kMilliseconds);
+    };
+    const auto expected = makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<Timestamp>(kLast - kFirst + 1, expectedAt),
+         makeFlatVector<Timestamp>(
+             kLast - kFirst + 1,
+             expectedAt,
+             [&](auto row) { return isNullAt(row + kFirst); })});
+    FilterMap filters;
+    filters.insert(
+        {"c0",
+         std::make_unique<TimestampRange>(
+             afterValueAt(kFirst - 1), afterValueAt(kLast), false)});
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    assertReadWithReaderAndFilters(
+        createReader(filePath, readerOptions),
+        "",
+        rowType,
+        std::move(filters),
+        expected);
+  }
+}
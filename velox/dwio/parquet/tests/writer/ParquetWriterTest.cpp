@@ -427,6 +427,39 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, encodingMemoryFromWriterPool) {
+  const auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  constexpr int64_t kRows = 10'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row * 3; }),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("value {}", row % 100); }),
+  });
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  auto writerPool = rootPool_->addAggregateChild("writer");
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, writerPool, schema);
+  writer->write(data);
+  writer->close();
+  // The column writers and encoders of the row group allocate from the
+  // writer's pool and free all their memory by the end of the write.
+  EXPECT_GT(writerPool->peakBytes(), 0);
+  writer.reset();
+  EXPECT_EQ(writerPool->usedBytes(), 0);
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), kRows);
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+}
+
 TEST_F(ParquetWriterTest, testPageSizeAndBatchSizeConfiguration) {
   const auto schema = ROW({"c0"}, {SMALLINT()});
   constexpr int64_t kRows = 10'000;
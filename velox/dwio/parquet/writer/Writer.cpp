@@ -17,6 +17,7 @@
 #include "velox/dwio/parquet/writer/Writer.h"
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
+#include <arrow/memory_pool.h>
 #include <arrow/table.h>
 #include "velox/common/base/Pointers.h"
 #include "velox/common/config/Config.h"
@@ -97,7 +98,107 @@ class ArrowDataBufferSink : public ::arrow::io::OutputStream {
   int64_t bytesFlushed_ = 0;
 };
 
+// Allocates the memory of the Arrow Parquet writer, i.e. the column writers,
+// their encoders and the pages buffered for a row group, from a Velox memory
+// pool. This makes the encoding memory count against the query and be seen
+// by the memory arbitration like the rest of the writer's memory.
+class ArrowMemoryPool : public ::arrow::MemoryPool {
+ public:
+  explicit ArrowMemoryPool(memory::MemoryPool& pool) : pool_(pool) {}
+
+  using ::arrow::MemoryPool::Allocate;
+  using ::arrow::MemoryPool::Free;
+  using ::arrow::MemoryPool::Reallocate;
+
+  ::arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out)
+      override {
+    if (size == 0) {
+      *out = zeroSizeArea();
+      return ::arrow::Status::OK();
+    }
+    if (alignment > memory::MemoryAllocator::kMaxAlignment) {
+      return ::arrow::Status::Invalid(
+          "Unsupported alignment for Velox memory pool: ", alignment);
+    }
+    try {
+      *out = reinterpret_cast<uint8_t*>(pool_.allocate(size));
+    } catch (const std::exception& e) {
+      return ::arrow::Status::OutOfMemory(e.what());
+    }
+    bytesAllocated_ += size;
+    totalBytesAllocated_ += size;
+    ++numAllocations_;
+    return ::arrow::Status::OK();
+  }
+
+  ::arrow::Status Reallocate(
+      int64_t oldSize,
+      int64_t newSize,
+      int64_t alignment,
+      uint8_t** ptr) override {
+    if (oldSize == 0) {
+      return Allocate(newSize, alignment, ptr);
+    }
+    if (newSize == 0) {
+      Free(*ptr, oldSize, alignment);
+      *ptr = zeroSizeArea();
+      return ::arrow::Status::OK();
+    }
+    try {
+      *ptr = reinterpret_cast<uint8_t*>(
+          pool_.reallocate(*ptr, oldSize, newSize));
+    } catch (const std::exception& e) {
+      return ::arrow::Status::OutOfMemory(e.what());
+    }
+    bytesAllocated_ += newSize - oldSize;
+    if (newSize > oldSize) {
+      totalBytesAllocated_ += newSize - oldSize;
+    }
+    ++numAllocations_;
+    return ::arrow::Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size, int64_t /*alignment*/) override {
+    if (size == 0) {
+      return;
+    }
+    pool_.free(buffer, size);
+    bytesAllocated_ -= size;
+  }
+
+  int64_t bytes_allocated() const override {
+    return bytesAllocated_;
+  }
+
+  int64_t total_bytes_allocated() const override {
+    return totalBytesAllocated_;
+  }
+
+  int64_t num_allocations() const override {
+    return numAllocations_;
+  }
+
+  std::string backend_name() const override {
+    return "velox";
+  }
+
+ private:
+  // Arrow allocates empty buffers. These get one non-null address that is
+  // never freed.
+  static uint8_t* zeroSizeArea() {
+    alignas(memory::MemoryAllocator::kMaxAlignment) static uint8_t area[1];
+    return area;
+  }
+
+  memory::MemoryPool& pool_;
+  std::atomic<int64_t> bytesAllocated_{0};
+  std::atomic<int64_t> totalBytesAllocated_{0};
+  std::atomic<int64_t> numAllocations_{0};
+};
+
 struct ArrowContext {
+  // Declared first so that it outlives the Arrow objects that use it.
+  std::unique_ptr<ArrowMemoryPool> pool;
   std::unique_ptr<FileWriter> writer;
   std::shared_ptr<::arrow::Schema> schema;
   std::shared_ptr<WriterProperties> properties;
@@ -128,9 +229,11 @@ namespace {
 
 std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
     const parquet::WriterOptions& options,
-    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy) {
+    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy,
+    ::arrow::MemoryPool* pool) {
   auto builder = WriterProperties::Builder();
   WriterProperties::Builder* properties = &builder;
+  properties = properties->memory_pool(pool);
   if (options.enableDictionary.value_or(
           facebook::velox::parquet::arrow::DEFAULT_IS_DICTIONARY_ENABLED)) {
     properties = properties->enable_dictionary();
@@ -164,6 +267,9 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
     properties =
         properties->data_page_version(arrow::ParquetDataPageVersion::V1);
   }
+  if (options.enablePageIndex.value_or(false)) {
+    properties = properties->enable_write_page_index();
+  }
   return properties->build();
 }
 
@@ -334,8 +440,9 @@ Writer::Writer(
   options_.timestampTimeZone = options.parquetWriteTimestampTimeZone;
   common::testutil::TestValue::adjust(
       "facebook::velox::parquet::Writer::Writer", &options_);
-  arrowContext_->properties =
-      getArrowParquetWriterOptions(options, flushPolicy_);
+  arrowContext_->pool = std::make_unique<ArrowMemoryPool>(*generalPool_);
+  arrowContext_->properties = getArrowParquetWriterOptions(
+      options, flushPolicy_, arrowContext_->pool.get());
   setMemoryReclaimers();
   writeInt96AsTimestamp_ = options.writeInt96AsTimestamp;
 }
@@ -364,7 +471,7 @@ void Writer::flush() {
           arrowContext_->writer,
           FileWriter::Open(
               *arrowContext_->schema.get(),
-              ::arrow::default_memory_pool(),
+              arrowContext_->pool.get(),
               stream_,
               arrowContext_->properties,
               arrowProperties));
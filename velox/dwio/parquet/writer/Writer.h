@@ -111,6 +111,9 @@ struct WriterOptions : public dwio::common::WriterOptions {
   std::optional<int64_t> dictionaryPageSizeLimit;
   std::optional<bool> enableDictionary;
   std::optional<bool> useParquetDataPageV2;
+  /// Writes the ColumnIndex and OffsetIndex of the column chunks, which let
+  /// readers skip the pages whose values cannot pass their filters.
+  std::optional<bool> enablePageIndex;
 
   // Parsing session and hive configs.
 
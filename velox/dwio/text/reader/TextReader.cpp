@@ -0,0 +1,558 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include <strings.h>
+
+#include <folly/Conv.h>
+#include <folly/io/IOBuf.h>
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/common/encode/Base64.h"
+#include "velox/type/TimestampConversion.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::text {
+
+namespace {
+
+constexpr char kNewLine = '\n';
+
+bool isSupported(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return !type.isDecimal();
+    default:
+      return false;
+  }
+}
+
+// Returns the compression of a file from its first bytes.
+common::CompressionKind detectCompression(const char* magic, uint64_t size) {
+  if (size >= 2 && magic[0] == '\x1f' && magic[1] == '\x8b') {
+    return common::CompressionKind_GZIP;
+  }
+  if (size >= 4 && memcmp(magic, "\x28\xb5\x2f\xfd", 4) == 0) {
+    return common::CompressionKind_ZSTD;
+  }
+  return common::CompressionKind_NONE;
+}
+
+std::optional<bool> parseBoolean(const char* data, uint64_t size) {
+  if (size == 4 && strncasecmp(data, "true", 4) == 0) {
+    return true;
+  }
+  if (size == 5 && strncasecmp(data, "false", 5) == 0) {
+    return false;
+  }
+  return std::nullopt;
+}
+
+template <typename T>
+std::optional<T> parseInteger(const char* data, uint64_t size) {
+  uint64_t i = 0;
+  const bool negative = size > 0 && data[0] == '-';
+  if (size > 0 && (negative || data[0] == '+')) {
+    ++i;
+  }
+  if (i == size) {
+    return std::nullopt;
+  }
+  // Negative values are accumulated downwards so that the minimum of the
+  // type parses without overflow.
+  int64_t value = 0;
+  for (; i < size; ++i) {
+    const uint8_t digit = data[i] - '0';
+    if (digit > 9 || __builtin_mul_overflow(value, 10, &value) ||
+        (negative ? __builtin_sub_overflow(value, digit, &value)
+                  : __builtin_add_overflow(value, digit, &value))) {
+      return std::nullopt;
+    }
+  }
+  if (value < std::numeric_limits<T>::min() ||
+      value > std::numeric_limits<T>::max()) {
+    return std::nullopt;
+  }
+  return static_cast<T>(value);
+}
+
+template <typename T>
+std::optional<T> parseFloatingPoint(const char* data, uint64_t size) {
+  auto result = folly::tryTo<T>(folly::StringPiece(data, size));
+  if (result.hasError()) {
+    return std::nullopt;
+  }
+  return result.value();
+}
+
+template <typename T>
+void setOrNull(BaseVector& vector, vector_size_t row, std::optional<T> value) {
+  if (value.has_value()) {
+    vector.asUnchecked<FlatVector<T>>()->set(row, value.value());
+  } else {
+    vector.setNull(row, true);
+  }
+}
+
+} // namespace
+
+DelimiterScanner::DelimiterScanner(
+    const dwio::common::SerDeOptions& serDeOptions,
+    char lineDelim)
+    : fieldDelim_(static_cast<char>(serDeOptions.separators[0])),
+      lineDelim_(lineDelim),
+      escapeChar_(static_cast<char>(serDeOptions.escapeChar)),
+      escaped_(serDeOptions.isEscaped) {}
+
+uint64_t DelimiterScanner::delimiterBits(const char* data, uint64_t size)
+    const {
+  if (size < 64) {
+    uint64_t bits = 0;
+    for (uint64_t i = 0; i < size; ++i) {
+      const char c = data[i];
+      if (c == fieldDelim_ || c == lineDelim_ ||
+          (escaped_ && c == escapeChar_)) {
+        bits |= 1UL << i;
+      }
+    }
+    return bits;
+  }
+  using Batch = xsimd::batch<uint8_t>;
+  const auto fieldDelims =
+      Batch::broadcast(static_cast<uint8_t>(fieldDelim_));
+  const auto lineDelims = Batch::broadcast(static_cast<uint8_t>(lineDelim_));
+  const auto escapes = Batch::broadcast(static_cast<uint8_t>(escapeChar_));
+  uint64_t bits = 0;
+  for (int32_t i = 0; i < 64; i += Batch::size) {
+    const auto bytes =
+        Batch::load_unaligned(reinterpret_cast<const uint8_t*>(data) + i);
+    auto hits = (bytes == fieldDelims) | (bytes == lineDelims);
+    if (escaped_) {
+      hits = hits | (bytes == escapes);
+    }
+    uint64_t mask = simd::toBitMask(hits);
+    if constexpr (Batch::size < 64) {
+      mask &= (1UL << Batch::size) - 1;
+    }
+    bits |= mask << i;
+  }
+  return bits;
+}
+
+TextRowReader::TextRowReader(
+    const RowTypePtr& fileType,
+    const std::shared_ptr<dwio::common::BufferedInput>& input,
+    common::CompressionKind compression,
+    const dwio::common::ReaderOptions& readerOptions,
+    const dwio::common::RowReaderOptions& options)
+    : serDeOptions_(readerOptions.serDeOptions()),
+      input_(input),
+      scanSpec_(options.scanSpec()),
+      fileType_(fileType),
+      scanner_(serDeOptions_, kNewLine),
+      pool_(readerOptions.memoryPool()),
+      loadQuantum_(readerOptions.loadQuantum()),
+      buffer_(pool_) {
+  VELOX_CHECK_NOT_NULL(scanSpec_, "Text reader requires a scan spec");
+  if (options.rowNumberColumnInfo().has_value()) {
+    VELOX_NYI("Row numbers are not supported yet in TextReader");
+  }
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (const auto& childSpec : scanSpec_->children()) {
+    if (childSpec->isConstant()) {
+      continue;
+    }
+    const auto fileIndex =
+        fileType_->getChildIdxIfExists(childSpec->fieldName());
+    VELOX_CHECK(
+        fileIndex.has_value(),
+        "Column {} is not in the text file schema",
+        childSpec->fieldName());
+    const auto& type = fileType_->childAt(fileIndex.value());
+    if (!isSupported(*type)) {
+      VELOX_NYI("{} is not supported yet in TextReader", type->toString());
+    }
+    columns_.push_back({fileIndex.value(), type});
+    names.push_back(childSpec->fieldName());
+    types.push_back(type);
+  }
+  inputType_ = ROW(std::move(names), std::move(types));
+
+  if (compression != common::CompressionKind_NONE) {
+    if (options.offset() > 0) {
+      atEnd_ = true;
+      return;
+    }
+    decompress(compression);
+    rangeEnd_ = fileSize_;
+  } else {
+    fileSize_ = input_->getReadFile()->size();
+    rangeEnd_ = std::min(options.limit(), fileSize_);
+  }
+  seekToFirstRow(options.offset(), options.skipRows());
+}
+
+void TextRowReader::decompress(common::CompressionKind compression) {
+  const auto compressedSize = input_->getReadFile()->size();
+  auto compressed = folly::IOBuf::create(compressedSize);
+  input_->getInputStream()->read(
+      compressed->writableData(),
+      compressedSize,
+      0,
+      dwio::common::LogType::FILE);
+  compressed->append(compressedSize);
+  decompressed_ =
+      common::compressionKindToCodec(compression)->uncompress(compressed.get());
+  decompressed_->coalesce();
+  fileSize_ = decompressed_->length();
+}
+
+void TextRowReader::seekToFirstRow(uint64_t offset, uint64_t skipRows) {
+  if (offset > 0) {
+    // The row that contains the byte before the range belongs to the
+    // previous split, so the first row starts after the first newline from
+    // there.
+    bufferOffset_ = offset - 1;
+    readOffset_ = offset - 1;
+    if (!skipLine()) {
+      atEnd_ = true;
+      return;
+    }
+    // The header rows are only at the start of the file.
+    skipRows = 0;
+  }
+  for (uint64_t i = 0; i < skipRows; ++i) {
+    if (!skipLine()) {
+      atEnd_ = true;
+      return;
+    }
+  }
+}
+
+bool TextRowReader::loadMore() {
+  if (readOffset_ >= fileSize_) {
+    return false;
+  }
+  const auto remaining = buffer_.size() - position_;
+  if (position_ > 0) {
+    memmove(buffer_.data(), buffer_.data() + position_, remaining);
+    bufferOffset_ += position_;
+    position_ = 0;
+  }
+  const auto readSize = std::min(loadQuantum_, fileSize_ - readOffset_);
+  buffer_.resize(remaining + readSize);
+  readFile(readOffset_, readSize, buffer_.data() + remaining);
+  readOffset_ += readSize;
+  bitsValid_ = false;
+  return true;
+}
+
+void TextRowReader::readFile(
+    uint64_t offset,
+    uint64_t size,
+    char* destination) {
+  if (decompressed_ != nullptr) {
+    memcpy(destination, decompressed_->data() + offset, size);
+    return;
+  }
+  input_->getInputStream()->read(
+      destination, size, offset, dwio::common::LogType::STREAM);
+}
+
+uint64_t TextRowReader::nextDelimiter(uint64_t position) {
+  const auto size = buffer_.size();
+  while (position < size) {
+    if (!bitsValid_ || position < bitsStart_ || position >= bitsStart_ + 64) {
+      bitsStart_ = position;
+      bits_ =
+          scanner_.delimiterBits(buffer_.data() + position, size - position);
+      bitsValid_ = true;
+    }
+    const auto bits = bits_ & (~0UL << (position - bitsStart_));
+    if (bits != 0) {
+      return bitsStart_ + __builtin_ctzll(bits);
+    }
+    position = bitsStart_ + 64;
+  }
+  return size;
+}
+
+bool TextRowReader::skipLine() {
+  for (;;) {
+    if (position_ < buffer_.size()) {
+      const auto* newLine = static_cast<const char*>(memchr(
+          buffer_.data() + position_, kNewLine, buffer_.size() - position_));
+      if (newLine != nullptr) {
+        position_ = newLine - buffer_.data() + 1;
+        return true;
+      }
+      position_ = buffer_.size();
+    }
+    if (!loadMore()) {
+      return false;
+    }
+  }
+}
+
+bool TextRowReader::readRow(vector_size_t row, RowVector& input) {
+  const char fieldDelim = static_cast<char>(serDeOptions_.separators[0]);
+  // The delimiters after the last column are data if the last column takes
+  // the rest of the row.
+  const auto maxFields = serDeOptions_.lastColumnTakesRest
+      ? fileType_->size()
+      : std::numeric_limits<size_t>::max();
+  uint64_t rowEnd;
+  for (;;) {
+    if (bufferOffset_ + position_ >= rangeEnd_) {
+      return false;
+    }
+    if (position_ == buffer_.size()) {
+      if (!loadMore()) {
+        return false;
+      }
+      continue;
+    }
+    fieldStarts_.clear();
+    fieldEnds_.clear();
+    fieldEscapes_.clear();
+    auto addField = [&](uint64_t start, uint64_t end, bool hasEscape) {
+      fieldStarts_.push_back(start);
+      fieldEnds_.push_back(end);
+      fieldEscapes_.push_back(hasEscape);
+    };
+    uint64_t fieldStart = position_;
+    uint64_t position = position_;
+    bool hasEscape = false;
+    bool complete = false;
+    for (;;) {
+      position = nextDelimiter(position);
+      if (position >= buffer_.size()) {
+        break;
+      }
+      const char c = buffer_.data()[position];
+      if (c == kNewLine) {
+        addField(fieldStart, position, hasEscape);
+        rowEnd = position + 1;
+        complete = true;
+        break;
+      }
+      if (c == fieldDelim) {
+        if (fieldStarts_.size() + 1 < maxFields) {
+          addField(fieldStart, position, hasEscape);
+          fieldStart = position + 1;
+          hasEscape = false;
+        }
+        ++position;
+        continue;
+      }
+      // An escape character. The next character is data.
+      hasEscape = true;
+      position += 2;
+    }
+    if (complete) {
+      break;
+    }
+    // The row continues past the loaded bytes. Loading moves the row to the
+    // start of the buffer, so the row is scanned again from its start.
+    if (loadMore()) {
+      continue;
+    }
+    // The last row of the file has no newline.
+    addField(fieldStart, buffer_.size(), hasEscape);
+    rowEnd = buffer_.size();
+    break;
+  }
+
+  const auto& nullString = serDeOptions_.nullString;
+  for (column_index_t i = 0; i < columns_.size(); ++i) {
+    const auto& column = columns_[i];
+    auto& vector = *input.childAt(i);
+    if (column.fileIndex >= fieldStarts_.size()) {
+      vector.setNull(row, true);
+      continue;
+    }
+    const char* data = buffer_.data() + fieldStarts_[column.fileIndex];
+    const auto size =
+        fieldEnds_[column.fileIndex] - fieldStarts_[column.fileIndex];
+    if (size == nullString.size() &&
+        memcmp(data, nullString.data(), size) == 0) {
+      vector.setNull(row, true);
+      continue;
+    }
+    setValue(
+        column, data, size, fieldEscapes_[column.fileIndex], row, vector);
+  }
+  position_ = rowEnd;
+  return true;
+}
+
+void TextRowReader::setValue(
+    const Column& column,
+    const char* data,
+    uint64_t size,
+    bool hasEscape,
+    vector_size_t row,
+    BaseVector& vector) {
+  switch (column.type->kind()) {
+    case TypeKind::BOOLEAN:
+      setOrNull(vector, row, parseBoolean(data, size));
+      break;
+    case TypeKind::TINYINT:
+      setOrNull(vector, row, parseInteger<int8_t>(data, size));
+      break;
+    case TypeKind::SMALLINT:
+      setOrNull(vector, row, parseInteger<int16_t>(data, size));
+      break;
+    case TypeKind::INTEGER:
+      if (column.type->isDate()) {
+        const auto days =
+            util::fromDateString(data, size, util::ParseMode::kPrestoCast);
+        setOrNull(
+            vector,
+            row,
+            days.hasValue() ? std::optional<int32_t>(days.value())
+                            : std::nullopt);
+      } else {
+        setOrNull(vector, row, parseInteger<int32_t>(data, size));
+      }
+      break;
+    case TypeKind::BIGINT:
+      setOrNull(vector, row, parseInteger<int64_t>(data, size));
+      break;
+    case TypeKind::REAL:
+      setOrNull(vector, row, parseFloatingPoint<float>(data, size));
+      break;
+    case TypeKind::DOUBLE:
+      setOrNull(vector, row, parseFloatingPoint<double>(data, size));
+      break;
+    case TypeKind::TIMESTAMP: {
+      const auto timestamp = util::fromTimestampString(
+          data, size, util::TimestampParseMode::kLegacyCast);
+      setOrNull(
+          vector,
+          row,
+          timestamp.hasValue() ? std::optional<Timestamp>(timestamp.value())
+                               : std::nullopt);
+      break;
+    }
+    case TypeKind::VARCHAR: {
+      const auto value =
+          hasEscape ? unescape(data, size) : std::string_view(data, size);
+      vector.asUnchecked<FlatVector<StringView>>()->set(
+          row, StringView(value.data(), value.size()));
+      break;
+    }
+    case TypeKind::VARBINARY: {
+      // The text writer writes binary values in base64.
+      std::optional<StringView> value;
+      std::string decoded;
+      try {
+        decoded = encoding::Base64::decode(folly::StringPiece(data, size));
+        value = StringView(decoded);
+      } catch (const std::exception&) {
+      }
+      setOrNull(vector, row, value);
+      break;
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+std::string_view TextRowReader::unescape(const char* data, uint64_t size) {
+  const char escapeChar = static_cast<char>(serDeOptions_.escapeChar);
+  unescaped_.clear();
+  for (uint64_t i = 0; i < size; ++i) {
+    if (data[i] == escapeChar && i + 1 < size) {
+      ++i;
+    }
+    unescaped_.push_back(data[i]);
+  }
+  return unescaped_;
+}
+
+uint64_t TextRowReader::next(
+    uint64_t size,
+    VectorPtr& result,
+    const dwio::common::Mutation* mutation) {
+  if (atEnd_) {
+    return 0;
+  }
+  auto input = BaseVector::create<RowVector>(inputType_, size, &pool_);
+  vector_size_t numRows = 0;
+  while (numRows < size && readRow(numRows, *input)) {
+    ++numRows;
+  }
+  if (static_cast<uint64_t>(numRows) < size) {
+    atEnd_ = true;
+  }
+  if (numRows == 0) {
+    return 0;
+  }
+  for (auto& child : input->children()) {
+    child->resize(numRows);
+  }
+  input->resize(numRows);
+  rowsRead_ += numRows;
+  result = projectColumns(input, *scanSpec_, mutation);
+  return numRows;
+}
+
+int64_t TextRowReader::nextRowNumber() {
+  return atEnd_ ? kAtEnd : rowsRead_;
+}
+
+int64_t TextRowReader::nextReadSize(uint64_t size) {
+  return atEnd_ ? kAtEnd : size;
+}
+
+TextReader::TextReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options)
+    : options_(options), input_(std::move(input)) {
+  VELOX_CHECK_NOT_NULL(
+      options_.fileSchema(), "Text reader requires a file schema");
+  typeWithId_ = dwio::common::TypeWithId::create(options_.fileSchema());
+  // The reader does not know the name of the file, so a compressed file is
+  // recognized by its magic bytes.
+  char magic[4];
+  const auto magicSize =
+      std::min<uint64_t>(sizeof(magic), input_->getReadFile()->size());
+  if (magicSize > 0) {
+    input_->getInputStream()->read(
+        magic, magicSize, 0, dwio::common::LogType::HEADER);
+    compression_ = detectCompression(magic, magicSize);
+  }
+}
+
+std::unique_ptr<dwio::common::RowReader> TextReader::createRowReader(
+    const dwio::common::RowReaderOptions& options) const {
+  return std::make_unique<TextRowReader>(
+      options_.fileSchema(), input_, compression_, options_, options);
+}
+
+} // namespace facebook::velox::text
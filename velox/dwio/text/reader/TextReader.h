@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/compression/Compression.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::text {
+
+/// Finds the delimiters of a text file 64 bytes at a time. A delimiter is
+/// the field delimiter, the newline or, if the file is escaped, the escape
+/// character.
+class DelimiterScanner {
+ public:
+  DelimiterScanner(
+      const dwio::common::SerDeOptions& serDeOptions,
+      char lineDelim);
+
+  /// Returns a mask with bit i set if data[i] is a delimiter, for the first
+  /// min(size, 64) bytes of 'data'.
+  uint64_t delimiterBits(const char* data, uint64_t size) const;
+
+ private:
+  const char fieldDelim_;
+  const char lineDelim_;
+  const char escapeChar_;
+  const bool escaped_;
+};
+
+/// Reads the rows of a text file whose first byte is in the range of the
+/// options, so that the splits of a file cut at arbitrary offsets read each
+/// row exactly once. A file compressed with gzip or zstd is not splittable
+/// and is read in full by the split at offset 0.
+class TextRowReader : public dwio::common::RowReader {
+ public:
+  TextRowReader(
+      const RowTypePtr& fileType,
+      const std::shared_ptr<dwio::common::BufferedInput>& input,
+      common::CompressionKind compression,
+      const dwio::common::ReaderOptions& readerOptions,
+      const dwio::common::RowReaderOptions& options);
+
+  uint64_t next(
+      uint64_t size,
+      VectorPtr& result,
+      const dwio::common::Mutation* mutation = nullptr) override;
+
+  int64_t nextRowNumber() override;
+
+  int64_t nextReadSize(uint64_t size) override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& /*stats*/) const override {}
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override {
+    return std::nullopt;
+  }
+
+ private:
+  struct Column {
+    // The index of the column in the file.
+    column_index_t fileIndex;
+    TypePtr type;
+  };
+
+  // Decompresses the whole file into 'decompressed_'.
+  void decompress(common::CompressionKind compression);
+
+  // Positions at the first row of the range that starts at 'offset' and
+  // skips the 'skipRows' header rows if the range is at the start of the
+  // file.
+  void seekToFirstRow(uint64_t offset, uint64_t skipRows);
+
+  // Appends the next bytes of the file to the buffer after moving the row
+  // starting at 'position_' to its start. Returns false at the end of the
+  // file.
+  bool loadMore();
+
+  // Copies 'size' bytes at 'offset' of the file to 'destination'.
+  void readFile(uint64_t offset, uint64_t size, char* destination);
+
+  // Returns the position of the first delimiter at or after 'position' in
+  // the buffer, or the end of the buffer.
+  uint64_t nextDelimiter(uint64_t position);
+
+  // Skips past the next newline. Returns false if there is none.
+  bool skipLine();
+
+  // Reads the row at 'position_' into 'row' of the columns of 'input'.
+  // Returns false if there is no row left in the range.
+  bool readRow(vector_size_t row, RowVector& input);
+
+  void setValue(
+      const Column& column,
+      const char* data,
+      uint64_t size,
+      bool hasEscape,
+      vector_size_t row,
+      BaseVector& vector);
+
+  // Returns the field of 'size' bytes at 'data' without its escape
+  // characters.
+  std::string_view unescape(const char* data, uint64_t size);
+
+  const dwio::common::SerDeOptions serDeOptions_;
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+  const std::shared_ptr<common::ScanSpec> scanSpec_;
+  const RowTypePtr fileType_;
+  const DelimiterScanner scanner_;
+  memory::MemoryPool& pool_;
+  const uint64_t loadQuantum_;
+
+  // The columns parsed from the file and the type of the rows made of them.
+  std::vector<Column> columns_;
+  RowTypePtr inputType_;
+
+  // The decompressed file if the file is compressed.
+  std::unique_ptr<folly::IOBuf> decompressed_;
+  uint64_t fileSize_{0};
+  // The rows starting at or after this offset of the file belong to the
+  // next split.
+  uint64_t rangeEnd_{0};
+
+  // The bytes read from the file. 'buffer_[0]' is at 'bufferOffset_' in the
+  // file and the next load starts at 'readOffset_'.
+  dwio::common::DataBuffer<char> buffer_;
+  uint64_t bufferOffset_{0};
+  uint64_t readOffset_{0};
+  // The start of the next row in 'buffer_'.
+  uint64_t position_{0};
+
+  // The delimiter bits of the 64 bytes of 'buffer_' from 'bitsStart_'.
+  uint64_t bitsStart_{0};
+  uint64_t bits_{0};
+  bool bitsValid_{false};
+
+  // The bounds of the fields of the current row and whether they have
+  // escape characters.
+  std::vector<uint64_t> fieldStarts_;
+  std::vector<uint64_t> fieldEnds_;
+  std::vector<bool> fieldEscapes_;
+  std::string unescaped_;
+
+  int64_t rowsRead_{0};
+  bool atEnd_{false};
+};
+
+/// Reads Hive text files. Text files have no metadata, so the schema is the
+/// file schema of the options.
+class TextReader : public dwio::common::Reader {
+ public:
+  TextReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options);
+
+  std::optional<uint64_t> numberOfRows() const override {
+    return std::nullopt;
+  }
+
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t /*index*/) const override {
+    return nullptr;
+  }
+
+  const RowTypePtr& rowType() const override {
+    return options_.fileSchema();
+  }
+
+  const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
+      const override {
+    return typeWithId_;
+  }
+
+  std::unique_ptr<dwio::common::RowReader> createRowReader(
+      const dwio::common::RowReaderOptions& options = {}) const override;
+
+ private:
+  const dwio::common::ReaderOptions options_;
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+  std::shared_ptr<const dwio::common::TypeWithId> typeWithId_;
+  // The compression of the file, detected from its first bytes.
+  common::CompressionKind compression_{common::CompressionKind_NONE};
+};
+
+class TextReaderFactory : public dwio::common::ReaderFactory {
+ public:
+  TextReaderFactory() : ReaderFactory(dwio::common::FileFormat::TEXT) {}
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override {
+    return std::make_unique<TextReader>(std::move(input), options);
+  }
+};
+
+} // namespace facebook::velox::text
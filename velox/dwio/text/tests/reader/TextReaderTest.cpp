@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include <fstream>
+
+#include <folly/compression/Compression.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/file/File.h"
+#include "velox/dwio/text/writer/TextWriter.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::text {
+namespace {
+
+class TextReaderTest : public testing::Test,
+                       public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  void SetUp() override {
+    dwio::common::LocalFileSink::registerFactory();
+    rootPool_ = memory::memoryManager()->addRootPool("TextReaderTests");
+    leafPool_ = rootPool_->addLeafChild("TextReaderTests");
+    tempPath_ = exec::test::TempDirectoryPath::create();
+  }
+
+  std::string writeFile(const std::string& content) {
+    auto path = fmt::format("{}/{}.txt", tempPath_->getPath(), numFiles_++);
+    std::ofstream file(path, std::ios::binary);
+    file.write(content.data(), content.size());
+    return path;
+  }
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      const std::string& path,
+      const RowTypePtr& schema,
+      const dwio::common::SerDeOptions& serDeOptions = {}) {
+    dwio::common::ReaderOptions options(leafPool_.get());
+    options.setFileSchema(schema);
+    options.setSerDeOptions(serDeOptions);
+    // A small load quantum makes the rows cross the loads.
+    options.setLoadQuantum(100);
+    auto input = std::make_unique<dwio::common::BufferedInput>(
+        std::make_shared<LocalReadFile>(path), *leafPool_);
+    return TextReaderFactory().createReader(std::move(input), options);
+  }
+
+  // Reads the rows of 'path' in [offset, offset + length).
+  RowVectorPtr read(
+      const std::string& path,
+      const RowTypePtr& schema,
+      uint64_t offset = 0,
+      uint64_t length = std::numeric_limits<uint64_t>::max(),
+      const std::shared_ptr<common::ScanSpec>& scanSpec = nullptr,
+      const dwio::common::SerDeOptions& serDeOptions = {},
+      uint64_t skipRows = 0) {
+    auto reader = createReader(path, schema, serDeOptions);
+    dwio::common::RowReaderOptions options;
+    auto spec = scanSpec;
+    if (spec == nullptr) {
+      spec = std::make_shared<common::ScanSpec>("");
+      spec->addAllChildFields(*schema);
+    }
+    options.setScanSpec(spec);
+    options.range(offset, length);
+    options.setSkipRows(skipRows);
+    auto rowReader = reader->createRowReader(options);
+    auto result = BaseVector::create<RowVector>(schema, 0, pool());
+    VectorPtr batch;
+    while (rowReader->next(7, batch) > 0) {
+      result->append(batch.get());
+    }
+    EXPECT_EQ(rowReader->nextRowNumber(), dwio::common::RowReader::kAtEnd);
+    return result;
+  }
+
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> leafPool_;
+  std::shared_ptr<exec::test::TempDirectoryPath> tempPath_;
+  int32_t numFiles_{0};
+};
+
+TEST_F(TextReaderTest, readWrittenFile) {
+  auto schema =
+      ROW({"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8"},
+          {BOOLEAN(),
+           TINYINT(),
+           INTEGER(),
+           BIGINT(),
+           DOUBLE(),
+           TIMESTAMP(),
+           VARCHAR(),
+           VARBINARY(),
+           REAL()});
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      schema->names(),
+      {
+          makeFlatVector<bool>(size, [](auto row) { return row % 3 == 0; }),
+          makeFlatVector<int8_t>(
+              size, [](auto row) { return row % 256 - 128; }, nullEvery(7)),
+          makeFlatVector<int32_t>(size, [](auto row) { return row * 1'001; }),
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return -row * 1'000'000'007L; }),
+          makeFlatVector<double>(size, [](auto row) { return row * 0.5; }),
+          makeFlatVector<Timestamp>(
+              size,
+              [](auto row) { return Timestamp(row * 1'000, row * 1'000'000); }),
+          makeFlatVector<std::string>(
+              size,
+              [](auto row) { return std::string(row % 100, 'a' + row % 26); },
+              nullEvery(11)),
+          makeFlatVector<std::string>(
+              size,
+              [](auto row) { return std::string(row % 5, 'x'); },
+              nullptr,
+              VARBINARY()),
+          makeFlatVector<float>(size, [](auto row) { return row * 0.25; }),
+      });
+
+  WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  const auto path = fmt::format("{}/written.txt", tempPath_->getPath());
+  auto writer = std::make_unique<TextWriter>(
+      schema,
+      std::make_unique<dwio::common::LocalFileSink>(
+          path, dwio::common::FileSink::Options{.pool = leafPool_.get()}),
+      std::make_shared<text::WriterOptions>(writerOptions));
+  writer->write(data);
+  writer->close();
+
+  velox::test::assertEqualVectors(data, read(path, schema));
+}
+
+TEST_F(TextReaderTest, splits) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  std::string content;
+  for (auto i = 0; i < 500; ++i) {
+    content += fmt::format(
+        "{}\x01{}\n", i, std::string(i % 150, static_cast<char>('a' + i % 26)));
+  }
+  const auto path = writeFile(content);
+  auto expected = read(path, schema);
+  ASSERT_EQ(expected->size(), 500);
+
+  // A split that starts at the start of a row reads the row.
+  uint64_t rowStart = 0;
+  for (auto i = 0; i < 50; ++i) {
+    rowStart = content.find('\n', rowStart) + 1;
+    EXPECT_EQ(read(path, schema, 0, rowStart)->size(), i + 1);
+    EXPECT_EQ(read(path, schema, rowStart - 1, 1)->size(), 0);
+    EXPECT_EQ(read(path, schema, rowStart)->size(), 500 - i - 1);
+  }
+
+  // Splits cut anywhere read each row once.
+  for (uint64_t splitSize : {37, 64, 1'000, 10'000}) {
+    SCOPED_TRACE(fmt::format("splitSize {}", splitSize));
+    auto result = BaseVector::create<RowVector>(schema, 0, pool());
+    for (uint64_t offset = 0; offset < content.size(); offset += splitSize) {
+      auto split = read(path, schema, offset, splitSize);
+      result->append(split.get());
+    }
+    velox::test::assertEqualVectors(expected, result);
+  }
+}
+
+TEST_F(TextReaderTest, compressed) {
+  auto schema = ROW({"c0", "c1"}, {INTEGER(), VARCHAR()});
+  std::string content;
+  for (auto i = 0; i < 300; ++i) {
+    content += fmt::format("{}\x01row {}\n", i, i);
+  }
+  for (auto codecType :
+       {folly::compression::CodecType::GZIP,
+        folly::compression::CodecType::ZSTD}) {
+    if (!folly::compression::hasCodec(codecType)) {
+      continue;
+    }
+    auto codec = folly::compression::getCodec(codecType);
+    const auto path = writeFile(codec->compress(content));
+    auto result = read(path, schema);
+    ASSERT_EQ(result->size(), 300);
+    auto* strings = result->childAt(1)->asFlatVector<StringView>();
+    EXPECT_EQ(strings->valueAt(0).str(), "row 0");
+    EXPECT_EQ(strings->valueAt(299).str(), "row 299");
+    // A compressed file is not splittable and is read by the first split.
+    EXPECT_EQ(read(path, schema, 0, 10)->size(), 300);
+    EXPECT_EQ(read(path, schema, 10, 1'000'000)->size(), 0);
+  }
+}
+
+TEST_F(TextReaderTest, nullsAndBadValues) {
+  auto schema = ROW(
+      {"c0", "c1", "c2", "c3", "c4"},
+      {SMALLINT(), BOOLEAN(), DOUBLE(), DATE(), VARCHAR()});
+  const auto path = writeFile(
+      "1\x01true\x01"
+      "1.5\x01"
+      "2024-01-31\x01x\n"
+      "\\N\x01\\N\x01\\N\x01\\N\x01\\N\n"
+      "40000\x01yes\x01one\x01"
+      "2024-02-30\x01\n"
+      "-32768\x01"
+      "FALSE\n"
+      "\n");
+  auto expected = makeRowVector(
+      {makeNullableFlatVector<int16_t>(
+           {1, std::nullopt, std::nullopt, -32768, std::nullopt}),
+       makeNullableFlatVector<bool>(
+           {true, std::nullopt, std::nullopt, false, std::nullopt}),
+       makeNullableFlatVector<double>(
+           {1.5, std::nullopt, std::nullopt, std::nullopt, std::nullopt}),
+       makeNullableFlatVector<int32_t>(
+           {19753, std::nullopt, std::nullopt, std::nullopt, std::nullopt},
+           DATE()),
+       makeNullableFlatVector<std::string>(
+           {"x", std::nullopt, "", std::nullopt, std::nullopt})});
+  velox::test::assertEqualVectors(expected, read(path, schema));
+}
+
+TEST_F(TextReaderTest, serDeOptions) {
+  auto schema = ROW({"c0", "c1"}, {INTEGER(), VARCHAR()});
+  const auto path = writeFile(
+      "c0|c1\n"
+      "1|a\\|b\n"
+      "2|c|d\n"
+      "NULL|\\\\e\n");
+  dwio::common::SerDeOptions serDeOptions('|', '\2', '\3', '\\', true);
+  serDeOptions.nullString = "NULL";
+  auto expected = makeRowVector(
+      {makeNullableFlatVector<int32_t>({1, 2, std::nullopt}),
+       makeFlatVector<std::string>({"a|b", "c", "\\e"})});
+  velox::test::assertEqualVectors(
+      expected,
+      read(
+          path,
+          schema,
+          0,
+          std::numeric_limits<uint64_t>::max(),
+          nullptr,
+          serDeOptions,
+          1));
+
+  // The last column takes the delimiters after it.
+  serDeOptions.lastColumnTakesRest = true;
+  auto result = read(
+      path,
+      schema,
+      0,
+      std::numeric_limits<uint64_t>::max(),
+      nullptr,
+      serDeOptions,
+      1);
+  EXPECT_EQ(
+      result->childAt(1)->asFlatVector<StringView>()->valueAt(1).str(), "c|d");
+}
+
+TEST_F(TextReaderTest, filter) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  std::string content;
+  for (auto i = 0; i < 100; ++i) {
+    content += fmt::format("{}\x01{}\n", i, i * 2);
+  }
+  const auto path = writeFile(content);
+  auto spec = std::make_shared<common::ScanSpec>("");
+  spec->addAllChildFields(*schema);
+  spec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(10, 19, false));
+  auto result = read(
+      path, schema, 0, std::numeric_limits<uint64_t>::max(), spec);
+  velox::test::assertEqualVectors(
+      makeRowVector(
+          {makeFlatVector<int64_t>(10, [](auto row) { return row + 10; }),
+           makeFlatVector<std::string>(10, [](auto row) {
+             return std::to_string((row + 10) * 2);
+           })}),
+      result);
+}
+
+TEST_F(TextReaderTest, delimiterScanner) {
+  dwio::common::SerDeOptions serDeOptions(',', '\2', '\3', '\\', true);
+  DelimiterScanner scanner(serDeOptions, '\n');
+  std::string data(100, 'a');
+  uint64_t expected = 0;
+  for (auto i : {0, 5, 31, 32, 47, 63}) {
+    data[i] = i % 2 == 0 ? ',' : '\n';
+    expected |= 1UL << i;
+  }
+  data[20] = '\\';
+  expected |= 1UL << 20;
+  data[70] = ',';
+  EXPECT_EQ(scanner.delimiterBits(data.data(), data.size()), expected);
+  EXPECT_EQ(scanner.delimiterBits(data.data(), 32), expected & 0xFFFFFFFF);
+  EXPECT_EQ(scanner.delimiterBits(data.data() + 64, 36), 1UL << 6);
+}
+
+} // namespace
+} // namespace facebook::velox::text
@@ -200,6 +200,46 @@ class Aggregate {
     VELOX_NYI("Unimplemented: {} {}", typeid(*this).name(), __func__);
   }
 
+  /// Whether the function can keep its accumulators in a flat array indexed by
+  /// group number while adding raw input, e.g. for a group by on a small range
+  /// of integer keys.
+  ///
+  /// When this returns true, `addDenseRawInput` and `mergeDenseAccumulators`
+  /// should be implemented.
+  virtual bool supportsDenseAccumulators() const {
+    return false;
+  }
+
+  /// Fast path for adding raw input to dense accumulators instead of group
+  /// rows. `rows` and `args` are the same as in `addRawInput`.
+  /// `groupNumbers[i]` is the number of the group of row `i`. `accumulators`
+  /// has `accumulatorFixedWidthSize()` bytes per group number and starts
+  /// zero-filled. `nonNulls` has a bit per group number that is set once the
+  /// accumulator has a non-null value.
+  ///
+  /// Will only be called when `supportsDenseAccumulators` returns true.
+  virtual void addDenseRawInput(
+      const uint64_t* /*groupNumbers*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/,
+      char* /*accumulators*/,
+      uint64_t* /*nonNulls*/) {
+    VELOX_NYI("Unimplemented: {} {}", typeid(*this).name(), __func__);
+  }
+
+  /// Adds the dense accumulators of `numGroups` group numbers filled by
+  /// `addDenseRawInput` to the accumulators in `groups`. `groups[i]` is the
+  /// group row for group number `i` or nullptr if there is no such group.
+  ///
+  /// Will only be called when `supportsDenseAccumulators` returns true.
+  virtual void mergeDenseAccumulators(
+      char** /*groups*/,
+      int32_t /*numGroups*/,
+      const char* /*accumulators*/,
+      const uint64_t* /*nonNulls*/) {
+    VELOX_NYI("Unimplemented: {} {}", typeid(*this).name(), __func__);
+  }
+
   // Updates final accumulators from intermediate results.
   // @param groups Pointers to the start of the group rows. These are aligned
   // with the 'args', e.g. data in the i-th row of the 'args' goes to the i-th
@@ -227,8 +227,8 @@ void AggregateCompanionAdapter::ExtractFunction::apply(
   char** groups = allocateGroups(allocationPool, rows, offset);
 
   // Perform per-row aggregation.
-  std::vector<vector_size_t> allSelectedRange;
-  rows.applyToSelected([&](auto row) { allSelectedRange.push_back(row); });
+  std::vector<vector_size_t> allSelectedRange(rows.end());
+  allSelectedRange.resize(rows.selectedRows(allSelectedRange.data()));
   fn_->initializeNewGroups(groups, allSelectedRange);
   fn_->enableValidateIntermediateInputs();
   fn_->addIntermediateResults(groups, rows, args, false);
@@ -15,6 +15,8 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+#include <folly/container/F14Set.h>
+#include <numeric>
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/WindowFunction.h"
@@ -25,10 +27,43 @@ namespace facebook::velox::exec {
 
 namespace {
 
+// Returns true if 'name' is an aggregate whose intermediate results over
+// adjacent row ranges can be combined in any grouping without changing the
+// result, so that a frame can be aggregated from a segment tree.
+bool supportsSegmentTree(const std::string& name) {
+  static const folly::F14FastSet<std::string> kSegmentTreeAggregates = {
+      "avg",
+      "bool_and",
+      "bool_or",
+      "count",
+      "count_if",
+      "every",
+      "max",
+      "min",
+      "stddev",
+      "stddev_pop",
+      "stddev_samp",
+      "sum",
+      "var_pop",
+      "var_samp",
+      "variance",
+  };
+  // The functions may be registered with a prefix, e.g. presto.default.
+  const auto pos = name.rfind('.');
+  return kSegmentTreeAggregates.contains(
+      pos == std::string::npos ? name : name.substr(pos + 1));
+}
+
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
 // to frameEnd boundaries at that row using singleGroup.
+//
+// For frames with moving starts, e.g. ROWS BETWEEN 100 PRECEDING AND CURRENT
+// ROW, the aggregates that can combine their intermediate results use a
+// segment tree instead: the frame of each row is aggregated from at most
+// 2 * (kSegmentTreeFanout - 1) nodes per level of the tree and raw rows at
+// its edges, which is O(log n) instead of O(frame size) per row.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -90,6 +125,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
         exec::RowContainer::initializedMask(kAccumulatorFlagsOffset),
         /* needed for out of line allocations */ kRowSizeOffset);
     singleGroupRowSize_ += aggregate_->accumulatorFixedWidthSize();
+    groupRowStride_ = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
 
     // Construct the single row in the MemoryPool.
     singleGroupRowBufferPtr_ =
@@ -101,6 +138,11 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
     computeDefaultAggregateValue(resultType);
+
+    if (supportsSegmentTree(name)) {
+      intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
+      segmentTreeResultVector_ = BaseVector::create(resultType, 0, pool_);
+    }
   }
 
   ~AggregateWindowFunction() {
@@ -163,6 +205,16 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree(validRows, rawFrameStarts, rawFrameEnds)) {
+      fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
+      segmentTreeAggregation(
+          validRows,
+          frameMetadata.firstRow,
+          frameMetadata.lastRow,
+          rawFrameStarts,
+          rawFrameEnds,
+          resultOffset,
+          result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -345,6 +397,206 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' are on average large enough for
+  // a segment tree to be cheaper than aggregating each frame from its rows.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    if (intermediateType_ == nullptr) {
+      return false;
+    }
+    int64_t numFrameRows{0};
+    validRows.applyToSelected([&](auto i) {
+      numFrameRows += rawFrameEnds[i] - rawFrameStarts[i] + 1;
+    });
+    return numFrameRows >=
+        static_cast<int64_t>(validRows.countSelected()) *
+        kSegmentTreeMinFrameRows;
+  }
+
+  // Returns pointers to 'numGroups' zeroed group rows in
+  // 'segmentTreeGroupRows_'.
+  std::vector<char*> allocateGroupRows(vector_size_t numGroups) {
+    const auto numBytes = static_cast<uint64_t>(numGroups) * groupRowStride_;
+    if (segmentTreeGroupRows_ == nullptr ||
+        segmentTreeGroupRows_->capacity() < numBytes) {
+      segmentTreeGroupRows_ = AlignedBuffer::allocate<char>(numBytes, pool_);
+    }
+    auto* rawGroupRows = segmentTreeGroupRows_->asMutable<char>();
+    std::memset(rawGroupRows, 0, numBytes);
+    std::vector<char*> groups(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      groups[i] = rawGroupRows + i * groupRowStride_;
+    }
+    return groups;
+  }
+
+  // Adds the intermediate results of 'sources' to 'targets'.
+  void combineIntermediateResults(
+      std::vector<char*>& sources,
+      std::vector<char*>& targets) {
+    if (sources.empty()) {
+      return;
+    }
+    const auto numGroups = sources.size();
+    VectorPtr intermediate =
+        BaseVector::create(intermediateType_, numGroups, pool_);
+    aggregate_->extractAccumulators(sources.data(), numGroups, &intermediate);
+    aggregate_->addIntermediateResults(
+        targets.data(),
+        SelectivityVector(numGroups),
+        {std::move(intermediate)},
+        false);
+  }
+
+  // Builds a segment tree over the 'argVectors_' rows from 'minFrame' to
+  // 'maxFrame' and computes the aggregate of each frame from the nodes that
+  // cover the frame and the raw rows at its edges. A node at level 0 holds
+  // the accumulator of kSegmentTreeFanout rows, a node at level 'i + 1' the
+  // combined accumulators of kSegmentTreeFanout nodes at level 'i'.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      vector_size_t maxFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    const vector_size_t numRows = maxFrame + 1 - minFrame;
+    // The first node of each level and the number of nodes last.
+    std::vector<vector_size_t> levelStarts{0};
+    for (auto levelSize = bits::divRoundUp(numRows, kSegmentTreeFanout);;
+         levelSize = bits::divRoundUp(levelSize, kSegmentTreeFanout)) {
+      levelStarts.push_back(levelStarts.back() + levelSize);
+      if (levelSize == 1) {
+        break;
+      }
+    }
+    const auto numLevels = levelStarts.size() - 1;
+    const auto numNodes = levelStarts.back();
+    const auto numFrames = validRows.countSelected();
+
+    // The tree nodes followed by one group per frame.
+    auto groups = allocateGroupRows(numNodes + numFrames);
+    std::vector<vector_size_t> allGroups(groups.size());
+    std::iota(allGroups.begin(), allGroups.end(), 0);
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(groups.data(), allGroups);
+
+    std::vector<char*> rowGroups(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      rowGroups[i] = groups[i / kSegmentTreeFanout];
+    }
+    aggregate_->addRawInput(
+        rowGroups.data(), SelectivityVector(numRows), argVectors_, false);
+    std::vector<char*> sources;
+    std::vector<char*> targets;
+    for (auto level = 1; level < numLevels; ++level) {
+      const auto levelStart = levelStarts[level - 1];
+      const auto levelSize = levelStarts[level] - levelStart;
+      sources.assign(
+          groups.begin() + levelStart,
+          groups.begin() + levelStart + levelSize);
+      targets.resize(levelSize);
+      for (auto i = 0; i < levelSize; ++i) {
+        targets[i] = groups[levelStarts[level] + i / kSegmentTreeFanout];
+      }
+      combineIntermediateResults(sources, targets);
+    }
+
+    // Collects the raw rows and the nodes covering each frame.
+    std::vector<vector_size_t> rawRows;
+    std::vector<char*> rawRowGroups;
+    sources.clear();
+    targets.clear();
+    auto* frameGroup = groups.data() + numNodes;
+    validRows.applyToSelected([&](auto i) {
+      char* group = *frameGroup++;
+      vector_size_t begin = frameStartsVector[i] - minFrame;
+      vector_size_t end = frameEndsVector[i] - minFrame + 1;
+      // The raw rows before the first and after the last full leaf.
+      const auto firstLeaf = bits::divRoundUp(begin, kSegmentTreeFanout);
+      const auto lastLeaf = end / kSegmentTreeFanout;
+      if (firstLeaf >= lastLeaf) {
+        for (auto row = begin; row < end; ++row) {
+          rawRows.push_back(row);
+          rawRowGroups.push_back(group);
+        }
+        return;
+      }
+      for (auto row = begin; row < firstLeaf * kSegmentTreeFanout; ++row) {
+        rawRows.push_back(row);
+        rawRowGroups.push_back(group);
+      }
+      for (auto row = lastLeaf * kSegmentTreeFanout; row < end; ++row) {
+        rawRows.push_back(row);
+        rawRowGroups.push_back(group);
+      }
+      begin = firstLeaf;
+      end = lastLeaf;
+      for (auto level = 0; level < numLevels && begin < end; ++level) {
+        const auto firstParent = bits::divRoundUp(begin, kSegmentTreeFanout);
+        const auto lastParent = end / kSegmentTreeFanout;
+        const auto levelStart = levelStarts[level];
+        if (firstParent >= lastParent) {
+          for (auto node = begin; node < end; ++node) {
+            sources.push_back(groups[levelStart + node]);
+            targets.push_back(group);
+          }
+          break;
+        }
+        for (auto node = begin; node < firstParent * kSegmentTreeFanout;
+             ++node) {
+          sources.push_back(groups[levelStart + node]);
+          targets.push_back(group);
+        }
+        for (auto node = lastParent * kSegmentTreeFanout; node < end; ++node) {
+          sources.push_back(groups[levelStart + node]);
+          targets.push_back(group);
+        }
+        begin = firstParent;
+        end = lastParent;
+      }
+    });
+
+    if (!rawRows.empty()) {
+      const vector_size_t numRawRows = rawRows.size();
+      auto indices = allocateIndices(numRawRows, pool_);
+      std::copy(
+          rawRows.begin(), rawRows.end(), indices->asMutable<vector_size_t>());
+      std::vector<VectorPtr> rawArgs;
+      rawArgs.reserve(argVectors_.size());
+      for (auto i = 0; i < argVectors_.size(); ++i) {
+        if (argIndices_[i] == kConstantChannel) {
+          rawArgs.push_back(
+              BaseVector::wrapInConstant(numRawRows, 0, argVectors_[i]));
+        } else {
+          rawArgs.push_back(BaseVector::wrapInDictionary(
+              nullptr, indices, numRawRows, argVectors_[i]));
+        }
+      }
+      aggregate_->addRawInput(
+          rawRowGroups.data(), SelectivityVector(numRawRows), rawArgs, false);
+    }
+    combineIntermediateResults(sources, targets);
+
+    BaseVector::prepareForReuse(segmentTreeResultVector_, numFrames);
+    aggregate_->extractValues(
+        groups.data() + numNodes, numFrames, &segmentTreeResultVector_);
+    std::vector<BaseVector::CopyRange> ranges;
+    ranges.reserve(numFrames);
+    vector_size_t frame = 0;
+    validRows.applyToSelected([&](auto i) {
+      ranges.push_back({frame++, resultOffset + i, 1});
+    });
+    result->copyRanges(segmentTreeResultVector_.get(), ranges);
+    aggregate_->destroy(folly::Range(groups.data(), groups.size()));
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -385,6 +637,26 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // This vector is used to copy from the aggregate to the result.
   VectorPtr aggregateResultVector_;
 
+  // The number of rows or nodes combined into a node of the segment tree.
+  static constexpr vector_size_t kSegmentTreeFanout = 16;
+
+  // The min average frame size for aggregating the frames of an output block
+  // with a segment tree.
+  static constexpr vector_size_t kSegmentTreeMinFrameRows = 32;
+
+  // The intermediate type of the aggregate if it supports segment tree
+  // aggregation, nullptr otherwise.
+  TypePtr intermediateType_;
+
+  // The distance between the group rows of the segment tree.
+  vector_size_t groupRowStride_;
+
+  // The group rows of the segment tree nodes and frames of an output block.
+  BufferPtr segmentTreeGroupRows_;
+
+  // The results of the frames aggregated with the segment tree.
+  VectorPtr segmentTreeResultVector_;
+
   // Stores metadata about the previous output block of the partition
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
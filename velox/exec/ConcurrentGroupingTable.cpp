@@ -0,0 +1,699 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/ConcurrentGroupingTable.h"
+
+#include <folly/hash/Hash.h>
+#include <folly/portability/Asm.h>
+
+#include <shared_mutex>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/CheckedArithmetic.h"
+#include "velox/type/FloatingPointUtil.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+constexpr int64_t kInitialCapacity = 1024;
+
+// Returns the name of an aggregate function without the registration prefix.
+std::string baseName(const std::string& name) {
+  const auto pos = name.rfind('.');
+  return pos == std::string::npos ? name : name.substr(pos + 1);
+}
+
+bool isIntegerKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool isFloatingPointKind(TypeKind kind) {
+  return kind == TypeKind::REAL || kind == TypeKind::DOUBLE;
+}
+
+int64_t doubleToBits(double value) {
+  int64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double bitsToDouble(int64_t bits) {
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Reads the values of 'decoded' as int64 or as the bits of a double into
+// 'values' and sets bit 'nullBit' of 'nulls' for the null rows.
+template <typename T>
+void readColumn(
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    int64_t* values,
+    uint64_t* nulls,
+    int32_t nullBit) {
+  for (auto row = 0; row < numRows; ++row) {
+    if (decoded.isNullAt(row)) {
+      values[row] = 0;
+      nulls[row] |= 1ULL << nullBit;
+    } else if constexpr (std::is_floating_point_v<T>) {
+      values[row] = doubleToBits(decoded.valueAt<T>(row));
+    } else {
+      values[row] = decoded.valueAt<T>(row);
+    }
+  }
+}
+
+void readColumn(
+    TypeKind kind,
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    int64_t* values,
+    uint64_t* nulls,
+    int32_t nullBit) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+      return readColumn<bool>(decoded, numRows, values, nulls, nullBit);
+    case TypeKind::TINYINT:
+      return readColumn<int8_t>(decoded, numRows, values, nulls, nullBit);
+    case TypeKind::SMALLINT:
+      return readColumn<int16_t>(decoded, numRows, values, nulls, nullBit);
+    case TypeKind::INTEGER:
+      return readColumn<int32_t>(decoded, numRows, values, nulls, nullBit);
+    case TypeKind::BIGINT:
+      return readColumn<int64_t>(decoded, numRows, values, nulls, nullBit);
+    case TypeKind::REAL:
+      return readColumn<float>(decoded, numRows, values, nulls, nullBit);
+    case TypeKind::DOUBLE:
+      return readColumn<double>(decoded, numRows, values, nulls, nullBit);
+    default:
+      VELOX_UNREACHABLE("Unsupported type: {}", mapTypeKindToName(kind));
+  }
+}
+
+// Writes 'numRows' values read by 'valueAt' into 'column', making it a flat
+// vector of 'type' if needed. 'valueAt' returns std::nullopt for a null.
+template <typename T, typename ValueAt>
+void writeColumn(
+    const TypePtr& type,
+    vector_size_t numRows,
+    memory::MemoryPool* pool,
+    VectorPtr& column,
+    ValueAt valueAt) {
+  if (column == nullptr || !column.unique() ||
+      column->encoding() != VectorEncoding::Simple::FLAT) {
+    column = BaseVector::create(type, numRows, pool);
+  } else {
+    column->resize(numRows);
+  }
+  auto* flat = column->asFlatVector<T>();
+  for (auto row = 0; row < numRows; ++row) {
+    const std::optional<int64_t> value = valueAt(row);
+    if (!value.has_value()) {
+      flat->setNull(row, true);
+    } else if constexpr (std::is_floating_point_v<T>) {
+      flat->set(row, static_cast<T>(bitsToDouble(value.value())));
+    } else {
+      flat->set(row, static_cast<T>(value.value()));
+    }
+  }
+}
+
+template <typename ValueAt>
+void writeColumn(
+    const TypePtr& type,
+    vector_size_t numRows,
+    memory::MemoryPool* pool,
+    VectorPtr& column,
+    ValueAt valueAt) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      return writeColumn<bool>(type, numRows, pool, column, valueAt);
+    case TypeKind::TINYINT:
+      return writeColumn<int8_t>(type, numRows, pool, column, valueAt);
+    case TypeKind::SMALLINT:
+      return writeColumn<int16_t>(type, numRows, pool, column, valueAt);
+    case TypeKind::INTEGER:
+      return writeColumn<int32_t>(type, numRows, pool, column, valueAt);
+    case TypeKind::BIGINT:
+      return writeColumn<int64_t>(type, numRows, pool, column, valueAt);
+    case TypeKind::REAL:
+      return writeColumn<float>(type, numRows, pool, column, valueAt);
+    case TypeKind::DOUBLE:
+      return writeColumn<double>(type, numRows, pool, column, valueAt);
+    default:
+      VELOX_UNREACHABLE("Unsupported type: {}", type->toString());
+  }
+}
+
+// Replaces the value of 'word' with 'update(value)' unless 'update' returns
+// std::nullopt.
+template <typename Update>
+void atomicUpdate(std::atomic<uint64_t>& word, Update update) {
+  uint64_t old = word.load(std::memory_order_relaxed);
+  for (;;) {
+    const std::optional<int64_t> updated = update(static_cast<int64_t>(old));
+    if (!updated.has_value() ||
+        word.compare_exchange_weak(
+            old,
+            static_cast<uint64_t>(updated.value()),
+            std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+} // namespace
+
+// static
+bool ConcurrentGroupingTable::supports(const core::AggregationNode& node) {
+  using Step = core::AggregationNode::Step;
+  if (node.step() != Step::kSingle && node.step() != Step::kFinal) {
+    return false;
+  }
+  const auto& groupingKeys = node.groupingKeys();
+  const auto& aggregates = node.aggregates();
+  if (groupingKeys.empty() || groupingKeys.size() > 64 || aggregates.empty() ||
+      aggregates.size() > 64 || !node.preGroupedKeys().empty() ||
+      !node.globalGroupingSets().empty() || node.groupId().has_value()) {
+    return false;
+  }
+  for (const auto& key : groupingKeys) {
+    if (!isIntegerKind(key->type()->kind())) {
+      return false;
+    }
+  }
+  const auto& outputType = node.outputType();
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto& aggregate = aggregates[i];
+    if (aggregate.mask != nullptr || !aggregate.sortingKeys.empty() ||
+        aggregate.distinct) {
+      return false;
+    }
+    const auto& inputs = aggregate.call->inputs();
+    for (const auto& input : inputs) {
+      if (dynamic_cast<const core::FieldAccessTypedExpr*>(input.get()) ==
+          nullptr) {
+        return false;
+      }
+    }
+    const auto& resultType = outputType->childAt(groupingKeys.size() + i);
+    const auto name = baseName(aggregate.call->name());
+    if (name == "count") {
+      if (resultType->kind() != TypeKind::BIGINT || inputs.size() > 1) {
+        return false;
+      }
+      if (node.step() == Step::kFinal &&
+          (inputs.size() != 1 || inputs[0]->type()->kind() != TypeKind::BIGINT)) {
+        return false;
+      }
+      continue;
+    }
+    if (inputs.size() != 1) {
+      return false;
+    }
+    const auto& inputType = inputs[0]->type();
+    if (inputType->isDecimal() || resultType->isDecimal()) {
+      return false;
+    }
+    const auto inputKind = inputType->kind();
+    if (name == "sum") {
+      const bool integerSum = isIntegerKind(inputKind) &&
+          inputKind != TypeKind::BOOLEAN &&
+          resultType->kind() == TypeKind::BIGINT;
+      const bool doubleSum = inputKind == TypeKind::DOUBLE &&
+          resultType->kind() == TypeKind::DOUBLE;
+      if (!integerSum && !doubleSum) {
+        return false;
+      }
+    } else if (name == "min" || name == "max") {
+      if ((!isIntegerKind(inputKind) && !isFloatingPointKind(inputKind)) ||
+          inputKind == TypeKind::BOOLEAN ||
+          !resultType->equivalent(*inputType)) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+ConcurrentGroupingTable::ConcurrentGroupingTable(
+    const core::AggregationNode& node,
+    memory::MemoryPool* pool)
+    : ignoreNullKeys_(node.ignoreNullKeys()), pool_(pool) {
+  VELOX_CHECK(supports(node));
+  const auto& inputType = node.sources()[0]->outputType();
+  for (const auto& key : node.groupingKeys()) {
+    keyChannels_.push_back(inputType->getChildIdx(key->name()));
+    keyTypes_.push_back(key->type());
+  }
+  const auto numKeys = keyChannels_.size();
+  const auto& aggregates = node.aggregates();
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto& call = aggregates[i].call;
+    const auto name = baseName(call->name());
+    Accumulator accumulator;
+    accumulator.kind = name == "count" ? Kind::kCount
+        : name == "sum"                ? Kind::kSum
+        : name == "min"                ? Kind::kMin
+                                       : Kind::kMax;
+    if (!call->inputs().empty()) {
+      const auto* field = dynamic_cast<const core::FieldAccessTypedExpr*>(
+          call->inputs()[0].get());
+      accumulator.channel = inputType->getChildIdx(field->name());
+      accumulator.inputType = field->type();
+    }
+    accumulator.resultType = node.outputType()->childAt(numKeys + i);
+    accumulator.isDouble = accumulator.kind != Kind::kCount &&
+        isFloatingPointKind(accumulator.inputType->kind());
+    accumulator.addsCounts = accumulator.kind == Kind::kCount &&
+        node.step() == core::AggregationNode::Step::kFinal;
+    accumulators_.push_back(std::move(accumulator));
+  }
+
+  keyNullsOffset_ = 1;
+  keysOffset_ = keyNullsOffset_ + 1;
+  nonNullsOffset_ = keysOffset_ + numKeys;
+  accumulatorsOffset_ = nonNullsOffset_ + 1;
+  slotWords_ = accumulatorsOffset_ + accumulators_.size();
+
+  capacity_ = kInitialCapacity;
+  maxGroups_ = capacity_ / 2;
+  slots_ = allocateSlots(capacity_);
+}
+
+ConcurrentGroupingTable::~ConcurrentGroupingTable() {
+  freeSlots(slots_, capacity_);
+}
+
+std::atomic<uint64_t>* ConcurrentGroupingTable::allocateSlots(
+    int64_t capacity) {
+  const auto numWords = capacity * slotWords_;
+  auto* slots = reinterpret_cast<std::atomic<uint64_t>*>(
+      pool_->allocate(numWords * sizeof(std::atomic<uint64_t>)));
+  for (auto i = 0; i < numWords; ++i) {
+    new (slots + i) std::atomic<uint64_t>(kEmpty);
+  }
+  return slots;
+}
+
+void ConcurrentGroupingTable::freeSlots(
+    std::atomic<uint64_t>* slots,
+    int64_t capacity) {
+  if (slots != nullptr) {
+    pool_->free(slots, capacity * slotWords_ * sizeof(std::atomic<uint64_t>));
+  }
+}
+
+void ConcurrentGroupingTable::initializeAccumulators(
+    std::atomic<uint64_t>* slot) const {
+  slot[nonNullsOffset_].store(0, std::memory_order_relaxed);
+  for (auto i = 0; i < accumulators_.size(); ++i) {
+    const auto& accumulator = accumulators_[i];
+    int64_t initial{0};
+    switch (accumulator.kind) {
+      case Kind::kCount:
+        break;
+      case Kind::kSum:
+        initial = accumulator.isDouble ? doubleToBits(0.0) : 0;
+        break;
+      case Kind::kMin:
+        // NaN is the largest double, so it is replaced by any other value.
+        initial = accumulator.isDouble
+            ? doubleToBits(std::numeric_limits<double>::quiet_NaN())
+            : std::numeric_limits<int64_t>::max();
+        break;
+      case Kind::kMax:
+        initial = accumulator.isDouble
+            ? doubleToBits(-std::numeric_limits<double>::infinity())
+            : std::numeric_limits<int64_t>::min();
+        break;
+    }
+    slot[accumulatorsOffset_ + i].store(
+        static_cast<uint64_t>(initial), std::memory_order_relaxed);
+  }
+}
+
+void ConcurrentGroupingTable::decodeInput(
+    const RowVectorPtr& input,
+    DecodedInput& decoded) const {
+  const auto numRows = input->size();
+  const SelectivityVector rows(numRows);
+
+  decoded.keys.resize(keyChannels_.size());
+  decoded.keyNulls.resize(numRows);
+  std::fill(decoded.keyNulls.begin(), decoded.keyNulls.end(), 0);
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    decoded.decoded.decode(*input->childAt(keyChannels_[i]), rows);
+    decoded.keys[i].resize(numRows);
+    readColumn(
+        keyTypes_[i]->kind(),
+        decoded.decoded,
+        numRows,
+        decoded.keys[i].data(),
+        decoded.keyNulls.data(),
+        i);
+  }
+
+  decoded.values.resize(accumulators_.size());
+  decoded.valueNulls.resize(numRows);
+  std::fill(decoded.valueNulls.begin(), decoded.valueNulls.end(), 0);
+  for (auto i = 0; i < accumulators_.size(); ++i) {
+    const auto& accumulator = accumulators_[i];
+    if (!accumulator.channel.has_value()) {
+      continue;
+    }
+    decoded.decoded.decode(*input->childAt(accumulator.channel.value()), rows);
+    decoded.values[i].resize(numRows);
+    if (accumulator.kind == Kind::kCount && !accumulator.addsCounts) {
+      // count(x) only needs the nulls of x.
+      for (auto row = 0; row < numRows; ++row) {
+        if (decoded.decoded.isNullAt(row)) {
+          decoded.valueNulls[row] |= 1ULL << i;
+        }
+      }
+      continue;
+    }
+    readColumn(
+        accumulator.inputType->kind(),
+        decoded.decoded,
+        numRows,
+        decoded.values[i].data(),
+        decoded.valueNulls.data(),
+        i);
+  }
+
+  decoded.hashes.resize(numRows);
+  for (auto row = 0; row < numRows; ++row) {
+    uint64_t hash = folly::hasher<uint64_t>()(decoded.keyNulls[row]);
+    for (const auto& keys : decoded.keys) {
+      hash = bits::hashMix(hash, folly::hasher<int64_t>()(keys[row]));
+    }
+    decoded.hashes[row] = hash;
+  }
+}
+
+bool ConcurrentGroupingTable::keysMatch(
+    const std::atomic<uint64_t>* slot,
+    const DecodedInput& decoded,
+    vector_size_t row) const {
+  if (slot[keyNullsOffset_].load(std::memory_order_relaxed) !=
+      decoded.keyNulls[row]) {
+    return false;
+  }
+  for (auto i = 0; i < decoded.keys.size(); ++i) {
+    if (static_cast<int64_t>(
+            slot[keysOffset_ + i].load(std::memory_order_relaxed)) !=
+        decoded.keys[i][row]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::atomic<uint64_t>* ConcurrentGroupingTable::findOrInsert(
+    const DecodedInput& decoded,
+    vector_size_t row) {
+  // The top bit marks a full slot, so it is not part of the hash.
+  const uint64_t hash = decoded.hashes[row] >> 1;
+  const uint64_t tag = hash | kFull;
+  const int64_t mask = capacity_ - 1;
+  int64_t index = hash & mask;
+  for (;;) {
+    auto* candidate = slot(slots_, index);
+    uint64_t word = candidate->load(std::memory_order_acquire);
+    while (word == kBusy) {
+      // Another driver is inserting a group here.
+      folly::asm_volatile_pause();
+      word = candidate->load(std::memory_order_acquire);
+    }
+    if (word != kEmpty) {
+      if (word == tag && keysMatch(candidate, decoded, row)) {
+        return candidate;
+      }
+      index = (index + 1) & mask;
+      continue;
+    }
+    // Reserve room for the group before claiming the slot so that the table
+    // never fills up.
+    if (numGroups_.fetch_add(1) >= maxGroups_) {
+      numGroups_.fetch_sub(1);
+      return nullptr;
+    }
+    uint64_t expected = kEmpty;
+    if (!candidate->compare_exchange_strong(
+            expected, kBusy, std::memory_order_acq_rel)) {
+      // Another driver claimed the slot. Check the group it inserts.
+      numGroups_.fetch_sub(1);
+      continue;
+    }
+    candidate[keyNullsOffset_].store(
+        decoded.keyNulls[row], std::memory_order_relaxed);
+    for (auto i = 0; i < decoded.keys.size(); ++i) {
+      candidate[keysOffset_ + i].store(
+          static_cast<uint64_t>(decoded.keys[i][row]),
+          std::memory_order_relaxed);
+    }
+    initializeAccumulators(candidate);
+    candidate->store(tag, std::memory_order_release);
+    return candidate;
+  }
+}
+
+void ConcurrentGroupingTable::updateAccumulators(
+    std::atomic<uint64_t>* slot,
+    const DecodedInput& decoded,
+    vector_size_t row) {
+  const uint64_t valueNulls = decoded.valueNulls[row];
+  for (auto i = 0; i < accumulators_.size(); ++i) {
+    const auto& accumulator = accumulators_[i];
+    auto& word = slot[accumulatorsOffset_ + i];
+    if (!accumulator.channel.has_value()) {
+      word.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    if (valueNulls & (1ULL << i)) {
+      continue;
+    }
+    if (accumulator.kind == Kind::kCount) {
+      word.fetch_add(
+          accumulator.addsCounts ? static_cast<uint64_t>(decoded.values[i][row])
+                                 : 1,
+          std::memory_order_relaxed);
+      continue;
+    }
+    auto& nonNulls = slot[nonNullsOffset_];
+    if (!(nonNulls.load(std::memory_order_relaxed) & (1ULL << i))) {
+      nonNulls.fetch_or(1ULL << i, std::memory_order_relaxed);
+    }
+    const int64_t value = decoded.values[i][row];
+    switch (accumulator.kind) {
+      case Kind::kSum:
+        if (accumulator.isDouble) {
+          atomicUpdate(word, [&](int64_t old) -> std::optional<int64_t> {
+            return doubleToBits(bitsToDouble(old) + bitsToDouble(value));
+          });
+        } else {
+          atomicUpdate(word, [&](int64_t old) -> std::optional<int64_t> {
+            return checkedPlus<int64_t>(old, value, "bigint");
+          });
+        }
+        break;
+      case Kind::kMin:
+        if (accumulator.isDouble) {
+          atomicUpdate(word, [&](int64_t old) -> std::optional<int64_t> {
+            if (util::floating_point::NaNAwareLessThan<double>()(
+                    bitsToDouble(value), bitsToDouble(old))) {
+              return value;
+            }
+            return std::nullopt;
+          });
+        } else {
+          atomicUpdate(word, [&](int64_t old) -> std::optional<int64_t> {
+            if (value < old) {
+              return value;
+            }
+            return std::nullopt;
+          });
+        }
+        break;
+      case Kind::kMax:
+        if (accumulator.isDouble) {
+          atomicUpdate(word, [&](int64_t old) -> std::optional<int64_t> {
+            if (util::floating_point::NaNAwareGreaterThan<double>()(
+                    bitsToDouble(value), bitsToDouble(old))) {
+              return value;
+            }
+            return std::nullopt;
+          });
+        } else {
+          atomicUpdate(word, [&](int64_t old) -> std::optional<int64_t> {
+            if (value > old) {
+              return value;
+            }
+            return std::nullopt;
+          });
+        }
+        break;
+      case Kind::kCount:
+        VELOX_UNREACHABLE();
+    }
+  }
+}
+
+void ConcurrentGroupingTable::addInput(
+    const RowVectorPtr& input,
+    DecodedInput& decoded) {
+  decodeInput(input, decoded);
+  const auto numRows = input->size();
+  vector_size_t row = 0;
+  while (row < numRows) {
+    {
+      std::shared_lock<folly::SharedMutex> l(mutex_);
+      for (; row < numRows; ++row) {
+        if (ignoreNullKeys_ && decoded.keyNulls[row] != 0) {
+          continue;
+        }
+        auto* group = findOrInsert(decoded, row);
+        if (group == nullptr) {
+          break;
+        }
+        updateAccumulators(group, decoded, row);
+      }
+    }
+    if (row < numRows) {
+      grow();
+    }
+  }
+}
+
+void ConcurrentGroupingTable::reinsert(
+    const std::atomic<uint64_t>* slot,
+    std::atomic<uint64_t>* slots,
+    int64_t capacity) const {
+  const uint64_t tag = slot->load(std::memory_order_relaxed);
+  const int64_t mask = capacity - 1;
+  int64_t index = (tag & ~kFull) & mask;
+  while (this->slot(slots, index)->load(std::memory_order_relaxed) != kEmpty) {
+    index = (index + 1) & mask;
+  }
+  auto* target = this->slot(slots, index);
+  for (auto i = 0; i < slotWords_; ++i) {
+    target[i].store(
+        slot[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+}
+
+void ConcurrentGroupingTable::grow() {
+  std::unique_lock<folly::SharedMutex> l(mutex_);
+  if (numGroups_ < maxGroups_) {
+    // Another driver has grown the table.
+    return;
+  }
+  const auto newCapacity = capacity_ * 2;
+  auto* newSlots = allocateSlots(newCapacity);
+  for (auto i = 0; i < capacity_; ++i) {
+    const auto* oldSlot = slot(slots_, i);
+    if (oldSlot->load(std::memory_order_relaxed) != kEmpty) {
+      reinsert(oldSlot, newSlots, newCapacity);
+    }
+  }
+  freeSlots(slots_, capacity_);
+  slots_ = newSlots;
+  capacity_ = newCapacity;
+  maxGroups_ = newCapacity / 2;
+  ++numRehashes_;
+}
+
+bool ConcurrentGroupingTable::getOutput(
+    OutputCursor& cursor,
+    int32_t maxRows,
+    RowVectorPtr& result) {
+  std::vector<const std::atomic<uint64_t>*> groups;
+  groups.reserve(maxRows);
+  while (groups.size() < maxRows) {
+    if (cursor.slot >= cursor.endSlot) {
+      const auto begin = nextOutputSlot_.fetch_add(kOutputRangeSlots);
+      if (begin >= capacity_) {
+        break;
+      }
+      cursor.slot = begin;
+      cursor.endSlot = std::min(begin + kOutputRangeSlots, capacity_);
+    }
+    for (; cursor.slot < cursor.endSlot && groups.size() < maxRows;
+         ++cursor.slot) {
+      const auto* group = slot(slots_, cursor.slot);
+      if (group->load(std::memory_order_relaxed) != kEmpty) {
+        groups.push_back(group);
+      }
+    }
+  }
+  if (groups.empty()) {
+    return false;
+  }
+
+  const vector_size_t numRows = groups.size();
+  result->resize(numRows);
+  auto* pool = result->pool();
+  for (auto i = 0; i < keyTypes_.size(); ++i) {
+    writeColumn(
+        keyTypes_[i],
+        numRows,
+        pool,
+        result->childAt(i),
+        [&](vector_size_t row) -> std::optional<int64_t> {
+          const auto* group = groups[row];
+          if (group[keyNullsOffset_].load(std::memory_order_relaxed) &
+              (1ULL << i)) {
+            return std::nullopt;
+          }
+          return static_cast<int64_t>(
+              group[keysOffset_ + i].load(std::memory_order_relaxed));
+        });
+  }
+  for (auto i = 0; i < accumulators_.size(); ++i) {
+    const auto& accumulator = accumulators_[i];
+    writeColumn(
+        accumulator.resultType,
+        numRows,
+        pool,
+        result->childAt(keyTypes_.size() + i),
+        [&](vector_size_t row) -> std::optional<int64_t> {
+          const auto* group = groups[row];
+          if (accumulator.kind != Kind::kCount &&
+              !(group[nonNullsOffset_].load(std::memory_order_relaxed) &
+                (1ULL << i))) {
+            return std::nullopt;
+          }
+          return static_cast<int64_t>(
+              group[accumulatorsOffset_ + i].load(std::memory_order_relaxed));
+        });
+  }
+  return true;
+}
+
+} // namespace facebook::velox::exec
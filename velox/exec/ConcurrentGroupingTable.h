@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/SharedMutex.h>
+
+#include "velox/common/base/RawVector.h"
+#include "velox/core/PlanNode.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::exec {
+
+/// A grouping table shared by the HashAggregation operators of all the drivers
+/// of a pipeline. The drivers insert groups concurrently so that a final or
+/// single aggregation with many drivers does not need a local exchange to give
+/// each driver a disjoint set of groups.
+///
+/// The table covers the aggregations whose grouping keys are fixed width
+/// integer or boolean columns and whose aggregates are count, sum, min and max
+/// of fixed width numeric types. Each group is a slot of 64-bit words: a tag
+/// word, the key null flags, the keys, the aggregate non-null flags and the
+/// accumulators. A driver inserts a group by a compare-and-swap on the tag word
+/// of an empty slot and updates the accumulators with atomic operations.
+/// Inserts and updates run under a shared lock which a driver takes
+/// exclusively to grow the table when it is half full.
+class ConcurrentGroupingTable {
+ public:
+  /// Returns true if 'node' can be aggregated into a ConcurrentGroupingTable.
+  static bool supports(const core::AggregationNode& node);
+
+  /// Allocates the table from 'pool'.
+  ConcurrentGroupingTable(
+      const core::AggregationNode& node,
+      memory::MemoryPool* pool);
+
+  ~ConcurrentGroupingTable();
+
+  /// Per-driver buffers for the decoded keys and aggregate inputs of an input
+  /// batch, one entry per row.
+  struct DecodedInput {
+    std::vector<raw_vector<int64_t>> keys;
+    // Bit i is set if key i is null.
+    raw_vector<uint64_t> keyNulls;
+    // The integer or double input values of each accumulator. Empty for
+    // count(*).
+    std::vector<raw_vector<int64_t>> values;
+    // Bit i is set if the input of accumulator i is null.
+    raw_vector<uint64_t> valueNulls;
+    raw_vector<uint64_t> hashes;
+    DecodedVector decoded;
+  };
+
+  /// Adds the groups of 'input' and updates their accumulators. 'decoded' is
+  /// scratch owned by the calling driver. Thread-safe.
+  void addInput(const RowVectorPtr& input, DecodedInput& decoded);
+
+  /// Position of a driver in producing the output.
+  struct OutputCursor {
+    int64_t slot{0};
+    int64_t endSlot{0};
+  };
+
+  /// Writes up to 'maxRows' groups into 'result' starting at 'cursor'. Claims
+  /// another range of slots for 'cursor' when its range is exhausted, so that
+  /// the drivers produce the output in parallel. Returns false if there are no
+  /// more groups to output. May only be called after all the drivers finished
+  /// adding input.
+  bool getOutput(OutputCursor& cursor, int32_t maxRows, RowVectorPtr& result);
+
+  int64_t numGroups() const {
+    return numGroups_;
+  }
+
+  int64_t capacity() const {
+    return capacity_;
+  }
+
+  int64_t numRehashes() const {
+    return numRehashes_;
+  }
+
+ private:
+  enum class Kind { kCount, kSum, kMin, kMax };
+
+  struct Accumulator {
+    Kind kind;
+    // Input channel. Not set for count(*).
+    std::optional<column_index_t> channel;
+    // True if the accumulator is a double, otherwise an int64.
+    bool isDouble;
+    // True if 'channel' holds counts to add, i.e. count in a final aggregation.
+    bool addsCounts;
+    // Type of the input values.
+    TypePtr inputType;
+    // Type of the result.
+    TypePtr resultType;
+  };
+
+  // Number of slots in a range of slots claimed by getOutput().
+  static constexpr int64_t kOutputRangeSlots = 4096;
+
+  static constexpr uint64_t kEmpty = 0;
+  static constexpr uint64_t kBusy = 1;
+  static constexpr uint64_t kFull = 1ULL << 63;
+
+  std::atomic<uint64_t>* slot(std::atomic<uint64_t>* slots, int64_t index)
+      const {
+    return slots + index * slotWords_;
+  }
+
+  // Allocates 'capacity' empty slots.
+  std::atomic<uint64_t>* allocateSlots(int64_t capacity);
+
+  void freeSlots(std::atomic<uint64_t>* slots, int64_t capacity);
+
+  // Sets the initial values of the accumulators of a new group at 'slot'.
+  void initializeAccumulators(std::atomic<uint64_t>* slot) const;
+
+  // Decodes the keys and aggregate inputs of 'input' into 'decoded' and
+  // computes the hashes of the keys.
+  void decodeInput(const RowVectorPtr& input, DecodedInput& decoded) const;
+
+  // Returns true if the keys in 'slot' are the keys of 'row' in 'decoded'.
+  bool keysMatch(
+      const std::atomic<uint64_t>* slot,
+      const DecodedInput& decoded,
+      vector_size_t row) const;
+
+  // Returns the slot of the group of 'row' in 'decoded', inserting the group if
+  // it is new. Returns null if the group is new and the table is too full to
+  // insert it. Must be called under a shared lock on 'mutex_'.
+  std::atomic<uint64_t>* findOrInsert(
+      const DecodedInput& decoded,
+      vector_size_t row);
+
+  // Updates the accumulators in 'slot' with 'row' in 'decoded'.
+  void updateAccumulators(
+      std::atomic<uint64_t>* slot,
+      const DecodedInput& decoded,
+      vector_size_t row);
+
+  // Inserts the group in 'slot' of a table being grown into 'slots' without
+  // synchronization.
+  void reinsert(
+      const std::atomic<uint64_t>* slot,
+      std::atomic<uint64_t>* slots,
+      int64_t capacity) const;
+
+  // Doubles the capacity unless another driver has already grown the table.
+  void grow();
+
+  // Column channels of the grouping keys in the input and their types.
+  std::vector<column_index_t> keyChannels_;
+  std::vector<TypePtr> keyTypes_;
+  const bool ignoreNullKeys_;
+  std::vector<Accumulator> accumulators_;
+
+  memory::MemoryPool* const pool_;
+
+  // Number of words in a slot and offsets of the slot fields.
+  int32_t keyNullsOffset_;
+  int32_t keysOffset_;
+  int32_t nonNullsOffset_;
+  int32_t accumulatorsOffset_;
+  int32_t slotWords_;
+
+  // Taken shared to insert and update groups and exclusive to grow the table.
+  folly::SharedMutex mutex_;
+  std::atomic<uint64_t>* slots_{nullptr};
+  int64_t capacity_{0};
+  // Number of groups above which no more are inserted before growing.
+  int64_t maxGroups_{0};
+  std::atomic<int64_t> numGroups_{0};
+  int64_t numRehashes_{0};
+
+  // Next slot to claim a range of output from.
+  std::atomic<int64_t> nextOutputSlot_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -15,6 +15,7 @@
  */
 #include "velox/exec/Cursor.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Operator.h"
 
 #include <filesystem>
@@ -54,7 +55,8 @@ exec::BlockingReason TaskQueue::enqueue(
   }
 
   auto bytes = vector->retainedSize();
-  TaskQueueEntry entry{std::move(vector), bytes};
+  const auto numRows = vector->size();
+  TaskQueueEntry entry{std::move(vector), bytes, getCurrentTimeMicro()};
 
   std::lock_guard<std::mutex> l(mutex_);
   // Check inside 'mutex_'
@@ -63,11 +65,15 @@ exec::BlockingReason TaskQueue::enqueue(
   }
   queue_.push_back(std::move(entry));
   totalBytes_ += bytes;
+  totalRows_ += numRows;
   if (consumerBlocked_) {
     consumerBlocked_ = false;
     consumerPromise_.setValue();
   }
-  if (totalBytes_ > maxBytes_) {
+  const bool full = streaming_.has_value()
+      ? queue_.size() >= static_cast<size_t>(streaming_->maxQueuedBatches)
+      : totalBytes_ > maxBytes_;
+  if (full) {
     auto [unblockPromise, unblockFuture] = makeVeloxContinuePromiseContract();
     producerUnblockPromises_.emplace_back(std::move(unblockPromise));
     *future = std::move(unblockFuture);
@@ -77,6 +83,9 @@ exec::BlockingReason TaskQueue::enqueue(
 }
 
 RowVectorPtr TaskQueue::dequeue() {
+  if (streaming_.has_value()) {
+    return dequeueStreaming();
+  }
   for (;;) {
     RowVectorPtr vector;
     std::vector<ContinuePromise> mayContinue;
@@ -90,12 +99,12 @@ RowVectorPtr TaskQueue::dequeue() {
         auto result = std::move(queue_.front());
         queue_.pop_front();
         totalBytes_ -= result.bytes;
+        totalRows_ -= result.vector->size();
         vector = std::move(result.vector);
         if (totalBytes_ < maxBytes_ / 2) {
           mayContinue = std::move(producerUnblockPromises_);
         }
-      } else if (
-          numProducers_.has_value() && producersFinished_ == numProducers_) {
+      } else if (producersFinishedLocked()) {
         return nullptr;
       }
       if (!vector) {
@@ -115,6 +124,83 @@ RowVectorPtr TaskQueue::dequeue() {
   }
 }
 
+RowVectorPtr TaskQueue::dequeueStreaming() {
+  for (;;) {
+    std::deque<TaskQueueEntry> entries;
+    uint64_t numRows{0};
+    std::vector<ContinuePromise> mayContinue;
+    std::optional<uint64_t> maxWaitUs;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (closed_) {
+        return nullptr;
+      }
+
+      const auto nowUs = getCurrentTimeMicro();
+      if (readyToFlushLocked(nowUs)) {
+        entries.swap(queue_);
+        numRows = totalRows_;
+        totalBytes_ = 0;
+        totalRows_ = 0;
+        mayContinue = std::move(producerUnblockPromises_);
+      } else if (queue_.empty() && producersFinishedLocked()) {
+        return nullptr;
+      } else {
+        if (!queue_.empty()) {
+          // Wait for more rows up to the deadline of the oldest batch.
+          maxWaitUs =
+              queue_.front().enqueueTimeUs + streaming_->maxLatencyUs - nowUs;
+        }
+        consumerBlocked_ = true;
+        consumerPromise_ = ContinuePromise();
+        consumerFuture_ = consumerPromise_.getFuture();
+      }
+    }
+    // outside of 'mutex_'
+    for (auto& promise : mayContinue) {
+      promise.setValue();
+    }
+    if (!entries.empty()) {
+      return merge(entries, numRows);
+    }
+    if (maxWaitUs.has_value()) {
+      consumerFuture_.wait(std::chrono::microseconds(maxWaitUs.value()));
+    } else {
+      consumerFuture_.wait();
+    }
+  }
+}
+
+bool TaskQueue::readyToFlushLocked(uint64_t nowUs) const {
+  if (queue_.empty()) {
+    return false;
+  }
+  return totalRows_ >= streaming_->minRows ||
+      queue_.size() >= static_cast<size_t>(streaming_->maxQueuedBatches) ||
+      producersFinishedLocked() ||
+      nowUs - queue_.front().enqueueTimeUs >= streaming_->maxLatencyUs;
+}
+
+RowVectorPtr TaskQueue::merge(
+    const std::deque<TaskQueueEntry>& entries,
+    uint64_t numRows) {
+  if (entries.size() == 1) {
+    return entries.front().vector;
+  }
+  auto result = BaseVector::create<RowVector>(
+      entries.front().vector->type(), numRows, pool_.get());
+  vector_size_t offset = 0;
+  for (const auto& entry : entries) {
+    // Make sure to load lazy vector if not loaded already.
+    for (auto& child : entry.vector->children()) {
+      child->loadedVector();
+    }
+    result->copy(entry.vector.get(), offset, 0, entry.vector->size());
+    offset += entry.vector->size();
+  }
+  return result;
+}
+
 void TaskQueue::close() {
   std::lock_guard<std::mutex> l(mutex_);
   closed_ = true;
@@ -219,8 +305,15 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
         queryCtx_->isExecutorSupplied(),
         "Executor should be set in parallel task cursor");
 
-    queue_ =
-        std::make_shared<TaskQueue>(params.bufferedBytes, params.outputPool);
+    std::optional<TaskQueue::StreamingOptions> streaming;
+    if (params.streaming) {
+      streaming = TaskQueue::StreamingOptions{
+          params.streamingMaxQueuedBatches,
+          params.streamingMinRows,
+          params.streamingMaxLatencyMs * 1'000};
+    }
+    queue_ = std::make_shared<TaskQueue>(
+        params.bufferedBytes, params.outputPool, streaming);
 
     // Captured as a shared_ptr by the consumer callback of task_.
     auto queue = queue_;
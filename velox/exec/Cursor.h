@@ -49,6 +49,27 @@ struct CursorParameters {
 
   uint64_t bufferedBytes{512 * 1024};
 
+  /// If true, the results are streamed to the cursor: producers are blocked
+  /// once 'streamingMaxQueuedBatches' batches are queued instead of by
+  /// 'bufferedBytes', and moveNext() returns the queued batches as one batch as
+  /// soon as they have 'streamingMinRows' rows or the oldest of them has waited
+  /// for 'streamingMaxLatencyMs'. This bounds the time to the first rows by
+  /// the latency deadline rather than by the size of the output batches.
+  ///
+  /// Only used if serialExecution is false.
+  bool streaming{false};
+
+  /// The number of batches producers may queue in streaming mode before they
+  /// are blocked.
+  int32_t streamingMaxQueuedBatches{8};
+
+  /// The number of rows after which queued batches are returned in streaming
+  /// mode.
+  vector_size_t streamingMinRows{1};
+
+  /// The max time a queued batch waits for more rows in streaming mode.
+  uint64_t streamingMaxLatencyMs{10};
+
   /// An optional memory pool to be used to allocate vectors returned by
   /// MultiThreadedTaskCursor. A new pool is created if not specified.
   ///
@@ -88,15 +109,31 @@ class TaskQueue {
   struct TaskQueueEntry {
     RowVectorPtr vector;
     uint64_t bytes;
+    // The time the entry was added to the queue.
+    uint64_t enqueueTimeUs;
+  };
+
+  /// Delivery policy of a streaming queue. See CursorParameters::streaming.
+  struct StreamingOptions {
+    int32_t maxQueuedBatches;
+    vector_size_t minRows;
+    uint64_t maxLatencyUs;
   };
 
   explicit TaskQueue(
       uint64_t maxBytes,
-      const std::shared_ptr<memory::MemoryPool>& outputPool)
+      const std::shared_ptr<memory::MemoryPool>& outputPool,
+      std::optional<StreamingOptions> streaming = std::nullopt)
       : pool_(
             outputPool != nullptr ? outputPool
                                   : memory::memoryManager()->addLeafPool()),
-        maxBytes_(maxBytes) {}
+        maxBytes_(maxBytes),
+        streaming_(streaming) {
+    if (streaming_.has_value()) {
+      VELOX_CHECK_GT(streaming_->maxQueuedBatches, 0);
+      VELOX_CHECK_GT(streaming_->minRows, 0);
+    }
+  }
 
   void setNumProducers(int32_t n) {
     numProducers_ = n;
@@ -105,12 +142,15 @@ class TaskQueue {
   // Adds a batch of rows to the queue and returns kNotBlocked if the
   // producer may continue. Returns kWaitForConsumer if the queue is
   // full after the addition and sets '*future' to a future that is
-  // realized when the producer may continue.
+  // realized when the producer may continue. A streaming queue is full when
+  // it holds 'maxQueuedBatches' batches.
   exec::BlockingReason enqueue(
       RowVectorPtr vector,
       velox::ContinueFuture* future);
 
-  // Returns nullptr when all producers are at end. Otherwise blocks.
+  // Returns nullptr when all producers are at end. Otherwise blocks. A
+  // streaming queue returns all the queued batches as one batch once they
+  // are ready to flush.
   RowVectorPtr dequeue();
 
   void close();
@@ -122,15 +162,33 @@ class TaskQueue {
   }
 
  private:
+  RowVectorPtr dequeueStreaming();
+
+  // Returns true if a streaming queue should return the queued batches at
+  // 'nowUs'.
+  bool readyToFlushLocked(uint64_t nowUs) const;
+
+  // Returns the rows of 'entries' as one batch.
+  RowVectorPtr merge(
+      const std::deque<TaskQueueEntry>& entries,
+      uint64_t numRows);
+
+  bool producersFinishedLocked() const {
+    return numProducers_.has_value() && producersFinished_ == numProducers_;
+  }
+
   // Owns the vectors in 'queue_', hence must be declared first.
   std::shared_ptr<velox::memory::MemoryPool> pool_;
   std::deque<TaskQueueEntry> queue_;
   std::optional<int32_t> numProducers_;
   int32_t producersFinished_ = 0;
   uint64_t totalBytes_ = 0;
+  // The number of rows in 'queue_'.
+  uint64_t totalRows_ = 0;
   // Blocks the producer if 'totalBytes' exceeds 'maxBytes' after
-  // adding the result.
+  // adding the result. Not used by a streaming queue.
   uint64_t maxBytes_;
+  const std::optional<StreamingOptions> streaming_;
   std::mutex mutex_;
   std::vector<ContinuePromise> producerUnblockPromises_;
   bool consumerBlocked_ = false;
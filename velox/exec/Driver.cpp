@@ -16,8 +16,11 @@
 
 #include "velox/exec/Driver.h"
 
+#include "velox/common/process/HardwareCounters.h"
+#include "velox/common/process/ProcessBase.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/exec/Task.h"
+#include "velox/exec/WorkStealingExecutor.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -125,7 +128,7 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       [this](uint64_t bytes) {
         task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
       };
-  return common::SpillConfig(
+  common::SpillConfig spillConfig(
       std::move(getSpillDirPathCb),
       std::move(updateAndCheckSpillLimitCb),
       spillFilePrefix,
@@ -145,8 +148,73 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
           ? std::optional<common::PrefixSortConfig>(prefixSortConfig())
           : std::nullopt,
       queryConfig.spillFileCreateConfig());
+  if (queryConfig.spillAsyncWriteEnabled()) {
+    spillConfig.asyncWriteExecutor = task->queryCtx()->spillExecutor();
+  }
+  spillConfig.maxSpillableReservationGrowthPct =
+      queryConfig.maxSpillableReservationGrowthPct();
+  spillConfig.mergeReadAheadBudget = queryConfig.spillMergeReadAheadBudget();
+  spillConfig.mergeReadBufferBudget = queryConfig.spillMergeReadBufferBudget();
+  spillConfig.rowContainerSerdeKind = queryConfig.spillRowContainerSerdeKind();
+  spillConfig.compressionDictionaryPages =
+      queryConfig.spillCompressionDictionaryPages();
+  if (!task->overflowSpillDirectory().empty() &&
+      queryConfig.spillLocalTierMaxBytes() > 0) {
+    spillConfig.overflowConfig = common::SpillOverflowConfig{
+        .getSpillDirPathCb = [this]() -> std::string_view {
+          return task->getOrCreateOverflowSpillDirectory();
+        },
+        .updateLocalSpillBytesCb =
+            [this, maxBytes = queryConfig.spillLocalTierMaxBytes()](
+                uint64_t bytes) {
+              return task->updateLocalSpilledBytes(bytes, maxBytes);
+            }};
+  }
+  if (spillConfig.mergeReadAheadBudget > 0) {
+    spillConfig.readAheadExecutor = task->queryCtx()->spillExecutor();
+  }
+  return spillConfig;
 }
 
+namespace {
+// Returns the name of 'reason' for the timeline trace, which keeps the names
+// for as long as the process.
+const char* blockingReasonName(BlockingReason reason) {
+  static const auto names = []() {
+    std::vector<std::string> names;
+    for (auto i = 0;
+         i <= static_cast<int32_t>(BlockingReason::kWaitForIndexLookup);
+         ++i) {
+      names.push_back(
+          blockingReasonToString(static_cast<BlockingReason>(i)).substr(1));
+    }
+    return names;
+  }();
+  const auto index = static_cast<size_t>(reason);
+  return index < names.size() ? names[index].c_str() : "Unknown";
+}
+
+// Records the interval from 'sinceUs', the high resolution clock time of the
+// blocking, to now on 'track'.
+void recordBlockedInterval(
+    const process::TimelineTrack& track,
+    uint64_t sinceUs,
+    BlockingReason reason) {
+  const uint64_t nowUs =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::high_resolution_clock::now().time_since_epoch())
+          .count();
+  process::TimelineEvent event;
+  event.name = blockingReasonName(reason);
+  event.category = "blocked";
+  event.pid = track.pid;
+  event.tid = track.tid;
+  event.durationUs = nowUs > sinceUs ? nowUs - sinceUs : 0;
+  event.startUs = process::TimelineTrace::nowUs() - event.durationUs;
+  track.trace->record(event);
+}
+} // namespace
+
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
 
 BlockingState::BlockingState(
@@ -172,23 +240,7 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
   auto& exec = folly::QueuedImmediateExecutor::instance();
   std::move(state->future_)
       .via(&exec)
-      .thenValue([state](auto&& /* unused */) {
-        auto& driver = state->driver_;
-        auto& task = driver->task();
-
-        std::lock_guard<std::timed_mutex> l(task->mutex());
-        if (!driver->state().isTerminated) {
-          state->operator_->recordBlockingTime(state->sinceUs_, state->reason_);
-        }
-        VELOX_CHECK(!driver->state().suspended());
-        VELOX_CHECK(driver->state().hasBlockingFuture);
-        driver->state().hasBlockingFuture = false;
-        if (task->pauseRequested()) {
-          // The thread will be enqueued at resume.
-          return;
-        }
-        Driver::enqueue(state->driver_);
-      })
+      .thenValue([state](auto&& /* unused */) { resume(state, false); })
       .thenError(
           folly::tag_t<std::exception>{}, [state](std::exception const& e) {
             try {
@@ -202,6 +254,41 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
           });
 }
 
+bool BlockingState::wait(uint64_t maxWaitUs) {
+  future_.wait(std::chrono::microseconds(maxWaitUs));
+  return future_.isReady() && !future_.hasException();
+}
+
+// static
+bool BlockingState::resume(
+    const std::shared_ptr<BlockingState>& state,
+    bool onThread) {
+  auto& driver = state->driver_;
+  auto& task = driver->task();
+
+  std::lock_guard<std::timed_mutex> l(task->mutex());
+  if (!driver->state().isTerminated) {
+    state->operator_->recordBlockingTime(state->sinceUs_, state->reason_);
+    if (driver->timelineTrack_ != nullptr) {
+      recordBlockedInterval(
+          *driver->timelineTrack_, state->sinceUs_, state->reason_);
+    }
+  }
+  VELOX_CHECK(!driver->state().suspended());
+  VELOX_CHECK(driver->state().hasBlockingFuture);
+  driver->state().hasBlockingFuture = false;
+  if (task->pauseRequested()) {
+    // The thread will be enqueued at resume.
+    return false;
+  }
+  if (onThread) {
+    driver->enqueueInternal();
+    return !driver->closed_;
+  }
+  Driver::enqueue(state->driver_);
+  return false;
+}
+
 std::string stopReasonString(StopReason reason) {
   switch (reason) {
     case StopReason::kNone:
@@ -238,8 +325,21 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (auto* workStealing = dynamic_cast<WorkStealingExecutor*>(executor)) {
+    // Prefer the last worker unless on another node than the task's.
+    int32_t worker = driver->lastWorker_;
+    const auto node = driver->task()->numaNode();
+    if (node >= 0 && (worker < 0 || workStealing->nodeOf(worker) != node)) {
+      worker = workStealing->nextWorker(node);
+    }
+    workStealing->add(
+        [driver]() { Driver::run(driver); },
+        worker,
+        driver->task()->queryCtx()->weightedCpuTimeNanos());
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -248,10 +348,20 @@ void Driver::init(
   VELOX_CHECK_NULL(ctx_);
   ctx_ = std::move(ctx);
   cpuSliceMs_ = task()->driverCpuTimeSliceLimitMs();
+  ioWaitOnThreadUs_ = ctx_->queryConfig().driverIoWaitOnThreadUs();
   VELOX_CHECK(operators_.empty());
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  hardwareCounterSampleRate_ =
+      ctx_->queryConfig().operatorHardwareCounterSampleRate();
+  adaptiveOutputBatchRows_ =
+      ctx_->queryConfig().adaptiveOutputBatchRowsEnabled();
+  if (const auto& timelineTrace = task()->timelineTrace()) {
+    timelineTrack_ =
+        std::make_unique<process::TimelineTrack>(process::TimelineTrack{
+            timelineTrace, ctx_->pipelineId, ctx_->driverId});
+  }
 }
 
 void Driver::initializeOperators() {
@@ -264,6 +374,56 @@ void Driver::initializeOperators() {
   }
 }
 
+void Driver::adaptOutputBatchRows(int operatorIndex) {
+  // Number of batches between adjustments of the batch size of an operator.
+  static constexpr uint32_t kAdaptInterval = 4;
+  // CPU time the consumer should spend on one batch so that the per batch
+  // overhead of the Driver loop and of the operators is amortized.
+  static constexpr double kTargetBatchNanos = 100'000;
+  // Bytes of output rows that fit in the L2 cache together with the working
+  // set of the consumer.
+  static constexpr uint64_t kTargetBatchBytes = 1 << 20;
+
+  if (numBatchesSinceAdapt_.size() != operators_.size()) {
+    numBatchesSinceAdapt_.resize(operators_.size(), 0);
+  }
+  if (++numBatchesSinceAdapt_[operatorIndex] < kAdaptInterval) {
+    return;
+  }
+  numBatchesSinceAdapt_[operatorIndex] = 0;
+
+  auto* op = operators_[operatorIndex].get();
+  auto* nextOp = operators_[operatorIndex + 1].get();
+  uint64_t rowBytes;
+  {
+    const auto lockedStats = op->stats().rlock();
+    if (lockedStats->outputPositions == 0) {
+      return;
+    }
+    rowBytes = std::max<uint64_t>(
+        1, lockedStats->outputBytes / lockedStats->outputPositions);
+  }
+  double nanosPerRow;
+  {
+    const auto lockedStats = nextOp->stats().rlock();
+    const auto nanos = lockedStats->addInputTiming.cpuNanos +
+        lockedStats->getOutputTiming.cpuNanos;
+    if (nanos == 0 || lockedStats->inputPositions == 0) {
+      return;
+    }
+    nanosPerRow = static_cast<double>(nanos) / lockedStats->inputPositions;
+  }
+
+  const auto& config = ctx_->queryConfig();
+  const uint64_t maxRows = config.maxOutputBatchRows();
+  const uint64_t minRows =
+      std::min<uint64_t>(config.adaptiveOutputBatchMinRows(), maxRows);
+  const auto rows = std::min(
+      static_cast<uint64_t>(kTargetBatchNanos / nanosPerRow),
+      kTargetBatchBytes / rowBytes);
+  op->setAdaptiveOutputBatchRows(std::clamp(rows, minRows, maxRows));
+}
+
 void Driver::pushdownFilters(int operatorIndex) {
   auto* op = operators_[operatorIndex].get();
   const auto& filters = op->getDynamicFilters();
@@ -529,6 +689,17 @@ StopReason Driver::runInternal(
     close();
   });
 
+  // The spills and loads of the quantum are on the track of the driver.
+  process::ScopedTimelineTrack scopedTimelineTrack(timelineTrack_.get());
+  const auto quantumStartUs =
+      timelineTrack_ != nullptr ? process::TimelineTrace::nowUs() : 0;
+  auto recordQuantum = folly::makeGuard([&]() {
+    if (timelineTrack_ != nullptr) {
+      process::TimelineTrack::recordOnThread(
+          "quantum", "driver", quantumStartUs);
+    }
+  });
+
   try {
     // Invoked to initialize the operators once before driver starts execution.
     initializeOperators();
@@ -646,6 +817,9 @@ StopReason Driver::runInternal(
                         curOperatorId_ + 1,
                         kOpMethodAddInput);
                   });
+              if (adaptiveOutputBatchRows_) {
+                adaptOutputBatchRows(i);
+              }
               // The next iteration will see if operators_[i + 1] has
               // output now that it got input.
               i += 2;
@@ -773,49 +947,85 @@ void Driver::run(std::shared_ptr<Driver> self) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(self->driverCtx());
-  std::shared_ptr<BlockingState> blockingState;
-  RowVectorPtr nullResult;
-  auto reason = self->runInternal(self, blockingState, nullResult);
-
-  // When Driver runs on an executor, the last operator (sink) must not produce
-  // any results.
-  VELOX_CHECK_NULL(
-      nullResult,
-      "The last operator (sink) must not produce any results. "
-      "Results need to be consumed by either a callback or another operator. ");
-
-  // There can be a race between Task terminating and the Driver being on the
-  // thread and exiting the runInternal() in a blocked state. If this happens
-  // the Driver won't be closed, so we need to check the Task here and exit w/o
-  // going into the resume mode waiting on a promise.
-  if (reason == StopReason::kBlock &&
-      self->task()->shouldStop() == StopReason::kTerminate) {
-    return;
+  auto* const workStealing = dynamic_cast<WorkStealingExecutor*>(
+      self->task()->queryCtx()->executor());
+  uint64_t startCpuNanos{0};
+  if (workStealing != nullptr) {
+    self->lastWorker_ = workStealing->currentWorker();
+    const auto node = self->task()->numaNode();
+    if (node >= 0 && self->lastWorker_ >= 0 &&
+        workStealing->nodeOf(self->lastWorker_) != node) {
+      self->task()->addCrossNodeDriverRun();
+    }
+    startCpuNanos = process::threadCpuNanos();
   }
+  for (;;) {
+    std::shared_ptr<BlockingState> blockingState;
+    RowVectorPtr nullResult;
+    auto reason = self->runInternal(self, blockingState, nullResult);
+    if (workStealing != nullptr) {
+      const auto cpuNanos = process::threadCpuNanos();
+      self->task()->queryCtx()->addCpuTimeNanos(cpuNanos - startCpuNanos);
+      startCpuNanos = cpuNanos;
+    }
 
-  switch (reason) {
-    case StopReason::kBlock:
-      // Set the resume action outside the Task so that, if the
-      // future is already realized we do not have a second thread
-      // entering the same Driver.
-      BlockingState::setResume(blockingState);
-      return;
-
-    case StopReason::kYield:
-      // Go to the end of the queue.
-      enqueue(self);
+    // When Driver runs on an executor, the last operator (sink) must not
+    // produce any results.
+    VELOX_CHECK_NULL(
+        nullResult,
+        "The last operator (sink) must not produce any results. "
+        "Results need to be consumed by either a callback or another operator. ");
+
+    // There can be a race between Task terminating and the Driver being on the
+    // thread and exiting the runInternal() in a blocked state. If this happens
+    // the Driver won't be closed, so we need to check the Task here and exit
+    // w/o going into the resume mode waiting on a promise.
+    if (reason == StopReason::kBlock &&
+        self->task()->shouldStop() == StopReason::kTerminate) {
       return;
+    }
 
-    case StopReason::kPause:
-    case StopReason::kTerminate:
-    case StopReason::kAlreadyTerminated:
-    case StopReason::kAtEnd:
-      return;
-    default:
-      VELOX_FAIL("Unhandled stop reason");
+    switch (reason) {
+      case StopReason::kBlock:
+        // A short wait for I/O is cheaper on the thread than going off thread
+        // and being enqueued again when the I/O completes.
+        if (self->shouldWaitOnThread(blockingState->reason()) &&
+            blockingState->wait(self->ioWaitOnThreadUs_)) {
+          if (BlockingState::resume(blockingState, true)) {
+            continue;
+          }
+          return;
+        }
+        // Set the resume action outside the Task so that, if the
+        // future is already realized we do not have a second thread
+        // entering the same Driver.
+        BlockingState::setResume(blockingState);
+        return;
+
+      case StopReason::kYield:
+        // Go to the end of the queue.
+        enqueue(self);
+        return;
+
+      case StopReason::kPause:
+      case StopReason::kTerminate:
+      case StopReason::kAlreadyTerminated:
+      case StopReason::kAtEnd:
+        return;
+      default:
+        VELOX_FAIL("Unhandled stop reason");
+    }
   }
 }
 
+bool Driver::shouldWaitOnThread(BlockingReason reason) const {
+  // Exchange waits for kWaitForProducer, which is also the wait of a local
+  // exchange for a producer which may need this thread to run.
+  return ioWaitOnThreadUs_ > 0 &&
+      (reason == BlockingReason::kWaitForConnector ||
+       reason == BlockingReason::kWaitForIndexLookup);
+}
+
 void Driver::initializeOperatorStats(std::vector<OperatorStats>& stats) {
   stats.resize(operators_.size(), OperatorStats(0, 0, "", ""));
   // Initialize the place in stats given by the operatorId. Use the
@@ -968,6 +1178,20 @@ bool Driver::mayPushdownAggregation(Operator* aggregation) const {
       aggregation->toString());
 }
 
+Operator* Driver::rowLimitTarget(const Operator* limit) const {
+  for (auto i = 1; i < operators_.size(); ++i) {
+    auto* op = operators_[i].get();
+    if (limit == op) {
+      auto* source = operators_[0].get();
+      return source->canAddRowLimit() ? source : nullptr;
+    }
+    if (!op->isFilter()) {
+      return nullptr;
+    }
+  }
+  VELOX_FAIL("Limit operator not found in its Driver: {}", limit->toString());
+}
+
 std::unordered_set<column_index_t> Driver::canPushdownFilters(
     const Operator* filterSource,
     const std::vector<column_index_t>& channels) const {
@@ -1132,7 +1356,7 @@ void Driver::withDeltaCpuWallTimer(
   // If 'trackOperatorCpuUsage_' is true, create and initialize the timer object
   // to track cpu and wall time of the opFunction.
   if (!trackOperatorCpuUsage_) {
-    opFunction();
+    callWithHardwareCounters(op, opTimingMember, opFunction);
     return;
   }
 
@@ -1147,7 +1371,43 @@ void Driver::withDeltaCpuWallTimer(
   };
   DeltaCpuWallTimer<decltype(f)> timer(std::move(f));
 
+  callWithHardwareCounters(op, opTimingMember, opFunction);
+}
+
+template <typename Func>
+void Driver::callWithHardwareCounters(
+    Operator* op,
+    TimingMemberPtr opTimingMember,
+    Func& opFunction) {
+  if (FOLLY_LIKELY(hardwareCounterSampleRate_ == 0) ||
+      (opTimingMember != &OperatorStats::addInputTiming &&
+       opTimingMember != &OperatorStats::getOutputTiming) ||
+      ++numCountableCalls_ % hardwareCounterSampleRate_ != 0) {
+    opFunction();
+    return;
+  }
+  const auto& counters = process::HardwareCounters::forThread();
+  process::HardwareCounterValues start;
+  if (!counters.read(start)) {
+    opFunction();
+    return;
+  }
   opFunction();
+  process::HardwareCounterValues end;
+  if (!counters.read(end)) {
+    return;
+  }
+  const auto delta = end - start;
+  op->stats().withWLock([&](auto& lockedStats) {
+    lockedStats.addRuntimeStat(
+        Operator::kHardwareCycles, RuntimeCounter(delta.cycles));
+    lockedStats.addRuntimeStat(
+        Operator::kHardwareInstructions, RuntimeCounter(delta.instructions));
+    lockedStats.addRuntimeStat(
+        Operator::kHardwareLlcMisses, RuntimeCounter(delta.llcMisses));
+    lockedStats.addRuntimeStat(
+        Operator::kHardwareBranchMisses, RuntimeCounter(delta.branchMisses));
+  });
 }
 
 void Driver::validateOperatorOutputResult(
@@ -25,6 +25,7 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/TraceConfig.h"
+#include "velox/common/process/TimelineTrace.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
@@ -235,6 +236,17 @@ class BlockingState {
 
   static void setResume(std::shared_ptr<BlockingState> state);
 
+  /// Waits up to 'maxWaitUs' on the calling driver thread for the blocking
+  /// future. Returns true if the future is realized without error. The driver
+  /// is then resumed with resume(state, true) instead of setResume().
+  bool wait(uint64_t maxWaitUs);
+
+  /// Unblocks the driver after the blocking future is realized. If
+  /// 'onThread', the driver continues on the calling thread and the function
+  /// returns true unless the task is paused or the driver closed. Otherwise,
+  /// enqueues the driver unless the task is paused and returns false.
+  static bool resume(const std::shared_ptr<BlockingState>& state, bool onThread);
+
   Operator* op() {
     return operator_;
   }
@@ -425,6 +437,11 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// order-preserving and do not increase cardinality.
   bool mayPushdownAggregation(Operator* aggregation) const;
 
+  /// Returns the source operator if it accepts a row limit and all operators
+  /// between the source and 'limit' do not increase cardinality. Returns
+  /// nullptr otherwise.
+  Operator* rowLimitTarget(const Operator* limit) const;
+
   /// Returns a subset of channels for which there are operators upstream from
   /// filterSource that accept dynamically generated filters.
   std::unordered_set<column_index_t> canPushdownFilters(
@@ -570,6 +587,10 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   static void run(std::shared_ptr<Driver> self);
 
+  // Returns true if the driver blocked for 'reason' waits on the thread for up
+  // to 'ioWaitOnThreadUs_' before going off thread.
+  bool shouldWaitOnThread(BlockingReason reason) const;
+
   StopReason runInternal(
       std::shared_ptr<Driver>& self,
       std::shared_ptr<BlockingState>& blockingState,
@@ -604,6 +625,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // position in the pipeline.
   void pushdownFilters(int operatorIndex);
 
+  // Sets the output batch size of the operator at 'operatorIndex' from the CPU
+  // time per row of the next operator and from the size of its output rows.
+  // Called after each batch passed to the next operator if
+  // QueryConfig::kAdaptiveOutputBatchRowsEnabled is true.
+  void adaptOutputBatchRows(int operatorIndex);
+
   using TimingMemberPtr = CpuWallTiming OperatorStats::*;
   template <typename Func>
   void withDeltaCpuWallTimer(
@@ -611,6 +638,15 @@ class Driver : public std::enable_shared_from_this<Driver> {
       TimingMemberPtr opTimingMember,
       Func&& opFunction);
 
+  // Calls 'opFunction', the call of a method of 'op' timed by
+  // 'opTimingMember'. Adds the hardware counter deltas of the call to the
+  // runtime stats of 'op' if the call is sampled.
+  template <typename Func>
+  void callWithHardwareCounters(
+      Operator* op,
+      TimingMemberPtr opTimingMember,
+      Func& opFunction);
+
   // Adjusts 'timing' by removing the lazy load wall time, CPU time, and input
   // bytes accrued since last time timing information was recorded for 'op'. The
   // accrued lazy load times are credited to the source operator of 'this'. The
@@ -634,6 +670,14 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // If not zero, specifies the driver cpu time slice.
   size_t cpuSliceMs_{0};
 
+  // If not zero, the max time to wait for I/O on the driver thread before
+  // going off thread.
+  uint64_t ioWaitOnThreadUs_{0};
+
+  // The worker of a WorkStealingExecutor which last ran this driver, or -1.
+  // Driver::enqueue() prefers the same worker to run the driver again.
+  std::atomic_int32_t lastWorker_{-1};
+
   bool operatorsInitialized_{false};
 
   std::atomic_bool closed_{false};
@@ -660,11 +704,30 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  // Reads the hardware counters around one in 'hardwareCounterSampleRate_'
+  // addInput() and getOutput() calls if not 0.
+  uint32_t hardwareCounterSampleRate_{0};
+  // The number of addInput() and getOutput() calls if
+  // 'hardwareCounterSampleRate_' is not 0.
+  uint64_t numCountableCalls_{0};
+
+  // True if the output batch sizes of the operators are set from the cost of
+  // their consumers. See adaptOutputBatchRows().
+  bool adaptiveOutputBatchRows_{false};
+  // Number of batches each operator passed to the next one since its output
+  // batch size was last set.
+  std::vector<uint32_t> numBatchesSinceAdapt_;
+
+  // The track of this driver in the timeline trace of the task if the task
+  // has one.
+  std::unique_ptr<process::TimelineTrack> timelineTrack_;
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
 
   friend struct DriverFactory;
+  friend class BlockingState;
 };
 
 using OperatorSupplier = std::function<
@@ -30,6 +30,11 @@ std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
       : std::make_unique<VectorSerde::Options>();
   options->compressionKind =
       common::stringToCompressionKind(queryConfig.shuffleCompressionKind());
+  if (kind == VectorSerde::Kind::kPresto) {
+    static_cast<serializer::presto::PrestoVectorSerde::PrestoOptions*>(
+        options.get())
+        ->preserveEncodings = queryConfig.shufflePreserveEncodings();
+  }
   return options;
 }
 } // namespace
@@ -52,6 +57,9 @@ Exchange::Exchange(
       serdeOptions_{getVectorSerdeOptions(
           operatorCtx_->driverCtx()->queryConfig(),
           serdeKind_)},
+      preserveEncodings_{
+          serdeKind_ == VectorSerde::Kind::kPresto &&
+          driverCtx->queryConfig().shufflePreserveEncodings()},
       processSplits_{operatorCtx_->driverCtx()->driverId == 0},
       driverId_{driverCtx->driverId},
       exchangeClient_{std::move(exchangeClient)} {}
@@ -166,6 +174,9 @@ RowVectorPtr Exchange::getOutput() {
     if (currentPages_.empty()) {
       return nullptr;
     }
+    if (preserveEncodings_) {
+      return getOutputFromEncodedPage(serde);
+    }
     vector_size_t resultOffset = 0;
     for (const auto& page : currentPages_) {
       rawInputBytes += page->size();
@@ -192,10 +203,26 @@ RowVectorPtr Exchange::getOutput() {
   if (serde->kind() == VectorSerde::Kind::kUnsafeRow) {
     return getOutputFromUnsafeRows(serde);
   }
+  if (serde->kind() == VectorSerde::Kind::kArrowIpc) {
+    // A page is an Arrow record batch, which is returned as is.
+    return getOutputFromEncodedPage(serde);
+  }
   VELOX_UNREACHABLE(
       "Unsupported serde kind: {}", VectorSerde::kindName(serde->kind()));
 }
 
+RowVectorPtr Exchange::getOutputFromEncodedPage(VectorSerde* serde) {
+  // Appending pages to 'result_' would flatten the encodings of the columns.
+  auto page = std::move(currentPages_.front());
+  currentPages_.erase(currentPages_.begin());
+  auto inputStream = page->prepareStreamForDeserialize();
+  serde->deserialize(
+      inputStream.get(), pool(), outputType_, &result_, serdeOptions_.get());
+  VELOX_CHECK(inputStream->atEnd());
+  recordInputStats(page->size());
+  return result_;
+}
+
 RowVectorPtr Exchange::getOutputFromCompactRows(VectorSerde* serde) {
   uint64_t rawInputBytes{0};
   if (currentPages_.empty()) {
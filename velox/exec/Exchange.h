@@ -87,6 +87,10 @@ class Exchange : public SourceOperator {
 
   void recordInputStats(uint64_t rawInputBytes);
 
+  // Deserializes the first of 'currentPages_' into a vector of its own to
+  // keep the encodings of its columns.
+  RowVectorPtr getOutputFromEncodedPage(VectorSerde* serde);
+
   RowVectorPtr getOutputFromCompactRows(VectorSerde* serde);
 
   RowVectorPtr getOutputFromUnsafeRows(VectorSerde* serde);
@@ -97,6 +101,10 @@ class Exchange : public SourceOperator {
 
   const std::unique_ptr<VectorSerde::Options> serdeOptions_;
 
+  // True if the pages from PartitionedOutput keep the encodings of their
+  // columns, see 'QueryConfig::kShufflePreserveEncodings'.
+  const bool preserveEncodings_;
+
   /// True if this operator is responsible for fetching splits from the Task
   /// and passing these to ExchangeClient.
   const bool processSplits_;
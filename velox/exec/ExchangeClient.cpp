@@ -115,6 +115,16 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
   stats["averageReceivedPageBytes"] = RuntimeMetric(
       queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes);
+  stats["exchangeQueueWaitNanos"] = RuntimeMetric(
+      queue_->consumerWaitNanos(), RuntimeCounter::Unit::kNanos);
+  if (adaptiveFlowControl_) {
+    stats["exchangeCreditBytes"] =
+        RuntimeMetric(creditBytesLocked(), RuntimeCounter::Unit::kBytes);
+    stats["exchangeDrainBytesPerSec"] =
+        RuntimeMetric(static_cast<int64_t>(queue_->drainBytesPerSecLocked()));
+    stats["exchangeRequestRttNanos"] = RuntimeMetric(
+        static_cast<int64_t>(requestRttNanos_), RuntimeCounter::Unit::kNanos);
+  }
 
   return stats;
 }
@@ -141,7 +151,7 @@ std::vector<std::unique_ptr<SerializedPage>> ExchangeClient::next(
       return pages;
     }
 
-    if (!pages.empty() && queue_->totalBytes() > maxQueuedBytes_) {
+    if (!pages.empty() && queue_->totalBytes() > creditBytesLocked()) {
       return pages;
     }
 
@@ -169,9 +179,10 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
     std::move(future)
         .via(executor_)
         .thenValue(
-            [self, spec = std::move(spec), sendTimeMs = getCurrentTimeMs()](
+            [self, spec = std::move(spec), sendTimeNs = getCurrentTimeNano()](
                 ExchangeSource::Response&& response) {
-              const auto requestTimeMs = getCurrentTimeMs() - sendTimeMs;
+              const auto requestTimeNs = getCurrentTimeNano() - sendTimeNs;
+              const auto requestTimeMs = requestTimeNs / 1'000'000;
               if (spec.maxBytes == 0) {
                 RECORD_HISTOGRAM_METRIC_VALUE(
                     kMetricExchangeDataSizeTimeMs, requestTimeMs);
@@ -206,6 +217,9 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
                   }
                 }
                 self->totalPendingBytes_ -= spec.maxBytes;
+                if (spec.maxBytes > 0) {
+                  self->addRequestRttLocked(requestTimeNs);
+                }
                 requestSpecs = self->pickSourcesToRequestLocked();
                 pauseCurrentSource =
                     std::find_if(
@@ -239,8 +253,9 @@ ExchangeClient::pickSourcesToRequestLocked() {
     requestSpecs.push_back({std::move(source), 0});
     emptySources_.pop();
   }
+  const int64_t maxQueuedBytes = creditBytesLocked();
   int64_t availableSpace =
-      maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
+      maxQueuedBytes - queue_->totalBytes() - totalPendingBytes_;
   while (availableSpace > 0 && !producingSources_.empty()) {
     auto& source = producingSources_.front().source;
     int64_t requestBytes = 0;
@@ -274,7 +289,7 @@ ExchangeClient::pickSourcesToRequestLocked() {
     auto& source = producingSources_.front().source;
     auto requestBytes = producingSources_.front().remainingBytes.at(0);
     LOG(INFO) << "Requesting large single page " << requestBytes
-              << " bytes, exceeding capacity " << maxQueuedBytes_;
+              << " bytes, exceeding capacity " << maxQueuedBytes;
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
     producingSources_.pop();
@@ -283,6 +298,29 @@ ExchangeClient::pickSourcesToRequestLocked() {
   return requestSpecs;
 }
 
+int64_t ExchangeClient::creditBytesLocked() const {
+  if (!adaptiveFlowControl_ || requestRttNanos_ == 0) {
+    return maxQueuedBytes_;
+  }
+  const auto drainBytesPerSec = queue_->drainBytesPerSecLocked();
+  if (drainBytesPerSec == 0) {
+    return maxQueuedBytes_;
+  }
+  const auto creditBytes =
+      drainBytesPerSec * requestRttNanos_ * kCreditRoundTrips / 1e9;
+  return std::min<int64_t>(
+      maxQueuedBytes_,
+      std::max<double>(creditBytes, minOutputBatchBytes_));
+}
+
+void ExchangeClient::addRequestRttLocked(uint64_t rttNanos) {
+  // Weight of the latest sample in the moving average.
+  constexpr double kSampleWeight = 0.2;
+  requestRttNanos_ = requestRttNanos_ == 0
+      ? rttNanos
+      : requestRttNanos_ * (1 - kSampleWeight) + rttNanos * kSampleWeight;
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
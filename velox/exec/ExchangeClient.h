@@ -36,10 +36,12 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
       uint64_t minOutputBatchBytes,
       memory::MemoryPool* pool,
       folly::Executor* executor,
-      int32_t requestDataSizesMaxWaitSec = 10)
+      int32_t requestDataSizesMaxWaitSec = 10,
+      bool adaptiveFlowControl = false)
       : taskId_{std::move(taskId)},
         destination_(destination),
         maxQueuedBytes_{maxQueuedBytes},
+        adaptiveFlowControl_{adaptiveFlowControl},
         kRequestDataSizesMaxWaitSec_{requestDataSizesMaxWaitSec},
         pool_(pool),
         executor_(executor),
@@ -133,12 +135,23 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
+  // Returns the number of bytes to keep queued and in flight. This is
+  // 'maxQueuedBytes_' unless 'adaptiveFlowControl_' is set, in which case it
+  // is the drain rate of the queue times 'kCreditRoundTrips' round trip times
+  // of the data requests, but no less than 'minOutputBatchBytes_' and no more
+  // than 'maxQueuedBytes_'.
+  int64_t creditBytesLocked() const;
+
+  // Adds the round trip time of a data request to 'requestRttNanos_'.
+  void addRequestRttLocked(uint64_t rttNanos);
+
   void request(std::vector<RequestSpec>&& requestSpecs);
 
   // Handy for ad-hoc logging.
   const std::string taskId_;
   const int destination_;
   const int64_t maxQueuedBytes_;
+  const bool adaptiveFlowControl_;
   const std::chrono::seconds kRequestDataSizesMaxWaitSec_;
 
   memory::MemoryPool* const pool_;
@@ -156,6 +169,15 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // Total number of bytes in flight.
   int64_t totalPendingBytes_{0};
 
+  // The number of round trip times of data the consumers may drain that the
+  // adaptive flow control keeps queued and in flight. More than one so that
+  // the data of the next response arrives before the queue runs dry.
+  static constexpr int32_t kCreditRoundTrips = 2;
+
+  // Moving average of the round trip time of the data requests, 0 until the
+  // first response.
+  double requestRttNanos_{0};
+
   // A queue of sources that have returned non-empty response from the latest
   // request.
   std::queue<ProducingSource> producingSources_;
@@ -74,6 +74,45 @@ int64_t ExchangeQueue::minOutputBatchBytesLocked() const {
   return std::min<int64_t>(minOutputBatchBytes_, receivedBytes_ / 100);
 }
 
+// static
+void ExchangeQueue::updateDrainRate(
+    ConsumerStats& consumer,
+    uint64_t nowNanos) {
+  if (consumer.lastDequeueBytes == 0) {
+    return;
+  }
+  // Weight of the latest sample in the moving average.
+  constexpr double kSampleWeight = 0.2;
+  const auto elapsedNanos =
+      std::max<uint64_t>(1, nowNanos - consumer.lastDequeueNanos);
+  const double bytesPerSec = consumer.lastDequeueBytes * 1e9 / elapsedNanos;
+  consumer.bytesPerSec = consumer.bytesPerSec == 0
+      ? bytesPerSec
+      : consumer.bytesPerSec * (1 - kSampleWeight) +
+          bytesPerSec * kSampleWeight;
+  consumer.lastDequeueBytes = 0;
+}
+
+void ExchangeQueue::recordDequeueLocked(
+    ConsumerStats& consumer,
+    uint64_t bytes,
+    uint64_t nowNanos) {
+  if (consumer.waitStartNanos != 0) {
+    consumerWaitNanos_ += nowNanos - consumer.waitStartNanos;
+    consumer.waitStartNanos = 0;
+  }
+  consumer.lastDequeueNanos = nowNanos;
+  consumer.lastDequeueBytes = bytes;
+}
+
+double ExchangeQueue::drainBytesPerSecLocked() const {
+  double bytesPerSec = 0;
+  for (const auto& [_, consumer] : consumerStats_) {
+    bytesPerSec += consumer.bytesPerSec;
+  }
+  return bytesPerSec;
+}
+
 void ExchangeQueue::enqueueLocked(
     std::unique_ptr<SerializedPage>&& page,
     std::vector<ContinuePromise>& promises) {
@@ -143,10 +182,17 @@ std::vector<std::unique_ptr<SerializedPage>> ExchangeQueue::dequeueLocked(
 
   *atEnd = false;
 
+  const auto nowNanos = getCurrentTimeNano();
+  auto& consumer = consumerStats_[consumerId];
+  updateDrainRate(consumer, nowNanos);
+
   // If we don't have enough bytes to return, we wait for more data to be
   // available
   if (totalBytes_ < minOutputBatchBytesLocked()) {
     addPromiseLocked(consumerId, future, stalePromise);
+    if (consumer.waitStartNanos == 0) {
+      consumer.waitStartNanos = nowNanos;
+    }
     return {};
   }
 
@@ -158,12 +204,15 @@ std::vector<std::unique_ptr<SerializedPage>> ExchangeQueue::dequeueLocked(
         *atEnd = true;
       } else if (pages.empty()) {
         addPromiseLocked(consumerId, future, stalePromise);
+        if (consumer.waitStartNanos == 0) {
+          consumer.waitStartNanos = nowNanos;
+        }
       }
-      return pages;
+      break;
     }
 
     if (pageBytes > 0 && pageBytes + queue_.front()->size() > maxBytes) {
-      return pages;
+      break;
     }
 
     pages.emplace_back(std::move(queue_.front()));
@@ -172,7 +221,10 @@ std::vector<std::unique_ptr<SerializedPage>> ExchangeQueue::dequeueLocked(
     totalBytes_ -= pages.back()->size();
   }
 
-  VELOX_UNREACHABLE();
+  if (!pages.empty()) {
+    recordDequeueLocked(consumer, pageBytes, nowNanos);
+  }
+  return pages;
 }
 
 void ExchangeQueue::setError(const std::string& error) {
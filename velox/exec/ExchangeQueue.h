@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -155,6 +156,18 @@ class ExchangeQueue {
     return receivedPages_ > 0 ? receivedBytes_ / receivedPages_ : 0;
   }
 
+  /// Returns the estimated rate in bytes per second at which the consumers
+  /// take data out of the queue when it has data. Each consumer contributes the
+  /// moving average of the bytes it dequeued divided by the time until it came
+  /// back for more, which excludes the time it waited for data. Returns 0 until
+  /// a consumer has come back after getting data.
+  double drainBytesPerSecLocked() const;
+
+  /// Returns the total time the consumers waited for data to arrive.
+  uint64_t consumerWaitNanos() const {
+    return consumerWaitNanos_;
+  }
+
   void addSourceLocked() {
     VELOX_CHECK(!noMoreSources_, "addSource called after noMoreSources");
     numSources_++;
@@ -211,6 +224,28 @@ class ExchangeQueue {
 
   int64_t minOutputBatchBytesLocked() const;
 
+  // Drain rate and wait time bookkeeping of one consumer.
+  struct ConsumerStats {
+    // Time the consumer last got pages and the bytes of these pages. The bytes
+    // are reset once the consumer comes back and they are added to the rate.
+    uint64_t lastDequeueNanos{0};
+    uint64_t lastDequeueBytes{0};
+    // Time the consumer started to wait for data, 0 if not waiting.
+    uint64_t waitStartNanos{0};
+    // Moving average of the bytes per second the consumer drains.
+    double bytesPerSec{0};
+  };
+
+  // Adds the bytes 'consumer' got in its last dequeue to its drain rate when it
+  // comes back for more at 'nowNanos'.
+  static void updateDrainRate(ConsumerStats& consumer, uint64_t nowNanos);
+
+  // Records that 'consumer' got 'bytes' at 'nowNanos' and ends its wait if any.
+  void recordDequeueLocked(
+      ConsumerStats& consumer,
+      uint64_t bytes,
+      uint64_t nowNanos);
+
   const int32_t numberOfConsumers_;
   const uint64_t minOutputBatchBytes_;
 
@@ -236,5 +271,9 @@ class ExchangeQueue {
   int64_t receivedBytes_{0};
   // Maximum value of totalBytes_.
   int64_t peakBytes_{0};
+  // Drain rate and wait time bookkeeping of each consumer id.
+  folly::F14FastMap<int, ConsumerStats> consumerStats_;
+  // Total time the consumers waited for data.
+  uint64_t consumerWaitNanos_{0};
 };
 } // namespace facebook::velox::exec
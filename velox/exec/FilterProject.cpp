@@ -16,6 +16,7 @@
 #include "velox/exec/FilterProject.h"
 #include "velox/core/Expressions.h"
 #include "velox/expression/Expr.h"
+#include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/expression/FieldReference.h"
 
 namespace facebook::velox::exec {
@@ -72,6 +73,54 @@ std::vector<OperatorStats> splitStats(
   return {std::move(projectStats), std::move(filterStats)};
 }
 
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& conjuncts) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(expr);
+}
+
+bool isIntegerKind(TypeKind kind) {
+  return kind == TypeKind::TINYINT || kind == TypeKind::SMALLINT ||
+      kind == TypeKind::INTEGER || kind == TypeKind::BIGINT;
+}
+
+template <typename T>
+std::optional<std::pair<int64_t, int64_t>> intBounds(
+    const BaseVector& vector) {
+  const auto* simple = vector.as<SimpleVector<T>>();
+  if (simple == nullptr || !simple->getMin().has_value() ||
+      !simple->getMax().has_value()) {
+    return std::nullopt;
+  }
+  return std::pair<int64_t, int64_t>(
+      simple->getMin().value(), simple->getMax().value());
+}
+
+// Returns the min and max of the non-null values of integer 'vector' if these
+// are known.
+std::optional<std::pair<int64_t, int64_t>> intBounds(
+    const BaseVector& vector) {
+  switch (vector.typeKind()) {
+    case TypeKind::TINYINT:
+      return intBounds<int8_t>(vector);
+    case TypeKind::SMALLINT:
+      return intBounds<int16_t>(vector);
+    case TypeKind::INTEGER:
+      return intBounds<int32_t>(vector);
+    case TypeKind::BIGINT:
+      return intBounds<int64_t>(vector);
+    default:
+      return std::nullopt;
+  }
+}
+
 } // namespace
 
 FilterProject::FilterProject(
@@ -125,6 +174,10 @@ void FilterProject::initialize() {
   numExprs_ = allExprs.size();
   exprs_ = makeExprSetFromFlag(std::move(allExprs), operatorCtx_->execCtx());
 
+  if (hasFilter_) {
+    initializeColumnFilters();
+  }
+
   if (numExprs_ > 0 && !identityProjections_.empty()) {
     const auto inputType = project_ ? project_->sources()[0]->outputType()
                                     : filter_->sources()[0]->outputType();
@@ -144,6 +197,80 @@ void FilterProject::initialize() {
   project_.reset();
 }
 
+void FilterProject::initializeColumnFilters() {
+  const auto& inputType = filter_->sources()[0]->outputType();
+  std::vector<core::TypedExprPtr> conjuncts;
+  flattenConjuncts(filter_->filter(), conjuncts);
+
+  SimpleExpressionEvaluator evaluator(
+      operatorCtx_->execCtx()->queryCtx(), pool());
+  auto parser = ExprToSubfieldFilterParser::getInstance();
+  for (const auto& conjunct : conjuncts) {
+    auto* call = dynamic_cast<const core::CallTypedExpr*>(conjunct.get());
+    if (call == nullptr) {
+      continue;
+    }
+    common::Subfield subfield;
+    std::unique_ptr<common::Filter> filter;
+    try {
+      filter = parser->leafCallToSubfieldFilter(*call, subfield, &evaluator);
+      if (filter != nullptr) {
+        // Throws if the filter cannot test ranges.
+        filter->testInt64Range(0, 0, false);
+      }
+    } catch (const VeloxException&) {
+      continue;
+    }
+    if (filter == nullptr || subfield.path().size() != 1) {
+      continue;
+    }
+    const auto channel = inputType->getChildIdxIfExists(subfield.toString());
+    if (!channel.has_value() ||
+        !isIntegerKind(inputType->childAt(channel.value())->kind())) {
+      continue;
+    }
+    columnFilters_.emplace_back(channel.value(), std::move(filter));
+  }
+  allConjunctsColumnFilters_ = columnFilters_.size() == conjuncts.size();
+}
+
+std::optional<vector_size_t> FilterProject::filterFromBounds() const {
+  if (columnFilters_.empty()) {
+    return std::nullopt;
+  }
+  bool allPass = allConjunctsColumnFilters_;
+  for (const auto& [channel, filter] : columnFilters_) {
+    const auto& column = input_->childAt(channel);
+    if (isLazyNotLoaded(*column)) {
+      allPass = false;
+      continue;
+    }
+    const auto* loaded = column->loadedVector();
+    const auto* base = loaded->wrappedVector();
+    const auto bounds = intBounds(*base);
+    if (!bounds.has_value()) {
+      allPass = false;
+      continue;
+    }
+    const auto [min, max] = bounds.value();
+    const bool hasNulls = loaded->mayHaveNulls() || base->mayHaveNulls();
+    if (!filter->testInt64Range(min, max, hasNulls)) {
+      return 0;
+    }
+    if (allPass) {
+      const auto* range = filter->kind() == common::FilterKind::kBigintRange
+          ? static_cast<const common::BigintRange*>(filter.get())
+          : nullptr;
+      allPass = range != nullptr && range->lower() <= min &&
+          max <= range->upper() && (!hasNulls || range->testNull());
+    }
+  }
+  if (allPass) {
+    return input_->size();
+  }
+  return std::nullopt;
+}
+
 void FilterProject::addInput(RowVectorPtr input) {
   input_ = std::move(input);
   numProcessedInputRows_ = 0;
@@ -164,6 +291,36 @@ bool FilterProject::isFinished() {
   return noMoreInput_ && allInputProcessed();
 }
 
+void FilterProject::addProfileStats() {
+  if (!operatorCtx_->driverCtx()->queryConfig().exprProfileEnabled()) {
+    return;
+  }
+  for (const auto& [path, stats] : exprs_->profile()) {
+    if (stats.numProfiledRows == 0) {
+      continue;
+    }
+    const auto prefix = fmt::format("exprProfile.{}.", path);
+    addRuntimeStat(
+        prefix + "wallNanos",
+        RuntimeCounter(
+            stats.profileTiming.wallNanos, RuntimeCounter::Unit::kNanos));
+    addRuntimeStat(
+        prefix + "cpuNanos",
+        RuntimeCounter(
+            stats.profileTiming.cpuNanos, RuntimeCounter::Unit::kNanos));
+    addRuntimeStat(
+        prefix + "allocatedBytes",
+        RuntimeCounter(stats.allocatedBytes, RuntimeCounter::Unit::kBytes));
+    addRuntimeStat(prefix + "inputRows", RuntimeCounter(stats.numProfiledRows));
+    addRuntimeStat(prefix + "outputRows", RuntimeCounter(stats.numOutputRows));
+    addRuntimeStat(
+        prefix + "flatNoNulls", RuntimeCounter(stats.numFlatNoNulls));
+    addRuntimeStat(prefix + "peeled", RuntimeCounter(stats.numPeeled));
+    addRuntimeStat(
+        prefix + "memoizedRows", RuntimeCounter(stats.numMemoizedRows));
+  }
+}
+
 RowVectorPtr FilterProject::getOutput() {
   if (allInputProcessed()) {
     return nullptr;
@@ -189,8 +346,13 @@ RowVectorPtr FilterProject::getOutput() {
     return fillOutput(size, nullptr, results);
   }
 
-  // evaluate filter
-  auto numOut = filter(evalCtx, *rows);
+  // evaluate filter unless the bounds of the filtered columns decide it
+  const auto boundsResult = filterFromBounds();
+  if (boundsResult.has_value()) {
+    addRuntimeStat("numBatchesFilteredByBounds", RuntimeCounter(1));
+  }
+  auto numOut = boundsResult.has_value() ? boundsResult.value()
+                                         : filter(evalCtx, *rows);
   numProcessedInputRows_ = size;
   if (numOut == 0) { // no rows passed the filer
     input_ = nullptr;
@@ -19,6 +19,7 @@
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/expression/Expr.h"
+#include "velox/type/Filter.h"
 
 namespace facebook::velox::exec {
 class FilterProject : public Operator {
@@ -59,6 +60,7 @@ class FilterProject : public Operator {
   void close() override {
     Operator::close();
     if (exprs_ != nullptr) {
+      addProfileStats();
       exprs_->clear();
     } else {
       VELOX_CHECK(!initialized_);
@@ -91,12 +93,25 @@ class FilterProject : public Operator {
   // updated.
   vector_size_t filter(EvalCtx& evalCtx, const SelectivityVector& allRows);
 
+  // Collects the conjuncts of 'filter_' that are equivalent to a filter on an
+  // integer input column.
+  void initializeColumnFilters();
+
+  // Decides the filter for all of 'input_' from the min and max of the
+  // filtered columns. Returns 0 if no row can pass, the input size if all rows
+  // pass or std::nullopt if the filter must be evaluated.
+  std::optional<vector_size_t> filterFromBounds() const;
+
   // Evaluate projections on the specified rows and return the results.
   // pre-condition: !isIdentityProjection_
   std::vector<VectorPtr> project(
       const SelectivityVector& rows,
       EvalCtx& evalCtx);
 
+  // Adds the profile of 'exprs_' to the runtime stats if
+  // QueryConfig::kExprProfileEnabled is set.
+  void addProfileStats();
+
   // If true exprs_[0] is a filter and the other expressions are projections
   const bool hasFilter_{false};
 
@@ -111,6 +126,16 @@ class FilterProject : public Operator {
 
   FilterEvalCtx filterEvalCtx_;
 
+  // Conjuncts of the filter that are equivalent to a filter on an integer
+  // input column, with the channel of the column. Scans set the bounds of
+  // columns they filtered, e.g. a pushed down range, so that a batch whose
+  // bounds are disjoint from or inside these filters skips the evaluation.
+  std::vector<std::pair<column_index_t, std::unique_ptr<common::Filter>>>
+      columnFilters_;
+
+  // True if 'columnFilters_' has all the conjuncts of the filter.
+  bool allConjunctsColumnFilters_{false};
+
   vector_size_t numProcessedInputRows_{0};
 
   // Indices for fields/input columns that are both an identity projection and
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/ForwardSubExpressions.h"
+
+#include "velox/expression/SimpleFunctionRegistry.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+struct TypedExprHasher {
+  size_t operator()(const core::TypedExprPtr& expr) const {
+    return expr->hash();
+  }
+};
+
+struct TypedExprComparer {
+  bool operator()(const core::TypedExprPtr& lhs, const core::TypedExprPtr& rhs)
+      const {
+    return *lhs == *rhs;
+  }
+};
+
+// Maps the forwardable subexpressions of the first project to the names of
+// the columns that hold them, empty until the second project reads them.
+using SubExpressionMap = std::unordered_map<
+    core::TypedExprPtr,
+    std::string,
+    TypedExprHasher,
+    TypedExprComparer>;
+
+// Returns true if 'expr' is a call of a registered function or a cast. The
+// inputs of these are evaluated for all the rows, unlike the inputs of the
+// special forms like 'if' and 'and'.
+bool isFunctionCall(const core::TypedExprPtr& expr, bool& deterministic) {
+  if (dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+    deterministic = true;
+    return true;
+  }
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return false;
+  }
+  const auto simpleFunctions =
+      simpleFunctions().getFunctionSignaturesAndMetadata(call->name());
+  const auto metadata = getVectorFunctionMetadata(call->name());
+  if (simpleFunctions.empty() && !metadata.has_value()) {
+    return false;
+  }
+  deterministic = !metadata.has_value() || metadata->deterministic;
+  for (const auto& [simpleMetadata, _] : simpleFunctions) {
+    deterministic &= simpleMetadata.deterministic;
+  }
+  return true;
+}
+
+// Returns true if 'expr' is a deterministic function call over columns and
+// constants that references at least one column.
+bool isForwardable(const core::TypedExprPtr& expr, bool& hasField) {
+  if (auto field = core::TypedExprs::asFieldAccess(expr)) {
+    if (!field->isInputColumn()) {
+      return false;
+    }
+    hasField = true;
+    return true;
+  }
+  if (core::TypedExprs::isConstant(expr)) {
+    return true;
+  }
+  bool deterministic;
+  if (!isFunctionCall(expr, deterministic) || !deterministic) {
+    return false;
+  }
+  for (const auto& input : expr->inputs()) {
+    if (!isForwardable(input, hasField)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isForwardable(const core::TypedExprPtr& expr) {
+  bool hasField = false;
+  return !core::TypedExprs::isFieldAccess(expr) &&
+      isForwardable(expr, hasField) && hasField;
+}
+
+// Adds the forwardable subexpressions 'expr' evaluates for all the rows to
+// 'subExpressions'.
+void collectSubExpressions(
+    const core::TypedExprPtr& expr,
+    SubExpressionMap& subExpressions) {
+  if (isForwardable(expr)) {
+    subExpressions.emplace(expr, "");
+  }
+  bool deterministic;
+  if (isFunctionCall(expr, deterministic)) {
+    for (const auto& input : expr->inputs()) {
+      collectSubExpressions(input, subExpressions);
+    }
+  }
+}
+
+// Replaces the subexpressions of 'expr', an expression over the output of the
+// first project, that are in 'subExpressions' with the columns holding them.
+// 'projections' maps the output columns of the first project to their
+// expressions. Adds the columns that are not output yet to 'forwarded' and
+// their names to 'names'.
+core::TypedExprPtr replaceSubExpressions(
+    const core::TypedExprPtr& expr,
+    const std::unordered_map<std::string, core::TypedExprPtr>& projections,
+    std::unordered_set<std::string>& names,
+    SubExpressionMap& subExpressions,
+    std::vector<std::pair<std::string, core::TypedExprPtr>>& forwarded) {
+  if (isForwardable(expr)) {
+    auto it = subExpressions.find(expr->rewriteInputNames(projections));
+    if (it != subExpressions.end()) {
+      if (it->second.empty()) {
+        auto name = fmt::format("__forwarded{}", forwarded.size());
+        while (names.count(name) > 0) {
+          name += "_";
+        }
+        names.insert(name);
+        it->second = std::move(name);
+        forwarded.emplace_back(it->second, it->first);
+      }
+      return std::make_shared<core::FieldAccessTypedExpr>(
+          expr->type(), it->second);
+    }
+  }
+
+  const auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get());
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (cast == nullptr && call == nullptr) {
+    return expr;
+  }
+  bool changed = false;
+  std::vector<core::TypedExprPtr> inputs;
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(replaceSubExpressions(
+        input, projections, names, subExpressions, forwarded));
+    changed |= inputs.back() != input;
+  }
+  if (!changed) {
+    return expr;
+  }
+  if (cast != nullptr) {
+    return std::make_shared<core::CastTypedExpr>(
+        expr->type(), inputs, cast->nullOnFailure());
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      expr->type(), std::move(inputs), call->name());
+}
+
+// Rewrites 'planNodes[index]' and 'planNodes[index + 1]' if the second project
+// can read subexpressions of the first project or of the filter before it.
+void forwardSubExpressions(
+    std::vector<core::PlanNodePtr>& planNodes,
+    size_t index) {
+  const auto first =
+      std::dynamic_pointer_cast<const core::ProjectNode>(planNodes[index]);
+  const auto second =
+      std::dynamic_pointer_cast<const core::ProjectNode>(planNodes[index + 1]);
+  if (first == nullptr || second == nullptr ||
+      second->sources()[0]->id() != first->id()) {
+    return;
+  }
+
+  SubExpressionMap subExpressions;
+  std::unordered_map<std::string, core::TypedExprPtr> projections;
+  std::unordered_set<std::string> names;
+  for (auto i = 0; i < first->names().size(); ++i) {
+    const auto& name = first->names()[i];
+    const auto& projection = first->projections()[i];
+    projections.emplace(name, projection);
+    names.insert(name);
+    collectSubExpressions(projection, subExpressions);
+  }
+  // The columns the first project outputs already.
+  for (auto i = 0; i < first->names().size(); ++i) {
+    auto it = subExpressions.find(first->projections()[i]);
+    if (it != subExpressions.end() && it->second.empty()) {
+      it->second = first->names()[i];
+    }
+  }
+  if (index > 0) {
+    auto filter =
+        std::dynamic_pointer_cast<const core::FilterNode>(planNodes[index - 1]);
+    if (filter != nullptr && first->sources()[0]->id() == filter->id()) {
+      // All the conjuncts are evaluated for the rows that pass the filter.
+      std::vector<core::TypedExprPtr> conjuncts{filter->filter()};
+      while (!conjuncts.empty()) {
+        auto conjunct = std::move(conjuncts.back());
+        conjuncts.pop_back();
+        const auto* call =
+            dynamic_cast<const core::CallTypedExpr*>(conjunct.get());
+        if (call != nullptr && call->name() == "and") {
+          conjuncts.insert(
+              conjuncts.end(), call->inputs().begin(), call->inputs().end());
+        } else {
+          collectSubExpressions(conjunct, subExpressions);
+        }
+      }
+    }
+  }
+  if (subExpressions.empty()) {
+    return;
+  }
+
+  std::vector<std::pair<std::string, core::TypedExprPtr>> forwarded;
+  std::vector<core::TypedExprPtr> secondProjections;
+  bool changed = false;
+  for (const auto& projection : second->projections()) {
+    secondProjections.push_back(replaceSubExpressions(
+        projection, projections, names, subExpressions, forwarded));
+    changed |= secondProjections.back() != projection;
+  }
+  if (!changed) {
+    return;
+  }
+
+  auto firstNames = first->names();
+  auto firstProjections = first->projections();
+  for (auto& [name, expr] : forwarded) {
+    firstNames.push_back(name);
+    firstProjections.push_back(expr);
+  }
+  auto newFirst = std::make_shared<core::ProjectNode>(
+      first->id(),
+      std::move(firstNames),
+      std::move(firstProjections),
+      first->sources()[0]);
+  planNodes[index + 1] = std::make_shared<core::ProjectNode>(
+      second->id(), second->names(), std::move(secondProjections), newFirst);
+  planNodes[index] = std::move(newFirst);
+}
+} // namespace
+
+void forwardSubExpressions(std::vector<core::PlanNodePtr>& planNodes) {
+  for (size_t i = 0; i + 1 < planNodes.size(); ++i) {
+    forwardSubExpressions(planNodes, i);
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// Rewrites the consecutive ProjectNodes in 'planNodes', the plan nodes of a
+/// pipeline, so that a subexpression the first project or the filter before
+/// it computes is not computed again by the second project, see
+/// 'QueryConfig::kPipelineSubExpressionForwardingEnabled'. The first project
+/// outputs the subexpression as an additional column, which the second
+/// project reads instead.
+///
+/// Only the deterministic calls and casts that the first FilterProject
+/// evaluates for all its output rows are forwarded, i.e. the ones outside of
+/// conditionals and lambdas, and the conjuncts of the filter. The rewritten
+/// nodes keep the ids of the original ones and the second project keeps its
+/// output type.
+void forwardSubExpressions(std::vector<core::PlanNodePtr>& planNodes);
+
+} // namespace facebook::velox::exec
@@ -20,7 +20,8 @@ namespace facebook::velox::exec {
 GroupId::GroupId(
     int32_t operatorId,
     DriverCtx* driverCtx,
-    const std::shared_ptr<const core::GroupIdNode>& groupIdNode)
+    const std::shared_ptr<const core::GroupIdNode>& groupIdNode,
+    bool rollup)
     : Operator(
           driverCtx,
           groupIdNode->outputType(),
@@ -56,6 +57,15 @@ GroupId::GroupId(
     groupingKeyMappings_.emplace_back(std::move(mappings));
   }
 
+  if (rollup) {
+    // A single 'grouping set' with all the grouping keys.
+    std::vector<column_index_t> mappings(numGroupingKeys);
+    for (auto i = 0; i < numGroupingKeys; ++i) {
+      mappings[i] = outputToInputGroupingKeyMapping.at(i);
+    }
+    groupingKeyMappings_ = {std::move(mappings)};
+  }
+
   const auto& aggregationInputs = groupIdNode->aggregationInputs();
   aggregationInputs_.reserve(aggregationInputs.size());
   for (auto i = 0; i < aggregationInputs.size(); ++i) {
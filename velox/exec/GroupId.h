@@ -21,10 +21,15 @@ namespace facebook::velox::exec {
 
 class GroupId : public Operator {
  public:
+  /// @param rollup If true, the aggregation that consumes the output computes
+  /// all the grouping sets from one copy of the input (see
+  /// RollupGroupingSets). Each input row is then returned once with all the
+  /// grouping keys and group id 0 instead of once per grouping set.
   GroupId(
       int32_t operatorId,
       DriverCtx* driverCtx,
-      const std::shared_ptr<const core::GroupIdNode>& groupIdNode);
+      const std::shared_ptr<const core::GroupIdNode>& groupIdNode,
+      bool rollup = false);
 
   bool needsInput() const override;
 
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/GroupingSet.h"
+
+#include <numeric>
+
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
 
@@ -72,6 +75,9 @@ GroupingSet::GroupingSet(
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
       isAdaptive_(queryConfig_.hashAdaptivityEnabled()),
+      partialEviction_(
+          isPartial_ && !isGlobal_ && !aggregates_.empty() &&
+          queryConfig_.partialAggregationEvictionPct() > 0),
       pool_(*operatorCtx->pool()),
       spillStats_(spillStats) {
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
@@ -111,17 +117,54 @@ GroupingSet::GroupingSet(
         "Partial aggregations over sorted inputs are not supported");
   }
 
-  for (auto& aggregate : aggregates_) {
+  std::vector<AggregateInfo*> sharedDistinct;
+  if (!isGlobal_ && !isPartial_ &&
+      queryConfig_.aggregationSharedDistinctTableEnabled()) {
+    for (auto& aggregate : aggregates_) {
+      if (SharedDistinctAggregations::canShare(aggregate, inputType)) {
+        sharedDistinct.push_back(&aggregate);
+      }
+    }
+    if (sharedDistinct.size() < 2) {
+      sharedDistinct.clear();
+    }
+  }
+
+  sharedDistinctIds_.resize(aggregates_.size(), -1);
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto& aggregate = aggregates_[i];
     if (aggregate.distinct) {
       VELOX_USER_CHECK(
           !isPartial_,
           "Partial aggregations over distinct inputs are not supported");
+      auto it =
+          std::find(sharedDistinct.begin(), sharedDistinct.end(), &aggregate);
+      if (it != sharedDistinct.end()) {
+        sharedDistinctIds_[i] = it - sharedDistinct.begin();
+        distinctAggregations_.push_back(nullptr);
+        continue;
+      }
       distinctAggregations_.emplace_back(
           DistinctAggregations::create({&aggregate}, inputType, &pool_));
     } else {
       distinctAggregations_.push_back(nullptr);
     }
   }
+
+  if (!sharedDistinct.empty()) {
+    sharedDistinctAggregations_ = std::make_unique<SharedDistinctAggregations>(
+        std::move(sharedDistinct), inputType, &pool_);
+  }
+
+  const bool allSupportDense = !aggregates_.empty() &&
+      std::all_of(aggregates_.begin(), aggregates_.end(), [](const auto& a) {
+        return !a.distinct && !a.mask.has_value() && a.sortingKeys.empty() &&
+            a.function->supportsDenseAccumulators();
+      });
+  if (isRawInput_ && !isGlobal_ && allSupportDense) {
+    denseAccumulatorsMaxGroups_ =
+        queryConfig_.aggregationDenseAccumulatorsMaxGroups();
+  }
 }
 
 GroupingSet::~GroupingSet() {
@@ -167,6 +210,22 @@ bool equalKeys(
 
   return true;
 }
+
+// Compares row 'index' of 'keys' with row 'otherIndex' of 'otherKeys' on all
+// the keys in order of significance.
+int32_t compareKeys(
+    const std::vector<const BaseVector*>& keys,
+    vector_size_t index,
+    const std::vector<const BaseVector*>& otherKeys,
+    vector_size_t otherIndex) {
+  for (auto i = 0; i < keys.size(); ++i) {
+    const auto result = keys[i]->compare(otherKeys[i], index, otherIndex);
+    if (result != 0) {
+      return result;
+    }
+  }
+  return 0;
+}
 } // namespace
 
 void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
@@ -177,13 +236,19 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
 
   auto numRows = input->size();
   numInputRows_ += numRows;
-  if (!preGroupedKeyChannels_.empty()) {
-    if (remainingInput_) {
-      addRemainingInput();
-    }
+  if (remainingInput_) {
+    addRemainingInput();
+  }
+  if (sortedInputDetection_) {
+    updateSortedInputStreaming(input);
+  }
+  // All the grouping keys are pre-grouped while the input is sorted on them.
+  const auto& preGroupedKeys =
+      sortedInputStreaming_ ? keyChannels_ : preGroupedKeyChannels_;
+  if (!preGroupedKeys.empty()) {
     // Look for the last group of pre-grouped keys.
     for (auto i = input->size() - 2; i >= 0; --i) {
-      if (!equalKeys(preGroupedKeyChannels_, input, i, i + 1)) {
+      if (!equalKeys(preGroupedKeys, input, i, i + 1)) {
         // Process that many rows, flush the accumulators and the hash
         // table, then add remaining rows.
         numRows = i + 1;
@@ -202,8 +267,68 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   addInputForActiveRows(input, mayPushdown);
 }
 
+void GroupingSet::enableSortedInputDetection() {
+  VELOX_CHECK(isPartial_);
+  VELOX_CHECK(!isGlobal_);
+  VELOX_CHECK(!isDistinct());
+  VELOX_CHECK(preGroupedKeyChannels_.empty());
+  VELOX_CHECK_NULL(spillConfig_);
+  VELOX_CHECK_EQ(numInputRows_, 0);
+  sortedInputDetection_ = true;
+}
+
+bool GroupingSet::isSortedContinuation(const RowVectorPtr& input) const {
+  std::vector<const BaseVector*> keys;
+  keys.reserve(keyChannels_.size());
+  for (auto channel : keyChannels_) {
+    keys.push_back(input->childAt(channel)->loadedVector());
+  }
+  if (!lastSortedKeys_.empty()) {
+    std::vector<const BaseVector*> lastKeys;
+    lastKeys.reserve(lastSortedKeys_.size());
+    for (const auto& key : lastSortedKeys_) {
+      lastKeys.push_back(key.get());
+    }
+    if (compareKeys(lastKeys, 0, keys, 0) > 0) {
+      return false;
+    }
+  }
+  for (auto row = 0; row < input->size() - 1; ++row) {
+    if (compareKeys(keys, row, keys, row + 1) > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void GroupingSet::updateSortedInputStreaming(const RowVectorPtr& input) {
+  if (input->size() == 0) {
+    return;
+  }
+  if (!isSortedContinuation(input)) {
+    sortedInputDetection_ = false;
+    sortedInputStreaming_ = false;
+    lastSortedKeys_.clear();
+    return;
+  }
+  sortedInputStreaming_ = true;
+  if (lastSortedKeys_.empty()) {
+    lastSortedKeys_.reserve(keyChannels_.size());
+    for (auto channel : keyChannels_) {
+      lastSortedKeys_.push_back(
+          BaseVector::create(input->childAt(channel)->type(), 1, &pool_));
+    }
+  }
+  const auto lastRow = input->size() - 1;
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    lastSortedKeys_[i]->copy(
+        input->childAt(keyChannels_[i])->loadedVector(), 0, lastRow, 1);
+  }
+}
+
 void GroupingSet::noMoreInput() {
   noMoreInput_ = true;
+  flushDenseAccumulators();
 
   if (remainingInput_) {
     addRemainingInput();
@@ -261,6 +386,24 @@ void GroupingSet::addInputForActiveRows(
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
 
+  if (partialEviction_) {
+    // Marks the groups as recently used for evictPartialGroups().
+    const auto probedFlagOffset = table_->rows()->probedFlagOffset();
+    for (auto row : lookup_->rows) {
+      bits::setBit(groups[row], probedFlagOffset);
+    }
+  }
+
+  // In kArray mode the hashes are the array positions of the groups.
+  const uint64_t* denseGroupNumbers = nullptr;
+  if (prepareDenseAccumulators()) {
+    denseGroupNumbers = lookup_->hashes.data();
+    for (auto row : lookup_->rows) {
+      denseGroups_[denseGroupNumbers[row]] = groups[row];
+    }
+    hasDenseState_ = true;
+  }
+
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
       continue;
@@ -268,6 +411,18 @@ void GroupingSet::addInputForActiveRows(
 
     const auto& rows = getSelectivityVector(i);
 
+    if (sharedDistinctIds_[i] >= 0) {
+      if (!newGroups.empty()) {
+        aggregates_[i].function->initializeNewGroups(groups, newGroups);
+      }
+
+      if (rows.hasSelections()) {
+        sharedDistinctAggregations_->addInput(
+            sharedDistinctIds_[i], groups, input, rows);
+      }
+      continue;
+    }
+
     if (aggregates_[i].distinct) {
       if (!newGroups.empty()) {
         distinctAggregations_[i]->initializeNewGroups(groups, newGroups);
@@ -290,6 +445,15 @@ void GroupingSet::addInputForActiveRows(
     }
 
     populateTempVectors(i, input);
+    if (denseGroupNumbers != nullptr) {
+      function->addDenseRawInput(
+          denseGroupNumbers,
+          rows,
+          tempVectors_,
+          denseAccumulators_[i].data(),
+          denseNonNulls_[i].data());
+      continue;
+    }
     // TODO(spershin): We disable the pushdown at the moment if selectivity
     // vector has changed after groups generation, we might want to revisit
     // this.
@@ -311,6 +475,59 @@ void GroupingSet::addInputForActiveRows(
   }
 }
 
+bool GroupingSet::prepareDenseAccumulators() {
+  if (denseAccumulatorsMaxGroups_ == 0) {
+    return false;
+  }
+  const auto stats = table_->stats();
+  const bool isArray = table_->hashMode() == BaseHashTable::HashMode::kArray;
+  if (hasDenseState_ &&
+      (!isArray || stats.capacity != denseTableCapacity_ ||
+       stats.numRehashes != denseTableRehashes_)) {
+    flushDenseAccumulators();
+  }
+  if (!isArray || stats.capacity > denseAccumulatorsMaxGroups_) {
+    return false;
+  }
+  denseTableRehashes_ = stats.numRehashes;
+  if (stats.capacity == denseTableCapacity_ && !denseGroups_.empty()) {
+    return true;
+  }
+  VELOX_CHECK(!hasDenseState_);
+  denseTableCapacity_ = stats.capacity;
+  denseGroups_.assign(denseTableCapacity_, nullptr);
+  denseAccumulators_.resize(aggregates_.size());
+  denseNonNulls_.resize(aggregates_.size());
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto& accumulators = denseAccumulators_[i];
+    accumulators = raw_vector<char>(&pool_);
+    accumulators.resize(
+        denseTableCapacity_ *
+        aggregates_[i].function->accumulatorFixedWidthSize());
+    std::memset(accumulators.data(), 0, accumulators.size());
+    denseNonNulls_[i].assign(bits::nwords(denseTableCapacity_), 0);
+  }
+  return true;
+}
+
+void GroupingSet::flushDenseAccumulators() {
+  if (!hasDenseState_) {
+    return;
+  }
+  hasDenseState_ = false;
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto& accumulators = denseAccumulators_[i];
+    aggregates_[i].function->mergeDenseAccumulators(
+        denseGroups_.data(),
+        denseGroups_.size(),
+        accumulators.data(),
+        denseNonNulls_[i].data());
+    std::memset(accumulators.data(), 0, accumulators.size());
+    std::fill(denseNonNulls_[i].begin(), denseNonNulls_[i].end(), 0);
+  }
+  std::fill(denseGroups_.begin(), denseGroups_.end(), nullptr);
+}
+
 void GroupingSet::addRemainingInput() {
   activeRows_.resize(remainingInput_->size());
   activeRows_.clearAll();
@@ -374,10 +591,10 @@ std::vector<Accumulator> GroupingSet::accumulators(bool excludeToIntermediate) {
 void GroupingSet::createHashTable() {
   if (ignoreNullKeys_) {
     table_ = HashTable<true>::createForAggregation(
-        std::move(hashers_), accumulators(false), &pool_);
+        std::move(hashers_), accumulators(false), &pool_, partialEviction_);
   } else {
     table_ = HashTable<false>::createForAggregation(
-        std::move(hashers_), accumulators(false), &pool_);
+        std::move(hashers_), accumulators(false), &pool_, partialEviction_);
   }
 
   RowContainer& rows = *table_->rows();
@@ -744,6 +961,8 @@ bool GroupingSet::getOutput(
     return getGlobalAggregationOutput(iterator, result);
   }
 
+  flushDenseAccumulators();
+
   if (hasDefaultGlobalGroupingSetOutput()) {
     return getDefaultGlobalGroupingSetOutput(iterator, result);
   }
@@ -763,6 +982,9 @@ bool GroupingSet::getOutput(
     if (table_ != nullptr) {
       table_->clear(/*freeTable=*/true);
     }
+    if (sharedDistinctAggregations_) {
+      sharedDistinctAggregations_->clear();
+    }
     return false;
   }
   extractGroups(
@@ -811,12 +1033,65 @@ void GroupingSet::extractGroups(
       aggregation->extractValues(groups, result);
     }
   }
+
+  if (sharedDistinctAggregations_) {
+    sharedDistinctAggregations_->extractValues(groups, result);
+  }
 }
 
 void GroupingSet::resetTable(bool freeTable) {
+  flushDenseAccumulators();
+  evictionIterator_.reset();
   if (table_ != nullptr) {
     table_->clear(freeTable);
   }
+  if (sharedDistinctAggregations_) {
+    sharedDistinctAggregations_->clear();
+  }
+}
+
+bool GroupingSet::evictPartialGroups(int32_t maxGroups, RowVectorPtr& result) {
+  VELOX_CHECK(partialEviction_);
+  VELOX_CHECK(!hasSpilled());
+  if (table_ == nullptr || table_->numDistinct() == 0 || maxGroups <= 0) {
+    return false;
+  }
+  flushDenseAccumulators();
+
+  auto* rows = table_->rows();
+  const auto probedFlagOffset = rows->probedFlagOffset();
+  constexpr int32_t kBatch = 1'024;
+  std::vector<char*> candidates(kBatch);
+  std::vector<char*> evicted;
+  evicted.reserve(maxGroups);
+  // Two full turns of the hand find an unreferenced group unless all groups
+  // were referenced, in which case the first turn cleared all flags.
+  const int64_t maxVisits = 2 * rows->numRows();
+  int64_t numVisited = 0;
+  while (evicted.size() < maxGroups && numVisited < maxVisits) {
+    const auto numCandidates =
+        rows->listRows(&evictionIterator_, kBatch, candidates.data());
+    if (numCandidates == 0) {
+      evictionIterator_.reset();
+      continue;
+    }
+    numVisited += numCandidates;
+    for (auto i = 0; i < numCandidates; ++i) {
+      char* group = candidates[i];
+      if (bits::isBitSet(group, probedFlagOffset)) {
+        bits::clearBit(group, probedFlagOffset);
+      } else if (evicted.size() < maxGroups) {
+        evicted.push_back(group);
+      }
+    }
+  }
+  if (evicted.empty()) {
+    return false;
+  }
+  const folly::Range<char**> evictedGroups(evicted.data(), evicted.size());
+  extractGroups(rows, evictedGroups, result);
+  table_->erase(evictedGroups);
+  return true;
 }
 
 bool GroupingSet::isPartialFull(int64_t maxBytes) {
@@ -846,6 +1121,9 @@ uint64_t GroupingSet::allocatedBytes() const {
   if (sortedAggregations_ != nullptr) {
     totalBytes += sortedAggregations_->inputRowBytes();
   }
+  if (sharedDistinctAggregations_ != nullptr) {
+    totalBytes += sharedDistinctAggregations_->allocatedBytes();
+  }
   if (table_ != nullptr) {
     totalBytes += table_->allocatedBytes();
   } else {
@@ -917,17 +1195,20 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
   }
 
   // Check if we can increase reservation. The increment is the larger of twice
-  // the maximum increment from this input and 'spillableReservationGrowthPct_'
-  // of the current memory usage.
+  // the maximum increment from this input and
+  // SpillConfig::reservationGrowthPct() of the current memory usage.
   const auto targetIncrementBytes = std::max<int64_t>(
       incrementBytes * 2,
-      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
+      currentUsage *
+          spillConfig_->reservationGrowthPct(numReservationGrowths_) / 100);
   {
     memory::ReclaimableSectionGuard guard(nonReclaimableSection_);
     if (pool_.maybeReserve(targetIncrementBytes)) {
+      ++numReservationGrowths_;
       return;
     }
   }
+  numReservationGrowths_ = 0;
   LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
                << " for memory pool " << pool_.name()
                << ", usage: " << succinctBytes(pool_.usedBytes())
@@ -1009,26 +1290,10 @@ void GroupingSet::spill() {
   if (table_ == nullptr || table_->numDistinct() == 0) {
     return;
   }
+  flushDenseAccumulators();
 
   auto* rows = table_->rows();
-  VELOX_CHECK_NULL(outputSpiller_);
-  if (inputSpiller_ == nullptr) {
-    VELOX_DCHECK(pool_.trackUsage());
-    VELOX_CHECK(numDistinctSpillFilesPerPartition_.empty());
-    const auto sortingKeys = SpillState::makeSortingKeys(
-        std::vector<CompareFlags>(rows->keyTypes().size()));
-    inputSpiller_ = std::make_unique<AggregationInputSpiller>(
-        rows,
-        makeSpillType(),
-        HashBitRange(
-            spillConfig_->startPartitionBit,
-            static_cast<uint8_t>(
-                spillConfig_->startPartitionBit +
-                spillConfig_->numPartitionBits)),
-        sortingKeys,
-        spillConfig_,
-        spillStats_);
-  }
+  ensureInputSpiller();
   // Spilling may execute on multiple partitions in parallel, and
   // HashStringAllocator is not thread safe. If any aggregations
   // allocate/deallocate memory during spilling it can lead to concurrency bugs.
@@ -1053,12 +1318,86 @@ void GroupingSet::spill() {
   table_->clear(/*freeTable=*/true);
 }
 
+void GroupingSet::ensureInputSpiller() {
+  VELOX_CHECK_NULL(outputSpiller_);
+  if (inputSpiller_ != nullptr) {
+    return;
+  }
+  VELOX_DCHECK(pool_.trackUsage());
+  VELOX_CHECK(numDistinctSpillFilesPerPartition_.empty());
+  auto* rows = table_->rows();
+  const auto sortingKeys = SpillState::makeSortingKeys(
+      std::vector<CompareFlags>(rows->keyTypes().size()));
+  inputSpiller_ = std::make_unique<AggregationInputSpiller>(
+      rows,
+      makeSpillType(),
+      HashBitRange(
+          spillConfig_->startPartitionBit,
+          static_cast<uint8_t>(
+              spillConfig_->startPartitionBit +
+              spillConfig_->numPartitionBits)),
+      sortingKeys,
+      spillConfig_,
+      spillStats_);
+}
+
+bool GroupingSet::supportsPartialSpill() const {
+  return !isDistinct() && sortedAggregations_ == nullptr &&
+      distinctAggregations_.empty();
+}
+
+void GroupingSet::spillPartial(int32_t pct) {
+  VELOX_CHECK_GT(pct, 0);
+  VELOX_CHECK_LE(pct, 100);
+  if (pct == 100 || !supportsPartialSpill()) {
+    spill();
+    return;
+  }
+  if (table_ == nullptr || table_->numDistinct() == 0) {
+    return;
+  }
+  flushDenseAccumulators();
+
+  auto* rows = table_->rows();
+  ensureInputSpiller();
+
+  // Spills the largest partitions first so that the most partitions stay in
+  // memory for the bytes to spill.
+  const auto partitionBytes = inputSpiller_->partitionBytes();
+  const auto totalBytes = std::accumulate(
+      partitionBytes.begin(), partitionBytes.end(), uint64_t{0});
+  std::vector<uint32_t> order(partitionBytes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](auto left, auto right) {
+    return partitionBytes[left] > partitionBytes[right];
+  });
+  std::vector<bool> partitions(partitionBytes.size(), false);
+  uint64_t spillBytes{0};
+  for (const auto partition : order) {
+    if (spillBytes * 100 >= totalBytes * pct) {
+      break;
+    }
+    partitions[partition] = true;
+    spillBytes += partitionBytes[partition];
+  }
+
+  std::vector<char*> spilledRows;
+  // See spill() for why the HashStringAllocator is frozen.
+  rows->stringAllocator().freezeAndExecute(
+      [&]() { inputSpiller_->spill(partitions, spilledRows); });
+  // Erasing the groups frees their accumulators and puts their rows on the
+  // free list of the row container for the new groups of the partitions left
+  // in memory.
+  table_->erase(folly::Range<char**>(spilledRows.data(), spilledRows.size()));
+}
+
 void GroupingSet::spill(const RowContainerIterator& rowIterator) {
   VELOX_CHECK(!hasSpilled());
 
   if (table_ == nullptr) {
     return;
   }
+  flushDenseAccumulators();
 
   auto* rows = table_->rows();
   VELOX_CHECK(pool_.trackUsage());
@@ -1135,7 +1474,11 @@ bool GroupingSet::prepareNextSpillPartitionOutput() {
   VELOX_CHECK_NE(outputSpillPartition_, it->first.partitionNumber());
   outputSpillPartition_ = it->first.partitionNumber();
   merge_ = it->second->createOrderedReader(
-      spillConfig_->readBufferSize, &pool_, spillStats_);
+      spillConfig_->readBufferSize,
+      &pool_,
+      spillStats_,
+      spillConfig_->readAheadExecutor,
+      spillConfig_->mergeReadAheadBudget);
   spillPartitionSet_.erase(it);
   return true;
 }
@@ -1556,6 +1899,36 @@ void AggregationInputSpiller::spill() {
   SpillerBase::spill(nullptr);
 }
 
+void AggregationInputSpiller::spill(
+    const std::vector<bool>& partitions,
+    std::vector<char*>& spilledRows) {
+  VELOX_CHECK_EQ(partitions.size(), static_cast<size_t>(bits_.numPartitions()));
+  SpillerBase::spill(nullptr, &partitions, &spilledRows);
+}
+
+std::vector<uint64_t> AggregationInputSpiller::partitionBytes() const {
+  std::vector<uint64_t> bytes(bits_.numPartitions(), 0);
+  constexpr int32_t kBatchSize = 4096;
+  std::vector<uint64_t> hashes(kBatchSize);
+  std::vector<char*> rows(kBatchSize);
+  RowContainerIterator iterator;
+  for (;;) {
+    const auto numRows = container_->listRows(
+        &iterator, rows.size(), RowContainer::kUnlimited, rows.data());
+    if (numRows == 0) {
+      break;
+    }
+    const auto rowSet = folly::Range<char**>(rows.data(), numRows);
+    for (auto i = 0; i < container_->keyTypes().size(); ++i) {
+      container_->hash(i, rowSet, i > 0, hashes.data());
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      bytes[bits_.partition(hashes[i])] += container_->rowSize(rows[i]);
+    }
+  }
+  return bytes;
+}
+
 void AggregationOutputSpiller::spill(const RowContainerIterator& startRowIter) {
   SpillerBase::spill(&startRowIter);
 }
@@ -19,6 +19,7 @@
 #include "velox/exec/AggregationMasks.h"
 #include "velox/exec/DistinctAggregations.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/SharedDistinctAggregations.h"
 #include "velox/exec/SortedAggregations.h"
 #include "velox/exec/Spiller.h"
 #include "velox/exec/TreeOfLosers.h"
@@ -67,6 +68,20 @@ class GroupingSet {
   /// have changed.
   bool hasOutput();
 
+  /// Makes a partial aggregation check whether each input batch is sorted on
+  /// the grouping keys and greater than the previous batch. While it is, the
+  /// groups are output every time the keys change as if all the grouping keys
+  /// were pre-grouped. The first batch that is out of order turns the check
+  /// off for the rest of the input: a partial aggregation may output a group
+  /// more than once, so the groups output so far stay valid.
+  void enableSortedInputDetection();
+
+  /// True while the input has been sorted on the grouping keys since
+  /// enableSortedInputDetection().
+  bool streamsSortedInput() const {
+    return sortedInputStreaming_;
+  }
+
   /// Called if partial aggregation has reached memory limit or if hasOutput()
   /// returns true. 'maxOutputRows' and 'maxOutputBytes' specify the max number
   /// of rows/bytes to return in 'result' respectively. The function stops
@@ -93,6 +108,19 @@ class GroupingSet {
   /// based on value ranges to one based on value ids can save a lot.
   bool isPartialFull(int64_t maxBytes);
 
+  /// True if a partial aggregation evicts groups with evictPartialGroups()
+  /// instead of flushing all groups when full.
+  bool supportsPartialEviction() const {
+    return partialEviction_;
+  }
+
+  /// Evicts up to 'maxGroups' groups from a partial aggregation and returns
+  /// their keys and intermediate results in 'result'. Picks the groups with
+  /// the CLOCK algorithm: a sweep over the group rows evicts groups that were
+  /// not updated since the previous sweep and clears the flag of the others.
+  /// Returns false if there is nothing to evict.
+  bool evictPartialGroups(int32_t maxGroups, RowVectorPtr& result);
+
   /// Returns the count of the hash table, if any.
   int64_t numDistinct() const {
     return table_ ? table_->numDistinct() : 0;
@@ -111,6 +139,19 @@ class GroupingSet {
   /// Spills all the rows in container.
   void spill();
 
+  /// Spills the largest hash partitions of the table which together hold at
+  /// least 'pct' percent of the row bytes and erases their groups from the
+  /// table. The groups of the other partitions stay in memory and keep
+  /// aggregating the input. Like after spill(), the rows left in memory are
+  /// spilled in noMoreInput() and the output merges the spilled runs. Spills
+  /// all the rows if partial spilling is not supported.
+  void spillPartial(int32_t pct);
+
+  /// True if spillPartial() can keep some of the groups in memory. The
+  /// distinct aggregations and the aggregations with sorted or distinct inputs
+  /// keep state outside of the group rows and are spilled as a whole.
+  bool supportsPartialSpill() const;
+
   /// Spills all the rows in container starting from the offset specified by
   /// 'rowIterator'. This should be only called during output processing and
   /// when no spill has occurred previously.
@@ -163,6 +204,15 @@ class GroupingSet {
 
   void addRemainingInput();
 
+  // Returns true if 'input' is sorted on the grouping keys and its first row
+  // is not less than the last row of the previous batch.
+  bool isSortedContinuation(const RowVectorPtr& input) const;
+
+  // Checks if 'input' keeps the input sorted on the grouping keys. Turns
+  // 'sortedInputDetection_' and 'sortedInputStreaming_' off if not, otherwise
+  // records the keys of the last row of 'input'.
+  void updateSortedInputStreaming(const RowVectorPtr& input);
+
   void initializeGlobalAggregation();
 
   void destroyGlobalAggregations();
@@ -182,6 +232,21 @@ class GroupingSet {
 
   void createHashTable();
 
+  // Returns true if the accumulators for the input being added are kept in
+  // 'denseAccumulators_'. This is the case when 'table_' is in kArray mode
+  // with at most 'denseAccumulatorsMaxGroups_' entries. Flushes the dense
+  // accumulators if the array positions of the groups changed since the
+  // previous input.
+  bool prepareDenseAccumulators();
+
+  // Adds the dense accumulators to the group rows and resets them. Must be
+  // called before the accumulators in the group rows are read or before the
+  // group rows are freed.
+  void flushDenseAccumulators();
+
+  // Creates 'inputSpiller_' on the first spill of the input.
+  void ensureInputSpiller();
+
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
   // If the given aggregation has mask, the method returns reference to the
@@ -309,6 +374,15 @@ class GroupingSet {
   std::unique_ptr<SortedAggregations> sortedAggregations_;
   std::vector<std::unique_ptr<DistinctAggregations>> distinctAggregations_;
 
+  // Distinct aggregates over single columns that share one hash table instead
+  // of keeping a set per group and aggregate. Set if
+  // 'aggregation_shared_distinct_table_enabled' is true and there are at least
+  // two such aggregates.
+  std::unique_ptr<SharedDistinctAggregations> sharedDistinctAggregations_;
+
+  // Id of each aggregate in 'sharedDistinctAggregations_', -1 if not shared.
+  std::vector<int32_t> sharedDistinctIds_;
+
   const bool ignoreNullKeys_;
 
   uint64_t numInputRows_ = 0;
@@ -320,6 +394,9 @@ class GroupingSet {
 
   const common::SpillConfig* const spillConfig_;
 
+  // See SpillConfig::reservationGrowthPct().
+  uint32_t numReservationGrowths_{0};
+
   // Indicates if this grouping set and the associated hash aggregation operator
   // is under non-reclaimable execution section or not.
   tsan_atomic<bool>* const nonReclaimableSection_;
@@ -336,6 +413,37 @@ class GroupingSet {
   std::unique_ptr<HashLookup> lookup_;
   SelectivityVector activeRows_;
 
+  // Max number of array positions in a kArray mode 'table_' for keeping
+  // accumulators in flat arrays indexed by array position. 0 if dense
+  // accumulators are disabled or not supported by all the aggregates.
+  uint32_t denseAccumulatorsMaxGroups_{0};
+
+  // The group row for each array position that has dense accumulator state.
+  std::vector<char*> denseGroups_;
+
+  // Per aggregate, the dense accumulators and non-null flags indexed by array
+  // position.
+  std::vector<raw_vector<char>> denseAccumulators_;
+  std::vector<std::vector<uint64_t>> denseNonNulls_;
+
+  // Capacity and number of rehashes of 'table_' when the positions in
+  // 'denseGroups_' were recorded. A change in either moves groups to other
+  // array positions.
+  uint64_t denseTableCapacity_{0};
+  int64_t denseTableRehashes_{0};
+
+  // True if the dense accumulators have state not yet added to group rows.
+  bool hasDenseState_{false};
+
+  // True if partial aggregation evicts cold groups instead of flushing all
+  // groups when full. The probed flag of the group rows is set when a group is
+  // updated and serves as the CLOCK reference bit.
+  const bool partialEviction_;
+
+  // The CLOCK hand of evictPartialGroups(), i.e. the position of the next
+  // group row to consider for eviction.
+  RowContainerIterator evictionIterator_;
+
   // Used to allocate memory for a single row accumulating results of global
   // aggregation
   HashStringAllocator stringAllocator_;
@@ -352,6 +460,18 @@ class GroupingSet {
   // First row in remainingInput_ that needs to be processed.
   vector_size_t firstRemainingRow_;
 
+  // True if enableSortedInputDetection() was called and no batch has been out
+  // of order on the grouping keys so far.
+  bool sortedInputDetection_{false};
+
+  // True while 'sortedInputDetection_' and all the input so far was sorted on
+  // the grouping keys. 'keyChannels_' are then treated as pre-grouped keys.
+  bool sortedInputStreaming_{false};
+
+  // The grouping keys of the last row of the previous input batch, one single
+  // row vector per key in 'keyChannels_'. Empty before the first batch.
+  std::vector<VectorPtr> lastSortedKeys_;
+
   // In case of distinct aggregation without aggregates and the grouping key
   // reordered, the spilled data is first loaded into
   // 'spillResultWithoutAggregates_' and then reordered back and load to
@@ -427,6 +547,17 @@ class AggregationInputSpiller : public SpillerBase {
 
   void spill();
 
+  /// Spills the rows of the hash partitions set in 'partitions' and appends
+  /// them to 'spilledRows'. The caller erases the spilled rows from the row
+  /// container.
+  void spill(
+      const std::vector<bool>& partitions,
+      std::vector<char*>& spilledRows);
+
+  /// Returns the byte size of the rows of each hash partition in the row
+  /// container.
+  std::vector<uint64_t> partitionBytes() const;
+
  private:
   std::string type() const override {
     return std::string(kType);
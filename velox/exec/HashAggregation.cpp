@@ -48,13 +48,40 @@ HashAggregation::HashAggregation(
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
       maxPartialAggregationMemoryUsage_(
-          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()),
+      partialAggregationEvictionPct_(std::min(
+          100, driverCtx->queryConfig().partialAggregationEvictionPct())),
+      spillPartialPct_(std::min(
+          100, driverCtx->queryConfig().aggregationSpillPartialPct())) {
+  if (driverCtx->queryConfig().concurrentHashAggregationEnabled() &&
+      !canSpill() && ConcurrentGroupingTable::supports(*aggregationNode)) {
+    concurrentTable_ =
+        operatorCtx_->task()->getOrAddConcurrentGroupingTableLocked(
+            driverCtx->splitGroupId, *aggregationNode);
+  }
+}
 
 void HashAggregation::initialize() {
   Operator::initialize();
 
   VELOX_CHECK(pool()->trackUsage());
 
+  if (concurrentTable_ != nullptr) {
+    aggregationNode_.reset();
+    return;
+  }
+
+  if (RollupGroupingSets::supports(
+          *aggregationNode_, operatorCtx_->driverCtx()->queryConfig())) {
+    rollupGroupingSets_ = std::make_unique<RollupGroupingSets>(
+        *aggregationNode_,
+        operatorCtx_.get(),
+        &nonReclaimableSection_,
+        &spillStats_);
+    aggregationNode_.reset();
+    return;
+  }
+
   const auto& inputType = aggregationNode_->sources()[0]->outputType();
   std::vector<column_index_t> groupingKeyInputChannels;
   std::vector<column_index_t> groupingKeyOutputChannels;
@@ -115,6 +142,14 @@ void HashAggregation::initialize() {
       operatorCtx_.get(),
       &spillStats_);
 
+  if (operatorCtx_->driverCtx()
+          ->queryConfig()
+          .partialAggregationSortedInputDetectionEnabled() &&
+      isPartialOutput_ && !isGlobal_ && !isDistinct_ &&
+      aggregationNode_->preGroupedKeys().empty() && !spillConfig_.has_value()) {
+    groupingSet_->enableSortedInputDetection();
+  }
+
   aggregationNode_.reset();
 }
 
@@ -173,6 +208,16 @@ bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
 }
 
 void HashAggregation::addInput(RowVectorPtr input) {
+  if (concurrentTable_ != nullptr) {
+    concurrentTable_->addInput(input, concurrentInput_);
+    numInputRows_ += input->size();
+    return;
+  }
+  if (rollupGroupingSets_ != nullptr) {
+    rollupGroupingSets_->addInput(input);
+    numInputRows_ += input->size();
+    return;
+  }
   if (!pushdownChecked_) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
@@ -184,18 +229,28 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
   groupingSet_->addInput(input, mayPushdown_);
   numInputRows_ += input->size();
+  if (groupingSet_->streamsSortedInput()) {
+    addRuntimeStat("sortedInputRowCount", RuntimeCounter(input->size()));
+  }
 
   updateRuntimeStats();
 
   // NOTE: we should not trigger partial output flush in case of global
   // aggregation as the final aggregator will handle it the same way as the
   // partial aggregator. Hence, we have to use more memory anyway.
+  // The groups evicted so far count as output of the partial aggregation.
+  // The groups of sorted input are output once and the rest of the batch
+  // waits in the grouping set, so the aggregation is not abandoned.
   const bool abandonPartialEarly = isPartialOutput_ && !isGlobal_ &&
-      abandonPartialAggregationEarly(groupingSet_->numDistinct());
+      !groupingSet_->streamsSortedInput() &&
+      abandonPartialAggregationEarly(
+          numOutputRows_ + groupingSet_->numDistinct());
   if (isPartialOutput_ && !isGlobal_ &&
       (abandonPartialEarly ||
        groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_))) {
-    partialFull_ = true;
+    if (abandonPartialEarly || !maybeEvictPartialGroups()) {
+      partialFull_ = true;
+    }
   }
 
   if (isDistinct_) {
@@ -272,6 +327,7 @@ void HashAggregation::resetPartialOutputIfNeed() {
   }
   groupingSet_->resetTable(/*freeTable=*/false);
   partialFull_ = false;
+  maxPartialGroups_ = 0;
   if (!finished_) {
     maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
   }
@@ -286,10 +342,11 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
   VELOX_DCHECK(isPartialOutput_);
   // If size is at max and there still is not enough reduction, abandon partial
   // aggregation.
-  if (abandonPartialAggregationEarly(numOutputRows_) ||
-      (aggregationPct > kPartialMinFinalPct &&
-       maxPartialAggregationMemoryUsage_ >=
-           maxExtendedPartialAggregationMemoryUsage_)) {
+  if (!groupingSet_->streamsSortedInput() &&
+      (abandonPartialAggregationEarly(numOutputRows_) ||
+       (aggregationPct > kPartialMinFinalPct &&
+        maxPartialAggregationMemoryUsage_ >=
+            maxExtendedPartialAggregationMemoryUsage_))) {
     groupingSet_->abandonPartialAggregation();
     pool()->release();
     addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
@@ -322,6 +379,12 @@ RowVectorPtr HashAggregation::getOutput() {
     input_ = nullptr;
     return nullptr;
   }
+  if (concurrentTable_ != nullptr) {
+    return getConcurrentOutput();
+  }
+  if (rollupGroupingSets_ != nullptr) {
+    return getRollupOutput();
+  }
   if (abandonedPartialAggregation_) {
     if (noMoreInput_) {
       finished_ = true;
@@ -336,6 +399,10 @@ RowVectorPtr HashAggregation::getOutput() {
     return output_;
   }
 
+  if (partialEvict_) {
+    return getEvictedOutput();
+  }
+
   // Produce results if one of the following is true:
   // - received no-more-input message;
   // - partial aggregation reached memory limit;
@@ -374,6 +441,103 @@ RowVectorPtr HashAggregation::getOutput() {
   return output_;
 }
 
+bool HashAggregation::maybeEvictPartialGroups() {
+  if (!groupingSet_->supportsPartialEviction()) {
+    return false;
+  }
+  const auto numGroups = groupingSet_->numDistinct();
+  if (maxPartialGroups_ == 0) {
+    maxPartialGroups_ = numGroups;
+    partialFullBytes_ = groupingSet_->allocatedBytes();
+  }
+  // Eviction does not free memory but reuses the rows of evicted groups. Flush
+  // all groups if variable width data keeps growing.
+  if (groupingSet_->allocatedBytes() > 2 * partialFullBytes_) {
+    return false;
+  }
+  partialEvict_ = numGroups >= maxPartialGroups_;
+  return true;
+}
+
+RowVectorPtr HashAggregation::getEvictedOutput() {
+  VELOX_CHECK(isPartialOutput_ && !isGlobal_ && !isDistinct_);
+  partialEvict_ = false;
+  const int64_t targetGroups =
+      maxPartialGroups_ * (100 - partialAggregationEvictionPct_) / 100;
+  const int64_t numToEvict = std::min<int64_t>(
+      outputBatchRows(estimatedOutputRowSize_),
+      std::max<int64_t>(1, groupingSet_->numDistinct() - targetGroups));
+  prepareOutput(numToEvict);
+  if (!groupingSet_->evictPartialGroups(numToEvict, output_)) {
+    return nullptr;
+  }
+  numOutputRows_ += output_->size();
+  {
+    auto lockedStats = stats_.wlock();
+    lockedStats->addRuntimeStat(
+        "evictedRowCount", RuntimeCounter(output_->size()));
+    lockedStats->addRuntimeStat("evictionTimes", RuntimeCounter(1));
+  }
+  return output_;
+}
+
+RowVectorPtr HashAggregation::getConcurrentOutput() {
+  // Wait for the peers to finish adding input into the shared table.
+  if (!noMoreInput_ || future_.valid()) {
+    return nullptr;
+  }
+  const auto maxOutputRows = outputBatchRows(estimatedOutputRowSize_);
+  prepareOutput(maxOutputRows);
+  if (!concurrentTable_->getOutput(
+          concurrentOutputCursor_, maxOutputRows, output_)) {
+    finished_ = true;
+    return nullptr;
+  }
+  numOutputRows_ += output_->size();
+  return output_;
+}
+
+RowVectorPtr HashAggregation::getRollupOutput() {
+  if (!noMoreInput_) {
+    return nullptr;
+  }
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  auto output = rollupGroupingSets_->getOutput(
+      outputBatchRows(estimatedOutputRowSize_),
+      queryConfig.preferredOutputBatchBytes());
+  if (output == nullptr) {
+    finished_ = true;
+    return nullptr;
+  }
+  numOutputRows_ += output->size();
+  return output;
+}
+
+void HashAggregation::noMoreConcurrentInput() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+  // The last driver to finish adding input reports the table stats and lets
+  // the other drivers produce output.
+  {
+    auto lockedStats = stats_.wlock();
+    auto& runtimeStats = lockedStats->runtimeStats;
+    runtimeStats[BaseHashTable::kCapacity] =
+        RuntimeMetric(concurrentTable_->capacity());
+    runtimeStats[BaseHashTable::kNumRehashes] =
+        RuntimeMetric(concurrentTable_->numRehashes());
+    runtimeStats[BaseHashTable::kNumDistinct] =
+        RuntimeMetric(concurrentTable_->numGroups());
+  }
+  peers.clear();
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
 RowVectorPtr HashAggregation::getDistinctOutput() {
   VELOX_CHECK(isDistinct_);
   VELOX_CHECK(!finished_);
@@ -434,6 +598,17 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 }
 
 void HashAggregation::noMoreInput() {
+  if (concurrentTable_ != nullptr) {
+    Operator::noMoreInput();
+    noMoreConcurrentInput();
+    return;
+  }
+  if (rollupGroupingSets_ != nullptr) {
+    rollupGroupingSets_->noMoreInput();
+    Operator::noMoreInput();
+    pool()->release();
+    return;
+  }
   updateEstimatedOutputRowSize();
   groupingSet_->noMoreInput();
   Operator::noMoreInput();
@@ -445,6 +620,14 @@ bool HashAggregation::isFinished() {
   return finished_;
 }
 
+uint64_t HashAggregation::reclaimCostNs(uint64_t reclaimableBytes) const {
+  if (noMoreInput_ && isDistinct_ && groupingSet_ != nullptr &&
+      !groupingSet_->hasSpilled()) {
+    return 0;
+  }
+  return Operator::reclaimCostNs(reclaimableBytes);
+}
+
 void HashAggregation::reclaim(
     uint64_t targetBytes,
     memory::MemoryReclaimer::Stats& stats) {
@@ -477,6 +660,16 @@ void HashAggregation::reclaim(
     // Spill all the rows starting from the next output row pointed by
     // 'resultIterator_'.
     groupingSet_->spill(resultIterator_);
+  } else if (
+      spillPartialPct_ > 0 && targetBytes > 0 &&
+      groupingSet_->supportsPartialSpill() &&
+      pool()->availableReservation() >= static_cast<int64_t>(targetBytes)) {
+    // Releasing the unused reservation satisfies the reclaim. Spill only some
+    // of the partitions to make room in the table for the growth the
+    // reservation was held for and keep aggregating the others in memory.
+    groupingSet_->spillPartial(spillPartialPct_);
+    pool()->release();
+    return;
   } else {
     // TODO: support fine-grain disk spilling based on 'targetBytes' after
     // having row container memory compaction support later.
@@ -493,6 +686,8 @@ void HashAggregation::close() {
 
   output_ = nullptr;
   groupingSet_.reset();
+  concurrentTable_.reset();
+  rollupGroupingSets_.reset();
 }
 
 void HashAggregation::updateEstimatedOutputRowSize() {
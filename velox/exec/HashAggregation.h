@@ -15,8 +15,10 @@
  */
 #pragma once
 
+#include "velox/exec/ConcurrentGroupingTable.h"
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/RollupGroupingSets.h"
 
 namespace facebook::velox::exec {
 
@@ -34,17 +36,25 @@ class HashAggregation : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_ && !partialFull_;
+    return !noMoreInput_ && !partialFull_ && !partialEvict_;
   }
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
+  BlockingReason isBlocked(ContinueFuture* future) override {
+    if (future_.valid()) {
+      *future = std::move(future_);
+      return BlockingReason::kWaitForProducer;
+    }
     return BlockingReason::kNotBlocked;
   }
 
   bool isFinished() override;
 
+  /// Reclaiming a distinct aggregation which has seen all its input drops the
+  /// hash table without spilling.
+  uint64_t reclaimCostNs(uint64_t reclaimableBytes) const override;
+
   void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
       override;
 
@@ -72,6 +82,26 @@ class HashAggregation : public Operator {
 
   RowVectorPtr getDistinctOutput();
 
+  // Returns true if a partial aggregation that reached its memory limit
+  // should evict groups rather than flush all groups. Sets 'partialEvict_' if
+  // there are enough groups to evict.
+  bool maybeEvictPartialGroups();
+
+  // Evicts groups from a full partial aggregation and returns them.
+  RowVectorPtr getEvictedOutput();
+
+  // Returns the next batch of groups from 'concurrentTable_' once all the
+  // drivers have finished adding input.
+  RowVectorPtr getConcurrentOutput();
+
+  // Waits for the peer drivers to finish adding input into 'concurrentTable_'.
+  // The last driver to finish wakes up the others.
+  void noMoreConcurrentInput();
+
+  // Returns the next batch of grouping set results from 'rollupGroupingSets_'
+  // once all the input has been added.
+  RowVectorPtr getRollupOutput();
+
   // Setups the projections for accessing grouping keys stored in grouping
   // set.
   // For 'groupingKeyInputChannels', the index is the key column index from
@@ -98,14 +128,40 @@ class HashAggregation : public Operator {
   const int32_t abandonPartialAggregationMinPct_;
 
   int64_t maxPartialAggregationMemoryUsage_;
+  // Percentage of the groups evicted at a time from a full partial
+  // aggregation. 0 if a full partial aggregation flushes all groups.
+  const int32_t partialAggregationEvictionPct_;
+  // Percentage of the row bytes spilled by a reclaim which the unused
+  // reservation satisfies. 0 if a reclaim spills all the rows.
+  const int32_t spillPartialPct_;
   std::unique_ptr<GroupingSet> groupingSet_;
 
+  // Grouping table shared with the peer drivers if the aggregation is
+  // concurrent. 'groupingSet_' is not used then.
+  std::shared_ptr<ConcurrentGroupingTable> concurrentTable_;
+  ConcurrentGroupingTable::DecodedInput concurrentInput_;
+  ConcurrentGroupingTable::OutputCursor concurrentOutputCursor_;
+  // Set while waiting for the peer drivers to finish adding input.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
+  // Computes the grouping sets of an aggregation over a GroupId from one copy
+  // of the input. 'groupingSet_' is not used then.
+  std::unique_ptr<RollupGroupingSets> rollupGroupingSets_;
+
   // Size of a single output row estimated using
   // 'groupingSet_->estimateRowSize()'. If spilling, this value is set to max
   // 'groupingSet_->estimateRowSize()' across all accumulated data set.
   std::optional<int64_t> estimatedOutputRowSize_;
 
   bool partialFull_ = false;
+  // True if getOutput() evicts groups from a full partial aggregation.
+  bool partialEvict_ = false;
+  // The number of groups when the partial aggregation first reached its
+  // memory limit. Eviction keeps the number of groups below this. 0 if the
+  // limit has not been reached since the last flush.
+  int64_t maxPartialGroups_ = 0;
+  // Memory used by the partial aggregation when 'maxPartialGroups_' was set.
+  int64_t partialFullBytes_ = 0;
   bool newDistincts_ = false;
   bool finished_ = false;
   // True if partial aggregation has been found to be non-reducing.
@@ -15,9 +15,13 @@
  */
 
 #include "velox/exec/HashBuild.h"
+
+#include <folly/String.h>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -65,6 +69,13 @@ HashBuild::HashBuild(
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
+      shareTable_(canShareTable()),
+      compactSpillInputColumns_(
+          canSpill() &&
+          driverCtx->queryConfig().joinSpillCompactColumnsEnabled()),
+      sortMergeFallback_(
+          canSpill() && isInnerJoin(joinType_) && !joinNode_->filter() &&
+          driverCtx->queryConfig().hashJoinSortMergeFallbackEnabled()),
       keyChannelMap_(joinNode_->rightKeys().size()) {
   VELOX_CHECK(pool()->trackUsage());
   VELOX_CHECK_NOT_NULL(joinBridge_);
@@ -100,6 +111,10 @@ HashBuild::HashBuild(
       decoders_.emplace_back(std::make_unique<DecodedVector>());
     }
   }
+  if (compactSpillInputColumns_) {
+    inputRanges_.resize(dependentChannels_.size());
+    nonCompactInputColumns_.resize(dependentChannels_.size(), false);
+  }
 
   tableType_ = hashJoinTableType(joinNode_);
   setupTable();
@@ -143,7 +158,8 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        pool(),
+        spillInputRanges_);
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -163,7 +179,8 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          spillInputRanges_);
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -174,9 +191,12 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          spillInputRanges_);
     }
   }
+  table_->setRadixPartitionBytes(
+      operatorCtx_->driverCtx()->queryConfig().hashJoinRadixPartitionBytes());
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
@@ -308,6 +328,9 @@ void HashBuild::removeInputRowsForAntiJoinFilter() {
 
 void HashBuild::addInput(RowVectorPtr input) {
   checkRunning();
+  if (maybeUseSharedTable()) {
+    return;
+  }
   ensureInputFits(input);
 
   TestValue::adjust("facebook::velox::exec::HashBuild::addInput", this);
@@ -359,6 +382,9 @@ void HashBuild::addInput(RowVectorPtr input) {
     decoders_[i]->decode(
         *input->childAt(dependentChannels_[i])->loadedVector(), activeRows_);
   }
+  if (compactSpillInputColumns_ && !isInputFromSpill()) {
+    updateInputRanges();
+  }
 
   if (isAntiJoin(joinType_) && joinNode_->filter()) {
     if (filterPropagatesNulls_) {
@@ -485,14 +511,16 @@ void HashBuild::ensureInputFits(RowVectorPtr& input) {
 
   // Check if we can increase reservation. The increment is the larger of
   // twice the maximum increment from this input and
-  // 'spillableReservationGrowthPct_' of the current reservation.
+  // SpillConfig::reservationGrowthPct() of the current reservation.
   const auto targetIncrementBytes = std::max<int64_t>(
       incrementBytes * 2,
-      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
+      currentUsage *
+          spillConfig_->reservationGrowthPct(numReservationGrowths_) / 100);
 
   {
     Operator::ReclaimableSectionGuard guard(this);
     if (pool()->maybeReserve(targetIncrementBytes)) {
+      ++numReservationGrowths_;
       // If above reservation triggers the spilling of 'HashBuild' operator
       // itself, we will no longer need the reserved memory for building hash
       // table as the table is spilled, and the input will be directly spilled,
@@ -503,6 +531,7 @@ void HashBuild::ensureInputFits(RowVectorPtr& input) {
       return;
     }
   }
+  numReservationGrowths_ = 0;
   LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
                << " for memory pool " << pool()->name()
                << ", usage: " << succinctBytes(pool()->usedBytes())
@@ -705,6 +734,14 @@ bool HashBuild::finishHashBuild() {
     otherBuilds.push_back(build);
   }
 
+  if (shareTable_ && !isInputFromSpill()) {
+    bool hasNullKeys{false};
+    if (auto sharedTable = findSharedTable(otherBuilds, hasNullKeys)) {
+      setSharedTable(std::move(sharedTable), hasNullKeys, otherBuilds);
+      return true;
+    }
+  }
+
   ensureTableFits(numRows);
 
   std::vector<std::unique_ptr<BaseHashTable>> otherTables;
@@ -722,6 +759,10 @@ bool HashBuild::finishHashBuild() {
       VELOX_CHECK_NOT_NULL(build->table_);
       otherTables.push_back(std::move(build->table_));
       spiller = std::move(build->spiller_);
+      for (auto& file : build->sortMergeBuildFiles_) {
+        sortMergeBuildFiles_.push_back(std::move(file));
+      }
+      build->sortMergeBuildFiles_.clear();
     }
     if (spiller != nullptr) {
       spiller->finishSpill(spillPartitions);
@@ -733,6 +774,11 @@ bool HashBuild::finishHashBuild() {
     removeEmptyPartitions(spillPartitions);
   }
 
+  // The table may also be spilled later from the join bridge.
+  if (compactSpillInputColumns_ && !isInputFromSpill()) {
+    setSpillInputRanges(otherBuilds);
+  }
+
   // TODO: Get accurate signal if parallel join build is going to be applied
   //  from hash table. Currently there is still a chance inside hash table that
   //  it might decide it is not going to trigger parallel join build.
@@ -763,6 +809,17 @@ bool HashBuild::finishHashBuild() {
 
   addRuntimeStats();
 
+  if (shareTable_ && !isInputFromSpill() && spillPartitions.empty()) {
+    bool hasNullKeys{joinHasNullKeys_};
+    if (auto sharedTable = publishTable(otherBuilds, hasNullKeys)) {
+      joinBridge_->setSharedHashTable(std::move(sharedTable), hasNullKeys);
+      if (canSpill()) {
+        stateCleared_ = true;
+      }
+      return true;
+    }
+  }
+
   // Setup spill function for spilling hash table directly from hash join
   // bridge after transferring of table ownership.
   HashJoinTableSpillFunc tableSpillFunc;
@@ -787,13 +844,230 @@ bool HashBuild::finishHashBuild() {
       std::move(table_),
       std::move(spillPartitions),
       joinHasNullKeys_,
-      std::move(tableSpillFunc));
+      std::move(tableSpillFunc),
+      std::move(sortMergeBuildFiles_));
+  sortMergeBuildFiles_.clear();
   if (canSpill()) {
     stateCleared_ = true;
   }
   return true;
 }
 
+void HashBuild::updateInputRanges() {
+  const auto numKeys = keyChannels_.size();
+  for (auto i = 0; i < dependentChannels_.size(); ++i) {
+    const auto& decoded = *decoders_[i];
+    auto& range = inputRanges_[i];
+    auto addValue = [&](int64_t value) {
+      if (!range.has_value()) {
+        range = RowContainer::ColumnRange{value, value};
+      } else {
+        range->min = std::min(range->min, value);
+        range->max = std::max(range->max, value);
+      }
+    };
+    switch (tableType_->childAt(numKeys + i)->kind()) {
+      case TypeKind::SMALLINT:
+        activeRows_.applyToSelected([&](auto row) {
+          if (!decoded.isNullAt(row)) {
+            addValue(decoded.valueAt<int16_t>(row));
+          }
+        });
+        break;
+      case TypeKind::INTEGER:
+        activeRows_.applyToSelected([&](auto row) {
+          if (!decoded.isNullAt(row)) {
+            addValue(decoded.valueAt<int32_t>(row));
+          }
+        });
+        break;
+      case TypeKind::BIGINT:
+        activeRows_.applyToSelected([&](auto row) {
+          if (!decoded.isNullAt(row)) {
+            addValue(decoded.valueAt<int64_t>(row));
+          }
+        });
+        break;
+      case TypeKind::TIMESTAMP:
+        // The range is in microseconds. A single value with a finer precision
+        // keeps the column at full width.
+        if (nonCompactInputColumns_[i]) {
+          break;
+        }
+        activeRows_.testSelected([&](auto row) {
+          if (decoded.isNullAt(row)) {
+            return true;
+          }
+          const auto timestamp = decoded.valueAt<Timestamp>(row);
+          if (!RowContainer::isCompactTimestamp(timestamp)) {
+            nonCompactInputColumns_[i] = true;
+            range.reset();
+            return false;
+          }
+          addValue(timestamp.toMicros());
+          return true;
+        });
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void HashBuild::setSpillInputRanges(
+    const std::vector<HashBuild*>& otherBuilds) {
+  auto ranges = inputRanges_;
+  auto nonCompactColumns = nonCompactInputColumns_;
+  for (auto* build : otherBuilds) {
+    for (auto i = 0; i < ranges.size(); ++i) {
+      if (build->nonCompactInputColumns_[i]) {
+        nonCompactColumns[i] = true;
+        continue;
+      }
+      const auto& otherRange = build->inputRanges_[i];
+      if (!otherRange.has_value()) {
+        continue;
+      }
+      if (!ranges[i].has_value()) {
+        ranges[i] = otherRange;
+      } else {
+        ranges[i]->min = std::min(ranges[i]->min, otherRange->min);
+        ranges[i]->max = std::max(ranges[i]->max, otherRange->max);
+      }
+    }
+  }
+  for (auto i = 0; i < ranges.size(); ++i) {
+    if (nonCompactColumns[i]) {
+      ranges[i].reset();
+    }
+  }
+  spillInputRanges_ = ranges;
+  for (auto* build : otherBuilds) {
+    build->spillInputRanges_ = ranges;
+  }
+}
+
+bool HashBuild::canShareTable() const {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  std::vector<std::string> nodeIds;
+  folly::split(',', queryConfig.sharedHashJoinNodeIds(), nodeIds);
+  if (std::find(nodeIds.begin(), nodeIds.end(), planNodeId()) ==
+      nodeIds.end()) {
+    return false;
+  }
+  // The probe side of these joins sets the probed flags in the table.
+  if (needRightSideJoin(joinType_)) {
+    return false;
+  }
+  // Split groups of different tasks have different build sides.
+  if (!operatorCtx_->task()->isUngroupedExecution()) {
+    return false;
+  }
+  return !canSpill() || queryConfig.sharedHashJoinMaxTableBytes() > 0;
+}
+
+bool HashBuild::maybeUseSharedTable() {
+  if (!shareTable_ || canSpill()) {
+    return false;
+  }
+  if (sharedTable_ != nullptr) {
+    return true;
+  }
+  sharedTable_ = HashTableCache::instance()->get(
+      operatorCtx_->task()->queryCtx()->queryId(),
+      planNodeId(),
+      sharedTableHasNullKeys_);
+  if (sharedTable_ == nullptr) {
+    return false;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  table_->clear(true);
+  return true;
+}
+
+std::shared_ptr<BaseHashTable> HashBuild::findSharedTable(
+    const std::vector<HashBuild*>& otherBuilds,
+    bool& hasNullKeys) {
+  if (sharedTable_ != nullptr) {
+    hasNullKeys = sharedTableHasNullKeys_;
+    return sharedTable_;
+  }
+  for (auto* build : otherBuilds) {
+    std::lock_guard<std::mutex> l(build->mutex_);
+    if (build->sharedTable_ != nullptr) {
+      hasNullKeys = build->sharedTableHasNullKeys_;
+      return build->sharedTable_;
+    }
+  }
+  return HashTableCache::instance()->get(
+      operatorCtx_->task()->queryCtx()->queryId(), planNodeId(), hasNullKeys);
+}
+
+void HashBuild::setSharedTable(
+    std::shared_ptr<BaseHashTable> sharedTable,
+    bool hasNullKeys,
+    const std::vector<HashBuild*>& otherBuilds) {
+  for (auto* build : otherBuilds) {
+    std::lock_guard<std::mutex> l(build->mutex_);
+    VELOX_CHECK(
+        !build->stateCleared_,
+        "Internal state for a peer is empty. It might have already"
+        " been closed.");
+    build->stateCleared_ = true;
+    build->table_.reset();
+    build->spiller_.reset();
+    build->sharedTable_.reset();
+  }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    table_.reset();
+    spiller_.reset();
+    sharedTable_.reset();
+  }
+  stats_.wlock()->addRuntimeStat(
+      BaseHashTable::kSharedTableReused, RuntimeCounter(1));
+  joinBridge_->setSharedHashTable(std::move(sharedTable), hasNullKeys);
+  if (canSpill()) {
+    stateCleared_ = true;
+  }
+}
+
+std::shared_ptr<BaseHashTable> HashBuild::publishTable(
+    const std::vector<HashBuild*>& otherBuilds,
+    bool& hasNullKeys) {
+  std::vector<std::shared_ptr<memory::MemoryPool>> pools;
+  pools.reserve(otherBuilds.size() + 1);
+  pools.push_back(pool()->shared_from_this());
+  for (auto* build : otherBuilds) {
+    pools.push_back(build->pool()->shared_from_this());
+  }
+  if (canSpill()) {
+    uint64_t tableBytes{0};
+    for (const auto& pool : pools) {
+      tableBytes += pool->usedBytes();
+    }
+    if (tableBytes >
+        operatorCtx_->driverCtx()->queryConfig().sharedHashJoinMaxTableBytes()) {
+      return nullptr;
+    }
+  }
+  // The deleter frees the table before releasing the pools of its rows.
+  std::shared_ptr<BaseHashTable> table(
+      table_.release(), [pools = std::move(pools)](BaseHashTable* table) {
+        delete table;
+      });
+  auto publishedTable = HashTableCache::instance()->put(
+      operatorCtx_->task()->queryCtx()->queryId(),
+      planNodeId(),
+      table,
+      hasNullKeys);
+  stats_.wlock()->addRuntimeStat(
+      publishedTable == table ? BaseHashTable::kSharedTablePublished
+                              : BaseHashTable::kSharedTableReused,
+      RuntimeCounter(1));
+  return publishedTable;
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -876,9 +1150,19 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
       keyChannels_.size());
 
   setupTable();
+  // The spill input reader takes the files from the partition.
+  auto spillFiles = spillInput.spillPartition->files();
   setupSpiller(spillInput.spillPartition.get());
   stateCleared_ = false;
 
+  if (sortMergeFallback_ && exceededMaxSpillLevelLimit_) {
+    // Leave the partition to the probe side to sort merge join instead of
+    // building a table which might not fit in memory.
+    sortMergeBuildFiles_ = std::move(spillFiles);
+    noMoreInputInternal();
+    return;
+  }
+
   // Start to process spill input.
   processSpillInput();
 }
@@ -1071,6 +1355,10 @@ bool HashBuild::canReclaim() const {
   return canSpill() && !exceededMaxSpillLevelLimit_;
 }
 
+uint64_t HashBuild::reclaimCostNs(uint64_t reclaimableBytes) const {
+  return 2 * Operator::reclaimCostNs(reclaimableBytes);
+}
+
 void HashBuild::reclaim(
     uint64_t /*unused*/,
     memory::MemoryReclaimer::Stats& stats) {
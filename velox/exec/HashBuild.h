@@ -81,6 +81,11 @@ class HashBuild final : public Operator {
 
   bool canReclaim() const override;
 
+  /// Reclaiming spills the build side and makes the probe side spill its input
+  /// of the spilled partitions too. Both are read back later and the hash
+  /// tables of the spilled partitions are rebuilt.
+  uint64_t reclaimCostNs(uint64_t reclaimableBytes) const override;
+
   void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
       override;
 
@@ -125,6 +130,47 @@ class HashBuild final : public Operator {
 
   bool canSpill() const override;
 
+  // Widens 'inputRanges_' to the values of the integer and timestamp
+  // dependent columns in 'activeRows_'.
+  void updateInputRanges();
+
+  // Invoked by the last build driver to set 'spillInputRanges_' of this and
+  // 'otherBuilds' to the ranges of the input of all build drivers.
+  void setSpillInputRanges(const std::vector<HashBuild*>& otherBuilds);
+
+  // Returns true if the build table of this join can be shared with the other
+  // tasks of the query on this node. See HashTableCache.
+  bool canShareTable() const;
+
+  // Returns true if another task of the query has published the build table of
+  // this join. The rows accumulated so far are then freed and the rest of the
+  // input is dropped. Only applies if spilling is disabled as the input of the
+  // peers is otherwise needed for spilling.
+  bool maybeUseSharedTable();
+
+  // Invoked by the last build driver to find a shared table taken by itself or
+  // any of 'otherBuilds' from HashTableCache, or published in HashTableCache
+  // meanwhile. Sets 'hasNullKeys' for the returned table.
+  std::shared_ptr<BaseHashTable> findSharedTable(
+      const std::vector<HashBuild*>& otherBuilds,
+      bool& hasNullKeys);
+
+  // Invoked by the last build driver to hand 'sharedTable' to the probe side
+  // instead of the table built from the input of this task.
+  void setSharedTable(
+      std::shared_ptr<BaseHashTable> sharedTable,
+      bool hasNullKeys,
+      const std::vector<HashBuild*>& otherBuilds);
+
+  // Invoked by the last build driver to publish the built 'table_' in
+  // HashTableCache. The memory pools of this and 'otherBuilds' which hold the
+  // table rows are kept alive by the published table. Returns the published
+  // table, which may be a table published meanwhile by another task, and sets
+  // 'hasNullKeys' for it. Returns null if the table is too large to share.
+  std::shared_ptr<BaseHashTable> publishTable(
+      const std::vector<HashBuild*>& otherBuilds,
+      bool& hasNullKeys);
+
   // Indicates if the input is read from spill data or not.
   bool isInputFromSpill() const;
 
@@ -221,6 +267,45 @@ class HashBuild final : public Operator {
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
+  // True if the build table of this join is shared with the other tasks of the
+  // query on this node.
+  const bool shareTable_;
+
+  // The build table published by another task. Set if the input was dropped in
+  // favor of the shared table.
+  std::shared_ptr<BaseHashTable> sharedTable_;
+
+  // True if the build side of 'sharedTable_' has null join keys.
+  bool sharedTableHasNullKeys_{false};
+
+  // True if the integer dependent columns of the tables built from spilled
+  // input are stored in the fewest bytes that fit the range of their values,
+  // and the timestamp dependent columns as microseconds in 8 bytes.
+  const bool compactSpillInputColumns_;
+
+  // Ranges of the values of the integer dependent columns of the build side
+  // input not read from spill. Corresponds 1:1 to 'dependentChannels_'.
+  std::vector<std::optional<RowContainer::ColumnRange>> inputRanges_;
+
+  // True for the timestamp dependent columns with a value of the build side
+  // input not read from spill that is not a whole number of microseconds.
+  // These are stored at full width. Corresponds 1:1 to 'dependentChannels_'.
+  std::vector<bool> nonCompactInputColumns_;
+
+  // Ranges of the values of the integer dependent columns of the input of all
+  // build drivers. The spilled input is a subset of it. Empty until all build
+  // drivers have finished their input.
+  std::vector<std::optional<RowContainer::ColumnRange>> spillInputRanges_;
+
+  // True if a restored partition which exceeds the max spill level is sort
+  // merge joined by the probe side instead of built into a table.
+  const bool sortMergeFallback_;
+
+  // The spill files of the restored partition to sort merge join. The last
+  // build driver collects them from the peers and hands them to the probe
+  // side.
+  SpillFiles sortMergeBuildFiles_;
+
   tsan_atomic<bool> exceededMaxSpillLevelLimit_{false};
 
   State state_{State::kRunning};
@@ -285,6 +370,9 @@ class HashBuild final : public Operator {
   // it has been cleared to set up a new one for recursive spilling.
   std::unique_ptr<HashBuildSpiller> spiller_;
 
+  // See SpillConfig::reservationGrowthPct().
+  uint32_t numReservationGrowths_{0};
+
   // Used to read input from previously spilled data for restoring.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
   // The spill partition id for the currently restoring partition. Not set if
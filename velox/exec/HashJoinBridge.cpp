@@ -215,9 +215,13 @@ void HashJoinBridge::setHashTable(
     std::unique_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
     bool hasNullKeys,
-    HashJoinTableSpillFunc&& tableSpillFunc) {
+    HashJoinTableSpillFunc&& tableSpillFunc,
+    SpillFiles sortMergeBuildFiles) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
   VELOX_CHECK(table->numDistinct() == 0 || spillPartitionSet.empty());
+  VELOX_CHECK(
+      sortMergeBuildFiles.empty() ||
+      (table->numDistinct() == 0 && spillPartitionSet.empty()));
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -234,6 +238,7 @@ void HashJoinBridge::setHashTable(
         std::move(restoringSpillPartitionId_),
         spillPartitionIdSet,
         hasNullKeys);
+    buildResult_->sortMergeBuildFiles = std::move(sortMergeBuildFiles);
     restoringSpillPartitionId_.reset();
     promises = std::move(promises_);
   }
@@ -257,6 +262,26 @@ void HashJoinBridge::setHashTable(
   notify(std::move(promises));
 }
 
+void HashJoinBridge::setSharedHashTable(
+    std::shared_ptr<BaseHashTable> table,
+    bool hasNullKeys) {
+  VELOX_CHECK_NOT_NULL(table, "setSharedHashTable called with null table");
+
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK(!buildResult_.has_value());
+    VELOX_CHECK(restoringSpillShards_.empty());
+    VELOX_CHECK(!restoringSpillPartitionId_.has_value());
+    buildResult_ = HashBuildResult(
+        std::move(table), std::nullopt, SpillPartitionIdSet{}, hasNullKeys);
+    buildResult_->sharedTable = true;
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
 void HashJoinBridge::appendSpilledHashTablePartitions(
     SpillPartitionSet spillPartitionSet) {
   VELOX_CHECK(
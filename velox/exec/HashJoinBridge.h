@@ -53,16 +53,27 @@ class HashJoinBridge : public JoinBridge {
   /// Invoked by the build operator to set the built hash table.
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table' which only applies if the disk spilling is enabled.
+  /// 'sortMergeBuildFiles' are the build side spill files of a restored
+  /// partition which exceeds the max spill level. If set, 'table' is empty and
+  /// the probe operators join the partition with SortMergeFallbackJoin.
   void setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
       bool hasNullKeys,
-      HashJoinTableSpillFunc&& tableSpillFunc);
+      HashJoinTableSpillFunc&& tableSpillFunc,
+      SpillFiles sortMergeBuildFiles = {});
 
   void setHashTable(
       std::shared_ptr<wave::HashTableHolder> table,
       bool hasNullKeys);
 
+  /// Invoked by the build operator to set a table shared with the same join of
+  /// the other tasks of the query on this node. The probe operators must not
+  /// modify, clear or spill it. See HashTableCache.
+  void setSharedHashTable(
+      std::shared_ptr<BaseHashTable> table,
+      bool hasNullKeys);
+
   /// Invoked by the probe operator to append the spilled hash table partitions
   /// while probing. The function appends the spilled table partitions into
   /// 'spillPartitionSets_' stack. This only applies if the disk spilling is
@@ -106,6 +117,13 @@ class HashJoinBridge : public JoinBridge {
     /// fine-grained spilling for hash table, either 'table' is empty or
     /// 'spillPartitionIds' is empty.
     SpillPartitionIdSet spillPartitionIds;
+
+    /// True if 'table' is shared with the other tasks of the query.
+    bool sharedTable{false};
+
+    /// Build side spill files of the restored partition to sort merge join
+    /// instead of probing 'table'. See setHashTable().
+    SpillFiles sortMergeBuildFiles;
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
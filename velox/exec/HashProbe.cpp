@@ -83,6 +83,83 @@ void extractColumns(
   }
 }
 
+// Loads a build side column of the hash probe output from the hash table rows
+// the output rows matched. Keeps the table alive until the column is loaded.
+class BuildColumnLoader : public VectorLoader {
+ public:
+  BuildColumnLoader(
+      std::shared_ptr<BaseHashTable> table,
+      BufferPtr tableRows,
+      column_index_t column,
+      TypePtr type,
+      memory::MemoryPool* pool)
+      : table_(std::move(table)),
+        tableRows_(std::move(tableRows)),
+        column_(column),
+        type_(std::move(type)),
+        pool_(pool) {}
+
+ private:
+  void loadInternal(
+      RowSet rows,
+      ValueHook* hook,
+      vector_size_t resultSize,
+      VectorPtr* result) override {
+    VELOX_CHECK_NULL(hook, "Build side columns do not support ValueHook");
+    const auto* tableRows = tableRows_->as<char*>();
+    std::vector<char*> selectedRows;
+    if (rows.size() < resultSize) {
+      // Only the values of 'rows' are copied. The other rows are set to null.
+      selectedRows.resize(resultSize, nullptr);
+      for (auto row : rows) {
+        selectedRows[row] = tableRows[row];
+      }
+      tableRows = selectedRows.data();
+    }
+    *result = BaseVector::create(type_, resultSize, pool_);
+    table_->extractColumn(
+        folly::Range<char* const*>(tableRows, resultSize), column_, *result);
+  }
+
+  const std::shared_ptr<BaseHashTable> table_;
+  const BufferPtr tableRows_;
+  const column_index_t column_;
+  const TypePtr type_;
+  memory::MemoryPool* const pool_;
+};
+
+// Sets the columns of 'resultVectors' according to 'projections' to lazy
+// vectors that copy the values from 'rows' of 'table' on first use.
+void makeLazyColumns(
+    const std::shared_ptr<BaseHashTable>& table,
+    folly::Range<char* const*> rows,
+    folly::Range<const IdentityProjection*> projections,
+    memory::MemoryPool* pool,
+    const std::vector<TypePtr>& resultTypes,
+    std::vector<VectorPtr>& resultVectors) {
+  if (projections.empty()) {
+    return;
+  }
+  // The row pointers are copied since the probe reuses its buffer for the next
+  // batch.
+  auto tableRows = AlignedBuffer::allocate<char*>(rows.size(), pool);
+  std::copy(rows.begin(), rows.end(), tableRows->asMutable<char*>());
+  for (auto projection : projections) {
+    const auto resultChannel = projection.outputChannel;
+    VELOX_CHECK_LT(resultChannel, resultVectors.size());
+    resultVectors[resultChannel] = std::make_shared<LazyVector>(
+        pool,
+        resultTypes[resultChannel],
+        rows.size(),
+        std::make_unique<BuildColumnLoader>(
+            table,
+            tableRows,
+            projection.inputChannel,
+            resultTypes[resultChannel],
+            pool));
+  }
+}
+
 BlockingReason fromStateToBlockingReason(ProbeOperatorState state) {
   switch (state) {
     case ProbeOperatorState::kRunning:
@@ -125,6 +202,11 @@ HashProbe::HashProbe(
       joinNode_(std::move(joinNode)),
       joinType_{joinNode_->joinType()},
       nullAware_{joinNode_->isNullAware()},
+      bloomFilterPushdownMaxSize_{
+          driverCtx->queryConfig().hashProbeBloomFilterPushdownMaxSize()},
+      lazyBuildColumns_{
+          driverCtx->queryConfig().hashProbeLazyBuildColumnsEnabled() &&
+          !joinNode_->canSpill(driverCtx->queryConfig())},
       probeType_(joinNode_->sources()[0]->outputType()),
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
@@ -402,6 +484,7 @@ void HashProbe::asyncWaitForHashTable() {
   }
 
   table_ = std::move(hashBuildResult->table);
+  sharedTable_ = hashBuildResult->sharedTable;
   initializeResultIter();
 
   VELOX_CHECK_NOT_NULL(table_);
@@ -410,6 +493,25 @@ void HashProbe::asyncWaitForHashTable() {
   maybeSetupInputSpiller(hashBuildResult->spillPartitionIds);
   checkMaxSpillLevel(hashBuildResult->restoredPartitionId);
 
+  if (!hashBuildResult->sortMergeBuildFiles.empty()) {
+    VELOX_CHECK(isSpillInput());
+    VELOX_CHECK(spillInputPartitionIds_.empty());
+    sortMergeJoin_ = std::make_unique<SortMergeFallbackJoin>(
+        std::move(hashBuildResult->sortMergeBuildFiles),
+        probeType_,
+        keyChannels_,
+        outputType_,
+        identityProjections_,
+        tableOutputProjections_,
+        pool(),
+        &nonReclaimableSection_,
+        operatorCtx_->driverCtx()->prefixSortConfig(),
+        spillConfig(),
+        &spillStats_);
+    addRuntimeStat("sortMergeJoinFallbacks", RuntimeCounter(1));
+    return;
+  }
+
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
       if (!needToSpillInput()) {
@@ -428,8 +530,9 @@ void HashProbe::asyncWaitForHashTable() {
        isRightSemiFilterJoin(joinType_) ||
        (isRightSemiProjectJoin(joinType_) && !nullAware_) ||
        isRightJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       bloomFilterPushdownMaxSize_ > 0) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
     // push down.
@@ -442,11 +545,23 @@ void HashProbe::asyncWaitForHashTable() {
     const auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
 
+    // If the exact filter from the VectorHasher is not available, e.g. the key
+    // has too many distinct values, fall back to a Bloom filter of the key
+    // values if enabled.
     for (auto i = 0; i < keyChannels_.size(); ++i) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(/*nullAllowed=*/false)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
-        }
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      std::shared_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(/*nullAllowed=*/false);
+      }
+      if (filter == nullptr && bloomFilterPushdownMaxSize_ > 0) {
+        filter = table_->bloomFilter(i, bloomFilterPushdownMaxSize_);
+        hasInexactDynamicFilters_ |= filter != nullptr;
+      }
+      if (filter != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
@@ -516,6 +631,13 @@ void HashProbe::addSpillInput() {
     return;
   }
   if (FOLLY_UNLIKELY(!spillInputReader_->nextBatch(input_))) {
+    if (sortMergeJoin_ != nullptr) {
+      // Produces the sort merge join output before finishing the partition
+      // input, see getSortMergeJoinOutput().
+      noMoreSpillInput_ = true;
+      sortMergeJoin_->noMoreProbeInput();
+      return;
+    }
     noMoreInputInternal();
     return;
   }
@@ -637,10 +759,11 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down filter when the
   // following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
       tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
-      !isRightJoin(joinType_)) {
+      !hasInexactDynamicFilters_ && !isRightJoin(joinType_)) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -668,6 +791,10 @@ void HashProbe::addInput(RowVectorPtr input) {
     VELOX_CHECK_NULL(input_);
     return;
   }
+  if (sortMergeJoin_ != nullptr) {
+    sortMergeJoin_->addProbeInput(input);
+    return;
+  }
   input_ = std::move(input);
 
   // Reset passingInputRowsInitialized_ as input_ as changed.
@@ -772,6 +899,12 @@ void HashProbe::prepareOutput(vector_size_t size) {
   // clearIdentityProjectedOutput). BaseVector::prepareForReuse keeps null
   // children unmodified and makes non-null (build side) children reusable.
   if (output_) {
+    if (lazyBuildColumns_ && output_.use_count() == 1) {
+      // Lazy build side children are replaced, not reused.
+      for (const auto& projection : tableOutputProjections_) {
+        output_->childAt(projection.outputChannel) = nullptr;
+      }
+    }
     VectorPtr output = std::move(output_);
     BaseVector::prepareForReuse(output, size);
     output_ = std::static_pointer_cast<RowVector>(output);
@@ -845,6 +978,14 @@ void HashProbe::fillOutput(vector_size_t size) {
 
   if (isLeftSemiProjectJoin(joinType_)) {
     fillLeftSemiProjectMatchColumn(size);
+  } else if (lazyBuildColumns_) {
+    makeLazyColumns(
+        table_,
+        folly::Range<char* const*>(outputTableRows_->as<char*>(), size),
+        tableOutputProjections_,
+        pool(),
+        outputType_->children(),
+        output_->children());
   } else {
     extractColumns(
         table_.get(),
@@ -1022,6 +1163,10 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
 
   clearProjectedOutput();
 
+  if (sortMergeJoin_ != nullptr) {
+    return toSpillOutput ? nullptr : getSortMergeJoinOutput();
+  }
+
   if (!input_) {
     if (hasMoreInput()) {
       return nullptr;
@@ -1065,7 +1210,7 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
           }
         } else {
           joinBridge_->probeFinished();
-          if (table_ != nullptr) {
+          if (table_ != nullptr && !sharedTable_ && !lazyBuildColumns_) {
             table_->clear(true);
           }
         }
@@ -1196,6 +1341,18 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
   }
 }
 
+RowVectorPtr HashProbe::getSortMergeJoinOutput() {
+  if (!noMoreSpillInput_) {
+    return nullptr;
+  }
+  auto output = sortMergeJoin_->getOutput(outputBatchSize_);
+  if (output == nullptr) {
+    sortMergeJoin_.reset();
+    noMoreInputInternal();
+  }
+  return output;
+}
+
 bool HashProbe::maybeReadSpillOutput() {
   maybeSetupSpillOutputReader();
 
@@ -1756,10 +1913,15 @@ void HashProbe::setRunning() {
 }
 
 bool HashProbe::nonReclaimableState() const {
+  if (sortMergeJoin_ != nullptr) {
+    // The sort merge fallback has an empty table and spills its sorted rows
+    // instead, see reclaim().
+    return state_ != ProbeOperatorState::kRunning || nonReclaimableSection_;
+  }
   return (state_ != ProbeOperatorState::kRunning &&
           state_ != ProbeOperatorState::kWaitForPeers) ||
       nonReclaimableSection_ || (inputSpiller_ != nullptr) ||
-      (table_ == nullptr) || (table_->numDistinct() == 0);
+      (table_ == nullptr) || (table_->numDistinct() == 0) || sharedTable_;
 }
 
 void HashProbe::ensureOutputFits() {
@@ -1798,7 +1960,10 @@ void HashProbe::ensureOutputFits() {
 }
 
 bool HashProbe::canReclaim() const {
-  return canSpill() && !exceededMaxSpillLevelLimit_;
+  // A partition joined by the sort merge fallback exceeds the max spill level
+  // but its sorted rows can still spill.
+  return canSpill() &&
+      (!exceededMaxSpillLevelLimit_ || sortMergeJoin_ != nullptr);
 }
 
 void HashProbe::reclaim(
@@ -1810,6 +1975,19 @@ void HashProbe::reclaim(
   VELOX_CHECK_NOT_NULL(driver);
   VELOX_CHECK(!nonReclaimableSection_);
 
+  if (sortMergeJoin_ != nullptr) {
+    if (nonReclaimableState()) {
+      RECORD_METRIC_VALUE(kMetricMemoryNonReclaimableCount);
+      ++stats.numNonReclaimableAttempts;
+      return;
+    }
+    // Each probe operator sorts its own copy of the partition, so there is no
+    // state to spill in coordination with the peers.
+    sortMergeJoin_->spill();
+    pool()->release();
+    return;
+  }
+
   if (UNLIKELY(exceededMaxSpillLevelLimit_)) {
     // 'canReclaim()' already checks the spill limit is not exceeding max, there
     // is only a small chance from the time 'canReclaim()' is checked to the
@@ -2055,6 +2233,7 @@ void HashProbe::close() {
   inputSpiller_.reset();
   table_.reset();
   spillInputReader_.reset();
+  sortMergeJoin_.reset();
   restoringPartitionId_.reset();
   spillOutputPartitionSet_.clear();
   spillOutputReader_.reset();
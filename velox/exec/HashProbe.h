@@ -20,6 +20,7 @@
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/ProbeOperatorState.h"
+#include "velox/exec/SortMergeFallbackJoin.h"
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::exec {
@@ -100,6 +101,10 @@ class HashProbe : public Operator {
     return input_ != nullptr;
   }
 
+  bool testingHasSortMergeJoin() const {
+    return sortMergeJoin_ != nullptr;
+  }
+
   std::shared_ptr<BaseHashTable> testingTable() const {
     return table_;
   }
@@ -281,6 +286,11 @@ class HashProbe : public Operator {
   // 'output_'.
   bool maybeReadSpillOutput();
 
+  // Returns the next output of 'sortMergeJoin_' once all the probe input of the
+  // restored partition has been added. Finishes the partition input after the
+  // last output.
+  RowVectorPtr getSortMergeJoinOutput();
+
   // Invoked after finishes processing the probe inputs and there is spill data
   // remaining to restore. The function will reset the internal states which
   // are relevant to the last finished probe run. The last finished probe
@@ -377,6 +387,15 @@ class HashProbe : public Operator {
 
   const bool nullAware_;
 
+  // Max size of a Bloom filter dynamic filter made from a join key. 0 if Bloom
+  // filter pushdown is disabled.
+  const uint64_t bloomFilterPushdownMaxSize_;
+
+  // True if the build side columns of the output are lazy vectors. The hash
+  // table is then not cleared when the probe finishes since the vectors keep
+  // referencing its rows.
+  const bool lazyBuildColumns_;
+
   const RowTypePtr probeType_;
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
@@ -408,6 +427,10 @@ class HashProbe : public Operator {
   // table from the previously spilled data.
   bool lastProber_{false};
 
+  // True if 'table_' is shared with the other tasks of the query. A shared
+  // table is neither cleared nor spilled by this operator.
+  bool sharedTable_{false};
+
   std::unique_ptr<HashLookup> lookup_;
 
   // Channel of probe keys in 'input_'.
@@ -419,6 +442,10 @@ class HashProbe : public Operator {
   // down to the upstream operators.
   tsan_atomic<bool> hasGeneratedDynamicFilters_{false};
 
+  // True if some of the dynamic filters are Bloom filters, which pass some
+  // values not in the build side. Such filters cannot replace the join.
+  bool hasInexactDynamicFilters_{false};
+
   // True if the join can become a no-op starting with the next batch of input.
   bool canReplaceWithDynamicFilter_{false};
 
@@ -725,6 +752,10 @@ class HashProbe : public Operator {
   // Sets to true after read all the probe inputs from 'spillInputReader_'.
   bool noMoreSpillInput_{false};
 
+  // Joins the restored partition instead of 'table_' if the build side
+  // partition exceeded the max spill level. See SortMergeFallbackJoin.
+  std::unique_ptr<SortMergeFallbackJoin> sortMergeJoin_;
+
   // The spilled probe partitions remaining to restore.
   SpillPartitionSet inputSpillPartitionSet_;
 
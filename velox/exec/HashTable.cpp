@@ -52,7 +52,9 @@ HashTable<ignoreNullKeys>::HashTable(
     bool isJoinBuild,
     bool hasProbedFlag,
     uint32_t minTableSizeForParallelJoinBuild,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    const std::vector<std::optional<RowContainer::ColumnRange>>&
+        dependentRanges)
     : BaseHashTable(std::move(hashers)),
       pool_(pool),
       minTableSizeForParallelJoinBuild_(minTableSizeForParallelJoinBuild),
@@ -75,7 +77,8 @@ HashTable<ignoreNullKeys>::HashTable(
       isJoinBuild,
       hasProbedFlag,
       hashMode_ != HashMode::kHash,
-      pool);
+      pool,
+      dependentRanges);
   nextOffset_ = rows_->nextOffset();
 }
 
@@ -99,6 +102,12 @@ class ProbeState {
     return row_;
   }
 
+  // Returns the first row whose tag matched in firstProbe(), or nullptr if
+  // there was no match in the first bucket.
+  char* firstHit() const {
+    return group_;
+  }
+
   // Use one instruction to make 16 copies of the tag being searched for
   template <typename Table>
   inline void preProbe(const Table& table, uint64_t hash, int32_t row) {
@@ -222,11 +231,14 @@ class ProbeState {
         "Have looped through all the buckets in table: {}", table.toString());
   }
 
-  template <typename Table>
+  // If 'firstHitChecked' is true, the caller has already compared the key of
+  // firstHit() and found it not to match.
+  template <bool firstHitChecked = false, typename Table>
   FOLLY_ALWAYS_INLINE char* joinNormalizedKeyFullProbe(
       const Table& table,
       const uint64_t* keys) {
-    if (group_ && RowContainer::normalizedKey(group_) == keys[row_]) {
+    if (!firstHitChecked && group_ &&
+        RowContainer::normalizedKey(group_) == keys[row_]) {
       table.incrementHits();
       return group_;
     }
@@ -590,6 +602,65 @@ void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+int32_t HashTable<ignoreNullKeys>::numRadixPartitions() const {
+  if (radixPartitionBytes_ == 0 || !isJoinBuild_ ||
+      hashMode_ == HashMode::kArray || table_ == nullptr) {
+    return 1;
+  }
+  const uint64_t partitionBytes = std::max<uint64_t>(
+      kBucketSize, bits::nextPowerOfTwo(radixPartitionBytes_));
+  const uint64_t tableBytes = sizeMask_ + 1;
+  if (tableBytes <= partitionBytes) {
+    return 1;
+  }
+  return std::min<uint64_t>(tableBytes / partitionBytes, kMaxRadixPartitions);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::sortByRadixPartition(
+    char** groups,
+    uint64_t* hashes,
+    int32_t numGroups) {
+  const auto numPartitions = numRadixPartitions();
+  std::vector<int32_t> offsets(numPartitions + 1, 0);
+  for (auto i = 0; i < numGroups; ++i) {
+    ++offsets[radixPartition(hashes[i], numPartitions) + 1];
+  }
+  for (auto i = 1; i <= numPartitions; ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  std::vector<char*> sortedGroups(numGroups);
+  raw_vector<uint64_t> sortedHashes(numGroups);
+  for (auto i = 0; i < numGroups; ++i) {
+    const auto index = offsets[radixPartition(hashes[i], numPartitions)]++;
+    sortedGroups[index] = groups[i];
+    sortedHashes[index] = hashes[i];
+  }
+  std::copy(sortedGroups.begin(), sortedGroups.end(), groups);
+  std::copy(sortedHashes.begin(), sortedHashes.end(), hashes);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::partitionProbeRows(
+    HashLookup& lookup,
+    int32_t numPartitions) const {
+  auto& offsets = lookup.partitionOffsets;
+  offsets.assign(numPartitions + 1, 0);
+  const auto* hashes = lookup.hashes.data();
+  for (auto row : lookup.rows) {
+    ++offsets[radixPartition(hashes[row], numPartitions) + 1];
+  }
+  for (auto i = 1; i <= numPartitions; ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  lookup.partitionedRows.resize(lookup.rows.size());
+  for (auto row : lookup.rows) {
+    lookup.partitionedRows
+        [offsets[radixPartition(hashes[row], numPartitions)]++] = row;
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   incrementProbes(lookup.rows.size());
@@ -599,6 +670,26 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
+  }
+
+  // On a radix partitioned table, probe the rows grouped by table partition so
+  // that consecutive probes hit the same cache-resident part of the table. The
+  // hits are indexed by row number so the probe order does not affect the
+  // result.
+  const auto numPartitions = numRadixPartitions();
+  const bool partitioned =
+      numPartitions > 1 && lookup.rows.size() >= numPartitions;
+  if (partitioned) {
+    partitionProbeRows(lookup, numPartitions);
+    std::swap(lookup.rows, lookup.partitionedRows);
+  }
+  auto restoreRows = folly::makeGuard([&]() {
+    if (partitioned) {
+      std::swap(lookup.rows, lookup.partitionedRows);
+    }
+  });
+
+  if (hashMode_ == HashMode::kNormalizedKey) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
@@ -679,6 +770,82 @@ void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
+  if (!batchedNormalizedKeyProbe_) {
+    joinNormalizedKeyProbeByRow(lookup);
+    return;
+  }
+  int32_t probeIndex = 0;
+  const int32_t numProbes = lookup.rows.size();
+  const vector_size_t* rows = lookup.rows.data();
+  // Two batches of states: the buckets of the next batch are prefetched while
+  // the keys of the current batch are compared.
+  ProbeState states[2][kPrefetchSize];
+  const uint64_t* keys = lookup.normalizedKeys.data();
+  const uint64_t* hashes = lookup.hashes.data();
+  char** hits = lookup.hits.data();
+  constexpr int32_t kKeyOffset =
+      -static_cast<int32_t>(sizeof(normalized_key_t));
+  constexpr int32_t kKeyBatchSize = xsimd::batch<uint64_t>::size;
+  static_assert(kPrefetchSize % kKeyBatchSize == 0);
+  static_assert(kPrefetchSize <= 64);
+  auto preProbeBatch = [&](ProbeState* batch, int32_t start) {
+    for (int32_t i = 0; i < kPrefetchSize; ++i) {
+      const int32_t row = rows[start + i];
+      batch[i].preProbe(*this, hashes[row], row);
+    }
+  };
+  if (numProbes >= kPrefetchSize) {
+    preProbeBatch(states[0], 0);
+  }
+  for (int32_t batchIndex = 0; probeIndex + kPrefetchSize <= numProbes;
+       probeIndex += kPrefetchSize, ++batchIndex) {
+    auto* batch = states[batchIndex & 1];
+    for (int32_t i = 0; i < kPrefetchSize; ++i) {
+      batch[i].firstProbe(*this, kKeyOffset);
+    }
+    if (probeIndex + 2 * kPrefetchSize <= numProbes) {
+      preProbeBatch(states[(batchIndex + 1) & 1], probeIndex + kPrefetchSize);
+    }
+    // Gather the probe key and the key of the first tag match of each state,
+    // then compare them a SIMD width at a time. Most probes are resolved by
+    // the first tag match.
+    alignas(xsimd::default_arch::alignment()) uint64_t
+        probeKeys[kPrefetchSize];
+    alignas(xsimd::default_arch::alignment()) uint64_t
+        candidateKeys[kPrefetchSize];
+    for (int32_t i = 0; i < kPrefetchSize; ++i) {
+      probeKeys[i] = keys[batch[i].row()];
+      char* candidate = batch[i].firstHit();
+      // A missing candidate gets a key that cannot match.
+      candidateKeys[i] = candidate ? RowContainer::normalizedKey(candidate)
+                                   : ~probeKeys[i];
+    }
+    uint64_t matches = 0;
+    for (int32_t i = 0; i < kPrefetchSize; i += kKeyBatchSize) {
+      const auto probe = xsimd::load_aligned(probeKeys + i);
+      const auto candidate = xsimd::load_aligned(candidateKeys + i);
+      matches |= static_cast<uint64_t>(simd::toBitMask(probe == candidate))
+          << i;
+    }
+    incrementHits(__builtin_popcountll(matches));
+    for (int32_t i = 0; i < kPrefetchSize; ++i) {
+      auto& state = batch[i];
+      hits[state.row()] = (matches >> i) & 1
+          ? state.firstHit()
+          : state.joinNormalizedKeyFullProbe<true>(*this, keys);
+    }
+  }
+  for (; probeIndex < numProbes; ++probeIndex) {
+    int32_t row = rows[probeIndex];
+    states[0][0].preProbe(*this, lookup.hashes[row], row);
+    states[0][0].firstProbe(*this, kKeyOffset);
+    hits[row] = states[0][0].joinNormalizedKeyFullProbe(*this, keys);
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::joinNormalizedKeyProbeByRow(
+    HashLookup& lookup) {
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
@@ -703,7 +870,7 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
     states[0].preProbe(*this, lookup.hashes[row], row);
-    states[0].firstProbe(*this, 0);
+    states[0].firstProbe(*this, kKeyOffset);
     hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys);
   }
 }
@@ -1274,6 +1441,9 @@ void HashTable<ignoreNullKeys>::insertForJoin(
     }
     return;
   }
+  if (partitionInfo == nullptr && numRadixPartitions() > 1) {
+    sortByRadixPartition(groups, hashes, numGroups);
+  }
   if (hashMode_ == HashMode::kNormalizedKey) {
     insertForJoinWithPrefetch<true>(groups, hashes, numGroups, partitionInfo);
   } else {
@@ -1287,13 +1457,19 @@ void HashTable<ignoreNullKeys>::rehash(
     int8_t spillInputStartPartitionBit) {
   ++numRehashes_;
   constexpr int32_t kHashBatchSize = 1024;
+  // Rows per insert batch for a radix partitioned join table. This is large
+  // enough for each batch to have a run of rows for every partition.
+  constexpr int32_t kRadixHashBatchSize = 64 * kMaxRadixPartitions;
   if (canApplyParallelJoinBuild()) {
     parallelJoinBuild();
     return;
   }
+  const int32_t batchSize =
+      numRadixPartitions() > 1 ? kRadixHashBatchSize : kHashBatchSize;
   raw_vector<uint64_t> hashes;
-  hashes.resize(kHashBatchSize);
-  char* groups[kHashBatchSize];
+  hashes.resize(batchSize);
+  std::vector<char*> groupsHolder(batchSize);
+  char** groups = groupsHolder.data();
   // A join build can have multiple payload tables. Loop over 'this'
   // and the possible other tables and put all the data in the table
   // of 'this'.
@@ -1303,7 +1479,7 @@ void HashTable<ignoreNullKeys>::rehash(
     do {
       numGroups = (i == 0 ? this : otherTables_[i - 1].get())
                       ->rows()
-                      ->listRows(&iterator, kHashBatchSize, groups);
+                      ->listRows(&iterator, batchSize, groups);
       if (!insertBatch(
               groups, numGroups, hashes, initNormalizedKeys || i != 0)) {
         VELOX_CHECK_NE(hashMode_, HashMode::kHash);
@@ -1576,6 +1752,105 @@ void HashTable<ignoreNullKeys>::checkHashBitsOverlap(
   }
 }
 
+namespace {
+// Adds the non-null values of 'keys' to 'bloomFilter' and widens ['min', 'max']
+// to cover them.
+template <TypeKind Kind>
+void addBloomFilterValues(
+    const BaseVector& keys,
+    BloomFilter<>& bloomFilter,
+    int64_t& min,
+    int64_t& max) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto* flatKeys = keys.asUnchecked<FlatVector<T>>();
+  for (auto i = 0; i < keys.size(); ++i) {
+    if (flatKeys->isNullAt(i)) {
+      continue;
+    }
+    const int64_t value = flatKeys->valueAt(i);
+    bloomFilter.insert(common::BigintValuesUsingBloomFilter::hashValue(value));
+    min = std::min(min, value);
+    max = std::max(max, value);
+  }
+}
+} // namespace
+
+template <bool ignoreNullKeys>
+std::shared_ptr<common::Filter> HashTable<ignoreNullKeys>::bloomFilter(
+    int32_t keyIndex,
+    uint64_t maxBytes) {
+  VELOX_CHECK_LT(keyIndex, hashers_.size());
+  VELOX_CHECK(isJoinBuild_);
+  std::lock_guard<std::mutex> l(bloomFilterMutex_);
+  auto it = bloomFilters_.find(keyIndex);
+  if (it != bloomFilters_.end()) {
+    return it->second;
+  }
+  auto& filter = bloomFilters_[keyIndex];
+  const auto& keyType = hashers_[keyIndex]->type();
+  switch (keyType->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      break;
+    default:
+      return nullptr;
+  }
+  uint64_t numRows{0};
+  for (const auto* rowContainer : allRows()) {
+    numRows += rowContainer->numRows();
+  }
+  // BloomFilter::reset() allocates 2 bytes per expected value, rounded up to a
+  // power of two.
+  if (numRows == 0 || numRows > std::numeric_limits<int32_t>::max() ||
+      std::max<uint64_t>(32, bits::nextPowerOfTwo(numRows) * 2) > maxBytes) {
+    return nullptr;
+  }
+
+  auto bloom = std::make_shared<BloomFilter<>>();
+  bloom->reset(numRows);
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  constexpr int32_t kBatchSize = 1024;
+  std::vector<char*> rows(kBatchSize);
+  VectorPtr keys = BaseVector::create(keyType, kBatchSize, pool_);
+  for (auto* rowContainer : allRows()) {
+    RowContainerIterator iter;
+    while (const auto numListed =
+               rowContainer->listRows(&iter, kBatchSize, rows.data())) {
+      keys->resize(numListed);
+      RowContainer::extractColumn(
+          rows.data(),
+          numListed,
+          rows_->columnAt(keyIndex),
+          columnHasNulls_[keyIndex],
+          keys);
+      switch (keyType->kind()) {
+        case TypeKind::TINYINT:
+          addBloomFilterValues<TypeKind::TINYINT>(*keys, *bloom, min, max);
+          break;
+        case TypeKind::SMALLINT:
+          addBloomFilterValues<TypeKind::SMALLINT>(*keys, *bloom, min, max);
+          break;
+        case TypeKind::INTEGER:
+          addBloomFilterValues<TypeKind::INTEGER>(*keys, *bloom, min, max);
+          break;
+        default:
+          addBloomFilterValues<TypeKind::BIGINT>(*keys, *bloom, min, max);
+          break;
+      }
+    }
+  }
+  if (min > max) {
+    // All keys are null.
+    return nullptr;
+  }
+  filter = std::make_shared<common::BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloom), /*nullAllowed=*/false);
+  return filter;
+}
+
 template <bool ignoreNullKeys>
 std::string HashTable<ignoreNullKeys>::toString() {
   std::stringstream out;
@@ -2119,8 +2394,8 @@ void populateLookupRows(
   if (rows.isAllSelected()) {
     std::iota(lookupRows.begin(), lookupRows.end(), 0);
   } else {
-    lookupRows.clear();
-    rows.applyToSelected([&](auto row) { lookupRows.push_back(row); });
+    lookupRows.resize(rows.end());
+    lookupRows.resize(rows.selectedRows(lookupRows.data()));
   }
 }
 } // namespace
@@ -2155,6 +2430,11 @@ void HashTable<ignoreNullKeys>::prepareForGroupProbe(
 
   bool rehash = false;
   const auto mode = hashMode();
+  if (mode == BaseHashTable::HashMode::kHash &&
+      VectorHasher::hashFused(hashers, rows, lookup.hashes)) {
+    populateLookupRows(rows, lookup.rows);
+    return;
+  }
   for (auto i = 0; i < hashers.size(); ++i) {
     auto& hasher = hashers[i];
     if (mode != BaseHashTable::HashMode::kHash) {
@@ -2200,6 +2480,11 @@ void HashTable<ignoreNullKeys>::prepareForJoinProbe(
   lookup.reset(rows.end());
 
   const auto mode = hashMode();
+  if (mode == BaseHashTable::HashMode::kHash &&
+      VectorHasher::hashFused(hashers, rows, lookup.hashes)) {
+    populateLookupRows(rows, lookup.rows);
+    return;
+  }
   for (auto i = 0; i < hashers.size(); ++i) {
     auto& hasher = hashers[i];
     if (mode != BaseHashTable::HashMode::kHash) {
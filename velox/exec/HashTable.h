@@ -63,7 +63,8 @@ struct HashLookup {
         rows(raw_vector<vector_size_t>(pool)),
         hashes(raw_vector<uint64_t>(pool)),
         hits(raw_vector<char*>(pool)),
-        normalizedKeys(raw_vector<uint64_t>(pool)) {}
+        normalizedKeys(raw_vector<uint64_t>(pool)),
+        partitionedRows(raw_vector<vector_size_t>(pool)) {}
 
   void reset(vector_size_t size) {
     rows.resize(size);
@@ -102,6 +103,13 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// Scratch memory for joinProbe on a radix partitioned table. Holds 'rows'
+  /// reordered so that the rows probing the same table partition are adjacent.
+  raw_vector<vector_size_t> partitionedRows;
+
+  /// Scratch memory for the per partition row counts of 'partitionedRows'.
+  std::vector<int32_t> partitionOffsets;
 };
 
 struct HashTableStats {
@@ -152,6 +160,10 @@ class BaseHashTable {
       "hashtable.parallelJoinBuildWallNanos"};
   static inline const std::string kParallelJoinBuildCpuNanos{
       "hashtable.parallelJoinBuildCpuNanos"};
+  static inline const std::string kSharedTablePublished{
+      "hashtable.sharedTablePublished"};
+  static inline const std::string kSharedTableReused{
+      "hashtable.sharedTableReused"};
 
   /// Returns the string of the given 'mode'.
   static std::string modeString(HashMode mode);
@@ -345,6 +357,18 @@ class BaseHashTable {
   /// VectorHashers of 'this'.
   virtual HashMode hashMode() const = 0;
 
+  /// Sets the target size in bytes of a cache-resident partition of a join
+  /// table. If non-zero and the table is larger than this, the build inserts
+  /// and the probes are grouped by table partition so that each group works on
+  /// a cache-resident part of the table. Must be set before prepareJoinTable().
+  void setRadixPartitionBytes(uint64_t bytes) {
+    radixPartitionBytes_ = bytes;
+  }
+
+  uint64_t radixPartitionBytes() const {
+    return radixPartitionBytes_;
+  }
+
   /// Disables use of array or normalized key hash modes.
   void forceGenericHashMode(int8_t spillInputStartPartitionBit) {
     setHashMode(HashMode::kHash, 0, spillInputStartPartitionBit);
@@ -375,6 +399,15 @@ class BaseHashTable {
   /// Returns a brief description for use in debugging.
   virtual std::string toString() = 0;
 
+  /// Returns a dynamic filter passing the values of the integer join key at
+  /// 'keyIndex' of a join table, implemented as a Bloom filter. Returns nullptr
+  /// if the key is not an integer, the table is empty or the Bloom filter would
+  /// be larger than 'maxBytes'. The filter is made on first call and then
+  /// shared by all callers. Must be called after prepareJoinTable().
+  virtual std::shared_ptr<common::Filter> bloomFilter(
+      int32_t keyIndex,
+      uint64_t maxBytes) = 0;
+
   const std::vector<std::unique_ptr<VectorHasher>>& hashers() const {
     return hashers_;
   }
@@ -449,6 +482,10 @@ class BaseHashTable {
   std::unique_ptr<RowContainer> rows_;
 
   ParallelJoinBuildStats parallelJoinBuildStats_;
+
+  // Target byte size of a radix partition of a join table. 0 if the table is
+  // not radix partitioned.
+  uint64_t radixPartitionBytes_{0};
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -482,32 +519,41 @@ class HashTable : public BaseHashTable {
       bool isJoinBuild,
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      const std::vector<std::optional<RowContainer::ColumnRange>>&
+          dependentRanges = {});
 
   ~HashTable() override = default;
 
+  /// 'hasProbedFlag' reserves a flag in each group row, e.g. for tracking
+  /// recently used groups.
   static std::unique_ptr<HashTable> createForAggregation(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      bool hasProbedFlag = false) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         accumulators,
         std::vector<TypePtr>{},
         false, // allowDuplicates
         false, // isJoinBuild
-        false, // hasProbedFlag
+        hasProbedFlag,
         0, // minTableSizeForParallelJoinBuild
         pool);
   }
 
+  /// 'dependentRanges' is either empty or gives the ranges of the values of
+  /// the integer and timestamp dependent columns. See RowContainer.
   static std::unique_ptr<HashTable> createForJoin(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<TypePtr>& dependentTypes,
       bool allowDuplicates,
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      const std::vector<std::optional<RowContainer::ColumnRange>>&
+          dependentRanges = {}) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         std::vector<Accumulator>{},
@@ -516,7 +562,8 @@ class HashTable : public BaseHashTable {
         true, // isJoinBuild
         hasProbedFlag,
         minTableSizeForParallelJoinBuild,
-        pool);
+        pool,
+        dependentRanges);
   }
 
   void groupProbe(HashLookup& lookup, int8_t spillInputStartPartitionBit)
@@ -647,6 +694,10 @@ class HashTable : public BaseHashTable {
 
   std::string toString() override;
 
+  std::shared_ptr<common::Filter> bloomFilter(
+      int32_t keyIndex,
+      uint64_t maxBytes) override;
+
   /// Returns the details of the range of buckets. The range starts from
   /// zero-based 'startBucket' and contains 'numBuckets' or however many there
   /// are left till the end of the table.
@@ -665,11 +716,12 @@ class HashTable : public BaseHashTable {
       folly::Range<char* const*> rows,
       int32_t columnIndex,
       const VectorPtr& result) override {
-    RowContainer::extractColumn(
+    rows_->extractColumn(
         rows.data(),
         rows.size(),
-        rows_->columnAt(columnIndex),
-        columnHasNulls_[columnIndex],
+        columnIndex,
+        static_cast<bool>(columnHasNulls_[columnIndex]),
+        0,
         result);
   }
 
@@ -685,6 +737,17 @@ class HashTable : public BaseHashTable {
     return table_;
   }
 
+  int32_t testingNumRadixPartitions() const {
+    return numRadixPartitions();
+  }
+
+  /// Selects between the batched join probe for kNormalizedKey mode, which
+  /// compares the first candidate keys of a batch of probes with SIMD, and the
+  /// row at a time probe. Used for comparing the two in benchmarks.
+  void testingSetBatchedNormalizedKeyProbe(bool batched) {
+    batchedNormalizedKeyProbe_ = batched;
+  }
+
  private:
   // Enables debug stats for collisions for debug build.
 #ifdef NDEBUG
@@ -917,6 +980,9 @@ class HashTable : public BaseHashTable {
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Row at a time variant of joinNormalizedKeyProbe.
+  void joinNormalizedKeyProbeByRow(HashLookup& lookup);
+
   // Returns the total size of the variable size 'columns' in 'row'.
   // NOTE: No checks are done in the method for performance considerations.
   // Caller needs to make sure only variable size columns are inside of
@@ -952,6 +1018,29 @@ class HashTable : public BaseHashTable {
       int32_t numGroups,
       TableInsertPartitionInfo* partitionInfo);
 
+  // The max number of radix partitions of a join table.
+  static constexpr int32_t kMaxRadixPartitions = 1024;
+
+  // Returns the number of radix partitions the table is divided into for join
+  // build and probe, 1 if the table is not radix partitioned. The partitions
+  // are equal, power of two sized ranges of bucket offsets of at least
+  // 'radixPartitionBytes_' each.
+  int32_t numRadixPartitions() const;
+
+  // Returns the radix partition of 'hash'. 'numPartitions' is the result of
+  // numRadixPartitions().
+  int32_t radixPartition(uint64_t hash, int32_t numPartitions) const {
+    return bucketOffset(hash) >> (sizeBits_ - __builtin_ctz(numPartitions));
+  }
+
+  // Reorders 'groups' and 'hashes' so that the rows inserting into the same
+  // radix partition are adjacent.
+  void sortByRadixPartition(char** groups, uint64_t* hashes, int32_t numGroups);
+
+  // Fills 'lookup.partitionedRows' with 'lookup.rows' reordered so that the
+  // rows probing the same radix partition are adjacent.
+  void partitionProbeRows(HashLookup& lookup, int32_t numPartitions) const;
+
   // Updates 'hashers_' to correspond to the keys in the
   // content. Returns true if all hashers offer a mapping to value ids
   // for array or normalized key.
@@ -1021,6 +1110,12 @@ class HashTable : public BaseHashTable {
     }
   }
 
+  void incrementHits(int64_t count) const {
+    if (kTrackLoads) {
+      numHits_ += count;
+    }
+  }
+
   // We don't want any overlap in the bit ranges used by bucket index and those
   // used by spill partitioning; otherwise because we receive data from only one
   // partition, the overlapped bits would be the same and only a fraction of the
@@ -1030,6 +1125,10 @@ class HashTable : public BaseHashTable {
 
   memory::MemoryPool* const pool_;
 
+  // If false, joinNormalizedKeyProbe() probes a row at a time instead of
+  // comparing the first candidate keys of a batch of probes with SIMD.
+  bool batchedNormalizedKeyProbe_{true};
+
   // The min table size in row to trigger parallel join table build.
   const uint32_t minTableSizeForParallelJoinBuild_;
 
@@ -1101,6 +1200,13 @@ class HashTable : public BaseHashTable {
   // If true, avoids using VectorHasher value ranges with kArray hash mode.
   bool disableRangeArrayHash_{false};
 
+  // Serializes the making of 'bloomFilters_' by concurrent probes.
+  std::mutex bloomFilterMutex_;
+
+  // Bloom filter dynamic filters made by bloomFilter(), keyed on join key
+  // index. An entry is nullptr if no filter could be made for the key.
+  folly::F14FastMap<int32_t, std::shared_ptr<common::Filter>> bloomFilters_;
+
   friend class ProbeState;
   friend test::HashTableTestHelper<ignoreNullKeys>;
 };
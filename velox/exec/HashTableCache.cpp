@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/HashTableCache.h"
+
+namespace facebook::velox::exec {
+
+// static
+HashTableCache* HashTableCache::instance() {
+  static HashTableCache cache;
+  return &cache;
+}
+
+std::shared_ptr<BaseHashTable> HashTableCache::get(
+    const std::string& queryId,
+    const core::PlanNodeId& planNodeId,
+    bool& hasNullKeys) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(Key{queryId, planNodeId});
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  auto table = it->second.table.lock();
+  if (table == nullptr) {
+    entries_.erase(it);
+    return nullptr;
+  }
+  hasNullKeys = it->second.hasNullKeys;
+  return table;
+}
+
+std::shared_ptr<BaseHashTable> HashTableCache::put(
+    const std::string& queryId,
+    const core::PlanNodeId& planNodeId,
+    std::shared_ptr<BaseHashTable> table,
+    bool& hasNullKeys) {
+  VELOX_CHECK_NOT_NULL(table);
+  std::lock_guard<std::mutex> l(mutex_);
+  removeExpiredLocked();
+  auto& entry = entries_[Key{queryId, planNodeId}];
+  if (auto published = entry.table.lock()) {
+    hasNullKeys = entry.hasNullKeys;
+    return published;
+  }
+  entry.table = table;
+  entry.hasNullKeys = hasNullKeys;
+  return table;
+}
+
+size_t HashTableCache::testingNumTables() {
+  std::lock_guard<std::mutex> l(mutex_);
+  removeExpiredLocked();
+  return entries_.size();
+}
+
+void HashTableCache::removeExpiredLocked() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.table.expired()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+} // namespace facebook::velox::exec
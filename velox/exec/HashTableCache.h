@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::exec {
+
+/// Node-level registry of the hash join build tables shared by the tasks of a
+/// query. Used for the joins whose build sides are broadcast, so that all the
+/// tasks of a stage on a node probe one table instead of each building an
+/// identical one. The cache holds the tables by weak reference: a table lives
+/// as long as the hash join bridges and probes of any of the tasks use it.
+class HashTableCache {
+ public:
+  static HashTableCache* instance();
+
+  /// Returns the table published for 'planNodeId' of query 'queryId' and sets
+  /// 'hasNullKeys' to whether its build side has null join keys. Returns null
+  /// if no table is published or the published table is not used anymore.
+  std::shared_ptr<BaseHashTable> get(
+      const std::string& queryId,
+      const core::PlanNodeId& planNodeId,
+      bool& hasNullKeys);
+
+  /// Publishes 'table' for 'planNodeId' of query 'queryId' if there is no live
+  /// table published for it yet. Returns the published table, which is the one
+  /// from an earlier call if there is one, and sets 'hasNullKeys' for it.
+  std::shared_ptr<BaseHashTable> put(
+      const std::string& queryId,
+      const core::PlanNodeId& planNodeId,
+      std::shared_ptr<BaseHashTable> table,
+      bool& hasNullKeys);
+
+  /// Returns the number of live published tables.
+  size_t testingNumTables();
+
+ private:
+  using Key = std::pair<std::string, core::PlanNodeId>;
+
+  struct Entry {
+    std::weak_ptr<BaseHashTable> table;
+    bool hasNullKeys{false};
+  };
+
+  // Removes the entries whose tables are no longer used.
+  void removeExpiredLocked();
+
+  std::mutex mutex_;
+  folly::F14FastMap<Key, Entry> entries_;
+};
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/InProcessExchangeSource.h"
+
+#include "velox/exec/OutputBufferManager.h"
+
+namespace facebook::velox::exec {
+
+InProcessExchangeSource::InProcessExchangeSource(
+    const std::string& remoteTaskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool)
+    : ExchangeSource(remoteTaskId, destination, std::move(queue), pool),
+      bufferManager_(OutputBufferManager::getInstanceRef()) {
+  VELOX_CHECK_NOT_NULL(bufferManager_, "invalid OutputBufferManager");
+}
+
+// static
+std::shared_ptr<ExchangeSource> InProcessExchangeSource::create(
+    const std::string& remoteTaskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  const auto& bufferManager = OutputBufferManager::getInstanceRef();
+  if (bufferManager == nullptr ||
+      bufferManager->getBufferIfExists(remoteTaskId) == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<InProcessExchangeSource>(
+      remoteTaskId, destination, std::move(queue), pool);
+}
+
+// static
+void InProcessExchangeSource::registerFactory() {
+  auto& factories = ExchangeSource::factories();
+  factories.insert(factories.begin(), InProcessExchangeSource::create);
+}
+
+bool InProcessExchangeSource::shouldRequestLocked() {
+  if (atEnd_) {
+    return false;
+  }
+  return !requestPending_.exchange(true);
+}
+
+folly::SemiFuture<ExchangeSource::Response> InProcessExchangeSource::request(
+    uint32_t maxBytes,
+    std::chrono::microseconds /*maxWait*/) {
+  VELOX_CHECK(requestPending_);
+  auto promise = VeloxPromise<Response>("InProcessExchangeSource::request");
+  auto future = promise.getSemiFuture();
+  int64_t requestedSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    promise_ = std::move(promise);
+    requestedSequence = sequence_;
+  }
+
+  // The callback may outlive 'this', hence holds a reference to it.
+  auto self =
+      std::static_pointer_cast<InProcessExchangeSource>(shared_from_this());
+  const auto found = bufferManager_->getData(
+      remoteTaskId_,
+      destination_,
+      maxBytes,
+      requestedSequence,
+      [self, requestedSequence](
+          std::vector<std::unique_ptr<folly::IOBuf>> data,
+          int64_t sequence,
+          std::vector<int64_t> remainingBytes) {
+        self->processData(
+            std::move(data),
+            sequence,
+            requestedSequence,
+            std::move(remainingBytes));
+      });
+  if (!found) {
+    queue_->setError(
+        fmt::format("Output buffer of task {} not found", remoteTaskId_));
+    completeRequest();
+  }
+  return future;
+}
+
+folly::SemiFuture<ExchangeSource::Response>
+InProcessExchangeSource::requestDataSizes(std::chrono::microseconds maxWait) {
+  return request(0, maxWait);
+}
+
+void InProcessExchangeSource::processData(
+    std::vector<std::unique_ptr<folly::IOBuf>> data,
+    int64_t sequence,
+    int64_t requestedSequence,
+    std::vector<int64_t> remainingBytes) {
+  if (requestedSequence > sequence && !data.empty()) {
+    // Drops the pages before 'requestedSequence' which were already received.
+    const int64_t numExtra = requestedSequence - sequence;
+    VELOX_CHECK_LT(numExtra, data.size());
+    data.erase(data.begin(), data.begin() + numExtra);
+    sequence = requestedSequence;
+  }
+
+  std::vector<std::unique_ptr<SerializedPage>> pages;
+  pages.reserve(data.size());
+  bool atEnd{false};
+  int64_t totalBytes{0};
+  for (auto& buffer : data) {
+    if (buffer == nullptr) {
+      atEnd = true;
+      // There could be more end markers.
+      continue;
+    }
+    totalBytes += buffer->computeChainDataLength();
+    // The IOBufs share the memory of the pages in the output buffer.
+    pages.push_back(std::make_unique<SerializedPage>(std::move(buffer)));
+  }
+  numPages_ += pages.size();
+  totalBytes_ += totalBytes;
+
+  VeloxPromise<Response> requestPromise;
+  std::vector<ContinuePromise> queuePromises;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    requestPending_ = false;
+    requestPromise = std::move(promise_);
+    for (auto& page : pages) {
+      queue_->enqueueLocked(std::move(page), queuePromises);
+    }
+    if (atEnd) {
+      queue_->enqueueLocked(nullptr, queuePromises);
+      atEnd_ = true;
+    }
+    if (!data.empty()) {
+      sequence_ = sequence + pages.size();
+    }
+  }
+  for (auto& promise : queuePromises) {
+    promise.setValue();
+  }
+
+  if (atEnd) {
+    bufferManager_->deleteResults(remoteTaskId_, destination_);
+  }
+  if (requestPromise.valid() && !requestPromise.isFulfilled()) {
+    requestPromise.setValue(
+        Response{totalBytes, atEnd, std::move(remainingBytes)});
+  }
+}
+
+void InProcessExchangeSource::pause() {
+  int64_t ackSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    ackSequence = sequence_;
+  }
+  bufferManager_->acknowledge(remoteTaskId_, destination_, ackSequence);
+}
+
+void InProcessExchangeSource::close() {
+  completeRequest();
+  bufferManager_->deleteResults(remoteTaskId_, destination_);
+}
+
+void InProcessExchangeSource::completeRequest() {
+  VeloxPromise<Response> promise;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    requestPending_ = false;
+    promise = std::move(promise_);
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{0, false, {}});
+  }
+}
+
+folly::F14FastMap<std::string, RuntimeMetric>
+InProcessExchangeSource::metrics() const {
+  return {
+      {kNumPages, RuntimeMetric(numPages_)},
+      {kTotalBytes, RuntimeMetric(totalBytes_, RuntimeCounter::Unit::kBytes)},
+  };
+}
+} // namespace facebook::velox::exec
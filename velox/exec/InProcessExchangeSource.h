@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+
+namespace facebook::velox::exec {
+
+class OutputBufferManager;
+
+/// Fetches the pages of a producer task running in the same process directly
+/// from its output buffer in OutputBufferManager. The pages are handed over
+/// by reference: the consumer gets the IOBufs of the serialized pages of the
+/// producer without copying them and without a network round trip. The
+/// memory of a page stays with the producer until the consumer deserializes
+/// it.
+///
+/// A request waits for data in the output buffer until there is data or the
+/// producer is at end. It does not time out: the producer runs in the same
+/// process, so if it fails, the query fails.
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  InProcessExchangeSource(
+      const std::string& remoteTaskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  /// Returns a source for 'remoteTaskId' if it has an output buffer in
+  /// OutputBufferManager, i.e. the producer task runs in this process and was
+  /// started. Returns nullptr otherwise to fall back to the next factory.
+  static std::shared_ptr<ExchangeSource> create(
+      const std::string& remoteTaskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  /// Registers create() ahead of the registered factories so that the tasks
+  /// in this process are read in-process and the other tasks by the remote
+  /// sources.
+  static void registerFactory();
+
+  bool supportsMetrics() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override;
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override;
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override;
+
+  void pause() override;
+
+  void close() override;
+
+  folly::F14FastMap<std::string, RuntimeMetric> metrics() const override;
+
+  static inline const std::string kNumPages{"inProcessExchangeSource.numPages"};
+  static inline const std::string kTotalBytes{
+      "inProcessExchangeSource.totalBytes"};
+
+ private:
+  // Enqueues the pages returned by OutputBufferManager::getData() for
+  // 'requestedSequence' and completes the pending request.
+  void processData(
+      std::vector<std::unique_ptr<folly::IOBuf>> data,
+      int64_t sequence,
+      int64_t requestedSequence,
+      std::vector<int64_t> remainingBytes);
+
+  // Completes the pending request with an empty response if not completed.
+  void completeRequest();
+
+  const std::shared_ptr<OutputBufferManager> bufferManager_;
+
+  std::atomic_int64_t numPages_{0};
+  std::atomic_int64_t totalBytes_{0};
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+};
+} // namespace facebook::velox::exec
@@ -37,6 +37,39 @@ Limit::Limit(
   }
 }
 
+void Limit::initialize() {
+  Operator::initialize();
+  rowLimitTarget_ = operatorCtx_->driver()->rowLimitTarget(this);
+  pushdownRowLimit(0);
+}
+
+void Limit::pushdownRowLimit(vector_size_t numPendingRows) {
+  if (rowLimitTarget_ == nullptr) {
+    return;
+  }
+  int64_t numRows = remainingOffset_ + remainingLimit_ - numPendingRows;
+  if (numRows <= 0) {
+    return;
+  }
+  // The operators between the source and 'this' are filters, see
+  // Driver::rowLimitTarget(). Scale the rows needed by their observed
+  // selectivity and leave the source uncapped until it is known.
+  if (operatorId() > 1) {
+    const auto numInputRows = stats().rlock()->inputPositions;
+    if (numInputRows == 0) {
+      return;
+    }
+    const auto numSourceRows =
+        rowLimitTarget_->stats().rlock()->outputPositions;
+    // Clamp to avoid overflow. Any cap above one read batch is the same to
+    // the source.
+    numRows = std::min<double>(
+        std::ceil(1.0 * numRows * numSourceRows / numInputRows),
+        std::numeric_limits<int32_t>::max());
+  }
+  rowLimitTarget_->addRowLimit(numRows);
+}
+
 bool Limit::needsInput() const {
   return !finished_ && input_ == nullptr;
 }
@@ -44,6 +77,7 @@ bool Limit::needsInput() const {
 void Limit::addInput(RowVectorPtr input) {
   VELOX_CHECK_NULL(input_);
   input_ = input;
+  pushdownRowLimit(input_->size());
 }
 
 RowVectorPtr Limit::getOutput() {
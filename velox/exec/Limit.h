@@ -24,6 +24,8 @@ class Limit : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::LimitNode>& limitNode);
 
+  void initialize() override;
+
   bool needsInput() const override;
 
   void addInput(RowVectorPtr input) override;
@@ -39,8 +41,16 @@ class Limit : public Operator {
   }
 
  private:
+  // Tells 'rowLimitTarget_' how many rows are needed after 'numPendingRows'
+  // rows of input that have not been consumed yet.
+  void pushdownRowLimit(vector_size_t numPendingRows);
+
   int64_t remainingOffset_;
   int64_t remainingLimit_;
   bool finished_{false};
+
+  // Source operator of the pipeline that stops reading ahead once it has
+  // produced the rows needed by 'this'. Set in initialize().
+  Operator* rowLimitTarget_{nullptr};
 };
 } // namespace facebook::velox::exec
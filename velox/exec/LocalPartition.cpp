@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/LocalPartition.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/vector/EncodedVectorCopy.h"
 
@@ -30,32 +31,68 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  producersWaiting_ = true;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  // A consumer may have brought the usage under the limit since.
+  if (bufferedBytes_ < maxBufferSize_) {
+    if (promises_.empty()) {
+      producersWaiting_ = false;
+    }
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_) {
+    return {};
+  }
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!producersWaiting_) {
+    return {};
+  }
+
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
-
     if (bufferedBytes_ < maxBufferSize_) {
       promises = std::move(promises_);
+      producersWaiting_ = false;
     }
   }
   return promises;
 }
 
+void ScaleWriterSinkTracker::addAppend(
+    uint64_t appendTimeNs,
+    uint64_t writeIOTimeNs) {
+  std::lock_guard<std::mutex> l(mutex_);
+  appendTimeNs_ += appendTimeNs;
+  writeIOTimeNs_ += writeIOTimeNs;
+  if (appendTimeNs_ > kDecayTimeNs) {
+    appendTimeNs_ /= 2;
+    writeIOTimeNs_ /= 2;
+  }
+}
+
+double ScaleWriterSinkTracker::ioTimeRatio() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (appendTimeNs_ == 0) {
+    return 0;
+  }
+  // The sink may write asynchronously, in which case its I/O time can exceed
+  // the append time.
+  return std::min(1.0, static_cast<double>(writeIOTimeNs_) / appendTimeNs_);
+}
+
 void LocalExchangeVectorPool::push(const RowVectorPtr& vector, int64_t size) {
   pool_.withWLock([&](auto& pool) {
     if (totalSize_ + size <= capacity_) {
@@ -82,36 +119,42 @@ RowVectorPtr LocalExchangeVectorPool::pop() {
 }
 
 void LocalExchangeQueue::addProducer() {
-  queue_.withWLock([&](auto& /*queue*/) {
-    VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
-    ++pendingProducers_;
-  });
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
+  ++pendingProducers_;
+}
+
+std::vector<ContinuePromise> LocalExchangeQueue::takeConsumerPromisesLocked() {
+  consumersWaiting_ = false;
+  return std::move(consumerPromises_);
 }
 
 void LocalExchangeQueue::noMoreProducers() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!noMoreProducers_, "noMoreProducers can be called only once");
     noMoreProducers_ = true;
     if (pendingProducers_ == 0) {
       // No more data will be produced.
-      consumerPromises = std::move(consumerPromises_);
+      consumerPromises = takeConsumerPromisesLocked();
     }
-  });
+  }
   notify(consumerPromises);
 }
 
 void LocalExchangeQueue::drain() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!closed_, "Queue is closed");
     ++drainedProducers_;
     VELOX_CHECK_LE(drainedProducers_, pendingProducers_);
     if (drainedProducers_ != pendingProducers_) {
       return;
     }
-    consumerPromises = std::move(consumerPromises_);
-  });
+    consumerPromises = takeConsumerPromisesLocked();
+  }
   notify(consumerPromises);
 }
 
@@ -119,27 +162,31 @@ BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
     int64_t inputBytes,
     ContinueFuture* future) {
-  std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
-  const bool isClosed = queue_.withWLock([&](auto& queue) {
-    if (closed_) {
-      return true;
-    }
-    queue.emplace(std::move(input), inputBytes);
-    consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
-    }
+  if (closed_) {
+    return BlockingReason::kNotBlocked;
+  }
 
-    return false;
-  });
+  // The memory is accounted before the data is visible to the consumers so
+  // that the usage never goes negative.
+  const bool blockedOnConsumer =
+      memoryManager_->increaseMemoryUsage(future, inputBytes);
+  queue_.enqueue(Entry(std::move(input), inputBytes));
+  std::atomic_thread_fence(std::memory_order_seq_cst);
 
-  if (isClosed) {
+  if (closed_) {
+    // The queue was closed concurrently and may have missed the data.
+    clear();
     return BlockingReason::kNotBlocked;
   }
 
-  notify(consumerPromises);
+  if (consumersWaiting_) {
+    std::vector<ContinuePromise> consumerPromises;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      consumerPromises = takeConsumerPromisesLocked();
+    }
+    notify(consumerPromises);
+  }
 
   if (blockedOnConsumer) {
     return BlockingReason::kWaitForConsumer;
@@ -150,14 +197,15 @@ BlockingReason LocalExchangeQueue::enqueue(
 
 void LocalExchangeQueue::noMoreData() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK_EQ(drainedProducers_, 0);
     VELOX_CHECK_GT(pendingProducers_, 0);
     --pendingProducers_;
     if (noMoreProducers_ && pendingProducers_ == 0) {
-      consumerPromises = std::move(consumerPromises_);
+      consumerPromises = takeConsumerPromisesLocked();
     }
-  });
+  }
   notify(consumerPromises);
 }
 
@@ -167,12 +215,15 @@ BlockingReason LocalExchangeQueue::next(
     RowVectorPtr* data,
     bool& drained) {
   drained = false;
-  int64_t size{0};
-  std::vector<ContinuePromise> memoryPromises;
-  const auto blockingReason = queue_.withWLock([&](auto& queue) {
-    *data = nullptr;
-    if (queue.empty()) {
-      if (isFinishedLocked(queue)) {
+  *data = nullptr;
+  Entry entry;
+  if (!queue_.try_dequeue(entry)) {
+    std::lock_guard<std::mutex> l(mutex_);
+    consumersWaiting_ = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // A producer may have added data since.
+    if (!queue_.try_dequeue(entry)) {
+      if (isFinishedLocked()) {
         return BlockingReason::kNotBlocked;
       }
       if (testAndClearDrainedLocked()) {
@@ -185,27 +236,25 @@ BlockingReason LocalExchangeQueue::next(
 
       return BlockingReason::kWaitForProducer;
     }
+    if (consumerPromises_.empty()) {
+      consumersWaiting_ = false;
+    }
+  }
 
-    std::tie(*data, size) = std::move(queue.front());
-    queue.pop();
-
-    memoryPromises = memoryManager_->decreaseMemoryUsage(size);
-    return BlockingReason::kNotBlocked;
-  });
-
+  const auto size = entry.second;
+  *data = std::move(entry.first);
+  auto memoryPromises = memoryManager_->decreaseMemoryUsage(size);
   notify(memoryPromises);
-  if (*data != nullptr) {
-    vectorPool_->push(*data, size);
-  }
-  return blockingReason;
+  vectorPool_->push(*data, size);
+  return BlockingReason::kNotBlocked;
 }
 
-bool LocalExchangeQueue::isFinishedLocked(const Queue& queue) const {
+bool LocalExchangeQueue::isFinishedLocked() const {
   if (closed_) {
     return true;
   }
 
-  if (noMoreProducers_ && pendingProducers_ == 0 && queue.empty()) {
+  if (noMoreProducers_ && pendingProducers_ == 0 && queue_.empty()) {
     return true;
   }
 
@@ -223,33 +272,42 @@ bool LocalExchangeQueue::testAndClearDrainedLocked() {
 }
 
 bool LocalExchangeQueue::isFinished() {
-  return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
+  if (closed_) {
+    return true;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  return isFinishedLocked();
 }
 
 bool LocalExchangeQueue::testingProducersDone() const {
-  return queue_.withRLock(
-      [&](auto& queue) { return noMoreProducers_ && pendingProducers_ == 0; });
+  std::lock_guard<std::mutex> l(mutex_);
+  return noMoreProducers_ && pendingProducers_ == 0;
+}
+
+void LocalExchangeQueue::clear() {
+  uint64_t freedBytes = 0;
+  Entry entry;
+  while (queue_.try_dequeue(entry)) {
+    freedBytes += entry.second;
+  }
+  if (freedBytes) {
+    auto memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
+    notify(memoryPromises);
+  }
 }
 
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> consumerPromises;
-  std::vector<ContinuePromise> memoryPromises;
-  queue_.withWLock([&](auto& queue) {
-    uint64_t freedBytes = 0;
-    while (!queue.empty()) {
-      freedBytes += queue.front().second;
-      queue.pop();
-    }
-
-    if (freedBytes) {
-      memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
-    }
-
-    consumerPromises = std::move(consumerPromises_);
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     closed_ = true;
-  });
+    consumerPromises = takeConsumerPromisesLocked();
+  }
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  // A producer which adds data concurrently and does not see 'closed_'
+  // leaves its data for this to release.
+  clear();
   notify(consumerPromises);
-  notify(memoryPromises);
 }
 
 LocalExchange::LocalExchange(
@@ -349,7 +407,9 @@ LocalPartition::LocalPartition(
               ? 0
               : ctx->queryConfig().maxLocalExchangePartitionBufferSize()},
       partitionBufferPreserveEncoding_{
-          ctx->queryConfig().localExchangePartitionBufferPreserveEncoding()} {
+          ctx->queryConfig().localExchangePartitionBufferPreserveEncoding()},
+      stringCompactionRatio_{
+          ctx->queryConfig().localExchangeStringCompactionRatio()} {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
   for (auto& queue : queues_) {
     queue->addProducer();
@@ -483,6 +543,10 @@ RowVectorPtr LocalPartition::processPartition(
 
 void LocalPartition::addInput(RowVectorPtr input) {
   prepareForInput(input);
+  if (const auto numCompacted =
+          compactStringColumns(input, stringCompactionRatio_, pool())) {
+    addRuntimeStat("numCompactedStringColumns", RuntimeCounter(numCompacted));
+  }
 
   const auto singlePartition = numPartitions_ == 1
       ? 0
@@ -15,13 +15,17 @@
  */
 #pragma once
 
+#include <folly/concurrency/UnboundedQueue.h>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The size is updated without a lock. The lock is only
+/// taken by a producer which reaches the limit and by a consumer which brings
+/// the size back under the limit while producers wait.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -48,11 +52,42 @@ class LocalExchangeMemoryManager {
 
  private:
   const int64_t maxBufferSize_;
+  std::atomic_int64_t bufferedBytes_{0};
+  // True if 'promises_' may be non-empty. A producer sets it before it checks
+  // 'bufferedBytes_' again under 'mutex_' and a consumer checks it after it
+  // decreases 'bufferedBytes_', so that either the producer sees the decrease
+  // or the consumer sees the producer waiting.
+  std::atomic_bool producersWaiting_{false};
   std::mutex mutex_;
-  tsan_atomic<int64_t> bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
+/// Collects the time the table writers behind a scale writer local exchange
+/// spend appending data to their sinks and the part of it spent in sink write
+/// I/O. The scale writer local partition uses the ratio of the two to tell
+/// writers bound by encoding, which an extra writer speeds up, from writers
+/// bound by the storage, which an extra writer does not speed up but leaves
+/// with smaller files and more memory. Older times decay so that the ratio
+/// follows the recent behavior of the sinks.
+class ScaleWriterSinkTracker {
+ public:
+  /// Adds the wall time of one append to a sink and the sink write I/O time
+  /// during it.
+  void addAppend(uint64_t appendTimeNs, uint64_t writeIOTimeNs);
+
+  /// Returns the ratio of the sink write I/O time to the append time in
+  /// [0, 1]. Returns 0 before any append.
+  double ioTimeRatio() const;
+
+ private:
+  // The append time above which the collected times are halved.
+  static constexpr uint64_t kDecayTimeNs = 10'000'000'000;
+
+  mutable std::mutex mutex_;
+  uint64_t appendTimeNs_{0};
+  uint64_t writeIOTimeNs_{0};
+};
+
 /// A vector pool to reuse the RowVector and DictionaryVectors.  Only
 /// exclusively owned vectors will be reused.
 class LocalExchangeVectorPool {
@@ -77,6 +112,12 @@ class LocalExchangeVectorPool {
 /// must be called after all producers have been registered. A producer calls
 /// 'enqueue' multiple time to put the data and calls 'noMoreData' when done.
 /// Consumers call 'next' repeatedly to fetch the data.
+///
+/// The data is kept in a lock-free unbounded multi-producer multi-consumer
+/// queue, which is bounded by the LocalExchangeMemoryManager. 'enqueue' and
+/// 'next' only take the lock of the queue when a consumer finds no data and
+/// has to wait, and when a producer wakes up waiting consumers. The producer
+/// registration, drain and close state is kept under the lock.
 class LocalExchangeQueue {
  public:
   LocalExchangeQueue(
@@ -139,21 +180,34 @@ class LocalExchangeQueue {
   bool testingProducersDone() const;
 
  private:
-  using Queue = std::queue<std::pair<RowVectorPtr, int64_t>>;
+  using Entry = std::pair<RowVectorPtr, int64_t>;
 
-  bool isFinishedLocked(const Queue& queue) const;
+  bool isFinishedLocked() const;
 
   bool testAndClearDrainedLocked();
 
+  // Moves out 'consumerPromises_' for the caller to fulfill.
+  std::vector<ContinuePromise> takeConsumerPromisesLocked();
+
+  // Removes the data from 'queue_' and releases its memory.
+  void clear();
+
   const std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const std::shared_ptr<LocalExchangeVectorPool> vectorPool_;
   const int partition_;
 
-  folly::Synchronized<Queue> queue_;
+  folly::UMPMCQueue<Entry, /*MayBlock=*/false> queue_;
+
+  mutable std::mutex mutex_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
   std::vector<ContinuePromise> consumerPromises_;
+  // True if 'consumerPromises_' may be non-empty. A consumer sets it before it
+  // checks 'queue_' again under 'mutex_' and a producer checks it after it
+  // adds to 'queue_', so that either the consumer sees the data or the
+  // producer sees the consumer waiting.
+  std::atomic_bool consumersWaiting_{false};
   int pendingProducers_{0};
   bool noMoreProducers_{false};
   // The number of drained producers when the task is under barrier processing.
@@ -161,7 +215,8 @@ class LocalExchangeQueue {
   // consumer receives the drained signal on the next call to 'next', and
   // 'drainedProducers_' is reset to zero.
   int drainedProducers_{0};
-  bool closed_{false};
+  // Set under 'mutex_'. Read without the lock by the producers.
+  std::atomic_bool closed_{false};
 };
 
 /// Fetches data for a single partition produced by local exchange from
@@ -276,6 +331,10 @@ class LocalPartition : public Operator {
   std::vector<BaseVector::CopyRange> copyRanges_;
   std::vector<VectorPtr> partitionBuffers_;
   const bool partitionBufferPreserveEncoding_;
+
+  // Strings of a column taking less than this fraction of the string buffers
+  // of the column are copied before queuing. See compactStringColumns().
+  const double stringCompactionRatio_;
 };
 
 } // namespace facebook::velox::exec
@@ -22,6 +22,7 @@
 #include "velox/exec/Exchange.h"
 #include "velox/exec/Expand.h"
 #include "velox/exec/FilterProject.h"
+#include "velox/exec/ForwardSubExpressions.h"
 #include "velox/exec/GroupId.h"
 #include "velox/exec/HashAggregation.h"
 #include "velox/exec/HashBuild.h"
@@ -36,6 +37,7 @@
 #include "velox/exec/OperatorTraceScan.h"
 #include "velox/exec/OrderBy.h"
 #include "velox/exec/PartitionedOutput.h"
+#include "velox/exec/RollupGroupingSets.h"
 #include "velox/exec/RoundRobinPartitionFunction.h"
 #include "velox/exec/RowNumber.h"
 #include "velox/exec/ScaleWriterLocalPartition.h"
@@ -361,6 +363,12 @@ void LocalPlanner::plan(
     markMixedJoinBridges(*driverFactories);
   }
 
+  if (queryConfig.pipelineSubExpressionForwardingEnabled()) {
+    for (auto& factory : *driverFactories) {
+      forwardSubExpressions(factory->planNodes);
+    }
+  }
+
   // Determine number of drivers for each pipeline.
   for (auto& factory : *driverFactories) {
     factory->maxDrivers = detail::maxDrivers(*factory, queryConfig);
@@ -571,8 +579,14 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto groupIdNode =
             std::dynamic_pointer_cast<const core::GroupIdNode>(planNode)) {
+      const auto* aggregationNode = i + 1 < planNodes.size()
+          ? dynamic_cast<const core::AggregationNode*>(planNodes[i + 1].get())
+          : nullptr;
+      const bool rollup = aggregationNode != nullptr &&
+          aggregationNode->sources()[0] == groupIdNode &&
+          RollupGroupingSets::supports(*aggregationNode, ctx->queryConfig());
       operators.push_back(
-          std::make_unique<GroupId>(id, ctx.get(), groupIdNode));
+          std::make_unique<GroupId>(id, ctx.get(), groupIdNode, rollup));
     } else if (
         auto topNNode =
             std::dynamic_pointer_cast<const core::TopNNode>(planNode)) {
@@ -17,6 +17,7 @@
 #include "velox/exec/Merge.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
+#include "velox/exec/prefixsort/PrefixSortEncoder.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -33,6 +34,41 @@ std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
       common::stringToCompressionKind(queryConfig.shuffleCompressionKind());
   return options;
 }
+
+// Returns the size of the normalized key of 'kind' with a null byte, or
+// std::nullopt if the encoding is not exact.
+std::optional<uint32_t> normalizedKeyTypeSize(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+      return prefixsort::PrefixSortEncoder::encodedSize(kind, 0, true);
+    default:
+      return std::nullopt;
+  }
+}
+
+template <TypeKind Kind>
+void encodeKey(
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    const prefixsort::PrefixSortEncoder& encoder,
+    uint32_t rowSize,
+    char* dest) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  constexpr uint32_t kEncodedSize = 1 + sizeof(T);
+  for (vector_size_t row = 0; row < numRows; ++row, dest += rowSize) {
+    if (decoded.isNullAt(row)) {
+      encoder.encode<T>(std::nullopt, dest, kEncodedSize, true);
+    } else {
+      encoder.encode<T>(decoded.valueAt<T>(row), dest, kEncodedSize, true);
+    }
+  }
+}
 } // namespace
 
 Merge::Merge(
@@ -69,11 +105,16 @@ Merge::Merge(
 }
 
 void Merge::initializeTreeOfLosers() {
+  const auto normalizedKeySize =
+      SourceStream::normalizedKeySize(*outputType_, sortingKeys_);
   std::vector<std::unique_ptr<SourceStream>> sourceCursors;
   sourceCursors.reserve(sources_.size());
   for (auto& source : sources_) {
     sourceCursors.push_back(std::make_unique<SourceStream>(
-        source.get(), sortingKeys_, outputBatchSize_));
+        source.get(),
+        sortingKeys_,
+        outputBatchSize_,
+        normalizedKeySize));
   }
 
   // Save the pointers to cursors before moving these into the TreeOfLosers.
@@ -221,8 +262,68 @@ void Merge::close() {
   }
 }
 
+// static
+std::optional<uint32_t> SourceStream::normalizedKeySize(
+    const RowType& type,
+    const std::vector<SpillSortKey>& sortingKeys) {
+  uint32_t size{0};
+  for (const auto& [channel, _] : sortingKeys) {
+    const auto keySize = normalizedKeyTypeSize(type.childAt(channel)->kind());
+    if (!keySize.has_value()) {
+      return std::nullopt;
+    }
+    size += keySize.value();
+  }
+  return size;
+}
+
+void SourceStream::encodeKeys() {
+  const auto numRows = data_->size();
+  const auto rowSize = normalizedKeySize_.value();
+  normalizedKeys_.resize(numRows * rowSize);
+  rows_.resizeFill(numRows, true);
+  uint32_t offset{0};
+  for (auto i = 0; i < sortingKeys_.size(); ++i) {
+    const auto& compareFlags = sortingKeys_[i].second;
+    const prefixsort::PrefixSortEncoder encoder(
+        compareFlags.ascending, compareFlags.nullsFirst);
+    decoded_.decode(*keyColumns_[i], rows_);
+    const auto kind = keyColumns_[i]->typeKind();
+    switch (kind) {
+#define ENCODE_CASE(kind)                 \
+  case TypeKind::kind:                    \
+    encodeKey<TypeKind::kind>(            \
+        decoded_,                         \
+        numRows,                          \
+        encoder,                          \
+        rowSize,                          \
+        normalizedKeys_.data() + offset); \
+    break;
+      ENCODE_CASE(SMALLINT)
+      ENCODE_CASE(INTEGER)
+      ENCODE_CASE(BIGINT)
+      ENCODE_CASE(HUGEINT)
+      ENCODE_CASE(REAL)
+      ENCODE_CASE(DOUBLE)
+      ENCODE_CASE(TIMESTAMP)
+#undef ENCODE_CASE
+      default:
+        VELOX_UNREACHABLE(
+            "Unexpected normalized key type: {}", mapTypeKindToName(kind));
+    }
+    offset += normalizedKeyTypeSize(kind).value();
+  }
+  VELOX_DCHECK_EQ(offset, rowSize);
+}
+
 bool SourceStream::operator<(const MergeStream& other) const {
   const auto& otherCursor = static_cast<const SourceStream&>(other);
+  if (normalizedKeySize_.has_value()) {
+    return std::memcmp(
+               normalizedKey(),
+               otherCursor.normalizedKey(),
+               normalizedKeySize_.value()) < 0;
+  }
   for (auto i = 0; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
@@ -258,13 +359,24 @@ void SourceStream::copyToOutput(RowVectorPtr& output) {
     return;
   }
 
+  // The source rows are consecutive. The output rows are consecutive while
+  // this stream wins, so each run of wins is copied as one range.
+  ranges_.clear();
   vector_size_t sourceRow = firstSourceRow_;
-  outputRows_.applyToSelected(
-      [&](auto row) { sourceRows_[row] = sourceRow++; });
+  outputRows_.applyToSelected([&](auto row) {
+    if (!ranges_.empty() &&
+        ranges_.back().targetIndex + ranges_.back().count == row) {
+      ++ranges_.back().count;
+    } else {
+      ranges_.push_back({sourceRow, row, 1});
+    }
+    ++sourceRow;
+  });
 
+  const folly::Range<const BaseVector::CopyRange*> ranges(
+      ranges_.data(), ranges_.size());
   for (auto i = 0; i < output->type()->size(); ++i) {
-    output->childAt(i)->copy(
-        data_->childAt(i).get(), outputRows_, sourceRows_.data());
+    output->childAt(i)->copyRanges(data_->childAt(i).get(), ranges);
   }
 
   outputRows_.clearAll();
@@ -297,6 +409,9 @@ bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
     for (const auto& key : sortingKeys_) {
       keyColumns_.push_back(data_->childAt(key.first).get());
     }
+    if (normalizedKeySize_.has_value()) {
+      encodeKeys();
+    }
   }
   return false;
 }
@@ -88,17 +88,29 @@ class Merge : public SourceOperator {
 
 class SourceStream final : public MergeStream {
  public:
+  /// If 'normalizedKeySize' is set, the keys of each batch are encoded into
+  /// byte strings of this size which compare with memcmp like the keys, see
+  /// normalizedKeySize(). All the streams of a merge must agree on it.
   SourceStream(
       MergeSource* source,
       const std::vector<SpillSortKey>& sortingKeys,
-      uint32_t outputBatchSize)
+      uint32_t outputBatchSize,
+      std::optional<uint32_t> normalizedKeySize = std::nullopt)
       : source_{source},
         sortingKeys_{sortingKeys},
-        outputRows_(outputBatchSize, false),
-        sourceRows_(outputBatchSize) {
+        normalizedKeySize_{normalizedKeySize},
+        outputRows_(outputBatchSize, false) {
     keyColumns_.reserve(sortingKeys.size());
   }
 
+  /// Returns the size of the normalized keys of a row of 'type' for
+  /// 'sortingKeys', or std::nullopt if a key has no exact normalized
+  /// encoding. The keys are encoded with prefixsort::PrefixSortEncoder, which
+  /// is exact for the fixed width types other than BOOLEAN and TINYINT.
+  static std::optional<uint32_t> normalizedKeySize(
+      const RowType& type,
+      const std::vector<SpillSortKey>& sortingKeys);
+
   /// Returns true and appends a future to 'futures' if needs to wait for the
   /// source to produce data.
   bool isBlocked(std::vector<ContinueFuture>& futures) {
@@ -140,10 +152,20 @@ class SourceStream final : public MergeStream {
  private:
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  // Encodes the keys of 'data_' into 'normalizedKeys_'.
+  void encodeKeys();
+
+  const char* normalizedKey() const {
+    return normalizedKeys_.data() +
+        currentSourceRow_ * normalizedKeySize_.value();
+  }
+
   MergeSource* source_;
 
   const std::vector<SpillSortKey>& sortingKeys_;
 
+  const std::optional<uint32_t> normalizedKeySize_;
+
   /// Ordered source rows.
   RowVectorPtr data_;
 
@@ -167,8 +189,14 @@ class SourceStream final : public MergeStream {
   /// Output row numbers for source rows that haven't been copied out yet.
   SelectivityVector outputRows_;
 
+  /// The normalized keys of the rows of 'data_' if 'normalizedKeySize_' is
+  /// set.
+  std::vector<char> normalizedKeys_;
+
   /// Reusable memory.
-  std::vector<vector_size_t> sourceRows_;
+  std::vector<BaseVector::CopyRange> ranges_;
+  SelectivityVector rows_;
+  DecodedVector decoded_;
 };
 
 // LocalMerge merges its source's output into a single stream of
@@ -237,6 +237,57 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+namespace {
+// Returns the first row in [begin, end) for which 'predicate' is false, given
+// that 'predicate' is true on a prefix of the range and false after it. Probes
+// rows at exponentially growing distances from 'begin' and then binary
+// searches the last step, so that skipping 'n' rows takes O(log n) calls
+// instead of 'n' while a short prefix costs as much as a linear scan.
+template <typename Predicate>
+vector_size_t gallop(
+    vector_size_t begin,
+    vector_size_t end,
+    Predicate predicate) {
+  // 'predicate' is true on [begin, low) and false at 'high' unless 'high' is
+  // 'end'.
+  int64_t low = begin;
+  int64_t high = end;
+  int64_t step = 1;
+  while (low < end) {
+    const auto probe = std::min<int64_t>(low + step, end) - 1;
+    if (!predicate(probe)) {
+      high = probe;
+      break;
+    }
+    low = probe + 1;
+    step *= 2;
+  }
+  while (low < high) {
+    const auto middle = low + (high - low) / 2;
+    if (predicate(middle)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+// Returns true if any of the 'keys' of 'input' may be null. A null key compares
+// less than any row on the other side, so a null in the middle of a batch
+// breaks the ordering that galloping relies on.
+bool keysMayHaveNulls(
+    const RowVectorPtr& input,
+    const std::vector<column_index_t>& keys) {
+  for (auto key : keys) {
+    if (input->childAt(key)->mayHaveNulls()) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
 bool MergeJoin::findEndOfMatch(
     const RowVectorPtr& input,
     const std::vector<column_index_t>& keys,
@@ -250,11 +301,10 @@ bool MergeJoin::findEndOfMatch(
 
   const auto numInputRows = input->size();
 
-  vector_size_t endRow = 0;
-  while (endRow < numInputRows &&
-         compare(keys, input, endRow, keys, prevInput, prevIndex) == 0) {
-    ++endRow;
-  }
+  // Rows with equal keys are contiguous in sorted input.
+  const auto endRow = gallop(0, numInputRows, [&](vector_size_t row) {
+    return compare(keys, input, row, keys, prevInput, prevIndex) == 0;
+  });
 
   if (endRow == numInputRows) {
     // Inputs are kept past getting a new batch of inputs. LazyVectors
@@ -768,6 +818,66 @@ vector_size_t firstNonNull(
 }
 } // namespace
 
+vector_size_t MergeJoin::skipLeftRows(vector_size_t start) const {
+  if (start >= input_->size() || keysMayHaveNulls(input_, leftKeyChannels_)) {
+    return start;
+  }
+  return gallop(start, input_->size(), [&](vector_size_t row) {
+    return compare(
+               leftKeyChannels_,
+               input_,
+               row,
+               rightKeyChannels_,
+               rightInput_,
+               rightRowIndex_) < 0;
+  });
+}
+
+vector_size_t MergeJoin::skipRightRows(vector_size_t start) const {
+  if (start >= rightInput_->size() ||
+      keysMayHaveNulls(rightInput_, rightKeyChannels_)) {
+    return start;
+  }
+  return gallop(start, rightInput_->size(), [&](vector_size_t row) {
+    return compare(
+               leftKeyChannels_,
+               input_,
+               leftRowIndex_,
+               rightKeyChannels_,
+               rightInput_,
+               row) > 0;
+  });
+}
+
+bool MergeJoin::tryAddOneToOneRun() {
+  if (!isInnerJoin(joinType_) || filter_ != nullptr || output_ == nullptr ||
+      currentLeft_ != input_ || currentRight_ != rightInput_ ||
+      isRightFlattened_) {
+    return false;
+  }
+
+  // Both rows start a run of equal keys. A run has a single row if the next
+  // row has a different key. The last row of a batch is left to the general
+  // path since its run may continue in the next batch.
+  const auto numLeftRows = input_->size();
+  const auto numRightRows = rightInput_->size();
+  const auto firstOutputRow = outputSize_;
+  while (outputSize_ < outputBatchSize_ && leftRowIndex_ + 1 < numLeftRows &&
+         rightRowIndex_ + 1 < numRightRows && compare() == 0 &&
+         compareLeft(leftRowIndex_ + 1) != 0 &&
+         compareRight(rightRowIndex_ + 1) != 0) {
+    rawLeftOutputIndices_[outputSize_] = leftRowIndex_++;
+    rawRightOutputIndices_[outputSize_] = rightRowIndex_++;
+    ++outputSize_;
+  }
+
+  if (outputSize_ == firstOutputRow) {
+    return false;
+  }
+  rightRowIndex_ = firstNonNull(rightInput_, rightKeyChannels_, rightRowIndex_);
+  return true;
+}
+
 RowVectorPtr MergeJoin::filterOutputForAntiJoin(const RowVectorPtr& output) {
   const auto numRows = output->size();
   const auto& filterRows = joinTracker_->matchingRows(numRows);
@@ -1143,8 +1253,8 @@ RowVectorPtr MergeJoin::doGetOutput() {
           return std::move(output_);
         }
       } else {
-        leftRowIndex_ =
-            firstNonNull(input_, leftKeyChannels_, leftRowIndex_ + 1);
+        leftRowIndex_ = firstNonNull(
+            input_, leftKeyChannels_, skipLeftRows(leftRowIndex_ + 1));
       }
 
       if (finishedLeftBatch()) {
@@ -1168,8 +1278,8 @@ RowVectorPtr MergeJoin::doGetOutput() {
           return std::move(output_);
         }
       } else {
-        rightRowIndex_ =
-            firstNonNull(rightInput_, rightKeyChannels_, rightRowIndex_ + 1);
+        rightRowIndex_ = firstNonNull(
+            rightInput_, rightKeyChannels_, skipRightRows(rightRowIndex_ + 1));
       }
 
       if (finishedRightBatch()) {
@@ -1179,13 +1289,31 @@ RowVectorPtr MergeJoin::doGetOutput() {
       compareResult = compare();
     }
 
+    if (compareResult == 0 && tryAddOneToOneRun()) {
+      if (finishedRightBatch()) {
+        // Ran out of rows on the right side.
+        rightInput_ = nullptr;
+      }
+
+      if (outputSize_ == outputBatchSize_) {
+        return std::move(output_);
+      }
+
+      if (!rightInput_) {
+        return nullptr;
+      }
+
+      compareResult = compare();
+      continue;
+    }
+
     if (compareResult == 0) {
       // Found a match. Identify all rows on the left and right that have the
       // matching keys.
-      vector_size_t leftEndRow = leftRowIndex_ + 1;
-      while (leftEndRow < input_->size() && compareLeft(leftEndRow) == 0) {
-        ++leftEndRow;
-      }
+      const auto leftEndRow = gallop(
+          leftRowIndex_ + 1, input_->size(), [&](vector_size_t row) {
+            return compareLeft(row) == 0;
+          });
 
       if (leftEndRow == input_->size()) {
         // Matches continue in subsequent input. Load all lazies.
@@ -1198,11 +1326,10 @@ RowVectorPtr MergeJoin::doGetOutput() {
           leftEndRow < input_->size(),
           std::nullopt};
 
-      vector_size_t endRightRow = rightRowIndex_ + 1;
-      while (endRightRow < rightInput_->size() &&
-             compareRight(endRightRow) == 0) {
-        ++endRightRow;
-      }
+      const auto endRightRow = gallop(
+          rightRowIndex_ + 1, rightInput_->size(), [&](vector_size_t row) {
+            return compareRight(row) == 0;
+          });
 
       rightMatch_ = Match{
           {rightInput_},
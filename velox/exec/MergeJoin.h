@@ -274,6 +274,24 @@ class MergeJoin : public Operator {
   // rightRowIndex_ are unchanged.
   bool tryAddOutputRowForRightJoin();
 
+  // Returns the first row of the left batch at or after 'start' that is not
+  // less than the current right row. Gallops over the batch unless its keys
+  // may have nulls, in which case returns 'start'. Used to skip left rows that
+  // produce no output.
+  vector_size_t skipLeftRows(vector_size_t start) const;
+
+  // Returns the first row of the right batch at or after 'start' that is not
+  // less than the current left row. Same as skipLeftRows() for the right side.
+  vector_size_t skipRightRows(vector_size_t start) const;
+
+  // Adds a run of matches in which both the current left and right rows are
+  // the only rows with their keys, which is common when joining on unique
+  // keys. Writes the dictionary indices of the run directly instead of setting
+  // up a match per row. Applies only to inner joins without filter whose
+  // output already wraps the current batches. Advances leftRowIndex_ and
+  // rightRowIndex_ past the run. Returns false if no rows were added.
+  bool tryAddOneToOneRun();
+
   // If all rows from the current left batch have been processed.
   bool finishedLeftBatch() const {
     return leftRowIndex_ == input_->size();
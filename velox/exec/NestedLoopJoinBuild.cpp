@@ -17,6 +17,427 @@
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
+namespace {
+
+// Returns true if 'expr' references only columns of 'type' and has no lambdas.
+bool referencesOnly(const core::TypedExprPtr& expr, const RowType& type) {
+  if (core::TypedExprs::isLambda(expr)) {
+    return false;
+  }
+  if (auto field = core::TypedExprs::asFieldAccess(expr);
+      field != nullptr && field->isInputColumn()) {
+    return type.containsChild(field->name());
+  }
+  for (const auto& input : expr->inputs()) {
+    if (!referencesOnly(input, type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the channel of 'expr' in 'buildType' if 'expr' is a build column of
+// a primitive type.
+std::optional<column_index_t> buildColumn(
+    const core::TypedExprPtr& expr,
+    const RowType& buildType) {
+  auto field = core::TypedExprs::asFieldAccess(expr);
+  if (field == nullptr || !field->isInputColumn() ||
+      !field->type()->isPrimitiveType()) {
+    return std::nullopt;
+  }
+  return buildType.getChildIdxIfExists(field->name());
+}
+
+class RangeBuilder {
+ public:
+  RangeBuilder(const RowType& probeType, const RowType& buildType)
+      : probeType_(probeType), buildType_(buildType) {}
+
+  void addConjunct(const core::TypedExprPtr& expr) {
+    auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+    if (call == nullptr) {
+      return;
+    }
+    const auto& name = call->name();
+    const auto& inputs = call->inputs();
+    if (name == "and") {
+      for (const auto& input : inputs) {
+        addConjunct(input);
+      }
+      return;
+    }
+
+    if (name == "between" && inputs.size() == 3) {
+      if (auto key = buildColumn(inputs[0], buildType_)) {
+        addBound(*key, inputs[1], true, true);
+        addBound(*key, inputs[2], false, true);
+        return;
+      }
+      // 'probe BETWEEN key AND ...' bounds 'key' from above and
+      // '... BETWEEN ... AND key' from below.
+      if (auto key = buildColumn(inputs[1], buildType_)) {
+        addBound(*key, inputs[0], false, true);
+      }
+      if (auto key = buildColumn(inputs[2], buildType_)) {
+        addBound(*key, inputs[0], true, true);
+      }
+      return;
+    }
+
+    const bool isLess = name == "lt" || name == "lte";
+    const bool isGreater = name == "gt" || name == "gte";
+    if ((!isLess && !isGreater) || inputs.size() != 2) {
+      return;
+    }
+    const bool inclusive = name == "lte" || name == "gte";
+    if (auto key = buildColumn(inputs[0], buildType_)) {
+      // 'key < probe' is an upper bound and 'key > probe' a lower bound.
+      addBound(*key, inputs[1], isGreater, inclusive);
+    } else if (auto key = buildColumn(inputs[1], buildType_)) {
+      addBound(*key, inputs[0], isLess, inclusive);
+    }
+  }
+
+  std::optional<NestedLoopJoinRange> range() {
+    return std::move(range_);
+  }
+
+ private:
+  void addBound(
+      column_index_t key,
+      const core::TypedExprPtr& bound,
+      bool isLower,
+      bool inclusive) {
+    if (!referencesOnly(bound, probeType_) ||
+        !buildType_.childAt(key)->equivalent(*bound->type())) {
+      return;
+    }
+    if (!range_.has_value()) {
+      range_ = NestedLoopJoinRange{key};
+    } else if (range_->buildKey != key) {
+      return;
+    }
+    auto& target = isLower ? range_->lower : range_->upper;
+    if (target != nullptr) {
+      return;
+    }
+    target = bound;
+    (isLower ? range_->lowerInclusive : range_->upperInclusive) = inclusive;
+  }
+
+  const RowType& probeType_;
+  const RowType& buildType_;
+  std::optional<NestedLoopJoinRange> range_;
+};
+
+class EnvelopeBuilder {
+ public:
+  EnvelopeBuilder(const RowType& probeType, const RowType& buildType)
+      : probeType_(probeType), buildType_(buildType) {}
+
+  void addConjunct(const core::TypedExprPtr& expr) {
+    auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+    if (call == nullptr) {
+      return;
+    }
+    const auto& name = call->name();
+    const auto& inputs = call->inputs();
+    if (name == "and") {
+      for (const auto& input : inputs) {
+        addConjunct(input);
+      }
+      return;
+    }
+
+    // 'probe BETWEEN min AND max' bounds 'min' from above and 'max' from
+    // below.
+    if (name == "between" && inputs.size() == 3) {
+      if (auto column = doubleBuildColumn(inputs[1])) {
+        add(mins_, *column, inputs[0]);
+      }
+      if (auto column = doubleBuildColumn(inputs[2])) {
+        add(maxes_, *column, inputs[0]);
+      }
+      return;
+    }
+
+    const bool isLess = name == "lt" || name == "lte";
+    const bool isGreater = name == "gt" || name == "gte";
+    if ((!isLess && !isGreater) || inputs.size() != 2) {
+      return;
+    }
+    if (auto column = doubleBuildColumn(inputs[0])) {
+      // 'column < probe' bounds 'column' from above.
+      add(isLess ? mins_ : maxes_, *column, inputs[1]);
+    } else if (auto column = doubleBuildColumn(inputs[1])) {
+      add(isLess ? maxes_ : mins_, *column, inputs[0]);
+    }
+  }
+
+  std::optional<NestedLoopJoinEnvelope> envelope() const {
+    constexpr auto kNumDimensions = NestedLoopJoinEnvelope::kNumDimensions;
+    if (mins_.size() < kNumDimensions || maxes_.size() < kNumDimensions) {
+      return std::nullopt;
+    }
+    NestedLoopJoinEnvelope envelope;
+    for (auto i = 0; i < kNumDimensions; ++i) {
+      envelope.buildMin[i] = mins_[i].first;
+      envelope.probeMax[i] = mins_[i].second;
+      envelope.buildMax[i] = maxes_[i].first;
+      envelope.probeMin[i] = maxes_[i].second;
+    }
+    return envelope;
+  }
+
+ private:
+  using Bound = std::pair<column_index_t, core::TypedExprPtr>;
+
+  std::optional<column_index_t> doubleBuildColumn(
+      const core::TypedExprPtr& expr) const {
+    auto column = buildColumn(expr, buildType_);
+    if (column.has_value() &&
+        buildType_.childAt(*column)->kind() == TypeKind::DOUBLE) {
+      return column;
+    }
+    return std::nullopt;
+  }
+
+  // Adds the bound of 'column' by 'probe' unless 'column' is already bounded
+  // in the same direction.
+  void add(
+      std::vector<Bound>& bounds,
+      column_index_t column,
+      const core::TypedExprPtr& probe) {
+    if (probe->type()->kind() != TypeKind::DOUBLE ||
+        !referencesOnly(probe, probeType_)) {
+      return;
+    }
+    for (const auto& bound : bounds) {
+      if (bound.first == column) {
+        return;
+      }
+    }
+    bounds.emplace_back(column, probe);
+  }
+
+  const RowType& probeType_;
+  const RowType& buildType_;
+
+  // Build columns bounded from above and from below, in conjunct order.
+  std::vector<Bound> mins_;
+  std::vector<Bound> maxes_;
+};
+
+// Returns the value of a DOUBLE column of 'data' at 'row' or std::nullopt if
+// it is null or NaN.
+std::optional<double> envelopeValue(
+    const RowVector& data,
+    column_index_t column,
+    vector_size_t row) {
+  const auto* vector = data.childAt(column)->as<SimpleVector<double>>();
+  if (vector->isNullAt(row)) {
+    return std::nullopt;
+  }
+  const auto value = vector->valueAt(row);
+  if (std::isnan(value)) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+// Returns true if 'row' of 'data' has non-null and non-NaN ends of
+// 'envelope' in all the dimensions.
+bool hasEnvelope(
+    const RowVector& data,
+    const NestedLoopJoinEnvelope& envelope,
+    vector_size_t row) {
+  for (auto i = 0; i < NestedLoopJoinEnvelope::kNumDimensions; ++i) {
+    if (!envelopeValue(data, envelope.buildMin[i], row).has_value() ||
+        !envelopeValue(data, envelope.buildMax[i], row).has_value()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+// static
+std::optional<NestedLoopJoinEnvelope> NestedLoopJoinEnvelope::extract(
+    const core::TypedExprPtr& condition,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  if (condition == nullptr) {
+    return std::nullopt;
+  }
+  EnvelopeBuilder builder(*probeType, *buildType);
+  builder.addConjunct(condition);
+  return builder.envelope();
+}
+
+// static
+std::vector<vector_size_t> NestedLoopJoinEnvelopeIndex::packOrder(
+    const RowVector& data,
+    const NestedLoopJoinEnvelope& envelope) {
+  std::vector<vector_size_t> order;
+  std::vector<vector_size_t> noEnvelope;
+  order.reserve(data.size());
+  for (auto row = 0; row < data.size(); ++row) {
+    if (hasEnvelope(data, envelope, row)) {
+      order.push_back(row);
+    } else {
+      noEnvelope.push_back(row);
+    }
+  }
+
+  // Sort-Tile-Recursive packing: sorts the rows on the center of the first
+  // dimension, cuts them into slices of about sqrt(number of leaves) leaves
+  // and sorts each slice on the center of the second dimension.
+  // The center of an envelope from -Infinity to Infinity is NaN, which would
+  // break the ordering. Such an envelope is centered on 0.
+  const auto center = [&](vector_size_t row, int32_t dimension) {
+    const auto value =
+        *envelopeValue(data, envelope.buildMin[dimension], row) / 2 +
+        *envelopeValue(data, envelope.buildMax[dimension], row) / 2;
+    return std::isnan(value) ? 0 : value;
+  };
+  const auto sortOn = [&](auto begin, auto end, int32_t dimension) {
+    std::sort(begin, end, [&](auto left, auto right) {
+      return center(left, dimension) < center(right, dimension);
+    });
+  };
+  const auto numIndexedRows = order.size();
+  const auto numLeaves =
+      bits::divRoundUp(numIndexedRows, static_cast<size_t>(kLeafRows));
+  const auto numSlices =
+      static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(numLeaves))));
+  sortOn(order.begin(), order.end(), 0);
+  const auto sliceRows = std::max<size_t>(1, numSlices) * kLeafRows;
+  for (size_t begin = 0; begin < numIndexedRows; begin += sliceRows) {
+    const auto end = std::min(begin + sliceRows, numIndexedRows);
+    sortOn(order.begin() + begin, order.begin() + end, 1);
+  }
+
+  order.insert(order.end(), noEnvelope.begin(), noEnvelope.end());
+  return order;
+}
+
+NestedLoopJoinEnvelopeIndex::NestedLoopJoinEnvelopeIndex(
+    const RowVector& data,
+    const NestedLoopJoinEnvelope& envelope)
+    : numRows_(data.size()) {
+  while (numIndexedRows_ < numRows_ &&
+         hasEnvelope(data, envelope, numIndexedRows_)) {
+    ++numIndexedRows_;
+  }
+
+  std::vector<Box> leaves;
+  for (vector_size_t row = 0; row < numIndexedRows_; ++row) {
+    Box box;
+    for (auto i = 0; i < NestedLoopJoinEnvelope::kNumDimensions; ++i) {
+      box.min[i] = *envelopeValue(data, envelope.buildMin[i], row);
+      box.max[i] = *envelopeValue(data, envelope.buildMax[i], row);
+    }
+    if (row % kLeafRows == 0) {
+      leaves.push_back(box);
+    } else {
+      leaves.back().add(box);
+    }
+  }
+  if (leaves.empty()) {
+    return;
+  }
+  levels_.push_back(std::move(leaves));
+  while (levels_.back().size() > 1) {
+    const auto& children = levels_.back();
+    std::vector<Box> parents;
+    for (size_t i = 0; i < children.size(); ++i) {
+      if (i % kFanout == 0) {
+        parents.push_back(children[i]);
+      } else {
+        parents.back().add(children[i]);
+      }
+    }
+    levels_.push_back(std::move(parents));
+  }
+}
+
+void NestedLoopJoinEnvelopeIndex::Box::add(const Box& other) {
+  for (auto i = 0; i < NestedLoopJoinEnvelope::kNumDimensions; ++i) {
+    min[i] = std::min(min[i], other.min[i]);
+    max[i] = std::max(max[i], other.max[i]);
+  }
+}
+
+bool NestedLoopJoinEnvelopeIndex::Box::overlaps(
+    const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& low,
+    const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& high)
+    const {
+  for (auto i = 0; i < NestedLoopJoinEnvelope::kNumDimensions; ++i) {
+    if (min[i] > high[i] || max[i] < low[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void NestedLoopJoinEnvelopeIndex::find(
+    const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& min,
+    const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& max,
+    std::vector<RowRange>& ranges) const {
+  ranges.clear();
+  if (!levels_.empty()) {
+    find(levels_.size() - 1, 0, min, max, ranges);
+  }
+  if (numIndexedRows_ < numRows_) {
+    if (!ranges.empty() && ranges.back().second == numIndexedRows_) {
+      ranges.back().second = numRows_;
+    } else {
+      ranges.emplace_back(numIndexedRows_, numRows_);
+    }
+  }
+}
+
+void NestedLoopJoinEnvelopeIndex::find(
+    size_t level,
+    size_t node,
+    const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& min,
+    const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& max,
+    std::vector<RowRange>& ranges) const {
+  if (!levels_[level][node].overlaps(min, max)) {
+    return;
+  }
+  if (level == 0) {
+    const vector_size_t begin = node * kLeafRows;
+    const vector_size_t end = std::min(begin + kLeafRows, numIndexedRows_);
+    // Merges the runs of adjacent leaves.
+    if (!ranges.empty() && ranges.back().second == begin) {
+      ranges.back().second = end;
+    } else {
+      ranges.emplace_back(begin, end);
+    }
+    return;
+  }
+  const auto& children = levels_[level - 1];
+  const auto end = std::min((node + 1) * kFanout, children.size());
+  for (auto child = node * kFanout; child < end; ++child) {
+    find(level - 1, child, min, max, ranges);
+  }
+}
+
+// static
+std::optional<NestedLoopJoinRange> NestedLoopJoinRange::extract(
+    const core::TypedExprPtr& condition,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  if (condition == nullptr) {
+    return std::nullopt;
+  }
+  RangeBuilder builder(*probeType, *buildType);
+  builder.addConjunct(condition);
+  return builder.range();
+}
 
 void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
   std::vector<ContinuePromise> promises;
@@ -50,7 +471,24 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild") {
+  if (driverCtx->queryConfig().nestedLoopJoinSpatialIndexEnabled()) {
+    envelope_ = NestedLoopJoinEnvelope::extract(
+        joinNode->joinCondition(),
+        joinNode->sources()[0]->outputType(),
+        joinNode->sources()[1]->outputType());
+  }
+  if (!envelope_.has_value() &&
+      driverCtx->queryConfig().nestedLoopJoinSortedBuildEnabled()) {
+    auto range = NestedLoopJoinRange::extract(
+        joinNode->joinCondition(),
+        joinNode->sources()[0]->outputType(),
+        joinNode->sources()[1]->outputType());
+    if (range.has_value()) {
+      sortKey_ = range->buildKey;
+    }
+  }
+}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -103,6 +541,62 @@ std::vector<RowVectorPtr> NestedLoopJoinBuild::mergeDataVectors() const {
   return merged;
 }
 
+RowVectorPtr NestedLoopJoinBuild::concatenateDataVectors() const {
+  int64_t numRows = 0;
+  for (const auto& vector : dataVectors_) {
+    numRows += vector->size();
+  }
+  VELOX_CHECK_LE(
+      numRows,
+      std::numeric_limits<vector_size_t>::max(),
+      "Too many rows for a sorted or packed nested loop join build side");
+
+  auto merged = BaseVector::create<RowVector>(
+      dataVectors_[0]->type(), numRows, pool());
+  vector_size_t offset = 0;
+  for (const auto& vector : dataVectors_) {
+    merged->copy(vector.get(), offset, 0, vector->size());
+    offset += vector->size();
+  }
+  return merged;
+}
+
+std::vector<RowVectorPtr> NestedLoopJoinBuild::sortDataVectors() const {
+  VELOX_CHECK(sortKey_.has_value());
+  if (dataVectors_.empty()) {
+    return {};
+  }
+  auto merged = concatenateDataVectors();
+  const auto numRows = merged->size();
+
+  std::vector<vector_size_t> order(numRows);
+  std::iota(order.begin(), order.end(), 0);
+  const auto* key = merged->childAt(sortKey_.value()).get();
+  constexpr CompareFlags kFlags{.nullsFirst = false, .ascending = true};
+  std::sort(order.begin(), order.end(), [&](auto left, auto right) {
+    return key->compare(key, left, right, kFlags).value() < 0;
+  });
+
+  auto sorted = BaseVector::create<RowVector>(merged->type(), numRows, pool());
+  sorted->copy(merged.get(), SelectivityVector(numRows), order.data());
+  return {std::move(sorted)};
+}
+
+std::vector<RowVectorPtr> NestedLoopJoinBuild::packDataVectors() const {
+  VELOX_CHECK(envelope_.has_value());
+  if (dataVectors_.empty()) {
+    return {};
+  }
+  auto merged = concatenateDataVectors();
+  const auto numRows = merged->size();
+  const auto order =
+      NestedLoopJoinEnvelopeIndex::packOrder(*merged, *envelope_);
+
+  auto packed = BaseVector::create<RowVector>(merged->type(), numRows, pool());
+  packed->copy(merged.get(), SelectivityVector(numRows), order.data());
+  return {std::move(packed)};
+}
+
 void NestedLoopJoinBuild::noMoreInput() {
   Operator::noMoreInput();
   std::vector<ContinuePromise> promises;
@@ -138,7 +632,13 @@ void NestedLoopJoinBuild::noMoreInput() {
     }
   }
 
-  dataVectors_ = mergeDataVectors();
+  if (envelope_.has_value()) {
+    dataVectors_ = packDataVectors();
+  } else if (sortKey_.has_value()) {
+    dataVectors_ = sortDataVectors();
+  } else {
+    dataVectors_ = mergeDataVectors();
+  }
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
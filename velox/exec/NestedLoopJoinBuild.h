@@ -15,11 +15,145 @@
  */
 #pragma once
 
+#include <array>
+
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
 
+/// A range of one build side column that is implied by the join condition of
+/// a nested loop join, e.g. 'u0 >= t0 - 10 AND u0 < t0 + 10' or 't0 BETWEEN u0
+/// AND u1'. The bounds are expressions over probe side columns. When the build
+/// side is sorted on 'buildKey', the build rows that may match a probe row are
+/// the consecutive rows between the bounds evaluated on that probe row.
+struct NestedLoopJoinRange {
+  /// Channel of the range column in the build side type.
+  column_index_t buildKey;
+
+  /// Lower bound of 'buildKey', nullptr if there is none.
+  core::TypedExprPtr lower;
+  bool lowerInclusive{false};
+
+  /// Upper bound of 'buildKey', nullptr if there is none.
+  core::TypedExprPtr upper;
+  bool upperInclusive{false};
+
+  /// Returns the range implied by the top level conjuncts of 'condition' or
+  /// std::nullopt if there are no comparisons between a build column of a
+  /// primitive type and an expression over probe columns of the same type. If
+  /// there are conjuncts on several build columns, the first one wins.
+  static std::optional<NestedLoopJoinRange> extract(
+      const core::TypedExprPtr& condition,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+};
+
+/// A test that the envelope of a build row overlaps the envelope of a probe
+/// row in two dimensions, implied by the join condition of a nested loop join,
+/// e.g. 'x BETWEEN xmin AND xmax AND y BETWEEN ymin AND ymax' for a point (x,
+/// y) over probe columns and an envelope given by the build columns xmin, xmax,
+/// ymin and ymax. A build row may match a probe row only if, in each dimension,
+/// 'buildMin <= probeMax' and 'buildMax >= probeMin'.
+struct NestedLoopJoinEnvelope {
+  static constexpr int32_t kNumDimensions = 2;
+
+  /// Channels of the DOUBLE build columns with the low and high ends of the
+  /// build envelope in each dimension.
+  std::array<column_index_t, kNumDimensions> buildMin;
+  std::array<column_index_t, kNumDimensions> buildMax;
+
+  /// DOUBLE expressions over probe columns with the low and high ends of the
+  /// probe envelope in each dimension. They are the same expression for a
+  /// point.
+  std::array<core::TypedExprPtr, kNumDimensions> probeMin;
+  std::array<core::TypedExprPtr, kNumDimensions> probeMax;
+
+  /// Returns the envelope test implied by the top level conjuncts of
+  /// 'condition' or std::nullopt. These must bound two DOUBLE build columns
+  /// from above, e.g. 'xmin <= x', and two from below, e.g. 'xmax >= x', by
+  /// DOUBLE expressions over probe columns. The n-th column bounded from above
+  /// and the n-th column bounded from below make the n-th dimension.
+  static std::optional<NestedLoopJoinEnvelope> extract(
+      const core::TypedExprPtr& condition,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+};
+
+/// A packed R-tree over the envelopes of the rows of a build vector. The rows
+/// are ordered by NestedLoopJoinEnvelopeIndex::packOrder(): the rows with an
+/// envelope come first in Sort-Tile-Recursive order, so that the leaves of the
+/// tree are runs of 'kLeafRows' consecutive rows, and the rows with a null or
+/// NaN end of their envelope come last. A probe then evaluates the join
+/// condition on the runs of rows whose leaves overlap its envelope, and on all
+/// the rows without an envelope.
+class NestedLoopJoinEnvelopeIndex {
+ public:
+  static constexpr vector_size_t kLeafRows = 32;
+  static constexpr int32_t kFanout = 16;
+
+  /// A range of build rows, end exclusive.
+  using RowRange = std::pair<vector_size_t, vector_size_t>;
+
+  /// Returns the positions of the rows of 'data' in packing order.
+  static std::vector<vector_size_t> packOrder(
+      const RowVector& data,
+      const NestedLoopJoinEnvelope& envelope);
+
+  /// Builds the tree over 'data', whose rows are in packing order.
+  NestedLoopJoinEnvelopeIndex(
+      const RowVector& data,
+      const NestedLoopJoinEnvelope& envelope);
+
+  /// Sets 'ranges' to the ranges of rows that may overlap the envelope from
+  /// 'min' to 'max', in increasing row order. These include the rows without
+  /// an envelope.
+  void find(
+      const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& min,
+      const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& max,
+      std::vector<RowRange>& ranges) const;
+
+  vector_size_t numRows() const {
+    return numRows_;
+  }
+
+  /// Number of rows with an envelope, which are the leading rows.
+  vector_size_t numIndexedRows() const {
+    return numIndexedRows_;
+  }
+
+ private:
+  struct Box {
+    std::array<double, NestedLoopJoinEnvelope::kNumDimensions> min;
+    std::array<double, NestedLoopJoinEnvelope::kNumDimensions> max;
+
+    void add(const Box& other);
+
+    bool overlaps(
+        const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& low,
+        const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& high)
+        const;
+  };
+
+  // Adds to 'ranges' the rows of the leaves under 'node' at 'level' that
+  // overlap the envelope.
+  void find(
+      size_t level,
+      size_t node,
+      const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& min,
+      const std::array<double, NestedLoopJoinEnvelope::kNumDimensions>& max,
+      std::vector<RowRange>& ranges) const;
+
+  vector_size_t numRows_{0};
+  vector_size_t numIndexedRows_{0};
+
+  // Boxes of the nodes by level. The first level has the leaves and the last
+  // level has the root. Node 'i' of a level covers nodes 'i * kFanout' to
+  // '(i + 1) * kFanout - 1' of the level below, and leaf 'i' covers rows
+  // 'i * kLeafRows' to '(i + 1) * kLeafRows - 1'.
+  std::vector<std::vector<Box>> levels_;
+};
+
 class NestedLoopJoinBridge : public JoinBridge {
  public:
   void setData(std::vector<RowVectorPtr> buildVectors);
@@ -60,7 +194,26 @@ class NestedLoopJoinBuild : public Operator {
 
   std::vector<RowVectorPtr> mergeDataVectors() const;
 
+  /// Returns a single vector with the rows of 'dataVectors_' sorted on
+  /// 'sortKey_' with nulls last.
+  std::vector<RowVectorPtr> sortDataVectors() const;
+
+  /// Returns a single vector with the rows of 'dataVectors_' in the packing
+  /// order of NestedLoopJoinEnvelopeIndex for 'envelope_'.
+  std::vector<RowVectorPtr> packDataVectors() const;
+
  private:
+  // Returns a single vector with the rows of 'dataVectors_'.
+  RowVectorPtr concatenateDataVectors() const;
+
+  // Build side column to sort on if the probe side uses range search. See
+  // QueryConfig::kNestedLoopJoinSortedBuildEnabled.
+  std::optional<column_index_t> sortKey_;
+
+  // Build side envelope to pack the build side on if the probe side uses an
+  // envelope index. See QueryConfig::kNestedLoopJoinSpatialIndexEnabled.
+  std::optional<NestedLoopJoinEnvelope> envelope_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
@@ -70,10 +70,42 @@ void NestedLoopJoinProbe::initialize() {
 
   VELOX_CHECK(joinNode_ != nullptr);
   if (joinNode_->joinCondition() != nullptr) {
-    initializeFilter(
-        joinNode_->joinCondition(),
-        joinNode_->sources()[0]->outputType(),
-        joinNode_->sources()[1]->outputType());
+    const auto& probeType = joinNode_->sources()[0]->outputType();
+    const auto& buildType = joinNode_->sources()[1]->outputType();
+    initializeFilter(joinNode_->joinCondition(), probeType, buildType);
+
+    // The build side is packed on the envelope or sorted on the range key iff
+    // NestedLoopJoinBuild finds the same envelope or range.
+    const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+    if (queryConfig.nestedLoopJoinSpatialIndexEnabled()) {
+      envelope_ = NestedLoopJoinEnvelope::extract(
+          joinNode_->joinCondition(), probeType, buildType);
+    }
+    if (!envelope_.has_value() &&
+        queryConfig.nestedLoopJoinSortedBuildEnabled()) {
+      range_ = NestedLoopJoinRange::extract(
+          joinNode_->joinCondition(), probeType, buildType);
+    }
+    if (envelope_.has_value()) {
+      std::vector<core::TypedExprPtr> bounds;
+      for (auto i = 0; i < NestedLoopJoinEnvelope::kNumDimensions; ++i) {
+        bounds.push_back(envelope_->probeMin[i]);
+        bounds.push_back(envelope_->probeMax[i]);
+      }
+      envelopeBounds_ = std::make_unique<ExprSet>(
+          std::move(bounds), operatorCtx_->execCtx());
+    }
+    if (range_.has_value()) {
+      std::vector<core::TypedExprPtr> bounds;
+      if (range_->lower != nullptr) {
+        bounds.push_back(range_->lower);
+      }
+      if (range_->upper != nullptr) {
+        bounds.push_back(range_->upper);
+      }
+      rangeBounds_ = std::make_unique<ExprSet>(
+          std::move(bounds), operatorCtx_->execCtx());
+    }
   }
 
   joinNode_.reset();
@@ -165,6 +197,17 @@ void NestedLoopJoinProbe::close() {
   if (joinCondition_ != nullptr) {
     joinCondition_->clear();
   }
+  if (rangeBounds_ != nullptr) {
+    rangeBounds_->clear();
+  }
+  if (envelopeBounds_ != nullptr) {
+    envelopeBounds_->clear();
+  }
+  lowerBound_.reset();
+  upperBound_.reset();
+  probeMin_ = {};
+  probeMax_ = {};
+  envelopeIndex_.reset();
   buildVectors_.reset();
   Operator::close();
 }
@@ -181,10 +224,124 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   input_ = std::move(input);
   if (input_->size() > 0) {
     probeSideEmpty_ = false;
+    if (range_.has_value() && !isBuildSideEmpty()) {
+      evaluateRangeBounds();
+    } else if (envelope_.has_value() && !isBuildSideEmpty()) {
+      evaluateEnvelopeBounds();
+    }
   }
   VELOX_CHECK_EQ(buildIndex_, 0);
 }
 
+void NestedLoopJoinProbe::evaluateRangeBounds() {
+  SelectivityVector rows(input_->size());
+  std::vector<VectorPtr> results;
+  EvalCtx evalCtx(operatorCtx_->execCtx(), rangeBounds_.get(), input_.get());
+  rangeBounds_->eval(rows, evalCtx, results);
+  auto next = results.begin();
+  lowerBound_ = range_->lower != nullptr ? *next++ : nullptr;
+  upperBound_ = range_->upper != nullptr ? *next++ : nullptr;
+}
+
+void NestedLoopJoinProbe::evaluateEnvelopeBounds() {
+  SelectivityVector rows(input_->size());
+  std::vector<VectorPtr> results;
+  EvalCtx evalCtx(operatorCtx_->execCtx(), envelopeBounds_.get(), input_.get());
+  envelopeBounds_->eval(rows, evalCtx, results);
+  for (auto i = 0; i < NestedLoopJoinEnvelope::kNumDimensions; ++i) {
+    probeMin_[i] = results[2 * i];
+    probeMax_[i] = results[2 * i + 1];
+  }
+}
+
+void NestedLoopJoinProbe::findEnvelopeCandidates() {
+  candidateRanges_.clear();
+  std::array<double, NestedLoopJoinEnvelope::kNumDimensions> min;
+  std::array<double, NestedLoopJoinEnvelope::kNumDimensions> max;
+  bool hasNaN = false;
+  for (auto i = 0; i < NestedLoopJoinEnvelope::kNumDimensions; ++i) {
+    const auto* low = probeMin_[i]->as<SimpleVector<double>>();
+    const auto* high = probeMax_[i]->as<SimpleVector<double>>();
+    // A null end matches no build row.
+    if (low->isNullAt(probeRow_) || high->isNullAt(probeRow_)) {
+      return;
+    }
+    min[i] = low->valueAt(probeRow_);
+    max[i] = high->valueAt(probeRow_);
+    hasNaN |= std::isnan(min[i]) || std::isnan(max[i]);
+  }
+  // NaN is greater than all other values, so a NaN end may match any build
+  // row. Such probe rows are evaluated on the whole build side.
+  if (hasNaN) {
+    if (envelopeIndex_->numRows() > 0) {
+      candidateRanges_.emplace_back(0, envelopeIndex_->numRows());
+    }
+    return;
+  }
+  envelopeIndex_->find(min, max, candidateRanges_);
+}
+
+bool NestedLoopJoinProbe::nextCandidateRange() {
+  if (nextCandidateRange_ >= candidateRanges_.size()) {
+    return false;
+  }
+  std::tie(candidateRow_, candidateEnd_) =
+      candidateRanges_[nextCandidateRange_++];
+  return true;
+}
+
+void NestedLoopJoinProbe::findCandidates(const RowVectorPtr& buildVector) {
+  if (envelope_.has_value()) {
+    hasCandidates_ = true;
+    findEnvelopeCandidates();
+    nextCandidateRange_ = 0;
+    if (!nextCandidateRange()) {
+      candidateRow_ = 0;
+      candidateEnd_ = 0;
+    }
+    return;
+  }
+
+  const auto* key = buildVector->childAt(range_->buildKey).get();
+  // Returns the first non-null build key that is not less than 'bound' at
+  // 'probeRow_', or not less than or equal to it if 'orEqual' is true.
+  const auto firstNotBelow = [&](const VectorPtr& bound, bool orEqual) {
+    vector_size_t begin = 0;
+    vector_size_t end = numBuildKeys_;
+    while (begin < end) {
+      const auto middle = begin + (end - begin) / 2;
+      const auto result =
+          key->compare(bound.get(), middle, probeRow_, CompareFlags{}).value();
+      if (result < 0 || (orEqual && result == 0)) {
+        begin = middle + 1;
+      } else {
+        end = middle;
+      }
+    }
+    return begin;
+  };
+
+  hasCandidates_ = true;
+  candidateRow_ = 0;
+  candidateEnd_ = numBuildKeys_;
+  // A null bound matches no build row.
+  if (lowerBound_ != nullptr) {
+    if (lowerBound_->isNullAt(probeRow_)) {
+      candidateEnd_ = 0;
+      return;
+    }
+    candidateRow_ = firstNotBelow(lowerBound_, !range_->lowerInclusive);
+  }
+  if (upperBound_ != nullptr) {
+    if (upperBound_->isNullAt(probeRow_)) {
+      candidateEnd_ = candidateRow_;
+      return;
+    }
+    candidateEnd_ = std::max(
+        candidateRow_, firstNotBelow(upperBound_, range_->upperInclusive));
+  }
+}
+
 void NestedLoopJoinProbe::noMoreInput() {
   Operator::noMoreInput();
   if (state_ != ProbeOperatorState::kRunning || input_ != nullptr) {
@@ -210,6 +367,20 @@ bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   }
 
   buildVectors_ = std::move(buildData);
+  if (range_.has_value() && !isBuildSideEmpty()) {
+    // NestedLoopJoinBuild::sortDataVectors() puts the null keys last.
+    VELOX_CHECK_EQ(buildVectors_->size(), 1);
+    const auto& key = buildVectors_->front()->childAt(range_->buildKey);
+    numBuildKeys_ = key->size();
+    while (numBuildKeys_ > 0 && key->isNullAt(numBuildKeys_ - 1)) {
+      --numBuildKeys_;
+    }
+  } else if (envelope_.has_value() && !isBuildSideEmpty()) {
+    // NestedLoopJoinBuild::packDataVectors() puts the rows in packing order.
+    VELOX_CHECK_EQ(buildVectors_->size(), 1);
+    envelopeIndex_ = std::make_unique<NestedLoopJoinEnvelopeIndex>(
+        *buildVectors_->front(), *envelope_);
+  }
   return true;
 }
 
@@ -299,6 +470,7 @@ bool NestedLoopJoinProbe::advanceProbe() {
   if (hasProbedAllBuildData()) {
     probeRow_ += probeRowCount_;
     probeRowHasMatch_ = false;
+    hasCandidates_ = false;
     buildIndex_ = 0;
 
     // If we finished processing the probe side.
@@ -362,9 +534,24 @@ bool NestedLoopJoinProbe::addToOutput() {
       return true;
     }
 
-    // Only re-calculate the filter if we have a new build vector.
+    // Only re-calculate the filter if we have a new build vector or a new
+    // batch of candidates from a sorted or packed build vector.
     if (buildRow_ == 0) {
-      evaluateJoinFilter(currentBuild);
+      if (hasCandidateSearch()) {
+        if (!hasCandidates_) {
+          findCandidates(currentBuild);
+        }
+        if (candidateRow_ == candidateEnd_) {
+          ++buildIndex_;
+          continue;
+        }
+        const auto numCandidates = std::min<vector_size_t>(
+            outputBatchSize_, candidateEnd_ - candidateRow_);
+        evaluateJoinFilter(std::static_pointer_cast<RowVector>(
+            currentBuild->slice(candidateRow_, numCandidates)));
+      } else {
+        evaluateJoinFilter(currentBuild);
+      }
     }
 
     // Iterate over the filter results. For each match, add an output record.
@@ -373,7 +560,9 @@ bool NestedLoopJoinProbe::addToOutput() {
         continue;
       }
 
-      addOutputRow(i);
+      // 'candidateRow_' is 0 unless the build side is sorted or packed.
+      const vector_size_t buildRow = candidateRow_ + i;
+      addOutputRow(buildRow);
       ++numOutputRows_;
       probeRowHasMatch_ = true;
 
@@ -410,7 +599,7 @@ bool NestedLoopJoinProbe::addToOutput() {
       // records that got a hit (key match), so that at end we know which
       // build records to add and which to skip.
       if (needsBuildMismatch(joinType_)) {
-        buildMatched_[buildIndex_].setValid(i, true);
+        buildMatched_[buildIndex_].setValid(buildRow, true);
       }
 
       // If the buffer is full, save state and produce it as output.
@@ -423,8 +612,15 @@ bool NestedLoopJoinProbe::addToOutput() {
 
     // Before moving to the next build vector, copy the needed ranges.
     copyBuildValues(currentBuild);
-    ++buildIndex_;
     buildRow_ = 0;
+    if (hasCandidateSearch()) {
+      candidateRow_ += decodedFilterResult_.size();
+      if (candidateRow_ < candidateEnd_ ||
+          (envelope_.has_value() && nextCandidateRange())) {
+        continue;
+      }
+    }
+    ++buildIndex_;
   }
 
   // Check if the current probed row needs to be added as a mismatch (for left
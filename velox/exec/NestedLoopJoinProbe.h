@@ -65,6 +65,20 @@ namespace facebook::velox::exec {
 /// to be copied, then performs the copies in batch, column-by-column. It
 /// produces at most `outputBatchSize_` records, but it may produce fewer since
 /// the output needs to follow the probe vector boundaries.
+///
+/// If QueryConfig::kNestedLoopJoinSortedBuildEnabled is set and the join
+/// condition bounds a build column by expressions over probe columns (see
+/// NestedLoopJoinRange), the build side is a single vector sorted on that
+/// column. Each probe row is then processed as in c), but only over the build
+/// rows between its bounds, which are found by binary search, in batches of at
+/// most `outputBatchSize_` rows.
+///
+/// If QueryConfig::kNestedLoopJoinSpatialIndexEnabled is set and the join
+/// condition tests that build and probe envelopes overlap (see
+/// NestedLoopJoinEnvelope), the build side is a single vector in the packing
+/// order of NestedLoopJoinEnvelopeIndex, which takes precedence over the sorted
+/// build side. Each probe row is then processed over the runs of build rows
+/// whose leaves overlap its envelope, found by searching the index.
 class NestedLoopJoinProbe : public Operator {
  public:
   NestedLoopJoinProbe(
@@ -146,6 +160,32 @@ class NestedLoopJoinProbe : public Operator {
   // by `isJoinConditionMatch(buildRow)` below.
   void evaluateJoinFilter(const RowVectorPtr& buildVector);
 
+  // Evaluates the bounds of 'range_' on 'input_'.
+  void evaluateRangeBounds();
+
+  // Evaluates the ends of the probe envelope of 'envelope_' on 'input_'.
+  void evaluateEnvelopeBounds();
+
+  // True if only some build rows are evaluated per probe row, either by range
+  // search on a sorted build side or by envelope search on a packed one.
+  bool hasCandidateSearch() const {
+    return range_.has_value() || envelope_.has_value();
+  }
+
+  // Sets 'candidateRow_' and 'candidateEnd_' to the rows of the sorted
+  // 'buildVector' between the bounds of 'range_' for 'probeRow_', or to the
+  // first of the ranges of rows of the packed 'buildVector' that may overlap
+  // the envelope of 'probeRow_'.
+  void findCandidates(const RowVectorPtr& buildVector);
+
+  // Sets 'candidateRanges_' to the ranges of build rows that may overlap the
+  // envelope of 'probeRow_'.
+  void findEnvelopeCandidates();
+
+  // Moves 'candidateRow_' and 'candidateEnd_' to the next range of
+  // 'candidateRanges_'. Returns false if there is none.
+  bool nextCandidateRange();
+
   // Checks if the join condition matched for a particular row.
   bool isJoinConditionMatch(vector_size_t i) const {
     return (
@@ -358,9 +398,48 @@ class NestedLoopJoinProbe : public Operator {
   // Index into `buildVectors_` for the build vector being currently processed.
   size_t buildIndex_{0};
 
-  // Row being currently processed from `buildVectors_[buildIndex_]`.
+  // Row being currently processed from `buildVectors_[buildIndex_]`. With a
+  // sorted or packed build side, this is relative to 'candidateRow_'.
   vector_size_t buildRow_{0};
 
+  // Range of the join condition if the build side is sorted on its key.
+  std::optional<NestedLoopJoinRange> range_;
+
+  // Bounds of 'range_' evaluated on 'input_'. Either may be nullptr.
+  std::unique_ptr<ExprSet> rangeBounds_;
+  VectorPtr lowerBound_;
+  VectorPtr upperBound_;
+
+  // Number of leading non-null build keys in the sorted build vector.
+  vector_size_t numBuildKeys_{0};
+
+  // Envelope test of the join condition if the build side is packed on its
+  // envelopes.
+  std::optional<NestedLoopJoinEnvelope> envelope_;
+
+  // Low and high ends of the probe envelope of 'envelope_' evaluated on
+  // 'input_', one per dimension.
+  std::unique_ptr<ExprSet> envelopeBounds_;
+  std::array<VectorPtr, NestedLoopJoinEnvelope::kNumDimensions> probeMin_;
+  std::array<VectorPtr, NestedLoopJoinEnvelope::kNumDimensions> probeMax_;
+
+  // Index over the packed build vector.
+  std::unique_ptr<NestedLoopJoinEnvelopeIndex> envelopeIndex_;
+
+  // Ranges of build rows that may overlap the envelope of 'probeRow_' and the
+  // position of the range after the one in 'candidateRow_' and
+  // 'candidateEnd_'.
+  std::vector<NestedLoopJoinEnvelopeIndex::RowRange> candidateRanges_;
+  size_t nextCandidateRange_{0};
+
+  // Whether 'candidateRow_' and 'candidateEnd_' are set for 'probeRow_'.
+  bool hasCandidates_{false};
+
+  // First build row of the current batch of candidates and the end of the
+  // candidates of 'probeRow_'.
+  vector_size_t candidateRow_{0};
+  vector_size_t candidateEnd_{0};
+
   // Keep track of the build rows that had matches (only used for right or full
   // outer joins).
   std::vector<SelectivityVector> buildMatched_;
@@ -347,6 +347,10 @@ void Operator::close() {
 
 vector_size_t Operator::outputBatchRows(
     std::optional<uint64_t> averageRowSize) const {
+  if (adaptiveOutputBatchRows_.has_value()) {
+    return adaptiveOutputBatchRows_.value();
+  }
+
   const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
   if (!averageRowSize.has_value()) {
     return queryConfig.preferredOutputBatchRows();
@@ -386,6 +390,14 @@ void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
       fmt::format("blocked{}Times", blockReason), RuntimeCounter(1));
 }
 
+uint64_t Operator::reclaimCostNs(uint64_t reclaimableBytes) const {
+  const auto spillStats = spillStats_.copy();
+  if (!spillStats.empty()) {
+    return spillStats.estimateSpillCostNs(reclaimableBytes);
+  }
+  return common::globalSpillStats().estimateSpillCostNs(reclaimableBytes);
+}
+
 void Operator::recordSpillStats() {
   const auto lockedSpillStats = spillStats_.wlock();
   auto lockedStats = stats_.wlock();
@@ -441,6 +453,13 @@ void Operator::recordSpillStats() {
             static_cast<int64_t>(lockedSpillStats->spillWriteTimeNanos),
             RuntimeCounter::Unit::kNanos});
   }
+  if (lockedSpillStats->spillWriteWaitTimeNanos != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillWriteWaitTime,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillWriteWaitTimeNanos),
+            RuntimeCounter::Unit::kNanos});
+  }
   if (lockedSpillStats->spillRuns != 0) {
     lockedStats->addRuntimeStat(
         kSpillRuns,
@@ -726,6 +745,23 @@ bool Operator::MemoryReclaimer::reclaimableBytes(
   return op_->reclaimableBytes(reclaimableBytes);
 }
 
+bool Operator::MemoryReclaimer::reclaimCost(
+    const memory::MemoryPool& pool,
+    uint64_t& reclaimCostNs) const {
+  reclaimCostNs = 0;
+  std::shared_ptr<Driver> driver = ensureDriver();
+  if (FOLLY_UNLIKELY(driver == nullptr)) {
+    return false;
+  }
+  VELOX_CHECK_EQ(pool.name(), op_->pool()->name());
+  uint64_t reclaimableBytes{0};
+  if (!op_->reclaimableBytes(reclaimableBytes)) {
+    return false;
+  }
+  reclaimCostNs = op_->reclaimCostNs(reclaimableBytes);
+  return true;
+}
+
 uint64_t Operator::MemoryReclaimer::reclaim(
     memory::MemoryPool* pool,
     uint64_t targetBytes,
@@ -169,6 +169,8 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillFlushTime{"spillFlushWallNanos"};
   static inline const std::string kSpillWrites{"spillWrites"};
   static inline const std::string kSpillWriteTime{"spillWriteWallNanos"};
+  static inline const std::string kSpillWriteWaitTime{
+      "spillWriteWaitWallNanos"};
   static inline const std::string kSpillRuns{"spillRuns"};
   static inline const std::string kExceededMaxSpillLevel{
       "exceededMaxSpillLevel"};
@@ -188,6 +190,15 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kShuffleCompressionKind{
       "shuffleCompressionKind"};
 
+  /// The hardware counter stats of the addInput() and getOutput() calls
+  /// sampled by the Driver if 'operator_hardware_counter_sample_rate' is set.
+  static inline const std::string kHardwareCycles{"hardwareCycles"};
+  static inline const std::string kHardwareInstructions{
+      "hardwareInstructions"};
+  static inline const std::string kHardwareLlcMisses{"hardwareLlcMisses"};
+  static inline const std::string kHardwareBranchMisses{
+      "hardwareBranchMisses"};
+
   /// 'operatorId' is the initial index of the 'this' in the Driver's list of
   /// Operators. This is used as in index into OperatorStats arrays in the Task.
   /// 'planNodeId' is a query-level unique identifier of the PlanNode to which
@@ -322,6 +333,20 @@ class Operator : public BaseRuntimeStatWriter {
         toString());
   }
 
+  /// Returns true if this operator would accept a limit on its output rows from
+  /// a downstream Limit.
+  virtual bool canAddRowLimit() const {
+    return false;
+  }
+
+  /// Tells this operator that the downstream operators need at most 'numRows'
+  /// more output rows. Called only if canAddRowLimit() returns true. Called
+  /// again with a smaller number as the Limit consumes the output.
+  virtual void addRowLimit(int64_t /*numRows*/) {
+    VELOX_UNSUPPORTED(
+        "This operator doesn't support row limit pushdown: {}", toString());
+  }
+
   /// Returns a list of identity projections, e.g. columns that are projected
   /// as-is possibly after applying a filter. Used to allow pushdown of dynamic
   /// filters generated by HashProbe into the TableScan. Examples of identity
@@ -344,6 +369,12 @@ class Operator : public BaseRuntimeStatWriter {
     return false;
   }
 
+  /// Sets the number of rows returned by outputBatchRows(). Called by the
+  /// Driver if QueryConfig::kAdaptiveOutputBatchRowsEnabled is true.
+  void setAdaptiveOutputBatchRows(vector_size_t rows) {
+    adaptiveOutputBatchRows_ = rows;
+  }
+
   /// Returns copy of operator stats. If 'clear' is true, the function also
   /// clears the operator stats after retrieval.
   virtual OperatorStats stats(bool clear);
@@ -391,6 +422,14 @@ class Operator : public BaseRuntimeStatWriter {
     return reclaimable;
   }
 
+  /// Invoked by the memory arbitrator to get the estimated time in nanoseconds
+  /// for reclaim() to free 'reclaimableBytes'. The default is the time to spill
+  /// them and read them back at the throughput observed by the spills of this
+  /// operator or, if it has not spilled yet, of the process. An operator
+  /// overrides this if its reclaim does not spill or has to rebuild its state
+  /// from the spilled data.
+  virtual uint64_t reclaimCostNs(uint64_t reclaimableBytes) const;
+
   /// Invoked by the memory arbitrator to reclaim memory from this operator with
   /// specified reclaim target bytes. If 'targetBytes' is zero, then it tries to
   /// reclaim all the reclaimable memory from this operator.
@@ -543,6 +582,9 @@ class Operator : public BaseRuntimeStatWriter {
         const memory::MemoryPool& pool,
         uint64_t& reclaimableBytes) const override;
 
+    bool reclaimCost(const memory::MemoryPool& pool, uint64_t& reclaimCostNs)
+        const override;
+
     uint64_t reclaim(
         memory::MemoryPool* pool,
         uint64_t targetBytes,
@@ -611,7 +653,8 @@ class Operator : public BaseRuntimeStatWriter {
   /// number of rows at 10K and returns at least one row. The averageRowSize
   /// must not be negative. If the averageRowSize is 0 which is not advised,
   /// returns maxOutputBatchRows. If the averageRowSize is not given, returns
-  /// preferredOutputBatchRows.
+  /// preferredOutputBatchRows. If the Driver has set an adaptive batch size,
+  /// returns that instead.
   vector_size_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
@@ -667,6 +710,9 @@ class Operator : public BaseRuntimeStatWriter {
   std::unordered_map<column_index_t, std::shared_ptr<common::Filter>>
       dynamicFilters_;
 
+  /// Output batch size set by the Driver. See setAdaptiveOutputBatchRows().
+  std::optional<vector_size_t> adaptiveOutputBatchRows_;
+
  private:
   // Setup 'inputTracer_' to record the processed input vectors.
   void setupInputTracer(const std::string& traceDir);
@@ -410,6 +410,98 @@ void loadColumns(const RowVectorPtr& input, core::ExecCtx& execCtx) {
   }
 }
 
+namespace {
+// Returns a flat copy of the string column 'vector' with the strings in a tight
+// buffer if these take less than 'minUsedRatio' of the string buffers of
+// 'vector', or nullptr otherwise.
+VectorPtr compactStringColumn(
+    const VectorPtr& vector,
+    double minUsedRatio,
+    memory::MemoryPool* pool) {
+  if (vector->typeKind() != TypeKind::VARCHAR &&
+      vector->typeKind() != TypeKind::VARBINARY) {
+    return nullptr;
+  }
+  if (vector->isFlatEncoding()) {
+    auto* flat = vector->asUnchecked<FlatVector<StringView>>();
+    auto copy = std::make_shared<FlatVector<StringView>>(
+        pool,
+        vector->type(),
+        flat->nulls(),
+        flat->size(),
+        flat->values(),
+        std::vector<BufferPtr>(flat->stringBuffers()));
+    return copy->compactStringBuffers(minUsedRatio) ? copy : nullptr;
+  }
+  if (vector->encoding() != VectorEncoding::Simple::DICTIONARY ||
+      isLazyNotLoaded(*vector) || !vector->wrappedVector()->isFlatEncoding()) {
+    return nullptr;
+  }
+
+  const auto* base =
+      vector->wrappedVector()->asUnchecked<FlatVector<StringView>>();
+  uint64_t retainedBytes = 0;
+  for (const auto& buffer : base->stringBuffers()) {
+    retainedBytes += buffer->capacity();
+  }
+  const auto numRows = vector->size();
+  DecodedVector decoded(*vector);
+  uint64_t usedBytes = 0;
+  for (auto row = 0; row < numRows; ++row) {
+    if (!decoded.isNullAt(row)) {
+      const auto value = decoded.valueAt<StringView>(row);
+      if (!value.isInline()) {
+        usedBytes += value.size();
+      }
+    }
+  }
+  if (usedBytes >= retainedBytes * minUsedRatio) {
+    return nullptr;
+  }
+
+  auto flat =
+      BaseVector::create<FlatVector<StringView>>(vector->type(), numRows, pool);
+  auto* rawValues = flat->mutableRawValues();
+  for (auto row = 0; row < numRows; ++row) {
+    if (decoded.isNullAt(row)) {
+      flat->setNull(row, true);
+    } else {
+      rawValues[row] = decoded.valueAt<StringView>(row);
+    }
+  }
+  flat->acquireSharedStringBuffers(vector.get());
+  flat->compactStringBuffers(minUsedRatio);
+  return flat;
+}
+} // namespace
+
+column_index_t compactStringColumns(
+    RowVectorPtr& input,
+    double minUsedRatio,
+    memory::MemoryPool* pool) {
+  if (minUsedRatio <= 0) {
+    return 0;
+  }
+  std::vector<VectorPtr> children;
+  column_index_t numCompacted = 0;
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    auto compacted = compactStringColumn(input->childAt(i), minUsedRatio, pool);
+    if (compacted == nullptr) {
+      continue;
+    }
+    if (children.empty()) {
+      children = input->children();
+    }
+    children[i] = std::move(compacted);
+    ++numCompacted;
+  }
+  if (numCompacted > 0) {
+    input = std::make_shared<RowVector>(
+        pool, input->type(), input->nulls(), input->size(), std::move(children));
+  }
+  return numCompacted;
+}
+
 void gatherCopy(
     RowVector* target,
     vector_size_t targetIndex,
@@ -120,6 +120,16 @@ VectorPtr wrapOne(
 // Ensures that all LazyVectors reachable from 'input' are loaded for all rows.
 void loadColumns(const RowVectorPtr& input, core::ExecCtx& execCtx);
 
+/// Replaces the flat or dictionary encoded string columns of 'input' whose
+/// strings take less than 'minUsedRatio' of the string buffers they reference
+/// with flat columns holding a tight copy of the strings. Replaces 'input'
+/// with a new RowVector if any column is replaced and returns the number of
+/// replaced columns. Used before holding on to 'input' for a long time.
+column_index_t compactStringColumns(
+    RowVectorPtr& input,
+    double minUsedRatio,
+    memory::MemoryPool* pool);
+
 /// Scatter copy from multiple source row vectors into the target row vector.
 /// 'targetIndex' is first row in 'target' to copy to. 'count' specifies how
 /// many rows to copy from the sources. 'sources' and 'sourceIndices' specify
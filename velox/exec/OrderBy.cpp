@@ -42,7 +42,10 @@ OrderBy::OrderBy(
           "OrderBy",
           orderByNode->canSpill(driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
-              : std::nullopt) {
+              : std::nullopt),
+      parallelSortEnabled_(
+          driverCtx->queryConfig().orderByParallelSortEnabled() &&
+          !spillConfig_.has_value()) {
   maxOutputRows_ = outputBatchRows(std::nullopt);
   VELOX_CHECK(pool()->trackUsage());
   std::vector<column_index_t> sortColumnIndices;
@@ -93,13 +96,72 @@ void OrderBy::noMoreInput() {
   Operator::noMoreInput();
   sortBuffer_->noMoreInput();
   maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
+  if (parallelSortEnabled_) {
+    noMoreParallelSortInput();
+  }
+}
+
+void OrderBy::noMoreParallelSortInput() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+  SCOPE_EXIT {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  };
+  if (peers.empty()) {
+    // A single driver returns its sorted input as is.
+    return;
+  }
+
+  std::vector<OrderBy*> orderBys;
+  orderBys.reserve(peers.size() + 1);
+  orderBys.push_back(this);
+  for (auto& peer : peers) {
+    auto* orderBy = dynamic_cast<OrderBy*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(orderBy);
+    orderBys.push_back(orderBy);
+  }
+  std::vector<std::unique_ptr<SortBuffer>> runs;
+  runs.reserve(orderBys.size());
+  for (auto* orderBy : orderBys) {
+    runs.push_back(std::move(orderBy->sortBuffer_));
+  }
+  const auto parallelSort =
+      std::make_shared<const ParallelSort>(std::move(runs), orderBys.size());
+  for (auto* orderBy : orderBys) {
+    orderBy->setParallelSort(parallelSort);
+  }
+}
+
+void OrderBy::setParallelSort(
+    const std::shared_ptr<const ParallelSort>& parallelSort) {
+  const auto range = operatorCtx_->driverCtx()->driverId;
+  rangeMerger_ =
+      std::make_unique<ParallelSort::RangeMerger>(parallelSort, range);
+  maxOutputRows_ = outputBatchRows(parallelSort->estimateOutputRowSize());
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat(
+      kParallelSortRangeRows, RuntimeCounter(parallelSort->numRows(range)));
 }
 
 RowVectorPtr OrderBy::getOutput() {
-  if (finished_ || !noMoreInput_) {
+  if (finished_ || !noMoreInput_ || future_.valid()) {
     return nullptr;
   }
 
+  if (rangeMerger_ != nullptr) {
+    auto output =
+        rangeMerger_->getOutput(maxOutputRows_, outputType_, output_, pool());
+    finished_ = (output == nullptr);
+    return output;
+  }
+
   RowVectorPtr output = sortBuffer_->getOutput(maxOutputRows_);
   finished_ = (output == nullptr);
   return output;
@@ -107,6 +169,8 @@ RowVectorPtr OrderBy::getOutput() {
 
 void OrderBy::close() {
   Operator::close();
+  rangeMerger_.reset();
+  output_.reset();
   sortBuffer_.reset();
 }
 } // namespace facebook::velox::exec
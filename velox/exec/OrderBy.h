@@ -17,6 +17,7 @@
 
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/ParallelSort.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/SortBuffer.h"
 #include "velox/exec/Spiller.h"
@@ -28,6 +29,11 @@ namespace facebook::velox::exec {
 /// to the rows using the RowContainer's compare() function. And finally it
 /// constructs and returns the sorted output RowVector using the data in the
 /// RowContainer.
+///
+/// With 'QueryConfig::kOrderByParallelSortEnabled', the drivers of the
+/// operator sort their inputs on their own and then each returns one key range
+/// of the inputs of all the drivers, see ParallelSort.
+///
 /// Limitations:
 /// * It memcopies twice: 1) input to RowContainer and 2) RowContainer to
 /// output.
@@ -48,7 +54,11 @@ class OrderBy : public Operator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+  BlockingReason isBlocked(ContinueFuture* future) override {
+    if (future_.valid()) {
+      *future = std::move(future_);
+      return BlockingReason::kWaitForProducer;
+    }
     return BlockingReason::kNotBlocked;
   }
 
@@ -61,9 +71,29 @@ class OrderBy : public Operator {
 
   void close() override;
 
+  /// The number of rows of the key range which the driver returns with
+  /// 'QueryConfig::kOrderByParallelSortEnabled'.
+  static inline const std::string kParallelSortRangeRows{
+      "parallelSortRangeRows"};
+
  private:
+  // Waits for the peers to sort their inputs. The last driver to finish moves
+  // the sort buffers of all the drivers into a ParallelSort and lets each
+  // driver merge its key range.
+  void noMoreParallelSortInput();
+
+  // Sets the range of this driver in 'parallelSort'.
+  void setParallelSort(const std::shared_ptr<const ParallelSort>& parallelSort);
+
   std::unique_ptr<SortBuffer> sortBuffer_;
   bool finished_ = false;
   vector_size_t maxOutputRows_;
+
+  // True if the drivers sort in parallel and merge key ranges.
+  const bool parallelSortEnabled_;
+  // Set when all the peers have sorted their inputs.
+  std::unique_ptr<ParallelSort::RangeMerger> rangeMerger_;
+  RowVectorPtr output_;
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
 };
 } // namespace facebook::velox::exec
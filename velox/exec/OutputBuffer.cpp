@@ -92,15 +92,18 @@ void DestinationBuffer::Stats::recordEnqueue(const SerializedPage& data) {
 void DestinationBuffer::Stats::recordAcknowledge(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
-  const int64_t size = data.size();
-  bytesBuffered -= size;
+  recordAcknowledge(data.size(), numRows.value());
+}
+
+void DestinationBuffer::Stats::recordAcknowledge(int64_t bytes, int64_t rows) {
+  bytesBuffered -= bytes;
   VELOX_DCHECK_GE(bytesBuffered, 0, "bytesBuffered must be non-negative");
-  rowsBuffered -= numRows.value();
+  rowsBuffered -= rows;
   VELOX_DCHECK_GE(rowsBuffered, 0, "rowsBuffered must be non-negative");
   --pagesBuffered;
   VELOX_DCHECK_GE(pagesBuffered, 0, "pagesBuffered must be non-negative");
-  bytesSent += size;
-  rowsSent += numRows.value();
+  bytesSent += bytes;
+  rowsSent += rows;
   ++pagesSent;
 }
 
@@ -120,8 +123,9 @@ DestinationBuffer::Data DestinationBuffer::getData(
     loadData(arbitraryBuffer, maxBytes);
   }
 
-  if (sequence - sequence_ >= data_.size()) {
-    if (sequence - sequence_ > data_.size()) {
+  const auto numPages = this->numPages();
+  if (sequence - sequence_ >= numPages) {
+    if (sequence - sequence_ > numPages) {
       VLOG(1) << this << " Out of order get: " << sequence << " over "
               << sequence_ << " Setting second notify " << notifySequence_
               << " / " << sequence;
@@ -137,7 +141,7 @@ DestinationBuffer::Data DestinationBuffer::getData(
     }
     notify_ = std::move(notify);
     aliveCheck_ = std::move(activeCheck);
-    if (sequence - sequence_ > data_.size()) {
+    if (sequence - sequence_ > numPages) {
       notifySequence_ = std::min(notifySequence_, sequence);
     } else {
       notifySequence_ = sequence;
@@ -150,15 +154,21 @@ DestinationBuffer::Data DestinationBuffer::getData(
   uint64_t resultBytes = 0;
   auto i = sequence - sequence_;
   if (maxBytes > 0) {
-    for (; i < data_.size(); ++i) {
+    for (; i < numPages; ++i) {
       // nullptr is used as end marker
-      if (data_[i] == nullptr) {
-        VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
+      if (isEndMarker(i)) {
+        VELOX_CHECK_EQ(i, numPages - 1, "null marker found in the middle");
         data.push_back(nullptr);
         break;
       }
-      data.push_back(data_[i]->getIOBuf());
-      resultBytes += data_[i]->size();
+      const auto page = pageAt(i);
+      if (page == nullptr) {
+        // The page is spilled and not read back yet. It is reported in the
+        // remaining bytes and read back when fetched again.
+        break;
+      }
+      data.push_back(page->getIOBuf());
+      resultBytes += page->size();
       if (resultBytes >= maxBytes) {
         ++i;
         break;
@@ -167,14 +177,14 @@ DestinationBuffer::Data DestinationBuffer::getData(
   }
   bool atEnd = false;
   std::vector<int64_t> remainingBytes;
-  remainingBytes.reserve(data_.size() - i);
-  for (; i < data_.size(); ++i) {
-    if (data_[i] == nullptr) {
-      VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
+  remainingBytes.reserve(numPages - i);
+  for (; i < numPages; ++i) {
+    if (isEndMarker(i)) {
+      VELOX_CHECK_EQ(i, numPages - 1, "null marker found in the middle");
       atEnd = true;
       break;
     }
-    remainingBytes.push_back(data_[i]->size());
+    remainingBytes.push_back(pageBytes(i));
   }
   if (!atEnd && arbitraryBuffer) {
     arbitraryBuffer->getAvailablePageSizes(remainingBytes);
@@ -197,6 +207,163 @@ void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
   data_.push_back(std::move(data));
 }
 
+bool DestinationBuffer::isEndMarker(int64_t index) const {
+  return index >= spilledPages_.size() &&
+      data_[index - spilledPages_.size()] == nullptr;
+}
+
+int64_t DestinationBuffer::pageBytes(int64_t index) const {
+  if (index < spilledPages_.size()) {
+    return spilledPages_[index].bytes;
+  }
+  return data_[index - spilledPages_.size()]->size();
+}
+
+std::shared_ptr<SerializedPage> DestinationBuffer::pageAt(int64_t index) {
+  if (index >= spilledPages_.size()) {
+    return data_[index - spilledPages_.size()];
+  }
+  if (readingBack_ || !spilledPages_[index].readBack) {
+    return nullptr;
+  }
+  for (auto& run : spillRuns_) {
+    if (index < run.numPages) {
+      return run.reader->at(run.numDeleted + index);
+    }
+    index -= run.numPages;
+  }
+  VELOX_UNREACHABLE();
+}
+
+void DestinationBuffer::deleteSpilledPages(int64_t numPages) {
+  VELOX_CHECK_LE(numPages, spilledPages_.size());
+  for (auto i = 0; i < numPages; ++i) {
+    const auto& page = spilledPages_[i];
+    stats_.recordAcknowledge(page.bytes, page.rows);
+    spilledBytes_ -= page.bytes;
+    if (page.readBack) {
+      ++freedReadBackPages_.numPages;
+      freedReadBackPages_.bytes += page.bytes;
+    }
+  }
+  spilledPages_.erase(spilledPages_.begin(), spilledPages_.begin() + numPages);
+
+  while (numPages > 0) {
+    auto& run = spillRuns_.front();
+    if (numPages >= run.numPages) {
+      numPages -= run.numPages;
+      spillRuns_.pop_front();
+      continue;
+    }
+    run.numDeleted += numPages;
+    run.numPages -= numPages;
+    numPages = 0;
+    // The pages read back are deleted right away to free their memory.
+    if (!readingBack_ && run.numDeleted <= run.reader->numBufferedPages()) {
+      run.reader->deleteFront(run.numDeleted);
+      run.numDeleted = 0;
+    }
+  }
+}
+
+std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::startSpill()
+    const {
+  // The end marker stays in memory.
+  const auto numPages =
+      (!data_.empty() && data_.back() == nullptr) ? data_.size() - 1
+                                                  : data_.size();
+  return {data_.begin(), data_.begin() + numPages};
+}
+
+std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::finishSpill(
+    const std::vector<std::shared_ptr<SerializedPage>>& pages,
+    std::shared_ptr<SerializedPageSpillReader> reader) {
+  // The pages acknowledged while being written are at the front of 'pages'.
+  // The others are at the front of 'data_'.
+  const auto firstPage = std::find(
+      pages.begin(), pages.end(), data_.empty() ? nullptr : data_.front());
+  const uint64_t numDeleted = firstPage - pages.begin();
+  const auto numPages = pages.size() - numDeleted;
+  if (numPages == 0) {
+    return {};
+  }
+  VELOX_CHECK_LE(numPages, data_.size());
+  std::vector<std::shared_ptr<SerializedPage>> spilled;
+  spilled.reserve(numPages);
+  for (auto i = 0; i < numPages; ++i) {
+    VELOX_CHECK(data_[i] == pages[numDeleted + i]);
+    const auto& page = data_[i];
+    spilledPages_.push_back({page->size(), page->numRows().value()});
+    spilledBytes_ += page->size();
+    spilled.push_back(std::move(data_[i]));
+  }
+  data_.erase(data_.begin(), data_.begin() + numPages);
+  spillRuns_.push_back({std::move(reader), numDeleted, numPages});
+  return spilled;
+}
+
+void DestinationBuffer::ReadBack::read() const {
+  reader->deleteFront(numDeleted);
+  reader->at(lastIndex);
+}
+
+DestinationBuffer::ReadBack DestinationBuffer::startReadBack(
+    uint64_t maxBytes,
+    int64_t sequence) {
+  const auto index = sequence - sequence_;
+  if (readingBack_ || maxBytes == 0 || index < 0 ||
+      index >= spilledPages_.size() || spilledPages_[index].readBack) {
+    return {};
+  }
+  int64_t runStart = 0;
+  for (auto& run : spillRuns_) {
+    const int64_t runEnd = runStart + run.numPages;
+    if (index >= runEnd) {
+      runStart = runEnd;
+      continue;
+    }
+    // Reads back up to 'maxBytes' from the run of 'index'.
+    auto lastIndex = index;
+    uint64_t bytes = spilledPages_[lastIndex].bytes;
+    while (bytes < maxBytes && lastIndex + 1 < runEnd) {
+      bytes += spilledPages_[++lastIndex].bytes;
+    }
+    ReadBack readBack{
+        run.reader,
+        run.numDeleted,
+        static_cast<uint64_t>(lastIndex - runStart)};
+    run.numDeleted = 0;
+    readingBack_ = true;
+    return readBack;
+  }
+  VELOX_UNREACHABLE();
+}
+
+DestinationBuffer::ReadBackPages DestinationBuffer::finishReadBack() {
+  VELOX_CHECK(readingBack_);
+  readingBack_ = false;
+  ReadBackPages readBackPages;
+  int64_t runStart = 0;
+  for (const auto& run : spillRuns_) {
+    const auto numBuffered = std::min(
+        run.reader->numBufferedPages(), run.numDeleted + run.numPages);
+    for (auto i = run.numDeleted; i < numBuffered; ++i) {
+      auto& page = spilledPages_[runStart + i - run.numDeleted];
+      if (!page.readBack) {
+        page.readBack = true;
+        ++readBackPages.numPages;
+        readBackPages.bytes += page.bytes;
+      }
+    }
+    runStart += run.numPages;
+  }
+  return readBackPages;
+}
+
+DestinationBuffer::ReadBackPages DestinationBuffer::takeFreedReadBackPages() {
+  return std::exchange(freedReadBackPages_, ReadBackPages{});
+}
+
 DataAvailable DestinationBuffer::getAndClearNotify() {
   if (notify_ == nullptr) {
     VELOX_CHECK_NULL(aliveCheck_);
@@ -221,7 +388,9 @@ void DestinationBuffer::clearNotify() {
 
 void DestinationBuffer::finish() {
   VELOX_CHECK_NULL(notify_, "notify must be cleared before finish");
-  VELOX_CHECK(data_.empty(), "data must be fetched before finish");
+  VELOX_CHECK(
+      data_.empty() && spilledPages_.empty(),
+      "data must be fetched before finish");
   stats_.finished = true;
 }
 
@@ -267,9 +436,14 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
   }
 
   VELOX_CHECK_LE(
-      numDeleted, data_.size(), "Ack received for a not yet produced item");
+      numDeleted, numPages(), "Ack received for a not yet produced item");
+  // The spilled pages are not in memory, so they are not returned to be freed.
+  const int64_t numSpilledDeleted =
+      std::min<int64_t>(numDeleted, spilledPages_.size());
+  deleteSpilledPages(numSpilledDeleted);
+  const int64_t numMemoryDeleted = numDeleted - numSpilledDeleted;
   std::vector<std::shared_ptr<SerializedPage>> freed;
-  for (auto i = 0; i < numDeleted; ++i) {
+  for (auto i = 0; i < numMemoryDeleted; ++i) {
     if (data_[i] == nullptr) {
       VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
       break;
@@ -277,13 +451,14 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
     stats_.recordAcknowledge(*data_[i]);
     freed.push_back(std::move(data_[i]));
   }
-  data_.erase(data_.begin(), data_.begin() + numDeleted);
+  data_.erase(data_.begin(), data_.begin() + numMemoryDeleted);
   sequence_ += numDeleted;
   return freed;
 }
 
 std::vector<std::shared_ptr<SerializedPage>>
 DestinationBuffer::deleteResults() {
+  deleteSpilledPages(spilledPages_.size());
   std::vector<std::shared_ptr<SerializedPage>> freed;
   for (auto i = 0; i < data_.size(); ++i) {
     if (data_[i] == nullptr) {
@@ -303,8 +478,10 @@ DestinationBuffer::Stats DestinationBuffer::stats() const {
 
 std::string DestinationBuffer::toString() {
   std::stringstream out;
-  out << "[available: " << data_.size() << ", " << "sequence: " << sequence_
-      << ", " << (notify_ ? "notify registered, " : "") << this << "]";
+  out << "[available: " << numPages() << ", "
+      << "spilled: " << spilledPages_.size() << ", "
+      << "sequence: " << sequence_ << ", "
+      << (notify_ ? "notify registered, " : "") << this << "]";
   return out.str();
 }
 
@@ -335,6 +512,11 @@ OutputBuffer::OutputBuffer(
       continueSize_((maxSize_ * kContinuePct) / 100),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
+      spillEnabled_(
+          isPartitioned() && task_->queryCtx()->queryConfig().spillEnabled() &&
+          task_->queryCtx()->queryConfig().outputBufferSpillEnabled() &&
+          (!task_->spillDirectory().empty() ||
+           task_->hasCreateSpillDirectoryCb())),
       numDrivers_(numDrivers) {
   buffers_.reserve(numDestinations);
   for (int i = 0; i < numDestinations; i++) {
@@ -366,7 +548,7 @@ void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
 
     noMoreBuffers_ = true;
     isFinished = isFinishedLocked();
-    updateAfterAcknowledgeLocked(dataToBroadcast_, promises);
+    updateAfterAcknowledgeLocked(dataToBroadcast_, {}, promises);
   }
 
   releaseAfterAcknowledge(dataToBroadcast_, promises);
@@ -451,6 +633,7 @@ bool OutputBuffer::enqueue(
   VELOX_CHECK(
       task_->isRunning(), "Task is terminated, cannot add data to output.");
   std::vector<DataAvailable> dataAvailableCallbacks;
+  std::vector<SpillVictim> spillVictims;
   bool blocked = false;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -475,7 +658,12 @@ bool OutputBuffer::enqueue(
         VELOX_UNREACHABLE(PartitionedOutputNode::kindString(kind_));
     }
 
-    if (bufferedBytes_ >= maxSize_ && future) {
+    if (bufferedBytes_ >= maxSize_ && spillEnabled_) {
+      spillVictims = pickSpillVictimsLocked();
+    }
+
+    // The producer which spills is not blocked.
+    if (bufferedBytes_ >= maxSize_ && spillVictims.empty() && future) {
       common::testutil::TestValue::adjust(
           "facebook::velox::exec::OutputBuffer::enqueue", this);
 
@@ -490,9 +678,123 @@ bool OutputBuffer::enqueue(
     callback.notify();
   }
 
+  if (!spillVictims.empty()) {
+    spill(spillVictims);
+  }
+
   return blocked;
 }
 
+std::vector<OutputBuffer::SpillVictim> OutputBuffer::pickSpillVictimsLocked() {
+  VELOX_CHECK(isPartitioned());
+  if (spilling_) {
+    return {};
+  }
+  std::vector<int> destinations;
+  for (auto i = 0; i < buffers_.size(); ++i) {
+    if (buffers_[i] != nullptr && buffers_[i]->memoryBytes() > 0) {
+      destinations.push_back(i);
+    }
+  }
+  std::sort(
+      destinations.begin(), destinations.end(), [&](auto left, auto right) {
+        return buffers_[left]->memoryBytes() > buffers_[right]->memoryBytes();
+      });
+
+  if (spillPool_ == nullptr) {
+    spillPool_ = task_->pool()->addLeafChild("outputBufferSpill");
+    updateAndCheckSpillLimitCb_ = [task = task_.get()](uint64_t bytes) {
+      task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
+    };
+  }
+  std::vector<SpillVictim> victims;
+  auto bufferedBytes = bufferedBytes_;
+  for (auto destination : destinations) {
+    if (bufferedBytes < continueSize_) {
+      break;
+    }
+    auto* buffer = buffers_[destination].get();
+    auto pages = buffer->startSpill();
+    if (pages.empty()) {
+      continue;
+    }
+    for (const auto& page : pages) {
+      bufferedBytes -= page->size();
+    }
+    victims.push_back(
+        {destination,
+         buffer,
+         std::move(pages),
+         fmt::format(
+             "{}/outputBuffer_{}",
+             task_->getOrCreateSpillDirectory(),
+             numSpills_++)});
+  }
+  spilling_ = !victims.empty();
+  return victims;
+}
+
+void OutputBuffer::spill(const std::vector<SpillVictim>& victims) {
+  const auto& queryConfig = task_->queryCtx()->queryConfig();
+  std::vector<std::shared_ptr<SerializedPageSpillReader>> readers;
+  std::exception_ptr error;
+  try {
+    for (const auto& victim : victims) {
+      common::testutil::TestValue::adjust(
+          "facebook::velox::exec::OutputBuffer::spill", this);
+      SerializedPageSpiller spiller(
+          queryConfig.spillWriteBufferSize(),
+          queryConfig.maxSpillFileSize(),
+          victim.pathPrefix,
+          queryConfig.spillFileCreateConfig(),
+          updateAndCheckSpillLimitCb_,
+          spillPool_.get(),
+          &spillStats_);
+      spiller.spill(victim.pages);
+      readers.push_back(std::make_shared<SerializedPageSpillReader>(
+          spiller.finishSpill(),
+          queryConfig.spillReadBufferSize(),
+          spillPool_.get(),
+          &spillStats_));
+    }
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  std::vector<std::shared_ptr<SerializedPage>> freed;
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(spilling_);
+    spilling_ = false;
+    // The victims not written due to an error stay in memory.
+    for (auto i = 0; i < readers.size(); ++i) {
+      const auto& victim = victims[i];
+      // The buffer is destroyed if its results have been deleted meanwhile.
+      if (buffers_[victim.destination].get() != victim.buffer) {
+        continue;
+      }
+      const auto spilled =
+          victim.buffer->finishSpill(victim.pages, std::move(readers[i]));
+      int64_t spilledBytes{0};
+      for (const auto& page : spilled) {
+        spilledBytes += page->size();
+      }
+      numSpilledBytes_ += spilledBytes;
+      numSpilledPages_ += spilled.size();
+      updateStatsWithFreedPagesLocked(spilled.size(), spilledBytes);
+      freed.insert(freed.end(), spilled.begin(), spilled.end());
+    }
+    if (bufferedBytes_ < continueSize_) {
+      promises = std::move(promises_);
+    }
+  }
+  releaseAfterAcknowledge(freed, promises);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
 void OutputBuffer::enqueueBroadcastOutputLocked(
     std::unique_ptr<SerializedPage> data,
     std::vector<DataAvailable>& dataAvailableCbs) {
@@ -645,16 +947,18 @@ void OutputBuffer::acknowledge(int destination, int64_t sequence) {
       return;
     }
     freed = buffer->acknowledge(sequence, false);
-    updateAfterAcknowledgeLocked(freed, promises);
+    updateAfterAcknowledgeLocked(
+        freed, buffer->takeFreedReadBackPages(), promises);
   }
   releaseAfterAcknowledge(freed, promises);
 }
 
 void OutputBuffer::updateAfterAcknowledgeLocked(
     const std::vector<std::shared_ptr<SerializedPage>>& freed,
+    const DestinationBuffer::ReadBackPages& freedReadBack,
     std::vector<ContinuePromise>& promises) {
-  uint64_t freedBytes{0};
-  int freedPages{0};
+  uint64_t freedBytes = freedReadBack.bytes;
+  int freedPages = freedReadBack.numPages;
   for (const auto& free : freed) {
     if (free.use_count() == 1) {
       ++freedPages;
@@ -688,6 +992,7 @@ bool OutputBuffer::deleteResults(int destination) {
       return false;
     }
     freed = buffer->deleteResults();
+    const auto freedReadBack = buffer->takeFreedReadBackPages();
     dataAvailable = buffer->getAndClearNotify();
     buffer->finish();
     VELOX_CHECK_LT(destination, finishedBufferStats_.size());
@@ -695,7 +1000,7 @@ bool OutputBuffer::deleteResults(int destination) {
     buffers_[destination] = nullptr;
     ++numFinalAcknowledges_;
     isFinished = isFinishedLocked();
-    updateAfterAcknowledgeLocked(freed, promises);
+    updateAfterAcknowledgeLocked(freed, freedReadBack, promises);
   }
 
   // Outside of mutex.
@@ -721,6 +1026,8 @@ void OutputBuffer::getData(
   DestinationBuffer::Data data;
   std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
+  DestinationBuffer* buffer;
+  DestinationBuffer::ReadBack readBack;
   {
     std::lock_guard<std::mutex> l(mutex_);
 
@@ -729,12 +1036,16 @@ void OutputBuffer::getData(
     }
 
     VELOX_CHECK_LT(destination, buffers_.size());
-    auto* buffer = buffers_[destination].get();
+    buffer = buffers_[destination].get();
     if (buffer) {
       freed = buffer->acknowledge(sequence, true);
-      updateAfterAcknowledgeLocked(freed, promises);
-      data = buffer->getData(
-          maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
+      updateAfterAcknowledgeLocked(
+          freed, buffer->takeFreedReadBackPages(), promises);
+      readBack = buffer->startReadBack(maxBytes, sequence);
+      if (readBack.reader == nullptr) {
+        data = buffer->getData(
+            maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
+      }
     } else {
       data.data.emplace_back(nullptr);
       data.immediate = true;
@@ -743,11 +1054,50 @@ void OutputBuffer::getData(
     }
   }
   releaseAfterAcknowledge(freed, promises);
+
+  if (readBack.reader != nullptr) {
+    readBackSpilledPages(destination, buffer, readBack);
+    std::lock_guard<std::mutex> l(mutex_);
+    buffer = buffers_[destination].get();
+    if (buffer) {
+      data = buffer->getData(
+          maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
+    } else {
+      data.data.emplace_back(nullptr);
+      data.immediate = true;
+    }
+  }
+
   if (data.immediate) {
     notify(std::move(data.data), sequence, std::move(data.remainingBytes));
   }
 }
 
+void OutputBuffer::readBackSpilledPages(
+    int destination,
+    DestinationBuffer* buffer,
+    const DestinationBuffer::ReadBack& readBack) {
+  std::exception_ptr error;
+  try {
+    readBack.read();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    // 'buffer' is destroyed if its results have been deleted meanwhile.
+    if (buffers_[destination].get() == buffer) {
+      const auto readBackPages = buffer->finishReadBack();
+      updateTotalBufferedBytesMsLocked();
+      bufferedBytes_ += readBackPages.bytes;
+      bufferedPages_ += readBackPages.numPages;
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
 void OutputBuffer::terminate() {
   VELOX_CHECK(!task_->isRunning());
 
@@ -848,7 +1198,7 @@ OutputBuffer::Stats OutputBuffer::stats() {
 
   updateTotalBufferedBytesMsLocked();
 
-  return OutputBuffer::Stats(
+  OutputBuffer::Stats result(
       kind_,
       noMoreBuffers_,
       atEnd_,
@@ -861,6 +1211,9 @@ OutputBuffer::Stats OutputBuffer::stats() {
       getAverageBufferTimeMsLocked(),
       countTopBuffers(bufferStats, numOutputBytes_),
       bufferStats);
+  result.spilledBytes = numSpilledBytes_;
+  result.spilledPages = numSpilledPages_;
+  return result;
 }
 
 } // namespace facebook::velox::exec
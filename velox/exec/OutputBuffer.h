@@ -17,6 +17,7 @@
 
 #include "velox/core/PlanNode.h"
 #include "velox/exec/ExchangeQueue.h"
+#include "velox/exec/SerializedPageSpiller.h"
 
 namespace facebook::velox::exec {
 
@@ -104,6 +105,8 @@ class DestinationBuffer {
 
     void recordDelete(const SerializedPage& data);
 
+    void recordAcknowledge(int64_t bytes, int64_t rows);
+
     bool finished{false};
 
     /// Number of buffered bytes / rows / pages.
@@ -119,6 +122,58 @@ class DestinationBuffer {
 
   void enqueue(std::shared_ptr<SerializedPage> data);
 
+  /// Returns the bytes of the buffered pages which are in memory.
+  int64_t memoryBytes() const {
+    return stats_.bytesBuffered - spilledBytes_;
+  }
+
+  /// Returns the buffered pages which are in memory for the caller to write
+  /// to disk outside of the output buffer lock. The pages stay in this buffer
+  /// and can be fetched and acknowledged until finishSpill() is called.
+  std::vector<std::shared_ptr<SerializedPage>> startSpill() const;
+
+  /// Replaces 'pages' returned by startSpill() with the spilled pages in
+  /// 'reader', which are read back when fetched. The pages acknowledged while
+  /// being written are dropped from 'reader'. The order of the pages and their
+  /// sequence numbers do not change. Returns the pages removed from memory for
+  /// the caller to free.
+  std::vector<std::shared_ptr<SerializedPage>> finishSpill(
+      const std::vector<std::shared_ptr<SerializedPage>>& pages,
+      std::shared_ptr<SerializedPageSpillReader> reader);
+
+  /// The number of pages and bytes read back from disk.
+  struct ReadBackPages {
+    int64_t numPages{0};
+    int64_t bytes{0};
+  };
+
+  /// Spilled pages to read back outside of the output buffer lock.
+  struct ReadBack {
+    std::shared_ptr<SerializedPageSpillReader> reader;
+    /// The number of acknowledged pages to delete from the front of 'reader'
+    /// first.
+    uint64_t numDeleted{0};
+    /// The index in 'reader' of the last page to read back after the delete.
+    uint64_t lastIndex{0};
+
+    /// Reads the pages from disk.
+    void read() const;
+  };
+
+  /// Returns the spilled pages to read back for a getData() of up to
+  /// 'maxBytes' at 'sequence'. Returns a null 'reader' if the pages are in
+  /// memory or another read back is in progress. Otherwise, the spilled pages
+  /// are not accessed until finishReadBack() is called.
+  ReadBack startReadBack(uint64_t maxBytes, int64_t sequence);
+
+  /// Ends the read back from startReadBack(). Returns the pages which have
+  /// been read back into memory.
+  ReadBackPages finishReadBack();
+
+  /// Returns and resets the pages read back into memory which have been
+  /// acknowledged or deleted since the last call.
+  ReadBackPages takeFreedReadBackPages();
+
   /// Invoked to load data with up to 'notifyMaxBytes_' bytes from arbitrary
   /// 'buffer' if there is pending fetch from this destination in which case
   /// 'notify_' is not null. Otherwise, it does nothing. This only used by
@@ -184,11 +239,67 @@ class DestinationBuffer {
 
   std::string toString();
 
+  /// Returns the number of buffered pages which are spilled.
+  int64_t numSpilledPages() const {
+    return spilledPages_.size();
+  }
+
  private:
+  struct SpilledPage {
+    int64_t bytes;
+    int64_t rows;
+    // True if the page has been read back into memory.
+    bool readBack{false};
+  };
+
+  // The pages spilled together and the reader to read them back.
+  struct SpillRun {
+    std::shared_ptr<SerializedPageSpillReader> reader;
+    // The number of pages at the front of 'reader' which are deleted from this
+    // buffer but not from 'reader'. Deleting pages which are not read back
+    // reads them from disk, which is left to the next read back outside of the
+    // output buffer lock.
+    uint64_t numDeleted{0};
+    // The number of pages of this run in the buffer, which follow the deleted
+    // ones in 'reader'. Kept here as 'reader' may be read back concurrently.
+    uint64_t numPages{0};
+  };
+
   void clearNotify();
 
+  // Returns the number of buffered pages, spilled and in memory, including
+  // the end marker.
+  int64_t numPages() const {
+    return spilledPages_.size() + data_.size();
+  }
+
+  // Returns true if the page at 'index' is the end marker.
+  bool isEndMarker(int64_t index) const;
+
+  // Returns the bytes of the page at 'index' without reading it back if
+  // spilled.
+  int64_t pageBytes(int64_t index) const;
+
+  // Returns the page at 'index'. Returns nullptr if the page is spilled and
+  // not read back.
+  std::shared_ptr<SerializedPage> pageAt(int64_t index);
+
+  // Removes the first 'numPages' spilled pages and records them as sent.
+  void deleteSpilledPages(int64_t numPages);
+
   std::vector<std::shared_ptr<SerializedPage>> data_;
-  // The sequence number of the first in 'data_'.
+  // The spilled pages, which precede 'data_'. Each spill appends a run for
+  // the pages in 'data_' at the time.
+  std::deque<SpillRun> spillRuns_;
+  // The sizes of the pages in 'spillRuns_' in order, so that they can be
+  // reported without reading the pages back.
+  std::deque<SpilledPage> spilledPages_;
+  int64_t spilledBytes_{0};
+  // True while the pages of a spill run are read back outside of the output
+  // buffer lock. The readers in 'spillRuns_' are not accessed meanwhile.
+  bool readingBack_{false};
+  ReadBackPages freedReadBackPages_;
+  // The sequence number of the first in 'spilledPages_' or 'data_'.
   int64_t sequence_ = 0;
   DataAvailableCallback notify_{nullptr};
   DataConsumerActiveCheckCallback aliveCheck_{nullptr};
@@ -254,6 +365,10 @@ class OutputBuffer {
     /// Stats of the OutputBuffer's destinations.
     std::vector<DestinationBuffer::Stats> buffersStats;
 
+    /// The total number of bytes / pages spilled to disk under backpressure.
+    int64_t spilledBytes{0};
+    int64_t spilledPages{0};
+
     std::string toString() const;
   };
 
@@ -335,6 +450,32 @@ class OutputBuffer {
 
   void updateTotalBufferedBytesMsLocked();
 
+  // The in-memory pages of a destination buffer picked to spill under
+  // 'mutex_' and written to disk outside of it.
+  struct SpillVictim {
+    int destination;
+    DestinationBuffer* buffer;
+    std::vector<std::shared_ptr<SerializedPage>> pages;
+    std::string pathPrefix;
+  };
+
+  // Picks the destination buffers with the most pages in memory until the
+  // buffered bytes would go below 'continueSize_', so that the producers can
+  // keep going while the consumers are slow. Returns an empty vector if a
+  // spill is already in progress.
+  std::vector<SpillVictim> pickSpillVictimsLocked();
+
+  // Writes 'victims' to disk outside of 'mutex_' and then replaces their pages
+  // in memory with the spilled pages.
+  void spill(const std::vector<SpillVictim>& victims);
+
+  // Reads back the spilled pages of 'buffer' outside of 'mutex_' and counts
+  // them in the buffered bytes.
+  void readBackSpilledPages(
+      int destination,
+      DestinationBuffer* buffer,
+      const DestinationBuffer::ReadBack& readBack);
+
   int64_t getAverageBufferTimeMsLocked() const;
 
   // If this is called due to a driver processed all its data (no more data),
@@ -343,9 +484,11 @@ class OutputBuffer {
   void checkIfDone(bool oneDriverFinished);
 
   // Updates buffered size and returns possibly continuable producer promises
-  // in 'promises'.
+  // in 'promises'. 'freedReadBack' are the freed pages which were spilled and
+  // read back, see DestinationBuffer::takeFreedReadBackPages().
   void updateAfterAcknowledgeLocked(
       const std::vector<std::shared_ptr<SerializedPage>>& freed,
+      const DestinationBuffer::ReadBackPages& freedReadBack,
       std::vector<ContinuePromise>& promises);
 
   /// Given an updated total number of broadcast buffers, add any missing ones
@@ -388,6 +531,9 @@ class OutputBuffer {
   // resumed.
   const uint64_t continueSize_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
+  // True if the pages of a partitioned output buffer are spilled instead of
+  // blocking the producers, see QueryConfig::kOutputBufferSpillEnabled.
+  const bool spillEnabled_;
 
   // Total number of drivers expected to produce results. This number will
   // decrease in the end of grouped execution, when we understand the real
@@ -433,6 +579,16 @@ class OutputBuffer {
 
   // Total time data is buffered as bytes * time.
   double totalBufferedBytesMs_;
+
+  // The pool for reading back the spilled pages. Created on first spill.
+  std::shared_ptr<memory::MemoryPool> spillPool_;
+  common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
+  folly::Synchronized<common::SpillStats> spillStats_;
+  uint32_t numSpills_{0};
+  // True while the pages picked by pickSpillVictimsLocked() are written.
+  bool spilling_{false};
+  int64_t numSpilledBytes_{0};
+  int64_t numSpilledPages_{0};
 };
 
 } // namespace facebook::velox::exec
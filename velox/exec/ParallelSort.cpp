@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/ParallelSort.h"
+
+namespace facebook::velox::exec {
+
+ParallelSort::ParallelSort(
+    std::vector<std::unique_ptr<SortBuffer>> runs,
+    int32_t numRanges)
+    : runs_(std::move(runs)), numRanges_(numRanges) {
+  VELOX_CHECK(!runs_.empty());
+  VELOX_CHECK_GT(numRanges_, 0);
+
+  const auto splitters = sampleSplitters();
+  const auto* compareRun = runs_[0].get();
+  bounds_.resize(runs_.size());
+  for (auto i = 0; i < runs_.size(); ++i) {
+    const auto& rows = runs_[i]->sortedRows();
+    auto& bounds = bounds_[i];
+    bounds.reserve(numRanges_ + 1);
+    bounds.push_back(0);
+    // The rows equal to a splitter go to the range after it in all the runs.
+    for (auto* splitter : splitters) {
+      const auto it = std::lower_bound(
+          rows.begin() + bounds.back(),
+          rows.end(),
+          splitter,
+          [&](const char* row, const char* key) {
+            return compareRun->compareRows(row, key) < 0;
+          });
+      bounds.push_back(it - rows.begin());
+    }
+    bounds.resize(numRanges_ + 1, rows.size());
+  }
+}
+
+std::vector<char*> ParallelSort::sampleSplitters() const {
+  if (numRanges_ == 1) {
+    return {};
+  }
+  std::vector<char*> samples;
+  for (const auto& run : runs_) {
+    const auto& rows = run->sortedRows();
+    const uint64_t numSamples =
+        std::min<uint64_t>(rows.size(), numRanges_ * kSamplesPerRange);
+    for (uint64_t i = 0; i < numSamples; ++i) {
+      // Takes the row in the middle of each of 'numSamples' equal parts.
+      samples.push_back(rows[(2 * i + 1) * rows.size() / (2 * numSamples)]);
+    }
+  }
+  if (samples.empty()) {
+    return {};
+  }
+  const auto* compareRun = runs_[0].get();
+  std::sort(samples.begin(), samples.end(), [&](char* left, char* right) {
+    return compareRun->compareRows(left, right) < 0;
+  });
+
+  std::vector<char*> splitters;
+  splitters.reserve(numRanges_ - 1);
+  for (auto i = 1; i < numRanges_; ++i) {
+    splitters.push_back(samples[i * samples.size() / numRanges_]);
+  }
+  return splitters;
+}
+
+uint64_t ParallelSort::numRows(int32_t range) const {
+  VELOX_CHECK_LT(range, numRanges_);
+  uint64_t numRows{0};
+  for (const auto& bounds : bounds_) {
+    numRows += bounds[range + 1] - bounds[range];
+  }
+  return numRows;
+}
+
+std::optional<uint64_t> ParallelSort::estimateOutputRowSize() const {
+  std::optional<uint64_t> rowSize;
+  for (const auto& run : runs_) {
+    const auto runRowSize = run->estimateOutputRowSize();
+    if (runRowSize.has_value() &&
+        (!rowSize.has_value() || runRowSize.value() > rowSize.value())) {
+      rowSize = runRowSize;
+    }
+  }
+  return rowSize;
+}
+
+ParallelSort::RangeMerger::RangeMerger(
+    std::shared_ptr<const ParallelSort> sort,
+    int32_t range)
+    : sort_(std::move(sort)), numRows_(sort_->numRows(range)) {
+  std::vector<std::unique_ptr<RunStream>> streams;
+  for (auto i = 0; i < sort_->runs_.size(); ++i) {
+    const auto begin = sort_->bounds_[i][range];
+    const auto end = sort_->bounds_[i][range + 1];
+    if (begin == end) {
+      continue;
+    }
+    const auto* rows = sort_->runs_[i]->sortedRows().data();
+    streams.push_back(std::make_unique<RunStream>(
+        sort_->runs_[i].get(), rows + begin, rows + end));
+  }
+  if (!streams.empty()) {
+    merger_ = std::make_unique<TreeOfLosers<RunStream>>(std::move(streams));
+  }
+}
+
+RowVectorPtr ParallelSort::RangeMerger::getOutput(
+    vector_size_t maxRows,
+    const RowTypePtr& outputType,
+    RowVectorPtr& output,
+    memory::MemoryPool* pool) {
+  if (numOutputRows_ == numRows_) {
+    return nullptr;
+  }
+  VELOX_CHECK_GT(maxRows, 0);
+  const vector_size_t numRows =
+      std::min<uint64_t>(numRows_ - numOutputRows_, maxRows);
+  outputRows_.resize(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    auto* stream = merger_->next();
+    VELOX_CHECK_NOT_NULL(stream);
+    outputRows_[i] = stream->pop();
+  }
+
+  if (output != nullptr) {
+    VectorPtr reusable = std::move(output);
+    BaseVector::prepareForReuse(reusable, numRows);
+    output = std::static_pointer_cast<RowVector>(reusable);
+  } else {
+    output = std::static_pointer_cast<RowVector>(
+        BaseVector::create(outputType, numRows, pool));
+  }
+  for (auto& child : output->children()) {
+    child->resize(numRows);
+  }
+  sort_->runs_[0]->extractRows(outputRows_.data(), numRows, 0, output);
+  numOutputRows_ += numRows;
+  return output;
+}
+} // namespace facebook::velox::exec
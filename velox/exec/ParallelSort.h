@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/SortBuffer.h"
+#include "velox/exec/TreeOfLosers.h"
+
+namespace facebook::velox::exec {
+
+/// The sorted runs of the drivers of an OrderBy split into key ranges, see
+/// 'QueryConfig::kOrderByParallelSortEnabled'. Each driver sorts its input in
+/// its own SortBuffer. The last driver to finish its input moves the sort
+/// buffers of all the drivers into a ParallelSort, which samples splitters
+/// from all the runs and finds the rows of each key range in each run by
+/// binary search. Each driver then merges the rows of one range from all the
+/// runs with a RangeMerger, so that the merge runs on all the drivers and
+/// range 'i' has no key greater than a key of range 'i + 1'.
+class ParallelSort {
+ public:
+  /// Splits 'runs' into 'numRanges' key ranges. The runs must have seen all
+  /// their input and must not have spilled.
+  ParallelSort(std::vector<std::unique_ptr<SortBuffer>> runs, int32_t numRanges);
+
+  int32_t numRanges() const {
+    return numRanges_;
+  }
+
+  /// Returns the number of rows of all the runs in 'range'.
+  uint64_t numRows(int32_t range) const;
+
+  /// Returns the largest estimated output row size of the runs.
+  std::optional<uint64_t> estimateOutputRowSize() const;
+
+  /// Merges the rows of one key range of all the runs in key order.
+  class RangeMerger {
+   public:
+    RangeMerger(std::shared_ptr<const ParallelSort> sort, int32_t range);
+
+    /// Returns the next at most 'maxRows' rows of the range, or nullptr after
+    /// all the rows were returned. Reuses 'output' if not null.
+    RowVectorPtr getOutput(
+        vector_size_t maxRows,
+        const RowTypePtr& outputType,
+        RowVectorPtr& output,
+        memory::MemoryPool* pool);
+
+   private:
+    // The rows of one run in a range.
+    class RunStream : public MergeStream {
+     public:
+      RunStream(const SortBuffer* run, char* const* begin, char* const* end)
+          : run_(run), next_(begin), end_(end) {}
+
+      bool hasData() const override {
+        return next_ != end_;
+      }
+
+      bool operator<(const MergeStream& other) const override {
+        return run_->compareRows(
+                   *next_, *static_cast<const RunStream&>(other).next_) < 0;
+      }
+
+      char* pop() {
+        return *next_++;
+      }
+
+     private:
+      const SortBuffer* const run_;
+      char* const* next_;
+      char* const* const end_;
+    };
+
+    const std::shared_ptr<const ParallelSort> sort_;
+    const uint64_t numRows_;
+    std::unique_ptr<TreeOfLosers<RunStream>> merger_;
+    uint64_t numOutputRows_{0};
+    std::vector<char*> outputRows_;
+  };
+
+ private:
+  // Returns the splitters between the key ranges sampled from all the runs.
+  std::vector<char*> sampleSplitters() const;
+
+  // The number of rows sampled from each run per range.
+  static constexpr int32_t kSamplesPerRange = 16;
+
+  const std::vector<std::unique_ptr<SortBuffer>> runs_;
+  const int32_t numRanges_;
+
+  // The first row of each range in each run and the number of rows of the run
+  // last: range 'i' of run 'j' is [bounds_[j][i], bounds_[j][i + 1]).
+  std::vector<std::vector<uint64_t>> bounds_;
+};
+} // namespace facebook::velox::exec
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PartialAggregationCombiner.h"
+
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+// static
+std::shared_ptr<const core::AggregationNode>
+PartialAggregationCombiner::intermediateAggregation(
+    const core::PartitionedOutputNode& planNode) {
+  if (planNode.isReplicateNullsAndAny()) {
+    return nullptr;
+  }
+  auto partial = std::dynamic_pointer_cast<const core::AggregationNode>(
+      planNode.sources()[0]);
+  if (partial == nullptr ||
+      partial->step() != core::AggregationNode::Step::kPartial ||
+      partial->groupingKeys().empty() ||
+      !partial->globalGroupingSets().empty() ||
+      partial->groupId().has_value() || partial->aggregates().empty()) {
+    return nullptr;
+  }
+
+  const auto& outputType = partial->outputType();
+  const auto numKeys = partial->groupingKeys().size();
+  for (const auto& key : planNode.keys()) {
+    if (!core::TypedExprs::isFieldAccess(key)) {
+      continue;
+    }
+    const auto channel = exprToChannel(key.get(), outputType);
+    if (channel >= numKeys) {
+      return nullptr;
+    }
+  }
+
+  std::vector<core::AggregationNode::Aggregate> aggregates;
+  aggregates.reserve(partial->aggregates().size());
+  for (auto i = 0; i < partial->aggregates().size(); ++i) {
+    const auto& aggregate = partial->aggregates()[i];
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return nullptr;
+    }
+    for (const auto& type : aggregate.rawInputTypes) {
+      if (type->kind() == TypeKind::FUNCTION) {
+        return nullptr;
+      }
+    }
+    const auto channel = numKeys + i;
+    const auto& intermediateType = outputType->childAt(channel);
+    aggregates.push_back(
+        {std::make_shared<core::CallTypedExpr>(
+             intermediateType,
+             std::vector<core::TypedExprPtr>{
+                 std::make_shared<core::FieldAccessTypedExpr>(
+                     intermediateType, outputType->nameOf(channel))},
+             aggregate.call->name()),
+         aggregate.rawInputTypes});
+  }
+
+  return std::make_shared<core::AggregationNode>(
+      fmt::format("{}.combiner", planNode.id()),
+      core::AggregationNode::Step::kIntermediate,
+      partial->groupingKeys(),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      partial->aggregateNames(),
+      std::move(aggregates),
+      partial->ignoreNullKeys(),
+      partial);
+}
+
+PartialAggregationCombiner::PartialAggregationCombiner(
+    const std::shared_ptr<const core::AggregationNode>& aggregationNode,
+    OperatorCtx* operatorCtx,
+    tsan_atomic<bool>* nonReclaimableSection,
+    folly::Synchronized<common::SpillStats>* spillStats)
+    : outputType_(aggregationNode->outputType()),
+      pool_(operatorCtx->pool()),
+      maxMemoryUsage_(operatorCtx->driverCtx()
+                          ->queryConfig()
+                          .maxPartialAggregationMemoryUsage()),
+      abandonMinRows_(operatorCtx->driverCtx()
+                          ->queryConfig()
+                          .abandonPartialAggregationMinRows()),
+      abandonMinPct_(operatorCtx->driverCtx()
+                         ->queryConfig()
+                         .abandonPartialAggregationMinPct()) {
+  VELOX_CHECK_EQ(
+      aggregationNode->step(), core::AggregationNode::Step::kIntermediate);
+  const auto& inputType = aggregationNode->sources()[0]->outputType();
+  auto hashers =
+      createVectorHashers(inputType, aggregationNode->groupingKeys());
+  std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator;
+  auto aggregateInfos = toAggregateInfo(
+      *aggregationNode, *operatorCtx, hashers.size(), expressionEvaluator);
+  groupingSet_ = std::make_unique<GroupingSet>(
+      inputType,
+      std::move(hashers),
+      /*preGroupedKeys=*/std::vector<column_index_t>{},
+      /*groupingKeyOutputProjections=*/std::vector<column_index_t>{},
+      std::move(aggregateInfos),
+      aggregationNode->ignoreNullKeys(),
+      /*isPartial=*/true,
+      /*isRawInput=*/false,
+      aggregationNode->globalGroupingSets(),
+      /*groupIdChannel=*/std::nullopt,
+      /*spillConfig=*/nullptr,
+      nonReclaimableSection,
+      operatorCtx,
+      spillStats);
+}
+
+void PartialAggregationCombiner::addInput(const RowVectorPtr& input) {
+  VELOX_CHECK(!abandoned_);
+  groupingSet_->addInput(input, /*mayPushdown=*/false);
+  numInputRows_ += input->size();
+  totalInputRows_ += input->size();
+}
+
+bool PartialAggregationCombiner::isFull() {
+  return groupingSet_->isPartialFull(maxMemoryUsage_);
+}
+
+RowVectorPtr PartialAggregationCombiner::getOutput(
+    vector_size_t maxRows,
+    int32_t maxBytes) {
+  VELOX_CHECK_GT(maxRows, 0);
+  auto output = std::static_pointer_cast<RowVector>(
+      BaseVector::create(outputType_, maxRows, pool_));
+  if (groupingSet_->getOutput(maxRows, maxBytes, iterator_, output)) {
+    numOutputRows_ += output->size();
+    totalOutputRows_ += output->size();
+    return output;
+  }
+
+  iterator_.reset();
+  if (numInputRows_ > abandonMinRows_ &&
+      100 * numOutputRows_ / numInputRows_ >= abandonMinPct_) {
+    groupingSet_->resetTable(/*freeTable=*/true);
+    abandoned_ = true;
+  } else {
+    groupingSet_->resetTable(/*freeTable=*/false);
+  }
+  numInputRows_ = 0;
+  numOutputRows_ = 0;
+  return nullptr;
+}
+} // namespace facebook::velox::exec
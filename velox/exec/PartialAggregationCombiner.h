@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/GroupingSet.h"
+
+namespace facebook::velox::exec {
+
+/// Merges the intermediate results of a partial aggregation with the same
+/// grouping keys before PartitionedOutput serializes them, see
+/// 'QueryConfig::kShuffleCombinePartialAggregates'. A partial aggregation
+/// flushes its groups when full and passes its input through when abandoned,
+/// so its output can repeat the same keys many times. The combiner runs an
+/// intermediate aggregation over this output in a hash table bounded by
+/// 'QueryConfig::kMaxPartialAggregationMemory' and returns the merged rows,
+/// which have the same type as its input, when full or at the end of the
+/// input. It is abandoned like a partial aggregation if it does not reduce
+/// the rows enough.
+class PartialAggregationCombiner {
+ public:
+  /// Returns the intermediate aggregation to combine the input of 'planNode'
+  /// with, or nullptr if the source of 'planNode' is not a partial
+  /// aggregation whose output is combinable: it must have grouping keys, no
+  /// grouping sets, only aggregates without distinct, sorting or lambda
+  /// inputs, and the partition keys must be grouping keys.
+  static std::shared_ptr<const core::AggregationNode> intermediateAggregation(
+      const core::PartitionedOutputNode& planNode);
+
+  /// 'aggregationNode' is the result of intermediateAggregation().
+  PartialAggregationCombiner(
+      const std::shared_ptr<const core::AggregationNode>& aggregationNode,
+      OperatorCtx* operatorCtx,
+      tsan_atomic<bool>* nonReclaimableSection,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
+  /// Merges 'input' into the hash table. Must not be called when abandoned().
+  void addInput(const RowVectorPtr& input);
+
+  /// Returns true if the hash table reached its memory limit and the merged
+  /// rows should be returned by getOutput() before adding more input.
+  bool isFull();
+
+  /// Returns true if there are merged rows to return.
+  bool hasOutput() const {
+    return groupingSet_->numDistinct() > 0;
+  }
+
+  /// Returns the next batch of at most 'maxRows' merged rows, or nullptr after
+  /// all the merged rows were returned. The hash table is then cleared for
+  /// more input, or abandoned if it did not reduce the input rows enough.
+  RowVectorPtr getOutput(vector_size_t maxRows, int32_t maxBytes);
+
+  /// Returns true if combining is abandoned and the input should be
+  /// serialized as is.
+  bool abandoned() const {
+    return abandoned_;
+  }
+
+  int64_t numInputRows() const {
+    return totalInputRows_;
+  }
+
+  int64_t numOutputRows() const {
+    return totalOutputRows_;
+  }
+
+ private:
+  const RowTypePtr outputType_;
+  memory::MemoryPool* const pool_;
+  const uint64_t maxMemoryUsage_;
+  const int64_t abandonMinRows_;
+  const int32_t abandonMinPct_;
+
+  std::unique_ptr<GroupingSet> groupingSet_;
+  RowContainerIterator iterator_;
+  bool abandoned_{false};
+
+  // The input and output rows since the hash table was last cleared.
+  int64_t numInputRows_{0};
+  int64_t numOutputRows_{0};
+  int64_t totalInputRows_{0};
+  int64_t totalOutputRows_{0};
+};
+} // namespace facebook::velox::exec
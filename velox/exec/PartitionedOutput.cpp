@@ -20,6 +20,18 @@
 
 namespace facebook::velox::exec {
 namespace {
+// Upper limit of message size with no columns.
+constexpr int32_t kMinMessageSize = 128;
+
+bool preserveEncodings(
+    const VectorSerde* serde,
+    const VectorSerde::Options* options) {
+  return serde->kind() == VectorSerde::Kind::kPresto && options != nullptr &&
+      static_cast<const serializer::presto::PrestoVectorSerde::PrestoOptions*>(
+          options)
+          ->preserveEncodings;
+}
+
 std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
     const core::QueryConfig& queryConfig,
     VectorSerde::Kind kind) {
@@ -29,6 +41,15 @@ std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
       : std::make_unique<VectorSerde::Options>();
   options->compressionKind =
       common::stringToCompressionKind(queryConfig.shuffleCompressionKind());
+  if (kind == VectorSerde::Kind::kPresto) {
+    auto* prestoOptions =
+        static_cast<serializer::presto::PrestoVectorSerde::PrestoOptions*>(
+            options.get());
+    prestoOptions->preserveEncodings = queryConfig.shufflePreserveEncodings();
+    prestoOptions->compressColumns = queryConfig.shuffleColumnCompression();
+    prestoOptions->stringCompressionKind = common::stringToCompressionKind(
+        queryConfig.shuffleStringCompressionKind());
+  }
   options->minCompressionRatio = PartitionedOutput::minCompressionRatio();
   return options;
 }
@@ -51,6 +72,9 @@ Destination::Destination(
       eagerFlush_(eagerFlush),
       recordEnqueued_(std::move(recordEnqueued)),
       rows_(raw_vector<vector_size_t>(pool)) {
+  if (preserveEncodings(serde_, serdeOptions_)) {
+    batchSerializer_ = serde_->createBatchSerializer(pool_, serdeOptions_);
+  }
   setTargetSizePct();
 }
 
@@ -87,6 +111,14 @@ BlockingReason Destination::advance(
         bytesInCurrent_ >= adjustedMaxBytes || rowsInCurrent_ >= targetNumRows_;
   }
 
+  if (batchSerializer_ != nullptr) {
+    if (rowIdx_ == rows_.size()) {
+      *atEnd = true;
+    }
+    return serializeEncoded(
+        output, firstRow, bufferManager, bufferReleaseFn, future, scratch);
+  }
+
   // Serialize
   if (current_ == nullptr) {
     current_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
@@ -102,7 +134,9 @@ BlockingReason Destination::advance(
     VELOX_CHECK_NOT_NULL(outputUnsafeRow);
     current_->append(*outputUnsafeRow, rows, sizes);
   } else {
-    VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kPresto);
+    VELOX_CHECK(
+        serde_->kind() == VectorSerde::Kind::kPresto ||
+        serde_->kind() == VectorSerde::Kind::kArrowIpc);
     current_->append(output, rows, scratch);
   }
 
@@ -124,18 +158,49 @@ BlockingReason Destination::flush(
     return BlockingReason::kNotBlocked;
   }
 
-  // Upper limit of message size with no columns.
-  constexpr int32_t kMinMessageSize = 128;
   auto listener = bufferManager.newListener();
   IOBufOutputStream stream(
       *current_->pool(),
       listener.get(),
       std::max<int64_t>(kMinMessageSize, current_->size()));
-  const int64_t flushedRows = rowsInCurrent_;
-
   current_->flush(&stream);
   current_->clear();
+  return enqueue(stream, bufferManager, bufferReleaseFn, future);
+}
+
+BlockingReason Destination::serializeEncoded(
+    const RowVectorPtr& output,
+    vector_size_t firstRow,
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future,
+    Scratch& scratch) {
+  ranges_.clear();
+  for (auto i = firstRow; i < rowIdx_; ++i) {
+    const auto row = rows_[i];
+    if (!ranges_.empty() &&
+        ranges_.back().begin + ranges_.back().size == row) {
+      ++ranges_.back().size;
+    } else {
+      ranges_.push_back(IndexRange{row, 1});
+    }
+  }
+  auto listener = bufferManager.newListener();
+  IOBufOutputStream stream(
+      *pool_,
+      listener.get(),
+      std::max<int64_t>(kMinMessageSize, bytesInCurrent_));
+  batchSerializer_->serialize(
+      output, folly::Range(ranges_.data(), ranges_.size()), scratch, &stream);
+  return enqueue(stream, bufferManager, bufferReleaseFn, future);
+}
 
+BlockingReason Destination::enqueue(
+    IOBufOutputStream& stream,
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
+  const int64_t flushedRows = rowsInCurrent_;
   const int64_t flushedBytes = stream.tellp();
 
   bytesInCurrent_ = 0;
@@ -204,7 +269,11 @@ PartitionedOutput::PartitionedOutput(
       serde_(getNamedVectorSerde(planNode->serdeKind())),
       serdeOptions_(getVectorSerdeOptions(
           operatorCtx_->driverCtx()->queryConfig(),
-          planNode->serdeKind())) {
+          planNode->serdeKind())),
+      columnarPartitionMinDestinations_(
+          operatorCtx_->driverCtx()
+              ->queryConfig()
+              .shuffleColumnarPartitionMinDestinations()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -212,6 +281,24 @@ PartitionedOutput::PartitionedOutput(
     VELOX_USER_CHECK(keyChannels_.empty());
     VELOX_USER_CHECK_NULL(partitionFunction_);
   }
+  if (operatorCtx_->driverCtx()
+          ->queryConfig()
+          .shuffleCombinePartialAggregates()) {
+    combinerAggregationNode_ =
+        PartialAggregationCombiner::intermediateAggregation(*planNode);
+  }
+}
+
+void PartitionedOutput::initialize() {
+  Operator::initialize();
+  if (combinerAggregationNode_ != nullptr) {
+    combiner_ = std::make_unique<PartialAggregationCombiner>(
+        combinerAggregationNode_,
+        operatorCtx_.get(),
+        &nonReclaimableSection_,
+        &spillStats_);
+    combinerAggregationNode_.reset();
+  }
 }
 
 void PartitionedOutput::initializeInput(RowVectorPtr input) {
@@ -245,6 +332,10 @@ void PartitionedOutput::initializeInput(RowVectorPtr input) {
     output_->childAt(i)->loadedVector();
   }
 
+  initializeOutputRows();
+}
+
+void PartitionedOutput::initializeOutputRows() {
   if (serde_->kind() == VectorSerde::Kind::kCompactRow) {
     outputCompactRow_ = std::make_unique<row::CompactRow>(output_);
   } else if (serde_->kind() == VectorSerde::Kind::kUnsafeRow) {
@@ -298,17 +389,27 @@ void PartitionedOutput::estimateRowSizes() {
     serde_->estimateSerializedSize(
         outputUnsafeRow_.get(), rows, sizePointers_.data());
   } else {
-    VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kPresto);
+    VELOX_CHECK(
+        serde_->kind() == VectorSerde::Kind::kPresto ||
+        serde_->kind() == VectorSerde::Kind::kArrowIpc);
     serde_->estimateSerializedSize(
         output_.get(), rows, sizePointers_.data(), scratch_);
   }
 }
 
 void PartitionedOutput::addInput(RowVectorPtr input) {
+  if (combiner_ != nullptr && !combiner_->abandoned()) {
+    combiner_->addInput(input);
+    flushingCombiner_ = combiner_->isFull();
+    return;
+  }
+  partitionInput(std::move(input));
+}
+
+void PartitionedOutput::partitionInput(RowVectorPtr input) {
   initializeInput(std::move(input));
   initializeDestinations();
   initializeSizeBuffers();
-  estimateRowSizes();
 
   for (auto& destination : destinations_) {
     destination->beginBatch();
@@ -340,7 +441,7 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
           if (singlePartition.has_value()) {
             destinations_[singlePartition.value()]->addRow(i);
           } else {
-            destinations_[partitions_[i]]->addRow(i);
+            addRow(i, partitions_[i]);
           }
         }
       }
@@ -348,13 +449,70 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
       if (singlePartition.has_value()) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
-      } else {
+      } else if (
+          columnarPartitionMinDestinations_ == 0 ||
+          numDestinations_ < columnarPartitionMinDestinations_ ||
+          !groupRowsByPartition()) {
         for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
+          addRow(i, partitions_[i]);
         }
       }
     }
   }
+
+  // Estimates after grouping the rows by partition which reorders 'output_'.
+  estimateRowSizes();
+}
+
+bool PartitionedOutput::groupRowsByPartition() {
+  const auto numInput = output_->size();
+  // Histogram of the partitions, then the first row of each partition.
+  partitionOffsets_.assign(numDestinations_ + 1, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    const auto partition = partitions_[i];
+    if (partition == core::PartitionFunction::kAllPartitions) {
+      return false;
+    }
+    ++partitionOffsets_[partition + 1];
+  }
+  for (auto i = 0; i < numDestinations_; ++i) {
+    partitionOffsets_[i + 1] += partitionOffsets_[i];
+  }
+
+  partitionRows_.resize(numInput);
+  nextPartitionRows_.assign(
+      partitionOffsets_.begin(), partitionOffsets_.end() - 1);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    partitionRows_[nextPartitionRows_[partitions_[i]]++] = i;
+  }
+
+  // Gathers each column once into the partition order so that each
+  // destination serializes a contiguous range of rows.
+  auto grouped = std::static_pointer_cast<RowVector>(
+      BaseVector::create(outputType_, numInput, pool()));
+  rows_.resize(numInput);
+  rows_.setAll();
+  grouped->copy(output_.get(), rows_, partitionRows_.data());
+  output_ = std::move(grouped);
+  initializeOutputRows();
+
+  for (auto i = 0; i < numDestinations_; ++i) {
+    const auto numRows = partitionOffsets_[i + 1] - partitionOffsets_[i];
+    if (numRows > 0) {
+      destinations_[i]->addRows(IndexRange{partitionOffsets_[i], numRows});
+    }
+  }
+  return true;
+}
+
+void PartitionedOutput::addRow(vector_size_t row, uint32_t partition) {
+  if (FOLLY_UNLIKELY(partition == core::PartitionFunction::kAllPartitions)) {
+    for (auto& destination : destinations_) {
+      destination->addRow(row);
+    }
+    return;
+  }
+  destinations_[partition]->addRow(row);
 }
 
 void PartitionedOutput::collectNullRows() {
@@ -404,6 +562,20 @@ RowVectorPtr PartitionedOutput::getOutput() {
       kMinDestinationSize,
       std::min<uint64_t>(kMaxPageSize, maxBufferedBytes_ / numDestinations_));
 
+  // Serializes the next batch of merged rows once the previous input is
+  // fully serialized.
+  if (output_ == nullptr && combiner_ != nullptr &&
+      (flushingCombiner_ || noMoreInput_)) {
+    auto combined = combiner_->getOutput(
+        outputBatchRows(),
+        operatorCtx_->driverCtx()->queryConfig().preferredOutputBatchBytes());
+    if (combined != nullptr) {
+      partitionInput(std::move(combined));
+    } else {
+      flushingCombiner_ = false;
+    }
+  }
+
   bool workLeft;
   do {
     workLeft = false;
@@ -450,7 +622,7 @@ RowVectorPtr PartitionedOutput::getOutput() {
   // All of 'output_' is written into the destinations. We are finishing, hence
   // move all the destinations to the output queue. This will not grow memory
   // and hence does not need blocking.
-  if (noMoreInput_) {
+  if (noMoreInput_ && (combiner_ == nullptr || !combiner_->hasOutput())) {
     for (auto& destination : destinations_) {
       if (destination->isFinished()) {
         continue;
@@ -485,8 +657,15 @@ void PartitionedOutput::close() {
     lockedStats->addRuntimeStat(
         Operator::kShuffleCompressionKind,
         RuntimeCounter(static_cast<int64_t>(serdeOptions_->compressionKind)));
+    if (combiner_ != nullptr) {
+      lockedStats->addRuntimeStat(
+          kCombinerInputRows, RuntimeCounter(combiner_->numInputRows()));
+      lockedStats->addRuntimeStat(
+          kCombinerOutputRows, RuntimeCounter(combiner_->numOutputRows()));
+    }
   }
   destinations_.clear();
+  combiner_.reset();
 }
 
 } // namespace facebook::velox::exec
@@ -18,6 +18,7 @@
 #include <folly/Random.h>
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/PartialAggregationCombiner.h"
 #include "velox/row/CompactRow.h"
 #include "velox/row/UnsafeRowFast.h"
 #include "velox/vector/VectorStream.h"
@@ -89,6 +90,24 @@ class Destination {
   void updateStats(Operator* op);
 
  private:
+  // Serializes the rows of 'output' from 'rows_[firstRow]' to
+  // 'rows_[rowIdx_]' with their encodings into a page and enqueues it.
+  BlockingReason serializeEncoded(
+      const RowVectorPtr& output,
+      vector_size_t firstRow,
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future,
+      Scratch& scratch);
+
+  // Enqueues the page in 'stream' with the 'rowsInCurrent_' rows and resets
+  // the accumulated rows and bytes.
+  BlockingReason enqueue(
+      IOBufOutputStream& stream,
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future);
+
   // Sets the next target size for flushing. This is called at the
   // start of each batch of output for the destination. The effect is
   // to make different destinations ready at slightly different times
@@ -122,6 +141,11 @@ class Destination {
   // The current stream where the input is serialized to. This is cleared on
   // every flush() call.
   std::unique_ptr<VectorStreamGroup> current_;
+  // Set instead of 'current_' if the serde preserves the encodings, see
+  // 'QueryConfig::kShufflePreserveEncodings'.
+  std::unique_ptr<BatchVectorSerializer> batchSerializer_;
+  // Reusable ranges of rows for 'batchSerializer_'.
+  std::vector<IndexRange> ranges_;
   bool finished_{false};
 
   // Flush accumulated data to buffer manager after reaching this
@@ -159,6 +183,8 @@ class PartitionedOutput : public Operator {
       const std::shared_ptr<const core::PartitionedOutputNode>& planNode,
       bool eagerFlush);
 
+  void initialize() override;
+
   void addInput(RowVectorPtr input) override;
 
   /// Always returns nullptr. The action is to further process
@@ -166,10 +192,11 @@ class PartitionedOutput : public Operator {
   /// a non-blocked state, otherwise blocked.
   RowVectorPtr getOutput() override;
 
-  /// always true but the caller will check isBlocked before adding input, hence
-  /// the blocked state does not accumulate input.
+  /// True unless the merged rows of a full 'combiner_' are being serialized.
+  /// The caller will check isBlocked before adding input, hence the blocked
+  /// state does not accumulate input.
   bool needsInput() const override {
-    return true;
+    return !flushingCombiner_;
   }
 
   BlockingReason isBlocked(ContinueFuture* future) override {
@@ -193,7 +220,15 @@ class PartitionedOutput : public Operator {
     return minCompressionRatio_;
   }
 
+  /// The number of rows added to and returned by the combiner of partial
+  /// aggregates, see 'QueryConfig::kShuffleCombinePartialAggregates'.
+  static inline const std::string kCombinerInputRows{"combinerInputRows"};
+  static inline const std::string kCombinerOutputRows{"combinerOutputRows"};
+
  private:
+  // Adds the rows of 'input' to the destinations.
+  void partitionInput(RowVectorPtr input);
+
   void initializeInput(RowVectorPtr input);
 
   void initializeDestinations();
@@ -202,9 +237,22 @@ class PartitionedOutput : public Operator {
 
   void estimateRowSizes();
 
+  // Creates 'outputCompactRow_' or 'outputUnsafeRow_' for 'output_' if the
+  // serde is row-wise.
+  void initializeOutputRows();
+
+  // Reorders 'output_' so that the rows of each partition in 'partitions_'
+  // are contiguous and adds each range of rows to its destination. Returns
+  // false without changes if a row goes to all the partitions.
+  bool groupRowsByPartition();
+
   // Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Adds 'row' to the destination for 'partition', or to all the destinations
+  // if 'partition' is core::PartitionFunction::kAllPartitions.
+  void addRow(vector_size_t row, uint32_t partition);
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -221,6 +269,19 @@ class PartitionedOutput : public Operator {
   const bool eagerFlush_;
   VectorSerde* const serde_;
   const std::unique_ptr<VectorSerde::Options> serdeOptions_;
+  // Groups the rows by partition before serializing if there are at least
+  // this many destinations and this is not zero. See
+  // 'QueryConfig::kShuffleColumnarPartitionMinDestinations'.
+  const uint32_t columnarPartitionMinDestinations_;
+
+  // The intermediate aggregation for 'combiner_'. Set in the constructor if
+  // 'QueryConfig::kShuffleCombinePartialAggregates' is enabled and the input
+  // is combinable, and reset after creating 'combiner_' in initialize().
+  std::shared_ptr<const core::AggregationNode> combinerAggregationNode_;
+  std::unique_ptr<PartialAggregationCombiner> combiner_;
+  // True while the merged rows of a full 'combiner_' are serialized before
+  // more input is combined.
+  bool flushingCombiner_{false};
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -248,6 +309,12 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  // The first row of each partition in the grouped 'output_' followed by the
+  // number of rows, the input row of each grouped row and the next grouped
+  // row of each partition when grouping the rows by partition.
+  std::vector<vector_size_t> partitionOffsets_;
+  std::vector<vector_size_t> partitionRows_;
+  std::vector<vector_size_t> nextPartitionRows_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
 };
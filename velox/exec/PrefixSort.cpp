@@ -349,13 +349,45 @@ uint32_t PrefixSort::maxRequiredBytes() const {
   const auto numRows = rowContainer_->numRows();
   const auto numPages =
       memory::AllocationTraits::numPages(numRows * sortLayout_.entrySize);
-  // Prefix data size + swap buffer size.
-  return memory::AllocationTraits::pageBytes(numPages) +
+  // Prefix data size + radix sort buffer size + swap buffer size.
+  return memory::AllocationTraits::pageBytes(numPages) *
+      (useRadixSort(numRows) ? 2 : 1) +
       pool_->preferredSize(checkedPlus<size_t>(
           sortLayout_.entrySize, AlignedBuffer::kPaddedSize)) +
       2 * pool_->alignment();
 }
 
+char* PrefixSort::radixSort(
+    const PrefixSortRunner& sortRunner,
+    char* prefixBuffer,
+    char* radixBuffer,
+    uint64_t numRows) {
+  const auto entrySize = sortLayout_.entrySize;
+  const auto keyBytes = sortLayout_.normalizedBufferSize;
+  auto* sorted = sortRunner.radixSort(
+      prefixBuffer, prefixBuffer + numRows * entrySize, radixBuffer, keyBytes);
+  if (!needsTieBreak()) {
+    return sorted;
+  }
+
+  // Sorts the runs of equal prefixes by the keys after the prefixes.
+  auto* runStart = sorted;
+  auto* end = sorted + numRows * entrySize;
+  while (runStart < end) {
+    auto* runEnd = runStart + entrySize;
+    while (runEnd < end && compareAllNormalizedKeys(runStart, runEnd) == 0) {
+      runEnd += entrySize;
+    }
+    if (runEnd - runStart > entrySize) {
+      sortRunner.quickSort(runStart, runEnd, [&](char* lhs, char* rhs) {
+        return comparePartNormalizedKeys(lhs, rhs);
+      });
+    }
+    runStart = runEnd;
+  }
+  return sorted;
+}
+
 void PrefixSort::sortInternal(
     std::vector<char*, memory::StlAllocator<char*>>& rows) {
   const auto numRows = rows.size();
@@ -376,6 +408,7 @@ void PrefixSort::sortInternal(
   }
 
   // Sort rows with the normalized prefix keys.
+  memory::ContiguousAllocation radixBufferAlloc;
   {
     const auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool_);
     PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
@@ -387,8 +420,14 @@ void PrefixSort::sortInternal(
           RuntimeCounter(
               sortLayout_.numNormalizedKeys, RuntimeCounter::Unit::kNone));
     }
-    if (sortLayout_.hasNonNormalizedKey ||
-        sortLayout_.nonPrefixSortStartIndex < sortLayout_.numNormalizedKeys) {
+    if (useRadixSort(numRows)) {
+      pool_->allocateContiguous(prefixBufferAlloc.numPages(), radixBufferAlloc);
+      addThreadLocalRuntimeStat(
+          PrefixSort::kNumRadixSorts,
+          RuntimeCounter(1, RuntimeCounter::Unit::kNone));
+      prefixBuffer = radixSort(
+          sortRunner, prefixBuffer, radixBufferAlloc.data<char>(), numRows);
+    } else if (needsTieBreak()) {
       sortRunner.quickSort(
           prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
             return comparePartNormalizedKeys(lhs, rhs);
@@ -162,6 +162,8 @@ class PrefixSort {
   /// The runtime stats name collected for prefix sort.
   /// The number of prefix sort keys.
   static inline const std::string kNumPrefixSortKeys{"numPrefixSortKeys"};
+  /// The number of sorts which used radix sort on the prefixes.
+  static inline const std::string kNumRadixSorts{"numPrefixRadixSorts"};
 
  private:
   /// Fallback to stdSort when prefix sort conditions such as config and memory
@@ -203,10 +205,38 @@ class PrefixSort {
         maxStringLengths);
   }
 
+  // Radix sort is used instead of quick sort if the normalized keys are at
+  // most 'kRadixSortMaxKeyBytes' bytes, e.g. a bigint with a null byte, and
+  // there are at least 'kRadixSortMinRows' rows.
+  static constexpr uint32_t kRadixSortMaxKeyBytes = 16;
+  static constexpr uint64_t kRadixSortMinRows = 1'024;
+
   // Estimates the memory required for prefix sort such as prefix buffer and
   // swap buffer.
   uint32_t maxRequiredBytes() const;
 
+  bool useRadixSort(uint64_t numRows) const {
+    return sortLayout_.normalizedBufferSize <= kRadixSortMaxKeyBytes &&
+        numRows >= kRadixSortMinRows;
+  }
+
+  // Returns true if the prefixes do not cover all the sort keys and the rows
+  // with equal prefixes are compared by the remaining keys.
+  bool needsTieBreak() const {
+    return sortLayout_.hasNonNormalizedKey ||
+        sortLayout_.nonPrefixSortStartIndex < sortLayout_.numNormalizedKeys;
+  }
+
+  // Sorts the prefixes in 'prefixBuffer' with radix sort and then quick sorts
+  // the runs of equal prefixes by the remaining keys if needsTieBreak().
+  // Returns the start of the sorted prefixes, either 'prefixBuffer' or
+  // 'radixBuffer'.
+  char* radixSort(
+      const PrefixSortRunner& sortRunner,
+      char* prefixBuffer,
+      char* radixBuffer,
+      uint64_t numRows);
+
   void sortInternal(std::vector<char*, memory::StlAllocator<char*>>& rows);
 
   int compareAllNormalizedKeys(char* left, char* right);
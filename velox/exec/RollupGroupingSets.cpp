@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/RollupGroupingSets.h"
+#include "velox/exec/Aggregate.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+const core::GroupIdNode* asGroupIdNode(const core::AggregationNode& node) {
+  return dynamic_cast<const core::GroupIdNode*>(node.sources()[0].get());
+}
+} // namespace
+
+// static
+bool RollupGroupingSets::supports(
+    const core::AggregationNode& node,
+    const core::QueryConfig& config) {
+  if (!config.aggregationGroupingSetsRollupEnabled() ||
+      node.step() != core::AggregationNode::Step::kSingle ||
+      node.isPreGrouped() || node.ignoreNullKeys() ||
+      !node.groupId().has_value() || node.aggregates().empty() ||
+      node.canSpill(config)) {
+    return false;
+  }
+
+  const auto* groupIdNode = asGroupIdNode(node);
+  if (groupIdNode == nullptr || groupIdNode->numGroupingKeys() == 0 ||
+      groupIdNode->groupIdName() != node.groupId().value()->name()) {
+    return false;
+  }
+
+  // The aggregation must group on all the grouping keys and on the group id.
+  const auto& inputType = groupIdNode->outputType();
+  std::vector<bool> isGroupedOn(groupIdNode->numGroupingKeys(), false);
+  for (const auto& key : node.groupingKeys()) {
+    if (key->name() == groupIdNode->groupIdName()) {
+      continue;
+    }
+    const auto channel = inputType->getChildIdx(key->name());
+    if (channel >= isGroupedOn.size()) {
+      return false;
+    }
+    isGroupedOn[channel] = true;
+  }
+  if (node.groupingKeys().size() != isGroupedOn.size() + 1 ||
+      !std::all_of(isGroupedOn.begin(), isGroupedOn.end(), [](bool grouped) {
+        return grouped;
+      })) {
+    return false;
+  }
+
+  for (const auto& aggregate : node.aggregates()) {
+    if (aggregate.distinct || aggregate.mask != nullptr ||
+        !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    // The aggregate must not read the grouping keys or the group id, which
+    // differ between the grouping sets.
+    for (const auto& arg : aggregate.call->inputs()) {
+      if (dynamic_cast<const core::LambdaTypedExpr*>(arg.get()) != nullptr) {
+        return false;
+      }
+      if (auto field =
+              dynamic_cast<const core::FieldAccessTypedExpr*>(arg.get())) {
+        const auto channel = inputType->getChildIdx(field->name());
+        if (channel < isGroupedOn.size() ||
+            field->name() == groupIdNode->groupIdName()) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+RollupGroupingSets::RollupGroupingSets(
+    const core::AggregationNode& node,
+    OperatorCtx* operatorCtx,
+    tsan_atomic<bool>* nonReclaimableSection,
+    folly::Synchronized<common::SpillStats>* spillStats)
+    : pool_(operatorCtx->pool()),
+      outputType_(node.outputType()),
+      numGroupIdKeys_(asGroupIdNode(node)->numGroupingKeys()),
+      globalGroupingSets_(node.globalGroupingSets()) {
+  const auto& groupIdNode = *asGroupIdNode(node);
+  const auto& inputType = groupIdNode.outputType();
+  const auto& config = operatorCtx->driverCtx()->queryConfig();
+  const auto numKeys = node.groupingKeys().size();
+  const auto numAggregates = node.aggregates().size();
+
+  for (const auto& key : node.groupingKeys()) {
+    if (key->name() == groupIdNode.groupIdName()) {
+      keyInputChannels_.push_back(std::nullopt);
+    } else {
+      keyInputChannels_.push_back(inputType->getChildIdx(key->name()));
+    }
+  }
+
+  // Aggregates the raw input on all the grouping keys.
+  std::vector<column_index_t> allKeyChannels(numGroupIdKeys_);
+  std::iota(allKeyChannels.begin(), allKeyChannels.end(), 0);
+  std::vector<TypePtr> allKeysTypes;
+  for (auto channel : allKeyChannels) {
+    allKeysTypes.push_back(inputType->childAt(channel));
+  }
+
+  std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator;
+  auto aggregateInfos =
+      toAggregateInfo(node, *operatorCtx, numKeys, expressionEvaluator);
+  for (auto i = 0; i < numAggregates; ++i) {
+    const auto& aggregate = node.aggregates()[i];
+    auto& info = aggregateInfos[i];
+    info.function = Aggregate::create(
+        aggregate.call->name(),
+        core::AggregationNode::Step::kPartial,
+        aggregate.rawInputTypes,
+        info.intermediateType,
+        config);
+    info.output = numGroupIdKeys_ + i;
+    allKeysTypes.push_back(info.intermediateType);
+  }
+  allKeysType_ = ROW(std::move(allKeysTypes));
+
+  allKeys_ = std::make_unique<GroupingSet>(
+      inputType,
+      createVectorHashers(inputType, allKeyChannels),
+      std::vector<column_index_t>{},
+      std::vector<column_index_t>{},
+      std::move(aggregateInfos),
+      /*ignoreNullKeys=*/false,
+      /*isPartial=*/true,
+      /*isRawInput=*/true,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      nullptr,
+      nonReclaimableSection,
+      operatorCtx,
+      spillStats);
+
+  // Merges the intermediate results into each grouping set.
+  for (const auto& groupingSet : groupIdNode.groupingSets()) {
+    std::vector<column_index_t> keyChannels;
+    std::vector<TypePtr> setTypes;
+    for (const auto& key : groupingSet) {
+      keyChannels.push_back(inputType->getChildIdx(key));
+      setTypes.push_back(inputType->childAt(keyChannels.back()));
+    }
+
+    std::vector<AggregateInfo> finalInfos;
+    for (auto i = 0; i < numAggregates; ++i) {
+      const auto& aggregate = node.aggregates()[i];
+      AggregateInfo info;
+      info.inputs = {static_cast<column_index_t>(numGroupIdKeys_ + i)};
+      info.constantInputs = {nullptr};
+      info.intermediateType = allKeysType_->childAt(numGroupIdKeys_ + i);
+      info.function = Aggregate::create(
+          aggregate.call->name(),
+          core::AggregationNode::Step::kFinal,
+          aggregate.rawInputTypes,
+          outputType_->childAt(numKeys + i),
+          config);
+      info.output = keyChannels.size() + i;
+      setTypes.push_back(outputType_->childAt(numKeys + i));
+      finalInfos.push_back(std::move(info));
+    }
+
+    sets_.push_back(std::make_unique<GroupingSet>(
+        allKeysType_,
+        createVectorHashers(allKeysType_, keyChannels),
+        std::vector<column_index_t>{},
+        std::vector<column_index_t>{},
+        std::move(finalInfos),
+        /*ignoreNullKeys=*/false,
+        /*isPartial=*/false,
+        /*isRawInput=*/false,
+        std::vector<vector_size_t>{},
+        std::nullopt,
+        nullptr,
+        nonReclaimableSection,
+        operatorCtx,
+        spillStats));
+    setKeyChannels_.push_back(std::move(keyChannels));
+    setTypes_.push_back(ROW(std::move(setTypes)));
+  }
+}
+
+void RollupGroupingSets::addInput(const RowVectorPtr& input) {
+  hasInput_ |= input->size() > 0;
+  allKeys_->addInput(input, /*mayPushdown=*/false);
+}
+
+void RollupGroupingSets::noMoreInput() {
+  allKeys_->noMoreInput();
+
+  RowContainerIterator iterator;
+  for (;;) {
+    auto groups = std::static_pointer_cast<RowVector>(
+        BaseVector::create(allKeysType_, kMergeBatchRows, pool_));
+    if (!allKeys_->getOutput(
+            kMergeBatchRows,
+            std::numeric_limits<int32_t>::max(),
+            iterator,
+            groups)) {
+      break;
+    }
+    for (auto& set : sets_) {
+      set->addInput(groups, /*mayPushdown=*/false);
+    }
+  }
+  allKeys_.reset();
+
+  for (auto& set : sets_) {
+    set->noMoreInput();
+  }
+}
+
+RowVectorPtr RollupGroupingSets::getOutput(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes) {
+  while (outputSet_ < sets_.size()) {
+    const auto& keyChannels = setKeyChannels_[outputSet_];
+    // A grouping set without keys returns a row for empty input only if it is
+    // a global grouping set of the aggregation, like the aggregation over the
+    // replicated input does.
+    const bool skipSet = !hasInput_ &&
+        (!keyChannels.empty() ||
+         std::find(
+             globalGroupingSets_.begin(),
+             globalGroupingSets_.end(),
+             outputSet_) == globalGroupingSets_.end());
+    auto setOutput = std::static_pointer_cast<RowVector>(BaseVector::create(
+        setTypes_[outputSet_],
+        keyChannels.empty() ? 1 : maxOutputRows,
+        pool_));
+    if (skipSet ||
+        !sets_[outputSet_]->getOutput(
+            maxOutputRows, maxOutputBytes, outputIterator_, setOutput)) {
+      // Free the grouping set before merging the next one.
+      sets_[outputSet_].reset();
+      outputIterator_.reset();
+      ++outputSet_;
+      continue;
+    }
+
+    const auto numRows = setOutput->size();
+    std::vector<VectorPtr> children(outputType_->size());
+    for (auto i = 0; i < keyInputChannels_.size(); ++i) {
+      if (!keyInputChannels_[i].has_value()) {
+        children[i] = std::make_shared<ConstantVector<int64_t>>(
+            pool_, numRows, false, BIGINT(), static_cast<int64_t>(outputSet_));
+        continue;
+      }
+      auto it = std::find(
+          keyChannels.begin(), keyChannels.end(), keyInputChannels_[i].value());
+      if (it == keyChannels.end()) {
+        children[i] = BaseVector::createNullConstant(
+            outputType_->childAt(i), numRows, pool_);
+      } else {
+        children[i] = setOutput->childAt(it - keyChannels.begin());
+      }
+    }
+    for (auto i = keyInputChannels_.size(); i < children.size(); ++i) {
+      children[i] = setOutput->childAt(
+          keyChannels.size() + i - keyInputChannels_.size());
+    }
+    return std::make_shared<RowVector>(
+        pool_, outputType_, nullptr, numRows, std::move(children));
+  }
+  return nullptr;
+}
+
+uint64_t RollupGroupingSets::allocatedBytes() const {
+  uint64_t totalBytes = allKeys_ != nullptr ? allKeys_->allocatedBytes() : 0;
+  for (const auto& set : sets_) {
+    if (set != nullptr) {
+      totalBytes += set->allocatedBytes();
+    }
+  }
+  return totalBytes;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/GroupingSet.h"
+
+namespace facebook::velox::exec {
+
+/// Computes the grouping sets of a single aggregation over a GroupId without
+/// replicating the input once per grouping set. The GroupId operator passes
+/// each input row once with all the grouping keys. The input is aggregated on
+/// all the grouping keys into intermediate accumulators, and the intermediate
+/// results of these groups are then merged into each grouping set. The output
+/// is the same as the one of the aggregation over the replicated input: the
+/// keys not in a grouping set are null and the group id column is the index of
+/// the grouping set.
+class RollupGroupingSets {
+ public:
+  /// Returns true if 'node' is a single aggregation whose source is a GroupId
+  /// and whose aggregates can be computed from intermediate results, and if
+  /// the roll-up is enabled in 'config'. The GroupId operator and the
+  /// HashAggregation operator both use this to agree on the roll-up.
+  static bool supports(
+      const core::AggregationNode& node,
+      const core::QueryConfig& config);
+
+  RollupGroupingSets(
+      const core::AggregationNode& node,
+      OperatorCtx* operatorCtx,
+      tsan_atomic<bool>* nonReclaimableSection,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
+  /// Adds input with the layout of the GroupId output. The group id column is
+  /// ignored.
+  void addInput(const RowVectorPtr& input);
+
+  /// Merges the groups on all the grouping keys into the grouping sets.
+  void noMoreInput();
+
+  /// Returns the next batch of at most 'maxOutputRows' rows with the layout of
+  /// the aggregation output. Returns nullptr after all the grouping sets have
+  /// been returned. Without input, only the global grouping sets of the
+  /// aggregation return a row each.
+  RowVectorPtr getOutput(int32_t maxOutputRows, int32_t maxOutputBytes);
+
+  uint64_t allocatedBytes() const;
+
+ private:
+  // Number of groups on all the grouping keys merged into the grouping sets
+  // at a time.
+  static constexpr int32_t kMergeBatchRows = 1'024;
+
+  memory::MemoryPool* const pool_;
+  const RowTypePtr outputType_;
+
+  // Number of grouping key columns in the GroupId output. These are the first
+  // columns of the input.
+  const column_index_t numGroupIdKeys_;
+
+  // Indices of the grouping sets which return a row for empty input. See
+  // core::AggregationNode::globalGroupingSets().
+  const std::vector<vector_size_t> globalGroupingSets_;
+
+  // True if addInput() has been called with at least one row.
+  bool hasInput_{false};
+
+  // For each grouping key of the aggregation, the input channel of the key or
+  // std::nullopt for the group id.
+  std::vector<std::optional<column_index_t>> keyInputChannels_;
+
+  // For each grouping set, the input channels of its keys in the order of the
+  // keys in the grouping set's table.
+  std::vector<std::vector<column_index_t>> setKeyChannels_;
+
+  // Aggregation on all the grouping keys into intermediate results. The output
+  // has the 'numGroupIdKeys_' keys followed by the intermediate results.
+  std::unique_ptr<GroupingSet> allKeys_;
+  RowTypePtr allKeysType_;
+
+  // Merges the intermediate results into final results per grouping set. The
+  // output of a grouping set has its keys followed by the aggregates.
+  std::vector<std::unique_ptr<GroupingSet>> sets_;
+  std::vector<RowTypePtr> setTypes_;
+
+  // Grouping set being returned by getOutput().
+  size_t outputSet_{0};
+  RowContainerIterator outputIterator_;
+};
+
+} // namespace facebook::velox::exec
@@ -37,6 +37,34 @@ static int32_t typeKindSize(TypeKind kind) {
   return VELOX_DYNAMIC_TYPE_DISPATCH(kindSize, kind);
 }
 
+// Returns the number of bytes of the offset from 'range.min' of a value of
+// 'kind' in 'range', or 0 if this is not less than the size of 'kind'. The
+// range of a TIMESTAMP is in microseconds and its offset takes 8 bytes.
+int32_t compactBytes(
+    TypeKind kind,
+    const std::optional<RowContainer::ColumnRange>& range) {
+  if (!range.has_value() ||
+      (kind != TypeKind::SMALLINT && kind != TypeKind::INTEGER &&
+       kind != TypeKind::BIGINT && kind != TypeKind::TIMESTAMP)) {
+    return 0;
+  }
+  VELOX_CHECK_LE(range->min, range->max);
+  if (kind == TypeKind::TIMESTAMP) {
+    return sizeof(int64_t);
+  }
+  const auto delta =
+      static_cast<uint64_t>(range->max) - static_cast<uint64_t>(range->min);
+  for (const int32_t bytes : {1, 2, 4}) {
+    if (bytes >= typeKindSize(kind)) {
+      break;
+    }
+    if (delta < (1UL << (bytes * 8))) {
+      return bytes;
+    }
+  }
+  return 0;
+}
+
 #if defined(__has_feature)
 #if __has_feature(thread_sanitizer)
 __attribute__((__no_sanitize__("thread")))
@@ -137,7 +165,8 @@ RowContainer::RowContainer(
     bool isJoinBuild,
     bool hasProbedFlag,
     bool hasNormalizedKeys,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    const std::vector<std::optional<ColumnRange>>& dependentRanges)
     : keyTypes_(keyTypes),
       nullableKeys_(nullableKeys),
       isJoinBuild_(isJoinBuild),
@@ -173,6 +202,14 @@ RowContainer::RowContainer(
   // cardinality grows too large for packing all in 64
   // bits. 'numRowsWithNormalizedKey_' gives the number of rows with
   // the extra field.
+  //
+  // Integer dependent fields with a known range of values are stored as the
+  // offset from the lower bound of the range in 1, 2 or 4 bytes. Timestamp
+  // dependent fields with a known range of microseconds are stored as the
+  // offset in microseconds in 8 bytes.
+  VELOX_CHECK(
+      dependentRanges.empty() ||
+      (isJoinBuild && dependentRanges.size() == dependentTypes.size()));
   int32_t offset = 0;
   int32_t nullOffset = 0;
   bool isVariableWidth = false;
@@ -237,9 +274,14 @@ RowContainer::RowContainer(
     offsets_.push_back(offset);
     offset += accumulator.fixedWidthSize();
   }
-  for (auto& type : dependentTypes) {
+  std::vector<int32_t> dependentBytes(dependentTypes.size(), 0);
+  for (auto i = 0; i < dependentTypes.size(); ++i) {
+    const auto kind = dependentTypes[i]->kind();
+    if (!dependentRanges.empty()) {
+      dependentBytes[i] = compactBytes(kind, dependentRanges[i]);
+    }
     offsets_.push_back(offset);
-    offset += typeKindSize(type->kind());
+    offset += dependentBytes[i] != 0 ? dependentBytes[i] : typeKindSize(kind);
   }
   if (isVariableWidth) {
     rowSizeOffset_ = offset;
@@ -263,11 +305,18 @@ RowContainer::RowContainer(
       : 0;
   normalizedKeySize_ = originalNormalizedKeySize_;
   size_t nullOffsetsPos = 0;
+  const auto firstDependent = keyTypes_.size() + accumulators.size();
   for (auto i = 0; i < offsets_.size(); ++i) {
-    rowColumns_.emplace_back(
-        offsets_[i],
-        (nullableKeys_ || i >= keyTypes_.size()) ? nullOffsets_[nullOffsetsPos]
-                                                 : RowColumn::kNotNullOffset);
+    const auto nullOffset = (nullableKeys_ || i >= keyTypes_.size())
+        ? nullOffsets_[nullOffsetsPos]
+        : RowColumn::kNotNullOffset;
+    rowColumns_.emplace_back(offsets_[i], nullOffset);
+    if (i >= firstDependent && dependentBytes[i - firstDependent] != 0) {
+      compactColumns_.resize(offsets_.size());
+      compactColumns_[i] = {
+          dependentRanges[i - firstDependent]->min,
+          dependentBytes[i - firstDependent]};
+    }
 
     // offsets_ contains the offsets for keys, then accumulators, then dependent
     // columns.  This captures the case where i is the index of an accumulator.
@@ -523,7 +572,9 @@ void RowContainer::store(
     int32_t columnIndex) {
   auto numKeys = keyTypes_.size();
   bool isKey = columnIndex < numKeys;
-  if (isKey && !nullableKeys_) {
+  if (UNLIKELY(isCompactAt(columnIndex))) {
+    storeCompact(decoded, rowIndex, row, columnIndex);
+  } else if (isKey && !nullableKeys_) {
     VELOX_DYNAMIC_TYPE_DISPATCH(
         storeNoNulls,
         typeKinds_[columnIndex],
@@ -556,7 +607,11 @@ void RowContainer::store(
     int32_t column) {
   VELOX_CHECK_GE(decoded.size(), rows.size());
   const bool isKey = column < keyTypes_.size();
-  if ((isKey && !nullableKeys_) || !decoded.mayHaveNulls()) {
+  if (UNLIKELY(isCompactAt(column))) {
+    for (int32_t i = 0; i < rows.size(); ++i) {
+      store(decoded, i, rows[i], column);
+    }
+  } else if ((isKey && !nullableKeys_) || !decoded.mayHaveNulls()) {
     VELOX_DYNAMIC_TYPE_DISPATCH(
         storeNoNullsBatch,
         typeKinds_[column],
@@ -580,6 +635,65 @@ void RowContainer::store(
   }
 }
 
+void RowContainer::storeCompact(
+    const DecodedVector& decoded,
+    vector_size_t index,
+    char* row,
+    int32_t columnIndex) {
+  const auto column = rowColumns_[columnIndex];
+  const auto compact = compactColumns_[columnIndex];
+  uint64_t delta = 0;
+  if (decoded.isNullAt(index)) {
+    row[column.nullByte()] |= column.nullMask();
+  } else {
+    int64_t value;
+    switch (typeKinds_[columnIndex]) {
+      case TypeKind::SMALLINT:
+        value = decoded.valueAt<int16_t>(index);
+        break;
+      case TypeKind::INTEGER:
+        value = decoded.valueAt<int32_t>(index);
+        break;
+      case TypeKind::TIMESTAMP: {
+        const auto timestamp = decoded.valueAt<Timestamp>(index);
+        VELOX_CHECK(
+            isCompactTimestamp(timestamp),
+            "Timestamp {} does not fit a compact column",
+            timestamp.toString());
+        value = timestamp.toMicros();
+        break;
+      }
+      default:
+        VELOX_DCHECK_EQ(typeKinds_[columnIndex], TypeKind::BIGINT);
+        value = decoded.valueAt<int64_t>(index);
+        break;
+    }
+    delta = static_cast<uint64_t>(value) - static_cast<uint64_t>(compact.base);
+    VELOX_CHECK(
+        value >= compact.base &&
+            (compact.bytes == sizeof(uint64_t) ||
+             delta < (1UL << (compact.bytes * 8))),
+        "Value {} is outside of the range of a compact column",
+        value);
+  }
+  char* data = row + column.offset();
+  switch (compact.bytes) {
+    case 1:
+      *reinterpret_cast<uint8_t*>(data) = delta;
+      break;
+    case 2:
+      *reinterpret_cast<uint16_t*>(data) = delta;
+      break;
+    case 4:
+      *reinterpret_cast<uint32_t*>(data) = delta;
+      break;
+    default:
+      VELOX_DCHECK_EQ(compact.bytes, 8);
+      *reinterpret_cast<uint64_t*>(data) = delta;
+      break;
+  }
+}
+
 HashStringAllocator::InputStream RowContainer::prepareRead(
     const char* row,
     int32_t offset) {
@@ -612,6 +726,176 @@ int32_t RowContainer::fixedSizeAt(column_index_t column) const {
   return typeKindSize(typeKinds_[column]);
 }
 
+int32_t RowContainer::storedSizeAt(column_index_t column) const {
+  const auto bytes = compactBytesAt(column);
+  return bytes != 0 ? bytes : fixedSizeAt(column);
+}
+
+namespace {
+
+// Returns the value at 'offset' of 'row', stored as the 'bytes' wide offset
+// from 'base'.
+inline int64_t
+compactValueAt(const char* row, int32_t offset, int64_t base, int32_t bytes) {
+  const char* data = row + offset;
+  uint64_t delta;
+  switch (bytes) {
+    case 1:
+      delta = *reinterpret_cast<const uint8_t*>(data);
+      break;
+    case 2:
+      delta = *reinterpret_cast<const uint16_t*>(data);
+      break;
+    case 4:
+      delta = *reinterpret_cast<const uint32_t*>(data);
+      break;
+    default:
+      VELOX_DCHECK_EQ(bytes, 8);
+      delta = *reinterpret_cast<const uint64_t*>(data);
+      break;
+  }
+  return static_cast<int64_t>(static_cast<uint64_t>(base) + delta);
+}
+
+template <bool useRowNumbers, typename T>
+void extractCompactValues(
+    const char* const* rows,
+    folly::Range<const vector_size_t*> rowNumbers,
+    int32_t numRows,
+    RowColumn column,
+    int64_t base,
+    int32_t bytes,
+    bool columnHasNulls,
+    int32_t resultOffset,
+    FlatVector<T>* result) {
+  auto* values = result->mutableRawValues();
+  for (int32_t i = 0; i < numRows; ++i) {
+    const char* row;
+    if constexpr (useRowNumbers) {
+      auto rowNumber = rowNumbers[i];
+      row = rowNumber >= 0 ? rows[rowNumber] : nullptr;
+    } else {
+      row = rows[i];
+    }
+    auto resultIndex = resultOffset + i;
+    if (row == nullptr ||
+        (columnHasNulls && RowContainer::isNullAt(row, column))) {
+      result->setNull(resultIndex, true);
+    } else {
+      result->setNull(resultIndex, false);
+      const auto value = compactValueAt(row, column.offset(), base, bytes);
+      if constexpr (std::is_same_v<T, Timestamp>) {
+        values[resultIndex] = Timestamp::fromMicros(value);
+      } else {
+        values[resultIndex] = static_cast<T>(value);
+      }
+    }
+  }
+}
+
+template <typename T>
+void extractCompactValues(
+    const char* const* rows,
+    folly::Range<const vector_size_t*> rowNumbers,
+    int32_t numRows,
+    RowColumn column,
+    int64_t base,
+    int32_t bytes,
+    bool columnHasNulls,
+    int32_t resultOffset,
+    const VectorPtr& result) {
+  result->resize(numRows + resultOffset);
+  auto* flatResult = result->asFlatVector<T>();
+  if (rowNumbers.size() > 0) {
+    extractCompactValues<true, T>(
+        rows,
+        rowNumbers,
+        numRows,
+        column,
+        base,
+        bytes,
+        columnHasNulls,
+        resultOffset,
+        flatResult);
+  } else {
+    extractCompactValues<false, T>(
+        rows,
+        rowNumbers,
+        numRows,
+        column,
+        base,
+        bytes,
+        columnHasNulls,
+        resultOffset,
+        flatResult);
+  }
+}
+
+} // namespace
+
+void RowContainer::extractCompactColumn(
+    const char* const* rows,
+    folly::Range<const vector_size_t*> rowNumbers,
+    int32_t numRows,
+    int32_t columnIndex,
+    bool columnHasNulls,
+    int32_t resultOffset,
+    const VectorPtr& result) const {
+  const auto column = rowColumns_[columnIndex];
+  const auto compact = compactColumns_[columnIndex];
+  switch (typeKinds_[columnIndex]) {
+    case TypeKind::SMALLINT:
+      extractCompactValues<int16_t>(
+          rows,
+          rowNumbers,
+          numRows,
+          column,
+          compact.base,
+          compact.bytes,
+          columnHasNulls,
+          resultOffset,
+          result);
+      break;
+    case TypeKind::INTEGER:
+      extractCompactValues<int32_t>(
+          rows,
+          rowNumbers,
+          numRows,
+          column,
+          compact.base,
+          compact.bytes,
+          columnHasNulls,
+          resultOffset,
+          result);
+      break;
+    case TypeKind::BIGINT:
+      extractCompactValues<int64_t>(
+          rows,
+          rowNumbers,
+          numRows,
+          column,
+          compact.base,
+          compact.bytes,
+          columnHasNulls,
+          resultOffset,
+          result);
+      break;
+    default:
+      VELOX_DCHECK_EQ(typeKinds_[columnIndex], TypeKind::TIMESTAMP);
+      extractCompactValues<Timestamp>(
+          rows,
+          rowNumbers,
+          numRows,
+          column,
+          compact.base,
+          compact.bytes,
+          columnHasNulls,
+          resultOffset,
+          result);
+      break;
+  }
+}
+
 int32_t RowContainer::extractVariableSizeAt(
     const char* row,
     column_index_t column,
@@ -701,7 +985,7 @@ void RowContainer::extractSerializedRows(
   for (auto i = 0; i < types_.size(); ++i) {
     const auto& type = types_[i];
     if (type->isFixedWidth()) {
-      fixedWidthRowSize += typeKindSize(type->kind());
+      fixedWidthRowSize += storedSizeAt(i);
     } else {
       hasVariableWidth = true;
     }
@@ -740,7 +1024,7 @@ void RowContainer::extractSerializedRows(
     for (auto j = 0; j < types_.size(); ++j) {
       const auto& type = types_[j];
       if (type->isFixedWidth()) {
-        const auto size = typeKindSize(type->kind());
+        const auto size = storedSizeAt(j);
         ::memcpy(rawBuffer + offset, row + rowColumns_[j].offset(), size);
         offset += size;
       } else {
@@ -772,7 +1056,7 @@ void RowContainer::storeSerializedRow(
   for (auto i = 0; i < types_.size(); ++i) {
     const auto& type = types_[i];
     if (type->isFixedWidth()) {
-      const auto size = typeKindSize(type->kind());
+      const auto size = storedSizeAt(i);
       ::memcpy(row + rowColumns_[i].offset(), serialized.data() + offset, size);
       offset += size;
     } else {
@@ -264,6 +264,23 @@ class RowContainer {
   static constexpr size_t kNumAccumulatorFlags = 2;
   using Eraser = std::function<void(folly::Range<char**> rows)>;
 
+  /// Inclusive range of the values of an integer column. For a TIMESTAMP
+  /// column, the range of the values in microseconds.
+  struct ColumnRange {
+    int64_t min;
+    int64_t max;
+  };
+
+  /// Returns true if 'timestamp' can be stored in a compact TIMESTAMP column,
+  /// i.e. it is a whole number of microseconds that fits in an int64_t.
+  static bool isCompactTimestamp(const Timestamp& timestamp) {
+    constexpr int64_t kMaxSeconds =
+        std::numeric_limits<int64_t>::max() / 1'000'000 - 1;
+    return timestamp.getNanos() % 1'000 == 0 &&
+        timestamp.getSeconds() >= -kMaxSeconds &&
+        timestamp.getSeconds() <= kMaxSeconds;
+  }
+
   /// 'keyTypes' gives the type of row and use 'allocator' for bulk
   /// allocation.
   RowContainer(const std::vector<TypePtr>& keyTypes, memory::MemoryPool* pool)
@@ -303,7 +320,13 @@ class RowContainer {
   /// below each row for a normalized key that collapses all parts
   /// into one word for faster comparison. The bulk allocation is done
   /// from 'allocator'. ContainerRowSerde is used for serializing complex
-  /// type values into the container.
+  /// type values into the container. 'dependentRanges' is either empty or
+  /// corresponds 1:1 to 'dependentTypes' and gives the range of the values of
+  /// SMALLINT, INTEGER and BIGINT dependent columns of a hash join build side.
+  /// Such columns are stored as the offset from the lower bound in the fewest
+  /// bytes that fit the range. Storing a value outside of the range throws.
+  /// A TIMESTAMP dependent column with a range in microseconds is stored in 8
+  /// instead of 16 bytes. All its values must satisfy isCompactTimestamp().
   RowContainer(
       const std::vector<TypePtr>& keyTypes,
       bool nullableKeys,
@@ -313,7 +336,8 @@ class RowContainer {
       bool isJoinBuild,
       bool hasProbedFlag,
       bool hasNormalizedKey,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      const std::vector<std::optional<ColumnRange>>& dependentRanges = {});
 
   /// Allocates a new row and initializes possible aggregates to null.
   char* newRow();
@@ -475,28 +499,48 @@ class RowContainer {
       int32_t numRows,
       int32_t columnIndex,
       const VectorPtr& result) const {
+    extractColumn(
+        rows, numRows, columnIndex, columnHasNulls(columnIndex), 0, result);
+  }
+
+  /// Copies the values at 'columnIndex' into 'result' (starting at
+  /// 'resultOffset') for the 'numRows' rows pointed to by 'rows'. If an
+  /// entry in 'rows' is null, sets corresponding row in 'result' to null.
+  void extractColumn(
+      const char* const* rows,
+      int32_t numRows,
+      int32_t columnIndex,
+      int32_t resultOffset,
+      const VectorPtr& result) const {
     extractColumn(
         rows,
         numRows,
-        columnAt(columnIndex),
+        columnIndex,
         columnHasNulls(columnIndex),
+        resultOffset,
         result);
   }
 
-  /// Copies the values at 'columnIndex' into 'result' (starting at
-  /// 'resultOffset') for the 'numRows' rows pointed to by 'rows'. If an
-  /// entry in 'rows' is null, sets corresponding row in 'result' to null.
+  /// Same as above with the caller providing 'columnHasNulls', e.g. for rows
+  /// of several containers with the same layout. Unlike the static overloads,
+  /// this also decodes compact columns, see compactBytesAt().
   void extractColumn(
       const char* const* rows,
       int32_t numRows,
       int32_t columnIndex,
+      bool columnHasNulls,
       int32_t resultOffset,
       const VectorPtr& result) const {
+    if (UNLIKELY(isCompactAt(columnIndex))) {
+      extractCompactColumn(
+          rows, {}, numRows, columnIndex, columnHasNulls, resultOffset, result);
+      return;
+    }
     extractColumn(
         rows,
         numRows,
         columnAt(columnIndex),
-        columnHasNulls(columnIndex),
+        columnHasNulls,
         resultOffset,
         result);
   }
@@ -514,6 +558,17 @@ class RowContainer {
       int32_t columnIndex,
       const vector_size_t resultOffset,
       const VectorPtr& result) const {
+    if (UNLIKELY(isCompactAt(columnIndex))) {
+      extractCompactColumn(
+          rows,
+          rowNumbers,
+          rowNumbers.size(),
+          columnIndex,
+          columnHasNulls(columnIndex),
+          resultOffset,
+          result);
+      return;
+    }
     extractColumn(
         rows,
         rowNumbers,
@@ -732,9 +787,19 @@ class RowContainer {
   /// specified row and column.
   int32_t variableSizeAt(const char* row, column_index_t column) const;
 
-  /// Returns the per row size of a fixed size column.
+  /// Returns the per row size of a fixed size column. This is the size of a
+  /// value of the column type, also for frame-of-reference encoded columns.
   int32_t fixedSizeAt(column_index_t column) const;
 
+  /// Number of bytes of a frame-of-reference encoded dependent column, i.e.
+  /// of the offset of its values from the lower bound of their range. 0 if
+  /// the column is stored at full width. A compact TIMESTAMP is the offset in
+  /// microseconds in 8 bytes. Compact columns are only decoded by the member
+  /// extractColumn() overloads, not by the static ones taking a RowColumn.
+  int32_t compactBytesAt(column_index_t column) const {
+    return compactColumns_.empty() ? 0 : compactColumns_[column].bytes;
+  }
+
   /// Bit offset of the probed flag for a full or right outer join  payload.
   /// 0 if not applicable.
   int32_t probedFlagOffset() const {
@@ -910,6 +975,32 @@ class RowContainer {
     return *reinterpret_cast<T*>(group + offset);
   }
 
+  // Frame-of-reference encoding of a dependent column.
+  struct CompactColumn {
+    // Lower bound of the values.
+    int64_t base{0};
+    // Bytes per value, 0 if the column is stored at full width.
+    int32_t bytes{0};
+  };
+
+  bool isCompactAt(column_index_t column) const {
+    return !compactColumns_.empty() && compactColumns_[column].bytes != 0;
+  }
+
+  // Returns the number of bytes 'column' occupies in a row.
+  int32_t storedSizeAt(column_index_t column) const;
+
+  // Decodes the compact column at 'columnIndex'. See the extractColumn()
+  // overloads for the other arguments.
+  void extractCompactColumn(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t columnIndex,
+      bool columnHasNulls,
+      int32_t resultOffset,
+      const VectorPtr& result) const;
+
   // Copies a string or complex type value from the specified row and column
   // into provided buffer. Stored the size of the data in the first 4 bytes of
   // the buffer. If the value is null, writes zero into the first 4 bytes of
@@ -1160,6 +1251,14 @@ class RowContainer {
     }
   }
 
+  // Stores the 'index'th value of 'decoded' into the frame-of-reference
+  // encoded column at 'columnIndex' of 'row'.
+  void storeCompact(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      char* row,
+      int32_t columnIndex);
+
   static HashStringAllocator::InputStream prepareRead(
       const char* row,
       int32_t offset);
@@ -1520,6 +1619,11 @@ class RowContainer {
   // Offset and null indicator offset of non-aggregate fields as a single word.
   // Corresponds pairwise to 'types_'.
   std::vector<RowColumn> rowColumns_;
+  // Encoding of the columns of a join build with dependent ranges. Corresponds
+  // pairwise to 'types_' if any column is compact and is empty otherwise. Kept
+  // out of RowColumn so that it stays one word and the default paths only
+  // check for emptiness.
+  std::vector<CompactColumn> compactColumns_;
   // Aggregated column stats(e.g. min/max size) for non-aggregate
   // fields. Index aligns with 'rowColumns_'.
   std::vector<RowColumn::Stats> rowColumnsStats_;
@@ -29,6 +29,51 @@ bool hasRangeFrame(const std::shared_ptr<const core::WindowNode>& windowNode) {
   }
   return false;
 }
+
+// Returns the constant offset of a k PRECEDING or k FOLLOWING bound of a ROWS
+// frame, or 0 for the other bounds. The offsets that do not fit in
+// vector_size_t are capped, which keeps all the rows of the partition.
+vector_size_t rowsFrameOffset(
+    const core::WindowNode::Frame& frame,
+    const core::TypedExprPtr& value) {
+  if (frame.type != core::WindowNode::WindowType::kRows ||
+      !core::TypedExprs::isConstant(value)) {
+    return 0;
+  }
+  const auto& constant = core::TypedExprs::asConstant(value)->value();
+  if (constant.isNull()) {
+    return 0;
+  }
+  const auto offset =
+      VariantConverter::convert(constant, TypeKind::BIGINT).value<int64_t>();
+  return std::clamp<int64_t>(
+      offset, 0, std::numeric_limits<vector_size_t>::max());
+}
+
+// Returns the max number of rows before and after the current row that the
+// ROWS frames of the window functions refer to.
+std::pair<vector_size_t, vector_size_t> frameOffsets(
+    const std::shared_ptr<const core::WindowNode>& windowNode) {
+  vector_size_t numPrecedingRows{0};
+  vector_size_t numFollowingRows{0};
+  const auto addOffset = [&](const core::WindowNode::Frame& frame,
+                             core::WindowNode::BoundType boundType,
+                             const core::TypedExprPtr& value) {
+    if (boundType == core::WindowNode::BoundType::kPreceding) {
+      numPrecedingRows =
+          std::max(numPrecedingRows, rowsFrameOffset(frame, value));
+    } else if (boundType == core::WindowNode::BoundType::kFollowing) {
+      numFollowingRows =
+          std::max(numFollowingRows, rowsFrameOffset(frame, value));
+    }
+  };
+  for (const auto& function : windowNode->windowFunctions()) {
+    const auto& frame = function.frame;
+    addOffset(frame, frame.startType, frame.startValue);
+    addOffset(frame, frame.endType, frame.endValue);
+  }
+  return {numPrecedingRows, numFollowingRows};
+}
 } // namespace
 
 RowsStreamingWindowBuild::RowsStreamingWindowBuild(
@@ -37,7 +82,8 @@ RowsStreamingWindowBuild::RowsStreamingWindowBuild(
     const common::SpillConfig* spillConfig,
     tsan_atomic<bool>* nonReclaimableSection)
     : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection),
-      hasRangeFrame_(hasRangeFrame(windowNode)) {
+      hasRangeFrame_(hasRangeFrame(windowNode)),
+      frameOffsets_(frameOffsets(windowNode)) {
   velox::common::testutil::TestValue::adjust(
       "facebook::velox::exec::RowsStreamingWindowBuild::RowsStreamingWindowBuild",
       this);
@@ -51,7 +97,11 @@ bool RowsStreamingWindowBuild::needsInput() {
 void RowsStreamingWindowBuild::ensureInputPartition() {
   if (windowPartitions_.empty() || windowPartitions_.back()->complete()) {
     windowPartitions_.emplace_back(std::make_shared<WindowPartition>(
-        data_.get(), inversedInputChannels_, sortKeyInfo_));
+        data_.get(),
+        inversedInputChannels_,
+        sortKeyInfo_,
+        frameOffsets_.first,
+        frameOffsets_.second));
   }
 }
 
@@ -114,7 +164,7 @@ std::shared_ptr<WindowPartition> RowsStreamingWindowBuild::nextPartition() {
   // NOTE: the window operator only calls this after processing a completed
   // partition.
   if (!windowPartitions_.empty() && windowPartitions_.front()->complete() &&
-      windowPartitions_.front()->numRows() == 0) {
+      !windowPartitions_.front()->hasUnprocessedRows()) {
     windowPartitions_.pop_front();
   }
 
@@ -128,7 +178,7 @@ bool RowsStreamingWindowBuild::hasNextPartition() {
   for (auto it = windowPartitions_.rbegin(); it != windowPartitions_.rend();
        ++it) {
     const auto& windowPartition = *it;
-    if (!windowPartition->complete() || windowPartition->numRows() > 0) {
+    if (!windowPartition->complete() || windowPartition->hasUnprocessedRows()) {
       return true;
     }
   }
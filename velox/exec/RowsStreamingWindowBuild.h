@@ -26,7 +26,10 @@ namespace facebook::velox::exec {
 /// approach can significantly reduce memory usage, especially when a single
 /// partition contains a large amount of data. It is particularly suited for
 /// optimizing rank, dense_rank and row_number functions, as well as aggregate
-/// window functions with a default frame.
+/// window functions with a default frame or a ROWS frame bounded by constant
+/// offsets, e.g. ROWS BETWEEN 10 PRECEDING AND 5 FOLLOWING. For the latter,
+/// the window partition keeps only the last processed rows the next frames
+/// can start at and frees the rows before them.
 class RowsStreamingWindowBuild : public WindowBuild {
  public:
   RowsStreamingWindowBuild(
@@ -67,6 +70,10 @@ class RowsStreamingWindowBuild : public WindowBuild {
   // Sets to true if this window node has range frames.
   const bool hasRangeFrame_;
 
+  // The max number of rows before and after the current row that the ROWS
+  // frames of the window functions refer to.
+  const std::pair<vector_size_t, vector_size_t> frameOffsets_;
+
   // Points to the input rows in the current partition.
   std::vector<char*> inputRows_;
 
@@ -28,6 +28,7 @@ ScaleWriterPartitioningLocalPartition::ScaleWriterPartitioningLocalPartition(
     : LocalPartition(operatorId, ctx, planNode, false),
       maxQueryMemoryUsageRatio_(
           ctx->queryConfig().scaleWriterRebalanceMaxMemoryUsageRatio()),
+      maxSinkIoTimeRatio_(ctx->queryConfig().scaleWriterMaxSinkIoTimeRatio()),
       maxTablePartitionsPerWriter_(
           ctx->queryConfig().scaleWriterMaxPartitionsPerWriter()),
       numTablePartitions_(maxTablePartitionsPerWriter_ * numPartitions_),
@@ -66,6 +67,9 @@ void ScaleWriterPartitioningLocalPartition::initialize() {
   memoryManager_ =
       operatorCtx_->driver()->task()->getLocalExchangeMemoryManager(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+  VELOX_CHECK_NULL(sinkTracker_);
+  sinkTracker_ = operatorCtx_->driver()->task()->getScaleWriterSinkTracker(
+      operatorCtx_->driverCtx()->splitGroupId, planNodeId());
 }
 
 void ScaleWriterPartitioningLocalPartition::prepareForWriterAssignments(
@@ -122,7 +126,13 @@ void ScaleWriterPartitioningLocalPartition::addInput(RowVectorPtr input) {
       // able to do anything to prevent query OOM.
       queryPool_->reservedBytes() <
           queryPool_->maxCapacity() * maxQueryMemoryUsageRatio_) {
-    tablePartitionRebalancer_->rebalance();
+    // Do not scale up if the writers spend most of their time waiting on the
+    // storage, which more writers would not speed up.
+    if (sinkTracker_->ioTimeRatio() > maxSinkIoTimeRatio_) {
+      ++numSinkIoBoundSkips_;
+    } else {
+      tablePartitionRebalancer_->rebalance();
+    }
   }
 
   const auto singlePartition =
@@ -223,6 +233,11 @@ uint32_t ScaleWriterPartitioningLocalPartition::getNextWriterId(
 void ScaleWriterPartitioningLocalPartition::close() {
   LocalPartition::close();
 
+  if (numSinkIoBoundSkips_ != 0) {
+    stats_.wlock()->addRuntimeStat(
+        kSinkIoBoundSkips, RuntimeCounter(numSinkIoBoundSkips_));
+  }
+
   // The last driver operator reports the shared table partition rebalancer
   // stats. We expect one reference hold by this operator and one referenced by
   // the task.
@@ -249,6 +264,7 @@ ScaleWriterLocalPartition::ScaleWriterLocalPartition(
     : LocalPartition(operatorId, ctx, planNode, false),
       maxQueryMemoryUsageRatio_(
           ctx->queryConfig().scaleWriterRebalanceMaxMemoryUsageRatio()),
+      maxSinkIoTimeRatio_(ctx->queryConfig().scaleWriterMaxSinkIoTimeRatio()),
       queryPool_(pool()->root()),
       minDataProcessedBytes_(
           ctx->queryConfig()
@@ -265,6 +281,9 @@ void ScaleWriterLocalPartition::initialize() {
   memoryManager_ =
       operatorCtx_->driver()->task()->getLocalExchangeMemoryManager(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+  VELOX_CHECK_NULL(sinkTracker_);
+  sinkTracker_ = operatorCtx_->driver()->task()->getScaleWriterSinkTracker(
+      operatorCtx_->driverCtx()->splitGroupId, planNodeId());
 }
 
 void ScaleWriterLocalPartition::addInput(RowVectorPtr input) {
@@ -314,10 +333,16 @@ uint32_t ScaleWriterLocalPartition::getNextWriterId() {
        numWriters_ * minDataProcessedBytes_) &&
       (queryPool_->reservedBytes() <
        queryPool_->maxCapacity() * maxQueryMemoryUsageRatio_)) {
-    ++numWriters_;
-    processedBytesAtLastScale_ = processedDataBytes_;
-    LOG(INFO) << "Scaled task writer count to: " << numWriters_
-              << " with max of " << numPartitions_;
+    // Do not scale up if the writers spend most of their time waiting on the
+    // storage, which more writers would not speed up.
+    if (sinkTracker_->ioTimeRatio() > maxSinkIoTimeRatio_) {
+      ++numSinkIoBoundSkips_;
+    } else {
+      ++numWriters_;
+      processedBytesAtLastScale_ = processedDataBytes_;
+      LOG(INFO) << "Scaled task writer count to: " << numWriters_
+                << " with max of " << numPartitions_;
+    }
   }
   return (nextWriterIndex_++) % numWriters_;
 }
@@ -325,6 +350,10 @@ uint32_t ScaleWriterLocalPartition::getNextWriterId() {
 void ScaleWriterLocalPartition::close() {
   LocalPartition::close();
 
+  if (numSinkIoBoundSkips_ != 0) {
+    stats_.wlock()->addRuntimeStat(
+        kSinkIoBoundSkips, RuntimeCounter(numSinkIoBoundSkips_));
+  }
   if (numWriters_ == 1) {
     return;
   }
@@ -47,6 +47,9 @@ class ScaleWriterPartitioningLocalPartition : public LocalPartition {
   static inline const std::string kRebalanceTriggers{"rebalanceTriggers"};
   /// The number of times that we scale a partition processing.
   static inline const std::string kScaledPartitions{"scaledPartitions"};
+  /// The number of inputs for which we held the rebalance because the table
+  /// writers are bound by the sink write I/O.
+  static inline const std::string kSinkIoBoundSkips{"sinkIoBoundSkips"};
 
  private:
   void prepareForWriterAssignments(vector_size_t numInput);
@@ -55,6 +58,9 @@ class ScaleWriterPartitioningLocalPartition : public LocalPartition {
 
   // The max query memory usage ratio before we stop writer scaling.
   const double maxQueryMemoryUsageRatio_;
+  // The max ratio of sink write I/O time to sink append time of the table
+  // writers before we stop writer scaling.
+  const double maxSinkIoTimeRatio_;
   // The max number of logical table partitions that can be assigned to a single
   // table writer thread. Multiple physical table partitions can be mapped to
   // one logical table partition.
@@ -69,6 +75,11 @@ class ScaleWriterPartitioningLocalPartition : public LocalPartition {
   const std::shared_ptr<SkewedPartitionRebalancer> tablePartitionRebalancer_;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
+  std::shared_ptr<ScaleWriterSinkTracker> sinkTracker_;
+
+  // The number of inputs for which the rebalance was held because the table
+  // writers are bound by the sink write I/O.
+  uint64_t numSinkIoBoundSkips_{0};
 
   // Reusable memory for writer assignment processing.
   std::vector<uint32_t> tablePartitionRowCounts_;
@@ -99,6 +110,9 @@ class ScaleWriterLocalPartition : public LocalPartition {
   /// The name of the runtime stats of writer scaling.
   /// The number of scaled writers.
   static inline const std::string kScaledWriters{"scaledWriters"};
+  /// The number of inputs for which we held the writer scaling because the
+  /// table writers are bound by the sink write I/O.
+  static inline const std::string kSinkIoBoundSkips{"sinkIoBoundSkips"};
 
  private:
   // Gets the writer id to process the next input in a round-robin manner.
@@ -106,12 +120,16 @@ class ScaleWriterLocalPartition : public LocalPartition {
 
   // The max query memory usage ratio before we stop writer scaling.
   const double maxQueryMemoryUsageRatio_;
+  // The max ratio of sink write I/O time to sink append time of the table
+  // writers before we stop writer scaling.
+  const double maxSinkIoTimeRatio_;
   memory::MemoryPool* const queryPool_;
   // The minimal amount of processed data bytes before we trigger next writer
   // scaling.
   const uint64_t minDataProcessedBytes_;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
+  std::shared_ptr<ScaleWriterSinkTracker> sinkTracker_;
 
   // The number of assigned writers.
   uint32_t numWriters_{1};
@@ -122,5 +140,8 @@ class ScaleWriterLocalPartition : public LocalPartition {
   uint64_t processedDataBytes_{0};
   // The total processed data bytes at the last writer scaling.
   uint64_t processedBytesAtLastScale_{0};
+  // The number of inputs for which the writer scaling was held because the
+  // table writers are bound by the sink write I/O.
+  uint64_t numSinkIoBoundSkips_{0};
 };
 } // namespace facebook::velox::exec
@@ -93,16 +93,10 @@ SerializedPageSpiller::Result SerializedPageSpiller::finishSpill() {
   return {std::move(spillFiles), totalPages_};
 }
 
-void SerializedPageSpiller::flushBuffer(
-    SpillWriteFile* file,
-    uint64_t& writtenBytes,
-    uint64_t& flushTimeNs,
-    uint64_t& writeTimeNs) {
+std::unique_ptr<folly::IOBuf> SerializedPageSpiller::flushBuffer(
+    uint64_t& flushTimeNs) {
   flushTimeNs = 0;
-  {
-    NanosecondTimer timer(&writeTimeNs);
-    writtenBytes = file->write(bufferStream_->getIOBuf());
-  }
+  return bufferStream_->getIOBuf();
 }
 
 bool SerializedPageSpiller::bufferEmpty() const {
@@ -62,11 +62,7 @@ class SerializedPageSpiller : public SpillWriterBase {
   Result finishSpill();
 
  private:
-  void flushBuffer(
-      SpillWriteFile* file,
-      uint64_t& writtenBytes,
-      uint64_t& flushTimeNs,
-      uint64_t& writeTimeNs) override;
+  std::unique_ptr<folly::IOBuf> flushBuffer(uint64_t& flushTimeNs) override;
 
   bool bufferEmpty() const override;
 
@@ -110,6 +106,11 @@ class SerializedPageSpillReader {
   /// Returns the current number of pages in the reader.
   uint64_t numPages() const;
 
+  /// Returns the number of pages at the front which are read back in memory.
+  uint64_t numBufferedPages() const {
+    return bufferedPages_.size();
+  }
+
   /// Returns the page at 'index' in the reader.
   std::shared_ptr<SerializedPage> at(uint64_t index);
 
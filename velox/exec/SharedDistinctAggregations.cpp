@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/SharedDistinctAggregations.h"
+
+namespace facebook::velox::exec {
+
+SharedDistinctAggregations::SharedDistinctAggregations(
+    std::vector<AggregateInfo*> aggregates,
+    const RowTypePtr& inputType,
+    memory::MemoryPool* pool)
+    : pool_{pool}, aggregates_{std::move(aggregates)} {
+  VELOX_CHECK(!aggregates_.empty());
+
+  for (const auto* aggregate : aggregates_) {
+    VELOX_CHECK(canShare(*aggregate, inputType));
+    const auto& type = inputType->childAt(aggregate->inputs[0]);
+    inputTypes_.push_back(type);
+
+    column_index_t column = 0;
+    while (column < valueTypes_.size() &&
+           !valueTypes_[column]->equivalent(*type)) {
+      ++column;
+    }
+    if (column == valueTypes_.size()) {
+      valueTypes_.push_back(type);
+    }
+    valueColumns_.push_back(kFirstValueColumn + column);
+  }
+
+  std::vector<TypePtr> probeTypes{BIGINT(), INTEGER()};
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  hashers.push_back(VectorHasher::create(BIGINT(), kGroupColumn));
+  hashers.push_back(VectorHasher::create(INTEGER(), kIdColumn));
+  for (auto i = 0; i < valueTypes_.size(); ++i) {
+    probeTypes.push_back(valueTypes_[i]);
+    hashers.push_back(
+        VectorHasher::create(valueTypes_[i], kFirstValueColumn + i));
+  }
+  probeType_ = ROW(std::move(probeTypes));
+
+  table_ =
+      HashTable<false>::createForAggregation(std::move(hashers), {}, pool_);
+  // The group addresses never fit an array or normalized keys.
+  table_->forceGenericHashMode(BaseHashTable::kNoSpillInputStartPartitionBit);
+  lookup_ = std::make_unique<HashLookup>(table_->hashers(), pool_);
+  groupOffset_ = table_->rows()->columnAt(kGroupColumn).offset();
+  idOffset_ = table_->rows()->columnAt(kIdColumn).offset();
+
+  probeChildren_.resize(probeType_->size());
+  batchRows_.resize(aggregates_.size());
+  batchGroups_.resize(aggregates_.size());
+}
+
+// static
+bool SharedDistinctAggregations::canShare(
+    const AggregateInfo& aggregate,
+    const RowTypePtr& inputType) {
+  if (!aggregate.distinct || aggregate.inputs.size() != 1 ||
+      !aggregate.sortingKeys.empty()) {
+    return false;
+  }
+  const auto& type = inputType->childAt(aggregate.inputs[0]);
+  return type->kind() != TypeKind::UNKNOWN &&
+      !type->providesCustomComparison();
+}
+
+void SharedDistinctAggregations::addInput(
+    int32_t aggregateId,
+    char** groups,
+    const RowVectorPtr& input,
+    const SelectivityVector& rows) {
+  const auto numRows = input->size();
+
+  auto groupVector =
+      BaseVector::create<FlatVector<int64_t>>(BIGINT(), numRows, pool_);
+  auto* rawGroups = groupVector->mutableRawValues();
+  rows.applyToSelected([&](vector_size_t row) {
+    rawGroups[row] = reinterpret_cast<int64_t>(groups[row]);
+  });
+
+  probeChildren_[kGroupColumn] = std::move(groupVector);
+  probeChildren_[kIdColumn] =
+      BaseVector::createConstant(INTEGER(), aggregateId, numRows, pool_);
+  for (auto column = kFirstValueColumn; column < probeChildren_.size();
+       ++column) {
+    if (column == valueColumns_[aggregateId]) {
+      probeChildren_[column] =
+          input->childAt(aggregates_[aggregateId]->inputs[0]);
+    } else {
+      probeChildren_[column] = BaseVector::createNullConstant(
+          valueTypes_[column - kFirstValueColumn], numRows, pool_);
+    }
+  }
+  auto probeInput = std::make_shared<RowVector>(
+      pool_, probeType_, nullptr, numRows, std::move(probeChildren_));
+  probeChildren_.resize(probeType_->size());
+
+  probeRows_ = rows;
+  table_->prepareForGroupProbe(
+      *lookup_,
+      probeInput,
+      probeRows_,
+      BaseHashTable::kNoSpillInputStartPartitionBit);
+  if (lookup_->rows.empty()) {
+    return;
+  }
+  table_->groupProbe(*lookup_, BaseHashTable::kNoSpillInputStartPartitionBit);
+  sorted_ = false;
+}
+
+void SharedDistinctAggregations::sortRows() {
+  sortedRows_.resize(table_->numDistinct());
+  RowContainerIterator iterator;
+  const auto numRows = table_->rows()->listRows(
+      &iterator, sortedRows_.size(), sortedRows_.data());
+  VELOX_CHECK_EQ(numRows, sortedRows_.size());
+
+  std::sort(
+      sortedRows_.begin(),
+      sortedRows_.end(),
+      [&](const char* left, const char* right) {
+        const auto leftGroup = groupAt(left);
+        const auto rightGroup = groupAt(right);
+        if (leftGroup != rightGroup) {
+          return leftGroup < rightGroup;
+        }
+        return idAt(left) < idAt(right);
+      });
+  sorted_ = true;
+}
+
+void SharedDistinctAggregations::extractValues(
+    folly::Range<char**> groups,
+    const RowVectorPtr& result) {
+  if (!sorted_) {
+    sortRows();
+  }
+
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    batchRows_[i].clear();
+    batchGroups_[i].clear();
+  }
+
+  // The distinct values of a group are contiguous in 'sortedRows_'.
+  for (auto* group : groups) {
+    const auto address = reinterpret_cast<int64_t>(group);
+    auto it = std::lower_bound(
+        sortedRows_.begin(),
+        sortedRows_.end(),
+        address,
+        [&](const char* row, int64_t value) { return groupAt(row) < value; });
+    for (; it != sortedRows_.end() && groupAt(*it) == address; ++it) {
+      const auto id = idAt(*it);
+      batchRows_[id].push_back(*it);
+      batchGroups_[id].push_back(group);
+    }
+  }
+
+  SelectivityVector rows;
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto& aggregate = *aggregates_[i];
+    const auto numValues = batchRows_[i].size();
+    if (numValues > 0) {
+      auto values = BaseVector::create(inputTypes_[i], numValues, pool_);
+      table_->rows()->extractColumn(
+          batchRows_[i].data(), numValues, valueColumns_[i], values);
+      rows.resize(numValues);
+      aggregate.function->addRawInput(
+          batchGroups_[i].data(), rows, {values}, false);
+    }
+
+    aggregate.function->extractValues(
+        groups.data(), groups.size(), &result->childAt(aggregate.output));
+
+    // Release memory back to HashStringAllocator and overwrite empty groups
+    // over the destructed groups to keep the container in a well formed state.
+    aggregate.function->destroy(groups);
+    raw_vector<int32_t> temp;
+    aggregate.function->initializeNewGroups(
+        groups.data(),
+        folly::Range<const int32_t*>(iota(groups.size(), temp), groups.size()));
+  }
+}
+
+void SharedDistinctAggregations::clear() {
+  table_->clear(/*freeTable=*/true);
+  sortedRows_.clear();
+  sorted_ = false;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/AggregateInfo.h"
+#include "velox/exec/HashTable.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Computes several single-input distinct aggregations, e.g. count(distinct
+/// a), count(distinct b), using one hash table on (group, aggregate id, value)
+/// instead of one set accumulator per group and aggregate. The group is the
+/// address of the group row in the grouping table, so the groups must not move
+/// or be freed while input is being added, i.e. the grouping table must not
+/// spill or evict. Inputs of equivalent types share one value column of the
+/// table. The distinct values are fed to the aggregate functions when the
+/// results are extracted.
+class SharedDistinctAggregations {
+ public:
+  /// @param aggregates Distinct aggregates for which 'canShare' is true. The
+  /// position of an aggregate in this list is its id for 'addInput'.
+  /// @param inputType Input row type for the aggregation operator.
+  /// @param pool Memory pool for the hash table and the extracted values.
+  SharedDistinctAggregations(
+      std::vector<AggregateInfo*> aggregates,
+      const RowTypePtr& inputType,
+      memory::MemoryPool* pool);
+
+  /// Returns true if 'aggregate' is a distinct aggregate over a single column
+  /// whose values can be keys of the shared hash table.
+  static bool canShare(
+      const AggregateInfo& aggregate,
+      const RowTypePtr& inputType);
+
+  /// Adds the distinct values of 'rows' of the input of aggregate
+  /// 'aggregateId' to the groups in 'groups'. The accumulators of the
+  /// aggregate function must have been initialized for new groups.
+  void addInput(
+      int32_t aggregateId,
+      char** groups,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows);
+
+  /// Aggregates the distinct values of 'groups' and stores the results in
+  /// 'result'.
+  void extractValues(folly::Range<char**> groups, const RowVectorPtr& result);
+
+  /// Frees the distinct values. Must be called when the groups are cleared.
+  void clear();
+
+  int64_t allocatedBytes() const {
+    return table_->allocatedBytes();
+  }
+
+ private:
+  // Column of the group address and of the aggregate id in 'table_'. The value
+  // columns follow.
+  static constexpr column_index_t kGroupColumn = 0;
+  static constexpr column_index_t kIdColumn = 1;
+  static constexpr column_index_t kFirstValueColumn = 2;
+
+  // Sorts the rows of 'table_' on group address and aggregate id.
+  void sortRows();
+
+  int64_t groupAt(const char* row) const {
+    return RowContainer::valueAt<int64_t>(row, groupOffset_);
+  }
+
+  int32_t idAt(const char* row) const {
+    return RowContainer::valueAt<int32_t>(row, idOffset_);
+  }
+
+  memory::MemoryPool* const pool_;
+  const std::vector<AggregateInfo*> aggregates_;
+
+  // Value column of 'table_' for each aggregate.
+  std::vector<column_index_t> valueColumns_;
+
+  // Type of the input of each aggregate.
+  std::vector<TypePtr> inputTypes_;
+
+  // Type of each value column.
+  std::vector<TypePtr> valueTypes_;
+
+  // Type of the probe input: group address, aggregate id and value columns.
+  RowTypePtr probeType_;
+
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+  int32_t groupOffset_;
+  int32_t idOffset_;
+
+  // Probe input made of the group addresses, the aggregate id, the value
+  // column of the aggregate and null constants for the other value columns.
+  std::vector<VectorPtr> probeChildren_;
+  SelectivityVector probeRows_;
+
+  // Rows of 'table_' ordered on group address and aggregate id. Set on the
+  // first call to 'extractValues'.
+  std::vector<char*> sortedRows_;
+  bool sorted_{false};
+
+  // Per aggregate, the rows of 'table_' and the groups they belong to for the
+  // groups of an output batch.
+  std::vector<std::vector<char*>> batchRows_;
+  std::vector<std::vector<char*>> batchGroups_;
+};
+
+} // namespace facebook::velox::exec
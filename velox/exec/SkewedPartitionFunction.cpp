@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/SkewedPartitionFunction.h"
+
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
+
+namespace facebook::velox::exec {
+namespace {
+std::vector<std::unique_ptr<VectorHasher>> createHashers(
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& keyChannels) {
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  hashers.reserve(keyChannels.size());
+  for (const auto channel : keyChannels) {
+    VELOX_USER_CHECK_NE(
+        channel,
+        kConstantChannel,
+        "Skewed partitioning does not support constant keys");
+    hashers.emplace_back(
+        VectorHasher::create(inputType->childAt(channel), channel));
+  }
+  return hashers;
+}
+
+void hashKeys(
+    const RowVector& input,
+    std::vector<std::unique_ptr<VectorHasher>>& hashers,
+    const SelectivityVector& rows,
+    raw_vector<uint64_t>& hashes) {
+  hashes.resize(rows.end());
+  for (auto i = 0; i < hashers.size(); ++i) {
+    auto& hasher = hashers[i];
+    hasher->decode(*input.childAt(hasher->channel()), rows);
+    hasher->hash(rows, i > 0, hashes);
+  }
+}
+} // namespace
+
+// static
+std::string SkewedPartitionFunction::modeName(Mode mode) {
+  switch (mode) {
+    case Mode::kReplicate:
+      return "REPLICATE";
+    case Mode::kRoundRobin:
+      return "ROUND_ROBIN";
+  }
+  VELOX_UNREACHABLE();
+}
+
+// static
+SkewedPartitionFunction::Mode SkewedPartitionFunction::modeFromName(
+    const std::string& name) {
+  if (name == "REPLICATE") {
+    return Mode::kReplicate;
+  }
+  if (name == "ROUND_ROBIN") {
+    return Mode::kRoundRobin;
+  }
+  VELOX_USER_FAIL("Unknown skewed partition mode: {}", name);
+}
+
+SkewedPartitionFunction::SkewedPartitionFunction(
+    std::unique_ptr<core::PartitionFunction> base,
+    Mode mode,
+    int numPartitions,
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& keyChannels,
+    const std::vector<uint64_t>& heavyKeyHashes)
+    : base_{std::move(base)},
+      mode_{mode},
+      numPartitions_{numPartitions},
+      heavyKeyHashes_(heavyKeyHashes.begin(), heavyKeyHashes.end()),
+      hashers_{createHashers(inputType, keyChannels)} {
+  VELOX_CHECK_NOT_NULL(base_);
+  VELOX_CHECK_GT(numPartitions_, 0);
+}
+
+std::optional<uint32_t> SkewedPartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  const auto singlePartition = base_->partition(input, partitions);
+  if (heavyKeyHashes_.empty()) {
+    return singlePartition;
+  }
+
+  const auto size = input.size();
+  rows_.resize(size);
+  rows_.setAll();
+  hashKeys(input, hashers_, rows_, hashes_);
+
+  partitions.resize(size);
+  if (singlePartition.has_value()) {
+    std::fill(partitions.begin(), partitions.end(), singlePartition.value());
+  }
+  for (auto i = 0; i < size; ++i) {
+    if (!heavyKeyHashes_.contains(hashes_[i])) {
+      continue;
+    }
+    if (mode_ == Mode::kReplicate) {
+      partitions[i] = kAllPartitions;
+    } else {
+      partitions[i] = counter_;
+      if (++counter_ == numPartitions_) {
+        counter_ = 0;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+// static
+std::vector<uint64_t> SkewedPartitionFunction::sampleHeavyKeyHashes(
+    const RowVector& sample,
+    const std::vector<column_index_t>& keyChannels,
+    int32_t maxKeys,
+    double minFraction,
+    int32_t capacity) {
+  VELOX_CHECK_GT(maxKeys, 0);
+  const auto size = sample.size();
+  if (size == 0) {
+    return {};
+  }
+
+  auto hashers = createHashers(asRowType(sample.type()), keyChannels);
+  SelectivityVector rows(size);
+  raw_vector<uint64_t> hashes;
+  hashKeys(sample, hashers, rows, hashes);
+
+  functions::ApproxMostFrequentStreamSummary<uint64_t> summary;
+  summary.setCapacity(std::max(capacity, maxKeys));
+  for (auto i = 0; i < size; ++i) {
+    summary.insert(hashes[i]);
+  }
+
+  const auto minCount = static_cast<int64_t>(std::ceil(minFraction * size));
+  std::vector<uint64_t> heavyKeyHashes;
+  for (const auto& [hash, count] : summary.topK(maxKeys)) {
+    if (count < minCount) {
+      break;
+    }
+    heavyKeyHashes.push_back(hash);
+  }
+  return heavyKeyHashes;
+}
+
+std::unique_ptr<core::PartitionFunction> SkewedPartitionFunctionSpec::create(
+    int numPartitions,
+    bool localExchange) const {
+  VELOX_USER_CHECK(
+      !localExchange ||
+          mode_ != SkewedPartitionFunction::Mode::kReplicate,
+      "Skewed partitioning does not replicate rows in a local exchange");
+  return std::make_unique<SkewedPartitionFunction>(
+      base_->create(numPartitions, localExchange),
+      mode_,
+      numPartitions,
+      inputType_,
+      keyChannels_,
+      heavyKeyHashes_);
+}
+
+std::string SkewedPartitionFunctionSpec::toString() const {
+  std::ostringstream keys;
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    if (i > 0) {
+      keys << ", ";
+    }
+    keys << inputType_->nameOf(keyChannels_[i]);
+  }
+  return fmt::format(
+      "SKEWED({}, {}, {} heavy keys of {})",
+      base_->toString(),
+      SkewedPartitionFunction::modeName(mode_),
+      heavyKeyHashes_.size(),
+      keys.str());
+}
+
+folly::dynamic SkewedPartitionFunctionSpec::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "SkewedPartitionFunctionSpec";
+  obj["base"] = base_->serialize();
+  obj["mode"] = SkewedPartitionFunction::modeName(mode_);
+  obj["inputType"] = inputType_->serialize();
+  obj["keyChannels"] = ISerializable::serialize(keyChannels_);
+  // Hashes are stored as signed values as folly::dynamic has no unsigned
+  // integers.
+  folly::dynamic hashes = folly::dynamic::array;
+  for (const auto hash : heavyKeyHashes_) {
+    hashes.push_back(static_cast<int64_t>(hash));
+  }
+  obj["heavyKeyHashes"] = std::move(hashes);
+  return obj;
+}
+
+// static
+core::PartitionFunctionSpecPtr SkewedPartitionFunctionSpec::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  std::vector<uint64_t> heavyKeyHashes;
+  heavyKeyHashes.reserve(obj["heavyKeyHashes"].size());
+  for (const auto& hash : obj["heavyKeyHashes"]) {
+    heavyKeyHashes.push_back(static_cast<uint64_t>(hash.asInt()));
+  }
+  return std::make_shared<SkewedPartitionFunctionSpec>(
+      ISerializable::deserialize<core::PartitionFunctionSpec>(
+          obj["base"], context),
+      SkewedPartitionFunction::modeFromName(obj["mode"].asString()),
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      ISerializable::deserialize<std::vector<column_index_t>>(
+          obj["keyChannels"], context),
+      std::move(heavyKeyHashes));
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Set.h>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/VectorHasher.h"
+
+namespace facebook::velox::exec {
+
+/// Partitions one side of a join on skewed keys. The rows with keys which are
+/// not heavy hitters go to the partition of 'base', e.g. a hash or Hive
+/// partition function on the join keys. The rows with heavy hitter keys are
+/// spread over all the partitions instead of going to one: the build side
+/// replicates them to all the partitions and the probe side assigns them to
+/// the partitions in round-robin. The heavy hitters are identified by the hash
+/// of their keys. Both sides must use the same key types and heavy hitter
+/// hashes. A key which is not a heavy hitter but has the hash of one is treated
+/// as one on both sides, which is still correct.
+class SkewedPartitionFunction : public core::PartitionFunction {
+ public:
+  enum class Mode {
+    /// Sends the heavy hitter rows to all the partitions. Used for the build
+    /// side of an inner or left join.
+    kReplicate,
+    /// Sends the heavy hitter rows to the partitions in round-robin. Used for
+    /// the probe side.
+    kRoundRobin,
+  };
+
+  static std::string modeName(Mode mode);
+
+  static Mode modeFromName(const std::string& name);
+
+  SkewedPartitionFunction(
+      std::unique_ptr<core::PartitionFunction> base,
+      Mode mode,
+      int numPartitions,
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& keyChannels,
+      const std::vector<uint64_t>& heavyKeyHashes);
+
+  std::optional<uint32_t> partition(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions) override;
+
+  /// Returns the hashes of the keys at 'keyChannels' of 'sample' which are
+  /// estimated to occur in at least 'minFraction' of the rows, up to 'maxKeys'
+  /// of the most frequent ones. The frequencies are estimated with
+  /// ApproxMostFrequentStreamSummary tracking 'capacity' keys.
+  static std::vector<uint64_t> sampleHeavyKeyHashes(
+      const RowVector& sample,
+      const std::vector<column_index_t>& keyChannels,
+      int32_t maxKeys,
+      double minFraction,
+      int32_t capacity = 1'024);
+
+ private:
+  const std::unique_ptr<core::PartitionFunction> base_;
+  const Mode mode_;
+  const int numPartitions_;
+  const folly::F14FastSet<uint64_t> heavyKeyHashes_;
+  std::vector<std::unique_ptr<VectorHasher>> hashers_;
+
+  // The next partition for a heavy hitter row in kRoundRobin mode.
+  uint32_t counter_{0};
+
+  // Reusable memory.
+  SelectivityVector rows_;
+  raw_vector<uint64_t> hashes_;
+};
+
+/// Factory class to create SkewedPartitionFunction.
+class SkewedPartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  SkewedPartitionFunctionSpec(
+      core::PartitionFunctionSpecPtr base,
+      SkewedPartitionFunction::Mode mode,
+      RowTypePtr inputType,
+      std::vector<column_index_t> keyChannels,
+      std::vector<uint64_t> heavyKeyHashes)
+      : base_{std::move(base)},
+        mode_{mode},
+        inputType_{std::move(inputType)},
+        keyChannels_{std::move(keyChannels)},
+        heavyKeyHashes_{std::move(heavyKeyHashes)} {
+    VELOX_CHECK_NOT_NULL(base_);
+    VELOX_CHECK(!keyChannels_.empty());
+  }
+
+  std::unique_ptr<core::PartitionFunction> create(
+      int numPartitions,
+      bool localExchange) const override;
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+ private:
+  const core::PartitionFunctionSpecPtr base_;
+  const SkewedPartitionFunction::Mode mode_;
+  const RowTypePtr inputType_;
+  const std::vector<column_index_t> keyChannels_;
+  const std::vector<uint64_t> heavyKeyHashes_;
+};
+} // namespace facebook::velox::exec
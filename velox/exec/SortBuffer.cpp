@@ -200,6 +200,24 @@ std::optional<uint64_t> SortBuffer::estimateOutputRowSize() const {
   return estimatedOutputRowSize_;
 }
 
+void SortBuffer::extractRows(
+    const char* const* rows,
+    vector_size_t numRows,
+    vector_size_t resultOffset,
+    const RowVectorPtr& result) const {
+  for (const auto& columnProjection : columnMap_) {
+    // The null flags of 'data_' do not cover the rows of the other sort
+    // buffers.
+    RowContainer::extractColumn(
+        rows,
+        numRows,
+        data_->columnAt(columnProjection.inputChannel),
+        /*columnHasNulls=*/true,
+        resultOffset,
+        result->childAt(columnProjection.outputChannel));
+  }
+}
+
 void SortBuffer::ensureInputFits(const VectorPtr& input) {
   // Check if spilling is enabled or not.
   if (spillConfig_ == nullptr) {
@@ -245,16 +263,19 @@ void SortBuffer::ensureInputFits(const VectorPtr& input) {
   }
 
   // Try reserving targetIncrementBytes more in memory pool, if succeed, no
-  // need to spill.
+  // need to spill. The growth follows SpillConfig::reservationGrowthPct().
   const auto targetIncrementBytes = std::max<int64_t>(
       estimatedIncrementalBytes * 2,
-      currentMemoryUsage * spillConfig_->spillableReservationGrowthPct / 100);
+      currentMemoryUsage *
+          spillConfig_->reservationGrowthPct(numReservationGrowths_) / 100);
   {
     memory::ReclaimableSectionGuard guard(nonReclaimableSection_);
     if (pool_->maybeReserve(targetIncrementBytes)) {
+      ++numReservationGrowths_;
       return;
     }
   }
+  numReservationGrowths_ = 0;
   LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
                << " for memory pool " << pool()->name()
                << ", usage: " << succinctBytes(pool()->usedBytes())
@@ -487,8 +508,18 @@ void SortBuffer::prepareOutputWithSpill() {
   }
 
   VELOX_CHECK_EQ(spillPartitionSet_.size(), 1);
-  spillMerger_ = spillPartitionSet_.begin()->second->createOrderedReader(
-      spillConfig_->readBufferSize, pool(), spillStats_);
+  auto& spillPartition = spillPartitionSet_.begin()->second;
+  const auto maxMergeFiles = spillConfig_->maxMergeFiles();
+  if (maxMergeFiles > 0 && spillPartition->numFiles() > maxMergeFiles) {
+    spillPartition->mergeFiles(
+        maxMergeFiles, *spillConfig_, pool(), spillStats_);
+  }
+  spillMerger_ = spillPartition->createOrderedReader(
+      spillConfig_->readBufferSize,
+      pool(),
+      spillStats_,
+      spillConfig_->readAheadExecutor,
+      spillConfig_->mergeReadAheadBudget);
   spillPartitionSet_.clear();
 }
 } // namespace facebook::velox::exec
@@ -69,6 +69,33 @@ class SortBuffer {
 
   std::optional<uint64_t> estimateOutputRowSize() const;
 
+  uint64_t numInputRows() const {
+    return numInputRows_;
+  }
+
+  /// Returns the rows in sort order after noMoreInput(). The sort buffer must
+  /// not have spilled.
+  const std::vector<char*, memory::StlAllocator<char*>>& sortedRows() const {
+    VELOX_CHECK(noMoreInput_);
+    VELOX_CHECK(!hasSpilled());
+    return sortedRows_;
+  }
+
+  /// Compares the sort keys of 'left' and 'right'. The rows may be from
+  /// different sort buffers with the same input type and sort keys as 'this'.
+  int32_t compareRows(const char* left, const char* right) const {
+    return data_->compareRows(left, right, sortCompareFlags_);
+  }
+
+  /// Copies the 'numRows' 'rows' to 'result' starting at 'resultOffset'. The
+  /// rows may be from different sort buffers with the same input type and sort
+  /// keys as 'this'.
+  void extractRows(
+      const char* const* rows,
+      vector_size_t numRows,
+      vector_size_t resultOffset,
+      const RowVectorPtr& result) const;
+
  private:
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
@@ -127,6 +154,9 @@ class SortBuffer {
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
+  // See SpillConfig::reservationGrowthPct().
+  uint32_t numReservationGrowths_{0};
+
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
   std::vector<IdentityProjection> columnMap_;
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SortMergeFallbackJoin.h"
+
+#include <numeric>
+
+namespace facebook::velox::exec {
+namespace {
+// Both sides are sorted ascending with nulls first, which 'compareKeys' must
+// agree with.
+const CompareFlags kCompareFlags{};
+
+bool hasNullKey(
+    const RowVector& rows,
+    const std::vector<column_index_t>& keyChannels,
+    vector_size_t row) {
+  for (auto channel : keyChannels) {
+    if (rows.childAt(channel)->isNullAt(row)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void addRange(
+    std::vector<BaseVector::CopyRange>& ranges,
+    vector_size_t sourceIndex,
+    vector_size_t targetIndex,
+    vector_size_t count) {
+  const BaseVector::CopyRange range{sourceIndex, targetIndex, count};
+  if (!ranges.empty() && ranges.back().mergeable(range)) {
+    ranges.back().count += count;
+    return;
+  }
+  ranges.push_back(range);
+}
+
+void copyRanges(
+    const RowVector& source,
+    const std::vector<IdentityProjection>& projections,
+    std::vector<BaseVector::CopyRange>& ranges,
+    RowVector& target) {
+  if (ranges.empty()) {
+    return;
+  }
+  const folly::Range<const BaseVector::CopyRange*> range(
+      ranges.data(), ranges.size());
+  for (const auto& projection : projections) {
+    target.childAt(projection.outputChannel)
+        ->copyRanges(source.childAt(projection.inputChannel).get(), range);
+  }
+  ranges.clear();
+}
+} // namespace
+
+SortMergeFallbackJoin::SortMergeFallbackJoin(
+    SpillFiles buildFiles,
+    const RowTypePtr& probeType,
+    const std::vector<column_index_t>& probeKeyChannels,
+    const RowTypePtr& outputType,
+    const std::vector<IdentityProjection>& probeProjections,
+    const std::vector<IdentityProjection>& buildProjections,
+    memory::MemoryPool* pool,
+    tsan_atomic<bool>* nonReclaimableSection,
+    const common::PrefixSortConfig& prefixSortConfig,
+    const common::SpillConfig* spillConfig,
+    folly::Synchronized<common::SpillStats>* spillStats)
+    : probeKeyChannels_(probeKeyChannels),
+      outputType_(outputType),
+      probeProjections_(probeProjections),
+      buildProjections_(buildProjections),
+      pool_(pool),
+      spillConfig_(spillConfig),
+      spillStats_(spillStats),
+      buildFiles_(std::move(buildFiles)),
+      buildKeyChannels_(probeKeyChannels_.size()) {
+  VELOX_CHECK(!buildFiles_.empty());
+  VELOX_CHECK_NOT_NULL(spillConfig_);
+  std::iota(buildKeyChannels_.begin(), buildKeyChannels_.end(), 0);
+
+  const std::vector<CompareFlags> compareFlags(
+      probeKeyChannels_.size(), kCompareFlags);
+  probeSorter_ = std::make_unique<SortBuffer>(
+      probeType,
+      probeKeyChannels_,
+      compareFlags,
+      pool_,
+      nonReclaimableSection,
+      prefixSortConfig,
+      spillConfig_,
+      spillStats_);
+  buildSorter_ = std::make_unique<SortBuffer>(
+      buildFiles_[0].type,
+      buildKeyChannels_,
+      compareFlags,
+      pool_,
+      nonReclaimableSection,
+      prefixSortConfig,
+      spillConfig_,
+      spillStats_);
+}
+
+void SortMergeFallbackJoin::addProbeInput(const RowVectorPtr& input) {
+  VELOX_CHECK(!noMoreProbeInput_);
+  probeSorter_->addInput(input);
+}
+
+void SortMergeFallbackJoin::noMoreProbeInput() {
+  VELOX_CHECK(!noMoreProbeInput_);
+  noMoreProbeInput_ = true;
+  probeSorter_->noMoreInput();
+
+  SpillPartition partition(SpillPartitionId(0), std::move(buildFiles_));
+  auto reader = partition.createUnorderedReader(
+      spillConfig_->readBufferSize, pool_, spillStats_);
+  RowVectorPtr input;
+  while (reader->nextBatch(input)) {
+    buildSorter_->addInput(input);
+  }
+  buildSorter_->noMoreInput();
+}
+
+void SortMergeFallbackJoin::spill() {
+  probeSorter_->spill();
+  buildSorter_->spill();
+}
+
+int32_t SortMergeFallbackJoin::compareKeys(
+    const RowVector& left,
+    const std::vector<column_index_t>& leftKeys,
+    vector_size_t leftRow,
+    const RowVector& right,
+    vector_size_t rightRow) const {
+  for (auto i = 0; i < leftKeys.size(); ++i) {
+    const auto result = left.childAt(leftKeys[i])
+                            ->compare(
+                                right.childAt(i).get(),
+                                leftRow,
+                                rightRow,
+                                kCompareFlags);
+    VELOX_DCHECK(result.has_value());
+    if (result.value() != 0) {
+      return result.value();
+    }
+  }
+  return 0;
+}
+
+bool SortMergeFallbackJoin::nextProbeRow() {
+  for (;;) {
+    if (probe_ != nullptr && probeRow_ < probe_->size()) {
+      if (!hasNullKey(*probe_, probeKeyChannels_, probeRow_)) {
+        return true;
+      }
+      ++probeRow_;
+      continue;
+    }
+    flushProbeRanges();
+    probe_ = probeSorter_->getOutput(maxOutput_);
+    probeRow_ = 0;
+    if (probe_ == nullptr) {
+      return false;
+    }
+  }
+}
+
+bool SortMergeFallbackJoin::nextBuildRow() {
+  for (;;) {
+    if (build_ != nullptr && buildRow_ < build_->size()) {
+      if (!hasNullKey(*build_, buildKeyChannels_, buildRow_)) {
+        return true;
+      }
+      ++buildRow_;
+      continue;
+    }
+    build_ = buildSorter_->getOutput(maxOutput_);
+    buildRow_ = 0;
+    if (build_ == nullptr) {
+      return false;
+    }
+  }
+}
+
+void SortMergeFallbackJoin::loadGroup() {
+  VELOX_CHECK_NULL(group_);
+  group_ = std::static_pointer_cast<RowVector>(
+      BaseVector::create(build_->type(), 1, pool_));
+  group_->copy(build_.get(), 0, buildRow_, 1);
+  groupRow_ = 0;
+  ++buildRow_;
+
+  for (;;) {
+    if (buildRow_ == build_->size()) {
+      build_ = buildSorter_->getOutput(maxOutput_);
+      buildRow_ = 0;
+      if (build_ == nullptr) {
+        return;
+      }
+    }
+    auto end = buildRow_;
+    while (end < build_->size() &&
+           compareKeys(*build_, buildKeyChannels_, end, *group_, 0) == 0) {
+      ++end;
+    }
+    if (end > buildRow_) {
+      const auto size = group_->size();
+      group_->resize(size + end - buildRow_);
+      group_->copy(build_.get(), size, buildRow_, end - buildRow_);
+    }
+    const bool groupEnded = end < build_->size();
+    buildRow_ = end;
+    if (groupEnded) {
+      return;
+    }
+  }
+}
+
+void SortMergeFallbackJoin::addMatches() {
+  const auto count = std::min<vector_size_t>(
+      group_->size() - groupRow_, maxOutput_ - numOutput_);
+  addRange(groupRanges_, groupRow_, numOutput_, count);
+  for (auto i = 0; i < count; ++i) {
+    addRange(probeRanges_, probeRow_, numOutput_ + i, 1);
+  }
+  numOutput_ += count;
+  groupRow_ += count;
+  if (groupRow_ == group_->size()) {
+    groupRow_ = 0;
+    ++probeRow_;
+  }
+}
+
+void SortMergeFallbackJoin::flushProbeRanges() {
+  if (probe_ != nullptr) {
+    copyRanges(*probe_, probeProjections_, probeRanges_, *output_);
+  }
+}
+
+void SortMergeFallbackJoin::flushGroupRanges() {
+  if (group_ != nullptr) {
+    copyRanges(*group_, buildProjections_, groupRanges_, *output_);
+  }
+}
+
+RowVectorPtr SortMergeFallbackJoin::getOutput(vector_size_t maxRows) {
+  VELOX_CHECK(noMoreProbeInput_);
+  VELOX_CHECK_GT(maxRows, 0);
+  if (finished_) {
+    return nullptr;
+  }
+
+  maxOutput_ = maxRows;
+  output_ = std::static_pointer_cast<RowVector>(
+      BaseVector::create(outputType_, maxOutput_, pool_));
+  numOutput_ = 0;
+  while (numOutput_ < maxOutput_) {
+    if (!nextProbeRow()) {
+      finished_ = true;
+      break;
+    }
+    if (group_ != nullptr) {
+      const auto result =
+          compareKeys(*probe_, probeKeyChannels_, probeRow_, *group_, 0);
+      if (result == 0) {
+        addMatches();
+        continue;
+      }
+      if (result < 0) {
+        ++probeRow_;
+        continue;
+      }
+      flushGroupRanges();
+      group_.reset();
+    }
+    if (!nextBuildRow()) {
+      finished_ = true;
+      break;
+    }
+    const auto result = compareKeys(
+        *probe_, probeKeyChannels_, probeRow_, *build_, buildRow_);
+    if (result < 0) {
+      ++probeRow_;
+    } else if (result > 0) {
+      ++buildRow_;
+    } else {
+      loadGroup();
+    }
+  }
+
+  flushProbeRanges();
+  flushGroupRanges();
+  if (finished_) {
+    probe_.reset();
+    build_.reset();
+    group_.reset();
+  }
+  if (numOutput_ == 0) {
+    output_.reset();
+    return nullptr;
+  }
+  output_->resize(numOutput_);
+  return std::move(output_);
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/SortBuffer.h"
+#include "velox/exec/Spill.h"
+
+namespace facebook::velox::exec {
+
+/// Inner joins the build and probe side rows of a restored hash join spill
+/// partition by sorting both sides on the join keys and merging them. HashProbe
+/// uses this instead of a hash table for a partition which exceeds the max
+/// spill level so that a skewed partition which does not fit in memory makes
+/// progress instead of failing the query. Both sides are sorted by SortBuffer
+/// which spills if needed. The build side rows with the same join key are kept
+/// in memory while they are joined. Rows with null join keys never match and
+/// are skipped.
+class SortMergeFallbackJoin {
+ public:
+  /// 'buildFiles' are the spill files of the build side of the partition. Their
+  /// columns are the join keys followed by the dependent columns.
+  /// 'probeKeyChannels' are the join key columns of 'probeType'.
+  /// 'probeProjections' and 'buildProjections' map the probe side and the
+  /// build side columns to 'outputType'.
+  SortMergeFallbackJoin(
+      SpillFiles buildFiles,
+      const RowTypePtr& probeType,
+      const std::vector<column_index_t>& probeKeyChannels,
+      const RowTypePtr& outputType,
+      const std::vector<IdentityProjection>& probeProjections,
+      const std::vector<IdentityProjection>& buildProjections,
+      memory::MemoryPool* pool,
+      tsan_atomic<bool>* nonReclaimableSection,
+      const common::PrefixSortConfig& prefixSortConfig,
+      const common::SpillConfig* spillConfig,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
+  /// Adds a batch of probe side rows of the partition.
+  void addProbeInput(const RowVectorPtr& input);
+
+  /// Invoked after all the probe side rows have been added. Sorts the probe
+  /// side rows and reads and sorts the build side rows.
+  void noMoreProbeInput();
+
+  /// Returns up to 'maxRows' joined rows, or null when the join has finished.
+  RowVectorPtr getOutput(vector_size_t maxRows);
+
+  /// Spills the probe and build side rows held by the sort buffers. Invoked
+  /// by HashProbe::reclaim() outside of a non-reclaimable section.
+  void spill();
+
+ private:
+  // Compares the join keys of 'row' in 'left' at 'leftKeys' with the join keys
+  // of 'rightRow' in 'right' which has the build side layout.
+  int32_t compareKeys(
+      const RowVector& left,
+      const std::vector<column_index_t>& leftKeys,
+      vector_size_t leftRow,
+      const RowVector& right,
+      vector_size_t rightRow) const;
+
+  // Positions 'probeRow_' on the next probe row with no null join key. Returns
+  // false if there are no more probe rows.
+  bool nextProbeRow();
+
+  // Positions 'buildRow_' on the next build row with no null join key. Returns
+  // false if there are no more build rows.
+  bool nextBuildRow();
+
+  // Copies the build rows from 'buildRow_' with the same join key into
+  // 'group_'.
+  void loadGroup();
+
+  // Adds the output rows joining 'probeRow_' with the rows of 'group_' from
+  // 'groupRow_' up to the output batch size.
+  void addMatches();
+
+  // Copies the output ranges collected for the current 'probe_' batch.
+  void flushProbeRanges();
+
+  // Copies the output ranges collected for the current 'group_'.
+  void flushGroupRanges();
+
+  const std::vector<column_index_t> probeKeyChannels_;
+  const RowTypePtr outputType_;
+  const std::vector<IdentityProjection> probeProjections_;
+  const std::vector<IdentityProjection> buildProjections_;
+  memory::MemoryPool* const pool_;
+  const common::SpillConfig* const spillConfig_;
+  folly::Synchronized<common::SpillStats>* const spillStats_;
+
+  // Build side spill files to read on noMoreProbeInput().
+  SpillFiles buildFiles_;
+  // The join key columns of the build side rows.
+  std::vector<column_index_t> buildKeyChannels_;
+
+  std::unique_ptr<SortBuffer> probeSorter_;
+  std::unique_ptr<SortBuffer> buildSorter_;
+
+  bool noMoreProbeInput_{false};
+  bool finished_{false};
+
+  // The current batches of sorted probe and build side rows and the positions
+  // in them.
+  RowVectorPtr probe_;
+  vector_size_t probeRow_{0};
+  RowVectorPtr build_;
+  vector_size_t buildRow_{0};
+
+  // The build side rows with the join key of the current match and the next
+  // row to join with 'probeRow_'.
+  RowVectorPtr group_;
+  vector_size_t groupRow_{0};
+
+  // The output being produced by getOutput().
+  RowVectorPtr output_;
+  vector_size_t numOutput_{0};
+  vector_size_t maxOutput_{0};
+
+  // The copies to 'output_' from 'probe_' and 'group_' which are made all at
+  // once before either changes.
+  std::vector<BaseVector::CopyRange> probeRanges_;
+  std::vector<BaseVector::CopyRange> groupRanges_;
+};
+} // namespace facebook::velox::exec
@@ -71,7 +71,11 @@ SpillState::SpillState(
     const std::optional<common::PrefixSortConfig>& prefixSortConfig,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    folly::Executor* asyncWriteExecutor,
+    VectorSerde::Kind serdeKind,
+    std::optional<common::SpillOverflowConfig> overflowConfig,
+    int32_t compressionDictionaryPages)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -81,6 +85,10 @@ SpillState::SpillState(
       compressionKind_(compressionKind),
       prefixSortConfig_(prefixSortConfig),
       fileCreateConfig_(fileCreateConfig),
+      asyncWriteExecutor_(asyncWriteExecutor),
+      serdeKind_(serdeKind),
+      overflowConfig_(std::move(overflowConfig)),
+      compressionDictionaryPages_(compressionDictionaryPages),
       pool_(pool),
       stats_(stats) {}
 
@@ -162,7 +170,12 @@ uint64_t SpillState::appendToPartition(
               fileCreateConfig_,
               updateAndCheckSpillLimitCb_,
               pool_,
-              stats_));
+              stats_,
+              asyncWriteExecutor_,
+              serdeKind_,
+              overflowConfig_.has_value() ? &overflowConfig_.value()
+                                          : nullptr,
+              compressionDictionaryPages_));
     }
   });
 
@@ -291,16 +304,188 @@ SpillPartition::createUnorderedReader(
       std::move(streams));
 }
 
+void SpillPartition::mergeFiles(
+    int32_t maxMergeFiles,
+    const common::SpillConfig& config,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  VELOX_CHECK_GE(maxMergeFiles, 2);
+  while (files_.size() > maxMergeFiles) {
+    // The first pass merges just enough files for the following passes to
+    // merge 'maxMergeFiles' files each. Merging the smallest files first
+    // rewrites the fewest bytes.
+    const auto numMergeFiles =
+        std::min<size_t>(maxMergeFiles, files_.size() - maxMergeFiles + 1);
+    std::sort(
+        files_.begin(),
+        files_.end(),
+        [](const SpillFileInfo& left, const SpillFileInfo& right) {
+          return left.size < right.size;
+        });
+    SpillFiles mergeFiles(
+        std::make_move_iterator(files_.begin()),
+        std::make_move_iterator(files_.begin() + numMergeFiles));
+    files_.erase(files_.begin(), files_.begin() + numMergeFiles);
+
+    uint32_t maxFileId{0};
+    for (const auto& file : files_) {
+      maxFileId = std::max(maxFileId, file.id);
+    }
+    for (const auto& file : mergeFiles) {
+      maxFileId = std::max(maxFileId, file.id);
+    }
+    auto mergedFile =
+        mergeSortedFiles(std::move(mergeFiles), config, pool, spillStats);
+    mergedFile.id = maxFileId + 1;
+    files_.push_back(std::move(mergedFile));
+  }
+
+  size_ = 0;
+  for (const auto& file : files_) {
+    size_ += file.size;
+  }
+}
+
+SpillFileInfo SpillPartition::mergeSortedFiles(
+    SpillFiles files,
+    const common::SpillConfig& config,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  // Makes the file names of the merged files unique in the process.
+  static std::atomic_uint64_t numMerges{0};
+
+  VELOX_CHECK_GT(files.size(), 1);
+  const auto type = files[0].type;
+  const auto sortingKeys = files[0].sortingKeys;
+  const auto compressionKind = files[0].compressionKind;
+  const auto serdeKind = files[0].serdeKind;
+  std::vector<std::string> paths;
+  paths.reserve(files.size());
+  for (const auto& file : files) {
+    paths.push_back(file.path);
+  }
+
+  auto merger = SpillPartition(id_, std::move(files))
+                    .createOrderedReader(config.readBufferSize, pool, spillStats);
+  VELOX_CHECK_NOT_NULL(merger);
+
+  auto updateAndCheckSpillLimitCb = config.updateAndCheckSpillLimitCb;
+  // The merged file must be a single sorted run, hence no target file size
+  // and no overflow tier that would close the file early.
+  SpillWriter writer(
+      type,
+      sortingKeys,
+      compressionKind,
+      fmt::format(
+          "{}/{}-merge-{}-{}",
+          config.getSpillDirPathCb(),
+          config.fileNamePrefix,
+          id_.encodedId(),
+          numMerges++),
+      std::numeric_limits<uint64_t>::max(),
+      config.writeBufferSize,
+      config.fileCreateConfig,
+      updateAndCheckSpillLimitCb,
+      pool,
+      spillStats,
+      /*asyncWriteExecutor=*/nullptr,
+      serdeKind,
+      /*overflowConfig=*/nullptr,
+      config.compressionDictionaryPages);
+
+  // Copies the merged rows in batches of consecutive rows of the same input
+  // batch. A batch is copied before its stream moves to its next batch.
+  constexpr vector_size_t kBatchRows = 1'024;
+  auto output =
+      std::static_pointer_cast<RowVector>(BaseVector::create(type, 0, pool));
+  std::vector<BaseVector::CopyRange> ranges;
+  const RowVector* rangeSource{nullptr};
+  vector_size_t numOutputRows{0};
+  const auto flushRanges = [&]() {
+    if (ranges.empty()) {
+      return;
+    }
+    for (auto i = 0; i < output->childrenSize(); ++i) {
+      output->childAt(i)->copyRanges(rangeSource->childAt(i).get(), ranges);
+    }
+    ranges.clear();
+    rangeSource = nullptr;
+  };
+  const auto writeOutput = [&]() {
+    flushRanges();
+    if (numOutputRows == 0) {
+      return;
+    }
+    IndexRange range{0, numOutputRows};
+    writer.write(output, folly::Range<IndexRange*>(&range, 1));
+    numOutputRows = 0;
+  };
+  while (auto* stream = merger->next()) {
+    if (numOutputRows == 0) {
+      VectorPtr reusable = std::move(output);
+      BaseVector::prepareForReuse(reusable, kBatchRows);
+      output = std::static_pointer_cast<RowVector>(reusable);
+      for (auto& child : output->children()) {
+        child->resize(kBatchRows);
+      }
+    }
+    bool isLastRow{false};
+    const auto* source = &stream->current();
+    const auto sourceIndex = stream->currentIndex(&isLastRow);
+    if (source != rangeSource) {
+      flushRanges();
+      rangeSource = source;
+    }
+    if (!ranges.empty() &&
+        ranges.back().sourceIndex + ranges.back().count == sourceIndex) {
+      ++ranges.back().count;
+    } else {
+      ranges.push_back({sourceIndex, numOutputRows, 1});
+    }
+    ++numOutputRows;
+    if (isLastRow) {
+      flushRanges();
+    }
+    if (numOutputRows == kBatchRows) {
+      writeOutput();
+    }
+    stream->pop();
+  }
+  writeOutput();
+  merger.reset();
+
+  auto mergedFiles = writer.finish();
+  VELOX_CHECK_EQ(mergedFiles.size(), 1);
+  for (const auto& path : paths) {
+    try {
+      filesystems::getFileSystem(path, nullptr)->remove(path);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to delete merged spill file " << path << ": "
+                 << e.what();
+    }
+  }
+  return std::move(mergedFiles[0]);
+}
+
 std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* readAheadExecutor,
+    uint64_t readAheadBudget) {
+  std::shared_ptr<SpillReadAheadScheduler> readAhead;
+  if (readAheadExecutor != nullptr && readAheadBudget > 0 &&
+      files_.size() > 1) {
+    readAhead = std::make_shared<SpillReadAheadScheduler>(
+        readAheadExecutor, readAheadBudget);
+  }
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
     streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats),
+        readAhead));
   }
   files_.clear();
   // Check if the partition is empty or not.
@@ -371,6 +556,12 @@ uint32_t FileSpillMergeStream::id() const {
   return spillFile_->id();
 }
 
+FileSpillMergeStream::~FileSpillMergeStream() {
+  if (readAhead_ != nullptr && spillFile_ != nullptr) {
+    readAhead_->remove(spillFile_.get());
+  }
+}
+
 void FileSpillMergeStream::nextBatch() {
   VELOX_CHECK(!closed_);
   index_ = 0;
@@ -380,11 +571,17 @@ void FileSpillMergeStream::nextBatch() {
     return;
   }
   size_ = rowVector_->size();
+  if (readAhead_ != nullptr) {
+    readAhead_->schedule();
+  }
 }
 
 void FileSpillMergeStream::close() {
   VELOX_CHECK(!closed_);
   SpillMergeStream::close();
+  if (readAhead_ != nullptr) {
+    readAhead_->remove(spillFile_.get());
+  }
   spillFile_.reset();
 }
 
@@ -139,20 +139,30 @@ class SpillMergeStream : public MergeStream {
 /// A source of spilled RowVectors coming from a file.
 class FileSpillMergeStream : public SpillMergeStream {
  public:
+  /// If 'readAhead' is set, the next buffers of 'spillFile' are prefetched
+  /// with the other files scheduled by 'readAhead'.
   static std::unique_ptr<SpillMergeStream> create(
-      std::unique_ptr<SpillReadFile> spillFile) {
+      std::unique_ptr<SpillReadFile> spillFile,
+      std::shared_ptr<SpillReadAheadScheduler> readAhead = nullptr) {
     auto spillStream = std::unique_ptr<SpillMergeStream>(
-        new FileSpillMergeStream(std::move(spillFile)));
+        new FileSpillMergeStream(std::move(spillFile), std::move(readAhead)));
     static_cast<FileSpillMergeStream*>(spillStream.get())->nextBatch();
     return spillStream;
   }
 
+  ~FileSpillMergeStream() override;
+
   uint32_t id() const override;
 
  private:
-  explicit FileSpillMergeStream(std::unique_ptr<SpillReadFile> spillFile)
-      : spillFile_(std::move(spillFile)) {
+  FileSpillMergeStream(
+      std::unique_ptr<SpillReadFile> spillFile,
+      std::shared_ptr<SpillReadAheadScheduler> readAhead)
+      : spillFile_(std::move(spillFile)), readAhead_(std::move(readAhead)) {
     VELOX_CHECK_NOT_NULL(spillFile_);
+    if (readAhead_ != nullptr) {
+      readAhead_->add(spillFile_.get());
+    }
   }
 
   const std::vector<SpillSortKey>& sortingKeys() const override {
@@ -165,6 +175,8 @@ class FileSpillMergeStream : public SpillMergeStream {
   void close() override;
 
   std::unique_ptr<SpillReadFile> spillFile_;
+  // Shared by the streams of the same ordered reader.
+  const std::shared_ptr<SpillReadAheadScheduler> readAhead_;
 };
 
 /// A source of spilled RowVectors coming from a file. The spill data might not
@@ -463,16 +475,39 @@ class SpillPartition {
   /// The created reader will take the ownership of the spill files.
   /// 'bufferSize' specifies the read size from the storage. If the file
   /// system supports async read mode, then reader allocates two buffers with
-  /// one buffer prefetch ahead. 'spillStats' is provided to collect the spill
-  /// stats when reading data from spilled files.
+  /// one buffer prefetch ahead. Otherwise, if 'readAheadExecutor' is set, the
+  /// reader prefetches the next buffers of the files closest to exhausting
+  /// their buffers on it, using up to 'readAheadBudget' bytes from 'pool'.
+  /// 'spillStats' is provided to collect the spill stats when reading data
+  /// from spilled files.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* readAheadExecutor = nullptr,
+      uint64_t readAheadBudget = 0);
+
+  /// Merges the sorted files of this partition until it has at most
+  /// 'maxMergeFiles' files, so that an ordered reader needs at most
+  /// 'maxMergeFiles' read buffers. Each pass merges the smallest files into a
+  /// new sorted file written with 'config', as many as needed for the next
+  /// passes to merge 'maxMergeFiles' files each, and deletes the merged files.
+  void mergeFiles(
+      int32_t maxMergeFiles,
+      const common::SpillConfig& config,
+      memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* spillStats);
 
   std::string toString() const;
 
  private:
+  // Merges the sorted 'files' into a single sorted file.
+  SpillFileInfo mergeSortedFiles(
+      SpillFiles files,
+      const common::SpillConfig& config,
+      memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
   SpillPartitionId id_;
   SpillFiles files_;
   // Counts the total file size in bytes from this spilled partition.
@@ -541,7 +576,12 @@ class SpillState {
       const std::optional<common::PrefixSortConfig>& prefixSortConfig,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      folly::Executor* asyncWriteExecutor = nullptr,
+      VectorSerde::Kind serdeKind = VectorSerde::Kind::kPresto,
+      std::optional<common::SpillOverflowConfig> overflowConfig =
+          std::nullopt,
+      int32_t compressionDictionaryPages = 0);
 
   static std::vector<SpillSortKey> makeSortingKeys(
       const std::vector<CompareFlags>& compareFlags = {});
@@ -566,6 +606,10 @@ class SpillState {
     return compressionKind_;
   }
 
+  VectorSerde::Kind serdeKind() const {
+    return serdeKind_;
+  }
+
   const std::optional<common::PrefixSortConfig>& prefixSortConfig() const {
     return prefixSortConfig_;
   }
@@ -644,6 +688,10 @@ class SpillState {
   const common::CompressionKind compressionKind_;
   const std::optional<common::PrefixSortConfig> prefixSortConfig_;
   const std::string fileCreateConfig_;
+  folly::Executor* const asyncWriteExecutor_;
+  const VectorSerde::Kind serdeKind_;
+  const std::optional<common::SpillOverflowConfig> overflowConfig_;
+  const int32_t compressionDictionaryPages_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
@@ -27,6 +27,40 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+using ZstdDictionaryState =
+    serializer::presto::PrestoVectorSerde::ZstdDictionaryState;
+
+std::shared_ptr<ZstdDictionaryState> makeZstdDictionaryState(
+    common::CompressionKind compressionKind,
+    VectorSerde::Kind serdeKind,
+    int32_t numTrainingPages) {
+  if (numTrainingPages <= 0 ||
+      compressionKind != common::CompressionKind::CompressionKind_ZSTD ||
+      serdeKind != VectorSerde::Kind::kPresto) {
+    return nullptr;
+  }
+  auto state = std::make_shared<ZstdDictionaryState>();
+  state->numTrainingPages = numTrainingPages;
+  // The dictionary is kept with the spill file info instead of in the file.
+  state->shipDictionary = false;
+  return state;
+}
+
+serializer::presto::PrestoVectorSerde::PrestoOptions makeReadOptions(
+    common::CompressionKind compressionKind,
+    std::shared_ptr<common::ZstdDictionary> compressionDictionary) {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options{
+      kDefaultUseLosslessTimestamp,
+      compressionKind,
+      0.8,
+      /*nullsFirst=*/true};
+  if (compressionDictionary != nullptr) {
+    options.zstdDictionary = std::make_shared<ZstdDictionaryState>();
+    options.zstdDictionary->dictionary = std::move(compressionDictionary);
+  }
+  return options;
+}
 } // namespace
 
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
@@ -79,14 +113,24 @@ SpillWriterBase::SpillWriterBase(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* asyncWriteExecutor,
+    const common::SpillOverflowConfig* overflowConfig)
     : pool_(pool),
       stats_(stats),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileCreateConfig_(fileCreateConfig),
       pathPrefix_(pathPrefix),
       writeBufferSize_(writeBufferSize),
-      targetFileSize_(targetFileSize) {}
+      targetFileSize_(targetFileSize),
+      asyncWriteExecutor_(asyncWriteExecutor),
+      overflowConfig_(overflowConfig) {}
+
+SpillWriterBase::~SpillWriterBase() {
+  if (pendingWrite_ != nullptr) {
+    pendingWrite_->close();
+  }
+}
 
 SpillFiles SpillWriterBase::finish() {
   checkNotFinished();
@@ -109,34 +153,98 @@ uint64_t SpillWriterBase::flush() {
     return 0;
   }
 
+  uint64_t flushTimeNs{0};
+  auto iobuf = flushBuffer(flushTimeNs);
+  const uint64_t writtenBytes = iobuf->computeChainDataLength();
+  // Serializing this buffer overlaps with the write of the previous one.
+  waitForPendingWrite();
+
   auto* file = ensureFile();
   VELOX_CHECK_NOT_NULL(file);
-  uint64_t writtenBytes{0};
-  uint64_t flushTimeNs{0};
-  uint64_t writeTimeNs{0};
-  flushBuffer(file, writtenBytes, flushTimeNs, writeTimeNs);
-  updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
+  if (asyncWriteExecutor_ == nullptr) {
+    uint64_t writeTimeNs{0};
+    {
+      NanosecondTimer timer(&writeTimeNs);
+      file->write(std::move(iobuf));
+    }
+    updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
+  } else {
+    pendingWrite_ = std::make_shared<AsyncSource<uint64_t>>(
+        [file, iobuf = std::shared_ptr<folly::IOBuf>(std::move(iobuf))]() {
+          uint64_t writeTimeNs{0};
+          {
+            NanosecondTimer timer(&writeTimeNs);
+            file->write(iobuf->clone());
+          }
+          return std::make_unique<uint64_t>(writeTimeNs);
+        });
+    pendingWriteBytes_ = writtenBytes;
+    pendingFlushTimeNs_ = flushTimeNs;
+    asyncWriteExecutor_->add([write = pendingWrite_]() { write->prepare(); });
+  }
+  if (overflowConfig_ != nullptr && !currentFileOverflow_) {
+    localTierFull_ = !overflowConfig_->updateLocalSpillBytesCb(writtenBytes);
+  }
   updateAndCheckSpillLimitCb_(writtenBytes);
   return writtenBytes;
 }
 
+void SpillWriterBase::waitForPendingWrite() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  auto write = std::move(pendingWrite_);
+  uint64_t waitTimeNs{0};
+  std::unique_ptr<uint64_t> writeTimeNs;
+  {
+    NanosecondTimer timer(&waitTimeNs);
+    writeTimeNs = write->move();
+  }
+  VELOX_CHECK_NOT_NULL(writeTimeNs);
+  updateWriteStats(pendingWriteBytes_, pendingFlushTimeNs_, *writeTimeNs);
+  stats_->wlock()->spillWriteWaitTimeNanos += waitTimeNs;
+}
+
 SpillWriteFile* SpillWriterBase::ensureFile() {
-  if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
+  // A local file is closed once the local tier is full so that the rest of the
+  // data goes to the overflow tier.
+  if ((currentFile_ != nullptr) &&
+      ((currentFile_->size() > targetFileSize_) ||
+       (!currentFileOverflow_ && localTierFull_))) {
     closeFile();
   }
   if (currentFile_ == nullptr) {
+    currentFileOverflow_ = (overflowConfig_ != nullptr) &&
+        !overflowConfig_->updateLocalSpillBytesCb(0);
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
-        fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
+        fmt::format(
+            "{}-{}",
+            currentFileOverflow_ ? overflowPathPrefix() : pathPrefix_,
+            finishedFiles_.size()),
         fileCreateConfig_);
   }
   return currentFile_.get();
 }
 
+const std::string& SpillWriterBase::overflowPathPrefix() {
+  if (overflowPathPrefix_.empty()) {
+    const auto spillDir = overflowConfig_->getSpillDirPathCb();
+    VELOX_CHECK(!spillDir.empty(), "Overflow spill directory does not exist");
+    const auto pos = pathPrefix_.rfind('/');
+    overflowPathPrefix_ = fmt::format(
+        "{}/{}",
+        spillDir,
+        pos == std::string::npos ? pathPrefix_ : pathPrefix_.substr(pos + 1));
+  }
+  return overflowPathPrefix_;
+}
+
 void SpillWriterBase::closeFile() {
   if (currentFile_ == nullptr) {
     return;
   }
+  waitForPendingWrite();
   currentFile_->finish();
   updateSpilledFileStats(currentFile_->size());
   addFinishedFile(currentFile_.get());
@@ -199,7 +307,11 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* asyncWriteExecutor,
+    VectorSerde::Kind serdeKind,
+    const common::SpillOverflowConfig* overflowConfig,
+    int32_t compressionDictionaryPages)
     : SpillWriterBase(
           writeBufferSize,
           targetFileSize,
@@ -207,17 +319,20 @@ SpillWriter::SpillWriter(
           fileCreateConfig,
           updateAndCheckSpillLimitCb,
           pool,
-          stats),
+          stats,
+          asyncWriteExecutor,
+          overflowConfig),
       type_(type),
       sortingKeys_(sortingKeys),
       compressionKind_(compressionKind),
-      serde_(getNamedVectorSerde(VectorSerde::Kind::kPresto)) {}
+      serdeKind_(serdeKind),
+      serde_(getNamedVectorSerde(serdeKind_)),
+      zstdDictionary_(makeZstdDictionaryState(
+          compressionKind_,
+          serdeKind_,
+          compressionDictionaryPages)) {}
 
-void SpillWriter::flushBuffer(
-    SpillWriteFile* file,
-    uint64_t& writtenBytes,
-    uint64_t& flushTimeNs,
-    uint64_t& writeTimeNs) {
+std::unique_ptr<folly::IOBuf> SpillWriter::flushBuffer(uint64_t& flushTimeNs) {
   IOBufOutputStream out(
       *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
   {
@@ -225,12 +340,7 @@ void SpillWriter::flushBuffer(
     batch_->flush(&out);
   }
   batch_.reset();
-
-  auto iobuf = out.getIOBuf();
-  {
-    NanosecondTimer timer(&writeTimeNs);
-    writtenBytes = file->write(std::move(iobuf));
-  }
+  return out.getIOBuf();
 }
 
 uint64_t SpillWriter::write(
@@ -238,11 +348,13 @@ uint64_t SpillWriter::write(
     const folly::Range<IndexRange*>& indices) {
   return writeWithBufferControl([&]() {
     if (batch_ == nullptr) {
+      // The row wise serdes only use the compression options.
       serializer::presto::PrestoVectorSerde::PrestoOptions options = {
           kDefaultUseLosslessTimestamp,
           compressionKind_,
           0.8,
           /*nullsFirst=*/true};
+      options.zstdDictionary = zstdDictionary_;
       batch_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
       batch_->createStreamTree(
           std::static_pointer_cast<const RowType>(rows->type()),
@@ -261,7 +373,11 @@ void SpillWriter::addFinishedFile(SpillWriteFile* file) {
       .path = file->path(),
       .size = file->size(),
       .sortingKeys = sortingKeys_,
-      .compressionKind = compressionKind_});
+      .compressionKind = compressionKind_,
+      .serdeKind = serdeKind_,
+      .compressionDictionary = zstdDictionary_ == nullptr
+          ? nullptr
+          : zstdDictionary_->dictionary});
 }
 
 std::vector<std::string> SpillWriter::testingSpilledFilePaths() const {
@@ -303,6 +419,8 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.type,
       fileInfo.sortingKeys,
       fileInfo.compressionKind,
+      fileInfo.serdeKind,
+      fileInfo.compressionDictionary,
       pool,
       stats));
 }
@@ -315,6 +433,8 @@ SpillReadFile::SpillReadFile(
     const RowTypePtr& type,
     const std::vector<SpillSortKey>& sortingKeys,
     common::CompressionKind compressionKind,
+    VectorSerde::Kind serdeKind,
+    std::shared_ptr<common::ZstdDictionary> compressionDictionary,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats)
     : id_(id),
@@ -323,13 +443,11 @@ SpillReadFile::SpillReadFile(
       type_(type),
       sortingKeys_(sortingKeys),
       compressionKind_(compressionKind),
-      readOptions_{
-          kDefaultUseLosslessTimestamp,
-          compressionKind_,
-          0.8,
-          /*nullsFirst=*/true},
+      serdeKind_(serdeKind),
+      readOptions_(
+          makeReadOptions(compressionKind_, std::move(compressionDictionary))),
       pool_(pool),
-      serde_(getNamedVectorSerde(VectorSerde::Kind::kPresto)),
+      serde_(getNamedVectorSerde(serdeKind_)),
       stats_(stats) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
@@ -338,7 +456,7 @@ SpillReadFile::SpillReadFile(
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
-  if (input_->atEnd()) {
+  if (input_->atEnd() && rowIterator_ == nullptr) {
     recordSpillStats();
     return false;
   }
@@ -346,14 +464,76 @@ bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
   uint64_t timeNs{0};
   {
     NanosecondTimer timer{&timeNs};
-    VectorStreamGroup::read(
-        input_.get(), pool_, type_, serde_, &rowVector, &readOptions_);
+    // The columnar serdes read one batch per flush of the writer.
+    if (serdeKind_ == VectorSerde::Kind::kPresto ||
+        serdeKind_ == VectorSerde::Kind::kArrowIpc) {
+      VectorStreamGroup::read(
+          input_.get(), pool_, type_, serde_, &rowVector, &readOptions_);
+    } else {
+      // A row wise serde reads all the row groups left in the stream at
+      // once, so read a bounded number of rows at a time instead.
+      serde_->deserialize(
+          input_.get(),
+          rowIterator_,
+          kMaxRowsPerBatch,
+          type_,
+          &rowVector,
+          pool_,
+          &readOptions_);
+    }
   }
   stats_->wlock()->spillDeserializationTimeNanos += timeNs;
   common::updateGlobalSpillDeserializationTimeNs(timeNs);
   return true;
 }
 
+SpillReadAheadScheduler::SpillReadAheadScheduler(
+    folly::Executor* executor,
+    uint64_t budget)
+    : executor_(executor), budget_(budget) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(budget_, 0);
+}
+
+void SpillReadAheadScheduler::add(SpillReadFile* file) {
+  VELOX_CHECK_NOT_NULL(file);
+  files_.push_back(file);
+}
+
+void SpillReadAheadScheduler::remove(SpillReadFile* file) {
+  auto it = std::find(files_.begin(), files_.end(), file);
+  VELOX_CHECK(it != files_.end());
+  *it = files_.back();
+  files_.pop_back();
+}
+
+void SpillReadAheadScheduler::schedule() {
+  uint64_t usedBytes{0};
+  candidates_.clear();
+  for (auto* file : files_) {
+    usedBytes += file->prefetchedBytes();
+    if (file->prefetchSize() > 0) {
+      candidates_.push_back(file);
+    }
+  }
+  if (candidates_.empty() || usedBytes >= budget_) {
+    return;
+  }
+  std::sort(
+      candidates_.begin(),
+      candidates_.end(),
+      [](const SpillReadFile* left, const SpillReadFile* right) {
+        return left->bufferedBytes() < right->bufferedBytes();
+      });
+  for (auto* file : candidates_) {
+    if (usedBytes + file->prefetchSize() > budget_) {
+      break;
+    }
+    file->prefetch(executor_);
+    usedBytes += file->prefetchedBytes();
+  }
+}
+
 void SpillReadFile::recordSpillStats() {
   VELOX_CHECK(input_->atEnd());
   const auto readStats = input_->stats();
@@ -18,6 +18,7 @@
 
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -90,6 +91,11 @@ struct SpillFileInfo {
   uint64_t size;
   std::vector<SpillSortKey> sortingKeys;
   common::CompressionKind compressionKind;
+  /// The serde which serialized the file.
+  VectorSerde::Kind serdeKind{VectorSerde::Kind::kPresto};
+  /// The ZSTD dictionary that the Presto serde compressed the pages of the
+  /// file with, if any.
+  std::shared_ptr<common::ZstdDictionary> compressionDictionary;
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
@@ -110,9 +116,11 @@ class SpillWriterBase {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* asyncWriteExecutor = nullptr,
+      const common::SpillOverflowConfig* overflowConfig = nullptr);
 
-  virtual ~SpillWriterBase() = default;
+  virtual ~SpillWriterBase();
 
   /// Finishes the current file writing.
   void finishFile();
@@ -126,11 +134,9 @@ class SpillWriterBase {
   }
 
  protected:
-  virtual void flushBuffer(
-      SpillWriteFile* file,
-      uint64_t& writtenBytes,
-      uint64_t& flushTimeNs,
-      uint64_t& writeTimeNs) = 0;
+  // Serializes the buffered data for write and clears the buffer. Sets
+  // 'flushTimeNs' to the time spent.
+  virtual std::unique_ptr<folly::IOBuf> flushBuffer(uint64_t& flushTimeNs) = 0;
 
   virtual bool bufferEmpty() const = 0;
 
@@ -144,7 +150,8 @@ class SpillWriterBase {
   uint64_t writeWithBufferControl(const std::function<uint64_t()>& writeCb);
 
   // Writes data from buffer to the current output file. Returns the actual
-  // written size.
+  // written size. If 'asyncWriteExecutor_' is set, the write is started on it
+  // and finishes before the next flush or the file is closed.
   uint64_t flush();
 
   FOLLY_ALWAYS_INLINE void checkNotFinished() const {
@@ -166,9 +173,17 @@ class SpillWriterBase {
   // creates a new one. 'currentFile_' points to the current open spill file.
   SpillWriteFile* ensureFile();
 
+  // Returns the path prefix of the files on the overflow tier.
+  const std::string& overflowPathPrefix();
+
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
+  // Waits for the in-flight write to the current file to finish, if any, and
+  // updates the write stats. Runs the write on the calling thread if the
+  // executor has not started it.
+  void waitForPendingWrite();
+
   // Invoked to update the disk write stats.
   void updateWriteStats(
       uint64_t spilledBytes,
@@ -193,6 +208,24 @@ class SpillWriterBase {
 
   const uint64_t targetFileSize_;
 
+  folly::Executor* const asyncWriteExecutor_;
+
+  // If set, the files are created on the overflow tier with the file name part
+  // of 'pathPrefix_' once the local tier has reached its quota.
+  const common::SpillOverflowConfig* const overflowConfig_;
+  // The path prefix on the overflow tier. Set on the first overflow file.
+  std::string overflowPathPrefix_;
+  // True if 'currentFile_' is on the overflow tier.
+  bool currentFileOverflow_{false};
+  // True if the local tier had reached its quota at the last write.
+  bool localTierFull_{false};
+
+  // The in-flight write of 'pendingWriteBytes_' to 'currentFile_' on
+  // 'asyncWriteExecutor_'. Produces the write time in nanoseconds.
+  std::shared_ptr<AsyncSource<uint64_t>> pendingWrite_;
+  uint64_t pendingWriteBytes_{0};
+  uint64_t pendingFlushTimeNs_{0};
+
   uint64_t nextFileId_{0};
 
   bool finished_{false};
@@ -209,7 +242,9 @@ class SpillWriter : public SpillWriterBase {
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. If 'compressionDictionaryPages' is larger than 0,
+  /// 'compressionKind' is ZSTD and 'serdeKind' is Presto, the pages are
+  /// compressed with a ZSTD dictionary trained on the first this many pages.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -223,7 +258,11 @@ class SpillWriter : public SpillWriterBase {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* asyncWriteExecutor = nullptr,
+      VectorSerde::Kind serdeKind = VectorSerde::Kind::kPresto,
+      const common::SpillOverflowConfig* overflowConfig = nullptr,
+      int32_t compressionDictionaryPages = 0);
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -247,11 +286,7 @@ class SpillWriter : public SpillWriterBase {
     return batch_->size();
   }
 
-  void flushBuffer(
-      SpillWriteFile* file,
-      uint64_t& writtenBytes,
-      uint64_t& flushTimeNs,
-      uint64_t& writeTimeNs) override;
+  std::unique_ptr<folly::IOBuf> flushBuffer(uint64_t& flushTimeNs) override;
 
   void addFinishedFile(SpillWriteFile* file) override;
 
@@ -261,8 +296,16 @@ class SpillWriter : public SpillWriterBase {
 
   const common::CompressionKind compressionKind_;
 
+  const VectorSerde::Kind serdeKind_;
+
   VectorSerde* const serde_;
 
+  // The ZSTD dictionary state shared by the pages of all the files of 'this'.
+  // Set if the pages are compressed with a dictionary.
+  const std::shared_ptr<
+      serializer::presto::PrestoVectorSerde::ZstdDictionaryState>
+      zstdDictionary_;
+
   std::unique_ptr<VectorStreamGroup> batch_;
 };
 
@@ -296,6 +339,27 @@ class SpillReadFile {
     return size_;
   }
 
+  /// Returns the bytes left to deserialize before the next read from the file.
+  uint64_t bufferedBytes() const {
+    return input_->bufferedBytes();
+  }
+
+  /// Returns the bytes of the next read-ahead, or 0 if the next buffer can not
+  /// be prefetched. See FileInputStream::prefetchSize().
+  uint64_t prefetchSize() const {
+    return input_->prefetchSize();
+  }
+
+  /// Returns the memory held by an outstanding read-ahead.
+  uint64_t prefetchedBytes() const {
+    return input_->prefetchedBytes();
+  }
+
+  /// Reads the next buffer from the file on 'executor'.
+  void prefetch(folly::Executor* executor) {
+    input_->prefetch(executor);
+  }
+
   const std::string& testingFilePath() const {
     return path_;
   }
@@ -309,9 +373,15 @@ class SpillReadFile {
       const RowTypePtr& type,
       const std::vector<SpillSortKey>& sortingKeys,
       common::CompressionKind compressionKind,
+      VectorSerde::Kind serdeKind,
+      std::shared_ptr<common::ZstdDictionary> compressionDictionary,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats);
 
+  // The max number of rows read in a batch from a file written by a row wise
+  // serde. A batch of the Presto serde is a flushed write buffer instead.
+  static constexpr uint64_t kMaxRowsPerBatch = 1'024;
+
   // Invoked to record spill read stats at the end of read input.
   void recordSpillStats();
 
@@ -325,11 +395,44 @@ class SpillReadFile {
   const RowTypePtr type_;
   const std::vector<SpillSortKey> sortingKeys_;
   const common::CompressionKind compressionKind_;
+  const VectorSerde::Kind serdeKind_;
   const serializer::presto::PrestoVectorSerde::PrestoOptions readOptions_;
   memory::MemoryPool* const pool_;
   VectorSerde* const serde_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
   std::unique_ptr<common::FileInputStream> input_;
+  // The rows left to read in the current row group of a row wise serde.
+  std::unique_ptr<RowIterator> rowIterator_;
+};
+
+/// Schedules the read-ahead of the spill files merged by a spill partition's
+/// ordered reader. A merge consumes its files at different rates, so instead
+/// of prefetching every file, the scheduler prefetches the next buffer of the
+/// files with the fewest buffered bytes left, which are the next to block on
+/// a read, as long as the memory held by the outstanding read-aheads stays
+/// within 'budget'. The read-ahead buffers are allocated from the pool of the
+/// files, i.e. the pool of the operator which reads them.
+class SpillReadAheadScheduler {
+ public:
+  SpillReadAheadScheduler(folly::Executor* executor, uint64_t budget);
+
+  /// Adds a file to prefetch. 'file' must be removed before its destruction.
+  void add(SpillReadFile* file);
+
+  void remove(SpillReadFile* file);
+
+  /// Issues read-aheads for the files closest to needing a read. Invoked after
+  /// a file has read a batch.
+  void schedule();
+
+ private:
+  folly::Executor* const executor_;
+  const uint64_t budget_;
+
+  std::vector<SpillReadFile*> files_;
+
+  // Reusable memory.
+  std::vector<SpillReadFile*> candidates_;
 };
 } // namespace facebook::velox::exec
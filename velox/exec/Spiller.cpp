@@ -18,6 +18,7 @@
 #include <folly/ScopeGuard.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/process/TimelineTrace.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/HashJoinBridge.h"
@@ -27,6 +28,18 @@
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
+namespace {
+VectorSerde::Kind spillSerdeKind(const std::string& name) {
+  const auto kind = VectorSerde::kindByName(name);
+  VELOX_USER_CHECK(
+      kind == VectorSerde::Kind::kPresto ||
+          kind == VectorSerde::Kind::kCompactRow ||
+          kind == VectorSerde::Kind::kArrowIpc,
+      "Unsupported spill serde kind: {}",
+      name);
+  return kind;
+}
+} // namespace
 
 SpillerBase::SpillerBase(
     RowContainer* container,
@@ -64,12 +77,22 @@ SpillerBase::SpillerBase(
           spillConfig->prefixSortConfig,
           memory::spillMemoryPool(),
           spillStats,
-          spillConfig->fileCreateConfig) {
+          spillConfig->fileCreateConfig,
+          spillConfig->asyncWriteExecutor,
+          container == nullptr
+              ? VectorSerde::Kind::kPresto
+              : spillSerdeKind(spillConfig->rowContainerSerdeKind),
+          spillConfig->overflowConfig,
+          spillConfig->compressionDictionaryPages) {
   TestValue::adjust("facebook::velox::exec::SpillerBase", this);
 }
 
-void SpillerBase::spill(const RowContainerIterator* startRowIter) {
+void SpillerBase::spill(
+    const RowContainerIterator* startRowIter,
+    const std::vector<bool>* partitions,
+    std::vector<char*>* spilledRows) {
   VELOX_CHECK(!finalized_);
+  VELOX_CHECK_EQ(partitions == nullptr, spilledRows == nullptr);
 
   RowContainerIterator rowIter;
   if (startRowIter != nullptr) {
@@ -78,14 +101,22 @@ void SpillerBase::spill(const RowContainerIterator* startRowIter) {
 
   bool lastRun{false};
   do {
-    lastRun = fillSpillRuns(&rowIter);
+    lastRun = fillSpillRuns(&rowIter, partitions);
+    if (spilledRows != nullptr) {
+      for (const auto& [_, spillRun] : spillRuns_) {
+        spilledRows->insert(
+            spilledRows->end(), spillRun.rows.begin(), spillRun.rows.end());
+      }
+    }
     runSpill(lastRun);
   } while (!lastRun);
 
   checkEmptySpillRuns();
 }
 
-bool SpillerBase::fillSpillRuns(RowContainerIterator* iterator) {
+bool SpillerBase::fillSpillRuns(
+    RowContainerIterator* iterator,
+    const std::vector<bool>* partitions) {
   checkEmptySpillRuns();
 
   bool lastRun{false};
@@ -124,6 +155,9 @@ bool SpillerBase::fillSpillRuns(RowContainerIterator* iterator) {
         const auto partitionNum =
             isSinglePartition ? 0 : bits_.partition(hashes[i]);
         VELOX_DCHECK_GE(partitionNum, 0);
+        if (partitions != nullptr && !(*partitions)[partitionNum]) {
+          continue;
+        }
         // TODO: Fully integrate nested spill id into spiller partitioning,
         // replacing integer based partitioning.
         auto& spillRun = createOrGetSpillRun(SpillPartitionId(partitionNum));
@@ -144,6 +178,10 @@ bool SpillerBase::fillSpillRuns(RowContainerIterator* iterator) {
 
 void SpillerBase::runSpill(bool lastRun) {
   ++spillStats_->wlock()->spillRuns;
+  const auto timelineStartUs = process::TimelineTrack::current() != nullptr
+      ? process::TimelineTrace::nowUs()
+      : 0;
+  int64_t numSpilledRows{0};
 
   std::vector<std::shared_ptr<AsyncSource<SpillStatus>>> writes;
   for (const auto& [id, spillRun] : spillRuns_) {
@@ -185,12 +223,17 @@ void SpillerBase::runSpill(bool lastRun) {
     auto partitionId = result->partitionId;
     auto& run = spillRuns_.at(partitionId);
     VELOX_CHECK_EQ(numWritten, run.rows.size());
+    numSpilledRows += numWritten;
     run.clear();
     // When a sorted run ends, we start with a new file next time.
     if (needSort()) {
       state_.finishFile(partitionId);
     }
   }
+  if (timelineStartUs != 0) {
+    process::TimelineTrack::recordOnThread(
+        "spill", "spill", timelineStartUs, "rows", numSpilledRows);
+  }
 }
 
 std::unique_ptr<SpillerBase::SpillStatus> SpillerBase::writeSpill(
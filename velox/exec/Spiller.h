@@ -63,8 +63,13 @@ class SpillerBase {
       folly::Synchronized<common::SpillStats>* spillStats);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
-  // from row container starting at the offset pointed by 'startRowIter'.
-  void spill(const RowContainerIterator* startRowIter);
+  // from row container starting at the offset pointed by 'startRowIter'. If
+  // 'partitions' is not null, then we only spill the rows of the partitions
+  // set in 'partitions' and append them to 'spilledRows'.
+  void spill(
+      const RowContainerIterator* startRowIter,
+      const std::vector<bool>* partitions = nullptr,
+      std::vector<char*>* spilledRows = nullptr);
 
   // Writes out all the rows collected in spillRuns_.
   virtual void runSpill(bool lastRun);
@@ -170,9 +175,12 @@ class SpillerBase {
 
   // Prepares spill runs for the spillable data from all the hash partitions.
   // If 'startRowIter' is not null, we prepare runs starting from the offset
-  // pointed by 'startRowIter'.
+  // pointed by 'startRowIter'. If 'partitions' is not null, we only prepare
+  // runs for the partitions set in 'partitions'.
   // The function returns true if it is the last spill run.
-  bool fillSpillRuns(RowContainerIterator* startRowIter = nullptr);
+  bool fillSpillRuns(
+      RowContainerIterator* startRowIter = nullptr,
+      const std::vector<bool>* partitions = nullptr);
 
   void updateSpillExtractVectorTime(uint64_t timeNs);
 
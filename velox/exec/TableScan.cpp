@@ -142,6 +142,9 @@ RowVectorPtr TableScan::getOutput() {
          &debugString_});
 
     int32_t readBatchSize = readBatchSize_;
+    if (rowLimit_.has_value()) {
+      readBatchSize = std::min<int64_t>(readBatchSize, rowLimit_.value());
+    }
     if (maxFilteringRatio_ > 0) {
       readBatchSize = std::min(
           maxReadBatchSize_,
@@ -237,7 +240,7 @@ bool TableScan::getSplit() {
       planNodeId(),
       split,
       blockingFuture_,
-      maxPreloadedSplits_,
+      limitFitsInReadBatch() ? 0 : maxPreloadedSplits_,
       splitPreloader_);
   if (blockingReason_ != BlockingReason::kNotBlocked) {
     return false;
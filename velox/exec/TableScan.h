@@ -55,6 +55,14 @@ class TableScan : public SourceOperator {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  bool canAddRowLimit() const override {
+    return true;
+  }
+
+  void addRowLimit(int64_t numRows) override {
+    rowLimit_ = numRows;
+  }
+
   /// The name of runtime stats specific to table scan.
   /// The number of running table scan drivers.
   ///
@@ -90,6 +98,11 @@ class TableScan : public SourceOperator {
   // done, it will be made when needed.
   void preload(const std::shared_ptr<connector::ConnectorSplit>& split);
 
+  // Returns true if a downstream Limit needs no more rows than one read batch.
+  bool limitFitsInReadBatch() const {
+    return rowLimit_.has_value() && rowLimit_.value() <= readBatchSize_;
+  }
+
   // Invoked by scan operator to check if it needs to stop to wait for scale up.
   bool shouldWaitForScaleUp();
 
@@ -130,6 +143,12 @@ class TableScan : public SourceOperator {
 
   int32_t maxPreloadedSplits_{0};
 
+  // Number of output rows needed by a downstream Limit. Caps the read batch
+  // size. Splits are not preloaded while the rows fit in one read batch, as
+  // the current split is likely to produce them and the preloaded splits would
+  // only be cancelled.
+  std::optional<int64_t> rowLimit_;
+
   // Callback passed to getSplitOrFuture() for triggering async preload. The
   // callback's lifetime is the lifetime of 'this'. This callback can schedule
   // preloads on an executor. These preloads may outlive the Task and therefore
@@ -20,6 +20,19 @@
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Returns the id of the source of 'node' if it is a scale writer local
+// partition, or an empty id otherwise.
+core::PlanNodeId scaleWriterNodeId(const core::TableWriteNode& node) {
+  const auto partitionNode =
+      std::dynamic_pointer_cast<const core::LocalPartitionNode>(
+          node.sources()[0]);
+  if (partitionNode == nullptr || !partitionNode->scaleWriter()) {
+    return "";
+  }
+  return partitionNode->id();
+}
+} // namespace
 
 TableWriter::TableWriter(
     int32_t operatorId,
@@ -44,7 +57,8 @@ TableWriter::TableWriter(
       insertTableHandle_(
           tableWriteNode->insertTableHandle()->connectorInsertTableHandle()),
       commitStrategy_(tableWriteNode->commitStrategy()),
-      createTimeUs_(getCurrentTimeNano()) {
+      createTimeUs_(getCurrentTimeNano()),
+      scaleWriterNodeId_(scaleWriterNodeId(*tableWriteNode)) {
   setConnectorMemoryReclaimer();
   if (tableWriteNode->outputType()->size() == 1) {
     VELOX_USER_CHECK_NULL(tableWriteNode->aggregationNode());
@@ -95,6 +109,10 @@ void TableWriter::initialize() {
   Operator::initialize();
   VELOX_CHECK_NULL(dataSink_);
   createDataSink();
+  if (!scaleWriterNodeId_.empty()) {
+    sinkTracker_ = operatorCtx_->driver()->task()->getScaleWriterSinkTracker(
+        operatorCtx_->driverCtx()->splitGroupId, scaleWriterNodeId_);
+  }
   if (aggregation_ != nullptr) {
     aggregation_->initialize();
   }
@@ -155,9 +173,19 @@ void TableWriter::addInput(RowVectorPtr input) {
       mappedChildren,
       input->getNullCount());
 
+  const auto appendStartNs = getCurrentTimeNano();
   dataSink_->appendData(mappedInput);
   numWrittenRows_ += input->size();
-  updateStats(dataSink_->stats());
+  const auto sinkStats = dataSink_->stats();
+  if (sinkTracker_ != nullptr) {
+    const auto writeIOTimeUs =
+        std::max<uint64_t>(sinkStats.writeIOTimeUs, writeIOTimeUs_);
+    sinkTracker_->addAppend(
+        getCurrentTimeNano() - appendStartNs,
+        (writeIOTimeUs - writeIOTimeUs_) * 1'000);
+    writeIOTimeUs_ = writeIOTimeUs;
+  }
+  updateStats(sinkStats);
 
   if (aggregation_ != nullptr) {
     aggregation_->addInput(input);
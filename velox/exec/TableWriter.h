@@ -18,6 +18,7 @@
 
 #include "OperatorUtils.h"
 #include "velox/core/PlanNode.h"
+#include "velox/exec/LocalPartition.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/Operator.h"
 
@@ -250,6 +251,15 @@ class TableWriter : public Operator {
   ContinueFuture blockingFuture_{ContinueFuture::makeEmpty()};
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
 
+  // The id of the scale writer local partition that feeds this writer or
+  // empty if the input does not come from one.
+  const core::PlanNodeId scaleWriterNodeId_;
+  // Receives the sink append and write I/O times of this writer to drive the
+  // scaling of the writers. Set if 'scaleWriterNodeId_' is not empty.
+  std::shared_ptr<ScaleWriterSinkTracker> sinkTracker_;
+  // The sink write I/O time at the last append.
+  uint64_t writeIOTimeUs_{0};
+
   bool finished_{false};
   bool closed_{false};
   vector_size_t numWrittenRows_{0};
@@ -19,10 +19,12 @@
 #include <string>
 
 #include "velox/common/base/Counters.h"
+#include "velox/common/base/SpillStats.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/ConcurrentGroupingTable.h"
 #include "velox/exec/Exchange.h"
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/LocalPlanner.h"
@@ -33,6 +35,7 @@
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/TraceUtil.h"
+#include "velox/exec/WorkStealingExecutor.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -477,7 +480,55 @@ const std::string& Task::getOrCreateSpillDirectory() {
   return spillDirectory_;
 }
 
+const std::string& Task::getOrCreateOverflowSpillDirectory() {
+  VELOX_CHECK(
+      !overflowSpillDirectory_.empty(),
+      "Overflow spill directory must be set");
+  if (overflowSpillDirectoryCreated_) {
+    return overflowSpillDirectory_;
+  }
+
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  if (overflowSpillDirectoryCreated_) {
+    return overflowSpillDirectory_;
+  }
+
+  try {
+    auto fileSystem =
+        filesystems::getFileSystem(overflowSpillDirectory_, nullptr);
+    fileSystem->mkdir(overflowSpillDirectory_);
+  } catch (const std::exception& e) {
+    VELOX_FAIL(
+        "Failed to create overflow spill directory '{}' for Task {}: {}",
+        overflowSpillDirectory_,
+        taskId(),
+        e.what());
+  }
+  overflowSpillDirectoryCreated_ = true;
+  return overflowSpillDirectory_;
+}
+
+bool Task::updateLocalSpilledBytes(uint64_t bytes, uint64_t maxBytes) {
+  localSpilledBytes_ += bytes;
+  return common::updateGlobalLocalSpillTierBytes(bytes) < maxBytes;
+}
+
 void Task::removeSpillDirectoryIfExists() {
+  if (const auto localSpilledBytes = localSpilledBytes_.exchange(0);
+      localSpilledBytes > 0) {
+    common::updateGlobalLocalSpillTierBytes(
+        -static_cast<int64_t>(localSpilledBytes));
+  }
+  if (overflowSpillDirectoryCreated_) {
+    try {
+      auto fs = filesystems::getFileSystem(overflowSpillDirectory_, nullptr);
+      fs->rmdir(overflowSpillDirectory_);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove overflow spill directory '"
+                 << overflowSpillDirectory_ << "' for Task " << taskId()
+                 << ": " << e.what();
+    }
+  }
   if (spillDirectory_.empty() || !spillDirectoryCreated_) {
     return;
   }
@@ -500,6 +551,8 @@ void Task::initTaskPool() {
   VELOX_CHECK_NULL(pool_);
   pool_ = queryCtx_->pool()->addAggregateChild(
       fmt::format("task.{}", taskId_.c_str()), createTaskReclaimer());
+  maybeInitMemoryTrace();
+  maybeInitTimelineTrace();
 }
 
 velox::memory::MemoryPool* Task::getOrAddNodePool(
@@ -909,6 +962,16 @@ void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
     drivers_.resize(numDriversPerSplitGroup_ * concurrentSplitGroups_);
   }
 
+  // Place the drivers on one NUMA node if they all fit on its workers.
+  if (auto* workStealing =
+          dynamic_cast<WorkStealingExecutor*>(queryCtx_->executor())) {
+    if (workStealing->numNodes() > 1 &&
+        numDriversUngrouped_ + drivers_.size() <=
+            workStealing->minThreadsPerNode()) {
+      numaNode_ = workStealing->nextNode();
+    }
+  }
+
   // First, create drivers for ungrouped execution.
   if (numDriversUngrouped_ > 0) {
     createSplitGroupStateLocked(kUngroupedGroupId);
@@ -1399,6 +1462,9 @@ void Task::addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split) {
     if (isTaskRunning) {
       promise = addSplitLocked(
           getPlanNodeSplitsStateLocked(planNodeId), std::move(split));
+      if (timelineTrace_ != nullptr) {
+        recordSplitArrivalLocked(planNodeId);
+      }
     }
   }
 
@@ -1886,6 +1952,24 @@ std::shared_ptr<ScaledScanController> Task::getScaledScanControllerLocked(
   return it->second;
 }
 
+std::shared_ptr<ConcurrentGroupingTable>
+Task::getOrAddConcurrentGroupingTableLocked(
+    uint32_t splitGroupId,
+    const core::AggregationNode& aggregationNode) {
+  auto& table = splitGroupStates_[splitGroupId]
+                    .concurrentGroupingTables[aggregationNode.id()];
+  if (table == nullptr) {
+    auto* nodePool = getOrAddNodePool(aggregationNode.id());
+    childPools_.push_back(nodePool->addLeafChild(fmt::format(
+        "op.{}.{}.ConcurrentGroupingTable",
+        aggregationNode.id(),
+        splitGroupId)));
+    table = std::make_shared<ConcurrentGroupingTable>(
+        aggregationNode, childPools_.back().get());
+  }
+  return table;
+}
+
 void Task::addScaledScanControllerLocked(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId,
@@ -2362,6 +2446,10 @@ ContinueFuture Task::terminate(TaskState terminalState) {
     barrierPromises.swap(barrierFinishPromises_);
   }
 
+  // Writes the memory and timeline traces before the waiters for the task
+  // completion read them.
+  maybeFinishMemoryTrace();
+  maybeFinishTimelineTrace();
   taskCompletionNotifier.notify();
   stateChangeNotifier.notify();
 
@@ -2528,6 +2616,7 @@ TaskStats Task::taskStats() const {
   // 'taskStats_' contains task stats plus stats for the completed drivers
   // (their operators).
   TaskStats taskStats = taskStats_;
+  taskStats.numCrossNodeDriverRuns = numCrossNodeDriverRuns_;
 
   taskStats.numTotalDrivers = drivers_.size();
 
@@ -2924,6 +3013,8 @@ void Task::createLocalExchangeQueuesLocked(
                 .scaleWriterMinPartitionProcessedBytesRebalanceThreshold(),
             queryCtx_->queryConfig()
                 .scaleWriterMinProcessedBytesRebalanceThreshold());
+    exchange.scaleWriterSinkTracker =
+        std::make_shared<ScaleWriterSinkTracker>();
   }
 
   splitGroupState.localExchanges.insert({planNodeId, std::move(exchange)});
@@ -2984,6 +3075,22 @@ Task::getScaleWriterPartitionBalancer(
   return it->second.scaleWriterPartitionBalancer;
 }
 
+const std::shared_ptr<ScaleWriterSinkTracker>& Task::getScaleWriterSinkTracker(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+
+  auto it = splitGroupState.localExchanges.find(planNodeId);
+  VELOX_CHECK(
+      it != splitGroupState.localExchanges.end(),
+      "Incorrect local exchange ID {} for group {}, task {}",
+      planNodeId,
+      splitGroupId,
+      taskId());
+  return it->second.scaleWriterSinkTracker;
+}
+
 const std::shared_ptr<LocalExchangeMemoryManager>&
 Task::getLocalExchangeMemoryManager(
     uint32_t splitGroupId,
@@ -3082,6 +3189,9 @@ StopReason Task::enterForTerminateLocked(ThreadState& state) {
 void Task::leave(
     ThreadState& state,
     const std::function<void(StopReason)>& driverCb) {
+  if (memoryTraceWriter_ != nullptr) {
+    memoryTraceWriter_->maybeSample(getCurrentTimeMs());
+  }
   std::vector<ContinuePromise> threadFinishPromises;
   auto guard = folly::makeGuard([&]() {
     for (auto& promise : threadFinishPromises) {
@@ -3297,7 +3407,8 @@ void Task::createExchangeClientLocked(
       queryCtx()->queryConfig().minExchangeOutputBatchBytes(),
       addExchangeClientPool(planNodeId, pipelineId),
       queryCtx()->executor(),
-      queryCtx()->queryConfig().requestDataSizesMaxWaitSec());
+      queryCtx()->queryConfig().requestDataSizesMaxWaitSec(),
+      queryCtx()->queryConfig().exchangeAdaptiveFlowControl());
   exchangeClientByPlanNode_.emplace(planNodeId, exchangeClients_[pipelineId]);
 }
 
@@ -3392,6 +3503,89 @@ void Task::maybeInitTrace() {
   metadataWriter->write(queryCtx_, planFragment_.planNode);
 }
 
+void Task::maybeInitMemoryTrace() {
+  const auto& queryConfig = queryCtx_->queryConfig();
+  const auto sampleIntervalMs = queryConfig.queryTraceMemorySampleIntervalMs();
+  if (sampleIntervalMs == 0) {
+    return;
+  }
+  VELOX_USER_CHECK(
+      !queryConfig.queryTraceDir().empty(),
+      "Query memory trace enabled but the trace dir is not set");
+  const auto taskRegExp = queryConfig.queryTraceTaskRegExp();
+  if (!taskRegExp.empty() && !RE2::FullMatch(taskId_, taskRegExp)) {
+    return;
+  }
+  memoryTraceWriter_ = std::make_unique<trace::TaskMemoryTraceWriter>(
+      trace::getTaskTraceDirectory(
+          queryConfig.queryTraceDir(), queryCtx_->queryId(), taskId_),
+      pool_.get(),
+      sampleIntervalMs);
+}
+
+void Task::maybeFinishMemoryTrace() {
+  if (memoryTraceWriter_ == nullptr) {
+    return;
+  }
+  try {
+    memoryTraceWriter_->finish();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to write the memory trace of task " << taskId_
+               << ": " << e.what();
+  }
+}
+
+void Task::maybeInitTimelineTrace() {
+  const auto& queryConfig = queryCtx_->queryConfig();
+  const auto maxEvents = queryConfig.queryTraceTimelineMaxEvents();
+  if (maxEvents == 0) {
+    return;
+  }
+  VELOX_USER_CHECK(
+      !queryConfig.queryTraceDir().empty(),
+      "Query timeline trace enabled but the trace dir is not set");
+  const auto taskRegExp = queryConfig.queryTraceTaskRegExp();
+  if (!taskRegExp.empty() && !RE2::FullMatch(taskId_, taskRegExp)) {
+    return;
+  }
+  timelineTraceWriter_ = std::make_unique<trace::TaskTimelineTraceWriter>(
+      trace::getTaskTraceDirectory(
+          queryConfig.queryTraceDir(), queryCtx_->queryId(), taskId_),
+      maxEvents);
+  timelineTrace_ = timelineTraceWriter_->trace();
+}
+
+void Task::maybeFinishTimelineTrace() {
+  if (timelineTraceWriter_ == nullptr) {
+    return;
+  }
+  try {
+    timelineTraceWriter_->finish();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to write the timeline trace of task " << taskId_
+               << ": " << e.what();
+  }
+}
+
+void Task::recordSplitArrivalLocked(const core::PlanNodeId& planNodeId) {
+  process::TimelineEvent event;
+  event.name = "split";
+  event.category = "split";
+  // The splits that arrive before the start of the task are on pipeline -1.
+  event.pid = -1;
+  for (auto i = 0; i < driverFactories_.size(); ++i) {
+    if (driverFactories_[i]->leafNodeId() == planNodeId) {
+      event.pid = i;
+      break;
+    }
+  }
+  event.startUs = process::TimelineTrace::nowUs();
+  event.instant = true;
+  event.valueName = "numQueuedSplits";
+  event.value = taskStats_.numQueuedSplits;
+  timelineTrace_->record(event);
+}
+
 void Task::testingVisitDrivers(const std::function<void(Driver*)>& callback) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   for (int i = 0; i < drivers_.size(); ++i) {
@@ -34,6 +34,7 @@ namespace facebook::velox::exec {
 
 class OutputBufferManager;
 
+class ConcurrentGroupingTable;
 class HashJoinBridge;
 class NestedLoopJoinBridge;
 
@@ -116,6 +117,14 @@ class Task : public std::enable_shared_from_this<Task> {
     spillDirectoryCallback_ = std::move(spillDirectoryCallback);
   }
 
+  /// Specifies the directory on the overflow spill tier, e.g. on a remote
+  /// object store, to which data is spilled once the local spill tier of the
+  /// node reaches the quota set by QueryConfig::kSpillLocalTierMaxBytes. The
+  /// directory is created on first use.
+  void setOverflowSpillDirectory(const std::string& overflowSpillDirectory) {
+    overflowSpillDirectory_ = overflowSpillDirectory;
+  }
+
   /// Returns human-friendly representation of the plan augmented with runtime
   /// statistics. The implementation invokes exec::printPlanWithStats().
   ///
@@ -167,6 +176,13 @@ class Task : public std::enable_shared_from_this<Task> {
     return traceConfig_;
   }
 
+  /// Returns the timeline trace the drivers of this task record into if
+  /// 'QueryConfig::kQueryTraceTimelineMaxEvents' is set for this task, or
+  /// nullptr.
+  const std::shared_ptr<process::TimelineTrace>& timelineTrace() const {
+    return timelineTrace_;
+  }
+
   /// Returns ConsumerSupplier passed in the constructor.
   ConsumerSupplier consumerSupplier() const {
     return consumerSupplier_;
@@ -394,6 +410,18 @@ class Task : public std::enable_shared_from_this<Task> {
     return numFinishedDrivers_;
   }
 
+  /// Returns the NUMA node of the WorkStealingExecutor the drivers of this
+  /// task are placed on, or -1 if not placed on a node.
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
+  /// Invoked by a driver placed on a NUMA node which runs on a worker of
+  /// another node.
+  void addCrossNodeDriverRun() {
+    ++numCrossNodeDriverRuns_;
+  }
+
   /// Internal public methods. These methods are intended to be used by internal
   /// library components (Driver, Operator, etc.) and should not be called by
   /// the library users.
@@ -454,6 +482,14 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  /// Returns the grouping table shared by the HashAggregation operators of
+  /// 'aggregationNode' in split group 'splitGroupId'. Creates the table on the
+  /// first call.
+  std::shared_ptr<ConcurrentGroupingTable>
+  getOrAddConcurrentGroupingTableLocked(
+      uint32_t splitGroupId,
+      const core::AggregationNode& aggregationNode);
+
   void splitFinished(bool fromTableScan, int64_t splitWeight);
 
   void multipleSplitsFinished(
@@ -509,6 +545,13 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  /// Returns the shared tracker of the sink times of the table writers behind
+  /// a scale writer local partition with the given split group id and plan
+  /// node id.
+  const std::shared_ptr<ScaleWriterSinkTracker>& getScaleWriterSinkTracker(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
   void setError(const std::exception_ptr& exception);
 
   void setError(const std::string& message);
@@ -731,6 +774,20 @@ class Task : public std::enable_shared_from_this<Task> {
   /// folder could not be created.
   const std::string& getOrCreateSpillDirectory();
 
+  const std::string& overflowSpillDirectory() const {
+    return overflowSpillDirectory_;
+  }
+
+  /// Returns the overflow spill directory path. Ensures that the directory is
+  /// created before returning. Is thread safe.
+  const std::string& getOrCreateOverflowSpillDirectory();
+
+  /// Adds 'bytes' written to the spill files of this task on the local spill
+  /// tier to the bytes of the node's local spill tier. Returns true if the
+  /// node's local spill tier holds less than 'maxBytes'. The bytes are released
+  /// when the spill directory is removed.
+  bool updateLocalSpilledBytes(uint64_t bytes, uint64_t maxBytes);
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -1110,6 +1167,24 @@ class Task : public std::enable_shared_from_this<Task> {
   // trace enabled.
   void maybeInitTrace();
 
+  // Creates 'memoryTraceWriter_' if the memory trace is enabled for this task.
+  void maybeInitMemoryTrace();
+
+  // Writes the memory trace file if 'memoryTraceWriter_' is set. Logs the
+  // errors instead of failing the task.
+  void maybeFinishMemoryTrace();
+
+  // Creates 'timelineTraceWriter_' if the timeline trace is enabled for this
+  // task.
+  void maybeInitTimelineTrace();
+
+  // Writes the timeline trace file if 'timelineTraceWriter_' is set. Logs the
+  // errors instead of failing the task.
+  void maybeFinishTimelineTrace();
+
+  // Records the arrival of a split for 'planNodeId' into 'timelineTrace_'.
+  void recordSplitArrivalLocked(const core::PlanNodeId& planNodeId);
+
   std::shared_ptr<Driver> getDriver(uint32_t driverId) const;
 
   // Invokes to record the start/end time of task output batch processing time
@@ -1163,6 +1238,16 @@ class Task : public std::enable_shared_from_this<Task> {
   // NOTE: 'childPools_' holds the ownerships of node memory pools.
   std::unordered_map<std::string, memory::MemoryPool*> nodePools_;
 
+  // Samples the memory usage of 'pool_' and its descendants if
+  // 'QueryConfig::kQueryTraceMemorySampleIntervalMs' is set.
+  std::unique_ptr<trace::TaskMemoryTraceWriter> memoryTraceWriter_;
+
+  // Keeps the timeline events of the drivers of this task if
+  // 'QueryConfig::kQueryTraceTimelineMaxEvents' is set. 'timelineTrace_' is
+  // the trace of the writer.
+  std::unique_ptr<trace::TaskTimelineTraceWriter> timelineTraceWriter_;
+  std::shared_ptr<process::TimelineTrace> timelineTrace_;
+
   // Set to true by OutputBufferManager when all output is
   // acknowledged. If this happens before Drivers are at end, the last
   // Driver to finish will set state_ to kFinished. If Drivers have
@@ -1381,6 +1466,23 @@ class Task : public std::enable_shared_from_this<Task> {
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
 
+  // Spill directory on the overflow spill tier for this task.
+  std::string overflowSpillDirectory_;
+
+  // Indicates whether the overflow spill directory has been created.
+  std::atomic<bool> overflowSpillDirectoryCreated_{false};
+
+  // The bytes of the spill files of this task on the local spill tier.
+  std::atomic<uint64_t> localSpilledBytes_{0};
+
+  // The NUMA node of the WorkStealingExecutor to run the drivers on, or -1.
+  // Set when the drivers start.
+  std::atomic_int32_t numaNode_{-1};
+
+  // The number of driver runs on a worker of another NUMA node than
+  // 'numaNode_'.
+  std::atomic<uint64_t> numCrossNodeDriverRuns_{0};
+
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
@@ -103,6 +103,9 @@ struct TaskStats {
   uint64_t numTerminatedDrivers{0};
   /// The number of drivers that are currently running on driver thread.
   uint64_t numRunningDrivers{0};
+  /// The number of driver runs on a worker of another NUMA node than the one
+  /// the task is placed on, see WorkStealingExecutor.
+  uint64_t numCrossNodeDriverRuns{0};
   /// Drivers blocked for various reasons. Based on enum BlockingReason.
   std::unordered_map<BlockingReason, uint64_t> numBlockedDrivers;
 
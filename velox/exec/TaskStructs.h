@@ -20,11 +20,13 @@
 
 namespace facebook::velox::exec {
 
+class ConcurrentGroupingTable;
 class Driver;
 class JoinBridge;
 class LocalExchangeMemoryManager;
 class MergeSource;
 class MergeJoinSource;
+class ScaleWriterSinkTracker;
 struct Split;
 
 /// Corresponds to Presto TaskState, needed for reporting query completion.
@@ -92,6 +94,7 @@ struct LocalExchangeState {
   std::vector<std::shared_ptr<LocalExchangeQueue>> queues;
   std::shared_ptr<common::SkewedPartitionRebalancer>
       scaleWriterPartitionBalancer;
+  std::shared_ptr<ScaleWriterSinkTracker> scaleWriterSinkTracker;
 };
 
 /// Stores inter-operator state (exchange, bridges) for split groups.
@@ -121,6 +124,13 @@ struct SplitGroupState {
   std::unordered_map<core::PlanNodeId, std::shared_ptr<ScaledScanController>>
       scaledScanControllers;
 
+  /// Map of the grouping tables shared by the drivers of concurrent hash
+  /// aggregations keyed on AggregationNode plan node ID.
+  std::unordered_map<
+      core::PlanNodeId,
+      std::shared_ptr<ConcurrentGroupingTable>>
+      concurrentGroupingTables;
+
   /// Drivers created and still running for this split group.
   /// The split group is finished when this numbers reaches zero.
   uint32_t numRunningDrivers{0};
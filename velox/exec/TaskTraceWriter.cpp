@@ -15,13 +15,51 @@
  */
 
 #include "velox/exec/TaskTraceWriter.h"
+
+#include <cstring>
+#include <set>
+
 #include "velox/common/file/File.h"
+#include "velox/common/time/Timer.h"
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Trace.h"
 #include "velox/exec/TraceUtil.h"
 
 namespace facebook::velox::exec::trace {
+namespace {
+// The maximum number of allocation call sites recorded per pool.
+constexpr size_t kMaxCallSites = 5;
+
+// Calls 'visitor' on 'pool' and all its descendants.
+void visitPools(
+    memory::MemoryPool* pool,
+    const std::function<void(memory::MemoryPool*)>& visitor) {
+  visitor(pool);
+  pool->visitChildren([&](memory::MemoryPool* child) {
+    visitPools(child, visitor);
+    return true;
+  });
+}
+
+// The offset of the thread ids of the I/O tracks from the thread ids of the
+// driver tracks.
+constexpr int32_t kIoThreadIdOffset = 1'000'000;
+
+folly::dynamic makeMetadataEvent(
+    const char* name,
+    int32_t pid,
+    int32_t tid,
+    const std::string& value) {
+  folly::dynamic eventObj = folly::dynamic::object;
+  eventObj["name"] = name;
+  eventObj["ph"] = "M";
+  eventObj["pid"] = pid;
+  eventObj["tid"] = tid;
+  eventObj["args"] = folly::dynamic::object("name", value);
+  return eventObj;
+}
+} // namespace
 
 TaskTraceMetadataWriter::TaskTraceMetadataWriter(
     std::string traceDir,
@@ -65,4 +103,233 @@ void TaskTraceMetadataWriter::write(
   file->close();
 }
 
+TaskMemoryTraceWriter::TaskMemoryTraceWriter(
+    std::string traceDir,
+    memory::MemoryPool* taskPool,
+    uint64_t sampleIntervalMs)
+    : traceDir_(std::move(traceDir)),
+      taskPool_(taskPool),
+      sampleIntervalMs_(sampleIntervalMs),
+      startTimeMs_(getCurrentTimeMs()) {
+  VELOX_CHECK_NOT_NULL(taskPool_);
+  VELOX_CHECK_GT(sampleIntervalMs_, 0);
+}
+
+void TaskMemoryTraceWriter::maybeSample(uint64_t nowMs) {
+  if (nowMs < nextSampleMs_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  std::unique_lock<std::mutex> l(mutex_, std::try_to_lock);
+  if (!l.owns_lock() || finished_ ||
+      nowMs < nextSampleMs_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  sampleLocked(nowMs);
+}
+
+void TaskMemoryTraceWriter::sampleLocked(uint64_t nowMs) {
+  nextSampleMs_ = nowMs + sampleIntervalMs_;
+  auto& sample = samples_.emplace_back();
+  sample.timeMs = nowMs > startTimeMs_ ? nowMs - startTimeMs_ : 0;
+  std::vector<memory::MemoryPool*> leafPools;
+  visitPools(taskPool_, [&](memory::MemoryPool* pool) {
+    const auto reservedBytes = pool->reservedBytes();
+    if (reservedBytes == 0 && pool != taskPool_) {
+      return;
+    }
+    sample.reservedBytes.emplace_back(
+        poolIndexLocked(pool->name()), reservedBytes);
+    if (pool->kind() == memory::MemoryPool::Kind::kLeaf &&
+        pool->debugEnabled()) {
+      leafPools.push_back(pool);
+    }
+  });
+
+  // The task pool is visited first.
+  if (samples_.size() > 1 &&
+      sample.reservedBytes[0].second <=
+          samples_[maxSample_].reservedBytes[0].second) {
+    return;
+  }
+  maxSample_ = samples_.size() - 1;
+  maxSampleCallSites_ = folly::dynamic::object;
+  for (auto* pool : leafPools) {
+    auto* poolImpl = dynamic_cast<memory::MemoryPoolImpl*>(pool);
+    if (poolImpl == nullptr) {
+      continue;
+    }
+    const auto callSites = poolImpl->debugAllocationCallSites();
+    if (callSites.empty()) {
+      continue;
+    }
+    folly::dynamic callSitesObj = folly::dynamic::array;
+    for (auto i = 0; i < std::min(kMaxCallSites, callSites.size()); ++i) {
+      folly::dynamic callSiteObj = folly::dynamic::object;
+      callSiteObj[TaskMemoryTraceTraits::kCallStackKey] =
+          callSites[i].callStack;
+      callSiteObj[TaskMemoryTraceTraits::kBytesKey] = callSites[i].bytes;
+      callSiteObj[TaskMemoryTraceTraits::kNumAllocationsKey] =
+          callSites[i].numAllocations;
+      callSitesObj.push_back(std::move(callSiteObj));
+    }
+    maxSampleCallSites_[pool->name()] = std::move(callSitesObj);
+  }
+}
+
+uint32_t TaskMemoryTraceWriter::poolIndexLocked(const std::string& name) {
+  const auto [it, inserted] =
+      poolIndices_.emplace(name, static_cast<uint32_t>(poolNames_.size()));
+  if (inserted) {
+    poolNames_.push_back(name);
+  }
+  return it->second;
+}
+
+void TaskMemoryTraceWriter::finish() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!finished_, "Task memory trace can only be written once");
+  finished_ = true;
+  sampleLocked(getCurrentTimeMs());
+
+  // The time of the largest sampled reservation of each pool.
+  std::vector<uint64_t> maxReservedBytes(poolNames_.size(), 0);
+  std::vector<uint64_t> peakTimeMs(poolNames_.size(), 0);
+  folly::dynamic samplesObj = folly::dynamic::array;
+  for (const auto& sample : samples_) {
+    folly::dynamic reservedBytesObj = folly::dynamic::object;
+    for (const auto& [index, bytes] : sample.reservedBytes) {
+      reservedBytesObj[poolNames_[index]] = bytes;
+      if (bytes > maxReservedBytes[index]) {
+        maxReservedBytes[index] = bytes;
+        peakTimeMs[index] = sample.timeMs;
+      }
+    }
+    folly::dynamic sampleObj = folly::dynamic::object;
+    sampleObj[TaskMemoryTraceTraits::kTimeMsKey] = sample.timeMs;
+    sampleObj[TaskMemoryTraceTraits::kReservedBytesKey] =
+        std::move(reservedBytesObj);
+    samplesObj.push_back(std::move(sampleObj));
+  }
+
+  // The pools of the task stay alive until the task is destroyed, so the
+  // peaks include the pools that were empty at all the samples.
+  std::vector<std::pair<std::string, uint64_t>> peaks;
+  visitPools(taskPool_, [&](memory::MemoryPool* pool) {
+    peaks.emplace_back(pool->name(), pool->peakBytes());
+  });
+  std::stable_sort(
+      peaks.begin(), peaks.end(), [](const auto& left, const auto& right) {
+        return left.second > right.second;
+      });
+  folly::dynamic peaksObj = folly::dynamic::array;
+  for (const auto& [name, peakBytes] : peaks) {
+    folly::dynamic peakObj = folly::dynamic::object;
+    peakObj[TaskMemoryTraceTraits::kPoolKey] = name;
+    peakObj[TaskMemoryTraceTraits::kPeakBytesKey] = peakBytes;
+    const auto it = poolIndices_.find(name);
+    if (it != poolIndices_.end()) {
+      peakObj[TaskMemoryTraceTraits::kPeakTimeMsKey] = peakTimeMs[it->second];
+    }
+    peaksObj.push_back(std::move(peakObj));
+  }
+
+  folly::dynamic traceObj = folly::dynamic::object;
+  traceObj[TaskMemoryTraceTraits::kSampleIntervalMsKey] = sampleIntervalMs_;
+  traceObj[TaskMemoryTraceTraits::kSamplesKey] = std::move(samplesObj);
+  traceObj[TaskMemoryTraceTraits::kPeaksKey] = std::move(peaksObj);
+  traceObj[TaskMemoryTraceTraits::kMaxSampleTimeMsKey] =
+      samples_[maxSample_].timeMs;
+  traceObj[TaskMemoryTraceTraits::kCallSitesKey] =
+      std::move(maxSampleCallSites_);
+
+  const auto fs = filesystems::getFileSystem(traceDir_, nullptr);
+  if (!fs->exists(traceDir_)) {
+    fs->mkdir(traceDir_);
+  }
+  const auto file =
+      fs->openFileForWrite(getTaskMemoryTraceFilePath(traceDir_));
+  file->append(folly::toJson(traceObj));
+  file->close();
+}
+
+TaskTimelineTraceWriter::TaskTimelineTraceWriter(
+    std::string traceDir,
+    uint32_t maxEvents)
+    : traceDir_(std::move(traceDir)),
+      trace_(std::make_shared<process::TimelineTrace>(maxEvents)),
+      startUs_(process::TimelineTrace::nowUs()) {
+  VELOX_CHECK_GT(maxEvents, 0);
+}
+
+void TaskTimelineTraceWriter::finish() {
+  VELOX_CHECK(
+      !finished_.exchange(true),
+      "Task timeline trace can only be written once");
+  const auto events = trace_->events();
+
+  folly::dynamic eventsObj = folly::dynamic::array;
+  std::set<int32_t> pids;
+  std::set<std::pair<int32_t, int32_t>> tracks;
+  for (const auto& event : events) {
+    const bool io =
+        strcmp(event.category, process::TimelineEvent::kIoCategory) == 0;
+    const auto tid = io ? event.tid + kIoThreadIdOffset : event.tid;
+    folly::dynamic eventObj = folly::dynamic::object;
+    eventObj["name"] = event.name;
+    eventObj["cat"] = event.category;
+    eventObj["pid"] = event.pid;
+    eventObj["tid"] = tid;
+    eventObj["ts"] = event.startUs > startUs_ ? event.startUs - startUs_ : 0;
+    if (event.instant) {
+      // An instant event of the process, e.g. of the pipeline.
+      eventObj["ph"] = "i";
+      eventObj["s"] = "p";
+    } else {
+      eventObj["ph"] = "X";
+      eventObj["dur"] = event.durationUs;
+      tracks.emplace(event.pid, tid);
+    }
+    if (event.valueName != nullptr) {
+      eventObj["args"] = folly::dynamic::object(event.valueName, event.value);
+    }
+    pids.insert(event.pid);
+    eventsObj.push_back(std::move(eventObj));
+  }
+
+  for (const auto pid : pids) {
+    // The splits that arrive before the start of the task have no pipeline.
+    eventsObj.push_back(makeMetadataEvent(
+        "process_name",
+        pid,
+        0,
+        pid < 0 ? std::string("task") : fmt::format("pipeline {}", pid)));
+  }
+  for (const auto& [pid, tid] : tracks) {
+    eventsObj.push_back(makeMetadataEvent(
+        "thread_name",
+        pid,
+        tid,
+        tid >= kIoThreadIdOffset
+            ? fmt::format("driver {} I/O", tid - kIoThreadIdOffset)
+            : fmt::format("driver {}", tid)));
+  }
+
+  folly::dynamic traceObj = folly::dynamic::object;
+  traceObj["traceEvents"] = std::move(eventsObj);
+  traceObj["displayTimeUnit"] = "ms";
+  const auto numRecorded = trace_->numRecorded();
+  traceObj["otherData"] =
+      folly::dynamic::object("numRecordedEvents", numRecorded)(
+          "numDroppedEvents", numRecorded - events.size());
+
+  const auto fs = filesystems::getFileSystem(traceDir_, nullptr);
+  if (!fs->exists(traceDir_)) {
+    fs->mkdir(traceDir_);
+  }
+  const auto file =
+      fs->openFileForWrite(getTaskTimelineTraceFilePath(traceDir_));
+  file->append(folly::toJson(traceObj));
+  file->close();
+}
+
 } // namespace facebook::velox::exec::trace
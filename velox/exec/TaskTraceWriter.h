@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <folly/dynamic.h>
+
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/process/TimelineTrace.h"
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
 
@@ -35,4 +38,84 @@ class TaskTraceMetadataWriter {
   const std::string traceFilePath_;
   bool finished_{false};
 };
+
+/// Samples the memory reservations of the memory pools of a task, see
+/// 'QueryConfig::kQueryTraceMemorySampleIntervalMs', and writes them to the
+/// task memory trace file in the task trace directory when the task
+/// completes. The file has the sampled reservation of each non-empty pool
+/// over time and the peak usage of each pool, the largest first. For the
+/// sample with the largest task reservation, it also has the call sites of
+/// the outstanding allocations of the pools that record them in memory pool
+/// debug mode, see 'MemoryManager::Options::debugEnabled'.
+class TaskMemoryTraceWriter {
+ public:
+  TaskMemoryTraceWriter(
+      std::string traceDir,
+      memory::MemoryPool* taskPool,
+      uint64_t sampleIntervalMs);
+
+  /// Samples the reservations of the task pool and its descendants if
+  /// 'sampleIntervalMs' passed since the last sample. Returns without sampling
+  /// if another thread is sampling.
+  void maybeSample(uint64_t nowMs);
+
+  /// Takes a last sample and writes the trace file. Can be called only once.
+  void finish();
+
+ private:
+  struct Sample {
+    // The time since the creation of the writer.
+    uint64_t timeMs;
+    // The index in 'poolNames_' and the reserved bytes of the non-empty pools.
+    std::vector<std::pair<uint32_t, uint64_t>> reservedBytes;
+  };
+
+  void sampleLocked(uint64_t nowMs);
+
+  uint32_t poolIndexLocked(const std::string& name);
+
+  const std::string traceDir_;
+  memory::MemoryPool* const taskPool_;
+  const uint64_t sampleIntervalMs_;
+  const uint64_t startTimeMs_;
+
+  // The earliest time for the next sample.
+  std::atomic_uint64_t nextSampleMs_{0};
+
+  std::mutex mutex_;
+  std::vector<std::string> poolNames_;
+  std::unordered_map<std::string, uint32_t> poolIndices_;
+  std::vector<Sample> samples_;
+  // The index in 'samples_' of the sample with the largest task reservation.
+  size_t maxSample_{0};
+  // The allocation call sites of the leaf pools at 'maxSample_' by pool name.
+  folly::dynamic maxSampleCallSites_ = folly::dynamic::object;
+  bool finished_{false};
+};
+
+/// Keeps the latest timeline events of a task, see
+/// 'QueryConfig::kQueryTraceTimelineMaxEvents', and writes them to the task
+/// timeline trace file in the task trace directory when the task completes.
+/// The file is in the Chrome trace event format, which chrome://tracing and
+/// Perfetto open. Each pipeline is a process and each driver a thread of it,
+/// with the I/O of the driver on a separate thread.
+class TaskTimelineTraceWriter {
+ public:
+  TaskTimelineTraceWriter(std::string traceDir, uint32_t maxEvents);
+
+  const std::shared_ptr<process::TimelineTrace>& trace() const {
+    return trace_;
+  }
+
+  /// Writes the trace file. Can be called only once.
+  void finish();
+
+ private:
+  const std::string traceDir_;
+  const std::shared_ptr<process::TimelineTrace> trace_;
+  // The time of the creation of the writer. The event times in the file are
+  // relative to this.
+  const uint64_t startUs_;
+  std::atomic_bool finished_{false};
+};
 } // namespace facebook::velox::exec::trace
@@ -15,8 +15,11 @@
  */
 #include <folly/container/F14Map.h>
 
-#include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/TopN.h"
+#include "velox/common/base/SimdUtil.h"
+#include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/Driver.h"
+#include "velox/type/Filter.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
@@ -31,6 +34,8 @@ TopN::TopN(
           topNNode->id(),
           "TopN"),
       count_(topNNode->count()),
+      firstKeyAscending_(topNNode->sortingOrders()[0].isAscending()),
+      firstKeyNullsFirst_(topNNode->sortingOrders()[0].isNullsFirst()),
       data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
       comparator_(
           outputType_,
@@ -38,7 +43,9 @@ TopN::TopN(
           topNNode->sortingOrders(),
           data_.get()),
       topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {
+      decodedVectors_(outputType_->children().size()),
+      maxPayloadBatches_(
+          driverCtx->queryConfig().topNLateMaterializationMaxBatches()) {
   const auto numColumns{outputType_->children().size()};
   const auto numSortingKeys{topNNode->sortingKeys().size()};
   sortingKeyColumns_.reserve(numSortingKeys);
@@ -57,16 +64,193 @@ TopN::TopN(
   }
 }
 
+namespace {
+bool isIntegerKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t readInteger(TypeKind kind, const char* value) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return *reinterpret_cast<const int8_t*>(value);
+    case TypeKind::SMALLINT:
+      return *reinterpret_cast<const int16_t*>(value);
+    case TypeKind::INTEGER:
+      return *reinterpret_cast<const int32_t*>(value);
+    case TypeKind::BIGINT:
+      return *reinterpret_cast<const int64_t*>(value);
+    default:
+      VELOX_UNREACHABLE("Unexpected type: {}", mapTypeKindToName(kind));
+  }
+}
+} // namespace
+
+void TopN::initialize() {
+  Operator::initialize();
+  const auto& keyType = outputType_->childAt(sortingKeyColumns_[0]);
+  if (count_ > 0 && isIntegerKind(keyType->kind()) &&
+      !keyType->providesCustomComparison()) {
+    canPushdownThreshold_ =
+        !operatorCtx_->driverCtx()
+             ->driver->canPushdownFilters(this, {sortingKeyColumns_[0]})
+             .empty();
+  }
+}
+
+bool TopN::prefilter(vector_size_t numRows) {
+  if (count_ == 0 || topRows_.size() < count_) {
+    return false;
+  }
+  const auto keyColumn = sortingKeyColumns_[0];
+  const auto& keyType = outputType_->childAt(keyColumn);
+  if (keyType->providesCustomComparison()) {
+    return false;
+  }
+  const char* topRow = topRows_.top();
+  const auto column = data_->columnAt(keyColumn);
+  if (RowContainer::isNullAt(topRow, column.nullByte(), column.nullMask())) {
+    if (!firstKeyNullsFirst_) {
+      // Null is last, so any row may be better than the top.
+      return false;
+    }
+    // Only the rows with a null key may be better than the top.
+    auto& decoded = decodedVectors_[keyColumn];
+    candidates_.resizeFill(numRows, false);
+    if (decoded.mayHaveNulls()) {
+      bits::forEachUnsetBit(decoded.nulls(), 0, numRows, [&](auto row) {
+        candidates_.setValid(row, true);
+      });
+    }
+    candidates_.updateBounds();
+    return true;
+  }
+
+  switch (keyType->kind()) {
+    case TypeKind::TINYINT:
+      return prefilterValues<int8_t>(numRows, topRow);
+    case TypeKind::SMALLINT:
+      return prefilterValues<int16_t>(numRows, topRow);
+    case TypeKind::INTEGER:
+      return prefilterValues<int32_t>(numRows, topRow);
+    case TypeKind::BIGINT:
+      return prefilterValues<int64_t>(numRows, topRow);
+    case TypeKind::REAL:
+      return prefilterValues<float>(numRows, topRow);
+    case TypeKind::DOUBLE:
+      return prefilterValues<double>(numRows, topRow);
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+bool TopN::prefilterValues(vector_size_t numRows, const char* topRow) {
+  const auto column = data_->columnAt(sortingKeyColumns_[0]);
+  const T threshold = *reinterpret_cast<const T*>(topRow + column.offset());
+  if constexpr (std::is_floating_point_v<T>) {
+    // NaN sorts after all the other values but compares false with them.
+    if (!firstKeyAscending_ || std::isnan(threshold)) {
+      return false;
+    }
+  }
+
+  auto& decoded = decodedVectors_[sortingKeyColumns_[0]];
+  candidates_.resize(numRows);
+  auto* rawCandidates = candidates_.asMutableRange().bits();
+  vector_size_t row = 0;
+  if (decoded.isIdentityMapping()) {
+    // Compares 64 rows at a time and stores a word of the candidate bits.
+    constexpr int32_t kBatchSize = xsimd::batch<T>::size;
+    const auto* values = decoded.data<T>();
+    const auto thresholds = xsimd::broadcast<T>(threshold);
+    for (; row + 64 <= numRows; row += 64) {
+      uint64_t word{0};
+      for (auto i = 0; i < 64; i += kBatchSize) {
+        const auto batch = xsimd::load_unaligned(values + row + i);
+        const auto passed = firstKeyAscending_ ? batch <= thresholds
+                                               : batch >= thresholds;
+        word |= static_cast<uint64_t>(simd::toBitMask(passed)) << i;
+      }
+      rawCandidates[row / 64] = word;
+    }
+  }
+  for (; row < numRows; ++row) {
+    const auto value = decoded.valueAt<T>(row);
+    bits::setBit(
+        rawCandidates,
+        row,
+        firstKeyAscending_ ? value <= threshold : value >= threshold);
+  }
+  if (decoded.mayHaveNulls()) {
+    bits::forEachUnsetBit(decoded.nulls(), 0, numRows, [&](auto nullRow) {
+      bits::setBit(rawCandidates, nullRow, firstKeyNullsFirst_);
+    });
+  }
+  candidates_.updateBounds();
+  return true;
+}
+
+void TopN::updateDynamicFilter() {
+  if (!canPushdownThreshold_ || topRows_.size() < count_) {
+    return;
+  }
+  const auto keyColumn = sortingKeyColumns_[0];
+  const char* topRow = topRows_.top();
+  const auto column = data_->columnAt(keyColumn);
+  if (RowContainer::isNullAt(topRow, column.nullByte(), column.nullMask())) {
+    if (!firstKeyNullsFirst_ || pushedNullThreshold_) {
+      return;
+    }
+    pushedNullThreshold_ = true;
+    dynamicFilters_[keyColumn] = std::make_shared<common::IsNull>();
+    return;
+  }
+
+  const auto threshold = readInteger(
+      outputType_->childAt(keyColumn)->kind(), topRow + column.offset());
+  if (pushedThreshold_ == threshold) {
+    return;
+  }
+  pushedThreshold_ = threshold;
+  // The rows equal to the threshold may be better than the top by the next
+  // sort keys.
+  if (firstKeyAscending_) {
+    dynamicFilters_[keyColumn] = std::make_shared<common::BigintRange>(
+        std::numeric_limits<int64_t>::min(), threshold, firstKeyNullsFirst_);
+  } else {
+    dynamicFilters_[keyColumn] = std::make_shared<common::BigintRange>(
+        threshold, std::numeric_limits<int64_t>::max(), firstKeyNullsFirst_);
+  }
+}
+
 void TopN::addInput(RowVectorPtr input) {
   for (const auto col : sortingKeyColumns_) {
     decodedVectors_[col].decode(*input->childAt(col));
   }
 
+  const bool prefiltered = prefilter(input->size());
+  if (prefiltered) {
+    addRuntimeStat(
+        kNumPrefilteredRows,
+        RuntimeCounter(input->size() - candidates_.countSelected()));
+  }
+
   const bool hasNonKeyColumn{!nonKeyColumns_.empty()};
   // Maps passed rows of 'data_' to the corresponding input row number. These
   // input rows of non-key columns are later stored into data_.
   folly::F14FastMap<void*, vector_size_t> passedRows;
   for (auto row = 0; row < input->size(); ++row) {
+    if (prefiltered && !candidates_.isValid(row)) {
+      continue;
+    }
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -77,6 +261,9 @@ void TopN::addInput(RowVectorPtr input) {
         continue;
       }
       topRows_.pop();
+      if (maxPayloadBatches_ > 0) {
+        releasePayload(topRow);
+      }
       // Reuse the topRow's memory.
       newRow = data_->initializeRow(topRow, true /* reuse */);
     }
@@ -92,7 +279,9 @@ void TopN::addInput(RowVectorPtr input) {
     }
   }
 
-  if (hasNonKeyColumn && !passedRows.empty()) {
+  if (hasNonKeyColumn && !passedRows.empty() && maxPayloadBatches_ > 0) {
+    addPayloadBatch(input, passedRows);
+  } else if (hasNonKeyColumn && !passedRows.empty()) {
     for (const auto col : nonKeyColumns_) {
       decodedVectors_[col].decode(*input->childAt(col));
       for (const auto [dataRow, inputRow] : passedRows) {
@@ -104,6 +293,78 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+  updateDynamicFilter();
+}
+
+void TopN::addPayloadBatch(
+    const RowVectorPtr& input,
+    const folly::F14FastMap<void*, vector_size_t>& passedRows) {
+  const auto batch = nextPayloadBatch_++;
+  auto& payloadBatch = payloadBatches_[batch];
+  payloadBatch.columns.reserve(nonKeyColumns_.size());
+  for (const auto col : nonKeyColumns_) {
+    // Lazy vectors are loaded since the batch outlives the input.
+    payloadBatch.columns.push_back(
+        BaseVector::loadedVectorShared(input->childAt(col)));
+  }
+  payloadBatch.numRows = passedRows.size();
+  for (const auto [dataRow, inputRow] : passedRows) {
+    payloadSources_[reinterpret_cast<char*>(dataRow)] = {batch, inputRow};
+  }
+  if (payloadBatches_.size() > maxPayloadBatches_) {
+    compactPayload();
+  }
+}
+
+void TopN::releasePayload(char* row) {
+  auto it = payloadSources_.find(row);
+  if (it == payloadSources_.end()) {
+    // The row was added from the current input.
+    return;
+  }
+  auto batchIt = payloadBatches_.find(it->second.batch);
+  VELOX_CHECK(batchIt != payloadBatches_.end());
+  if (--batchIt->second.numRows == 0) {
+    payloadBatches_.erase(batchIt);
+  }
+  payloadSources_.erase(it);
+}
+
+std::vector<VectorPtr> TopN::gatherPayload(const std::vector<char*>& rows) {
+  // Copies the rows of each input batch at once.
+  folly::F14FastMap<int32_t, std::vector<BaseVector::CopyRange>> ranges;
+  for (vector_size_t i = 0; i < rows.size(); ++i) {
+    const auto& source = payloadSources_.at(rows[i]);
+    ranges[source.batch].push_back({source.row, i, 1});
+  }
+  std::vector<VectorPtr> columns;
+  columns.reserve(nonKeyColumns_.size());
+  for (auto i = 0; i < nonKeyColumns_.size(); ++i) {
+    auto column = BaseVector::create(
+        outputType_->childAt(nonKeyColumns_[i]), rows.size(), pool());
+    for (const auto& [batch, batchRanges] : ranges) {
+      column->copyRanges(
+          payloadBatches_.at(batch).columns[i].get(), batchRanges);
+    }
+    columns.push_back(std::move(column));
+  }
+  return columns;
+}
+
+void TopN::compactPayload() {
+  std::vector<char*> rows;
+  rows.reserve(payloadSources_.size());
+  for (const auto& [row, source] : payloadSources_) {
+    rows.push_back(row);
+  }
+  auto columns = gatherPayload(rows);
+  payloadBatches_.clear();
+  const auto batch = nextPayloadBatch_++;
+  payloadBatches_[batch] = {
+      std::move(columns), static_cast<int32_t>(rows.size())};
+  for (vector_size_t i = 0; i < rows.size(); ++i) {
+    payloadSources_[rows[i]] = {batch, i};
+  }
 }
 
 RowVectorPtr TopN::getOutput() {
@@ -118,12 +379,26 @@ RowVectorPtr TopN::getOutput() {
   auto result = BaseVector::create<RowVector>(
       outputType_, numRowsToReturn, operatorCtx_->pool());
 
-  for (auto i = 0; i < outputType_->size(); ++i) {
-    data_->extractColumn(
-        rows_.data() + numRowsReturned_,
-        numRowsToReturn,
-        i,
-        result->childAt(i));
+  if (payload_.empty()) {
+    for (auto i = 0; i < outputType_->size(); ++i) {
+      data_->extractColumn(
+          rows_.data() + numRowsReturned_,
+          numRowsToReturn,
+          i,
+          result->childAt(i));
+    }
+  } else {
+    for (const auto col : sortingKeyColumns_) {
+      data_->extractColumn(
+          rows_.data() + numRowsReturned_,
+          numRowsToReturn,
+          col,
+          result->childAt(col));
+    }
+    for (auto i = 0; i < nonKeyColumns_.size(); ++i) {
+      result->childAt(nonKeyColumns_[i])
+          ->copy(payload_[i].get(), 0, numRowsReturned_, numRowsToReturn);
+    }
   }
   numRowsReturned_ += numRowsToReturn;
   finished_ = (numRowsReturned_ == rows_.size());
@@ -142,7 +417,18 @@ void TopN::noMoreInput() {
     topRows_.pop();
   }
 
-  outputBatchSize_ = outputBatchRows(data_->estimateRowSize());
+  auto rowSize = data_->estimateRowSize();
+  if (maxPayloadBatches_ > 0 && !nonKeyColumns_.empty()) {
+    payload_ = gatherPayload(rows_);
+    payloadBatches_.clear();
+    payloadSources_.clear();
+    if (rowSize.has_value()) {
+      for (const auto& column : payload_) {
+        rowSize.value() += column->estimateFlatSize() / rows_.size();
+      }
+    }
+  }
+  outputBatchSize_ = outputBatchRows(rowSize);
 }
 
 bool TopN::isFinished() {
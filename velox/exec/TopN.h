@@ -15,11 +15,25 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 
 namespace facebook::velox::exec {
 
+/// Keeps the top 'count' rows of the input in a heap. Once the heap is full,
+/// the first sort key of each input batch is compared with the first sort key
+/// of the top of the heap with SIMD, and only the rows which are not worse go
+/// through the full comparison. If the first sort key is an integer which an
+/// upstream TableScan can filter on, the first sort key of the top of the heap
+/// is also pushed down as a dynamic filter so that the scan drops the rows
+/// which cannot get into the heap.
+///
+/// With 'QueryConfig::kTopNLateMaterializationMaxBatches', the rows in the
+/// heap hold only the sort keys. The non-key columns stay in the input batches,
+/// which are kept while a row in the heap references them, and are copied once
+/// for the final rows.
 class TopN : public Operator {
  public:
   TopN(
@@ -27,6 +41,8 @@ class TopN : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::TopNNode>& topNNode);
 
+  void initialize() override;
+
   bool needsInput() const override {
     return !noMoreInput_;
   }
@@ -43,8 +59,43 @@ class TopN : public Operator {
 
   bool isFinished() override;
 
+  /// The number of input rows rejected by the comparison of the first sort key
+  /// with the top of the heap.
+  static inline const std::string kNumPrefilteredRows{"numPrefilteredRows"};
+
  private:
+  // Sets 'candidates_' to the rows of the input whose first sort key is not
+  // worse than the first sort key of the top of the heap. Returns false if
+  // the rows are not prefiltered, e.g. the heap is not full.
+  bool prefilter(vector_size_t numRows);
+
+  template <typename T>
+  bool prefilterValues(vector_size_t numRows, const char* topRow);
+
+  // Sets the dynamic filter on the first sort key to the values which are not
+  // worse than the top of the heap if changed since last set.
+  void updateDynamicFilter();
+
+  // Keeps the non-key columns of 'input' for the rows of the heap in
+  // 'passedRows', which maps a row of 'data_' to its row in 'input'.
+  void addPayloadBatch(
+      const RowVectorPtr& input,
+      const folly::F14FastMap<void*, vector_size_t>& passedRows);
+
+  // Drops the reference of 'row' of 'data_' to its input batch and the batch if
+  // no other row references it.
+  void releasePayload(char* row);
+
+  // Returns the non-key columns of 'rows' of 'data_' copied from their input
+  // batches, in the order of 'rows'.
+  std::vector<VectorPtr> gatherPayload(const std::vector<char*>& rows);
+
+  // Copies the non-key columns of all the rows in the heap into one batch.
+  void compactPayload();
+
   const int32_t count_;
+  const bool firstKeyAscending_;
+  const bool firstKeyNullsFirst_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
@@ -68,5 +119,37 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  SelectivityVector candidates_;
+
+  // The non-key columns of an input batch, in the order of 'nonKeyColumns_',
+  // and the number of rows of 'data_' which reference the batch.
+  struct PayloadBatch {
+    std::vector<VectorPtr> columns;
+    int32_t numRows{0};
+  };
+
+  // The input batch and the row in the batch of a row of 'data_'.
+  struct PayloadSource {
+    int32_t batch;
+    vector_size_t row;
+  };
+
+  // Maximum number of input batches kept in 'payloadBatches_'. 0 if the
+  // non-key columns are stored in 'data_'.
+  const int32_t maxPayloadBatches_;
+  folly::F14FastMap<int32_t, PayloadBatch> payloadBatches_;
+  folly::F14FastMap<char*, PayloadSource> payloadSources_;
+  int32_t nextPayloadBatch_{0};
+  // The non-key columns of 'rows_' in the order of 'rows_', set by
+  // noMoreInput() if 'maxPayloadBatches_' is not 0.
+  std::vector<VectorPtr> payload_;
+
+  // True if the first sort key can be pushed down as a dynamic filter.
+  bool canPushdownThreshold_{false};
+  // The last first sort key of the top of the heap pushed down, and true if it
+  // was null.
+  std::optional<int64_t> pushedThreshold_;
+  bool pushedNullThreshold_{false};
 };
 } // namespace facebook::velox::exec
@@ -116,6 +116,7 @@ TopNRowNumber::TopNRowNumber(
       limit_{node->limit()},
       generateRowNumber_{node->generateRowNumber()},
       numPartitionKeys_{node->partitionKeys().size()},
+      inlineRows_{numPartitionKeys_ > 0 && limit_ <= kMaxInlineRows},
       inputChannels_{reorderInputChannels(
           node->inputType(),
           node->partitionKeys(),
@@ -146,9 +147,10 @@ TopNRowNumber::TopNRowNumber(
   if (numKeys > 0) {
     Accumulator accumulator{
         true,
-        sizeof(TopRows),
-        false,
-        1,
+        static_cast<int32_t>(
+            sizeof(TopRows) + (inlineRows_ ? limit_ * sizeof(char*) : 0)),
+        !inlineRows_,
+        alignof(TopRows),
         nullptr,
         [](auto, auto) { VELOX_UNREACHABLE(); },
         [](auto) {}};
@@ -166,7 +168,7 @@ TopNRowNumber::TopNRowNumber(
     lookup_ = std::make_unique<HashLookup>(table_->hashers(), pool());
   } else {
     allocator_ = std::make_unique<HashStringAllocator>(pool());
-    singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+    singlePartition_ = std::make_unique<TopRows>();
   }
 
   if (generateRowNumber_) {
@@ -244,19 +246,21 @@ bool TopNRowNumber::abandonPartialEarly() const {
 
 void TopNRowNumber::initializeNewPartitions() {
   for (auto index : lookup_->newGroups) {
-    new (lookup_->hits[index] + partitionOffset_)
-        TopRows(table_->stringAllocator(), comparator_);
+    auto* partition =
+        new (lookup_->hits[index] + partitionOffset_) TopRows();
+    if (inlineRows_) {
+      partition->rows = reinterpret_cast<char**>(partition + 1);
+      partition->capacity = limit_;
+    }
   }
 }
 
 void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
-  auto& topRows = partition.rows;
-
   char* newRow = nullptr;
-  if (topRows.size() < limit_) {
+  if (partition.size < limit_) {
     newRow = data_->newRow();
   } else {
-    char* topRow = topRows.top();
+    char* topRow = partition.top();
 
     if (!comparator_(decodedVectors_, index, topRow)) {
       // Drop this input row.
@@ -264,7 +268,7 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     }
 
     // Replace existing row.
-    topRows.pop();
+    popRow(partition);
 
     // Reuse the topRow's memory.
     newRow = data_->initializeRow(topRow, true /* reuse */);
@@ -274,7 +278,44 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     data_->store(decodedVectors_[col], index, newRow, col);
   }
 
-  topRows.push(newRow);
+  pushRow(partition, newRow);
+}
+
+void TopNRowNumber::pushRow(TopRows& partition, char* row) {
+  if (partition.size == partition.capacity) {
+    growPartition(partition);
+  }
+  partition.rows[partition.size++] = row;
+  std::push_heap(
+      partition.rows,
+      partition.rows + partition.size,
+      [&](const char* lhs, const char* rhs) { return comparator_(lhs, rhs); });
+}
+
+char* TopNRowNumber::popRow(TopRows& partition) {
+  VELOX_DCHECK_GT(partition.size, 0);
+  std::pop_heap(
+      partition.rows,
+      partition.rows + partition.size,
+      [&](const char* lhs, const char* rhs) { return comparator_(lhs, rhs); });
+  return partition.rows[--partition.size];
+}
+
+void TopNRowNumber::growPartition(TopRows& partition) {
+  VELOX_CHECK(!inlineRows_);
+  VELOX_CHECK_LT(partition.capacity, limit_);
+  auto* allocator =
+      table_ != nullptr ? table_->stringAllocator() : allocator_.get();
+  const auto capacity = std::min<int64_t>(
+      limit_, std::max<int64_t>(kMinPartitionCapacity, 2 * partition.capacity));
+  auto* rows = reinterpret_cast<char**>(
+      allocator->allocate(capacity * sizeof(char*))->begin());
+  if (partition.rows != nullptr) {
+    std::copy(partition.rows, partition.rows + partition.size, rows);
+    allocator->free(HashStringAllocator::headerOf(partition.rows));
+  }
+  partition.rows = rows;
+  partition.capacity = capacity;
 }
 
 void TopNRowNumber::noMoreInput() {
@@ -293,7 +334,11 @@ void TopNRowNumber::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool(), &spillStats_);
+        spillConfig_->readBufferSize,
+        pool(),
+        &spillStats_,
+        spillConfig_->readAheadExecutor,
+        spillConfig_->mergeReadAheadBudget);
   } else {
     outputRows_.resize(outputBatchSize_);
   }
@@ -355,16 +400,14 @@ void TopNRowNumber::appendPartitionRows(
     vector_size_t numRows,
     vector_size_t outputOffset,
     FlatVector<int64_t>* rowNumbers) {
-  // The partition.rows priority queue pops rows in order of reverse
-  // row numbers.
-  auto rowNumber = partition.rows.size();
+  // The heap of the partition pops rows in order of reverse row numbers.
+  auto rowNumber = partition.size;
   for (auto i = 0; i < numRows; ++i) {
     const auto index = outputOffset + i;
     if (rowNumbers) {
       rowNumbers->set(index, rowNumber--);
     }
-    outputRows_[index] = partition.rows.top();
-    partition.rows.pop();
+    outputRows_[index] = popRow(partition);
   }
 }
 
@@ -434,7 +477,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
     }
 
     const auto numOutputRowsLeft = outputBatchSize_ - offset;
-    if (outputPartition_->rows.size() > numOutputRowsLeft) {
+    if (outputPartition_->size > numOutputRowsLeft) {
       // Only a partial partition can be output in this getOutput() call.
       // Output as many rows as possible.
       // NOTE: the partial output partition erases the yielded output rows
@@ -446,7 +489,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
     }
 
     // Add all partition rows.
-    auto numPartitionRows = outputPartition_->rows.size();
+    auto numPartitionRows = outputPartition_->size;
     appendPartitionRows(
         *outputPartition_, numPartitionRows, offset, rowNumbers);
     offset += numPartitionRows;
@@ -614,29 +657,11 @@ bool TopNRowNumber::isFinished() {
 void TopNRowNumber::close() {
   Operator::close();
 
-  SCOPE_EXIT {
-    table_.reset();
-    singlePartition_.reset();
-    data_.reset();
-    allocator_.reset();
-  };
-
-  if (table_ == nullptr) {
-    return;
-  }
-
-  partitionIt_.reset();
-  partitions_.resize(1'000);
-  while (auto numPartitions = table_->listAllRows(
-             &partitionIt_,
-             partitions_.size(),
-             RowContainer::kUnlimited,
-             partitions_.data())) {
-    for (auto i = 0; i < numPartitions; ++i) {
-      std::destroy_at(
-          reinterpret_cast<TopRows*>(partitions_[i] + partitionOffset_));
-    }
-  }
+  // The heaps of the partitions are freed with their allocators.
+  table_.reset();
+  singlePartition_.reset();
+  data_.reset();
+  allocator_.reset();
 }
 
 void TopNRowNumber::reclaim(
@@ -71,21 +71,19 @@ class TopNRowNumber : public Operator {
       override;
 
  private:
-  // A priority queue to keep track of top 'limit' rows for a given partition.
+  // A max heap of the top 'limit' rows of a partition: the last of these rows
+  // in the sort order is at the top. The heap of a partition in 'table_' is
+  // stored inline after this struct in the partition row if 'inlineRows_'.
+  // Otherwise, it is allocated from a HashStringAllocator and grows up to
+  // 'limit' rows.
   struct TopRows {
-    struct Compare {
-      RowComparator& comparator;
+    char** rows{nullptr};
+    int32_t size{0};
+    int32_t capacity{0};
 
-      bool operator()(const char* lhs, const char* rhs) {
-        return comparator(lhs, rhs);
-      }
-    };
-
-    std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
-        rows;
-
-    TopRows(HashStringAllocator* allocator, RowComparator& comparator)
-        : rows{{comparator}, StlAllocator<char*>(allocator)} {}
+    char* top() const {
+      return rows[0];
+    }
   };
 
   void initializeNewPartitions();
@@ -100,6 +98,15 @@ class TopNRowNumber : public Operator {
   // Adds input row to a partition or discards the row.
   void processInputRow(vector_size_t index, TopRows& partition);
 
+  // Adds 'row' to the heap of 'partition'.
+  void pushRow(TopRows& partition, char* row);
+
+  // Removes and returns the top row of 'partition'.
+  char* popRow(TopRows& partition);
+
+  // Grows the heap of 'partition' if not stored inline.
+  void growPartition(TopRows& partition);
+
   // Returns next partition to add to output or nullptr if there are no
   // partitions left.
   TopRows* nextPartition();
@@ -159,6 +166,17 @@ class TopNRowNumber : public Operator {
 
   const size_t numPartitionKeys_;
 
+  // The largest limit for which the heaps of the partitions are stored inline
+  // in the partition rows of 'table_'. Larger limits would waste the space of
+  // the partitions with fewer rows.
+  static constexpr int32_t kMaxInlineRows = 64;
+
+  // The initial capacity of a heap not stored inline.
+  static constexpr int32_t kMinPartitionCapacity = 16;
+
+  // True if the heaps of the partitions are stored inline.
+  const bool inlineRows_;
+
   // Input columns in the order of: partition keys, sorting keys, the rest.
   const std::vector<column_index_t> inputChannels_;
 
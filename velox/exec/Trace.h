@@ -29,6 +29,27 @@ struct TraceTraits {
       "connectorProperties";
 
   static inline const std::string kTaskMetaFileName = "task_trace_meta.json";
+  static inline const std::string kTaskMemoryTraceFileName =
+      "task_memory_trace.json";
+  static inline const std::string kTaskTimelineTraceFileName =
+      "task_timeline_trace.json";
+};
+
+struct TaskMemoryTraceTraits {
+  /// Keys for task memory trace file.
+  static inline const std::string kSampleIntervalMsKey = "sampleIntervalMs";
+  static inline const std::string kSamplesKey = "samples";
+  static inline const std::string kTimeMsKey = "timeMs";
+  static inline const std::string kReservedBytesKey = "reservedBytes";
+  static inline const std::string kPeaksKey = "peaks";
+  static inline const std::string kPoolKey = "pool";
+  static inline const std::string kPeakBytesKey = "peakBytes";
+  static inline const std::string kPeakTimeMsKey = "peakTimeMs";
+  static inline const std::string kMaxSampleTimeMsKey = "maxSampleTimeMs";
+  static inline const std::string kCallSitesKey = "callSites";
+  static inline const std::string kCallStackKey = "callStack";
+  static inline const std::string kBytesKey = "bytes";
+  static inline const std::string kNumAllocationsKey = "numAllocations";
 };
 
 struct OperatorTraceTraits {
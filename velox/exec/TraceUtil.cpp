@@ -88,6 +88,16 @@ std::string getTaskTraceMetaFilePath(const std::string& taskTraceDir) {
   return fmt::format("{}/{}", taskTraceDir, TraceTraits::kTaskMetaFileName);
 }
 
+std::string getTaskMemoryTraceFilePath(const std::string& taskTraceDir) {
+  return fmt::format(
+      "{}/{}", taskTraceDir, TraceTraits::kTaskMemoryTraceFileName);
+}
+
+std::string getTaskTimelineTraceFilePath(const std::string& taskTraceDir) {
+  return fmt::format(
+      "{}/{}", taskTraceDir, TraceTraits::kTaskTimelineTraceFileName);
+}
+
 std::string getNodeTraceDirectory(
     const std::string& taskTraceDir,
     const std::string& nodeId) {
@@ -50,6 +50,12 @@ std::string getTaskTraceDirectory(
 /// Returns the file path for a given task's metadata trace file.
 std::string getTaskTraceMetaFilePath(const std::string& taskTraceDir);
 
+/// Returns the file path for a given task's memory trace file.
+std::string getTaskMemoryTraceFilePath(const std::string& taskTraceDir);
+
+/// Returns the file path for a given task's timeline trace file.
+std::string getTaskTimelineTraceFilePath(const std::string& taskTraceDir);
+
 /// Returns the trace directory for a given traced plan node.
 std::string getNodeTraceDirectory(
     const std::string& taskTraceDir,
@@ -193,6 +193,17 @@ void Unnest::generateRepeatedColumns(
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
   VELOX_DCHECK_GT(range.size, 0);
+  if (range.size == 1) {
+    // A single input row, e.g. a part of a huge array, makes the whole output.
+    for (const auto& projection : identityProjections_) {
+      outputs.at(projection.outputChannel) = BaseVector::wrapInConstant(
+          range.numElements,
+          range.start,
+          input_->childAt(projection.inputChannel));
+    }
+    return;
+  }
+
   // Record the row number to process.
   range.forEachRow(
       [&](vector_size_t row, vector_size_t /*start*/, vector_size_t size) {
@@ -230,6 +241,8 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
   bool identityMapping = true;
+  std::optional<vector_size_t> sliceOffset;
+  bool contiguous = true;
   VELOX_DCHECK_GT(range.size, 0);
 
   range.forEachRow(
@@ -244,6 +257,15 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
               unnestSize < end) {
             identityMapping = false;
           }
+          if (unnestSize < end) {
+            contiguous = false;
+          } else if (size > 0) {
+            if (index == 0) {
+              sliceOffset = offset + start;
+            } else if (sliceOffset.value() + index != offset + start) {
+              contiguous = false;
+            }
+          }
           auto currentUnnestSize = std::min(end, unnestSize);
           for (auto i = start; i < currentUnnestSize; i++) {
             rawElementIndices[index++] = offset + i;
@@ -254,6 +276,7 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
           }
         } else if (size > 0) {
           identityMapping = false;
+          contiguous = false;
 
           for (auto i = start; i < end; ++i) {
             bits::setNull(rawNulls, index++, true);
@@ -263,7 +286,10 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
       rawMaxSizes_,
       firstRowStart_);
 
-  return {elementIndices, nulls, identityMapping};
+  if (!contiguous) {
+    sliceOffset.reset();
+  }
+  return {elementIndices, nulls, identityMapping, sliceOffset};
 }
 
 VectorPtr Unnest::generateOrdinalityVector(const RowRange& range) {
@@ -335,6 +361,12 @@ VectorPtr Unnest::UnnestChannelEncoding::wrap(
     return base;
   }
 
+  if (sliceOffset.has_value() &&
+      base->encoding() != VectorEncoding::Simple::BIASED &&
+      base->encoding() != VectorEncoding::Simple::FUNCTION) {
+    return base->slice(sliceOffset.value(), wrapSize);
+  }
+
   const auto result =
       BaseVector::wrapInDictionary(nulls, indices, wrapSize, base);
 
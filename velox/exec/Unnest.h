@@ -107,7 +107,8 @@ class Unnest : public Operator {
   RowVectorPtr generateOutput(const RowRange& rowRange);
 
   // Invoked by generateOutput function above to generate the repeated output
-  // columns.
+  // columns. These are dictionaries over the input columns, or constants if
+  // all the output comes from one input row.
   void generateRepeatedColumns(
       const RowRange& rowRange,
       std::vector<VectorPtr>& outputs);
@@ -117,6 +118,11 @@ class Unnest : public Operator {
     BufferPtr nulls;
     bool identityMapping;
 
+    // Set when the elements of the range are one contiguous run of the base
+    // vector starting at this offset, without null padding. The output is then
+    // a slice of the base vector instead of a copy.
+    std::optional<vector_size_t> sliceOffset;
+
     VectorPtr wrap(const VectorPtr& base, vector_size_t wrapSize) const;
   };
 
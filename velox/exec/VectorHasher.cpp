@@ -52,6 +52,18 @@ namespace facebook::velox::exec {
   }()
 
 namespace {
+// Hash of a scalar of a type without custom comparison.
+template <TypeKind Kind>
+FOLLY_ALWAYS_INLINE uint64_t
+hashScalar(typename KindToFlatVector<Kind>::HashRowType value) {
+  using T = typename KindToFlatVector<Kind>::HashRowType;
+  if constexpr (std::is_floating_point_v<T>) {
+    return util::floating_point::NaNAwareHash<T>()(value);
+  } else {
+    return folly::hasher<T>()(value);
+  }
+}
+
 template <bool typeProvidesCustomComparison, TypeKind Kind>
 uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
   if constexpr (
@@ -68,12 +80,55 @@ uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
       return static_cast<const CanProvideCustomComparisonType<Kind>*>(
                  decoded.base()->type().get())
           ->hash(value);
-    } else if constexpr (std::is_floating_point_v<T>) {
-      return util::floating_point::NaNAwareHash<T>()(value);
     } else {
-      return folly::hasher<T>()(value);
+      return hashScalar<Kind>(value);
+    }
+  }
+}
+
+// Hashes the flat keys of 'hashers' of kinds 'Kinds' for 'rows' in one pass,
+// mixing the key hashes in the order of the keys like hash() does.
+template <TypeKind... Kinds, size_t... I>
+void hashFlatKeys(
+    const std::vector<std::unique_ptr<VectorHasher>>& hashers,
+    const SelectivityVector& rows,
+    uint64_t* result,
+    std::index_sequence<I...>) {
+  const std::tuple<const typename KindToFlatVector<Kinds>::HashRowType*...>
+      keys{hashers[I]->decodedVector().template data<
+          typename KindToFlatVector<Kinds>::HashRowType>()...};
+  rows.applyToSelected([&](vector_size_t row) {
+    const uint64_t hashes[] = {hashScalar<Kinds>(std::get<I>(keys)[row])...};
+    uint64_t hash = hashes[0];
+    for (size_t i = 1; i < sizeof...(Kinds); ++i) {
+      hash = bits::hashMix(hash, hashes[i]);
+    }
+    result[row] = hash;
+  });
+}
+
+// Hashes the keys of 'hashers' with hashFlatKeys() if they are of kinds
+// 'Kinds'.
+template <TypeKind... Kinds>
+bool hashFlatKeysOf(
+    const std::vector<std::unique_ptr<VectorHasher>>& hashers,
+    const SelectivityVector& rows,
+    raw_vector<uint64_t>& result) {
+  constexpr TypeKind kKinds[] = {Kinds...};
+  if (hashers.size() != sizeof...(Kinds)) {
+    return false;
+  }
+  for (auto i = 0; i < hashers.size(); ++i) {
+    if (hashers[i]->typeKind() != kKinds[i]) {
+      return false;
     }
   }
+  hashFlatKeys<Kinds...>(
+      hashers,
+      rows,
+      result.data(),
+      std::make_index_sequence<sizeof...(Kinds)>());
+  return true;
 }
 } // namespace
 
@@ -560,6 +615,39 @@ void VectorHasher::hash(
   }
 }
 
+// static
+bool VectorHasher::hashFused(
+    const std::vector<std::unique_ptr<VectorHasher>>& hashers,
+    const SelectivityVector& rows,
+    raw_vector<uint64_t>& result) {
+  if (hashers.size() < 2 || hashers.size() > 4) {
+    return false;
+  }
+  for (const auto& hasher : hashers) {
+    const auto& decoded = hasher->decodedVector();
+    if (!decoded.isIdentityMapping() || decoded.mayHaveNulls() ||
+        hasher->type()->providesCustomComparison()) {
+      return false;
+    }
+  }
+  // The most common key shapes. DATE keys are INTEGER.
+  constexpr auto kInteger = TypeKind::INTEGER;
+  constexpr auto kBigint = TypeKind::BIGINT;
+  constexpr auto kVarchar = TypeKind::VARCHAR;
+  return hashFlatKeysOf<kBigint, kBigint>(hashers, rows, result) ||
+      hashFlatKeysOf<kBigint, kVarchar>(hashers, rows, result) ||
+      hashFlatKeysOf<kVarchar, kBigint>(hashers, rows, result) ||
+      hashFlatKeysOf<kVarchar, kVarchar>(hashers, rows, result) ||
+      hashFlatKeysOf<kInteger, kInteger>(hashers, rows, result) ||
+      hashFlatKeysOf<kBigint, kInteger>(hashers, rows, result) ||
+      hashFlatKeysOf<kInteger, kBigint>(hashers, rows, result) ||
+      hashFlatKeysOf<kBigint, kBigint, kBigint>(hashers, rows, result) ||
+      hashFlatKeysOf<kInteger, kInteger, kInteger>(hashers, rows, result) ||
+      hashFlatKeysOf<kBigint, kBigint, kVarchar>(hashers, rows, result) ||
+      hashFlatKeysOf<kBigint, kBigint, kBigint, kBigint>(
+             hashers, rows, result);
+}
+
 void VectorHasher::hashPrecomputed(
     const SelectivityVector& rows,
     bool mix,
@@ -183,6 +183,17 @@ class VectorHasher {
   void
   hash(const SelectivityVector& rows, bool mix, raw_vector<uint64_t>& result);
 
+  // Computes the hashes of 'rows' over all 'hashers' in one pass over the
+  // rows, with the same result as calling hash() on each hasher in turn. Only
+  // applies to the common key shapes of 2 to 4 flat INTEGER, BIGINT or
+  // VARCHAR keys without nulls, e.g. (BIGINT, BIGINT) or (BIGINT, VARCHAR).
+  // Returns false without changing 'result' for other keys. The hashers must
+  // have decoded their keys for 'rows'.
+  static bool hashFused(
+      const std::vector<std::unique_ptr<VectorHasher>>& hashers,
+      const SelectivityVector& rows,
+      raw_vector<uint64_t>& result);
+
   // Computes a hash for 'rows' using precomputedHash_ (just like from a const
   // vector) and stores it in 'result'.
   // If 'mix' is true, mixes the hash with existing value in 'result'.
@@ -596,12 +607,30 @@ bool VectorHasher::makeValueIdsForRows<TypeKind::VARCHAR>(
 template <>
 void VectorHasher::analyzeValue(StringView value);
 
+// Maps the strings of up to 'kStringASRangeMaxSize' bytes in one pass. These
+// are inline in the StringViews, so that the loop reads no string buffers.
 template <>
 inline bool VectorHasher::tryMapToRange(
-    const StringView* /*values*/,
-    const SelectivityVector& /*rows*/,
-    uint64_t* /*result*/) {
-  return false;
+    const StringView* values,
+    const SelectivityVector& rows,
+    uint64_t* result) {
+  bool inRange = true;
+  rows.testSelected([&](vector_size_t row) {
+    const auto& value = values[row];
+    if (value.size() > kStringASRangeMaxSize) {
+      inRange = false;
+      return false;
+    }
+    const auto number = stringAsNumber(value.data(), value.size());
+    if (number > max_ || number < min_) {
+      inRange = false;
+      return false;
+    }
+    const uint64_t id = number - min_ + 1;
+    result[row] = multiplier_ == 1 ? id : result[row] + multiplier_ * id;
+    return true;
+  });
+  return inRange;
 }
 
 template <>
@@ -678,12 +707,6 @@ inline bool VectorHasher::tryMapToRange(
   return true;
 }
 
-template <>
-bool VectorHasher::tryMapToRange(
-    const StringView* /*values*/,
-    const SelectivityVector& /*rows*/,
-    uint64_t* /*result*/);
-
 template <>
 bool VectorHasher::makeValueIdsFlatNoNulls<bool>(
     const SelectivityVector& rows,
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/Window.h"
+#include "velox/common/base/CheckedArithmetic.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/PartitionStreamingWindowBuild.h"
 #include "velox/exec/RowsStreamingWindowBuild.h"
@@ -22,6 +23,16 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+CompareFlags fromSortOrderToCompareFlags(const core::SortOrder& sortOrder) {
+  return {
+      sortOrder.isNullsFirst(),
+      sortOrder.isAscending(),
+      false,
+      CompareFlags::NullHandlingMode::kNullAsValue};
+}
+} // namespace
+
 Window::Window(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -38,7 +49,8 @@ Window::Window(
       numInputColumns_(windowNode->inputType()->size()),
       windowNode_(windowNode),
       currentPartition_(nullptr),
-      stringAllocator_(pool()) {
+      stringAllocator_(pool()),
+      inputType_(windowNode->sources()[0]->outputType()) {
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   if (spillConfig == nullptr &&
@@ -46,7 +58,36 @@ Window::Window(
     auto lockedStats = stats_.wlock();
     lockedStats->runtimeStats.emplace(kSpillNotSupported, RuntimeMetric(1));
   }
-  if (windowNode->inputsSorted()) {
+  if (driverCtx->queryConfig().windowParallelEvaluationEnabled() &&
+      spillConfig == nullptr && windowNode->partitionKeys().empty() &&
+      !windowNode->sortingKeys().empty() && !windowNode->inputsSorted()) {
+    if (auto fixups = parallelEvaluationFixups(*windowNode)) {
+      parallelEvaluation_ = true;
+      rangeFixups_ = std::move(fixups.value());
+    }
+  }
+  if (parallelEvaluation_) {
+    std::vector<column_index_t> sortColumnIndices;
+    std::vector<CompareFlags> sortCompareFlags;
+    sortColumnIndices.reserve(windowNode->sortingKeys().size());
+    sortCompareFlags.reserve(windowNode->sortingKeys().size());
+    for (auto i = 0; i < windowNode->sortingKeys().size(); ++i) {
+      sortColumnIndices.push_back(
+          exprToChannel(windowNode->sortingKeys()[i].get(), inputType_));
+      sortCompareFlags.push_back(
+          fromSortOrderToCompareFlags(windowNode->sortingOrders()[i]));
+    }
+    sortBuffer_ = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices,
+        sortCompareFlags,
+        pool(),
+        &nonReclaimableSection_,
+        driverCtx->prefixSortConfig());
+    // The sorted rows of the range of this driver form a single partition.
+    windowBuild_ = std::make_unique<PartitionStreamingWindowBuild>(
+        windowNode, pool(), nullptr, &nonReclaimableSection_);
+  } else if (windowNode->inputsSorted()) {
     if (supportRowsStreaming()) {
       windowBuild_ = std::make_unique<RowsStreamingWindowBuild>(
           windowNode_, pool(), spillConfig, &nonReclaimableSection_);
@@ -210,6 +251,39 @@ void Window::createWindowFunctions() {
   }
 }
 
+namespace {
+// Returns true if the ROWS frame 'frame' is bounded by the current row or
+// constant offsets before and after it, except that it may start at the start
+// of the partition if it does not end before the current row. These frames
+// need only a bounded number of rows around the current row, or for the
+// fixed start, the incremental aggregation of the previous rows.
+bool isBoundedRowsFrame(const core::WindowNode::Frame& frame) {
+  using BoundType = core::WindowNode::BoundType;
+  if (frame.type != core::WindowNode::WindowType::kRows) {
+    return false;
+  }
+  const auto isBounded = [](BoundType boundType,
+                            const core::TypedExprPtr& value) {
+    switch (boundType) {
+      case BoundType::kCurrentRow:
+        return true;
+      case BoundType::kPreceding:
+      case BoundType::kFollowing:
+        return core::TypedExprs::isConstant(value);
+      default:
+        return false;
+    }
+  };
+  if (!isBounded(frame.endType, frame.endValue)) {
+    return false;
+  }
+  if (frame.startType == BoundType::kUnboundedPreceding) {
+    return frame.endType != BoundType::kPreceding;
+  }
+  return isBounded(frame.startType, frame.startValue);
+}
+} // namespace
+
 bool Window::supportRowsStreaming() {
   for (const auto& windowFunction : windowNode_->windowFunctions()) {
     const auto& functionName = windowFunction.functionCall->name();
@@ -227,7 +301,8 @@ bool Window::supportRowsStreaming() {
         (frame.startType == core::WindowNode::BoundType::kUnboundedPreceding &&
          frame.endType == core::WindowNode::BoundType::kCurrentRow);
 
-    if (windowFunctionMetadata.isAggregate && !isDefaultFrame) {
+    if (windowFunctionMetadata.isAggregate && !isDefaultFrame &&
+        !isBoundedRowsFrame(frame)) {
       return false;
     }
   }
@@ -235,7 +310,76 @@ bool Window::supportRowsStreaming() {
   return true;
 }
 
+// static
+std::optional<std::vector<Window::RangeFixup>> Window::parallelEvaluationFixups(
+    const core::WindowNode& windowNode) {
+  using Kind = RangeFixup::Kind;
+  std::vector<RangeFixup> fixups;
+  fixups.reserve(windowNode.windowFunctions().size());
+  for (const auto& windowFunction : windowNode.windowFunctions()) {
+    auto name = windowFunction.functionCall->name();
+    const auto pos = name.rfind('.');
+    if (pos != std::string::npos) {
+      name = name.substr(pos + 1);
+    }
+
+    const auto& type = windowFunction.functionCall->type();
+    if (type->isDecimal()) {
+      return std::nullopt;
+    }
+    bool isInteger;
+    switch (type->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        isInteger = true;
+        break;
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+        isInteger = false;
+        break;
+      default:
+        return std::nullopt;
+    }
+
+    // The ranking functions restart at each range and are shifted by the
+    // number of rows or peer groups before it. Peers never span ranges.
+    if (name == "row_number" || name == "dense_rank") {
+      fixups.push_back({Kind::kAdd, false});
+      continue;
+    }
+    if (name == "rank") {
+      fixups.push_back({Kind::kAdd, true});
+      continue;
+    }
+
+    // The aggregates over the default frame combine with their result over
+    // all the rows before the range.
+    const auto& frame = windowFunction.frame;
+    if (windowFunction.ignoreNulls ||
+        frame.startType != core::WindowNode::BoundType::kUnboundedPreceding ||
+        frame.endType != core::WindowNode::BoundType::kCurrentRow) {
+      return std::nullopt;
+    }
+    if (name == "sum" || name == "count") {
+      fixups.push_back({Kind::kAdd, false});
+    } else if (name == "min" && isInteger) {
+      fixups.push_back({Kind::kMin, false});
+    } else if (name == "max" && isInteger) {
+      fixups.push_back({Kind::kMax, false});
+    } else {
+      return std::nullopt;
+    }
+  }
+  return fixups;
+}
+
 void Window::addInput(RowVectorPtr input) {
+  if (parallelEvaluation_) {
+    sortBuffer_->addInput(input);
+    return;
+  }
   windowBuild_->addInput(input);
   numRows_ += input->size();
 }
@@ -287,7 +431,215 @@ void Window::createPeerAndFrameBuffers() {
 
 void Window::noMoreInput() {
   Operator::noMoreInput();
+  if (parallelEvaluation_) {
+    sortBuffer_->noMoreInput();
+    noMoreParallelInput();
+    return;
+  }
+  windowBuild_->noMoreInput();
+}
+
+void Window::noMoreParallelInput() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+  SCOPE_EXIT {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  };
+
+  std::vector<Window*> windows;
+  windows.reserve(peers.size() + 1);
+  windows.push_back(this);
+  for (auto& peer : peers) {
+    auto* window = dynamic_cast<Window*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(window);
+    windows.push_back(window);
+  }
+  std::vector<std::unique_ptr<SortBuffer>> runs;
+  runs.reserve(windows.size());
+  for (auto* window : windows) {
+    runs.push_back(std::move(window->sortBuffer_));
+  }
+  const auto parallelSort =
+      std::make_shared<const ParallelSort>(std::move(runs), windows.size());
+  for (auto* window : windows) {
+    const auto range = window->operatorCtx_->driverCtx()->driverId;
+    window->rangeMerger_ =
+        std::make_unique<ParallelSort::RangeMerger>(parallelSort, range);
+    auto lockedStats = window->stats_.wlock();
+    lockedStats->addRuntimeStat(
+        kParallelEvaluationRangeRows,
+        RuntimeCounter(parallelSort->numRows(range)));
+  }
+}
+
+void Window::evaluateRange() {
+  RowVectorPtr input;
+  while (rangeMerger_->getOutput(numRowsPerOutput_, inputType_, input, pool()) !=
+         nullptr) {
+    windowBuild_->addInput(input);
+    numRows_ += input->size();
+  }
+  // Releases the sorted input of the range.
+  rangeMerger_.reset();
   windowBuild_->noMoreInput();
+
+  while (auto output = computeOutput()) {
+    rangeOutputs_.push_back(std::move(output));
+  }
+
+  const auto numFuncs = windowFunctions_.size();
+  rangeCarries_.resize(numFuncs);
+  rangePrefixes_.resize(numFuncs);
+  if (rangeOutputs_.empty()) {
+    return;
+  }
+  const auto& lastOutput = rangeOutputs_.back();
+  for (auto i = 0; i < numFuncs; ++i) {
+    const auto& result = lastOutput->childAt(numInputColumns_ + i);
+    if (rangeFixups_[i].carryNumRows) {
+      rangeCarries_[i] = BaseVector::createConstant(
+          result->type(),
+          VariantConverter::convert(
+              variant(static_cast<int64_t>(numRows_)), result->typeKind()),
+          1,
+          pool());
+    } else {
+      rangeCarries_[i] = BaseVector::create(result->type(), 1, pool());
+      rangeCarries_[i]->copy(result.get(), 0, result->size() - 1, 1);
+    }
+  }
+}
+
+void Window::noMoreRangeOutput() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+  SCOPE_EXIT {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  };
+
+  // Orders the drivers by their range.
+  std::vector<Window*> windows(peers.size() + 1);
+  windows[operatorCtx_->driverCtx()->driverId] = this;
+  for (auto& peer : peers) {
+    auto* window = dynamic_cast<Window*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(window);
+    windows[window->operatorCtx_->driverCtx()->driverId] = window;
+  }
+
+  // Each prefix is allocated from the pool of the driver that uses it.
+  const auto copyRow = [](const VectorPtr& source,
+                          memory::MemoryPool* pool) -> VectorPtr {
+    auto copy = BaseVector::create(source->type(), 1, pool);
+    copy->copy(source.get(), 0, 0, 1);
+    return copy;
+  };
+  for (auto i = 0; i < rangeFixups_.size(); ++i) {
+    VectorPtr prefix;
+    VectorPtr carry;
+    for (auto* window : windows) {
+      if (carry != nullptr) {
+        auto next = copyRow(carry, window->pool());
+        applyPrefix(rangeFixups_[i], prefix, next, window->pool());
+        prefix = std::move(next);
+      } else if (prefix != nullptr) {
+        prefix = copyRow(prefix, window->pool());
+      }
+      window->rangePrefixes_[i] = prefix;
+      carry = window->rangeCarries_[i];
+    }
+  }
+}
+
+// static
+template <typename T>
+void Window::combinePrefix(
+    const RangeFixup& fixup,
+    const VectorPtr& prefix,
+    const VectorPtr& result) {
+  const auto prefixValue = prefix->as<SimpleVector<T>>()->valueAt(0);
+  auto* flatResult = result->asFlatVector<T>();
+  VELOX_CHECK_NOT_NULL(flatResult);
+  for (vector_size_t row = 0; row < flatResult->size(); ++row) {
+    // A null aggregate has seen no non-null value in the range.
+    if (flatResult->isNullAt(row)) {
+      flatResult->set(row, prefixValue);
+      continue;
+    }
+    const auto value = flatResult->valueAtFast(row);
+    switch (fixup.kind) {
+      case RangeFixup::Kind::kAdd:
+        if constexpr (std::is_integral_v<T>) {
+          flatResult->set(row, checkedPlus<T>(value, prefixValue));
+        } else {
+          flatResult->set(row, value + prefixValue);
+        }
+        break;
+      case RangeFixup::Kind::kMin:
+        flatResult->set(row, std::min(value, prefixValue));
+        break;
+      case RangeFixup::Kind::kMax:
+        flatResult->set(row, std::max(value, prefixValue));
+        break;
+    }
+  }
+}
+
+// static
+void Window::applyPrefix(
+    const RangeFixup& fixup,
+    const VectorPtr& prefix,
+    VectorPtr& result,
+    memory::MemoryPool* pool) {
+  if (prefix == nullptr || prefix->isNullAt(0)) {
+    return;
+  }
+  BaseVector::ensureWritable(
+      SelectivityVector(result->size()), result->type(), pool, result);
+  switch (result->typeKind()) {
+    case TypeKind::TINYINT:
+      combinePrefix<int8_t>(fixup, prefix, result);
+      break;
+    case TypeKind::SMALLINT:
+      combinePrefix<int16_t>(fixup, prefix, result);
+      break;
+    case TypeKind::INTEGER:
+      combinePrefix<int32_t>(fixup, prefix, result);
+      break;
+    case TypeKind::BIGINT:
+      combinePrefix<int64_t>(fixup, prefix, result);
+      break;
+    case TypeKind::REAL:
+      combinePrefix<float>(fixup, prefix, result);
+      break;
+    case TypeKind::DOUBLE:
+      combinePrefix<double>(fixup, prefix, result);
+      break;
+    default:
+      VELOX_UNREACHABLE("Unexpected window function result type");
+  }
+}
+
+void Window::close() {
+  Operator::close();
+  sortBuffer_.reset();
+  rangeMerger_.reset();
+  rangeOutputs_.clear();
+  rangeCarries_.clear();
+  rangePrefixes_.clear();
 }
 
 void Window::callResetPartition() {
@@ -638,6 +990,11 @@ vector_size_t Window::callApplyLoop(
   while (numOutputRowsLeft > 0) {
     const auto numPartitionRows =
         currentPartition_->numRowsForProcessing(partitionOffset_);
+    if (numPartitionRows == 0 && !currentPartition_->complete()) {
+      // The frames of the next rows of a partial partition end at rows that
+      // were not added yet.
+      break;
+    }
     if (numPartitionRows <= numOutputRowsLeft) {
       // Current partition can fit completely in the output buffer.
       // So output all its rows.
@@ -680,6 +1037,42 @@ vector_size_t Window::callApplyLoop(
 }
 
 RowVectorPtr Window::getOutput() {
+  if (parallelEvaluation_) {
+    return getParallelOutput();
+  }
+  return computeOutput();
+}
+
+RowVectorPtr Window::getParallelOutput() {
+  if (finished_ || !noMoreInput_ || future_.valid()) {
+    return nullptr;
+  }
+
+  if (rangeMerger_ != nullptr) {
+    evaluateRange();
+    noMoreRangeOutput();
+    if (future_.valid()) {
+      return nullptr;
+    }
+  }
+
+  if (nextRangeOutput_ == rangeOutputs_.size()) {
+    finished_ = true;
+    rangeOutputs_.clear();
+    return nullptr;
+  }
+  auto output = std::move(rangeOutputs_[nextRangeOutput_++]);
+  for (auto i = 0; i < rangeFixups_.size(); ++i) {
+    applyPrefix(
+        rangeFixups_[i],
+        rangePrefixes_[i],
+        output->children()[numInputColumns_ + i],
+        pool());
+  }
+  return output;
+}
+
+RowVectorPtr Window::computeOutput() {
   if (numRows_ == 0) {
     return nullptr;
   }
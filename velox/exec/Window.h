@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/exec/Operator.h"
+#include "velox/exec/ParallelSort.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/WindowBuild.h"
 #include "velox/exec/WindowFunction.h"
@@ -35,6 +36,14 @@ namespace facebook::velox::exec {
 ///
 /// We will revise this algorithm in the future using a HashTable based
 /// approach pending some profiling results.
+///
+/// With 'QueryConfig::kWindowParallelEvaluationEnabled', the drivers of a
+/// Window without partition keys sort their input and split the single
+/// partition into consecutive key ranges, see ParallelSort. Each driver
+/// evaluates the window functions over one range as over a partition, waits
+/// for all the drivers to finish the evaluation and then fixes up its results
+/// with the results at the ends of the ranges before it, e.g. adds the number
+/// of rows before the range to row_number.
 class Window : public Operator {
  public:
   Window(
@@ -51,23 +60,52 @@ class Window : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
+    if (parallelEvaluation_) {
+      return !noMoreInput_;
+    }
     return !noMoreInput_ && windowBuild_->needsInput();
   }
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
+  BlockingReason isBlocked(ContinueFuture* future) override {
+    if (future_.valid()) {
+      *future = std::move(future_);
+      return BlockingReason::kWaitForProducer;
+    }
     return BlockingReason::kNotBlocked;
   }
 
   bool isFinished() override {
+    if (parallelEvaluation_) {
+      return finished_;
+    }
     return noMoreInput_ && numRows_ == numProcessedRows_;
   }
 
   void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
       override;
 
+  void close() override;
+
+  /// The number of rows of the key range of a driver with
+  /// 'QueryConfig::kWindowParallelEvaluationEnabled'.
+  static inline const std::string kParallelEvaluationRangeRows{
+      "parallelEvaluationRangeRows"};
+
  private:
+  // How the results of a window function over the key range of a driver are
+  // fixed up with the results over the ranges before it in a parallel
+  // evaluation.
+  struct RangeFixup {
+    enum class Kind { kAdd, kMin, kMax };
+    Kind kind;
+    // True if the value carried over from a range to the next ranges is the
+    // number of rows of the range, e.g. for rank. Otherwise it is the result
+    // at the last row of the range.
+    bool carryNumRows;
+  };
+
   // Used for k preceding/following frames. Index is the column index if k is a
   // column. value is used to read column values from the column index when k
   // is a column. The field constant stores constant k values.
@@ -90,9 +128,48 @@ class Window : public Operator {
 
   // Returns if a window operator support rows-wise streaming processing or not.
   // Currently we supports 'rank', 'dense_rank' and 'row_number' functions with
-  // any frame type. Also supports the agg window function with default frame.
+  // any frame type. Also supports the agg window function with default frame
+  // or a ROWS frame bounded by constant offsets.
   bool supportRowsStreaming();
 
+  // Returns the fixups of the window functions if the drivers can evaluate
+  // 'windowNode' in parallel, std::nullopt otherwise.
+  static std::optional<std::vector<RangeFixup>> parallelEvaluationFixups(
+      const core::WindowNode& windowNode);
+
+  // Returns the next output block of the window functions over the rows in
+  // 'windowBuild_'.
+  RowVectorPtr computeOutput();
+
+  // Returns the next output block of a parallel evaluation.
+  RowVectorPtr getParallelOutput();
+
+  // Splits the sorted input of all the drivers into key ranges once all the
+  // drivers have seen all their input.
+  void noMoreParallelInput();
+
+  // Evaluates the window functions over the key range of this driver into
+  // 'rangeOutputs_' and sets 'rangeCarries_'.
+  void evaluateRange();
+
+  // Sets the 'rangePrefixes_' of all the drivers once all the drivers have
+  // evaluated their key range.
+  void noMoreRangeOutput();
+
+  // Combines the window function results in 'result' with 'prefix' according
+  // to 'fixup'. A null 'prefix' leaves 'result' as is.
+  static void applyPrefix(
+      const RangeFixup& fixup,
+      const VectorPtr& prefix,
+      VectorPtr& result,
+      memory::MemoryPool* pool);
+
+  template <typename T>
+  static void combinePrefix(
+      const RangeFixup& fixup,
+      const VectorPtr& prefix,
+      const VectorPtr& result);
+
   // Creates WindowFunction and frame objects for this operator.
   void createWindowFunctions();
 
@@ -235,6 +312,38 @@ class Window : public Operator {
   // calls to computePeerBuffers they are saved here.
   vector_size_t peerStartRow_ = 0;
   vector_size_t peerEndRow_ = 0;
+
+  // The following are set for a parallel evaluation, see
+  // 'QueryConfig::kWindowParallelEvaluationEnabled'.
+  bool parallelEvaluation_{false};
+
+  // The fixup of each window function.
+  std::vector<RangeFixup> rangeFixups_;
+
+  const RowTypePtr inputType_;
+
+  // Sorts the input of this driver.
+  std::unique_ptr<SortBuffer> sortBuffer_;
+
+  // Merges the key range of this driver from the sorted inputs of all the
+  // drivers.
+  std::unique_ptr<ParallelSort::RangeMerger> rangeMerger_;
+
+  // The output blocks over the key range of this driver before the fixup and
+  // the next block to return.
+  std::vector<RowVectorPtr> rangeOutputs_;
+  size_t nextRangeOutput_{0};
+
+  // The value each window function carries over to the next ranges. Null if
+  // the range of this driver is empty.
+  std::vector<VectorPtr> rangeCarries_;
+
+  // The combined carries of the ranges before the range of this driver for
+  // each window function. Null if these ranges are empty.
+  std::vector<VectorPtr> rangePrefixes_;
+
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+  bool finished_{false};
 };
 
 } // namespace facebook::velox::exec
@@ -23,8 +23,12 @@ WindowPartition::WindowPartition(
     const std::vector<column_index_t>& inputMapping,
     const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo,
     bool partial,
-    bool complete)
+    bool complete,
+    vector_size_t numPrecedingRows,
+    vector_size_t numFollowingRows)
     : partial_(partial),
+      numPrecedingRows_(numPrecedingRows),
+      numFollowingRows_(numFollowingRows),
       data_(data),
       partition_(rows),
       complete_(complete),
@@ -43,13 +47,31 @@ WindowPartition::WindowPartition(
     const folly::Range<char**>& rows,
     const std::vector<column_index_t>& inputMapping,
     const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
-    : WindowPartition(data, rows, inputMapping, sortKeyInfo, false, true) {}
+    : WindowPartition(
+          data,
+          rows,
+          inputMapping,
+          sortKeyInfo,
+          false,
+          true,
+          /*numPrecedingRows=*/0,
+          /*numFollowingRows=*/0) {}
 
 WindowPartition::WindowPartition(
     RowContainer* data,
     const std::vector<column_index_t>& inputMapping,
-    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
-    : WindowPartition(data, {}, inputMapping, sortKeyInfo, true, false) {}
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo,
+    vector_size_t numPrecedingRows,
+    vector_size_t numFollowingRows)
+    : WindowPartition(
+          data,
+          {},
+          inputMapping,
+          sortKeyInfo,
+          true,
+          false,
+          numPrecedingRows,
+          numFollowingRows) {}
 
 void WindowPartition::addRows(const std::vector<char*>& rows) {
   checkPartial();
@@ -66,26 +88,36 @@ void WindowPartition::eraseRows(vector_size_t numRows) {
 void WindowPartition::removeProcessedRows(vector_size_t numRows) {
   checkPartial();
 
-  VELOX_CHECK_NULL(previousRow_);
-  if (complete_ && rows_.size() == numRows) {
-    eraseRows(numRows);
+  numProcessedRows_ += numRows;
+  const vector_size_t endRow = startRow_ + rows_.size();
+  VELOX_CHECK_LE(numProcessedRows_, endRow);
+  vector_size_t numRemovedRows;
+  if (complete_ && numProcessedRows_ == endRow) {
+    numRemovedRows = rows_.size();
   } else {
-    eraseRows(numRows - 1);
-    previousRow_ = rows_[numRows - 1];
+    // Keeps the last processed row for the peer group of the next row and the
+    // rows the frames of the next rows may start at.
+    const int64_t numKeptRows =
+        std::max<int64_t>(numPrecedingRows_, 1) + startRow_;
+    numRemovedRows = std::max<int64_t>(0, numProcessedRows_ - numKeptRows);
   }
 
-  rows_.erase(rows_.begin(), rows_.begin() + numRows);
+  eraseRows(numRemovedRows);
+  rows_.erase(rows_.begin(), rows_.begin() + numRemovedRows);
   partition_ = folly::Range(rows_.data(), rows_.size());
-  startRow_ += numRows;
+  startRow_ += numRemovedRows;
 }
 
 vector_size_t WindowPartition::numRowsForProcessing(
     vector_size_t partitionOffset) const {
-  if (partial_) {
-    return partition_.size();
-  } else {
-    return partition_.size() - partitionOffset;
+  const auto numRowsLeft = numRows() - partitionOffset;
+  if (partial_ && !complete_) {
+    // The rows whose frames end after the last added row must wait for more
+    // rows.
+    return std::max<int64_t>(
+        0, static_cast<int64_t>(numRowsLeft) - numFollowingRows_);
   }
+  return numRowsLeft;
 }
 
 void WindowPartition::extractColumn(
@@ -123,8 +155,9 @@ void WindowPartition::extractNulls(
     vector_size_t partitionOffset,
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
+  VELOX_CHECK_GE(partitionOffset, startRow_);
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -206,12 +239,6 @@ vector_size_t WindowPartition::findPeerRowEndIndex(
   return peerEnd;
 }
 
-void WindowPartition::removePreviousRow() {
-  VELOX_CHECK_NOT_NULL(previousRow_);
-  data_->eraseRows(folly::Range<char**>(&previousRow_, 1));
-  previousRow_ = nullptr;
-}
-
 std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
     vector_size_t start,
     vector_size_t end,
@@ -223,20 +250,20 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
     return compareRowsWithSortKeys(lhs, rhs);
   };
 
-  VELOX_CHECK_LE(end, numRows() + startRow_);
+  VELOX_CHECK_LE(end, numRows());
 
-  auto lastPartitionRow = numRows() + startRow_ - 1;
+  auto lastPartitionRow = numRows() - 1;
   auto peerStart = prevPeerStart;
   auto peerEnd = prevPeerEnd;
 
   size_t next = start;
   size_t index{0};
   if (partial_ && start > 0) {
-    const auto peerGroup = peerCompare(previousRow_, partition_[0]);
-
-    // The first row is the last row in previous batch so delete it after used
-    // for the first peer group detection.
-    removePreviousRow();
+    // The last row of the previous batch is kept for the first peer group
+    // detection.
+    VELOX_CHECK_GT(start, startRow_);
+    const auto peerGroup = peerCompare(
+        partition_[start - startRow_ - 1], partition_[start - startRow_]);
 
     if (!peerGroup) {
       peerEnd = findPeerRowEndIndex(start, lastPartitionRow, peerCompare);
@@ -49,29 +49,45 @@ class WindowPartition {
 
   /// The WindowPartition is used for RowStreamingWindowBuild which allows to
   /// start data processing with a subset of partition rows. 'partial_' flag is
-  /// set for the constructed window partition.
+  /// set for the constructed window partition. 'numPrecedingRows' and
+  /// 'numFollowingRows' are the max number of rows before and after the
+  /// current row that the frames of the window functions refer to. The rows
+  /// before are kept after they were processed, the current row is processed
+  /// only after the rows after it were added or the partition is complete.
   WindowPartition(
       RowContainer* data,
       const std::vector<column_index_t>& inputMapping,
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
-          sortKeyInfo);
+          sortKeyInfo,
+      vector_size_t numPrecedingRows = 0,
+      vector_size_t numFollowingRows = 0);
 
   /// Adds remaining input 'rows' for a partial window partition.
   void addRows(const std::vector<char*>& rows);
 
-  /// Removes the first 'numRows' in 'rows_' from a partial window partition
-  /// after been processed.
+  /// Marks the next 'numRows' rows of a partial window partition as processed
+  /// and removes the processed rows that no frame or peer group of the next
+  /// rows refers to.
   void removeProcessedRows(vector_size_t numRows);
 
-  /// Returns the number of rows in the current WindowPartition.
+  /// Returns the number of rows in the current WindowPartition. For a partial
+  /// window partition, this is the number of rows added so far, including the
+  /// removed rows.
   vector_size_t numRows() const {
-    return partition_.size();
+    return startRow_ + partition_.size();
   }
 
   /// Returns the number of rows in a window partition remaining for data
   /// processing.
   vector_size_t numRowsForProcessing(vector_size_t partitionOffset) const;
 
+  /// Returns true if a partial window partition has rows that were not
+  /// processed yet.
+  bool hasUnprocessedRows() const {
+    checkPartial();
+    return numRows() > numProcessedRows_;
+  }
+
   bool complete() const {
     return complete_;
   }
@@ -179,7 +195,9 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo,
       bool partial,
-      bool complete);
+      bool complete,
+      vector_size_t numPrecedingRows,
+      vector_size_t numFollowingRows);
 
   bool compareRowsWithSortKeys(const char* lhs, const char* rhs) const;
 
@@ -196,9 +214,6 @@ class WindowPartition {
     VELOX_CHECK(partial_, "WindowPartition should be partial");
   }
 
-  // Removes the previous row from 'data_'.
-  void removePreviousRow();
-
   // Searches for 'currentRow[frameColumn]' in 'orderByColumn' of rows between
   // 'start' and 'end' in the partition. 'firstMatch' specifies if first or last
   // row is matched.
@@ -242,6 +257,14 @@ class WindowPartition {
   // processing.
   const bool partial_;
 
+  // The number of processed rows a partial partition keeps for the frames of
+  // the next rows.
+  const vector_size_t numPrecedingRows_;
+
+  // The number of rows after a row that a partial partition needs before the
+  // row is processed.
+  const vector_size_t numFollowingRows_;
+
   // The RowContainer associated with the partition.
   // It is owned by the WindowBuild that creates the partition.
   RowContainer* const data_;
@@ -282,9 +305,9 @@ class WindowPartition {
   // non-partial partition.
   vector_size_t startRow_{0};
 
-  // Points to the last row from the previous processed peer group if not null.
-  // This is only set for a partial window partition and always null for a
-  // non-partial one.
-  char* previousRow_{nullptr};
+  // The number of processed rows of a partial partition. The rows from
+  // 'startRow_' to 'numProcessedRows_' are kept for the frames and the peer
+  // group of the next rows.
+  vector_size_t numProcessedRows_{0};
 };
 } // namespace facebook::velox::exec
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/WorkStealingExecutor.h"
+
+#include <fstream>
+
+#include <folly/String.h>
+#include <folly/system/ThreadName.h>
+
+#include "velox/common/base/Exceptions.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace facebook::velox::exec {
+namespace {
+// The executor and the worker which run on the calling thread.
+thread_local const WorkStealingExecutor* currentExecutor{nullptr};
+thread_local int32_t currentWorkerIndex{-1};
+
+// Returns the cpus of NUMA 'node' from sysfs, e.g. "0-15,32-47", or an empty
+// list if not known.
+std::vector<int32_t> nodeCpus(int32_t node) {
+  std::ifstream in(fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+  std::string cpuList;
+  if (!std::getline(in, cpuList)) {
+    return {};
+  }
+  std::vector<int32_t> cpus;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(cpuList), ranges, true);
+  for (const auto& range : ranges) {
+    folly::StringPiece first;
+    folly::StringPiece last;
+    if (!folly::split('-', range, first, last)) {
+      first = last = range;
+    }
+    const auto begin = folly::tryTo<int32_t>(first);
+    const auto end = folly::tryTo<int32_t>(last);
+    if (!begin.hasValue() || !end.hasValue()) {
+      return {};
+    }
+    for (auto cpu = begin.value(); cpu <= end.value(); ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+// Pins the calling thread to the cpus of NUMA 'node' if known.
+void pinToNode(int32_t node) {
+#ifdef __linux__
+  const auto cpus = nodeCpus(node);
+  if (cpus.empty()) {
+    return;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0) {
+    LOG(WARNING) << "Failed to pin the worker thread to NUMA node " << node;
+  }
+#endif
+}
+} // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(
+    int32_t numThreads,
+    const std::string& threadNamePrefix,
+    int32_t numNodes)
+    : numNodes_(numNodes) {
+  VELOX_CHECK_GT(numThreads, 0);
+  VELOX_CHECK_GT(numNodes_, 0);
+  VELOX_CHECK_LE(numNodes_, numThreads);
+  workers_.reserve(numThreads);
+  for (auto node = 0; node < numNodes_; ++node) {
+    nodeFirstWorker_.push_back(workers_.size());
+    nextNodeWorker_.push_back(std::make_unique<std::atomic_uint32_t>(0));
+    const auto end = static_cast<int64_t>(numThreads) * (node + 1) / numNodes_;
+    while (workers_.size() < end) {
+      workers_.push_back(std::make_unique<Worker>(node));
+    }
+  }
+  nodeFirstWorker_.push_back(workers_.size());
+  for (auto i = 0; i < numThreads; ++i) {
+    workers_[i]->thread = std::thread([this, i, threadNamePrefix]() {
+      folly::setThreadName(fmt::format("{}{}", threadNamePrefix, i));
+      if (numNodes_ > 1) {
+        pinToNode(workers_[i]->node);
+      }
+      run(i);
+    });
+  }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  {
+    std::lock_guard<std::mutex> l(idleMutex_);
+    stopped_ = true;
+  }
+  idleCv_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void WorkStealingExecutor::add(folly::Func func) {
+  add(std::move(func), -1);
+}
+
+void WorkStealingExecutor::add(
+    folly::Func func,
+    int32_t worker,
+    uint64_t virtualTimeNs) {
+  if (worker < 0 || worker >= workers_.size()) {
+    worker = currentWorker();
+    if (worker < 0) {
+      worker = nextWorker_++ % workers_.size();
+    }
+  }
+  {
+    std::lock_guard<std::mutex> l(workers_[worker]->mutex);
+    workers_[worker]->queue.push_back({std::move(func), virtualTimeNs});
+  }
+  {
+    std::lock_guard<std::mutex> l(idleMutex_);
+    ++numQueued_;
+  }
+  idleCv_.notify_one();
+}
+
+int32_t WorkStealingExecutor::nextWorker(int32_t node) {
+  VELOX_CHECK_GE(node, 0);
+  VELOX_CHECK_LT(node, numNodes_);
+  const auto numNodeWorkers =
+      nodeFirstWorker_[node + 1] - nodeFirstWorker_[node];
+  return nodeFirstWorker_[node] +
+      (*nextNodeWorker_[node])++ % numNodeWorkers;
+}
+
+int32_t WorkStealingExecutor::currentWorker() const {
+  return currentExecutor == this ? currentWorkerIndex : -1;
+}
+
+WorkStealingExecutor::Stats WorkStealingExecutor::stats() const {
+  Stats stats;
+  stats.numRuns = numRuns_;
+  stats.numSteals = numSteals_;
+  stats.numCrossNodeSteals = numCrossNodeSteals_;
+  return stats;
+}
+
+bool WorkStealingExecutor::next(int32_t worker, folly::Func& func) {
+  {
+    auto& own = *workers_[worker];
+    std::lock_guard<std::mutex> l(own.mutex);
+    if (!own.queue.empty()) {
+      // The queue is short, about the number of drivers of the worker, so a
+      // scan is cheaper than keeping a heap.
+      auto it = own.queue.begin();
+      for (auto other = it + 1; other != own.queue.end(); ++other) {
+        if (other->virtualTimeNs < it->virtualTimeNs) {
+          it = other;
+        }
+      }
+      func = std::move(it->func);
+      own.queue.erase(it);
+      return true;
+    }
+  }
+  // Steal from the back of the other queues, i.e. the functions which were
+  // added last. The workers of the same node come first.
+  const auto node = workers_[worker]->node;
+  for (auto crossNode : {false, true}) {
+    for (auto i = 1; i < workers_.size(); ++i) {
+      auto& other = *workers_[(worker + i) % workers_.size()];
+      if ((other.node != node) != crossNode) {
+        continue;
+      }
+      std::lock_guard<std::mutex> l(other.mutex);
+      if (!other.queue.empty()) {
+        func = std::move(other.queue.back().func);
+        other.queue.pop_back();
+        ++numSteals_;
+        if (crossNode) {
+          ++numCrossNodeSteals_;
+        }
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void WorkStealingExecutor::run(int32_t worker) {
+  currentExecutor = this;
+  currentWorkerIndex = worker;
+  for (;;) {
+    folly::Func func;
+    if (next(worker, func)) {
+      --numQueued_;
+      ++numRuns_;
+      try {
+        func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "Function run by worker " << worker
+                   << " threw: " << e.what();
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> l(idleMutex_);
+    idleCv_.wait(l, [&]() { return numQueued_ > 0 || stopped_; });
+    if (numQueued_ == 0 && stopped_) {
+      return;
+    }
+  }
+}
+} // namespace facebook::velox::exec
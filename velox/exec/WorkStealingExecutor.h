@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <folly/Executor.h>
+
+namespace facebook::velox::exec {
+
+/// An executor for running drivers on a fixed number of worker threads which
+/// each have their own queue. A worker runs the functions in its own queue in
+/// the order of their virtual time, FIFO among the same virtual time, and
+/// steals from the back of the other queues when its own queue is empty.
+/// Driver::enqueue() adds a driver to the queue of the worker which last ran
+/// it so that the driver keeps its state in the caches of the same core. The
+/// virtual time of a driver is the cpu time of its query divided by the weight
+/// of the query, see 'QueryConfig::kQueryCpuShareWeight'. A driver which
+/// yields at the end of its cpu time slice, see
+/// 'QueryConfig::kDriverCpuTimeSliceLimitMs', goes behind the drivers of its
+/// own query and of the queries which got less cpu time for their weight, so
+/// that the queries share the workers in proportion to their weights. A
+/// function added without a preferred worker goes to the queue of the calling
+/// worker, or to the queues in round-robin if not called from a worker of this
+/// executor.
+///
+/// The workers can be split into NUMA nodes. The workers of a node are pinned
+/// to the cpus of the node on Linux, and steal from the workers of their own
+/// node before the workers of the other nodes. Task::start() places a task
+/// whose drivers fit in the workers of one node on that node, so that the
+/// memory its drivers first touch, e.g. its hash tables, is local to the node
+/// for its lifetime.
+class WorkStealingExecutor : public folly::Executor {
+ public:
+  struct Stats {
+    /// The number of functions run.
+    uint64_t numRuns{0};
+    /// The number of functions run by a worker which stole them from the
+    /// queue of another worker.
+    uint64_t numSteals{0};
+    /// The number of steals from the queue of a worker on another node.
+    uint64_t numCrossNodeSteals{0};
+  };
+
+  /// Creates 'numThreads' workers split evenly into 'numNodes' NUMA nodes.
+  explicit WorkStealingExecutor(
+      int32_t numThreads,
+      const std::string& threadNamePrefix = "WorkStealing",
+      int32_t numNodes = 1);
+
+  /// Runs the queued functions and joins the worker threads.
+  ~WorkStealingExecutor() override;
+
+  void add(folly::Func func) override;
+
+  /// Adds 'func' to the queue of 'worker' with 'virtualTimeNs'. Adds to the
+  /// queue add(func) would if 'worker' is not a worker of this executor, e.g.
+  /// -1. The functions added without a virtual time have virtual time 0.
+  void add(folly::Func func, int32_t worker, uint64_t virtualTimeNs = 0);
+
+  /// Returns the worker of this executor which runs on the calling thread, or
+  /// -1 if the calling thread is not a worker of this executor.
+  int32_t currentWorker() const;
+
+  int32_t numThreads() const {
+    return workers_.size();
+  }
+
+  int32_t numNodes() const {
+    return numNodes_;
+  }
+
+  /// Returns the number of workers of the node with the fewest workers.
+  int32_t minThreadsPerNode() const {
+    return workers_.size() / numNodes_;
+  }
+
+  /// Returns the NUMA node of 'worker'.
+  int32_t nodeOf(int32_t worker) const {
+    return workers_[worker]->node;
+  }
+
+  /// Returns the node to place the next task on, in round-robin.
+  int32_t nextNode() {
+    return nextNode_++ % numNodes_;
+  }
+
+  /// Returns a worker of 'node', in round-robin among its workers.
+  int32_t nextWorker(int32_t node);
+
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    folly::Func func;
+    uint64_t virtualTimeNs;
+  };
+
+  struct Worker {
+    explicit Worker(int32_t _node) : node(_node) {}
+
+    const int32_t node;
+    std::mutex mutex;
+    std::deque<Entry> queue;
+    std::thread thread;
+  };
+
+  void run(int32_t worker);
+
+  // Sets 'func' to the next function for 'worker' to run from its own queue
+  // or from the queue of another worker. Returns false if all the queues are
+  // empty.
+  bool next(int32_t worker, folly::Func& func);
+
+  const int32_t numNodes_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // The first worker of each node and one past the last worker of the last
+  // node. The workers of a node are consecutive.
+  std::vector<int32_t> nodeFirstWorker_;
+
+  // The next worker to add a function without a preferred worker to.
+  std::atomic_uint32_t nextWorker_{0};
+  // The next node to place a task on and the next worker of each node.
+  std::atomic_uint32_t nextNode_{0};
+  std::vector<std::unique_ptr<std::atomic_uint32_t>> nextNodeWorker_;
+
+  // Idle workers wait on 'idleCv_' for 'numQueued_' to become positive or for
+  // 'stopped_'. 'numQueued_' is incremented and 'stopped_' set under
+  // 'idleMutex_' so that the workers don't miss the wake up.
+  std::mutex idleMutex_;
+  std::condition_variable idleCv_;
+  std::atomic_int64_t numQueued_{0};
+  bool stopped_{false};
+
+  std::atomic_uint64_t numRuns_{0};
+  std::atomic_uint64_t numSteals_{0};
+  std::atomic_uint64_t numCrossNodeSteals_{0};
+};
+} // namespace facebook::velox::exec
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/connectors/tpch/TpchConnector.h"
+#include "velox/connectors/tpch/TpchConnectorSplit.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/exec/WorkStealingExecutor.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+
+DEFINE_int32(num_threads, 8, "Number of executor threads");
+DEFINE_int32(num_queries, 64, "Number of queries run concurrently");
+DEFINE_int32(num_drivers, 4, "Number of drivers per query");
+DEFINE_int32(
+    driver_cpu_time_slice_limit_ms,
+    10,
+    "Driver cpu time slice of each query, 0 for no limit");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+// Runs many small TPC-H queries concurrently to compare the schedulers of
+// their drivers. Each query scans a few splits of lineitem and aggregates it,
+// so that the drivers are short-lived, yield often with a cpu time slice and
+// compete for the executor threads.
+class DriverSchedulerBenchmark {
+ public:
+  DriverSchedulerBenchmark() {
+    pool_ = memory::memoryManager()->addLeafPool("DriverSchedulerBenchmark");
+    plan_ = PlanBuilder()
+                .tpchTableScan(
+                    tpch::Table::TBL_LINEITEM,
+                    {"l_returnflag", "l_linestatus", "l_quantity"},
+                    0.01)
+                .partialAggregation(
+                    {"l_returnflag", "l_linestatus"},
+                    {"sum(l_quantity)", "count(1)"})
+                .localPartition({"l_returnflag", "l_linestatus"})
+                .finalAggregation()
+                .planNode();
+  }
+
+  void run(folly::Executor* executor) {
+    std::vector<std::thread> threads;
+    threads.reserve(FLAGS_num_queries);
+    for (auto i = 0; i < FLAGS_num_queries; ++i) {
+      threads.emplace_back([&, i]() { runQuery(executor, i); });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+ private:
+  void runQuery(folly::Executor* executor, int32_t query) {
+    std::vector<Split> splits;
+    constexpr int32_t kNumSplits = 8;
+    for (auto i = 0; i < kNumSplits; ++i) {
+      splits.emplace_back(std::make_shared<connector::tpch::TpchConnectorSplit>(
+          std::string(PlanBuilder::kTpchDefaultConnectorId), kNumSplits, i));
+    }
+    auto queryCtx = core::QueryCtx::create(
+        executor,
+        core::QueryConfig({
+            {core::QueryConfig::kDriverCpuTimeSliceLimitMs,
+             std::to_string(FLAGS_driver_cpu_time_slice_limit_ms)},
+        }),
+        {},
+        cache::AsyncDataCache::getInstance(),
+        nullptr,
+        nullptr,
+        fmt::format("DriverSchedulerBenchmark{}", query));
+    AssertQueryBuilder(plan_)
+        .queryCtx(queryCtx)
+        .maxDrivers(FLAGS_num_drivers)
+        .splits(std::move(splits))
+        .copyResults(pool_.get());
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+  core::PlanNodePtr plan_;
+};
+
+std::unique_ptr<DriverSchedulerBenchmark> benchmark;
+
+BENCHMARK(cpuThreadPoolExecutor) {
+  folly::BenchmarkSuspender suspender;
+  folly::CPUThreadPoolExecutor executor(FLAGS_num_threads);
+  suspender.dismiss();
+  benchmark->run(&executor);
+}
+
+BENCHMARK_RELATIVE(workStealingExecutor) {
+  folly::BenchmarkSuspender suspender;
+  WorkStealingExecutor executor(FLAGS_num_threads);
+  suspender.dismiss();
+  benchmark->run(&executor);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  memory::initializeMemoryManager(memory::MemoryManager::Options{});
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+  connector::registerConnectorFactory(
+      std::make_shared<connector::tpch::TpchConnectorFactory>());
+  connector::registerConnector(
+      connector::getConnectorFactory(
+          connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+          ->newConnector(
+              std::string(PlanBuilder::kTpchDefaultConnectorId),
+              std::make_shared<config::ConfigBase>(
+                  std::unordered_map<std::string, std::string>())));
+
+  benchmark = std::make_unique<DriverSchedulerBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+
+  connector::unregisterConnector(
+      std::string(PlanBuilder::kTpchDefaultConnectorId));
+  connector::unregisterConnectorFactory(
+      connector::tpch::TpchConnectorFactory::kTpchConnectorName);
+  return 0;
+}
@@ -41,6 +41,10 @@ DEFINE_int64(
     "task-wide buffer in local exchange");
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
 DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
+DEFINE_int32(
+    max_sweep_width,
+    256,
+    "Max number of parties in the shuffles sweeping the number of destinations");
 // Add the following definitions to allow Clion runs
 DEFINE_bool(gtest_color, false, "");
 DEFINE_string(gtest_filter, "*", "");
@@ -325,6 +329,14 @@ class ExchangeBenchmark : public VectorTestBase {
     };
   }
 
+  /// Sets PartitionedOutput to group the rows by partition before serializing
+  /// them if 'columnar', or to serialize the rows per destination otherwise.
+  void setColumnarPartition(bool columnar) {
+    configSettings_
+        [core::QueryConfig::kShuffleColumnarPartitionMinDestinations] =
+            columnar ? "1" : "0";
+  }
+
  private:
   static constexpr int64_t kMaxMemory = 6UL << 30; // 6GB
 
@@ -509,6 +521,37 @@ void runBenchmarks() {
     return 1;
   });
 
+  // Sweeps the number of destinations of PartitionedOutput with and without
+  // grouping the rows by partition.
+  std::vector<RowVectorPtr> flat10kSweep(
+      bm->makeRows(flatType, 2, 10000, FLAGS_dict_pct));
+  int64_t sweepWallUs;
+  PlanNodeStats partitionedOutputStatsSweep;
+  PlanNodeStats exchangeStatsSweep;
+  for (auto width = 16; width <= FLAGS_max_sweep_width; width *= 4) {
+    for (auto columnar : {false, true}) {
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format(
+              "{}exchangeFlat10kWidth{}{}",
+              columnar ? "%" : "",
+              width,
+              columnar ? "Columnar" : ""),
+          [&, width, columnar]() {
+            bm->setColumnarPartition(columnar);
+            bm->run(
+                flat10kSweep,
+                width,
+                1,
+                sweepWallUs,
+                partitionedOutputStatsSweep,
+                exchangeStatsSweep);
+            bm->setColumnarPartition(false);
+            return 1;
+          });
+    }
+  }
+
   int64_t localPartitionWallUs;
   PlanNodeStats localPartitionStatsFlat10K;
   LocalPartitionWaitStats localPartitionWaitStats;
@@ -21,8 +21,20 @@
 #include <folly/Benchmark.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
+#include <gflags/gflags.h>
 #include <iostream>
 
+DEFINE_uint64(
+    radix_partition_bytes,
+    1 << 20,
+    "Target size of a radix partition of the join table in the radix "
+    "partitioned benchmark cases");
+DEFINE_int64(
+    radix_max_build_rows,
+    100'000'000,
+    "Max number of build rows in the radix partitioned benchmark cases. The "
+    "cases scale by 10x from 10M rows up to this");
+
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::test;
@@ -44,13 +56,15 @@ struct HashTableBenchmarkParams {
       int64_t probeSize,
       const std::vector<std::pair<int32_t, int32_t>>&
           keyRepeatTimesDistribution,
-      bool runErase)
+      bool runErase,
+      uint64_t radixPartitionBytes = 0)
       : mode{mode},
         buildType{buildType},
         hashTableSize{hashTableSize},
         probeSize{probeSize},
         keyRepeatTimesDistribution{keyRepeatTimesDistribution},
-        runErase{runErase} {
+        runErase{runErase},
+        radixPartitionBytes{radixPartitionBytes} {
     int32_t distSum = 0;
     buildSize = 0;
     buildKeyRepeat.reserve(keyRepeatTimesDistribution.size());
@@ -93,6 +107,10 @@ struct HashTableBenchmarkParams {
     if (runErase) {
       title += ",withErase";
     }
+    if (radixPartitionBytes > 0) {
+      title += fmt::format(
+          ",build:{},radix:{}", hashTableSize, succinctBytes(radixPartitionBytes));
+    }
   }
 
   // Expected mode.
@@ -113,6 +131,10 @@ struct HashTableBenchmarkParams {
 
   bool runErase;
 
+  // Target size of a radix partition of the join table. 0 means the table is
+  // not radix partitioned.
+  uint64_t radixPartitionBytes{0};
+
   // Title for reporting
   std::string title;
 
@@ -141,12 +163,13 @@ struct HashTableBenchmarkParams {
       distStr << fmt::format("{}%:{}; ", dist.first, dist.second);
     }
     return fmt::format(
-        "HashTableSize:{}, BuildInputSize:{}, ProbeInputSize:{}, ExpectHashMode:{}, KeyRepeatTimesDistribution: {}",
+        "HashTableSize:{}, BuildInputSize:{}, ProbeInputSize:{}, ExpectHashMode:{}, KeyRepeatTimesDistribution: {}, RadixPartitionBytes: {}",
         hashTableSize,
         buildSize,
         probeSize,
         BaseHashTable::modeString(mode),
-        distStr.str());
+        distStr.str(),
+        radixPartitionBytes);
   }
 };
 
@@ -385,6 +408,7 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
         otherTables.push_back(std::move(table));
       }
     }
+    topTable_->setRadixPartitionBytes(params_.radixPartitionBytes);
     uint64_t buildClocks{0};
     {
       ClockTimer timer(buildClocks);
@@ -579,6 +603,25 @@ int main(int argc, char** argv) {
     }
   }
 
+  // Compares radix partitioned and non-partitioned kHash tables too large to be
+  // cache resident. Each pair of cases has the same build and probe rows.
+  for (int64_t buildRows = 10'000'000; buildRows <= FLAGS_radix_max_build_rows;
+       buildRows *= 10) {
+    for (auto radixPartitionBytes : {0UL, FLAGS_radix_partition_bytes}) {
+      params.emplace_back(HashTableBenchmarkParams(
+          BaseHashTable::HashMode::kHash,
+          onlyKeyType,
+          buildRows,
+          buildRows,
+          {{100, 0}},
+          false,
+          radixPartitionBytes));
+      if (radixPartitionBytes == 0) {
+        params.back().title += fmt::format(",build:{},radix:none", buildRows);
+      }
+    }
+  }
+
   for (auto& param : params) {
     folly::addBenchmark(__FILE__, param.title, [param, &bm, &results]() {
       combineResults(results, bm->run(param));
@@ -17,6 +17,7 @@
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
@@ -114,13 +115,27 @@ struct HashTableBenchmarkRun {
   // The mode of the table.
   BaseHashTable::HashMode hashMode;
 
+  // Probed rows per second of probe time on one thread.
+  float probesPerSecond{0};
+
+  // Clocks and probes per second with the row at a time probe for
+  // kNormalizedKey mode, if applicable. The default is the batched probe.
+  float rowProbeClocks{-1};
+  float rowProbesPerSecond{0};
+
   // Clocks for same operation with F14FastSet if applicable.
   float f14ProbeClocks{-1};
 
   std::string toString() const {
     std::stringstream out;
     out << params.toString();
-    out << " hash/row=" << hashClocks << " probe clocks=" << probeClocks;
+    out << " hash/row=" << hashClocks << " probe clocks=" << probeClocks
+        << " probes/s=" << probesPerSecond;
+    if (rowProbeClocks != -1) {
+      out << " rowProbe=" << rowProbeClocks
+          << " rowProbes/s=" << rowProbesPerSecond << " ("
+          << (100 * rowProbeClocks / probeClocks) << "%)";
+    }
     if (f14ProbeClocks != -1) {
       out << " f14Probe=" << f14ProbeClocks << " ("
           << (100 * f14ProbeClocks / probeClocks) << "%)";
@@ -229,9 +244,15 @@ class HashTableBenchmark : public VectorTestBase {
     testProbe();
     result.hashClocks = hashClocksPerRow_;
     result.probeClocks = clocksPerRow_;
+    result.probesPerSecond = probesPerSecond_;
     result.hashMode = topTable_->hashMode();
     result.numDistinct = topTable_->numDistinct();
     if (topTable_->hashMode() == BaseHashTable::HashMode::kNormalizedKey) {
+      topTable_->testingSetBatchedNormalizedKeyProbe(false);
+      testProbe();
+      topTable_->testingSetBatchedNormalizedKeyProbe(true);
+      result.rowProbeClocks = clocksPerRow_;
+      result.rowProbesPerSecond = probesPerSecond_;
       testF14Probe();
       result.f14ProbeClocks = clocksPerRow_;
     }
@@ -426,6 +447,7 @@ class HashTableBenchmark : public VectorTestBase {
     int32_t numHashed = 0;
     int32_t numProbed = 0;
     int32_t numHit = 0;
+    uint64_t probeNanos = 0;
     auto& hashers = topTable_->hashers();
     VectorHasher::ScratchMemory scratchMemory;
     for (auto batchIndex = 0; batchIndex < batches_.size(); ++batchIndex) {
@@ -468,6 +490,7 @@ class HashTableBenchmark : public VectorTestBase {
         {
           numProbed += lookup->rows.size();
           SelectivityTimer timer(probeTime, 0);
+          NanosecondTimer nanoTimer(&probeNanos);
           topTable_->joinProbe(*lookup);
         }
         for (auto i = 0; i < lookup->rows.size(); ++i) {
@@ -480,6 +503,8 @@ class HashTableBenchmark : public VectorTestBase {
     hashClocksPerRow_ = hashTime.timeToDropValue() / numHashed;
 
     clocksPerRow_ = probeTime.timeToDropValue() / numProbed;
+    probesPerSecond_ =
+        probeNanos == 0 ? 0 : numProbed * 1'000'000'000.0 / probeNanos;
 
     std::cout
         << fmt::format(
@@ -588,6 +613,7 @@ class HashTableBenchmark : public VectorTestBase {
   // Timing set by test*Probe().
   float hashClocksPerRow_{0};
   float clocksPerRow_{0};
+  float probesPerSecond_{0};
 
   // hasher and comparer for F14 comparison test.
   struct F14TestHasher {
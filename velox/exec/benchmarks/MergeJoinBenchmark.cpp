@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include "velox/common/memory/Memory.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace facebook::velox::exec {
+namespace {
+
+struct BenchmarkParams {
+  // Number of rows on each side.
+  int32_t numRows;
+  // Every 'leftStride'-th key value appears on the left side.
+  int32_t leftStride;
+  // Number of consecutive rows with the same key on the right side.
+  int32_t rightDuplicates;
+};
+
+// Benchmark for merge join with different match ratios. Both sides have an
+// integer key and a payload column. The left keys are multiples of
+// 'leftStride', so the right side skips all but one in 'leftStride' keys. With
+// 'rightDuplicates' of 1 the matches are one to one, otherwise each left row
+// matches a run of right rows.
+class MergeJoinBenchmark : public VectorTestBase {
+ public:
+  void makeBenchmark(core::JoinType joinType, const BenchmarkParams& params) {
+    auto plan = std::make_unique<core::PlanNodePtr>();
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    *plan = exec::test::PlanBuilder(planNodeIdGenerator)
+                .values(makeData(params.numRows, params.leftStride, 1, "t"))
+                .mergeJoin(
+                    {"t_k"},
+                    {"u_k"},
+                    exec::test::PlanBuilder(planNodeIdGenerator)
+                        .values(makeData(
+                            params.numRows, 1, params.rightDuplicates, "u"))
+                        .planNode(),
+                    "",
+                    core::isLeftSemiFilterJoin(joinType)
+                        ? std::vector<std::string>{"t_k", "t_p"}
+                        : std::vector<std::string>{"t_k", "t_p", "u_p"},
+                    joinType)
+                .planNode();
+
+    const auto name = fmt::format(
+        "{}_1_in_{}_x{}",
+        core::joinTypeName(joinType),
+        params.leftStride,
+        params.rightDuplicates);
+
+    folly::addBenchmark(__FILE__, name, [plan = plan.get()]() {
+      std::shared_ptr<Task> task;
+      exec::test::AssertQueryBuilder(*plan)
+          .serialExecution(true)
+          .runWithoutResults(task);
+      return 1;
+    });
+    plans_.push_back(std::move(plan));
+  }
+
+  void makeBenchmarks(core::JoinType joinType) {
+    for (auto leftStride : {1, 10, 1'000}) {
+      for (auto rightDuplicates : {1, 4}) {
+        makeBenchmark(
+            joinType,
+            {.numRows = 1'000'000,
+             .leftStride = leftStride,
+             .rightDuplicates = rightDuplicates});
+      }
+    }
+  }
+
+ private:
+  // Makes 'numRows' rows with keys 0, 'stride', 2 * 'stride'... each repeated
+  // 'duplicates' times, split into batches of 10K rows.
+  std::vector<RowVectorPtr> makeData(
+      int32_t numRows,
+      int32_t stride,
+      int32_t duplicates,
+      const std::string& prefix) {
+    constexpr int32_t kBatchSize = 10'000;
+    std::vector<RowVectorPtr> data;
+    for (auto start = 0; start < numRows; start += kBatchSize) {
+      const auto size = std::min(kBatchSize, numRows - start);
+      data.push_back(makeRowVector(
+          {prefix + "_k", prefix + "_p"},
+          {makeFlatVector<int64_t>(
+               size,
+               [&](auto row) {
+                 return static_cast<int64_t>(start + row) / duplicates *
+                     stride;
+               }),
+           makeFlatVector<int64_t>(
+               size, [&](auto row) { return start + row; })}));
+    }
+    return data;
+  }
+
+  std::vector<std::unique_ptr<core::PlanNodePtr>> plans_;
+};
+
+} // namespace
+} // namespace facebook::velox::exec
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  memory::initializeMemoryManager(memory::MemoryManager::Options{});
+
+  MergeJoinBenchmark bm;
+  bm.makeBenchmarks(core::JoinType::kInner);
+  BENCHMARK_DRAW_LINE();
+  bm.makeBenchmarks(core::JoinType::kLeftSemiFilter);
+  BENCHMARK_DRAW_LINE();
+  bm.makeBenchmarks(core::JoinType::kLeft);
+
+  folly::runBenchmarks();
+
+  return 0;
+}
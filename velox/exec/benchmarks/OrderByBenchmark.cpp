@@ -23,6 +23,11 @@
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
+DEFINE_int32(
+    parallel_sort_rows,
+    10'000'000,
+    "The number of rows sorted by the parallel sort benchmarks");
+
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
 
@@ -73,6 +78,31 @@ class OrderByBenchmark {
     }
   }
 
+  // Sorts 'numRows' rows split evenly across 'numThreads' drivers, with and
+  // without 'QueryConfig::kOrderByParallelSortEnabled', followed by a
+  // LocalMerge of the drivers.
+  void addParallelBenchmark(vector_size_t numRows, int32_t numThreads) {
+    for (const bool parallelSort : {false, true}) {
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format(
+              "OrderBy{}_{}threads",
+              parallelSort ? "ParallelSort" : "LocalMerge",
+              numThreads),
+          [numRows, numThreads, parallelSort, this]() {
+            const auto plan = makeLocalMergePlan(numRows / numThreads);
+            std::shared_ptr<Task> task;
+            test::AssertQueryBuilder(plan)
+                .maxDrivers(numThreads)
+                .config(
+                    core::QueryConfig::kOrderByParallelSortEnabled,
+                    parallelSort)
+                .runWithoutResults(task);
+            return 1;
+          });
+    }
+  }
+
  private:
   core::PlanNodePtr makeOrderByPlan(
       const TestCase& test,
@@ -95,6 +125,28 @@ class OrderByBenchmark {
         .planNode();
   }
 
+  core::PlanNodePtr makeLocalMergePlan(vector_size_t numRowsPerDriver) {
+    folly::BenchmarkSuspender suspender;
+    const auto rowType = ROW({BIGINT(), BIGINT(), VARCHAR()});
+    std::vector<RowVectorPtr> vectors;
+    constexpr vector_size_t kBatchSize = 10'000;
+    for (vector_size_t i = 0; i < numRowsPerDriver; i += kBatchSize) {
+      vectors.emplace_back(OrderByBenchmarkUtil::fuzzRows(
+          rowType, std::min(kBatchSize, numRowsPerDriver - i), pool_.get()));
+    }
+
+    const std::vector<std::string> keys = {"c0", "c1"};
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return test::PlanBuilder(planNodeIdGenerator)
+        .localMerge(
+            keys,
+            {test::PlanBuilder(planNodeIdGenerator)
+                 .values(vectors, true)
+                 .orderBy(keys, false)
+                 .planNode()})
+        .planNode();
+  }
+
   std::shared_ptr<memory::MemoryPool> rootPool_{
       memory::memoryManager()->addRootPool()};
   std::shared_ptr<memory::MemoryPool> pool_{
@@ -115,6 +167,10 @@ int main(int argc, char** argv) {
     bm.addBenchmark(benchmarkName, numRows, rowType, iterations, numKeys);
   });
 
+  for (const auto numThreads : {1, 2, 4, 8, 16, 32, 64}) {
+    bm.addParallelBenchmark(FLAGS_parallel_sort_rows, numThreads);
+  }
+
   folly::runBenchmarks();
   return 0;
 }
@@ -270,6 +270,78 @@ BENCHMARK(computeValueIdsDictionaryForFiltering) {
   }
 }
 
+// Hashes flat keys without nulls of 'types' column by column or in one fused
+// pass.
+void benchmarkMultiColumnHash(const std::vector<TypePtr>& types, bool fused) {
+  folly::BenchmarkSuspender suspender;
+  vector_size_t size = 1'000;
+  BenchmarkBase base;
+
+  std::vector<VectorPtr> vectors;
+  std::vector<std::unique_ptr<exec::VectorHasher>> hashers;
+  for (auto i = 0; i < types.size(); ++i) {
+    if (types[i]->isVarchar()) {
+      vectors.push_back(base.vectorMaker().flatVector<std::string>(
+          size, [](vector_size_t row) {
+            return fmt::format("customer#{}", row * 17);
+          }));
+    } else if (types[i]->isBigint()) {
+      vectors.push_back(base.vectorMaker().flatVector<int64_t>(
+          size, [](vector_size_t row) { return row * 1'234'567; }));
+    } else {
+      vectors.push_back(base.vectorMaker().flatVector<int32_t>(
+          size,
+          [](vector_size_t row) { return row % 366; },
+          nullptr,
+          types[i]));
+    }
+    hashers.push_back(exec::VectorHasher::create(types[i], i));
+  }
+
+  SelectivityVector rows(size);
+  raw_vector<uint64_t> hashes(size);
+  suspender.dismiss();
+
+  for (int i = 0; i < 10'000; i++) {
+    for (auto j = 0; j < hashers.size(); ++j) {
+      hashers[j]->decode(*vectors[j], rows);
+    }
+    if (fused) {
+      bool ok = VectorHasher::hashFused(hashers, rows, hashes);
+      folly::doNotOptimizeAway(ok);
+    } else {
+      for (auto j = 0; j < hashers.size(); ++j) {
+        hashers[j]->hash(rows, j > 0, hashes);
+      }
+    }
+    folly::doNotOptimizeAway(hashes);
+  }
+}
+
+BENCHMARK(hashBigintBigint) {
+  benchmarkMultiColumnHash({BIGINT(), BIGINT()}, false);
+}
+
+BENCHMARK_RELATIVE(hashBigintBigintFused) {
+  benchmarkMultiColumnHash({BIGINT(), BIGINT()}, true);
+}
+
+BENCHMARK(hashBigintVarchar) {
+  benchmarkMultiColumnHash({BIGINT(), VARCHAR()}, false);
+}
+
+BENCHMARK_RELATIVE(hashBigintVarcharFused) {
+  benchmarkMultiColumnHash({BIGINT(), VARCHAR()}, true);
+}
+
+BENCHMARK(hashIntegerIntegerDate) {
+  benchmarkMultiColumnHash({INTEGER(), INTEGER(), DATE()}, false);
+}
+
+BENCHMARK_RELATIVE(hashIntegerIntegerDateFused) {
+  benchmarkMultiColumnHash({INTEGER(), INTEGER(), DATE()}, true);
+}
+
 int main(int argc, char** argv) {
   folly::Init init{&argc, &argv};
   memory::MemoryManager::initialize(memory::MemoryManager::Options{});
@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
@@ -159,6 +160,65 @@ class PrefixSortRunner {
         compare);
   }
 
+  /// Sorts the entries in [start, end) by their first 'keyBytes' bytes with a
+  /// least significant digit first radix sort, which does not compare the
+  /// entries. The key is a sequence of 8 byte words compared as unsigned
+  /// integers, the first word first, which is the layout of the normalized keys
+  /// of PrefixSort after the byte swap of each word. The sort is stable and
+  /// skips the bytes which have the same value in all the entries.
+  ///
+  /// @param buffer The buffer must have space for the entries in [start, end).
+  /// @return The start of the sorted entries, either 'start' or 'buffer'.
+  char* radixSort(char* start, char* end, char* buffer, uint32_t keyBytes)
+      const {
+    VELOX_CHECK(end >= start, "Invalid sort range.");
+    VELOX_CHECK_EQ(keyBytes % sizeof(uint64_t), 0);
+    VELOX_CHECK_LE(keyBytes, entrySize_);
+    const uint64_t numEntries = (end - start) / entrySize_;
+    if (numEntries < 2) {
+      return start;
+    }
+
+    // Counts the values of all the bytes of the key in one pass.
+    constexpr int32_t kNumValues = 256;
+    std::vector<uint64_t> counts(keyBytes * kNumValues, 0);
+    for (auto* entry = start; entry < end; entry += entrySize_) {
+      for (uint32_t i = 0; i < keyBytes; ++i) {
+        ++counts[i * kNumValues + static_cast<uint8_t>(entry[i])];
+      }
+    }
+
+    char* source = start;
+    char* target = buffer;
+    // The least significant byte of a little endian word comes first in
+    // memory, and the last word is the least significant.
+    for (int32_t word = keyBytes / sizeof(uint64_t) - 1; word >= 0; --word) {
+      for (int32_t byte = 0; byte < sizeof(uint64_t); ++byte) {
+        const auto digit = word * sizeof(uint64_t) + byte;
+        auto* offsets = counts.data() + digit * kNumValues;
+        if (offsets[static_cast<uint8_t>(source[digit])] == numEntries) {
+          continue;
+        }
+        uint64_t offset{0};
+        for (auto i = 0; i < kNumValues; ++i) {
+          const auto count = offsets[i];
+          offsets[i] = offset;
+          offset += count;
+        }
+        const auto* sourceEnd = source + numEntries * entrySize_;
+        for (auto* entry = source; entry < sourceEnd; entry += entrySize_) {
+          simd::memcpy(
+              target +
+                  entrySize_ * offsets[static_cast<uint8_t>(entry[digit])]++,
+              entry,
+              entrySize_);
+        }
+        std::swap(source, target);
+      }
+    }
+    return source;
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
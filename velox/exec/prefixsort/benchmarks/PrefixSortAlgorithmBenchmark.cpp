@@ -44,6 +44,27 @@ class PrefixSortAlgorithmBenchmark {
         });
   }
 
+  void runRadixSort(std::vector<int64_t> vec) {
+    char* start = (char*)vec.data();
+    uint32_t entrySize = sizeof(int64_t);
+    std::vector<int64_t> buffer(vec.size());
+    auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool_.get());
+    auto sortRunner =
+        prefixsort::PrefixSortRunner(entrySize, swapBuffer->asMutable<char>());
+    sortRunner.radixSort(
+        start, start + entrySize * vec.size(), (char*)buffer.data(), entrySize);
+  }
+
+  /// Returns the data of generateTestVector() with the bytes of each value
+  /// swapped, which is the layout radix sort expects.
+  std::vector<int64_t> generateRadixTestVector(int32_t size) {
+    auto data = generateTestVector(size);
+    for (auto& value : data) {
+      value = __builtin_bswap64(value);
+    }
+    return data;
+  }
+
   std::vector<int64_t> generateTestVector(int32_t size) {
     std::vector<int64_t> randomTestVec(size);
     std::generate(randomTestVec.begin(), randomTestVec.end(), [&]() {
@@ -65,6 +86,10 @@ std::vector<int64_t> data10k;
 std::vector<int64_t> data100k;
 std::vector<int64_t> data1000k;
 std::vector<int64_t> data10000k;
+std::vector<int64_t> radixData10k;
+std::vector<int64_t> radixData100k;
+std::vector<int64_t> radixData1000k;
+std::vector<int64_t> radixData10000k;
 
 BENCHMARK(PrefixSort_algorithm_10k) {
   bm->runQuickSort(data10k);
@@ -82,6 +107,22 @@ BENCHMARK(PrefixSort_algorithm_10000k) {
   bm->runQuickSort(data10000k);
 }
 
+BENCHMARK(PrefixSort_radix_10k) {
+  bm->runRadixSort(radixData10k);
+}
+
+BENCHMARK(PrefixSort_radix_100k) {
+  bm->runRadixSort(radixData100k);
+}
+
+BENCHMARK(PrefixSort_radix_1000k) {
+  bm->runRadixSort(radixData1000k);
+}
+
+BENCHMARK(PrefixSort_radix_10000k) {
+  bm->runRadixSort(radixData10000k);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -93,6 +134,10 @@ int main(int argc, char** argv) {
   data100k = bm->generateTestVector(100'000);
   data1000k = bm->generateTestVector(1'000'000);
   data10000k = bm->generateTestVector(10'000'000);
+  radixData10k = bm->generateRadixTestVector(10'000);
+  radixData100k = bm->generateRadixTestVector(100'000);
+  radixData1000k = bm->generateRadixTestVector(1'000'000);
+  radixData10000k = bm->generateRadixTestVector(10'000'000);
   folly::runBenchmarks();
   return 0;
 }
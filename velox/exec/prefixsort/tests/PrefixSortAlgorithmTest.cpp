@@ -55,6 +55,42 @@ class PrefixSortAlgorithmTest : public testing::Test,
     ASSERT_EQ(data1, data2);
   }
 
+  void testRadixSort(size_t size, uint64_t maxKey) {
+    // Each entry has a 16 byte key of two words and the position of the entry
+    // in the input.
+    struct Entry {
+      uint64_t key[2];
+      uint64_t position;
+    };
+    std::vector<Entry> entries(size);
+    for (size_t i = 0; i < size; ++i) {
+      entries[i] = {
+          {folly::Random::rand64() % maxKey, folly::Random::rand64() % maxKey},
+          i};
+    }
+    std::vector<Entry> expected = entries;
+    std::stable_sort(
+        expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+          return std::make_pair(a.key[0], a.key[1]) <
+              std::make_pair(b.key[0], b.key[1]);
+        });
+
+    std::vector<Entry> buffer(size);
+    char* start = (char*)entries.data();
+    auto swapBuffer = AlignedBuffer::allocate<char>(sizeof(Entry), pool());
+    PrefixSortRunner sortRunner(sizeof(Entry), swapBuffer->asMutable<char>());
+    auto* sorted = reinterpret_cast<Entry*>(sortRunner.radixSort(
+        start,
+        start + sizeof(Entry) * size,
+        (char*)buffer.data(),
+        sizeof(Entry::key)));
+    for (size_t i = 0; i < size; ++i) {
+      ASSERT_EQ(sorted[i].key[0], expected[i].key[0]) << i;
+      ASSERT_EQ(sorted[i].key[1], expected[i].key[1]) << i;
+      ASSERT_EQ(sorted[i].position, expected[i].position) << i;
+    }
+  }
+
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
@@ -70,6 +106,15 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  testRadixSort(0, 10);
+  testRadixSort(1, 10);
+  // Few distinct keys check the stability and the skipped bytes.
+  testRadixSort(1'000, 10);
+  testRadixSort(10'000, 1'000);
+  testRadixSort(10'000, std::numeric_limits<uint64_t>::max());
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
@@ -810,6 +810,176 @@ TEST_F(AggregationTest, rangeToDistinct) {
       " GROUP BY c0, c1, c2, c3, c4, c5");
 }
 
+TEST_F(AggregationTest, denseAccumulators) {
+  std::vector<RowVectorPtr> batches;
+  // Keys in a small range, then in a wider range, which changes the array
+  // positions of the groups, then keys that do not fit an array.
+  for (auto maxKey : {100, 100, 1'000, 1'000, 1'000'000'000}) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return (row * 7'919L) % maxKey; },
+            [](auto row) { return row % 101 == 0; }),
+        makeFlatVector<int32_t>(
+            1'000, [](auto row) { return row; }, nullEvery(7)),
+        makeFlatVector<double>(
+            1'000, [](auto row) { return row * 0.5; }, nullEvery(11)),
+    }));
+  }
+  // Groups that only get null 'c1' values.
+  batches.push_back(makeRowVector({
+      makeFlatVector<int64_t>(10, [](auto row) { return 2'000 + row; }),
+      makeNullConstant(TypeKind::INTEGER, 10),
+      makeFlatVector<double>(10, [](auto row) { return row; }),
+  }));
+  createDuckDbTable(batches);
+
+  const std::vector<std::string> aggregates = {
+      "sum(c1)", "count(c1)", "count(1)", "sum(c2)"};
+  const std::string duckDbSql =
+      "SELECT c0, sum(c1), count(c1), count(1), sum(c2) FROM tmp GROUP BY c0";
+  for (const auto& plan :
+       {PlanBuilder()
+            .values(batches)
+            .singleAggregation({"c0"}, aggregates)
+            .planNode(),
+        PlanBuilder()
+            .values(batches)
+            .partialAggregation({"c0"}, aggregates)
+            .finalAggregation()
+            .planNode()}) {
+    for (const auto maxGroups : {0, 100'000}) {
+      SCOPED_TRACE(fmt::format("maxGroups: {}", maxGroups));
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(
+              core::QueryConfig::kAggregationDenseAccumulatorsMaxGroups,
+              std::to_string(maxGroups))
+          .assertResults(duckDbSql);
+    }
+  }
+
+  // Flushes partial aggregation results while the accumulators are dense.
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .partialAggregation({"c0"}, aggregates)
+                  .finalAggregation()
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kAggregationDenseAccumulatorsMaxGroups, "1000")
+      .config(core::QueryConfig::kMaxPartialAggregationMemory, "1")
+      .config(core::QueryConfig::kMaxExtendedPartialAggregationMemory, "1")
+      .assertResults(duckDbSql);
+}
+
+TEST_F(AggregationTest, concurrentHashAggregation) {
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return (i * 1'000 + row) * 7'919L % 5'000; },
+            [](auto row) { return row % 103 == 0; }),
+        makeFlatVector<int32_t>(
+            1'000, [](auto row) { return row % 3; }, nullEvery(17)),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return i * row; }, nullEvery(7)),
+        makeFlatVector<double>(
+            1'000, [](auto row) { return row * 0.25; }, nullEvery(11)),
+    }));
+  }
+  // Each driver reads all of 'batches' from the parallelizable values node.
+  constexpr int32_t kNumDrivers = 4;
+  std::vector<RowVectorPtr> duckDbBatches;
+  for (auto i = 0; i < kNumDrivers; ++i) {
+    duckDbBatches.insert(duckDbBatches.end(), batches.begin(), batches.end());
+  }
+  createDuckDbTable(duckDbBatches);
+
+  const std::vector<std::string> aggregates = {
+      "count(1)", "count(c2)", "sum(c2)", "sum(c3)", "min(c2)", "max(c3)"};
+  const std::string duckDbSql =
+      "SELECT c0, c1, count(1), count(c2), sum(c2), sum(c3), min(c2), max(c3) "
+      "FROM tmp GROUP BY c0, c1";
+  for (const bool partial : {false, true}) {
+    SCOPED_TRACE(fmt::format("partial: {}", partial));
+    core::PlanNodeId aggregationId;
+    PlanBuilder builder;
+    builder.values(batches, true);
+    if (partial) {
+      builder.partialAggregation({"c0", "c1"}, aggregates)
+          .finalAggregation()
+          .capturePlanNodeId(aggregationId);
+    } else {
+      builder.singleAggregation({"c0", "c1"}, aggregates)
+          .capturePlanNodeId(aggregationId);
+    }
+    auto task =
+        AssertQueryBuilder(builder.planNode(), duckDbQueryRunner_)
+            .maxDrivers(kNumDrivers)
+            .config(core::QueryConfig::kConcurrentHashAggregationEnabled, "true")
+            .assertResults(duckDbSql);
+
+    auto runtimeStats =
+        toPlanStats(task->taskStats()).at(aggregationId).customStats;
+    ASSERT_EQ(runtimeStats.at(BaseHashTable::kNumDistinct).sum, 4'954);
+    ASSERT_GT(runtimeStats.at(BaseHashTable::kNumRehashes).sum, 0);
+  }
+}
+
+TEST_F(AggregationTest, sharedDistinctTable) {
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 5; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [&](auto row) { return row % 97; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * row) % 31; }, nullEvery(13)),
+        makeFlatVector<int32_t>(1'000, [&](auto row) { return row % 7; }),
+        makeFlatVector<StringView>(
+            1'000,
+            [&](auto row) {
+              return StringView::makeInline(
+                  fmt::format("value {}", (i + row) % 17));
+            },
+            nullEvery(11)),
+    }));
+  }
+  createDuckDbTable(batches);
+
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .singleAggregation(
+                      {"c0"},
+                      {"count(distinct c1)",
+                       "sum(distinct c1)",
+                       "count(distinct c2)",
+                       "count(distinct c3)",
+                       "sum(c2)"})
+                  .planNode();
+  const std::string duckDbSql =
+      "SELECT c0, count(distinct c1), sum(distinct c1), count(distinct c2), "
+      "count(distinct c3), sum(c2) FROM tmp GROUP BY c0";
+  for (const auto outputBatchRows : {10, 1'024}) {
+    SCOPED_TRACE(fmt::format("outputBatchRows: {}", outputBatchRows));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kAggregationSharedDistinctTableEnabled, "true")
+        .config(
+            core::QueryConfig::kPreferredOutputBatchRows,
+            std::to_string(outputBatchRows))
+        .assertResults(duckDbSql);
+  }
+
+  // Global aggregations keep a set per aggregate.
+  plan = PlanBuilder()
+             .values(batches)
+             .singleAggregation(
+                 {}, {"count(distinct c1)", "count(distinct c2)"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kAggregationSharedDistinctTableEnabled, "true")
+      .assertResults("SELECT count(distinct c1), count(distinct c2) FROM tmp");
+}
+
 TEST_F(AggregationTest, allKeyTypes) {
   // Covers different key types. Unlike the integer/string tests, the
   // hash table begins life in the generic mode, not array or
@@ -915,6 +1085,101 @@ TEST_F(AggregationTest, partialAggregationMemoryLimit) {
           .customStats.count("flushRowCount"));
 }
 
+TEST_F(AggregationTest, partialAggregationEviction) {
+  // Each batch has 90 hot keys that repeat in all batches and 100 cold keys
+  // that appear only once.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 20; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) {
+              return row % 10 == 0 ? 1'000 + i * 100 + row / 10 : row % 100;
+            }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggNodeId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation({"c0"}, {"count(1)", "sum(c1)"})
+                  .capturePlanNodeId(aggNodeId)
+                  .finalAggregation()
+                  .planNode();
+  auto runQuery = [&](int32_t evictionPct) {
+    return AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(QueryConfig::kMaxPartialAggregationMemory, 1)
+        .config(QueryConfig::kMaxExtendedPartialAggregationMemory, 1)
+        .config(QueryConfig::kPartialAggregationEvictionPct, evictionPct)
+        .assertResults("SELECT c0, count(1), sum(c1) FROM tmp GROUP BY 1");
+  };
+
+  auto task = runQuery(0);
+  const auto flushStats = toPlanStats(task->taskStats()).at(aggNodeId);
+  ASSERT_EQ(0, flushStats.customStats.count("evictionTimes"));
+
+  task = runQuery(10);
+  const auto evictionStats = toPlanStats(task->taskStats()).at(aggNodeId);
+  ASSERT_GT(evictionStats.customStats.at("evictionTimes").sum, 0);
+  ASSERT_GT(evictionStats.customStats.at("evictedRowCount").sum, 0);
+  // Keeping the hot keys in the table reduces the partial aggregation output.
+  ASSERT_LT(evictionStats.outputRows, flushStats.outputRows);
+}
+
+TEST_F(AggregationTest, partialAggregationSortedInput) {
+  // 10 batches sorted on (c0, c1) with 10 rows per group. A group may span two
+  // batches.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row + 5) / 100; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row + 5) / 10 % 10; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggNodeId;
+  auto runQuery = [&](const std::vector<RowVectorPtr>& input, bool enabled) {
+    auto plan = PlanBuilder()
+                    .values(input)
+                    .partialAggregation({"c0", "c1"}, {"count(1)", "sum(c2)"})
+                    .capturePlanNodeId(aggNodeId)
+                    .finalAggregation()
+                    .planNode();
+    return AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            QueryConfig::kPartialAggregationSortedInputDetectionEnabled,
+            enabled)
+        .assertResults(
+            "SELECT c0, c1, count(1), sum(c2) FROM tmp GROUP BY 1, 2");
+  };
+
+  auto task = runQuery(vectors, false);
+  auto stats = toPlanStats(task->taskStats()).at(aggNodeId);
+  ASSERT_EQ(0, stats.customStats.count("sortedInputRowCount"));
+
+  // The groups are output batch by batch. The groups that span two batches are
+  // output once.
+  task = runQuery(vectors, true);
+  stats = toPlanStats(task->taskStats()).at(aggNodeId);
+  ASSERT_EQ(10'000, stats.customStats.at("sortedInputRowCount").sum);
+  ASSERT_EQ(1'001, stats.outputRows);
+  ASSERT_GE(stats.outputVectors, 10);
+
+  // A batch less than the previous one turns the detection off. The batches
+  // up to the out of order one are streamed.
+  std::vector<RowVectorPtr> unsorted = vectors;
+  std::swap(unsorted[5], unsorted[6]);
+  task = runQuery(unsorted, true);
+  stats = toPlanStats(task->taskStats()).at(aggNodeId);
+  ASSERT_EQ(6'000, stats.customStats.at("sortedInputRowCount").sum);
+}
+
 TEST_F(AggregationTest, partialDistinctWithAbandon) {
   auto vectors = {
       // 1st batch will produce 100 distinct groups from 10 rows.
@@ -1372,6 +1637,120 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsRollup) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "k3", "a", "b"},
+      {
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 11; }, nullEvery(13)),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 5, 'y'); }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> aggregates = {
+      "count(1) as count_1",
+      "sum(a) as sum_a",
+      "avg(a) as avg_a",
+      "max(b) as max_b",
+      "approx_distinct(b) as distinct_b"};
+  const std::string aggregatesSql =
+      "count(1), sum(a), avg(a), max(b), approx_distinct(b)";
+
+  struct {
+    std::vector<std::vector<std::string>> groupingSets;
+    std::string groupBySql;
+  } testSettings[] = {
+      {{{"k1", "k2", "k3"}, {"k1", "k2"}, {"k1"}, {}}, "ROLLUP (k1, k2, k3)"},
+      {{{"k1", "k2"}, {"k1"}, {"k2"}, {}}, "CUBE (k1, k2)"},
+      {{{"k1"}, {"k2"}, {"k3"}}, "GROUPING SETS ((k1), (k2), (k3))"},
+      {{{"k3", "k1"}, {"k2"}, {}}, "GROUPING SETS ((k3, k1), (k2), ())"}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.groupBySql);
+    core::PlanNodeId groupIdNodeId;
+    auto plan =
+        PlanBuilder()
+            .values({data})
+            .groupId({"k1", "k2", "k3"}, testData.groupingSets, {"a", "b"})
+            .capturePlanNodeId(groupIdNodeId)
+            .singleAggregation({"k1", "k2", "k3", "group_id"}, aggregates)
+            .project(
+                {"k1",
+                 "k2",
+                 "k3",
+                 "count_1",
+                 "sum_a",
+                 "avg_a",
+                 "max_b",
+                 "distinct_b"})
+            .planNode();
+
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kAggregationGroupingSetsRollupEnabled,
+                "true")
+            .assertResults(fmt::format(
+                "SELECT k1, k2, k3, {} FROM tmp GROUP BY {}",
+                aggregatesSql,
+                testData.groupBySql));
+
+    // GroupId returns each input row once.
+    ASSERT_EQ(
+        toPlanStats(task->taskStats()).at(groupIdNodeId).outputRows, size);
+  }
+
+  // The grouping sets with no keys return a row for empty input.
+  auto plan =
+      PlanBuilder()
+          .values({data})
+          .filter("a < 0")
+          .groupId({"k1"}, {{"k1"}, {}}, {"a"})
+          .singleAggregation({"k1", "group_id"}, {"count(a) as count_a"})
+          .project({"count_a"})
+          .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kAggregationGroupingSetsRollupEnabled, "true")
+      .assertResults(
+          "SELECT count(a) FROM tmp WHERE a < 0 "
+          "GROUP BY GROUPING SETS ((k1), ())");
+
+  // For empty input, only the grouping sets which the aggregation marks as
+  // global return a row. The grouping set 3 has no keys but is not global.
+  auto aggregation = std::dynamic_pointer_cast<const core::AggregationNode>(
+      PlanBuilder()
+          .values({data})
+          .filter("a < 0")
+          .groupId({"k1", "k2"}, {{"k1"}, {}, {"k2"}, {}}, {"a"})
+          .singleAggregation({"k1", "k2", "group_id"}, {"count(a) as count_a"})
+          .planNode());
+  ASSERT_EQ(
+      aggregation->globalGroupingSets(), std::vector<vector_size_t>({1, 3}));
+  plan = core::AggregationNode::Builder(*aggregation)
+             .globalGroupingSets({1})
+             .build();
+  const auto expected = makeRowVector(
+      {makeNullConstant(TypeKind::BIGINT, 1),
+       makeNullConstant(TypeKind::BIGINT, 1),
+       makeFlatVector<int64_t>(std::vector<int64_t>{1}),
+       makeFlatVector<int64_t>(std::vector<int64_t>{0})});
+  for (const auto rollupEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("rollupEnabled {}", rollupEnabled));
+    AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kAggregationGroupingSetsRollupEnabled,
+            rollupEnabled ? "true" : "false")
+        .assertResults(expected);
+  }
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -2546,6 +2925,86 @@ DEBUG_ONLY_TEST_F(AggregationTest, reclaimDuringInputProcessing) {
   ASSERT_EQ(reclaimerStats_, memory::MemoryReclaimer::Stats{});
 }
 
+DEBUG_ONLY_TEST_F(AggregationTest, reclaimPartialSpill) {
+  constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
+  auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
+  const int numBatches = 10;
+  auto batches = makeVectors(rowType, 1000, numBatches);
+  const auto plan = PlanBuilder()
+                        .values(batches)
+                        .singleAggregation({"c0", "c1"}, {"array_agg(c2)"})
+                        .planNode();
+
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto queryCtx = core::QueryCtx::create(executor_.get());
+  queryCtx->testingOverrideMemoryPool(memory::memoryManager()->addRootPool(
+      queryCtx->queryId(), kMaxBytes, memory::MemoryReclaimer::create()));
+  auto expectedResult =
+      AssertQueryBuilder(plan).queryCtx(queryCtx).copyResults(pool_.get());
+
+  folly::EventCount driverWait;
+  std::atomic_bool driverWaitFlag{true};
+  folly::EventCount testWait;
+  std::atomic_bool testWaitFlag{true};
+
+  std::atomic_int numInputs{0};
+  Operator* op{nullptr};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::addInput",
+      std::function<void(Operator*)>(([&](Operator* testOp) {
+        if (testOp->operatorType() != "Aggregation") {
+          return;
+        }
+        op = testOp;
+        if (++numInputs != numBatches / 2) {
+          return;
+        }
+        // Holds an unused reservation for the reclaim to release.
+        ASSERT_TRUE(op->pool()->maybeReserve(8 << 20));
+        testWaitFlag = false;
+        testWait.notifyAll();
+        driverWait.await([&] { return !driverWaitFlag.load(); });
+      })));
+
+  std::thread taskThread([&]() {
+    AssertQueryBuilder(plan)
+        .queryCtx(queryCtx)
+        .spillDirectory(tempDirectory->getPath())
+        .config(QueryConfig::kSpillEnabled, true)
+        .config(QueryConfig::kAggregationSpillEnabled, true)
+        .config(QueryConfig::kAggregationSpillPartialPct, 50)
+        .maxDrivers(1)
+        .assertResults(expectedResult);
+  });
+
+  testWait.await([&]() { return !testWaitFlag.load(); });
+  ASSERT_TRUE(op != nullptr);
+  auto task = op->operatorCtx()->task();
+  auto taskPauseWait = task->requestPause();
+  driverWaitFlag = false;
+  driverWait.notifyAll();
+  taskPauseWait.wait();
+
+  ASSERT_GE(op->pool()->availableReservation(), 1 << 20);
+  {
+    memory::ScopedMemoryArbitrationContext ctx(op->pool());
+    op->reclaim(1 << 20, reclaimerStats_);
+  }
+  // Unlike a full spill, the groups of the partitions left in memory keep the
+  // table memory beyond the raw_vectors.
+  ASSERT_GT(op->pool()->usedBytes(), 28672);
+  ASSERT_LT(op->pool()->availableReservation(), 1 << 20);
+  reclaimerStats_.reset();
+
+  Task::resume(task);
+  taskThread.join();
+
+  auto stats = task->taskStats().pipelineStats;
+  ASSERT_GT(stats[0].operatorStats[1].spilledBytes, 0);
+  ASSERT_EQ(stats[0].operatorStats[1].spilledPartitions, 8);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 DEBUG_ONLY_TEST_F(AggregationTest, reclaimDuringReserve) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
@@ -19,6 +19,7 @@
 #include <memory>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/HardwareCounters.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Cursor.h"
@@ -604,6 +605,40 @@ TEST_F(DriverTest, pause) {
   EXPECT_EQ(operators[1].outputPositions, 10 * hits);
 }
 
+TEST_F(DriverTest, hardwareCounters) {
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 10; ++i) {
+    batches.push_back(
+        makeRowVector({makeFlatVector<int64_t>(1'000, folly::identity)}));
+  }
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .project({"c0 * 2 AS c1"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  // Samples all the calls.
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kOperatorHardwareCounterSampleRate, "1")
+      .copyResults(pool(), task);
+  auto stats = toPlanStats(task->taskStats()).at(projectId).customStats;
+  if (!process::HardwareCounters::forThread().available()) {
+    ASSERT_EQ(stats.count(Operator::kHardwareCycles), 0);
+    return;
+  }
+  // The 10 addInput() calls and at least as many getOutput() calls.
+  ASSERT_GE(stats.at(Operator::kHardwareCycles).count, 20);
+  ASSERT_GT(stats.at(Operator::kHardwareCycles).sum, 0);
+  ASSERT_GT(stats.at(Operator::kHardwareInstructions).sum, 0);
+  ASSERT_EQ(
+      stats.at(Operator::kHardwareLlcMisses).count,
+      stats.at(Operator::kHardwareCycles).count);
+  ASSERT_EQ(
+      stats.at(Operator::kHardwareBranchMisses).count,
+      stats.at(Operator::kHardwareCycles).count);
+}
+
 TEST_F(DriverTest, yield) {
   constexpr int32_t kNumTasks = 20;
   constexpr int32_t kThreadsPerTask = 5;
@@ -1769,3 +1804,223 @@ DEBUG_ONLY_TEST_F(DriverTest, recursiveSuspensionThrow) {
   createAndStartTaskToReadValues(1);
   waitForAllTasksToBeDeleted();
 }
+
+namespace {
+
+// Executor that counts the functions added to it.
+class CountingExecutor : public folly::Executor {
+ public:
+  explicit CountingExecutor(folly::Executor* executor) : executor_(executor) {}
+
+  void add(folly::Func func) override {
+    ++numAdds_;
+    executor_->add(std::move(func));
+  }
+
+  int32_t numAdds() const {
+    return numAdds_;
+  }
+
+ private:
+  folly::Executor* const executor_;
+  std::atomic_int32_t numAdds_{0};
+};
+
+// Where the driver ran before and after waiting for the I/O of an
+// IoWaitOperator.
+struct IoWaitResult {
+  std::thread::id blockedThreadId;
+  std::thread::id resumedThreadId;
+  // Functions added to the executor while the driver waited.
+  int32_t numAddsWhileBlocked{-1};
+};
+
+class IoWaitNode : public core::PlanNode {
+ public:
+  IoWaitNode(
+      const core::PlanNodeId& id,
+      const core::PlanNodePtr& input,
+      uint64_t ioDelayUs,
+      CountingExecutor* executor,
+      IoWaitResult* result)
+      : PlanNode(id),
+        ioDelayUs_(ioDelayUs),
+        executor_(executor),
+        result_(result),
+        sources_{input} {}
+
+  const RowTypePtr& outputType() const override {
+    return sources_[0]->outputType();
+  }
+
+  const std::vector<std::shared_ptr<const PlanNode>>& sources() const override {
+    return sources_;
+  }
+
+  std::string_view name() const override {
+    return "IoWait";
+  }
+
+  uint64_t ioDelayUs() const {
+    return ioDelayUs_;
+  }
+
+  CountingExecutor* executor() const {
+    return executor_;
+  }
+
+  IoWaitResult* result() const {
+    return result_;
+  }
+
+ private:
+  void addDetails(std::stringstream& /* stream */) const override {}
+
+  const uint64_t ioDelayUs_;
+  CountingExecutor* const executor_;
+  IoWaitResult* const result_;
+  std::vector<core::PlanNodePtr> sources_;
+};
+
+// Blocks on the connector once, with a future that another thread realizes
+// 'ioDelayUs_' later.
+class IoWaitOperator : public Operator {
+ public:
+  IoWaitOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const std::shared_ptr<const IoWaitNode>& node)
+      : Operator(ctx, node->outputType(), id, node->id(), "IoWait"),
+        node_(node) {}
+
+  bool needsInput() const override {
+    return !noMoreInput_ && !input_;
+  }
+
+  void addInput(RowVectorPtr input) override {
+    input_ = std::move(input);
+  }
+
+  RowVectorPtr getOutput() override {
+    auto* result = node_->result();
+    if (ioThread_.joinable() && result->resumedThreadId == std::thread::id()) {
+      result->resumedThreadId = std::this_thread::get_id();
+      result->numAddsWhileBlocked =
+          node_->executor()->numAdds() - numAddsAtBlock_;
+    }
+    return std::move(input_);
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr;
+  }
+
+  BlockingReason isBlocked(ContinueFuture* future) override {
+    if (input_ == nullptr || ioThread_.joinable()) {
+      return BlockingReason::kNotBlocked;
+    }
+    node_->result()->blockedThreadId = std::this_thread::get_id();
+    numAddsAtBlock_ = node_->executor()->numAdds();
+    auto [promise, ioFuture] = makeVeloxContinuePromiseContract("IoWait");
+    ioThread_ = std::thread(
+        [promise = std::move(promise), delayUs = node_->ioDelayUs()]() mutable {
+          std::this_thread::sleep_for(
+              std::chrono::microseconds(delayUs)); // NOLINT
+          promise.setValue();
+        });
+    *future = std::move(ioFuture);
+    return BlockingReason::kWaitForConnector;
+  }
+
+  void close() override {
+    if (ioThread_.joinable()) {
+      ioThread_.join();
+    }
+    Operator::close();
+  }
+
+ private:
+  const std::shared_ptr<const IoWaitNode> node_;
+  std::thread ioThread_;
+  int32_t numAddsAtBlock_{0};
+};
+
+class IoWaitNodeFactory : public Operator::PlanNodeTranslator {
+ public:
+  std::unique_ptr<Operator> toOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const core::PlanNodePtr& node) override {
+    if (auto ioWaitNode = std::dynamic_pointer_cast<const IoWaitNode>(node)) {
+      return std::make_unique<IoWaitOperator>(ctx, id, ioWaitNode);
+    }
+    return nullptr;
+  }
+
+  std::optional<uint32_t> maxDrivers(const core::PlanNodePtr& node) override {
+    return 1;
+  }
+};
+} // namespace
+
+TEST_F(DriverTest, ioWaitOnThread) {
+  Operator::registerOperator(std::make_unique<IoWaitNodeFactory>());
+  auto rows = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+
+  struct {
+    uint64_t ioWaitOnThreadUs;
+    uint64_t ioDelayUs;
+    bool resumedOnThread;
+
+    std::string debugString() const {
+      return fmt::format(
+          "ioWaitOnThreadUs {}, ioDelayUs {}", ioWaitOnThreadUs, ioDelayUs);
+    }
+  } testSettings[] = {
+      // The I/O completes within the wait, so the driver continues on the
+      // thread.
+      {10'000'000, 10'000, true},
+      // The I/O completes after the wait, so the driver goes off thread and
+      // is enqueued again when the I/O completes.
+      {1'000, 500'000, false}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    CountingExecutor executor(driverExecutor_.get());
+    IoWaitResult result;
+    auto plan = PlanBuilder()
+                    .values({rows})
+                    .addNode([&](const core::PlanNodeId& id,
+                                 const core::PlanNodePtr& input) {
+                      return std::make_shared<IoWaitNode>(
+                          id, input, testData.ioDelayUs, &executor, &result);
+                    })
+                    .planFragment();
+    std::unordered_map<std::string, std::string> queryConfig{
+        {core::QueryConfig::kDriverIoWaitOnThreadUs,
+         std::to_string(testData.ioWaitOnThreadUs)}};
+    auto task = Task::create(
+        "t0",
+        plan,
+        0,
+        core::QueryCtx::create(
+            &executor, core::QueryConfig{std::move(queryConfig)}),
+        Task::ExecutionMode::kParallel,
+        [](RowVectorPtr /*unused*/, bool drained, ContinueFuture* /*unused*/) {
+          VELOX_CHECK(!drained);
+          return exec::BlockingReason::kNotBlocked;
+        });
+    task->start(1, 1);
+    ASSERT_TRUE(waitForTaskCompletion(task.get(), 10'000'000));
+    task.reset();
+    waitForAllTasksToBeDeleted();
+
+    ASSERT_NE(result.resumedThreadId, std::thread::id());
+    if (testData.resumedOnThread) {
+      ASSERT_EQ(result.resumedThreadId, result.blockedThreadId);
+      ASSERT_EQ(result.numAddsWhileBlocked, 0);
+    } else {
+      ASSERT_GE(result.numAddsWhileBlocked, 1);
+    }
+  }
+}
@@ -18,6 +18,7 @@
 #include <atomic>
 #include <thread>
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/InProcessExchangeSource.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
@@ -283,6 +284,65 @@ TEST_P(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+// Verify that with adaptive flow control a slow consumer shrinks the bytes the
+// client keeps queued and in flight below the maximum.
+TEST_P(ExchangeClientTest, adaptiveFlowControl) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+
+  auto client = std::make_shared<ExchangeClient>(
+      "adaptive.flow.control",
+      17,
+      ExchangeClient::kDefaultMaxQueuedBytes,
+      1,
+      1024,
+      pool(),
+      executor(),
+      10,
+      /*adaptiveFlowControl=*/true);
+  ASSERT_EQ(
+      client->stats().at("exchangeCreditBytes").sum,
+      ExchangeClient::kDefaultMaxQueuedBytes);
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < 3; ++i) {
+    auto taskId = fmt::format("local://t{}", i);
+    auto task = makeTask(taskId);
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+    for (auto j = 0; j < 3; ++j) {
+      enqueue(taskId, 17, data);
+    }
+    tasks.push_back(task);
+    client->addRemoteTaskId(taskId);
+  }
+
+  // Drain one page every 10ms.
+  for (auto i = 0; i < 3 * tasks.size(); ++i) {
+    fetchPages(1, *client, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+
+  const auto stats = client->stats();
+  EXPECT_EQ(9, stats.at("numReceivedPages").sum);
+  EXPECT_GT(stats.at("exchangeDrainBytesPerSec").sum, 0);
+  EXPECT_GT(stats.at("exchangeRequestRttNanos").sum, 0);
+  EXPECT_LT(
+      stats.at("exchangeCreditBytes").sum,
+      ExchangeClient::kDefaultMaxQueuedBytes);
+  EXPECT_GE(stats.at("exchangeCreditBytes").sum, 1024);
+  EXPECT_EQ(
+      stats.at("exchangeQueueWaitNanos").unit, RuntimeCounter::Unit::kNanos);
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+
+  client->close();
+}
+
 // Test that small pages will block and we will keep
 // requesting from the queue if we do not have enough buffer
 // to fillout minOutputBatchBytes
@@ -360,6 +420,66 @@ TEST_P(ExchangeClientTest, largeSinglePage) {
   client->close();
 }
 
+TEST_P(ExchangeClientTest, inProcessExchangeSource) {
+  InProcessExchangeSource::registerFactory();
+  auto data = {
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}),
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3, 4, 5})}),
+      makeRowVector({makeFlatVector<int32_t>({1, 2})}),
+  };
+
+  auto task = makeTask("in-process-producer");
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 1, 1);
+  auto client = std::make_shared<ExchangeClient>(
+      "t",
+      0,
+      ExchangeClient::kDefaultMaxQueuedBytes,
+      1,
+      kDefaultMinExchangeOutputBatchBytes,
+      pool(),
+      executor());
+
+  // A task without an output buffer in this process is left to the next
+  // factory.
+  ASSERT_EQ(
+      InProcessExchangeSource::create("unknown", 0, client->queue(), pool()),
+      nullptr);
+
+  client->addRemoteTaskId(task->taskId());
+  uint64_t totalBytes{0};
+  for (auto vector : data) {
+    totalBytes += enqueue(task->taskId(), 0, vector);
+  }
+  bufferManager_->noMoreData(task->taskId());
+
+  auto pages = fetchPages(1, *client, 3);
+  uint64_t receivedBytes{0};
+  for (const auto& page : pages) {
+    receivedBytes += page->size();
+  }
+  ASSERT_EQ(receivedBytes, totalBytes);
+
+  bool atEnd{false};
+  ContinueFuture future;
+  auto morePages = client->next(1, 1, &atEnd, &future);
+  while (!atEnd) {
+    ASSERT_TRUE(morePages.empty());
+    auto& exec = folly::QueuedImmediateExecutor::instance();
+    std::move(future).via(&exec).wait();
+    morePages = client->next(1, 1, &atEnd, &future);
+  }
+  ASSERT_TRUE(morePages.empty());
+
+  const auto stats = client->stats();
+  ASSERT_EQ(stats.at(InProcessExchangeSource::kNumPages).sum, 3);
+  ASSERT_EQ(stats.at(InProcessExchangeSource::kTotalBytes).sum, totalBytes);
+
+  task->requestCancel();
+  bufferManager_->removeTask(task->taskId());
+  client->close();
+}
+
 TEST_P(ExchangeClientTest, multiPageFetch) {
   auto client = std::make_shared<ExchangeClient>(
       "test",
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/exec/ForwardSubExpressions.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -314,6 +315,73 @@ TEST_F(FilterProjectTest, filterProjectFused) {
       "SELECT c0, c1, c0 %100 + c1 % 50, c0 % 100 FROM tmp WHERE c0 % 10 < 5");
 }
 
+TEST_F(FilterProjectTest, forwardSubExpressions) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+        makeFlatVector<std::string>(
+            100, [](auto row) { return std::string(row % 7, 'a' + row % 5); }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodePtr values;
+  core::PlanNodePtr filter;
+  core::PlanNodePtr first;
+  core::PlanNodePtr second;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .capturePlanNode(values)
+                  .filter("length(c1) > 2")
+                  .capturePlanNode(filter)
+                  .project({"c0", "c1", "upper(c1) AS u", "rand(c0) AS v"})
+                  .capturePlanNode(first)
+                  .project(
+                      {"c0 + length(c1) AS x",
+                       "concat(u, '!') AS y",
+                       "upper(c1) AS z",
+                       "rand(c0) AS r"})
+                  .capturePlanNode(second)
+                  .planNode();
+
+  // 'length(c1)' is forwarded from the filter and 'upper(c1)' is read from
+  // 'u'. 'rand(c0)' is not deterministic.
+  std::vector<core::PlanNodePtr> planNodes{values, filter, first, second};
+  forwardSubExpressions(planNodes);
+  ASSERT_EQ(planNodes[1], filter);
+  ASSERT_EQ(planNodes[2]->id(), first->id());
+  ASSERT_EQ(planNodes[3]->id(), second->id());
+  ASSERT_EQ(
+      *planNodes[2]->outputType(),
+      *ROW({"c0", "c1", "u", "v", "__forwarded0"},
+           {BIGINT(), VARCHAR(), VARCHAR(), BIGINT(), BIGINT()}));
+  ASSERT_EQ(*planNodes[3]->outputType(), *second->outputType());
+  const auto& projections =
+      std::dynamic_pointer_cast<const core::ProjectNode>(planNodes[3])
+          ->projections();
+  ASSERT_EQ(projections[0]->toString(), "plus(\"c0\",\"__forwarded0\")");
+  ASSERT_EQ(projections[1], second->projections()[1]);
+  ASSERT_EQ(projections[2]->toString(), "\"u\"");
+  ASSERT_EQ(projections[3], second->projections()[3]);
+
+  plan = PlanBuilder()
+             .values(vectors)
+             .filter("length(c1) > 2")
+             .project({"c0", "c1", "upper(c1) AS u"})
+             .project(
+                 {"c0 + length(c1) AS x",
+                  "concat(u, '!') AS y",
+                  "upper(c1) AS z"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(
+          core::QueryConfig::kPipelineSubExpressionForwardingEnabled, "true")
+      .assertResults(
+          "SELECT c0 + length(c1), upper(c1) || '!', upper(c1) FROM tmp "
+          "WHERE length(c1) > 2");
+}
+
 TEST_F(FilterProjectTest, projectAndIdentityOverLazy) {
   // Verify that a lazy column which is a part of both an identity projection
   // and a regular projection is loaded correctly. This is done by running a
@@ -24,6 +24,7 @@
 #include "velox/exec/Cursor.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/ArbitratorTestUtil.h"
@@ -3474,6 +3475,237 @@ TEST_F(HashJoinTest, lazyVectorPartiallyLoadedInFilterLeftSemiFilter) {
       "SELECT t.c1, t.c2 FROM t WHERE c0 IN (SELECT u.c0 FROM u WHERE t.c0 = u.c0 AND NOT (t.c1 < 15 AND t.c2 >= 0))");
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilter) {
+  const int32_t numSplits = 5;
+  const int32_t numRowsProbe = 10'000;
+  // More distinct build keys than an exact IN-list dynamic filter can hold.
+  const int32_t numRowsBuild = VectorHasher::kMaxDistinct + 10'000;
+  // Spreads the keys so that they do not form a dense range.
+  constexpr int64_t kKeyStride = 7'919;
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    // Every 10th probe row matches a build row.
+    auto rowVector = makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsProbe,
+            [&](auto row) {
+              const int64_t key = i * numRowsProbe + row;
+              return row % 10 == 0 ? key * kKeyStride : key * kKeyStride + 1;
+            }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->getPath(), rowVector);
+  }
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"u_c0", "u_c1"},
+      {makeFlatVector<int64_t>(
+           numRowsBuild, [&](auto row) { return row * kKeyStride; }),
+       makeFlatVector<int64_t>(numRowsBuild, [](auto row) { return row; })})};
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(asRowType(probeVectors[0]->type()))
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    PlanBuilder(planNodeIdGenerator, pool_.get())
+                        .values(buildVectors)
+                        .planNode(),
+                    "",
+                    {"c0", "c1", "u_c1"},
+                    core::JoinType::kInner)
+                .planNode();
+
+  for (const auto maxBloomSize : {0, 16 << 20}) {
+    SCOPED_TRACE(fmt::format("maxBloomSize: {}", maxBloomSize));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .makeInputSplits([&] {
+          std::vector<exec::Split> probeSplits;
+          for (auto& file : tempFiles) {
+            probeSplits.push_back(
+                exec::Split(makeHiveConnectorSplit(file->getPath())));
+          }
+          SplitInput splits;
+          splits.emplace(probeScanId, probeSplits);
+          return splits;
+        })
+        .config(
+            core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize,
+            std::to_string(maxBloomSize))
+        .injectSpill(false)
+        .referenceQuery(
+            "SELECT t.c0, t.c1, u.u_c1 FROM t, u WHERE t.c0 = u.u_c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          if (maxBloomSize == 0) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+          } else {
+            ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+            ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+            // The Bloom filter drops most of the non-matching probe rows.
+            ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits / 5);
+          }
+        })
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, lazyBuildColumns) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t_k", "t_v"},
+        {makeFlatVector<int64_t>(1'000, [&](auto row) { return row + i * 7; }),
+         makeFlatVector<int64_t>(1'000, [](auto row) { return row; })}));
+  }
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"u_k", "u_v", "u_s"},
+      {makeFlatVector<int64_t>(500, [](auto row) { return row * 3; }),
+       makeFlatVector<int64_t>(
+           500, [](auto row) { return row % 17; }, nullEvery(11)),
+       makeFlatVector<std::string>(500, [](auto row) {
+         return fmt::format("string value {}", row);
+       })})};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  // The filter after the join reads u_v of the matches and u_s of the rows that
+  // pass.
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"t_k"},
+                        {"u_k"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "",
+                        {"t_k", "t_v", "u_v", "u_s"},
+                        joinType)
+                    .filter("t_v % 3 = 0 AND coalesce(u_v, 0) < 5")
+                    .planNode();
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(plan)
+        .config(core::QueryConfig::kHashProbeLazyBuildColumnsEnabled, "true")
+        .injectSpill(false)
+        .referenceQuery(fmt::format(
+            "SELECT t_k, t_v, u_v, u_s FROM t {} JOIN u ON t_k = u_k "
+            "WHERE t_v % 3 = 0 AND coalesce(u_v, 0) < 5",
+            joinType == core::JoinType::kInner ? "INNER" : "LEFT"))
+        .run();
+  }
+}
+
+DEBUG_ONLY_TEST_F(HashJoinTest, sharedBuildTable) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t_k", "t_v"},
+        {makeFlatVector<int64_t>(1'000, [&](auto row) { return row + i * 7; }),
+         makeFlatVector<int64_t>(1'000, [](auto row) { return row; })}));
+  }
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"u_k", "u_v"},
+      {makeFlatVector<int64_t>(500, [](auto row) { return row * 3; }),
+       makeFlatVector<int64_t>(500, [](auto row) { return row % 17; })})};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .hashJoin(
+                      {"t_k"},
+                      {"u_k"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "",
+                      {"t_k", "t_v", "u_v"})
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+
+  const std::string queryId = "sharedBuildTable";
+  auto queryCtx = core::QueryCtx::create(
+      driverExecutor_.get(),
+      core::QueryConfig(
+          {{core::QueryConfig::kSharedHashJoinNodeIds, joinNodeId}}),
+      {},
+      cache::AsyncDataCache::getInstance(),
+      nullptr,
+      nullptr,
+      queryId);
+  const std::string referenceQuery =
+      "SELECT t_k, t_v, u_v FROM t, u WHERE t_k = u_k";
+  const auto sharedTableStat = [&](const std::shared_ptr<Task>& task,
+                                   const std::string& name) {
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& customStats = planStats.at(joinNodeId).customStats;
+    const auto it = customStats.find(name);
+    return it == customStats.end() ? 0 : it->second.sum;
+  };
+
+  // Holds the published table as if another task were still probing it.
+  std::shared_ptr<BaseHashTable> heldTable;
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::isBlocked",
+      std::function<void(Operator*)>([&](Operator* op) {
+        if (op->operatorType() != "HashProbe" || heldTable != nullptr) {
+          return;
+        }
+        bool hasNullKeys{false};
+        heldTable =
+            HashTableCache::instance()->get(queryId, joinNodeId, hasNullKeys);
+      }));
+
+  // The first task builds and publishes the table.
+  auto firstTask = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                       .queryCtx(queryCtx)
+                       .assertResults(referenceQuery);
+  ASSERT_EQ(
+      1, sharedTableStat(firstTask, BaseHashTable::kSharedTablePublished));
+  ASSERT_EQ(0, sharedTableStat(firstTask, BaseHashTable::kSharedTableReused));
+  ASSERT_EQ(1, HashTableCache::instance()->testingNumTables());
+
+  // The second task of the query drops its build input and probes the table of
+  // the first task.
+  auto secondTask = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                        .queryCtx(queryCtx)
+                        .assertResults(referenceQuery);
+  ASSERT_EQ(
+      0, sharedTableStat(secondTask, BaseHashTable::kSharedTablePublished));
+  ASSERT_EQ(1, sharedTableStat(secondTask, BaseHashTable::kSharedTableReused));
+
+  // The table of the first task outlives it while it is used.
+  firstTask.reset();
+  secondTask.reset();
+  ASSERT_NE(heldTable, nullptr);
+  ASSERT_EQ(1, HashTableCache::instance()->testingNumTables());
+  heldTable.reset();
+  ASSERT_EQ(0, HashTableCache::instance()->testingNumTables());
+
+  // A query which does not list the join builds a table per task.
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .assertResults(referenceQuery);
+  ASSERT_EQ(0, sharedTableStat(task, BaseHashTable::kSharedTablePublished));
+  ASSERT_EQ(0, HashTableCache::instance()->testingNumTables());
+}
+
 TEST_F(HashJoinTest, dynamicFilters) {
   const int32_t numSplits = 10;
   const int32_t numRowsProbe = 333;
@@ -4809,6 +5041,176 @@ TEST_F(HashJoinTest, spillFileSize) {
   }
 }
 
+TEST_F(HashJoinTest, spillCompactColumns) {
+  std::vector<RowVectorPtr> probeVectors =
+      makeBatches(4, [&](uint32_t /*unused*/) {
+        return makeRowVector(
+            {"t0", "t1"},
+            {makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+             makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+      });
+  std::vector<RowVectorPtr> buildVectors =
+      makeBatches(4, [&](uint32_t batch) {
+        return makeRowVector(
+            {"u0", "u1", "u2", "u3", "u4"},
+            {makeFlatVector<int32_t>(
+                 1'000, [&](auto row) { return (row * 7 + batch) % 1'500; }),
+             makeFlatVector<int64_t>(
+                 1'000,
+                 [&](auto row) { return 1'000'000'000'000L - row % 200; },
+                 nullEvery(11)),
+             makeFlatVector<int32_t>(
+                 1'000, [&](auto row) { return -row * 37 + batch; }),
+             makeFlatVector<int16_t>(
+                 1'000, [](auto row) { return row % 100; }, nullEvery(3)),
+             makeFlatVector<int64_t>(1'000, [&](auto row) {
+               return (row + batch) * 1'000'000'007L;
+             })});
+      });
+
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .probeKeys({"t0"})
+      .probeVectors(std::move(probeVectors))
+      .buildKeys({"u0"})
+      .buildVectors(std::move(buildVectors))
+      .joinOutputLayout({"t1", "u1", "u2", "u3", "u4"})
+      .referenceQuery(
+          "SELECT t1, u1, u2, u3, u4 FROM t, u WHERE t.t0 = u.u0")
+      .config(core::QueryConfig::kJoinSpillCompactColumnsEnabled, "true")
+      .run();
+}
+
+TEST_F(HashJoinTest, sortMergeFallback) {
+  std::vector<RowVectorPtr> probeVectors =
+      makeBatches(4, [&](uint32_t batch) {
+        return makeRowVector(
+            {"t0", "t1", "t2"},
+            {makeFlatVector<int32_t>(
+                 1'000, [&](auto row) { return (row + batch) % 300; },
+                 nullEvery(13)),
+             makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+             makeFlatVector<StringView>(1'000, [](auto row) {
+               return StringView::makeInline(std::to_string(row % 50));
+             })});
+      });
+  std::vector<RowVectorPtr> buildVectors =
+      makeBatches(4, [&](uint32_t batch) {
+        return makeRowVector(
+            {"u0", "u1", "u2"},
+            {makeFlatVector<int32_t>(
+                 1'000,
+                 [&](auto row) { return (row * 7 + batch) % 500; },
+                 nullEvery(17)),
+             makeFlatVector<StringView>(1'000, [](auto row) {
+               return StringView::makeInline(std::to_string(row % 50));
+             }),
+             makeFlatVector<int64_t>(
+                 1'000, [&](auto row) { return row + batch; }, nullEvery(5))});
+      });
+
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .probeKeys({"t0", "t2"})
+      .probeVectors(std::move(probeVectors))
+      .buildKeys({"u0", "u1"})
+      .buildVectors(std::move(buildVectors))
+      .joinOutputLayout({"t1", "t2", "u0", "u2"})
+      .referenceQuery(
+          "SELECT t1, t2, u0, u2 FROM t, u WHERE t.t0 = u.u0 AND t.t2 = u.u1")
+      .config(core::QueryConfig::kHashJoinSortMergeFallbackEnabled, "true")
+      .checkSpillStats(false)
+      .maxSpillLevel(0)
+      .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+        if (!hasSpill) {
+          return;
+        }
+        auto opStats = toOperatorStats(task->taskStats());
+        ASSERT_GT(
+            opStats.at("HashProbe").runtimeStats["sortMergeJoinFallbacks"].sum,
+            0);
+      })
+      .run();
+}
+
+DEBUG_ONLY_TEST_F(HashJoinTest, sortMergeFallbackReclaim) {
+  std::vector<RowVectorPtr> probeVectors =
+      makeBatches(4, [&](uint32_t batch) {
+        return makeRowVector(
+            {"t0", "t1", "t2"},
+            {makeFlatVector<int32_t>(
+                 1'000, [&](auto row) { return (row + batch) % 300; },
+                 nullEvery(13)),
+             makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+             makeFlatVector<StringView>(1'000, [](auto row) {
+               return StringView::makeInline(std::to_string(row % 50));
+             })});
+      });
+  std::vector<RowVectorPtr> buildVectors =
+      makeBatches(4, [&](uint32_t batch) {
+        return makeRowVector(
+            {"u0", "u1", "u2"},
+            {makeFlatVector<int32_t>(
+                 1'000,
+                 [&](auto row) { return (row * 7 + batch) % 500; },
+                 nullEvery(17)),
+             makeFlatVector<StringView>(1'000, [](auto row) {
+               return StringView::makeInline(std::to_string(row % 50));
+             }),
+             makeFlatVector<int64_t>(
+                 1'000, [&](auto row) { return row + batch; }, nullEvery(5))});
+      });
+
+  // Reclaims from the probe operators while they join a restored partition
+  // with the sort merge fallback and checks that the sorted rows are spilled.
+  std::atomic_int numReclaims{0};
+  std::atomic_int numReclaimsWithRelease{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::getOutput",
+      std::function<void(Operator*)>([&](Operator* op) {
+        if (!isHashProbeMemoryPool(*op->pool())) {
+          return;
+        }
+        auto* probeOp = static_cast<HashProbe*>(op);
+        if (!probeOp->testingHasSortMergeJoin()) {
+          return;
+        }
+        ASSERT_TRUE(op->canReclaim());
+        const auto usedBytes = op->pool()->usedBytes();
+        testingRunArbitration(op->pool());
+        ASSERT_LE(op->pool()->usedBytes(), usedBytes);
+        ++numReclaims;
+        if (op->pool()->usedBytes() < usedBytes) {
+          ++numReclaimsWithRelease;
+        }
+      }));
+
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .probeKeys({"t0", "t2"})
+      .probeVectors(std::move(probeVectors))
+      .buildKeys({"u0", "u1"})
+      .buildVectors(std::move(buildVectors))
+      .joinOutputLayout({"t1", "t2", "u0", "u2"})
+      .referenceQuery(
+          "SELECT t1, t2, u0, u2 FROM t, u WHERE t.t0 = u.u0 AND t.t2 = u.u1")
+      .config(core::QueryConfig::kHashJoinSortMergeFallbackEnabled, "true")
+      .checkSpillStats(false)
+      .maxSpillLevel(0)
+      .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+        if (!hasSpill) {
+          return;
+        }
+        auto opStats = toOperatorStats(task->taskStats());
+        ASSERT_GT(
+            opStats.at("HashProbe").runtimeStats["sortMergeJoinFallbacks"].sum,
+            0);
+        ASSERT_GT(numReclaims, 0);
+        ASSERT_GT(numReclaimsWithRelease, 0);
+      })
+      .run();
+}
+
 TEST_F(HashJoinTest, spillPartitionBitsOverlap) {
   auto builder =
       HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
@@ -152,6 +152,8 @@ class HashTableTest : public testing::TestWithParam<bool>,
       startOffset += size;
     }
 
+    topTable_->setRadixPartitionBytes(radixPartitionBytes_);
+    topTable_->testingSetBatchedNormalizedKeyProbe(batchedNormalizedKeyProbe_);
     const uint64_t estimatedTableSize =
         topTable_->estimateHashTableSize(numRows);
     const uint64_t usedMemoryBytes = topTable_->rows()->pool()->usedBytes();
@@ -163,6 +165,9 @@ class HashTableTest : public testing::TestWithParam<bool>,
         estimatedTableSize,
         topTable_->rows()->pool()->usedBytes() - usedMemoryBytes);
     ASSERT_EQ(topTable_->hashMode(), mode);
+    if (radixPartitionBytes_ > 0) {
+      ASSERT_GT(topTable_->testingNumRadixPartitions(), 1);
+    }
     ASSERT_EQ(topTable_->allRows().size(), numWays);
     uint64_t rowCount{0};
     for (auto* rowContainer : topTable_->allRows()) {
@@ -587,6 +592,10 @@ class HashTableTest : public testing::TestWithParam<bool>,
   int64_t keySpacing_ = 1;
   // Base string for varchar fields when making string vector.
   std::string baseString_;
+  // Target size of a radix partition of the join table. 0 means the table is
+  // not radix partitioned.
+  uint64_t radixPartitionBytes_{0};
+  bool batchedNormalizedKeyProbe_{true};
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -639,6 +648,30 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, radixPartitionedNormalizedKey) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  radixPartitionBytes_ = 16 << 10;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, normalizedKeyProbeByRow) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  batchedNormalizedKeyProbe_ = false;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, radixPartitionedHash) {
+  auto type =
+      ROW({"key"}, {ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), BIGINT()})});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  radixPartitionBytes_ = 16 << 10;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 4, type, 1);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clearBeforeInsert) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -1100,6 +1100,131 @@ TEST_F(LocalPartitionTest, vectorPool) {
   ASSERT_FALSE(vectorPool.pop());
 }
 
+TEST_F(LocalPartitionTest, concurrentQueue) {
+  constexpr int kNumProducers = 8;
+  constexpr int kNumConsumers = 4;
+  constexpr int kNumBatches = 1'000;
+  constexpr int64_t kBatchBytes = 100;
+  // Small enough for the producers to block on the consumers.
+  auto memoryManager =
+      std::make_shared<LocalExchangeMemoryManager>(10 * kBatchBytes);
+  auto queue = std::make_shared<LocalExchangeQueue>(
+      memoryManager, std::make_shared<LocalExchangeVectorPool>(0), 0);
+  for (auto i = 0; i < kNumProducers; ++i) {
+    queue->addProducer();
+  }
+  queue->noMoreProducers();
+
+  auto batch = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumProducers; ++i) {
+    threads.emplace_back([&] {
+      for (auto j = 0; j < kNumBatches; ++j) {
+        ContinueFuture future;
+        if (queue->enqueue(batch, kBatchBytes, &future) ==
+            BlockingReason::kWaitForConsumer) {
+          future.wait();
+        }
+      }
+      queue->noMoreData();
+    });
+  }
+  std::atomic_int64_t numRows{0};
+  for (auto i = 0; i < kNumConsumers; ++i) {
+    threads.emplace_back([&] {
+      for (;;) {
+        ContinueFuture future;
+        RowVectorPtr data;
+        bool drained;
+        if (queue->next(&future, pool(), &data, drained) ==
+            BlockingReason::kWaitForProducer) {
+          future.wait();
+          continue;
+        }
+        ASSERT_FALSE(drained);
+        if (data == nullptr) {
+          break;
+        }
+        numRows += data->size();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(numRows, kNumProducers * kNumBatches * batch->size());
+  ASSERT_TRUE(queue->isFinished());
+  ASSERT_EQ(memoryManager->bufferedBytes(), 0);
+}
+
+TEST_F(LocalPartitionTest, closeQueue) {
+  auto memoryManager = std::make_shared<LocalExchangeMemoryManager>(100);
+  auto queue = std::make_shared<LocalExchangeQueue>(
+      memoryManager, std::make_shared<LocalExchangeVectorPool>(0), 0);
+  queue->addProducer();
+  queue->noMoreProducers();
+
+  auto batch = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  ContinueFuture producerFuture;
+  ASSERT_EQ(
+      queue->enqueue(batch, 100, &producerFuture),
+      BlockingReason::kWaitForConsumer);
+  ASSERT_EQ(memoryManager->bufferedBytes(), 100);
+
+  // Closing releases the buffered data and unblocks the producer.
+  queue->close();
+  ASSERT_TRUE(producerFuture.isReady());
+  ASSERT_EQ(memoryManager->bufferedBytes(), 0);
+  ASSERT_TRUE(queue->isFinished());
+
+  // Data added after close is dropped.
+  ContinueFuture future;
+  ASSERT_EQ(queue->enqueue(batch, 100, &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(memoryManager->bufferedBytes(), 0);
+  RowVectorPtr data;
+  bool drained;
+  ASSERT_EQ(
+      queue->next(&future, pool(), &data, drained),
+      BlockingReason::kNotBlocked);
+  ASSERT_TRUE(data == nullptr);
+}
+
+TEST_F(LocalPartitionTest, compactStrings) {
+  std::vector<RowVectorPtr> vectors = {makeRowVector(
+      {makeFlatSequence<int32_t>(0, 1'000),
+       makeFlatVector<std::string>(1'000, [](auto row) {
+         return fmt::format("{:050}", row);
+       })})};
+  createDuckDbTable(vectors);
+
+  // The filter keeps 1% of the strings, which reference the string buffer of
+  // all the rows.
+  core::PlanNodeId partitionId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .filter("c0 % 100 = 0")
+                  .localPartition(std::vector<std::string>{})
+                  .capturePlanNodeId(partitionId)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .assertResults("SELECT * FROM tmp WHERE c0 % 100 = 0");
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(
+      planStats.at(partitionId)
+          .customStats.at("numCompactedStringColumns")
+          .sum,
+      1);
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(
+                 core::QueryConfig::kLocalExchangeStringCompactionRatio, "0")
+             .assertResults("SELECT * FROM tmp WHERE c0 % 100 = 0");
+  planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(
+      planStats.at(partitionId).customStats.count("numCompactedStringColumns"),
+      0);
+}
+
 TEST_F(LocalPartitionTest, barrier) {
   const auto rowType = ROW({"c0"}, {BIGINT()});
   std::vector<RowVectorPtr> vectors;
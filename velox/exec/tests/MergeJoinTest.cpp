@@ -434,6 +434,58 @@ TEST_F(MergeJoinTest, keySkew) {
       [](auto row) { return row < 10 ? row : row + 10240; });
 }
 
+TEST_F(MergeJoinTest, keyGapsAndOneToOneRuns) {
+  // Blocks of unique keys that match one to one, separated by gaps that one
+  // side skips.
+  testJoin<int32_t>(
+      [](auto row) { return row + row / 1'000 * 1'000; },
+      [](auto row) { return row; });
+  testJoin<int32_t>(
+      [](auto row) { return row; },
+      [](auto row) { return row + row / 300 * 700; });
+
+  // One to one runs interrupted by duplicate keys.
+  testJoin<int32_t>(
+      [](auto row) { return row % 100 == 0 ? row - 1 : row; },
+      [](auto row) { return row % 77 == 0 ? row - 1 : row; });
+}
+
+TEST_F(MergeJoinTest, multiKeyNullsInsideRuns) {
+  // Nulls in the second key sit between non-null keys, which the rows skipped
+  // without output must not jump over.
+  auto left = makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>({1, 1, 1, 1, 1, 2, 2, 3}),
+       makeNullableFlatVector<int64_t>(
+           {0, 2, std::nullopt, std::nullopt, 5, 0, 1, 1})});
+  auto right = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>({1, 1, 1, 2, 3}),
+       makeFlatVector<int64_t>({1, 2, 5, 1, 1})});
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values({left})
+            .mergeJoin(
+                {"t0", "t1"},
+                {"u0", "u1"},
+                PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                "",
+                {"t0", "t1", "u0", "u1"},
+                joinType)
+            .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .assertResults(fmt::format(
+            "SELECT * FROM t {} JOIN u ON t.t0 = u.u0 AND t.t1 = u.u1",
+            joinType == core::JoinType::kInner ? "INNER" : "LEFT"));
+  }
+}
+
 TEST_F(MergeJoinTest, aggregationOverJoin) {
   auto left =
       makeRowVector({"t_c0"}, {makeFlatVector<int32_t>({1, 2, 3, 4, 5})});
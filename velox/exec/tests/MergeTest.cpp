@@ -16,6 +16,7 @@
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/Merge.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -157,6 +158,38 @@ TEST_F(MergeTest, localMerge) {
   testTwoKeys(vectors, "c3", "c0");
 }
 
+TEST_F(MergeTest, normalizedKeys) {
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    auto c0 = makeFlatVector<int32_t>(
+        batchSize, [&](auto row) { return (row % 97) - 50 + i; }, nullEvery(7));
+    auto c1 = makeFlatVector<double>(
+        batchSize,
+        [&](auto row) { return (row % 13) * -0.5 + i; },
+        nullEvery(11));
+    auto c2 = makeFlatVector<int16_t>(
+        batchSize, [&](auto row) { return row % 5 - 2; });
+    auto c3 = makeFlatVector<StringView>(batchSize, [](auto row) {
+      return StringView::makeInline(std::to_string(row));
+    });
+    vectors.push_back(makeRowVector({c0, c1, c2, c3}));
+  }
+  createDuckDbTable(vectors);
+
+  const auto& rowType = vectors[0]->type()->asRow();
+  const std::vector<SpillSortKey> fixedWidthKeys = {
+      {0, CompareFlags{}}, {1, CompareFlags{}}, {2, CompareFlags{}}};
+  ASSERT_EQ(
+      SourceStream::normalizedKeySize(rowType, fixedWidthKeys), 5 + 9 + 3);
+  ASSERT_FALSE(
+      SourceStream::normalizedKeySize(rowType, {{0, {}}, {3, {}}}).has_value());
+
+  testSingleKey(vectors, "c1");
+  testTwoKeys(vectors, "c0", "c1");
+  testTwoKeys(vectors, "c2", "c0");
+}
+
 DEBUG_ONLY_TEST_F(MergeTest, localMergeStart) {
   const auto data1 = makeRowVector({
       makeFlatVector<int64_t>({0, 1, 10}),
@@ -399,6 +399,86 @@ TEST_P(MultiFragmentTest, aggregationMultiKey) {
   }
 }
 
+TEST_P(MultiFragmentTest, combinePartialAggregates) {
+  setupSources(10, 1'000);
+  // Abandons the partial aggregation right away so that the rows of the same
+  // keys reach PartitionedOutput many times.
+  configSettings_[core::QueryConfig::kShuffleCombinePartialAggregates] =
+      "true";
+  configSettings_[core::QueryConfig::kAbandonPartialAggregationMinRows] =
+      "100";
+  configSettings_[core::QueryConfig::kAbandonPartialAggregationMinPct] = "0";
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  auto leafTaskId = makeTaskId("leaf", 0);
+  core::PlanNodePtr partialAggPlan;
+  core::PlanNodeId partitionNodeId;
+  std::shared_ptr<Task> leafTask;
+  {
+    partialAggPlan =
+        PlanBuilder()
+            .tableScan(rowType_)
+            .project({"c0 % 10 AS c0", "c1", "c2"})
+            .partialAggregation({"c0"}, {"sum(c1)", "avg(c2)", "max(c1)"})
+            .partitionedOutput(
+                {"c0"}, 3, /*outputLayout=*/{}, GetParam().serdeKind)
+            .capturePlanNodeId(partitionNodeId)
+            .planNode();
+
+    leafTask = makeTask(leafTaskId, partialAggPlan, 0);
+    tasks.push_back(leafTask);
+    leafTask->start(4);
+    addHiveSplits(leafTask, filePaths_);
+  }
+
+  core::PlanNodePtr finalAggPlan;
+  std::vector<std::string> finalAggTaskIds;
+  for (int i = 0; i < 3; i++) {
+    finalAggPlan =
+        PlanBuilder()
+            .exchange(partialAggPlan->outputType(), GetParam().serdeKind)
+            .finalAggregation(
+                {"c0"},
+                {"sum(a0)", "avg(a1)", "max(a2)"},
+                {{INTEGER()}, {SMALLINT()}, {INTEGER()}})
+            .partitionedOutput({}, 1, /*outputLayout=*/{}, GetParam().serdeKind)
+            .planNode();
+
+    finalAggTaskIds.push_back(makeTaskId("final-agg", i));
+    auto task = makeTask(finalAggTaskIds.back(), finalAggPlan, i);
+    tasks.push_back(task);
+    task->start(1);
+    addRemoteSplits(task, {leafTaskId});
+  }
+
+  auto op = PlanBuilder()
+                .exchange(finalAggPlan->outputType(), GetParam().serdeKind)
+                .planNode();
+
+  std::vector<Split> finalAggTaskSplits;
+  for (auto finalAggTaskId : finalAggTaskIds) {
+    finalAggTaskSplits.emplace_back(remoteSplit(finalAggTaskId));
+  }
+  test::AssertQueryBuilder(op, duckDbQueryRunner_)
+      .splits(std::move(finalAggTaskSplits))
+      .config(
+          core::QueryConfig::kShuffleCompressionKind,
+          common::compressionKindToString(GetParam().compressionKind))
+      .assertResults(
+          "SELECT c0 % 10, sum(c1), avg(c2), max(c1) FROM tmp GROUP BY 1");
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+
+  // Each of the 4 drivers sends at most one row per key.
+  const auto leafPlanStats = toPlanStats(leafTask->taskStats());
+  const auto& customStats = leafPlanStats.at(partitionNodeId).customStats;
+  ASSERT_EQ(customStats.at(PartitionedOutput::kCombinerInputRows).sum, 10'000);
+  ASSERT_LE(customStats.at(PartitionedOutput::kCombinerOutputRows).sum, 40);
+  ASSERT_LE(leafPlanStats.at(partitionNodeId).outputRows, 40);
+}
+
 TEST_P(MultiFragmentTest, distributedTableScan) {
   setupSources(10, 1000);
   // Run the table scan several times to test the caching.
@@ -56,6 +56,14 @@ class NestedLoopJoinTest : public HiveConnectorTestBase {
     joinTypes_ = std::move(joinTypes);
   }
 
+  void setSortedBuild(bool sortedBuild) {
+    sortedBuild_ = sortedBuild;
+  }
+
+  void setSpatialIndex(bool spatialIndex) {
+    spatialIndex_ = spatialIndex;
+  }
+
   template <typename T>
   VectorPtr sequence(vector_size_t size, T start = 0) {
     return makeFlatVector<int32_t>(
@@ -93,7 +101,11 @@ class NestedLoopJoinTest : public HiveConnectorTestBase {
     params.queryCtx = queryCtx;
     params.queryCtx->testingOverrideConfigUnsafe(
         {{core::QueryConfig::kPreferredOutputBatchRows,
-          std::to_string(preferredOutputBatchSize)}});
+          std::to_string(preferredOutputBatchSize)},
+         {core::QueryConfig::kNestedLoopJoinSortedBuildEnabled,
+          sortedBuild_ ? "true" : "false"},
+         {core::QueryConfig::kNestedLoopJoinSpatialIndexEnabled,
+          spatialIndex_ ? "true" : "false"}});
     params.maxDrivers = numDrivers;
     auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
 
@@ -139,6 +151,8 @@ class NestedLoopJoinTest : public HiveConnectorTestBase {
       core::JoinType::kRight,
       core::JoinType::kFull,
   };
+  bool sortedBuild_{false};
+  bool spatialIndex_{false};
   std::vector<std::string> outputLayout_{probeKeyName_, buildKeyName_};
   std::string joinConditionStr_{probeKeyName_ + " {} " + buildKeyName_};
   std::string queryStr_{fmt::format(
@@ -219,6 +233,133 @@ TEST_F(NestedLoopJoinTest, basic) {
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
 
+TEST_F(NestedLoopJoinTest, sortedBuild) {
+  auto probeVectors = makeBatches(20, 5, probeType_, pool_.get());
+  auto buildVectors = makeBatches(18, 5, buildType_, pool_.get());
+  setSortedBuild(true);
+  setComparisons({"<", "<=", ">", ">="});
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+
+  // Empty build side.
+  runSingleAndMultiDriverTest(
+      probeVectors, makeBatches(0, 5, buildType_, pool_.get()));
+}
+
+TEST_F(NestedLoopJoinTest, sortedBuildBandJoin) {
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 4; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int64_t>(
+             50, [&](auto row) { return (row * 7 + i) % 101; }, nullEvery(9)),
+         makeFlatVector<int64_t>(50, [&](auto row) { return row % 5; })}));
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(
+             30, [&](auto row) { return (row * 13 + i) % 97; }, nullEvery(7)),
+         makeFlatVector<int64_t>(30, [&](auto row) { return row % 3; })}));
+  }
+  setSortedBuild(true);
+  setComparisons({""});
+  setJoinTypes(
+      {core::JoinType::kInner,
+       core::JoinType::kLeft,
+       core::JoinType::kRight,
+       core::JoinType::kFull});
+
+  // A band on 'u0' with a residual condition.
+  setJoinConditionStr("u0 BETWEEN t0 - 5 AND t0 + 5 AND t1 > u1");
+  setQueryStr(
+      "SELECT t0, u0 FROM t {0} JOIN u "
+      "ON u0 BETWEEN t0 - 5 AND t0 + 5 AND t1 > u1");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+
+  // Exclusive bounds from separate comparisons.
+  setJoinConditionStr("t0 - 3 < u0 AND u0 < t0 + 3");
+  setQueryStr("SELECT t0, u0 FROM t {0} JOIN u ON t0 - 3 < u0 AND u0 < t0 + 3");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+
+  // The probe value between two build columns. Only 'u0' is searched.
+  setOutputLayout({"t0", "u0", "u1"});
+  setJoinConditionStr("t0 BETWEEN u0 AND u0 + u1 * 10");
+  setQueryStr(
+      "SELECT t0, u0, u1 FROM t {0} JOIN u ON t0 BETWEEN u0 AND u0 + u1 * 10");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
+
+TEST_F(NestedLoopJoinTest, spatialIndex) {
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 4; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "x", "y"},
+        {makeFlatVector<int64_t>(50, [&](auto row) { return i * 50 + row; }),
+         makeFlatVector<double>(
+             50,
+             [&](auto row) {
+               return row % 23 == 0 ? nan : (row * 7 + i) % 101;
+             },
+             nullEvery(11)),
+         makeFlatVector<double>(
+             50, [&](auto row) { return (row * 3 + i) % 103; })}));
+    // Enough build rows for several levels of the index.
+    buildVectors.push_back(makeRowVector(
+        {"u0", "xmin", "xmax", "ymin", "ymax"},
+        {makeFlatVector<int64_t>(300, [&](auto row) { return i * 300 + row; }),
+         makeFlatVector<double>(
+             300, [&](auto row) { return (row * 13 + i) % 97; }, nullEvery(37)),
+         makeFlatVector<double>(
+             300,
+             [&](auto row) {
+               return row % 41 == 0 ? nan : (row * 13 + i) % 97 + row % 5;
+             }),
+         makeFlatVector<double>(
+             300, [&](auto row) { return (row * 17 + i) % 89; }),
+         makeFlatVector<double>(
+             300,
+             [&](auto row) { return (row * 17 + i) % 89 + row % 7; },
+             nullEvery(43))}));
+  }
+  setSpatialIndex(true);
+  setComparisons({""});
+  setJoinTypes(
+      {core::JoinType::kInner,
+       core::JoinType::kLeft,
+       core::JoinType::kRight,
+       core::JoinType::kFull});
+  setOutputLayout({"t0", "u0"});
+
+  // Points in boxes.
+  setJoinConditionStr("x BETWEEN xmin AND xmax AND y BETWEEN ymin AND ymax");
+  setQueryStr(
+      "SELECT t0, u0 FROM t {0} JOIN u "
+      "ON x BETWEEN xmin AND xmax AND y BETWEEN ymin AND ymax");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+
+  // Overlapping boxes with a residual condition.
+  setJoinConditionStr(
+      "xmin <= x + 3.0 AND ymin <= y + 2.0 AND x - 1.0 <= xmax AND "
+      "y - 4.0 <= ymax AND t0 % 3 <> u0 % 3");
+  setQueryStr(
+      "SELECT t0, u0 FROM t {0} JOIN u "
+      "ON xmin <= x + 3.0 AND ymin <= y + 2.0 AND x - 1.0 <= xmax AND "
+      "y - 4.0 <= ymax AND t0 % 3 <> u0 % 3");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+
+  // Empty build side.
+  runSingleAndMultiDriverTest(
+      probeVectors,
+      {makeRowVector(
+          {"u0", "xmin", "xmax", "ymin", "ymax"},
+          {makeFlatVector<int64_t>({}),
+           makeFlatVector<double>({}),
+           makeFlatVector<double>({}),
+           makeFlatVector<double>({}),
+           makeFlatVector<double>({})})});
+}
+
 TEST_F(NestedLoopJoinTest, emptyProbe) {
   auto probeVectors = makeBatches(0, 5, probeType_, pool_.get());
   auto buildVectors = makeBatches(18, 5, buildType_, pool_.get());
@@ -16,6 +16,7 @@
 
 #include <folly/init/Init.h>
 #include <folly/io/Cursor.h>
+#include <folly/json.h>
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -443,6 +444,125 @@ TEST_F(OperatorTraceTest, task) {
   }
 }
 
+TEST_F(OperatorTraceTest, memoryTrace) {
+  const auto rows = makeVectors(10, 1'000);
+  core::PlanNodeId aggregationNodeId;
+  const auto planNode = PlanBuilder()
+                            .values(rows)
+                            .singleAggregation({"a"}, {"sum(b)"})
+                            .capturePlanNodeId(aggregationNodeId)
+                            .planNode();
+  const auto outputDir = TempDirectoryPath::create();
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(planNode)
+      .config(core::QueryConfig::kQueryTraceDir, outputDir->getPath())
+      .config(core::QueryConfig::kQueryTraceMemorySampleIntervalMs, "1")
+      .maxDrivers(1)
+      .copyResults(pool(), task);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+
+  const auto fs = filesystems::getFileSystem(outputDir->getPath(), nullptr);
+  const auto file = fs->openFileForRead(getTaskMemoryTraceFilePath(
+      getTaskTraceDirectory(outputDir->getPath(), *task)));
+  const auto trace = folly::parseJson(file->pread(0, file->size()));
+  ASSERT_EQ(trace[TaskMemoryTraceTraits::kSampleIntervalMsKey].asInt(), 1);
+
+  const auto& samples = trace[TaskMemoryTraceTraits::kSamplesKey];
+  ASSERT_GE(samples.size(), 1);
+  const auto taskPoolName = task->pool()->name();
+  int64_t maxTaskBytes = 0;
+  for (const auto& sample : samples) {
+    const auto& reservedBytes =
+        sample[TaskMemoryTraceTraits::kReservedBytesKey];
+    ASSERT_EQ(reservedBytes.count(taskPoolName), 1);
+    maxTaskBytes =
+        std::max(maxTaskBytes, reservedBytes[taskPoolName].asInt());
+  }
+  ASSERT_GT(maxTaskBytes, 0);
+
+  // The task pool comes first and the peaks are in decreasing order.
+  const auto& peaks = trace[TaskMemoryTraceTraits::kPeaksKey];
+  ASSERT_EQ(peaks[0][TaskMemoryTraceTraits::kPoolKey].asString(), taskPoolName);
+  bool foundAggregation = false;
+  for (auto i = 0; i < peaks.size(); ++i) {
+    const auto peakBytes = peaks[i][TaskMemoryTraceTraits::kPeakBytesKey];
+    if (i > 0) {
+      ASSERT_LE(
+          peakBytes.asInt(),
+          peaks[i - 1][TaskMemoryTraceTraits::kPeakBytesKey].asInt());
+    }
+    if (peaks[i][TaskMemoryTraceTraits::kPoolKey].asString() ==
+        fmt::format("node.{}", aggregationNodeId)) {
+      foundAggregation = true;
+      ASSERT_GT(peakBytes.asInt(), 0);
+    }
+  }
+  ASSERT_TRUE(foundAggregation);
+  ASSERT_TRUE(trace[TaskMemoryTraceTraits::kCallSitesKey].empty());
+}
+
+TEST_F(OperatorTraceTest, timelineTrace) {
+  constexpr auto numSplits = 3;
+  const auto vectors = makeVectors(10, 100);
+  std::vector<std::shared_ptr<TempFilePath>> splitFiles;
+  for (int i = 0; i < numSplits; ++i) {
+    auto filePath = TempFilePath::create();
+    writeToFile(filePath->getPath(), vectors);
+    splitFiles.push_back(std::move(filePath));
+  }
+  const auto planNode = PlanBuilder()
+                            .tableScan(dataType_)
+                            .singleAggregation({"a"}, {"sum(b)"})
+                            .planNode();
+  const auto outputDir = TempDirectoryPath::create();
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(planNode)
+      .config(core::QueryConfig::kQueryTraceDir, outputDir->getPath())
+      .config(core::QueryConfig::kQueryTraceTimelineMaxEvents, "100000")
+      .splits(makeHiveConnectorSplits(splitFiles))
+      .maxDrivers(1)
+      .copyResults(pool(), task);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+
+  const auto fs = filesystems::getFileSystem(outputDir->getPath(), nullptr);
+  const auto file = fs->openFileForRead(getTaskTimelineTraceFilePath(
+      getTaskTraceDirectory(outputDir->getPath(), *task)));
+  const auto trace = folly::parseJson(file->pread(0, file->size()));
+  ASSERT_EQ(trace["otherData"]["numDroppedEvents"].asInt(), 0);
+
+  int32_t numQuanta = 0;
+  int32_t numSplitArrivals = 0;
+  bool foundDriverName = false;
+  for (const auto& event : trace["traceEvents"]) {
+    const auto phase = event["ph"].asString();
+    if (phase == "M") {
+      if (event["name"].asString() == "thread_name" &&
+          event["args"]["name"].asString() == "driver 0") {
+        foundDriverName = true;
+      }
+      continue;
+    }
+    ASSERT_GE(event["ts"].asInt(), 0);
+    const auto category = event["cat"].asString();
+    if (category == "driver") {
+      ASSERT_EQ(phase, "X");
+      ASSERT_EQ(event["pid"].asInt(), 0);
+      ASSERT_EQ(event["tid"].asInt(), 0);
+      ASSERT_GE(event["dur"].asInt(), 0);
+      ++numQuanta;
+    } else if (category == "split") {
+      ASSERT_EQ(phase, "i");
+      ++numSplitArrivals;
+    } else if (category == "blocked") {
+      ASSERT_EQ(phase, "X");
+      ASSERT_EQ(event["tid"].asInt(), 0);
+    }
+  }
+  ASSERT_GT(numQuanta, 0);
+  ASSERT_EQ(numSplitArrivals, numSplits);
+  ASSERT_TRUE(foundDriverName);
+}
+
 TEST_F(OperatorTraceTest, error) {
   const auto planNode = PlanBuilder().values({}).planNode();
   // No trace dir.
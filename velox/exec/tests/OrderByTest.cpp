@@ -23,6 +23,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/exec/OrderBy.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Spiller.h"
 #include "velox/exec/tests/utils/ArbitratorTestUtil.h"
@@ -480,6 +481,57 @@ TEST_F(OrderByTest, outputBatchRows) {
   }
 }
 
+TEST_F(OrderByTest, parallelSort) {
+  constexpr int32_t kNumDrivers = 4;
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](vector_size_t row) { return (row * 7919 + i) % 997; },
+        nullEvery(13));
+    auto c1 = makeFlatVector<StringView>(batchSize, [](vector_size_t row) {
+      return StringView::makeInline(std::to_string(row % 17));
+    });
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  // Each driver reads all the values.
+  std::vector<RowVectorPtr> duckDbVectors;
+  for (auto i = 0; i < kNumDrivers; ++i) {
+    duckDbVectors.insert(duckDbVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(duckDbVectors);
+
+  const std::vector<std::string> keys = {"c0 DESC NULLS FIRST", "c1"};
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId orderById;
+  const auto plan = PlanBuilder(planNodeIdGenerator)
+                        .localMerge(
+                            keys,
+                            {PlanBuilder(planNodeIdGenerator)
+                                 .values(vectors, true)
+                                 .orderBy(keys, false)
+                                 .capturePlanNodeId(orderById)
+                                 .planNode()})
+                        .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .maxDrivers(kNumDrivers)
+                  .config(core::QueryConfig::kOrderByParallelSortEnabled, true)
+                  .assertResults(
+                      "SELECT * FROM tmp ORDER BY c0 DESC NULLS FIRST, c1",
+                      {{0, 1}});
+
+  // Each driver returns one key range.
+  const auto& rangeRows = toPlanStats(task->taskStats())
+                              .at(orderById)
+                              .customStats.at(OrderBy::kParallelSortRangeRows);
+  const int64_t numRows = kNumDrivers * vectors.size() * batchSize;
+  ASSERT_EQ(rangeRows.count, kNumDrivers);
+  ASSERT_EQ(rangeRows.sum, numRows);
+  ASSERT_GT(rangeRows.min, 0);
+  ASSERT_LT(rangeRows.max, numRows / 2);
+}
+
 TEST_F(OrderByTest, spill) {
   const auto rowType =
       ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
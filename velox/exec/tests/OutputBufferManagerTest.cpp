@@ -17,10 +17,13 @@
 #include <gtest/gtest.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/SerializedPageUtil.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/CompactRowSerializer.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/serializers/UnsafeRowSerializer.h"
@@ -58,6 +61,7 @@ class OutputBufferManagerTest : public testing::Test {
 
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+    common::testutil::TestValue::enable();
   }
 
   void SetUp() override {
@@ -89,14 +93,15 @@ class OutputBufferManagerTest : public testing::Test {
       PartitionedOutputNode::Kind kind,
       int numDestinations,
       int numDrivers,
-      int maxOutputBufferSize = 0) {
+      int maxOutputBufferSize = 0,
+      std::unordered_map<std::string, std::string> configSettings = {},
+      const std::string& spillDirectory = "") {
     bufferManager_->removeTask(taskId);
 
     auto planFragment = exec::test::PlanBuilder()
                             .values({std::dynamic_pointer_cast<RowVector>(
                                 BatchMaker::createBatch(rowType, 100, *pool_))})
                             .planFragment();
-    std::unordered_map<std::string, std::string> configSettings;
     if (maxOutputBufferSize != 0) {
       configSettings[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
           std::to_string(maxOutputBufferSize);
@@ -110,6 +115,9 @@ class OutputBufferManagerTest : public testing::Test {
         0,
         std::move(queryCtx),
         Task::ExecutionMode::kParallel);
+    if (!spillDirectory.empty()) {
+      task->setSpillDirectory(spillDirectory);
+    }
 
     bufferManager_->initializeTask(task, kind, numDestinations, numDrivers);
     return task;
@@ -1419,6 +1427,144 @@ TEST_P(AllOutputBufferManagerTest, outputBufferStats) {
   ASSERT_FALSE(bufferManager_->stats(taskId).has_value());
 }
 
+TEST_P(OutputBufferManagerWithDifferentSerdeKindsTest, spill) {
+  filesystems::registerLocalFileSystem();
+  const auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const std::string taskId = "t0";
+  // Every page reaches the max buffer size and is spilled.
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kPartitioned,
+      2,
+      1,
+      0,
+      {{core::QueryConfig::kSpillEnabled, "true"},
+       {core::QueryConfig::kOutputBufferSpillEnabled, "true"},
+       {core::QueryConfig::kMaxOutputBufferSize, "1"}},
+      spillDirectory->getPath());
+
+  constexpr int kNumPages = 10;
+  std::vector<uint64_t> pageSizes;
+  for (int i = 0; i < kNumPages; ++i) {
+    // Does not block as the pages are spilled.
+    pageSizes.push_back(enqueue(taskId, 0, rowType_, 100));
+  }
+  enqueue(taskId, 1, rowType_, 100);
+  auto stats = getStats(taskId);
+  ASSERT_EQ(stats.spilledPages, kNumPages + 1);
+  ASSERT_GT(stats.spilledBytes, 0);
+  ASSERT_EQ(stats.bufferedBytes, 0);
+  ASSERT_EQ(stats.buffersStats[0].pagesBuffered, kNumPages);
+
+  // The spilled pages are read back in order. Each page is fetched twice
+  // before the ack to cover a retried fetch. The pages read back count in the
+  // buffered bytes until acknowledged.
+  for (int i = 0; i < kNumPages; ++i) {
+    for (int retry = 0; retry < 2; ++retry) {
+      bool receivedData = false;
+      ASSERT_TRUE(bufferManager_->getData(
+          taskId,
+          0,
+          1,
+          i,
+          [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+              int64_t sequence,
+              std::vector<int64_t> remainingBytes) {
+            ASSERT_EQ(sequence, i);
+            ASSERT_EQ(pages.size(), 1);
+            ASSERT_EQ(pages[0]->computeChainDataLength(), pageSizes[i]);
+            ASSERT_EQ(remainingBytes.size(), kNumPages - i - 1);
+            for (int j = 0; j < remainingBytes.size(); ++j) {
+              ASSERT_EQ(remainingBytes[j], pageSizes[i + j + 1]);
+            }
+            receivedData = true;
+          }));
+      ASSERT_TRUE(receivedData);
+      stats = getStats(taskId);
+      ASSERT_EQ(stats.bufferedBytes, static_cast<int64_t>(pageSizes[i]));
+      ASSERT_EQ(stats.bufferedPages, 1);
+    }
+    acknowledge(taskId, 0, i + 1);
+    stats = getStats(taskId);
+    ASSERT_EQ(stats.bufferedBytes, 0);
+    ASSERT_EQ(stats.bufferedPages, 0);
+  }
+
+  stats = getStats(taskId);
+  ASSERT_EQ(stats.buffersStats[0].pagesBuffered, 0);
+  ASSERT_EQ(stats.buffersStats[0].pagesSent, kNumPages);
+
+  // Deleting the results of a destination drops its spilled pages.
+  deleteResults(taskId, 1);
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, kNumPages);
+  bufferManager_->removeTask(taskId);
+  EXPECT_TRUE(task->isFinished());
+}
+
+DEBUG_ONLY_TEST_P(
+    OutputBufferManagerWithDifferentSerdeKindsTest,
+    spillOutsideOfLock) {
+  filesystems::registerLocalFileSystem();
+  const auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const std::string taskId = "t0";
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kPartitioned,
+      1,
+      1,
+      0,
+      {{core::QueryConfig::kSpillEnabled, "true"},
+       {core::QueryConfig::kOutputBufferSpillEnabled, "true"},
+       {core::QueryConfig::kMaxOutputBufferSize, "1"}},
+      spillDirectory->getPath());
+
+  // The pages are written to disk outside of the output buffer lock, so the
+  // consumer can fetch and acknowledge the page being spilled meanwhile.
+  std::atomic_bool ackWhileSpilling{true};
+  std::atomic_int numSpills{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::OutputBuffer::spill",
+      std::function<void(OutputBuffer*)>([&](OutputBuffer* /*unused*/) {
+        ++numSpills;
+        if (ackWhileSpilling) {
+          fetchOneAndAck(taskId, 0, 0);
+        } else {
+          fetchOne(taskId, 0, 1);
+        }
+      }));
+
+  // The page acknowledged while being written is not spilled.
+  enqueue(taskId, 0, rowType_, 100);
+  ASSERT_EQ(numSpills, 1);
+  auto stats = getStats(taskId);
+  ASSERT_EQ(stats.spilledPages, 0);
+  ASSERT_EQ(stats.bufferedBytes, 0);
+  ASSERT_EQ(stats.buffersStats[0].pagesSent, 1);
+
+  // The page fetched while being written is spilled and read back on the next
+  // fetch.
+  ackWhileSpilling = false;
+  const auto pageSize = enqueue(taskId, 0, rowType_, 100);
+  ASSERT_EQ(numSpills, 2);
+  stats = getStats(taskId);
+  ASSERT_EQ(stats.spilledPages, 1);
+  ASSERT_EQ(stats.bufferedBytes, 0);
+  fetchOne(taskId, 0, 1);
+  ASSERT_EQ(getStats(taskId).bufferedBytes, static_cast<int64_t>(pageSize));
+  acknowledge(taskId, 0, 2);
+  stats = getStats(taskId);
+  ASSERT_EQ(stats.bufferedBytes, 0);
+  ASSERT_EQ(stats.buffersStats[0].pagesSent, 2);
+
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, 2);
+  bufferManager_->removeTask(taskId);
+  EXPECT_TRUE(task->isFinished());
+}
+
 TEST_P(OutputBufferManagerWithDifferentSerdeKindsTest, outOfOrderAcks) {
   const vector_size_t size = 100;
   const std::string taskId = "t0";
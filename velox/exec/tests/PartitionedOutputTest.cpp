@@ -206,6 +206,127 @@ TEST_P(PartitionedOutputTest, keyChannelNotAtBeginningWithNulls) {
           .count()));
 }
 
+TEST_P(PartitionedOutputTest, columnarPartition) {
+  constexpr vector_size_t kSize = 1'000;
+  constexpr int32_t kNumPartitions = 4;
+  auto input = makeRowVector(
+      {"p1", "v1"},
+      {makeFlatVector<int32_t>(kSize, [](auto row) { return row; }),
+       makeFlatVector<std::string>(
+           kSize, [](auto row) { return fmt::format("value {}", row); })});
+
+  auto plan = PlanBuilder()
+                  .values({input})
+                  .partitionedOutput(
+                      {"p1"},
+                      kNumPartitions,
+                      std::vector<std::string>{"p1", "v1"},
+                      GetParam())
+                  .planNode();
+  auto runTask = [&](const std::string& taskId,
+                     uint32_t minDestinations) {
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        createQueryContext(
+            {{core::QueryConfig::kShuffleColumnarPartitionMinDestinations,
+              std::to_string(minDestinations)}}),
+        Task::ExecutionMode::kParallel);
+    task->start(1);
+    std::vector<std::vector<std::unique_ptr<folly::IOBuf>>> partitions;
+    for (auto i = 0; i < kNumPartitions; ++i) {
+      partitions.push_back(getAllData(taskId, i));
+    }
+    EXPECT_TRUE(waitForTaskCompletion(
+        task.get(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::seconds(10))
+            .count()));
+    return partitions;
+  };
+
+  // Grouping the rows by partition produces the same pages as adding the rows
+  // to the destinations one by one.
+  const auto expected =
+      runTask("local://test-partitioned-output-columnar-partition-0", 0);
+  const auto actual = runTask(
+      "local://test-partitioned-output-columnar-partition-1", kNumPartitions);
+  for (auto i = 0; i < kNumPartitions; ++i) {
+    ASSERT_EQ(actual[i].size(), expected[i].size());
+    for (auto page = 0; page < actual[i].size(); ++page) {
+      ASSERT_TRUE(folly::IOBufEqualTo()(*actual[i][page], *expected[i][page]));
+    }
+  }
+}
+
+TEST_P(PartitionedOutputTest, preserveEncodings) {
+  if (GetParam() != VectorSerde::Kind::kPresto) {
+    return;
+  }
+  constexpr vector_size_t kSize = 1'000;
+  auto input = makeRowVector(
+      {"p1", "v1", "v2"},
+      {makeFlatVector<int32_t>(kSize, [](auto row) { return row % 2; }),
+       BaseVector::wrapInDictionary(
+           nullptr,
+           makeIndices(kSize, [](auto row) { return row % 3; }),
+           kSize,
+           makeFlatVector<std::string>(
+               {std::string(100, 'a'),
+                std::string(100, 'b'),
+                std::string(100, 'c')})),
+       makeConstant<int64_t>(7, kSize)});
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, 3)
+                  .partitionedOutput(
+                      {"p1"},
+                      2,
+                      std::vector<std::string>{"v1", "v2"},
+                      GetParam())
+                  .planNode();
+
+  auto taskId = "local://test-partitioned-output-preserve-encodings-0";
+  auto task = Task::create(
+      taskId,
+      core::PlanFragment{plan},
+      0,
+      createQueryContext({{core::QueryConfig::kShufflePreserveEncodings, "true"}}),
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  auto* serde = getNamedVectorSerde(VectorSerde::Kind::kPresto);
+  const auto outputType = ROW({"v1", "v2"}, {VARCHAR(), BIGINT()});
+  for (auto destination = 0; destination < 2; ++destination) {
+    auto pages = getAllData(taskId, destination);
+    // One page per input vector.
+    ASSERT_EQ(pages.size(), 3);
+    for (auto& buffer : pages) {
+      SerializedPage page(std::move(buffer));
+      auto stream = page.prepareStreamForDeserialize();
+      RowVectorPtr result;
+      serde->deserialize(stream.get(), pool(), outputType, &result, nullptr);
+      ASSERT_EQ(result->size(), kSize / 2);
+      ASSERT_EQ(
+          result->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+      ASSERT_TRUE(result->childAt(1)->isConstantEncoding());
+      for (auto row = 0; row < result->size(); ++row) {
+        ASSERT_EQ(
+            result->childAt(0)->asUnchecked<SimpleVector<StringView>>()->valueAt(
+                row),
+            StringView(std::string(100, 'a' + (2 * row + destination) % 3)));
+      }
+    }
+  }
+
+  ASSERT_TRUE(waitForTaskCompletion(
+      task.get(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::seconds(10))
+          .count()));
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     PartitionedOutputTest,
     PartitionedOutputTest,
@@ -330,6 +330,25 @@ TEST_F(PrefixSortTest, fuzzMulti) {
   runFuzzTest(0.0);
 }
 
+TEST_F(PrefixSortTest, radixSortWithTies) {
+  // The bigint prefix fits the radix sort and the rows with the same bigint
+  // are sorted by the array key, which is not in the prefix.
+  const vector_size_t numRows = 4'096;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          numRows, [](auto row) { return row % 10 - 5; }, nullEvery(7)),
+      makeArrayVector<int32_t>(
+          numRows,
+          [](auto row) { return row % 3; },
+          [](auto row, auto index) { return (row * 31 + index) % 11; }),
+      makeFlatVector<int32_t>(numRows, [](auto row) { return row; }),
+  });
+  testPrefixSort({kAsc}, data);
+  testPrefixSort({kDesc}, data);
+  testPrefixSort({kAsc, kAsc}, data);
+  testPrefixSort({kDesc, kAsc}, data);
+}
+
 TEST_F(PrefixSortTest, checkMaxNormalizedKeySizeForMultipleKeys) {
   // Test the normalizedKeySize doesn't exceed the MaxNormalizedKeySize.
   // The normalizedKeySize for BIGINT should be 8 + 1.
@@ -1452,6 +1452,179 @@ TEST_F(RowContainerTest, columnSize) {
   }
 }
 
+TEST_F(RowContainerTest, compactColumns) {
+  const vector_size_t kNumRows = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          kNumRows,
+          [](auto row) { return -1'000'000'000'000L + row % 256; },
+          nullEvery(7)),
+      makeFlatVector<int32_t>(kNumRows, [](auto row) { return row * 60; }),
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return row * 4'000'000L; }),
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return row * 10'000'000L; }),
+      makeFlatVector<StringView>(
+          kNumRows, [](auto row) { return StringView::makeInline("abc"); }),
+  });
+  const std::vector<TypePtr> dependentTypes = {
+      BIGINT(), INTEGER(), BIGINT(), BIGINT(), VARCHAR()};
+  const std::vector<std::optional<RowContainer::ColumnRange>> ranges = {
+      RowContainer::ColumnRange{-1'000'000'000'000L, -1'000'000'000'000L + 255},
+      RowContainer::ColumnRange{0, 60'000},
+      RowContainer::ColumnRange{0, 4'000'000'000L},
+      RowContainer::ColumnRange{0, 10'000'000'000L},
+      RowContainer::ColumnRange{0, 0}};
+  auto rowContainer = std::make_unique<RowContainer>(
+      std::vector<TypePtr>{BIGINT()},
+      true, // nullableKeys
+      std::vector<Accumulator>{},
+      dependentTypes,
+      true, // hasNext
+      true, // isJoinBuild
+      false, // hasProbedFlag
+      false, // hasNormalizedKey
+      pool_.get(),
+      ranges);
+  ASSERT_EQ(rowContainer->compactBytesAt(1), 1);
+  ASSERT_EQ(rowContainer->compactBytesAt(2), 2);
+  ASSERT_EQ(rowContainer->compactBytesAt(3), 4);
+  ASSERT_EQ(rowContainer->compactBytesAt(4), 0);
+  ASSERT_EQ(rowContainer->compactBytesAt(5), 0);
+  ASSERT_EQ(rowContainer->fixedSizeAt(1), 8);
+  // The encoding is kept out of RowColumn.
+  static_assert(sizeof(RowColumn) == sizeof(uint64_t));
+
+  auto fullWidthContainer = std::make_unique<RowContainer>(
+      std::vector<TypePtr>{BIGINT()},
+      true, // nullableKeys
+      std::vector<Accumulator>{},
+      dependentTypes,
+      true, // hasNext
+      true, // isJoinBuild
+      false, // hasProbedFlag
+      false, // hasNormalizedKey
+      pool_.get());
+  ASSERT_EQ(fullWidthContainer->compactBytesAt(1), 0);
+  ASSERT_EQ(
+      fullWidthContainer->fixedRowSize() - rowContainer->fixedRowSize(),
+      7 + 2 + 4);
+
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = rowContainer->newRow();
+  }
+  SelectivityVector allRows(kNumRows);
+  for (auto column = 0; column < data->childrenSize(); ++column) {
+    DecodedVector decoded(*data->childAt(column), allRows);
+    rowContainer->store(
+        decoded, folly::Range<char**>(rows.data(), kNumRows), column);
+  }
+  for (auto column = 0; column < data->childrenSize(); ++column) {
+    auto result = BaseVector::create(data->childAt(column)->type(), 0, pool());
+    rowContainer->extractColumn(rows.data(), kNumRows, column, result);
+    assertEqualVectors(data->childAt(column), result);
+  }
+
+  // Extracts with row numbers.
+  std::vector<vector_size_t> rowNumbers = {999, -1, 7, 0};
+  auto result = BaseVector::create(BIGINT(), 0, pool());
+  rowContainer->extractColumn(
+      rows.data(),
+      folly::Range<const vector_size_t*>(rowNumbers.data(), rowNumbers.size()),
+      1,
+      0,
+      result);
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>(
+          {-1'000'000'000'000L + 999 % 256,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt}),
+      result);
+
+  // Values outside of the range cannot be stored.
+  auto outOfRange = makeFlatVector<int32_t>({-1});
+  DecodedVector decoded(*outOfRange);
+  VELOX_ASSERT_THROW(
+      rowContainer->store(decoded, 0, rowContainer->newRow(), 2),
+      "Value -1 is outside of the range of a compact column");
+}
+
+TEST_F(RowContainerTest, compactTimestampColumns) {
+  const vector_size_t kNumRows = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<Timestamp>(
+          kNumRows,
+          [](auto row) {
+            return Timestamp::fromMicros(1'700'000'000'000'000L - row * 1'001);
+          },
+          nullEvery(7)),
+      makeFlatVector<Timestamp>(
+          kNumRows, [](auto row) { return Timestamp(row, row); }),
+  });
+  ASSERT_TRUE(RowContainer::isCompactTimestamp(Timestamp(-1, 999'000)));
+  ASSERT_FALSE(RowContainer::isCompactTimestamp(Timestamp(1, 1)));
+  ASSERT_FALSE(RowContainer::isCompactTimestamp(Timestamp::max()));
+
+  const std::vector<TypePtr> dependentTypes = {TIMESTAMP(), TIMESTAMP()};
+  const std::vector<std::optional<RowContainer::ColumnRange>> ranges = {
+      RowContainer::ColumnRange{
+          1'700'000'000'000'000L - 999 * 1'001, 1'700'000'000'000'000L},
+      std::nullopt};
+  auto rowContainer = std::make_unique<RowContainer>(
+      std::vector<TypePtr>{BIGINT()},
+      true, // nullableKeys
+      std::vector<Accumulator>{},
+      dependentTypes,
+      true, // hasNext
+      true, // isJoinBuild
+      false, // hasProbedFlag
+      false, // hasNormalizedKey
+      pool_.get(),
+      ranges);
+  ASSERT_EQ(rowContainer->compactBytesAt(1), 8);
+  ASSERT_EQ(rowContainer->compactBytesAt(2), 0);
+
+  auto fullWidthContainer = std::make_unique<RowContainer>(
+      std::vector<TypePtr>{BIGINT()},
+      true, // nullableKeys
+      std::vector<Accumulator>{},
+      dependentTypes,
+      true, // hasNext
+      true, // isJoinBuild
+      false, // hasProbedFlag
+      false, // hasNormalizedKey
+      pool_.get());
+  ASSERT_EQ(
+      fullWidthContainer->fixedRowSize() - rowContainer->fixedRowSize(), 8);
+
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = rowContainer->newRow();
+  }
+  SelectivityVector allRows(kNumRows);
+  for (auto column = 0; column < data->childrenSize(); ++column) {
+    DecodedVector decoded(*data->childAt(column), allRows);
+    rowContainer->store(
+        decoded, folly::Range<char**>(rows.data(), kNumRows), column);
+  }
+  for (auto column = 0; column < data->childrenSize(); ++column) {
+    auto result = BaseVector::create(data->childAt(column)->type(), 0, pool());
+    rowContainer->extractColumn(rows.data(), kNumRows, column, result);
+    assertEqualVectors(data->childAt(column), result);
+  }
+
+  // Timestamps finer than microseconds cannot be stored.
+  auto nanos = makeFlatVector<Timestamp>({Timestamp(1'700'000'000, 1)});
+  DecodedVector decoded(*nanos);
+  VELOX_ASSERT_THROW(
+      rowContainer->store(decoded, 0, rowContainer->newRow(), 1),
+      "does not fit a compact column");
+}
+
 TEST_F(RowContainerTest, rowSizeWithNormalizedKey) {
   auto data = makeRowContainer({SMALLINT()}, {VARCHAR()});
   data->newRow();
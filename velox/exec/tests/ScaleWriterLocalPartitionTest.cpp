@@ -101,6 +101,18 @@ class TestExchangeController {
     return consumerMaxDelayUs_;
   }
 
+  // Specifies the ratio of sink write I/O time to sink append time reported
+  // to the scale writer exchange before the producers produce any data.
+  void setSinkIoTimeRatio(double ratio) {
+    std::lock_guard<std::mutex> l(mutex_);
+    sinkIoTimeRatio_ = ratio;
+  }
+
+  std::optional<double> sinkIoTimeRatio() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return sinkIoTimeRatio_;
+  }
+
   RowVectorPtr getInput() {
     std::lock_guard<std::mutex> l(mutex_);
     if (nextInput_ >= producerInputVectors_.size()) {
@@ -158,6 +170,7 @@ class TestExchangeController {
   memory::MemoryPool* holdPool_{nullptr};
   void* holdBuffer_{nullptr};
   core::PlanNodeId exchnangeNodeId_;
+  std::optional<double> sinkIoTimeRatio_;
   uint32_t nextInput_{0};
   std::vector<RowVectorPtr> producerInputVectors_;
   std::vector<std::vector<RowVectorPtr>> consumerInputs_;
@@ -241,6 +254,7 @@ class FakeSourceOperator : public SourceOperator {
           operatorCtx_->driver()->task()->getLocalExchangeMemoryManager(
               operatorCtx_->driverCtx()->splitGroupId,
               testController_->exchangeNodeId());
+      reportSinkTimes();
     }
 
     if (testController_->producerTargetBufferMemoryRatio().has_value()) {
@@ -257,6 +271,22 @@ class FakeSourceOperator : public SourceOperator {
     }
   }
 
+  // Reports the sink times of the writers as specified by the test controller.
+  void reportSinkTimes() {
+    const auto ratio = testController_->sinkIoTimeRatio();
+    if (!ratio.has_value()) {
+      return;
+    }
+    const uint64_t appendTimeNs = 1'000'000;
+    operatorCtx_->driver()
+        ->task()
+        ->getScaleWriterSinkTracker(
+            operatorCtx_->driverCtx()->splitGroupId,
+            testController_->exchangeNodeId())
+        ->addAppend(
+            appendTimeNs, static_cast<uint64_t>(appendTimeNs * ratio.value()));
+  }
+
   const std::shared_ptr<TestExchangeController> testController_;
   folly::Random::DefaultGenerator rng_;
 
@@ -708,6 +738,105 @@ TEST_F(ScaleWriterLocalPartitionTest, unpartitionBasic) {
   }
 }
 
+TEST_F(ScaleWriterLocalPartitionTest, sinkTracker) {
+  ScaleWriterSinkTracker tracker;
+  ASSERT_EQ(tracker.ioTimeRatio(), 0);
+
+  tracker.addAppend(1'000, 250);
+  ASSERT_DOUBLE_EQ(tracker.ioTimeRatio(), 0.25);
+
+  // Sink I/O time above the append time caps the ratio at 1.
+  tracker.addAppend(1'000, 3'000);
+  ASSERT_DOUBLE_EQ(tracker.ioTimeRatio(), 1.0);
+
+  // The older times decay and the recent CPU-bound appends dominate.
+  for (auto i = 0; i < 10; ++i) {
+    tracker.addAppend(10'000'000'000, 0);
+  }
+  ASSERT_LT(tracker.ioTimeRatio(), 0.001);
+}
+
+TEST_F(ScaleWriterLocalPartitionTest, unpartitionSinkIoBound) {
+  const std::vector<RowVectorPtr> inputVectors = makeVectors(128, 1024);
+  const uint64_t queryCapacity = 256 << 20;
+  const uint32_t maxExchanegBufferSize = 2 << 20;
+
+  for (const double sinkIoTimeRatio : {0.1, 0.9}) {
+    SCOPED_TRACE(fmt::format("sinkIoTimeRatio: {}", sinkIoTimeRatio));
+    const bool expectedRebalance = sinkIoTimeRatio < 0.5;
+    Operator::unregisterAllOperators();
+
+    auto testController = std::make_shared<TestExchangeController>(
+        1, 4, 0, 0.8, 0.6, std::nullopt, std::nullopt, inputVectors);
+    testController->setSinkIoTimeRatio(sinkIoTimeRatio);
+    Operator::registerOperator(
+        std::make_unique<FakeWriteNodeFactory>(testController));
+    Operator::registerOperator(
+        std::make_unique<FakeSourceNodeFactory>(testController));
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId exchnangeNodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .addNode([&](const core::PlanNodeId& id,
+                                 const core::PlanNodePtr& input) {
+                      return std::make_shared<FakeSourceNode>(id, rowType_);
+                    })
+                    .scaleWriterlocalPartitionRoundRobin()
+                    .capturePlanNodeId(exchnangeNodeId)
+                    .addNode([](const core::PlanNodeId& id,
+                                const core::PlanNodePtr& input) {
+                      return std::make_shared<FakeWriteNode>(id, input);
+                    })
+                    .planNode();
+    testController->setExchangeNodeId(exchnangeNodeId);
+
+    std::shared_ptr<Task> task;
+    const auto result =
+        AssertQueryBuilder(plan)
+            .maxDrivers(32)
+            .maxQueryCapacity(queryCapacity)
+            .config(
+                core::QueryConfig::kMaxLocalExchangeBufferSize,
+                std::to_string(maxExchanegBufferSize))
+            .config(
+                core::QueryConfig::kScaleWriterRebalanceMaxMemoryUsageRatio,
+                "1.0")
+            .config(
+                core::QueryConfig::
+                    kScaleWriterMinPartitionProcessedBytesRebalanceThreshold,
+                "0")
+            .config(core::QueryConfig::kScaleWriterMaxSinkIoTimeRatio, "0.5")
+            .copyResults(pool_.get(), task);
+    uint32_t nonEmptyConsumers{0};
+    for (const auto& consumerInput : testController->consumerInputs()) {
+      if (!consumerInput.empty()) {
+        ++nonEmptyConsumers;
+      }
+    }
+    const auto& customStats =
+        toPlanStats(task->taskStats()).at(exchnangeNodeId).customStats;
+    if (expectedRebalance) {
+      ASSERT_GT(
+          customStats.at(ScaleWriterLocalPartition::kScaledWriters).sum, 0);
+      ASSERT_EQ(
+          customStats.count(ScaleWriterLocalPartition::kSinkIoBoundSkips), 0);
+      ASSERT_GT(nonEmptyConsumers, 1);
+    } else {
+      ASSERT_EQ(
+          customStats.count(ScaleWriterLocalPartition::kScaledWriters), 0);
+      ASSERT_GT(
+          customStats.at(ScaleWriterLocalPartition::kSinkIoBoundSkips).sum, 0);
+      ASSERT_EQ(nonEmptyConsumers, 1);
+    }
+
+    testController->clear();
+    task.reset();
+
+    verifyResults(inputVectors, {result});
+    waitForAllTasksToBeDeleted();
+  }
+}
+
 TEST_P(ScaleWriterLocalPartitionTestParametrized, unpartitionFuzzer) {
   const std::vector<RowVectorPtr> inputVectors = makeVectors(256, 512);
   const uint64_t queryCapacity = 256 << 20;
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/SkewedPartitionFunction.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/PartitionFunction.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook;
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class SkewedPartitionFunctionTest : public velox::test::VectorTestBase,
+                                    public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  // Returns 1'000 rows where key 7 is in every other row and the other keys
+  // are distinct.
+  RowVectorPtr makeSkewedInput() {
+    return makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<int64_t>(
+             1'000, [](auto row) { return row % 2 == 0 ? 7 : 1'000 + row; }),
+         makeFlatVector<int32_t>(1'000, [](auto row) { return row; })});
+  }
+
+  std::unique_ptr<SkewedPartitionFunction> makeFunction(
+      SkewedPartitionFunction::Mode mode,
+      const RowVectorPtr& input,
+      const std::vector<uint64_t>& heavyKeyHashes) {
+    const auto rowType = asRowType(input->type());
+    return std::make_unique<SkewedPartitionFunction>(
+        std::make_unique<HashPartitionFunction>(
+            false, kNumPartitions, rowType, std::vector<column_index_t>{0}),
+        mode,
+        kNumPartitions,
+        rowType,
+        std::vector<column_index_t>{0},
+        heavyKeyHashes);
+  }
+
+  static constexpr int kNumPartitions = 8;
+};
+
+TEST_F(SkewedPartitionFunctionTest, sampleHeavyKeyHashes) {
+  const auto input = makeSkewedInput();
+  const auto heavyKeyHashes =
+      SkewedPartitionFunction::sampleHeavyKeyHashes(*input, {0}, 10, 0.1);
+  ASSERT_EQ(heavyKeyHashes.size(), 1);
+
+  // The hash of the heavy key is the one the hash partition function uses.
+  auto hasher = VectorHasher::create(BIGINT(), 0);
+  SelectivityVector rows(1);
+  hasher->decode(*makeFlatVector<int64_t>({7}), rows);
+  raw_vector<uint64_t> rawHashes(1);
+  hasher->hash(rows, false, rawHashes);
+  ASSERT_EQ(heavyKeyHashes[0], rawHashes[0]);
+
+  ASSERT_TRUE(
+      SkewedPartitionFunction::sampleHeavyKeyHashes(*input, {0}, 10, 0.6)
+          .empty());
+  ASSERT_TRUE(SkewedPartitionFunction::sampleHeavyKeyHashes(
+                  *makeRowVector({makeFlatVector<int64_t>({})}), {0}, 10, 0.1)
+                  .empty());
+}
+
+TEST_F(SkewedPartitionFunctionTest, partition) {
+  const auto input = makeSkewedInput();
+  const auto heavyKeyHashes =
+      SkewedPartitionFunction::sampleHeavyKeyHashes(*input, {0}, 10, 0.1);
+
+  std::vector<uint32_t> expected;
+  HashPartitionFunction hashFunction(
+      false,
+      kNumPartitions,
+      asRowType(input->type()),
+      std::vector<column_index_t>{0});
+  hashFunction.partition(*input, expected);
+
+  std::vector<uint32_t> partitions;
+  auto replicate = makeFunction(
+      SkewedPartitionFunction::Mode::kReplicate, input, heavyKeyHashes);
+  ASSERT_FALSE(replicate->partition(*input, partitions).has_value());
+  ASSERT_EQ(partitions.size(), input->size());
+  for (auto row = 0; row < input->size(); ++row) {
+    if (row % 2 == 0) {
+      ASSERT_EQ(partitions[row], core::PartitionFunction::kAllPartitions);
+    } else {
+      ASSERT_EQ(partitions[row], expected[row]);
+    }
+  }
+
+  auto roundRobin = makeFunction(
+      SkewedPartitionFunction::Mode::kRoundRobin, input, heavyKeyHashes);
+  std::vector<int32_t> numHeavyRows(kNumPartitions);
+  for (auto i = 0; i < 2; ++i) {
+    ASSERT_FALSE(roundRobin->partition(*input, partitions).has_value());
+    for (auto row = 0; row < input->size(); ++row) {
+      if (row % 2 == 0) {
+        ++numHeavyRows[partitions[row]];
+      } else {
+        ASSERT_EQ(partitions[row], expected[row]);
+      }
+    }
+  }
+  for (auto count : numHeavyRows) {
+    ASSERT_EQ(count, 1'000 / kNumPartitions);
+  }
+
+  // No heavy keys keeps the partitions of the base function.
+  auto noSkew =
+      makeFunction(SkewedPartitionFunction::Mode::kReplicate, input, {});
+  noSkew->partition(*input, partitions);
+  ASSERT_EQ(partitions, expected);
+}
+
+TEST_F(SkewedPartitionFunctionTest, spec) {
+  const auto rowType = ROW({"c0", "c1"}, {BIGINT(), INTEGER()});
+  auto spec = std::make_shared<SkewedPartitionFunctionSpec>(
+      std::make_shared<HashPartitionFunctionSpec>(
+          rowType, std::vector<column_index_t>{0}),
+      SkewedPartitionFunction::Mode::kRoundRobin,
+      rowType,
+      std::vector<column_index_t>{0},
+      std::vector<uint64_t>{1, std::numeric_limits<uint64_t>::max()});
+  ASSERT_EQ(
+      spec->toString(), "SKEWED(HASH(c0), ROUND_ROBIN, 2 heavy keys of c0)");
+
+  Type::registerSerDe();
+  core::ITypedExpr::registerSerDe();
+  registerPartitionFunctionSerDe();
+  auto copy = ISerializable::deserialize<core::PartitionFunctionSpec>(
+      spec->serialize(), pool());
+  ASSERT_EQ(spec->toString(), copy->toString());
+  ASSERT_EQ(spec->serialize(), copy->serialize());
+
+  auto replicateSpec = std::make_shared<SkewedPartitionFunctionSpec>(
+      std::make_shared<HashPartitionFunctionSpec>(
+          rowType, std::vector<column_index_t>{0}),
+      SkewedPartitionFunction::Mode::kReplicate,
+      rowType,
+      std::vector<column_index_t>{0},
+      std::vector<uint64_t>{1});
+  VELOX_ASSERT_THROW(
+      replicateSpec->create(4, /*localExchange=*/true),
+      "Skewed partitioning does not replicate rows in a local exchange");
+}
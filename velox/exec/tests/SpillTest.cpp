@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -24,6 +25,7 @@
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Spill.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/serializers/CompactRowSerializer.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/type/Timestamp.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
@@ -52,6 +54,31 @@ class TestRuntimeStatWriter : public BaseRuntimeStatWriter {
  private:
   std::unordered_map<std::string, RuntimeMetric>& stats_;
 };
+
+// Executor that counts the functions added to it and delays each of them, so
+// that the next flush waits for the pending write.
+class DelayingExecutor : public folly::Executor {
+ public:
+  DelayingExecutor(folly::Executor* executor, std::chrono::microseconds delay)
+      : executor_(executor), delay_(delay) {}
+
+  void add(folly::Func func) override {
+    ++numAdds_;
+    executor_->add([func = std::move(func), delay = delay_]() mutable {
+      std::this_thread::sleep_for(delay); // NOLINT
+      func();
+    });
+  }
+
+  int32_t numAdds() const {
+    return numAdds_;
+  }
+
+ private:
+  folly::Executor* const executor_;
+  const std::chrono::microseconds delay_;
+  std::atomic_int32_t numAdds_{0};
+};
 } // namespace
 
 struct TestParam {
@@ -132,6 +159,10 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
       facebook::velox::serializer::presto::PrestoVectorSerde::
           registerNamedVectorSerde();
     }
+    if (!isRegisteredNamedVectorSerde(VectorSerde::Kind::kCompactRow)) {
+      facebook::velox::serializer::CompactRowVectorSerde::
+          registerNamedVectorSerde();
+    }
   }
 
   void SetUp() override {
@@ -542,7 +573,8 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
             "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] "
             "spilledPartitions[{}] spilledFiles[{}] spillFillTimeNanos[{}] "
             "spillSortTimeNanos[{}] spillExtractVectorTime[{}] spillSerializationTimeNanos[{}] spillWrites[{}] "
-            "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] maxSpillExceededLimitCount[0] "
+            "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] spillWriteWaitTimeNanos[{}] "
+            "maxSpillExceededLimitCount[0] "
             "spillReadBytes[{}] spillReads[{}] spillReadTimeNanos[{}] "
             "spillReadDeserializationTimeNanos[{}]",
             finalStats.spillRuns,
@@ -558,6 +590,7 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
             finalStats.spillWrites,
             succinctNanos(finalStats.spillFlushTimeNanos),
             succinctNanos(finalStats.spillWriteTimeNanos),
+            succinctNanos(finalStats.spillWriteWaitTimeNanos),
             succinctBytes(finalStats.spillReadBytes),
             finalStats.spillReads,
             succinctNanos(finalStats.spillReadTimeNanos),
@@ -663,6 +696,445 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, asyncWrite) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  folly::CPUThreadPoolExecutor threadPool(2);
+  DelayingExecutor executor(&threadPool, std::chrono::milliseconds(1));
+  const std::optional<common::PrefixSortConfig> prefixSortConfig =
+      enablePrefixSort_
+      ? std::optional<common::PrefixSortConfig>(common::PrefixSortConfig())
+      : std::nullopt;
+  spillStats_.wlock()->reset();
+  // A zero write buffer size flushes on every append so that each write
+  // overlaps with the serialization of the next batch.
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+      kGB,
+      0,
+      compressionKind_,
+      prefixSortConfig,
+      pool(),
+      &spillStats_,
+      /*fileCreateConfig=*/{},
+      &executor);
+  SpillPartitionId partitionId{0};
+  state.setPartitionSpilled(partitionId);
+  const int kNumBatches = 10;
+  const int kNumRowsPerBatch = 1'000;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    state.appendToPartition(
+        partitionId,
+        makeRowVector({makeFlatVector<int64_t>(
+            kNumRowsPerBatch,
+            [&](auto row) { return i * kNumRowsPerBatch + row; })}));
+  }
+  state.finishFile(partitionId);
+
+  const auto stats = spillStats_.copy();
+  ASSERT_EQ(stats.spillWrites, kNumBatches);
+  ASSERT_EQ(stats.spilledRows, kNumBatches * kNumRowsPerBatch);
+  ASSERT_EQ(stats.spilledFiles, 1);
+  ASSERT_GT(stats.spilledBytes, 0);
+  // Each flush went to the executor and the writes overlap with the next
+  // flush, which waits for them.
+  ASSERT_EQ(executor.numAdds(), kNumBatches);
+  ASSERT_GT(stats.spillWriteWaitTimeNanos, 0);
+
+  SpillPartition spillPartition(partitionId, state.finish(partitionId));
+  ASSERT_EQ(spillPartition.numFiles(), 1);
+  auto reader =
+      spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+  RowVectorPtr batch;
+  int64_t expected = 0;
+  while (reader->nextBatch(batch)) {
+    auto* values = batch->childAt(0)->asFlatVector<int64_t>();
+    for (auto row = 0; row < batch->size(); ++row) {
+      ASSERT_EQ(values->valueAt(row), expected++);
+    }
+  }
+  ASSERT_EQ(expected, kNumBatches * kNumRowsPerBatch);
+}
+
+TEST_P(SpillTest, orderedReaderReadAhead) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  folly::CPUThreadPoolExecutor executor(4);
+  const std::optional<common::PrefixSortConfig> prefixSortConfig =
+      enablePrefixSort_
+      ? std::optional<common::PrefixSortConfig>(common::PrefixSortConfig())
+      : std::nullopt;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+      kGB,
+      0,
+      compressionKind_,
+      prefixSortConfig,
+      pool(),
+      &spillStats_);
+  SpillPartitionId partitionId{0};
+  state.setPartitionSpilled(partitionId);
+  // Each file holds the values with the same remainder modulo 'kNumFiles' in
+  // several batches so that the merge reads every file many times.
+  const int kNumFiles = 8;
+  const int kNumBatches = 10;
+  const int kNumRowsPerBatch = 100;
+  for (auto file = 0; file < kNumFiles; ++file) {
+    for (auto batch = 0; batch < kNumBatches; ++batch) {
+      state.appendToPartition(
+          partitionId,
+          makeRowVector({makeFlatVector<int64_t>(
+              kNumRowsPerBatch, [&](auto row) {
+                return (batch * kNumRowsPerBatch + row) * kNumFiles + file;
+              })}));
+    }
+    state.finishFile(partitionId);
+  }
+  const auto files = state.finish(partitionId);
+  ASSERT_EQ(files.size(), kNumFiles);
+
+  for (const uint64_t budget : {1UL, 1UL << 10, 1UL << 20}) {
+    SCOPED_TRACE(fmt::format("budget: {}", budget));
+    SpillPartition spillPartition(partitionId, files);
+    // A small read buffer size makes each file read many buffers.
+    auto merge = spillPartition.createOrderedReader(
+        256, pool(), &spillStats_, &executor, budget);
+    ASSERT_TRUE(merge != nullptr);
+    for (int64_t expected = 0;
+         expected < kNumFiles * kNumBatches * kNumRowsPerBatch;
+         ++expected) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      ASSERT_EQ(
+          expected,
+          stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+      stream->pop();
+    }
+    ASSERT_EQ(nullptr, merge->next());
+  }
+
+  // Destroying the reader with read-aheads in flight is safe.
+  SpillPartition spillPartition(partitionId, files);
+  auto merge = spillPartition.createOrderedReader(
+      256, pool(), &spillStats_, &executor, 1UL << 20);
+  ASSERT_NE(merge->next(), nullptr);
+  merge.reset();
+}
+
+TEST_P(SpillTest, mergeFiles) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+      kGB,
+      0,
+      compressionKind_,
+      std::nullopt,
+      pool(),
+      &spillStats_);
+  SpillPartitionId partitionId{0};
+  state.setPartitionSpilled(partitionId);
+  // File 'i' holds the values with remainder 'i' modulo 'kNumFiles', with more
+  // values in the later files.
+  const int kNumFiles = 10;
+  int64_t numRows{0};
+  for (auto file = 0; file < kNumFiles; ++file) {
+    const auto numFileRows = 500 + file * 100;
+    state.appendToPartition(
+        partitionId,
+        makeRowVector({makeFlatVector<int64_t>(
+            numFileRows, [&](auto row) { return row * kNumFiles + file; })}));
+    state.finishFile(partitionId);
+    numRows += numFileRows;
+  }
+  const auto files = state.finish(partitionId);
+  ASSERT_EQ(files.size(), kNumFiles);
+
+  common::SpillConfig config;
+  config.getSpillDirPathCb = [&]() -> std::string_view {
+    return tempDirectory->getPath();
+  };
+  config.updateAndCheckSpillLimitCb = updateSpilledBytesCb_;
+  config.fileNamePrefix = "test";
+  config.writeBufferSize = 0;
+  config.readBufferSize = 256;
+
+  SpillPartition spillPartition(partitionId, files);
+  spillPartition.mergeFiles(3, config, pool(), &spillStats_);
+  ASSERT_EQ(spillPartition.numFiles(), 3);
+  uint64_t size{0};
+  for (const auto& file : spillPartition.files()) {
+    size += file.size;
+  }
+  ASSERT_EQ(spillPartition.size(), size);
+
+  // All the original files were merged and deleted.
+  auto fs = filesystems::getFileSystem(tempDirectory->getPath(), nullptr);
+  int numDeleted{0};
+  for (const auto& file : files) {
+    numDeleted += !fs->exists(file.path);
+  }
+  ASSERT_EQ(numDeleted, kNumFiles);
+
+  auto merge = spillPartition.createOrderedReader(256, pool(), &spillStats_);
+  ASSERT_TRUE(merge != nullptr);
+  int64_t previous{-1};
+  for (auto i = 0; i < numRows; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    const auto value =
+        stream->decoded(0).valueAt<int64_t>(stream->currentIndex());
+    ASSERT_LT(previous, value);
+    previous = value;
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+}
+
+TEST_P(SpillTest, compactRowSerde) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  const std::optional<common::PrefixSortConfig> prefixSortConfig =
+      enablePrefixSort_
+      ? std::optional<common::PrefixSortConfig>(common::PrefixSortConfig())
+      : std::nullopt;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+      kGB,
+      0,
+      compressionKind_,
+      prefixSortConfig,
+      pool(),
+      &spillStats_,
+      /*fileCreateConfig=*/{},
+      /*asyncWriteExecutor=*/nullptr,
+      VectorSerde::Kind::kCompactRow);
+  ASSERT_EQ(state.serdeKind(), VectorSerde::Kind::kCompactRow);
+  SpillPartitionId partitionId{0};
+  state.setPartitionSpilled(partitionId);
+
+  // Two files with interleaved keys, each written in batches larger than a
+  // read batch.
+  const int kNumFiles = 2;
+  const int kNumBatches = 3;
+  const int kNumRowsPerBatch = 3'000;
+  const int kNumRows = kNumFiles * kNumBatches * kNumRowsPerBatch;
+  auto makeBatch = [&](int file, int batch) {
+    const auto makeKey = [&](auto row) {
+      return (batch * kNumRowsPerBatch + row) * kNumFiles + file;
+    };
+    return makeRowVector({
+        makeFlatVector<int64_t>(kNumRowsPerBatch, makeKey),
+        makeFlatVector<std::string>(
+            kNumRowsPerBatch,
+            [&](auto row) { return fmt::format("string {}", makeKey(row)); },
+            nullEvery(7)),
+        makeArrayVector<int32_t>(
+            kNumRowsPerBatch,
+            [](auto row) { return row % 5; },
+            [](auto row) { return row; },
+            nullEvery(11)),
+    });
+  };
+  std::vector<RowVectorPtr> expected;
+  for (auto file = 0; file < kNumFiles; ++file) {
+    for (auto batch = 0; batch < kNumBatches; ++batch) {
+      expected.push_back(makeBatch(file, batch));
+      state.appendToPartition(partitionId, expected.back());
+    }
+    state.finishFile(partitionId);
+  }
+  const auto files = state.finish(partitionId);
+  ASSERT_EQ(files.size(), kNumFiles);
+  for (const auto& file : files) {
+    ASSERT_EQ(file.serdeKind, VectorSerde::Kind::kCompactRow);
+  }
+
+  // The files are read back in order in batches of bounded size.
+  {
+    SpillPartition spillPartition(partitionId, files);
+    auto reader =
+        spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+    std::vector<RowVectorPtr> results;
+    RowVectorPtr batch;
+    while (reader->nextBatch(batch)) {
+      ASSERT_LE(batch->size(), 1'024);
+      results.push_back(batch);
+    }
+    auto expectedRows = BaseVector::create<RowVector>(
+        expected[0]->type(), 0, pool());
+    for (const auto& vector : expected) {
+      expectedRows->append(vector.get());
+    }
+    auto resultRows =
+        BaseVector::create<RowVector>(expected[0]->type(), 0, pool());
+    for (const auto& vector : results) {
+      resultRows->append(vector.get());
+    }
+    velox::test::assertEqualVectors(expectedRows, resultRows);
+  }
+
+  // The merge of the files produces the keys in order.
+  {
+    SpillPartition spillPartition(partitionId, files);
+    auto merge =
+        spillPartition.createOrderedReader(1 << 20, pool(), &spillStats_);
+    for (int64_t key = 0; key < kNumRows; ++key) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      ASSERT_EQ(
+          key, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+      stream->pop();
+    }
+    ASSERT_EQ(nullptr, merge->next());
+  }
+}
+
+TEST_P(SpillTest, compressionDictionary) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+      kGB,
+      0,
+      compressionKind_,
+      std::nullopt,
+      pool(),
+      &spillStats_,
+      /*fileCreateConfig=*/{},
+      /*asyncWriteExecutor=*/nullptr,
+      VectorSerde::Kind::kPresto,
+      /*overflowConfig=*/std::nullopt,
+      /*compressionDictionaryPages=*/4);
+  SpillPartitionId partitionId{0};
+  state.setPartitionSpilled(partitionId);
+
+  // Two files of small pages with interleaved keys. The dictionary is trained
+  // on the first pages of the first file and used by both.
+  const int kNumFiles = 2;
+  const int kNumBatches = 8;
+  const int kNumRowsPerBatch = 200;
+  const int kNumRows = kNumFiles * kNumBatches * kNumRowsPerBatch;
+  std::vector<RowVectorPtr> expected;
+  for (auto file = 0; file < kNumFiles; ++file) {
+    for (auto batch = 0; batch < kNumBatches; ++batch) {
+      const auto makeKey = [&](auto row) {
+        return (batch * kNumRowsPerBatch + row) * kNumFiles + file;
+      };
+      expected.push_back(makeRowVector({
+          makeFlatVector<int64_t>(kNumRowsPerBatch, makeKey),
+          makeFlatVector<std::string>(
+              kNumRowsPerBatch,
+              [&](auto row) {
+                return fmt::format(
+                    "order {} of customer#{:09}", makeKey(row), row % 50);
+              }),
+      }));
+      state.appendToPartition(partitionId, expected.back());
+    }
+    state.finishFile(partitionId);
+  }
+  const auto files = state.finish(partitionId);
+  ASSERT_EQ(files.size(), kNumFiles);
+  for (const auto& file : files) {
+    ASSERT_EQ(
+        file.compressionDictionary != nullptr,
+        compressionKind_ == common::CompressionKind::CompressionKind_ZSTD);
+  }
+
+  SpillPartition spillPartition(partitionId, files);
+  auto merge =
+      spillPartition.createOrderedReader(1 << 20, pool(), &spillStats_);
+  for (int64_t key = 0; key < kNumRows; ++key) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(key, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    ASSERT_EQ(
+        fmt::format("order {} of customer#{:09}", key, key / kNumFiles % 50),
+        stream->decoded(1).valueAt<StringView>(stream->currentIndex()).str());
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+}
+
+TEST_P(SpillTest, overflowTier) {
+  auto localDirectory = exec::test::TempDirectoryPath::create();
+  auto overflowDirectory = exec::test::TempDirectoryPath::create();
+  const std::optional<common::PrefixSortConfig> prefixSortConfig =
+      enablePrefixSort_
+      ? std::optional<common::PrefixSortConfig>(common::PrefixSortConfig())
+      : std::nullopt;
+  // The local tier is full after the first write.
+  uint64_t localBytes{0};
+  common::SpillOverflowConfig overflowConfig{
+      .getSpillDirPathCb = [&]() -> std::string_view {
+        return overflowDirectory->getPath();
+      },
+      .updateLocalSpillBytesCb =
+          [&](uint64_t bytes) {
+            localBytes += bytes;
+            return localBytes == 0;
+          }};
+  SpillState state(
+      [&]() -> const std::string& { return localDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+      kGB,
+      0,
+      compressionKind_,
+      prefixSortConfig,
+      pool(),
+      &spillStats_,
+      /*fileCreateConfig=*/{},
+      /*asyncWriteExecutor=*/nullptr,
+      VectorSerde::Kind::kPresto,
+      overflowConfig);
+  SpillPartitionId partitionId{0};
+  state.setPartitionSpilled(partitionId);
+  const int kNumBatches = 4;
+  const int kNumRowsPerBatch = 100;
+  for (auto batch = 0; batch < kNumBatches; ++batch) {
+    state.appendToPartition(
+        partitionId,
+        makeRowVector({makeFlatVector<int64_t>(
+            kNumRowsPerBatch,
+            [&](auto row) { return batch * kNumRowsPerBatch + row; })}));
+  }
+  const auto files = state.finish(partitionId);
+  ASSERT_GT(localBytes, 0);
+
+  // The first batch is written to a local file which is closed when the
+  // local tier becomes full. The other batches go to the overflow tier.
+  ASSERT_EQ(files.size(), 2);
+  ASSERT_TRUE(files[0].path.starts_with(localDirectory->getPath()));
+  ASSERT_TRUE(files[1].path.starts_with(overflowDirectory->getPath()));
+  ASSERT_EQ(files[0].size, localBytes);
+
+  SpillPartition spillPartition(partitionId, files);
+  auto reader =
+      spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+  RowVectorPtr batch;
+  int64_t expected{0};
+  while (reader->nextBatch(batch)) {
+    auto* values = batch->childAt(0)->asFlatVector<int64_t>();
+    for (auto row = 0; row < batch->size(); ++row) {
+      ASSERT_EQ(values->valueAt(row), expected++);
+    }
+  }
+  ASSERT_EQ(expected, kNumBatches * kNumRowsPerBatch);
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -17,6 +17,7 @@
 #include <shared_mutex>
 
 #include <fmt/ranges.h>
+#include <folly/ScopeGuard.h>
 #include <folly/experimental/EventCount.h>
 #include <folly/synchronization/Baton.h>
 #include <folly/synchronization/Latch.h>
@@ -29,6 +30,7 @@
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/connectors/hive/DecodedColumnCache.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/HiveDataSource.h"
@@ -290,6 +292,45 @@ TEST_F(TableScanTest, allColumns) {
   ASSERT_TRUE(it->second.dynamicFilterStats.empty());
 }
 
+TEST_F(TableScanTest, topNDynamicFilter) {
+  constexpr int32_t kNumFiles = 10;
+  constexpr vector_size_t kNumRows = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kNumRows,
+            [&](auto row) { return (kNumFiles - i) * kNumRows - row; }),
+        makeFlatVector<int32_t>(kNumRows, [](auto row) { return row; }),
+    }));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), vectors.back());
+  }
+  createDuckDbTable(vectors);
+
+  // The first key of the top of the heap is pushed down into the scan, so that
+  // the scan drops the rows which cannot get into the heap.
+  core::PlanNodeId scanId;
+  core::PlanNodeId topNId;
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(vectors[0]->type()))
+                  .capturePlanNodeId(scanId)
+                  .topN({"c0 DESC"}, 10, false)
+                  .capturePlanNodeId(topNId)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .assertResults(
+                      "SELECT * FROM tmp ORDER BY c0 DESC LIMIT 10", {{0}});
+
+  const auto planStats = toPlanStats(task->taskStats());
+  const auto& scanStats = planStats.at(scanId);
+  ASSERT_EQ(scanStats.dynamicFilterStats.producerNodeIds.count(topNId), 1);
+  ASSERT_GT(scanStats.customStats.at("dynamicFiltersAccepted").sum, 0);
+  ASSERT_LT(scanStats.outputRows, 2 * kNumRows);
+}
+
 TEST_F(TableScanTest, directBufferInputRawInputBytes) {
   constexpr int kSize = 10;
   auto vector = makeRowVector({
@@ -1542,6 +1583,142 @@ TEST_F(TableScanTest, batchSize) {
   }
 }
 
+TEST_F(TableScanTest, adaptiveOutputBatchRows) {
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto vectors = makeVectors(1, 10'000, rowType);
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  std::vector<RowVectorPtr> allVectors;
+  for (auto i = 0; i < 16; ++i) {
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), vectors);
+    allVectors.push_back(vectors[0]);
+  }
+  createDuckDbTable(allVectors);
+
+  // An expensive projection makes the scan return smaller batches once the
+  // cost per row of the projection is known. The batch size changes for the
+  // next split.
+  auto plan =
+      PlanBuilder()
+          .tableScan(rowType)
+          .project({"length(to_hex(md5(to_utf8(cast(c0 as varchar)))))"})
+          .planNode();
+  auto scanOutputVectors = [&](bool adaptive) {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .splits(makeHiveConnectorSplits(filePaths))
+            .config(
+                QueryConfig::kAdaptiveOutputBatchRowsEnabled,
+                adaptive ? "true" : "false")
+            .config(QueryConfig::kAdaptiveOutputBatchMinRows, "100")
+            .assertResults("SELECT 32 FROM tmp");
+    return task->taskStats().pipelineStats[0].operatorStats[0].outputVectors;
+  };
+
+  EXPECT_GT(scanOutputVectors(true), 2 * scanOutputVectors(false));
+}
+
+TEST_F(TableScanTest, limitPushdown) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [&](auto row) { return i * 1'000 + row; })}));
+  }
+  auto filePaths = makeFilePaths(4);
+  for (const auto& filePath : filePaths) {
+    writeToFile(filePath->getPath(), vectors);
+  }
+  const auto rowType = asRowType(vectors[0]->type());
+
+  // Runs 'plan' with read batches of 1'000 rows and returns the scan stats.
+  std::shared_ptr<Task> task;
+  auto runScan = [&](const core::PlanNodePtr& plan, vector_size_t numRows) {
+    auto result =
+        AssertQueryBuilder(plan)
+            .splits(makeHiveConnectorSplits(filePaths))
+            .config(core::QueryConfig::kPreferredOutputBatchRows, 1'000)
+            .config(core::QueryConfig::kMaxOutputBatchRows, 1'000)
+            .config(core::QueryConfig::kMaxSplitPreloadPerDriver, 2)
+            .copyResults(pool(), task);
+    EXPECT_EQ(result->size(), numRows);
+    return getTableScanStats(task);
+  };
+
+  // The scan reads only the rows needed by the limit in one batch and does
+  // not preload the other splits.
+  auto plan = PlanBuilder().tableScan(rowType).limit(0, 10, false).planNode();
+  auto scanStats = runScan(plan, 10);
+  EXPECT_EQ(scanStats.outputVectors, 1);
+  EXPECT_EQ(scanStats.outputRows, 10);
+  EXPECT_EQ(scanStats.numSplits, 1);
+  EXPECT_EQ(getTableScanRuntimeStats(task).count("preloadedSplits"), 0);
+
+  // With a filter between the scan and the limit, the first batch is not
+  // capped. The next one is capped to the remaining 50 rows divided by the
+  // observed selectivity of 1/4.
+  plan = PlanBuilder()
+             .tableScan(rowType)
+             .filter("c0 % 4 = 0")
+             .limit(0, 300, false)
+             .planNode();
+  scanStats = runScan(plan, 300);
+  EXPECT_EQ(scanStats.outputVectors, 2);
+  EXPECT_EQ(scanStats.outputRows, 1'000 + 200);
+  EXPECT_EQ(scanStats.numSplits, 1);
+
+  // Splits are preloaded while the limit needs more than one read batch.
+  plan = PlanBuilder().tableScan(rowType).limit(0, 25'000, false).planNode();
+  scanStats = runScan(plan, 25'000);
+  EXPECT_EQ(scanStats.outputRows, 25'000);
+  EXPECT_EQ(scanStats.numSplits, 3);
+  EXPECT_GT(getTableScanRuntimeStats(task).at("preloadedSplits").sum, 0);
+}
+
+TEST_F(TableScanTest, filterFromColumnBounds) {
+  std::vector<RowVectorPtr> vectors = {makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })})};
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+  auto rowType = asRowType(vectors[0]->type());
+
+  auto numDecidedBatches = [&](const std::shared_ptr<Task>& task,
+                               const core::PlanNodeId& filterId) {
+    const auto stats = toPlanStats(task->taskStats()).at(filterId).customStats;
+    auto it = stats.find("numBatchesFilteredByBounds");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  // The scan filter bounds c0 to [100, max], so all rows pass c0 >= 50.
+  core::PlanNodeId filterId;
+  auto plan = PlanBuilder()
+                  .tableScan(rowType, {"c0 >= 100"})
+                  .filter("c0 >= 50")
+                  .capturePlanNodeId(filterId)
+                  .planNode();
+  auto task =
+      assertQuery(plan, {filePath}, "SELECT c0 FROM tmp WHERE c0 >= 100");
+  EXPECT_GT(numDecidedBatches(task, filterId), 0);
+
+  // No row can pass c0 < 50.
+  plan = PlanBuilder()
+             .tableScan(rowType, {"c0 >= 100"})
+             .filter("c0 < 50 AND c0 % 2 = 0")
+             .capturePlanNodeId(filterId)
+             .planNode();
+  task = assertQuery(plan, {filePath}, "SELECT c0 FROM tmp WHERE false");
+  EXPECT_GT(numDecidedBatches(task, filterId), 0);
+
+  // The bounds overlap the filter, which is evaluated.
+  plan = PlanBuilder()
+             .tableScan(rowType, {"c0 >= 100"})
+             .filter("c0 >= 500")
+             .capturePlanNodeId(filterId)
+             .planNode();
+  task = assertQuery(plan, {filePath}, "SELECT c0 FROM tmp WHERE c0 >= 500");
+  EXPECT_EQ(numDecidedBatches(task, filterId), 0);
+}
+
 // Test that adding the same split with the same sequence id does not cause
 // double read and the 2nd split is ignored.
 TEST_F(TableScanTest, sequentialSplitNoDoubleRead) {
@@ -1908,6 +2085,247 @@ TEST_F(TableScanTest, splitOffsetAndLength) {
       "SELECT * FROM tmp LIMIT 0");
 }
 
+TEST_F(TableScanTest, decodedColumnCache) {
+  auto vectors = makeVectors(4, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  connector::hive::DecodedColumnCache cache(
+      64 << 20, memory::memoryManager()->addLeafPool("decodedColumnCache"));
+  connector::hive::DecodedColumnCache::setInstance(&cache);
+  SCOPE_EXIT {
+    connector::hive::DecodedColumnCache::setInstance(nullptr);
+  };
+  auto split = exec::test::HiveConnectorSplitBuilder(filePath->getPath())
+                   .fileProperties(
+                       {filePath->fileSize(), filePath->fileModifiedTime()})
+                   .build();
+  auto scan = [&](const core::PlanNodePtr& plan,
+                  const std::string& sql,
+                  const std::string& maxFileSize = "1GB") {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .connectorSessionProperty(
+                kHiveConnectorId,
+                connector::hive::HiveConfig::
+                    kDecodedColumnCacheMaxFileSizeSession,
+                maxFileSize)
+            .split(split)
+            .assertResults(sql);
+    const auto stats = getTableScanRuntimeStats(task);
+    auto it = stats.find("numDecodedColumnCacheSplits");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  // The cache is disabled by default.
+  ASSERT_EQ(scan(tableScanNode(), "SELECT * FROM tmp", "0B"), 0);
+  ASSERT_EQ(cache.stats().numEntries, 0);
+
+  // The first scan fills the cache and the next ones are served from it.
+  ASSERT_EQ(scan(tableScanNode(), "SELECT * FROM tmp"), 0);
+  ASSERT_EQ(cache.stats().numEntries, rowType_->size());
+  ASSERT_EQ(scan(tableScanNode(), "SELECT * FROM tmp"), 1);
+  ASSERT_EQ(
+      scan(
+          tableScanNode(ROW({"c5", "c0"}, {VARCHAR(), BIGINT()})),
+          "SELECT c5, c0 FROM tmp"),
+      1);
+
+  // A scan with filters reads the file.
+  ASSERT_EQ(
+      scan(
+          PlanBuilder().tableScan(rowType_, {"c0 > 0"}).planNode(),
+          "SELECT * FROM tmp WHERE c0 > 0"),
+      0);
+
+  // A rewritten file does not get the columns of its previous version.
+  split = exec::test::HiveConnectorSplitBuilder(filePath->getPath())
+              .fileProperties(
+                  {filePath->fileSize(), filePath->fileModifiedTime() + 1})
+              .build();
+  ASSERT_EQ(scan(tableScanNode(), "SELECT * FROM tmp"), 0);
+}
+
+TEST_F(TableScanTest, decodedColumnCacheSharedDecode) {
+  auto vectors = makeVectors(4, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  connector::hive::DecodedColumnCache cache(
+      64 << 20, memory::memoryManager()->addLeafPool("sharedDecode"));
+  connector::hive::DecodedColumnCache::setInstance(&cache);
+  SCOPE_EXIT {
+    connector::hive::DecodedColumnCache::setInstance(nullptr);
+  };
+  auto split = exec::test::HiveConnectorSplitBuilder(filePath->getPath())
+                   .fileProperties(
+                       {filePath->fileSize(), filePath->fileModifiedTime()})
+                   .build();
+  std::vector<connector::hive::DecodedColumnCache::Key> keys;
+  for (auto i = 0; i < rowType_->size(); ++i) {
+    keys.push_back(
+        {filePath->getPath(),
+         static_cast<int64_t>(filePath->fileSize()),
+         static_cast<int64_t>(filePath->fileModifiedTime()),
+         split->start,
+         split->length,
+         rowType_->nameOf(i),
+         rowType_->childAt(i),
+         ""});
+  }
+
+  // The test decodes the split. A reader of a subset of the columns waits
+  // and a reader of other columns does not.
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ASSERT_TRUE(cache.startDecode(keys, future));
+  ASSERT_FALSE(future.valid());
+  std::vector<connector::hive::DecodedColumnCache::Key> subset{keys[1]};
+  ASSERT_FALSE(cache.startDecode(subset, future));
+  ASSERT_TRUE(future.valid());
+  ASSERT_FALSE(future.isReady());
+  auto otherKey = keys[0];
+  otherKey.column = "other";
+  ContinueFuture otherFuture = ContinueFuture::makeEmpty();
+  ASSERT_TRUE(cache.startDecode({keys[0], otherKey}, otherFuture));
+  ASSERT_FALSE(otherFuture.valid());
+  // The reader that was not registered does not wake up the waiters.
+  cache.finishDecode({keys[0], otherKey});
+  ASSERT_FALSE(future.isReady());
+
+  // A scan of the split waits for the columns of the test.
+  std::thread queryThread([&]() {
+    auto task = AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+                    .connectorSessionProperty(
+                        kHiveConnectorId,
+                        connector::hive::HiveConfig::
+                            kDecodedColumnCacheMaxFileSizeSession,
+                        "1GB")
+                    .split(split)
+                    .assertResults("SELECT * FROM tmp");
+    const auto stats = getTableScanRuntimeStats(task);
+    EXPECT_EQ(stats.at("numSharedDecodeWaits").sum, 1);
+    EXPECT_EQ(stats.at("numDecodedColumnCacheSplits").sum, 1);
+  });
+  while (cache.stats().numDecodeWaits < 2) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  for (auto i = 0; i < keys.size(); ++i) {
+    auto column = BaseVector::create(keys[i].type, 0, cache.pool());
+    for (const auto& vector : vectors) {
+      column->append(vector->childAt(i).get());
+    }
+    cache.put(keys[i], std::move(column));
+  }
+  cache.finishDecode(keys);
+  ASSERT_TRUE(future.isReady());
+  queryThread.join();
+}
+
+TEST_F(TableScanTest, fragmentResultCache) {
+  auto vectors = makeVectors(4, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  connector::hive::DecodedColumnCache cache(
+      64 << 20, memory::memoryManager()->addLeafPool("fragmentResultCache"));
+  connector::hive::DecodedColumnCache::setInstance(&cache);
+  SCOPE_EXIT {
+    connector::hive::DecodedColumnCache::setInstance(nullptr);
+  };
+  auto split = exec::test::HiveConnectorSplitBuilder(filePath->getPath())
+                   .fileProperties(
+                       {filePath->fileSize(), filePath->fileModifiedTime()})
+                   .build();
+  auto scan = [&](const core::PlanNodePtr& plan, const std::string& sql) {
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .connectorSessionProperty(
+                        kHiveConnectorId,
+                        connector::hive::HiveConfig::
+                            kDecodedColumnCacheMaxFileSizeSession,
+                        "1GB")
+                    .connectorSessionProperty(
+                        kHiveConnectorId,
+                        connector::hive::HiveConfig::
+                            kFragmentResultCacheEnabledSession,
+                        "true")
+                    .split(split)
+                    .assertResults(sql);
+    const auto stats = getTableScanRuntimeStats(task);
+    auto it = stats.find("numDecodedColumnCacheSplits");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  auto plan = PlanBuilder()
+                  .tableScan(
+                      ROW({"c0", "c5"}, {BIGINT(), VARCHAR()}),
+                      {"c1 > 0"},
+                      "c0 % 3 = 0",
+                      rowType_)
+                  .planNode();
+  const auto sql = "SELECT c0, c5 FROM tmp WHERE c1 > 0 AND c0 % 3 = 0";
+  ASSERT_EQ(scan(plan, sql), 0);
+  ASSERT_EQ(cache.stats().numEntries, 2);
+  ASSERT_EQ(scan(plan, sql), 1);
+
+  // Other filters do not get the cached rows.
+  auto otherPlan =
+      PlanBuilder()
+          .tableScan(
+              ROW({"c0", "c5"}, {BIGINT(), VARCHAR()}),
+              {"c1 > 1"},
+              "c0 % 3 = 0",
+              rowType_)
+          .planNode();
+  ASSERT_EQ(
+      scan(otherPlan, "SELECT c0, c5 FROM tmp WHERE c1 > 1 AND c0 % 3 = 0"),
+      0);
+  ASSERT_EQ(cache.stats().numEntries, 4);
+  ASSERT_EQ(
+      scan(
+          tableScanNode(ROW({"c0", "c5"}, {BIGINT(), VARCHAR()})),
+          "SELECT c0, c5 FROM tmp"),
+      0);
+  ASSERT_EQ(scan(plan, sql), 1);
+}
+
+TEST_F(TableScanTest, countFromMetadata) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  auto scan = [&](const core::PlanNodePtr& plan, const std::string& sql) {
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .split(makeHiveConnectorSplit(filePath->getPath()))
+                    .assertResults(sql);
+    const auto stats = getTableScanRuntimeStats(task);
+    auto it = stats.find("numMetadataCountedSplits");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  // The rows of a scan without columns and filters come from the footer.
+  auto plan = PlanBuilder()
+                  .tableScan(ROW({}, {}))
+                  .singleAggregation({}, {"count(1)"})
+                  .planNode();
+  ASSERT_EQ(scan(plan, "SELECT count(*) FROM tmp"), 1);
+
+  // The filters and the columns need the data.
+  plan = PlanBuilder()
+             .tableScan(ROW({}, {}), {"c0 > 0"}, "", rowType_)
+             .singleAggregation({}, {"count(1)"})
+             .planNode();
+  ASSERT_EQ(scan(plan, "SELECT count(*) FROM tmp WHERE c0 > 0"), 0);
+  plan = PlanBuilder()
+             .tableScan(ROW({"c1"}, {INTEGER()}))
+             .singleAggregation({}, {"count(c1)"})
+             .planNode();
+  ASSERT_EQ(scan(plan, "SELECT count(c1) FROM tmp"), 0);
+}
+
 TEST_F(TableScanTest, fileNotFound) {
   auto split =
       exec::test::HiveConnectorSplitBuilder("/path/to/nowhere.orc").build();
@@ -1960,6 +2378,106 @@ TEST_F(TableScanTest, preloadEmptySplit) {
   assertQuery(op, filePaths, "SELECT * FROM tmp", 1);
 }
 
+TEST_F(TableScanTest, preloadAfterEmptySplits) {
+  // Splits that are empty or pruned by file statistics issue no IO, so they
+  // do not hold back preloading the splits after them.
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), DOUBLE()});
+  auto emptyVector = makeVectors(1, 0, rowType);
+  auto filePaths = makeFilePaths(20);
+  for (const auto& filePath : filePaths) {
+    writeToFile(filePath->getPath(), emptyVector[0]);
+  }
+  createDuckDbTable(emptyVector);
+  auto task =
+      assertQuery(tableScanNode(rowType), filePaths, "SELECT * FROM tmp", 2);
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_GT(stats.at("preloadedSplits").sum, 0);
+}
+
+TEST_F(TableScanTest, coalescedFiles) {
+  // A split of many small files reads each file with its own partition keys
+  // in one data source.
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), DOUBLE()});
+  auto vectors = makeVectors(10, 100, rowType);
+  auto filePaths = makeFilePaths(vectors.size());
+  std::vector<RowVectorPtr> expected;
+  std::vector<std::shared_ptr<connector::hive::HiveConnectorSplit>> files;
+  for (auto i = 0; i < vectors.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+    files.push_back(HiveConnectorSplitBuilder(filePaths[i]->getPath())
+                        .partitionKey("pkey", std::to_string(i))
+                        .build());
+    expected.push_back(makeRowVector(
+        {"c0", "c1", "pkey"},
+        {vectors[i]->childAt(0),
+         vectors[i]->childAt(1),
+         makeFlatVector<int64_t>(
+             vectors[i]->size(), [i](auto /*row*/) { return i; })}));
+  }
+  createDuckDbTable(expected);
+
+  HiveConnectorSplitBuilder builder(files[0]->filePath);
+  builder.partitionKey("pkey", "0");
+  for (auto i = 1; i < files.size(); ++i) {
+    builder.coalescedFile(files[i]);
+  }
+  auto split = builder.build();
+  ASSERT_EQ(split->coalescedFiles.size(), files.size() - 1);
+
+  auto plan =
+      PlanBuilder()
+          .startTableScan()
+          .outputType(
+              ROW({"c0", "c1", "pkey"}, {BIGINT(), DOUBLE(), BIGINT()}))
+          .assignments(
+              {{"c0", regularColumn("c0", BIGINT())},
+               {"c1", regularColumn("c1", DOUBLE())},
+               {"pkey", partitionKey("pkey", BIGINT())}})
+          .endTableScan()
+          .planNode();
+  assertQuery(plan, split, "SELECT * FROM tmp");
+
+  // The coalesced files survive serialization.
+  auto copy = connector::hive::HiveConnectorSplit::create(split->serialize());
+  ASSERT_EQ(copy->coalescedFiles.size(), split->coalescedFiles.size());
+  ASSERT_EQ(copy->toString(), split->toString());
+  assertQuery(plan, copy, "SELECT * FROM tmp");
+
+  // Coalesced files of another format are rejected.
+  builder.coalescedFile(HiveConnectorSplitBuilder(files[1]->filePath)
+                            .fileFormat(dwio::common::FileFormat::PARQUET)
+                            .build());
+  VELOX_ASSERT_THROW(
+      assertQuery(plan, builder.build(), "SELECT * FROM tmp"),
+      "Coalesced files must have the format of their split");
+}
+
+TEST_F(TableScanTest, partitionFilterBeforeFileOpen) {
+  // A split whose partition value fails the filters is skipped without
+  // opening its file, which here does not exist.
+  auto vectors = makeVectors(1, 100, ROW({"c0"}, {BIGINT()}));
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+  auto makeSplit = [](const std::string& path, const std::string& value) {
+    return HiveConnectorSplitBuilder(path).partitionKey("pkey", value).build();
+  };
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .outputType(ROW({"c0", "pkey"}, {BIGINT(), BIGINT()}))
+                  .assignments(
+                      {{"c0", regularColumn("c0", BIGINT())},
+                       {"pkey", partitionKey("pkey", BIGINT())}})
+                  .subfieldFilter("pkey = 1")
+                  .endTableScan()
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .split(makeSplit(filePath->getPath(), "1"))
+                  .split(makeSplit("/path/to/nowhere.orc", "2"))
+                  .assertResults("SELECT c0, 1 FROM tmp");
+  ASSERT_EQ(getTableScanRuntimeStats(task).at("skippedSplits").sum, 1);
+}
+
 TEST_F(TableScanTest, partitionedTableVarcharKey) {
   auto rowType = ROW({"c0", "c1"}, {BIGINT(), DOUBLE()});
   auto vectors = makeVectors(10, 1'000, rowType);
@@ -3657,6 +4175,53 @@ TEST_F(TableScanTest, remainingFilter) {
       "SELECT * FROM tmp WHERE not (c0 > 0 or c1 > c0)");
 }
 
+TEST_F(TableScanTest, expressionFilterPushdown) {
+  const std::vector<std::string> countries = {"US", "uk", "De", "us", "Fr"};
+  const vector_size_t size = 10'000;
+  std::vector<RowVectorPtr> vectors = {makeRowVector(
+      {"c0", "c1", "c2"},
+      {makeFlatVector<std::string>(
+           size,
+           [&](auto row) { return countries[row % countries.size()]; },
+           nullEvery(11)),
+       makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+       makeFlatVector<std::string>(size, [](auto row) {
+         return row % 100 == 99 ? "x" : fmt::format("{}", row % 100);
+       })})};
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  auto assertFilter = [&](const std::string& remainingFilter,
+                          const std::string& duckDbFilter) {
+    SCOPED_TRACE(remainingFilter);
+    auto plan =
+        PlanBuilder(pool_.get())
+            .tableScan(asRowType(vectors[0]->type()), {}, remainingFilter)
+            .planNode();
+    for (const auto enabled : {false, true}) {
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .connectorSessionProperty(
+              kHiveConnectorId,
+              connector::hive::HiveConfig::
+                  kExpressionFilterPushdownEnabledSession,
+              enabled ? "true" : "false")
+          .split(makeHiveConnectorSplit(filePath->getPath()))
+          .assertResults("SELECT * FROM tmp WHERE " + duckDbFilter);
+    }
+  };
+
+  assertFilter("lower(c0) = 'us'", "lower(c0) = 'us'");
+  assertFilter(
+      "lower(c0) = 'us' AND c1 % 3 = 0", "lower(c0) = 'us' AND c1 % 3 = 0");
+  assertFilter("c0 LIKE '%e%' AND c1 > 5000", "c0 LIKE '%e%' AND c1 > 5000");
+  assertFilter("coalesce(c0, 'us') = 'us'", "coalesce(c0, 'us') = 'us'");
+  // The cast fails for the rows that the other conjunct removes.
+  assertFilter(
+      "c1 % 100 <> 99 AND cast(c2 as bigint) < 10",
+      "c1 % 100 <> 99 AND try_cast(c2 as bigint) < 10");
+}
+
 TEST_F(TableScanTest, remainingFilterLazyWithMultiReferences) {
   constexpr int kSize = 10;
   auto vector = makeRowVector({
@@ -23,6 +23,7 @@
 #include "velox/common/memory/SharedArbitrator.h"
 #include "velox/common/memory/tests/SharedArbitratorTestUtil.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/exec/Cursor.h"
 #include "velox/exec/OutputBufferManager.h"
@@ -911,6 +912,75 @@ TEST_F(TaskTest, testTerminateDeadlock) {
       cursor->task()->toString().find("zombie drivers:"), std::string::npos);
 }
 
+TEST_F(TaskTest, streamingTaskQueue) {
+  auto makeBatch = [&](vector_size_t size) {
+    return makeRowVector(
+        {makeFlatVector<int64_t>(size, [](auto row) { return row; })});
+  };
+
+  TaskQueue queue(
+      1, nullptr, TaskQueue::StreamingOptions{2, 10, 3'600'000'000});
+  queue.setNumProducers(1);
+
+  // The queue is full after the second batch regardless of its bytes and
+  // returns both batches at once.
+  ContinueFuture future;
+  ASSERT_EQ(queue.enqueue(makeBatch(3), &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(
+      queue.enqueue(makeBatch(4), &future), BlockingReason::kWaitForConsumer);
+  ASSERT_FALSE(future.isReady());
+  auto result = queue.dequeue();
+  ASSERT_EQ(result->size(), 7);
+  ASSERT_TRUE(future.isReady());
+
+  // A batch with enough rows is returned right away.
+  ASSERT_EQ(queue.enqueue(makeBatch(12), &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(queue.dequeue()->size(), 12);
+
+  // Fewer rows are returned once the producers are done.
+  ASSERT_EQ(queue.enqueue(makeBatch(5), &future), BlockingReason::kNotBlocked);
+  queue.enqueue(nullptr, &future);
+  ASSERT_EQ(queue.dequeue()->size(), 5);
+  ASSERT_EQ(queue.dequeue(), nullptr);
+
+  // Fewer rows are returned after the latency deadline.
+  TaskQueue deadlineQueue(
+      1, nullptr, TaskQueue::StreamingOptions{8, 1'000, 10'000});
+  deadlineQueue.setNumProducers(1);
+  ASSERT_EQ(
+      deadlineQueue.enqueue(makeBatch(5), &future),
+      BlockingReason::kNotBlocked);
+  const auto startUs = getCurrentTimeMicro();
+  ASSERT_EQ(deadlineQueue.dequeue()->size(), 5);
+  ASSERT_GE(getCurrentTimeMicro() - startUs, 5'000);
+}
+
+TEST_F(TaskTest, streamingCursor) {
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 100; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int64_t>(
+        3, [&](auto row) { return i * 3 + row; })}));
+  }
+
+  CursorParameters params;
+  params.planNode = PlanBuilder().values(batches).planNode();
+  params.streaming = true;
+  params.streamingMinRows = 10;
+  params.streamingMaxLatencyMs = 3'600'000;
+
+  auto cursor = TaskCursor::create(params);
+  std::vector<RowVectorPtr> results;
+  while (cursor->moveNext()) {
+    results.push_back(cursor->current());
+  }
+  ASSERT_TRUE(waitForTaskCompletion(cursor->task().get()));
+
+  for (auto i = 0; i + 1 < results.size(); ++i) {
+    ASSERT_GE(results[i]->size(), params.streamingMinRows);
+  }
+  assertEqualResults(batches, results);
+}
+
 TEST_F(TaskTest, serialExecution) {
   auto data = makeRowVector({
       makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
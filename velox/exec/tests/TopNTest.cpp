@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/TopN.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -166,6 +169,47 @@ TEST_F(TopNTest, multipleKeys) {
   testTwoKeys(vectors, "c0", "c1", 200);
 }
 
+TEST_F(TopNTest, prefilter) {
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    // The first keys repeat across batches, so that the rows equal to the top
+    // of the heap are compared by the second key.
+    auto c0 = makeFlatVector<int32_t>(
+        batchSize,
+        [&](vector_size_t row) { return (row * 7 + i) % 50 - 25; },
+        nullEvery(13));
+    auto c1 = makeFlatVector<int64_t>(
+        batchSize, [&](vector_size_t row) { return i * batchSize - row; });
+    auto c2 = makeFlatVector<double>(
+        batchSize,
+        [&](vector_size_t row) { return (row % 101) * 0.5 - i; },
+        nullEvery(11));
+    // Dictionary-encoded keys are compared one row at a time.
+    auto c3 = wrapInDictionary(
+        makeIndicesInReverse(batchSize),
+        makeFlatVector<int16_t>(
+            batchSize, [&](vector_size_t row) { return row % 300 - i; }));
+    vectors.push_back(makeRowVector({c0, c1, c2, c3}));
+  }
+  createDuckDbTable(vectors);
+
+  testSingleKey(vectors, "c2", 50);
+  testSingleKey(vectors, "c3", 50);
+  testTwoKeys(vectors, "c0", "c1", 100);
+
+  core::PlanNodeId topNId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .topN({"c0", "c1"}, 10, false)
+                  .capturePlanNodeId(topNId)
+                  .planNode();
+  auto task = assertQueryOrdered(
+      plan, "SELECT * FROM tmp ORDER BY c0, c1 LIMIT 10", {0, 1});
+  const auto stats = toPlanStats(task->taskStats()).at(topNId).customStats;
+  ASSERT_GT(stats.at(exec::TopN::kNumPrefilteredRows).sum, 8 * batchSize);
+}
+
 TEST_F(TopNTest, compaction) {
   vector_size_t batchSize = 1000;
   std::vector<RowVectorPtr> vectors;
@@ -234,6 +278,44 @@ TEST_F(TopNTest, multiBatch) {
   testSingleKey(vectors, "c2", 2'500);
 }
 
+TEST_F(TopNTest, lateMaterialization) {
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize, [&](vector_size_t row) { return batchSize * i + row; });
+    auto c1 = makeFlatVector<std::string>(batchSize, [&](vector_size_t row) {
+      return "non inline string " + std::to_string(batchSize * i + row);
+    });
+    auto c2 = makeArrayVector<int32_t>(
+        batchSize,
+        [](vector_size_t row) { return row % 5; },
+        [](vector_size_t row) { return row; },
+        nullEvery(7));
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  // Each row of the input pushes the top of the heap out. With 1 and 2 batches
+  // the non-key columns are compacted.
+  for (const auto maxBatches : {1, 2, 100}) {
+    SCOPED_TRACE(fmt::format("maxBatches: {}", maxBatches));
+    for (const auto limit : {10, 1'500}) {
+      auto plan = PlanBuilder()
+                      .values(vectors)
+                      .topN({"c0 DESC"}, limit, false)
+                      .planNode();
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(
+              core::QueryConfig::kTopNLateMaterializationMaxBatches, maxBatches)
+          .assertResults(
+              fmt::format(
+                  "SELECT * FROM tmp ORDER BY c0 DESC LIMIT {}", limit),
+              {{0}});
+    }
+  }
+}
+
 TEST_F(TopNTest, empty) {
   vector_size_t batchSize = 1'000;
   std::vector<RowVectorPtr> vectors;
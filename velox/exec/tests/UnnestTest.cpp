@@ -477,6 +477,44 @@ TEST_P(UnnestTest, batchSize) {
   ASSERT_EQ(expectedNumVectors, stats.at(unnestId).outputVectors);
 }
 
+TEST_P(UnnestTest, hugeArray) {
+  // One row with an array much larger than the output batch and one row with a
+  // small array.
+  auto data = makeRowVector({
+      makeFlatVector<std::string>({"huge array", "small array"}),
+      makeArrayVector<int64_t>({
+          std::vector<int64_t>(5'000, 7),
+          {1, 2, 3},
+      }),
+  });
+
+  auto plan = PlanBuilder().values({data}).unnest({"c0"}, {"c1"}).planNode();
+  auto [cursor, results] = readCursor(makeCursorParameters(plan));
+
+  vector_size_t numRows = 0;
+  for (const auto& result : results) {
+    ASSERT_LE(result->size(), batchSize_);
+    // Parts of one input row repeat it as a constant and slice its array.
+    if (numRows + result->size() <= 5'000) {
+      ASSERT_TRUE(result->childAt(0)->isConstantEncoding());
+      ASSERT_TRUE(result->childAt(1)->isFlatEncoding());
+    }
+    numRows += result->size();
+  }
+  ASSERT_EQ(numRows, 5'003);
+
+  auto expected = makeRowVector({
+      makeFlatVector<std::string>(
+          5'003,
+          [](auto row) {
+            return std::string(row < 5'000 ? "huge array" : "small array");
+          }),
+      makeFlatVector<int64_t>(
+          5'003, [](auto row) { return row < 5'000 ? 7 : row - 4'999; }),
+  });
+  assertEqualResults({expected}, results);
+}
+
 TEST_P(UnnestTest, barrier) {
   std::vector<RowVectorPtr> vectors;
   std::vector<std::shared_ptr<TempFilePath>> tempFiles;
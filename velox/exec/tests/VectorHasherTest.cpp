@@ -448,6 +448,36 @@ TEST_F(VectorHasherTest, stringIds) {
   EXPECT_EQ(numInRange, rows.countSelected());
 }
 
+TEST_F(VectorHasherTest, shortStringRange) {
+  constexpr int32_t kNumRows = 1'000;
+  std::vector<std::string> codes = {"", "a", "us", "fin", "deu", "swe"};
+  auto vector = makeFlatVector<StringView>(kNumRows, [&](auto row) {
+    return StringView(codes[row % codes.size()]);
+  });
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 0);
+  SelectivityVector rows(kNumRows);
+  raw_vector<uint64_t> ids(kNumRows);
+  hasher->decode(*vector, rows);
+  EXPECT_FALSE(hasher->computeValueIds(rows, ids));
+  hasher->enableValueRange(1, 0);
+
+  // Equal strings get equal ids and different strings different ones.
+  hasher->decode(*vector, rows);
+  ASSERT_TRUE(hasher->computeValueIds(rows, ids));
+  std::unordered_set<uint64_t> distinctIds;
+  for (auto i = 0; i < kNumRows; ++i) {
+    ASSERT_EQ(ids[i], ids[i % codes.size()]);
+    ASSERT_GT(ids[i], 0);
+    distinctIds.insert(ids[i]);
+  }
+  ASSERT_EQ(distinctIds.size(), codes.size());
+
+  // A string longer than 7 bytes does not map.
+  vector->set(kNumRows / 2, StringView("abcdefgh"));
+  hasher->decode(*vector, rows);
+  ASSERT_FALSE(hasher->computeValueIds(rows, ids));
+}
+
 // Tests distinct overflow, but starting with a small string
 TEST_F(VectorHasherTest, stringDistinctOverflow) {
   auto hasher = exec::VectorHasher::create(VARCHAR(), 1);
@@ -1073,6 +1103,57 @@ TEST_F(VectorHasherTest, typeMismatch) {
       hasher->decode(*data, rows), "Type mismatch: BIGINT vs. VARCHAR");
 }
 
+TEST_F(VectorHasherTest, hashFused) {
+  const vector_size_t size = 1'000;
+  auto bigints = makeFlatVector<int64_t>(size, [](auto row) { return row; });
+  auto integers =
+      makeFlatVector<int32_t>(size, [](auto row) { return row * 7; });
+  auto dates = makeFlatVector<int32_t>(
+      size, [](auto row) { return row % 100; }, nullptr, DATE());
+  auto strings = makeFlatVector<std::string>(
+      size, [](auto row) { return std::string(row % 30, 'a' + row % 26); });
+  auto nullableBigints =
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }, nullEvery(7));
+  auto doubles = makeFlatVector<double>(size, [](auto row) { return row; });
+
+  SelectivityVector rows(size);
+  rows.setValidRange(0, 10, false);
+  rows.updateBounds();
+
+  auto testFused = [&](const std::vector<VectorPtr>& keys, bool fused) {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    raw_vector<uint64_t> expected(size);
+    for (auto i = 0; i < keys.size(); ++i) {
+      hashers.push_back(VectorHasher::create(keys[i]->type(), i));
+      hashers.back()->decode(*keys[i], rows);
+      hashers.back()->hash(rows, i > 0, expected);
+    }
+    raw_vector<uint64_t> actual(size);
+    ASSERT_EQ(VectorHasher::hashFused(hashers, rows, actual), fused);
+    if (fused) {
+      rows.applyToSelected([&](auto row) {
+        ASSERT_EQ(actual[row], expected[row]) << "at " << row;
+      });
+    }
+  };
+
+  testFused({bigints, bigints}, true);
+  testFused({bigints, strings}, true);
+  testFused({strings, bigints}, true);
+  testFused({integers, integers}, true);
+  testFused({integers, integers, dates}, true);
+  testFused({bigints, bigints, strings}, true);
+  testFused({bigints, integers, bigints, bigints}, false);
+  testFused({bigints, bigints, bigints, bigints}, true);
+
+  // Single keys, nulls, encodings and other types use the column-wise path.
+  testFused({bigints}, false);
+  testFused({bigints, nullableBigints}, false);
+  testFused(
+      {bigints, wrapInDictionary(makeIndicesInReverse(size), bigints)}, false);
+  testFused({bigints, doubles}, false);
+}
+
 void testCustomComparison(const VectorPtr& actual, const VectorPtr& expected) {
   // Vector hasher should hash the values in actual to the same hashes as it
   // does when hashing the values in expected.
@@ -19,6 +19,7 @@
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/RowsStreamingWindowBuild.h"
 #include "velox/exec/SortWindowBuild.h"
+#include "velox/exec/Window.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -323,6 +324,48 @@ DEBUG_ONLY_TEST_F(WindowTest, valuesRowsStreamingWindowBuild) {
   ASSERT_TRUE(isStreamCreated.load());
 }
 
+DEBUG_ONLY_TEST_F(WindowTest, boundedRowsFrameStreamingWindowBuild) {
+  const vector_size_t size = 1'000;
+
+  auto data = makeRowVector(
+      {makeFlatVector<int32_t>(size, [](auto row) { return row % 5; }),
+       makeFlatVector<int32_t>(size, [](auto row) { return row % 50; }),
+       makeFlatVector<int64_t>(
+           size, [](auto row) { return row % 3 + 1; }, nullEvery(5)),
+       makeFlatVector<int32_t>(size, [](auto row) { return row % 40; }),
+       makeFlatVector<int32_t>(size, [](auto row) { return row; })});
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> kClauses = {
+      "sum(c4) over (partition by c0 order by c1, c3, c4 rows between 3 preceding and 2 following)",
+      "min(c2) over (partition by c0 order by c1, c3, c4 rows between current row and 5 following)",
+      "count(c2) over (partition by c0 order by c1, c3, c4 rows between unbounded preceding and 1 following)",
+      "avg(c4) over (partition by c0 order by c1, c3, c4 rows between 10 preceding and 2 preceding)",
+      "row_number() over (partition by c0 order by c1, c3, c4)"};
+
+  auto plan = PlanBuilder()
+                  .values({split(data, 10)})
+                  .orderBy({"c0", "c1", "c3", "c4"}, false)
+                  .streamingWindow(kClauses)
+                  .planNode();
+
+  std::atomic_bool isStreamCreated{false};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::RowsStreamingWindowBuild::RowsStreamingWindowBuild",
+      std::function<void(RowsStreamingWindowBuild*)>(
+          [&](RowsStreamingWindowBuild* windowBuild) {
+            isStreamCreated.store(true);
+          }));
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kPreferredOutputBatchRows, "3")
+      .config(core::QueryConfig::kMaxOutputBatchRows, "3")
+      .assertResults(fmt::format(
+          "SELECT *, {} FROM tmp", folly::join(", ", kClauses)));
+  ASSERT_TRUE(isStreamCreated.load());
+}
+
 DEBUG_ONLY_TEST_F(WindowTest, aggregationWithNonDefaultFrame) {
   const vector_size_t size = 1'00;
 
@@ -395,6 +438,58 @@ DEBUG_ONLY_TEST_F(WindowTest, nonRowsStreamingWindow) {
   ASSERT_FALSE(isStreamCreated.load());
 }
 
+TEST_F(WindowTest, parallelEvaluation) {
+  constexpr int32_t kNumDrivers = 4;
+  const vector_size_t size = 5'000;
+  auto data = makeRowVector(
+      {makeFlatVector<int32_t>(
+           size, [](auto row) { return (row * 7919) % 97; }, nullEvery(31)),
+       makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(
+           size, [](auto row) { return row % 11 - 5; }, nullEvery(7))});
+
+  // Each driver reads all the values. The rows read by different drivers are
+  // identical, so the results do not depend on the order of their ties.
+  std::vector<RowVectorPtr> duckDbVectors(kNumDrivers, data);
+  createDuckDbTable(duckDbVectors);
+
+  const std::vector<std::vector<std::string>> kClauses = {
+      {"rank() over (order by c0)",
+       "dense_rank() over (order by c0)",
+       "sum(c2) over (order by c0)",
+       "min(c2) over (order by c0)",
+       "max(c2) over (order by c0)",
+       "count(c2) over (order by c0)"},
+      {"row_number() over (order by c1 desc)",
+       "sum(c2) over (order by c1 desc rows unbounded preceding)"}};
+  for (const auto& clauses : kClauses) {
+    SCOPED_TRACE(folly::join(", ", clauses));
+    core::PlanNodeId windowId;
+    auto plan = PlanBuilder()
+                    .values(split(data, 10), true)
+                    .window(clauses)
+                    .capturePlanNodeId(windowId)
+                    .planNode();
+
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .maxDrivers(kNumDrivers)
+            .config(core::QueryConfig::kWindowParallelEvaluationEnabled, true)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "1000")
+            .assertResults(fmt::format(
+                "SELECT *, {} FROM tmp", folly::join(", ", clauses)));
+
+    // Each driver evaluates one key range.
+    const auto& rangeRows =
+        toPlanStats(task->taskStats())
+            .at(windowId)
+            .customStats.at(Window::kParallelEvaluationRangeRows);
+    ASSERT_EQ(rangeRows.count, kNumDrivers);
+    ASSERT_EQ(rangeRows.sum, kNumDrivers * size);
+    ASSERT_GT(rangeRows.min, 0);
+  }
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
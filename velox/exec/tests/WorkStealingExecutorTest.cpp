@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/WorkStealingExecutor.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace facebook::velox::exec;
+
+TEST(WorkStealingExecutorTest, run) {
+  constexpr int32_t kNumTasks = 1'000;
+  std::atomic_int32_t numRun{0};
+  {
+    WorkStealingExecutor executor(4);
+    ASSERT_EQ(executor.numThreads(), 4);
+    ASSERT_EQ(executor.currentWorker(), -1);
+    for (auto i = 0; i < kNumTasks; ++i) {
+      executor.add([&]() { ++numRun; });
+    }
+    // A function which throws does not stop its worker.
+    executor.add([]() { throw std::runtime_error("expected"); });
+  }
+  ASSERT_EQ(numRun, kNumTasks);
+}
+
+TEST(WorkStealingExecutorTest, preferredWorker) {
+  WorkStealingExecutor executor(4);
+  for (auto worker = 0; worker < executor.numThreads(); ++worker) {
+    folly::Baton<> done;
+    int32_t ranOn{-1};
+    int32_t addedOn{-1};
+    executor.add(
+        [&]() {
+          ranOn = executor.currentWorker();
+          // A function added from a worker goes to the queue of that worker.
+          executor.add([&]() {
+            addedOn = executor.currentWorker();
+            done.post();
+          });
+        },
+        worker);
+    done.wait();
+    ASSERT_EQ(ranOn, worker);
+    ASSERT_EQ(addedOn, worker);
+  }
+  // Another executor's worker is not a worker of 'executor'.
+  WorkStealingExecutor other(1);
+  folly::Baton<> done;
+  int32_t worker{0};
+  other.add([&]() {
+    worker = executor.currentWorker();
+    done.post();
+  });
+  done.wait();
+  ASSERT_EQ(worker, -1);
+}
+
+TEST(WorkStealingExecutorTest, steal) {
+  WorkStealingExecutor executor(2);
+  // Block worker 0 and queue more functions behind it. Worker 1 steals them.
+  folly::Baton<> started;
+  folly::Baton<> release;
+  folly::Baton<> done;
+  std::atomic_int32_t numRun{0};
+  std::vector<int32_t> workers(10, -1);
+  executor.add(
+      [&]() {
+        started.post();
+        release.wait();
+      },
+      0);
+  started.wait();
+  for (auto i = 0; i < workers.size(); ++i) {
+    executor.add(
+        [&, i]() {
+          workers[i] = executor.currentWorker();
+          if (++numRun == workers.size()) {
+            done.post();
+          }
+        },
+        0);
+  }
+  done.wait();
+  for (auto worker : workers) {
+    ASSERT_EQ(worker, 1);
+  }
+  ASSERT_EQ(executor.stats().numSteals, workers.size());
+  release.post();
+}
+
+TEST(WorkStealingExecutorTest, virtualTime) {
+  WorkStealingExecutor executor(1);
+  folly::Baton<> started;
+  folly::Baton<> release;
+  executor.add([&]() {
+    started.post();
+    release.wait();
+  });
+  started.wait();
+
+  // Queued behind the blocked function, these run in the order of their
+  // virtual time and FIFO among the same virtual time.
+  std::vector<int32_t> order;
+  folly::Baton<> done;
+  const std::vector<uint64_t> virtualTimes{30, 10, 20, 10, 0};
+  for (auto i = 0; i < virtualTimes.size(); ++i) {
+    executor.add(
+        [&, i]() {
+          order.push_back(i);
+          if (order.size() == virtualTimes.size()) {
+            done.post();
+          }
+        },
+        0,
+        virtualTimes[i]);
+  }
+  release.post();
+  done.wait();
+  ASSERT_EQ(order, std::vector<int32_t>({4, 1, 3, 2, 0}));
+}
+
+TEST(WorkStealingExecutorTest, numaNodes) {
+  VELOX_ASSERT_THROW(WorkStealingExecutor(2, "test", 3), "(3 vs. 2)");
+
+  WorkStealingExecutor executor(5, "test", 2);
+  ASSERT_EQ(executor.numNodes(), 2);
+  ASSERT_EQ(executor.minThreadsPerNode(), 2);
+  const std::vector<int32_t> expectedNodes{0, 0, 1, 1, 1};
+  for (auto worker = 0; worker < executor.numThreads(); ++worker) {
+    ASSERT_EQ(executor.nodeOf(worker), expectedNodes[worker]);
+  }
+  ASSERT_EQ(executor.nextNode(), 0);
+  ASSERT_EQ(executor.nextNode(), 1);
+  ASSERT_EQ(executor.nextNode(), 0);
+  for (auto i = 0; i < 6; ++i) {
+    ASSERT_EQ(executor.nextWorker(0), i % 2);
+    ASSERT_EQ(executor.nextWorker(1), 2 + i % 3);
+  }
+
+  // The functions queued behind a blocked worker of node 0 are stolen by the
+  // other workers, the one of node 0 first.
+  folly::Baton<> started;
+  folly::Baton<> release;
+  executor.add(
+      [&]() {
+        started.post();
+        release.wait();
+      },
+      0);
+  started.wait();
+  constexpr int32_t kNumFuncs = 100;
+  std::atomic_int32_t numRun{0};
+  folly::Baton<> done;
+  for (auto i = 0; i < kNumFuncs; ++i) {
+    executor.add(
+        [&]() {
+          if (++numRun == kNumFuncs) {
+            done.post();
+          }
+        },
+        0);
+  }
+  done.wait();
+  const auto stats = executor.stats();
+  ASSERT_EQ(stats.numSteals, kNumFuncs);
+  ASSERT_LE(stats.numCrossNodeSteals, stats.numSteals);
+  release.post();
+}
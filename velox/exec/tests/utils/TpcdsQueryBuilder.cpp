@@ -0,0 +1,587 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+#include <fstream>
+
+namespace facebook::velox::exec::test {
+
+void TpcdsQueryBuilder::readFileSchema(
+    const std::string& tableName,
+    const std::string& path) {
+  dwio::common::ReaderOptions readerOptions{pool_.get()};
+  readerOptions.setFileFormat(format_);
+  std::shared_ptr<ReadFile> readFile =
+      filesystems::getFileSystem(path, nullptr)->openFileForRead(path);
+  auto input = std::make_unique<dwio::common::BufferedInput>(
+      readFile, readerOptions.memoryPool());
+  auto reader = dwio::common::getReaderFactory(readerOptions.fileFormat())
+                    ->createReader(std::move(input), readerOptions);
+  tableMetadata_[tableName].type = reader->rowType();
+}
+
+void TpcdsQueryBuilder::initialize(const std::string& dataPath) {
+  for (const auto& tableName : getTableNames()) {
+    const fs::path tablePath{dataPath + "/" + tableName};
+    auto& metadata = tableMetadata_[tableName];
+    std::error_code error;
+    for (const auto& dirEntry : fs::directory_iterator{
+             tablePath, std::filesystem::directory_options(), error}) {
+      // Ignore directories and hidden files.
+      if (!dirEntry.is_regular_file() ||
+          dirEntry.path().filename().c_str()[0] == '.') {
+        continue;
+      }
+      if (metadata.dataFiles.empty()) {
+        readFileSchema(tableName, dirEntry.path().string());
+      }
+      metadata.dataFiles.push_back(dirEntry.path());
+    }
+    if (metadata.dataFiles.empty() && error) {
+      std::ifstream file(tablePath);
+      std::string line;
+      while (std::getline(file, line)) {
+        if (metadata.dataFiles.empty()) {
+          readFileSchema(tableName, line);
+        }
+        metadata.dataFiles.push_back(line);
+      }
+    }
+  }
+}
+
+RowTypePtr TpcdsQueryBuilder::getRowType(
+    const std::string& tableName,
+    const std::vector<std::string>& columnNames) const {
+  const auto& metadata = tableMetadata_.at(tableName);
+  VELOX_USER_CHECK_NOT_NULL(
+      metadata.type, "No data files found for TPC-DS table {}", tableName);
+  std::vector<TypePtr> types;
+  types.reserve(columnNames.size());
+  for (const auto& name : columnNames) {
+    types.push_back(metadata.type->findChild(name));
+  }
+  return ROW(std::vector<std::string>(columnNames), std::move(types));
+}
+
+const std::vector<std::string>& TpcdsQueryBuilder::getTableFilePaths(
+    const std::string& tableName) const {
+  return tableMetadata_.at(tableName).dataFiles;
+}
+
+PlanBuilder& TpcdsQueryBuilder::scan(
+    PlanBuilder& builder,
+    const std::string& tableName,
+    const std::vector<std::string>& columns,
+    const std::vector<std::string>& subfieldFilters,
+    TpchPlan& plan,
+    const std::string& remainingFilter) const {
+  core::PlanNodeId scanNodeId;
+  builder
+      .tableScan(
+          tableName,
+          getRowType(tableName, columns),
+          {},
+          subfieldFilters,
+          remainingFilter)
+      .captureScanNodeId(scanNodeId);
+  plan.dataFiles[scanNodeId] = getTableFilePaths(tableName);
+  return builder;
+}
+
+TpchPlan TpcdsQueryBuilder::getQueryPlan(int queryId) const {
+  switch (queryId) {
+    case 3:
+      return getQ3Plan();
+    case 7:
+      return getQ7Plan();
+    case 27:
+      return getQ27Plan();
+    case 96:
+      return getQ96Plan();
+    case 98:
+      return getQ98Plan();
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+}
+
+// select dt.d_year, item.i_brand_id brand_id, item.i_brand brand,
+//   sum(ss_ext_sales_price) sum_agg
+// from date_dim dt, store_sales, item
+// where dt.d_date_sk = store_sales.ss_sold_date_sk
+//   and store_sales.ss_item_sk = item.i_item_sk
+//   and item.i_manufact_id = 128 and dt.d_moy = 11
+// group by dt.d_year, item.i_brand, item.i_brand_id
+// order by dt.d_year, sum_agg desc, brand_id
+// limit 100
+TpchPlan TpcdsQueryBuilder::getQ3Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  PlanBuilder items(planNodeIdGenerator, pool_.get());
+  scan(
+      items,
+      kItem,
+      {"i_item_sk", "i_brand_id", "i_brand", "i_manufact_id"},
+      {"i_manufact_id = 128"},
+      context);
+
+  PlanBuilder dates(planNodeIdGenerator, pool_.get());
+  scan(
+      dates,
+      kDateDim,
+      {"d_date_sk", "d_year", "d_moy"},
+      {"d_moy = 11"},
+      context);
+
+  PlanBuilder sales(planNodeIdGenerator, pool_.get());
+  context.plan =
+      scan(
+          sales,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"},
+          {},
+          context)
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items.planNode(),
+              "",
+              {"ss_sold_date_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates.planNode(),
+              "",
+              {"d_year", "i_brand_id", "i_brand", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"d_year", "i_brand", "i_brand_id"},
+              {"sum(ss_ext_sales_price) AS sum_agg"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"d_year", "sum_agg DESC", "i_brand_id"}, 100, false)
+          .project(
+              {"d_year",
+               "i_brand_id AS brand_id",
+               "i_brand AS brand",
+               "sum_agg"})
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+// select i_item_id, avg(ss_quantity) agg1, avg(ss_list_price) agg2,
+//   avg(ss_coupon_amt) agg3, avg(ss_sales_price) agg4
+// from store_sales, customer_demographics, date_dim, item, promotion
+// where ss_sold_date_sk = d_date_sk and ss_item_sk = i_item_sk
+//   and ss_cdemo_sk = cd_demo_sk and ss_promo_sk = p_promo_sk
+//   and cd_gender = 'M' and cd_marital_status = 'S'
+//   and cd_education_status = 'College'
+//   and (p_channel_email = 'N' or p_channel_event = 'N')
+//   and d_year = 2000
+// group by i_item_id
+// order by i_item_id
+// limit 100
+TpchPlan TpcdsQueryBuilder::getQ7Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  PlanBuilder dates(planNodeIdGenerator, pool_.get());
+  scan(dates, kDateDim, {"d_date_sk", "d_year"}, {"d_year = 2000"}, context);
+
+  PlanBuilder demographics(planNodeIdGenerator, pool_.get());
+  scan(
+      demographics,
+      kCustomerDemographics,
+      {"cd_demo_sk", "cd_gender", "cd_marital_status", "cd_education_status"},
+      {"cd_gender = 'M'",
+       "cd_marital_status = 'S'",
+       "cd_education_status = 'College'"},
+      context);
+
+  PlanBuilder promotions(planNodeIdGenerator, pool_.get());
+  scan(
+      promotions,
+      kPromotion,
+      {"p_promo_sk", "p_channel_email", "p_channel_event"},
+      {},
+      context,
+      "p_channel_email = 'N' OR p_channel_event = 'N'");
+
+  PlanBuilder items(planNodeIdGenerator, pool_.get());
+  scan(items, kItem, {"i_item_sk", "i_item_id"}, {}, context);
+
+  const std::vector<std::string> measures = {
+      "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+  auto withMeasures = [&](std::vector<std::string> columns) {
+    columns.insert(columns.end(), measures.begin(), measures.end());
+    return columns;
+  };
+
+  PlanBuilder sales(planNodeIdGenerator, pool_.get());
+  context.plan =
+      scan(
+          sales,
+          kStoreSales,
+          withMeasures(
+              {"ss_sold_date_sk", "ss_item_sk", "ss_cdemo_sk", "ss_promo_sk"}),
+          {},
+          context)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates.planNode(),
+              "",
+              withMeasures({"ss_item_sk", "ss_cdemo_sk", "ss_promo_sk"}))
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics.planNode(),
+              "",
+              withMeasures({"ss_item_sk", "ss_promo_sk"}))
+          .hashJoin(
+              {"ss_promo_sk"},
+              {"p_promo_sk"},
+              promotions.planNode(),
+              "",
+              withMeasures({"ss_item_sk"}))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items.planNode(),
+              "",
+              withMeasures({"i_item_id"}))
+          .partialAggregation(
+              {"i_item_id"},
+              {"avg(ss_quantity) AS agg1",
+               "avg(ss_list_price) AS agg2",
+               "avg(ss_coupon_amt) AS agg3",
+               "avg(ss_sales_price) AS agg4"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"i_item_id"}, 100, false)
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+// select i_item_id, s_state, grouping(s_state) g_state,
+//   avg(ss_quantity) agg1, avg(ss_list_price) agg2,
+//   avg(ss_coupon_amt) agg3, avg(ss_sales_price) agg4
+// from store_sales, customer_demographics, date_dim, store, item
+// where ss_sold_date_sk = d_date_sk and ss_item_sk = i_item_sk
+//   and ss_store_sk = s_store_sk and ss_cdemo_sk = cd_demo_sk
+//   and cd_gender = 'M' and cd_marital_status = 'S'
+//   and cd_education_status = 'College' and d_year = 2002
+//   and s_state in ('TN')
+// group by rollup (i_item_id, s_state)
+// order by i_item_id, s_state
+// limit 100
+TpchPlan TpcdsQueryBuilder::getQ27Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  PlanBuilder dates(planNodeIdGenerator, pool_.get());
+  scan(dates, kDateDim, {"d_date_sk", "d_year"}, {"d_year = 2002"}, context);
+
+  PlanBuilder demographics(planNodeIdGenerator, pool_.get());
+  scan(
+      demographics,
+      kCustomerDemographics,
+      {"cd_demo_sk", "cd_gender", "cd_marital_status", "cd_education_status"},
+      {"cd_gender = 'M'",
+       "cd_marital_status = 'S'",
+       "cd_education_status = 'College'"},
+      context);
+
+  PlanBuilder stores(planNodeIdGenerator, pool_.get());
+  scan(
+      stores, kStore, {"s_store_sk", "s_state"}, {"s_state = 'TN'"}, context);
+
+  PlanBuilder items(planNodeIdGenerator, pool_.get());
+  scan(items, kItem, {"i_item_sk", "i_item_id"}, {}, context);
+
+  const std::vector<std::string> measures = {
+      "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+  auto withMeasures = [&](std::vector<std::string> columns) {
+    columns.insert(columns.end(), measures.begin(), measures.end());
+    return columns;
+  };
+
+  // The grouping sets of the rollup are (i_item_id, s_state), (i_item_id)
+  // and (). s_state is grouped out in all but the first.
+  PlanBuilder sales(planNodeIdGenerator, pool_.get());
+  context.plan =
+      scan(
+          sales,
+          kStoreSales,
+          withMeasures(
+              {"ss_sold_date_sk", "ss_item_sk", "ss_store_sk", "ss_cdemo_sk"}),
+          {},
+          context)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates.planNode(),
+              "",
+              withMeasures({"ss_item_sk", "ss_store_sk", "ss_cdemo_sk"}))
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics.planNode(),
+              "",
+              withMeasures({"ss_item_sk", "ss_store_sk"}))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores.planNode(),
+              "",
+              withMeasures({"ss_item_sk", "s_state"}))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items.planNode(),
+              "",
+              withMeasures({"i_item_id", "s_state"}))
+          .groupId(
+              {"i_item_id", "s_state"},
+              {{"i_item_id", "s_state"}, {"i_item_id"}, {}},
+              measures)
+          .partialAggregation(
+              {"i_item_id", "s_state", "group_id"},
+              {"avg(ss_quantity) AS agg1",
+               "avg(ss_list_price) AS agg2",
+               "avg(ss_coupon_amt) AS agg3",
+               "avg(ss_sales_price) AS agg4"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"i_item_id",
+               "s_state",
+               "if(group_id = 0, 0, 1) AS g_state",
+               "agg1",
+               "agg2",
+               "agg3",
+               "agg4"})
+          .topN({"i_item_id", "s_state"}, 100, false)
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+// select count(*)
+// from store_sales, household_demographics, time_dim, store
+// where ss_sold_time_sk = time_dim.t_time_sk
+//   and ss_hdemo_sk = household_demographics.hd_demo_sk
+//   and ss_store_sk = s_store_sk
+//   and time_dim.t_hour = 20 and time_dim.t_minute >= 30
+//   and household_demographics.hd_dep_count = 7
+//   and store.s_store_name = 'ese'
+TpchPlan TpcdsQueryBuilder::getQ96Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  PlanBuilder times(planNodeIdGenerator, pool_.get());
+  scan(
+      times,
+      kTimeDim,
+      {"t_time_sk", "t_hour", "t_minute"},
+      {"t_hour = 20", "t_minute >= 30"},
+      context);
+
+  PlanBuilder households(planNodeIdGenerator, pool_.get());
+  scan(
+      households,
+      kHouseholdDemographics,
+      {"hd_demo_sk", "hd_dep_count"},
+      {"hd_dep_count = 7"},
+      context);
+
+  PlanBuilder stores(planNodeIdGenerator, pool_.get());
+  scan(
+      stores,
+      kStore,
+      {"s_store_sk", "s_store_name"},
+      {"s_store_name = 'ese'"},
+      context);
+
+  PlanBuilder sales(planNodeIdGenerator, pool_.get());
+  context.plan =
+      scan(
+          sales,
+          kStoreSales,
+          {"ss_sold_time_sk", "ss_hdemo_sk", "ss_store_sk"},
+          {},
+          context)
+          .hashJoin(
+              {"ss_sold_time_sk"},
+              {"t_time_sk"},
+              times.planNode(),
+              "",
+              {"ss_hdemo_sk", "ss_store_sk"})
+          .hashJoin(
+              {"ss_hdemo_sk"},
+              {"hd_demo_sk"},
+              households.planNode(),
+              "",
+              {"ss_store_sk"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores.planNode(),
+              "",
+              {"ss_store_sk"})
+          .partialAggregation({}, {"count(0) AS cnt"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+// select i_item_id, i_item_desc, i_category, i_class, i_current_price,
+//   sum(ss_ext_sales_price) as itemrevenue,
+//   sum(ss_ext_sales_price) * 100 / sum(sum(ss_ext_sales_price)) over
+//     (partition by i_class) as revenueratio
+// from store_sales, item, date_dim
+// where ss_item_sk = i_item_sk
+//   and i_category in ('Sports', 'Books', 'Home')
+//   and ss_sold_date_sk = d_date_sk
+//   and d_date between cast('1999-02-22' as date)
+//     and (cast('1999-02-22' as date) + interval '30' day)
+// group by i_item_id, i_item_desc, i_category, i_class, i_current_price
+// order by i_category, i_class, i_item_id, i_item_desc, revenueratio
+TpchPlan TpcdsQueryBuilder::getQ98Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  const std::vector<std::string> itemColumns = {
+      "i_item_id", "i_item_desc", "i_category", "i_class", "i_current_price"};
+
+  PlanBuilder items(planNodeIdGenerator, pool_.get());
+  std::vector<std::string> itemScanColumns = {"i_item_sk"};
+  itemScanColumns.insert(
+      itemScanColumns.end(), itemColumns.begin(), itemColumns.end());
+  scan(
+      items,
+      kItem,
+      itemScanColumns,
+      {"i_category IN ('Sports', 'Books', 'Home')"},
+      context);
+
+  PlanBuilder dates(planNodeIdGenerator, pool_.get());
+  scan(
+      dates,
+      kDateDim,
+      {"d_date_sk", "d_date"},
+      {"d_date BETWEEN '1999-02-22'::DATE AND '1999-03-24'::DATE"},
+      context);
+
+  std::vector<std::string> joinOutput = itemColumns;
+  joinOutput.push_back("ss_ext_sales_price");
+
+  PlanBuilder sales(planNodeIdGenerator, pool_.get());
+  context.plan =
+      scan(
+          sales,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"},
+          {},
+          context)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates.planNode(),
+              "",
+              {"ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"}, {"i_item_sk"}, items.planNode(), "", joinOutput)
+          .partialAggregation(
+              itemColumns, {"sum(ss_ext_sales_price) AS itemrevenue"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .window({"sum(itemrevenue) OVER (PARTITION BY i_class) AS total"})
+          .project(
+              {"i_item_id",
+               "i_item_desc",
+               "i_category",
+               "i_class",
+               "i_current_price",
+               "itemrevenue",
+               "cast(itemrevenue AS DOUBLE) * 100.0 / "
+               "cast(total AS DOUBLE) AS revenueratio"})
+          .orderBy(
+              {"i_category",
+               "i_class",
+               "i_item_id",
+               "i_item_desc",
+               "revenueratio"},
+              false)
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getScanPlan() const {
+  const auto& type = tableMetadata_.at(kStoreSales).type;
+  VELOX_USER_CHECK_NOT_NULL(type, "No data files found for store_sales");
+  std::vector<std::string> aggregates;
+  aggregates.reserve(type->size());
+  for (const auto& name : type->names()) {
+    aggregates.push_back(fmt::format("max({})", name));
+  }
+
+  TpchPlan context;
+  PlanBuilder builder(pool_.get());
+  context.plan = scan(builder, kStoreSales, type->names(), {}, context)
+                     .partialAggregation({}, aggregates)
+                     .localPartition(std::vector<std::string>{})
+                     .finalAggregation()
+                     .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+// static
+const std::vector<int>& TpcdsQueryBuilder::supportedQueries() {
+  static const std::vector<int> kQueries = {3, 7, 27, 96, 98};
+  return kQueries;
+}
+
+// static
+const std::vector<std::string>& TpcdsQueryBuilder::getTableNames() {
+  static const std::vector<std::string> kTableNames = {
+      kStoreSales,
+      kDateDim,
+      kTimeDim,
+      kItem,
+      kStore,
+      kPromotion,
+      kCustomerDemographics,
+      kHouseholdDemographics};
+  return kTableNames;
+}
+
+} // namespace facebook::velox::exec::test
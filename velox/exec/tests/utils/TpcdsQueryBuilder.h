@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/dwio/common/Options.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TpchQueryBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+/// Builds plans for a subset of the TPC-DS queries that cover the operators
+/// the TPC-H queries exercise little: window functions (Q98), ROLLUP through
+/// GroupId (Q27), multi-way star joins on skewed fact keys (Q7, Q96) and wide
+/// scans (the scan plan).
+///
+/// The data files of each table must be in a sub-directory named after the
+/// table, like for TpchQueryBuilder, or the sub-directory path may be a file
+/// listing the paths of the data files, one per line. Unlike TPC-H, the
+/// column names in the files must be the standard TPC-DS names, e.g.
+/// ss_sold_date_sk, as produced by the common TPC-DS generators. The queries
+/// use the values of the qualification substitution parameters.
+class TpcdsQueryBuilder {
+ public:
+  explicit TpcdsQueryBuilder(dwio::common::FileFormat format)
+      : format_(format) {}
+
+  /// Reads the schema of a data file of each table and lists the data files
+  /// of each table under 'dataPath'.
+  void initialize(const std::string& dataPath);
+
+  /// Returns the plan of TPC-DS query 'queryId'. Throws if the query is not
+  /// supported.
+  TpchPlan getQueryPlan(int queryId) const;
+
+  /// Returns a plan that scans all the columns of store_sales and aggregates
+  /// each of them with max(), to measure the cost of wide scans.
+  TpchPlan getScanPlan() const;
+
+  /// Returns the numbers of the supported queries.
+  static const std::vector<int>& supportedQueries();
+
+  /// Returns the names of the tables the supported queries read.
+  static const std::vector<std::string>& getTableNames();
+
+ private:
+  void readFileSchema(const std::string& tableName, const std::string& path);
+
+  TpchPlan getQ3Plan() const;
+  TpchPlan getQ7Plan() const;
+  TpchPlan getQ27Plan() const;
+  TpchPlan getQ96Plan() const;
+  TpchPlan getQ98Plan() const;
+
+  // Adds a scan of 'columns' of 'tableName' to 'builder' and its data files to
+  // 'plan'.
+  PlanBuilder& scan(
+      PlanBuilder& builder,
+      const std::string& tableName,
+      const std::vector<std::string>& columns,
+      const std::vector<std::string>& subfieldFilters,
+      TpchPlan& plan,
+      const std::string& remainingFilter = "") const;
+
+  // Returns the type of 'columnNames' of 'tableName' in the order of
+  // 'columnNames'.
+  RowTypePtr getRowType(
+      const std::string& tableName,
+      const std::vector<std::string>& columnNames) const;
+
+  const std::vector<std::string>& getTableFilePaths(
+      const std::string& tableName) const;
+
+  struct TableMetadata {
+    RowTypePtr type;
+    std::vector<std::string> dataFiles;
+  };
+
+  std::unordered_map<std::string, TableMetadata> tableMetadata_;
+  const dwio::common::FileFormat format_;
+
+  static constexpr const char* kStoreSales = "store_sales";
+  static constexpr const char* kDateDim = "date_dim";
+  static constexpr const char* kTimeDim = "time_dim";
+  static constexpr const char* kItem = "item";
+  static constexpr const char* kStore = "store";
+  static constexpr const char* kPromotion = "promotion";
+  static constexpr const char* kCustomerDemographics = "customer_demographics";
+  static constexpr const char* kHouseholdDemographics =
+      "household_demographics";
+
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::memoryManager()->addLeafPool();
+};
+
+} // namespace facebook::velox::exec::test
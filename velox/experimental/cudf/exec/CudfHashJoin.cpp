@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/cudf/exec/CudfHashJoin.h"
+#include "velox/experimental/cudf/exec/ToCudf.h"
+#include "velox/experimental/cudf/exec/Utilities.h"
+#include "velox/experimental/cudf/exec/VeloxCudfInterop.h"
+
+#include "velox/exec/Task.h"
+
+#include <cudf/copying.hpp>
+#include <cudf/utilities/memory_resource.hpp>
+#include <cudf/utilities/span.hpp>
+
+#include <folly/ScopeGuard.h>
+
+namespace facebook::velox::cudf_velox {
+
+namespace {
+std::vector<cudf::size_type> keyChannels(
+    const std::vector<core::FieldAccessTypedExprPtr>& keys,
+    const RowTypePtr& inputType) {
+  std::vector<cudf::size_type> channels;
+  channels.reserve(keys.size());
+  for (const auto& key : keys) {
+    channels.push_back(inputType->getChildIdx(key->name()));
+  }
+  return channels;
+}
+} // namespace
+
+void CudfHashJoinBridge::setHashTable(HashTable hashTable) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK(!hashTable_.has_value(), "The hash table is already set");
+    hashTable_ = std::move(hashTable);
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+std::optional<CudfHashJoinBridge::HashTable>
+CudfHashJoinBridge::hashTableOrFuture(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(started_);
+  VELOX_CHECK(!cancelled_, "Getting hash table after join is aborted");
+  if (hashTable_.has_value()) {
+    return hashTable_;
+  }
+  promises_.emplace_back("CudfHashJoinBridge::hashTableOrFuture");
+  *future = promises_.back().getSemiFuture();
+  return std::nullopt;
+}
+
+bool isCudfHashJoinSupported(const core::HashJoinNode& joinNode) {
+  return (joinNode.isInnerJoin() || joinNode.isLeftJoin()) &&
+      !joinNode.isNullAware() && joinNode.filter() == nullptr;
+}
+
+CudfHashJoinBuild::CudfHashJoinBuild(
+    int32_t operatorId,
+    exec::DriverCtx* driverCtx,
+    std::shared_ptr<const core::HashJoinNode> joinNode)
+    : exec::Operator(
+          driverCtx,
+          nullptr,
+          operatorId,
+          joinNode->id(),
+          "CudfHashJoinBuild"),
+      NvtxHelper(
+          nvtx3::rgb{65, 105, 225}, // Royal Blue
+          operatorId,
+          fmt::format("[{}]", joinNode->id())),
+      joinNode_(std::move(joinNode)),
+      buildKeys_(keyChannels(
+          joinNode_->rightKeys(),
+          joinNode_->sources()[1]->outputType())) {}
+
+void CudfHashJoinBuild::addInput(RowVectorPtr input) {
+  // Accumulate inputs
+  if (input->size() > 0) {
+    auto cudfInput = std::dynamic_pointer_cast<CudfVector>(input);
+    VELOX_CHECK_NOT_NULL(cudfInput);
+    inputs_.push_back(std::move(cudfInput));
+  }
+}
+
+void CudfHashJoinBuild::noMoreInput() {
+  exec::Operator::noMoreInput();
+
+  VELOX_NVTX_OPERATOR_FUNC_RANGE();
+
+  // The last driver to finish builds the hash table on the input of all the
+  // build drivers.
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<exec::Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+
+  SCOPE_EXIT {
+    // Realize the promises so that the other drivers can continue and finish.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  };
+
+  for (auto& peer : peers) {
+    auto* build = dynamic_cast<CudfHashJoinBuild*>(
+        peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(build);
+    inputs_.insert(
+        inputs_.end(),
+        std::make_move_iterator(build->inputs_.begin()),
+        std::make_move_iterator(build->inputs_.end()));
+    build->inputs_.clear();
+  }
+
+  auto stream = cudfGlobalStreamPool().get_stream();
+  std::shared_ptr<cudf::table> table;
+  if (inputs_.empty()) {
+    const auto& buildType = joinNode_->sources()[1]->outputType();
+    table = with_arrow::toCudfTable(
+        BaseVector::create<RowVector>(buildType, 0, pool()), pool(), stream);
+  } else {
+    table = getConcatenatedTable(inputs_, stream);
+  }
+  // Release input data after synchronizing
+  stream.synchronize();
+  inputs_.clear();
+
+  VELOX_CHECK_NOT_NULL(table);
+  auto hashJoin = std::make_shared<cudf::hash_join>(
+      table->view().select(buildKeys_), cudf::null_equality::UNEQUAL, stream);
+  stream.synchronize();
+
+  auto joinBridge = std::dynamic_pointer_cast<CudfHashJoinBridge>(
+      operatorCtx_->task()->getCustomJoinBridge(
+          operatorCtx_->driverCtx()->splitGroupId, planNodeId()));
+  VELOX_CHECK_NOT_NULL(joinBridge);
+  joinBridge->setHashTable({std::move(table), std::move(hashJoin)});
+}
+
+exec::BlockingReason CudfHashJoinBuild::isBlocked(ContinueFuture* future) {
+  if (!future_.valid()) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  *future = std::move(future_);
+  return exec::BlockingReason::kWaitForJoinBuild;
+}
+
+void CudfHashJoinBuild::close() {
+  exec::Operator::close();
+  // Release cudf memory resources
+  inputs_.clear();
+}
+
+CudfHashJoinProbe::CudfHashJoinProbe(
+    int32_t operatorId,
+    exec::DriverCtx* driverCtx,
+    std::shared_ptr<const core::HashJoinNode> joinNode)
+    : exec::Operator(
+          driverCtx,
+          joinNode->outputType(),
+          operatorId,
+          joinNode->id(),
+          "CudfHashJoinProbe"),
+      NvtxHelper(
+          nvtx3::rgb{0, 191, 255}, // Deep Sky Blue
+          operatorId,
+          fmt::format("[{}]", joinNode->id())),
+      joinNode_(std::move(joinNode)) {
+  const auto& probeType = joinNode_->sources()[0]->outputType();
+  const auto& buildType = joinNode_->sources()[1]->outputType();
+  probeKeys_ = keyChannels(joinNode_->leftKeys(), probeType);
+  for (cudf::size_type i = 0; i < outputType_->size(); ++i) {
+    const auto& name = outputType_->nameOf(i);
+    if (auto channel = probeType->getChildIdxIfExists(name)) {
+      probeOutputChannels_.push_back(channel.value());
+      probeOutputIndices_.push_back(i);
+    } else {
+      buildOutputChannels_.push_back(buildType->getChildIdx(name));
+      buildOutputIndices_.push_back(i);
+    }
+  }
+}
+
+void CudfHashJoinProbe::addInput(RowVectorPtr input) {
+  if (input->size() > 0) {
+    auto cudfInput = std::dynamic_pointer_cast<CudfVector>(input);
+    VELOX_CHECK_NOT_NULL(cudfInput);
+    input_ = std::move(cudfInput);
+  }
+}
+
+RowVectorPtr CudfHashJoinProbe::getOutput() {
+  if (input_ == nullptr) {
+    finished_ = noMoreInput_ && hashTable_.has_value();
+    return nullptr;
+  }
+
+  VELOX_NVTX_OPERATOR_FUNC_RANGE();
+
+  auto input = std::move(input_);
+  auto stream = input->stream();
+  auto mr = cudf::get_current_device_resource_ref();
+  const auto probeView = input->getTableView();
+  const auto& [buildTable, hashJoin] = hashTable_.value();
+
+  // The gather maps of the joined probe and build rows. A left join maps the
+  // probe rows without a match to an out of bounds build row.
+  auto [probeIndices, buildIndices] = joinNode_->isInnerJoin()
+      ? hashJoin->inner_join(
+            probeView.select(probeKeys_), std::nullopt, stream, mr)
+      : hashJoin->left_join(
+            probeView.select(probeKeys_), std::nullopt, stream, mr);
+  const auto probeMap = cudf::column_view(
+      cudf::device_span<const cudf::size_type>(*probeIndices));
+  const auto buildMap = cudf::column_view(
+      cudf::device_span<const cudf::size_type>(*buildIndices));
+
+  auto probeColumns =
+      cudf::gather(
+          probeView.select(probeOutputChannels_),
+          probeMap,
+          cudf::out_of_bounds_policy::DONT_CHECK,
+          stream,
+          mr)
+          ->release();
+  auto buildColumns =
+      cudf::gather(
+          buildTable->view().select(buildOutputChannels_),
+          buildMap,
+          joinNode_->isInnerJoin() ? cudf::out_of_bounds_policy::DONT_CHECK
+                                   : cudf::out_of_bounds_policy::NULLIFY,
+          stream,
+          mr)
+          ->release();
+
+  std::vector<std::unique_ptr<cudf::column>> columns(outputType_->size());
+  for (auto i = 0; i < probeColumns.size(); ++i) {
+    columns[probeOutputIndices_[i]] = std::move(probeColumns[i]);
+  }
+  for (auto i = 0; i < buildColumns.size(); ++i) {
+    columns[buildOutputIndices_[i]] = std::move(buildColumns[i]);
+  }
+  const cudf::size_type size = probeIndices->size();
+
+  // Release input data after synchronizing
+  stream.synchronize();
+  input.reset();
+
+  if (size == 0) {
+    return nullptr;
+  }
+  return std::make_shared<CudfVector>(
+      pool(),
+      outputType_,
+      size,
+      std::make_unique<cudf::table>(std::move(columns)),
+      stream);
+}
+
+exec::BlockingReason CudfHashJoinProbe::isBlocked(ContinueFuture* future) {
+  if (hashTable_.has_value()) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  auto joinBridge = std::dynamic_pointer_cast<CudfHashJoinBridge>(
+      operatorCtx_->task()->getCustomJoinBridge(
+          operatorCtx_->driverCtx()->splitGroupId, planNodeId()));
+  VELOX_CHECK_NOT_NULL(joinBridge);
+  hashTable_ = joinBridge->hashTableOrFuture(future);
+  return hashTable_.has_value() ? exec::BlockingReason::kNotBlocked
+                                : exec::BlockingReason::kWaitForJoinBuild;
+}
+
+void CudfHashJoinProbe::close() {
+  exec::Operator::close();
+  // Release cudf memory resources
+  input_.reset();
+  hashTable_.reset();
+}
+
+std::unique_ptr<exec::JoinBridge> CudfHashJoinBridgeTranslator::toJoinBridge(
+    const core::PlanNodePtr& node) {
+  if (!cudfIsRegistered()) {
+    return nullptr;
+  }
+  auto joinNode = std::dynamic_pointer_cast<const core::HashJoinNode>(node);
+  if (joinNode == nullptr || !isCudfHashJoinSupported(*joinNode)) {
+    return nullptr;
+  }
+  return std::make_unique<CudfHashJoinBridge>();
+}
+
+} // namespace facebook::velox::cudf_velox
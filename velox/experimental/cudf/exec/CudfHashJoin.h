@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/cudf/exec/NvtxHelper.h"
+#include "velox/experimental/cudf/vector/CudfVector.h"
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/JoinBridge.h"
+#include "velox/exec/Operator.h"
+#include "velox/vector/ComplexVector.h"
+
+#include <cudf/join.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace facebook::velox::cudf_velox {
+
+/// Hands the hash table built by CudfHashJoinBuild over to the
+/// CudfHashJoinProbe operators of the join.
+class CudfHashJoinBridge : public exec::JoinBridge {
+ public:
+  /// The build table and the cuDF hash table on its join keys. The hash table
+  /// refers to the build table, which must outlive it.
+  using HashTable =
+      std::pair<std::shared_ptr<cudf::table>, std::shared_ptr<cudf::hash_join>>;
+
+  void setHashTable(HashTable hashTable);
+
+  /// Returns the hash table or sets 'future' to wait for it if the build is
+  /// not finished yet.
+  std::optional<HashTable> hashTableOrFuture(ContinueFuture* future);
+
+ private:
+  std::optional<HashTable> hashTable_;
+};
+
+/// Returns true if the cuDF hash join executes 'joinNode'. These are the inner
+/// and left equi-joins without a filter.
+bool isCudfHashJoinSupported(const core::HashJoinNode& joinNode);
+
+/// Collects the build side of a hash join on the GPU. The last build driver to
+/// finish concatenates the input of all the build drivers and builds the hash
+/// table on the join keys.
+class CudfHashJoinBuild : public exec::Operator, public NvtxHelper {
+ public:
+  CudfHashJoinBuild(
+      int32_t operatorId,
+      exec::DriverCtx* driverCtx,
+      std::shared_ptr<const core::HashJoinNode> joinNode);
+
+  bool needsInput() const override {
+    return !noMoreInput_;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  void noMoreInput() override;
+
+  RowVectorPtr getOutput() override {
+    return nullptr;
+  }
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool isFinished() override {
+    return noMoreInput_ && !future_.valid();
+  }
+
+  void close() override;
+
+ private:
+  const std::shared_ptr<const core::HashJoinNode> joinNode_;
+  std::vector<cudf::size_type> buildKeys_;
+  std::vector<CudfVectorPtr> inputs_;
+  // Set while waiting for the peer build drivers to finish.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+};
+
+/// Joins the probe input with the hash table of CudfHashJoinBuild on the GPU
+/// and produces the output on the GPU.
+class CudfHashJoinProbe : public exec::Operator, public NvtxHelper {
+ public:
+  CudfHashJoinProbe(
+      int32_t operatorId,
+      exec::DriverCtx* driverCtx,
+      std::shared_ptr<const core::HashJoinNode> joinNode);
+
+  bool needsInput() const override {
+    return !finished_ && hashTable_.has_value() && input_ == nullptr;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool isFinished() override {
+    return finished_;
+  }
+
+  void close() override;
+
+ private:
+  const std::shared_ptr<const core::HashJoinNode> joinNode_;
+  std::vector<cudf::size_type> probeKeys_;
+  // The input channels of the probe and build sides that appear in the output
+  // and their positions in the output.
+  std::vector<cudf::size_type> probeOutputChannels_;
+  std::vector<cudf::size_type> probeOutputIndices_;
+  std::vector<cudf::size_type> buildOutputChannels_;
+  std::vector<cudf::size_type> buildOutputIndices_;
+  std::optional<CudfHashJoinBridge::HashTable> hashTable_;
+  CudfVectorPtr input_;
+  bool finished_{false};
+};
+
+/// Makes the CudfHashJoinBridge of the hash joins that the cuDF driver adapter
+/// replaces with CudfHashJoinBuild and CudfHashJoinProbe.
+class CudfHashJoinBridgeTranslator
+    : public exec::Operator::PlanNodeTranslator {
+ public:
+  std::unique_ptr<exec::JoinBridge> toJoinBridge(
+      const core::PlanNodePtr& node) override;
+};
+
+} // namespace facebook::velox::cudf_velox
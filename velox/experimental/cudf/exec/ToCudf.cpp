@@ -16,6 +16,7 @@
 
 #include "velox/experimental/cudf/exec/CudfConversion.h"
 #include "velox/experimental/cudf/exec/CudfHashAggregation.h"
+#include "velox/experimental/cudf/exec/CudfHashJoin.h"
 #include "velox/experimental/cudf/exec/CudfOrderBy.h"
 #include "velox/experimental/cudf/exec/ToCudf.h"
 #include "velox/experimental/cudf/exec/Utilities.h"
@@ -82,8 +83,20 @@ bool CompileState::compile() {
     return driverFactory_.consumerNode;
   };
 
-  auto isSupportedGpuOperator = [](const exec::Operator* op) {
-    return isAnyOf<exec::OrderBy, exec::HashAggregation>(op);
+  // The build and the probe of a join are both replaced or both kept, so that
+  // they share the bridge of their kind.
+  auto isSupportedHashJoin = [&](const exec::Operator* op) {
+    if (!isAnyOf<exec::HashBuild, exec::HashProbe>(op)) {
+      return false;
+    }
+    auto joinNode = std::dynamic_pointer_cast<const core::HashJoinNode>(
+        getPlanNode(op->planNodeId()));
+    return joinNode != nullptr && isCudfHashJoinSupported(*joinNode);
+  };
+
+  auto isSupportedGpuOperator = [&](const exec::Operator* op) {
+    return isAnyOf<exec::OrderBy, exec::HashAggregation>(op) ||
+        isSupportedHashJoin(op);
   };
 
   std::vector<bool> isSupportedGpuOperators(operators.size());
@@ -93,12 +106,26 @@ bool CompileState::compile() {
       isSupportedGpuOperators.begin(),
       isSupportedGpuOperator);
 
-  auto acceptsGpuInput = [](const exec::Operator* op) {
-    return isAnyOf<exec::OrderBy, exec::HashAggregation>(op);
+  auto acceptsGpuInput = [&](const exec::Operator* op) {
+    return isSupportedGpuOperator(op);
+  };
+
+  auto producesGpuOutput = [&](const exec::Operator* op) {
+    return isAnyOf<exec::OrderBy, exec::HashAggregation>(op) ||
+        (isAnyOf<exec::HashProbe>(op) && isSupportedHashJoin(op));
   };
 
-  auto producesGpuOutput = [](const exec::Operator* op) {
-    return isAnyOf<exec::OrderBy, exec::HashAggregation>(op);
+  // The type of the input of 'op' from 'planNode'. A join has an input of the
+  // type of each of its sources.
+  auto inputType = [](const exec::Operator* op,
+                      const core::PlanNodePtr& planNode) {
+    if (isAnyOf<exec::HashBuild>(op)) {
+      return planNode->sources()[1]->outputType();
+    }
+    if (isAnyOf<exec::HashProbe>(op)) {
+      return planNode->sources()[0]->outputType();
+    }
+    return planNode->outputType();
   };
 
   int32_t operatorsOffset = 0;
@@ -122,7 +149,10 @@ bool CompileState::compile() {
     if (previousOperatorIsNotGpu and acceptsGpuInput(oper)) {
       auto planNode = getPlanNode(oper->planNodeId());
       replaceOp.push_back(std::make_unique<CudfFromVelox>(
-          id, planNode->outputType(), ctx, planNode->id() + "-from-velox"));
+          id,
+          inputType(oper, planNode),
+          ctx,
+          planNode->id() + "-from-velox"));
       replaceOp.back()->initialize();
     }
 
@@ -140,6 +170,18 @@ bool CompileState::compile() {
       replaceOp.push_back(
           std::make_unique<CudfHashAggregation>(id, ctx, planNode));
       replaceOp.back()->initialize();
+    } else if (isSupportedHashJoin(oper)) {
+      auto planNode = std::dynamic_pointer_cast<const core::HashJoinNode>(
+          getPlanNode(oper->planNodeId()));
+      VELOX_CHECK(planNode != nullptr);
+      if (isAnyOf<exec::HashBuild>(oper)) {
+        replaceOp.push_back(
+            std::make_unique<CudfHashJoinBuild>(id, ctx, planNode));
+      } else {
+        replaceOp.push_back(
+            std::make_unique<CudfHashJoinProbe>(id, ctx, planNode));
+      }
+      replaceOp.back()->initialize();
     }
 
     if (producesGpuOutput(oper) and
@@ -189,6 +231,7 @@ struct CudfDriverAdapter {
 };
 
 static bool isCudfRegistered = false;
+static bool isCudfHashJoinBridgeTranslatorRegistered = false;
 
 void registerCudf(const CudfOptions& options) {
   if (cudfIsRegistered()) {
@@ -207,6 +250,13 @@ void registerCudf(const CudfOptions& options) {
   CudfDriverAdapter cda{mr};
   exec::DriverAdapter cudfAdapter{kCudfAdapterName, {}, cda};
   exec::DriverFactory::registerAdapter(cudfAdapter);
+  // The translator can not be unregistered and makes no bridges while cuDF is
+  // not registered.
+  if (!isCudfHashJoinBridgeTranslatorRegistered) {
+    exec::Operator::registerOperator(
+        std::make_unique<CudfHashJoinBridgeTranslator>());
+    isCudfHashJoinBridgeTranslatorRegistered = true;
+  }
   isCudfRegistered = true;
 }
 
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/cudf/exec/ToCudf.h"
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+#include <fmt/format.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+class HashJoinTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    cudf_velox::registerCudf();
+
+    // Probe keys 0..999 of which the even ones have up to 3 build rows.
+    probe_ = {makeRowVector(
+        {"t_k", "t_v"},
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+         makeFlatVector<std::string>(
+             1'000, [](auto row) { return fmt::format("probe {}", row); })})};
+    build_ = {makeRowVector(
+        {"u_k", "u_v"},
+        {makeFlatVector<int64_t>(
+             1'500,
+             [](auto row) { return row % 500 * 2; },
+             nullEvery(97)),
+         makeFlatVector<int32_t>(1'500, [](auto row) { return row; })})};
+    createDuckDbTable("t", probe_);
+    createDuckDbTable("u", build_);
+  }
+
+  void TearDown() override {
+    cudf_velox::unregisterCudf();
+    OperatorTestBase::TearDown();
+  }
+
+  core::PlanNodePtr makeJoinPlan(core::JoinType joinType) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values(probe_)
+        .hashJoin(
+            {"t_k"},
+            {"u_k"},
+            PlanBuilder(planNodeIdGenerator).values(build_).planNode(),
+            "",
+            {"t_k", "u_v", "t_v"},
+            joinType)
+        .planNode();
+  }
+
+  // Returns the number of operators of 'operatorType' that ran in 'task'.
+  static int32_t numOperators(
+      const std::shared_ptr<Task>& task,
+      const std::string& operatorType) {
+    int32_t count{0};
+    for (const auto& pipeline : task->taskStats().pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        count += op.operatorType == operatorType;
+      }
+    }
+    return count;
+  }
+
+  std::vector<RowVectorPtr> probe_;
+  std::vector<RowVectorPtr> build_;
+};
+
+TEST_F(HashJoinTest, inner) {
+  auto task = AssertQueryBuilder(
+                  makeJoinPlan(core::JoinType::kInner), duckDbQueryRunner_)
+                  .assertResults(
+                      "SELECT t_k, u_v, t_v FROM t, u WHERE t_k = u_k");
+  ASSERT_EQ(numOperators(task, "CudfHashJoinBuild"), 1);
+  ASSERT_EQ(numOperators(task, "CudfHashJoinProbe"), 1);
+  ASSERT_EQ(numOperators(task, "HashBuild"), 0);
+  ASSERT_EQ(numOperators(task, "HashProbe"), 0);
+}
+
+TEST_F(HashJoinTest, left) {
+  auto task = AssertQueryBuilder(
+                  makeJoinPlan(core::JoinType::kLeft), duckDbQueryRunner_)
+                  .assertResults(
+                      "SELECT t_k, u_v, t_v FROM t LEFT JOIN u ON t_k = u_k");
+  ASSERT_EQ(numOperators(task, "CudfHashJoinProbe"), 1);
+}
+
+TEST_F(HashJoinTest, multipleDrivers) {
+  auto task = AssertQueryBuilder(
+                  makeJoinPlan(core::JoinType::kInner), duckDbQueryRunner_)
+                  .maxDrivers(4)
+                  .assertResults(
+                      "SELECT t_k, u_v, t_v FROM t, u WHERE t_k = u_k");
+  ASSERT_EQ(numOperators(task, "CudfHashJoinBuild"), 1);
+}
+
+TEST_F(HashJoinTest, emptyBuild) {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probe_)
+                  .hashJoin(
+                      {"t_k"},
+                      {"u_k"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(build_)
+                          .filter("u_k < 0")
+                          .planNode(),
+                      "",
+                      {"t_k", "u_v"},
+                      core::JoinType::kLeft)
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT t_k, null::INTEGER FROM t");
+}
+
+TEST_F(HashJoinTest, joinAggregation) {
+  // The join output stays on the GPU for the aggregation.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probe_)
+                  .hashJoin(
+                      {"t_k"},
+                      {"u_k"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(build_)
+                          .planNode(),
+                      "",
+                      {"t_k", "u_v"})
+                  .singleAggregation({"t_k"}, {"sum(u_v)", "count(u_v)"})
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .assertResults(
+              "SELECT t_k, sum(u_v), count(u_v) FROM t, u WHERE t_k = u_k "
+              "GROUP BY t_k");
+  ASSERT_EQ(numOperators(task, "CudfHashJoinProbe"), 1);
+  ASSERT_EQ(numOperators(task, "CudfToVelox"), 1);
+}
+
+TEST_F(HashJoinTest, unsupportedFilter) {
+  // A join with a filter runs on the CPU.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probe_)
+                  .hashJoin(
+                      {"t_k"},
+                      {"u_k"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(build_)
+                          .planNode(),
+                      "u_v % 2 = 0",
+                      {"t_k", "u_v"})
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .assertResults(
+              "SELECT t_k, u_v FROM t, u WHERE t_k = u_k AND u_v % 2 = 0");
+  ASSERT_EQ(numOperators(task, "HashProbe"), 1);
+  ASSERT_EQ(numOperators(task, "CudfHashJoinProbe"), 0);
+}
+
+} // namespace
@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/parquet/ParquetColumnChunk.h"
+#include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/PageReader.h"
+#include "velox/dwio/parquet/reader/RleBpDecoder.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> // @manual
+
+namespace facebook::velox::wave {
+
+using parquet::thrift::Encoding;
+using parquet::thrift::PageHeader;
+using parquet::thrift::PageType;
+
+namespace {
+
+// The device reads up to 3 words past the last bit packed value.
+constexpr int32_t kPadding = 16;
+
+BufferPtr toBuffer(const std::vector<char>& data, memory::MemoryPool& pool) {
+  auto buffer = AlignedBuffer::allocate<char>(data.size() + kPadding, &pool);
+  memcpy(buffer->asMutable<char>(), data.data(), data.size());
+  memset(buffer->asMutable<char>() + data.size(), 0, kPadding);
+  return buffer;
+}
+
+// Returns the number of bits for values up to 'max'.
+int8_t bitWidth(uint64_t max) {
+  return max == 0 ? 1 : 64 - __builtin_clzll(max);
+}
+
+// Packs 'indices' at 'bitWidth' bits each.
+BufferPtr packIndices(
+    const std::vector<int32_t>& indices,
+    int8_t bitWidth,
+    memory::MemoryPool& pool) {
+  auto numWords = bits::nwords(indices.size() * bitWidth);
+  auto buffer = AlignedBuffer::allocate<uint64_t>(
+      numWords + kPadding / sizeof(uint64_t), &pool, 0);
+  auto* words = buffer->asMutable<uint64_t>();
+  for (auto i = 0; i < indices.size(); ++i) {
+    uint64_t value = static_cast<uint32_t>(indices[i]);
+    int64_t bit = i * static_cast<int64_t>(bitWidth);
+    words[bit / 64] |= value << (bit & 63);
+    if ((bit & 63) + bitWidth > 64) {
+      words[bit / 64 + 1] |= value >> (64 - (bit & 63));
+    }
+  }
+  return buffer;
+}
+
+// Decompresses the 'compressedSize' bytes at 'data' to 'decompressed' unless
+// 'codec' is NONE. Returns the start of the uncompressed data.
+const char* decompress(
+    common::CompressionKind codec,
+    const char* data,
+    uint32_t compressedSize,
+    uint32_t uncompressedSize,
+    BufferPtr& decompressed,
+    memory::MemoryPool& pool) {
+  if (codec == common::CompressionKind::CompressionKind_NONE) {
+    VELOX_CHECK_EQ(compressedSize, uncompressedSize);
+    return data;
+  }
+  auto stream = dwio::common::compression::createDecompressor(
+      codec,
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          data, compressedSize, 0),
+      uncompressedSize,
+      pool,
+      parquet::getParquetDecompressionOptions(codec),
+      "Wave Parquet page",
+      nullptr,
+      true,
+      compressedSize);
+  // The decoders may read a word past the end of the page.
+  dwio::common::ensureCapacity<char>(
+      decompressed, uncompressedSize + kPadding, &pool);
+  stream->readFully(decompressed->asMutable<char>(), uncompressedSize);
+  return decompressed->as<char>();
+}
+
+// Accumulates the values of the data pages of a column chunk.
+class ChunkBuilder {
+ public:
+  ChunkBuilder(
+      const parquet::ParquetTypeWithId& type,
+      int32_t numRows,
+      memory::MemoryPool& pool)
+      : valueSize_(
+            type.parquetType_ == parquet::thrift::Type::INT32 ? 4 : 8),
+        nullable_(type.maxDefine_ > 0),
+        numRows_(numRows),
+        pool_(pool) {
+    if (nullable_) {
+      nulls_ = AlignedBuffer::allocate<bool>(numRows, &pool_, true);
+    }
+  }
+
+  void addDictionary(const char* data, int32_t numValues) {
+    dictionary_.assign(data, data + numValues * valueSize_);
+    dictionarySize_ = numValues;
+  }
+
+  // Adds a page of 'numValues' rows of which 'numNonNull' have a value in
+  // 'data'. 'nulls' has a bit per row if the page has nulls.
+  void addPage(
+      Encoding::type encoding,
+      const char* data,
+      const char* end,
+      int32_t numValues,
+      int32_t numNonNull,
+      const uint64_t* nulls) {
+    VELOX_CHECK_LE(row_ + numValues, numRows_, "Too many values in chunk");
+    if (nulls) {
+      VELOX_CHECK_NOT_NULL(nulls_);
+      hasNulls_ = true;
+      bits::copyBits(nulls, 0, nulls_->asMutable<uint64_t>(), row_, numValues);
+    }
+    row_ += numValues;
+    switch (encoding) {
+      case Encoding::PLAIN:
+        VELOX_CHECK_LE(numNonNull * valueSize_, end - data);
+        materializeIndices();
+        values_.insert(values_.end(), data, data + numNonNull * valueSize_);
+        break;
+      case Encoding::PLAIN_DICTIONARY:
+      case Encoding::RLE_DICTIONARY: {
+        VELOX_CHECK_GT(dictionarySize_, 0, "Dictionary page missing");
+        auto offset = indices_.size();
+        indices_.resize(offset + numNonNull);
+        if (numNonNull > 0) {
+          auto indexWidth = static_cast<uint8_t>(*data);
+          auto* output = indices_.data() + offset;
+          parquet::RleBpDecoder(data + 1, end, indexWidth)
+              .next<int32_t>(output, numNonNull);
+        }
+        if (!values_.empty()) {
+          // Dictionary pages after plain ones are looked up on the host.
+          materializeIndices();
+        }
+        break;
+      }
+      case Encoding::DELTA_BINARY_PACKED: {
+        materializeIndices();
+        auto offset = values_.size();
+        values_.resize(offset + numNonNull * valueSize_);
+        parquet::DeltaBpDecoder decoder(data);
+        if (valueSize_ == 4) {
+          decoder.readValues<int32_t>(
+              reinterpret_cast<int32_t*>(values_.data() + offset), numNonNull);
+        } else {
+          decoder.readValues<int64_t>(
+              reinterpret_cast<int64_t*>(values_.data() + offset), numNonNull);
+        }
+        break;
+      }
+      default:
+        VELOX_NYI(
+            "Unsupported Parquet encoding for Wave: {}",
+            static_cast<int32_t>(encoding));
+    }
+  }
+
+  void finish(ParquetColumnChunk& chunk) {
+    VELOX_CHECK_EQ(row_, numRows_, "Column chunk has fewer rows than expected");
+    chunk.numValues = numRows_;
+    chunk.baseline = 0;
+    if (hasNulls_) {
+      chunk.nulls = std::move(nulls_);
+    }
+    if (values_.empty() && dictionarySize_ > 0) {
+      chunk.alphabet = toBuffer(dictionary_, pool_);
+      chunk.alphabetSize = dictionarySize_;
+      chunk.alphabetBitWidth = valueSize_ * 8;
+      chunk.bitWidth = bitWidth(dictionarySize_ - 1);
+      chunk.values = packIndices(indices_, chunk.bitWidth, pool_);
+    } else {
+      materializeIndices();
+      chunk.bitWidth = valueSize_ * 8;
+      chunk.values = toBuffer(values_, pool_);
+    }
+  }
+
+ private:
+  // Appends the dictionary values of 'indices_' to 'values_'.
+  void materializeIndices() {
+    for (auto index : indices_) {
+      VELOX_CHECK_LT(index, dictionarySize_);
+      auto* value = dictionary_.data() + index * valueSize_;
+      values_.insert(values_.end(), value, value + valueSize_);
+    }
+    indices_.clear();
+  }
+
+  const int32_t valueSize_;
+  const bool nullable_;
+  const int32_t numRows_;
+  memory::MemoryPool& pool_;
+
+  std::vector<char> dictionary_;
+  int32_t dictionarySize_{0};
+  std::vector<int32_t> indices_;
+  std::vector<char> values_;
+  BufferPtr nulls_;
+  bool hasNulls_{false};
+  int32_t row_{0};
+};
+
+} // namespace
+
+// static
+std::unique_ptr<ParquetColumnChunk> ParquetColumnChunk::read(
+    ReadFile& file,
+    parquet::ColumnChunkMetaDataPtr metadata,
+    const parquet::ParquetTypeWithId& type,
+    int32_t numRows,
+    memory::MemoryPool& pool) {
+  VELOX_CHECK(type.isLeaf());
+  if (type.maxRepeat_ > 0 || type.maxDefine_ > 1) {
+    VELOX_NYI("Wave reads only top level Parquet columns: {}", type.name_);
+  }
+  if (type.parquetType_ != parquet::thrift::Type::INT32 &&
+      type.parquetType_ != parquet::thrift::Type::INT64) {
+    VELOX_NYI("Unsupported Parquet type for Wave: {}", type.name_);
+  }
+  auto chunk = std::make_unique<ParquetColumnChunk>();
+  chunk->kind = type.type()->kind();
+
+  auto offset = metadata.dataPageOffset();
+  if (metadata.hasDictionaryPageOffset() &&
+      metadata.dictionaryPageOffset() > 0) {
+    offset = std::min(offset, metadata.dictionaryPageOffset());
+  }
+  auto length = metadata.totalCompressedSize();
+  // The decoders may read a word past the end of the last page.
+  std::vector<char> bytes(length + kPadding);
+  file.pread(offset, length, bytes.data());
+
+  const auto codec = metadata.compression();
+  ChunkBuilder builder(type, numRows, pool);
+  BufferPtr decompressed;
+  BufferPtr pageNulls;
+  int32_t rowsRead = 0;
+  const char* position = bytes.data();
+  const char* end = bytes.data() + length;
+  while (rowsRead < numRows && position < end) {
+    auto transport = std::make_shared<parquet::thrift::ThriftBufferedTransport>(
+        position, end - position);
+    apache::thrift::protocol::TCompactProtocolT<
+        parquet::thrift::ThriftTransport>
+        protocol(transport);
+    PageHeader header;
+    position += header.read(&protocol);
+    const char* pageData = position;
+    position += header.compressed_page_size;
+    VELOX_CHECK_LE(position, end, "Parquet page extends past column chunk");
+
+    switch (header.type) {
+      case PageType::DICTIONARY_PAGE: {
+        VELOX_CHECK(
+            header.dictionary_page_header.encoding == Encoding::PLAIN ||
+            header.dictionary_page_header.encoding ==
+                Encoding::PLAIN_DICTIONARY);
+        auto* data = decompress(
+            codec,
+            pageData,
+            header.compressed_page_size,
+            header.uncompressed_page_size,
+            decompressed,
+            pool);
+        builder.addDictionary(data, header.dictionary_page_header.num_values);
+        break;
+      }
+      case PageType::DATA_PAGE: {
+        auto* data = decompress(
+            codec,
+            pageData,
+            header.compressed_page_size,
+            header.uncompressed_page_size,
+            decompressed,
+            pool);
+        auto* pageEnd = data + header.uncompressed_page_size;
+        const auto numValues = header.data_page_header.num_values;
+        int32_t numNonNull = numValues;
+        const uint64_t* nulls = nullptr;
+        if (type.maxDefine_ > 0) {
+          uint32_t defineLength;
+          memcpy(&defineLength, data, sizeof(defineLength));
+          data += sizeof(defineLength);
+          dwio::common::ensureCapacity<uint64_t>(
+              pageNulls, bits::nwords(numValues), &pool);
+          parquet::RleBpDecoder(data, data + defineLength, 1)
+              .readBits(numValues, pageNulls->asMutable<uint64_t>());
+          nulls = pageNulls->as<uint64_t>();
+          numNonNull = bits::countBits(nulls, 0, numValues);
+          data += defineLength;
+        }
+        builder.addPage(
+            header.data_page_header.encoding,
+            data,
+            pageEnd,
+            numValues,
+            numNonNull,
+            numNonNull == numValues ? nullptr : nulls);
+        rowsRead += numValues;
+        break;
+      }
+      case PageType::DATA_PAGE_V2: {
+        const auto& v2 = header.data_page_header_v2;
+        VELOX_CHECK_EQ(v2.repetition_levels_byte_length, 0);
+        const auto numValues = v2.num_values;
+        const auto numNonNull = numValues - v2.num_nulls;
+        const uint64_t* nulls = nullptr;
+        if (v2.num_nulls > 0) {
+          dwio::common::ensureCapacity<uint64_t>(
+              pageNulls, bits::nwords(numValues), &pool);
+          parquet::RleBpDecoder(
+              pageData, pageData + v2.definition_levels_byte_length, 1)
+              .readBits(numValues, pageNulls->asMutable<uint64_t>());
+          nulls = pageNulls->as<uint64_t>();
+        }
+        // Levels are not compressed in V2 pages.
+        auto levelsLength = v2.definition_levels_byte_length;
+        auto valuesLength = header.uncompressed_page_size - levelsLength;
+        auto* data =
+            (v2.__isset.is_compressed && !v2.is_compressed)
+            ? pageData + levelsLength
+            : decompress(
+                  codec,
+                  pageData + levelsLength,
+                  header.compressed_page_size - levelsLength,
+                  valuesLength,
+                  decompressed,
+                  pool);
+        builder.addPage(
+            v2.encoding,
+            data,
+            data + valuesLength,
+            numValues,
+            numNonNull,
+            nulls);
+        rowsRead += numValues;
+        break;
+      }
+      default:
+        // Index pages and extensions are skipped.
+        break;
+    }
+  }
+  builder.finish(*chunk);
+  return chunk;
+}
+
+const ParquetColumnChunk* ParquetRowGroup::findColumn(
+    const dwio::common::TypeWithId& type) const {
+  auto it = columns.find(type.column());
+  VELOX_CHECK(it != columns.end(), "Column chunk not read: {}", type.column());
+  return it->second.get();
+}
+
+} // namespace facebook::velox::wave
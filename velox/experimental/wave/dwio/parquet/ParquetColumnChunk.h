@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/file/File.h"
+#include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
+#include "velox/experimental/wave/vector/WaveVector.h"
+
+namespace facebook::velox::wave {
+
+/// A leaf column chunk of a Parquet row group laid out for the Wave
+/// decoder. The pages of the chunk are parsed and decompressed on the host
+/// and their values are concatenated into one bit packed stream that is
+/// staged to the device as is. The GPU decodes the stream with
+/// kDictionaryOnBitpack, looking up 'alphabet' for dictionary encoded chunks,
+/// and applies the column's filter in the same kernel.
+///
+/// PLAIN pages are fixed width little endian values, i.e. bit packed at
+/// 32 or 64 bits, and are copied without change. RLE_DICTIONARY and
+/// PLAIN_DICTIONARY pages have their RLE/bit packed hybrid indices rewritten
+/// at the uniform width of the dictionary size and the dictionary page
+/// becomes 'alphabet'. DELTA_BINARY_PACKED pages are expanded to plain values
+/// on the host.
+struct ParquetColumnChunk {
+  /// Reads the chunk of the leaf column 'type' described by 'metadata' from
+  /// 'file'. Supports non-repeated INT32 and INT64 columns.
+  static std::unique_ptr<ParquetColumnChunk> read(
+      ReadFile& file,
+      parquet::ColumnChunkMetaDataPtr metadata,
+      const parquet::ParquetTypeWithId& type,
+      int32_t numRows,
+      memory::MemoryPool& pool);
+
+  TypeKind kind;
+
+  /// Number of rows including nulls.
+  int32_t numValues{0};
+
+  /// Width of the bit packed 'values'.
+  int8_t bitWidth{0};
+
+  /// Frame of reference base of 'values'. Always 0 for Parquet.
+  int64_t baseline{0};
+
+  /// One entry per non-null row, bit packed at 'bitWidth'. Indices into
+  /// 'alphabet' if this is set.
+  BufferPtr values;
+
+  /// 'numValues' bits, 1 for non-null. nullptr if there are no nulls.
+  BufferPtr nulls;
+
+  /// Values of the dictionary page, bit packed at 'alphabetBitWidth'.
+  /// nullptr if the chunk is not dictionary encoded.
+  BufferPtr alphabet;
+  int32_t alphabetSize{0};
+  int8_t alphabetBitWidth{0};
+};
+
+/// The transcoded leaf column chunks of a Parquet row group. Corresponds to a
+/// stripe of the Wave test format.
+struct ParquetRowGroup {
+  explicit ParquetRowGroup(int32_t numRows) : numRows(numRows) {}
+
+  /// Returns the chunk for the leaf column 'type'.
+  const ParquetColumnChunk* findColumn(
+      const dwio::common::TypeWithId& type) const;
+
+  const int32_t numRows;
+
+  /// Chunks indexed by the leaf column number of the file.
+  std::unordered_map<uint32_t, std::unique_ptr<ParquetColumnChunk>> columns;
+
+  /// Number of bytes read from the file.
+  uint64_t rawBytes{0};
+};
+
+} // namespace facebook::velox::wave
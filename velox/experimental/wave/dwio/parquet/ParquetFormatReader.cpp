@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/parquet/ParquetFormatReader.h"
+#include "velox/experimental/wave/dwio/StructColumnReader.h"
+#include "velox/experimental/wave/exec/Wave.h"
+
+DECLARE_int32(wave_reader_rows_per_tb);
+
+namespace facebook::velox::wave {
+
+using common::Subfield;
+
+std::unique_ptr<FormatData> ParquetFormatParams::toFormatData(
+    const std::shared_ptr<const dwio::common::TypeWithId>& type,
+    const velox::common::ScanSpec& scanSpec,
+    OperandId operand) {
+  auto* chunk = type->id() == 0 ? nullptr : rowGroup_->findColumn(*type);
+  return std::make_unique<ParquetFormatData>(
+      operand, rowGroup_->numRows, chunk);
+}
+
+int32_t ParquetFormatData::stageNulls(
+    ResultStaging& deviceStaging,
+    SplitStaging& splitStaging) {
+  if (!chunk_->nulls) {
+    nullsStaged_ = true;
+    return kNotRegistered;
+  }
+
+  if (nullsStaged_) {
+    splitStaging.addDependency(nullsStagingId_);
+    return kNotRegistered;
+  }
+  nullsStaged_ = true;
+  Staging staging(
+      chunk_->nulls->as<char>(),
+      bits::nwords(chunk_->numValues) * sizeof(uint64_t),
+      common::Region{});
+  nullsBufferId_ = splitStaging.add(staging);
+  nullsStagingId_ = splitStaging.id();
+  splitStaging.registerPointer(nullsBufferId_, &grid_.nulls, true);
+  return nullsBufferId_;
+}
+
+void ParquetFormatData::decodeAlphabet(
+    ColumnOp& op,
+    ResultStaging& deviceStaging,
+    SplitStaging& splitStaging,
+    DecodePrograms& program,
+    ReadStream& stream) {
+  const int32_t numRows = chunk_->alphabetSize;
+  auto rowsPerBlock = FLAGS_wave_reader_rows_per_tb;
+  int32_t numBlocks = bits::roundUp(numRows, rowsPerBlock) / rowsPerBlock;
+  VELOX_CHECK_LT(numBlocks, 256 * 256, "Overflow 16 bit block number");
+  auto filter = op.reader->scanSpec().filter();
+  BufferId filterId = kNoBufferId;
+  if (filter) {
+    // bitmap made of uint32_t, one bit per dictionary entry.
+    filterId = deviceStaging.reserve(bits::roundUp(numRows, 32) / 8);
+    deviceStaging.registerPointer(filterId, &filterBitmap_, true);
+  }
+  Staging staging(
+      chunk_->alphabet->as<char>(),
+      chunk_->alphabet->size(),
+      common::Region{});
+  BufferId rawId = splitStaging.add(staging);
+  BufferId decodedId = kNoBufferId;
+  auto kind = static_cast<WaveTypeKind>(chunk_->kind);
+  auto valueSize = waveTypeKindSize(kind);
+
+  for (auto blockIdx = 0; blockIdx < numBlocks; ++blockIdx) {
+    auto step = makeAlphabetStep(
+        op, deviceStaging, splitStaging, stream, kind, blockIdx, numRows);
+    step->resultNulls = nullptr;
+    step->result = reinterpret_cast<void*>(valueSize * blockIdx * rowsPerBlock);
+    if (blockIdx == 0) {
+      decodedId = deviceStaging.reserve(valueSize * numRows);
+      deviceStaging.registerPointer(decodedId, &decodedAlphabet_, true);
+    }
+    deviceStaging.registerPointer(decodedId, &step->result, false);
+    step->dictMode = filter ? DictMode::kRecordFilter : DictMode::kNone;
+    if (filter) {
+      // Init to byte where the bitmap for this block begins.
+      step->filterBitmap =
+          reinterpret_cast<uint32_t*>(blockIdx * rowsPerBlock / 8);
+      deviceStaging.registerPointer(filterId, &step->filterBitmap, false);
+    }
+    // The dictionary page is plain values, i.e. bit packed at the type width.
+    step->encoding = DecodeStep::kDictionaryOnBitpack;
+    step->data.dictionaryOnBitpack.alphabet = nullptr;
+    step->data.dictionaryOnBitpack.baseline = 0;
+    step->data.dictionaryOnBitpack.bitWidth = chunk_->alphabetBitWidth;
+    step->data.dictionaryOnBitpack.indices = nullptr;
+    step->data.dictionaryOnBitpack.begin = 0;
+    splitStaging.registerPointer(
+        rawId, &step->data.dictionaryOnBitpack.indices, true);
+
+    program.programs.emplace_back();
+    program.programs.back().push_back(std::move(step));
+  }
+}
+
+void ParquetFormatData::griddize(
+    ColumnOp& op,
+    int32_t blockSize,
+    int32_t numBlocks,
+    ResultStaging& deviceStaging,
+    ResultStaging& resultStaging,
+    SplitStaging& staging,
+    DecodePrograms& programs,
+    ReadStream& stream) {
+  constexpr int32_t kCountStride = 1024;
+  if (griddized_) {
+    return;
+  }
+  griddized_ = true;
+  if (isDictionary()) {
+    decodeAlphabet(op, deviceStaging, staging, programs, stream);
+  }
+  if (!chunk_->nulls) {
+    return;
+  }
+  // If the whole row group is covered by a single TB, there is no need for a
+  // separate griddize kernel.
+  if (blockSize >= chunk_->numValues) {
+    return;
+  }
+  auto id = stageNulls(deviceStaging, staging);
+
+  auto count = std::make_unique<GpuDecode>();
+  staging.registerPointer(id, &count->data.countBits.bits, true);
+  auto numStrides =
+      bits::roundUp(chunk_->numValues, kCountStride) / kCountStride;
+  auto resultId = deviceStaging.reserve(sizeof(int32_t) * numStrides);
+  deviceStaging.registerPointer(resultId, &count->result, true);
+  deviceStaging.registerPointer(resultId, &grid_.numNonNull, true);
+  count->step = DecodeStep::kCountBits;
+  count->data.countBits.numBits = chunk_->numValues;
+  count->data.countBits.resultStride = kCountStride;
+  programs.programs.emplace_back();
+  programs.programs.back().push_back(std::move(count));
+}
+
+void ParquetFormatData::startOp(
+    ColumnOp& op,
+    const ColumnOp* previousFilter,
+    ResultStaging& deviceStaging,
+    ResultStaging& resultStaging,
+    SplitStaging& splitStaging,
+    DecodePrograms& program,
+    ReadStream& stream) {
+  VELOX_CHECK_NOT_NULL(chunk_);
+  BufferId id = kNoBufferId;
+  // If nulls were not staged on device in griddize() they will be moved now for
+  // the single TB.
+  stageNulls(deviceStaging, splitStaging);
+  if (!staged_) {
+    staged_ = true;
+    Staging staging(
+        chunk_->values->as<char>(), chunk_->values->size(), common::Region{});
+    id = splitStaging.add(staging);
+    lastStagingId_ = splitStaging.id();
+  } else {
+    splitStaging.addDependency(lastStagingId_);
+  }
+  auto rowsPerBlock = FLAGS_wave_reader_rows_per_tb;
+  int32_t numBlocks =
+      bits::roundUp(op.rows.size(), rowsPerBlock) / rowsPerBlock;
+  if (numBlocks > 1) {
+    VELOX_CHECK(griddized_);
+  }
+  VELOX_CHECK_LT(numBlocks, 256 * 256, "Overflow 16 bit block number");
+  const bool hasDictFilter = isDictionary() && op.reader->scanSpec().filter();
+  for (auto blockIdx = 0; blockIdx < numBlocks; ++blockIdx) {
+    auto step = makeStep(
+        op,
+        previousFilter,
+        deviceStaging,
+        splitStaging,
+        stream,
+        static_cast<WaveTypeKind>(chunk_->kind),
+        blockIdx);
+    step->encoding = DecodeStep::kDictionaryOnBitpack;
+    step->dictMode = isDictionary() ? DictMode::kDict : DictMode::kNone;
+    step->data.dictionaryOnBitpack.alphabet = decodedAlphabet_;
+    step->data.dictionaryOnBitpack.baseline = chunk_->baseline;
+    step->data.dictionaryOnBitpack.bitWidth = chunk_->bitWidth;
+    step->data.dictionaryOnBitpack.indices = nullptr;
+    step->data.dictionaryOnBitpack.begin = currentRow_;
+    if (id != kNoBufferId) {
+      splitStaging.registerPointer(
+          id, &step->data.dictionaryOnBitpack.indices, true);
+      if (blockIdx == 0) {
+        splitStaging.registerPointer(id, &deviceBuffer_, true);
+      }
+    } else {
+      step->data.dictionaryOnBitpack.indices =
+          reinterpret_cast<uint64_t*>(deviceBuffer_);
+    }
+    if (hasDictFilter) {
+      // The filter was evaluated on the dictionary in griddize().
+      step->dictMode = DictMode::kDictFilter;
+      step->filterBitmap = filterBitmap_;
+    }
+    op.isFinal = true;
+    std::vector<std::unique_ptr<GpuDecode>>* steps;
+
+    // Programs are parallel after filters
+    if (stream.filtersDone() || !previousFilter) {
+      program.programs.emplace_back();
+      steps = &program.programs.back();
+    } else {
+      steps = &program.programs[blockIdx];
+    }
+    steps->push_back(std::move(step));
+  }
+}
+
+namespace {
+
+class ParquetStructColumnReader : public StructColumnReader {
+ public:
+  ParquetStructColumnReader(
+      const TypePtr& requestedType,
+      const std::shared_ptr<const dwio::common::TypeWithId>& fileType,
+      ParquetFormatParams& params,
+      common::ScanSpec& scanSpec,
+      std::vector<std::unique_ptr<Subfield::PathElement>>& path,
+      const DefinesMap& defines,
+      bool isRoot)
+      : StructColumnReader(
+            requestedType,
+            fileType,
+            pathToOperand(defines, path),
+            params,
+            scanSpec,
+            isRoot) {
+    auto& childSpecs = scanSpec.stableChildren();
+    for (auto i = 0; i < childSpecs.size(); ++i) {
+      auto childSpec = childSpecs[i];
+      if (isChildConstant(*childSpec)) {
+        VELOX_NYI("Constant columns in Wave Parquet scan");
+      }
+      auto childFileType = fileType_->childByName(childSpec->fieldName());
+      auto childRequestedType = requestedType_->as<TypeKind::ROW>().findChild(
+          folly::StringPiece(childSpec->fieldName()));
+
+      path.push_back(std::make_unique<common::Subfield::NestedField>(
+          childSpec->fieldName()));
+      addChild(ParquetFormatReader::build(
+          childRequestedType,
+          childFileType,
+          params,
+          *childSpec,
+          path,
+          defines));
+      path.pop_back();
+      childSpec->setSubscript(children_.size() - 1);
+    }
+  }
+};
+
+} // namespace
+
+// static
+std::unique_ptr<ColumnReader> ParquetFormatReader::build(
+    const TypePtr& requestedType,
+    const std::shared_ptr<const dwio::common::TypeWithId>& fileType,
+    ParquetFormatParams& params,
+    common::ScanSpec& scanSpec,
+    std::vector<std::unique_ptr<Subfield::PathElement>>& path,
+    const DefinesMap& defines,
+    bool isRoot) {
+  switch (fileType->type()->kind()) {
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return std::make_unique<ColumnReader>(
+          requestedType,
+          fileType,
+          pathToOperand(defines, path),
+          params,
+          scanSpec);
+
+    case TypeKind::ROW:
+      return std::make_unique<ParquetStructColumnReader>(
+          requestedType, fileType, params, scanSpec, path, defines, isRoot);
+    default:
+      VELOX_NYI(
+          "Unsupported type in Wave Parquet scan: {}",
+          fileType->type()->toString());
+  }
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/dwio/ColumnReader.h"
+#include "velox/experimental/wave/dwio/parquet/ParquetColumnChunk.h"
+#include "velox/type/Subfield.h"
+
+namespace facebook::velox::wave {
+
+/// Decodes a ParquetColumnChunk on the device. Plain values and dictionary
+/// indices are both read with kDictionaryOnBitpack. The dictionary is decoded
+/// in griddize() and a filter on a dictionary encoded column is evaluated
+/// once per dictionary entry.
+class ParquetFormatData : public FormatData {
+ public:
+  static constexpr int32_t kNotRegistered = -1;
+
+  ParquetFormatData(
+      OperandId operand,
+      int32_t totalRows,
+      const ParquetColumnChunk* chunk)
+      : operand_(operand), totalRows_(totalRows), chunk_(chunk) {}
+
+  bool hasNulls() const override {
+    return chunk_->nulls != nullptr;
+  }
+
+  int32_t totalRows() const override {
+    return totalRows_;
+  }
+
+  void newBatch(int32_t startRow) override {
+    currentRow_ = startRow;
+  }
+
+  void griddize(
+      ColumnOp& op,
+      int32_t blockSize,
+      int32_t numBlocks,
+      ResultStaging& deviceStaging,
+      ResultStaging& resultStaging,
+      SplitStaging& staging,
+      DecodePrograms& programs,
+      ReadStream& stream) override;
+
+  void startOp(
+      ColumnOp& op,
+      const ColumnOp* previousFilter,
+      ResultStaging& deviceStaging,
+      ResultStaging& resultStaging,
+      SplitStaging& staging,
+      DecodePrograms& program,
+      ReadStream& stream) override;
+
+ private:
+  bool isDictionary() const {
+    return chunk_->alphabet != nullptr;
+  }
+
+  // Stages movement of nulls to device if any. Returns the id of the buffer or
+  // kNotRegistered.
+  int32_t stageNulls(ResultStaging& deviceStaging, SplitStaging& splitStaging);
+
+  // Decodes the dictionary of 'chunk_' and evaluates the filter of 'op' on it.
+  void decodeAlphabet(
+      ColumnOp& op,
+      ResultStaging& deviceStaging,
+      SplitStaging& staging,
+      DecodePrograms& programs,
+      ReadStream& stream);
+
+  const OperandId operand_;
+
+  const int32_t totalRows_;
+
+  const ParquetColumnChunk* const chunk_;
+  bool staged_{false};
+  bool nullsStaged_{false};
+
+  // The device side values, set after the staged transfer is done.
+  void* deviceBuffer_{nullptr};
+
+  // Device side decoded dictionary.
+  void* decodedAlphabet_{nullptr};
+
+  // Device side filter result of each dictionary entry, nullptr if no filter.
+  uint32_t* filterBitmap_{nullptr};
+};
+
+class ParquetFormatParams : public FormatParams {
+ public:
+  ParquetFormatParams(
+      memory::MemoryPool& pool,
+      dwio::common::ColumnReaderStatistics& stats,
+      const ParquetRowGroup* rowGroup)
+      : FormatParams(pool, stats), rowGroup_(rowGroup) {}
+
+  std::unique_ptr<FormatData> toFormatData(
+      const std::shared_ptr<const dwio::common::TypeWithId>& type,
+      const velox::common::ScanSpec& scanSpec,
+      OperandId operand) override;
+
+  const ParquetRowGroup* rowGroup() const {
+    return rowGroup_;
+  }
+
+ private:
+  const ParquetRowGroup* rowGroup_;
+};
+
+class ParquetFormatReader {
+ public:
+  /// Makes the reader tree for reading 'requestedType' from a row group of
+  /// 'fileType', which is a ParquetTypeWithId.
+  static std::unique_ptr<ColumnReader> build(
+      const TypePtr& requestedType,
+      const std::shared_ptr<const dwio::common::TypeWithId>& fileType,
+      ParquetFormatParams& params,
+      common::ScanSpec& scanSpec,
+      std::vector<std::unique_ptr<common::Subfield::PathElement>>& path,
+      const DefinesMap& defines,
+      bool isRoot = false);
+};
+
+} // namespace facebook::velox::wave
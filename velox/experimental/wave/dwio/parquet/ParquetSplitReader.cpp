@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/parquet/ParquetSplitReader.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/experimental/wave/dwio/StructColumnReader.h"
+#include "velox/experimental/wave/dwio/parquet/ParquetFormatReader.h"
+
+DECLARE_int32(wave_max_reader_batch_rows);
+
+namespace facebook::velox::wave {
+
+using common::Subfield;
+
+namespace {
+int64_t rowGroupOffset(const parquet::RowGroupMetaDataPtr& rowGroup) {
+  if (rowGroup.hasFileOffset()) {
+    return rowGroup.fileOffset();
+  }
+  auto column = rowGroup.columnChunk(0);
+  return column.hasDictionaryPageOffset() ? column.dictionaryPageOffset()
+                                          : column.dataPageOffset();
+}
+} // namespace
+
+ParquetSplitReader::ParquetSplitReader(
+    const std::shared_ptr<connector::ConnectorSplit>& split,
+    const SplitReaderParams& params,
+    const DefinesMap* defines)
+    : params_(params), defines_(defines) {
+  auto hiveSplit =
+      dynamic_cast<connector::hive::HiveConnectorSplit*>(split.get());
+  VELOX_CHECK_NOT_NULL(hiveSplit);
+  try {
+    fileHandle_ = params_.fileHandleFactory->generate(
+        hiveSplit->filePath,
+        hiveSplit->properties.has_value() ? &*hiveSplit->properties : nullptr);
+    VELOX_CHECK_NOT_NULL(fileHandle_.get());
+  } catch (const VeloxRuntimeError& e) {
+    if (e.errorCode() == error_code::kFileNotFound &&
+        params_.hiveConfig->ignoreMissingFiles(
+            params_.connectorQueryCtx->sessionProperties())) {
+      emptySplit_ = true;
+      return;
+    }
+    throw;
+  }
+  auto& pool = *params_.connectorQueryCtx->memoryPool();
+  dwio::common::ReaderOptions readerOptions(&pool);
+  reader_ = std::make_unique<parquet::ParquetReader>(
+      std::make_unique<dwio::common::BufferedInput>(fileHandle_->file, pool),
+      readerOptions);
+
+  auto metadata = reader_->fileMetaData();
+  const auto end = hiveSplit->start + hiveSplit->length;
+  for (auto i = 0; i < metadata.numRowGroups(); ++i) {
+    auto rowGroup = metadata.rowGroup(i);
+    auto offset = rowGroupOffset(rowGroup);
+    if (offset >= hiveSplit->start && offset < end && rowGroup.numRows() > 0) {
+      rowGroupIds_.push_back(i);
+    }
+  }
+  fileInfo_.file = fileHandle_->file.get();
+  fileInfo_.fileId = &fileHandle_->uuid;
+  fileInfo_.cache = params_.connectorQueryCtx->cache();
+}
+
+void ParquetSplitReader::nextRowGroup() {
+  VELOX_CHECK_LT(numRowGroupsRead_, rowGroupIds_.size());
+  auto metadata =
+      reader_->fileMetaData().rowGroup(rowGroupIds_[numRowGroupsRead_++]);
+  auto& pool = *params_.connectorQueryCtx->memoryPool();
+  auto rowGroup = std::make_unique<ParquetRowGroup>(metadata.numRows());
+  const auto& fileType = reader_->typeWithId();
+  for (auto& childSpec : params_.scanSpec->stableChildren()) {
+    if (childSpec->isConstant()) {
+      continue;
+    }
+    auto child = fileType->childByName(childSpec->fieldName());
+    auto& leaf = *reinterpret_cast<const parquet::ParquetTypeWithId*>(
+        child.get());
+    auto columnChunk = metadata.columnChunk(leaf.column());
+    rowGroup->columns[leaf.column()] = ParquetColumnChunk::read(
+        *fileHandle_->file, columnChunk, leaf, rowGroup->numRows, pool);
+    rowGroup->rawBytes += columnChunk.totalCompressedSize();
+  }
+  completedBytes_ += rowGroup->rawBytes;
+  params_.ioStats->incRawBytesRead(rowGroup->rawBytes);
+
+  ParquetFormatParams formatParams(pool, readerStats_, rowGroup.get());
+  std::vector<std::unique_ptr<Subfield::PathElement>> empty;
+  columnReaders_.push_back(ParquetFormatReader::build(
+      params_.readerOutputType,
+      fileType,
+      formatParams,
+      *params_.scanSpec,
+      empty,
+      *defines_,
+      true));
+  rowGroups_.push_back(std::move(rowGroup));
+  nextRow_ = 0;
+}
+
+int32_t ParquetSplitReader::canAdvance(WaveStream& stream) {
+  if (emptySplit()) {
+    return 0;
+  }
+  if (available() == 0 && numRowGroupsRead_ < rowGroupIds_.size()) {
+    nextRowGroup();
+  }
+  return std::min<int32_t>(FLAGS_wave_max_reader_batch_rows, available());
+}
+
+void ParquetSplitReader::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK(!rowGroups_.empty());
+  auto numRows = std::min<int32_t>(maxRows, available());
+  auto* columnReader = columnReaders_.back().get();
+  auto rowSet = folly::Range<const int32_t*>(iota(numRows, rows_), numRows);
+  std::unique_ptr<ReadStream> exe(reinterpret_cast<ReadStream*>(
+      waveStream.recycleExecutable(nullptr, 0).release()));
+  if (exe && reinterpret_cast<ColumnReader*>(exe->reader()) != columnReader) {
+    // The previous read exe on the WaveStream is for a different row group.
+    exe.reset();
+  }
+  if (!exe) {
+    exe = std::make_unique<ReadStream>(
+        reinterpret_cast<StructColumnReader*>(columnReader),
+        waveStream,
+        params_.ioStats.get(),
+        fileInfo_);
+  }
+  ReadStream::launch(std::move(exe), nextRow_, rowSet);
+  nextRow_ += numRows;
+  completedRows_ += numRows;
+}
+
+bool ParquetSplitReader::isFinished() const {
+  return emptySplit_ ||
+      (numRowGroupsRead_ == rowGroupIds_.size() && available() == 0);
+}
+
+namespace {
+class ParquetSplitReaderFactory : public WaveSplitReaderFactory {
+ public:
+  std::shared_ptr<WaveSplitReader> create(
+      const std::shared_ptr<connector::ConnectorSplit>& split,
+      const SplitReaderParams& params,
+      const DefinesMap* defines) override {
+    auto hiveSplit =
+        dynamic_cast<connector::hive::HiveConnectorSplit*>(split.get());
+    if (!hiveSplit ||
+        hiveSplit->fileFormat != dwio::common::FileFormat::PARQUET) {
+      return nullptr;
+    }
+    return std::make_shared<ParquetSplitReader>(split, params, defines);
+  }
+};
+} // namespace
+
+// static
+void ParquetSplitReader::registerParquetSplitReader() {
+  static bool registered = false;
+  if (registered) {
+    return;
+  }
+  registered = true;
+  WaveSplitReader::registerFactory(
+      std::make_unique<ParquetSplitReaderFactory>());
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/experimental/wave/dwio/ColumnReader.h"
+#include "velox/experimental/wave/dwio/parquet/ParquetColumnChunk.h"
+#include "velox/experimental/wave/exec/WaveSplitReader.h"
+
+namespace facebook::velox::wave {
+
+/// A WaveSplitReader that decodes the row groups of a Parquet split on the
+/// device. Each row group is read and transcoded on the host when the
+/// previous one has been scheduled and is then read in batches like a
+/// stripe.
+class ParquetSplitReader : public WaveSplitReader {
+ public:
+  ParquetSplitReader(
+      const std::shared_ptr<connector::ConnectorSplit>& split,
+      const SplitReaderParams& params,
+      const DefinesMap* defines);
+
+  bool emptySplit() override {
+    return emptySplit_ || rowGroupIds_.empty();
+  }
+
+  int32_t canAdvance(WaveStream& stream) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows = 0) override;
+
+  bool isFinished() const override;
+
+  uint64_t getCompletedBytes() override {
+    return completedBytes_;
+  }
+
+  uint64_t getCompletedRows() override {
+    return completedRows_;
+  }
+
+  std::unordered_map<std::string, RuntimeCounter> runtimeStats() override {
+    return {};
+  }
+
+  static void registerParquetSplitReader();
+
+ private:
+  // Rows of the current row group not yet scheduled.
+  int32_t available() const {
+    return rowGroups_.empty() ? 0 : rowGroups_.back()->numRows - nextRow_;
+  }
+
+  // Reads the next row group of the split and makes its reader tree.
+  void nextRowGroup();
+
+  SplitReaderParams params_;
+  const DefinesMap* const defines_;
+  FileHandleCachedPtr fileHandle_;
+  std::unique_ptr<parquet::ParquetReader> reader_;
+  // Row groups of the file that start inside the split.
+  std::vector<int32_t> rowGroupIds_;
+  int32_t numRowGroupsRead_{0};
+  dwio::common::ColumnReaderStatistics readerStats_;
+  FileInfo fileInfo_;
+
+  // The row groups read so far and their readers. ReadStreams of batches of
+  // a previous row group may still be running when the next one is
+  // scheduled, so these live as long as 'this'.
+  std::vector<std::unique_ptr<ParquetRowGroup>> rowGroups_;
+  std::vector<std::unique_ptr<ColumnReader>> columnReaders_;
+
+  // First unscheduled row of the current row group.
+  int32_t nextRow_{0};
+  raw_vector<int32_t> rows_;
+  uint64_t completedRows_{0};
+  uint64_t completedBytes_{0};
+  bool emptySplit_{false};
+};
+
+} // namespace facebook::velox::wave
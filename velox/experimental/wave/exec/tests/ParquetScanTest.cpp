@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+#include "velox/experimental/wave/dwio/parquet/ParquetSplitReader.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+#include "velox/experimental/wave/exec/WaveHiveDataSource.h"
+
+DECLARE_int32(wave_max_reader_batch_rows);
+DECLARE_int32(wave_reader_rows_per_tb);
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+enum class PageEncoding { kPlain, kDictionary, kDelta };
+
+std::string toString(PageEncoding encoding) {
+  switch (encoding) {
+    case PageEncoding::kPlain:
+      return "plain";
+    case PageEncoding::kDictionary:
+      return "dictionary";
+    case PageEncoding::kDelta:
+      return "delta";
+  }
+  VELOX_UNREACHABLE();
+}
+
+class ParquetScanTest : public HiveConnectorTestBase,
+                        public testing::WithParamInterface<PageEncoding> {
+ protected:
+  void SetUp() override {
+    HiveConnectorTestBase::SetUp();
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+    wave::registerWave();
+    wave::WaveHiveDataSource::registerConnector();
+    wave::ParquetSplitReader::registerParquetSplitReader();
+    FLAGS_wave_max_reader_batch_rows = 20'000;
+    FLAGS_wave_reader_rows_per_tb = 1024;
+  }
+
+  // Writes 'vectors' to a Parquet file in the encoding of the test parameter.
+  // Each vector is a row group.
+  std::shared_ptr<TempFilePath> writeParquet(
+      const std::vector<RowVectorPtr>& vectors) {
+    auto file = TempFilePath::create();
+    parquet::WriterOptions options;
+    auto writerPool = rootPool_->addAggregateChild("ParquetScanTest.Writer");
+    options.memoryPool = writerPool.get();
+    options.enableDictionary = GetParam() == PageEncoding::kDictionary;
+    if (GetParam() == PageEncoding::kDelta) {
+      options.encoding = parquet::arrow::Encoding::DELTA_BINARY_PACKED;
+    }
+    // A small page size makes several pages per column chunk.
+    options.dataPageSize = 16 << 10;
+    auto sink = std::make_unique<dwio::common::WriteFileSink>(
+        std::make_unique<LocalWriteFile>(file->getPath(), true, false),
+        file->getPath());
+    auto writer = std::make_unique<parquet::Writer>(
+        std::move(sink), options, asRowType(vectors[0]->type()));
+    for (const auto& vector : vectors) {
+      writer->write(vector);
+      writer->flush();
+    }
+    writer->close();
+    return file;
+  }
+
+  // Makes 3 row groups of 'c0', 'c1', 'c2' with a low cardinality 'c0' and a
+  // nullable 'c2'.
+  std::vector<RowVectorPtr> makeVectors() {
+    std::vector<RowVectorPtr> vectors;
+    int64_t counter = 0;
+    for (auto i = 0; i < 3; ++i) {
+      vectors.push_back(makeRowVector(
+          {"c0", "c1", "c2"},
+          {makeFlatVector<int64_t>(
+               30'000, [&](auto row) { return (counter + row) % 1'000 * 7; }),
+           makeFlatVector<int32_t>(
+               30'000,
+               [&](auto row) { return (counter + row) % 20'011 - 500; }),
+           makeFlatVector<int64_t>(
+               30'000,
+               [&](auto row) { return counter + row; },
+               nullEvery(11))}));
+      counter += 30'000;
+    }
+    return vectors;
+  }
+
+  std::shared_ptr<Task> assertQuery(
+      const core::PlanNodePtr& plan,
+      const std::shared_ptr<TempFilePath>& file,
+      const std::string& duckDbSql) {
+    return AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .splits(makeHiveConnectorSplits(
+            file->getPath(), 1, dwio::common::FileFormat::PARQUET))
+        .assertResults(duckDbSql);
+  }
+};
+
+TEST_P(ParquetScanTest, scan) {
+  auto vectors = makeVectors();
+  auto file = writeParquet(vectors);
+  createDuckDbTable(vectors);
+  auto type = asRowType(vectors[0]->type());
+  auto plan = PlanBuilder().tableScan(type).planNode();
+  assertQuery(plan, file, "SELECT * FROM tmp");
+}
+
+TEST_P(ParquetScanTest, filterProject) {
+  auto vectors = makeVectors();
+  auto file = writeParquet(vectors);
+  createDuckDbTable(vectors);
+  auto type = asRowType(vectors[0]->type());
+  auto plan = PlanBuilder()
+                  .tableScan(type, {"c0 < 3000", "c2 > 1000"})
+                  .project({"c0 + 1 as c0", "c1", "c2 * 2 as c2"})
+                  .planNode();
+  assertQuery(
+      plan,
+      file,
+      "SELECT c0 + 1, c1, c2 * 2 FROM tmp WHERE c0 < 3000 AND c2 > 1000");
+}
+
+TEST_P(ParquetScanTest, scanAgg) {
+  auto vectors = makeVectors();
+  auto file = writeParquet(vectors);
+  createDuckDbTable(vectors);
+  auto type = asRowType(vectors[0]->type());
+  auto plan = PlanBuilder()
+                  .tableScan(type, {"c0 between 700 and 5000"})
+                  .project({"c0", "c2 + 1 as c2"})
+                  .singleAggregation({}, {"sum(c0)", "sum(c2)"})
+                  .planNode();
+  assertQuery(
+      plan,
+      file,
+      "SELECT sum(c0), sum(c2 + 1) FROM tmp WHERE c0 between 700 and 5000");
+}
+
+VELOX_INSTANTIATE_TEST_SUITE_P(
+    ParquetScanTests,
+    ParquetScanTest,
+    testing::Values(
+        PageEncoding::kPlain,
+        PageEncoding::kDictionary,
+        PageEncoding::kDelta),
+    [](const testing::TestParamInfo<PageEncoding>& info) {
+      return toString(info.param);
+    });
+
+} // namespace
@@ -14,19 +14,22 @@
  * limitations under the License.
  */
 #include "velox/expression/CoalesceExpr.h"
+#include "velox/expression/CompactEval.h"
 
 namespace facebook::velox::exec {
 
 CoalesceExpr::CoalesceExpr(
     TypePtr type,
     std::vector<ExprPtr>&& inputs,
-    bool inputsSupportFlatNoNullsFastPath)
+    bool inputsSupportFlatNoNullsFastPath,
+    double sparseBranchMaxDensity)
     : SpecialForm(
           std::move(type),
           std::move(inputs),
           kCoalesce,
           inputsSupportFlatNoNullsFastPath,
-          false /* trackCpuUsage */) {
+          false /* trackCpuUsage */),
+      sparseBranchMaxDensity_{sparseBranchMaxDensity} {
   std::vector<TypePtr> inputTypes;
   inputTypes.reserve(inputs_.size());
   std::transform(
@@ -59,7 +62,16 @@ void CoalesceExpr::evalSpecialForm(
 
   exec::LocalDecodedVector decodedVector(context);
   for (int i = 0; i < inputs_.size(); i++) {
-    inputs_[i]->eval(*activeRows, context, result);
+    // The first input is evaluated on all the rows.
+    if (i == 0 ||
+        !tryEvalCompacted(
+            *inputs_[i],
+            *activeRows,
+            sparseBranchMaxDensity_,
+            context,
+            result)) {
+      inputs_[i]->eval(*activeRows, context, result);
+    }
 
     if (!result->mayHaveNulls()) {
       // No nulls left.
@@ -111,10 +123,13 @@ ExprPtr CoalesceCallToSpecialForm::constructSpecialForm(
     const TypePtr& type,
     std::vector<ExprPtr>&& compiledChildren,
     bool /* trackCpuUsage */,
-    const core::QueryConfig& /*config*/) {
+    const core::QueryConfig& config) {
   bool inputsSupportFlatNoNullsFastPath =
       Expr::allSupportFlatNoNullsFastPath(compiledChildren);
   return std::make_shared<CoalesceExpr>(
-      type, std::move(compiledChildren), inputsSupportFlatNoNullsFastPath);
+      type,
+      std::move(compiledChildren),
+      inputsSupportFlatNoNullsFastPath,
+      config.exprSparseBranchMaxDensity());
 }
 } // namespace facebook::velox::exec
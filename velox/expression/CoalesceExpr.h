@@ -24,10 +24,14 @@ const char* const kCoalesce = "coalesce";
 
 class CoalesceExpr : public SpecialForm {
  public:
+  /// 'sparseBranchMaxDensity' is the density of the remaining null rows under
+  /// which an input is evaluated over a dense copy of its inputs, see
+  /// 'tryEvalCompacted()'.
   CoalesceExpr(
       TypePtr type,
       std::vector<ExprPtr>&& inputs,
-      bool inputsSupportFlatNoNullsFastPath);
+      bool inputsSupportFlatNoNullsFastPath,
+      double sparseBranchMaxDensity = 0);
 
   void evalSpecialForm(
       const SelectivityVector& rows,
@@ -41,6 +45,8 @@ class CoalesceExpr : public SpecialForm {
 
   static TypePtr resolveType(const std::vector<TypePtr>& argTypes);
 
+  const double sparseBranchMaxDensity_;
+
   friend class CoalesceCallToSpecialForm;
 };
 
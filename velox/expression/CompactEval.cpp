@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/CompactEval.h"
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FieldReference.h"
+
+namespace facebook::velox::exec {
+
+bool tryEvalCompacted(
+    Expr& expr,
+    const SelectivityVector& rows,
+    double maxDensity,
+    EvalCtx& context,
+    VectorPtr& result) {
+  if (maxDensity <= 0 || context.row() == nullptr ||
+      expr.is<FieldReference>() || expr.is<ConstantExpr>() ||
+      expr.type()->kind() == TypeKind::FUNCTION) {
+    return false;
+  }
+  const auto numRows = rows.countSelected();
+  if (numRows == rows.end() || numRows > maxDensity * rows.end()) {
+    return false;
+  }
+  for (const auto* field : expr.distinctFields()) {
+    if (!field->inputs().empty()) {
+      return false;
+    }
+  }
+
+  // The row in 'rows' of each dense row.
+  auto indices = allocateIndices(numRows, context.pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numDense = 0;
+  rows.applyToSelected([&](auto row) { rawIndices[numDense++] = row; });
+
+  LocalSelectivityVector denseRows(context);
+  denseRows.get(numRows, true);
+
+  // The columns 'expr' does not read are null constants.
+  const auto& rowType = context.row()->type()->asRow();
+  std::vector<VectorPtr> children(rowType.size());
+  for (auto* field : expr.distinctFields()) {
+    const auto index = field->index(context);
+    const auto input = context.ensureFieldLoaded(index, rows);
+    auto& child = children[index];
+    child = BaseVector::create(input->type(), numRows, context.pool());
+    child->copy(input.get(), *denseRows, rawIndices);
+  }
+  for (auto i = 0; i < children.size(); ++i) {
+    if (children[i] == nullptr) {
+      children[i] = BaseVector::createNullConstant(
+          rowType.childAt(i), numRows, context.pool());
+    }
+  }
+  auto denseInput = std::make_shared<RowVector>(
+      context.pool(),
+      context.row()->type(),
+      nullptr,
+      numRows,
+      std::move(children));
+
+  EvalCtx denseContext(context.execCtx(), context.exprSet(), denseInput.get());
+  *denseContext.mutableThrowOnError() = context.throwOnError();
+  *denseContext.mutableCaptureErrorDetails() = context.captureErrorDetails();
+  VectorPtr denseResult;
+  expr.eval(*denseRows, denseContext, denseResult);
+  denseContext.addElementErrorsToTopLevel(
+      *denseRows, indices, *context.errorsPtr());
+
+  // Scatters runs of consecutive rows at a time.
+  std::vector<BaseVector::CopyRange> ranges;
+  for (vector_size_t i = 0; i < numRows; ++i) {
+    if (!ranges.empty() &&
+        ranges.back().targetIndex + ranges.back().count == rawIndices[i]) {
+      ++ranges.back().count;
+    } else {
+      ranges.push_back({i, rawIndices[i], 1});
+    }
+  }
+  context.ensureWritable(rows, expr.type(), result);
+  result->copyRanges(denseResult.get(), ranges);
+  return true;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/Expr.h"
+
+namespace facebook::velox::exec {
+
+/// Evaluates 'expr' on 'rows' over a compacted copy of its inputs if 'rows'
+/// select at most 'maxDensity' of 'rows.end()', see
+/// 'QueryConfig::kExprSparseBranchMaxDensity'. The input columns 'expr' reads
+/// are gathered into dense vectors of 'rows.countSelected()' rows, 'expr' is
+/// evaluated on all of these and the result and the errors are scattered back
+/// to 'rows' of 'result' and 'context'. This keeps the selectivity vectors and
+/// the intermediate results of 'expr' proportional to the selected rows
+/// instead of to the batch.
+///
+/// Returns false without evaluating 'expr' if 'rows' are dense or if 'expr'
+/// is a column, a constant or of a function type.
+bool tryEvalCompacted(
+    Expr& expr,
+    const SelectivityVector& rows,
+    double maxDensity,
+    EvalCtx& context,
+    VectorPtr& result);
+
+} // namespace facebook::velox::exec
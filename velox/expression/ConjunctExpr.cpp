@@ -179,22 +179,25 @@ void ConjunctExpr::evalSpecialForm(
 }
 
 void ConjunctExpr::maybeReorderInputs() {
-  bool reorder = false;
-  for (auto i = 1; i < inputs_.size(); ++i) {
-    if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
-        selectivity_[inputOrder_[i]].timeToDropValue()) {
-      reorder = true;
-      break;
+  if (++numEvalsSinceDecay_ == kSelectivityDecayInterval) {
+    for (auto& selectivity : selectivity_) {
+      selectivity.decay();
     }
+    numEvalsSinceDecay_ = 0;
   }
-  if (reorder) {
-    std::sort(
-        inputOrder_.begin(),
-        inputOrder_.end(),
-        [this](size_t left, size_t right) {
-          return selectivity_[left].timeToDropValue() <
-              selectivity_[right].timeToDropValue();
-        });
+  const auto lessCostly = [this](size_t left, size_t right) {
+    return selectivity_[left].timeToDropValue() <
+        selectivity_[right].timeToDropValue();
+  };
+  auto begin = inputOrder_.begin();
+  while (begin != inputOrder_.end()) {
+    auto end = std::find_if(begin, inputOrder_.end(), [&](int32_t input) {
+      return !inputs_[input]->isDeterministic();
+    });
+    if (!std::is_sorted(begin, end, lessCostly)) {
+      std::sort(begin, end, lessCostly);
+    }
+    begin = end == inputOrder_.end() ? end : end + 1;
   }
 }
 
@@ -67,6 +67,15 @@ class ConjunctExpr : public SpecialForm {
     return selectivity_[inputOrder_[index]];
   }
 
+  /// Returns the input evaluated at position 'index'.
+  const ExprPtr& inputAt(int32_t index) const {
+    return inputs_[inputOrder_[index]];
+  }
+
+  /// The number of evaluations after which the selectivity of the inputs is
+  /// decayed, so that the order follows changes in the input.
+  static constexpr int32_t kSelectivityDecayInterval = 64;
+
   std::string toSql(
       std::vector<VectorPtr>* complexConstants = nullptr) const override;
 
@@ -83,6 +92,9 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
+  // Sorts the inputs by the time per row they decide, e.g. rejected by an
+  // AND. Only consecutive deterministic inputs are reordered: a
+  // non-deterministic input keeps its position and its inputs before it.
   void maybeReorderInputs();
 
   void updateResult(
@@ -105,6 +117,8 @@ class ConjunctExpr : public SpecialForm {
   bool reorderEnabled_;
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
+  // The number of evaluations since the last decay of 'selectivity_'.
+  int32_t numEvalsSinceDecay_{0};
 
   friend class ConjunctCallToSpecialForm;
 };
@@ -277,7 +277,7 @@ void EvalCtx::moveAppendErrors(EvalErrorsPtr& other) {
   errors_.reset();
 }
 
-const VectorPtr& EvalCtx::getField(int32_t index) const {
+const VectorPtr& EvalCtx::getField(int32_t index, bool loadChildren) const {
   const VectorPtr* field;
   if (!peeledFields_.empty()) {
     field = &peeledFields_[index];
@@ -286,7 +286,8 @@ const VectorPtr& EvalCtx::getField(int32_t index) const {
   }
   if ((*field)->isLazy() && (*field)->asUnchecked<LazyVector>()->isLoaded()) {
     auto lazy = (*field)->asUnchecked<LazyVector>();
-    return lazy->loadedVectorShared();
+    return loadChildren ? lazy->loadedVectorShared()
+                        : lazy->loadedVectorSharedWithLazyChildren();
   }
   return *field;
 }
@@ -240,8 +240,9 @@ class EvalCtx {
 
   // Returns the index-th column of the base row. If we have peeled off
   // wrappers like dictionaries, then this provides access only to the
-  // peeled off fields.
-  const VectorPtr& getField(int32_t index) const;
+  // peeled off fields. A loaded lazy struct column keeps its lazy children
+  // unloaded if 'loadChildren' is false.
+  const VectorPtr& getField(int32_t index, bool loadChildren = true) const;
 
   VectorPtr ensureFieldLoaded(int32_t index, const SelectivityVector& rows);
 
@@ -438,6 +439,12 @@ class EvalCtx {
     return execCtx_;
   }
 
+  /// Returns the reusable scratch areas of 'execCtx()' for the temporaries of
+  /// an expression that do not outlive its evaluation.
+  Scratch& scratch() const {
+    return execCtx_->scratch();
+  }
+
   ExprSet* exprSet() const {
     return exprSet_;
   }
@@ -532,6 +539,18 @@ class EvalCtx {
     return execCtx_->optimizationParams().maxSharedSubexprResultsCached;
   }
 
+  /// Returns the maximum retained size in bytes of the results memoized for
+  /// the base of a dictionary input, 0 if there is no limit.
+  uint64_t maxDictionaryMemoBytes() const {
+    return execCtx_->optimizationParams().maxDictionaryMemoBytes;
+  }
+
+  /// Returns true if the time, allocations and rows of each expression are
+  /// recorded in its ExprStats.
+  bool exprProfileEnabled() const {
+    return execCtx_->optimizationParams().exprProfileEnabled;
+  }
+
   /// Returns true if peeling is enabled.
   bool peelingEnabled() const {
     return execCtx_->optimizationParams().peelingEnabled;
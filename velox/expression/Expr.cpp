@@ -99,6 +99,23 @@ bool hasConditionals(Expr* expr) {
   return false;
 }
 
+// Adds to 'fields' the columns that 'expr' reads other than as the struct
+// input of a field reference.
+void collectFieldsReadWhole(
+    const Expr& expr,
+    std::unordered_set<FieldReference*>& fields) {
+  for (const auto& input : expr.inputs()) {
+    auto* reference = input->as<FieldReference>();
+    if (reference != nullptr && reference->inputs().empty()) {
+      if (!expr.is<FieldReference>()) {
+        fields.insert(reference);
+      }
+      continue;
+    }
+    collectFieldsReadWhole(*input, fields);
+  }
+}
+
 void checkOrSetEmptyResult(
     const TypePtr& type,
     memory::MemoryPool* pool,
@@ -289,6 +306,17 @@ void Expr::computeMetadata() {
   // (5) Compute hasConditionals_.
   hasConditionals_ = exec::hasConditionals(this);
 
+  // (6) Compute dereferencedFields_.
+  if (!is<FieldReference>() || !inputs_.empty()) {
+    std::unordered_set<FieldReference*> fieldsReadWhole;
+    collectFieldsReadWhole(*this, fieldsReadWhole);
+    for (auto* field : distinctFields_) {
+      if (field->type()->isRow() && fieldsReadWhole.count(field) == 0) {
+        dereferencedFields_.insert(field);
+      }
+    }
+  }
+
   metaDataComputed_ = true;
 }
 
@@ -328,6 +356,7 @@ bool isFlat(const BaseVector& vector) {
   }
   return !(
       encoding == VectorEncoding::Simple::DICTIONARY ||
+      encoding == VectorEncoding::Simple::SEQUENCE ||
       encoding == VectorEncoding::Simple::CONSTANT);
 }
 
@@ -699,6 +728,25 @@ void Expr::evalFlatNoNulls(
     EvalCtx& context,
     VectorPtr& result,
     const ExprSet* parentExprSet) {
+  ++stats_.numFlatNoNulls;
+  if (FOLLY_UNLIKELY(context.exprProfileEnabled())) {
+    evalWithProfile(rows, context, result, [&]() {
+      if (shouldEvaluateSharedSubexp(context)) {
+        evaluateSharedSubexpr(
+            rows,
+            context,
+            result,
+            [&](const SelectivityVector& rows,
+                EvalCtx& context,
+                VectorPtr& result) {
+              evalFlatNoNullsImpl(rows, context, result, parentExprSet);
+            });
+      } else {
+        evalFlatNoNullsImpl(rows, context, result, parentExprSet);
+      }
+    });
+    return;
+  }
   if (shouldEvaluateSharedSubexp(context)) {
     evaluateSharedSubexpr(
         rows,
@@ -771,6 +819,47 @@ void Expr::eval(
     return;
   }
 
+  if (FOLLY_UNLIKELY(context.exprProfileEnabled())) {
+    evalWithProfile(rows, context, result, [&]() {
+      evalImpl(rows, context, result, parentExprSet);
+    });
+    return;
+  }
+  evalImpl(rows, context, result, parentExprSet);
+}
+
+template <typename TEval>
+void Expr::evalWithProfile(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result,
+    TEval eval) {
+  const auto allocatedBytes = context.pool()->stats().cumulativeBytes;
+  {
+    CpuWallTimer timer(stats_.profileTiming);
+    eval();
+  }
+  stats_.allocatedBytes +=
+      context.pool()->stats().cumulativeBytes - allocatedBytes;
+  const auto numRows = rows.countSelected();
+  stats_.numProfiledRows += numRows;
+  if (result == nullptr) {
+    return;
+  }
+  if (!result->mayHaveNulls()) {
+    stats_.numOutputRows += numRows;
+    return;
+  }
+  rows.applyToSelected([&](auto row) {
+    stats_.numOutputRows += !result->isNullAt(row);
+  });
+}
+
+void Expr::evalImpl(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result,
+    const ExprSet* parentExprSet) {
   // Make sure to include current expression in the error message in case of
   // an exception.
   ExprExceptionContext exprExceptionContext{this, context.row(), parentExprSet};
@@ -815,7 +904,9 @@ void Expr::eval(
       !context.deferredLazyLoadingEnabled()) {
     // Load lazy vectors if any.
     for (auto* field : distinctFields_) {
-      context.ensureFieldLoaded(field->index(context), rows);
+      if (dereferencedFields_.count(field) == 0) {
+        context.ensureFieldLoaded(field->index(context), rows);
+      }
     }
   } else if (
       !propagatesNulls_ && !evaluatesArgumentsOnNonIncreasingSelection()) {
@@ -824,7 +915,9 @@ void Expr::eval(
     // case evaluatesArgumentsOnNonIncreasingSelection() is true, this is
     // delayed until we process the inputs of ConjunctExpr.
     for (const auto& field : multiplyReferencedFields_) {
-      context.ensureFieldLoaded(field->index(context), rows);
+      if (dereferencedFields_.count(field) == 0) {
+        context.ensureFieldLoaded(field->index(context), rows);
+      }
     }
   }
 
@@ -1088,6 +1181,7 @@ void Expr::evalEncodings(
       });
 
       if (wrappedResult != nullptr) {
+        ++stats_.numPeeled;
         context.moveOrCopyResult(wrappedResult, rows, result);
         return;
       }
@@ -1184,7 +1278,9 @@ void Expr::evalWithNulls(
 // Since this hold onto a reference to the base vector and the cached results,
 // it can be memory intensive. Therefore in order to reduce this consumption
 // and ensure it is only employed for cases where it can be useful, it only
-// starts caching result after it encounters the same base at least twice.
+// starts caching result after it encounters the same base at least twice, and
+// stops caching for the base once the results are larger than
+// EvalCtx::maxDictionaryMemoBytes().
 void Expr::evalWithMemo(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1199,6 +1295,11 @@ void Expr::evalWithMemo(
     baseOfDictionaryRawPtr_ = base.get();
     context.releaseVector(baseOfDictionary_);
     context.releaseVector(dictionaryCache_);
+    dictionaryCacheOverLimit_ = false;
+    evalWithNulls(rows, context, result);
+    return;
+  }
+  if (dictionaryCacheOverLimit_) {
     evalWithNulls(rows, context, result);
     return;
   }
@@ -1214,6 +1315,7 @@ void Expr::evalWithMemo(
     }
     *cachedDictionaryIndices_ = rows;
     context.deselectErrors(*cachedDictionaryIndices_);
+    checkDictionaryCacheSize(context);
     return;
   }
 
@@ -1223,6 +1325,7 @@ void Expr::evalWithMemo(
     VELOX_DCHECK(cached != nullptr);
     cached->intersect(*cachedDictionaryIndices_);
     if (cached->hasSelections()) {
+      stats_.numMemoizedRows += cached->countSelected();
       context.ensureWritable(rows, type(), result);
       result->copy(dictionaryCache_.get(), *cached, nullptr);
     }
@@ -1267,10 +1370,24 @@ void Expr::evalWithMemo(
       dictionaryCache_->resize(uncached->end());
     }
     dictionaryCache_->copy(result.get(), *uncached, nullptr);
+    checkDictionaryCacheSize(context);
   }
   context.releaseVector(base);
 }
 
+void Expr::checkDictionaryCacheSize(EvalCtx& context) {
+  const auto maxBytes = context.maxDictionaryMemoBytes();
+  if (maxBytes == 0 || dictionaryCache_->retainedSize() <= maxBytes) {
+    return;
+  }
+  // Keeps 'baseOfDictionaryRawPtr_' and 'baseOfDictionaryWeakPtr_' to
+  // recognize the base in the next batches.
+  dictionaryCacheOverLimit_ = true;
+  baseOfDictionary_.reset();
+  dictionaryCache_.reset();
+  cachedDictionaryIndices_->clearAll();
+}
+
 void Expr::setAllNulls(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1360,6 +1477,7 @@ inline bool isPeelable(VectorEncoding::Simple encoding) {
   switch (encoding) {
     case VectorEncoding::Simple::CONSTANT:
     case VectorEncoding::Simple::DICTIONARY:
+    case VectorEncoding::Simple::SEQUENCE:
       return true;
     default:
       return false;
@@ -1491,6 +1609,7 @@ bool Expr::applyFunctionWithPeeling(
   // those rows are not used but isFinalSelection() is only used to check
   // whether pre-existing rows need to be preserved.
   auto newRows = peeledEncoding->translateToInnerRows(applyRows, newRowsHolder);
+  ++stats_.numPeeled;
 
   withContextSaver([&](ContextSaver& saver) {
     // Save context and set the peel.
@@ -1783,7 +1902,8 @@ void addStats(
   uniqueExprs.insert(&expr);
 
   // Do not aggregate empty stats.
-  if (expr.stats().numProcessedRows || expr.stats().defaultNullRowsSkipped) {
+  if (expr.stats().numProcessedRows || expr.stats().defaultNullRowsSkipped ||
+      expr.stats().numProfiledRows) {
     stats[expr.name()].add(expr.stats());
   }
 
@@ -1792,6 +1912,29 @@ void addStats(
   }
 }
 
+void addProfile(
+    const exec::Expr& expr,
+    const std::string& parentPath,
+    std::map<std::string, exec::ExprStats>& profile,
+    std::map<std::string, int64_t>& selfNanos,
+    std::unordered_set<const exec::Expr*>& uniqueExprs) {
+  if (!uniqueExprs.insert(&expr).second) {
+    // Common sub-expression. Skip to avoid double counting.
+    return;
+  }
+  const auto path =
+      parentPath.empty() ? expr.name() : parentPath + ";" + expr.name();
+  profile[path].add(expr.stats());
+  int64_t nanos = expr.stats().profileTiming.wallNanos;
+  for (const auto& input : expr.inputs()) {
+    if (!uniqueExprs.count(input.get())) {
+      nanos -= input->stats().profileTiming.wallNanos;
+    }
+    addProfile(*input, path, profile, selfNanos, uniqueExprs);
+  }
+  selfNanos[path] += std::max<int64_t>(nanos, 0);
+}
+
 std::string makeUuid() {
   return boost::lexical_cast<std::string>(boost::uuids::random_generator()());
 }
@@ -1807,6 +1950,30 @@ std::unordered_map<std::string, exec::ExprStats> ExprSet::stats() const {
   return stats;
 }
 
+std::map<std::string, exec::ExprStats> ExprSet::profile() const {
+  std::map<std::string, exec::ExprStats> profile;
+  std::map<std::string, int64_t> selfNanos;
+  std::unordered_set<const exec::Expr*> uniqueExprs;
+  for (const auto& expr : exprs()) {
+    addProfile(*expr, "", profile, selfNanos, uniqueExprs);
+  }
+  return profile;
+}
+
+std::string ExprSet::profileToFoldedStacks() const {
+  std::map<std::string, exec::ExprStats> profile;
+  std::map<std::string, int64_t> selfNanos;
+  std::unordered_set<const exec::Expr*> uniqueExprs;
+  for (const auto& expr : exprs()) {
+    addProfile(*expr, "", profile, selfNanos, uniqueExprs);
+  }
+  std::stringstream out;
+  for (const auto& [path, nanos] : selfNanos) {
+    out << path << " " << nanos << std::endl;
+  }
+  return out.str();
+}
+
 ExprSet::~ExprSet() {
   exprSetListeners().withRLock([&](auto& listeners) {
     if (!listeners.empty()) {
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include <folly/container/F14Map.h>
@@ -50,11 +51,37 @@ struct ExprStats {
   /// evaluation of rows.
   bool defaultNullRowsSkipped{false};
 
+  /// Number of times the expression was evaluated on the flat no nulls fast
+  /// path, the inputs were peeled and of the rows served from the memoized
+  /// results of a dictionary base.
+  uint64_t numFlatNoNulls{0};
+  uint64_t numPeeled{0};
+  uint64_t numMemoizedRows{0};
+
+  /// The following require QueryConfig.exprProfileEnabled() to be 'true' and
+  /// include the evaluation of the inputs of the expression.
+  CpuWallTiming profileTiming;
+
+  /// Number of rows the expression was evaluated on and of these the number
+  /// of rows with a non-null result.
+  uint64_t numProfiledRows{0};
+  uint64_t numOutputRows{0};
+
+  /// Bytes allocated from the memory pool of the evaluation.
+  uint64_t allocatedBytes{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
     defaultNullRowsSkipped |= other.defaultNullRowsSkipped;
+    numFlatNoNulls += other.numFlatNoNulls;
+    numPeeled += other.numPeeled;
+    numMemoizedRows += other.numMemoizedRows;
+    profileTiming.add(other.profileTiming);
+    numProfiledRows += other.numProfiledRows;
+    numOutputRows += other.numOutputRows;
+    allocatedBytes += other.allocatedBytes;
   }
 
   std::string toString() const {
@@ -256,6 +283,7 @@ class Expr {
     baseOfDictionaryRawPtr_ = nullptr;
     dictionaryCache_ = nullptr;
     cachedDictionaryIndices_ = nullptr;
+    dictionaryCacheOverLimit_ = false;
   }
 
   virtual void clearCache() {
@@ -444,11 +472,30 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Evaluates the expression when the flat no nulls fast path does not apply.
+  void evalImpl(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result,
+      const ExprSet* parentExprSet);
+
+  // Calls 'eval' and adds its time, allocations and rows to 'stats_'.
+  template <typename TEval>
+  void evalWithProfile(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result,
+      TEval eval);
+
   void evalWithMemo(
       const SelectivityVector& rows,
       EvalCtx& context,
       VectorPtr& result);
 
+  // Drops the memoized results for the current base if they are larger than
+  // EvalCtx::maxDictionaryMemoBytes().
+  void checkDictionaryCacheSize(EvalCtx& context);
+
   void evalWithNulls(
       const SelectivityVector& rows,
       EvalCtx& context,
@@ -602,6 +649,11 @@ class Expr {
   // Used to determine pre-loading of lazy vectors at current expr.
   std::unordered_set<FieldReference*> multiplyReferencedFields_;
 
+  // The struct columns in 'distinctFields_' that are read only through
+  // references to their fields. These are not pre-loaded, so that the field
+  // references load only the fields they read.
+  std::unordered_set<FieldReference*> dereferencedFields_;
+
   // True if a null in any of 'distinctFields_' causes 'this' to be
   // null for the row.
   bool propagatesNulls_ = false;
@@ -681,6 +733,11 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // True if 'dictionaryCache_' grew larger than
+  // EvalCtx::maxDictionaryMemoBytes() for the current base. No results are
+  // memoized until the base changes.
+  bool dictionaryCacheOverLimit_ = false;
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
@@ -784,6 +841,18 @@ class ExprSet {
   /// evaluated.
   std::unordered_map<std::string, exec::ExprStats> stats() const;
 
+  /// Returns evaluation statistics for each node of the expression trees
+  /// keyed on the names of the expressions from the root to the node joined
+  /// by ';', e.g. 'and;gt;plus'. Nodes with the same path are aggregated. The
+  /// profile fields of the statistics require
+  /// QueryConfig.exprProfileEnabled() to be 'true'.
+  std::map<std::string, exec::ExprStats> profile() const;
+
+  /// Returns the profile in the folded stacks format of flame graphs, one
+  /// line per node with its path and the wall time in nanoseconds spent in
+  /// the node itself, excluding its inputs.
+  std::string profileToFoldedStacks() const;
+
  protected:
   void clearSharedSubexprs();
 
@@ -21,6 +21,7 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -366,6 +367,23 @@ core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   return expr;
 }
 
+// Returns a FusedArithmeticExpr for the call of 'name' if enabled and if the
+// call resolves to a simple function that can be fused.
+ExprPtr tryFuseArithmetic(
+    const std::string& name,
+    const TypePtr& resultType,
+    const std::vector<ExprPtr>& compiledInputs,
+    const std::vector<TypePtr>& inputTypes,
+    const core::QueryConfig& config) {
+  if (!config.exprFusedArithmeticEnabled() ||
+      getVectorFunctionSignatures(name).has_value() ||
+      !simpleFunctions().resolveFunction(name, inputTypes).has_value()) {
+    return nullptr;
+  }
+  return FusedArithmeticExpr::tryFuse(
+      name, resultType, compiledInputs, config.exprTrackCpuUsage());
+}
+
 ExprPtr compileRewrittenExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -417,6 +435,10 @@ ExprPtr compileRewrittenExpression(
     if (auto specialForm = specialFormRegistry().getSpecialForm(call->name())) {
       result = specialForm->constructSpecialForm(
           resultType, std::move(compiledInputs), trackCpuUsage, config);
+    } else if (
+        auto fused = tryFuseArithmetic(
+            call->name(), resultType, compiledInputs, inputTypes, config)) {
+      result = fused;
     } else if (
         auto functionWithMetadata = getVectorFunctionWithMetadata(
             call->name(),
@@ -591,19 +613,32 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
     core::ExecCtx* execCtx,
     ExprSet* exprSet,
     bool enableConstantFolding) {
+  const auto& config = execCtx->queryCtx()->queryConfig();
+  // Keeps the rewritten expressions alive while compiling, since the compiled
+  // expressions are deduplicated by address.
+  std::vector<TypedExprPtr> rewritten;
+  for (auto& rewrite : expressionSetRewrites()) {
+    auto result = rewrite(rewritten.empty() ? sources : rewritten, config);
+    if (!result.empty()) {
+      VELOX_CHECK_EQ(result.size(), sources.size());
+      rewritten = std::move(result);
+    }
+  }
+  const auto& rewrittenSources = rewritten.empty() ? sources : rewritten;
+
   Scope scope({}, nullptr, exprSet);
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(rewrittenSources);
 
-  for (auto& source : sources) {
+  for (auto& source : rewrittenSources) {
     exprs.push_back(compileExpression(
         source,
         &scope,
-        execCtx->queryCtx()->queryConfig(),
+        config,
         execCtx->pool(),
         flatteningCandidates,
         enableConstantFolding));
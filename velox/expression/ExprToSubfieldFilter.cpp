@@ -17,6 +17,7 @@
 #include "velox/expression/ExprToSubfieldFilter.h"
 
 #include "velox/expression/Expr.h"
+#include "velox/expression/FieldReference.h"
 
 using namespace facebook::velox;
 
@@ -561,4 +562,180 @@ std::pair<common::Subfield, std::unique_ptr<common::Filter>> toSubfieldFilter(
       "Unsupported expression for range filter: {}", expr->toString());
 }
 
+// static
+std::unique_ptr<ExpressionFilter> ExpressionFilter::create(
+    const core::TypedExprPtr& expr,
+    core::ExpressionEvaluator* evaluator,
+    common::Subfield& subfield) {
+  if (expr->type()->kind() != TypeKind::BOOLEAN) {
+    return nullptr;
+  }
+  std::shared_ptr<ExprSet> exprSet = evaluator->compile(expr);
+  const auto& compiled = exprSet->expr(0);
+  if (!compiled->isDeterministic() || compiled->distinctFields().size() != 1) {
+    return nullptr;
+  }
+  const auto* field = compiled->distinctFields()[0];
+  if (!field->inputs().empty() ||
+      (field->type()->kind() != TypeKind::VARCHAR &&
+       field->type()->kind() != TypeKind::VARBINARY)) {
+    return nullptr;
+  }
+  auto inputType = ROW({field->field()}, {field->type()});
+
+  // The result for null decides whether nulls pass, e.g. for coalesce(c, '').
+  auto input = std::make_shared<RowVector>(
+      evaluator->pool(),
+      inputType,
+      nullptr,
+      1,
+      std::vector<VectorPtr>{
+          BaseVector::createNullConstant(field->type(), 1, evaluator->pool())});
+  SelectivityVector rows(1);
+  VectorPtr result;
+  bool nullAllowed = true;
+  try {
+    evaluator->evaluate(exprSet.get(), rows, *input, result);
+    nullAllowed = !result->isNullAt(0) &&
+        result->as<SimpleVector<bool>>()->valueAt(0);
+  } catch (const VeloxUserError&) {
+  }
+  subfield = common::Subfield(field->field());
+  return std::make_unique<ExpressionFilter>(
+      std::move(exprSet), std::move(inputType), evaluator, nullAllowed);
+}
+
+ExpressionFilter::ExpressionFilter(
+    std::shared_ptr<ExprSet> exprSet,
+    RowTypePtr inputType,
+    core::ExpressionEvaluator* evaluator,
+    bool nullAllowed,
+    std::vector<common::FilterPtr> conjuncts)
+    : Filter(true, nullAllowed, common::FilterKind::kExpression),
+      exprSet_(std::move(exprSet)),
+      inputType_(std::move(inputType)),
+      evaluator_(evaluator),
+      conjuncts_(std::move(conjuncts)) {
+  input_ = std::make_shared<RowVector>(
+      evaluator_->pool(),
+      inputType_,
+      nullptr,
+      1,
+      std::vector<VectorPtr>{
+          BaseVector::create(inputType_->childAt(0), 1, evaluator_->pool())});
+}
+
+folly::dynamic ExpressionFilter::serialize() const {
+  auto obj = Filter::serializeBase("ExpressionFilter");
+  obj["expression"] = exprSet_->expr(0)->toString();
+  folly::dynamic conjuncts = folly::dynamic::array;
+  for (const auto& conjunct : conjuncts_) {
+    conjuncts.push_back(conjunct->serialize());
+  }
+  obj["conjuncts"] = conjuncts;
+  return obj;
+}
+
+std::vector<common::FilterPtr> ExpressionFilter::cloneConjuncts() const {
+  std::vector<common::FilterPtr> conjuncts;
+  conjuncts.reserve(conjuncts_.size());
+  for (const auto& conjunct : conjuncts_) {
+    conjuncts.push_back(conjunct->clone());
+  }
+  return conjuncts;
+}
+
+std::unique_ptr<common::Filter> ExpressionFilter::clone(
+    std::optional<bool> nullAllowed) const {
+  return std::make_unique<ExpressionFilter>(
+      exprSet_,
+      inputType_,
+      evaluator_,
+      nullAllowed.value_or(nullAllowed_),
+      cloneConjuncts());
+}
+
+bool ExpressionFilter::testingEquals(const common::Filter& other) const {
+  const auto* otherFilter = dynamic_cast<const ExpressionFilter*>(&other);
+  if (otherFilter == nullptr || !Filter::testingBaseEquals(other) ||
+      otherFilter->exprSet_ != exprSet_ ||
+      otherFilter->conjuncts_.size() != conjuncts_.size()) {
+    return false;
+  }
+  for (auto i = 0; i < conjuncts_.size(); ++i) {
+    if (!conjuncts_[i]->testingEquals(*otherFilter->conjuncts_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ExpressionFilter::testBytes(const char* value, int32_t length) const {
+  for (const auto& conjunct : conjuncts_) {
+    if (!conjunct->testBytes(value, length)) {
+      return false;
+    }
+  }
+  const std::string_view view(value, length);
+  if (auto it = cache_.find(view); it != cache_.end()) {
+    return it->second;
+  }
+  input_->childAt(0)->asFlatVector<StringView>()->set(
+      0, StringView(value, length));
+  const bool passed = evaluate();
+  if (cache_.size() < kMaxCachedValues) {
+    cache_.emplace(view, passed);
+  }
+  return passed;
+}
+
+bool ExpressionFilter::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  for (const auto& conjunct : conjuncts_) {
+    if (!conjunct->testBytesRange(min, max, hasNull)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ExpressionFilter::evaluate() const {
+  SelectivityVector rows(1);
+  try {
+    evaluator_->evaluate(exprSet_.get(), rows, *input_, result_);
+  } catch (const VeloxUserError&) {
+    // The remaining filter raises the error if the row passes the other
+    // filters.
+    return true;
+  }
+  return !result_->isNullAt(0) &&
+      result_->as<SimpleVector<bool>>()->valueAt(0);
+}
+
+std::unique_ptr<common::Filter> ExpressionFilter::mergeWith(
+    const common::Filter* other) const {
+  auto conjuncts = cloneConjuncts();
+  conjuncts.push_back(other->clone());
+  return std::make_unique<ExpressionFilter>(
+      exprSet_,
+      inputType_,
+      evaluator_,
+      nullAllowed_ && other->testNull(),
+      std::move(conjuncts));
+}
+
+std::string ExpressionFilter::toString() const {
+  std::string conjuncts;
+  for (const auto& conjunct : conjuncts_) {
+    conjuncts += " AND " + conjunct->toString();
+  }
+  return fmt::format(
+      "ExpressionFilter({}{}, {})",
+      exprSet_->expr(0)->toString(),
+      conjuncts,
+      nullAllowed_ ? "null allowed" : "null not allowed");
+}
+
 } // namespace facebook::velox::exec
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/core/ExpressionEvaluator.h"
 #include "velox/core/Expressions.h"
 #include "velox/core/ITypedExpr.h"
@@ -496,6 +498,83 @@ class ExprToSubfieldFilterParser {
       parserFactory_;
 };
 
+/// Filter on a VARCHAR or VARBINARY column that evaluates a deterministic
+/// boolean expression over the column alone, e.g. lower(c) = 'us' or c LIKE
+/// '%abc%'. Lets readers apply such predicates while decoding the column and
+/// prune the rows before the other columns are read. Dictionary encoded
+/// columns evaluate the expression once per dictionary value through the
+/// filter cache of the reader. The results of up to kMaxCachedValues distinct
+/// values are also cached in the filter for the other encodings.
+///
+/// A value for which the expression fails passes the filter. The predicate
+/// must therefore also stay in the remaining filter, which then raises the
+/// error only if the row passes the other filters.
+///
+/// Cannot be deserialized. The filter is only created by a data source from
+/// its remaining filter and evaluates with the evaluator of the data source.
+class ExpressionFilter final : public common::Filter {
+ public:
+  static constexpr int32_t kMaxCachedValues = 10'000;
+
+  /// Returns a filter for 'expr' or nullptr if 'expr' is not a deterministic
+  /// boolean expression over a single top level VARCHAR or VARBINARY column.
+  /// Sets 'subfield' to the column. 'evaluator' must outlive the filter and
+  /// its copies.
+  static std::unique_ptr<ExpressionFilter> create(
+      const core::TypedExprPtr& expr,
+      core::ExpressionEvaluator* evaluator,
+      common::Subfield& subfield);
+
+  ExpressionFilter(
+      std::shared_ptr<exec::ExprSet> exprSet,
+      RowTypePtr inputType,
+      core::ExpressionEvaluator* evaluator,
+      bool nullAllowed,
+      std::vector<common::FilterPtr> conjuncts = {});
+
+  folly::dynamic serialize() const override;
+
+  std::unique_ptr<common::Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const override;
+
+  bool testingEquals(const common::Filter& other) const override;
+
+  bool testBytes(const char* value, int32_t length) const override;
+
+  /// Returns false only if a merged filter excludes the range. The expression
+  /// does not prune ranges.
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const override;
+
+  /// Returns a filter that passes the values that pass both this and 'other'.
+  std::unique_ptr<common::Filter> mergeWith(
+      const common::Filter* other) const override;
+
+  std::string toString() const override;
+
+ private:
+  std::vector<common::FilterPtr> cloneConjuncts() const;
+
+  // Evaluates the expression on the single row of 'input_'.
+  bool evaluate() const;
+
+  const std::shared_ptr<exec::ExprSet> exprSet_;
+  const RowTypePtr inputType_;
+  core::ExpressionEvaluator* const evaluator_;
+
+  // Filters merged with this filter. A value must pass all of these.
+  const std::vector<common::FilterPtr> conjuncts_;
+
+  // Reused single row input and result of the expression.
+  mutable RowVectorPtr input_;
+  mutable VectorPtr result_;
+
+  // Results of the expression by value.
+  mutable folly::F14FastMap<std::string, bool> cache_;
+};
+
 // Parser for Presto expressions.
 class PrestoExprToSubfieldFilterParser : public ExprToSubfieldFilterParser {
  public:
@@ -33,7 +33,8 @@ void FieldReference::computeDistinctFields() {
 void FieldReference::apply(
     const SelectivityVector& rows,
     EvalCtx& context,
-    VectorPtr& result) {
+    VectorPtr& result,
+    bool loadChildren) {
   const RowVector* row;
   DecodedVector decoded;
   VectorPtr input;
@@ -44,7 +45,11 @@ void FieldReference::apply(
   if (inputs_.empty()) {
     row = context.row();
   } else {
-    inputs_[0]->eval(rows, context, input);
+    if (auto* inputReference = inputs_[0]->as<FieldReference>()) {
+      inputReference->apply(rows, context, input, false);
+    } else {
+      inputs_[0]->eval(rows, context, input);
+    }
 
     decoded.decode(*input, rows);
     if (decoded.mayHaveNulls()) {
@@ -65,8 +70,9 @@ void FieldReference::apply(
           {input}, *nonNullRows, localDecoded, true, peeledVectors);
       VELOX_CHECK_NOT_NULL(peeledEncoding);
       if (peeledVectors[0]->isLazy()) {
-        peeledVectors[0] =
-            peeledVectors[0]->as<LazyVector>()->loadedVectorShared();
+        peeledVectors[0] = peeledVectors[0]
+                               ->as<LazyVector>()
+                               ->loadedVectorSharedWithLazyChildren();
       }
       VELOX_CHECK(peeledVectors[0]->encoding() == VectorEncoding::Simple::ROW);
       row = peeledVectors[0]->as<const RowVector>();
@@ -81,9 +87,12 @@ void FieldReference::apply(
     index_ = rowType->getChildIdx(field_);
   }
   VectorPtr child =
-      inputs_.empty() ? context.getField(index_) : row->childAt(index_);
+      inputs_.empty() ? context.getField(index_, loadChildren)
+                      : row->childAt(index_);
   if (child->encoding() == VectorEncoding::Simple::LAZY) {
-    child = BaseVector::loadedVectorShared(child);
+    child = loadChildren
+        ? BaseVector::loadedVectorShared(child)
+        : child->as<LazyVector>()->loadedVectorSharedWithLazyChildren();
   }
   if (result.get()) {
     if (useDecode) {
@@ -83,8 +83,15 @@ class FieldReference : public SpecialForm {
   void computeDistinctFields() override;
 
  private:
-  void
-  apply(const SelectivityVector& rows, EvalCtx& context, VectorPtr& result);
+  // Sets 'result' to the field. If 'loadChildren' is false and the field is a
+  // lazy struct, its lazy children are not loaded. This is the case when the
+  // result is the input of another field reference, which loads only the
+  // field it reads.
+  void apply(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result,
+      bool loadChildren = true);
 
   const std::string field_;
   int32_t index_ = -1;
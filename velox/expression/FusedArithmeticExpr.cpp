@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedArithmeticExpr.h"
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FieldReference.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// Returns the name of a function without the prefix it was registered with.
+std::string_view baseName(const std::string& name) {
+  const auto pos = name.rfind('.');
+  return pos == std::string::npos ? std::string_view(name)
+                                  : std::string_view(name).substr(pos + 1);
+}
+} // namespace
+
+FusedArithmeticExpr::FusedArithmeticExpr(
+    TypePtr type,
+    std::vector<ExprPtr> inputs,
+    std::vector<Instruction> program,
+    bool supportsFlatNoNullsFastPath,
+    bool trackCpuUsage)
+    : SpecialForm(
+          std::move(type),
+          std::move(inputs),
+          kFusedArithmetic,
+          supportsFlatNoNullsFastPath,
+          trackCpuUsage),
+      program_(std::move(program)),
+      maxDepth_([&]() {
+        // An input pushes an intermediate result and an op replaces two with
+        // one.
+        int32_t depth = 0;
+        int32_t maxDepth = 0;
+        for (const auto& instruction : program_) {
+          if (instruction.op == Op::kInput) {
+            maxDepth = std::max(maxDepth, ++depth);
+          } else {
+            --depth;
+          }
+        }
+        return maxDepth;
+      }()) {}
+
+// static
+ExprPtr FusedArithmeticExpr::tryFuse(
+    const std::string& name,
+    const TypePtr& type,
+    const std::vector<ExprPtr>& inputs,
+    bool trackCpuUsage) {
+  Op op;
+  const auto base = baseName(name);
+  if (base == "plus") {
+    op = Op::kPlus;
+  } else if (base == "minus") {
+    op = Op::kMinus;
+  } else if (base == "multiply") {
+    op = Op::kMultiply;
+  } else {
+    return nullptr;
+  }
+  if (inputs.size() != 2 || (*type != *DOUBLE() && *type != *REAL())) {
+    return nullptr;
+  }
+
+  std::vector<ExprPtr> leaves;
+  std::vector<Instruction> program;
+  // Returns the index of 'leaf' in 'leaves', adding it if new.
+  const auto leafIndex = [&](const ExprPtr& leaf) -> column_index_t {
+    for (auto i = 0; i < leaves.size(); ++i) {
+      if (leaves[i] == leaf) {
+        return i;
+      }
+    }
+    leaves.push_back(leaf);
+    return leaves.size() - 1;
+  };
+  for (const auto& input : inputs) {
+    if (*input->type() != *type) {
+      return nullptr;
+    }
+    if (auto* fused = input->as<FusedArithmeticExpr>()) {
+      for (const auto& instruction : fused->program_) {
+        program.push_back(instruction);
+        if (instruction.op == Op::kInput) {
+          program.back().input =
+              leafIndex(fused->inputs_[instruction.input]);
+        }
+      }
+    } else if (input->is<FieldReference>() || input->is<ConstantExpr>()) {
+      program.push_back({Op::kInput, leafIndex(input), ""});
+    } else {
+      // The other inputs may fail or depend on the rows where the other
+      // arguments are not null.
+      return nullptr;
+    }
+  }
+  program.push_back({op, 0, name});
+  const bool supportsFlatNoNullsFastPath =
+      Expr::allSupportFlatNoNullsFastPath(leaves);
+  return std::shared_ptr<FusedArithmeticExpr>(new FusedArithmeticExpr(
+      type,
+      std::move(leaves),
+      std::move(program),
+      supportsFlatNoNullsFastPath,
+      trackCpuUsage));
+}
+
+void FusedArithmeticExpr::computePropagatesNulls() {
+  propagatesNulls_ = std::all_of(
+      inputs_.begin(), inputs_.end(), [](const ExprPtr& input) {
+        return input->propagatesNulls();
+      });
+}
+
+void FusedArithmeticExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  std::vector<VectorPtr> inputValues(inputs_.size());
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputs_[i]->eval(rows, context, inputValues[i]);
+  }
+  if (type()->kind() == TypeKind::DOUBLE) {
+    evalTyped<double>(rows, inputValues, context, result);
+  } else {
+    evalTyped<float>(rows, inputValues, context, result);
+  }
+}
+
+template <typename T>
+void FusedArithmeticExpr::evalTyped(
+    const SelectivityVector& rows,
+    const std::vector<VectorPtr>& inputValues,
+    EvalCtx& context,
+    VectorPtr& result) {
+  std::vector<LocalDecodedVector> decoded;
+  decoded.reserve(inputValues.size());
+  bool mayHaveNulls = false;
+  for (const auto& input : inputValues) {
+    decoded.emplace_back(context, *input, rows);
+    mayHaveNulls |= decoded.back()->mayHaveNulls();
+  }
+
+  context.ensureWritable(rows, type(), result);
+  auto* flatResult = result->asUnchecked<FlatVector<T>>();
+  if (mayHaveNulls) {
+    // A null in any input makes the result null.
+    rows.applyToSelected([&](auto row) {
+      bool isNull = false;
+      for (const auto& input : decoded) {
+        isNull |= input->isNullAt(row);
+      }
+      flatResult->setNull(row, isNull);
+    });
+  } else if (flatResult->mayHaveNulls()) {
+    flatResult->clearNulls(rows);
+  }
+
+  auto* rawResult = flatResult->mutableRawValues();
+  // The intermediate results do not outlive this call, so their buffers are
+  // reused across the batches.
+  ScratchPtr<T> buffersHolder(context.scratch());
+  T* const buffers = buffersHolder.get(maxDepth_ * kChunkSize);
+  ScratchPtr<const T*, 8> operandsHolder(context.scratch());
+  const T** const operands = operandsHolder.get(maxDepth_);
+  for (auto begin = rows.begin(); begin < rows.end(); begin += kChunkSize) {
+    const auto numRows = std::min(kChunkSize, rows.end() - begin);
+    int32_t depth = 0;
+    for (const auto& instruction : program_) {
+      T* buffer = buffers + depth * kChunkSize;
+      if (instruction.op == Op::kInput) {
+        const auto& input = *decoded[instruction.input];
+        if (input.isIdentityMapping()) {
+          operands[depth++] = input.data<T>() + begin;
+          continue;
+        }
+        if (input.isConstantMapping()) {
+          std::fill(buffer, buffer + numRows, input.valueAt<T>(0));
+        } else {
+          for (auto i = 0; i < numRows; ++i) {
+            buffer[i] = rows.isValid(begin + i) ? input.valueAt<T>(begin + i)
+                                                : T();
+          }
+        }
+        operands[depth++] = buffer;
+        continue;
+      }
+
+      --depth;
+      buffer = buffers + (depth - 1) * kChunkSize;
+      const T* left = operands[depth - 1];
+      const T* right = operands[depth];
+      switch (instruction.op) {
+        case Op::kPlus:
+          for (auto i = 0; i < numRows; ++i) {
+            buffer[i] = left[i] + right[i];
+          }
+          break;
+        case Op::kMinus:
+          for (auto i = 0; i < numRows; ++i) {
+            buffer[i] = left[i] - right[i];
+          }
+          break;
+        case Op::kMultiply:
+          for (auto i = 0; i < numRows; ++i) {
+            buffer[i] = left[i] * right[i];
+          }
+          break;
+        default:
+          VELOX_UNREACHABLE();
+      }
+      operands[depth - 1] = buffer;
+    }
+    VELOX_DCHECK_EQ(depth, 1);
+
+    const T* values = operands[0];
+    if (rows.isAllSelected()) {
+      std::copy(values, values + numRows, rawResult + begin);
+    } else {
+      for (auto i = 0; i < numRows; ++i) {
+        if (rows.isValid(begin + i)) {
+          rawResult[begin + i] = values[i];
+        }
+      }
+    }
+  }
+}
+
+int32_t FusedArithmeticExpr::appendTree(
+    int32_t pc,
+    std::stringstream& out,
+    bool sql,
+    std::vector<VectorPtr>* complexConstants) const {
+  const auto& instruction = program_[pc];
+  if (instruction.op == Op::kInput) {
+    const auto& input = inputs_[instruction.input];
+    out << (sql ? input->toSql(complexConstants) : input->toString());
+    return pc;
+  }
+  // The right operand ends right before 'pc' and the left operand ends right
+  // before the right one.
+  std::stringstream right;
+  const auto rightBegin = appendTree(pc - 1, right, sql, complexConstants);
+  std::stringstream left;
+  const auto leftBegin =
+      appendTree(rightBegin - 1, left, sql, complexConstants);
+  if (sql) {
+    out << "\"" << instruction.name << "\"";
+  } else {
+    out << instruction.name;
+  }
+  out << "(" << left.str() << ", " << right.str() << ")";
+  return leftBegin;
+}
+
+std::string FusedArithmeticExpr::toString(bool recursive) const {
+  if (!recursive) {
+    return name();
+  }
+  std::stringstream out;
+  appendTree(program_.size() - 1, out, false, nullptr);
+  return out.str();
+}
+
+std::string FusedArithmeticExpr::toSql(
+    std::vector<VectorPtr>* complexConstants) const {
+  std::stringstream out;
+  appendTree(program_.size() - 1, out, true, complexConstants);
+  return out.str();
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+const char* const kFusedArithmetic = "fused_arithmetic";
+
+/// A tree of plus, minus and multiply of DOUBLE or REAL over columns and
+/// constants evaluated in one pass, see
+/// 'QueryConfig::kExprFusedArithmeticEnabled'. The tree is translated into a
+/// postfix program over the distinct columns and constants, which are the
+/// inputs of the expression. The program runs over chunks of 'kChunkSize'
+/// rows, so that the intermediate results stay in small buffers in the cache
+/// instead of a vector per function call. The functions have default null
+/// behavior and cannot fail over the floating point types, so the result is
+/// the same as for the function calls.
+class FusedArithmeticExpr : public SpecialForm {
+ public:
+  /// Returns the fused expression for a call of 'name' over 'inputs' of type
+  /// 'type', or nullptr if the call cannot be fused. 'inputs' are fused too if
+  /// they are FusedArithmeticExprs, and must be columns or constants
+  /// otherwise.
+  static ExprPtr tryFuse(
+      const std::string& name,
+      const TypePtr& type,
+      const std::vector<ExprPtr>& inputs,
+      bool trackCpuUsage);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  std::string toString(bool recursive = true) const override;
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override;
+
+  /// The number of rows of the intermediate results.
+  static constexpr vector_size_t kChunkSize = 256;
+
+ private:
+  enum class Op { kInput, kPlus, kMinus, kMultiply };
+
+  struct Instruction {
+    Op op;
+    // The index in 'inputs_' for kInput, 0 otherwise.
+    column_index_t input;
+    // The name of the function call for the other ops.
+    std::string name;
+  };
+
+  FusedArithmeticExpr(
+      TypePtr type,
+      std::vector<ExprPtr> inputs,
+      std::vector<Instruction> program,
+      bool supportsFlatNoNullsFastPath,
+      bool trackCpuUsage);
+
+  void computePropagatesNulls() override;
+
+  template <typename T>
+  void evalTyped(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& inputValues,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  // Appends the expression of the sub-tree that ends at 'program_[pc]' to
+  // 'out' and returns the index of the first instruction of the sub-tree.
+  int32_t appendTree(
+      int32_t pc,
+      std::stringstream& out,
+      bool sql,
+      std::vector<VectorPtr>* complexConstants) const;
+
+  const std::vector<Instruction> program_;
+
+  // The maximum number of intermediate results at a time in 'program_'.
+  const int32_t maxDepth_;
+};
+} // namespace facebook::velox::exec
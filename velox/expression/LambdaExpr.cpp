@@ -51,7 +51,7 @@ class ExprCallable : public Callable {
       const std::vector<VectorPtr>& args,
       const BufferPtr& elementToTopLevelRows,
       VectorPtr* result) override {
-    auto row = createRowVector(context, wrapCapture, args, rows.end());
+    auto row = createRowVector(context, wrapCapture, args, rows);
     EvalCtx lambdaCtx = createLambdaCtx(context, row, validRowsInReusedResult);
     ScopedVarSetter throwOnError(
         lambdaCtx.mutableThrowOnError(), context->throwOnError());
@@ -68,7 +68,7 @@ class ExprCallable : public Callable {
       const std::vector<VectorPtr>& args,
       EvalErrorsPtr& elementErrors,
       VectorPtr* result) override {
-    auto row = createRowVector(context, wrapCapture, args, rows.end());
+    auto row = createRowVector(context, wrapCapture, args, rows);
     EvalCtx lambdaCtx = createLambdaCtx(context, row, validRowsInReusedResult);
     ScopedVarSetter throwOnError(lambdaCtx.mutableThrowOnError(), false);
     resetSharedExprs();
@@ -114,15 +114,15 @@ class ExprCallable : public Callable {
       EvalCtx* context,
       const BufferPtr& wrapCapture,
       const std::vector<VectorPtr>& args,
-      vector_size_t size) {
+      const SelectivityVector& rows) {
     VELOX_CHECK_EQ(signature_->size(), args.size());
+    const auto size = rows.end();
     std::vector<VectorPtr> allVectors = args;
     for (auto index = args.size(); index < capture_->childrenSize(); ++index) {
       auto values = capture_->childAt(index);
       VELOX_DCHECK(!isLazyNotLoaded(*values));
       if (wrapCapture) {
-        values = BaseVector::wrapInDictionary(
-            BufferPtr(nullptr), wrapCapture, size, values);
+        values = alignCapture(values, wrapCapture, rows, context->pool());
       }
       allVectors.push_back(values);
     }
@@ -136,6 +136,27 @@ class ExprCallable : public Callable {
     return row;
   }
 
+  // Returns the captured 'values' for the rows of the lambda arguments.
+  // Constants are resized and flat vectors of fixed width types are gathered
+  // into flat vectors, so that a body over numeric arguments and captures
+  // reads flat or constant inputs. Other vectors are wrapped in a dictionary.
+  static VectorPtr alignCapture(
+      const VectorPtr& values,
+      const BufferPtr& wrapCapture,
+      const SelectivityVector& rows,
+      memory::MemoryPool* pool) {
+    if (values->isConstantEncoding()) {
+      return BaseVector::wrapInConstant(rows.end(), 0, values);
+    }
+    if (values->isFlatEncoding() && values->type()->isFixedWidth()) {
+      auto flat = BaseVector::create(values->type(), rows.end(), pool);
+      flat->copy(values.get(), rows, wrapCapture->as<vector_size_t>());
+      return flat;
+    }
+    return BaseVector::wrapInDictionary(
+        BufferPtr(nullptr), wrapCapture, rows.end(), values);
+  }
+
   RowTypePtr signature_;
   RowVectorPtr capture_;
   std::shared_ptr<Expr> body_;
@@ -155,7 +155,10 @@ bool PeeledEncoding::peelInternal(
       }
       nonConstant = true;
       auto encoding = leaf->encoding();
-      if (encoding == VectorEncoding::Simple::DICTIONARY) {
+      // A sequence vector is peeled like a dictionary, so that the runs are
+      // evaluated once.
+      if (encoding == VectorEncoding::Simple::DICTIONARY ||
+          encoding == VectorEncoding::Simple::SEQUENCE) {
         if (!canPeelsHaveNulls && leaf->rawNulls()) {
           // A dictionary that adds nulls over an Expr that is not null for a
           // null argument cannot be peeled.
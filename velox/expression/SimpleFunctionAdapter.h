@@ -19,6 +19,7 @@
 #include <exception>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <type_traits>
 
 #include "velox/common/base/Portability.h"
@@ -55,6 +56,31 @@ struct IsMapWriter<MapWriter<K, V>> {
   static constexpr bool value = true;
 };
 
+template <typename T>
+struct IsFlatOrConstantReader {
+  static constexpr bool value = false;
+};
+
+template <typename T>
+struct IsFlatOrConstantReader<FlatVectorReader<T>> {
+  static constexpr bool value = true;
+};
+
+template <typename T>
+struct IsFlatOrConstantReader<ConstantVectorReader<T>> {
+  static constexpr bool value = true;
+};
+
+template <typename T>
+struct IsConstantVectorReader {
+  static constexpr bool value = false;
+};
+
+template <typename T>
+struct IsConstantVectorReader<ConstantVectorReader<T>> {
+  static constexpr bool value = true;
+};
+
 template <class T, class = void>
 struct udf_reuse_strings_from_arg : std::integral_constant<int32_t, -1> {};
 
@@ -655,6 +681,13 @@ class SimpleFunctionAdapter : public VectorFunction {
           });
         }
       } else if (allNotNull) {
+        if constexpr (
+            FUNC::udf_has_callBatch &&
+            return_type_traits::typeKind != TypeKind::BOOLEAN &&
+            (IsFlatOrConstantReader<TReader>::value && ...)) {
+          applyCallBatch(applyContext, readers...);
+          return;
+        }
         if constexpr (FUNC::has_ascii) {
           if (applyContext.allAscii) {
             applyContext.applyToSelectedNoThrow([&](auto row) INLINE_LAMBDA {
@@ -748,6 +781,74 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
   }
 
+  // The maximum number of rows of a call of FUNC::callBatch().
+  static constexpr vector_size_t kMaxCallBatchSize = 1'024;
+
+  // The values of an argument of FUNC::callBatch(). A constant is repeated
+  // 'kMaxCallBatchSize' times, so that all the arguments are arrays.
+  template <typename TReader>
+  struct BatchArg {
+    using exec_in_t = typename TReader::exec_in_t;
+
+    explicit BatchArg(const TReader& _reader) : reader{_reader} {
+      if constexpr (IsConstantVectorReader<TReader>::value) {
+        constants.resize(
+            kMaxCallBatchSize, reader.value.value_or(exec_in_t{}));
+      }
+    }
+
+    // Returns the values of the rows starting at 'begin'.
+    const exec_in_t* at(vector_size_t begin) const {
+      if constexpr (IsConstantVectorReader<TReader>::value) {
+        return constants.data();
+      } else {
+        return reader.values + begin;
+      }
+    }
+
+    const TReader& reader;
+    std::vector<exec_in_t> constants;
+  };
+
+  // Calls FUNC::callBatch() for the runs of consecutive selected rows. Used
+  // only when all the arguments are flat or constant without nulls.
+  template <typename... TReader>
+  void applyCallBatch(ApplyContext& applyContext, const TReader&... readers)
+      const {
+    auto* out = applyContext.resultWriter.data_;
+    std::tuple<BatchArg<TReader>...> args{BatchArg<TReader>(readers)...};
+    auto callBatch = [&](vector_size_t begin, vector_size_t end) {
+      for (; begin < end; begin += kMaxCallBatchSize) {
+        const auto size = std::min(end - begin, kMaxCallBatchSize);
+        std::apply(
+            [&](const auto&... arg) {
+              (*fn_).callBatch(out + begin, arg.at(begin)..., size);
+            },
+            args);
+      }
+    };
+
+    const auto& rows = *applyContext.rows;
+    if (rows.isAllSelected()) {
+      callBatch(rows.begin(), rows.end());
+      return;
+    }
+    vector_size_t runBegin = -1;
+    vector_size_t runEnd = -1;
+    rows.applyToSelected([&](auto row) {
+      if (row != runEnd) {
+        if (runBegin >= 0) {
+          callBatch(runBegin, runEnd);
+        }
+        runBegin = row;
+      }
+      runEnd = row + 1;
+    });
+    if (runBegin >= 0) {
+      callBatch(runBegin, runEnd);
+    }
+  }
+
   template <typename Func>
   void applyUdf(ApplyContext& applyContext, Func func) const {
     applyContext.applyToSelectedNoThrow(
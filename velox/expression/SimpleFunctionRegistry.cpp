@@ -64,13 +64,17 @@ bool SimpleFunctionRegistry::registerFunctionInternal(
 
     functions.emplace_back(
         std::make_unique<const FunctionEntry>(metadata, factory));
+    clearResolvedFunctions();
     return true;
   });
 }
 
 void SimpleFunctionRegistry::removeFunction(const std::string& name) {
   const auto sanitizedName = sanitizeName(name);
-  registeredFunctions_.withWLock([&](auto& map) { map.erase(sanitizedName); });
+  registeredFunctions_.withWLock([&](auto& map) {
+    map.erase(sanitizedName);
+    clearResolvedFunctions();
+  });
 }
 
 namespace {
@@ -153,56 +157,94 @@ std::optional<SimpleFunctionRegistry::ResolvedSimpleFunction>
 SimpleFunctionRegistry::resolveFunction(
     const std::string& name,
     const std::vector<TypePtr>& argTypes) const {
+  std::string key = sanitizeName(name);
+  for (const auto& argType : argTypes) {
+    key.append(",");
+    key.append(argType->toString());
+  }
+
+  const auto resolved = registeredFunctions_.withRLock([&](const auto& map) {
+    if (auto cached = resolvedFunctions_.withRLock(
+            [&](const auto& resolvedMap) -> std::optional<ResolvedEntry> {
+              const auto it = resolvedMap.find(key);
+              if (it == resolvedMap.end()) {
+                return std::nullopt;
+              }
+              return it->second;
+            })) {
+      return cached.value();
+    }
+
+    auto entry = resolveFunctionUncached(name, argTypes, map);
+    resolvedFunctions_.withWLock([&](auto& resolvedMap) {
+      if (resolvedMap.size() >= kMaxResolvedFunctions) {
+        resolvedMap.clear();
+      }
+      resolvedMap.emplace(std::move(key), entry);
+    });
+    return entry;
+  });
+
+  return resolved.has_value()
+      ? std::optional<ResolvedSimpleFunction>(
+            ResolvedSimpleFunction(*resolved->first, resolved->second))
+      : std::nullopt;
+}
+
+// static
+SimpleFunctionRegistry::ResolvedEntry
+SimpleFunctionRegistry::resolveFunctionUncached(
+    const std::string& name,
+    const std::vector<TypePtr>& argTypes,
+    const FunctionMap& registeredFunctions) {
   const FunctionEntry* selectedCandidate = nullptr;
   TypePtr selectedCandidateType = nullptr;
-  registeredFunctions_.withRLock([&](const auto& map) {
-    if (const auto* signatureMap = getSignatureMap(name, map)) {
-      for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
-        SignatureBinder binder(candidateSignature, argTypes);
-        if (binder.tryBind()) {
-          for (const auto& currentCandidate : functionEntry) {
-            const auto& m = currentCandidate->getMetadata();
-
-            // For variadic signatures, number of arguments in function call may
-            // be one less than number of arguments in the signature.
-            const auto numArgsToMatch =
-                std::min(argTypes.size(), m.argPhysicalTypes().size());
-
-            bool match = true;
-            for (auto i = 0; i < numArgsToMatch; ++i) {
-              if (!physicalTypeMatches(argTypes[i], m.argPhysicalTypes()[i])) {
-                match = false;
-                break;
-              }
+  if (const auto* signatureMap = getSignatureMap(name, registeredFunctions)) {
+    for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
+      SignatureBinder binder(candidateSignature, argTypes);
+      if (binder.tryBind()) {
+        for (const auto& currentCandidate : functionEntry) {
+          const auto& m = currentCandidate->getMetadata();
+
+          // For variadic signatures, number of arguments in function call may
+          // be one less than number of arguments in the signature.
+          const auto numArgsToMatch =
+              std::min(argTypes.size(), m.argPhysicalTypes().size());
+
+          bool match = true;
+          for (auto i = 0; i < numArgsToMatch; ++i) {
+            if (!physicalTypeMatches(argTypes[i], m.argPhysicalTypes()[i])) {
+              match = false;
+              break;
             }
+          }
 
-            if (!match) {
-              continue;
-            }
+          if (!match) {
+            continue;
+          }
 
-            if (!selectedCandidate ||
-                currentCandidate->getMetadata().priority() <
-                    selectedCandidate->getMetadata().priority()) {
-              auto resultType = binder.tryResolveReturnType();
-              VELOX_CHECK_NOT_NULL(resultType);
+          if (!selectedCandidate ||
+              currentCandidate->getMetadata().priority() <
+                  selectedCandidate->getMetadata().priority()) {
+            auto resultType = binder.tryResolveReturnType();
+            VELOX_CHECK_NOT_NULL(resultType);
 
-              if (physicalTypeMatches(resultType, m.resultPhysicalType())) {
-                selectedCandidate = currentCandidate.get();
-                selectedCandidateType = resultType;
-              }
+            if (physicalTypeMatches(resultType, m.resultPhysicalType())) {
+              selectedCandidate = currentCandidate.get();
+              selectedCandidateType = resultType;
             }
           }
         }
       }
     }
-  });
+  }
 
   VELOX_DCHECK(!selectedCandidate || selectedCandidateType);
 
-  return selectedCandidate
-      ? std::optional<ResolvedSimpleFunction>(
-            ResolvedSimpleFunction(*selectedCandidate, selectedCandidateType))
-      : std::nullopt;
+  if (selectedCandidate == nullptr) {
+    return std::nullopt;
+  }
+  return std::make_pair(selectedCandidate, selectedCandidateType);
 }
 
 } // namespace facebook::velox::exec
@@ -106,7 +106,10 @@ class SimpleFunctionRegistry {
   }
 
   void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    registeredFunctions_.withWLock([&](auto& map) {
+      map.clear();
+      clearResolvedFunctions();
+    });
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -150,11 +153,34 @@ class SimpleFunctionRegistry {
     const TypePtr type_;
   };
 
+  /// Returns the function registered as 'name' that accepts 'argTypes'. The
+  /// result is cached per name and argument types until the registry changes,
+  /// so that compiling the same expressions again, e.g. for each driver of a
+  /// pipeline or for repeated queries, does not bind every signature again.
   std::optional<ResolvedSimpleFunction> resolveFunction(
       const std::string& name,
       const std::vector<TypePtr>& argTypes) const;
 
  private:
+  // Maximum number of entries in 'resolvedFunctions_'. The cache is cleared
+  // when full.
+  static constexpr size_t kMaxResolvedFunctions = 10'000;
+
+  // A function entry and its result type, or std::nullopt if no function
+  // accepts the argument types.
+  using ResolvedEntry = std::optional<std::pair<const FunctionEntry*, TypePtr>>;
+
+  // Binds 'argTypes' to the signatures of 'name' in 'registeredFunctions'.
+  static ResolvedEntry resolveFunctionUncached(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes,
+      const FunctionMap& registeredFunctions);
+
+  // Must be called while holding the write lock of 'registeredFunctions_'.
+  void clearResolvedFunctions() {
+    resolvedFunctions_.withWLock([](auto& map) { map.clear(); });
+  }
+
   template <typename T>
   static std::unique_ptr<T> CreateUdf() {
     return std::make_unique<T>();
@@ -173,6 +199,13 @@ class SimpleFunctionRegistry {
       bool overwrite);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  // Results of resolveFunction() keyed on the function name and the argument
+  // types. Entries are added while holding the read lock of
+  // 'registeredFunctions_' and cleared while holding its write lock, so they
+  // never refer to removed functions.
+  mutable folly::Synchronized<std::unordered_map<std::string, ResolvedEntry>>
+      resolvedFunctions_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
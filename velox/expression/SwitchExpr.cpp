@@ -15,6 +15,7 @@
  */
 #include "velox/expression/SwitchExpr.h"
 #include "velox/expression/BooleanMix.h"
+#include "velox/expression/CompactEval.h"
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/FieldReference.h"
 #include "velox/expression/ScopedVarSetter.h"
@@ -30,7 +31,8 @@ bool hasElseClause(const std::vector<ExprPtr>& inputs) {
 SwitchExpr::SwitchExpr(
     TypePtr type,
     const std::vector<ExprPtr>& inputs,
-    bool inputsSupportFlatNoNullsFastPath)
+    bool inputsSupportFlatNoNullsFastPath,
+    double sparseBranchMaxDensity)
     : SpecialForm(
           std::move(type),
           inputs,
@@ -38,7 +40,8 @@ SwitchExpr::SwitchExpr(
           hasElseClause(inputs) && inputsSupportFlatNoNullsFastPath,
           false /* trackCpuUsage */),
       numCases_{inputs_.size() / 2},
-      hasElseClause_{hasElseClause(inputs_)} {
+      hasElseClause_{hasElseClause(inputs_)},
+      sparseBranchMaxDensity_{sparseBranchMaxDensity} {
   std::vector<TypePtr> inputTypes;
   inputTypes.reserve(inputs_.size());
   std::transform(
@@ -115,7 +118,7 @@ void SwitchExpr::evalSpecialForm(
         nullptr);
     switch (booleanMix) {
       case BooleanMix::kAllTrue:
-        inputs_[2 * i + 1]->eval(*remainingRows.get(), context, localResult);
+        evalClause(2 * i + 1, *remainingRows.get(), context, localResult);
         remainingRows->clearAll();
         continue;
       case BooleanMix::kAllNull:
@@ -132,7 +135,7 @@ void SwitchExpr::evalSpecialForm(
         thenRows.get()->updateBounds();
 
         if (thenRows.get()->hasSelections()) {
-          inputs_[2 * i + 1]->eval(*thenRows.get(), context, localResult);
+          evalClause(2 * i + 1, *thenRows.get(), context, localResult);
           remainingRows.get()->deselect(*thenRows.get());
         }
       }
@@ -142,7 +145,8 @@ void SwitchExpr::evalSpecialForm(
   // Evaluate the "else" clause.
   if (remainingRows.get()->hasSelections()) {
     if (hasElseClause_) {
-      inputs_.back()->eval(*remainingRows.get(), context, localResult);
+      evalClause(
+          inputs_.size() - 1, *remainingRows.get(), context, localResult);
     } else {
       context.ensureWritable(*remainingRows.get(), type(), localResult);
 
@@ -171,6 +175,17 @@ void SwitchExpr::evalSpecialForm(
   context.moveOrCopyResult(localResult, rows, finalResult);
 }
 
+void SwitchExpr::evalClause(
+    int32_t index,
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  if (!tryEvalCompacted(
+          *inputs_[index], rows, sparseBranchMaxDensity_, context, result)) {
+    inputs_[index]->eval(rows, context, result);
+  }
+}
+
 // This is safe to call only after all metadata is computed for input
 // expressions.
 void SwitchExpr::computePropagatesNulls() {
@@ -275,11 +290,14 @@ ExprPtr SwitchCallToSpecialForm::constructSpecialForm(
     const TypePtr& type,
     std::vector<ExprPtr>&& compiledChildren,
     bool /* trackCpuUsage */,
-    const core::QueryConfig& /*config*/) {
+    const core::QueryConfig& config) {
   bool inputsSupportFlatNoNullsFastPath =
       Expr::allSupportFlatNoNullsFastPath(compiledChildren);
   return std::make_shared<SwitchExpr>(
-      type, std::move(compiledChildren), inputsSupportFlatNoNullsFastPath);
+      type,
+      std::move(compiledChildren),
+      inputsSupportFlatNoNullsFastPath,
+      config.exprSparseBranchMaxDensity());
 }
 
 TypePtr IfCallToSpecialForm::resolveType(const std::vector<TypePtr>& argTypes) {
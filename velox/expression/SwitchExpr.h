@@ -41,10 +41,13 @@ class SwitchExpr : public SpecialForm {
  public:
   /// Inputs are concatenated conditions and results with an optional "else" at
   /// the end, e.g. {condition1, result1, condition2, result2,..else}
+  /// 'sparseBranchMaxDensity' is the density of the rows under which a result
+  /// is evaluated over a dense copy of its inputs, see 'tryEvalCompacted()'.
   SwitchExpr(
       TypePtr type,
       const std::vector<ExprPtr>& inputs,
-      bool inputsSupportFlatNoNullsFastPath);
+      bool inputsSupportFlatNoNullsFastPath,
+      double sparseBranchMaxDensity = 0);
 
   void evalSpecialForm(
       const SelectivityVector& rows,
@@ -65,8 +68,16 @@ class SwitchExpr : public SpecialForm {
 
   void computePropagatesNulls() override;
 
+  // Evaluates the 'then' or 'else' clause 'inputs_[index]' on 'rows'.
+  void evalClause(
+      int32_t index,
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
   const size_t numCases_;
   const bool hasElseClause_;
+  const double sparseBranchMaxDensity_;
   BufferPtr tempValues_;
 
   friend class SwitchCallToSpecialForm;
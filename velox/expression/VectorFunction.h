@@ -290,6 +290,22 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes the expressions of an ExprSet and returns equivalent
+/// expressions, or an empty vector if re-write is not possible. Unlike
+/// ExpressionRewrite, it sees all the expressions at once, e.g. to replace the
+/// calls in different expressions with one common subexpression.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&,
+    const core::QueryConfig&)>;
+
+/// Returns a list of registered expression set re-writes.
+std::vector<ExpressionSetRewrite>& expressionSetRewrites();
+
+/// Appends a 'rewrite' to 'expressionSetRewrites'. The re-writes are applied
+/// in the order they were registered to the expressions of an ExprSet before
+/// they are compiled, each to the result of the previous one.
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
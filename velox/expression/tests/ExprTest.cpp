@@ -29,6 +29,7 @@
 #include "velox/expression/CoalesceExpr.h"
 #include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/expression/SwitchExpr.h"
 #include "velox/functions/Udf.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -457,6 +458,22 @@ TEST_P(ParameterizedExprTest, moreEncodings) {
   assertEqualVectors(expected, result);
 }
 
+TEST_P(ParameterizedExprTest, sequenceEncoding) {
+  const std::vector<std::optional<int64_t>> data{
+      1, 1, 1, std::nullopt, 2, 2, 2, 2, 3};
+  auto sequence = vectorMaker_.sequenceVector<int64_t>(data);
+
+  // The sequence vector is peeled, so that the expression is evaluated once
+  // per run, and the result is a dictionary over the results of the runs.
+  auto result = evaluate("c0 * 10 + 1", makeRowVector({sequence}));
+  ASSERT_EQ(VectorEncoding::Simple::DICTIONARY, result->encoding());
+  ASSERT_EQ(sequence->valueVector()->size(), result->valueVector()->size());
+
+  auto expected = makeNullableFlatVector<int64_t>(
+      {11, 11, 11, std::nullopt, 21, 21, 21, 21, 31});
+  assertEqualVectors(expected, result);
+}
+
 TEST_P(ParameterizedExprTest, reorder) {
   constexpr int32_t kTestSize = 20'000;
 
@@ -483,6 +500,36 @@ TEST_P(ParameterizedExprTest, reorder) {
   }
 }
 
+TEST_P(ParameterizedExprTest, reorderDeterministicOnly) {
+  constexpr int32_t kTestSize = 20'000;
+
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kTestSize, [](auto row) { return row; })});
+  // The cheapest and most selective input is after the non-deterministic one.
+  auto exprSet = compileExpression(
+      "if (c0 % 409 < 300 and rand() < 2.0 and c0 % 408 < 400 and c0 % 103 < 3, 1, 2)",
+      asRowType(data->type()));
+  for (auto i = 0; i < 2 * exec::ConjunctExpr::kSelectivityDecayInterval;
+       ++i) {
+    auto result = evaluate(exprSet.get(), data);
+    auto expectedResult = makeFlatVector<int64_t>(kTestSize, [](auto row) {
+      return (row % 409) < 300 && (row % 408) < 400 && (row % 103) < 3 ? 1
+                                                                       : 2;
+    });
+    assertEqualVectors(expectedResult, result);
+  }
+
+  auto condition = std::dynamic_pointer_cast<exec::ConjunctExpr>(
+      exprSet->expr(0)->inputs()[0]);
+  ASSERT_TRUE(condition != nullptr);
+  // The non-deterministic input stays second and the inputs after it are
+  // sorted.
+  ASSERT_EQ(condition->inputAt(0), condition->inputs()[0]);
+  ASSERT_EQ(condition->inputAt(1), condition->inputs()[1]);
+  ASSERT_EQ(condition->inputAt(2), condition->inputs()[3]);
+  ASSERT_EQ(condition->inputAt(3), condition->inputs()[2]);
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -1213,6 +1260,36 @@ TEST_P(ParameterizedExprTest, lazyVectors) {
   assertEqualVectors(expected, result);
 }
 
+// Tests that a struct field reference loads only the fields it reads.
+TEST_P(ParameterizedExprTest, lazyStructFields) {
+  const vector_size_t size = 1'000;
+  auto valueAt = [](auto row) { return row; };
+  auto a = vectorMaker_.lazyFlatVector<int64_t>(size, valueAt);
+  auto x = vectorMaker_.lazyFlatVector<int64_t>(size, valueAt);
+  auto y = vectorMaker_.lazyFlatVector<int64_t>(size, valueAt);
+  auto b = makeRowVector({"x", "y"}, {x, y});
+  auto structVector = makeRowVector({"a", "b"}, {a, b});
+  auto lazyStruct = std::make_shared<LazyVector>(
+      pool(),
+      structVector->type(),
+      size,
+      std::make_unique<SimpleVectorLoader>(
+          [&](auto /*rows*/) { return structVector; }));
+
+  // Only the field that is read is loaded.
+  auto result = evaluate("c0.b.x", makeRowVector({lazyStruct}));
+  assertEqualVectors(makeFlatVector<int64_t>(size, valueAt), result);
+  ASSERT_TRUE(lazyStruct->isLoaded());
+  ASSERT_TRUE(x->isLoaded());
+  ASSERT_FALSE(a->isLoaded());
+  ASSERT_FALSE(y->isLoaded());
+
+  // Loading the struct loads the remaining fields.
+  lazyStruct->loadedVector();
+  ASSERT_TRUE(a->isLoaded());
+  ASSERT_TRUE(y->isLoaded());
+}
+
 // Tests that lazy vectors are not loaded unnecessarily.
 TEST_P(ParameterizedExprTest, lazyLoading) {
   const vector_size_t size = 1'000;
@@ -4885,6 +4962,158 @@ TEST_F(ExprTest, disablePeeling) {
       execCtx.get()));
 }
 
+TEST_F(ExprTest, fusedArithmetic) {
+  const vector_size_t size = 1'000;
+  auto input = makeRowVector({
+      makeFlatVector<double>(size, [](auto row) { return row * 0.5; }),
+      makeFlatVector<double>(
+          size, [](auto row) { return row % 7; }, nullEvery(11)),
+      wrapInDictionary(
+          makeIndicesInReverse(size),
+          makeFlatVector<double>(size, [](auto row) { return row - 3; })),
+      makeFlatVector<float>(size, [](auto row) { return row * 0.25; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+  });
+  const std::vector<std::string> expressions = {
+      "c0 * c1 + c2 * c0 - c2",
+      "c0 * 2.5 - (c1 + c0)",
+      "c3 * c3 + c3",
+      "c0 * c1 + cast(c4 as double)",
+      "c4 * c4 + 1",
+  };
+
+  std::unordered_map<std::string, std::string> configData(
+      {{core::QueryConfig::kExprFusedArithmeticEnabled, "true"}});
+  auto queryCtx = velox::core::QueryCtx::create(
+      nullptr, core::QueryConfig(std::move(configData)));
+  auto execCtx = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx.get());
+
+  // Evaluates all the rows and every third row.
+  SelectivityVector someRows(size, false);
+  for (auto row = 0; row < size; row += 3) {
+    someRows.setValid(row, true);
+  }
+  someRows.updateBounds();
+  for (const auto& rows : {SelectivityVector(size), someRows}) {
+    auto expected = evaluateMultiple(expressions, input, rows);
+    auto results = evaluateMultiple(expressions, input, rows, execCtx.get());
+    for (auto i = 0; i < expressions.size(); ++i) {
+      SCOPED_TRACE(expressions[i]);
+      rows.applyToSelected([&](auto row) {
+        ASSERT_TRUE(expected[i]->equalValueAt(results[i].get(), row, row))
+            << "at " << row;
+      });
+    }
+  }
+  // The buffers of the intermediate results are kept for the next batch.
+  ASSERT_GT(execCtx->scratch().retainedSize(), 0);
+
+  std::vector<core::TypedExprPtr> typedExprs;
+  for (const auto& expression : expressions) {
+    typedExprs.push_back(parseExpression(expression, asRowType(input->type())));
+  }
+  exec::ExprSet exprSet(std::move(typedExprs), execCtx.get());
+  // The calls over columns and constants are fused. The calls over the cast
+  // and over BIGINT are not.
+  ASSERT_TRUE(exprSet.exprs()[0]->is<exec::FusedArithmeticExpr>());
+  ASSERT_EQ(
+      exprSet.exprs()[0]->toString(),
+      "minus(plus(multiply(c0, c1), multiply(c2, c0)), c2)");
+  ASSERT_TRUE(exprSet.exprs()[1]->is<exec::FusedArithmeticExpr>());
+  ASSERT_TRUE(exprSet.exprs()[2]->is<exec::FusedArithmeticExpr>());
+  ASSERT_FALSE(exprSet.exprs()[3]->is<exec::FusedArithmeticExpr>());
+  ASSERT_TRUE(
+      exprSet.exprs()[3]->inputs()[0]->is<exec::FusedArithmeticExpr>());
+  ASSERT_FALSE(exprSet.exprs()[4]->is<exec::FusedArithmeticExpr>());
+}
+
+TEST_F(ExprTest, sparseBranches) {
+  const vector_size_t size = 1'000;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          size,
+          [](auto row) { return fmt::format("string value {}", row); },
+          nullEvery(7)),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 3; }, nullEvery(97)),
+  });
+  // The 'then' clauses and the second arguments of coalesce select about one
+  // row in 50, the errors of the division are caught by try.
+  const std::vector<std::string> expressions = {
+      "if(c0 % 50 = 0, concat(c1, '!'), c1)",
+      "case when c0 % 50 = 1 then c0 * 2 when c0 % 3 = 0 then c0 + 1 end",
+      "coalesce(c2, c0 + 10)",
+      "try(if(c0 % 50 = 0, 10 / (c0 % 100), 0))",
+  };
+
+  std::unordered_map<std::string, std::string> configData(
+      {{core::QueryConfig::kExprSparseBranchMaxDensity, "0.1"}});
+  auto queryCtx = velox::core::QueryCtx::create(
+      nullptr, core::QueryConfig(std::move(configData)));
+  auto execCtx = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx.get());
+
+  // Evaluates all the rows and every third row.
+  SelectivityVector someRows(size, false);
+  for (auto row = 0; row < size; row += 3) {
+    someRows.setValid(row, true);
+  }
+  someRows.updateBounds();
+  for (const auto& rows : {SelectivityVector(size), someRows}) {
+    auto expected = evaluateMultiple(expressions, input, rows);
+    auto results = evaluateMultiple(expressions, input, rows, execCtx.get());
+    for (auto i = 0; i < expressions.size(); ++i) {
+      SCOPED_TRACE(expressions[i]);
+      rows.applyToSelected([&](auto row) {
+        ASSERT_TRUE(expected[i]->equalValueAt(results[i].get(), row, row))
+            << "at " << row;
+      });
+    }
+  }
+}
+
+TEST_F(ExprTest, profile) {
+  const vector_size_t size = 2'000;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      wrapInDictionary(
+          makeIndicesInReverse(size),
+          makeFlatVector<std::string>(
+              size,
+              [](auto row) { return std::string(row % 7, 'x'); },
+              nullEvery(5))),
+  });
+
+  std::unordered_map<std::string, std::string> configData(
+      {{core::QueryConfig::kExprProfileEnabled, "true"}});
+  auto queryCtx = velox::core::QueryCtx::create(
+      nullptr, core::QueryConfig(std::move(configData)));
+  auto execCtx = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx.get());
+
+  exec::ExprSet exprSet(
+      {parseExpression(
+          "c0 + 1 > 10 AND length(c1) < 5", asRowType(input->type()))},
+      execCtx.get());
+  exec::EvalCtx context(execCtx.get(), &exprSet, input.get());
+  std::vector<VectorPtr> result(1);
+  exprSet.eval(SelectivityVector(size), context, result);
+
+  const auto profile = exprSet.profile();
+  ASSERT_EQ(profile.at("and").numProfiledRows, size);
+  ASSERT_GT(profile.at("and").profileTiming.wallNanos, 0);
+  ASSERT_GT(profile.at("and").allocatedBytes, 0);
+  ASSERT_EQ(profile.at("and;gt;plus").numProfiledRows, size);
+  ASSERT_EQ(profile.at("and;gt;plus").numOutputRows, size);
+  // The second conjunct is evaluated on the rows that pass the first one and
+  // over the base of the dictionary.
+  ASSERT_EQ(profile.at("and;lt").numProfiledRows, size - 10);
+  ASSERT_EQ(profile.at("and;lt").numOutputRows, (size - 10) * 4 / 5);
+  ASSERT_EQ(profile.at("and;lt").numPeeled, 1);
+
+  const auto stacks = exprSet.profileToFoldedStacks();
+  ASSERT_NE(stacks.find("\nand;gt;plus "), std::string::npos) << stacks;
+}
+
 TEST_F(ExprTest, disableSharedSubExpressionReuse) {
   // Verify that shared subexpression reuse is disabled when the config is set
   // by confirming that the same rows are processed twice by the shared
@@ -4955,6 +5184,45 @@ TEST_F(ExprTest, disableMemoization) {
   ASSERT_EQ(stats["plus"].numProcessedRows, 3 * flatSize);
 }
 
+TEST_F(ExprTest, maxDictionaryMemoBytes) {
+  // Verify that the results memoized for a base shared by consecutive batches
+  // are dropped once they are larger than the limit.
+  auto flatInput = makeFlatVector<int64_t>({1, 2, 3});
+  auto flatSize = flatInput->size();
+  auto dictInput = wrapInDictionary(
+      makeIndices(2 * flatSize, [&](auto row) { return row % flatSize; }),
+      2 * flatSize,
+      flatInput);
+  auto inputRow = makeRowVector({dictInput});
+
+  auto evaluate = [&](const std::string& maxBytes) {
+    auto queryCtx = velox::core::QueryCtx::create(
+        nullptr,
+        core::QueryConfig(
+            {{core::QueryConfig::kMaxDictionaryMemoBytes, maxBytes}}));
+    auto execCtx =
+        std::make_unique<core::ExecCtx>(pool_.get(), queryCtx.get());
+    auto exprSet = compileExpression("c0 + 1", asRowType(inputRow->type()));
+    VectorPtr result;
+    std::unordered_map<std::string, exec::ExprStats> stats;
+    for (auto i = 0; i < 4; ++i) {
+      std::tie(result, stats) =
+          evaluateWithStats(exprSet.get(), inputRow, execCtx.get());
+      assertEqualVectors(
+          makeFlatVector<int64_t>(
+              2 * flatSize, [&](auto row) { return row % flatSize + 2; }),
+          result);
+    }
+    return stats["plus"].numProcessedRows;
+  };
+
+  // The first two batches compute the results and the others reuse them.
+  ASSERT_EQ(evaluate("1000000"), 2 * flatSize);
+  // The results are dropped after the second batch and computed for all the
+  // batches.
+  ASSERT_EQ(evaluate("1"), 4 * flatSize);
+}
+
 TEST_F(ExprTest, disabledeferredLazyLoading) {
   // Verify that deferred lazy loading is disabled when the config is set by
   // confirming that all rows are loaded even when only a subset is required.
@@ -282,6 +282,57 @@ TEST_F(ExprToSubfieldFilterTest, dereferenceWithEmptyField) {
   ASSERT_FALSE(filter);
 }
 
+TEST_F(ExprToSubfieldFilterTest, expressionFilter) {
+  const auto type = ROW({{"a", VARCHAR()}, {"b", BIGINT()}});
+  Subfield subfield;
+  auto filter = ExpressionFilter::create(
+      parseExpr("lower(a) = 'us'", type), evaluator(), subfield);
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_EQ(filter->kind(), FilterKind::kExpression);
+  ASSERT_FALSE(filter->testNull());
+  ASSERT_TRUE(filter->testBytes("US", 2));
+  ASSERT_TRUE(filter->testBytes("uS", 2));
+  ASSERT_FALSE(filter->testBytes("UK", 2));
+  // Cached result.
+  ASSERT_TRUE(filter->testBytes("US", 2));
+  ASSERT_TRUE(filter->testingEquals(*filter->clone()));
+
+  auto merged = filter->mergeWith(
+      std::make_unique<BytesValues>(std::vector<std::string>{"US", "UK"}, true)
+          .get());
+  ASSERT_EQ(merged->kind(), FilterKind::kExpression);
+  ASSERT_TRUE(merged->testBytes("US", 2));
+  ASSERT_FALSE(merged->testBytes("us", 2));
+  ASSERT_FALSE(merged->testBytes("UK", 2));
+  ASSERT_FALSE(merged->testNull());
+  ASSERT_TRUE(filter->testBytesRange("a", "z", false));
+  ASSERT_FALSE(merged->testBytesRange("a", "b", false));
+
+  // Nulls pass if the expression is true for null.
+  filter = ExpressionFilter::create(
+      parseExpr("coalesce(a, 'us') = 'us'", type), evaluator(), subfield);
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testNull());
+  ASSERT_FALSE(filter->testBytes("uk", 2));
+
+  // Values for which the expression fails pass.
+  filter = ExpressionFilter::create(
+      parseExpr("cast(a as bigint) > 10", type), evaluator(), subfield);
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testBytes("abc", 3));
+  ASSERT_TRUE(filter->testBytes("20", 2));
+  ASSERT_FALSE(filter->testBytes("5", 1));
+
+  // Expressions over other types or several columns are not supported.
+  ASSERT_FALSE(ExpressionFilter::create(
+      parseExpr("b % 3 = 1", type), evaluator(), subfield));
+  ASSERT_FALSE(ExpressionFilter::create(
+      parseExpr("length(a) + b > 3", type), evaluator(), subfield));
+  ASSERT_FALSE(ExpressionFilter::create(
+      parseExpr("lower(a)", type), evaluator(), subfield));
+}
+
 class CustomExprToSubfieldFilterParser : public ExprToSubfieldFilterParser {
  public:
   std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
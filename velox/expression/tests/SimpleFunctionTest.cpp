@@ -1145,6 +1145,63 @@ TEST_F(SimpleFunctionTest, callAscii) {
       "get_input_size(c0)", makeRowVector({asciiInput})));
 }
 
+template <typename T>
+struct BatchMultiplyFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  static inline int32_t numBatchRows{0};
+
+  void call(int64_t& out, const int64_t& a, const int64_t& b) {
+    out = a * b;
+  }
+
+  void callBatch(
+      int64_t* out,
+      const int64_t* a,
+      const int64_t* b,
+      vector_size_t size) {
+    for (auto i = 0; i < size; ++i) {
+      out[i] = a[i] * b[i];
+    }
+    numBatchRows += size;
+  }
+};
+
+TEST_F(SimpleFunctionTest, callBatch) {
+  registerFunction<BatchMultiplyFunction, int64_t, int64_t, int64_t>(
+      {"batch_multiply"});
+  auto& numBatchRows = BatchMultiplyFunction<exec::VectorExec>::numBatchRows;
+  const vector_size_t size = 3'000;
+  auto a = makeFlatVector<int64_t>(size, [](auto row) { return row; });
+  auto b = makeFlatVector<int64_t>(size, [](auto row) { return row % 7; });
+
+  // Flat arguments.
+  numBatchRows = 0;
+  auto result = evaluate("batch_multiply(c0, c1)", makeRowVector({a, b}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, [](auto row) { return row * (row % 7); }),
+      result);
+  EXPECT_EQ(numBatchRows, size);
+
+  // A constant argument.
+  numBatchRows = 0;
+  result = evaluate("batch_multiply(c0, 3)", makeRowVector({a}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 3; }), result);
+  EXPECT_EQ(numBatchRows, size);
+
+  // The runs of rows between the nulls.
+  numBatchRows = 0;
+  auto nullable = makeFlatVector<int64_t>(
+      size, [](auto row) { return row; }, nullEvery(5));
+  result = evaluate("batch_multiply(c0, c1)", makeRowVector({nullable, b}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * (row % 7); }, nullEvery(5)),
+      result);
+  EXPECT_EQ(numBatchRows, size - size / 5);
+}
+
 // Return false always.
 template <typename T>
 struct GenericOutputFunc {
@@ -1216,6 +1273,42 @@ TEST_F(SimpleFunctionTest, simpleFunctionRegistryThreadSafe) {
   }
 }
 
+template <typename T>
+struct ResolveCacheFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  template <typename TInput>
+  void call(int64_t& out, const TInput& /*input*/) {
+    out = 1;
+  }
+};
+
+// Test that the cached results of resolveFunction follow registrations and
+// removals.
+TEST_F(SimpleFunctionTest, resolveFunctionCache) {
+  const std::string name = "resolve_cache_test";
+  registerFunction<ResolveCacheFunction, int64_t, int64_t>({name});
+
+  for (auto i = 0; i < 2; ++i) {
+    auto resolved = exec::simpleFunctions().resolveFunction(name, {BIGINT()});
+    ASSERT_TRUE(resolved.has_value());
+    ASSERT_EQ(*resolved->type(), *BIGINT());
+    ASSERT_FALSE(exec::simpleFunctions()
+                     .resolveFunction(name, {VARCHAR()})
+                     .has_value());
+  }
+
+  registerFunction<ResolveCacheFunction, int64_t, Varchar>({name});
+  ASSERT_TRUE(
+      exec::simpleFunctions().resolveFunction(name, {VARCHAR()}).has_value());
+
+  exec::mutableSimpleFunctions().removeFunction(name);
+  ASSERT_FALSE(
+      exec::simpleFunctions().resolveFunction(name, {BIGINT()}).has_value());
+  ASSERT_FALSE(
+      exec::simpleFunctions().resolveFunction(name, {VARCHAR()}).has_value());
+}
+
 TEST_F(SimpleFunctionTest, flatNoNullsPathCallNullFree) {
   // Void return type.
   testCallNullFreeSupportFlatNotNulls<Map<int32_t, int32_t>>(true, false);
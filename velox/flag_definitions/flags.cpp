@@ -57,6 +57,8 @@ DEFINE_bool(avx2, true, "Enables use of AVX2 when available");
 
 DEFINE_bool(bmi2, true, "Enables use of BMI2 when available");
 
+DEFINE_bool(avx512, true, "Enables use of AVX-512 when available");
+
 // Used in exec/Expr.cpp
 
 DEFINE_string(
@@ -127,11 +129,32 @@ DEFINE_int32(
 
 DEFINE_bool(velox_ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 
+DEFINE_int32(
+    velox_ssd_max_parallel_reads,
+    8,
+    "Maximum number of coalesced reads of one SSD cache load in flight at a "
+    "time. The reads past the first are issued on the SSD executor");
+
 DEFINE_bool(
     velox_ssd_verify_write,
     false,
     "Read back data after writing to SSD");
 
+// Used in dwio/common/BufferedInput.cpp and DirectBufferedInput.cpp
+DEFINE_bool(
+    velox_adaptive_io_coalesce,
+    false,
+    "Choose the distance under which the reads of nearby ranges are merged "
+    "from the measured latency and throughput of the file system instead of "
+    "the configured maximum coalesce distance");
+
+// Used in /connectors/hive/iceberg
+DEFINE_int64(
+    velox_iceberg_delete_cache_bytes,
+    128 << 20,
+    "The size of each of the process wide caches of the deletion vectors and "
+    "equality deletes read from Iceberg delete files. 0 disables the caches");
+
 // Used in /connectors/tpch
 DEFINE_int32(
     velox_tpch_text_pool_size_mb,
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <queue>
 #include <type_traits>
@@ -307,6 +308,40 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(const T* values, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  const auto [minIt, maxIt] = std::minmax_element(values, values + count, C());
+  if (n_ == 0) {
+    minValue_ = *minIt;
+    maxValue_ = *maxIt;
+  } else {
+    minValue_ = std::min(minValue_, *minIt, C());
+    maxValue_ = std::max(maxValue_, *maxIt, C());
+  }
+  VELOX_DCHECK_GT(k_, 0);
+  size_t i = 0;
+  // See doInsert().
+  for (; i < count && items_.size() < k_ && numLevels() == 1; ++i) {
+    items_.push_back(values[i]);
+    ++levels_[1];
+  }
+  while (i < count) {
+    // Compacts if level zero is full, then fills the slots below level zero.
+    items_[insertPosition()] = values[i++];
+    const auto numCopied = std::min<size_t>(levels_[0], count - i);
+    levels_[0] -= numCopied;
+    // Reversed like the positions insertPosition() returns, so that the
+    // sketch is the same as with one insert() per value.
+    std::reverse_copy(values + i, values + i + numCopied, &items_[levels_[0]]);
+    i += numCopied;
+  }
+  n_ += count;
+  isLevelZeroSorted_ = false;
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
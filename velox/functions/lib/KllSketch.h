@@ -82,6 +82,11 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add 'count' new values to the sketch. Same as calling insert() for each
+  /// value, but copies the values into the free space of level zero in bulk
+  /// and compacts only when level zero is full.
+  void insert(const T* values, size_t count);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
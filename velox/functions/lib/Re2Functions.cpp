@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/vector/FunctionVector.h"
 
@@ -671,12 +672,23 @@ bool matchSuffixPattern(
           length) == 0;
 }
 
+// Returns the position of the first occurrence of 'needle' in the 'size'
+// bytes at 'data' or std::string::npos. Compares the first and the last byte
+// of 'needle' with a SIMD width of positions at a time.
+size_t findSubstring(const char* data, size_t size, const std::string& needle) {
+  if (needle.size() == 1) {
+    const auto* found = static_cast<const char*>(
+        std::memchr(data, needle[0], size));
+    return found == nullptr ? std::string::npos : found - data;
+  }
+  return simd::simdStrstr(data, size, needle.data(), needle.size());
+}
+
 bool matchSubstringPattern(
     const StringView& input,
     const std::string& fixedPattern) {
-  return (
-      std::string_view(input).find(std::string_view(fixedPattern)) !=
-      std::string::npos);
+  return findSubstring(input.data(), input.size(), fixedPattern) !=
+      std::string::npos;
 }
 
 bool matchSubstringsPattern(
@@ -684,9 +696,7 @@ bool matchSubstringsPattern(
     const std::vector<std::string>& patterns) {
   const char* data = input.data();
   for (int i = 0; i < patterns.size(); i++) {
-    auto curPos =
-        std::string_view(data, input.end() - data)
-            .find(std::string_view(patterns[i].c_str(), patterns[i].size()));
+    auto curPos = findSubstring(data, input.end() - data, patterns[i]);
     if (curPos == std::string::npos) {
       return false;
     }
@@ -942,8 +952,7 @@ class LikeGeneric final : public exec::VectorFunction {
     auto applyRow = [&](const StringView& input,
                         const StringView& pattern,
                         const std::optional<char>& escapeChar) -> bool {
-      PatternMetadata patternMetadata =
-          determinePatternKind(std::string_view(pattern), escapeChar);
+      const auto& patternMetadata = findOrParsePattern(pattern, escapeChar);
 
       if (isAscii) {
         switch (patternMetadata.patternKind()) {
@@ -965,6 +974,9 @@ class LikeGeneric final : public exec::VectorFunction {
           case PatternKind::kSubstring:
             return OptimizedLike<PatternKind::kSubstring>::match<
                 /*isAscii*/ true>(input, patternMetadata);
+          case PatternKind::kSubstrings:
+            return OptimizedLike<PatternKind::kSubstrings>::match<
+                /*isAscii*/ true>(input, patternMetadata);
           default:
             return applyWithRegex(input, pattern, escapeChar);
         }
@@ -988,6 +1000,9 @@ class LikeGeneric final : public exec::VectorFunction {
           case PatternKind::kSubstring:
             return OptimizedLike<PatternKind::kSubstring>::match<
                 /*isAscii*/ false>(input, patternMetadata);
+          case PatternKind::kSubstrings:
+            return OptimizedLike<PatternKind::kSubstrings>::match<
+                /*isAscii*/ false>(input, patternMetadata);
           default:
             return applyWithRegex(input, pattern, escapeChar);
         }
@@ -1028,6 +1043,40 @@ class LikeGeneric final : public exec::VectorFunction {
   }
 
  private:
+  // Returns the metadata of 'pattern'. The metadata of up to
+  // 'maxCompiledRegexes_' patterns is kept across batches, so that repeated
+  // patterns are parsed once, which allows to also look for the patterns of
+  // several substrings like '%foo%bar%'. The metadata of the other patterns
+  // is parsed for each row.
+  const PatternMetadata& findOrParsePattern(
+      const StringView& pattern,
+      std::optional<char> escapeChar) const {
+    auto key = std::pair<std::string, std::optional<char>>{pattern, escapeChar};
+    auto it = patterns_.find(key);
+    if (it != patterns_.end()) {
+      return it->second;
+    }
+    if (patterns_.size() >= maxCompiledRegexes_) {
+      uncachedPattern_ =
+          determinePatternKind(std::string_view(pattern), escapeChar);
+      return uncachedPattern_;
+    }
+    auto patternMetadata = PatternMetadata::generic();
+    if (!escapeChar.has_value()) {
+      auto substrings =
+          PatternMetadata::parseSubstrings(std::string_view(pattern));
+      if (!substrings.empty()) {
+        patternMetadata = PatternMetadata::substrings(std::move(substrings));
+      }
+    }
+    if (patternMetadata.patternKind() == PatternKind::kGeneric) {
+      patternMetadata =
+          determinePatternKind(std::string_view(pattern), escapeChar);
+    }
+    return patterns_.emplace(std::move(key), std::move(patternMetadata))
+        .first->second;
+  }
+
   RE2* findOrCompileRegex(
       const StringView& pattern,
       std::optional<char> escapeChar) const {
@@ -1066,6 +1115,11 @@ class LikeGeneric final : public exec::VectorFunction {
       std::pair<std::string, std::optional<char>>,
       std::unique_ptr<RE2>>
       compiledRegularExpressions_;
+  mutable folly::F14FastMap<
+      std::pair<std::string, std::optional<char>>,
+      PatternMetadata>
+      patterns_;
+  mutable PatternMetadata uncachedPattern_{PatternMetadata::generic()};
   int64_t maxCompiledRegexes_;
 };
 
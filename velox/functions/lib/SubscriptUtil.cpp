@@ -104,6 +104,11 @@ VectorPtr applyMapTyped(
   auto rawSizes = baseMap->rawSizes();
   auto rawOffsets = baseMap->rawOffsets();
 
+  // The position in its map of the last key found without caching. The maps
+  // with the same keys in the same order, e.g. the maps of a flat map column,
+  // have the key at this position, which is checked before the search.
+  vector_size_t lastPosition = 0;
+
   // Lambda that does the search for a key, for each row.
   auto processRow = [&](vector_size_t row, TKey searchKey) {
     size_t mapIndex = mapIndices[row];
@@ -134,12 +139,20 @@ VectorPtr applyMapTyped(
         found = true;
       }
 
+    } else if (
+        lastPosition < size &&
+        isPrimitiveEqual<TKey>(
+            decodedMapKeys->valueAt<TKey>(offsetStart + lastPosition),
+            searchKey)) {
+      rawIndices[row] = offsetStart + lastPosition;
+      found = true;
     } else {
       // Search map without caching.
       for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
         if (isPrimitiveEqual<TKey>(
                 decodedMapKeys->valueAt<TKey>(offset), searchKey)) {
           rawIndices[row] = offset;
+          lastPosition = offset - offsetStart;
           found = true;
           break;
         }
@@ -15,6 +15,7 @@
  */
 #include "velox/functions/lib/Utf8Utils.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 
 namespace facebook::velox::functions {
@@ -221,4 +222,33 @@ void replaceInvalidUTF8Characters(
   out.resize(outputIndex);
 }
 
+int64_t validUtf8Prefix(const char* input, int64_t size) {
+  using Batch = xsimd::batch<uint8_t>;
+  const auto* bytes = reinterpret_cast<const uint8_t*>(input);
+  const auto highBit = Batch::broadcast(0x80);
+  int64_t pos = 0;
+  while (pos < size) {
+    if (pos + Batch::size <= size) {
+      const auto nonAscii =
+          simd::toBitMask(Batch::load_unaligned(bytes + pos) >= highBit);
+      if (nonAscii == 0) {
+        pos += Batch::size;
+        continue;
+      }
+      pos += __builtin_ctz(nonAscii);
+    } else if (IS_ASCII(bytes[pos])) {
+      ++pos;
+      continue;
+    }
+    int32_t codePoint;
+    const auto charLength =
+        tryGetUtf8CharLength(input + pos, size - pos, codePoint);
+    if (charLength < 0) {
+      return pos;
+    }
+    pos += charLength;
+  }
+  return pos;
+}
+
 } // namespace facebook::velox::functions
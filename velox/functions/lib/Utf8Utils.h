@@ -57,6 +57,12 @@ namespace facebook::velox::functions {
 int32_t
 tryGetUtf8CharLength(const char* input, int64_t size, int32_t& codePoint);
 
+/// Returns the number of bytes at the beginning of 'input' that are valid
+/// UTF-8, i.e. 'size' if all of 'input' is valid. The runs of ASCII bytes are
+/// skipped a SIMD batch at a time, so that mostly ASCII strings are validated
+/// at about the speed of checking them for ASCII.
+int64_t validUtf8Prefix(const char* input, int64_t size);
+
 /// Return the length in byte of the next UTF-8 encoded character at the
 /// beginning of `string`. If the beginning of `string` is not valid UTF-8
 /// encoding, return -1.
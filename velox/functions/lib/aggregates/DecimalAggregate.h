@@ -18,6 +18,7 @@
 
 #include "velox/common/base/IOUtils.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/type/DecimalUtil.h"
 #include "velox/type/HugeInt.h"
 #include "velox/vector/FlatVector.h"
 
@@ -137,31 +138,15 @@ class DecimalAggregate : public exec::Aggregate {
       });
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
-      LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
-      accumulator.count = rows.countSelected();
-      std::vector<char> rawData(LongDecimalWithOverflowState::serializedSize());
-      StringView serialized(
-          rawData.data(), LongDecimalWithOverflowState::serializedSize());
-      accumulator.serialize(serialized);
-      mergeAccumulators<false>(group, serialized);
+      DecimalBatchSum batchSum;
+      rows.applyToSelected([&](vector_size_t i) { batchSum.add(data[i]); });
+      updateNonNullValues<false>(group, batchSum, rows.countSelected());
     } else {
-      LongDecimalWithOverflowState accumulator;
+      DecimalBatchSum batchSum;
       rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum,
-            decodedRaw_.valueAt<TInputType>(i),
-            accumulator.sum);
+        batchSum.add(decodedRaw_.valueAt<TInputType>(i));
       });
-      accumulator.count = rows.countSelected();
-      std::vector<char> rawData(LongDecimalWithOverflowState::serializedSize());
-      StringView serialized(
-          rawData.data(), LongDecimalWithOverflowState::serializedSize());
-      accumulator.serialize(serialized);
-      mergeAccumulators(group, serialized);
+      updateNonNullValues(group, batchSum, rows.countSelected());
     }
   }
 
@@ -317,6 +302,19 @@ class DecimalAggregate : public exec::Aggregate {
     accumulator->count += 1;
   }
 
+  template <bool tableHasNulls = true>
+  void updateNonNullValues(
+      char* group,
+      const DecimalBatchSum& batchSum,
+      int64_t count) {
+    if constexpr (tableHasNulls) {
+      exec::Aggregate::clearNull(group);
+    }
+    auto accumulator = decimalAccumulator(group);
+    accumulator->overflow += batchSum.addTo(accumulator->sum);
+    accumulator->count += count;
+  }
+
  protected:
   void initializeNewGroupsInternal(
       char** groups,
@@ -80,6 +80,62 @@ class SumAggregateBase
     updateInternal<TAccumulator, TAccumulator>(groups, rows, args, mayPushdown);
   }
 
+  bool supportsDenseAccumulators() const override {
+    return true;
+  }
+
+  void addDenseRawInput(
+      const uint64_t* groupNumbers,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      char* accumulators,
+      uint64_t* nonNulls) override {
+    auto* sums = reinterpret_cast<TAccumulator*>(accumulators);
+    auto addValue = [&](vector_size_t i, TAccumulator value) {
+      const auto groupNumber = groupNumbers[i];
+      updateSingleValue<TAccumulator>(sums[groupNumber], value);
+      bits::setBit(nonNulls, groupNumber);
+    };
+    DecodedVector decoded(*args[0], rows);
+    if (decoded.isConstantMapping()) {
+      if (!decoded.isNullAt(0)) {
+        const TAccumulator value(decoded.valueAt<TInput>(0));
+        rows.applyToSelected([&](vector_size_t i) { addValue(i, value); });
+      }
+    } else if (decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          addValue(i, TAccumulator(decoded.valueAt<TInput>(i)));
+        }
+      });
+    } else if (decoded.isIdentityMapping()) {
+      const auto* data = decoded.data<TInput>();
+      rows.applyToSelected(
+          [&](vector_size_t i) { addValue(i, TAccumulator(data[i])); });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) {
+        addValue(i, TAccumulator(decoded.valueAt<TInput>(i)));
+      });
+    }
+  }
+
+  void mergeDenseAccumulators(
+      char** groups,
+      int32_t numGroups,
+      const char* accumulators,
+      const uint64_t* nonNulls) override {
+    const auto* sums = reinterpret_cast<const TAccumulator*>(accumulators);
+    bits::forEachSetBit(nonNulls, 0, numGroups, [&](int32_t i) {
+      auto* group = groups[i];
+      if (group == nullptr) {
+        return;
+      }
+      exec::Aggregate::clearNull(group);
+      updateSingleValue<TAccumulator>(
+          *exec::Aggregate::value<TAccumulator>(group), sums[i]);
+    });
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
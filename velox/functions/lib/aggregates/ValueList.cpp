@@ -88,18 +88,75 @@ void ValueList::appendValue(
   }
 }
 
+template <typename ForEach>
+void ValueList::appendBatch(ForEach forEach, HashStringAllocator* allocator) {
+  static const exec::ContainerRowSerdeOptions options{};
+  std::optional<ByteOutputStream> stream;
+  int64_t initialSize{0};
+  const auto finishData = [&]() {
+    if (stream.has_value()) {
+      bytes_ += stream->size() - initialSize;
+      dataCurrent_ =
+          allocator->finishWrite(*stream, std::clamp(bytes_ / 2, 24, 1024))
+              .second;
+      stream.reset();
+    }
+  };
+
+  forEach([&](const BaseVector* values, vector_size_t index) {
+    if (size_ && size_ % 64 == 0) {
+      // prepareAppend() writes to the 'nulls' allocation, which cannot be
+      // done while the write to the 'data' allocation is open.
+      finishData();
+    }
+    prepareAppend(allocator);
+    if (values == nullptr) {
+      lastNulls_ |= 1UL << (size_ % 64);
+    } else {
+      if (!stream.has_value()) {
+        stream.emplace(allocator);
+        allocator->extendWrite(dataCurrent_, *stream);
+        // The stream may have a tail of a previous write.
+        initialSize = stream->size();
+      }
+      exec::ContainerRowSerde::serialize(*values, index, *stream, options);
+    }
+    ++size_;
+  });
+  finishData();
+}
+
 void ValueList::appendRange(
     const VectorPtr& vector,
     vector_size_t offset,
     vector_size_t size,
     HashStringAllocator* allocator) {
-  for (auto index = offset; index < offset + size; ++index) {
-    if (vector->isNullAt(index)) {
-      appendNull(allocator);
-    } else {
-      appendNonNull(*vector, index, allocator);
-    }
-  }
+  appendBatch(
+      [&](auto append) {
+        for (auto index = offset; index < offset + size; ++index) {
+          append(vector->isNullAt(index) ? nullptr : vector.get(), index);
+        }
+      },
+      allocator);
+}
+
+void ValueList::appendValues(
+    const DecodedVector& decoded,
+    const SelectivityVector& rows,
+    bool ignoreNulls,
+    HashStringAllocator* allocator) {
+  const auto* base = decoded.base();
+  appendBatch(
+      [&](auto append) {
+        rows.applyToSelected([&](vector_size_t row) {
+          if (!decoded.isNullAt(row)) {
+            append(base, decoded.index(row));
+          } else if (!ignoreNulls) {
+            append(nullptr, 0);
+          }
+        });
+      },
+      allocator);
 }
 
 ValueListReader::ValueListReader(ValueList& values)
@@ -53,6 +53,14 @@ class ValueList {
       vector_size_t size,
       HashStringAllocator* allocator);
 
+  /// Appends the values of 'decoded' in 'rows'. Skips the nulls if
+  /// 'ignoreNulls' is true. Faster than calling appendValue() for each row.
+  void appendValues(
+      const DecodedVector& decoded,
+      const SelectivityVector& rows,
+      bool ignoreNulls,
+      HashStringAllocator* allocator);
+
   int32_t size() const {
     return size_;
   }
@@ -95,6 +103,13 @@ class ValueList {
 
   void prepareAppend(HashStringAllocator* allocator);
 
+  // Appends the values 'forEach' passes to its callback as (vector, index)
+  // pairs, a null vector for a null value. Writes the non-null values of up to
+  // 64 consecutive appends, i.e. until the next word of null flags, in one
+  // write to the 'data' allocation.
+  template <typename ForEach>
+  void appendBatch(ForEach forEach, HashStringAllocator* allocator);
+
   // Writes lastNulls_ word to the 'nulls' block.
   void writeLastNulls(HashStringAllocator* allocator);
 
@@ -72,6 +72,26 @@ class ValueListTest : public functions::test::FunctionBaseTest {
 
       assertEqualVectors(data, result);
     }
+
+    // Use ValueList::appendValues after a few appendValue calls, so that the
+    // batch does not start at a word of null flags.
+    {
+      DecodedVector decoded(*data);
+      aggregate::ValueList values;
+      const auto numSingle = std::min<vector_size_t>(size, 3);
+      for (auto i = 0; i < numSingle; i++) {
+        values.appendValue(decoded, i, allocator());
+      }
+      SelectivityVector rows(size);
+      rows.setValidRange(0, numSingle, false);
+      rows.updateBounds();
+      values.appendValues(decoded, rows, false, allocator());
+
+      ASSERT_EQ(size, values.size());
+      auto result = read(values, data->type(), size);
+
+      assertEqualVectors(data, result);
+    }
   }
 
   HashStringAllocator* allocator() {
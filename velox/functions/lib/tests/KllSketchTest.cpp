@@ -110,6 +110,31 @@ TEST_F(KllSketchTest, estimationMode) {
   }
 }
 
+TEST_F(KllSketchTest, insertBatches) {
+  constexpr int N = 1e5;
+  constexpr int M = 1001;
+  std::vector<double> values(N);
+  KllSketch<double> expected(kDefaultK, {}, 0);
+  insertRandomData(0, N, expected, values.data());
+  expected.finish();
+
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  std::default_random_engine gen(1);
+  for (int i = 0; i < N;) {
+    const int count = std::min<int>(gen() % 1'000, N - i);
+    kll.insert(values.data() + i, count);
+    i += count;
+  }
+  EXPECT_EQ(kll.totalCount(), N);
+  kll.finish();
+
+  // The values are compacted at the same points with the same random bits.
+  auto q = linspace(M);
+  EXPECT_EQ(
+      kll.estimateQuantiles(folly::Range(q.begin(), q.end())),
+      expected.estimateQuantiles(folly::Range(q.begin(), q.end())));
+}
+
 TEST_F(KllSketchTest, randomInput) {
   constexpr int N = 1e5;
   constexpr int M = 1001;
@@ -951,6 +951,40 @@ TEST_F(Re2FunctionsTest, likeSubstringPattern) {
       true);
 }
 
+TEST_F(Re2FunctionsTest, likeSubstringsPattern) {
+  testLike("abcde", "%a%c%e%", true);
+  testLike("abcde", "%ab%de%", true);
+  testLike("abcde", "%%b%%d%%", true);
+  testLike("abababab", "%ab%ab%ab%ab%", true);
+  testLike("abcde", "%c%a%", false);
+  testLike("abcde", "%abc%cd%", false);
+  testLike("ababab", "%ab%ab%ab%ab%", false);
+  testLike("", "%a%b%", false);
+  testLike("\nab\ncd\n", "%\nab%cd\n%", true);
+
+  // Substrings longer than a SIMD width.
+  std::string input = generateString("abcdefghijklmnopqrstuvwxyz", 70);
+  testLike(input + input, fmt::format("%{}%{}%", input, input), true);
+  testLike(input, fmt::format("%{}%{}%", input, input), false);
+
+  // Non-constant patterns repeat across the rows.
+  auto result = evaluate(
+      "like(c0, c1)",
+      makeRowVector({
+          makeFlatVector<std::string>(
+              {"foobar", "barfoo", "foo bar", "foo", "xbarx", "foo_bar"}),
+          makeFlatVector<std::string>(
+              {"%foo%bar%",
+               "%foo%bar%",
+               "%foo%bar%",
+               "%foo%bar%",
+               "%bar%",
+               "%foo%bar%"}),
+      }));
+  assertEqualVectors(
+      makeFlatVector<bool>({true, false, true, false, true, true}), result);
+}
+
 TEST_F(Re2FunctionsTest, nullConstantPatternOrEscape) {
   // Test null pattern.
   ASSERT_TRUE(
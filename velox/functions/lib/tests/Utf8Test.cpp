@@ -104,6 +104,29 @@ TEST(Utf8Test, tryCharLength) {
   ASSERT_EQ(-1, tryCharLength({0xBF}));
 }
 
+TEST(Utf8Test, validUtf8Prefix) {
+  auto prefix = [](const std::string& input) {
+    return validUtf8Prefix(input.data(), input.size());
+  };
+
+  EXPECT_EQ(0, prefix(""));
+  EXPECT_EQ(5, prefix("hello"));
+  EXPECT_EQ(11, prefix("hello \u00e9\u4e16"));
+  EXPECT_EQ(6, prefix("hello \xBF world"));
+  EXPECT_EQ(6, prefix("hello \xe0\x94\x83 world"));
+
+  // Long ASCII runs before and after the non-ASCII bytes, so that these are
+  // found in the middle of a batch and in the bytes after the last batch.
+  const std::string ascii(100, 'a');
+  EXPECT_EQ(205, prefix(ascii + "\u00e9" + ascii + "\u4e16"));
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, prefix(ascii.substr(0, i) + "\xBF" + ascii));
+    EXPECT_EQ(100 + i, prefix(ascii + ascii.substr(0, i) + "\xBF"));
+  }
+  // A truncated character at the end.
+  EXPECT_EQ(100, prefix(ascii + "\xe4\xb8"));
+}
+
 TEST(UTF8Test, replaceInvalidUTF8Characters) {
   auto testReplaceInvalidUTF8Chars = [](const std::string& input,
                                         const std::string& expected) {
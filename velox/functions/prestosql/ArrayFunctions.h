@@ -776,39 +776,26 @@ struct ArrayTopNFunction {
       }
     };
 
-    // Define min-heap to store the top n elements.
-    std::priority_queue<
-        typename TInput::element_t,
-        std::vector<typename TInput::element_t>,
-        GreaterThanComparator>
-        minHeap;
-
-    // Iterate through the array and push elements to the min-heap.
-    GreaterThanComparator comparator;
+    // Select the top n elements with nth_element and sort only these.
+    std::vector<typename TInput::element_t> values;
+    values.reserve(array.size());
     int numNull = 0;
     for (const auto& item : array) {
       if (item.has_value()) {
-        if (minHeap.size() < n) {
-          minHeap.push(item.value());
-        } else if (comparator(item.value(), minHeap.top())) {
-          minHeap.push(item.value());
-          minHeap.pop();
-        }
+        values.push_back(item.value());
       } else {
         ++numNull;
       }
     }
-
-    // Reverse the min-heap to get the top n elements in descending order.
-    std::vector<typename TInput::element_t> reversed(minHeap.size());
-    auto index = minHeap.size();
-    while (!minHeap.empty()) {
-      reversed[--index] = minHeap.top();
-      minHeap.pop();
+    GreaterThanComparator comparator;
+    if (n < static_cast<int32_t>(values.size())) {
+      std::nth_element(
+          values.begin(), values.begin() + n, values.end(), comparator);
+      values.resize(n);
     }
+    std::sort(values.begin(), values.end(), comparator);
 
-    // Copy mutated vector to result vector up to minHeap's size items.
-    for (const auto& item : reversed) {
+    for (const auto& item : values) {
       result.push_back(item);
     }
 
@@ -16,6 +16,7 @@
 
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/SortingNetwork.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
@@ -117,6 +118,19 @@ inline void swapWithNull(
   vector->setNull(index, true);
 }
 
+// Sorts the values in [begin, end) by 'lessThan'. The small arrays are sorted
+// with a sorting network, which has no data dependent branches, instead of
+// std::sort.
+template <typename T, typename LessThan>
+void sortValues(T* begin, T* end, LessThan lessThan) {
+  const auto size = end - begin;
+  if (size <= kSortingNetworkMaxSize) {
+    sortingNetwork(begin, size, lessThan);
+  } else {
+    std::sort(begin, end, lessThan);
+  }
+}
+
 template <TypeKind kind>
 void applyScalarType(
     const SelectivityVector& rows,
@@ -176,12 +190,12 @@ void applyScalarType(
     } else if constexpr (kind == TypeKind::REAL || kind == TypeKind::DOUBLE) {
       T* resultRawValues = flatResults->mutableRawValues();
       if (ascending) {
-        std::sort(
+        sortValues(
             resultRawValues + startRow,
             resultRawValues + endRow,
             util::floating_point::NaNAwareLessThan<T>());
       } else {
-        std::sort(
+        sortValues(
             resultRawValues + startRow,
             resultRawValues + endRow,
             util::floating_point::NaNAwareGreaterThan<T>());
@@ -189,9 +203,12 @@ void applyScalarType(
     } else {
       T* resultRawValues = flatResults->mutableRawValues();
       if (ascending) {
-        std::sort(resultRawValues + startRow, resultRawValues + endRow);
+        sortValues(
+            resultRawValues + startRow,
+            resultRawValues + endRow,
+            std::less<T>());
       } else {
-        std::sort(
+        sortValues(
             resultRawValues + startRow,
             resultRawValues + endRow,
             std::greater<T>());
@@ -128,7 +128,13 @@ struct DecimalMultiplyFunction {
 
   template <typename R, typename A, typename B>
   void call(R& out, const A& a, const B& b) {
-    out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
+    if constexpr (std::is_same_v<R, int128_t>) {
+      if (DecimalUtil::multiplyWithOverflow(out, a, b)) {
+        VELOX_ARITHMETIC_ERROR("Decimal overflow: {} * {}", a, b);
+      }
+    } else {
+      out = checkedMultiply<R>(R(a), R(b));
+    }
     DecimalUtil::valueInRange(out);
   }
 };
@@ -186,20 +186,10 @@ class FromUtf8Function : public exec::VectorFunction {
     std::optional<vector_size_t> firstInvalidRow;
     rows.testSelected([&](auto row) {
       auto value = decodedInput.valueAt<StringView>(row);
-
-      int32_t pos = 0;
-      while (pos < value.size()) {
-        int32_t codePoint;
-        auto charLength = tryGetUtf8CharLength(
-            value.data() + pos, value.size() - pos, codePoint);
-        if (charLength < 0) {
-          firstInvalidRow = row;
-          return false;
-        }
-
-        pos += charLength;
+      if (validUtf8Prefix(value.data(), value.size()) < value.size()) {
+        firstInvalidRow = row;
+        return false;
       }
-
       return true;
     });
     return firstInvalidRow;
@@ -267,17 +257,20 @@ class FromUtf8Function : public exec::VectorFunction {
       return;
     }
 
-    int32_t pos = 0;
+    int64_t pos = 0;
     while (pos < input.size()) {
+      const auto validSize =
+          validUtf8Prefix(input.data() + pos, input.size() - pos);
+      fixedWriter.append(std::string_view(input.data() + pos, validSize));
+      pos += validSize;
+      if (pos == input.size()) {
+        break;
+      }
+
       int32_t codePoint;
       auto charLength = tryGetUtf8CharLength(
           input.data() + pos, input.size() - pos, codePoint);
-      if (charLength > 0) {
-        fixedWriter.append(std::string_view(input.data() + pos, charLength));
-        pos += charLength;
-        continue;
-      }
-
+      VELOX_DCHECK_LT(charLength, 0);
       if (!replacement.empty()) {
         fixedWriter.append(replacement);
       }
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Filter.h"
@@ -580,6 +581,10 @@ class InPredicate : public exec::VectorFunction {
           }
         }
       });
+    } else if constexpr (
+        std::is_same_v<T, int64_t> || std::is_same_v<T, int32_t> ||
+        std::is_same_v<T, int16_t>) {
+      testWords(rows, *flatArg, rawResults, testFunction);
     } else {
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
         bool pass = testFunction(flatArg->valueAtFast(row));
@@ -588,6 +593,46 @@ class InPredicate : public exec::VectorFunction {
     }
   }
 
+  // Tests the values of 'flatArg' 64 at a time with the SIMD probes of
+  // 'filter_', e.g. the gathers of BigintValuesUsingHashTable, and sets the
+  // result bits of the selected rows. The word at the end of 'flatArg' is
+  // tested with 'testFunction' a row at a time.
+  template <typename T, typename F>
+  void testWords(
+      const SelectivityVector& rows,
+      const FlatVector<T>& flatArg,
+      uint64_t* rawResults,
+      F& testFunction) const {
+    using Batch = xsimd::batch<T>;
+    static_assert(64 % Batch::size == 0);
+    const auto* rawValues = flatArg.rawValues();
+    const auto* selected = rows.asRange().bits();
+    for (auto word = rows.begin() / 64; word < bits::nwords(rows.end());
+         ++word) {
+      const auto selectedBits = selected[word];
+      if (selectedBits == 0) {
+        continue;
+      }
+      const vector_size_t begin = word * 64;
+      uint64_t pass = 0;
+      if (begin + 64 <= flatArg.size()) {
+        for (auto i = 0; i < 64; i += Batch::size) {
+          const auto values = Batch::load_unaligned(rawValues + begin + i);
+          const auto batchPass = simd::toBitMask(filter_->testValues(values));
+          pass |= static_cast<uint64_t>(batchPass) << i;
+        }
+      } else {
+        bits::forEachSetBit(&selectedBits, 0, 64, [&](auto bit) {
+          if (testFunction(rawValues[begin + bit])) {
+            pass |= 1ULL << bit;
+          }
+        });
+      }
+      rawResults[word] =
+          (rawResults[word] & ~selectedBits) | (pass & selectedBits);
+    }
+  }
+
   const std::unique_ptr<common::Filter> filter_;
   const bool alwaysNull_;
 };
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/JsonExtractScalars.h"
+
+#include "velox/expression/DecodedArgs.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/JsonFunctions.h"
+#include "velox/functions/prestosql/json/JsonExtractCache.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+const char* const kJsonExtractScalars = "$internal$json_extract_scalars";
+
+// $internal$json_extract_scalars(json, path, path, ...) ->
+// row(varchar, varchar, ...)
+// Returns json_extract_scalar(json, path) for each of the constant paths in
+// one row. Parses each document once and extracts all the paths from it.
+// Copies the results from 'cache' instead if not null and the batch is in it.
+class JsonExtractScalarsFunction : public exec::VectorFunction {
+ public:
+  JsonExtractScalarsFunction(
+      std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors,
+      std::unique_ptr<JsonExtractCache> cache)
+      : extractors_(std::move(extractors)), cache_(std::move(cache)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    VELOX_CHECK_EQ(args.size(), extractors_.size() + 1);
+    exec::DecodedArgs decodedArgs(rows, {args[0]}, context);
+    const auto* json = decodedArgs.at(0);
+
+    std::vector<VectorPtr> fields;
+    std::pair<uint64_t, uint64_t> cacheKey;
+    if (cache_ != nullptr &&
+        cache_->find(*json, rows, context.pool(), fields, cacheKey)) {
+      setResult(rows, outputType, std::move(fields), context, result);
+      return;
+    }
+
+    std::vector<FlatVector<StringView>*> flatFields;
+    for (auto i = 0; i < extractors_.size(); ++i) {
+      fields.push_back(
+          BaseVector::create(VARCHAR(), rows.end(), context.pool()));
+      flatFields.push_back(fields.back()->asFlatVector<StringView>());
+    }
+
+    const auto countErrors = [&]() {
+      return context.errors() ? context.errors()->countErrors() : 0;
+    };
+    const auto numErrors = countErrors();
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      const auto value = json->valueAt<StringView>(row);
+      simdjson::padded_string paddedJson(value.data(), value.size());
+      simdjson::ondemand::document jsonDoc;
+      bool needsParse = true;
+      for (auto i = 0; i < extractors_.size(); ++i) {
+        auto error = simdjson::SUCCESS;
+        if (needsParse) {
+          error = simdjsonParse(paddedJson).get(jsonDoc);
+        } else {
+          jsonDoc.rewind();
+        }
+        std::optional<std::string> scalar;
+        if (error == simdjson::SUCCESS) {
+          error = extractJsonScalar(*extractors_[i], jsonDoc, scalar);
+        }
+        // The document may be in any state after an error, so it is parsed
+        // again for the next path.
+        needsParse = error != simdjson::SUCCESS;
+        if (error == simdjson::SUCCESS && scalar.has_value()) {
+          flatFields[i]->set(row, StringView(*scalar));
+        } else {
+          flatFields[i]->setNull(row, true);
+        }
+      }
+    });
+    // The fields are not set at the rows with errors.
+    if (cache_ != nullptr && countErrors() == numErrors) {
+      cache_->insert(cacheKey, rows, flatFields);
+    }
+
+    setResult(rows, outputType, std::move(fields), context, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    return {
+        exec::FunctionSignatureBuilder()
+            .returnType("row(unknown)")
+            .argumentType("json")
+            .constantVariableArity("varchar")
+            .build(),
+        exec::FunctionSignatureBuilder()
+            .returnType("row(unknown)")
+            .argumentType("varchar")
+            .constantVariableArity("varchar")
+            .build()};
+  }
+
+ private:
+  static void setResult(
+      const SelectivityVector& rows,
+      const TypePtr& outputType,
+      std::vector<VectorPtr> fields,
+      exec::EvalCtx& context,
+      VectorPtr& result) {
+    VectorPtr localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(fields));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  const std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors_;
+
+  const std::unique_ptr<JsonExtractCache> cache_;
+};
+
+struct TypedExprHasher {
+  size_t operator()(const core::TypedExprPtr& expr) const {
+    return expr->hash();
+  }
+};
+
+struct TypedExprComparer {
+  bool operator()(const core::TypedExprPtr& lhs, const core::TypedExprPtr& rhs)
+      const {
+    return *lhs == *rhs;
+  }
+};
+
+// The json_extract_scalar calls on one JSON.
+struct CallGroup {
+  core::TypedExprPtr json;
+  std::vector<std::string> paths;
+  // The $internal$json_extract_scalars call for 'paths' if there are at least
+  // two.
+  core::TypedExprPtr call;
+};
+
+struct CallGroups {
+  std::vector<CallGroup> groups;
+  std::unordered_map<
+      core::TypedExprPtr,
+      size_t,
+      TypedExprHasher,
+      TypedExprComparer>
+      groupIndices;
+  // Maps each rewritable call to its group and the index of its path.
+  std::unordered_map<const core::ITypedExpr*, std::pair<size_t, size_t>>
+      calls;
+};
+
+// Returns the path of 'call' if it is a json_extract_scalar call with a valid
+// constant path.
+std::optional<std::string> constantPath(
+    const std::string& prefix,
+    const core::CallTypedExpr& call) {
+  if (call.name() != prefix + "json_extract_scalar" ||
+      call.inputs().size() != 2) {
+    return std::nullopt;
+  }
+  const auto path = core::TypedExprs::asConstant(call.inputs()[1]);
+  if (path == nullptr || path->type()->kind() != TypeKind::VARCHAR ||
+      path->isNull()) {
+    return std::nullopt;
+  }
+  const auto value = path->hasValueVector()
+      ? path->valueVector()->as<ConstantVector<StringView>>()->valueAt(0).str()
+      : path->value().value<TypeKind::VARCHAR>();
+  try {
+    SIMDJsonExtractor::create(value);
+  } catch (const VeloxUserError&) {
+    // The call fails for all the rows, which is left to the call.
+    return std::nullopt;
+  }
+  return value;
+}
+
+// Adds the json_extract_scalar calls in 'expr' to 'groups'. Only looks into
+// the inputs of calls and casts, which are rebuilt by 'replaceCalls'.
+void collectCalls(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr,
+    CallGroups& groups) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr &&
+      dynamic_cast<const core::CastTypedExpr*>(expr.get()) == nullptr) {
+    return;
+  }
+  if (call != nullptr) {
+    if (auto path = constantPath(prefix, *call)) {
+      const auto& json = call->inputs()[0];
+      auto [it, inserted] =
+          groups.groupIndices.emplace(json, groups.groups.size());
+      if (inserted) {
+        groups.groups.push_back({json, {}, nullptr});
+      }
+      auto& paths = groups.groups[it->second].paths;
+      auto pathIt = std::find(paths.begin(), paths.end(), *path);
+      if (pathIt == paths.end()) {
+        pathIt = paths.insert(paths.end(), std::move(path.value()));
+      }
+      groups.calls.emplace(
+          call, std::make_pair(it->second, pathIt - paths.begin()));
+      return;
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    collectCalls(prefix, input, groups);
+  }
+}
+
+core::TypedExprPtr replaceCalls(
+    const core::TypedExprPtr& expr,
+    const CallGroups& groups) {
+  const auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get());
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (cast == nullptr && call == nullptr) {
+    return expr;
+  }
+  auto it = groups.calls.find(expr.get());
+  if (it != groups.calls.end()) {
+    const auto& [groupIndex, pathIndex] = it->second;
+    const auto& group = groups.groups[groupIndex];
+    if (group.call == nullptr) {
+      return expr;
+    }
+    return std::make_shared<core::FieldAccessTypedExpr>(
+        expr->type(), group.call, fmt::format("p{}", pathIndex));
+  }
+
+  bool changed = false;
+  std::vector<core::TypedExprPtr> inputs;
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(replaceCalls(input, groups));
+    changed |= inputs.back() != input;
+  }
+  if (!changed) {
+    return expr;
+  }
+  if (cast != nullptr) {
+    return std::make_shared<core::CastTypedExpr>(
+        expr->type(), inputs, cast->nullOnFailure());
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      expr->type(), std::move(inputs), call->name());
+}
+} // namespace
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs,
+    const core::QueryConfig& config) {
+  // With the cache, the single calls become one-path calls that use it.
+  const size_t minPaths = config.exprJsonExtractCacheEnabled() ? 1 : 2;
+  if (minPaths > 1 && !config.exprJsonMultiPathExtractionEnabled()) {
+    return {};
+  }
+  CallGroups groups;
+  for (const auto& expr : exprs) {
+    collectCalls(prefix, expr, groups);
+  }
+
+  bool hasCall = false;
+  for (auto& group : groups.groups) {
+    if (group.paths.size() < minPaths) {
+      continue;
+    }
+    std::vector<std::string> names;
+    std::vector<core::TypedExprPtr> inputs{group.json};
+    for (const auto& path : group.paths) {
+      names.push_back(fmt::format("p{}", names.size()));
+      inputs.push_back(std::make_shared<core::ConstantTypedExpr>(
+          VARCHAR(), variant(path)));
+    }
+    auto type = ROW(
+        std::move(names),
+        std::vector<TypePtr>(group.paths.size(), VARCHAR()));
+    // One call for all the expressions, which makes it a common
+    // subexpression.
+    group.call = std::make_shared<core::CallTypedExpr>(
+        std::move(type), std::move(inputs), prefix + kJsonExtractScalars);
+    hasCall = true;
+  }
+  if (!hasCall) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(replaceCalls(expr, groups));
+  }
+  return rewritten;
+}
+
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$_json_extract_scalars,
+    JsonExtractScalarsFunction::signatures(),
+    [](const std::string& /*name*/,
+       const std::vector<exec::VectorFunctionArg>& inputArgs,
+       const velox::core::QueryConfig& config) {
+      VELOX_CHECK_GE(inputArgs.size(), 2);
+      std::vector<std::string> paths;
+      std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors;
+      for (auto i = 1; i < inputArgs.size(); ++i) {
+        const auto& path = inputArgs[i].constantValue;
+        VELOX_CHECK(
+            path != nullptr && !path->isNullAt(0),
+            "{} requires constant non-null paths",
+            kJsonExtractScalars);
+        paths.push_back(
+            path->as<ConstantVector<StringView>>()->valueAt(0).str());
+        extractors.push_back(SIMDJsonExtractor::create(paths.back()));
+      }
+      std::unique_ptr<JsonExtractCache> cache;
+      auto* asyncDataCache = cache::AsyncDataCache::getInstance();
+      if (config.exprJsonExtractCacheEnabled() && asyncDataCache != nullptr) {
+        cache = std::make_unique<JsonExtractCache>(asyncDataCache, paths);
+      }
+      return std::make_shared<JsonExtractScalarsFunction>(
+          std::move(extractors), std::move(cache));
+    });
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/core/QueryConfig.h"
+
+namespace facebook::velox::functions {
+
+/// Rewrites the json_extract_scalar calls with a constant path in 'exprs',
+/// the expressions of an ExprSet, so that the calls on the same JSON parse
+/// each document once, see 'QueryConfig::kExprJsonMultiPathExtractionEnabled'.
+///
+/// For example,
+///
+/// Rewrites
+///     json_extract_scalar(j, '$.a'), json_extract_scalar(j, '$.b')
+/// into
+///     $internal$json_extract_scalars(j, '$.a', '$.b').p0,
+///     $internal$json_extract_scalars(j, '$.a', '$.b').p1
+///
+/// where the $internal$json_extract_scalars call is one common subexpression
+/// that returns a row of the results for all the paths.
+///
+/// If 'QueryConfig::kExprJsonExtractCacheEnabled' is set, a single call on a
+/// JSON is rewritten too, so that its results are kept in the cache, see
+/// JsonExtractCache.
+///
+/// The calls inside lambdas and the calls with an invalid path are not
+/// rewritten. Returns the new expressions or an empty vector if nothing is
+/// rewritten.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs,
+    const core::QueryConfig& config);
+
+} // namespace facebook::velox::functions
@@ -169,6 +169,52 @@ struct JsonArrayGetFunction {
   }
 };
 
+/// Extracts the value at the path of 'extractor' from 'jsonDoc' the way
+/// json_extract_scalar() does. Sets 'result' to the value as a string if the
+/// path references a single scalar and leaves it empty otherwise.
+inline simdjson::error_code extractJsonScalar(
+    SIMDJsonExtractor& extractor,
+    simdjson::ondemand::document& jsonDoc,
+    std::optional<std::string>& result) {
+  bool resultPopulated = false;
+
+  auto consumer = [&result, &resultPopulated](auto& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      result = std::nullopt;
+      return simdjson::SUCCESS;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        result = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, simdjson::to_json_string(v));
+      }
+    }
+    return simdjson::SUCCESS;
+  };
+
+  bool isDefinitePath = true;
+  return extractor.extract(jsonDoc, consumer, isDefinitePath);
+}
+
 // json_extract_scalar(json, json_path) -> varchar
 // Like json_extract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -189,56 +235,14 @@ struct JsonExtractScalarFunction {
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
-    std::optional<std::string> resultStr;
-
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return simdjson::SUCCESS;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return simdjson::SUCCESS;
-    };
-
     auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
 
-    // Check for valid json
+    // Check for valid json. The same parse is used for the extraction.
     simdjson::padded_string paddedJson(json.data(), json.size());
-    {
-      SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
-      simdjson::ondemand::document parsedDoc;
-      if (simdjsonParse(paddedJson).get(parsedDoc)) {
-        return simdjson::TAPE_ERROR;
-      }
-    }
+    SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
 
-    bool isDefinitePath = true;
-    SIMDJSON_TRY(extractor.extract(paddedJson, consumer, isDefinitePath));
+    std::optional<std::string> resultStr;
+    SIMDJSON_TRY(extractJsonScalar(extractor, jsonDoc, resultStr));
 
     if (resultStr.has_value()) {
       result.copy_from(*resultStr);
@@ -37,27 +37,8 @@ struct MapKeysByTopNValuesFunction {
     using Compare = typename MapTopNFunction<TExec>::template Compare<It>;
     const Compare comparator;
 
-    std::priority_queue<It, std::vector<It>, Compare> topEntries;
-
-    for (auto it = inputMap.begin(); it != inputMap.end(); ++it) {
-      if (topEntries.size() < n) {
-        topEntries.push(it);
-      } else if (comparator(it, topEntries.top())) {
-        topEntries.pop();
-        topEntries.push(it);
-      }
-    }
-
-    std::vector<It> result;
-    result.reserve(topEntries.size());
-    while (!topEntries.empty()) {
-      result.push_back(topEntries.top());
-      topEntries.pop();
-    }
-
-    // Output the results in descending order.
-    for (auto it = result.crbegin(); it != result.crend(); ++it) {
-      out.push_back((*it)->first);
+    for (const auto& it : topNEntries<It>(inputMap, n, comparator)) {
+      out.push_back(it->first);
     }
   }
 };
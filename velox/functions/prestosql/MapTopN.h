@@ -17,6 +17,7 @@
 
 #include "velox/expression/ComplexViewTypes.h"
 #include "velox/functions/Udf.h"
+#include "velox/functions/prestosql/MapTopNImpl.h"
 
 namespace facebook::velox::functions {
 
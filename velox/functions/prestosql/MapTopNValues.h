@@ -36,7 +36,7 @@ struct MapTopNValuesFunction {
 
       // No need for tie-breaker comparison, as we only maintain top N values.
       if (l->second.has_value() && r->second.has_value()) {
-        return l->second.value().compare(r->second.value(), flags) >= 0;
+        return l->second.value().compare(r->second.value(), flags) > 0;
       }
       return l->second.has_value();
     }
@@ -56,26 +56,8 @@ struct MapTopNValuesFunction {
     using Compare = Compare<It>;
 
     const Compare comparator;
-    std::priority_queue<It, std::vector<It>, Compare> topEntries;
-    for (auto it = inputMap.begin(); it != inputMap.end(); ++it) {
-      if (topEntries.size() < n) {
-        topEntries.push(it);
-      } else if (comparator(it, topEntries.top())) {
-        topEntries.pop();
-        topEntries.push(it);
-      }
-    }
-
-    std::vector<It> result;
-    result.reserve(topEntries.size());
-    while (!topEntries.empty()) {
-      result.push_back(topEntries.top());
-      topEntries.pop();
-    }
-
-    // Output the results in descending order.
-    for (auto it = result.crbegin(); it != result.crend(); ++it) {
-      out.push_back((*it)->second);
+    for (const auto& it : topNEntries<It>(inputMap, n, comparator)) {
+      out.push_back(it->second);
     }
   }
 };
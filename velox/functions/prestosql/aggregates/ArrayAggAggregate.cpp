@@ -284,12 +284,7 @@ class ArrayAggAggregate : public exec::Aggregate {
 
     decodedElements_.decode(*args[0], rows);
     auto tracker = trackRowSize(group);
-    rows.applyToSelected([&](vector_size_t row) {
-      if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
-        return;
-      }
-      values.appendValue(decodedElements_, row, allocator_);
-    });
+    values.appendValues(decodedElements_, rows, ignoreNulls_, allocator_);
   }
 
   void addSingleGroupIntermediateResults(
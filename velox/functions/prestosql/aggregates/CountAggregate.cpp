@@ -70,6 +70,52 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     }
   }
 
+  bool supportsDenseAccumulators() const override {
+    return true;
+  }
+
+  void addDenseRawInput(
+      const uint64_t* groupNumbers,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      char* accumulators,
+      uint64_t* /*nonNulls*/) override {
+    auto* counts = reinterpret_cast<int64_t*>(accumulators);
+    if (args.empty()) {
+      rows.applyToSelected([&](vector_size_t i) { ++counts[groupNumbers[i]]; });
+      return;
+    }
+
+    DecodedVector decoded(*args[0], rows);
+    if (decoded.isConstantMapping()) {
+      if (!decoded.isNullAt(0)) {
+        rows.applyToSelected(
+            [&](vector_size_t i) { ++counts[groupNumbers[i]]; });
+      }
+    } else if (decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          ++counts[groupNumbers[i]];
+        }
+      });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) { ++counts[groupNumbers[i]]; });
+    }
+  }
+
+  void mergeDenseAccumulators(
+      char** groups,
+      int32_t numGroups,
+      const char* accumulators,
+      const uint64_t* /*nonNulls*/) override {
+    const auto* counts = reinterpret_cast<const int64_t*>(accumulators);
+    for (auto i = 0; i < numGroups; ++i) {
+      if (groups[i] != nullptr) {
+        addToGroup(groups[i], counts[i]);
+      }
+    }
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -91,6 +91,19 @@ struct HllAccumulator {
     }
   }
 
+  /// Same as append() for the values of 'hashes'.
+  void appendHashes(const uint64_t* hashes, int32_t numHashes) {
+    int32_t i = 0;
+    for (; isSparse_ && i < numHashes; ++i) {
+      if (sparseHll_.insertHash(hashes[i])) {
+        toDense();
+      }
+    }
+    if (i < numHashes) {
+      denseHll_.insertHashes(hashes + i, numHashes - i);
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -334,6 +347,9 @@ class HyperLogLogAggregate : public exec::Aggregate {
     auto tracker = trackRowSize(group);
     if (hllAsRawInput_) {
       addSingleGroupIntermediateResults(group, rows, args, false /*unused*/);
+    } else if constexpr (!std::is_same_v<T, bool>) {
+      decodeArguments(rows, args);
+      addSingleGroupHashes(group, rows);
     } else {
       decodeArguments(rows, args);
 
@@ -385,6 +401,48 @@ class HyperLogLogAggregate : public exec::Aggregate {
   }
 
  private:
+  // The number of hashes addSingleGroupHashes() computes before adding them.
+  static constexpr int32_t kHashBatchSize = 1024;
+
+  // Adds the values of 'decodedValue_' at 'rows' to the accumulator of
+  // 'group'. Hashes a batch of values at a time in a loop over the values
+  // only, then adds the hashes of the batch.
+  void addSingleGroupHashes(char* group, const SelectivityVector& rows) {
+    auto* accumulator = value<HllAccumulator<T, HllAsFinalResult>>(group);
+    hashes_.resize(kHashBatchSize);
+    int32_t numHashes = 0;
+    const auto appendHashes = [&]() {
+      if (numHashes > 0) {
+        clearNull(group);
+        accumulator->setIndexBitLength(indexBitLength_);
+        accumulator->appendHashes(hashes_.data(), numHashes);
+        numHashes = 0;
+      }
+    };
+
+    if (decodedValue_.isIdentityMapping() && !decodedValue_.mayHaveNulls()) {
+      const auto* values = decodedValue_.data<T>();
+      rows.applyToSelected([&](auto row) {
+        hashes_[numHashes++] = hashOne<T, HllAsFinalResult>(values[row]);
+        if (numHashes == kHashBatchSize) {
+          appendHashes();
+        }
+      });
+    } else {
+      rows.applyToSelected([&](auto row) {
+        if (decodedValue_.isNullAt(row)) {
+          return;
+        }
+        hashes_[numHashes++] =
+            hashOne<T, HllAsFinalResult>(decodedValue_.valueAt<T>(row));
+        if (numHashes == kHashBatchSize) {
+          appendHashes();
+        }
+      });
+    }
+    appendHashes();
+  }
+
   void mergeToAccumulator(char* group, const vector_size_t row) {
     if constexpr (std::is_same_v<T, bool>) {
       static_assert(!HllAsFinalResult);
@@ -499,6 +557,8 @@ class HyperLogLogAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+  // The hashes of the values of a batch of rows in addSingleGroupHashes().
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+// Assumes flat arrays with flat elements placed sequentially with no gaps.
+// Evaluates on all rows.
+VectorPtr evaluateFast(const RowVector& data) {
+  auto input = data.childAt(0)->asUnchecked<ArrayVector>();
+  auto numElements = input->elements()->size();
+  auto rawInput =
+      input->elements()->asUnchecked<FlatVector<int64_t>>()->rawValues();
+
+  auto result = BaseVector::create(BIGINT(), numElements, data.pool());
+  auto flatResult = result->asUnchecked<FlatVector<int64_t>>();
+  auto rawResults = flatResult->mutableRawValues();
+
+  for (auto i = 0; i < numElements; ++i) {
+    rawResults[i] = rawInput[i] * 2;
+  }
+
+  return std::make_shared<ArrayVector>(
+      input->pool(),
+      input->type(),
+      nullptr,
+      input->size(),
+      input->offsets(),
+      input->sizes(),
+      result);
+}
+
+class TransformBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  explicit TransformBenchmark(uint32_t seed)
+      : FunctionBenchmarkBase(), seed_{seed} {
+    functions::prestosql::registerAllScalarFunctions();
+  }
+
+  // Returns flat arrays of BIGINT, a flat BIGINT and a constant BIGINT. The
+  // arrays have no nulls so that the fast path can ignore them.
+  RowVectorPtr generateData() {
+    VectorFuzzer::Options options;
+    options.vectorSize = 10'024;
+
+    VectorFuzzer fuzzer(options, pool(), seed_);
+    auto arrays = fuzzer.fuzzFlat(ARRAY(BIGINT()));
+    arrays->clearNulls(0, arrays->size());
+    auto* elements = arrays->asUnchecked<ArrayVector>()->elements().get();
+    elements->clearNulls(0, elements->size());
+
+    return vectorMaker_.rowVector(
+        {arrays,
+         fuzzer.fuzzFlat(BIGINT()),
+         BaseVector::createConstant(
+             BIGINT(), variant(int64_t{3}), options.vectorSize, pool())});
+  }
+
+  void test() {
+    auto data = generateData();
+
+    auto basicResult = evaluate(kNoCapture, data);
+    auto fastResult = evaluateFast(*data);
+
+    test::assertEqualVectors(basicResult, fastResult);
+  }
+
+  size_t runBasic(const std::string& expression, size_t times) {
+    folly::BenchmarkSuspender suspender;
+    auto data = generateData();
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    suspender.dismiss();
+
+    int cnt = 0;
+    for (auto i = 0; i < times * 1'000; i++) {
+      cnt += evaluate(exprSet, data)->size();
+    }
+    return cnt;
+  }
+
+  size_t runFast(size_t times) {
+    folly::BenchmarkSuspender suspender;
+    auto data = generateData();
+    suspender.dismiss();
+
+    int cnt = 0;
+    for (auto i = 0; i < times * 1'000; i++) {
+      cnt += evaluateFast(*data)->size();
+    }
+    return cnt;
+  }
+
+  static const std::string kNoCapture;
+  static const std::string kFlatCapture;
+  static const std::string kConstantCapture;
+
+ private:
+  const uint32_t seed_;
+};
+
+const std::string TransformBenchmark::kNoCapture =
+    "transform(c0, x -> x * 2)";
+const std::string TransformBenchmark::kFlatCapture =
+    "transform(c0, x -> x * c1)";
+const std::string TransformBenchmark::kConstantCapture =
+    "transform(c0, x -> x * c2)";
+
+const uint32_t seed = folly::Random::rand32();
+
+BENCHMARK_MULTI(noCapture, n) {
+  TransformBenchmark benchmark(seed);
+  return benchmark.runBasic(TransformBenchmark::kNoCapture, n);
+}
+
+BENCHMARK_MULTI(flatCapture, n) {
+  TransformBenchmark benchmark(seed);
+  return benchmark.runBasic(TransformBenchmark::kFlatCapture, n);
+}
+
+BENCHMARK_MULTI(constantCapture, n) {
+  TransformBenchmark benchmark(seed);
+  return benchmark.runBasic(TransformBenchmark::kConstantCapture, n);
+}
+
+BENCHMARK_MULTI(fast, n) {
+  TransformBenchmark benchmark(seed);
+  return benchmark.runFast(n);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+
+  LOG(ERROR) << "Seed: " << seed;
+  {
+    TransformBenchmark benchmark(seed);
+    benchmark.test();
+  }
+  folly::runBenchmarks();
+  return 0;
+}
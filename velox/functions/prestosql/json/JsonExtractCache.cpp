@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/json/JsonExtractCache.h"
+
+#include <fmt/ranges.h>
+
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+// The largest entry to add to the cache.
+constexpr uint64_t kMaxEntryBytes = 8 << 20;
+
+constexpr uint64_t kKeySeed = 0x4a534f4e4b455931;
+constexpr uint64_t kCheckSeed = 0x4a534f4e43484b32;
+
+struct EntryHeader {
+  // The half of the hash of the batch that is not in the key.
+  uint64_t check;
+  int32_t numRows;
+};
+
+// Returns the hash of the documents in 'json' at 'rows' and their positions,
+// computed with 'seed'.
+uint64_t hashBatch(
+    const DecodedVector& json,
+    const SelectivityVector& rows,
+    uint64_t seed) {
+  uint64_t hash = bits::hashMix(seed, rows.end());
+  rows.applyToSelected([&](auto row) {
+    uint64_t valueHash = 0;
+    if (!json.isNullAt(row)) {
+      const auto value = json.valueAt<StringView>(row);
+      valueHash = bits::hashBytes(seed, value.data(), value.size());
+    }
+    hash = bits::hashMix(hash, bits::hashMix(row, valueHash));
+  });
+  return hash;
+}
+
+// Calls 'func' with the consecutive ranges of the memory of 'entry'.
+template <typename Func>
+void forEachRange(cache::AsyncDataCacheEntry& entry, Func func) {
+  auto& data = entry.data();
+  if (data.numPages() == 0) {
+    func(entry.tinyData(), entry.size());
+    return;
+  }
+  uint64_t offset = 0;
+  for (auto i = 0; i < data.numRuns() && offset < entry.size(); ++i) {
+    const auto run = data.runAt(i);
+    const auto size = std::min<uint64_t>(run.numBytes(), entry.size() - offset);
+    func(run.data<char>(), size);
+    offset += size;
+  }
+}
+} // namespace
+
+JsonExtractCache::JsonExtractCache(
+    cache::AsyncDataCache* cache,
+    const std::vector<std::string>& paths)
+    : cache_(cache),
+      pathsId_(
+          fileIds(),
+          fmt::format("$json_extract:{}", fmt::join(paths, "\n"))),
+      numPaths_(paths.size()) {
+  VELOX_CHECK_NOT_NULL(cache_);
+}
+
+bool JsonExtractCache::find(
+    const DecodedVector& json,
+    const SelectivityVector& rows,
+    memory::MemoryPool* pool,
+    std::vector<VectorPtr>& results,
+    std::pair<uint64_t, uint64_t>& key) const {
+  key = {hashBatch(json, rows, kKeySeed), hashBatch(json, rows, kCheckSeed)};
+  const cache::RawFileCacheKey rawKey{pathsId_.id(), key.first};
+  if (!cache_->exists(rawKey)) {
+    return false;
+  }
+  auto pin = cache_->findOrCreate(rawKey, sizeof(EntryHeader), nullptr);
+  if (pin.empty() || pin.checkedEntry()->isExclusive()) {
+    // Evicted since exists() or being added by another thread. Clearing an
+    // exclusive pin removes the new entry.
+    return false;
+  }
+
+  auto* entry = pin.checkedEntry();
+  auto buffer = AlignedBuffer::allocate<char>(entry->size(), pool);
+  auto* rawBuffer = buffer->asMutable<char>();
+  uint64_t offset = 0;
+  forEachRange(*entry, [&](const char* data, uint64_t size) {
+    std::memcpy(rawBuffer + offset, data, size);
+    offset += size;
+  });
+  const auto* header = reinterpret_cast<const EntryHeader*>(rawBuffer);
+  if (header->check != key.second ||
+      header->numRows != rows.countSelected()) {
+    return false;
+  }
+
+  offset = sizeof(EntryHeader);
+  results.resize(numPaths_);
+  for (auto i = 0; i < numPaths_; ++i) {
+    results[i] = BaseVector::create(VARCHAR(), rows.end(), pool);
+    auto* flatResult = results[i]->asFlatVector<StringView>();
+    rows.applyToSelected([&](auto row) {
+      int32_t length;
+      std::memcpy(&length, rawBuffer + offset, sizeof(length));
+      offset += sizeof(length);
+      if (length < 0) {
+        flatResult->setNull(row, true);
+      } else {
+        flatResult->setNoCopy(row, StringView(rawBuffer + offset, length));
+        offset += length;
+      }
+    });
+    flatResult->addStringBuffer(buffer);
+  }
+  VELOX_CHECK_EQ(offset, entry->size());
+  return true;
+}
+
+void JsonExtractCache::insert(
+    const std::pair<uint64_t, uint64_t>& key,
+    const SelectivityVector& rows,
+    const std::vector<FlatVector<StringView>*>& results) const {
+  VELOX_CHECK_EQ(results.size(), numPaths_);
+  std::string serialized(sizeof(EntryHeader), '\0');
+  const EntryHeader header{key.second, rows.countSelected()};
+  std::memcpy(serialized.data(), &header, sizeof(header));
+  for (const auto* result : results) {
+    rows.applyToSelected([&](auto row) {
+      const int32_t length =
+          result->isNullAt(row) ? -1 : result->valueAt(row).size();
+      serialized.append(
+          reinterpret_cast<const char*>(&length), sizeof(length));
+      if (length > 0) {
+        serialized.append(result->valueAt(row).data(), length);
+      }
+    });
+    if (serialized.size() > kMaxEntryBytes) {
+      return;
+    }
+  }
+
+  const cache::RawFileCacheKey rawKey{pathsId_.id(), key.first};
+  cache::CachePin pin;
+  try {
+    pin = cache_->findOrCreate(rawKey, serialized.size(), nullptr);
+  } catch (const VeloxRuntimeError& e) {
+    if (e.errorCode() != error_code::kNoCacheSpace.c_str()) {
+      throw;
+    }
+    return;
+  }
+  if (pin.empty() || !pin.checkedEntry()->isExclusive()) {
+    return;
+  }
+  auto* entry = pin.checkedEntry();
+  uint64_t offset = 0;
+  forEachRange(*entry, [&](char* data, uint64_t size) {
+    std::memcpy(data, serialized.data() + offset, size);
+    offset += size;
+  });
+  // The entry is not backed by a file, so it is not written to SSD.
+  entry->setExclusiveToShared(false);
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::functions {
+
+/// Keeps the results of extracting a set of JSON paths from batches of
+/// documents in AsyncDataCache, see
+/// 'QueryConfig::kExprJsonExtractCacheEnabled'. Extracting the same paths from the same batch again, e.g. when the
+/// queries on a hot table scan the same split, then copies the cached
+/// results instead of parsing the documents again.
+///
+/// A batch is identified by a 128 bit hash of its selected rows and their
+/// documents. An entry is keyed by the paths and one half of the hash, and
+/// holds the other half to detect collisions. The entries take memory from
+/// the cache and are evicted with the other entries of the cache. They are
+/// not written to SSD.
+class JsonExtractCache {
+ public:
+  JsonExtractCache(
+      cache::AsyncDataCache* cache,
+      const std::vector<std::string>& paths);
+
+  /// Sets 'results' to the cached results for the documents in 'json' at
+  /// 'rows', one vector of VARCHAR of size 'rows.end()' per path, and returns
+  /// true. Returns false if the batch is not cached. Sets 'key' to the key of
+  /// the batch for insert().
+  bool find(
+      const DecodedVector& json,
+      const SelectivityVector& rows,
+      memory::MemoryPool* pool,
+      std::vector<VectorPtr>& results,
+      std::pair<uint64_t, uint64_t>& key) const;
+
+  /// Adds 'results' at 'rows' for the batch identified by 'key'. Does nothing
+  /// if there is no space in the cache or if another thread is adding the same
+  /// batch.
+  void insert(
+      const std::pair<uint64_t, uint64_t>& key,
+      const SelectivityVector& rows,
+      const std::vector<FlatVector<StringView>*>& results) const;
+
+ private:
+  cache::AsyncDataCache* const cache_;
+
+  // The id of the paths that is the file number of the keys of the entries.
+  const StringIdLease pathsId_;
+
+  const size_t numPaths_;
+};
+
+} // namespace facebook::velox::functions
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "folly/Range.h"
@@ -68,6 +69,15 @@ class SIMDJsonExtractor {
       TConsumer& consumer,
       bool& isDefinitePath);
 
+  /// Same as above for a document that is already parsed. 'jsonDoc' must be
+  /// positioned at its start, e.g. by simdjson::ondemand::document::rewind(),
+  /// which allows extracting several paths from one parse of the document.
+  template <typename TConsumer>
+  simdjson::error_code extract(
+      simdjson::ondemand::document& jsonDoc,
+      TConsumer& consumer,
+      bool& isDefinitePath);
+
   /// Returns true if this extractor was initialized with the trivial path "$".
   bool isRootOnlyPath() {
     return tokens_.empty();
@@ -78,6 +88,11 @@ class SIMDJsonExtractor {
   /// instance is not passed between threads.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  /// Returns a new extractor for 'path' that is not cached. For callers that
+  /// hold on to the extractors of many paths, which may not all fit in the
+  /// cache of getInstance().
+  static std::unique_ptr<SIMDJsonExtractor> create(folly::StringPiece path);
+
  private:
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
@@ -127,6 +142,14 @@ simdjson::error_code SIMDJsonExtractor::extract(
     TConsumer& consumer,
     bool& isDefinitePath) {
   SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+  return extract(jsonDoc, consumer, isDefinitePath);
+}
+
+template <typename TConsumer>
+simdjson::error_code SIMDJsonExtractor::extract(
+    simdjson::ondemand::document& jsonDoc,
+    TConsumer& consumer,
+    bool& isDefinitePath) {
   SIMDJSON_ASSIGN_OR_RAISE(auto isScalar, jsonDoc.is_scalar());
   if (isScalar) {
     // Note, we cannot convert this to a value as this is not supported if the
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include "velox/expression/VectorFunction.h"
 #include "velox/functions/Registerer.h"
+#include "velox/functions/prestosql/JsonExtractScalars.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/types/JsonRegistration.h"
 
@@ -78,6 +80,14 @@ void registerJsonFunctions(const std::string& prefix) {
   VELOX_REGISTER_VECTOR_FUNCTION(
       udf_$internal$_json_string_to_row,
       prefix + "$internal$json_string_to_row_cast");
+
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$_json_extract_scalars,
+      prefix + "$internal$json_extract_scalars");
+  exec::registerExpressionSetRewrite(
+      [prefix](const auto& exprs, const auto& config) {
+        return rewriteJsonExtractScalars(prefix, exprs, config);
+      });
 }
 
 } // namespace facebook::velox::functions
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/SortingNetwork.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/Registerer.h"
@@ -419,6 +420,31 @@ TEST_F(ArraySortTest, constant) {
   assertEqualVectors(expected, result);
 }
 
+TEST_F(ArraySortTest, arraySizes) {
+  // Sizes up to and past the largest sorting network.
+  std::vector<std::vector<int64_t>> arrays;
+  for (auto size = 0; size <= 3 * kSortingNetworkMaxSize; ++size) {
+    std::vector<int64_t> array;
+    for (auto i = 0; i < size; ++i) {
+      array.push_back((i * 7919 + size) % 13 - 6);
+    }
+    arrays.push_back(std::move(array));
+  }
+  auto data = makeRowVector({makeArrayVector<int64_t>(arrays)});
+
+  for (auto& array : arrays) {
+    std::sort(array.begin(), array.end());
+  }
+  auto result = evaluate("array_sort(c0)", data);
+  assertEqualVectors(makeArrayVector<int64_t>(arrays), result);
+
+  for (auto& array : arrays) {
+    std::reverse(array.begin(), array.end());
+  }
+  result = evaluate("array_sort_desc(c0)", data);
+  assertEqualVectors(makeArrayVector<int64_t>(arrays), result);
+}
+
 TEST_F(ArraySortTest, dictionaryEncodedElements) {
   auto elementVector = makeNullableFlatVector<int64_t>({3, 1, 2, 4, 5});
   auto dictionaryVector = BaseVector::wrapInDictionary(
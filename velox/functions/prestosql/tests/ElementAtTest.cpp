@@ -757,6 +757,26 @@ TEST_F(ElementAtTest, variableInputMap) {
   testVariableInputMap<StringView>(); // VARCHAR
 }
 
+TEST_F(ElementAtTest, sameKeysInMaps) {
+  // The maps have the keys in the same order, except for the maps 3 and 5.
+  const auto mapVector = makeMapVectorFromJson<int64_t, int64_t>({
+      "{1: 10, 2: 20, 3: 30}",
+      "{1: 11, 2: 21, 3: 31}",
+      "{1: 12, 2: 22, 3: 32}",
+      "{3: 33, 1: 13}",
+      "{1: 14, 2: 24, 3: 34}",
+      "{2: 25}",
+      "{1: 16, 2: 26, 3: 36}",
+  });
+  const auto data = makeRowVector({mapVector});
+  test::assertEqualVectors(
+      makeNullableFlatVector<int64_t>({20, 21, 22, std::nullopt, 24, 25, 26}),
+      evaluate("element_at(c0, 2)", data));
+  test::assertEqualVectors(
+      makeFlatVector<int64_t>({30, 31, 32, 33, 34, 0, 36}),
+      evaluate("coalesce(element_at(c0, 3), 0)", data));
+}
+
 TEST_F(ElementAtTest, timestampAsKey) {
   const auto keyVector = makeFlatVector<Timestamp>(
       {Timestamp(1991, 0),
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <fmt/ranges.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/OptionalEmpty.h"
 #include "velox/functions/lib/DateTimeFormatter.h"
@@ -607,6 +609,33 @@ TEST_F(InPredicateTest, reusableResult) {
   assertEqualVectors(expected, actual);
 }
 
+TEST_F(InPredicateTest, largeInListSomeRows) {
+  // 100 values that are not dense, i.e. a BigintValuesUsingHashTable.
+  std::vector<std::string> inListValues;
+  for (auto i = 0; i < 100; ++i) {
+    inListValues.push_back(std::to_string(i * 1'001));
+  }
+  const auto predicate =
+      fmt::format("c0 IN ({})", fmt::join(inListValues, ", "));
+
+  const vector_size_t size = 1'000;
+  auto input = makeRowVector({makeFlatVector<int64_t>(
+      size, [](auto row) { return row % 3 == 0 ? row * 1'001 : row + 1; })});
+  SelectivityVector rows(size);
+  for (auto i = 0; i < size; i += 5) {
+    rows.setValid(i, false);
+  }
+  rows.updateBounds();
+  // The rows that are not selected keep their values.
+  VectorPtr result = makeFlatVector<bool>(size, [](auto) { return true; });
+  evaluate<SimpleVector<bool>>(predicate, input, rows, result);
+
+  auto expected = makeFlatVector<bool>(size, [](auto row) {
+    return row % 5 == 0 || (row % 3 == 0 && row < 100);
+  });
+  assertEqualVectors(expected, result);
+}
+
 TEST_F(InPredicateTest, doubleWithZero) {
   // zero and negative zero, FloatingPointRange
   auto input = makeRowVector({
@@ -14,7 +14,10 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/AsyncDataCache.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
@@ -24,6 +27,20 @@ namespace {
 
 class JsonExtractScalarTest : public functions::test::FunctionBaseTest {
  protected:
+  // Evaluates 'expressions' over 'data' in one ExprSet. Returns the ExprSet
+  // and the results.
+  std::pair<std::unique_ptr<exec::ExprSet>, std::vector<VectorPtr>>
+  evaluateAll(
+      const std::vector<std::string>& expressions,
+      const RowVectorPtr& data) {
+    auto exprSet = compileExpressions(expressions, asRowType(data->type()));
+    exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+    SelectivityVector rows(data->size());
+    std::vector<VectorPtr> results(expressions.size());
+    exprSet->eval(rows, context, results);
+    return {std::move(exprSet), std::move(results)};
+  }
+
   VectorPtr makeVector(std::optional<std::string> json, const TypePtr& type) {
     std::optional<StringView> s = json.has_value()
         ? std::make_optional(StringView(json.value()))
@@ -239,6 +256,107 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+TEST_F(JsonExtractScalarTest, multiPath) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {R"({"a":1,"b":{"c":"x"},"d":[1,2]})",
+           R"({"a":true,"b":{"c":[1]},"d":[3]})",
+           std::nullopt,
+           R"({"a":"y")",
+           R"([1,2,3])",
+           R"({"b":{"c":null},"d":[]})",
+           R"({"a":"z","b":{"c":2.5}})"},
+          JSON()),
+      makeFlatVector<std::string>(
+          {R"({"a":1})",
+           R"({"a":2})",
+           R"({"a":3})",
+           R"({"a":4})",
+           R"({"a":5})",
+           R"({"a":6})",
+           R"({"a":7})"}),
+  });
+  const std::vector<std::string> expressions = {
+      "json_extract_scalar(c0, '$.a')",
+      "json_extract_scalar(c0, '$.b.c')",
+      "concat(json_extract_scalar(c0, '$.d[*]'), "
+      "json_extract_scalar(c0, '$.a'))",
+      "json_extract_scalar(c0, '$[0]')",
+      "json_extract_scalar(c1, '$.a')",
+  };
+
+  const auto [plainSet, expectedResults] = evaluateAll(expressions, data);
+  EXPECT_EQ(plainSet->expr(0)->name(), "json_extract_scalar");
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprJsonMultiPathExtractionEnabled, "true"},
+  });
+  const auto [multiPathSet, results] = evaluateAll(expressions, data);
+  // The calls on c0 read the fields of one shared call and the single call on
+  // c1 is not replaced.
+  const auto& shared = multiPathSet->expr(0)->inputs()[0];
+  EXPECT_EQ(shared->name(), "$internal$json_extract_scalars");
+  EXPECT_EQ(multiPathSet->expr(1)->inputs()[0], shared);
+  EXPECT_EQ(multiPathSet->expr(4)->name(), "json_extract_scalar");
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    velox::test::assertEqualVectors(expectedResults[i], results[i]);
+  }
+}
+
+TEST_F(JsonExtractScalarTest, cache) {
+  std::shared_ptr<cache::AsyncDataCache> asyncDataCache;
+  if (cache::AsyncDataCache::getInstance() == nullptr) {
+    asyncDataCache =
+        cache::AsyncDataCache::create(memory::memoryManager()->allocator());
+    cache::AsyncDataCache::setInstance(asyncDataCache.get());
+  }
+  SCOPE_EXIT {
+    if (asyncDataCache != nullptr) {
+      cache::AsyncDataCache::setInstance(nullptr);
+      asyncDataCache->shutdown();
+    }
+  };
+  auto* cache = cache::AsyncDataCache::getInstance();
+
+  auto makeData = [&](const std::string& last) {
+    return makeRowVector({makeNullableFlatVector<std::string>(
+        {R"({"a":1,"b":{"c":"x"}})",
+         std::nullopt,
+         R"({"a":"y")",
+         R"({"b":{"c":[1]}})",
+         last},
+        JSON())});
+  };
+  const std::vector<std::string> expressions = {
+      "json_extract_scalar(c0, '$.a')",
+      "json_extract_scalar(c0, '$.b.c')",
+  };
+  const auto data = makeData(R"({"a":"z","b":{"c":2.5}})");
+  const auto otherData = makeData(R"({"a":"w"})");
+  const auto [plainSet, expected] = evaluateAll(expressions, data);
+  const auto [otherPlainSet, otherExpected] =
+      evaluateAll(expressions, otherData);
+
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprJsonExtractCacheEnabled, "true"},
+  });
+  // The first evaluation adds the batch to the cache and the later ones copy
+  // the results from it. A batch with other documents is not found.
+  const auto numHits = cache->refreshStats().numHit;
+  for (auto i = 0; i < 3; ++i) {
+    const auto [exprSet, results] = evaluateAll(expressions, data);
+    EXPECT_EQ(cache->refreshStats().numHit, numHits + i);
+    for (auto j = 0; j < expressions.size(); ++j) {
+      velox::test::assertEqualVectors(expected[j], results[j]);
+    }
+  }
+  const auto [otherSet, otherResults] = evaluateAll(expressions, otherData);
+  EXPECT_EQ(cache->refreshStats().numHit, numHits + 2);
+  for (auto j = 0; j < expressions.size(); ++j) {
+    velox::test::assertEqualVectors(otherExpected[j], otherResults[j]);
+  }
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -88,6 +88,33 @@ TEST_F(TransformTest, differentResultType) {
   assertEqualVectors(expectedResult, result);
 }
 
+TEST_F(TransformTest, captures) {
+  vector_size_t size = 1'000;
+  auto array = makeArrayVector<int64_t>(size, modN(5), modN(7), nullEvery(11));
+  auto capture =
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }, nullEvery(3));
+
+  // A flat capture of a fixed width type is gathered and a constant one is
+  // resized. The results are the same as for a capture wrapped in a
+  // dictionary.
+  auto identity = makeIndices(size, [](auto row) { return row; });
+  auto expected = evaluate(
+      "transform(c0, x -> x * c1)",
+      makeRowVector({array, wrapInDictionary(identity, capture)}));
+  auto result =
+      evaluate("transform(c0, x -> x * c1)", makeRowVector({array, capture}));
+  assertEqualVectors(expected, result);
+
+  expected = evaluate(
+      "transform(c0, x -> x * c1)",
+      makeRowVector(
+          {array, makeFlatVector<int64_t>(size, [](auto) { return 10; })}));
+  result = evaluate(
+      "transform(c0, x -> x * c1)",
+      makeRowVector({array, makeConstant<int64_t>(10, size)}));
+  assertEqualVectors(expected, result);
+}
+
 // Test different lambdas applied to different rows
 TEST_F(TransformTest, conditional) {
   vector_size_t size = 1'000;
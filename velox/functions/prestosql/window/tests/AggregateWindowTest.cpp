@@ -129,6 +129,37 @@ TEST_F(AggregateWindowTest, variableWidthAggregate) {
       input, "max(c2)", kOverClauses, {""}, false);
 }
 
+// Tests sliding frames that are large enough to be aggregated with a segment
+// tree.
+TEST_F(AggregateWindowTest, slidingFrames) {
+  const vector_size_t size = 2'000;
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return (row * 7) % 101; }, nullEvery(11)),
+      makeFlatVector<double>(size, [](auto row) { return row * 0.5; }),
+  });
+
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and current row",
+      "rows between 50 preceding and 60 following",
+      "rows between current row and 200 following",
+      "range between 150 preceding and 20 following",
+  };
+  for (const auto& function :
+       {"sum(c2)",
+        "min(c2)",
+        "max(c2)",
+        "count(c2)",
+        "avg(c2)",
+        "stddev(c3)",
+        "var_samp(c2)"}) {
+    WindowTestBase::testWindowFunction(
+        {input}, function, {"partition by c0 order by c1"}, frameClauses);
+  }
+}
+
 // Tests function with k RANGE PRECEDING (FOLLOWING) frames.
 TEST_F(AggregateWindowTest, rangeFrames) {
   auto aggregateFunctions = kAggregateFunctions;
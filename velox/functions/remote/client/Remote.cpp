@@ -16,6 +16,9 @@
 
 #include "velox/functions/remote/client/Remote.h"
 
+#include <deque>
+
+#include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
@@ -43,7 +46,10 @@ class RemoteFunction : public exec::VectorFunction {
         location_(metadata.location),
         thriftClient_(getThriftClient(location_, &eventBase_)),
         serdeFormat_(metadata.serdeFormat),
-        serde_(getSerde(serdeFormat_)) {
+        serde_(getSerde(serdeFormat_)),
+        maxRowsPerRequest_(metadata.maxRowsPerRequest),
+        maxOutstandingRequests_(
+            std::max<int32_t>(1, metadata.maxOutstandingRequests)) {
     std::vector<TypePtr> types;
     types.reserve(inputArgs.size());
     serializedInputTypes_.reserve(inputArgs.size());
@@ -85,8 +91,51 @@ class RemoteFunction : public exec::VectorFunction {
         rows.end(),
         std::move(args));
 
-    // Send to remote server.
-    remote::RemoteFunctionResponse remoteResponse;
+    // Splits the rows into requests of at most 'maxRowsPerRequest_' rows.
+    const vector_size_t numRows = rows.end();
+    const vector_size_t rowsPerRequest =
+        maxRowsPerRequest_ > 0 && maxRowsPerRequest_ < numRows
+        ? maxRowsPerRequest_
+        : numRows;
+    if (rowsPerRequest == numRows) {
+      auto response =
+          waitForResponse(sendRequest(remoteRowVector, outputType, context));
+      result = processResponse(response, 0, outputType, context);
+      return;
+    }
+
+    // Keeps up to 'maxOutstandingRequests_' requests in flight and copies the
+    // results in the order of the requests.
+    result = BaseVector::create(outputType, numRows, context.pool());
+    std::deque<
+        std::pair<vector_size_t, folly::Future<remote::RemoteFunctionResponse>>>
+        inFlight;
+    vector_size_t offset = 0;
+    while (offset < numRows || !inFlight.empty()) {
+      if (offset < numRows && inFlight.size() < maxOutstandingRequests_) {
+        const auto size = std::min(rowsPerRequest, numRows - offset);
+        auto slice = std::static_pointer_cast<RowVector>(
+            remoteRowVector->slice(offset, size));
+        inFlight.emplace_back(offset, sendRequest(slice, outputType, context));
+        offset += size;
+        continue;
+      }
+      auto [requestOffset, future] = std::move(inFlight.front());
+      inFlight.pop_front();
+      auto response = waitForResponse(std::move(future));
+      auto requestResult =
+          processResponse(response, requestOffset, outputType, context);
+      result->copy(
+          requestResult.get(), requestOffset, 0, requestResult->size());
+    }
+  }
+
+  // Serializes 'input' and sends it to the server. The returned future
+  // completes when the event base is driven, e.g. by waitForResponse().
+  folly::Future<remote::RemoteFunctionResponse> sendRequest(
+      const RowVectorPtr& input,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     remote::RemoteFunctionRequest request;
     request.throwOnError_ref() = context.throwOnError();
 
@@ -96,15 +145,20 @@ class RemoteFunction : public exec::VectorFunction {
     functionHandle->argumentTypes_ref() = serializedInputTypes_;
 
     auto requestInputs = request.inputs_ref();
-    requestInputs->rowCount_ref() = remoteRowVector->size();
+    requestInputs->rowCount_ref() = input->size();
     requestInputs->pageFormat_ref() = serdeFormat_;
 
     // TODO: serialize only active rows.
-    requestInputs->payload_ref() = rowVectorToIOBuf(
-        remoteRowVector, rows.end(), *context.pool(), serde_.get());
+    requestInputs->payload_ref() =
+        rowVectorToIOBuf(input, input->size(), *context.pool(), serde_.get());
+
+    return thriftClient_->semifuture_invokeFunction(request).via(&eventBase_);
+  }
 
+  remote::RemoteFunctionResponse waitForResponse(
+      folly::Future<remote::RemoteFunctionResponse> future) const {
     try {
-      thriftClient_->sync_invokeFunction(remoteResponse, request);
+      return std::move(future).getVia(&eventBase_);
     } catch (const std::exception& e) {
       VELOX_FAIL(
           "Error while executing remote function '{}' at '{}': {}",
@@ -112,13 +166,20 @@ class RemoteFunction : public exec::VectorFunction {
           location_.describe(),
           e.what());
     }
+  }
 
+  // Returns the result of a request for the rows starting at 'offset' and
+  // sets the errors of these rows in 'context'.
+  VectorPtr processResponse(
+      const remote::RemoteFunctionResponse& remoteResponse,
+      vector_size_t offset,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     auto outputRowVector = IOBufToRowVector(
         remoteResponse.result().value().payload().value(),
         ROW({outputType}),
         *context.pool(),
         serde_.get());
-    result = outputRowVector->childAt(0);
 
     if (auto errorPayload = remoteResponse.result().value().errorPayload()) {
       auto errorsRowVector = IOBufToRowVector(
@@ -135,19 +196,22 @@ class RemoteFunction : public exec::VectorFunction {
         try {
           throw std::runtime_error(errorsVector->valueAt(i));
         } catch (const std::exception&) {
-          context.setError(i, std::current_exception());
+          context.setError(offset + i, std::current_exception());
         }
       });
     }
+    return outputRowVector->childAt(0);
   }
 
   const std::string functionName_;
   folly::SocketAddress location_;
 
-  folly::EventBase eventBase_;
+  mutable folly::EventBase eventBase_;
   std::unique_ptr<RemoteFunctionClient> thriftClient_;
   remote::PageFormat serdeFormat_;
   std::unique_ptr<VectorSerde> serde_;
+  const vector_size_t maxRowsPerRequest_;
+  const size_t maxOutstandingRequests_;
 
   // Structures we construct once to cache:
   RowTypePtr remoteInputType_;
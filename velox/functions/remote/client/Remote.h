@@ -30,6 +30,16 @@ struct RemoteVectorFunctionMetadata : public exec::VectorFunctionMetadata {
 
   /// The serialization format to be used
   remote::PageFormat serdeFormat{remote::PageFormat::PRESTO_PAGE};
+
+  /// Maximum number of rows sent to the server in one request. Larger batches
+  /// are split into several requests, which the server can evaluate in
+  /// parallel. 0 means no limit.
+  vector_size_t maxRowsPerRequest{0};
+
+  /// Maximum number of requests for one batch that can be in flight at the
+  /// same time. The next request is serialized and sent while the previous
+  /// ones are being evaluated by the server.
+  int32_t maxOutstandingRequests{4};
 };
 
 /// Registers a new remote function. It will use the meatadata defined in
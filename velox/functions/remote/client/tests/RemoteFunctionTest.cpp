@@ -114,6 +114,13 @@ class RemoteFunctionTest
                               .build()};
     registerRemoteFunction("remote_divide", divSignatures, metadata);
 
+    // Splits batches into requests of 3 rows with 2 requests in flight.
+    RemoteVectorFunctionMetadata splitMetadata = metadata;
+    splitMetadata.maxRowsPerRequest = 3;
+    splitMetadata.maxOutstandingRequests = 2;
+    registerRemoteFunction("remote_plus_split", plusSignatures, splitMetadata);
+    registerRemoteFunction("remote_divide_split", divSignatures, splitMetadata);
+
     auto substrSignatures = {exec::FunctionSignatureBuilder()
                                  .returnType("varchar")
                                  .argumentType("varchar")
@@ -133,8 +140,12 @@ class RemoteFunctionTest
         {params.functionPrefix + ".remote_plus"});
     registerFunction<FailFunction, UnknownValue, int32_t, Varchar>(
         {params.functionPrefix + ".remote_fail"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {params.functionPrefix + ".remote_plus_split"});
     registerFunction<CheckedDivideFunction, double, double, double>(
         {params.functionPrefix + ".remote_divide"});
+    registerFunction<CheckedDivideFunction, double, double, double>(
+        {params.functionPrefix + ".remote_divide_split"});
     registerFunction<SubstrFunction, Varchar, Varchar, int32_t>(
         {params.functionPrefix + ".remote_substr"});
     registerFunction<OpaqueTypeFunction, int64_t, std::shared_ptr<Foo>>(
@@ -181,6 +192,28 @@ TEST_P(RemoteFunctionTest, tryException) {
   assertEqualVectors(expected, results);
 }
 
+TEST_P(RemoteFunctionTest, splitRequests) {
+  auto inputVector = makeFlatVector<int64_t>(10, [](auto row) { return row; });
+  auto results = evaluate<SimpleVector<int64_t>>(
+      "remote_plus_split(c0, c0)", makeRowVector({inputVector}));
+
+  auto expected = makeFlatVector<int64_t>(10, [](auto row) { return row * 2; });
+  assertEqualVectors(expected, results);
+
+  // The errors of the rows of later requests are reported at their rows.
+  auto numeratorVector =
+      makeFlatVector<double>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+  auto denominatorVector =
+      makeFlatVector<double>({1, 1, 1, 1, 0, 1, 1, 1, 0, 1});
+  auto divideResults = evaluate<SimpleVector<double>>(
+      "TRY(remote_divide_split(c0, c1))",
+      makeRowVector({numeratorVector, denominatorVector}));
+
+  auto expectedDivide = makeNullableFlatVector<double>(
+      {1, 2, 3, 4, std::nullopt, 6, 7, 8, std::nullopt, 10});
+  assertEqualVectors(expectedDivide, divideResults);
+}
+
 TEST_P(RemoteFunctionTest, conditionalConjunction) {
   // conditional conjunction disables throwing on error.
   auto inputVector0 = makeFlatVector<bool>({true, true});
@@ -18,6 +18,7 @@
 #include <folly/CPortability.h>
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/vector/FlatVector.h"
 
@@ -292,6 +293,12 @@ class RowVectorHasher : public SparkVectorHasher<HashClass> {
   std::vector<std::shared_ptr<SparkVectorHasher<HashClass>>> hashers_;
 };
 
+// True if HashClass::hashBatch supports values of type T.
+template <typename T>
+constexpr bool kHasHashBatch = std::is_same_v<T, int32_t> ||
+    std::is_same_v<T, int64_t> || std::is_same_v<T, float> ||
+    std::is_same_v<T, double>;
+
 template <typename HashClass, typename ReturnType, typename ArgType>
 void hashSimdTyped(
     const SelectivityVector* rows,
@@ -301,6 +308,17 @@ void hashSimdTyped(
   const ArgType* __restrict rawA =
       args[hashIdx]->asUnchecked<FlatVector<ArgType>>()->rawValues();
   auto* __restrict rawResult = result.template mutableRawValues<ReturnType>();
+  if constexpr (kHasHashBatch<ArgType>) {
+    // Hashes a contiguous range of rows a SIMD register at a time.
+    if (rows->isAllSelected()) {
+      HashClass::hashBatch(
+          rawA + rows->begin(),
+          rows->end() - rows->begin(),
+          reinterpret_cast<std::make_unsigned_t<ReturnType>*>(rawResult) +
+              rows->begin());
+      return;
+    }
+  }
   rows->applyToSelected([&](auto row) {
     rawResult[row] = hashOne<HashClass>(rawA[row], rawResult[row]);
   });
@@ -458,6 +476,43 @@ class Murmur3Hash final {
     return hashInt64(input.toMicros(), seed);
   }
 
+  // Hashes the 'size' contiguous values of 'input' into 'hashes', which holds
+  // the seeds on entry. Gives the same results as hashing the values one by
+  // one, but computes the hashes of a SIMD register of values at a time, e.g.
+  // 8 with AVX2. 'T' is int32_t, int64_t, float or double.
+  template <typename T>
+  static void hashBatch(const T* input, int32_t size, uint32_t* hashes) {
+    constexpr uint32_t kNegativeZero = 0x80000000;
+    int32_t i = 0;
+    for (; i + static_cast<int32_t>(Batch::size) <= size; i += Batch::size) {
+      auto h1 = Batch::load_unaligned(hashes + i);
+      const auto* words = reinterpret_cast<const uint32_t*>(input + i);
+      if constexpr (sizeof(T) == sizeof(uint32_t)) {
+        auto k1 = Batch::load_unaligned(words);
+        if constexpr (std::is_floating_point_v<T>) {
+          k1 = xsimd::select(k1 == Batch(kNegativeZero), Batch(0), k1);
+        }
+        h1 = fmix(mixH1(h1, mixK1(k1)), 4);
+      } else {
+        // Gathers the low and the high halves of the 64 bit values.
+        const auto indices = simd::iota<int32_t>();
+        auto low = simd::gather<uint32_t, int32_t, 8>(words, indices);
+        auto high = simd::gather<uint32_t, int32_t, 8>(words + 1, indices);
+        if constexpr (std::is_floating_point_v<T>) {
+          const auto negativeZero =
+              (high == Batch(kNegativeZero)) & (low == Batch(0));
+          high = xsimd::select(negativeZero, Batch(0), high);
+        }
+        h1 = mixH1(h1, mixK1(low));
+        h1 = fmix(mixH1(h1, mixK1(high)), 8);
+      }
+      h1.store_unaligned(hashes + i);
+    }
+    for (; i < size; ++i) {
+      hashes[i] = hashOne<Murmur3Hash>(input[i], hashes[i]);
+    }
+  }
+
  private:
   static uint32_t mixK1(uint32_t k1) {
     k1 *= 0xcc9e2d51;
@@ -483,6 +538,37 @@ class Murmur3Hash final {
     h1 ^= h1 >> 16;
     return h1;
   }
+
+  // Same as the above on all the lanes of a batch.
+  using Batch = xsimd::batch<uint32_t>;
+
+  static Batch rotateLeft(Batch value, int32_t shift) {
+    return (value << shift) | (value >> (32 - shift));
+  }
+
+  static Batch mixK1(Batch k1) {
+    k1 *= Batch(0xcc9e2d51);
+    k1 = rotateLeft(k1, 15);
+    k1 *= Batch(0x1b873593);
+    return k1;
+  }
+
+  static Batch mixH1(Batch h1, Batch k1) {
+    h1 ^= k1;
+    h1 = rotateLeft(h1, 13);
+    h1 = h1 * Batch(5) + Batch(0xe6546b64);
+    return h1;
+  }
+
+  static Batch fmix(Batch h1, uint32_t length) {
+    h1 ^= Batch(length);
+    h1 ^= h1 >> 16;
+    h1 *= Batch(0x85ebca6b);
+    h1 ^= h1 >> 13;
+    h1 *= Batch(0xc2b2ae35);
+    h1 ^= h1 >> 16;
+    return h1;
+  }
 };
 
 class Murmur3HashFunction final : public exec::VectorFunction {
@@ -567,6 +653,45 @@ class XxHash64 final {
     return hashInt64(input.toMicros(), seed);
   }
 
+  // Hashes the 'size' contiguous values of 'input' into 'hashes', which holds
+  // the seeds on entry. Gives the same results as hashing the values one by
+  // one, but computes the hashes of a SIMD register of values at a time, e.g.
+  // 4 with AVX2. 'T' is int32_t, int64_t, float or double.
+  template <typename T>
+  static void hashBatch(const T* input, int32_t size, uint64_t* hashes) {
+    using Batch = xsimd::batch<uint64_t>;
+    int32_t i = 0;
+    for (; i + static_cast<int32_t>(Batch::size) <= size; i += Batch::size) {
+      auto hash = Batch::load_unaligned(hashes + i);
+      if constexpr (sizeof(T) == sizeof(uint32_t)) {
+        // Zero extends the 32 bit values to the 64 bit lanes.
+        const auto* words = reinterpret_cast<const uint32_t*>(input + i);
+        uint64_t extended[Batch::size];
+        for (size_t j = 0; j < Batch::size; ++j) {
+          extended[j] = std::is_floating_point_v<T> && words[j] == 0x80000000
+              ? 0
+              : words[j];
+        }
+        hash = hash + Batch(PRIME64_5 + 4);
+        hash ^= Batch::load_unaligned(extended) * Batch(PRIME64_1);
+        hash = rotateLeft(hash, 23) * Batch(PRIME64_2) + Batch(PRIME64_3);
+      } else {
+        auto k =
+            Batch::load_unaligned(reinterpret_cast<const uint64_t*>(input + i));
+        if constexpr (std::is_floating_point_v<T>) {
+          k = xsimd::select(k == Batch(0x8000000000000000), Batch(0), k);
+        }
+        hash = hash + Batch(PRIME64_5 + 8);
+        hash ^= rotateLeft(k * Batch(PRIME64_2), 31) * Batch(PRIME64_1);
+        hash = rotateLeft(hash, 27) * Batch(PRIME64_1) + Batch(PRIME64_4);
+      }
+      fmix(hash).store_unaligned(hashes + i);
+    }
+    for (; i < size; ++i) {
+      hashes[i] = hashOne<XxHash64>(input[i], hashes[i]);
+    }
+  }
+
  private:
   static const uint64_t PRIME64_1 = 0x9E3779B185EBCA87L;
   static const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FL;
@@ -574,6 +699,12 @@ class XxHash64 final {
   static const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63L;
   static const uint64_t PRIME64_5 = 0x27D4EB2F165667C5L;
 
+  static xsimd::batch<uint64_t> rotateLeft(
+      xsimd::batch<uint64_t> value,
+      int32_t shift) {
+    return (value << shift) | (value >> (64 - shift));
+  }
+
   static uint64_t fmix(uint64_t hash) {
     hash ^= hash >> 33;
     hash *= PRIME64_2;
@@ -583,6 +714,17 @@ class XxHash64 final {
     return hash;
   }
 
+  // Same as the above on all the lanes of a batch.
+  static xsimd::batch<uint64_t> fmix(xsimd::batch<uint64_t> hash) {
+    using Batch = xsimd::batch<uint64_t>;
+    hash ^= hash >> 33;
+    hash *= Batch(PRIME64_2);
+    hash ^= hash >> 29;
+    hash *= Batch(PRIME64_3);
+    hash ^= hash >> 32;
+    return hash;
+  }
+
   static uint64_t hashBytesByWords(const StringView& input, uint64_t seed) {
     const char* i = input.data();
     const char* const end = input.data() + input.size();
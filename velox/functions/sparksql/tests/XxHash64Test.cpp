@@ -365,5 +365,43 @@ TEST_F(XxHash64Test, simd) {
   runSIMDHashAndAssert<UnknownValue>(UnknownValue(), 42, 10);
 }
 
+TEST_F(XxHash64Test, batch) {
+  // Columns without nulls are hashed a SIMD register at a time. The same
+  // columns with a trailing null are hashed row by row.
+  const vector_size_t size = 1'003;
+  auto makeData = [&](vector_size_t numRows) {
+    auto isNullAt = [&](auto row) { return row == size; };
+    return makeRowVector({
+        makeFlatVector<int32_t>(
+            numRows, [](auto row) { return row * 7919; }, isNullAt),
+        makeFlatVector<int64_t>(
+            numRows,
+            [](auto row) { return row * 0x123456789abcdL - 5; },
+            isNullAt),
+        makeFlatVector<float>(
+            numRows,
+            [](auto row) { return row % 3 == 0 ? -0.f : row / 3.f; },
+            isNullAt),
+        makeFlatVector<double>(
+            numRows,
+            [](auto row) { return row % 5 == 0 ? -0. : row * -1.5; },
+            isNullAt),
+    });
+  };
+  auto data = makeData(size);
+  auto dataWithNull = makeData(size + 1);
+  const std::vector<std::string> expressions = {
+      "xxhash64(c0)",
+      "xxhash64(c1)",
+      "xxhash64(c2)",
+      "xxhash64(c3)",
+      "xxhash64(c0, c1, c2, c3)"};
+  for (const auto& expression : expressions) {
+    assertEqualVectors(
+        evaluate(expression, dataWithNull)->slice(0, size),
+        evaluate(expression, data));
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::functions::sparksql::test
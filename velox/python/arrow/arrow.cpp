@@ -24,18 +24,111 @@
 #include <pybind11/stl.h>
 
 #include "velox/python/init/PyInit.h"
+#include "velox/python/type/PyType.h"
 #include "velox/python/vector/PyVector.h"
 #include "velox/vector/arrow/Bridge.h"
 
 namespace py = pybind11;
 
+namespace {
+
+using namespace facebook;
+
+/// Returns the next element of a Python iterator, or a null object when it is
+/// exhausted. Unlike py::iterator, does not prefetch the following element.
+/// Must be called holding the GIL.
+py::object nextOrNull(py::handle iterator) {
+  auto next = py::reinterpret_steal<py::object>(PyIter_Next(iterator.ptr()));
+  if (!next && PyErr_Occurred()) {
+    throw py::error_already_set();
+  }
+  return next;
+}
+
+/// Dictionary and constant encodings are flattened so every batch in a stream
+/// matches the schema exported up front.
+const ArrowOptions kStreamOptions{
+    .flattenDictionary = true,
+    .flattenConstant = true};
+
+/// Arrow RecordBatchReader over a Python iterable of RowVectors, e.g. the
+/// iterator returned by LocalRunner.execute(). Batches are pulled lazily and
+/// converted using Velox's arrow bridge, which shares the buffers of flat
+/// fixed-width vectors instead of copying them.
+class VectorBatchReader : public arrow::RecordBatchReader {
+ public:
+  VectorBatchReader(
+      py::object iterator,
+      velox::RowTypePtr type,
+      velox::memory::MemoryPool* pool)
+      : iterator_(std::move(iterator)), type_(std::move(type)), pool_(pool) {
+    ArrowSchema schema;
+    velox::exportToArrow(
+        velox::BaseVector::create(type_, 0, pool_), schema, kStreamOptions);
+    schema_ = *arrow::ImportSchema(&schema);
+  }
+
+  ~VectorBatchReader() override {
+    // The reader may be released from a thread that does not hold the GIL.
+    py::gil_scoped_acquire acquire;
+    iterator_ = py::object();
+  }
+
+  std::shared_ptr<arrow::Schema> schema() const override {
+    return schema_;
+  }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+    velox::VectorPtr vector;
+    {
+      py::gil_scoped_acquire acquire;
+      try {
+        auto next = nextOrNull(iterator_);
+        if (!next) {
+          *batch = nullptr;
+          return arrow::Status::OK();
+        }
+        vector = next.cast<velox::py::PyVector&>().vector();
+      } catch (const std::exception& e) {
+        return arrow::Status::IOError(e.what());
+      }
+    }
+
+    if (!vector->type()->equivalent(*type_)) {
+      return arrow::Status::Invalid(fmt::format(
+          "Expected a vector of type '{}', but got '{}'",
+          type_->toString(),
+          vector->type()->toString()));
+    }
+
+    ArrowArray data;
+    try {
+      velox::exportToArrow(vector, data, pool_, kStreamOptions);
+    } catch (const std::exception& e) {
+      return arrow::Status::NotImplemented(e.what());
+    }
+    ARROW_ASSIGN_OR_RAISE(*batch, arrow::ImportRecordBatch(&data, schema_));
+    return arrow::Status::OK();
+  }
+
+ private:
+  py::object iterator_;
+  const velox::RowTypePtr type_;
+  velox::memory::MemoryPool* const pool_;
+  std::shared_ptr<arrow::Schema> schema_;
+};
+
+} // namespace
+
 /// This module adds two functions `to_velox()` and `to_arrow()` that allow the
 /// conversion between Velox Vectors and Arrow Arrays from a Python program. It
 /// works by extracting the Arrow C structures from the Arrow C++ Array, then
 /// using Velox's Arrow bridge to convert it to a Velox Vector (and vice-versa).
+/// `to_arrow_reader()` streams a sequence of Vectors as a RecordBatchReader.
 PYBIND11_MODULE(arrow, m) {
   using namespace facebook;
 
+  py::module::import("pyvelox.type");
   py::module::import("pyvelox.vector");
 
   arrow::py::import_pyarrow();
@@ -121,5 +214,66 @@ Converts a velox vector to an arrow object.
     >>> vec = pv.from_list([1, 2, 3, 4, 5])
     >>> arrow = to_arrow(vec)
 
+)pbdoc");
+
+  /// Wraps an iterable of pyvelox.vector.Vector into a
+  /// pyarrow.RecordBatchReader, exported through the Arrow C stream interface.
+  m.def(
+      "to_arrow_reader",
+      [](py::object& vectors, std::optional<velox::py::PyType> type) {
+        py::object iterator = py::iter(vectors);
+
+        // Without an explicit type, peek at the first vector and chain it back
+        // in front of the remaining ones.
+        if (!type.has_value()) {
+          auto first = nextOrNull(iterator);
+          if (!first) {
+            throw std::runtime_error(
+                "Unable to infer the schema of an empty input; pass a type.");
+          }
+          type = first.cast<velox::py::PyVector&>().type();
+          iterator = py::module::import("itertools")
+                         .attr("chain")(py::make_tuple(first), iterator);
+        }
+        if (type->type()->kind() != velox::TypeKind::ROW) {
+          throw std::runtime_error(fmt::format(
+              "Only RowVectors can be streamed as record batches, but got "
+              "'{}'",
+              type->toString()));
+        }
+
+        auto reader = std::make_shared<VectorBatchReader>(
+            std::move(iterator),
+            velox::asRowType(type->type()),
+            leafPool.get());
+        ArrowArrayStream stream;
+        auto status = arrow::ExportRecordBatchReader(reader, &stream);
+        if (!status.ok()) {
+          throw std::runtime_error(
+              "Unable to convert RecordBatchReader to C ABI.");
+        }
+        return py::module::import("pyarrow")
+            .attr("RecordBatchReader")
+            .attr("_import_from_c")(reinterpret_cast<uintptr_t>(&stream));
+      },
+      py::arg("vectors"),
+      py::arg("type") = std::nullopt,
+      R"pbdoc(
+Streams velox vectors as an arrow record batch reader.
+
+Vectors are pulled from `vectors` as the reader is consumed, so the result
+of LocalRunner.execute() can be streamed without materializing it.
+
+:param vectors: Iterable of RowVectors.
+:param type: Optional row type of the vectors. Required if `vectors` may be
+             empty; otherwise taken from the first vector.
+
+:examples:
+
+.. doctest::
+
+    >>> runner = LocalRunner(plan_builder.get_plan_node())
+    >>> table = to_arrow_reader(runner.execute()).read_all()
+
 )pbdoc");
 }
@@ -47,6 +47,9 @@ PyVector PyTaskIterator::Iterator::operator*() const {
 }
 
 void PyTaskIterator::Iterator::advance() {
+  // Task execution does not touch Python objects, so release the GIL while
+  // waiting for the next batch to let other Python threads make progress.
+  py::gil_scoped_release release;
   if (cursor_ && cursor_->moveNext()) {
     vector_ = cursor_->current();
   } else {
@@ -101,15 +104,17 @@ py::iterator PyLocalRunner::execute(int32_t maxDrivers) {
       .outputPool = outputPool_,
   });
 
-  // Add any files passed by the client during plan building.
-  for (auto& [scanId, splits] : scanFiles_) {
-    for (auto& split : splits) {
-      cursor_->task()->addSplit(scanId, exec::Split(std::move(split)));
+  {
+    py::gil_scoped_release release;
+
+    // Add any files passed by the client during plan building.
+    for (auto& [scanId, splits] : scanFiles_) {
+      for (auto& split : splits) {
+        cursor_->task()->addSplit(scanId, exec::Split(std::move(split)));
+      }
+      cursor_->task()->noMoreSplits(scanId);
     }
-    cursor_->task()->noMoreSplits(scanId);
-  }
 
-  {
     std::lock_guard<std::mutex> guard(taskRegistryLock());
     taskRegistry().push_back(cursor_->task());
   }
@@ -60,7 +60,9 @@ class PyLocalRunner {
       const std::string& configName,
       const std::string& configValue);
 
-  /// Execute the task and returns an iterable to the output vectors.
+  /// Execute the task and returns an iterable to the output vectors. The GIL
+  /// is released while the task runs and while waiting for output batches, so
+  /// multiple Python threads can execute plans concurrently.
   ///
   /// @param maxDrivers Maximum number of drivers to use when executing the
   /// plan.
@@ -16,9 +16,40 @@
 
 #include "velox/python/vector/PyVector.h"
 #include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
 #include "velox/vector/VectorPrinter.h"
 
 namespace facebook::velox::py {
+namespace {
+
+template <typename T>
+pybind11::buffer_info flatBufferInfo(const BaseVector& vector) {
+  auto* rawValues = vector.asUnchecked<FlatVector<T>>()->rawValues();
+  return pybind11::buffer_info(
+      const_cast<T*>(rawValues),
+      sizeof(T),
+      pybind11::format_descriptor<T>::format(),
+      1,
+      {static_cast<pybind11::ssize_t>(vector.size())},
+      {static_cast<pybind11::ssize_t>(sizeof(T))},
+      /*readonly=*/true);
+}
+
+bool isBufferKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace
 
 std::string PyVector::summarizeToText() const {
   return velox::VectorPrinter::summarizeToText(*vector_);
@@ -36,4 +67,48 @@ PyVector PyVector::childAt(vector_size_t idx) const {
       "Can only call child_at() on RowVector, but got '{}'", toString()));
 }
 
+PyVectorBuffer PyVector::values() const {
+  return PyVectorBuffer{*this};
+}
+
+PyVectorBuffer::PyVectorBuffer(PyVector vector) : vector_(std::move(vector)) {
+  const auto& values = vector_.vector();
+  if (values->encoding() != VectorEncoding::Simple::FLAT) {
+    throw std::runtime_error(fmt::format(
+        "Can only call values() on flat vectors, but got '{}'",
+        vector_.toString()));
+  }
+  if (!isBufferKind(values->typeKind())) {
+    throw std::runtime_error(fmt::format(
+        "Can only call values() on fixed-width numeric vectors, but got '{}'",
+        vector_.toString()));
+  }
+  if (vector_.nullCount() > 0) {
+    throw std::runtime_error(fmt::format(
+        "Can only call values() on vectors without nulls, but got '{}'",
+        vector_.toString()));
+  }
+}
+
+pybind11::buffer_info PyVectorBuffer::bufferInfo() const {
+  const auto& values = *vector_.vector();
+  switch (values.typeKind()) {
+    case TypeKind::TINYINT:
+      return flatBufferInfo<int8_t>(values);
+    case TypeKind::SMALLINT:
+      return flatBufferInfo<int16_t>(values);
+    case TypeKind::INTEGER:
+      return flatBufferInfo<int32_t>(values);
+    case TypeKind::BIGINT:
+      return flatBufferInfo<int64_t>(values);
+    case TypeKind::REAL:
+      return flatBufferInfo<float>(values);
+    case TypeKind::DOUBLE:
+      return flatBufferInfo<double>(values);
+    default:
+      // Rejected in the constructor.
+      VELOX_UNREACHABLE();
+  }
+}
+
 } // namespace facebook::velox::py
@@ -22,6 +22,8 @@
 
 namespace facebook::velox::py {
 
+class PyVectorBuffer;
+
 class PyVector {
  public:
   /// PyVector is a thin wrapper around Velox Vector. It wraps the underlying
@@ -106,6 +108,11 @@ class PyVector {
     return true;
   }
 
+  /// Returns a zero-copy view over the values of a flat vector of a
+  /// fixed-width numeric type, which can be passed to NumPy. Throws if the
+  /// vector is not flat, has nulls, or is of any other type.
+  PyVectorBuffer values() const;
+
   VectorPtr vector() const {
     return vector_;
   }
@@ -115,4 +122,27 @@ class PyVector {
   VectorPtr vector_;
 };
 
+/// Read-only view over the values of a flat TINYINT, SMALLINT, INTEGER,
+/// BIGINT, REAL or DOUBLE vector without nulls, exposed to Python through the
+/// buffer protocol. The view points directly to the vector's values Buffer and
+/// holds a reference to the vector (and its pool), so Python consumers such as
+/// NumPy arrays keep it alive for as long as they reference the memory. Logical
+/// types are exposed as their physical values, e.g. DATE as int32 days.
+///
+/// The vector is validated at construction so that bufferInfo(), which is
+/// called from Python's buffer protocol, never throws.
+class PyVectorBuffer {
+ public:
+  explicit PyVectorBuffer(PyVector vector);
+
+  pybind11::buffer_info bufferInfo() const;
+
+  size_t size() const {
+    return vector_.size();
+  }
+
+ private:
+  const PyVector vector_;
+};
+
 } // namespace facebook::velox::py
@@ -24,6 +24,13 @@ namespace py = pybind11;
 PYBIND11_MODULE(vector, m) {
   using namespace facebook;
 
+  py::class_<velox::py::PyVectorBuffer>(
+      m, "VectorBuffer", py::buffer_protocol())
+      .def_buffer(&velox::py::PyVectorBuffer::bufferInfo)
+      .def("__len__", &velox::py::PyVectorBuffer::size, py::doc(R"(
+        Number of values in the buffer.
+      )"));
+
   py::class_<velox::py::PyVector>(m, "Vector")
       .def("__str__", &velox::py::PyVector::toString, py::doc(R"(
         Returns a summarized description of the Vector and its type.
@@ -50,6 +57,11 @@ PYBIND11_MODULE(vector, m) {
         Args:
           index: The index of the child element in the RowVector.
       )"))
+      .def("values", &velox::py::PyVector::values, py::doc(R"(
+        Returns a read-only, zero-copy buffer over the values of a flat
+        numeric Vector without nulls, e.g. for numpy.asarray(). The
+        buffer keeps the Vector alive while it is referenced.
+      )"))
       .def("null_count", &velox::py::PyVector::nullCount, py::doc(R"(
         Number of null elements in the Vector.
       )"))
@@ -19,12 +19,18 @@
 from typing import List
 
 
+class VectorBuffer:
+    def __len__(self) -> int: ...
+    def __buffer__(self, flags: int) -> memoryview: ...
+
+
 class Vector:
     def size(self) -> int: ...
     def print_all(self) -> str: ...
     def print_detailed(self) -> str: ...
     def summarize_to_text(self) -> str: ...
     def child_at(self, idx: int) -> Vector: ...
+    def values(self) -> VectorBuffer: ...
     def null_count(self) -> int: ...
     def is_null_at(self, int) -> bool: ...
     def __getitem__(self, int) -> str: ...
@@ -33,14 +33,13 @@ int32_t readInt32(const char* buffer) {
   return n;
 }
 
-FOLLY_ALWAYS_INLINE void writeFixedWidth(
-    const char* rawData,
-    vector_size_t index,
-    size_t valueBytes,
-    char* buffer,
-    size_t& offset) {
-  ::memcpy(buffer + offset, rawData + index * valueBytes, valueBytes);
-  offset += valueBytes;
+// The size of the copy is known at compile time, so that it compiles to a
+// single store.
+template <typename T>
+FOLLY_ALWAYS_INLINE void
+writeFixedWidth(const T& value, char* buffer, size_t& offset) {
+  ::memcpy(buffer + offset, &value, sizeof(T));
+  offset += sizeof(T);
 }
 
 FOLLY_ALWAYS_INLINE void
@@ -72,20 +71,33 @@ void serializeTyped(
     const raw_vector<uint8_t*>& nulls,
     char* buffer,
     std::vector<size_t>& offsets) {
-  const auto* rawData = decoded.data<char>();
-  if (!decoded.mayHaveNulls()) {
-    for (auto i = 0; i < rows.size(); ++i) {
-      writeFixedWidth(
-          rawData, decoded.index(rows[i]), valueBytes, buffer, offsets[i]);
-    }
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (!std::is_trivially_copyable_v<T>) {
+    VELOX_UNSUPPORTED("Unsupported type kind: {}", mapTypeKindToName(kind));
   } else {
-    for (auto i = 0; i < rows.size(); ++i) {
-      if (decoded.isNullAt(rows[i])) {
-        bits::setBit(nulls[i], childIdx, true);
-        offsets[i] += valueBytes;
+    VELOX_DCHECK_EQ(valueBytes, sizeof(T));
+    const auto* rawData = decoded.data<T>();
+    const auto numRows = rows.size();
+    if (!decoded.mayHaveNulls()) {
+      if (decoded.isIdentityMapping()) {
+        for (auto i = 0; i < numRows; ++i) {
+          writeFixedWidth(rawData[rows[i]], buffer, offsets[i]);
+        }
       } else {
-        writeFixedWidth(
-            rawData, decoded.index(rows[i]), valueBytes, buffer, offsets[i]);
+        for (auto i = 0; i < numRows; ++i) {
+          writeFixedWidth(
+              rawData[decoded.index(rows[i])], buffer, offsets[i]);
+        }
+      }
+    } else {
+      for (auto i = 0; i < numRows; ++i) {
+        if (decoded.isNullAt(rows[i])) {
+          bits::setBit(nulls[i], childIdx, true);
+          offsets[i] += sizeof(T);
+        } else {
+          writeFixedWidth(
+              rawData[decoded.index(rows[i])], buffer, offsets[i]);
+        }
       }
     }
   }
@@ -235,6 +247,12 @@ void CompactRow::initialize(const TypePtr& type) {
       }
 
       rowNullBytes_ = bits::nbytes(type->size());
+      rowFixedBytes_ = rowNullBytes_;
+      for (auto i = 0; i < children_.size(); ++i) {
+        if (childIsFixedWidth_[i]) {
+          rowFixedBytes_ += children_[i].valueBytes_;
+        }
+      }
       break;
     }
     case TypeKind::BOOLEAN:
@@ -339,8 +357,43 @@ void CompactRow::serializedRowSizes(
     return;
   }
 
-  for (const auto& row : rows) {
-    *sizes[row] = rowSize(row) + sizeof(TRowSize);
+  raw_vector<vector_size_t> indices(rows.size());
+  for (auto i = 0; i < rows.size(); ++i) {
+    indices[i] = decoded_.index(rows[i]);
+  }
+  raw_vector<int32_t> rowSizes(rows.size());
+  std::fill(rowSizes.begin(), rowSizes.end(), rowFixedBytes_);
+  addVariableWidthRowSizes(indices, rowSizes);
+  for (auto i = 0; i < rows.size(); ++i) {
+    *sizes[rows[i]] = rowSizes[i] + sizeof(TRowSize);
+  }
+}
+
+void CompactRow::addVariableWidthRowSizes(
+    const raw_vector<vector_size_t>& rows,
+    raw_vector<int32_t>& sizes) const {
+  for (auto childIdx = 0; childIdx < children_.size(); ++childIdx) {
+    if (childIsFixedWidth_[childIdx]) {
+      continue;
+    }
+    const auto& child = children_[childIdx];
+    const auto& decoded = child.decoded_;
+    const bool mayHaveNulls = decoded.mayHaveNulls();
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      const auto* rawData = decoded.data<StringView>();
+      for (auto i = 0; i < rows.size(); ++i) {
+        if (!mayHaveNulls || !decoded.isNullAt(rows[i])) {
+          sizes[i] += kSizeBytes + rawData[decoded.index(rows[i])].size();
+        }
+      }
+    } else {
+      for (auto i = 0; i < rows.size(); ++i) {
+        if (!mayHaveNulls || !decoded.isNullAt(rows[i])) {
+          sizes[i] += child.variableWidthRowSize(rows[i]);
+        }
+      }
+    }
   }
 }
 
@@ -380,20 +433,12 @@ int32_t CompactRow::serializeRow(vector_size_t index, char* buffer) const {
   return valuesOffset;
 }
 
-void CompactRow::serializeRow(
-    vector_size_t offset,
-    vector_size_t size,
+void CompactRow::serializeRows(
+    const raw_vector<vector_size_t>& rows,
     char* buffer,
     const size_t* bufferOffsets) const {
-  raw_vector<vector_size_t> rows(size);
+  const auto size = rows.size();
   raw_vector<uint8_t*> nulls(size);
-  if (decoded_.isIdentityMapping()) {
-    std::iota(rows.begin(), rows.end(), offset);
-  } else {
-    for (auto i = 0; i < size; ++i) {
-      rows[i] = decoded_.index(offset + i);
-    }
-  }
 
   // After serializing each column, the 'offsets' are updated accordingly.
   std::vector<size_t> offsets(size);
@@ -661,7 +706,26 @@ void CompactRow::serialize(
     vector_size_t size,
     const size_t* bufferOffsets,
     char* buffer) const {
-  serializeRow(offset, size, buffer, bufferOffsets);
+  raw_vector<vector_size_t> rows(size);
+  if (decoded_.isIdentityMapping()) {
+    std::iota(rows.begin(), rows.end(), offset);
+  } else {
+    for (auto i = 0; i < size; ++i) {
+      rows[i] = decoded_.index(offset + i);
+    }
+  }
+  serializeRows(rows, buffer, bufferOffsets);
+}
+
+void CompactRow::serialize(
+    const folly::Range<const vector_size_t*>& rows,
+    const size_t* bufferOffsets,
+    char* buffer) const {
+  raw_vector<vector_size_t> indices(rows.size());
+  for (auto i = 0; i < rows.size(); ++i) {
+    indices[i] = decoded_.index(rows[i]);
+  }
+  serializeRows(indices, buffer, bufferOffsets);
 }
 
 void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) const {
@@ -773,10 +837,22 @@ VectorPtr deserializeFixedWidth(
 
   auto* rawNulls = nulls->as<uint64_t>();
 
-  for (auto i = 0; i < numRows; ++i) {
-    const bool isNull = bits::isBitNull(rawNulls, i);
-    readFixedWidthValue<T>(
-        isNull, data[i].data() + offsets[i], flatVector.get(), i);
+  if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Timestamp>) {
+    for (auto i = 0; i < numRows; ++i) {
+      const bool isNull = bits::isBitNull(rawNulls, i);
+      readFixedWidthValue<T>(
+          isNull, data[i].data() + offsets[i], flatVector.get(), i);
+    }
+  } else {
+    // Copy the values straight into the values buffer and take the nulls as
+    // a whole instead of setting each value and null flag.
+    auto* rawValues = flatVector->mutableRawValues();
+    bits::forEachSetBit(rawNulls, 0, numRows, [&](auto row) {
+      ::memcpy(rawValues + row, data[row].data() + offsets[row], sizeof(T));
+    });
+    if (!bits::isAllSet(rawNulls, 0, numRows)) {
+      flatVector->setNulls(nulls);
+    }
   }
 
   return flatVector;
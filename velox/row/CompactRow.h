@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/memory/RawVector.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
 
@@ -24,9 +25,8 @@ class CompactRow {
  public:
   explicit CompactRow(const RowVectorPtr& vector);
 
-  /// Returns the serialized sizes of the rows at specified indexes.
-  ///
-  /// TODO: optimizes using columnar serialization size calculation.
+  /// Returns the serialized sizes of the rows at specified indexes. The sizes
+  /// are computed column by column.
   void serializedRowSizes(
       const folly::Range<const vector_size_t*>& rows,
       vector_size_t** sizes) const;
@@ -55,6 +55,14 @@ class CompactRow {
       const size_t* bufferOffsets,
       char* buffer) const;
 
+  /// Serializes the rows at 'rows' into 'buffer' at given 'bufferOffsets',
+  /// column by column. The requirements on 'buffer' and 'bufferOffsets' are
+  /// the same as for serialize() of a range of rows.
+  void serialize(
+      const folly::Range<const vector_size_t*>& rows,
+      const size_t* bufferOffsets,
+      char* buffer) const;
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
@@ -130,14 +138,19 @@ class CompactRow {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer) const;
 
-  /// Serializes struct values in range [offset, offset + size) to buffer.
-  /// Value must not be null.
-  void serializeRow(
-      vector_size_t offset,
-      vector_size_t size,
+  /// Serializes the struct values at 'rows' of 'decoded_.base()' to buffer
+  /// column by column. Values must not be null.
+  void serializeRows(
+      const raw_vector<vector_size_t>& rows,
       char* buffer,
       const size_t* bufferOffsets) const;
 
+  /// Adds the serialized sizes of the variable-width fields of the struct
+  /// values at 'rows' of 'decoded_.base()' to 'sizes', column by column.
+  void addVariableWidthRowSizes(
+      const raw_vector<vector_size_t>& rows,
+      raw_vector<int32_t>& sizes) const;
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
@@ -155,6 +168,9 @@ class CompactRow {
   // ROW type only. Number of bytes used by null flags.
   size_t rowNullBytes_;
 
+  // ROW type only. Number of bytes used by null flags and fixed-width fields.
+  int32_t rowFixedBytes_;
+
   // Fixed-width types only. Number of bytes used for a single value.
   size_t valueBytes_;
 };
@@ -88,6 +88,50 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(copy->size(), data->size());
   }
 
+  // Serializes every other row of the data, as a shuffle does for the rows of
+  // one partition, row by row or column by column.
+  void serializeCompactRows(const RowTypePtr& rowType, bool columnar) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    std::vector<vector_size_t> rows;
+    for (auto i = 0; i < data->size(); i += 2) {
+      rows.push_back(i);
+    }
+    suspender.dismiss();
+
+    CompactRow compact(data);
+    std::vector<vector_size_t> rowSize(data->size());
+    std::vector<vector_size_t*> rowSizePtrs(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      rowSizePtrs[i] = &rowSize[i];
+    }
+    const folly::Range<const vector_size_t*> range(rows.data(), rows.size());
+    if (columnar) {
+      compact.serializedRowSizes(range, rowSizePtrs.data());
+    } else {
+      for (auto row : rows) {
+        rowSize[row] = compact.rowSize(row);
+      }
+    }
+
+    std::vector<size_t> offsets(rows.size());
+    size_t totalSize = 0;
+    for (auto i = 0; i < rows.size(); ++i) {
+      offsets[i] = totalSize;
+      totalSize += rowSize[rows[i]];
+    }
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    auto* rawBuffer = buffer->asMutable<char>();
+    if (columnar) {
+      compact.serialize(range, offsets.data(), rawBuffer);
+    } else {
+      for (auto i = 0; i < rows.size(); ++i) {
+        compact.serialize(rows[i], rawBuffer + offsets[i]);
+      }
+    }
+    folly::doNotOptimizeAway(rawBuffer);
+  }
+
   void serializeContainer(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -254,6 +298,36 @@ class SerializeBenchmark {
     benchmark.deserializeContainer(rowType); \
   }
 
+// Compares serializing the rows of one partition of wide rows one by one with
+// serializing them column by column.
+#define COMPACT_ROWS_BENCHMARKS(name, rowType)            \
+  BENCHMARK(compact_serialize_rows_row_by_row_##name) {   \
+    SerializeBenchmark benchmark;                         \
+    benchmark.serializeCompactRows(rowType, false);       \
+  }                                                       \
+                                                          \
+  BENCHMARK_RELATIVE(compact_serialize_rows_columnar_##name) { \
+    SerializeBenchmark benchmark;                         \
+    benchmark.serializeCompactRows(rowType, true);        \
+  }                                                       \
+                                                          \
+  BENCHMARK(compact_deserialize_##name) {                 \
+    SerializeBenchmark benchmark;                         \
+    benchmark.deserializeCompact(rowType);                \
+  }
+
+// Returns a row type of 'numColumns' columns cycling over integer, floating
+// point, boolean and string types.
+RowTypePtr wideRowType(int32_t numColumns) {
+  static const std::vector<TypePtr> kTypes = {
+      BIGINT(), INTEGER(), DOUBLE(), VARCHAR(), BOOLEAN(), SMALLINT()};
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < numColumns; ++i) {
+    types.push_back(kTypes[i % kTypes.size()]);
+  }
+  return ROW(std::move(types));
+}
+
 SERDE_BENCHMARKS(
     fixedWidth5,
     ROW({BIGINT(), DOUBLE(), BOOLEAN(), TINYINT(), REAL()}));
@@ -314,6 +388,14 @@ SERDE_BENCHMARKS(
     structs,
     ROW({BIGINT(), ROW({BIGINT(), DOUBLE(), BOOLEAN(), TINYINT(), REAL()})}));
 
+COMPACT_ROWS_BENCHMARKS(wide10, wideRowType(10));
+
+COMPACT_ROWS_BENCHMARKS(wide50, wideRowType(50));
+
+COMPACT_ROWS_BENCHMARKS(wide100, wideRowType(100));
+
+COMPACT_ROWS_BENCHMARKS(wide200, wideRowType(200));
+
 } // namespace
 } // namespace facebook::velox::row
 
@@ -126,6 +126,31 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
       auto copy = CompactRow::deserialize(serialized, rowType, pool());
       assertEqualVectors(data, copy);
     }
+    {
+      // Test serialize by rows. Serializes the even rows, then the odd rows.
+      memset(rawBuffer, 0, totalSize);
+
+      for (auto parity = 0; parity < 2; ++parity) {
+        std::vector<vector_size_t> selected;
+        std::vector<size_t> selectedOffsets;
+        for (auto i = parity; i < numRows; i += 2) {
+          selected.push_back(i);
+          selectedOffsets.push_back(offsets[i]);
+        }
+        row.serialize(
+            folly::Range(selected.data(), selected.size()),
+            selectedOffsets.data(),
+            rawBuffer);
+      }
+
+      std::vector<std::string_view> serialized;
+      for (auto i = 0; i < numRows; ++i) {
+        serialized.push_back(
+            std::string_view(rawBuffer + offsets[i], rowSize[i]));
+      }
+      auto copy = CompactRow::deserialize(serialized, rowType, pool());
+      assertEqualVectors(data, copy);
+    }
   }
 };
 
@@ -61,6 +61,11 @@ void LocalRunner::start() {
   VELOX_CHECK_EQ(state_, State::kInitialized);
   auto lastStage = makeStages();
   params_.planNode = plan_->fragments().back().fragment.planNode;
+  // The final stage runs single threaded unless its fragment sets the number
+  // of drivers, since it may gather the results without a local exchange.
+  if (fragments_.back().numDrivers > 0) {
+    params_.maxDrivers = fragments_.back().numDrivers;
+  }
   auto cursor = exec::TaskCursor::create(params_);
   stages_.push_back({cursor->task()});
   // Add table scan splits to the final gathere stage.
@@ -190,7 +195,7 @@ LocalRunner::makeStages() {
       stages_.back().push_back(task);
       // Output buffers are created during Task::start(), so we must start the
       // task before calling updateOutputBuffers().
-      task->start(options_.numDrivers);
+      task->start(numDrivers(fragment));
       if (fragment.numBroadcastDestinations) {
         // TODO: Add support for Arbitrary partition type.
         task->updateOutputBuffers(fragment.numBroadcastDestinations, true);
@@ -202,29 +207,7 @@ LocalRunner::makeStages() {
        ++fragmentIndex) {
     auto& fragment = fragments_[fragmentIndex];
     for (auto& scan : fragment.scans) {
-      auto source = splitSourceForScan(*scan);
-      std::vector<SplitSource::SplitAndGroup> splits;
-      int32_t splitIdx = 0;
-      auto getNextSplit = [&]() {
-        if (splitIdx < splits.size()) {
-          return exec::Split(std::move(splits[splitIdx++].split));
-        }
-        splits = source->getSplits(std::numeric_limits<int64_t>::max());
-        splitIdx = 1;
-        return exec::Split(std::move(splits[0].split));
-      };
-
-      bool allDone = false;
-      do {
-        for (auto i = 0; i < stages_[fragmentIndex].size(); ++i) {
-          auto split = getNextSplit();
-          if (!split.hasConnectorSplit()) {
-            allDone = true;
-            break;
-          }
-          stages_[fragmentIndex][i]->addSplit(scan->id(), std::move(split));
-        }
-      } while (!allDone);
+      addScanSplits(*scan, stages_[fragmentIndex]);
     }
     for (auto& scan : fragment.scans) {
       for (auto i = 0; i < stages_[fragmentIndex].size(); ++i) {
@@ -256,6 +239,21 @@ LocalRunner::makeStages() {
   return lastStage;
 }
 
+void LocalRunner::addScanSplits(
+    const core::TableScanNode& scan,
+    const std::vector<std::shared_ptr<exec::Task>>& stage) {
+  VELOX_CHECK(!stage.empty());
+  // The split weight and the number of splits of each Task.
+  std::vector<std::pair<int64_t, int32_t>> loads(stage.size(), {0, 0});
+  for (auto& split : listAllSplits(splitSourceForScan(scan))) {
+    const auto taskIndex =
+        std::min_element(loads.begin(), loads.end()) - loads.begin();
+    loads[taskIndex].first += split.connectorSplit->splitWeight;
+    ++loads[taskIndex].second;
+    stage[taskIndex]->addSplit(scan.id(), std::move(split));
+  }
+}
+
 std::vector<exec::TaskStats> LocalRunner::stats() const {
   std::vector<exec::TaskStats> result;
   std::lock_guard<std::mutex> l(mutex_);
@@ -93,6 +93,19 @@ class LocalRunner : public Runner,
   std::shared_ptr<SplitSource> splitSourceForScan(
       const core::TableScanNode& scan);
 
+  // Returns the number of threads of each Task of 'fragment'.
+  int32_t numDrivers(const ExecutableFragment& fragment) const {
+    return fragment.numDrivers > 0 ? fragment.numDrivers : options_.numDrivers;
+  }
+
+  // Adds the splits of 'scan' to the Tasks of 'stage'. Each split goes to the
+  // Task with the least split weight so far, or with the fewest splits if the
+  // weights are equal, so that the Tasks of a wide stage get even shares of
+  // the scan.
+  void addScanSplits(
+      const core::TableScanNode& scan,
+      const std::vector<std::shared_ptr<exec::Task>>& stage);
+
   // Serializes 'cursor_' and 'error_'.
   mutable std::mutex mutex_;
 
@@ -27,10 +27,13 @@ std::string toFragmentsString(
   for (auto i = 0; i < fragments.size(); ++i) {
     const auto& fragment = fragments[i];
     out << fmt::format(
-               "Fragment {}: {} numWorkers={}:",
+               "Fragment {}: {} numWorkers={}{}:",
                i,
                fragment.taskPrefix,
-               fragment.width)
+               fragment.width,
+               fragment.numDrivers > 0
+                   ? fmt::format(" numDrivers={}", fragment.numDrivers)
+                   : "")
         << std::endl;
     out << planNodeToString(*fragment.fragment.planNode) << std::endl;
     if (!fragment.inputStages.empty()) {
@@ -43,6 +43,12 @@ struct ExecutableFragment {
       : taskPrefix(taskPrefix) {}
   std::string taskPrefix;
   int32_t width{0};
+
+  /// Number of threads of each Task of 'this'. If 0,
+  /// MultiFragmentPlan::Options::numDrivers is used. Allows sizing the stages
+  /// of a plan independently, e.g. a wide scan stage and a narrow final
+  /// aggregation.
+  int32_t numDrivers{0};
   velox::core::PlanFragment fragment;
 
   /// Source fragments and Exchange node ids for remote shuffles producing input
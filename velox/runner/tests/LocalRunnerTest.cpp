@@ -199,6 +199,41 @@ TEST_F(LocalRunnerTest, scan) {
   checkScanCount("s2", 3);
 }
 
+TEST_F(LocalRunnerTest, fragmentNumDrivers) {
+  const std::string id = "d1";
+  auto fragments = makeScanPlan(id, 3)->fragments();
+  ASSERT_EQ(2, fragments.size());
+  fragments[0].numDrivers = 3;
+  fragments[1].numDrivers = 4;
+  auto plan = std::make_shared<MultiFragmentPlan>(
+      std::move(fragments),
+      MultiFragmentPlan::Options{
+          .queryId = id, .numWorkers = 3, .numDrivers = 2});
+  ASSERT_NE(plan->toString().find("numDrivers=3"), std::string::npos);
+
+  auto rootPool = makeRootPool(id);
+  auto splitSourceFactory = makeSimpleSplitSourceFactory(plan);
+  auto localRunner = std::make_shared<LocalRunner>(
+      std::move(plan), makeQueryCtx(id, rootPool.get()), splitSourceFactory);
+  auto results = readCursor(localRunner);
+  int32_t count = 0;
+  for (auto& rows : results) {
+    count += rows->size();
+  }
+  results.clear();
+  EXPECT_EQ(kNumRows, count);
+
+  // The scan stage has 3 Tasks of 3 drivers and the final stage 4 drivers.
+  const auto stats = localRunner->stats();
+  ASSERT_EQ(2, stats.size());
+  EXPECT_EQ(9, stats[0].pipelineStats[0].operatorStats[0].numDrivers);
+  EXPECT_EQ(4, stats[1].pipelineStats[0].operatorStats[0].numDrivers);
+  // The 5 splits are spread 2, 2, 1 over the scan Tasks. The stats of a stage
+  // have the split counts of its first Task.
+  EXPECT_EQ(2, stats[0].numTotalSplits);
+  localRunner->waitForCompletion(kWaitTimeoutUs);
+}
+
 TEST_F(LocalRunnerTest, broadcast) {
   auto plan = makeJoinPlan("c0", true);
   const std::string id = "q1";
@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowIpcSerializer.h"
+
+#include <algorithm>
+
+#include <arrow/buffer.h>
+#include <arrow/c/bridge.h>
+#include <arrow/io/interfaces.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/message.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/util/compression.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+// Dictionaries would need dictionary batches in the stream, so dictionary
+// and constant vectors are exported flat.
+const ArrowOptions kArrowOptions{
+    .flattenDictionary = true,
+    .flattenConstant = true};
+
+void checkStatus(const ::arrow::Status& status) {
+  VELOX_CHECK(status.ok(), "Arrow IPC error: {}", status.ToString());
+}
+
+template <typename T>
+T valueOrThrow(::arrow::Result<T> result) {
+  checkStatus(result.status());
+  return std::move(result).ValueUnsafe();
+}
+
+::arrow::Compression::type toArrowCompression(common::CompressionKind kind) {
+  switch (kind) {
+    case common::CompressionKind::CompressionKind_NONE:
+      return ::arrow::Compression::UNCOMPRESSED;
+    case common::CompressionKind::CompressionKind_LZ4:
+      return ::arrow::Compression::LZ4_FRAME;
+    case common::CompressionKind::CompressionKind_ZSTD:
+      return ::arrow::Compression::ZSTD;
+    default:
+      VELOX_USER_FAIL(
+          "Unsupported Arrow IPC compression: {}",
+          common::compressionKindToString(kind));
+  }
+}
+
+::arrow::ipc::IpcWriteOptions toIpcWriteOptions(
+    const VectorSerde::Options* options) {
+  auto ipcOptions = ::arrow::ipc::IpcWriteOptions::Defaults();
+  if (options == nullptr ||
+      options->compressionKind ==
+          common::CompressionKind::CompressionKind_NONE) {
+    return ipcOptions;
+  }
+  ipcOptions.codec = valueOrThrow(::arrow::util::Codec::Create(
+      toArrowCompression(options->compressionKind)));
+  ipcOptions.min_space_savings =
+      std::clamp(1.0 - options->minCompressionRatio, 0.0, 1.0);
+  return ipcOptions;
+}
+
+// Returns true if the Arrow bridge exports 'vector' without copying it into a
+// new vector first.
+bool isExportable(const RowVector& vector) {
+  for (const auto& child : vector.children()) {
+    if (child->encoding() == VectorEncoding::Simple::CONSTANT &&
+        !child->type()->isPrimitiveType()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<::arrow::RecordBatch> toRecordBatch(
+    const RowVectorPtr& vector,
+    memory::MemoryPool* pool) {
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  exportToArrow(vector, arrowSchema, kArrowOptions);
+  exportToArrow(vector, arrowArray, pool, kArrowOptions);
+  return valueOrThrow(::arrow::ImportRecordBatch(&arrowArray, &arrowSchema));
+}
+
+std::shared_ptr<::arrow::Schema> toArrowSchema(
+    const RowTypePtr& type,
+    memory::MemoryPool* pool) {
+  ArrowSchema arrowSchema;
+  exportToArrow(BaseVector::create(type, 0, pool), arrowSchema, kArrowOptions);
+  return valueOrThrow(::arrow::ImportSchema(&arrowSchema));
+}
+
+RowVectorPtr readRecordBatch(
+    const ::arrow::ipc::Message* message,
+    const RowTypePtr& type,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK_NOT_NULL(message, "Expected an Arrow IPC message");
+  VELOX_CHECK(
+      message->type() == ::arrow::ipc::MessageType::RECORD_BATCH,
+      "Expected an Arrow IPC record batch message");
+  auto batch = valueOrThrow(::arrow::ipc::ReadRecordBatch(
+      *message,
+      toArrowSchema(type, pool),
+      /*dictionary_memo=*/nullptr,
+      ::arrow::ipc::IpcReadOptions::Defaults()));
+
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  checkStatus(::arrow::ExportRecordBatch(*batch, &arrowArray, &arrowSchema));
+  return std::static_pointer_cast<RowVector>(
+      importFromArrowAsOwner(arrowSchema, arrowArray, pool));
+}
+
+// Writes to a Velox OutputStream.
+class OutputStreamSink : public ::arrow::io::OutputStream {
+ public:
+  explicit OutputStreamSink(velox::OutputStream* out) : out_(out) {}
+
+  ::arrow::Status Write(const void* data, int64_t nbytes) override {
+    out_->write(reinterpret_cast<const char*>(data), nbytes);
+    position_ += nbytes;
+    return ::arrow::Status::OK();
+  }
+
+  ::arrow::Result<int64_t> Tell() const override {
+    return position_;
+  }
+
+  ::arrow::Status Close() override {
+    closed_ = true;
+    return ::arrow::Status::OK();
+  }
+
+  bool closed() const override {
+    return closed_;
+  }
+
+ private:
+  velox::OutputStream* const out_;
+  int64_t position_{0};
+  bool closed_{false};
+};
+
+// Reads from a Velox ByteInputStream. Reads of buffers copy the bytes since
+// the stream does not own them.
+class ByteInputStreamSource : public ::arrow::io::InputStream {
+ public:
+  explicit ByteInputStreamSource(ByteInputStream* source) : source_(source) {}
+
+  ::arrow::Result<int64_t> Read(int64_t nbytes, void* out) override {
+    const auto size = std::min<int64_t>(nbytes, source_->remainingSize());
+    source_->readBytes(reinterpret_cast<uint8_t*>(out), size);
+    position_ += size;
+    return size;
+  }
+
+  ::arrow::Result<std::shared_ptr<::arrow::Buffer>> Read(
+      int64_t nbytes) override {
+    ARROW_ASSIGN_OR_RAISE(
+        auto buffer, ::arrow::AllocateResizableBuffer(nbytes));
+    ARROW_ASSIGN_OR_RAISE(
+        const auto size, Read(nbytes, buffer->mutable_data()));
+    ARROW_RETURN_NOT_OK(buffer->Resize(size, /*shrink_to_fit=*/false));
+    return std::shared_ptr<::arrow::Buffer>(std::move(buffer));
+  }
+
+  ::arrow::Result<int64_t> Tell() const override {
+    return position_;
+  }
+
+  ::arrow::Status Close() override {
+    closed_ = true;
+    return ::arrow::Status::OK();
+  }
+
+  bool closed() const override {
+    return closed_;
+  }
+
+ private:
+  ByteInputStream* const source_;
+  int64_t position_{0};
+  bool closed_{false};
+};
+
+// An Arrow buffer over the memory of an IOBuf, which it keeps alive.
+class IOBufBuffer : public ::arrow::Buffer {
+ public:
+  explicit IOBufBuffer(std::unique_ptr<folly::IOBuf> iobuf)
+      : ::arrow::Buffer(iobuf->data(), iobuf->length()),
+        iobuf_(std::move(iobuf)) {}
+
+ private:
+  const std::unique_ptr<folly::IOBuf> iobuf_;
+};
+
+class ArrowIpcIterativeSerializer : public IterativeVectorSerializer {
+ public:
+  ArrowIpcIterativeSerializer(
+      RowTypePtr type,
+      memory::MemoryPool* pool,
+      const VectorSerde::Options* options)
+      : type_(std::move(type)),
+        pool_(pool),
+        ipcOptions_(toIpcWriteOptions(options)) {}
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      Scratch& /*scratch*/) override {
+    // A whole vector is exported as is if it is the only one.
+    if (numRows_ == 0 && ranges.size() == 1 && ranges[0].begin == 0 &&
+        ranges[0].size == vector->size() && isExportable(*vector)) {
+      rows_ = vector;
+      numRows_ = vector->size();
+      return;
+    }
+    std::vector<BaseVector::CopyRange> copyRanges;
+    copyRanges.reserve(ranges.size());
+    vector_size_t numNewRows = 0;
+    for (const auto& range : ranges) {
+      copyRanges.push_back({range.begin, numRows_ + numNewRows, range.size});
+      numNewRows += range.size;
+    }
+    appendRanges(vector, copyRanges, numNewRows);
+  }
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const vector_size_t*>& rows,
+      Scratch& /*scratch*/) override {
+    std::vector<BaseVector::CopyRange> copyRanges;
+    for (auto i = 0; i < rows.size(); ++i) {
+      const auto targetIndex = numRows_ + i;
+      if (!copyRanges.empty() &&
+          copyRanges.back().sourceIndex + copyRanges.back().count == rows[i]) {
+        ++copyRanges.back().count;
+      } else {
+        copyRanges.push_back({rows[i], targetIndex, 1});
+      }
+    }
+    appendRanges(vector, copyRanges, rows.size());
+  }
+
+  bool supportsAppendRows() const override {
+    return true;
+  }
+
+  /// Returns the exact size of the message. Compresses the body to find it out
+  /// if compression is enabled.
+  size_t maxSerializedSize() const override {
+    int64_t size = 0;
+    checkStatus(
+        ::arrow::ipc::GetRecordBatchSize(*recordBatch(), ipcOptions_, &size));
+    return size;
+  }
+
+  void flush(OutputStream* stream) override {
+    OutputStreamSink sink(stream);
+    int32_t metadataLength = 0;
+    int64_t bodyLength = 0;
+    checkStatus(::arrow::ipc::WriteRecordBatch(
+        *recordBatch(),
+        /*buffer_start_offset=*/0,
+        &sink,
+        &metadataLength,
+        &bodyLength,
+        ipcOptions_));
+  }
+
+  void clear() override {
+    rows_.reset();
+    ownsRows_ = false;
+    numRows_ = 0;
+  }
+
+ private:
+  // Copies 'ranges' of 'vector' after the first 'numRows_' rows of 'rows_'.
+  void appendRanges(
+      const RowVectorPtr& vector,
+      const std::vector<BaseVector::CopyRange>& ranges,
+      vector_size_t numNewRows) {
+    if (numNewRows == 0) {
+      return;
+    }
+    if (ownsRows_) {
+      rows_->resize(numRows_ + numNewRows);
+    } else {
+      auto rows =
+          BaseVector::create<RowVector>(type_, numRows_ + numNewRows, pool_);
+      if (rows_ != nullptr) {
+        rows->copy(rows_.get(), 0, 0, numRows_);
+      }
+      rows_ = std::move(rows);
+      ownsRows_ = true;
+    }
+    rows_->copyRanges(vector.get(), ranges);
+    numRows_ += numNewRows;
+  }
+
+  std::shared_ptr<::arrow::RecordBatch> recordBatch() const {
+    if (rows_ == nullptr) {
+      return toRecordBatch(
+          BaseVector::create<RowVector>(type_, 0, pool_), pool_);
+    }
+    return toRecordBatch(rows_, pool_);
+  }
+
+  const RowTypePtr type_;
+  memory::MemoryPool* const pool_;
+  const ::arrow::ipc::IpcWriteOptions ipcOptions_;
+
+  // The appended rows. Either an appended vector, which is not modified, or a
+  // copy of the appended rows owned by 'this'.
+  RowVectorPtr rows_;
+  bool ownsRows_{false};
+  vector_size_t numRows_{0};
+};
+
+} // namespace
+
+void ArrowIpcVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    const folly::Range<const vector_size_t*>& rows,
+    vector_size_t** sizes,
+    Scratch& /*scratch*/) {
+  if (vector->size() == 0) {
+    return;
+  }
+  const auto rowSize = vector->estimateFlatSize() / vector->size();
+  for (auto i = 0; i < rows.size(); ++i) {
+    *sizes[i] += rowSize;
+  }
+}
+
+void ArrowIpcVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes,
+    Scratch& /*scratch*/) {
+  if (vector->size() == 0) {
+    return;
+  }
+  const auto rowSize = vector->estimateFlatSize() / vector->size();
+  for (auto i = 0; i < ranges.size(); ++i) {
+    *sizes[i] += rowSize * ranges[i].size;
+  }
+}
+
+std::unique_ptr<IterativeVectorSerializer>
+ArrowIpcVectorSerde::createIterativeSerializer(
+    RowTypePtr type,
+    int32_t /*numRows*/,
+    StreamArena* streamArena,
+    const Options* options) {
+  return std::make_unique<ArrowIpcIterativeSerializer>(
+      std::move(type), streamArena->pool(), options);
+}
+
+void ArrowIpcVectorSerde::deserialize(
+    ByteInputStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    const Options* /*options*/) {
+  ByteInputStreamSource input(source);
+  const auto message = valueOrThrow(::arrow::ipc::ReadMessage(&input));
+  *result = readRecordBatch(message.get(), type, pool);
+}
+
+void ArrowIpcVectorSerde::deserializeIOBuf(
+    std::unique_ptr<folly::IOBuf> data,
+    velox::memory::MemoryPool* pool,
+    const RowTypePtr& type,
+    RowVectorPtr* result) {
+  if (data->isChained()) {
+    data->coalesce();
+  }
+  ::arrow::io::BufferReader reader(
+      std::make_shared<IOBufBuffer>(std::move(data)));
+  const auto message = valueOrThrow(::arrow::ipc::ReadMessage(&reader));
+  *result = readRecordBatch(message.get(), type, pool);
+}
+
+// static
+void ArrowIpcVectorSerde::registerVectorSerde() {
+  velox::registerVectorSerde(std::make_unique<ArrowIpcVectorSerde>());
+}
+
+// static
+void ArrowIpcVectorSerde::registerNamedVectorSerde() {
+  velox::registerNamedVectorSerde(
+      VectorSerde::Kind::kArrowIpc, std::make_unique<ArrowIpcVectorSerde>());
+}
+
+} // namespace facebook::velox::serializer
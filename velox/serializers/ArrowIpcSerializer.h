@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/io/IOBuf.h>
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer {
+
+/// Serializes RowVectors as Arrow IPC record batch messages, i.e. the messages
+/// that follow the schema message in an Arrow IPC stream. Each flush writes one
+/// message and each deserialize reads one. The schema is not written: both
+/// ends know it from the plan. Vectors are exported with the Arrow bridge and
+/// their buffers are written to the output stream as they are. The bodies can
+/// be compressed with LZ4 frames or ZSTD as defined by the Arrow format. A
+/// buffer whose compression does not reach 'minCompressionRatio' is left
+/// uncompressed.
+///
+/// Reading from a ByteInputStream copies the message once, since the stream
+/// does not own its memory. Reading from an IOBuf with 'deserializeIOBuf' does
+/// not copy uncompressed bodies: the result references the IOBuf memory.
+class ArrowIpcVectorSerde : public VectorSerde {
+ public:
+  ArrowIpcVectorSerde() : VectorSerde(VectorSerde::Kind::kArrowIpc) {}
+
+  /// Adds the average flat size of the rows of 'vector' to each of the
+  /// 'sizes'.
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      const folly::Range<const vector_size_t*>& rows,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  std::unique_ptr<IterativeVectorSerializer> createIterativeSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override;
+
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override;
+
+  /// Deserializes the message in 'data' without copying its uncompressed
+  /// buffers. 'result' keeps 'data' alive.
+  void deserializeIOBuf(
+      std::unique_ptr<folly::IOBuf> data,
+      velox::memory::MemoryPool* pool,
+      const RowTypePtr& type,
+      RowVectorPtr* result);
+
+  static void registerVectorSerde();
+  static void registerNamedVectorSerde();
+};
+
+} // namespace facebook::velox::serializer
@@ -32,6 +32,25 @@ class CompactRowVectorSerializer : public RowSerializer<row::CompactRow> {
       : RowSerializer<row::CompactRow>(pool, options) {}
 
  private:
+  void serializeRows(
+      const row::CompactRow& row,
+      const folly::Range<const vector_size_t*>& rows,
+      char* rawBuffer,
+      const std::vector<vector_size_t>& sizes) override {
+    raw_vector<size_t> offsets(rows.size());
+    size_t offset = 0;
+    for (auto i = 0; i < rows.size(); ++i) {
+      const auto rowSize = sizes[rows[i]] - sizeof(TRowSize);
+      // Write raw size. Needs to be in big endian order.
+      *reinterpret_cast<TRowSize*>(rawBuffer + offset) =
+          folly::Endian::big<TRowSize>(rowSize);
+      offsets[i] = offset + sizeof(TRowSize);
+      offset += sizes[rows[i]];
+    }
+    // Write row data for all rows column by column.
+    row.serialize(rows, offsets.data(), rawBuffer);
+  }
+
   void serializeRanges(
       const row::CompactRow& row,
       const folly::Range<const IndexRange*>& ranges,
@@ -18,12 +18,38 @@
 #include "velox/serializers/PrestoSerializerSerializationUtils.h"
 
 namespace facebook::velox::serializer::presto::detail {
+namespace {
+constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
+
+template <typename T>
+std::unique_ptr<folly::IOBuf> makeIOBuf(T value) {
+  auto iobuf = folly::IOBuf::create(sizeof(T));
+  memcpy(iobuf->writableData(), &value, sizeof(T));
+  iobuf->append(sizeof(T));
+  return iobuf;
+}
+
+bool isVariableWidthOrComplex(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::ARRAY:
+    case TypeKind::MAP:
+    case TypeKind::ROW:
+      return true;
+    default:
+      return false;
+  }
+}
+} // namespace
+
 PrestoIterativeVectorSerializer::PrestoIterativeVectorSerializer(
     const RowTypePtr& rowType,
     int32_t numRows,
     StreamArena* streamArena,
     const PrestoVectorSerde::PrestoOptions& opts)
-    : opts_(opts),
+    : rowType_(rowType),
+      opts_(opts),
       streamArena_(streamArena),
       codec_(common::compressionKindToCodec(opts.compressionKind)),
       streams_(memory::StlAllocator<VectorStream>(*streamArena->pool())) {
@@ -35,6 +61,18 @@ PrestoIterativeVectorSerializer::PrestoIterativeVectorSerializer(
     streams_.emplace_back(
         types[i], std::nullopt, std::nullopt, streamArena, numRows, opts);
   }
+
+  if (opts_.compressColumns && needCompression(*codec_)) {
+    columns_.reserve(numTypes);
+    for (const auto& type : types) {
+      const auto kind = isVariableWidthOrComplex(type) &&
+              opts_.stringCompressionKind !=
+                  common::CompressionKind::CompressionKind_NONE
+          ? opts_.stringCompressionKind
+          : opts_.compressionKind;
+      columns_.push_back({kind, common::compressionKindToCodec(kind)});
+    }
+  }
 }
 
 void PrestoIterativeVectorSerializer::append(
@@ -66,6 +104,17 @@ void PrestoIterativeVectorSerializer::append(
 }
 
 size_t PrestoIterativeVectorSerializer::maxSerializedSize() const {
+  if (!columns_.empty()) {
+    size_t dataSize = 4; // streams_.size()
+    for (auto i = 0; i < streams_.size(); ++i) {
+      // codec(1) | uncompressedSize(4) | size(4) | data
+      dataSize += 9 +
+          columns_[i].codec->maxCompressedLength(
+              const_cast<VectorStream&>(streams_[i]).serializedSize());
+    }
+    return kHeaderSize + dataSize;
+  }
+
   size_t dataSize = 4; // streams_.size()
   for (auto& stream : streams_) {
     dataSize += const_cast<VectorStream&>(stream).serializedSize();
@@ -74,6 +123,11 @@ size_t PrestoIterativeVectorSerializer::maxSerializedSize() const {
   auto compressedSize = needCompression(*codec_)
       ? codec_->maxCompressedLength(dataSize)
       : dataSize;
+  if (useZstdDictionary()) {
+    // dictionarySize(4) | dictionary | uncompressedSize(4)
+    compressedSize +=
+        2 * sizeof(int32_t) + opts_.zstdDictionary->maxDictionarySize;
+  }
   return kHeaderSize + compressedSize;
 }
 
@@ -81,8 +135,11 @@ size_t PrestoIterativeVectorSerializer::maxSerializedSize() const {
 // numRows(4) | codec(1) | uncompressedSize(4) | compressedSize(4) |
 // checksum(8) | data
 void PrestoIterativeVectorSerializer::flush(OutputStream* out) {
-  constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
-  if (!needCompression(*codec_)) {
+  if (!columns_.empty()) {
+    flushColumns(out);
+  } else if (useZstdDictionary()) {
+    flushWithDictionary(out);
+  } else if (!needCompression(*codec_)) {
     flushStreams(
         streams_,
         numRows_,
@@ -117,8 +174,180 @@ void PrestoIterativeVectorSerializer::flush(OutputStream* out) {
   }
 }
 
+void PrestoIterativeVectorSerializer::flushColumns(OutputStream* out) {
+  auto listener = dynamic_cast<PrestoOutputStreamListener*>(out->listener());
+  // Reset CRC computation
+  if (listener) {
+    listener->reset();
+  }
+  char codecMask = kColumnCompressedBitMask;
+  if (listener) {
+    codecMask |= kCheckSumBitMask;
+    // Pause CRC computation
+    listener->pause();
+  }
+  writeInt32(out, numRows_);
+
+  // The column headers and data are chained without copying the data.
+  auto data = makeIOBuf(static_cast<int32_t>(streams_.size()));
+  int32_t dataSize = sizeof(int32_t);
+  auto* pool = streamArena_->pool();
+  for (auto i = 0; i < streams_.size(); ++i) {
+    IOBufOutputStream columnOut(*pool, nullptr, streams_[i].serializedSize());
+    streams_[i].flush(&columnOut);
+    auto column = columnOut.getIOBuf();
+    const int32_t size = column->computeChainDataLength();
+
+    auto& compression = columns_[i];
+    std::unique_ptr<folly::IOBuf> compressed;
+    if (compression.numCompressionToSkip > 0) {
+      compression.stats.compressionSkippedBytes += size;
+      --compression.numCompressionToSkip;
+      ++compression.stats.numCompressionSkipped;
+    } else {
+      compressed = compression.codec->compress(column.get());
+      const int32_t compressedSize = compressed->computeChainDataLength();
+      compression.stats.compressionInputBytes += size;
+      compression.stats.compressedBytes += compressedSize;
+      if (compressedSize > size * opts_.minCompressionRatio) {
+        compressed.reset();
+        compression.numCompressionToSkip = std::min<int64_t>(
+            kMaxCompressionAttemptsToSkip,
+            1 + compression.stats.numCompressionSkipped);
+      }
+    }
+
+    const int8_t kind = compressed != nullptr
+        ? compression.kind
+        : common::CompressionKind::CompressionKind_NONE;
+    auto columnData = compressed != nullptr ? std::move(compressed)
+                                            : std::move(column);
+    const int32_t columnSize = columnData->computeChainDataLength();
+    data->prependChain(makeIOBuf(kind));
+    data->prependChain(makeIOBuf(size));
+    data->prependChain(makeIOBuf(columnSize));
+    data->prependChain(std::move(columnData));
+    dataSize += 1 + 2 * sizeof(int32_t) + columnSize;
+  }
+
+  flushSerialization(
+      numRows_, dataSize, dataSize, codecMask, data, out, listener);
+}
+
+void PrestoIterativeVectorSerializer::flushWithDictionary(OutputStream* out) {
+  auto& state = *opts_.zstdDictionary;
+  auto listener = dynamic_cast<PrestoOutputStreamListener*>(out->listener());
+  // Reset CRC computation
+  if (listener) {
+    listener->reset();
+  }
+  char codecMask = 0;
+  if (listener) {
+    codecMask |= kCheckSumBitMask;
+    // Pause CRC computation
+    listener->pause();
+  }
+  writeInt32(out, numRows_);
+
+  IOBufOutputStream dataOut(
+      *streamArena_->pool(), nullptr, streamArena_->size());
+  writeInt32(&dataOut, streams_.size());
+  for (auto& stream : streams_) {
+    stream.flush(&dataOut);
+  }
+  const int32_t uncompressedSize = dataOut.tellp();
+  auto data = dataOut.getIOBuf();
+
+  if (!state.trained) {
+    std::string sample;
+    sample.reserve(uncompressedSize);
+    for (const auto range : *data) {
+      sample.append(reinterpret_cast<const char*>(range.data()), range.size());
+    }
+    state.samples.push_back(std::move(sample));
+    if (static_cast<int32_t>(state.samples.size()) >= state.numTrainingPages) {
+      state.dictionary =
+          common::ZstdDictionary::train(state.samples, state.maxDictionarySize);
+      state.trained = true;
+      state.samples.clear();
+    }
+  }
+
+  int32_t dataSize = uncompressedSize;
+  int32_t compressedSize = uncompressedSize;
+  if (state.dictionary == nullptr) {
+    auto compressed = codec_->compress(data.get());
+    const int32_t size = compressed->computeChainDataLength();
+    if (size <= uncompressedSize * opts_.minCompressionRatio) {
+      codecMask |= kCompressedBitMask;
+      data = std::move(compressed);
+      compressedSize = size;
+    }
+  } else {
+    auto frame = state.dictionary->compress(*data);
+    const int32_t frameSize = frame->computeChainDataLength();
+    if (frameSize <= uncompressedSize * opts_.minCompressionRatio) {
+      codecMask |= kDictionaryCompressedBitMask;
+      auto compressed = folly::IOBuf::create(0);
+      if (state.shipDictionary && !state.dictionaryShipped) {
+        codecMask |= kDictionaryIncludedBitMask;
+        const auto& content = state.dictionary->content();
+        compressed->prependChain(
+            makeIOBuf(static_cast<int32_t>(content.size())));
+        compressed->prependChain(
+            folly::IOBuf::copyBuffer(content.data(), content.size()));
+        state.dictionaryShipped = true;
+      }
+      compressed->prependChain(makeIOBuf(uncompressedSize));
+      compressed->prependChain(std::move(frame));
+      data = std::move(compressed);
+      // The sizes in the header are those of the data as written, like for
+      // 'kColumnCompressedBitMask'.
+      dataSize = data->computeChainDataLength();
+      compressedSize = dataSize;
+    }
+  }
+  stats_.compressionInputBytes += uncompressedSize;
+  stats_.compressedBytes += compressedSize;
+
+  flushSerialization(
+      numRows_, dataSize, compressedSize, codecMask, data, out, listener);
+}
+
 std::unordered_map<std::string, RuntimeCounter>
 PrestoIterativeVectorSerializer::runtimeStats() {
+  if (!columns_.empty()) {
+    // The totals over the columns and the bytes of each column by name, e.g.
+    // 'compressedBytes.c0'.
+    std::unordered_map<std::string, RuntimeCounter> map;
+    CompressionStats total;
+    const auto addBytes = [&](const std::string& name, int64_t bytes) {
+      if (bytes != 0) {
+        map.emplace(name, RuntimeCounter(bytes, RuntimeCounter::Unit::kBytes));
+      }
+    };
+    for (auto i = 0; i < columns_.size(); ++i) {
+      const auto& stats = columns_[i].stats;
+      const auto& name = rowType_->nameOf(i);
+      addBytes(
+          fmt::format("{}.{}", kCompressionInputBytes, name),
+          stats.compressionInputBytes);
+      addBytes(
+          fmt::format("{}.{}", kCompressedBytes, name), stats.compressedBytes);
+      addBytes(
+          fmt::format("{}.{}", kCompressionSkippedBytes, name),
+          stats.compressionSkippedBytes);
+      total.compressionInputBytes += stats.compressionInputBytes;
+      total.compressedBytes += stats.compressedBytes;
+      total.compressionSkippedBytes += stats.compressionSkippedBytes;
+    }
+    addBytes(kCompressionInputBytes, total.compressionInputBytes);
+    addBytes(kCompressedBytes, total.compressedBytes);
+    addBytes(kCompressionSkippedBytes, total.compressionSkippedBytes);
+    return map;
+  }
+
+
   std::unordered_map<std::string, RuntimeCounter> map;
   if (stats_.compressionInputBytes != 0) {
     map.emplace(
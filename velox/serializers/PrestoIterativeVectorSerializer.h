@@ -51,9 +51,36 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   void clear() override;
 
  private:
+  // Compression state of a top level column if 'opts_.compressColumns' is set.
+  struct ColumnCompression {
+    common::CompressionKind kind;
+    std::unique_ptr<folly::compression::Codec> codec;
+    // Count of forthcoming compressions of the column to skip.
+    int32_t numCompressionToSkip{0};
+    CompressionStats stats;
+  };
+
+  // Writes the page with each column compressed on its own. See
+  // 'kColumnCompressedBitMask' for the layout.
+  void flushColumns(OutputStream* out);
+
+  // Writes the page compressed with the ZSTD dictionary of
+  // 'opts_.zstdDictionary' or, while the dictionary is being trained, with
+  // 'codec_'. See 'kDictionaryCompressedBitMask' for the layout.
+  void flushWithDictionary(OutputStream* out);
+
+  bool useZstdDictionary() const {
+    return opts_.zstdDictionary != nullptr &&
+        opts_.compressionKind == common::CompressionKind::CompressionKind_ZSTD;
+  }
+
+  const RowTypePtr rowType_;
   const PrestoVectorSerde::PrestoOptions opts_;
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::compression::Codec> codec_;
+  // One per top level column if the columns are compressed one by one,
+  // otherwise empty.
+  std::vector<ColumnCompression> columns_;
 
   int32_t numRows_{0};
   std::vector<VectorStream, memory::StlAllocator<VectorStream>> streams_;
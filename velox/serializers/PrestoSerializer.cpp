@@ -17,6 +17,7 @@
 
 #include <optional>
 
+#include <folly/container/F14Map.h>
 #include <folly/lang/Bits.h>
 
 #include "velox/common/base/Crc.h"
@@ -79,6 +80,67 @@ int64_t computeChecksum(
   return checksum;
 }
 
+// Reads the data of a page with 'kColumnCompressedBitMask' from 'source' and
+// returns it with the columns uncompressed.
+std::unique_ptr<folly::IOBuf> readCompressedColumns(ByteInputStream* source) {
+  const auto numColumns = source->read<int32_t>();
+  auto data = folly::IOBuf::create(sizeof(int32_t));
+  memcpy(data->writableData(), &numColumns, sizeof(int32_t));
+  data->append(sizeof(int32_t));
+
+  // The codecs used so far, by compression kind.
+  folly::F14FastMap<int8_t, std::unique_ptr<folly::compression::Codec>> codecs;
+  for (auto i = 0; i < numColumns; ++i) {
+    const auto kind = source->read<int8_t>();
+    const auto uncompressedSize = source->read<int32_t>();
+    const auto size = source->read<int32_t>();
+    auto column = folly::IOBuf::create(size);
+    source->readBytes(column->writableData(), size);
+    column->append(size);
+    if (kind != common::CompressionKind::CompressionKind_NONE) {
+      auto& codec = codecs[kind];
+      if (codec == nullptr) {
+        codec = common::compressionKindToCodec(
+            static_cast<common::CompressionKind>(kind));
+      }
+      column = codec->uncompress(column.get(), uncompressedSize);
+    }
+    data->prependChain(std::move(column));
+  }
+  return data;
+}
+
+// Reads the 'size' bytes of data of a page with 'kDictionaryCompressedBitMask'
+// from 'source' and returns them decompressed. Keeps the dictionary that the
+// page carries in 'options.zstdDictionary' for the following pages.
+std::unique_ptr<folly::IOBuf> readDictionaryCompressed(
+    ByteInputStream* source,
+    int8_t codecMarker,
+    int32_t size,
+    const SerdeOpts& options) {
+  VELOX_CHECK_NOT_NULL(
+      options.zstdDictionary,
+      "A page compressed with a ZSTD dictionary needs a dictionary state");
+  auto& state = *options.zstdDictionary;
+  if (detail::isDictionaryIncludedBitSet(codecMarker)) {
+    const auto dictionarySize = source->read<int32_t>();
+    std::string content(dictionarySize, '\0');
+    source->readBytes(content.data(), dictionarySize);
+    state.dictionary =
+        std::make_shared<common::ZstdDictionary>(std::move(content));
+    size -= sizeof(int32_t) + dictionarySize;
+  }
+  VELOX_CHECK_NOT_NULL(
+      state.dictionary,
+      "A page compressed with a ZSTD dictionary precedes the dictionary");
+  const auto uncompressedSize = source->read<int32_t>();
+  size -= sizeof(int32_t);
+  auto frame = folly::IOBuf::create(size);
+  source->readBytes(frame->writableData(), size);
+  frame->append(size);
+  return state.dictionary->decompress(*frame, uncompressedSize);
+}
+
 PrestoVectorSerde::PrestoOptions toPrestoOptions(
     const VectorSerde::Options* options) {
   if (options == nullptr) {
@@ -178,7 +240,20 @@ void PrestoVectorSerde::deserialize(
   VELOX_CHECK_EQ(
       header.checksum, actualCheckSum, "Received corrupted serialized page.");
 
-  if (!detail::isCompressedBitSet(header.pageCodecMarker)) {
+  if (detail::isColumnCompressedBitSet(header.pageCodecMarker)) {
+    const auto data = readCompressedColumns(source);
+    auto uncompressedSource =
+        std::make_unique<BufferInputStream>(byteRangesFromIOBuf(data.get()));
+    detail::readTopColumns(
+        *uncompressedSource, type, pool, *result, resultOffset, prestoOptions);
+  } else if (detail::isDictionaryCompressedBitSet(header.pageCodecMarker)) {
+    const auto data = readDictionaryCompressed(
+        source, header.pageCodecMarker, header.compressedSize, prestoOptions);
+    auto uncompressedSource =
+        std::make_unique<BufferInputStream>(byteRangesFromIOBuf(data.get()));
+    detail::readTopColumns(
+        *uncompressedSource, type, pool, *result, resultOffset, prestoOptions);
+  } else if (!detail::isCompressedBitSet(header.pageCodecMarker)) {
     detail::readTopColumns(
         *source, type, pool, *result, resultOffset, prestoOptions);
   } else {
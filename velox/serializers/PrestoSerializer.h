@@ -19,6 +19,7 @@
 
 #include "velox/common/base/Crc.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 #include "velox/serializers/PrestoVectorLexer.h"
 #include "velox/vector/VectorStream.h"
 
@@ -48,6 +49,37 @@ namespace facebook::velox::serializer::presto {
 /// serializeSingleColumn() directly.
 class PrestoVectorSerde : public VectorSerde {
  public:
+  /// The ZSTD dictionary of a stream of pages, e.g. a spill file. The pages
+  /// of a stream are written in order by one serializer at a time and read in
+  /// order by one deserializer, each side with its own state. The writer
+  /// trains the dictionary on the first 'numTrainingPages' pages, which it
+  /// compresses without a dictionary, and compresses the following pages with
+  /// it. Not thread-safe.
+  struct ZstdDictionaryState {
+    /// The number of pages to train the dictionary on.
+    int32_t numTrainingPages{4};
+
+    /// The max size of the dictionary in bytes.
+    int32_t maxDictionarySize{32 << 10};
+
+    /// If true, the first page compressed with the dictionary carries it.
+    /// Otherwise the reader gets 'dictionary' from the writer some other way,
+    /// e.g. with the metadata of a spill file.
+    bool shipDictionary{true};
+
+    /// The pages sampled for training so far. Cleared after training.
+    std::vector<std::string> samples;
+
+    /// True after training, also if training did not produce a dictionary.
+    bool trained{false};
+
+    /// The dictionary trained by the writer or received by the reader.
+    std::shared_ptr<common::ZstdDictionary> dictionary;
+
+    /// True once the writer has shipped 'dictionary' in a page.
+    bool dictionaryShipped{false};
+  };
+
   // Input options that the serializer recognizes.
   struct PrestoOptions : VectorSerde::Options {
     PrestoOptions() = default;
@@ -80,6 +112,28 @@ class PrestoVectorSerde : public VectorSerde {
     /// affect the encoding of the input vectors. This is only relevant when
     /// using BatchVectorSerializer.
     bool preserveEncodings{false};
+
+    /// If true and 'compressionKind' is not NONE, IterativeVectorSerializer
+    /// compresses the stream of each top level column on its own instead of
+    /// the whole page: the columns of variable width and complex types with
+    /// 'stringCompressionKind' and the other columns with 'compressionKind'.
+    /// A column which does not compress to 'minCompressionRatio' is written
+    /// uncompressed and skips compression for a number of the next flushes
+    /// growing with the number of times it did not compress. The pages can
+    /// only be read by Velox.
+    bool compressColumns{false};
+
+    /// The compression kind for the columns of variable width and complex
+    /// types if 'compressColumns' is true. NONE means 'compressionKind'.
+    common::CompressionKind stringCompressionKind{
+        common::CompressionKind::CompressionKind_NONE};
+
+    /// If set and 'compressionKind' is ZSTD, IterativeVectorSerializer
+    /// compresses the pages of a stream with a ZSTD dictionary trained on the
+    /// first pages, see ZstdDictionaryState. Small pages compress several
+    /// times better this way. Ignored if 'compressColumns' is true. The pages
+    /// can only be read by Velox, in order, with a state of their own.
+    std::shared_ptr<ZstdDictionaryState> zstdDictionary;
   };
 
   PrestoVectorSerde() : VectorSerde(Kind::kPresto) {}
@@ -33,6 +33,18 @@ inline bool isChecksumBitSet(int8_t codec) {
   return (codec & kCheckSumBitMask) == kCheckSumBitMask;
 }
 
+inline bool isColumnCompressedBitSet(int8_t codec) {
+  return (codec & kColumnCompressedBitMask) == kColumnCompressedBitMask;
+}
+
+inline bool isDictionaryCompressedBitSet(int8_t codec) {
+  return (codec & kDictionaryCompressedBitMask) == kDictionaryCompressedBitMask;
+}
+
+inline bool isDictionaryIncludedBitSet(int8_t codec) {
+  return (codec & kDictionaryIncludedBitMask) == kDictionaryIncludedBitMask;
+}
+
 void readTopColumns(
     ByteInputStream& source,
     const RowTypePtr& type,
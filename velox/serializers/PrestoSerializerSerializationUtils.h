@@ -30,6 +30,15 @@ namespace facebook::velox::serializer::presto::detail {
 constexpr int8_t kCompressedBitMask = 1;
 constexpr int8_t kEncryptedBitMask = 2;
 constexpr int8_t kCheckSumBitMask = 4;
+// Velox extension. The data is the number of columns followed by each column
+// as codec(1) | uncompressedSize(4) | size(4) | data, where codec is the
+// common::CompressionKind of the column or NONE if it is not compressed.
+constexpr int8_t kColumnCompressedBitMask = 8;
+// Velox extension. The data is compressed with the ZSTD dictionary of the
+// stream as [dictionarySize(4) | dictionary] | uncompressedSize(4) | frame,
+// where the dictionary is present if 'kDictionaryIncludedBitMask' is set.
+constexpr int8_t kDictionaryCompressedBitMask = 16;
+constexpr int8_t kDictionaryIncludedBitMask = 32;
 // uncompressed size comes after the number of rows and the codec
 constexpr int32_t kSizeInBytesOffset{4 + 1};
 // There header for a page is:
@@ -107,16 +107,7 @@ class RowSerializer : public IterativeVectorSerializer {
     auto* rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
-    size_t offset = 0;
-    for (auto& row : rows) {
-      // Write row data.
-      const TRowSize size =
-          compactRow.serialize(row, rawBuffer + offset + sizeof(TRowSize));
-
-      // Write raw size. Needs to be in big endian order.
-      *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-      offset += sizeof(TRowSize) + size;
-    }
+    serializeRows(compactRow, rows, rawBuffer, sizes);
   }
 
   size_t maxSerializedSize() const override {
@@ -194,6 +185,25 @@ class RowSerializer : public IterativeVectorSerializer {
   void clear() override {}
 
  protected:
+  // Serializes 'rows' into 'rawBuffer'. 'sizes' are the serialized sizes
+  // including the row size prefix, indexed by row.
+  virtual void serializeRows(
+      const Serializer& rowSerializer,
+      const folly::Range<const vector_size_t*>& rows,
+      char* rawBuffer,
+      const std::vector<vector_size_t>& /*sizes*/) {
+    size_t offset = 0;
+    for (auto& row : rows) {
+      // Write row data.
+      const TRowSize size =
+          rowSerializer.serialize(row, rawBuffer + offset + sizeof(TRowSize));
+
+      // Write raw size. Needs to be in big endian order.
+      *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
+      offset += sizeof(TRowSize) + size;
+    }
+  }
+
   virtual void serializeRanges(
       const Serializer& rowSerializer,
       const folly::Range<const IndexRange*>& ranges,
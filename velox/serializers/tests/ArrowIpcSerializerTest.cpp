@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowIpcSerializer.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+class ArrowIpcSerializerTest
+    : public ::testing::Test,
+      public velox::test::VectorTestBase,
+      public testing::WithParamInterface<common::CompressionKind> {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  void SetUp() override {
+    deregisterNamedVectorSerde(VectorSerde::Kind::kArrowIpc);
+    ArrowIpcVectorSerde::registerNamedVectorSerde();
+    serde_ = static_cast<ArrowIpcVectorSerde*>(
+        getNamedVectorSerde(VectorSerde::Kind::kArrowIpc));
+    ASSERT_EQ(serde_->kind(), VectorSerde::Kind::kArrowIpc);
+    options_ = std::make_unique<VectorSerde::Options>(GetParam(), 0.8);
+  }
+
+  void TearDown() override {
+    deregisterNamedVectorSerde(VectorSerde::Kind::kArrowIpc);
+  }
+
+  bool isCompressed() const {
+    return GetParam() != common::CompressionKind::CompressionKind_NONE;
+  }
+
+  RowVectorPtr makeData(vector_size_t size, int32_t seed = 0) {
+    return makeRowVector(
+        {makeFlatVector<int64_t>(
+             size, [&](auto row) { return row * 3 + seed; }, nullEvery(7)),
+         makeFlatVector<double>(size, [&](auto row) { return row * 0.5; }),
+         makeFlatVector<bool>(size, [&](auto row) { return row % 3 == 0; }),
+         makeFlatVector<std::string>(
+             size,
+             [&](auto row) {
+               return std::string(row % 20, 'a' + (row + seed) % 26);
+             },
+             nullEvery(5)),
+         makeArrayVector<int32_t>(
+             size,
+             [](auto row) { return row % 4; },
+             [](auto row, auto index) { return row + index; },
+             nullEvery(9)),
+         makeRowVector({makeFlatVector<int32_t>(
+             size, [&](auto row) { return row + seed; }, nullEvery(3))})});
+  }
+
+  // Appends 'ranges' of each of 'vectors' to one serializer and returns the
+  // flushed message.
+  std::string serialize(
+      const std::vector<RowVectorPtr>& vectors,
+      const std::vector<std::vector<IndexRange>>& ranges) {
+    StreamArena arena(pool());
+    auto serializer = serde_->createIterativeSerializer(
+        asRowType(vectors[0]->type()), 0, &arena, options_.get());
+    for (auto i = 0; i < vectors.size(); ++i) {
+      serializer->append(
+          vectors[i], folly::Range(ranges[i].data(), ranges[i].size()));
+    }
+    const auto size = serializer->maxSerializedSize();
+    std::ostringstream output;
+    OStreamOutputStream out(&output);
+    serializer->flush(&out);
+    EXPECT_EQ(size, output.str().size());
+    return output.str();
+  }
+
+  std::string serialize(const RowVectorPtr& vector) {
+    return serialize({vector}, {{IndexRange{0, vector->size()}}});
+  }
+
+  // Returns a stream over 'input' split into small ranges.
+  std::unique_ptr<ByteInputStream> toByteStream(
+      const std::string& input,
+      size_t rangeSize = 32) {
+    auto* rawBytes =
+        reinterpret_cast<uint8_t*>(const_cast<char*>(input.data()));
+    std::vector<ByteRange> ranges;
+    for (size_t offset = 0; offset < input.size(); offset += rangeSize) {
+      ranges.push_back(
+          {rawBytes + offset,
+           static_cast<int32_t>(std::min(rangeSize, input.size() - offset)),
+           0});
+    }
+    return std::make_unique<BufferInputStream>(std::move(ranges));
+  }
+
+  RowVectorPtr deserialize(const std::string& input, const RowTypePtr& type) {
+    auto source = toByteStream(input);
+    RowVectorPtr result;
+    serde_->deserialize(source.get(), pool(), type, &result, options_.get());
+    EXPECT_TRUE(source->atEnd());
+    return result;
+  }
+
+  ArrowIpcVectorSerde* serde_;
+  std::unique_ptr<VectorSerde::Options> options_;
+};
+
+TEST_P(ArrowIpcSerializerTest, roundTrip) {
+  for (auto size : {0, 1, 10, 1'000}) {
+    SCOPED_TRACE(fmt::format("size: {}", size));
+    const auto data = makeData(size);
+    const auto result = deserialize(serialize(data), asRowType(data->type()));
+    velox::test::assertEqualVectors(data, result);
+  }
+}
+
+TEST_P(ArrowIpcSerializerTest, encodings) {
+  const auto size = 100;
+  const auto data = makeData(size);
+  const auto indices = makeIndicesInReverse(size);
+  const auto encoded = makeRowVector(
+      {wrapInDictionary(indices, data->childAt(0)),
+       BaseVector::wrapInConstant(size, 3, data->childAt(1)),
+       data->childAt(2),
+       wrapInDictionary(indices, data->childAt(3)),
+       data->childAt(4),
+       data->childAt(5)});
+  const auto result =
+      deserialize(serialize(encoded), asRowType(encoded->type()));
+  velox::test::assertEqualVectors(encoded, result);
+}
+
+TEST_P(ArrowIpcSerializerTest, appendRanges) {
+  const auto first = makeData(100);
+  const auto second = makeData(50, 11);
+  const std::vector<std::vector<IndexRange>> ranges = {
+      {{0, 10}, {20, 5}, {99, 1}}, {{3, 30}}};
+  const auto result = deserialize(
+      serialize({first, second}, ranges), asRowType(first->type()));
+
+  auto expected = BaseVector::create<RowVector>(first->type(), 46, pool());
+  vector_size_t offset = 0;
+  for (auto i = 0; i < 2; ++i) {
+    const auto& source = i == 0 ? first : second;
+    for (const auto& range : ranges[i]) {
+      expected->copy(source.get(), offset, range.begin, range.size);
+      offset += range.size;
+    }
+  }
+  velox::test::assertEqualVectors(expected, result);
+}
+
+TEST_P(ArrowIpcSerializerTest, appendRows) {
+  const auto data = makeData(100);
+  std::vector<vector_size_t> rows;
+  for (auto row = 0; row < data->size(); row += 3) {
+    rows.push_back(row);
+  }
+  rows.push_back(data->size() - 1);
+
+  StreamArena arena(pool());
+  auto serializer = serde_->createIterativeSerializer(
+      asRowType(data->type()), rows.size(), &arena, options_.get());
+  ASSERT_TRUE(serializer->supportsAppendRows());
+  Scratch scratch;
+  serializer->append(data, folly::Range(rows.data(), rows.size()), scratch);
+  std::ostringstream output;
+  OStreamOutputStream out(&output);
+  serializer->flush(&out);
+
+  const auto result = deserialize(output.str(), asRowType(data->type()));
+  velox::test::assertEqualVectors(
+      wrapInDictionary(makeIndices(rows), data), result);
+}
+
+TEST_P(ArrowIpcSerializerTest, multipleMessages) {
+  const auto first = makeData(100);
+  const auto second = makeData(30, 5);
+  const auto input = serialize(first) + serialize(second);
+
+  auto source = toByteStream(input);
+  const auto type = asRowType(first->type());
+  RowVectorPtr result;
+  serde_->deserialize(source.get(), pool(), type, &result, options_.get());
+  velox::test::assertEqualVectors(first, result);
+  serde_->deserialize(source.get(), pool(), type, &result, options_.get());
+  velox::test::assertEqualVectors(second, result);
+  ASSERT_TRUE(source->atEnd());
+}
+
+TEST_P(ArrowIpcSerializerTest, deserializeIOBuf) {
+  const auto data = makeData(1'000);
+  const auto input = serialize(data);
+  auto iobuf = folly::IOBuf::copyBuffer(input.data(), input.size());
+  const auto* begin = iobuf->data();
+  const auto* end = begin + iobuf->length();
+
+  RowVectorPtr result;
+  serde_->deserializeIOBuf(
+      std::move(iobuf), pool(), asRowType(data->type()), &result);
+  velox::test::assertEqualVectors(data, result);
+
+  // Uncompressed fixed width values are not copied.
+  if (!isCompressed()) {
+    const auto* values = reinterpret_cast<const uint8_t*>(
+        result->childAt(1)->asFlatVector<double>()->rawValues());
+    ASSERT_GE(values, begin);
+    ASSERT_LT(values, end);
+  }
+}
+
+TEST_P(ArrowIpcSerializerTest, compressedSize) {
+  const auto data = makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [](auto /*row*/) { return 1; })});
+  const auto input = serialize(data);
+  if (isCompressed()) {
+    ASSERT_LT(input.size(), 10'000 * sizeof(int64_t));
+  } else {
+    ASSERT_GT(input.size(), 10'000 * sizeof(int64_t));
+  }
+}
+
+TEST_P(ArrowIpcSerializerTest, unsupportedCompression) {
+  const VectorSerde::Options options(
+      common::CompressionKind::CompressionKind_SNAPPY, 0.8);
+  StreamArena arena(pool());
+  VELOX_ASSERT_USER_THROW(
+      serde_->createIterativeSerializer(
+          ROW({"c0"}, {BIGINT()}), 0, &arena, &options),
+      "Unsupported Arrow IPC compression: snappy");
+}
+
+VELOX_INSTANTIATE_TEST_SUITE_P(
+    ArrowIpcSerializerTest,
+    ArrowIpcSerializerTest,
+    ::testing::Values(
+        common::CompressionKind::CompressionKind_NONE,
+        common::CompressionKind::CompressionKind_LZ4,
+        common::CompressionKind::CompressionKind_ZSTD));
+
+} // namespace
+} // namespace facebook::velox::serializer
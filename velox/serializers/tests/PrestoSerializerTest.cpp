@@ -16,6 +16,7 @@
 #include "velox/serializers/PrestoSerializer.h"
 #include <boost/random/uniform_int_distribution.hpp>
 #include <folly/Random.h>
+#include <folly/hash/Hash.h>
 #include <gtest/gtest.h>
 #include <vector>
 #include "folly/experimental/EventCount.h"
@@ -1826,6 +1827,174 @@ TEST_F(PrestoSerializerTest, serdeSingleColumn) {
   }
 }
 
+TEST_F(PrestoSerializerTest, compressColumns) {
+  // A string and an integer column which compress and a column of random
+  // integers which does not.
+  const auto data = makeRowVector(
+      {"s", "i", "r"},
+      {makeFlatVector<std::string>(
+           10'000,
+           [](auto row) { return fmt::format("string value {}", row % 10); }),
+       makeFlatVector<int32_t>(10'000, [](auto row) { return row % 7; }),
+       makeFlatVector<int64_t>(10'000, [](auto row) {
+         return folly::hash::twang_mix64(row);
+       })});
+  const auto rowType = asRowType(data->type());
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.compressionKind = common::CompressionKind::CompressionKind_LZ4;
+  options.stringCompressionKind = common::CompressionKind::CompressionKind_ZSTD;
+  options.compressColumns = true;
+
+  auto arena = std::make_unique<StreamArena>(pool_.get());
+  auto serializer = serde_->createIterativeSerializer(
+      rowType, data->size(), arena.get(), &options);
+  std::vector<std::string> pages;
+  for (auto i = 0; i < 2; ++i) {
+    serializer->append(data);
+    const auto maxSize = serializer->maxSerializedSize();
+    std::ostringstream output;
+    serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializer->flush(&out);
+    pages.push_back(output.str());
+    ASSERT_LE(pages.back().size(), maxSize);
+    serializer->clear();
+  }
+
+  for (const auto& page : pages) {
+    auto byteStream = toByteStream(page);
+    RowVectorPtr result;
+    serde_->deserialize(
+        byteStream.get(), pool_.get(), rowType, &result, 0, &options);
+    assertEqualVectors(data, result);
+  }
+
+  // The random column is compressed on the first page and skips compression
+  // on the second. The other columns are compressed on both.
+  const auto stats = serializer->runtimeStats();
+  ASSERT_EQ(
+      stats.at("compressionInputBytes.r").value,
+      stats.at("compressionSkippedBytes.r").value);
+  for (const auto* name : {"s", "i"}) {
+    SCOPED_TRACE(name);
+    ASSERT_EQ(stats.count(fmt::format("compressionSkippedBytes.{}", name)), 0);
+    ASSERT_LT(
+        stats.at(fmt::format("compressedBytes.{}", name)).value * 4,
+        stats.at(fmt::format("compressionInputBytes.{}", name)).value);
+  }
+  ASSERT_EQ(
+      stats.at("compressionSkippedBytes").value,
+      stats.at("compressionSkippedBytes.r").value);
+}
+
+TEST_F(PrestoSerializerTest, zstdDictionary) {
+  using ZstdDictionaryState =
+      serializer::presto::PrestoVectorSerde::ZstdDictionaryState;
+  constexpr int32_t kNumPages = 24;
+  constexpr int32_t kNumTrainingPages = 8;
+  // Small pages with similar content that compress poorly on their own.
+  std::vector<RowVectorPtr> data;
+  for (auto page = 0; page < kNumPages; ++page) {
+    data.push_back(makeRowVector(
+        {"s", "i"},
+        {makeFlatVector<std::string>(
+             100,
+             [&](auto row) {
+               return fmt::format(
+                   "customer#{:09} of nation {} in segment {}",
+                   (page * 100 + row) * 7 % 1'000,
+                   row % 25,
+                   row % 5);
+             }),
+         makeFlatVector<int64_t>(
+             100, [&](auto row) { return page * 100 + row; })}));
+  }
+  const auto rowType = asRowType(data[0]->type());
+
+  const auto serialize =
+      [&](const std::shared_ptr<ZstdDictionaryState>& state) {
+        serializer::presto::PrestoVectorSerde::PrestoOptions options;
+        options.compressionKind = common::CompressionKind::CompressionKind_ZSTD;
+        options.zstdDictionary = state;
+        std::vector<std::string> pages;
+        for (const auto& vector : data) {
+          auto arena = std::make_unique<StreamArena>(pool_.get());
+          auto serializer = serde_->createIterativeSerializer(
+              rowType, vector->size(), arena.get(), &options);
+          serializer->append(vector);
+          const auto maxSize = serializer->maxSerializedSize();
+          std::ostringstream output;
+          serializer::presto::PrestoOutputStreamListener listener;
+          OStreamOutputStream out(&output, &listener);
+          serializer->flush(&out);
+          pages.push_back(output.str());
+          EXPECT_LE(pages.back().size(), maxSize);
+        }
+        return pages;
+      };
+  const auto bytesAfterTraining = [&](const std::vector<std::string>& pages) {
+    uint64_t bytes{0};
+    for (auto i = kNumTrainingPages; i < pages.size(); ++i) {
+      bytes += pages[i].size();
+    }
+    return bytes;
+  };
+
+  auto writerState = std::make_shared<ZstdDictionaryState>();
+  writerState->numTrainingPages = kNumTrainingPages;
+  writerState->maxDictionarySize = 8 << 10;
+  const auto pages = serialize(writerState);
+  ASSERT_TRUE(writerState->trained);
+  ASSERT_NE(writerState->dictionary, nullptr);
+  ASSERT_TRUE(writerState->dictionaryShipped);
+  ASSERT_TRUE(writerState->samples.empty());
+  ASSERT_LT(bytesAfterTraining(pages), bytesAfterTraining(serialize(nullptr)));
+
+  // The reader gets the dictionary from the first page compressed with it.
+  serializer::presto::PrestoVectorSerde::PrestoOptions readOptions;
+  readOptions.compressionKind = common::CompressionKind::CompressionKind_ZSTD;
+  readOptions.zstdDictionary = std::make_shared<ZstdDictionaryState>();
+  for (auto i = 0; i < pages.size(); ++i) {
+    SCOPED_TRACE(i);
+    auto byteStream = toByteStream(pages[i]);
+    RowVectorPtr result;
+    serde_->deserialize(
+        byteStream.get(), pool_.get(), rowType, &result, 0, &readOptions);
+    assertEqualVectors(data[i], result);
+  }
+  ASSERT_EQ(
+      readOptions.zstdDictionary->dictionary->id(),
+      writerState->dictionary->id());
+
+  // A page after the one carrying the dictionary can not be read without it.
+  auto byteStream = toByteStream(pages.back());
+  RowVectorPtr result;
+  readOptions.zstdDictionary = std::make_shared<ZstdDictionaryState>();
+  VELOX_ASSERT_THROW(
+      serde_->deserialize(
+          byteStream.get(), pool_.get(), rowType, &result, 0, &readOptions),
+      "A page compressed with a ZSTD dictionary precedes the dictionary");
+
+  // Without shipping, the reader is given the dictionary of the writer.
+  writerState = std::make_shared<ZstdDictionaryState>();
+  writerState->numTrainingPages = kNumTrainingPages;
+  writerState->maxDictionarySize = 8 << 10;
+  writerState->shipDictionary = false;
+  const auto unshippedPages = serialize(writerState);
+  ASSERT_FALSE(writerState->dictionaryShipped);
+  readOptions.zstdDictionary = std::make_shared<ZstdDictionaryState>();
+  readOptions.zstdDictionary->dictionary = writerState->dictionary;
+  for (auto i = 0; i < unshippedPages.size(); ++i) {
+    SCOPED_TRACE(i);
+    auto byteStream = toByteStream(unshippedPages[i]);
+    RowVectorPtr result;
+    serde_->deserialize(
+        byteStream.get(), pool_.get(), rowType, &result, 0, &readOptions);
+    assertEqualVectors(data[i], result);
+  }
+}
+
 TEST_P(PrestoSerializerTest, nullVector) {
   std::ostringstream out;
   facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
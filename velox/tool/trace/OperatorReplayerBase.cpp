@@ -14,10 +14,13 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
 #include <folly/json.h>
 
 #include <utility>
 
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/time/Timer.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/TaskTraceReader.h"
@@ -145,13 +148,81 @@ OperatorReplayerBase::replayNodeFactory(const core::PlanNode* node) const {
 }
 
 void OperatorReplayerBase::printStats(
-    const std::shared_ptr<exec::Task>& task) const {
+    const std::shared_ptr<exec::Task>& task) {
   const auto planStats = exec::toPlanStats(task->taskStats());
   const auto& stats = planStats.at(replayPlanNodeId_);
+  lastRunStats_ = BenchmarkStats{
+      .cpuNanos = stats.cpuWallTiming.cpuNanos,
+      .inputRows = stats.inputRows,
+      .inputBytes = stats.inputBytes,
+      .peakMemoryBytes = stats.peakMemoryBytes,
+      .spilledBytes = stats.spilledBytes};
+  if (benchmarking_) {
+    return;
+  }
   for (const auto& [name, operatorStats] : stats.operatorStats) {
     LOG(INFO) << "Stats of replaying operator " << name << " : "
               << operatorStats->toString();
   }
   LOG(INFO) << "Memory usage: " << task->pool()->treeMemoryUsage(false);
 }
+
+std::string OperatorReplayerBase::BenchmarkStats::toString() const {
+  const auto seconds = wallNanos / 1'000'000'000.0;
+  return fmt::format(
+      "wall {} cpu {} input {} rows {} ({} rows/s, {}/s) peak memory {} "
+      "spilled {}",
+      succinctNanos(wallNanos),
+      succinctNanos(cpuNanos),
+      inputRows,
+      succinctBytes(inputBytes),
+      seconds > 0 ? static_cast<uint64_t>(inputRows / seconds) : 0,
+      succinctBytes(seconds > 0 ? inputBytes / seconds : 0),
+      succinctBytes(peakMemoryBytes),
+      succinctBytes(spilledBytes));
+}
+
+std::vector<OperatorReplayerBase::BenchmarkStats>
+OperatorReplayerBase::benchmark(uint32_t numIterations) {
+  VELOX_USER_CHECK_GT(numIterations, 0);
+  benchmarking_ = true;
+  SCOPE_EXIT {
+    benchmarking_ = false;
+  };
+  std::vector<BenchmarkStats> runs;
+  runs.reserve(numIterations);
+  for (auto i = 0; i < numIterations; ++i) {
+    lastRunStats_.reset();
+    uint64_t wallNanos{0};
+    {
+      NanosecondTimer timer(&wallNanos);
+      run(/*copyResults=*/false);
+    }
+    VELOX_CHECK(lastRunStats_.has_value());
+    lastRunStats_->wallNanos = wallNanos;
+    LOG(INFO) << "Run " << i << " of " << operatorType_ << " node " << nodeId_
+              << ": " << lastRunStats_->toString();
+    runs.push_back(*lastRunStats_);
+  }
+
+  // The averages of the runs, except for the peak memory, which is the
+  // largest of the runs.
+  BenchmarkStats mean;
+  uint64_t minWallNanos = std::numeric_limits<uint64_t>::max();
+  for (const auto& run : runs) {
+    mean.wallNanos += run.wallNanos / numIterations;
+    mean.cpuNanos += run.cpuNanos / numIterations;
+    mean.inputRows += run.inputRows / numIterations;
+    mean.inputBytes += run.inputBytes / numIterations;
+    mean.peakMemoryBytes =
+        std::max(mean.peakMemoryBytes, run.peakMemoryBytes);
+    mean.spilledBytes += run.spilledBytes / numIterations;
+    minWallNanos = std::min(minWallNanos, run.wallNanos);
+  }
+  LOG(INFO) << "Replayed " << operatorType_ << " node " << nodeId_ << " "
+            << numIterations << " times with " << driverIds_.size()
+            << " drivers, mean " << mean.toString() << ", min wall "
+            << succinctNanos(minWallNanos);
+  return runs;
+}
 } // namespace facebook::velox::tool::trace
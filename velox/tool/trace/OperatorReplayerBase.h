@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "velox/common/file/FileSystems.h"
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
@@ -47,6 +49,24 @@ class OperatorReplayerBase {
 
   virtual RowVectorPtr run(bool copyResults = true);
 
+  /// The stats of the replayed node in one benchmark run.
+  struct BenchmarkStats {
+    uint64_t wallNanos{0};
+    uint64_t cpuNanos{0};
+    uint64_t inputRows{0};
+    uint64_t inputBytes{0};
+    uint64_t peakMemoryBytes{0};
+    uint64_t spilledBytes{0};
+
+    std::string toString() const;
+  };
+
+  /// Replays the traced operator 'numIterations' times on the traced input
+  /// without copying the results, each time with one driver per traced
+  /// driver. Logs the stats of each run and their summary, and returns the
+  /// stats of each run.
+  std::vector<BenchmarkStats> benchmark(uint32_t numIterations);
+
  protected:
   virtual core::PlanNodePtr createPlanNode(
       const core::PlanNode* node,
@@ -77,10 +97,16 @@ class OperatorReplayerBase {
   core::PlanNodePtr planFragment_;
   core::PlanNodeId replayPlanNodeId_;
 
-  void printStats(const std::shared_ptr<exec::Task>& task) const;
+  // Logs the stats of the replayed node of 'task' unless benchmarking and
+  // sets 'lastRunStats_'. Called at the end of each run().
+  void printStats(const std::shared_ptr<exec::Task>& task);
 
  private:
   std::function<core::PlanNodePtr(std::string, core::PlanNodePtr)>
   replayNodeFactory(const core::PlanNode* node) const;
+
+  bool benchmarking_{false};
+  // The stats of the replayed node in the last run.
+  std::optional<BenchmarkStats> lastRunStats_;
 };
 } // namespace facebook::velox::tool::trace
@@ -99,6 +99,12 @@ DEFINE_uint64(
     0,
     "Specify the query memory capacity limit in GB. If it is zero, then there is no limit.");
 DEFINE_bool(copy_results, false, "Copy the replaying results.");
+DEFINE_uint32(
+    benchmark_iterations,
+    0,
+    "If non-zero, replay the traced operator this many times without copying "
+    "the results and report the wall and CPU time, throughput, peak memory "
+    "and spilled bytes of each run and their averages.");
 DEFINE_string(
     function_prefix,
     "",
@@ -412,6 +418,10 @@ void TraceReplayRunner::run() {
     return;
   }
   VELOX_USER_CHECK(!FLAGS_task_id.empty(), "--task_id must be provided");
+  if (FLAGS_benchmark_iterations > 0) {
+    createReplayer()->benchmark(FLAGS_benchmark_iterations);
+    return;
+  }
   createReplayer()->run(FLAGS_copy_results);
 }
 } // namespace facebook::velox::tool::trace
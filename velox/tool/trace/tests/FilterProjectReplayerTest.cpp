@@ -22,6 +22,7 @@
 
 #include <folly/experimental/EventCount.h>
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/hyperloglog/SparseHll.h"
 #include "velox/common/testutil/TestValue.h"
@@ -202,6 +203,43 @@ TEST_F(FilterProjectReplayerTest, filterProject) {
   }
 }
 
+TEST_F(FilterProjectReplayerTest, benchmark) {
+  const auto traceRoot = fmt::format("{}/{}", testDir_->getPath(), "benchmark");
+  const auto tracePlanWithSplits = createPlan(PlanMode::FilterProject);
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(tracePlanWithSplits.plan)
+      .maxDrivers(2)
+      .config(core::QueryConfig::kQueryTraceEnabled, true)
+      .config(core::QueryConfig::kQueryTraceDir, traceRoot)
+      .config(core::QueryConfig::kQueryTraceMaxBytes, 100UL << 30)
+      .config(core::QueryConfig::kQueryTraceTaskRegExp, ".*")
+      .config(core::QueryConfig::kQueryTraceNodeIds, projectNodeId_)
+      .splits(tracePlanWithSplits.splits)
+      .copyResults(pool(), task);
+
+  FilterProjectReplayer replayer(
+      traceRoot,
+      task->queryCtx()->queryId(),
+      task->taskId(),
+      projectNodeId_,
+      "FilterProject",
+      "",
+      0,
+      executor_.get());
+  VELOX_ASSERT_THROW(replayer.benchmark(0), "");
+  const auto runs = replayer.benchmark(3);
+  ASSERT_EQ(runs.size(), 3);
+  for (const auto& run : runs) {
+    ASSERT_GT(run.wallNanos, 0);
+    ASSERT_GT(run.inputRows, 0);
+    ASSERT_EQ(run.inputRows, runs[0].inputRows);
+    ASSERT_GT(run.inputBytes, 0);
+    ASSERT_EQ(run.spilledBytes, 0);
+  }
+  // The replayer still copies the results after benchmarking.
+  ASSERT_NE(replayer.run(), nullptr);
+}
+
 TEST_F(FilterProjectReplayerTest, filterOnly) {
   const auto planWithSplits = createPlan(PlanMode::FilterOnly);
   AssertQueryBuilder builder(planWithSplits.plan);
@@ -15,6 +15,7 @@
  */
 
 #include "velox/tpch/gen/TpchGen.h"
+#include <folly/futures/Future.h>
 #include <velox/tpch/gen/dbgen/include/tpch_constants.hpp>
 #include "velox/tpch/gen/DBGenIterator.h"
 #include "velox/vector/FlatVector.h"
@@ -750,6 +751,101 @@ RowVectorPtr genTpchRegion(
       pool, regionRowType, BufferPtr(nullptr), vectorSize, std::move(children));
 }
 
+namespace {
+
+RowVectorPtr genTpchRange(
+    Table table,
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  switch (table) {
+    case Table::TBL_PART:
+      return genTpchPart(pool, maxRows, offset, scaleFactor);
+    case Table::TBL_SUPPLIER:
+      return genTpchSupplier(pool, maxRows, offset, scaleFactor);
+    case Table::TBL_PARTSUPP:
+      return genTpchPartSupp(pool, maxRows, offset, scaleFactor);
+    case Table::TBL_CUSTOMER:
+      return genTpchCustomer(pool, maxRows, offset, scaleFactor);
+    case Table::TBL_ORDERS:
+      return genTpchOrders(pool, maxRows, offset, scaleFactor);
+    case Table::TBL_LINEITEM:
+      return genTpchLineItem(pool, maxRows, offset, scaleFactor);
+    case Table::TBL_NATION:
+      return genTpchNation(pool, maxRows, offset, scaleFactor);
+    case Table::TBL_REGION:
+      return genTpchRegion(pool, maxRows, offset, scaleFactor);
+  }
+  return nullptr; // make gcc happy.
+}
+
+// Concatenates 'parts' into one vector. The string columns reference the
+// string buffers of 'parts' instead of copying the strings.
+RowVectorPtr concatenate(
+    const std::vector<RowVectorPtr>& parts,
+    memory::MemoryPool* pool) {
+  vector_size_t size = 0;
+  for (const auto& part : parts) {
+    size += part->size();
+  }
+  auto result = std::static_pointer_cast<RowVector>(
+      BaseVector::create(parts[0]->type(), size, pool));
+  vector_size_t offset = 0;
+  for (const auto& part : parts) {
+    result->copy(part.get(), offset, 0, part->size());
+    offset += part->size();
+  }
+  return result;
+}
+
+} // namespace
+
+RowVectorPtr genTpchData(
+    Table table,
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor,
+    folly::Executor* executor,
+    size_t parallelism) {
+  // Lineitem is generated from the orders, so the ranges are in orders.
+  const auto rowCount = getRowCount(
+      table == Table::TBL_LINEITEM ? Table::TBL_ORDERS : table, scaleFactor);
+  const auto numRows = getVectorSize(rowCount, maxRows, offset);
+  const auto numRanges = std::min(
+      parallelism, std::max<size_t>(1, numRows / kMinParallelGenRows));
+  if (executor == nullptr || numRanges <= 1) {
+    return genTpchRange(table, pool, maxRows, offset, scaleFactor);
+  }
+
+  // Each range seeds its own dbgen context at its first row, so the ranges
+  // are independent and produce the same rows as a single call.
+  const auto rangeSize = bits::divRoundUp(numRows, numRanges);
+  std::vector<folly::Future<RowVectorPtr>> futures;
+  futures.reserve(numRanges - 1);
+  for (size_t start = rangeSize; start < numRows; start += rangeSize) {
+    const auto size = std::min(rangeSize, numRows - start);
+    futures.push_back(folly::via(executor, [=]() {
+      return genTpchRange(table, pool, size, offset + start, scaleFactor);
+    }));
+  }
+  // The first range is generated on the calling thread. All the ranges are
+  // waited for before any error is rethrown since they use 'pool'.
+  auto first = folly::makeTryWith([&]() {
+    return genTpchRange(table, pool, rangeSize, offset, scaleFactor);
+  });
+  auto rest = folly::collectAll(std::move(futures)).get();
+
+  std::vector<RowVectorPtr> parts;
+  parts.reserve(numRanges);
+  parts.push_back(std::move(first).value());
+  for (auto& part : rest) {
+    parts.push_back(std::move(part).value());
+  }
+  return concatenate(parts, pool);
+}
+
 std::string getQuery(int query) {
   if (query <= 0 || query > TPCH_QUERIES_COUNT) {
     VELOX_FAIL("Out of range TPC-H query number {}", query);
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/memory/Memory.h"
 #include "velox/vector/ComplexVector.h"
 
@@ -235,6 +237,28 @@ RowVectorPtr genTpchRegion(
     size_t offset = 0,
     double scaleFactor = 1);
 
+/// Returns the same rows as the genTpch*() function of `table` given
+/// `maxRows`, `offset` and `scaleFactor`. For "lineitem", `maxRows` and
+/// `offset` refer to orders like in genTpchLineItem().
+///
+/// If `executor` is set and `parallelism` is greater than 1, the rows are
+/// split into up to `parallelism` contiguous ranges of at least
+/// `kMinParallelGenRows` rows that are generated concurrently, each by its own
+/// dbgen context seeded at the start of its range, and then concatenated. The
+/// strings of the ranges are not copied. The result does not depend on
+/// `parallelism`.
+RowVectorPtr genTpchData(
+    Table table,
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset = 0,
+    double scaleFactor = 1,
+    folly::Executor* executor = nullptr,
+    size_t parallelism = 1);
+
+/// The minimum number of rows generated by each range of genTpchData().
+inline constexpr size_t kMinParallelGenRows = 1'024;
+
 /// Gets the specified TPC-H query number as a string.
 std::string getQuery(int query);
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include "gtest/gtest.h"
 
@@ -849,6 +850,47 @@ TEST_F(TpchGenTestCustomerTest, reproducible) {
   }
 }
 
+// Parallel generation.
+class TpchGenTestParallelTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  void SetUp() override {
+    pool_ = memory::memoryManager()->addLeafPool("TpchGenTestParallelTest");
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+};
+
+TEST_F(TpchGenTestParallelTest, sameAsSerial) {
+  folly::CPUThreadPoolExecutor executor(4);
+  // The offsets are not aligned to the ranges, nor to the 4 partsupp rows of
+  // a part.
+  for (auto table : tables) {
+    SCOPED_TRACE(std::string(toTableName(table)));
+    const size_t maxRows = 5 * kMinParallelGenRows + 17;
+    const size_t offset = 3;
+    auto serial = genTpchData(table, pool_.get(), maxRows, offset);
+    auto parallel = genTpchData(
+        table, pool_.get(), maxRows, offset, 1, &executor, /*parallelism=*/4);
+    ASSERT_EQ(parallel->size(), serial->size());
+    for (auto i = 0; i < serial->size(); ++i) {
+      ASSERT_TRUE(parallel->equalValueAt(serial.get(), i, i)) << i;
+    }
+  }
+
+  // The last batch has fewer rows than the ranges.
+  auto serial = genTpchOrders(pool_.get(), 10'000, 1'499'000);
+  auto parallel = genTpchData(
+      Table::TBL_ORDERS, pool_.get(), 10'000, 1'499'000, 1, &executor, 8);
+  ASSERT_EQ(1'000, parallel->size());
+  for (auto i = 0; i < serial->size(); ++i) {
+    ASSERT_TRUE(parallel->equalValueAt(serial.get(), i, i)) << i;
+  }
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -19,6 +19,8 @@
 #include <folly/Conv.h>
 #include <folly/Expected.h>
 #include <cctype>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
@@ -137,6 +139,72 @@ Expected<T> callFollyTo(const F& v) {
   return result.value();
 }
 
+/// Returns the value of the 8 ASCII digits at 'data' in one pass over the
+/// bytes, or -1 if any of them is not a digit.
+inline int64_t parseEightDigits(const char* data) {
+  uint64_t chunk;
+  std::memcpy(&chunk, data, sizeof(chunk));
+  // Each byte is a digit if its high nibble is 3 and adding 6 does not carry
+  // into the high nibble.
+  if ((chunk & 0xF0F0F0F0F0F0F0F0) != 0x3030303030303030 ||
+      ((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) !=
+          0x3030303030303030) {
+    return -1;
+  }
+  // Combines adjacent digits, then pairs and then quads. The first digit is in
+  // the lowest byte.
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FF;
+  chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFF;
+  chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000FFFFFFFF;
+  return chunk;
+}
+
+/// Fast path for casting a string of at most 18 ASCII digits with an optional
+/// sign to an integer. Sets 'result' and returns true if 'data' is such a
+/// string and its value fits in T. Returns false for all the other strings,
+/// which the caller must cast with the general logic, so that the errors and
+/// the corner cases stay the same.
+template <typename T>
+bool tryParseShortInteger(const char* data, size_t size, T& result) {
+  static constexpr size_t kMaxDigits = 18;
+  bool negative = false;
+  if (size > 0 && (data[0] == '-' || data[0] == '+')) {
+    negative = data[0] == '-';
+    ++data;
+    --size;
+  }
+  if (size == 0 || size > kMaxDigits) {
+    return false;
+  }
+  int64_t value = 0;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const auto digits = parseEightDigits(data + i);
+    if (digits < 0) {
+      return false;
+    }
+    value = value * 100'000'000 + digits;
+  }
+  for (; i < size; ++i) {
+    if (data[i] < '0' || data[i] > '9') {
+      return false;
+    }
+    value = value * 10 + (data[i] - '0');
+  }
+  if (negative) {
+    value = -value;
+  }
+  if constexpr (sizeof(T) < sizeof(int64_t)) {
+    if (value < std::numeric_limits<T>::min() ||
+        value > std::numeric_limits<T>::max()) {
+      return false;
+    }
+  }
+  result = value;
+  return true;
+}
+
 } // namespace detail
 
 /// To BOOLEAN converter.
@@ -319,28 +387,30 @@ struct Converter<
   }
 
   static Expected<T> tryCast(folly::StringPiece v) {
-    if constexpr (TPolicy::truncate) {
-      return convertStringToInt(v);
-    } else {
-      auto trimmed = trimWhiteSpace(v.data(), v.size());
-      return detail::callFollyTo<T>(trimmed);
-    }
+    return castString(v.data(), v.size());
   }
 
   static Expected<T> tryCast(const StringView& v) {
-    if constexpr (TPolicy::truncate) {
-      return convertStringToInt(folly::StringPiece(v));
-    } else {
-      auto trimmed = trimWhiteSpace(v.data(), v.size());
-      return detail::callFollyTo<T>(trimmed);
-    }
+    return castString(v.data(), v.size());
   }
 
   static Expected<T> tryCast(const std::string& v) {
+    return castString(v.data(), v.length());
+  }
+
+  static Expected<T> castString(const char* data, size_t size) {
+    T result;
     if constexpr (TPolicy::truncate) {
-      return convertStringToInt(v);
+      if (detail::tryParseShortInteger(data, size, result)) {
+        return result;
+      }
+      return convertStringToInt(folly::StringPiece(data, size));
     } else {
-      auto trimmed = trimWhiteSpace(v.data(), v.length());
+      auto trimmed = trimWhiteSpace(data, size);
+      if (detail::tryParseShortInteger(
+              trimmed.data(), trimmed.size(), result)) {
+        return result;
+      }
       return detail::callFollyTo<T>(trimmed);
     }
   }
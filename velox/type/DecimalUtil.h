@@ -149,6 +149,41 @@ class DecimalUtil {
     }
   }
 
+  /// Multiplies 'a' and 'b' into 'result'. Returns true if the product
+  /// overflows int128_t. The product of two values that fit in 64 bits never
+  /// overflows, so the common case is a single widening multiply instead of a
+  /// checked 128-bit one.
+  template <typename A, typename B>
+  FOLLY_ALWAYS_INLINE static bool
+  multiplyWithOverflow(int128_t& result, A a, B b) {
+    if (fitsInInt64(a) && fitsInInt64(b)) {
+      result = static_cast<int128_t>(static_cast<int64_t>(a)) *
+          static_cast<int64_t>(b);
+      return false;
+    }
+    return __builtin_mul_overflow(
+        static_cast<int128_t>(a), static_cast<int128_t>(b), &result);
+  }
+
+  /// Returns 'value' divided by 10^'exponent', rounded towards zero, and sets
+  /// 'remainder'. If 'value' and the divisor fit in 64 bits, divides in 64
+  /// bits by a compile-time constant, which the compiler turns into a
+  /// multiplication by the reciprocal instead of a 128-bit division.
+  FOLLY_ALWAYS_INLINE static int128_t
+  divideByPowerOfTen(int128_t value, uint8_t exponent, int128_t& remainder) {
+    if (exponent <= ShortDecimalType::kMaxPrecision && fitsInInt64(value)) {
+      int64_t remainder64;
+      const auto quotient = divideByPowerOfTen64(
+          static_cast<int64_t>(value), exponent, remainder64);
+      remainder = remainder64;
+      return quotient;
+    }
+    const auto divisor = kPowersOfTen[exponent];
+    const int128_t quotient = value / divisor;
+    remainder = value - quotient * divisor;
+    return quotient;
+  }
+
   template <typename TInput, typename TOutput>
   inline static Status rescaleWithRoundUp(
       TInput inputValue,
@@ -161,15 +196,16 @@ class DecimalUtil {
     auto scaleDifference = toScale - fromScale;
     bool isOverflow = false;
     if (scaleDifference >= 0) {
-      isOverflow = __builtin_mul_overflow(
+      isOverflow = multiplyWithOverflow(
           rescaledValue,
-          DecimalUtil::kPowersOfTen[scaleDifference],
-          &rescaledValue);
+          rescaledValue,
+          DecimalUtil::kPowersOfTen[scaleDifference]);
     } else {
       scaleDifference = -scaleDifference;
       const auto scalingFactor = DecimalUtil::kPowersOfTen[scaleDifference];
-      rescaledValue /= scalingFactor;
-      int128_t remainder = inputValue % scalingFactor;
+      int128_t remainder;
+      rescaledValue =
+          divideByPowerOfTen(rescaledValue, scaleDifference, remainder);
       if (inputValue >= 0 && remainder >= scalingFactor / 2) {
         ++rescaledValue;
       } else if (remainder <= -scalingFactor / 2) {
@@ -503,5 +539,62 @@ class DecimalUtil {
   }
 
   static constexpr __uint128_t kOverflowMultiplier = ((__uint128_t)1 << 127);
+
+ private:
+  template <typename T>
+  FOLLY_ALWAYS_INLINE static bool fitsInInt64(T value) {
+    if constexpr (sizeof(T) <= sizeof(int64_t)) {
+      return true;
+    } else {
+      return static_cast<int64_t>(value) == value;
+    }
+  }
+
+  // Divides by 10^kExponent for the 'exponent' given at runtime so that each
+  // division has a constant divisor.
+  template <uint8_t kExponent = 0>
+  FOLLY_ALWAYS_INLINE static int64_t
+  divideByPowerOfTen64(int64_t value, uint8_t exponent, int64_t& remainder) {
+    if constexpr (kExponent < ShortDecimalType::kMaxPrecision) {
+      if (exponent != kExponent) {
+        return divideByPowerOfTen64<kExponent + 1>(value, exponent, remainder);
+      }
+    }
+    constexpr auto kDivisor = static_cast<int64_t>(kPowersOfTen[kExponent]);
+    const int64_t quotient = value / kDivisor;
+    remainder = value - quotient * kDivisor;
+    return quotient;
+  }
 }; // DecimalUtil
+
+/// Sums decimal values of one batch without a branch per value. The lower 64
+/// bits of the values are summed as unsigned and the upper 64 bits as signed,
+/// which cannot overflow for fewer than 2^63 values. The overflow of the
+/// 128-bit sum is resolved once per batch by 'addTo'.
+class DecimalBatchSum {
+ public:
+  template <typename T>
+  FOLLY_ALWAYS_INLINE void add(T value) {
+    const auto wide = static_cast<int128_t>(value);
+    lower_ += HugeInt::lower(wide);
+    upper_ += static_cast<int64_t>(HugeInt::upper(wide));
+  }
+
+  /// Adds the batch sum to 'sum' and returns the net overflow with the same
+  /// meaning as for DecimalUtil::addWithOverflow.
+  int64_t addTo(int128_t& sum) const {
+    // The batch sum is 'high' * 2^64 + 'low' and 'high' is 'overflow' * 2^63
+    // plus a value in [0, 2^63).
+    const int128_t high = upper_ + static_cast<int128_t>(lower_ >> 64);
+    const auto low = static_cast<uint64_t>(lower_);
+    const auto overflow = static_cast<int64_t>(high >> 63);
+    const auto rest = static_cast<uint64_t>(high) & DecimalUtil::kInt64Mask;
+    return overflow +
+        DecimalUtil::addWithOverflow(sum, sum, HugeInt::build(rest, low));
+  }
+
+ private:
+  uint128_t lower_{0};
+  int128_t upper_{0};
+};
 } // namespace facebook::velox
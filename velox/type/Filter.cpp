@@ -21,6 +21,7 @@
 #include <string>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -94,6 +95,12 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
+    case FilterKind::kExpression:
+      strKind = "Expression";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +138,9 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
+      {FilterKind::kExpression, "kExpression"},
   };
 }
 
@@ -190,6 +200,8 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
@@ -462,6 +474,57 @@ bool NegatedBigintValuesUsingHashTable::testingEquals(
       nonNegated_->testingEquals(*(otherNegatedBigintValues->nonNegated_));
 }
 
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  std::string bloom(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bloom.data());
+  obj["bloomFilter"] = encoding::Base64::encode(bloom);
+  if (conjunct_ != nullptr) {
+    obj["conjunct"] = conjunct_->serialize();
+  }
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  auto nullAllowed = deserializeNullAllowed(obj);
+  const auto bloom =
+      encoding::Base64::decode(obj["bloomFilter"].asString());
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(bloom.data());
+  std::shared_ptr<const Filter> conjunct;
+  if (obj.count("conjunct")) {
+    conjunct = ISerializable::deserialize<Filter>(obj["conjunct"]);
+  }
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed, std::move(conjunct));
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloom = dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  if (otherBloom == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloom->min_ || max_ != otherBloom->max_) {
+    return false;
+  }
+  if ((conjunct_ == nullptr) != (otherBloom->conjunct_ == nullptr) ||
+      (conjunct_ != nullptr &&
+       !conjunct_->testingEquals(*otherBloom->conjunct_))) {
+    return false;
+  }
+  const auto size = bloomFilter_->serializedSize();
+  if (size != otherBloom->bloomFilter_->serializedSize()) {
+    return false;
+  }
+  std::string bloom(size, '\0');
+  std::string otherBloomBits(size, '\0');
+  bloomFilter_->serialize(bloom.data());
+  otherBloom->bloomFilter_->serialize(otherBloomBits.data());
+  return bloom == otherBloomBits;
+}
+
 folly::dynamic NegatedBigintValuesUsingBitmask::serialize() const {
   auto obj = Filter::serializeBase("NegatedBigintValuesUsingBitmask");
   obj["min"] = min_;
@@ -779,6 +842,38 @@ bool BigintValuesUsingBitmask::testInt64(int64_t value) const {
   return bitmask_[value - min_];
 }
 
+BigintValuesUsingBloomFilter::BigintValuesUsingBloomFilter(
+    int64_t min,
+    int64_t max,
+    BloomFilterPtr bloomFilter,
+    bool nullAllowed,
+    std::shared_ptr<const Filter> conjunct)
+    : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+      min_(min),
+      max_(max),
+      bloomFilter_(std::move(bloomFilter)),
+      conjunct_(std::move(conjunct)) {
+  VELOX_CHECK_LE(min_, max_, "min must be no greater than max");
+  VELOX_CHECK_NOT_NULL(bloomFilter_);
+  VELOX_CHECK(bloomFilter_->isSet(), "Bloom filter must be initialized");
+}
+
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (min > max_ || max < min_) {
+    return false;
+  }
+  if (min == max) {
+    return testInt64(min);
+  }
+  return conjunct_ == nullptr || conjunct_->testInt64Range(min, max, false);
+}
+
 std::vector<int64_t> BigintValuesUsingBitmask::values() const {
   std::vector<int64_t> values;
   for (int i = 0; i < bitmask_.size(); i++) {
@@ -1807,6 +1902,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintRange>(lower_, upper_, false);
@@ -1901,6 +1997,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -1994,6 +2091,7 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingHashTable>(*this, false);
@@ -2085,6 +2183,7 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingBitmask>(*this, false);
@@ -2154,6 +2253,41 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(false);
+    case FilterKind::kBigintRange:
+    case FilterKind::kNegatedBigintRange:
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask:
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kNegatedBigintValuesUsingBitmask:
+    case FilterKind::kBigintMultiRange:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      // The exact filter becomes or is merged into the conjunct, which is
+      // checked before the Bloom filter.
+      const bool bothNullAllowed = nullAllowed_ && other->testNull();
+      std::shared_ptr<const Filter> conjunct = conjunct_ == nullptr
+          ? other->clone(false)
+          : conjunct_->mergeWith(other);
+      if (conjunct->kind() == FilterKind::kAlwaysFalse ||
+          conjunct->kind() == FilterKind::kIsNull) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min_, max_, bloomFilter_, bothNullAllowed, conjunct->clone(false));
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     const Filter* other) const {
   // Rules of NegatedBigintValuesUsingHashTable with IsNull/IsNotNull
@@ -2168,6 +2302,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingHashTable>(*this, false);
@@ -2207,6 +2342,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingBitmask>(*this, false);
@@ -2242,6 +2378,7 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull: {
       std::vector<std::unique_ptr<BigintRange>> ranges;
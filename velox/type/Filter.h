@@ -25,6 +25,7 @@
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -57,6 +58,8 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
+  kExpression,
 };
 
 class Filter;
@@ -1134,6 +1137,109 @@ class BigintValuesUsingBitmask final : public Filter {
   const int64_t max_;
 };
 
+/// IN-list filter for integral data types implemented as a blocked Bloom filter
+/// over the hashes of the values. Made for dynamic filters from hash join build
+/// sides with too many distinct keys for an exact IN-list. Values outside of
+/// [min, max] never pass. Values in the range that are not in the list pass at
+/// the false positive rate of the Bloom filter, under 1% with the 16 to 32
+/// bits per value that BloomFilter::reset() allocates. The filter may be
+/// further restricted by an exact 'conjunct' filter, e.g. when merged with a
+/// filter already present on the column.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  using BloomFilterPtr = std::shared_ptr<const BloomFilter<>>;
+
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter of the hashes of the passing values. See
+  /// hashValue().
+  /// @param nullAllowed Null values are passing the filter if true.
+  /// @param conjunct Optional filter that a value must also pass.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      BloomFilterPtr bloomFilter,
+      bool nullAllowed,
+      std::shared_ptr<const Filter> conjunct = nullptr);
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_),
+        conjunct_(other.conjunct_) {}
+
+  /// Returns the hash of 'value' to insert into and to test against the Bloom
+  /// filter.
+  static uint64_t hashValue(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final {
+    if (value < min_ || value > max_) {
+      return false;
+    }
+    if (conjunct_ != nullptr && !conjunct_->testInt64(value)) {
+      return false;
+    }
+    return bloomFilter_->mayContain(hashValue(value));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  const BloomFilterPtr& bloomFilter() const {
+    return bloomFilter_;
+  }
+
+  const std::shared_ptr<const Filter>& conjunct() const {
+    return conjunct_;
+  }
+
+  std::string toString() const override {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {} bytes {}{}",
+        min_,
+        max_,
+        bloomFilter_->serializedSize(),
+        nullAllowed_ ? "with nulls" : "no nulls",
+        conjunct_ ? " and " + conjunct_->toString() : "");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const int64_t min_;
+  const int64_t max_;
+  const BloomFilterPtr bloomFilter_;
+  const std::shared_ptr<const Filter> conjunct_;
+};
+
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
 // for large number of rejected values that do not fit within a small range.
 class NegatedBigintValuesUsingHashTable final : public Filter {
@@ -945,6 +945,96 @@ Status parserError(const char* str, size_t len) {
       std::string(str, len));
 }
 
+// Returns the value of the 'numDigits' digits at 'buf', or -1 if any of them
+// is not a digit.
+inline int32_t parseFixedDigits(const char* buf, int32_t numDigits) {
+  int32_t value = 0;
+  for (auto i = 0; i < numDigits; ++i) {
+    if (!characterIsDigit(buf[i])) {
+      return -1;
+    }
+    value = value * 10 + (buf[i] - '0');
+  }
+  return value;
+}
+
+// Fast path for the most common timestamp layout 'YYYY-MM-DD[?HH:MM:SS[.f]]'
+// with 1 to 6 fraction digits, where '?' is the separator between date and
+// time that 'parseMode' accepts. The fields are at fixed offsets, so they are
+// read without the scans of tryParseTimestampString(). Returns false for all
+// the other strings and for invalid values, which the caller must parse with
+// tryParseTimestampString(), so that the errors and the corner cases stay the
+// same.
+bool tryParseCanonicalTimestamp(
+    const char* buf,
+    size_t len,
+    TimestampParseMode parseMode,
+    Timestamp& result) {
+  static constexpr size_t kDateSize = 10;
+  static constexpr size_t kDateTimeSize = 19;
+  if ((len != kDateSize && len < kDateTimeSize) || len == kDateTimeSize + 1 ||
+      len > kDateTimeSize + 7) {
+    return false;
+  }
+  const auto year = parseFixedDigits(buf, 4);
+  const auto month = parseFixedDigits(buf + 5, 2);
+  const auto day = parseFixedDigits(buf + 8, 2);
+  if (year < 0 || month < 0 || day < 0 || buf[4] != '-' || buf[7] != '-' ||
+      !isValidDate(year, month, day)) {
+    return false;
+  }
+  const int64_t daysSinceEpoch =
+      daysSinceEpochFromDate(year, month, day).value();
+  if (len == kDateSize) {
+    result = fromDatetime(daysSinceEpoch, 0);
+    return true;
+  }
+
+  const char separator = buf[kDateSize];
+  switch (parseMode) {
+    case TimestampParseMode::kIso8601:
+      if (separator != 'T') {
+        return false;
+      }
+      break;
+    case TimestampParseMode::kPrestoCast:
+      if (separator != ' ') {
+        return false;
+      }
+      break;
+    case TimestampParseMode::kLegacyCast:
+    case TimestampParseMode::kSparkCast:
+      if (separator != ' ' && separator != 'T') {
+        return false;
+      }
+      break;
+  }
+  const auto hour = parseFixedDigits(buf + 11, 2);
+  const auto minute = parseFixedDigits(buf + 14, 2);
+  const auto second = parseFixedDigits(buf + 17, 2);
+  if (hour < 0 || hour >= 24 || minute < 0 || minute >= 60 || second < 0 ||
+      second > 60 || buf[13] != ':' || buf[16] != ':') {
+    return false;
+  }
+  int32_t micros = 0;
+  if (len > kDateTimeSize) {
+    if (buf[kDateTimeSize] != '.') {
+      return false;
+    }
+    const int32_t numDigits = len - kDateTimeSize - 1;
+    micros = parseFixedDigits(buf + kDateTimeSize + 1, numDigits);
+    if (micros < 0) {
+      return false;
+    }
+    for (auto i = numDigits; i < 6; ++i) {
+      micros *= 10;
+    }
+  }
+  result = fromDatetime(
+      daysSinceEpoch, fromTime(hour, minute, second, micros));
+  return true;
+}
+
 } // namespace
 
 Expected<Timestamp>
@@ -952,6 +1042,9 @@ fromTimestampString(const char* str, size_t len, TimestampParseMode parseMode) {
   size_t pos = 0;
   Timestamp resultTimestamp;
 
+  if (tryParseCanonicalTimestamp(str, len, parseMode, resultTimestamp)) {
+    return resultTimestamp;
+  }
   if (!tryParseTimestampString(str, len, pos, resultTimestamp, parseMode)) {
     return folly::makeUnexpected(parserError(str, len));
   }
@@ -525,6 +525,43 @@ TEST_F(ConversionsTest, toIntegeralTypes) {
         /*truncate*/ true,
         false,
         /*expectError*/ true);
+
+    // Digit runs of up to 18 digits take a fast path, the longer ones and the
+    // values out of range do not.
+    for (const bool truncate : {false, true}) {
+      testConversion<std::string, int64_t>(
+          {
+              "12345678",
+              "-12345678",
+              "0000000012345678",
+              "123456789012345678",
+              "-123456789012345678",
+              "9223372036854775807",
+              "-9223372036854775808",
+          },
+          {
+              12345678,
+              -12345678,
+              12345678,
+              123456789012345678,
+              -123456789012345678,
+              std::numeric_limits<int64_t>::max(),
+              std::numeric_limits<int64_t>::min(),
+          },
+          truncate);
+      testConversion<std::string, int32_t>(
+          {"2147483647", "-2147483648", "+00000002147483647"},
+          {std::numeric_limits<int32_t>::max(),
+           std::numeric_limits<int32_t>::min(),
+           std::numeric_limits<int32_t>::max()},
+          truncate);
+      testConversion<std::string, int32_t>(
+          {"2147483648", "-2147483649", "1234567a", "12345678-"},
+          {},
+          truncate,
+          false,
+          /*expectError*/ true);
+    }
   }
 
   // From integral types.
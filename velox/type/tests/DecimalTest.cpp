@@ -220,6 +220,89 @@ TEST(DecimalTest, addUnsignedValues) {
   ASSERT_EQ(HugeInt::lower(sum), 0x11d0ffffff0bdc0);
 }
 
+TEST(DecimalTest, batchSum) {
+  const std::vector<int128_t> values = {
+      DecimalUtil::kLongDecimalMax,
+      -HugeInt::build(0x4B3B4CA85A86C47A, 0x98A223FFFFFFFFF),
+      DecimalUtil::kLongDecimalMax,
+      1,
+      DecimalUtil::kLongDecimalMin,
+      HugeInt::build(0x4B3B4CA85A86C47A, 0x98A223FFFFFFFFF),
+      -12'345};
+  // Compares the batch sum to adding the values one at a time for each prefix
+  // of 'values' and for a non-zero initial sum.
+  for (auto initial : {int128_t(0), DecimalUtil::kLongDecimalMin}) {
+    for (size_t size = 0; size <= values.size(); ++size) {
+      SCOPED_TRACE(fmt::format("size: {}", size));
+      int128_t expectedSum = initial;
+      int64_t expectedOverflow = 0;
+      DecimalBatchSum batchSum;
+      for (size_t i = 0; i < size; ++i) {
+        expectedOverflow +=
+            DecimalUtil::addWithOverflow(expectedSum, expectedSum, values[i]);
+        batchSum.add(values[i]);
+      }
+      int128_t sum = initial;
+      const auto overflow = batchSum.addTo(sum);
+      EXPECT_EQ(
+          DecimalUtil::adjustSumForOverflow(sum, overflow),
+          DecimalUtil::adjustSumForOverflow(expectedSum, expectedOverflow));
+    }
+  }
+
+  // Short decimals.
+  DecimalBatchSum batchSum;
+  for (int64_t i = -1'000; i < 3'000; ++i) {
+    batchSum.add(i * 1'000'000'000'000);
+  }
+  int128_t sum = 0;
+  ASSERT_EQ(batchSum.addTo(sum), 0);
+  ASSERT_EQ(sum, int128_t(3'998'000) * 1'000'000'000'000);
+}
+
+TEST(DecimalTest, multiplyWithOverflow) {
+  int128_t result;
+  ASSERT_FALSE(DecimalUtil::multiplyWithOverflow(result, -3, 7));
+  ASSERT_EQ(result, -21);
+
+  // 64-bit inputs with a 128-bit product.
+  constexpr int64_t kInt64Max = std::numeric_limits<int64_t>::max();
+  ASSERT_FALSE(DecimalUtil::multiplyWithOverflow(result, kInt64Max, kInt64Max));
+  ASSERT_EQ(result, int128_t(kInt64Max) * kInt64Max);
+
+  ASSERT_FALSE(DecimalUtil::multiplyWithOverflow(
+      result, DecimalUtil::kPowersOfTen[30], int128_t(-1'000)));
+  ASSERT_EQ(result, -DecimalUtil::kPowersOfTen[33]);
+
+  ASSERT_TRUE(DecimalUtil::multiplyWithOverflow(
+      result, DecimalUtil::kLongDecimalMax, int128_t(100)));
+  ASSERT_TRUE(DecimalUtil::multiplyWithOverflow(
+      result, DecimalUtil::kPowersOfTen[20], DecimalUtil::kPowersOfTen[20]));
+}
+
+TEST(DecimalTest, divideByPowerOfTen) {
+  const std::vector<int128_t> values = {
+      0,
+      7,
+      -7,
+      123'456'789'012'345'678,
+      -123'456'789'012'345'678,
+      std::numeric_limits<int64_t>::min(),
+      DecimalUtil::kLongDecimalMax,
+      DecimalUtil::kLongDecimalMin};
+  for (auto value : values) {
+    for (uint8_t exponent = 0; exponent <= LongDecimalType::kMaxPrecision;
+         ++exponent) {
+      SCOPED_TRACE(fmt::format("{} / 10^{}", value, exponent));
+      int128_t remainder;
+      const auto quotient =
+          DecimalUtil::divideByPowerOfTen(value, exponent, remainder);
+      EXPECT_EQ(quotient, value / DecimalUtil::kPowersOfTen[exponent]);
+      EXPECT_EQ(remainder, value % DecimalUtil::kPowersOfTen[exponent]);
+    }
+  }
+}
+
 TEST(DecimalTest, longDecimalSerDe) {
   char data[100];
   HugeInt::serialize(DecimalUtil::kLongDecimalMin, data);
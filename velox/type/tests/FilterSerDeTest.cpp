@@ -110,6 +110,23 @@ TEST_F(FilterSerDeTest, valuesFilters) {
   }
 }
 
+TEST_F(FilterSerDeTest, bloomFilter) {
+  auto bloom = std::make_shared<BloomFilter<>>();
+  bloom->reset(1'000);
+  for (int64_t i = 0; i < 1'000; i += 3) {
+    bloom->insert(BigintValuesUsingBloomFilter::hashValue(i));
+  }
+  for (auto nullAllowed : {false, true}) {
+    testSerde(BigintValuesUsingBloomFilter(0, 999, bloom, nullAllowed));
+    testSerde(BigintValuesUsingBloomFilter(
+        0,
+        999,
+        bloom,
+        nullAllowed,
+        std::make_shared<BigintRange>(10, 500, false)));
+  }
+}
+
 TEST_F(FilterSerDeTest, rangeFilters) {
   FloatRange floatRange(1.0, true, true, 124.5, false, true, false);
   testSerde(floatRange);
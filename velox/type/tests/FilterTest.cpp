@@ -463,6 +463,53 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  auto bloom = std::make_shared<BloomFilter<>>();
+  bloom->reset(10'000);
+  for (int64_t i = 0; i < 10'000; ++i) {
+    bloom->insert(BigintValuesUsingBloomFilter::hashValue(i * 10));
+  }
+  BigintValuesUsingBloomFilter filter(0, 99'990, bloom, false);
+
+  // No false negatives.
+  for (int64_t i = 0; i < 10'000; ++i) {
+    ASSERT_TRUE(filter.testInt64(i * 10));
+  }
+  // Few false positives.
+  int32_t numPassed = 0;
+  for (int64_t i = 0; i < 10'000; ++i) {
+    numPassed += filter.testInt64(i * 10 + 1);
+  }
+  EXPECT_LT(numPassed, 500);
+
+  EXPECT_FALSE(filter.testNull());
+  EXPECT_FALSE(filter.testInt64(-10));
+  EXPECT_FALSE(filter.testInt64(100'000));
+  EXPECT_TRUE(filter.testInt64Range(5, 50, false));
+  EXPECT_FALSE(filter.testInt64Range(-10, -5, false));
+  EXPECT_FALSE(filter.testInt64Range(100'000, 200'000, false));
+
+  // Merging with an exact filter restricts the Bloom filter to it.
+  BigintRange range(100, 200, false);
+  auto merged = range.mergeWith(&filter);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(100));
+  EXPECT_TRUE(merged->testInt64(200));
+  EXPECT_FALSE(merged->testInt64(90));
+  EXPECT_FALSE(merged->testInt64(210));
+  EXPECT_FALSE(merged->testInt64Range(300, 400, false));
+
+  auto values = createBigintValues({90, 100, 300}, false);
+  merged = merged->mergeWith(values.get());
+  EXPECT_TRUE(merged->testInt64(100));
+  EXPECT_FALSE(merged->testInt64(90));
+  EXPECT_FALSE(merged->testInt64(300));
+
+  auto nullFilter = std::make_unique<IsNull>();
+  EXPECT_EQ(
+      filter.mergeWith(nullFilter.get())->kind(), FilterKind::kAlwaysFalse);
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =
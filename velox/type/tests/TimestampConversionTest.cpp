@@ -312,6 +312,39 @@ TEST(DateTimeUtilTest, fromTimestampString) {
       parseTimestamp("2000-01-01T12:21:56", TimestampParseMode::kIso8601));
 }
 
+TEST(DateTimeUtilTest, fromCanonicalTimestampString) {
+  // The 'YYYY-MM-DD HH:MM:SS[.f]' layout takes a fast path that must give the
+  // same results as the general parser.
+  EXPECT_EQ(
+      Timestamp(946729316, 500'000'000),
+      parseTimestamp("2000-01-01 12:21:56.5"));
+  EXPECT_EQ(
+      Timestamp(946729316, 123'456'000),
+      parseTimestamp("2000-01-01 12:21:56.123456"));
+  EXPECT_EQ(
+      Timestamp(946729316, 123'456'000),
+      parseTimestamp("2000-01-01 12:21:56.1234567"));
+  EXPECT_EQ(
+      Timestamp(-1, 900'000'000), parseTimestamp("1969-12-31 23:59:59.9"));
+  EXPECT_EQ(Timestamp(946729320, 0), parseTimestamp("2000-01-01 12:21:60"));
+  EXPECT_EQ(
+      Timestamp(946729316, 0),
+      parseTimestamp("2000-01-01T12:21:56", TimestampParseMode::kLegacyCast));
+  EXPECT_EQ(
+      Timestamp(946729316, 0),
+      parseTimestamp("2000-01-01 12:21:56", TimestampParseMode::kSparkCast));
+
+  const std::string_view parserError = "Unable to parse timestamp value: ";
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01T12:21:56"), parserError);
+  VELOX_ASSERT_THROW(
+      parseTimestamp("2000-01-01 12:21:56", TimestampParseMode::kIso8601),
+      parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-02-30 00:00:00"), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01 24:00:00"), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01 12:21:56."), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01 12:21:5a"), parserError);
+}
+
 TEST(DateTimeUtilTest, fromTimestampStringInvalid) {
   const std::string_view parserError = "Unable to parse timestamp value: ";
   const std::string_view overflowError = "integer overflow: ";
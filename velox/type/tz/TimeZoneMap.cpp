@@ -16,6 +16,7 @@
 
 #include "velox/type/tz/TimeZoneMap.h"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <fmt/core.h>
 #include <folly/container/F14Map.h>
@@ -465,14 +466,57 @@ TimeZone::milliseconds TimeZone::to_sys(
 }
 
 TimeZone::seconds TimeZone::to_local(TimeZone::seconds timestamp) const {
+  if (tz_ != nullptr) {
+    if (const auto offset = cachedOffset(timestamp.count())) {
+      return timestamp + seconds(offset.value());
+    }
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
 TimeZone::milliseconds TimeZone::to_local(
     TimeZone::milliseconds timestamp) const {
+  if (tz_ != nullptr) {
+    const auto timestampSeconds = std::chrono::floor<seconds>(timestamp);
+    if (const auto offset = cachedOffset(timestampSeconds.count())) {
+      return timestamp + seconds(offset.value());
+    }
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
+std::optional<int64_t> TimeZone::cachedOffset(int64_t seconds) const {
+  // 1900-01-01 and 2100-01-01 in seconds since epoch.
+  static constexpr int64_t kMinCachedSeconds = -2'208'988'800;
+  static constexpr int64_t kMaxCachedSeconds = 4'102'444'800;
+
+  if (seconds < kMinCachedSeconds || seconds >= kMaxCachedSeconds) {
+    return std::nullopt;
+  }
+
+  std::call_once(transitionsOnce_, [&]() {
+    auto begin = kMinCachedSeconds;
+    while (begin < kMaxCachedSeconds) {
+      const auto info =
+          tz_->get_info(date::sys_seconds{TimeZone::seconds{begin}});
+      const auto offset = static_cast<int32_t>(info.offset.count());
+      // Transitions that only change the abbreviation or the daylight
+      // savings flag keep the offset.
+      if (offsets_.empty() || offsets_.back() != offset) {
+        transitions_.push_back(begin);
+        offsets_.push_back(offset);
+      }
+      const auto end = info.end.time_since_epoch().count();
+      VELOX_CHECK_GT(end, begin);
+      begin = end;
+    }
+  });
+
+  const auto it =
+      std::upper_bound(transitions_.begin(), transitions_.end(), seconds);
+  return offsets_[it - transitions_.begin() - 1];
+}
+
 TimeZone::seconds TimeZone::correct_nonexistent_time(
     TimeZone::seconds timestamp) const {
   // If this is an offset time zone.
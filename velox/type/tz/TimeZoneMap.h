@@ -17,6 +17,8 @@
 #pragma once
 
 #include <chrono>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -144,6 +146,10 @@ class TimeZone {
   /// GMT), convert to the same instant in time as observed in the user local
   /// time represented by this object). Note that this conversion is not
   /// susceptible to the error above.
+  ///
+  /// The UTC offsets between the transitions of the time zone from 1900 to
+  /// 2100 are computed on the first call, so converting a time in that range
+  /// is a binary search and an add.
   seconds to_local(seconds timestamp) const;
   milliseconds to_local(milliseconds timestamp) const;
 
@@ -184,10 +190,21 @@ class TimeZone {
       TChoose choose = TChoose::kFail) const;
 
  private:
+  // Returns the UTC offset in seconds at system time 'seconds' from the cached
+  // transitions of 'tz_', or std::nullopt if 'seconds' is outside of the cached
+  // range.
+  std::optional<int64_t> cachedOffset(int64_t seconds) const;
+
   const tzdb::time_zone* tz_{nullptr};
   const std::chrono::minutes offset_{0};
   const std::string timeZoneName_;
   const int16_t timeZoneID_;
+
+  // System times in seconds at which the UTC offset of 'tz_' changes and the
+  // offset in seconds from each of them to the next. Built on first use.
+  mutable std::once_flag transitionsOnce_;
+  mutable std::vector<int64_t> transitions_;
+  mutable std::vector<int32_t> offsets_;
 };
 
 } // namespace facebook::velox::tz
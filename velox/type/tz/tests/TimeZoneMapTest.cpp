@@ -19,6 +19,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/external/date/date.h"
+#include "velox/external/tzdb/zoned_time.h"
 #include "velox/type/tz/TimeZoneMap.h"
 
 namespace facebook::velox::tz {
@@ -91,6 +92,33 @@ TEST(TimeZoneMapTest, offsetToLocal) {
   EXPECT_NE(toLocalTime("-07:00", ts), toLocalTime("America/Los_Angeles", ts));
 }
 
+TEST(TimeZoneMapTest, cachedToLocal) {
+  // Compares the conversions from the cached transitions to the ones from the
+  // time zone database, around the transitions and at the cached range ends.
+  for (auto name :
+       {"America/Los_Angeles",
+        "Europe/London",
+        "Asia/Kolkata",
+        "Australia/Lord_Howe",
+        "America/Sao_Paulo"}) {
+    SCOPED_TRACE(name);
+    const auto* tz = locateZone(name);
+    ASSERT_NE(tz, nullptr);
+    for (int64_t ts = -2'208'988'800 - 86'400; ts < 4'102'444'800 + 86'400;
+         ts += 3'599 * 47) {
+      const date::sys_seconds timePoint{seconds{ts}};
+      const auto expected = tzdb::zoned_time{tz->tz(), timePoint}
+                                .get_local_time()
+                                .time_since_epoch();
+      ASSERT_EQ(tz->to_local(seconds{ts}), expected) << ts;
+      ASSERT_EQ(
+          tz->to_local(milliseconds{ts * 1'000 + 999}),
+          expected + milliseconds{999})
+          << ts;
+    }
+  }
+}
+
 TEST(TimeZoneMapTest, offsetToSys) {
   auto toSysTime = [&](std::string_view name, size_t ts) {
     const auto* tz = locateZone(name);
@@ -49,6 +49,23 @@ const BaseVector* getValueVector(const BaseVector* vector) {
   return vector->valueVector().get();
 }
 
+// Sets 'indices' to the index of the run of each row of 'sequenceVector', so
+// that the sequence vector can be decoded like a dictionary over its values.
+void expandRuns(
+    const BaseVector& sequenceVector,
+    std::vector<vector_size_t>& indices) {
+  const auto* lengths = sequenceVector.wrapInfo()->as<vector_size_t>();
+  const auto numRuns = sequenceVector.valueVector()->size();
+  indices.resize(sequenceVector.size());
+  vector_size_t row = 0;
+  for (vector_size_t run = 0; run < numRuns; ++run) {
+    std::fill(
+        indices.begin() + row, indices.begin() + row + lengths[run], run);
+    row += lengths[run];
+  }
+  VELOX_DCHECK_EQ(row, sequenceVector.size());
+}
+
 } // namespace
 
 const std::vector<vector_size_t>& DecodedVector::consecutiveIndices() {
@@ -203,6 +220,11 @@ void DecodedVector::combineWrappers(
       hasExtraNulls_ = true;
       mayHaveNulls_ = true;
     }
+  } else if (topEncoding == VectorEncoding::Simple::SEQUENCE) {
+    // The nulls of a sequence vector are the nulls of its values.
+    expandRuns(*vector, copiedIndices_);
+    indices_ = copiedIndices_.data();
+    values = getValueVector(vector);
   } else {
     VELOX_FAIL(
         "Unsupported wrapper encoding: {}",
@@ -238,6 +260,7 @@ void DecodedVector::combineWrappers(
         setBaseData(values, rows, sharedBase);
         return;
       case VectorEncoding::Simple::DICTIONARY:
+      case VectorEncoding::Simple::SEQUENCE:
         applyDictionaryWrapper(*values, rows);
         values = getValueVector(values);
         break;
@@ -255,7 +278,13 @@ void DecodedVector::applyDictionaryWrapper(
     return;
   }
 
-  auto newIndices = dictionaryVector.wrapInfo()->as<vector_size_t>();
+  const vector_size_t* newIndices;
+  if (dictionaryVector.encoding() == VectorEncoding::Simple::SEQUENCE) {
+    expandRuns(dictionaryVector, runIndices_);
+    newIndices = runIndices_.data();
+  } else {
+    newIndices = dictionaryVector.wrapInfo()->as<vector_size_t>();
+  }
   auto newNulls = dictionaryVector.rawNulls();
   if (newNulls) {
     hasExtraNulls_ = true;
@@ -344,6 +344,8 @@ class DecodedVector {
       VectorPtr& sharedBase,
       int numLevels = -1);
 
+  // Combines the indices of a dictionary or sequence wrapper with the
+  // indices of the wrappers above it.
   void applyDictionaryWrapper(
       const BaseVector& dictionaryVector,
       const SelectivityVector* rows);
@@ -436,6 +438,10 @@ class DecodedVector {
   // e.g. when combining nested dictionaries.
   mutable std::vector<vector_size_t> copiedIndices_;
 
+  // The index of the run of each row of a sequence vector below the top
+  // level wrapper.
+  std::vector<vector_size_t> runIndices_;
+
   // Used as backing for 'nulls_' when null-ness is combined from
   // dictionary and base values.
   std::vector<uint64_t> copiedNulls_;
@@ -100,6 +100,53 @@ void FlatVector<StringView>::prepareForReuse() {
   }
 }
 
+template <>
+bool FlatVector<StringView>::compactStringBuffers(double minUsedRatio) {
+  if (stringBuffers_.empty() || rawValues_ == nullptr) {
+    return false;
+  }
+  uint64_t retainedBytes = 0;
+  for (const auto& buffer : stringBuffers_) {
+    retainedBytes += buffer->capacity();
+  }
+  uint64_t usedBytes = 0;
+  for (auto i = 0; i < BaseVector::length_; ++i) {
+    if (!BaseVector::isNullAt(i) && !rawValues_[i].isInline()) {
+      usedBytes += rawValues_[i].size();
+    }
+  }
+  if (usedBytes >= retainedBytes * minUsedRatio) {
+    return false;
+  }
+
+  if (!values_->isMutable()) {
+    values_ = AlignedBuffer::copy(pool(), values_);
+    rawValues_ = values_->asMutable<StringView>();
+  }
+  BufferPtr newBuffer;
+  char* rawBuffer = nullptr;
+  if (usedBytes > 0) {
+    newBuffer = AlignedBuffer::allocate<char>(usedBytes, pool());
+    rawBuffer = newBuffer->asMutable<char>();
+  }
+  for (auto i = 0; i < BaseVector::length_; ++i) {
+    if (BaseVector::isNullAt(i)) {
+      // Null rows must not reference the released buffers.
+      rawValues_[i] = StringView();
+    } else if (!rawValues_[i].isInline()) {
+      const auto size = rawValues_[i].size();
+      memcpy(rawBuffer, rawValues_[i].data(), size);
+      rawValues_[i] = StringView(rawBuffer, size);
+      rawBuffer += size;
+    }
+  }
+  clearStringBuffers();
+  if (newBuffer != nullptr) {
+    addStringBuffer(newBuffer);
+  }
+  return true;
+}
+
 template <>
 void FlatVector<StringView>::set(vector_size_t idx, StringView value) {
   VELOX_DCHECK_LT(idx, BaseVector::length_);
@@ -510,6 +510,17 @@ class FlatVector final : public SimpleVector<T> {
     return nullptr;
   }
 
+  /// This API is available only for string vectors (T = StringView).
+  ///
+  /// Copies the non-inline strings into one buffer of their total size and
+  /// releases the other string buffers if the strings take less than
+  /// 'minUsedRatio' of the capacity of these, e.g. when the vector references
+  /// a few rows of a large decompressed page. Copies the values buffer first
+  /// if this is shared. Returns true if the strings were copied.
+  bool compactStringBuffers(double /*minUsedRatio*/) {
+    return false;
+  }
+
   void ensureWritable(const SelectivityVector& rows) override;
 
   bool isWritable() const override {
@@ -650,6 +661,9 @@ char* FlatVector<StringView>::getRawStringBufferWithSpace(
 template <>
 void FlatVector<StringView>::prepareForReuse();
 
+template <>
+bool FlatVector<StringView>::compactStringBuffers(double minUsedRatio);
+
 template <>
 VectorPtr FlatVector<StringView>::copyPreserveEncodings(
     velox::memory::MemoryPool* pool) const;
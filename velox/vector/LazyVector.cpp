@@ -274,7 +274,7 @@ void LazyVector::load(RowSet rows, ValueHook* hook) const {
   }
 }
 
-void LazyVector::loadVectorInternal() const {
+void LazyVector::loadVectorInternal(bool loadChildren) const {
   if (!allLoaded_) {
     if (!vector_) {
       vector_ = BaseVector::create(type_, 0, pool_);
@@ -284,6 +284,9 @@ void LazyVector::loadVectorInternal() const {
     VELOX_CHECK_NOT_NULL(vector_);
     if (vector_->encoding() == VectorEncoding::Simple::LAZY) {
       vector_ = vector_->asUnchecked<LazyVector>()->loadedVectorShared();
+    } else if (
+        !loadChildren && vector_->encoding() == VectorEncoding::Simple::ROW) {
+      childrenNotLoaded_ = true;
     } else {
       // If the load produced a wrapper, load the wrapped vector.
       vector_->loadedVector();
@@ -296,6 +299,10 @@ void LazyVector::loadVectorInternal() const {
     }
   } else {
     VELOX_CHECK_NOT_NULL(vector_);
+    if (loadChildren && childrenNotLoaded_) {
+      vector_->loadedVector();
+      childrenNotLoaded_ = false;
+    }
   }
 }
 } // namespace facebook::velox
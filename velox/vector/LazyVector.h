@@ -245,6 +245,7 @@ class LazyVector : public BaseVector {
     BaseVector::length_ = size;
     loader_ = std::move(loader);
     allLoaded_ = false;
+    childrenNotLoaded_ = false;
     containsLazyAndIsWrapped_ = false;
     resetNulls();
   }
@@ -297,6 +298,15 @@ class LazyVector : public BaseVector {
     return vector_;
   }
 
+  /// Same as loadedVectorShared() but leaves the lazy children of a loaded ROW
+  /// vector unloaded, so that only the fields that are read later are loaded.
+  /// A struct field reference loads the struct this way. Any later call of
+  /// loadedVector() or loadedVectorShared() loads the remaining children.
+  const VectorPtr& loadedVectorSharedWithLazyChildren() const {
+    loadVectorInternal(false);
+    return vector_;
+  }
+
   const BaseVector* wrappedVector() const override {
     return loadedVector()->wrappedVector();
   }
@@ -376,12 +386,16 @@ class LazyVector : public BaseVector {
       const SelectivityVector& rows,
       SelectivityVector& baseRows);
 
-  void loadVectorInternal() const;
+  // Loads 'vector_' if not loaded. Also loads the lazy children of a ROW
+  // 'vector_' if 'loadChildren' is true.
+  void loadVectorInternal(bool loadChildren = true) const;
 
   std::unique_ptr<VectorLoader> loader_;
 
   // True if all values are loaded.
   mutable tsan_atomic<bool> allLoaded_{false};
+  // True if 'vector_' is a ROW vector loaded without loading its children.
+  mutable bool childrenNotLoaded_{false};
   // Vector to hold loaded values. This may be present before load for
   // reuse. If loading is with ValueHook, this will not be created.
   mutable VectorPtr vector_;
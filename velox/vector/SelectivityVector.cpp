@@ -15,7 +15,10 @@
  */
 #include "velox/vector/SelectivityVector.h"
 
+#include <numeric>
+
 #include "velox/common/base/Nulls.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox {
 
@@ -29,6 +32,14 @@ SelectivityVector SelectivityVector::empty(vector_size_t size) {
   return SelectivityVector{size, false};
 }
 
+vector_size_t SelectivityVector::selectedRows(vector_size_t* rows) const {
+  if (isAllSelected()) {
+    std::iota(rows, rows + end_ - begin_, begin_);
+    return end_ - begin_;
+  }
+  return simd::indicesOfSetBits(bits_.data(), begin_, end_, rows);
+}
+
 std::string SelectivityVector::toString(
     vector_size_t maxSelectedRowsToPrint) const {
   const auto selectedCnt = countSelected();
@@ -322,6 +322,12 @@ class SelectivityVector {
     return count;
   }
 
+  /// Writes the selected rows in ascending order to 'rows' and returns their
+  /// number. 'rows' must have space for end() - begin() rows. The bitmap is
+  /// converted a batch of bits at a time with SIMD, which is faster than
+  /// collecting the rows in applyToSelected() when few rows are selected.
+  vector_size_t selectedRows(vector_size_t* rows) const;
+
   vector_size_t size() const {
     return size_;
   }
@@ -144,6 +144,13 @@ class SimpleVector : public BaseVector {
     stats_ = std::move(stats);
   }
 
+  /// Sets bounds on the non-null values, e.g. the range of a filter all the
+  /// values passed. The bounds need not be tight. They are cleared when the
+  /// vector is prepared for reuse.
+  void setStats(SimpleVectorStats<T> stats) {
+    stats_ = std::move(stats);
+  }
+
   // Concrete Vector types need to implement this themselves.
   // This method does not do bounds checking. When the value is null the return
   // value is technically undefined (currently implemented as default of T)
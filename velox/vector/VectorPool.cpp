@@ -47,6 +47,12 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+bool isComplexEncoding(VectorEncoding::Simple encoding) {
+  return encoding == VectorEncoding::Simple::ARRAY ||
+      encoding == VectorEncoding::Simple::MAP ||
+      encoding == VectorEncoding::Simple::ROW;
+}
 } // namespace
 
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
@@ -54,6 +60,11 @@ VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
   if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
     return vectors_[cacheIndex].pop(type, size, *pool_);
   }
+  if (size <= kMaxRecycleSize) {
+    if (auto* typePool = complexTypePool(type, false)) {
+      return typePool->pop(type, size, *pool_);
+    }
+  }
   return BaseVector::create(type, size, pool_);
 }
 
@@ -66,10 +77,32 @@ bool VectorPool::release(VectorPtr& vector) {
   }
 
   auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
+  if (cacheIndex >= 0) {
+    return vectors_[cacheIndex].maybePushBack(vector);
+  }
+  if (!isComplexEncoding(vector->encoding()) || !vector->isWritable()) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  auto* typePool = complexTypePool(vector->type(), true);
+  return typePool != nullptr && typePool->maybePushBack(vector);
+}
+
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool add) {
+  if (!type->isArray() && !type->isMap() && !type->isRow()) {
+    return nullptr;
+  }
+  for (auto& [cachedType, typePool] : complexVectors_) {
+    if (cachedType == type || *cachedType == *type) {
+      return &typePool;
+    }
+  }
+  if (!add || complexVectors_.size() >= kNumComplexTypes) {
+    return nullptr;
+  }
+  complexVectors_.emplace_back(type, TypePool{});
+  return &complexVectors_.back().second;
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -88,12 +121,16 @@ void VectorPool::clear() {
   for (auto& vectorPool : vectors_) {
     vectorPool.clear();
   }
+  complexVectors_.clear();
 }
 
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
-  // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  // values Buffer and an uninitialized or unique and mutable nulls Buffer, or
+  // an ARRAY, MAP or ROW vector with writable children.
+  if (!vector->isWritable() ||
+      !(isComplexEncoding(vector->encoding()) ||
+        (vector->isFlatEncoding() && vector->values()))) {
     return false;
   }
   if (size >= kNumPerType) {
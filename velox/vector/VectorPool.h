@@ -23,10 +23,13 @@ namespace facebook::velox {
 /// A thread-level cache of pre-allocated flat vectors of different types.
 /// Keeps up to 10 recyclable vectors of each type. A vector is
 /// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// The singleton built-in types and up to 'kNumComplexTypes' ARRAY, MAP and
+/// ROW types are supported. A recycled complex vector keeps the buffers of its
+/// children, e.g. the offsets and the string buffers, so that these are not
+/// allocated again for the next batch. Decimal types, fixed-size array type and
+/// custom types are not supported. Calling 'get' for an unsupported type
+/// already returns a newly allocated vector. Calling 'release' for an
+/// unsupported type is a no-op.
 class VectorPool {
  public:
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
@@ -50,6 +53,7 @@ class VectorPool {
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
+  static constexpr int32_t kNumComplexTypes = 4;
 
   struct TypePool {
     int32_t size{0};
@@ -73,6 +77,13 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Returns the cache of the vectors of complex 'type', or nullptr if there
+  /// is none. Adds a cache if 'add' is true and there is space.
+  TypePool* complexTypePool(const TypePtr& type, bool add);
+
+  /// Caches of pre-allocated vectors of complex types.
+  std::vector<std::pair<TypePtr, TypePool>> complexVectors_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
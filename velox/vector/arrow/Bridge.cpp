@@ -574,6 +574,31 @@ VectorPtr createStringFlatVectorFromUtf8View(
         arrowArray.buffers[buffer_id], bufferSizes[buffer_id - 2]);
   }
 
+  // An Arrow view of a string of up to 12 bytes has the layout of an inline
+  // Velox StringView, so the views are used as is if all strings are inline.
+  const auto* arrowViews =
+      reinterpret_cast<const uint32_t*>(arrowArray.buffers[1]);
+  bool allInline = true;
+  for (int64_t i = 0; i < arrowArray.length; ++i) {
+    if (arrowViews[4 * i] > StringView::kInlineSize) {
+      allInline = false;
+      break;
+    }
+  }
+  if (allInline) {
+    return std::make_shared<FlatVector<StringView>>(
+        pool,
+        type,
+        nulls,
+        arrowArray.length,
+        wrapInBufferView(
+            arrowArray.buffers[1], arrowArray.length * sizeof(StringView)),
+        std::move(stringViewBuffers),
+        SimpleVectorStats<StringView>{},
+        std::nullopt,
+        optionalNullCount(arrowArray.null_count));
+  }
+
   BufferPtr stringViews =
       AlignedBuffer::allocate<StringView>(arrowArray.length, pool);
   auto* rawStringViews = stringViews->asMutable<uint64_t>();
@@ -1731,10 +1756,13 @@ VectorPtr createVectorFromReeArray(
     auto indices = allocateIndices(arrowArray.length, pool);
     auto rawIndices = indices->asMutable<vector_size_t>();
 
-    size_t cursor = 0;
-    for (size_t i = 0; i < runsArray.length; ++i) {
-      while (cursor < runsBuffer[i]) {
-        rawIndices[cursor++] = i;
+    vector_size_t cursor = 0;
+    for (vector_size_t i = 0; i < runsArray.length; ++i) {
+      const vector_size_t runEnd =
+          std::min<int64_t>(runsBuffer[i], arrowArray.length);
+      if (runEnd > cursor) {
+        std::fill(rawIndices + cursor, rawIndices + runEnd, i);
+        cursor = runEnd;
       }
     }
     return BaseVector::wrapInDictionary(
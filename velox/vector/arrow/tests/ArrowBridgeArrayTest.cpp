@@ -1627,6 +1627,22 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
           EXPECT_EQ(vec.size(), 12);
         },
         ArrowOptions{.exportToStringView = true});
+
+    // All strings are inline, so the views are imported without a copy.
+    arrow::StringViewBuilder inlineBuilder(arrow::default_memory_pool());
+    ASSERT_OK(inlineBuilder.Append("hello world", 11));
+    ASSERT_OK(inlineBuilder.AppendNull());
+    ASSERT_OK(inlineBuilder.Append("", 0));
+    ASSERT_OK(inlineBuilder.Append("twelve bytes", 12));
+    ASSERT_OK_AND_ASSIGN(auto inlineArray, inlineBuilder.Finish());
+    const void* views = inlineArray->data()->buffers[1]->data();
+    testArrowRoundTrip(
+        *inlineArray,
+        [views](const BaseVector& vec) {
+          ASSERT_EQ(vec.values()->as<void>(), views);
+          EXPECT_EQ(vec.size(), 4);
+        },
+        ArrowOptions{.exportToStringView = true});
   }
 
   void testImportREE() {
@@ -690,6 +690,42 @@ TEST_F(DecodedVectorTest, dictionaryOverConstant) {
   testDictionaryOverConstant(arrayVector, 5); // null
 }
 
+TEST_F(DecodedVectorTest, sequence) {
+  const std::vector<std::optional<int64_t>> data{
+      10, 10, 10, std::nullopt, 15, 15, std::nullopt, std::nullopt, 20};
+  auto sequence = vectorMaker_.sequenceVector<int64_t>(data);
+  ASSERT_EQ(sequence->encoding(), VectorEncoding::Simple::SEQUENCE);
+
+  DecodedVector decoded(*sequence);
+  ASSERT_FALSE(decoded.isIdentityMapping());
+  ASSERT_FALSE(decoded.isConstantMapping());
+  ASSERT_EQ(decoded.base(), sequence->valueVector().get());
+  ASSERT_TRUE(decoded.mayHaveNulls());
+  for (auto i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(decoded.isNullAt(i), !data[i].has_value()) << i;
+    if (data[i].has_value()) {
+      ASSERT_EQ(decoded.valueAt<int64_t>(i), data[i].value()) << i;
+    }
+  }
+  // Each run is decoded to one row of the base vector.
+  ASSERT_EQ(decoded.index(0), decoded.index(2));
+  ASSERT_EQ(decoded.index(4), decoded.index(5));
+  ASSERT_NE(decoded.index(2), decoded.index(4));
+
+  // A dictionary over the sequence vector.
+  auto indices = makeIndicesInReverse(data.size());
+  auto dictionary = wrapInDictionary(indices, sequence);
+  decoded.decode(*dictionary);
+  ASSERT_EQ(decoded.base(), sequence->valueVector().get());
+  for (auto i = 0; i < data.size(); ++i) {
+    const auto& expected = data[data.size() - 1 - i];
+    ASSERT_EQ(decoded.isNullAt(i), !expected.has_value()) << i;
+    if (expected.has_value()) {
+      ASSERT_EQ(decoded.valueAt<int64_t>(i), expected.value()) << i;
+    }
+  }
+}
+
 TEST_F(DecodedVectorTest, wrapOnDictionaryEncoding) {
   // This test exercises the use-case of unnesting the children of a rowVector
   // and making sure the wrap over the row vector is correctly applied on its
@@ -477,6 +477,29 @@ TEST(SelectivityVectorTest, selectAndGrow) {
 
 // Sanity check for toString() method. Primarily to ensure the method doesn't
 // fail or crash.
+TEST(SelectivityVectorTest, selectedRows) {
+  auto test = [](const SelectivityVector& rows) {
+    std::vector<vector_size_t> expected;
+    rows.applyToSelected([&](auto row) { expected.push_back(row); });
+    std::vector<vector_size_t> selected(rows.end() - rows.begin());
+    selected.resize(rows.selectedRows(selected.data()));
+    ASSERT_EQ(expected, selected);
+  };
+
+  SelectivityVector rows(1'000);
+  test(rows);
+  rows.setValidRange(0, 10, false);
+  rows.updateBounds();
+  test(rows);
+  for (auto i = 0; i < rows.size(); ++i) {
+    rows.setValid(i, i % 97 == 3);
+  }
+  rows.updateBounds();
+  test(rows);
+  rows.clearAll();
+  test(rows);
+}
+
 TEST(SelectivityVectorTest, toString) {
   SelectivityVector rows(1024);
 
@@ -153,6 +153,58 @@ TEST_F(VectorPoolTest, customTypes) {
   ASSERT_TRUE(isJsonType(vector->type()));
 }
 
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+
+  const auto type = ROW({"a", "b"}, {ARRAY(VARCHAR()), MAP(INTEGER(), REAL())});
+  auto vector = vectorPool.get(type, 100);
+  ASSERT_EQ(100, vector->size());
+  auto* row = vector->asChecked<RowVector>();
+  auto* array = row->childAt(0)->asChecked<ArrayVector>();
+  auto* elements = array->elements()->asFlatVector<StringView>();
+  elements->resize(10);
+  for (auto i = 0; i < 10; ++i) {
+    elements->set(i, StringView(fmt::format("a non-inline string {}", i)));
+  }
+  array->setOffsetAndSize(0, 0, 10);
+  ASSERT_EQ(1, elements->stringBuffers().size());
+  const auto* stringBuffer = elements->stringBuffers()[0].get();
+
+  // The vector comes back with empty children that keep their buffers.
+  auto* vectorPtr = vector.get();
+  ASSERT_TRUE(vectorPool.release(vector));
+  auto recycled = vectorPool.get(type, 200);
+  ASSERT_EQ(vectorPtr, recycled.get());
+  ASSERT_EQ(200, recycled->size());
+  row = recycled->asChecked<RowVector>();
+  array = row->childAt(0)->asChecked<ArrayVector>();
+  ASSERT_EQ(0, array->sizeAt(0));
+  ASSERT_EQ(0, array->elements()->size());
+  elements = array->elements()->asFlatVector<StringView>();
+  ASSERT_EQ(1, elements->stringBuffers().size());
+  ASSERT_EQ(stringBuffer, elements->stringBuffers()[0].get());
+  ASSERT_EQ(200, row->childAt(1)->size());
+
+  // A vector of an equal type that is not the same instance is recycled too.
+  ASSERT_TRUE(vectorPool.release(recycled));
+  recycled = vectorPool.get(
+      ROW({"a", "b"}, {ARRAY(VARCHAR()), MAP(INTEGER(), REAL())}), 10);
+  ASSERT_EQ(vectorPtr, recycled.get());
+
+  // Only a limited number of complex types are cached, one of which is the
+  // ROW type above.
+  std::vector<VectorPtr> arrays;
+  for (auto i = 0; i < 10; ++i) {
+    arrays.push_back(vectorPool.get(
+        ARRAY(ROW({fmt::format("c{}", i)}, {BIGINT()})), 100));
+  }
+  ASSERT_EQ(3, vectorPool.release(arrays));
+
+  // A vector with a shared child is not recycled.
+  auto child = row->childAt(1);
+  ASSERT_FALSE(vectorPool.release(recycled));
+}
+
 TEST_F(VectorPoolTest, clear) {
   const auto statsBefore = pool()->stats();
 
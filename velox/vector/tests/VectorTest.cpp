@@ -3009,6 +3009,46 @@ TEST_F(VectorTest, getRawStringBufferWithSpaceNoExistingBuffer) {
   test::assertEqualVectors(expected, vector);
 }
 
+TEST_F(VectorTest, compactStringBuffers) {
+  auto vector = makeNullableFlatVector<StringView>(
+      {"short", std::nullopt, "a string of 25 characters", "inlined"});
+  // The strings reference a large buffer of which they use a few bytes.
+  const std::string longString(30, 'x');
+  char* rawBuffer =
+      vector->getRawStringBufferWithSpace(1 << 20, /*exactSize=*/true);
+  memcpy(rawBuffer, longString.data(), longString.size());
+  vector->setNoCopy(0, StringView(rawBuffer, longString.size()));
+  const auto numBuffers = vector->stringBuffers().size();
+
+  // The values buffer is shared with 'other', which must not change.
+  auto other = std::make_shared<FlatVector<StringView>>(
+      pool(),
+      VARCHAR(),
+      vector->nulls(),
+      vector->size(),
+      vector->values(),
+      std::vector<BufferPtr>(vector->stringBuffers()));
+  auto expected = makeNullableFlatVector<StringView>(
+      {StringView(longString),
+       std::nullopt,
+       "a string of 25 characters",
+       "inlined"});
+
+  ASSERT_FALSE(vector->compactStringBuffers(0));
+  ASSERT_EQ(vector->stringBuffers().size(), numBuffers);
+
+  ASSERT_TRUE(vector->compactStringBuffers(0.5));
+  ASSERT_EQ(vector->stringBuffers().size(), 1);
+  ASSERT_LT(vector->stringBuffers()[0]->capacity(), 1 << 10);
+  ASSERT_EQ(vector->stringBuffers()[0]->size(), longString.size() + 25);
+  ASSERT_NE(vector->values(), other->values());
+  test::assertEqualVectors(expected, vector);
+  test::assertEqualVectors(expected, other);
+
+  // The strings now use most of the buffer.
+  ASSERT_FALSE(vector->compactStringBuffers(0.25));
+}
+
 namespace {
 
 SelectivityVector toSelectivityVector(